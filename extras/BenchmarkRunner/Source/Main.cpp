@@ -0,0 +1,301 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+//==============================================================================
+class ConsoleLogger : public Logger
+{
+    void logMessage (const String& message) override
+    {
+        std::cout << message << std::endl;
+
+       #if JUCE_WINDOWS
+        Logger::outputDebugString (message);
+       #endif
+    }
+};
+
+//==============================================================================
+class ConsoleBenchmarkRunner : public BenchmarkRunner
+{
+    void logMessage (const String& message) override
+    {
+        Logger::writeToLog (message);
+    }
+};
+
+//==============================================================================
+class FloatVectorOperationsBenchmark : public Benchmark
+{
+public:
+    FloatVectorOperationsBenchmark() : Benchmark ("FloatVectorOperations", "Audio") {}
+
+    void initialise() override
+    {
+        Random random;
+
+        for (auto* block : { &src1, &src2, &dest })
+        {
+            block->resize ((size_t) numValues);
+
+            for (auto& value : *block)
+                value = random.nextFloat() * 2.0f - 1.0f;
+        }
+    }
+
+    void runBenchmark() override
+    {
+        measure ("copy",            [this] { FloatVectorOperations::copy (dest.data(), src1.data(), numValues); });
+        measure ("add",             [this] { FloatVectorOperations::add (dest.data(), src1.data(), src2.data(), numValues); });
+        measure ("multiply",        [this] { FloatVectorOperations::multiply (dest.data(), src1.data(), src2.data(), numValues); });
+        measure ("addWithMultiply", [this] { FloatVectorOperations::addWithMultiply (dest.data(), src1.data(), 0.5f, numValues); });
+        measure ("findMinAndMax",   [this] { minAndMax = FloatVectorOperations::findMinAndMax (src1.data(), numValues); });
+    }
+
+private:
+    static constexpr int numValues = 1 << 16;
+
+    std::vector<float> src1, src2, dest;
+    Range<float> minAndMax;
+};
+
+static FloatVectorOperationsBenchmark floatVectorOperationsBenchmark;
+
+//==============================================================================
+class AudioBufferBenchmark : public Benchmark
+{
+public:
+    AudioBufferBenchmark() : Benchmark ("AudioBuffer", "Audio") {}
+
+    void initialise() override
+    {
+        Random random;
+
+        for (auto* b : { &buffer, &other, &scratch })
+            b->setSize (2, numSamples);
+
+        for (auto* b : { &buffer, &other })
+            for (int channel = 0; channel < b->getNumChannels(); ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    b->setSample (channel, i, random.nextFloat() * 2.0f - 1.0f);
+    }
+
+    void runBenchmark() override
+    {
+        measure ("applyGain", [this]
+        {
+            buffer.applyGain (1.0001f);
+        });
+
+        measure ("applyGainRamp", [this]
+        {
+            buffer.applyGainRamp (0, numSamples, 0.5f, 1.0f);
+        });
+
+        measure ("addFrom", [this]
+        {
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                buffer.addFrom (channel, 0, other, channel, 0, numSamples);
+        });
+
+        measure ("getMagnitude", [this]
+        {
+            magnitude = buffer.getMagnitude (0, numSamples);
+        });
+
+        measure ("makeCopyOf", [this]
+        {
+            scratch.makeCopyOf (buffer);
+        });
+    }
+
+private:
+    static constexpr int numSamples = 1 << 14;
+
+    AudioBuffer<float> buffer, other, scratch;
+    float magnitude = 0;
+};
+
+static AudioBufferBenchmark audioBufferBenchmark;
+
+//==============================================================================
+class FFTBenchmark : public Benchmark
+{
+public:
+    FFTBenchmark() : Benchmark ("dsp::FFT", "DSP") {}
+
+    void initialise() override
+    {
+        fft = std::make_unique<dsp::FFT> (order);
+
+        const auto size = (size_t) fft->getSize();
+
+        realInput.resize (size * 2);
+        realScratch.resize (size * 2);
+        complexInput.resize (size);
+        complexOutput.resize (size);
+
+        Random random;
+
+        for (auto& value : realInput)
+            value = random.nextFloat() * 2.0f - 1.0f;
+
+        for (auto& value : complexInput)
+            value = { random.nextFloat() * 2.0f - 1.0f, random.nextFloat() * 2.0f - 1.0f };
+    }
+
+    void runBenchmark() override
+    {
+        measure ("1024-point complex forward", [this]
+        {
+            fft->perform (complexInput.data(), complexOutput.data(), false);
+        });
+
+        measure ("1024-point complex inverse", [this]
+        {
+            fft->perform (complexInput.data(), complexOutput.data(), true);
+        });
+
+        // the real-only transforms work in-place, so the input is restored each time
+        measure ("1024-point real-only forward", [this]
+        {
+            FloatVectorOperations::copy (realScratch.data(), realInput.data(), (int) realScratch.size());
+            fft->performRealOnlyForwardTransform (realScratch.data());
+        });
+
+        measure ("1024-point frequency-only forward", [this]
+        {
+            FloatVectorOperations::copy (realScratch.data(), realInput.data(), (int) realScratch.size());
+            fft->performFrequencyOnlyForwardTransform (realScratch.data());
+        });
+    }
+
+private:
+    static constexpr int order = 10;
+
+    std::unique_ptr<dsp::FFT> fft;
+    std::vector<float> realInput, realScratch;
+    std::vector<dsp::Complex<float>> complexInput, complexOutput;
+};
+
+static FFTBenchmark fftBenchmark;
+
+//==============================================================================
+class StringFormattingBenchmark : public Benchmark
+{
+public:
+    StringFormattingBenchmark() : Benchmark ("String formatting", "Core") {}
+
+    void runBenchmark() override
+    {
+        measure ("String (int)", [this]
+        {
+            for (int i = 0; i < 1000; ++i)
+                totalLength += String (i).length();
+        });
+
+        measure ("String (double, 4)", [this]
+        {
+            for (int i = 0; i < 1000; ++i)
+                totalLength += String (i * 0.5, 4).length();
+        });
+
+        measure ("String::formatted", [this]
+        {
+            for (int i = 0; i < 1000; ++i)
+                totalLength += String::formatted ("%d: %.3f", i, i * 0.5).length();
+        });
+
+        measure ("operator<< concatenation", [this]
+        {
+            String s;
+
+            for (int i = 0; i < 1000; ++i)
+                s << i << ' ';
+
+            totalLength += s.length();
+        });
+
+        measure ("String::toHexString", [this]
+        {
+            for (int i = 0; i < 1000; ++i)
+                totalLength += String::toHexString (i * 7919).length();
+        });
+    }
+
+private:
+    int totalLength = 0;
+};
+
+static StringFormattingBenchmark stringFormattingBenchmark;
+
+
+//==============================================================================
+int main (int argc, char **argv)
+{
+    ArgumentList args (argc, argv);
+
+    if (args.containsOption ("--help|-h"))
+    {
+        std::cout << argv[0] << " [--help|-h] [--list-categories] [--category category] [--json file]" << std::endl;
+        return 0;
+    }
+
+    if (args.containsOption ("--list-categories"))
+    {
+        for (auto& category : Benchmark::getAllCategories())
+            std::cout << category << std::endl;
+
+        return 0;
+    }
+
+    ConsoleLogger logger;
+    Logger::setCurrentLogger (&logger);
+
+    ConsoleBenchmarkRunner runner;
+
+    if (args.containsOption ("--category"))
+        runner.runBenchmarksInCategory (args.getValueForOption ("--category"));
+    else
+        runner.runAllBenchmarks();
+
+    Logger::setCurrentLogger (nullptr);
+
+    if (args.containsOption ("--json"))
+    {
+        auto output = File::getCurrentWorkingDirectory()
+                         .getChildFile (args.getValueForOption ("--json"));
+
+        output.replaceWithText (runner.getResultsAsJSON());
+        std::cout << "Results written to " << output.getFullPathName() << std::endl;
+    }
+    else
+    {
+        std::cout << runner.getResultsAsJSON() << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,432 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+static constexpr uint32 analyticsSpoolMagic = 0x6c707341;  // 'Aspl'
+static constexpr uint32 analyticsSpoolVersion = 1;
+
+//==============================================================================
+static void writeStringPairArrayToStream (OutputStream& out, const StringPairArray& pairs)
+{
+    out.writeInt (pairs.size());
+
+    for (int i = 0; i < pairs.size(); ++i)
+    {
+        out.writeString (pairs.getAllKeys()[i]);
+        out.writeString (pairs.getAllValues()[i]);
+    }
+}
+
+static bool readStringPairArrayFromStream (InputStream& in, StringPairArray& pairs)
+{
+    auto numPairs = in.readInt();
+
+    if (numPairs < 0)
+        return false;
+
+    for (int i = 0; i < numPairs; ++i)
+    {
+        if (in.isExhausted())
+            return false;
+
+        auto key = in.readString();
+        pairs.set (key, in.readString());
+    }
+
+    return true;
+}
+
+static void writeEventToStream (OutputStream& out, const AnalyticsDestination::AnalyticsEvent& event)
+{
+    out.writeString (event.name);
+    out.writeInt (event.eventType);
+    out.writeInt ((int) event.timestamp);
+    writeStringPairArrayToStream (out, event.parameters);
+    out.writeString (event.userID);
+    writeStringPairArrayToStream (out, event.userProperties);
+}
+
+static bool readEventFromStream (InputStream& in, AnalyticsDestination::AnalyticsEvent& event)
+{
+    event.name      = in.readString();
+    event.eventType = in.readInt();
+    event.timestamp = (uint32) in.readInt();
+
+    if (! readStringPairArrayFromStream (in, event.parameters))
+        return false;
+
+    event.userID = in.readString();
+
+    return readStringPairArrayFromStream (in, event.userProperties);
+}
+
+//==============================================================================
+AnalyticsEventSpool::AnalyticsEventSpool (const File& fileToUse, size_t maxFileSizeInBytes)
+    : file (fileToUse), maxFileSize (maxFileSizeInBytes)
+{
+    // the spool needs at least some room for records beyond its header!
+    jassert (maxFileSize > sizeof (SpoolHeader) + 64);
+}
+
+AnalyticsEventSpool::~AnalyticsEventSpool()
+{
+    close();
+}
+
+bool AnalyticsEventSpool::open()
+{
+    close();
+
+    if (! file.existsAsFile() || (size_t) file.getSize() != maxFileSize)
+    {
+        file.deleteFile();
+
+        FileOutputStream stream (file);
+
+        if (stream.failedToOpen()
+             || ! stream.setPosition ((int64) maxFileSize - 1)
+             || ! stream.write ("", 1))
+            return false;
+    }
+
+    map.reset (new MemoryMappedFile (file, MemoryMappedFile::readWrite));
+
+    if (map->getData() == nullptr || map->getSize() != maxFileSize)
+    {
+        map.reset();
+        return false;
+    }
+
+    header   = static_cast<SpoolHeader*> (map->getData());
+    data     = static_cast<uint8*> (map->getData()) + sizeof (SpoolHeader);
+    dataSize = maxFileSize - sizeof (SpoolHeader);
+
+    if (! headerIsValid())
+        initialiseHeader();
+
+    return true;
+}
+
+void AnalyticsEventSpool::close()
+{
+    map.reset();
+    header = nullptr;
+    data = nullptr;
+    dataSize = 0;
+}
+
+void AnalyticsEventSpool::initialiseHeader() noexcept
+{
+    header->magic      = analyticsSpoolMagic;
+    header->version    = analyticsSpoolVersion;
+    header->headOffset = 0;
+    header->bytesUsed  = 0;
+    header->numEvents  = 0;
+}
+
+bool AnalyticsEventSpool::headerIsValid() const noexcept
+{
+    return header->magic == analyticsSpoolMagic
+        && header->version == analyticsSpoolVersion
+        && header->headOffset < dataSize
+        && header->bytesUsed <= dataSize;
+}
+
+//==============================================================================
+void AnalyticsEventSpool::writeBytes (size_t position, const void* source, size_t numBytes) noexcept
+{
+    auto contiguous = jmin (numBytes, dataSize - position);
+    memcpy (data + position, source, contiguous);
+    memcpy (data, addBytesToPointer (source, contiguous), numBytes - contiguous);
+}
+
+void AnalyticsEventSpool::readBytes (size_t position, void* destination, size_t numBytes) const noexcept
+{
+    auto contiguous = jmin (numBytes, dataSize - position);
+    memcpy (destination, data + position, contiguous);
+    memcpy (addBytesToPointer (destination, contiguous), data, numBytes - contiguous);
+}
+
+uint32 AnalyticsEventSpool::readRecordSize (size_t position) const noexcept
+{
+    uint32 size;
+    readBytes (position, &size, sizeof (size));
+    return ByteOrder::swapIfBigEndian (size);
+}
+
+void AnalyticsEventSpool::dropOldestEvent() noexcept
+{
+    auto recordSize = sizeof (uint32) + readRecordSize (header->headOffset);
+
+    header->headOffset = (uint32) ((header->headOffset + recordSize) % dataSize);
+    header->bytesUsed -= (uint32) recordSize;
+    --header->numEvents;
+}
+
+//==============================================================================
+bool AnalyticsEventSpool::appendEvent (const AnalyticsEvent& event)
+{
+    if (! isOpen())
+        return false;
+
+    MemoryOutputStream payload;
+    writeEventToStream (payload, event);
+
+    auto recordSize = sizeof (uint32) + payload.getDataSize();
+
+    if (recordSize > dataSize)
+    {
+        jassertfalse;  // a single event bigger than the whole spool can never be stored!
+        return false;
+    }
+
+    while (header->bytesUsed + recordSize > dataSize)
+        dropOldestEvent();
+
+    auto writePos = ((size_t) header->headOffset + header->bytesUsed) % dataSize;
+    auto payloadSize = ByteOrder::swapIfBigEndian ((uint32) payload.getDataSize());
+
+    writeBytes (writePos, &payloadSize, sizeof (payloadSize));
+    writeBytes ((writePos + sizeof (uint32)) % dataSize, payload.getData(), payload.getDataSize());
+
+    header->bytesUsed += (uint32) recordSize;
+    ++header->numEvents;
+    return true;
+}
+
+void AnalyticsEventSpool::readAllEvents (std::deque<AnalyticsEvent>& destination)
+{
+    if (! isOpen())
+        return;
+
+    auto position = (size_t) header->headOffset;
+    auto remaining = (size_t) header->bytesUsed;
+    MemoryBlock payload;
+
+    while (remaining >= sizeof (uint32))
+    {
+        auto payloadSize = (size_t) readRecordSize (position);
+
+        if (sizeof (uint32) + payloadSize > remaining)
+            break;  // damaged spool - salvage what was read so far
+
+        payload.setSize (payloadSize);
+        readBytes ((position + sizeof (uint32)) % dataSize, payload.getData(), payloadSize);
+
+        MemoryInputStream in (payload.getData(), payloadSize, false);
+        AnalyticsEvent event;
+
+        if (! readEventFromStream (in, event))
+            break;
+
+        destination.push_back (std::move (event));
+
+        position = (position + sizeof (uint32) + payloadSize) % dataSize;
+        remaining -= sizeof (uint32) + payloadSize;
+    }
+}
+
+void AnalyticsEventSpool::clear()
+{
+    if (isOpen())
+        initialiseHeader();
+}
+
+int AnalyticsEventSpool::getNumEvents() const noexcept
+{
+    return isOpen() ? (int) header->numEvents : 0;
+}
+
+size_t AnalyticsEventSpool::getNumBytesUsed() const noexcept
+{
+    return isOpen() ? (size_t) header->bytesUsed : 0;
+}
+
+//==============================================================================
+MemoryBlock AnalyticsEventSpool::createCompressedBatch (const Array<AnalyticsEvent>& events)
+{
+    MemoryOutputStream out;
+
+    {
+        GZIPCompressorOutputStream compressed (out);
+        compressed.writeInt (events.size());
+
+        for (auto& event : events)
+            writeEventToStream (compressed, event);
+    }
+
+    return out.getMemoryBlock();
+}
+
+bool AnalyticsEventSpool::parseCompressedBatch (const MemoryBlock& data, Array<AnalyticsEvent>& result)
+{
+    MemoryInputStream source (data.getData(), data.getSize(), false);
+    GZIPDecompressorInputStream decompressed (source);
+
+    auto numEvents = decompressed.readInt();
+
+    if (numEvents < 0)
+        return false;
+
+    for (int i = 0; i < numEvents; ++i)
+    {
+        AnalyticsEvent event;
+
+        if (! readEventFromStream (decompressed, event))
+            return false;
+
+        result.add (std::move (event));
+    }
+
+    return true;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct AnalyticsEventSpoolTests   : public UnitTest
+{
+    AnalyticsEventSpoolTests()
+        : UnitTest ("AnalyticsEventSpool", UnitTestCategories::analytics)
+    {}
+
+    static AnalyticsDestination::AnalyticsEvent makeEvent (int number)
+    {
+        StringPairArray parameters;
+        parameters.set ("index", String (number));
+        parameters.set ("padding", String::repeatedString ("x", 20));
+
+        StringPairArray userProperties;
+        userProperties.set ("plan", "pro");
+
+        return { "event" + String (number), number, (uint32) (1000 + number),
+                 parameters, "TestUser", userProperties };
+    }
+
+    static bool eventsMatch (const AnalyticsDestination::AnalyticsEvent& a,
+                             const AnalyticsDestination::AnalyticsEvent& b)
+    {
+        return a.name == b.name
+            && a.eventType == b.eventType
+            && a.timestamp == b.timestamp
+            && a.parameters == b.parameters
+            && a.userID == b.userID
+            && a.userProperties == b.userProperties;
+    }
+
+    void runTest() override
+    {
+        auto spoolFile = File::createTempFile (".spool");
+
+        beginTest ("Events survive a round trip through the spool file");
+        {
+            AnalyticsEventSpool spool (spoolFile, 4096);
+            expect (spool.open());
+
+            for (int i = 0; i < 10; ++i)
+                expect (spool.appendEvent (makeEvent (i)));
+
+            expectEquals (spool.getNumEvents(), 10);
+
+            std::deque<AnalyticsDestination::AnalyticsEvent> restored;
+            spool.readAllEvents (restored);
+
+            expectEquals ((int) restored.size(), 10);
+
+            for (int i = 0; i < (int) restored.size(); ++i)
+                expect (eventsMatch (restored[(size_t) i], makeEvent (i)));
+        }
+
+        beginTest ("Contents persist across close and reopen");
+        {
+            AnalyticsEventSpool spool (spoolFile, 4096);
+            expect (spool.open());
+            expectEquals (spool.getNumEvents(), 10);
+
+            std::deque<AnalyticsDestination::AnalyticsEvent> restored;
+            spool.readAllEvents (restored);
+            expect (eventsMatch (restored.back(), makeEvent (9)));
+
+            spool.clear();
+            expectEquals (spool.getNumEvents(), 0);
+        }
+
+        beginTest ("A full spool drops its oldest events");
+        {
+            AnalyticsEventSpool spool (spoolFile, 512);
+            expect (spool.open());
+
+            constexpr int numAppended = 50;
+
+            for (int i = 0; i < numAppended; ++i)
+                expect (spool.appendEvent (makeEvent (i)));
+
+            expect (spool.getNumEvents() < numAppended);
+            expect (spool.getNumBytesUsed() <= 512);
+
+            // the survivors should be the most recent events, in order
+            std::deque<AnalyticsDestination::AnalyticsEvent> restored;
+            spool.readAllEvents (restored);
+
+            expectEquals ((int) restored.size(), spool.getNumEvents());
+
+            auto firstSurvivor = numAppended - (int) restored.size();
+
+            for (int i = 0; i < (int) restored.size(); ++i)
+                expect (eventsMatch (restored[(size_t) i], makeEvent (firstSurvivor + i)));
+        }
+
+        beginTest ("Compressed batches expand to the original events");
+        {
+            Array<AnalyticsDestination::AnalyticsEvent> batch;
+
+            for (int i = 0; i < 20; ++i)
+                batch.add (makeEvent (i));
+
+            auto compressed = AnalyticsEventSpool::createCompressedBatch (batch);
+            expect (compressed.getSize() > 0);
+
+            Array<AnalyticsDestination::AnalyticsEvent> expanded;
+            expect (AnalyticsEventSpool::parseCompressedBatch (compressed, expanded));
+
+            expectEquals (expanded.size(), batch.size());
+
+            for (int i = 0; i < expanded.size(); ++i)
+                expect (eventsMatch (expanded.getReference (i), batch.getReference (i)));
+        }
+
+        spoolFile.deleteFile();
+    }
+};
+
+static AnalyticsEventSpoolTests analyticsEventSpoolTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,170 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A bounded, file-backed spool of analytics events.
+
+    This stores events in a fixed-size memory-mapped file laid out as a ring of
+    length-prefixed binary records, so spooling an event costs a small copy into
+    mapped memory - no XML serialisation, and no growth under telemetry bursts.
+    When the file is full, the oldest events are dropped to make room for new
+    ones, so the spool can be left in place indefinitely without competing with
+    the app for memory or disk.
+
+    A typical use is to implement ThreadedAnalyticsDestination's
+    saveUnloggedEvents and restoreUnloggedEvents with a spool, so that events
+    survive restarts without any serialisation spikes on shutdown:
+
+    @code
+    void saveUnloggedEvents (const std::deque<AnalyticsEvent>& events) override
+    {
+        for (auto& event : events)
+            spool.appendEvent (event);
+    }
+
+    void restoreUnloggedEvents (std::deque<AnalyticsEvent>& queue) override
+    {
+        spool.readAllEvents (queue);
+        spool.clear();
+    }
+    @endcode
+
+    There are also helpers for turning a batch of events into a single
+    gzip-compressed blob (and back), for destinations that upload batches over
+    the network.
+
+    Note that this class is not thread safe - like the methods above, use it
+    from one thread at a time.
+
+    @see ThreadedAnalyticsDestination, AnalyticsDestination::AnalyticsEvent
+
+    @tags{Analytics}
+*/
+class JUCE_API  AnalyticsEventSpool
+{
+public:
+    //==============================================================================
+    using AnalyticsEvent = AnalyticsDestination::AnalyticsEvent;
+
+    /** Creates a spool that will use the given file.
+
+        Nothing is touched on disk until open() is called.
+
+        @param fileToUse            the spool file to create or reuse
+        @param maxFileSizeInBytes   the fixed size of the spool file; once full,
+                                    the oldest events are dropped
+    */
+    AnalyticsEventSpool (const File& fileToUse, size_t maxFileSizeInBytes);
+
+    /** Destructor. Unmaps the file, leaving its contents in place for reuse. */
+    ~AnalyticsEventSpool();
+
+    //==============================================================================
+    /** Creates and maps the spool file, re-using any events it already holds.
+
+        If the file exists with the right size and a valid header, its contents
+        are kept; otherwise it's re-initialised as an empty spool.
+
+        @returns false if the file couldn't be created or mapped.
+    */
+    bool open();
+
+    /** Unmaps the spool file, leaving its contents on disk. */
+    void close();
+
+    /** Returns true if the spool file is currently mapped and usable. */
+    bool isOpen() const noexcept                    { return header != nullptr; }
+
+    //==============================================================================
+    /** Appends an event to the spool, dropping the oldest events if the file is full.
+
+        @returns false if the spool isn't open, or if this single event is too
+                 big to ever fit in it.
+    */
+    bool appendEvent (const AnalyticsEvent& event);
+
+    /** Reads every spooled event, in oldest-first order, onto the end of the
+        given queue. The spool itself is left unchanged - call clear() once the
+        events have been safely handed on.
+    */
+    void readAllEvents (std::deque<AnalyticsEvent>& destination);
+
+    /** Removes all events from the spool. */
+    void clear();
+
+    //==============================================================================
+    /** Returns the number of events currently spooled. */
+    int getNumEvents() const noexcept;
+
+    /** Returns the number of bytes of the file currently occupied by records. */
+    size_t getNumBytesUsed() const noexcept;
+
+    //==============================================================================
+    /** Serialises a batch of events into a single gzip-compressed block,
+        suitable for uploading in one network request.
+
+        @see parseCompressedBatch
+    */
+    static MemoryBlock createCompressedBatch (const Array<AnalyticsEvent>& events);
+
+    /** Expands a block created by createCompressedBatch back into events.
+
+        @returns false if the data couldn't be parsed.
+    */
+    static bool parseCompressedBatch (const MemoryBlock& data, Array<AnalyticsEvent>& result);
+
+private:
+    //==============================================================================
+    struct SpoolHeader
+    {
+        uint32 magic, version;
+        uint32 headOffset;   // offset of the oldest record within the data region
+        uint32 bytesUsed;    // total bytes of records currently stored
+        uint32 numEvents;
+    };
+
+    void initialiseHeader() noexcept;
+    bool headerIsValid() const noexcept;
+    void dropOldestEvent() noexcept;
+    void writeBytes (size_t position, const void* source, size_t numBytes) noexcept;
+    void readBytes (size_t position, void* destination, size_t numBytes) const noexcept;
+    uint32 readRecordSize (size_t position) const noexcept;
+
+    //==============================================================================
+    File file;
+    size_t maxFileSize;
+    std::unique_ptr<MemoryMappedFile> map;
+    SpoolHeader* header = nullptr;
+    uint8* data = nullptr;
+    size_t dataSize = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalyticsEventSpool)
+};
+
+} // namespace juce
@@ -42,6 +42,12 @@ void ThreadedAnalyticsDestination::setBatchPeriod (int newBatchPeriodMillisecond
     dispatcher.batchPeriodMilliseconds = newBatchPeriodMilliseconds;
 }
 
+void ThreadedAnalyticsDestination::setMaximumQueueSize (int maxNumEventsToBuffer)
+{
+    const ScopedLock lock (dispatcher.queueAccess);
+    dispatcher.maxQueueSize = maxNumEventsToBuffer;
+}
+
 void ThreadedAnalyticsDestination::logEvent (const AnalyticsEvent& event)
 {
     dispatcher.addToQueue (event);
@@ -137,6 +143,19 @@ void ThreadedAnalyticsDestination::EventDispatcher::run()
 void ThreadedAnalyticsDestination::EventDispatcher::addToQueue (const AnalyticsEvent& event)
 {
     const ScopedLock lock (queueAccess);
+
+    if (maxQueueSize > 0 && (int) eventQueue.size() >= maxQueueSize)
+    {
+        // Drop the oldest event that isn't staged in the current batch, so the
+        // pop_front bookkeeping after a successful submission stays in step.
+        const auto numStagedEvents = eventsToSend.size();
+
+        if ((int) eventQueue.size() > numStagedEvents)
+            eventQueue.erase (eventQueue.begin() + numStagedEvents);
+        else
+            return;  // everything queued is mid-submission, so drop the new event instead
+    }
+
     eventQueue.push_back (event);
 }
 
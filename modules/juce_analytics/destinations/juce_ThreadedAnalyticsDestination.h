@@ -118,6 +118,20 @@ public:
     */
     void setBatchPeriod (int newSubmissionPeriodMilliseconds);
 
+    /**
+        Sets an upper limit on the number of events buffered in memory.
+
+        Once the limit is reached, the oldest unsent event is discarded each
+        time a new one is logged, so a telemetry burst (or an unreachable
+        logging server) can't grow the queue without bound. A limit of 0, the
+        default, means unlimited.
+
+        This method is thread safe.
+
+        @param maxNumEventsToBuffer    the maximum queue length, or 0 for no limit
+    */
+    void setMaximumQueueSize (int maxNumEventsToBuffer);
+
     /**
         Adds an event to the queue, which will ultimately be submitted to
         logBatchedEvents.
@@ -204,6 +218,7 @@ private:
         CriticalSection queueAccess;
 
         Atomic<int> batchPeriodMilliseconds { 1000 };
+        int maxQueueSize = 0;
 
         Array<AnalyticsEvent> eventsToSend;
     };
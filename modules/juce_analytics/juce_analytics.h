@@ -56,5 +56,6 @@
 
 #include "destinations/juce_AnalyticsDestination.h"
 #include "destinations/juce_ThreadedAnalyticsDestination.h"
+#include "destinations/juce_AnalyticsEventSpool.h"
 #include "analytics/juce_Analytics.h"
 #include "analytics/juce_ButtonTracker.h"
@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A pre-allocated arena that provides the channel storage for a set of
+    AudioBuffers.
+
+    When a processing graph is reconfigured, calling AudioBuffer::setSize() on
+    each of its buffers performs one heap allocation per buffer, which is slow
+    and fragments the heap. An arena instead holds one contiguous block, and
+    attach() carves cache-line-aligned channel storage out of it, pointing the
+    buffers at the arena with AudioBuffer::setDataToReferTo().
+
+    The intended pattern is to rebuild all the buffers from scratch on each
+    reconfiguration:
+
+    @code
+    arena.reset();
+
+    for (auto* node : nodes)
+        arena.attach (node->buffer, node->numChannels, blockSize);
+    @endcode
+
+    reset() just rewinds the arena, so once it has grown to the size of the
+    largest configuration seen so far, reconfiguring performs no allocation at
+    all. If the arena does run out of space mid-round, the extra buffers are
+    given their own temporary blocks, and the next reset() folds the total
+    requirement back into the single contiguous arena - so pointers handed out
+    earlier in the round are never invalidated by later growth.
+
+    Each channel starts on a 64-byte boundary, matching the alignment that
+    AudioBuffer's own allocation provides.
+
+    Note that an arena must outlive the buffers attached to it, and resetting
+    it invalidates the contents of all of them.
+
+    @see AudioBuffer, AudioBuffer::setDataToReferTo
+
+    @tags{Audio}
+*/
+template <typename Type>
+class AudioBufferArena
+{
+public:
+    //==============================================================================
+    /** Creates an empty arena, which will grow as buffers are attached. */
+    AudioBufferArena() = default;
+
+    /** Creates an arena with enough space for a given total amount of channel data.
+
+        @param totalNumChannels         the total channel count across all the buffers
+                                        that will be attached per round
+        @param maxNumSamplesPerChannel  the largest block size that will be used
+    */
+    AudioBufferArena (int totalNumChannels, int maxNumSamplesPerChannel)
+    {
+        ensureCapacity (totalNumChannels, maxNumSamplesPerChannel);
+    }
+
+    //==============================================================================
+    /** Makes sure the arena can provide at least this much channel data per round
+        without having to grow.
+
+        Call this up-front if the total size of the graph is known, so that not
+        even the first round of attachments has to allocate.
+    */
+    void ensureCapacity (int totalNumChannels, int maxNumSamplesPerChannel)
+    {
+        jassert (totalNumChannels >= 0 && maxNumSamplesPerChannel >= 0);
+        jassert (bytesUsed == 0); // growing mid-round would invalidate attached buffers -
+                                  // reserve space before attaching anything!
+
+        auto newCapacity = (size_t) totalNumChannels * getAlignedBytesPerChannel (maxNumSamplesPerChannel);
+
+        if (capacity < newCapacity)
+        {
+            arena.allocate (newCapacity, false);
+            capacity = newCapacity;
+        }
+    }
+
+    /** Rewinds the arena, reclaiming all the space handed out since the last reset.
+
+        This invalidates the contents of every buffer that is currently attached,
+        so only call it when you're about to re-attach them all - typically at the
+        start of a prepare-to-play pass.
+    */
+    void reset()
+    {
+        // if the last round overflowed, consolidate the whole requirement into
+        // the single contiguous block for next time
+        if (! overflowBlocks.isEmpty())
+        {
+            overflowBlocks.clear();
+
+            if (capacity < highWaterMark)
+            {
+                arena.allocate (highWaterMark, false);
+                capacity = highWaterMark;
+            }
+        }
+
+        bytesUsed = 0;
+        highWaterMark = 0;
+    }
+
+    //==============================================================================
+    /** Carves channel storage for a buffer out of the arena, and points the buffer at it.
+
+        The buffer's existing allocation (if any) is released, and it is resized
+        to the given shape referring to arena memory. The new contents are
+        uninitialised - clear the buffer if you need silence.
+    */
+    void attach (AudioBuffer<Type>& buffer, int numChannels, int numSamples)
+    {
+        jassert (numChannels >= 0 && numSamples >= 0);
+
+        auto bytesPerChannel = getAlignedBytesPerChannel (numSamples);
+        auto totalBytes = (size_t) numChannels * bytesPerChannel;
+        char* base;
+
+        if (bytesUsed + totalBytes <= capacity)
+        {
+            base = arena + bytesUsed;
+            bytesUsed += totalBytes;
+        }
+        else
+        {
+            // ran out of space - give this buffer its own block for now, and
+            // let the next reset() grow the arena to cover it
+            base = overflowBlocks.add (new OverflowBlock (totalBytes))->data;
+        }
+
+        highWaterMark += totalBytes;
+
+        channelPointers.clearQuick();
+
+        for (int i = 0; i < numChannels; ++i)
+            channelPointers.add (unalignedPointerCast<Type*> (base + (size_t) i * bytesPerChannel));
+
+        buffer.setDataToReferTo (channelPointers.getRawDataPointer(), numChannels, numSamples);
+    }
+
+    //==============================================================================
+    /** Returns the size of the arena's contiguous block, in bytes. */
+    size_t getCapacityInBytes() const noexcept      { return capacity; }
+
+    /** Returns the number of bytes handed out since the last reset(). */
+    size_t getBytesUsed() const noexcept            { return bytesUsed; }
+
+private:
+    //==============================================================================
+    static constexpr size_t channelAlignmentBytes = 64;
+
+    static size_t getAlignedBytesPerChannel (int numSamples) noexcept
+    {
+        return ((size_t) numSamples * sizeof (Type) + channelAlignmentBytes - 1)
+                  / channelAlignmentBytes * channelAlignmentBytes;
+    }
+
+    struct OverflowBlock
+    {
+        explicit OverflowBlock (size_t numBytes)  { data.allocate (numBytes, false); }
+
+        HeapBlock<char, false, channelAlignmentBytes> data;
+    };
+
+    HeapBlock<char, false, channelAlignmentBytes> arena;
+    size_t capacity = 0, bytesUsed = 0, highWaterMark = 0;
+    OwnedArray<OverflowBlock> overflowBlocks;
+    Array<Type*> channelPointers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioBufferArena)
+};
+
+} // namespace juce
@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct AudioBufferArenaTests  : public UnitTest
+{
+    AudioBufferArenaTests()  : UnitTest ("AudioBufferArena", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        beginTest ("Channels are 64-byte aligned and usable");
+        {
+            AudioBufferArena<float> arena;
+            AudioBuffer<float> buffer;
+            arena.attach (buffer, 3, 100);
+
+            expectEquals (buffer.getNumChannels(), 3);
+            expectEquals (buffer.getNumSamples(), 100);
+
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                expect (isAligned (buffer.getReadPointer (ch)));
+
+            buffer.clear();
+            buffer.setSample (2, 99, 0.5f);
+            expectEquals (buffer.getSample (2, 99), 0.5f);
+            expectEquals (buffer.getSample (0, 0), 0.0f);
+        }
+
+        beginTest ("Pre-sized arena hands out stable storage without growing");
+        {
+            AudioBufferArena<float> arena (8, 512);
+            auto capacity = arena.getCapacityInBytes();
+
+            AudioBuffer<float> buffers[3];
+            const float* firstRound[3];
+
+            arena.attach (buffers[0], 2, 512);
+            arena.attach (buffers[1], 4, 512);
+            arena.attach (buffers[2], 2, 256);
+
+            for (int i = 0; i < 3; ++i)
+                firstRound[i] = buffers[i].getReadPointer (0);
+
+            // re-attaching after a reset should reuse exactly the same storage
+            arena.reset();
+            arena.attach (buffers[0], 2, 512);
+            arena.attach (buffers[1], 4, 512);
+            arena.attach (buffers[2], 2, 256);
+
+            for (int i = 0; i < 3; ++i)
+                expect (buffers[i].getReadPointer (0) == firstRound[i]);
+
+            expect (arena.getCapacityInBytes() == capacity);
+        }
+
+        beginTest ("Overflow is absorbed by the next reset");
+        {
+            AudioBufferArena<float> arena (1, 64);
+
+            AudioBuffer<float> a, b, c;
+            arena.attach (a, 1, 64);
+            arena.attach (b, 2, 64);   // doesn't fit - overflows
+            arena.attach (c, 1, 64);   // also overflows
+
+            // the overflowing buffers must still be distinct, aligned and usable
+            expect (isAligned (b.getReadPointer (0)));
+            expect (isAligned (c.getReadPointer (0)));
+            expect (b.getReadPointer (0) != a.getReadPointer (0));
+
+            b.clear();
+            c.clear();
+            b.setSample (1, 3, 0.25f);
+            expectEquals (b.getSample (1, 3), 0.25f);
+            expectEquals (c.getSample (0, 3), 0.0f);
+
+            // after a reset, the same set of attachments should fit contiguously
+            arena.reset();
+            arena.attach (a, 1, 64);
+            arena.attach (b, 2, 64);
+            arena.attach (c, 1, 64);
+
+            auto capacity = arena.getCapacityInBytes();
+            expect (arena.getBytesUsed() <= capacity);
+
+            arena.reset();
+            expect (arena.getBytesUsed() == 0);
+            expect (arena.getCapacityInBytes() == capacity);
+        }
+    }
+
+    static bool isAligned (const void* p) noexcept
+    {
+        return reinterpret_cast<uintptr_t> (p) % 64 == 0;
+    }
+};
+
+static AudioBufferArenaTests audioBufferArenaTests;
+
+} // namespace juce
@@ -326,40 +326,79 @@ AudioChannelSet AudioChannelSet::fromAbbreviatedString (const String& str)
     return set;
 }
 
+//==============================================================================
+struct AudioChannelSetHelpers
+{
+    /** A precomputed standard layout, so table lookups can replace rebuilding
+        every named set whenever layouts are being matched up.
+    */
+    struct LayoutDescriptor
+    {
+        LayoutDescriptor (AudioChannelSet setToUse, const char* desc)
+            : set (std::move (setToUse)), description (desc), numChannels (set.size())
+        {}
+
+        AudioChannelSet set;
+        const char* description;
+        int numChannels;
+    };
+
+    /** Returns descriptors for all the standard named layouts.
+
+        Layouts with the same channel count are ordered by preference: the
+        first match for a given count is the one bus negotiation should offer
+        first, which keeps channelSetsWithNumberOfChannels() stable.
+    */
+    static const Array<LayoutDescriptor>& getStandardLayouts()
+    {
+        static const Array<LayoutDescriptor> layouts = []
+        {
+            Array<LayoutDescriptor> result;
+            result.ensureStorageAllocated (27);
+
+            result.add ({ AudioChannelSet::mono(),                "Mono" });
+            result.add ({ AudioChannelSet::stereo(),              "Stereo" });
+            result.add ({ AudioChannelSet::createLCR(),           "LCR" });
+            result.add ({ AudioChannelSet::createLRS(),           "LRS" });
+            result.add ({ AudioChannelSet::quadraphonic(),        "Quadraphonic" });
+            result.add ({ AudioChannelSet::createLCRS(),          "LCRS" });
+            result.add ({ AudioChannelSet::create5point0(),       "5.0 Surround" });
+            result.add ({ AudioChannelSet::pentagonal(),          "Pentagonal" });
+            result.add ({ AudioChannelSet::create5point1(),       "5.1 Surround" });
+            result.add ({ AudioChannelSet::create6point0(),       "6.0 Surround" });
+            result.add ({ AudioChannelSet::create6point0Music(),  "6.0 (Music) Surround" });
+            result.add ({ AudioChannelSet::hexagonal(),           "Hexagonal" });
+            result.add ({ AudioChannelSet::create7point0(),       "7.0 Surround" });
+            result.add ({ AudioChannelSet::create7point0SDDS(),   "7.0 Surround SDDS" });
+            result.add ({ AudioChannelSet::create6point1(),       "6.1 Surround" });
+            result.add ({ AudioChannelSet::create6point1Music(),  "6.1 (Music) Surround" });
+            result.add ({ AudioChannelSet::create7point1(),       "7.1 Surround" });
+            result.add ({ AudioChannelSet::create7point1SDDS(),   "7.1 Surround SDDS" });
+            result.add ({ AudioChannelSet::octagonal(),           "Octagonal" });
+            result.add ({ AudioChannelSet::create5point1point2(), "5.1.2 Surround" });
+            result.add ({ AudioChannelSet::create7point0point2(), "7.0.2 Surround" });
+            result.add ({ AudioChannelSet::create5point1point4(), "5.1.4 Surround" });
+            result.add ({ AudioChannelSet::create7point1point2(), "7.1.2 Surround" });
+            result.add ({ AudioChannelSet::create7point0point4(), "7.0.4 Surround" });
+            result.add ({ AudioChannelSet::create7point1point4(), "7.1.4 Surround" });
+            result.add ({ AudioChannelSet::create7point1point6(), "7.1.6 Surround" });
+            result.add ({ AudioChannelSet::create9point1point6(), "9.1.6 Surround" });
+
+            return result;
+        }();
+
+        return layouts;
+    }
+};
+
 String AudioChannelSet::getDescription() const
 {
     if (isDiscreteLayout())            return "Discrete #" + String (size());
     if (*this == disabled())           return "Disabled";
-    if (*this == mono())               return "Mono";
-    if (*this == stereo())             return "Stereo";
-
-    if (*this == createLCR())          return "LCR";
-    if (*this == createLRS())          return "LRS";
-    if (*this == createLCRS())         return "LCRS";
-
-    if (*this == create5point0())       return "5.0 Surround";
-    if (*this == create5point1())       return "5.1 Surround";
-    if (*this == create5point1point2()) return "5.1.2 Surround";
-    if (*this == create5point1point4()) return "5.1.4 Surround";
-    if (*this == create6point0())       return "6.0 Surround";
-    if (*this == create6point1())       return "6.1 Surround";
-    if (*this == create6point0Music())  return "6.0 (Music) Surround";
-    if (*this == create6point1Music())  return "6.1 (Music) Surround";
-    if (*this == create7point0())       return "7.0 Surround";
-    if (*this == create7point1())       return "7.1 Surround";
-    if (*this == create7point0SDDS())   return "7.0 Surround SDDS";
-    if (*this == create7point1SDDS())   return "7.1 Surround SDDS";
-    if (*this == create7point0point2()) return "7.0.2 Surround";
-    if (*this == create7point0point4()) return "7.0.4 Surround";
-    if (*this == create7point1point2()) return "7.1.2 Surround";
-    if (*this == create7point1point4()) return "7.1.4 Surround";
-    if (*this == create7point1point6()) return "7.1.6 Surround";
-    if (*this == create9point1point6()) return "9.1.6 Surround";
-
-    if (*this == quadraphonic())       return "Quadraphonic";
-    if (*this == pentagonal())         return "Pentagonal";
-    if (*this == hexagonal())          return "Hexagonal";
-    if (*this == octagonal())          return "Octagonal";
+
+    for (auto& layout : AudioChannelSetHelpers::getStandardLayouts())
+        if (*this == layout.set)
+            return layout.description;
 
     // ambisonics
     {
@@ -400,27 +439,47 @@ int AudioChannelSet::size() const noexcept
 
 AudioChannelSet::ChannelType AudioChannelSet::getTypeOfChannel (int index) const noexcept
 {
-    int bit = channels.findNextSetBit(0);
+    index = jmax (0, index);
 
-    for (int i = 0; i < index && bit >= 0; ++i)
-        bit = channels.findNextSetBit (bit + 1);
+    // Whole words of the mask can be skipped by counting their set bits,
+    // so only the word actually containing the channel needs a bit scan.
+    for (int start = 0, highest = channels.getHighestBit(); start <= highest; start += 32)
+    {
+        auto word = channels.getBitRangeAsInt (start, 32);
+        auto numSetInWord = countNumberOfBits (word);
+
+        if (index < numSetInWord)
+        {
+            for (int bit = start;; ++bit)
+            {
+                if ((word & 1u) != 0 && index-- == 0)
+                    return static_cast<ChannelType> (bit);
 
-    return static_cast<ChannelType> (bit);
+                word >>= 1;
+            }
+        }
+
+        index -= numSetInWord;
+    }
+
+    return static_cast<ChannelType> (-1);
 }
 
 int AudioChannelSet::getChannelIndexForType (AudioChannelSet::ChannelType type) const noexcept
 {
-    int idx = 0;
+    const int bit = static_cast<int> (type);
 
-    for (int bit = channels.findNextSetBit (0); bit >= 0; bit = channels.findNextSetBit (bit + 1))
-    {
-        if (static_cast<ChannelType> (bit) == type)
-            return idx;
+    if (! channels[bit])
+        return -1;
 
-        idx++;
-    }
+    // The index is just the number of channels below this one in the mask,
+    // which can be counted a word at a time.
+    int index = 0;
 
-    return -1;
+    for (int start = 0; start < bit; start += 32)
+        index += countNumberOfBits (channels.getBitRangeAsInt (start, jmin (32, bit - start)));
+
+    return index;
 }
 
 Array<AudioChannelSet::ChannelType> AudioChannelSet::getChannelTypes() const
@@ -544,55 +603,9 @@ Array<AudioChannelSet> AudioChannelSet::channelSetsWithNumberOfChannels (int num
     {
         retval.add (AudioChannelSet::discreteChannels (numChannels));
 
-        retval.addArray ([numChannels]() -> Array<AudioChannelSet>
-        {
-            switch (numChannels)
-            {
-                case 1:
-                    return { AudioChannelSet::mono() };
-                case 2:
-                    return { AudioChannelSet::stereo() };
-                case 3:
-                    return { AudioChannelSet::createLCR(),
-                             AudioChannelSet::createLRS() };
-                case 4:
-                    return { AudioChannelSet::quadraphonic(),
-                             AudioChannelSet::createLCRS() };
-                case 5:
-                    return { AudioChannelSet::create5point0(),
-                             AudioChannelSet::pentagonal() };
-                case 6:
-                    return { AudioChannelSet::create5point1(),
-                             AudioChannelSet::create6point0(),
-                             AudioChannelSet::create6point0Music(),
-                             AudioChannelSet::hexagonal() };
-                case 7:
-                    return { AudioChannelSet::create7point0(),
-                             AudioChannelSet::create7point0SDDS(),
-                             AudioChannelSet::create6point1(),
-                             AudioChannelSet::create6point1Music() };
-                case 8:
-                    return { AudioChannelSet::create7point1(),
-                             AudioChannelSet::create7point1SDDS(),
-                             AudioChannelSet::octagonal(),
-                             AudioChannelSet::create5point1point2() };
-                case 9:
-                    return { AudioChannelSet::create7point0point2() };
-                case 10:
-                    return { AudioChannelSet::create5point1point4(),
-                             AudioChannelSet::create7point1point2() };
-                case 11:
-                    return { AudioChannelSet::create7point0point4() };
-                case 12:
-                    return { AudioChannelSet::create7point1point4() };
-                case 14:
-                    return { AudioChannelSet::create7point1point6() };
-                case 16:
-                    return { AudioChannelSet::create9point1point6() };
-            }
-
-            return {};
-        }());
+        for (auto& layout : AudioChannelSetHelpers::getStandardLayouts())
+            if (layout.numChannels == numChannels)
+                retval.add (layout.set);
 
         auto order = getAmbisonicOrderForNumChannels (numChannels);
         if (order >= 0)
@@ -672,6 +685,27 @@ public:
             }
         }
 
+        beginTest ("Channel indices and membership agree with the channel list");
+        {
+            for (auto ch = 1; ch <= max; ++ch)
+            {
+                for (auto set : AudioChannelSet::channelSetsWithNumberOfChannels (ch))
+                {
+                    auto types = set.getChannelTypes();
+
+                    for (int i = 0; i < types.size(); ++i)
+                    {
+                        expect (set.contains (types[i]));
+                        expect (set.getChannelIndexForType (types[i]) == i);
+                        expect (set.getTypeOfChannel (i) == types[i]);
+                    }
+
+                    expect (! set.contains (AudioChannelSet::unknown));
+                    expect (set.getChannelIndexForType (AudioChannelSet::unknown) == -1);
+                }
+            }
+        }
+
         beginTest ("Ambisonics");
         {
             uint64 mask = 0;
@@ -454,6 +454,10 @@ public:
         Will return -1 if the this set does not contain a channel of this type. */
     int getChannelIndexForType (ChannelType type) const noexcept;
 
+    /** Returns true if the set contains a channel of the given type.
+        This is a constant-time check on the underlying channel mask. */
+    bool contains (ChannelType type) const noexcept     { return channels[static_cast<int> (type)]; }
+
     /** Returns a string containing a whitespace-separated list of speaker types
         corresponding to each channel. For example in a 5.1 arrangement,
         the string may be "L R C Lfe Ls Rs". If the speaker arrangement is unknown,
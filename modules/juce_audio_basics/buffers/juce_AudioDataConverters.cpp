@@ -431,6 +431,459 @@ void AudioDataConverters::convertFormatToFloat (DataFormat sourceFormat, const v
     }
 }
 
+//==============================================================================
+namespace AudioDataInterleaveHelpers
+{
+    template <typename T>
+    static void interleaveScalar (const T* const* src, T* dst, int numChannels, int numSamples) noexcept
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* s = src[ch];
+            auto* d = dst + ch;
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                *d = s[i];
+                d += numChannels;
+            }
+        }
+    }
+
+    template <typename T>
+    static void deinterleaveScalar (const T* src, T* const* dst, int numChannels, int numSamples) noexcept
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* s = src + ch;
+            auto* d = dst[ch];
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                d[i] = *s;
+                s += numChannels;
+            }
+        }
+    }
+
+    static void interleave32 (const uint32* const* src, uint32* dst, int numChannels, int numSamples) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS
+        auto* d = reinterpret_cast<float*> (dst);
+
+        if (numChannels == 2)
+        {
+            auto* s0 = reinterpret_cast<const float*> (src[0]);
+            auto* s1 = reinterpret_cast<const float*> (src[1]);
+            int i = 0;
+
+            for (; i <= numSamples - 4; i += 4)
+            {
+                auto a = _mm_loadu_ps (s0 + i);
+                auto b = _mm_loadu_ps (s1 + i);
+                _mm_storeu_ps (d + 2 * i,     _mm_unpacklo_ps (a, b));
+                _mm_storeu_ps (d + 2 * i + 4, _mm_unpackhi_ps (a, b));
+            }
+
+            for (; i < numSamples; ++i)
+            {
+                dst[2 * i]     = src[0][i];
+                dst[2 * i + 1] = src[1][i];
+            }
+
+            return;
+        }
+
+        if (numChannels >= 4)
+        {
+            int ch = 0;
+
+            // 4 channels x 4 frames at a time: four consecutive channels of one
+            // frame are contiguous in the interleaved output, so a 4x4 register
+            // transpose turns channel-major loads into frame-major stores.
+            for (; ch <= numChannels - 4; ch += 4)
+            {
+                auto* s0 = reinterpret_cast<const float*> (src[ch]);
+                auto* s1 = reinterpret_cast<const float*> (src[ch + 1]);
+                auto* s2 = reinterpret_cast<const float*> (src[ch + 2]);
+                auto* s3 = reinterpret_cast<const float*> (src[ch + 3]);
+                int i = 0;
+
+                for (; i <= numSamples - 4; i += 4)
+                {
+                    auto r0 = _mm_loadu_ps (s0 + i);
+                    auto r1 = _mm_loadu_ps (s1 + i);
+                    auto r2 = _mm_loadu_ps (s2 + i);
+                    auto r3 = _mm_loadu_ps (s3 + i);
+                    _MM_TRANSPOSE4_PS (r0, r1, r2, r3);
+
+                    auto* frame = d + (size_t) i * (size_t) numChannels + (size_t) ch;
+                    _mm_storeu_ps (frame, r0);
+                    _mm_storeu_ps (frame + numChannels, r1);
+                    _mm_storeu_ps (frame + 2 * numChannels, r2);
+                    _mm_storeu_ps (frame + 3 * numChannels, r3);
+                }
+
+                for (; i < numSamples; ++i)
+                    for (int j = 0; j < 4; ++j)
+                        dst[(size_t) i * (size_t) numChannels + (size_t) (ch + j)] = src[ch + j][i];
+            }
+
+            for (; ch < numChannels; ++ch)
+                for (int i = 0; i < numSamples; ++i)
+                    dst[(size_t) i * (size_t) numChannels + (size_t) ch] = src[ch][i];
+
+            return;
+        }
+       #elif JUCE_USE_ARM_NEON
+        if (numChannels == 2)
+        {
+            int i = 0;
+
+            for (; i <= numSamples - 4; i += 4)
+            {
+                uint32x4x2_t v { { vld1q_u32 (src[0] + i), vld1q_u32 (src[1] + i) } };
+                vst2q_u32 (dst + 2 * i, v);
+            }
+
+            for (; i < numSamples; ++i)
+            {
+                dst[2 * i]     = src[0][i];
+                dst[2 * i + 1] = src[1][i];
+            }
+
+            return;
+        }
+
+        if (numChannels == 4)
+        {
+            int i = 0;
+
+            for (; i <= numSamples - 4; i += 4)
+            {
+                uint32x4x4_t v { { vld1q_u32 (src[0] + i), vld1q_u32 (src[1] + i),
+                                   vld1q_u32 (src[2] + i), vld1q_u32 (src[3] + i) } };
+                vst4q_u32 (dst + 4 * i, v);
+            }
+
+            for (; i < numSamples; ++i)
+                for (int j = 0; j < 4; ++j)
+                    dst[4 * i + j] = src[j][i];
+
+            return;
+        }
+       #endif
+
+        interleaveScalar (src, dst, numChannels, numSamples);
+    }
+
+    static void deinterleave32 (const uint32* src, uint32* const* dst, int numChannels, int numSamples) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS
+        auto* s = reinterpret_cast<const float*> (src);
+
+        if (numChannels == 2)
+        {
+            auto* d0 = reinterpret_cast<float*> (dst[0]);
+            auto* d1 = reinterpret_cast<float*> (dst[1]);
+            int i = 0;
+
+            for (; i <= numSamples - 4; i += 4)
+            {
+                auto a = _mm_loadu_ps (s + 2 * i);
+                auto b = _mm_loadu_ps (s + 2 * i + 4);
+                _mm_storeu_ps (d0 + i, _mm_shuffle_ps (a, b, _MM_SHUFFLE (2, 0, 2, 0)));
+                _mm_storeu_ps (d1 + i, _mm_shuffle_ps (a, b, _MM_SHUFFLE (3, 1, 3, 1)));
+            }
+
+            for (; i < numSamples; ++i)
+            {
+                dst[0][i] = src[2 * i];
+                dst[1][i] = src[2 * i + 1];
+            }
+
+            return;
+        }
+
+        if (numChannels >= 4)
+        {
+            int ch = 0;
+
+            for (; ch <= numChannels - 4; ch += 4)
+            {
+                auto* d0 = reinterpret_cast<float*> (dst[ch]);
+                auto* d1 = reinterpret_cast<float*> (dst[ch + 1]);
+                auto* d2 = reinterpret_cast<float*> (dst[ch + 2]);
+                auto* d3 = reinterpret_cast<float*> (dst[ch + 3]);
+                int i = 0;
+
+                for (; i <= numSamples - 4; i += 4)
+                {
+                    auto* frame = s + (size_t) i * (size_t) numChannels + (size_t) ch;
+                    auto r0 = _mm_loadu_ps (frame);
+                    auto r1 = _mm_loadu_ps (frame + numChannels);
+                    auto r2 = _mm_loadu_ps (frame + 2 * numChannels);
+                    auto r3 = _mm_loadu_ps (frame + 3 * numChannels);
+                    _MM_TRANSPOSE4_PS (r0, r1, r2, r3);
+
+                    _mm_storeu_ps (d0 + i, r0);
+                    _mm_storeu_ps (d1 + i, r1);
+                    _mm_storeu_ps (d2 + i, r2);
+                    _mm_storeu_ps (d3 + i, r3);
+                }
+
+                for (; i < numSamples; ++i)
+                    for (int j = 0; j < 4; ++j)
+                        dst[ch + j][i] = src[(size_t) i * (size_t) numChannels + (size_t) (ch + j)];
+            }
+
+            for (; ch < numChannels; ++ch)
+                for (int i = 0; i < numSamples; ++i)
+                    dst[ch][i] = src[(size_t) i * (size_t) numChannels + (size_t) ch];
+
+            return;
+        }
+       #elif JUCE_USE_ARM_NEON
+        if (numChannels == 2)
+        {
+            int i = 0;
+
+            for (; i <= numSamples - 4; i += 4)
+            {
+                auto v = vld2q_u32 (src + 2 * i);
+                vst1q_u32 (dst[0] + i, v.val[0]);
+                vst1q_u32 (dst[1] + i, v.val[1]);
+            }
+
+            for (; i < numSamples; ++i)
+            {
+                dst[0][i] = src[2 * i];
+                dst[1][i] = src[2 * i + 1];
+            }
+
+            return;
+        }
+
+        if (numChannels == 4)
+        {
+            int i = 0;
+
+            for (; i <= numSamples - 4; i += 4)
+            {
+                auto v = vld4q_u32 (src + 4 * i);
+
+                for (int j = 0; j < 4; ++j)
+                    vst1q_u32 (dst[j] + i, v.val[j]);
+            }
+
+            for (; i < numSamples; ++i)
+                for (int j = 0; j < 4; ++j)
+                    dst[j][i] = src[4 * i + j];
+
+            return;
+        }
+       #endif
+
+        deinterleaveScalar (src, dst, numChannels, numSamples);
+    }
+
+    static void interleave16 (const uint16* const* src, uint16* dst, int numChannels, int numSamples) noexcept
+    {
+        if (numChannels == 2)
+        {
+            int i = 0;
+
+           #if JUCE_USE_SSE_INTRINSICS
+            for (; i <= numSamples - 8; i += 8)
+            {
+                auto a = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src[0] + i));
+                auto b = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src[1] + i));
+                _mm_storeu_si128 (reinterpret_cast<__m128i*> (dst + 2 * i),     _mm_unpacklo_epi16 (a, b));
+                _mm_storeu_si128 (reinterpret_cast<__m128i*> (dst + 2 * i + 8), _mm_unpackhi_epi16 (a, b));
+            }
+           #elif JUCE_USE_ARM_NEON
+            for (; i <= numSamples - 8; i += 8)
+            {
+                uint16x8x2_t v { { vld1q_u16 (src[0] + i), vld1q_u16 (src[1] + i) } };
+                vst2q_u16 (dst + 2 * i, v);
+            }
+           #endif
+
+            for (; i < numSamples; ++i)
+            {
+                dst[2 * i]     = src[0][i];
+                dst[2 * i + 1] = src[1][i];
+            }
+
+            return;
+        }
+
+        interleaveScalar (src, dst, numChannels, numSamples);
+    }
+
+    static void deinterleave16 (const uint16* src, uint16* const* dst, int numChannels, int numSamples) noexcept
+    {
+       #if JUCE_USE_ARM_NEON
+        if (numChannels == 2)
+        {
+            int i = 0;
+
+            for (; i <= numSamples - 8; i += 8)
+            {
+                auto v = vld2q_u16 (src + 2 * i);
+                vst1q_u16 (dst[0] + i, v.val[0]);
+                vst1q_u16 (dst[1] + i, v.val[1]);
+            }
+
+            for (; i < numSamples; ++i)
+            {
+                dst[0][i] = src[2 * i];
+                dst[1][i] = src[2 * i + 1];
+            }
+
+            return;
+        }
+       #endif
+
+        deinterleaveScalar (src, dst, numChannels, numSamples);
+    }
+
+    static void interleaveBytes (const char* const* src, char* dst, int numChannels, int numSamples, int bytesPerSample) noexcept
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* s = src[ch];
+            auto* d = dst + (size_t) ch * (size_t) bytesPerSample;
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                memcpy (d, s, (size_t) bytesPerSample);
+                s += bytesPerSample;
+                d += (size_t) numChannels * (size_t) bytesPerSample;
+            }
+        }
+    }
+
+    static void deinterleaveBytes (const char* src, char* const* dst, int numChannels, int numSamples, int bytesPerSample) noexcept
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* s = src + (size_t) ch * (size_t) bytesPerSample;
+            auto* d = dst[ch];
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                memcpy (d, s, (size_t) bytesPerSample);
+                s += (size_t) numChannels * (size_t) bytesPerSample;
+                d += bytesPerSample;
+            }
+        }
+    }
+}
+
+void AudioData::interleaveDirect (const void* const* source, int numSourceChannels,
+                                  void* dest, int numDestChannels,
+                                  int numSamples, int bytesPerSample) noexcept
+{
+    using namespace AudioDataInterleaveHelpers;
+
+    jassert (numSourceChannels >= numDestChannels);
+
+    if (numSamples <= 0 || numDestChannels <= 0)
+        return;
+
+    bool allChannelsPresent = true;
+
+    for (int i = 0; i < numDestChannels && allChannelsPresent; ++i)
+        allChannelsPresent = source[i] != nullptr;
+
+    if (allChannelsPresent)
+    {
+        if (numDestChannels == 1)
+        {
+            memcpy (dest, source[0], (size_t) numSamples * (size_t) bytesPerSample);
+            return;
+        }
+
+        switch (bytesPerSample)
+        {
+            case 4:   interleave32 (reinterpret_cast<const uint32* const*> (source), static_cast<uint32*> (dest), numDestChannels, numSamples); return;
+            case 2:   interleave16 (reinterpret_cast<const uint16* const*> (source), static_cast<uint16*> (dest), numDestChannels, numSamples); return;
+            default:  interleaveBytes (reinterpret_cast<const char* const*> (source), static_cast<char*> (dest), numDestChannels, numSamples, bytesPerSample); return;
+        }
+    }
+
+    // Mirrors the templated per-channel loop's handling of null source
+    // channels: copying stops advancing through the source array at the first
+    // null entry, and the corresponding destination channels are left alone.
+    auto src = reinterpret_cast<const char* const*> (source);
+
+    for (int i = 0; i < numDestChannels; ++i)
+    {
+        if (*src == nullptr)
+            continue;
+
+        auto* s = *src++;
+        auto* d = static_cast<char*> (dest) + (size_t) i * (size_t) bytesPerSample;
+
+        for (int j = 0; j < numSamples; ++j)
+        {
+            memcpy (d, s, (size_t) bytesPerSample);
+            s += bytesPerSample;
+            d += (size_t) numDestChannels * (size_t) bytesPerSample;
+        }
+    }
+}
+
+void AudioData::deinterleaveDirect (const void* source, int numSourceChannels,
+                                    void* const* dest, int numDestChannels,
+                                    int numSamples, int bytesPerSample) noexcept
+{
+    using namespace AudioDataInterleaveHelpers;
+
+    jassert (numSourceChannels >= numDestChannels);
+
+    if (numSamples <= 0 || numDestChannels <= 0)
+        return;
+
+    bool allChannelsPresent = true;
+
+    for (int i = 0; i < numDestChannels && allChannelsPresent; ++i)
+        allChannelsPresent = dest[i] != nullptr;
+
+    if (allChannelsPresent && numSourceChannels == numDestChannels)
+    {
+        if (numDestChannels == 1)
+        {
+            memcpy (dest[0], source, (size_t) numSamples * (size_t) bytesPerSample);
+            return;
+        }
+
+        switch (bytesPerSample)
+        {
+            case 4:   deinterleave32 (static_cast<const uint32*> (source), reinterpret_cast<uint32* const*> (dest), numDestChannels, numSamples); return;
+            case 2:   deinterleave16 (static_cast<const uint16*> (source), reinterpret_cast<uint16* const*> (dest), numDestChannels, numSamples); return;
+            default:  deinterleaveBytes (static_cast<const char*> (source), reinterpret_cast<char* const*> (dest), numDestChannels, numSamples, bytesPerSample); return;
+        }
+    }
+
+    for (int i = 0; i < numDestChannels; ++i)
+    {
+        if (auto* channelDest = reinterpret_cast<char* const*> (dest)[i])
+        {
+            auto* s = static_cast<const char*> (source) + (size_t) i * (size_t) bytesPerSample;
+            auto* d = channelDest;
+
+            for (int j = 0; j < numSamples; ++j)
+            {
+                memcpy (d, s, (size_t) bytesPerSample);
+                s += (size_t) numSourceChannels * (size_t) bytesPerSample;
+                d += bytesPerSample;
+            }
+        }
+    }
+}
+
 //==============================================================================
 void AudioDataConverters::interleaveSamples (const float** source, float* dest, int numSamples, int numChannels)
 {
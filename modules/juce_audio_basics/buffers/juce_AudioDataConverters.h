@@ -663,6 +663,8 @@ private:
         using ElementType = std::remove_pointer_t<decltype (DataFormat::data)>;
         using ChannelType = std::conditional_t<IsConst, const ElementType*, ElementType*>;
         using DataType = std::conditional_t<IsInterleaved, ChannelType, ChannelType*>;
+        using DataFormatType = DataFormat;
+        using EndiannessType = Endianness;
         using PointerType = Pointer<DataFormat,
                                     Endianness,
                                     std::conditional_t<IsInterleaved, Interleaved, NonInterleaved>,
@@ -672,9 +674,11 @@ private:
     template <bool IsInterleaved, bool IsConst, typename DataFormat, typename Endianness>
     struct ChannelDataSubtypes<IsInterleaved, IsConst, Format<DataFormat, Endianness>>
     {
-        using Subtypes    = ChannelDataSubtypes<IsInterleaved, IsConst, DataFormat, Endianness>;
-        using DataType    = typename Subtypes::DataType;
-        using PointerType = typename Subtypes::PointerType;
+        using Subtypes       = ChannelDataSubtypes<IsInterleaved, IsConst, DataFormat, Endianness>;
+        using DataType       = typename Subtypes::DataType;
+        using DataFormatType = typename Subtypes::DataFormatType;
+        using EndiannessType = typename Subtypes::EndiannessType;
+        using PointerType    = typename Subtypes::PointerType;
     };
 
     template <bool IsInterleaved, bool IsConst, typename... Format>
@@ -688,6 +692,30 @@ private:
         int channels;
     };
 
+    //==============================================================================
+    // These handle the case where no per-sample format conversion is needed, by
+    // shuffling the raw sample data with vectorised kernels where possible. They
+    // are implemented in juce_AudioDataConverters.cpp.
+    static void interleaveDirect (const void* const* source, int numSourceChannels,
+                                  void* dest, int numDestChannels,
+                                  int numSamples, int bytesPerSample) noexcept;
+
+    static void deinterleaveDirect (const void* source, int numSourceChannels,
+                                    void* const* dest, int numDestChannels,
+                                    int numSamples, int bytesPerSample) noexcept;
+
+    template <typename Source, typename Dest>
+    struct CanShuffleDirectly
+    {
+        enum
+        {
+            value = std::is_same<typename Source::Subtypes::DataFormatType,
+                                 typename Dest::Subtypes::DataFormatType>::value
+                 && std::is_same<typename Source::Subtypes::EndiannessType,
+                                 typename Dest::Subtypes::EndiannessType>::value
+        };
+    };
+
 public:
     //==============================================================================
     /** A sequence of interleaved samples used as the source for the deinterleaveSamples() method. */
@@ -724,6 +752,16 @@ public:
         using SourceType = typename decltype (source)::PointerType;
         using DestType   = typename decltype (dest)  ::PointerType;
 
+        // The direct path never has to synthesise cleared channels, so it can
+        // only be taken when every destination channel has a source.
+        if (CanShuffleDirectly<decltype (source), decltype (dest)>::value && source.channels >= dest.channels)
+        {
+            interleaveDirect (reinterpret_cast<const void* const*> (source.data), source.channels,
+                              reinterpret_cast<void*> (dest.data), dest.channels,
+                              numSamples, (int) DestType::getBytesPerSample());
+            return;
+        }
+
         for (int i = 0; i < dest.channels; ++i)
         {
             const DestType destType (addBytesToPointer (dest.data, i * DestType::getBytesPerSample()), dest.channels);
@@ -768,6 +806,14 @@ public:
         using SourceType = typename decltype (source)::PointerType;
         using DestType   = typename decltype (dest)  ::PointerType;
 
+        if (CanShuffleDirectly<decltype (source), decltype (dest)>::value && source.channels >= dest.channels)
+        {
+            deinterleaveDirect (reinterpret_cast<const void*> (source.data), source.channels,
+                                reinterpret_cast<void* const*> (dest.data), dest.channels,
+                                numSamples, (int) SourceType::getBytesPerSample());
+            return;
+        }
+
         for (int i = 0; i < dest.channels; ++i)
         {
             if (auto* targetChan = dest.data[i])
@@ -63,7 +63,10 @@ void AudioProcessLoadMeasurer::registerRenderTime (double milliseconds, int numS
     cpuUsageProportion += filterAmount * (usedProportion - cpuUsageProportion);
 
     if (milliseconds > maxMilliseconds)
+    {
         ++xruns;
+        RealtimeTracer::addMarker ("xrun");
+    }
 }
 
 double AudioProcessLoadMeasurer::getLoadAsProportion() const   { return jlimit (0.0, 1.0, cpuUsageProportion); }
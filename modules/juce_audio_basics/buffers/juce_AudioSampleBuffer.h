@@ -422,8 +422,14 @@ public:
 
         if (newNumSamples != size || newNumChannels != numChannels)
         {
-            auto allocatedSamplesPerChannel = ((size_t) newNumSamples + 3) & ~3u;
-            auto channelListSize = ((static_cast<size_t> (1 + newNumChannels) * sizeof (Type*)) + 15) & ~15u;
+            // each channel is padded so that consecutive channels start on cache-line
+            // boundaries: this keeps SIMD loads aligned, and stops channels that are
+            // processed by different threads from sharing a cache line
+            auto samplesPerCacheLine = jmax ((size_t) 4, channelAlignmentBytes / sizeof (Type));
+            auto allocatedSamplesPerChannel = ((size_t) newNumSamples + samplesPerCacheLine - 1)
+                                                 / samplesPerCacheLine * samplesPerCacheLine;
+            auto channelListSize = ((static_cast<size_t> (1 + newNumChannels) * sizeof (Type*)) + channelAlignmentBytes - 1)
+                                      / channelAlignmentBytes * channelAlignmentBytes;
             auto newTotalBytes = ((size_t) newNumChannels * (size_t) allocatedSamplesPerChannel * sizeof (Type))
                                     + channelListSize + 32;
 
@@ -435,7 +441,7 @@ public:
                 }
                 else
                 {
-                    HeapBlock<char, true> newData;
+                    HeapBlock<char, true, channelAlignmentBytes> newData;
                     newData.allocate (newTotalBytes, clearExtraSpace || isClear);
 
                     auto numSamplesToCopy = (size_t) jmin (newNumSamples, size);
@@ -1180,15 +1186,23 @@ public:
             return Type (0);
 
         auto* data = channels[channel] + startSample;
-        double sum = 0.0;
+        double sum0 = 0.0, sum1 = 0.0, sum2 = 0.0, sum3 = 0.0;
+        int i = 0;
 
-        for (int i = 0; i < numSamples; ++i)
+        // Four accumulators keep the loop free of a serial dependency, so
+        // the compiler can vectorise it
+        for (; i <= numSamples - 4; i += 4)
         {
-            auto sample = data[i];
-            sum += sample * sample;
+            sum0 += (double) (data[i]     * data[i]);
+            sum1 += (double) (data[i + 1] * data[i + 1]);
+            sum2 += (double) (data[i + 2] * data[i + 2]);
+            sum3 += (double) (data[i + 3] * data[i + 3]);
         }
 
-        return static_cast<Type> (std::sqrt (sum / numSamples));
+        for (; i < numSamples; ++i)
+            sum0 += (double) (data[i] * data[i]);
+
+        return static_cast<Type> (std::sqrt ((sum0 + sum1 + sum2 + sum3) / numSamples));
     }
 
     /** Reverses a part of a channel. */
@@ -1218,7 +1232,13 @@ private:
     int numChannels = 0, size = 0;
     size_t allocatedBytes = 0;
     Type** channels;
-    HeapBlock<char, true> allocatedData;
+
+    // aligning the allocation (and the start of each channel within it) to a cache
+    // line keeps SIMD loads aligned, and stops channels that are processed by
+    // different threads from sharing a cache line
+    static constexpr size_t channelAlignmentBytes = 64;
+
+    HeapBlock<char, true, channelAlignmentBytes> allocatedData;
     Type* preallocatedChannelSpace[32];
     bool isClear = false;
 
@@ -1230,14 +1250,14 @@ private:
        #endif
         jassert (size >= 0);
 
-        auto channelListSize = (size_t) (numChannels + 1) * sizeof (Type*);
-        auto requiredSampleAlignment = std::alignment_of<Type>::value;
-        size_t alignmentOverflow = channelListSize % requiredSampleAlignment;
-
-        if (alignmentOverflow != 0)
-            channelListSize += requiredSampleAlignment - alignmentOverflow;
+        // use the same cache-line-aligned layout as setSize()
+        auto samplesPerCacheLine = jmax ((size_t) 4, channelAlignmentBytes / sizeof (Type));
+        auto allocatedSamplesPerChannel = ((size_t) size + samplesPerCacheLine - 1)
+                                             / samplesPerCacheLine * samplesPerCacheLine;
+        auto channelListSize = ((size_t) (numChannels + 1) * sizeof (Type*) + channelAlignmentBytes - 1)
+                                  / channelAlignmentBytes * channelAlignmentBytes;
 
-        allocatedBytes = (size_t) numChannels * (size_t) size * sizeof (Type) + channelListSize + 32;
+        allocatedBytes = (size_t) numChannels * allocatedSamplesPerChannel * sizeof (Type) + channelListSize + 32;
         allocatedData.malloc (allocatedBytes);
         channels = unalignedPointerCast<Type**> (allocatedData.get());
         auto chan = unalignedPointerCast<Type*> (allocatedData + channelListSize);
@@ -1245,7 +1265,7 @@ private:
         for (int i = 0; i < numChannels; ++i)
         {
             channels[i] = chan;
-            chan += size;
+            chan += allocatedSamplesPerChannel;
         }
 
         channels[numChannels] = nullptr;
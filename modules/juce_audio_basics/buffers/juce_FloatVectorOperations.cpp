@@ -1095,6 +1095,145 @@ namespace
        #endif
     }
 
+    template <typename Size>
+    Size clipAndCount (float* dest, const float* src, float low, float high, Size num) noexcept
+    {
+        jassert (high >= low);
+
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_Length numLow = 0, numHigh = 0;
+        vDSP_vclipc ((float*) src, 1, &low, &high, dest, 1, (vDSP_Length) num, &numLow, &numHigh);
+        return (Size) (numLow + numHigh);
+       #else
+        Size numClipped = 0;
+
+       #if JUCE_USE_SSE_INTRINSICS
+        {
+            auto numLongOps = num / 4;
+
+            if (numLongOps > 0)
+            {
+                const auto lo = _mm_load1_ps (&low);
+                const auto hi = _mm_load1_ps (&high);
+                auto counts = _mm_setzero_si128();
+
+                for (auto i = (decltype (numLongOps)) 0; i < numLongOps; ++i)
+                {
+                    const auto s = _mm_loadu_ps (src);
+                    const auto clipped = _mm_max_ps (_mm_min_ps (s, hi), lo);
+                    _mm_storeu_ps (dest, clipped);
+
+                    // each clipped lane compares not-equal, producing a mask of -1s
+                    counts = _mm_sub_epi32 (counts, _mm_castps_si128 (_mm_cmpneq_ps (s, clipped)));
+
+                    src += 4;
+                    dest += 4;
+                }
+
+                int32 laneCounts[4];
+                _mm_storeu_si128 (reinterpret_cast<__m128i*> (laneCounts), counts);
+                numClipped = (Size) (laneCounts[0] + laneCounts[1] + laneCounts[2] + laneCounts[3]);
+                num &= 3;
+            }
+        }
+       #elif JUCE_USE_ARM_NEON
+        {
+            auto numLongOps = num / 4;
+
+            if (numLongOps > 0)
+            {
+                const auto lo = vld1q_dup_f32 (&low);
+                const auto hi = vld1q_dup_f32 (&high);
+                auto counts = vdupq_n_u32 (0);
+
+                for (auto i = (decltype (numLongOps)) 0; i < numLongOps; ++i)
+                {
+                    const auto s = vld1q_f32 (src);
+                    const auto clipped = vmaxq_f32 (vminq_f32 (s, hi), lo);
+                    vst1q_f32 (dest, clipped);
+
+                    // each clipped lane compares not-equal, producing a mask of all-ones
+                    counts = vsubq_u32 (counts, vmvnq_u32 (vceqq_f32 (s, clipped)));
+
+                    src += 4;
+                    dest += 4;
+                }
+
+                uint32 laneCounts[4];
+                vst1q_u32 (laneCounts, counts);
+                numClipped = (Size) (laneCounts[0] + laneCounts[1] + laneCounts[2] + laneCounts[3]);
+                num &= 3;
+            }
+        }
+       #endif
+
+        for (auto i = (decltype (num)) 0; i < num; ++i)
+        {
+            const auto s = src[i];
+            dest[i] = jmax (jmin (s, high), low);
+
+            if (s < low || s > high)
+                ++numClipped;
+        }
+
+        return numClipped;
+       #endif
+    }
+
+    template <typename Size>
+    Size clipAndCount (double* dest, const double* src, double low, double high, Size num) noexcept
+    {
+        jassert (high >= low);
+
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_Length numLow = 0, numHigh = 0;
+        vDSP_vclipcD ((double*) src, 1, &low, &high, dest, 1, (vDSP_Length) num, &numLow, &numHigh);
+        return (Size) (numLow + numHigh);
+       #else
+        Size numClipped = 0;
+
+       #if JUCE_USE_SSE_INTRINSICS
+        {
+            auto numLongOps = num / 2;
+
+            if (numLongOps > 0)
+            {
+                const auto lo = _mm_load1_pd (&low);
+                const auto hi = _mm_load1_pd (&high);
+                auto counts = _mm_setzero_si128();
+
+                for (auto i = (decltype (numLongOps)) 0; i < numLongOps; ++i)
+                {
+                    const auto s = _mm_loadu_pd (src);
+                    const auto clipped = _mm_max_pd (_mm_min_pd (s, hi), lo);
+                    _mm_storeu_pd (dest, clipped);
+                    counts = _mm_sub_epi64 (counts, _mm_castpd_si128 (_mm_cmpneq_pd (s, clipped)));
+
+                    src += 2;
+                    dest += 2;
+                }
+
+                int64 laneCounts[2];
+                _mm_storeu_si128 (reinterpret_cast<__m128i*> (laneCounts), counts);
+                numClipped = (Size) (laneCounts[0] + laneCounts[1]);
+                num &= 1;
+            }
+        }
+       #endif
+
+        for (auto i = (decltype (num)) 0; i < num; ++i)
+        {
+            const auto s = src[i];
+            dest[i] = jmax (jmin (s, high), low);
+
+            if (s < low || s > high)
+                ++numClipped;
+        }
+
+        return numClipped;
+       #endif
+    }
+
     template <typename Size>
     Range<float> findMinAndMax (const float* src, Size num) noexcept
     {
@@ -1155,6 +1294,64 @@ namespace
        #endif
     }
 
+    template <typename FloatType, typename Size>
+    FloatType findMinAndMaxAndAbsPeak (const FloatType* src, Size num, Range<FloatType>& minAndMax) noexcept
+    {
+        minAndMax = findMinAndMax (src, num);
+        return jmax (std::abs (minAndMax.getStart()), std::abs (minAndMax.getEnd()));
+    }
+
+    template <typename FloatType, typename Size>
+    void addWithMultiplyAndRamp (FloatType* dest, const FloatType* src, FloatType startGain, FloatType endGain, Size num) noexcept
+    {
+        if (num <= 0)
+            return;
+
+        const auto step = (endGain - startGain) / (FloatType) num;
+
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        // The per-lane gain offsets can't be expressed with the usual vec-op
+        // macros, so this loop carries the ramp state across iterations by hand.
+        using Mode = typename ModeType<sizeof (FloatType)>::Mode;
+        auto numLongOps = num / (Size) Mode::numParallel;
+
+        if (Mode::numParallel > 1 && numLongOps > 0)
+        {
+            FloatType laneGains[Mode::numParallel];
+
+            for (int i = 0; i < Mode::numParallel; ++i)
+                laneGains[i] = startGain + step * (FloatType) i;
+
+            auto gain = Mode::loadU (laneGains);
+            const auto gainStep = Mode::load1 (step * (FloatType) Mode::numParallel);
+
+            for (auto i = (decltype (numLongOps)) 0; i < numLongOps; ++i)
+            {
+                Mode::storeU (dest, Mode::add (Mode::loadU (dest), Mode::mul (Mode::loadU (src), gain)));
+                gain = Mode::add (gain, gainStep);
+
+                src += Mode::numParallel;
+                dest += Mode::numParallel;
+            }
+
+            startGain += step * (FloatType) (numLongOps * (Size) Mode::numParallel);
+            num &= (Size) (Mode::numParallel - 1);
+        }
+       #endif
+
+        for (auto i = (decltype (num)) 0; i < num; ++i)
+            dest[i] += src[i] * (startGain + step * (FloatType) i);
+    }
+
+    template <typename FloatType, typename Size>
+    void convertGainToDecibels (FloatType* dest, const FloatType* src, FloatType minusInfinityDb, Size num) noexcept
+    {
+        // The log10 call keeps this one scalar, but the results must match
+        // Decibels::gainToDecibels exactly, silence clamp included.
+        for (auto i = (decltype (num)) 0; i < num; ++i)
+            dest[i] = Decibels::gainToDecibels (src[i], minusInfinityDb);
+    }
+
     template <typename Size>
     void convertFixedToFloat (float* dest, const int* src, float multiplier, Size num) noexcept
     {
@@ -1277,6 +1474,16 @@ void JUCE_CALLTYPE detail::FloatVectorOperationsBase<FloatType, CountType>::addW
     FloatVectorHelpers::addWithMultiply (dest, src1, src2, num);
 }
 
+template <typename FloatType, typename CountType>
+void JUCE_CALLTYPE detail::FloatVectorOperationsBase<FloatType, CountType>::addWithMultiplyAndRamp (FloatType* dest,
+                                                                                                    const FloatType* src,
+                                                                                                    FloatType startGain,
+                                                                                                    FloatType endGain,
+                                                                                                    CountType num) noexcept
+{
+    FloatVectorHelpers::addWithMultiplyAndRamp (dest, src, startGain, endGain, num);
+}
+
 template <typename FloatType, typename CountType>
 void JUCE_CALLTYPE detail::FloatVectorOperationsBase<FloatType, CountType>::subtractWithMultiply (FloatType* dest,
                                                                                                   const FloatType* src,
@@ -1391,6 +1598,16 @@ void JUCE_CALLTYPE detail::FloatVectorOperationsBase<FloatType, CountType>::clip
     FloatVectorHelpers::clip (dest, src, low, high, num);
 }
 
+template <typename FloatType, typename CountType>
+CountType JUCE_CALLTYPE detail::FloatVectorOperationsBase<FloatType, CountType>::clipAndCount (FloatType* dest,
+                                                                                               const FloatType* src,
+                                                                                               FloatType low,
+                                                                                               FloatType high,
+                                                                                               CountType num) noexcept
+{
+    return FloatVectorHelpers::clipAndCount (dest, src, low, high, num);
+}
+
 template <typename FloatType, typename CountType>
 Range<FloatType> JUCE_CALLTYPE detail::FloatVectorOperationsBase<FloatType, CountType>::findMinAndMax (const FloatType* src,
                                                                                                        CountType numValues) noexcept
@@ -1398,6 +1615,14 @@ Range<FloatType> JUCE_CALLTYPE detail::FloatVectorOperationsBase<FloatType, Coun
     return FloatVectorHelpers::findMinAndMax (src, numValues);
 }
 
+template <typename FloatType, typename CountType>
+FloatType JUCE_CALLTYPE detail::FloatVectorOperationsBase<FloatType, CountType>::findMinAndMaxAndAbsPeak (const FloatType* src,
+                                                                                                          CountType numValues,
+                                                                                                          Range<FloatType>& minAndMax) noexcept
+{
+    return FloatVectorHelpers::findMinAndMaxAndAbsPeak (src, numValues, minAndMax);
+}
+
 template <typename FloatType, typename CountType>
 FloatType JUCE_CALLTYPE detail::FloatVectorOperationsBase<FloatType, CountType>::findMinimum (const FloatType* src,
                                                                                               CountType numValues) noexcept
@@ -1412,6 +1637,15 @@ FloatType JUCE_CALLTYPE detail::FloatVectorOperationsBase<FloatType, CountType>:
     return FloatVectorHelpers::findMaximum (src, numValues);
 }
 
+template <typename FloatType, typename CountType>
+void JUCE_CALLTYPE detail::FloatVectorOperationsBase<FloatType, CountType>::convertGainToDecibels (FloatType* dest,
+                                                                                                   const FloatType* src,
+                                                                                                   FloatType minusInfinityDb,
+                                                                                                   CountType numValues) noexcept
+{
+    FloatVectorHelpers::convertGainToDecibels (dest, src, minusInfinityDb, numValues);
+}
+
 template struct detail::FloatVectorOperationsBase<float, int>;
 template struct detail::FloatVectorOperationsBase<float, size_t>;
 template struct detail::FloatVectorOperationsBase<double, int>;
@@ -1427,6 +1661,22 @@ void JUCE_CALLTYPE FloatVectorOperations::convertFixedToFloat (float* dest, cons
     FloatVectorHelpers::convertFixedToFloat (dest, src, multiplier, num);
 }
 
+template <typename ValueType, typename SizeType>
+static void flushDenormalsInBuffer (ValueType* data, SizeType num) noexcept
+{
+    const auto smallestNormal = std::numeric_limits<ValueType>::min();
+
+    // a branch-free select, so the loop vectorises; the comparison is false for
+    // NaNs, which are deliberately left alone
+    for (SizeType i = 0; i < num; ++i)
+        data[i] = std::abs (data[i]) < smallestNormal ? ValueType() : data[i];
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::flushDenormalsToZero (float* data, int num) noexcept       { flushDenormalsInBuffer (data, num); }
+void JUCE_CALLTYPE FloatVectorOperations::flushDenormalsToZero (float* data, size_t num) noexcept    { flushDenormalsInBuffer (data, num); }
+void JUCE_CALLTYPE FloatVectorOperations::flushDenormalsToZero (double* data, int num) noexcept      { flushDenormalsInBuffer (data, num); }
+void JUCE_CALLTYPE FloatVectorOperations::flushDenormalsToZero (double* data, size_t num) noexcept   { flushDenormalsInBuffer (data, num); }
+
 intptr_t JUCE_CALLTYPE FloatVectorOperations::getFpStatusRegister() noexcept
 {
     intptr_t fpsr = 0;
@@ -1539,6 +1789,26 @@ ScopedNoDenormals::ScopedNoDenormals() noexcept
   #endif
 }
 
+ScopedNoDenormals::ScopedNoDenormals (bool shouldDisableDenormals) noexcept
+{
+  #if JUCE_USE_SSE_INTRINSICS || (JUCE_USE_ARM_NEON || defined (__arm64__) || defined (__aarch64__))
+   #if JUCE_USE_SSE_INTRINSICS
+    intptr_t mask = 0x8040;
+   #else /*JUCE_USE_ARM_NEON*/
+    intptr_t mask = (1 << 24 /* FZ */);
+   #endif
+
+    // restoring the unchanged register in the destructor is a harmless no-op,
+    // so when denormals are to be left enabled the mask is simply not applied
+    fpsr = FloatVectorOperations::getFpStatusRegister();
+
+    if (shouldDisableDenormals)
+        FloatVectorOperations::setFpStatusRegister (fpsr | mask);
+  #else
+    ignoreUnused (shouldDisableDenormals);
+  #endif
+}
+
 ScopedNoDenormals::~ScopedNoDenormals() noexcept
 {
    #if JUCE_USE_SSE_INTRINSICS || (JUCE_USE_ARM_NEON || defined(__arm64__) || defined(__aarch64__))
@@ -1640,6 +1910,45 @@ public:
             FloatVectorOperations::fill (data2, (ValueType) 3, num);
             FloatVectorOperations::addWithMultiply (data1, data1, data2, num);
             u.expect (areAllValuesEqual (data1, num, (ValueType) 8));
+
+            FloatVectorOperations::fill (data1, (ValueType) 2, num);
+            FloatVectorOperations::fill (data2, (ValueType) 3, num);
+            FloatVectorOperations::addWithMultiplyAndRamp (data2, data1, (ValueType) 0, (ValueType) 1, num);
+            u.expect (rampMatches (data2, (ValueType) 3, (ValueType) 2, (ValueType) 0, (ValueType) 1, num));
+
+            fillRandomly (random, data1, num);
+            Range<ValueType> minMax3;
+            const auto absPeak = FloatVectorOperations::findMinAndMaxAndAbsPeak (data1, num, minMax3);
+            u.expect (minMax3 == Range<ValueType>::findMinAndMax (data1, num));
+            u.expect (valuesMatch (absPeak, jmax (std::abs (minMax3.getStart()), std::abs (minMax3.getEnd()))));
+
+            const auto lowClip  = (ValueType) 250;
+            const auto highClip = (ValueType) 750;
+            const auto numClipped = FloatVectorOperations::clipAndCount (data2, data1, lowClip, highClip, num);
+
+            int expectedClipped = 0;
+            bool clippedCorrectly = true;
+
+            for (int i = 0; i < num; ++i)
+            {
+                if (data1[i] < lowClip || data1[i] > highClip)
+                    ++expectedClipped;
+
+                clippedCorrectly = clippedCorrectly && data2[i] == jmax (jmin (data1[i], highClip), lowClip);
+            }
+
+            u.expectEquals (numClipped, expectedClipped);
+            u.expect (clippedCorrectly);
+
+            data1[0] = 0; // make sure the silence clamp gets exercised
+            FloatVectorOperations::convertGainToDecibels (data2, data1, (ValueType) -100, num);
+
+            bool decibelsMatch = true;
+
+            for (int i = 0; i < num; ++i)
+                decibelsMatch = decibelsMatch && data2[i] == Decibels::gainToDecibels (data1[i], (ValueType) -100);
+
+            u.expect (decibelsMatch);
         }
 
         static void doConversionTest (UnitTest& u, float* data1, float* data2, int* const int1, int num)
@@ -1691,6 +2000,19 @@ public:
         {
             return std::abs (v1 - v2) < std::numeric_limits<ValueType>::epsilon();
         }
+
+        static bool rampMatches (const ValueType* d, ValueType initial, ValueType source,
+                                 ValueType startGain, ValueType endGain, int num)
+        {
+            const auto step = (endGain - startGain) / (ValueType) num;
+
+            // the vectorised ramp accumulates its step, so allow a little rounding slack
+            for (int i = 0; i < num; ++i)
+                if (std::abs (d[i] - (initial + source * (startGain + step * (ValueType) i))) > (ValueType) 1.0e-3)
+                    return false;
+
+            return true;
+        }
     };
 
     void runTest() override
@@ -1702,6 +2024,26 @@ public:
             TestRunner<float>::runTest (*this, getRandom());
             TestRunner<double>::runTest (*this, getRandom());
         }
+
+        beginTest ("flushDenormalsToZero");
+        {
+            // note that if denormals are already disabled on this CPU, the
+            // subnormal entries will read back as zero anyway, so the
+            // expected results are the same either way
+            float floats[] = { 1.0f, 1.0e-40f, 0.0f, -1.0e-41f, -0.5f,
+                               std::numeric_limits<float>::min() };
+            FloatVectorOperations::flushDenormalsToZero (floats, (int) numElementsInArray (floats));
+
+            expect (floats[0] == 1.0f && floats[1] == 0.0f && floats[2] == 0.0f
+                     && floats[3] == 0.0f && floats[4] == -0.5f
+                     && floats[5] == std::numeric_limits<float>::min());
+
+            double doubles[] = { -2.0, 1.0e-320, 0.0, 7.0 };
+            FloatVectorOperations::flushDenormalsToZero (doubles, (size_t) numElementsInArray (doubles));
+
+            expect (doubles[0] == -2.0 && doubles[1] == 0.0
+                     && doubles[2] == 0.0 && doubles[3] == 7.0);
+        }
     }
 };
 
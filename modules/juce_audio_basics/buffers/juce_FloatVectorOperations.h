@@ -51,6 +51,7 @@ struct FloatVectorOperationsBase
     static void JUCE_CALLTYPE subtract (FloatType* dest, const FloatType* src1, const FloatType* src2, CountType num) noexcept;
     static void JUCE_CALLTYPE addWithMultiply (FloatType* dest, const FloatType* src, FloatType multiplier, CountType numValues) noexcept;
     static void JUCE_CALLTYPE addWithMultiply (FloatType* dest, const FloatType* src1, const FloatType* src2, CountType num) noexcept;
+    static void JUCE_CALLTYPE addWithMultiplyAndRamp (FloatType* dest, const FloatType* src, FloatType startGain, FloatType endGain, CountType num) noexcept;
     static void JUCE_CALLTYPE subtractWithMultiply (FloatType* dest, const FloatType* src, FloatType multiplier, CountType numValues) noexcept;
     static void JUCE_CALLTYPE subtractWithMultiply (FloatType* dest, const FloatType* src1, const FloatType* src2, CountType num) noexcept;
     static void JUCE_CALLTYPE multiply (FloatType* dest, const FloatType* src, CountType numValues) noexcept;
@@ -64,9 +65,12 @@ struct FloatVectorOperationsBase
     static void JUCE_CALLTYPE max (FloatType* dest, const FloatType* src, FloatType comp, CountType num) noexcept;
     static void JUCE_CALLTYPE max (FloatType* dest, const FloatType* src1, const FloatType* src2, CountType num) noexcept;
     static void JUCE_CALLTYPE clip (FloatType* dest, const FloatType* src, FloatType low, FloatType high, CountType num) noexcept;
+    static CountType JUCE_CALLTYPE clipAndCount (FloatType* dest, const FloatType* src, FloatType low, FloatType high, CountType num) noexcept;
     static Range<FloatType> JUCE_CALLTYPE findMinAndMax (const FloatType* src, CountType numValues) noexcept;
+    static FloatType JUCE_CALLTYPE findMinAndMaxAndAbsPeak (const FloatType* src, CountType numValues, Range<FloatType>& minAndMax) noexcept;
     static FloatType JUCE_CALLTYPE findMinimum (const FloatType* src, CountType numValues) noexcept;
     static FloatType JUCE_CALLTYPE findMaximum (const FloatType* src, CountType numValues) noexcept;
+    static void JUCE_CALLTYPE convertGainToDecibels (FloatType* dest, const FloatType* src, FloatType minusInfinityDb, CountType numValues) noexcept;
 };
 
 template <typename...>
@@ -99,6 +103,9 @@ struct NameForwarder<Head, Tail...> : Head, NameForwarder<Tail...>
     using Head::addWithMultiply;
     using NameForwarder<Tail...>::addWithMultiply;
 
+    using Head::addWithMultiplyAndRamp;
+    using NameForwarder<Tail...>::addWithMultiplyAndRamp;
+
     using Head::subtractWithMultiply;
     using NameForwarder<Tail...>::subtractWithMultiply;
 
@@ -120,14 +127,23 @@ struct NameForwarder<Head, Tail...> : Head, NameForwarder<Tail...>
     using Head::clip;
     using NameForwarder<Tail...>::clip;
 
+    using Head::clipAndCount;
+    using NameForwarder<Tail...>::clipAndCount;
+
     using Head::findMinAndMax;
     using NameForwarder<Tail...>::findMinAndMax;
 
+    using Head::findMinAndMaxAndAbsPeak;
+    using NameForwarder<Tail...>::findMinAndMaxAndAbsPeak;
+
     using Head::findMinimum;
     using NameForwarder<Tail...>::findMinimum;
 
     using Head::findMaximum;
     using NameForwarder<Tail...>::findMaximum;
+
+    using Head::convertGainToDecibels;
+    using NameForwarder<Tail...>::convertGainToDecibels;
 };
 
 } // namespace detail
@@ -150,6 +166,23 @@ public:
 
     static void JUCE_CALLTYPE convertFixedToFloat (float* dest, const int* src, float multiplier, size_t num) noexcept;
 
+    /** Replaces any denormalised values in the given buffer with zeroes.
+
+        This is useful for scrubbing filter or delay state buffers, so that a
+        decayed tail left behind in the state can't cause denormal stalls on
+        subsequent process calls. NaNs and normal values are left untouched.
+    */
+    static void JUCE_CALLTYPE flushDenormalsToZero (float* data, int num) noexcept;
+
+    /** Replaces any denormalised values in the given buffer with zeroes. */
+    static void JUCE_CALLTYPE flushDenormalsToZero (float* data, size_t num) noexcept;
+
+    /** Replaces any denormalised values in the given buffer with zeroes. */
+    static void JUCE_CALLTYPE flushDenormalsToZero (double* data, int num) noexcept;
+
+    /** Replaces any denormalised values in the given buffer with zeroes. */
+    static void JUCE_CALLTYPE flushDenormalsToZero (double* data, size_t num) noexcept;
+
     /** This method enables or disables the SSE/NEON flush-to-zero mode. */
     static void JUCE_CALLTYPE enableFlushToZeroMode (bool shouldEnable) noexcept;
 
@@ -182,6 +215,15 @@ class ScopedNoDenormals
 {
 public:
     ScopedNoDenormals() noexcept;
+
+    /** Creates a ScopedNoDenormals which only disables denormals if
+        shouldDisableDenormals is true.
+
+        This is handy when the decision is made at runtime, for example from
+        dsp::ProcessSpec::disableDenormals.
+    */
+    explicit ScopedNoDenormals (bool shouldDisableDenormals) noexcept;
+
     ~ScopedNoDenormals() noexcept;
 
 private:
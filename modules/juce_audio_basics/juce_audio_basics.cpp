@@ -61,8 +61,17 @@
 #include "utilities/juce_LagrangeInterpolator.cpp"
 #include "utilities/juce_WindowedSincInterpolator.cpp"
 #include "utilities/juce_Interpolators.cpp"
+#include "utilities/juce_PolyphaseResampler.cpp"
+#include "utilities/juce_RealtimeTracer.cpp"
+#include "utilities/juce_ADSREnvelopeBank.cpp"
 #include "utilities/juce_SmoothedValue.cpp"
+#include "utilities/juce_SmoothedValueBank.cpp"
+#include "utilities/juce_AutomationCurve.cpp"
+#include "utilities/juce_AudioTimeStretcher.cpp"
+#include "utilities/juce_LevelMeterTap.cpp"
+#include "utilities/juce_SlidingWindowStatistics.cpp"
 #include "midi/juce_MidiBuffer.cpp"
+#include "midi/juce_MidiEventTable.cpp"
 #include "midi/juce_MidiFile.cpp"
 #include "midi/juce_MidiKeyboardState.cpp"
 #include "midi/juce_MidiMessage.cpp"
@@ -78,12 +87,15 @@
 #include "mpe/juce_MPESynthesiser.cpp"
 #include "mpe/juce_MPEUtils.cpp"
 #include "sources/juce_BufferingAudioSource.cpp"
+#include "sources/juce_BufferingAudioSourceScheduler.cpp"
 #include "sources/juce_ChannelRemappingAudioSource.cpp"
 #include "sources/juce_IIRFilterAudioSource.cpp"
 #include "sources/juce_MemoryAudioSource.cpp"
 #include "sources/juce_MixerAudioSource.cpp"
+#include "sources/juce_PolyphaseResamplingAudioSource.cpp"
 #include "sources/juce_ResamplingAudioSource.cpp"
 #include "sources/juce_ReverbAudioSource.cpp"
+#include "sources/juce_TimeStretchingAudioSource.cpp"
 #include "sources/juce_ToneGeneratorAudioSource.cpp"
 #include "synthesisers/juce_Synthesiser.cpp"
 
@@ -94,6 +106,15 @@
 #include "midi/ump/juce_UMPMidi1ToMidi2DefaultTranslator.cpp"
 
 #if JUCE_UNIT_TESTS
+ #include "buffers/juce_AudioBufferArena_test.cpp"
  #include "utilities/juce_ADSR_test.cpp"
+ #include "utilities/juce_IIRFilter_test.cpp"
+ #include "utilities/juce_Reverb_test.cpp"
+ #include "utilities/juce_AudioTimeStretcher_test.cpp"
+ #include "utilities/juce_LevelMeterTap_test.cpp"
+ #include "utilities/juce_SlidingWindowStatistics_test.cpp"
+ #include "utilities/juce_PolyphaseResampler_test.cpp"
+ #include "utilities/juce_AutomationCurve_test.cpp"
+ #include "midi/juce_MidiKeyboardState_test.cpp"
  #include "midi/ump/juce_UMPTests.cpp"
 #endif
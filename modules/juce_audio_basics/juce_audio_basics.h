@@ -85,18 +85,28 @@
 #include "buffers/juce_AudioDataConverters.h"
 #include "buffers/juce_FloatVectorOperations.h"
 #include "buffers/juce_AudioSampleBuffer.h"
+#include "buffers/juce_AudioBufferArena.h"
 #include "buffers/juce_AudioChannelSet.h"
 #include "buffers/juce_AudioProcessLoadMeasurer.h"
 #include "utilities/juce_Decibels.h"
 #include "utilities/juce_IIRFilter.h"
 #include "utilities/juce_GenericInterpolator.h"
 #include "utilities/juce_Interpolators.h"
+#include "utilities/juce_PolyphaseResampler.h"
 #include "utilities/juce_SmoothedValue.h"
+#include "utilities/juce_SmoothedValueBank.h"
 #include "utilities/juce_Reverb.h"
 #include "utilities/juce_ADSR.h"
+#include "utilities/juce_ADSREnvelopeBank.h"
+#include "utilities/juce_AutomationCurve.h"
+#include "utilities/juce_AudioTimeStretcher.h"
+#include "utilities/juce_LevelMeterTap.h"
+#include "utilities/juce_SlidingWindowStatistics.h"
+#include "utilities/juce_RealtimeTracer.h"
 #include "midi/juce_MidiMessage.h"
 #include "midi/juce_MidiBuffer.h"
 #include "midi/juce_MidiMessageSequence.h"
+#include "midi/juce_MidiEventTable.h"
 #include "midi/juce_MidiFile.h"
 #include "midi/juce_MidiKeyboardState.h"
 #include "midi/juce_MidiRPN.h"
@@ -112,12 +122,15 @@
 #include "sources/juce_AudioSource.h"
 #include "sources/juce_PositionableAudioSource.h"
 #include "sources/juce_BufferingAudioSource.h"
+#include "sources/juce_BufferingAudioSourceScheduler.h"
 #include "sources/juce_ChannelRemappingAudioSource.h"
 #include "sources/juce_IIRFilterAudioSource.h"
 #include "sources/juce_MemoryAudioSource.h"
 #include "sources/juce_MixerAudioSource.h"
+#include "sources/juce_PolyphaseResamplingAudioSource.h"
 #include "sources/juce_ResamplingAudioSource.h"
 #include "sources/juce_ReverbAudioSource.h"
+#include "sources/juce_TimeStretchingAudioSource.h"
 #include "sources/juce_ToneGeneratorAudioSource.h"
 #include "synthesisers/juce_Synthesiser.h"
 #include "audio_play_head/juce_AudioPlayHead.h"
@@ -109,6 +109,11 @@ MidiBuffer::MidiBuffer (const MidiMessage& message) noexcept
 void MidiBuffer::swapWith (MidiBuffer& other) noexcept      { data.swapWith (other.data); }
 void MidiBuffer::clear() noexcept                           { data.clearQuick(); }
 void MidiBuffer::ensureSize (size_t minimumNumBytes)        { data.ensureStorageAllocated ((int) minimumNumBytes); }
+
+void MidiBuffer::reserveEvents (size_t numEvents, size_t maxBytesPerEvent)
+{
+    ensureSize (numEvents * (sizeof (int32) + sizeof (uint16) + maxBytesPerEvent));
+}
 bool MidiBuffer::isEmpty() const noexcept                   { return data.size() == 0; }
 
 void MidiBuffer::clear (int startSample, int numSamples)
@@ -155,7 +160,51 @@ bool MidiBuffer::addEvent (const void* newData, int maxBytes, int sampleNumber)
 void MidiBuffer::addEvents (const MidiBuffer& otherBuffer,
                             int startSample, int numSamples, int sampleDeltaToAdd)
 {
-    for (auto i = otherBuffer.findNextSamplePosition (startSample); i != otherBuffer.cend(); ++i)
+    const auto firstEvent = otherBuffer.findNextSamplePosition (startSample);
+
+    if (firstEvent == otherBuffer.cend())
+        return;
+
+    // When the incoming run lands entirely at or after the last event already
+    // in this buffer, the run (which is already sorted) can be appended in a
+    // single pass instead of binary-searching for an insertion point per event.
+    if (isEmpty() || (*firstEvent).samplePosition + sampleDeltaToAdd >= getLastEventTime())
+    {
+        auto lastEvent = firstEvent;
+        size_t bytesToAdd = 0;
+
+        while (lastEvent != otherBuffer.cend())
+        {
+            const auto metadata = *lastEvent;
+
+            if (metadata.samplePosition >= startSample + numSamples && numSamples >= 0)
+                break;
+
+            bytesToAdd += sizeof (int32) + sizeof (uint16) + (size_t) metadata.numBytes;
+            ++lastEvent;
+        }
+
+        const auto offset = data.size();
+        data.insertMultiple (offset, 0, (int) bytesToAdd);
+
+        auto* d = data.begin() + offset;
+
+        for (auto i = firstEvent; i != lastEvent; ++i)
+        {
+            const auto metadata = *i;
+
+            writeUnaligned<int32>  (d, metadata.samplePosition + sampleDeltaToAdd);
+            d += sizeof (int32);
+            writeUnaligned<uint16> (d, static_cast<uint16> (metadata.numBytes));
+            d += sizeof (uint16);
+            memcpy (d, metadata.data, (size_t) metadata.numBytes);
+            d += metadata.numBytes;
+        }
+
+        return;
+    }
+
+    for (auto i = firstEvent; i != otherBuffer.cend(); ++i)
     {
         const auto metadata = *i;
 
@@ -310,6 +359,76 @@ struct MidiBufferTest  : public UnitTest
                 expectEquals (buffer.getNumEvents(), 1);
             }
         }
+
+        beginTest ("Bulk addEvents");
+        {
+            const auto message = MidiMessage::noteOn (1, 64, 0.5f);
+
+            MidiBuffer source;
+
+            for (auto time : { 0, 10, 20, 30 })
+                source.addEvent (message, time);
+
+            // Appending a run after all existing events
+            {
+                MidiBuffer buffer;
+                buffer.addEvent (message, 0);
+                buffer.addEvents (source, 0, -1, 5);
+
+                expectEquals (buffer.getNumEvents(), 5);
+                expectEquals (buffer.getFirstEventTime(), 0);
+                expectEquals (buffer.getLastEventTime(), 35);
+
+                int previousTime = std::numeric_limits<int>::min();
+
+                for (const auto metadata : buffer)
+                {
+                    expect (metadata.samplePosition >= previousTime);
+                    previousTime = metadata.samplePosition;
+                }
+            }
+
+            // A run that needs to be interleaved with existing events
+            {
+                MidiBuffer buffer;
+                buffer.addEvent (message, 15);
+                buffer.addEvent (message, 100);
+                buffer.addEvents (source, 10, 21, 0);
+
+                expectEquals (buffer.getNumEvents(), 5);
+
+                int previousTime = std::numeric_limits<int>::min();
+
+                for (const auto metadata : buffer)
+                {
+                    expect (metadata.samplePosition >= previousTime);
+                    previousTime = metadata.samplePosition;
+                }
+            }
+
+            // Sample range limits are respected
+            {
+                MidiBuffer buffer;
+                buffer.addEvents (source, 10, 11, 0);
+
+                expectEquals (buffer.getNumEvents(), 2);
+                expectEquals (buffer.getFirstEventTime(), 10);
+                expectEquals (buffer.getLastEventTime(), 20);
+            }
+
+            // No reallocation when capacity was reserved up-front
+            {
+                MidiBuffer buffer;
+                buffer.reserveEvents (8);
+                const auto* allocated = buffer.data.begin();
+
+                buffer.addEvents (source, 0, -1, 0);
+                buffer.addEvents (source, 0, -1, 40);
+
+                expectEquals (buffer.getNumEvents(), 8);
+                expect (buffer.data.begin() == allocated);
+            }
+        }
     }
 };
 
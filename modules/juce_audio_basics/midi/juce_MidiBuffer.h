@@ -255,6 +255,23 @@ public:
     */
     void ensureSize (size_t minimumNumBytes);
 
+    /** Preallocates enough memory to hold the given number of events without
+        further allocation.
+
+        Call this from your prepareToPlay() with a worst-case event count to
+        guarantee that adding events on the audio thread won't touch the heap.
+        Each event needs a 6-byte header in addition to its MIDI data, so the
+        reservation is numEvents * (6 + maxBytesPerEvent) bytes.
+
+        @param numEvents          the number of events to reserve space for
+        @param maxBytesPerEvent   the largest MIDI message size you expect to
+                                  store; the default of 3 covers all standard
+                                  short messages
+
+        @see ensureSize
+    */
+    void reserveEvents (size_t numEvents, size_t maxBytesPerEvent = 3);
+
     /** Get a read-only iterator pointing to the beginning of this buffer. */
     MidiBufferIterator begin()  const noexcept { return cbegin(); }
 
@@ -0,0 +1,263 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+MidiEventTable::MidiEventTable() = default;
+MidiEventTable::~MidiEventTable() = default;
+
+void MidiEventTable::clear()
+{
+    times.clearQuick();
+    events.clearQuick();
+    slab.clearQuick();
+}
+
+int MidiEventTable::getNumEvents() const noexcept
+{
+    return times.size();
+}
+
+void MidiEventTable::ensureSize (int numEvents, size_t numBytes)
+{
+    times.ensureStorageAllocated (numEvents);
+    events.ensureStorageAllocated (numEvents);
+    slab.ensureStorageAllocated ((int) numBytes);
+}
+
+//==============================================================================
+void MidiEventTable::addEvent (const MidiMessage& message, double timeAdjustment)
+{
+    addEvent (message.getRawData(), message.getRawDataSize(),
+              message.getTimeStamp() + timeAdjustment);
+}
+
+void MidiEventTable::addEvent (const void* messageData, int numBytes, double time)
+{
+    jassert (messageData != nullptr && numBytes > 0);
+
+    times.add (time);
+    events.add ({ (size_t) slab.size(), numBytes });
+    slab.addArray (static_cast<const uint8*> (messageData), numBytes);
+}
+
+void MidiEventTable::addSequence (const MidiMessageSequence& sequence, double timeAdjustment)
+{
+    ensureSize (times.size() + sequence.getNumEvents(), (size_t) slab.size());
+
+    for (auto* holder : sequence)
+        addEvent (holder->message, timeAdjustment);
+}
+
+void MidiEventTable::sort()
+{
+    auto numEvents = times.size();
+
+    if (std::is_sorted (times.begin(), times.end()))
+        return;
+
+    Array<int> order;
+    order.ensureStorageAllocated (numEvents);
+
+    for (int i = 0; i < numEvents; ++i)
+        order.add (i);
+
+    std::stable_sort (order.begin(), order.end(),
+                      [this] (int a, int b)  { return times.getUnchecked (a) < times.getUnchecked (b); });
+
+    Array<double> sortedTimes;
+    Array<EventRef> sortedEvents;
+    sortedTimes.ensureStorageAllocated (numEvents);
+    sortedEvents.ensureStorageAllocated (numEvents);
+
+    for (auto i : order)
+    {
+        sortedTimes.add (times.getUnchecked (i));
+        sortedEvents.add (events.getUnchecked (i));
+    }
+
+    times.swapWith (sortedTimes);
+    events.swapWith (sortedEvents);
+}
+
+//==============================================================================
+double MidiEventTable::getEventTime (int index) const noexcept
+{
+    return times[index];
+}
+
+MidiMessage MidiEventTable::getEvent (int index) const
+{
+    jassert (isPositiveAndBelow (index, events.size()));
+
+    auto& e = events.getReference (index);
+    return MidiMessage (slab.begin() + e.offset, e.size, times.getUnchecked (index));
+}
+
+const uint8* MidiEventTable::getEventData (int index, int& numBytes) const noexcept
+{
+    if (! isPositiveAndBelow (index, events.size()))
+    {
+        numBytes = 0;
+        return nullptr;
+    }
+
+    auto& e = events.getReference (index);
+    numBytes = e.size;
+    return slab.begin() + e.offset;
+}
+
+int MidiEventTable::getNextIndexAtTime (double timeStamp) const noexcept
+{
+    return (int) std::distance (times.begin(),
+                                std::lower_bound (times.begin(), times.end(), timeStamp));
+}
+
+//==============================================================================
+MidiMessageSequence MidiEventTable::toMidiMessageSequence() const
+{
+    // the table should be sorted first - MidiMessageSequence::addEvent scans
+    // backwards for the insertion point, so in-order appends are O(1) each
+    jassert (std::is_sorted (times.begin(), times.end()));
+
+    MidiMessageSequence result;
+
+    for (int i = 0; i < events.size(); ++i)
+        result.addEvent (getEvent (i));
+
+    return result;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct MidiEventTableTest  : public UnitTest
+{
+    MidiEventTableTest()
+        : UnitTest ("MidiEventTable", UnitTestCategories::midi)
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest ("Bulk append and single sort order events by timestamp");
+        {
+            auto random = getRandom();
+
+            MidiEventTable table;
+            table.ensureSize (1000, 3000);
+
+            Array<double> expectedTimes;
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                auto time = (double) random.nextInt (10000);
+                table.addEvent (MidiMessage::noteOn (1, 60, (uint8) 100), time);
+                expectedTimes.add (time);
+            }
+
+            table.sort();
+            expectedTimes.sort();
+
+            expectEquals (table.getNumEvents(), 1000);
+
+            for (int i = 0; i < 1000; ++i)
+                expectEquals (table.getEventTime (i), expectedTimes.getUnchecked (i));
+        }
+
+        beginTest ("Sorting is stable for events with equal timestamps");
+        {
+            MidiEventTable table;
+            table.addEvent (MidiMessage::controllerEvent (1, 7, 3), 20.0);
+            table.addEvent (MidiMessage::controllerEvent (1, 7, 1), 10.0);
+            table.addEvent (MidiMessage::controllerEvent (1, 7, 2), 10.0);
+            table.sort();
+
+            expectEquals (table.getEvent (0).getControllerValue(), 1);
+            expectEquals (table.getEvent (1).getControllerValue(), 2);
+            expectEquals (table.getEvent (2).getControllerValue(), 3);
+        }
+
+        beginTest ("Range queries binary-search the sorted timestamps");
+        {
+            MidiEventTable table;
+
+            for (auto time : { 10.0, 20.0, 20.0, 30.0 })
+                table.addEvent (MidiMessage::noteOn (1, 60, (uint8) 100), time);
+
+            table.sort();
+
+            expectEquals (table.getNextIndexAtTime (5.0),  0);
+            expectEquals (table.getNextIndexAtTime (10.0), 0);
+            expectEquals (table.getNextIndexAtTime (15.0), 1);
+            expectEquals (table.getNextIndexAtTime (20.0), 1);
+            expectEquals (table.getNextIndexAtTime (25.0), 3);
+            expectEquals (table.getNextIndexAtTime (35.0), 4);
+        }
+
+        beginTest ("Conversion matches a directly-built MidiMessageSequence");
+        {
+            auto random = getRandom();
+
+            MidiEventTable table;
+            MidiMessageSequence direct;
+
+            for (int i = 0; i < 200; ++i)
+            {
+                auto note = 1 + random.nextInt (100);
+                auto time = (double) random.nextInt (1000);
+
+                auto on  = MidiMessage::noteOn  (1, note, (uint8) 100).withTimeStamp (time);
+                auto off = MidiMessage::noteOff (1, note).withTimeStamp (time + 10.0);
+
+                table.addEvent (on);
+                table.addEvent (off);
+                direct.addEvent (on);
+                direct.addEvent (off);
+            }
+
+            table.sort();
+            auto converted = table.toMidiMessageSequence();
+
+            expectEquals (converted.getNumEvents(), direct.getNumEvents());
+
+            for (int i = 0; i < converted.getNumEvents(); ++i)
+            {
+                const auto& a = converted.getEventPointer (i)->message;
+                const auto& b = direct.getEventPointer (i)->message;
+
+                expectEquals (a.getTimeStamp(), b.getTimeStamp());
+                expectEquals (a.getRawDataSize(), b.getRawDataSize());
+                expect (memcmp (a.getRawData(), b.getRawData(), (size_t) a.getRawDataSize()) == 0);
+            }
+        }
+    }
+};
+
+static MidiEventTableTest midiEventTableTests;
+
+#endif
+
+} // namespace juce
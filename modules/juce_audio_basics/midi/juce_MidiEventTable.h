@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A flat, cache-friendly store of timestamped midi messages, for bulk
+    sequence assembly.
+
+    MidiMessageSequence heap-allocates a MidiEventHolder per event and keeps
+    itself sorted on every insertion, which makes building a large sequence
+    from unordered events - quantising 100k events for an export, say -
+    quadratic. This class instead keeps the timestamps in one contiguous array
+    and the raw message bytes in a single slab: addEvent() just appends, and
+    one call to sort() afterwards puts everything in order, so assembling a
+    sequence is O(n log n) overall and touches memory sequentially.
+
+    Once sorted, events can be looked up by time with a binary search via
+    getNextIndexAtTime(), and the whole table can be converted to a
+    MidiMessageSequence (in a single linear pass) when something like MidiFile
+    needs one.
+
+    @see MidiMessageSequence, MidiBuffer
+
+    @tags{Audio}
+*/
+class JUCE_API  MidiEventTable
+{
+public:
+    //==============================================================================
+    /** Creates an empty table. */
+    MidiEventTable();
+
+    /** Destructor. */
+    ~MidiEventTable();
+
+    //==============================================================================
+    /** Clears the table. */
+    void clear();
+
+    /** Returns the number of events in the table. */
+    int getNumEvents() const noexcept;
+
+    /** Preallocates enough space for a given number of events and total message bytes,
+        to avoid repeated reallocation while appending. Most messages are 3 bytes.
+    */
+    void ensureSize (int numEvents, size_t numBytes);
+
+    //==============================================================================
+    /** Appends a message to the end of the table.
+
+        Unlike MidiMessageSequence::addEvent() this doesn't keep the table
+        sorted - append everything first, then call sort() once.
+
+        @param message          the message to add (its bytes are copied into the table)
+        @param timeAdjustment   an optional value to add to the message's timestamp
+    */
+    void addEvent (const MidiMessage& message, double timeAdjustment = 0);
+
+    /** Appends a message described by a block of raw midi data. */
+    void addEvent (const void* messageData, int numBytes, double time);
+
+    /** Appends a copy of every event in a sequence.
+
+        @param sequence         the sequence to add from
+        @param timeAdjustment   an optional value to add to the timestamps
+    */
+    void addSequence (const MidiMessageSequence& sequence, double timeAdjustment = 0);
+
+    /** Sorts the table by timestamp.
+
+        The sort is stable, so events with equal timestamps keep the order in
+        which they were appended.
+    */
+    void sort();
+
+    //==============================================================================
+    /** Returns the timestamp of the event at a given index.
+        If the index is out-of-range, this will return 0.0
+    */
+    double getEventTime (int index) const noexcept;
+
+    /** Returns a copy of the event at a given index, with its timestamp set.
+        The index must be in range.
+    */
+    MidiMessage getEvent (int index) const;
+
+    /** Returns a pointer to the raw bytes of the event at a given index,
+        setting numBytes to its length. This doesn't copy or allocate.
+    */
+    const uint8* getEventData (int index, int& numBytes) const noexcept;
+
+    /** Returns the index of the first event on or after the given timestamp,
+        using a binary search - the table must be sorted.
+
+        If the time is beyond the end of the table, this returns the number of
+        events, so a time range can be turned into an index range with two calls.
+
+        @see MidiMessageSequence::getNextIndexAtTime
+    */
+    int getNextIndexAtTime (double timeStamp) const noexcept;
+
+    //==============================================================================
+    /** Builds a MidiMessageSequence containing a copy of every event.
+
+        The table must be sorted: appending in-order events to a sequence is a
+        linear pass, so this is far cheaper than adding unordered events to the
+        sequence directly. Remember to call updateMatchedPairs() on the result
+        if you need note-on/note-off pairing.
+    */
+    MidiMessageSequence toMidiMessageSequence() const;
+
+private:
+    //==============================================================================
+    struct EventRef
+    {
+        size_t offset;
+        int size;
+    };
+
+    Array<double> times;
+    Array<EventRef> events;
+    Array<uint8> slab;
+
+    JUCE_LEAK_DETECTOR (MidiEventTable)
+};
+
+} // namespace juce
@@ -220,43 +220,53 @@ namespace MidiFileHelpers
         }
     }
 
-    static MidiMessageSequence readTrack (const uint8* data, int size)
+    static bool readNextTrackEvent (const uint8*& data, int& size,
+                                    double& time, uint8& lastStatusByte,
+                                    MidiMessage& result)
     {
-        double time = 0;
-        uint8 lastStatusByte = 0;
+        if (size <= 0)
+            return false;
 
-        MidiMessageSequence result;
+        const auto delay = MidiMessage::readVariableLengthValue (data, size);
 
-        while (size > 0)
-        {
-            const auto delay = MidiMessage::readVariableLengthValue (data, (int) size);
+        if (! delay.isValid())
+            return false;
 
-            if (! delay.isValid())
-                break;
+        data += delay.bytesUsed;
+        size -= delay.bytesUsed;
+        time += delay.value;
 
-            data += delay.bytesUsed;
-            size -= delay.bytesUsed;
-            time += delay.value;
+        if (size <= 0)
+            return false;
 
-            if (size <= 0)
-                break;
+        int messSize = 0;
+        MidiMessage mm (data, size, messSize, lastStatusByte, time);
 
-            int messSize = 0;
-            const MidiMessage mm (data, size, messSize, lastStatusByte, time);
+        if (messSize <= 0)
+            return false;
 
-            if (messSize <= 0)
-                break;
+        size -= messSize;
+        data += messSize;
 
-            size -= messSize;
-            data += messSize;
+        auto firstByte = *(mm.getRawData());
 
-            result.addEvent (mm);
+        if ((firstByte & 0xf0) != 0xf0)
+            lastStatusByte = firstByte;
 
-            auto firstByte = *(mm.getRawData());
+        result = std::move (mm);
+        return true;
+    }
 
-            if ((firstByte & 0xf0) != 0xf0)
-                lastStatusByte = firstByte;
-        }
+    static MidiMessageSequence readTrack (const uint8* data, int size)
+    {
+        double time = 0;
+        uint8 lastStatusByte = 0;
+
+        MidiMessageSequence result;
+        MidiMessage mm;
+
+        while (readNextTrackEvent (data, size, time, lastStatusByte, mm))
+            result.addEvent (mm);
 
         return result;
     }
@@ -538,6 +548,136 @@ bool MidiFile::writeTrack (OutputStream& mainOut, const MidiMessageSequence& ms)
     return true;
 }
 
+//==============================================================================
+MidiFileReader::MidiFileReader() = default;
+
+bool MidiFileReader::parse (InputStream& sourceStream)
+{
+    trackChunks.clearQuick();
+    data.reset();
+
+    const int maxSensibleMidiFileSize = 200 * 1024 * 1024;
+
+    // (put a sanity-check on the file size, as midi files are generally small)
+    if (! sourceStream.readIntoMemoryBlock (data, maxSensibleMidiFileSize))
+        return false;
+
+    auto size = data.getSize();
+    auto d = static_cast<const uint8*> (data.getData());
+
+    const auto optHeader = MidiFileHelpers::parseMidiHeader (d, size);
+
+    if (! optHeader.valid)
+        return false;
+
+    const auto header = optHeader.value;
+    timeFormat = header.timeFormat;
+    fileType = header.fileType;
+
+    d += header.bytesRead;
+    size -= (size_t) header.bytesRead;
+
+    for (int track = 0; track < header.numberOfTracks; ++track)
+    {
+        const auto optChunkType = MidiFileHelpers::tryRead<uint32> (d, size);
+
+        if (! optChunkType.valid)
+            return false;
+
+        const auto optChunkSize = MidiFileHelpers::tryRead<uint32> (d, size);
+
+        if (! optChunkSize.valid)
+            return false;
+
+        const auto chunkSize = optChunkSize.value;
+
+        if (size < chunkSize)
+            return false;
+
+        if (optChunkType.value == ByteOrder::bigEndianInt ("MTrk"))
+            trackChunks.add ({ (size_t) (d - static_cast<const uint8*> (data.getData())),
+                               (int) chunkSize });
+
+        size -= chunkSize;
+        d += chunkSize;
+    }
+
+    return size == 0;
+}
+
+int MidiFileReader::getNumTracks() const noexcept       { return trackChunks.size(); }
+short MidiFileReader::getTimeFormat() const noexcept    { return timeFormat; }
+int MidiFileReader::getFileType() const noexcept        { return fileType; }
+
+bool MidiFileReader::readTrackInto (int trackIndex, MidiBuffer& destination) const
+{
+    if (! isPositiveAndBelow (trackIndex, trackChunks.size()))
+        return false;
+
+    const auto& chunk = trackChunks.getReference (trackIndex);
+    auto* d = static_cast<const uint8*> (data.getData()) + chunk.offset;
+    auto size = chunk.length;
+
+    double time = 0;
+    uint8 lastStatusByte = 0;
+    MidiMessage mm;
+
+    while (MidiFileHelpers::readNextTrackEvent (d, size, time, lastStatusByte, mm))
+        destination.addEvent (mm, roundToInt (time));
+
+    return true;
+}
+
+//==============================================================================
+MidiFileReader::Iterator::Iterator (const MidiFileReader& reader)
+{
+    for (const auto& chunk : reader.trackChunks)
+    {
+        TrackCursor cursor;
+        cursor.data = static_cast<const uint8*> (reader.data.getData()) + chunk.offset;
+        cursor.bytesRemaining = chunk.length;
+
+        advance (cursor);
+        cursors.add (cursor);
+    }
+}
+
+void MidiFileReader::Iterator::advance (TrackCursor& cursor)
+{
+    cursor.eventReady = MidiFileHelpers::readNextTrackEvent (cursor.data,
+                                                             cursor.bytesRemaining,
+                                                             cursor.time,
+                                                             cursor.lastStatusByte,
+                                                             cursor.nextEvent);
+}
+
+bool MidiFileReader::Iterator::getNextEvent (MidiMessage& result, int* trackIndex)
+{
+    int best = -1;
+
+    for (int i = 0; i < cursors.size(); ++i)
+    {
+        const auto& cursor = cursors.getReference (i);
+
+        if (cursor.eventReady
+             && (best < 0 || cursor.nextEvent.getTimeStamp()
+                               < cursors.getReference (best).nextEvent.getTimeStamp()))
+            best = i;
+    }
+
+    if (best < 0)
+        return false;
+
+    auto& cursor = cursors.getReference (best);
+    result = cursor.nextEvent;
+
+    if (trackIndex != nullptr)
+        *trackIndex = best;
+
+    advance (cursor);
+    return true;
+}
+
 //==============================================================================
 //==============================================================================
 #if JUCE_UNIT_TESTS
@@ -753,6 +893,80 @@ struct MidiFileTest  : public UnitTest
                 expectEquals (track.getEventPointer (0)->message.getTimeStamp(), (double) 0x0f);
             }
         }
+
+        beginTest ("Lazy reader locates tracks without decoding them");
+        {
+            MemoryOutputStream os;
+            writeTwoTrackFile (os);
+
+            MemoryInputStream is (os.getData(), os.getDataSize(), false);
+            MidiFileReader reader;
+
+            expect (reader.parse (is));
+            expectEquals (reader.getNumTracks(), 2);
+            expectEquals (reader.getTimeFormat(), (short) 96);
+            expectEquals (reader.getFileType(), 1);
+
+            {
+                // Truncated track chunk
+                MemoryInputStream truncated (os.getData(), os.getDataSize() - 1, false);
+                MidiFileReader failing;
+                expect (! failing.parse (truncated));
+            }
+        }
+
+        beginTest ("Lazy reader decodes single tracks on demand");
+        {
+            MemoryOutputStream os;
+            writeTwoTrackFile (os);
+
+            MemoryInputStream is (os.getData(), os.getDataSize(), false);
+            MidiFileReader reader;
+            expect (reader.parse (is));
+
+            MidiBuffer decoded;
+            expect (! reader.readTrackInto (2, decoded));
+            expect (reader.readTrackInto (0, decoded));
+            expectEquals (decoded.getNumEvents(), 2);
+
+            auto event = decoded.begin();
+            expect ((*event).getMessage().isNoteOn());
+            expectEquals ((*event).samplePosition, 15);
+            ++event;
+            expect ((*event).getMessage().isNoteOff());
+            expectEquals ((*event).samplePosition, 25);
+        }
+
+        beginTest ("Lazy reader streams all tracks in timestamp order");
+        {
+            MemoryOutputStream os;
+            writeTwoTrackFile (os);
+
+            MemoryInputStream is (os.getData(), os.getDataSize(), false);
+            MidiFileReader reader;
+            expect (reader.parse (is));
+
+            MidiFileReader::Iterator iterator (reader);
+            MidiMessage message;
+            int trackIndex = -1;
+
+            expect (iterator.getNextEvent (message, &trackIndex));
+            expect (message.isController());
+            expectEquals (message.getTimeStamp(), 5.0);
+            expectEquals (trackIndex, 1);
+
+            expect (iterator.getNextEvent (message, &trackIndex));
+            expect (message.isNoteOn());
+            expectEquals (message.getTimeStamp(), 15.0);
+            expectEquals (trackIndex, 0);
+
+            expect (iterator.getNextEvent (message, &trackIndex));
+            expect (message.isNoteOff());
+            expectEquals (message.getTimeStamp(), 25.0);
+            expectEquals (trackIndex, 0);
+
+            expect (! iterator.getNextEvent (message, &trackIndex));
+        }
     }
 
     template <typename Fn>
@@ -797,6 +1011,20 @@ struct MidiFileTest  : public UnitTest
         for (const auto& byte : bytes)
             os.writeByte ((char) byte);
     }
+
+    static void writeTwoTrackFile (OutputStream& os)
+    {
+        writeBytes (os, { 'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 1, 0, 2, 0, 96 });
+
+        // Track 0: note-on at tick 15, note-off at tick 25
+        writeBytes (os, { 'M', 'T', 'r', 'k', 0, 0, 0, 8 });
+        writeBytes (os, { 0x0f, 0x90, 0x40, 0x40 });
+        writeBytes (os, { 0x0a, 0x80, 0x40, 0x00 });
+
+        // Track 1: controller at tick 5
+        writeBytes (os, { 'M', 'T', 'r', 'k', 0, 0, 0, 4 });
+        writeBytes (os, { 0x05, 0xb0, 0x07, 0x64 });
+    }
 };
 
 static MidiFileTest midiFileTests;
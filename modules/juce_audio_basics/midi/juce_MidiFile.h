@@ -195,4 +195,121 @@ private:
     JUCE_LEAK_DETECTOR (MidiFile)
 };
 
+//==============================================================================
+/**
+    Reads a standard midi file lazily, without decoding its events up-front.
+
+    Unlike MidiFile::readFrom(), which eagerly parses every track into
+    heap-allocated MidiMessageSequences, this just parses the file's header and
+    records where each track chunk lives. Individual tracks can then be decoded
+    on demand into a MidiBuffer, which packs the events into its contiguous
+    storage, or the whole file can be streamed in timestamp order with an
+    Iterator without ever materialising complete sequences. This makes scanning
+    a large library of midi files far cheaper when only the metadata or a few
+    tracks of each file are actually needed.
+
+    The reader keeps the raw bytes of the stream in memory, and its Iterators
+    read directly from them, so an Iterator mustn't outlive its reader.
+
+    @see MidiFile
+
+    @tags{Audio}
+*/
+class JUCE_API  MidiFileReader
+{
+public:
+    //==============================================================================
+    /** Creates an empty reader - call parse() to give it a stream to read. */
+    MidiFileReader();
+
+    /** Reads the stream and parses its header and the positions of its track chunks.
+
+        No events are decoded - for a well-formed file this only inspects the few
+        bytes of each chunk header, however long the tracks are.
+
+        @returns true if the data had a valid midi file header and chunk layout
+    */
+    bool parse (InputStream& sourceStream);
+
+    /** Returns the number of track chunks that parse() found. */
+    int getNumTracks() const noexcept;
+
+    /** Returns the time format from the file's header.
+        @see MidiFile::getTimeFormat
+    */
+    short getTimeFormat() const noexcept;
+
+    /** Returns the file type (0, 1 or 2) from the file's header. */
+    int getFileType() const noexcept;
+
+    /** Decodes a single track into the given buffer, on demand.
+
+        Each event is added with its absolute time in midi ticks as its buffer
+        position, so the buffer's contiguous storage acts as an arena for the
+        decoded events: they can be visited with a MidiBufferIterator without
+        any per-event heap allocation. The buffer isn't cleared first, so
+        several tracks can be merged into the same one.
+
+        @returns false if the track index is out of range
+    */
+    bool readTrackInto (int trackIndex, MidiBuffer& destination) const;
+
+    //==============================================================================
+    /** Streams the events of every track of a MidiFileReader in timestamp order.
+
+        Only one pending event per track is decoded at a time, so arbitrarily
+        large files can be scanned with a small, fixed amount of memory. Events
+        in the same track keep their original order; where several tracks have
+        an event at the same time, the lowest track index comes first.
+    */
+    class JUCE_API  Iterator
+    {
+    public:
+        /** Creates an iterator over all the tracks of the given reader.
+            The reader must remain valid for the lifetime of the iterator.
+        */
+        Iterator (const MidiFileReader& reader);
+
+        /** Fetches the next event in timestamp order.
+
+            @param result      on success, the message, with its timestamp set in midi ticks
+            @param trackIndex  if not nullptr, this is set to the index of the track
+                               that the event came from
+            @returns false when the end of every track has been reached
+        */
+        bool getNextEvent (MidiMessage& result, int* trackIndex = nullptr);
+
+    private:
+        //==============================================================================
+        struct TrackCursor
+        {
+            const uint8* data = nullptr;
+            int bytesRemaining = 0;
+            double time = 0;
+            uint8 lastStatusByte = 0;
+            bool eventReady = false;
+            MidiMessage nextEvent;
+        };
+
+        void advance (TrackCursor&);
+
+        Array<TrackCursor> cursors;
+    };
+
+private:
+    //==============================================================================
+    struct TrackChunk
+    {
+        size_t offset;
+        int length;
+    };
+
+    MemoryBlock data;
+    Array<TrackChunk> trackChunks;
+    short timeFormat = 0;
+    short fileType = 0;
+
+    JUCE_LEAK_DETECTOR (MidiFileReader)
+};
+
 } // namespace juce
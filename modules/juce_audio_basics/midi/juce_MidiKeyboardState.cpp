@@ -31,9 +31,8 @@ MidiKeyboardState::MidiKeyboardState()
 //==============================================================================
 void MidiKeyboardState::reset()
 {
-    const ScopedLock sl (lock);
     zerostruct (noteStates);
-    eventsToAdd.clear();
+    eventFifo.reset();
 }
 
 bool MidiKeyboardState::isNoteOn (const int midiChannel, const int n) const noexcept
@@ -50,19 +49,29 @@ bool MidiKeyboardState::isNoteOnForChannels (const int midiChannelMask, const in
             && (noteStates[n] & midiChannelMask) != 0;
 }
 
+void MidiKeyboardState::queueEvent (const QueuedEvent& event) noexcept
+{
+    int start1, size1, start2, size2;
+    eventFifo.prepareToWrite (1, start1, size1, start2, size2);
+
+    // If the queue is full the event is quietly dropped: using the state without
+    // anything draining it via processNextMidiBuffer() is a perfectly valid
+    // configuration. The oldest events can't safely be overwritten from here, as
+    // a consumer may be reading them concurrently on another thread.
+    if (size1 > 0)
+        queuedEvents[start1] = event;
+
+    eventFifo.finishedWrite (size1 + size2);
+}
+
 void MidiKeyboardState::noteOn (const int midiChannel, const int midiNoteNumber, const float velocity)
 {
     jassert (midiChannel > 0 && midiChannel <= 16);
     jassert (isPositiveAndBelow (midiNoteNumber, 128));
 
-    const ScopedLock sl (lock);
-
     if (isPositiveAndBelow (midiNoteNumber, 128))
     {
-        const int timeNow = (int) Time::getMillisecondCounter();
-        eventsToAdd.addEvent (MidiMessage::noteOn (midiChannel, midiNoteNumber, velocity), timeNow);
-        eventsToAdd.clear (0, timeNow - 500);
-
+        queueEvent ({ Time::getMillisecondCounter(), midiChannel, midiNoteNumber, velocity, true });
         noteOnInternal (midiChannel, midiNoteNumber, velocity);
     }
 }
@@ -71,21 +80,18 @@ void MidiKeyboardState::noteOnInternal  (const int midiChannel, const int midiNo
 {
     if (isPositiveAndBelow (midiNoteNumber, 128))
     {
-        noteStates[midiNoteNumber] = static_cast<uint16> (noteStates[midiNoteNumber] | (1 << (midiChannel - 1)));
+        noteStates[midiNoteNumber].fetch_or (static_cast<uint16> (1 << (midiChannel - 1)));
+
+        const ScopedLock sl (listenerLock);
         listeners.call ([&] (Listener& l) { l.handleNoteOn (this, midiChannel, midiNoteNumber, velocity); });
     }
 }
 
 void MidiKeyboardState::noteOff (const int midiChannel, const int midiNoteNumber, const float velocity)
 {
-    const ScopedLock sl (lock);
-
     if (isNoteOn (midiChannel, midiNoteNumber))
     {
-        const int timeNow = (int) Time::getMillisecondCounter();
-        eventsToAdd.addEvent (MidiMessage::noteOff (midiChannel, midiNoteNumber), timeNow);
-        eventsToAdd.clear (0, timeNow - 500);
-
+        queueEvent ({ Time::getMillisecondCounter(), midiChannel, midiNoteNumber, velocity, false });
         noteOffInternal (midiChannel, midiNoteNumber, velocity);
     }
 }
@@ -94,15 +100,15 @@ void MidiKeyboardState::noteOffInternal  (const int midiChannel, const int midiN
 {
     if (isNoteOn (midiChannel, midiNoteNumber))
     {
-        noteStates[midiNoteNumber] = static_cast<uint16> (noteStates[midiNoteNumber] & ~(1 << (midiChannel - 1)));
+        noteStates[midiNoteNumber].fetch_and (static_cast<uint16> (~(1 << (midiChannel - 1))));
+
+        const ScopedLock sl (listenerLock);
         listeners.call ([&] (Listener& l) { l.handleNoteOff (this, midiChannel, midiNoteNumber, velocity); });
     }
 }
 
 void MidiKeyboardState::allNotesOff (const int midiChannel)
 {
-    const ScopedLock sl (lock);
-
     if (midiChannel <= 0)
     {
         for (int i = 1; i <= 16; ++i)
@@ -137,36 +143,68 @@ void MidiKeyboardState::processNextMidiBuffer (MidiBuffer& buffer,
                                                const int numSamples,
                                                const bool injectIndirectEvents)
 {
-    const ScopedLock sl (lock);
-
     for (const auto metadata : buffer)
         processNextMidiEvent (metadata.getMessage());
 
-    if (injectIndirectEvents)
+    int start1, size1, start2, size2;
+    eventFifo.prepareToRead (eventFifo.getNumReady(), start1, size1, start2, size2);
+
+    if (injectIndirectEvents && size1 + size2 > 0)
     {
-        const int firstEventToAdd = eventsToAdd.getFirstEventTime();
-        const double scaleFactor = numSamples / (double) (eventsToAdd.getLastEventTime() + 1 - firstEventToAdd);
+        auto getEvent = [this, start1, size1, start2] (int i) -> const QueuedEvent&
+        {
+            return queuedEvents[i < size1 ? start1 + i : start2 + (i - size1)];
+        };
+
+        const auto numEvents = size1 + size2;
+        const auto lastEventTime = getEvent (numEvents - 1).time;
+
+        // ignore anything that's been stuck in the queue for ages - probably
+        // nothing has been consuming the events until now
+        const auto earliestAllowedTime = lastEventTime > 500 ? lastEventTime - 500 : 0;
+        auto firstEventTime = lastEventTime;
+
+        for (int i = 0; i < numEvents; ++i)
+        {
+            const auto t = getEvent (i).time;
 
-        for (const auto metadata : eventsToAdd)
+            if (t >= earliestAllowedTime)
+            {
+                firstEventTime = t;
+                break;
+            }
+        }
+
+        const auto scaleFactor = numSamples / (double) (lastEventTime + 1 - firstEventTime);
+
+        for (int i = 0; i < numEvents; ++i)
         {
-            const auto pos = jlimit (0, numSamples - 1, roundToInt ((metadata.samplePosition - firstEventToAdd) * scaleFactor));
-            buffer.addEvent (metadata.getMessage(), startSample + pos);
+            const auto& event = getEvent (i);
+
+            if (event.time < earliestAllowedTime)
+                continue;
+
+            const auto pos = jlimit (0, numSamples - 1, roundToInt ((double) (event.time - firstEventTime) * scaleFactor));
+
+            buffer.addEvent (event.isNoteOn ? MidiMessage::noteOn  (event.channel, event.note, event.velocity)
+                                            : MidiMessage::noteOff (event.channel, event.note),
+                             startSample + pos);
         }
     }
 
-    eventsToAdd.clear();
+    eventFifo.finishedRead (size1 + size2);
 }
 
 //==============================================================================
 void MidiKeyboardState::addListener (Listener* listener)
 {
-    const ScopedLock sl (lock);
+    const ScopedLock sl (listenerLock);
     listeners.add (listener);
 }
 
 void MidiKeyboardState::removeListener (Listener* listener)
 {
-    const ScopedLock sl (lock);
+    const ScopedLock sl (listenerLock);
     listeners.remove (listener);
 }
 
@@ -36,6 +36,12 @@ namespace juce
     methods, and midi messages for these events will be merged into the
     midi stream that gets processed by processNextMidiBuffer().
 
+    The key states are stored atomically and injected events travel through a
+    lock-free queue, so noteOn() and noteOff() calls from an on-screen keyboard
+    never block an audio callback that's busy in processNextMidiBuffer(). Note
+    that both of those paths make synchronous calls to any registered listeners,
+    which is the one place where the two threads are briefly serialized.
+
     @tags{Audio}
 */
 class JUCE_API  MidiKeyboardState
@@ -179,13 +185,25 @@ public:
 
 private:
     //==============================================================================
-    CriticalSection lock;
+    struct QueuedEvent
+    {
+        uint32 time;
+        int channel, note;
+        float velocity;
+        bool isNoteOn;
+    };
+
+    enum { eventQueueSize = 512 };
+
+    CriticalSection listenerLock;
     std::atomic<uint16> noteStates[128];
-    MidiBuffer eventsToAdd;
+    AbstractFifo eventFifo { eventQueueSize };
+    HeapBlock<QueuedEvent> queuedEvents { (size_t) eventQueueSize };
     ListenerList<Listener> listeners;
 
     void noteOnInternal  (int midiChannel, int midiNoteNumber, float velocity);
     void noteOffInternal (int midiChannel, int midiNoteNumber, float velocity);
+    void queueEvent (const QueuedEvent&) noexcept;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiKeyboardState)
 };
@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct MidiKeyboardStateTests  : public UnitTest
+{
+    MidiKeyboardStateTests()  : UnitTest ("MidiKeyboardState", UnitTestCategories::midi)  {}
+
+    void runTest() override
+    {
+        beginTest ("Note state tracking");
+        {
+            MidiKeyboardState state;
+
+            state.noteOn (1, 60, 0.5f);
+            state.noteOn (2, 61, 0.5f);
+
+            expect (state.isNoteOn (1, 60));
+            expect (! state.isNoteOn (2, 60));
+            expect (state.isNoteOn (2, 61));
+            expect (state.isNoteOnForChannels (0xffff, 60));
+            expect (state.isNoteOnForChannels (1 << 1, 61));
+            expect (! state.isNoteOnForChannels (1 << 0, 61));
+
+            state.noteOff (1, 60, 0.0f);
+            expect (! state.isNoteOn (1, 60));
+            expect (state.isNoteOn (2, 61));
+
+            state.reset();
+            expect (! state.isNoteOn (2, 61));
+        }
+
+        beginTest ("Injected events reach the processed buffer");
+        {
+            MidiKeyboardState state;
+            state.noteOn (3, 64, 0.75f);
+            state.noteOff (3, 64, 0.0f);
+
+            MidiBuffer buffer;
+            state.processNextMidiBuffer (buffer, 0, 512, true);
+
+            Array<MidiMessage> messages;
+
+            for (const auto metadata : buffer)
+                messages.add (metadata.getMessage());
+
+            expectEquals (messages.size(), 2);
+            expect (messages[0].isNoteOn() && messages[0].getChannel() == 3 && messages[0].getNoteNumber() == 64);
+            expect (messages[1].isNoteOff() && messages[1].getChannel() == 3 && messages[1].getNoteNumber() == 64);
+
+            // the queue should now be empty
+            buffer.clear();
+            state.processNextMidiBuffer (buffer, 0, 512, true);
+            expect (buffer.isEmpty());
+        }
+
+        beginTest ("Buffer events update the state");
+        {
+            MidiKeyboardState state;
+
+            MidiBuffer buffer;
+            buffer.addEvent (MidiMessage::noteOn (5, 40, 0.5f), 0);
+            state.processNextMidiBuffer (buffer, 0, 512, true);
+
+            expect (state.isNoteOn (5, 40));
+
+            buffer.clear();
+            buffer.addEvent (MidiMessage::noteOff (5, 40), 0);
+            state.processNextMidiBuffer (buffer, 0, 512, true);
+
+            expect (! state.isNoteOn (5, 40));
+        }
+
+        beginTest ("Injected events stay within the block and in order");
+        {
+            MidiKeyboardState state;
+
+            for (int note = 20; note < 30; ++note)
+                state.noteOn (1, note, 0.5f);
+
+            MidiBuffer buffer;
+            const int startSample = 100, numSamples = 256;
+            state.processNextMidiBuffer (buffer, startSample, numSamples, true);
+
+            int lastPosition = startSample, count = 0;
+
+            for (const auto metadata : buffer)
+            {
+                expect (metadata.samplePosition >= startSample);
+                expect (metadata.samplePosition < startSample + numSamples);
+                expect (metadata.samplePosition >= lastPosition);
+
+                lastPosition = metadata.samplePosition;
+                ++count;
+            }
+
+            expectEquals (count, 10);
+        }
+    }
+};
+
+static MidiKeyboardStateTests midiKeyboardStateTests;
+
+} // namespace juce
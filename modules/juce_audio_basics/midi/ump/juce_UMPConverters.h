@@ -163,6 +163,95 @@ namespace universal_midi_packets
 
         Midi1ToBytestreamTranslator translator;
     };
+
+    /**
+        Converts a sequence of Universal MIDI Packets directly into a MidiBuffer
+        in a single pass.
+
+        Unlike ToBytestreamDispatcher, which materialises a MidiMessage for every
+        converted packet, this writes short messages straight into the output
+        buffer, so converting a dense stream of channel voice messages doesn't
+        construct any intermediate MidiMessage objects. Only SysEx messages,
+        which may span several packets, are accumulated before being added.
+
+        Both MIDI 1.0 and MIDI 2.0 protocol packets are understood; MIDI 2.0
+        channel voice messages are converted using the default MIDI 2.0 to
+        MIDI 1.0 translation.
+
+        @tags{Audio}
+    */
+    class ToMidiBufferConverter
+    {
+    public:
+        /** Ensures that there is room in the internal buffer for a sysex message
+            of at least `initialBufferSize` bytes.
+        */
+        explicit ToMidiBufferConverter (int initialBufferSize)
+            : translator (initialBufferSize) {}
+
+        /** Converts all the packets in a collection, adding the results to
+            `output` at `samplePosition`.
+
+            The output buffer is not cleared first. To avoid allocation during
+            the conversion, preallocate it with MidiBuffer::ensureSize.
+        */
+        void convert (const Packets& packets, int samplePosition, MidiBuffer& output)
+        {
+            convert (packets.data(), packets.size(), samplePosition, output);
+        }
+
+        /** Converts a contiguous range of words forming a series of complete
+            packets, adding the results to `output` at `samplePosition`.
+        */
+        void convert (const uint32_t* words, size_t numWords, int samplePosition, MidiBuffer& output)
+        {
+            for (const auto& packet : ViewRange (words, numWords))
+                convert (packet, samplePosition, output);
+        }
+
+        /** Converts a single packet, adding the results to `output` at
+            `samplePosition`.
+        */
+        void convert (const View& packet, int samplePosition, MidiBuffer& output)
+        {
+            Conversion::midi2ToMidi1DefaultTranslation (packet, [&] (const View& midi1)
+            {
+                writeToBuffer (midi1, samplePosition, output);
+            });
+        }
+
+        void reset() { translator.reset(); }
+
+    private:
+        void writeToBuffer (const View& packet, int samplePosition, MidiBuffer& output)
+        {
+            const auto firstWord = packet[0];
+
+            if (packet.size() == 1 && ! translator.isAccumulatingSysEx())
+            {
+                // Utility messages don't translate to bytestream format
+                if (Utils::getMessageType (firstWord) == 0x00)
+                    return;
+
+                const std::array<uint8_t, 3> bytes { { uint8_t ((firstWord >> 0x10) & 0xff),
+                                                       uint8_t ((firstWord >> 0x08) & 0xff),
+                                                       uint8_t ((firstWord >> 0x00) & 0xff) } };
+                output.addEvent (bytes.data(),
+                                 MidiMessage::getMessageLengthFromFirstByte (bytes.front()),
+                                 samplePosition);
+                return;
+            }
+
+            // SysEx packets, and packets which may terminate a SysEx message
+            // that is currently being accumulated, go through the translator
+            translator.dispatch (packet, 0, [&] (const MidiMessage& m)
+            {
+                output.addEvent (m, samplePosition);
+            });
+        }
+
+        Midi1ToBytestreamTranslator translator;
+    };
 }
 }
 
@@ -124,6 +124,50 @@ private:
    #endif
 };
 
+//==============================================================================
+/**
+    A non-owning wrapper around a contiguous range of 32-bit words containing
+    a sequence of complete Universal MIDI Packets.
+
+    This allows iterating over packets that live in externally-owned memory
+    (a driver buffer, a Packets collection, a lock-free FIFO...) without
+    copying the words or materialising MidiMessage objects, which makes it
+    suitable for pass-through routing. Dereferencing the iterators yields
+    View objects, which can be queried in place and forwarded directly to
+    Packets::add or any of the converters.
+
+    The range must contain only complete packets - truncated packets are
+    not allowed.
+
+    @tags{Audio}
+*/
+class ViewRange
+{
+public:
+    /** Creates an empty range. */
+    ViewRange() noexcept = default;
+
+    /** Creates a range over `numWords` words starting at `dataIn`. */
+    ViewRange (const uint32_t* dataIn, size_t numWords) noexcept
+        : ptr (dataIn), words (numWords) {}
+
+    Iterator begin()  const noexcept { return cbegin(); }
+    Iterator cbegin() const noexcept { return Iterator (ptr, words); }
+
+    Iterator end()    const noexcept { return cend(); }
+    Iterator cend()   const noexcept { return Iterator (ptr + words, 0); }
+
+    /** Gets a pointer to the first word in the range. */
+    const uint32_t* data() const noexcept { return ptr; }
+
+    /** Returns the number of words (not packets!) in the range. */
+    size_t size() const noexcept { return words; }
+
+private:
+    const uint32_t* ptr = nullptr;
+    size_t words = 0;
+};
+
 }
 }
 
@@ -93,6 +93,9 @@ public:
         }
     }
 
+    /** Returns true if a multi-packet SysEx message is currently being accumulated. */
+    bool isAccumulatingSysEx() const noexcept { return ! pendingSysExData.empty(); }
+
     /** Converts from a Universal MIDI Packet to MIDI 1 bytestream format.
 
         This is only capable of converting a single Universal MIDI Packet to
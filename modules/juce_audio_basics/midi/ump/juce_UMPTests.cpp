@@ -871,6 +871,84 @@ public:
 
             checkMidi1ToMidi2Conversion (midi1, midi2);
         }
+
+        beginTest ("Packets convert to a MidiBuffer in a single pass");
+        {
+            MidiBuffer expected;
+            Packets allPackets;
+
+            forEachNonSysExTestMessage (random, [&] (const MidiMessage& m)
+            {
+                expected.addEvent (m, 0);
+                Conversion::toMidi1 (m, allPackets);
+            });
+
+            const auto sysEx = createRandomSysEx (random, 100);
+            expected.addEvent (sysEx, 0);
+            Conversion::toMidi1 (sysEx, allPackets);
+
+            MidiBuffer output;
+            output.ensureSize (size_t (expected.data.size()));
+
+            ToMidiBufferConverter bufferConverter (0);
+            bufferConverter.convert (allPackets, 0, output);
+
+            expect (equal (expected, output));
+        }
+
+        beginTest ("MIDI 2.0 packets convert to a MidiBuffer using the default translation");
+        {
+            Packets midi2;
+            midi2.add (PacketX2 { 0x40904000, 0x12345678 });
+            midi2.add (PacketX2 { 0x40d20000, 0x87654321 });
+
+            MidiBuffer viaDispatcher;
+            ToBytestreamDispatcher dispatcher (0);
+            dispatcher.dispatch (midi2.data(),
+                                 midi2.data() + midi2.size(),
+                                 0,
+                                 [&] (const MidiMessage& m) { viaDispatcher.addEvent (m, 0); });
+
+            MidiBuffer viaConverter;
+            ToMidiBufferConverter bufferConverter (0);
+            bufferConverter.convert (midi2, 0, viaConverter);
+
+            expect (viaDispatcher.getNumEvents() == 2);
+            expect (equal (viaDispatcher, viaConverter));
+        }
+
+        beginTest ("View ranges allow in-place iteration over raw words");
+        {
+            Packets packets;
+            packets.add (PacketX1 { 0x20904040 });
+            Conversion::toMidi1 (createRandomSysEx (random, 20), packets);
+            packets.add (PacketX2 { 0x40d20000, 0x87654321 });
+            packets.add (PacketX1 { 0x20803000 });
+
+            const ViewRange range { packets.data(), packets.size() };
+            expect (range.data() == packets.data());
+            expect (range.size() == packets.size());
+
+            auto it = packets.cbegin();
+
+            for (const auto& view : range)
+            {
+                expect (view.data() == it->data());
+                expect (view.size() == it->size());
+                ++it;
+            }
+
+            expect (it == packets.cend());
+
+            // packets can be forwarded without materialising MidiMessages
+            Packets passedThrough;
+            passedThrough.reserve (range.size());
+
+            for (const auto& view : range)
+                passedThrough.add (view);
+
+            checkBytestreamConversion (passedThrough, packets);
+        }
     }
 
 private:
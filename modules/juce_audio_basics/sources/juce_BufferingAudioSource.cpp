@@ -30,7 +30,25 @@ BufferingAudioSource::BufferingAudioSource (PositionableAudioSource* s,
                                             int numChannels,
                                             bool prefillBufferOnPrepareToPlay)
     : source (s, deleteSourceWhenDeleted),
-      backgroundThread (thread),
+      backgroundThread (&thread),
+      numberOfSamplesToBuffer (jmax (1024, bufferSizeSamples)),
+      numberOfChannels (numChannels),
+      prefillBuffer (prefillBufferOnPrepareToPlay)
+{
+    jassert (source != nullptr);
+
+    jassert (numberOfSamplesToBuffer > 1024); // not much point using this class if you're
+                                              //  not using a larger buffer..
+}
+
+BufferingAudioSource::BufferingAudioSource (PositionableAudioSource* s,
+                                            BufferingAudioSourceScheduler& schedulerToUse,
+                                            bool deleteSourceWhenDeleted,
+                                            int bufferSizeSamples,
+                                            int numChannels,
+                                            bool prefillBufferOnPrepareToPlay)
+    : source (s, deleteSourceWhenDeleted),
+      scheduler (&schedulerToUse),
       numberOfSamplesToBuffer (jmax (1024, bufferSizeSamples)),
       numberOfChannels (numChannels),
       prefillBuffer (prefillBufferOnPrepareToPlay)
@@ -55,7 +73,10 @@ void BufferingAudioSource::prepareToPlay (int samplesPerBlockExpected, double ne
          || bufferSizeNeeded != buffer.getNumSamples()
          || ! isPrepared)
     {
-        backgroundThread.removeTimeSliceClient (this);
+        if (scheduler != nullptr)
+            scheduler->removeSource (*this);
+        else
+            backgroundThread->removeTimeSliceClient (this);
 
         isPrepared = true;
         sampleRate = newSampleRate;
@@ -70,13 +91,20 @@ void BufferingAudioSource::prepareToPlay (int samplesPerBlockExpected, double ne
         bufferValidStart = 0;
         bufferValidEnd = 0;
 
-        backgroundThread.addTimeSliceClient (this);
+        if (scheduler != nullptr)
+            scheduler->addSource (*this);
+        else
+            backgroundThread->addTimeSliceClient (this);
 
         do
         {
             const ScopedUnlock ul (bufferRangeLock);
 
-            backgroundThread.moveToFrontOfQueue (this);
+            if (scheduler != nullptr)
+                scheduler->notify();
+            else
+                backgroundThread->moveToFrontOfQueue (this);
+
             Thread::sleep (5);
         }
         while (prefillBuffer
@@ -87,7 +115,11 @@ void BufferingAudioSource::prepareToPlay (int samplesPerBlockExpected, double ne
 void BufferingAudioSource::releaseResources()
 {
     isPrepared = false;
-    backgroundThread.removeTimeSliceClient (this);
+
+    if (scheduler != nullptr)
+        scheduler->removeSource (*this);
+    else
+        backgroundThread->removeTimeSliceClient (this);
 
     buffer.setSize (numberOfChannels, 0);
 
@@ -215,7 +247,23 @@ void BufferingAudioSource::setNextReadPosition (int64 newPosition)
     const ScopedLock sl (bufferRangeLock);
 
     nextPlayPos = newPosition;
-    backgroundThread.moveToFrontOfQueue (this);
+
+    if (scheduler != nullptr)
+        scheduler->notify();
+    else
+        backgroundThread->moveToFrontOfQueue (this);
+}
+
+int64 BufferingAudioSource::getNumReadySamples() const
+{
+    const ScopedLock sl (bufferRangeLock);
+
+    const auto pos = nextPlayPos.load();
+
+    if (pos < bufferValidStart)
+        return 0;
+
+    return jmax ((int64) 0, bufferValidEnd - pos);
 }
 
 Range<int> BufferingAudioSource::getValidBufferRange (int numSamples) const
@@ -244,10 +292,14 @@ bool BufferingAudioSource::readNextBufferChunk()
 
         newBVS = jmax ((int64) 0, nextPlayPos.load());
         newBVE = newBVS + buffer.getNumSamples() - 4;
+
+        if (auto readAheadLimit = maxReadAheadSamples.load())
+            newBVE = jmin (newBVE, newBVS + readAheadLimit);
+
         sectionToReadStart = 0;
         sectionToReadEnd = 0;
 
-        constexpr int maxChunkSize = 2048;
+        const int maxChunkSize = jmax (2048, maxChunkReadSize.load());
 
         if (newBVS < bufferValidStart || newBVS >= bufferValidEnd)
         {
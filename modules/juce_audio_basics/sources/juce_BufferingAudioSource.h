@@ -23,6 +23,8 @@
 namespace juce
 {
 
+class BufferingAudioSourceScheduler;
+
 //==============================================================================
 /**
     An AudioSource which takes another source as input, and buffers it using a thread.
@@ -61,6 +63,35 @@ public:
                           int numberOfChannels = 2,
                           bool prefillBufferOnPrepareToPlay = true);
 
+    /** Creates a BufferingAudioSource which is serviced by a shared scheduler.
+
+        Unlike the TimeSliceThread version, which round-robins between sources,
+        the scheduler always services whichever of its sources is closest to
+        running out of buffered data, so large numbers of streams degrade
+        gracefully as they approach the disk's bandwidth.
+
+        @param source                       the input source to read from
+        @param scheduler                    a shared scheduler that will perform the
+                                            background read-ahead. Its thread must be
+                                            running, and the object must not be deleted
+                                            until after any BufferingAudioSources that
+                                            are using it have been deleted!
+        @param deleteSourceWhenDeleted      if true, then the input source object will
+                                            be deleted when this object is deleted
+        @param numberOfSamplesToBuffer      the size of buffer to use for reading ahead
+        @param numberOfChannels             the number of channels that will be played
+        @param prefillBufferOnPrepareToPlay if true, then calling prepareToPlay on this object will
+                                            block until the buffer has been filled
+
+        @see BufferingAudioSourceScheduler
+    */
+    BufferingAudioSource (PositionableAudioSource* source,
+                          BufferingAudioSourceScheduler& scheduler,
+                          bool deleteSourceWhenDeleted,
+                          int numberOfSamplesToBuffer,
+                          int numberOfChannels = 2,
+                          bool prefillBufferOnPrepareToPlay = true);
+
     /** Destructor.
 
         The input source may be deleted depending on whether the deleteSourceWhenDeleted
@@ -97,6 +128,11 @@ public:
     */
     bool waitForNextAudioBlockReady (const AudioSourceChannelInfo& info, const uint32 timeout);
 
+    /** Returns the number of samples that are buffered and ready to be read
+        from the current read position without blocking.
+    */
+    int64 getNumReadySamples() const;
+
 private:
     //==============================================================================
     Range<int> getValidBufferRange (int numSamples) const;
@@ -106,17 +142,22 @@ private:
 
     //==============================================================================
     OptionalScopedPointer<PositionableAudioSource> source;
-    TimeSliceThread& backgroundThread;
+    TimeSliceThread* backgroundThread = nullptr;
+    BufferingAudioSourceScheduler* scheduler = nullptr;
     int numberOfSamplesToBuffer, numberOfChannels;
     AudioBuffer<float> buffer;
     CriticalSection callbackLock, bufferRangeLock;
     WaitableEvent bufferReadyEvent;
     int64 bufferValidStart = 0, bufferValidEnd = 0;
     std::atomic<int64> nextPlayPos { 0 };
+    std::atomic<int64> maxReadAheadSamples { 0 };
+    std::atomic<int> maxChunkReadSize { 2048 };
     double sampleRate = 0;
     bool wasSourceLooping = false, isPrepared = false;
     const bool prefillBuffer;
 
+    friend class BufferingAudioSourceScheduler;
+
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BufferingAudioSource)
 };
@@ -0,0 +1,316 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+BufferingAudioSourceScheduler::BufferingAudioSourceScheduler (const String& name)  : Thread (name)
+{
+}
+
+BufferingAudioSourceScheduler::~BufferingAudioSourceScheduler()
+{
+    stopThread (2000);
+}
+
+//==============================================================================
+void BufferingAudioSourceScheduler::setReadAheadTime (double seconds) noexcept
+{
+    readAheadSeconds = jmax (0.0, seconds);
+}
+
+double BufferingAudioSourceScheduler::getReadAheadTime() const noexcept
+{
+    return readAheadSeconds;
+}
+
+double BufferingAudioSourceScheduler::getMeasuredThroughput() const noexcept
+{
+    return measuredThroughput;
+}
+
+int BufferingAudioSourceScheduler::getNumSources() const
+{
+    const ScopedLock sl (listLock);
+    return sources.size();
+}
+
+//==============================================================================
+void BufferingAudioSourceScheduler::addSource (BufferingAudioSource& source)
+{
+    {
+        const ScopedLock sl (listLock);
+        sources.addIfNotAlreadyThere (&source);
+    }
+
+    notify();
+}
+
+void BufferingAudioSourceScheduler::removeSource (BufferingAudioSource& source)
+{
+    // Taking the callback lock makes sure that any read in progress for this
+    // source has finished before it returns.
+    const ScopedLock sl (callbackLock);
+    const ScopedLock sl2 (listLock);
+
+    sources.removeFirstMatchingValue (&source);
+}
+
+void BufferingAudioSourceScheduler::applyReadParameters (BufferingAudioSource& source) const
+{
+    const auto secondsAhead = readAheadSeconds.load();
+
+    source.maxReadAheadSamples = secondsAhead > 0 && source.sampleRate > 0
+                                   ? jmax ((int64) 1024, (int64) (secondsAhead * source.sampleRate))
+                                   : 0;
+
+    // Coalesce the read-ahead into chunks covering a roughly constant amount
+    // of time, so a faster disk gets fewer, larger reads.
+    const auto throughput = measuredThroughput.load();
+
+    if (throughput > 0)
+        source.maxChunkReadSize = jlimit (2048, 1 << 16, (int) (throughput * 0.05));
+}
+
+void BufferingAudioSourceScheduler::updateThroughput (int64 numSamplesRead, double elapsedSeconds)
+{
+    if (numSamplesRead <= 0)
+        return;
+
+    const auto measured = (double) numSamplesRead / jmax (1.0e-6, elapsedSeconds);
+    const auto previous = measuredThroughput.load();
+
+    measuredThroughput = previous > 0 ? previous * 0.8 + measured * 0.2
+                                      : measured;
+}
+
+//==============================================================================
+bool BufferingAudioSourceScheduler::performNextRead()
+{
+    struct RankedSource
+    {
+        BufferingAudioSource* source;
+        double secondsUntilUnderrun;
+    };
+
+    Array<RankedSource> ranked;
+
+    {
+        const ScopedLock sl (listLock);
+        ranked.ensureStorageAllocated (sources.size());
+
+        for (auto* s : sources)
+        {
+            const auto readySamples = (double) s->getNumReadySamples();
+
+            ranked.add ({ s, s->sampleRate > 0 ? readySamples / s->sampleRate
+                                               : readySamples });
+        }
+    }
+
+    std::stable_sort (ranked.begin(), ranked.end(),
+                      [] (const RankedSource& a, const RankedSource& b)
+                      {
+                          return a.secondsUntilUnderrun < b.secondsUntilUnderrun;
+                      });
+
+    for (auto& entry : ranked)
+    {
+        const ScopedLock sl (callbackLock);
+
+        {
+            const ScopedLock sl2 (listLock);
+
+            if (! sources.contains (entry.source))
+                continue;
+        }
+
+        applyReadParameters (*entry.source);
+
+        const auto readyBefore = entry.source->getNumReadySamples();
+        const auto startTime = Time::getMillisecondCounterHiRes();
+
+        if (entry.source->readNextBufferChunk())
+        {
+            // The play position may have moved while we were reading, so this
+            // slightly underestimates - it's only used as a chunk-sizing hint.
+            updateThroughput (entry.source->getNumReadySamples() - readyBefore,
+                              (Time::getMillisecondCounterHiRes() - startTime) * 0.001);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void BufferingAudioSourceScheduler::run()
+{
+    while (! threadShouldExit())
+        if (! performNextRead())
+            wait (10);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class BufferingAudioSourceSchedulerTests  : public UnitTest
+{
+public:
+    BufferingAudioSourceSchedulerTests()
+        : UnitTest ("BufferingAudioSourceScheduler", UnitTestCategories::audio)
+    {}
+
+    struct RampSource  : public PositionableAudioSource
+    {
+        void prepareToPlay (int, double) override {}
+        void releaseResources() override {}
+
+        void getNextAudioBlock (const AudioSourceChannelInfo& info) override
+        {
+            ++numReads;
+            largestRead = jmax (largestRead, info.numSamples);
+
+            for (int chan = 0; chan < info.buffer->getNumChannels(); ++chan)
+            {
+                auto* dest = info.buffer->getWritePointer (chan, info.startSample);
+
+                for (int i = 0; i < info.numSamples; ++i)
+                    dest[i] = (float) (position + i);
+            }
+
+            position += info.numSamples;
+        }
+
+        void setNextReadPosition (int64 newPosition) override    { position = newPosition; }
+        int64 getNextReadPosition() const override               { return position; }
+        int64 getTotalLength() const override                    { return 1 << 30; }
+        bool isLooping() const override                          { return false; }
+
+        int64 position = 0;
+        int numReads = 0, largestRead = 0;
+    };
+
+    void runTest() override
+    {
+        constexpr int bufferSize = 8192;
+        constexpr double rate = 44100.0;
+
+        beginTest ("The source closest to underrunning is serviced first");
+        {
+            BufferingAudioSourceScheduler scheduler;
+            RampSource rampA, rampB;
+            BufferingAudioSource sourceA (&rampA, scheduler, false, bufferSize, 1, false),
+                                 sourceB (&rampB, scheduler, false, bufferSize, 1, false);
+
+            sourceA.prepareToPlay (512, rate);
+            sourceB.prepareToPlay (512, rate);
+            expectEquals (scheduler.getNumSources(), 2);
+
+            while (scheduler.performNextRead()) {}
+
+            expect (sourceA.getNumReadySamples() >= bufferSize / 2);
+            expect (sourceB.getNumReadySamples() >= bufferSize / 2);
+
+            AudioBuffer<float> scratch (1, 1024);
+            AudioSourceChannelInfo info (&scratch, 0, 1024);
+            sourceB.getNextAudioBlock (info);
+
+            const auto readsFromA = rampA.numReads;
+            const auto readsFromB = rampB.numReads;
+
+            expect (scheduler.performNextRead());
+            expectEquals (rampA.numReads, readsFromA);
+            expect (rampB.numReads > readsFromB);
+        }
+
+        beginTest ("Buffered data reads back correctly");
+        {
+            BufferingAudioSourceScheduler scheduler;
+            RampSource ramp;
+            BufferingAudioSource source (&ramp, scheduler, false, bufferSize, 1, false);
+
+            source.prepareToPlay (512, rate);
+
+            while (scheduler.performNextRead()) {}
+
+            AudioBuffer<float> scratch (1, 2048);
+            AudioSourceChannelInfo info (&scratch, 0, 2048);
+            source.getNextAudioBlock (info);
+
+            for (int i = 0; i < 2048; ++i)
+                expectEquals (scratch.getSample (0, i), (float) i);
+        }
+
+        beginTest ("Larger coalesced reads once throughput has been measured");
+        {
+            BufferingAudioSourceScheduler scheduler;
+            RampSource ramp;
+            BufferingAudioSource source (&ramp, scheduler, false, bufferSize, 1, false);
+
+            source.prepareToPlay (512, rate);
+
+            while (scheduler.performNextRead()) {}
+
+            expect (scheduler.getMeasuredThroughput() > 0);
+            expect (ramp.largestRead > 2048);
+        }
+
+        beginTest ("Read-ahead time limits how far a source buffers");
+        {
+            BufferingAudioSourceScheduler scheduler;
+            scheduler.setReadAheadTime (0.05);
+
+            RampSource ramp;
+            BufferingAudioSource source (&ramp, scheduler, false, bufferSize, 1, false);
+
+            source.prepareToPlay (512, rate);
+
+            while (scheduler.performNextRead()) {}
+
+            const auto limit = (int64) (0.05 * rate);
+            expect (source.getNumReadySamples() <= limit);
+            expect (source.getNumReadySamples() > 1024);
+        }
+
+        beginTest ("The scheduler thread prefills a source");
+        {
+            BufferingAudioSourceScheduler scheduler;
+            scheduler.startThread();
+
+            RampSource ramp;
+            BufferingAudioSource source (&ramp, scheduler, false, bufferSize, 1, true);
+
+            source.prepareToPlay (512, rate);
+            expect (source.getNumReadySamples() >= bufferSize / 2);
+
+            source.releaseResources();
+            scheduler.stopThread (2000);
+        }
+    }
+};
+
+static BufferingAudioSourceSchedulerTests bufferingAudioSourceSchedulerTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A shared background thread that performs the read-ahead for a group of
+    BufferingAudioSources, always servicing whichever source is most urgent.
+
+    A TimeSliceThread gives each of its clients a fair share of the thread, so
+    with many streams a source that's about to run dry waits behind sources
+    whose buffers are already full. This scheduler instead ranks its sources by
+    how much buffered audio they have left and services the one closest to
+    underrunning first, so the available disk bandwidth goes where it's needed.
+
+    It also measures the throughput the sources are achieving and coalesces
+    read-ahead into correspondingly larger chunks, which keeps the per-read
+    overhead down when streaming from fast storage.
+
+    To use one, create it, start its thread, and pass it to the
+    BufferingAudioSource constructor that takes a scheduler:
+
+    @code
+    BufferingAudioSourceScheduler scheduler;
+    scheduler.startThread();
+
+    auto stream = std::make_unique<BufferingAudioSource> (reader, scheduler,
+                                                          false, 65536);
+    @endcode
+
+    @see BufferingAudioSource, TimeSliceThread
+
+    @tags{Audio}
+*/
+class JUCE_API  BufferingAudioSourceScheduler  : public Thread
+{
+public:
+    //==============================================================================
+    /** Creates a scheduler.
+
+        When first created, the thread is not running. Use the startThread()
+        method to start it.
+    */
+    explicit BufferingAudioSourceScheduler (const String& threadName = "Audio Streaming Scheduler");
+
+    /** Destructor.
+
+        Make sure all the BufferingAudioSources using this scheduler have been
+        deleted or have had releaseResources() called before deleting it.
+    */
+    ~BufferingAudioSourceScheduler() override;
+
+    //==============================================================================
+    /** Limits how far ahead of the play position each source will buffer.
+
+        By default a source fills its whole buffer. Setting a shorter time here
+        caps the read-ahead of every attached source at this many seconds of
+        audio, which reduces wasted reads when streams seek frequently.
+
+        Passing zero or less restores the default behaviour.
+    */
+    void setReadAheadTime (double seconds) noexcept;
+
+    /** Returns the read-ahead time limit, or 0 if the sources just fill their
+        buffers.
+
+        @see setReadAheadTime
+    */
+    double getReadAheadTime() const noexcept;
+
+    /** Returns a running estimate of the rate at which the sources are being
+        filled, in samples per second, or 0 if nothing has been measured yet.
+
+        The chunk size used for read-ahead is derived from this, so that each
+        read covers a roughly constant amount of time rather than a fixed
+        number of samples.
+    */
+    double getMeasuredThroughput() const noexcept;
+
+    /** Returns the number of sources currently attached to this scheduler. */
+    int getNumSources() const;
+
+    //==============================================================================
+    /** Synchronously performs one read for the most urgent source that needs
+        servicing, returning true if any data was read.
+
+        The background thread just calls this in a loop, but it can also be
+        called directly to drive the read-ahead from somewhere else - when
+        rendering offline, for example.
+    */
+    bool performNextRead();
+
+    //==============================================================================
+   #ifndef DOXYGEN
+    void run() override;
+   #endif
+
+private:
+    //==============================================================================
+    friend class BufferingAudioSource;
+
+    void addSource (BufferingAudioSource&);
+    void removeSource (BufferingAudioSource&);
+
+    void applyReadParameters (BufferingAudioSource&) const;
+    void updateThroughput (int64 numSamplesRead, double elapsedSeconds);
+
+    //==============================================================================
+    CriticalSection callbackLock, listLock;
+    Array<BufferingAudioSource*> sources;
+    std::atomic<double> readAheadSeconds { 0 }, measuredThroughput { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BufferingAudioSourceScheduler)
+};
+
+} // namespace juce
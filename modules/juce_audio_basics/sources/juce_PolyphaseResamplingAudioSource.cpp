@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+PolyphaseResamplingAudioSource::PolyphaseResamplingAudioSource (AudioSource* const inputSource,
+                                                                const bool deleteInputWhenDeleted,
+                                                                const int channels,
+                                                                const PolyphaseResampler::Quality qualityToUse)
+    : input (inputSource, deleteInputWhenDeleted),
+      quality (qualityToUse),
+      numChannels (channels)
+{
+    jassert (input != nullptr);
+
+    for (int i = 0; i < numChannels; ++i)
+        resamplers.add (new PolyphaseResampler());
+}
+
+PolyphaseResamplingAudioSource::~PolyphaseResamplingAudioSource() {}
+
+void PolyphaseResamplingAudioSource::setResamplingRatio (const double samplesInPerOutputSample)
+{
+    jassert (samplesInPerOutputSample > 0);
+
+    const SpinLock::ScopedLockType sl (ratioLock);
+    ratio = jmax (0.0, samplesInPerOutputSample);
+}
+
+void PolyphaseResamplingAudioSource::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
+{
+    const SpinLock::ScopedLockType sl (ratioLock);
+
+    auto scaledBlockSize = roundToInt (samplesPerBlockExpected * ratio);
+    input->prepareToPlay (scaledBlockSize, sampleRate * ratio);
+
+    scratch.setSize (numChannels, jmax (scaledBlockSize, samplesPerBlockExpected) + 32);
+
+    for (auto* r : resamplers)
+        r->prepare (ratio, quality);
+
+    lastRatio = ratio;
+
+    flushBuffers();
+}
+
+void PolyphaseResamplingAudioSource::flushBuffers()
+{
+    const ScopedLock sl (callbackLock);
+
+    for (auto* r : resamplers)
+        r->reset();
+}
+
+void PolyphaseResamplingAudioSource::releaseResources()
+{
+    input->releaseResources();
+    scratch.setSize (numChannels, 0);
+}
+
+void PolyphaseResamplingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& info)
+{
+    const ScopedLock sl (callbackLock);
+
+    double localRatio;
+
+    {
+        const SpinLock::ScopedLockType ratioSl (ratioLock);
+        localRatio = ratio;
+    }
+
+    if (lastRatio != localRatio)
+    {
+        for (auto* r : resamplers)
+            r->setResamplingRatio (localRatio);
+
+        lastRatio = localRatio;
+    }
+
+    // pull enough input to be able to produce the whole block; all channels
+    // share the same timing, so channel 0's bookkeeping speaks for them all
+    for (;;)
+    {
+        const int needed = resamplers.getUnchecked (0)->getNumInputSamplesNeeded (info.numSamples);
+
+        if (needed <= 0)
+            break;
+
+        if (scratch.getNumSamples() < needed)
+            scratch.setSize (numChannels, needed + 32, false, false);
+
+        AudioSourceChannelInfo readInfo (&scratch, 0, needed);
+        input->getNextAudioBlock (readInfo);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            resamplers.getUnchecked (channel)->pushSamples (scratch.getReadPointer (channel), needed);
+    }
+
+    const int channelsToProcess = jmin (numChannels, info.buffer->getNumChannels());
+
+    if (scratch.getNumSamples() < info.numSamples)
+        scratch.setSize (numChannels, info.numSamples + 32, false, false);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        // channels beyond the destination's count still have to be advanced
+        // to keep all the resamplers in step
+        auto* dest = channel < channelsToProcess ? info.buffer->getWritePointer (channel, info.startSample)
+                                                 : scratch.getWritePointer (channel);
+
+        auto numRead = resamplers.getUnchecked (channel)->readSamples (dest, info.numSamples);
+        jassertquiet (numRead == info.numSamples);
+    }
+}
+
+} // namespace juce
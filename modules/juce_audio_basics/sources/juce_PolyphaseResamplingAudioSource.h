@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A type of AudioSource that takes an input source and changes its sample rate,
+    using a PolyphaseResampler for each channel.
+
+    This has the same interface as ResamplingAudioSource, but processes whole
+    blocks through a pre-computed polyphase filter bank rather than interpolating
+    sample-by-sample, which makes it considerably cheaper when many sources are
+    being resampled at once.
+
+    @see PolyphaseResampler, ResamplingAudioSource
+
+    @tags{Audio}
+*/
+class JUCE_API  PolyphaseResamplingAudioSource  : public AudioSource
+{
+public:
+    //==============================================================================
+    /** Creates a PolyphaseResamplingAudioSource for a given input source.
+
+        @param inputSource              the input source to read from
+        @param deleteInputWhenDeleted   if true, the input source will be deleted when
+                                        this object is deleted
+        @param numChannels              the number of channels to process
+        @param quality                  the kernel length for the resamplers to use
+    */
+    PolyphaseResamplingAudioSource (AudioSource* inputSource,
+                                    bool deleteInputWhenDeleted,
+                                    int numChannels = 2,
+                                    PolyphaseResampler::Quality quality = PolyphaseResampler::Quality::medium);
+
+    /** Destructor. */
+    ~PolyphaseResamplingAudioSource() override;
+
+    /** Changes the resampling ratio.
+
+        (This value can be changed at any time, even while the source is running).
+
+        @param samplesInPerOutputSample     if set to 1.0, the input is passed through; higher
+                                            values will speed it up; lower values will slow it
+                                            down. The ratio must be greater than 0
+    */
+    void setResamplingRatio (double samplesInPerOutputSample);
+
+    /** Returns the current resampling ratio.
+
+        This is the value that was set by setResamplingRatio().
+    */
+    double getResamplingRatio() const noexcept                  { return ratio; }
+
+    /** Clears any buffered input that the resamplers are holding. */
+    void flushBuffers();
+
+    //==============================================================================
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock (const AudioSourceChannelInfo&) override;
+
+private:
+    //==============================================================================
+    OptionalScopedPointer<AudioSource> input;
+    double ratio = 1.0, lastRatio = 1.0;
+    const PolyphaseResampler::Quality quality;
+    AudioBuffer<float> scratch;
+    SpinLock ratioLock;
+    CriticalSection callbackLock;
+    const int numChannels;
+    OwnedArray<PolyphaseResampler> resamplers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PolyphaseResamplingAudioSource)
+};
+
+} // namespace juce
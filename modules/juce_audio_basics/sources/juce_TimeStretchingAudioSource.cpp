@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+TimeStretchingAudioSource::TimeStretchingAudioSource (PositionableAudioSource* inputSource,
+                                                      bool deleteInputWhenDeleted,
+                                                      int channels)
+    : input (inputSource, deleteInputWhenDeleted),
+      numChannels (channels)
+{
+    jassert (input != nullptr);
+    destBuffers.calloc (numChannels);
+}
+
+TimeStretchingAudioSource::~TimeStretchingAudioSource()
+{
+    releaseResources();
+}
+
+void TimeStretchingAudioSource::setStretchRatio (double newRatio)
+{
+    const ScopedLock sl (callbackLock);
+    ratio = jlimit (0.25, 4.0, newRatio);
+    stretcher.setStretchRatio (ratio);
+}
+
+//==============================================================================
+void TimeStretchingAudioSource::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
+{
+    const ScopedLock sl (callbackLock);
+
+    blockSize = jmax (64, samplesPerBlockExpected);
+    sourceBuffer.setSize (numChannels, blockSize);
+
+    stretcher.prepare (sampleRate, numChannels);
+    stretcher.setStretchRatio (ratio);
+
+    input->prepareToPlay (samplesPerBlockExpected, sampleRate);
+}
+
+void TimeStretchingAudioSource::releaseResources()
+{
+    const ScopedLock sl (callbackLock);
+    input->releaseResources();
+}
+
+void TimeStretchingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& info)
+{
+    const ScopedLock sl (callbackLock);
+
+    if (stretcher.getLookaheadInSamples() == 0)
+    {
+        // this indicates that prepareToPlay() hasn't been called!
+        jassertfalse;
+        info.clearActiveBufferRegion();
+        return;
+    }
+
+    while (stretcher.getNumSamplesReady() < info.numSamples)
+    {
+        AudioSourceChannelInfo sourceInfo (&sourceBuffer, 0, blockSize);
+        input->getNextAudioBlock (sourceInfo);
+        stretcher.pushSamples (sourceBuffer);
+    }
+
+    auto numDestChannels = jmin (numChannels, info.buffer->getNumChannels());
+
+    for (int ch = 0; ch < numDestChannels; ++ch)
+        destBuffers[ch] = info.buffer->getWritePointer (ch, info.startSample);
+
+    // If the stretcher has more channels than the destination, the extra
+    // ones are popped into the last destination channel and overwritten.
+    for (int ch = numDestChannels; ch < numChannels; ++ch)
+        destBuffers[ch] = destBuffers[jmax (0, numDestChannels - 1)];
+
+    stretcher.popSamples (destBuffers, info.numSamples);
+
+    for (int ch = numChannels; ch < info.buffer->getNumChannels(); ++ch)
+        info.buffer->clear (ch, info.startSample, info.numSamples);
+
+    outputPosition += info.numSamples;
+}
+
+//==============================================================================
+void TimeStretchingAudioSource::setNextReadPosition (int64 newPosition)
+{
+    const ScopedLock sl (callbackLock);
+
+    outputPosition = newPosition;
+    input->setNextReadPosition ((int64) std::llround ((double) newPosition / ratio));
+    stretcher.reset();
+}
+
+int64 TimeStretchingAudioSource::getNextReadPosition() const
+{
+    return outputPosition;
+}
+
+int64 TimeStretchingAudioSource::getTotalLength() const
+{
+    return (int64) std::llround ((double) input->getTotalLength() * ratio);
+}
+
+bool TimeStretchingAudioSource::isLooping() const
+{
+    return input->isLooping();
+}
+
+} // namespace juce
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A type of PositionableAudioSource that plays its input stretched in time,
+    without changing its pitch.
+
+    The read position, total length and all block sizes are expressed in
+    output (stretched) samples, so a ratio of 2.0 makes the source report
+    twice its input's length and play at half speed.
+
+    To change pitch as well as tempo, chain this through a
+    ResamplingAudioSource.
+
+    @see AudioTimeStretcher, ResamplingAudioSource
+
+    @tags{Audio}
+*/
+class JUCE_API  TimeStretchingAudioSource  : public PositionableAudioSource
+{
+public:
+    //==============================================================================
+    /** Creates a TimeStretchingAudioSource for a given input source.
+
+        @param inputSource              the input source to read from
+        @param deleteInputWhenDeleted   if true, the input source will be deleted when
+                                        this object is deleted
+        @param numChannels              the number of channels to process
+    */
+    TimeStretchingAudioSource (PositionableAudioSource* inputSource,
+                               bool deleteInputWhenDeleted,
+                               int numChannels = 2);
+
+    /** Destructor. */
+    ~TimeStretchingAudioSource() override;
+
+    //==============================================================================
+    /** Changes the stretch ratio.
+
+        A ratio of 2.0 doubles the playback time, 0.5 halves it. This can be
+        changed at any time, even while the source is running.
+    */
+    void setStretchRatio (double newRatio);
+
+    /** Returns the current stretch ratio. */
+    double getStretchRatio() const noexcept             { return ratio; }
+
+    //==============================================================================
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock (const AudioSourceChannelInfo&) override;
+
+    //==============================================================================
+    void setNextReadPosition (int64 newPosition) override;
+    int64 getNextReadPosition() const override;
+    int64 getTotalLength() const override;
+    bool isLooping() const override;
+
+private:
+    //==============================================================================
+    OptionalScopedPointer<PositionableAudioSource> input;
+    AudioTimeStretcher stretcher;
+    AudioBuffer<float> sourceBuffer;
+    CriticalSection callbackLock;
+    double ratio = 1.0;
+    int64 outputPosition = 0;
+    int blockSize = 512;
+    const int numChannels;
+    HeapBlock<float*> destBuffers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TimeStretchingAudioSource)
+};
+
+} // namespace juce
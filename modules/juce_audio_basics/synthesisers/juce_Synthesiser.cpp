@@ -169,6 +169,8 @@ void Synthesiser::processNextBlock (AudioBuffer<floatType>& outputAudio,
 
     const ScopedLock sl (lock);
 
+    processPendingNoteEvents();
+
     for (; numSamples > 0; ++midiIterator)
     {
         if (midiIterator == midiData.cend())
@@ -366,6 +368,47 @@ void Synthesiser::noteOff (const int midiChannel,
     }
 }
 
+bool Synthesiser::postNoteOn (int midiChannel, int midiNoteNumber, float velocity) noexcept
+{
+    return postNoteEvent ({ midiChannel, midiNoteNumber, velocity, true, false });
+}
+
+bool Synthesiser::postNoteOff (int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff) noexcept
+{
+    return postNoteEvent ({ midiChannel, midiNoteNumber, velocity, false, allowTailOff });
+}
+
+bool Synthesiser::postNoteEvent (const PendingNoteEvent& event) noexcept
+{
+    int start1, size1, start2, size2;
+    pendingEventFifo.prepareToWrite (1, start1, size1, start2, size2);
+
+    if (size1 + size2 < 1)
+        return false;
+
+    pendingEventQueue[start1] = event;
+    pendingEventFifo.finishedWrite (1);
+    return true;
+}
+
+void Synthesiser::processPendingNoteEvents()
+{
+    int start1, size1, start2, size2;
+    pendingEventFifo.prepareToRead (pendingEventFifo.getNumReady(), start1, size1, start2, size2);
+
+    for (int i = 0; i < size1 + size2; ++i)
+    {
+        auto& event = pendingEventQueue[i < size1 ? start1 + i : start2 + (i - size1)];
+
+        if (event.isNoteOn)
+            noteOn (event.midiChannel, event.midiNoteNumber, event.velocity);
+        else
+            noteOff (event.midiChannel, event.midiNoteNumber, event.velocity, event.allowTailOff);
+    }
+
+    pendingEventFifo.finishedRead (size1 + size2);
+}
+
 void Synthesiser::allNotesOff (const int midiChannel, const bool allowTailOff)
 {
     const ScopedLock sl (lock);
@@ -408,6 +408,35 @@ public:
                           float velocity,
                           bool allowTailOff);
 
+    /** Posts a note-on event to be triggered at the start of the next rendered block.
+
+        Unlike noteOn(), this never takes the synthesiser's lock, so a MIDI or GUI
+        thread can trigger notes without ever making the audio thread block on a
+        contended CriticalSection mid-render. The event goes onto a fixed-size
+        lock-free queue which renderNextBlock() drains just before rendering.
+
+        Note that the queue has a single-writer constraint: all calls to postNoteOn()
+        and postNoteOff() must be made from the same thread.
+
+        @returns true if the event was queued, or false if the queue was full and
+        the event was discarded.
+
+        @see postNoteOff, noteOn
+    */
+    bool postNoteOn (int midiChannel, int midiNoteNumber, float velocity) noexcept;
+
+    /** Posts a note-off event to be triggered at the start of the next rendered block.
+
+        This is the lock-free counterpart of noteOff() - see postNoteOn() for details
+        of the queueing behaviour and its threading constraints.
+
+        @returns true if the event was queued, or false if the queue was full and
+        the event was discarded.
+
+        @see postNoteOn, noteOff
+    */
+    bool postNoteOff (int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff) noexcept;
+
     /** Turns off all notes.
 
         This will turn off any voices that are playing a sound on the given midi channel.
@@ -628,6 +657,21 @@ private:
     bool shouldStealNotes = true;
     BigInteger sustainPedalsDown;
 
+    //==============================================================================
+    struct PendingNoteEvent
+    {
+        int midiChannel, midiNoteNumber;
+        float velocity;
+        bool isNoteOn, allowTailOff;
+    };
+
+    static constexpr int pendingEventQueueSize = 1024;
+    AbstractFifo pendingEventFifo { pendingEventQueueSize };
+    HeapBlock<PendingNoteEvent> pendingEventQueue { pendingEventQueueSize };
+
+    bool postNoteEvent (const PendingNoteEvent&) noexcept;
+    void processPendingNoteEvents();
+
     template <typename floatType>
     void processNextBlock (AudioBuffer<floatType>&, const MidiBuffer&, int startSample, int numSamples);
 
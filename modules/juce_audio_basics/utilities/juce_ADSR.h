@@ -194,6 +194,11 @@ public:
     /** This method will conveniently apply the next numSamples number of envelope values
         to an AudioBuffer.
 
+        Rather than calling getNextSample() once per sample, this processes the envelope
+        one segment at a time: each stretch of samples up to the next stage transition is
+        applied as a single gain ramp, so the branchy state logic only runs when the
+        envelope actually changes stage.
+
         @see getNextSample
     */
     template <typename FloatType>
@@ -201,28 +206,50 @@ public:
     {
         jassert (startSample + numSamples <= buffer.getNumSamples());
 
-        if (state == State::idle)
+        while (numSamples > 0)
         {
-            buffer.clear (startSample, numSamples);
-            return;
-        }
+            if (state == State::idle)
+            {
+                buffer.clear (startSample, numSamples);
+                return;
+            }
 
-        if (state == State::sustain)
-        {
-            buffer.applyGain (startSample, numSamples, parameters.sustain);
-            return;
-        }
+            if (state == State::sustain)
+            {
+                envelopeVal = parameters.sustain;
+                buffer.applyGain (startSample, numSamples, envelopeVal);
+                return;
+            }
 
-        auto numChannels = buffer.getNumChannels();
+            const auto target = getCurrentTarget();
+            const auto increment = getCurrentIncrement();
+            const auto stepsToTarget = getStepsToTarget (target, increment);
 
-        while (--numSamples >= 0)
-        {
-            auto env = getNextSample();
+            if (stepsToTarget > numSamples)
+            {
+                // the whole block lies inside the current segment, so it can be
+                // applied as a single ramp:
+                buffer.applyGainRamp (startSample, numSamples,
+                                      envelopeVal + increment,
+                                      envelopeVal + increment * (float) (numSamples + 1));
+                envelopeVal += increment * (float) numSamples;
+                return;
+            }
+
+            // ramp up to the sample on which the envelope reaches its target...
+            if (stepsToTarget > 1)
+                buffer.applyGainRamp (startSample, stepsToTarget - 1,
+                                      envelopeVal + increment,
+                                      envelopeVal + increment * (float) stepsToTarget);
 
-            for (int i = 0; i < numChannels; ++i)
-                buffer.getWritePointer (i)[startSample] *= env;
+            // ...which is applied with the exact target value:
+            buffer.applyGain (startSample + stepsToTarget - 1, 1, target);
 
-            ++startSample;
+            envelopeVal = target;
+            goToNextState();
+
+            startSample += stepsToTarget;
+            numSamples -= stepsToTarget;
         }
     }
 
@@ -257,6 +284,32 @@ private:
             reset();
     }
 
+    //==============================================================================
+    float getCurrentTarget() const noexcept
+    {
+        return state == State::attack ? 1.0f
+             : state == State::decay  ? parameters.sustain
+                                      : 0.0f;
+    }
+
+    float getCurrentIncrement() const noexcept
+    {
+        return state == State::attack ? attackRate
+             : state == State::decay  ? -decayRate
+                                      : -releaseRate;
+    }
+
+    /** Returns the number of samples after which the current segment will reach its
+        target value, so that the whole segment can be applied as one ramp.
+    */
+    int getStepsToTarget (float target, float increment) const noexcept
+    {
+        if (increment == 0.0f)
+            return 1;  // will clamp straight to the target
+
+        return jmax (1, (int) std::ceil ((target - envelopeVal) / increment));
+    }
+
     //==============================================================================
     enum class State { idle, attack, decay, sustain, release };
 
@@ -0,0 +1,391 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace
+{
+    static void multiplyByRamp (float* data, int numSamples, float gain, float increment) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            data[i] *= gain;
+            gain += increment;
+        }
+    }
+}
+
+//==============================================================================
+ADSREnvelopeBank::ADSREnvelopeBank (int numberOfEnvelopes)
+{
+    setSize (numberOfEnvelopes);
+}
+
+void ADSREnvelopeBank::setSize (int numberOfEnvelopes)
+{
+    jassert (numberOfEnvelopes >= 0);
+
+    numEnvelopes = numberOfEnvelopes;
+
+    states.calloc (numEnvelopes);
+    levels.calloc (numEnvelopes);
+    releaseRates.calloc (numEnvelopes);
+
+    recalculateRates();
+    reset();
+}
+
+//==============================================================================
+void ADSREnvelopeBank::setSampleRate (double newSampleRate) noexcept
+{
+    jassert (newSampleRate > 0.0);
+    sampleRate = newSampleRate;
+}
+
+void ADSREnvelopeBank::setParameters (const ADSR::Parameters& newParameters) noexcept
+{
+    // need to call setSampleRate() first!
+    jassert (sampleRate > 0.0);
+
+    parameters = newParameters;
+    recalculateRates();
+}
+
+//==============================================================================
+void ADSREnvelopeBank::reset() noexcept
+{
+    for (int i = 0; i < numEnvelopes; ++i)
+        reset (i);
+}
+
+void ADSREnvelopeBank::reset (int index) noexcept
+{
+    jassert (isPositiveAndBelow (index, numEnvelopes));
+
+    states[index] = State::idle;
+    levels[index] = 0.0f;
+}
+
+void ADSREnvelopeBank::noteOn (int index) noexcept
+{
+    jassert (isPositiveAndBelow (index, numEnvelopes));
+
+    if (attackRate > 0.0f)
+    {
+        states[index] = State::attack;
+    }
+    else if (decayRate > 0.0f)
+    {
+        levels[index] = 1.0f;
+        states[index] = State::decay;
+    }
+    else
+    {
+        levels[index] = parameters.sustain;
+        states[index] = State::sustain;
+    }
+}
+
+void ADSREnvelopeBank::noteOff (int index) noexcept
+{
+    jassert (isPositiveAndBelow (index, numEnvelopes));
+
+    if (states[index] != State::idle)
+    {
+        if (parameters.release > 0.0f)
+        {
+            releaseRates[index] = (float) (levels[index] / (parameters.release * sampleRate));
+            states[index] = State::release;
+        }
+        else
+        {
+            reset (index);
+        }
+    }
+}
+
+bool ADSREnvelopeBank::isActive (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, numEnvelopes));
+    return states[index] != State::idle;
+}
+
+float ADSREnvelopeBank::getEnvelopeValue (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, numEnvelopes));
+    return levels[index];
+}
+
+//==============================================================================
+void ADSREnvelopeBank::applyEnvelopeToBuffer (int index, AudioBuffer<float>& buffer,
+                                              int startSample, int numSamples) noexcept
+{
+    jassert (startSample + numSamples <= buffer.getNumSamples());
+
+    processEnvelope (index, buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                     startSample, numSamples);
+}
+
+void ADSREnvelopeBank::applyEnvelopesToChannels (AudioBuffer<float>& buffer,
+                                                 int startSample, int numSamples) noexcept
+{
+    jassert (startSample + numSamples <= buffer.getNumSamples());
+    jassert (buffer.getNumChannels() <= numEnvelopes);
+
+    auto channels = buffer.getArrayOfWritePointers();
+
+    for (int i = 0; i < buffer.getNumChannels(); ++i)
+        processEnvelope (i, channels + i, 1, startSample, numSamples);
+}
+
+//==============================================================================
+void ADSREnvelopeBank::processEnvelope (int index, float* const* channels, int numChannels,
+                                        int startSample, int numSamples) noexcept
+{
+    jassert (isPositiveAndBelow (index, numEnvelopes));
+
+    auto& level = levels[index];
+
+    while (numSamples > 0)
+    {
+        const auto state = states[index];
+
+        if (state == State::idle)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                FloatVectorOperations::clear (channels[ch] + startSample, numSamples);
+
+            return;
+        }
+
+        if (state == State::sustain)
+        {
+            level = parameters.sustain;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                FloatVectorOperations::multiply (channels[ch] + startSample, level, numSamples);
+
+            return;
+        }
+
+        const auto target    = state == State::attack ? 1.0f
+                             : state == State::decay  ? parameters.sustain : 0.0f;
+        const auto increment = state == State::attack ? attackRate
+                             : state == State::decay  ? -decayRate : -releaseRates[index];
+
+        const auto stepsToTarget = increment != 0.0f
+                                     ? jmax (1, (int) std::ceil ((target - level) / increment))
+                                     : 1;
+
+        if (stepsToTarget > numSamples)
+        {
+            // the whole block lies inside the current segment, so it can be
+            // applied as a single ramp:
+            for (int ch = 0; ch < numChannels; ++ch)
+                multiplyByRamp (channels[ch] + startSample, numSamples, level + increment, increment);
+
+            level += increment * (float) numSamples;
+            return;
+        }
+
+        // ramp up to the sample on which the envelope reaches its target, which
+        // is applied with the exact target value:
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            multiplyByRamp (channels[ch] + startSample, stepsToTarget - 1, level + increment, increment);
+            channels[ch][startSample + stepsToTarget - 1] *= target;
+        }
+
+        level = target;
+        goToNextState (index);
+
+        startSample += stepsToTarget;
+        numSamples -= stepsToTarget;
+    }
+}
+
+//==============================================================================
+void ADSREnvelopeBank::recalculateRates() noexcept
+{
+    auto getRate = [] (float distance, float timeInSeconds, double sr)
+    {
+        return timeInSeconds > 0.0f ? (float) (distance / (timeInSeconds * sr)) : -1.0f;
+    };
+
+    attackRate      = getRate (1.0f, parameters.attack, sampleRate);
+    decayRate       = getRate (1.0f - parameters.sustain, parameters.decay, sampleRate);
+    baseReleaseRate = getRate (parameters.sustain, parameters.release, sampleRate);
+
+    for (int i = 0; i < numEnvelopes; ++i)
+    {
+        releaseRates[i] = baseReleaseRate;
+
+        if ((states[i] == State::attack && attackRate <= 0.0f)
+            || (states[i] == State::decay && (decayRate <= 0.0f || levels[i] <= parameters.sustain))
+            || (states[i] == State::release && releaseRates[i] <= 0.0f))
+        {
+            goToNextState (i);
+        }
+    }
+}
+
+void ADSREnvelopeBank::goToNextState (int index) noexcept
+{
+    if (states[index] == State::attack)
+        states[index] = (decayRate > 0.0f ? State::decay : State::sustain);
+    else if (states[index] == State::decay)
+        states[index] = State::sustain;
+    else if (states[index] == State::release)
+        reset (index);
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct ADSREnvelopeBankTests  : public UnitTest
+{
+    ADSREnvelopeBankTests()  : UnitTest ("ADSREnvelopeBank", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        constexpr double sampleRate = 44100.0;
+        const ADSR::Parameters parameters { 0.05f, 0.05f, 0.6f, 0.07f };
+
+        beginTest ("Envelopes match a reference ADSR");
+        {
+            ADSR reference;
+            reference.setSampleRate (sampleRate);
+            reference.setParameters (parameters);
+            reference.noteOn();
+
+            ADSREnvelopeBank bank (3);
+            bank.setSampleRate (sampleRate);
+            bank.setParameters (parameters);
+            bank.noteOn (1);
+
+            auto random = getRandom();
+            auto noteOffSent = false;
+            auto numSamplesProcessed = 0;
+
+            while (reference.isActive() || bank.isActive (1))
+            {
+                if (! noteOffSent && numSamplesProcessed >= roundToInt (0.15 * sampleRate))
+                {
+                    reference.noteOff();
+                    bank.noteOff (1);
+                    noteOffSent = true;
+                }
+
+                const auto blockSize = random.nextInt ({ 1, 257 });
+
+                auto referenceBuffer = getTestBuffer (2, blockSize);
+                auto bankBuffer = getTestBuffer (2, blockSize);
+
+                reference.applyEnvelopeToBuffer (referenceBuffer, 0, blockSize);
+                bank.applyEnvelopeToBuffer (1, bankBuffer, 0, blockSize);
+
+                for (int channel = 0; channel < referenceBuffer.getNumChannels(); ++channel)
+                    for (int sample = 0; sample < blockSize; ++sample)
+                        expectWithinAbsoluteError (bankBuffer.getSample (channel, sample),
+                                                   referenceBuffer.getSample (channel, sample),
+                                                   1.0e-4f);
+
+                numSamplesProcessed += blockSize;
+
+                // both envelopes must finish eventually:
+                expect (numSamplesProcessed < roundToInt (10.0 * sampleRate));
+            }
+
+            expect (! bank.isActive (1));
+            expectEquals (bank.getEnvelopeValue (1), 0.0f);
+        }
+
+        beginTest ("Idle envelopes clear the buffer");
+        {
+            ADSREnvelopeBank bank (2);
+            bank.setSampleRate (sampleRate);
+            bank.setParameters (parameters);
+
+            auto buffer = getTestBuffer (1, 64);
+            bank.applyEnvelopeToBuffer (0, buffer, 0, buffer.getNumSamples());
+
+            expectEquals (buffer.getMagnitude (0, buffer.getNumSamples()), 0.0f);
+        }
+
+        beginTest ("Envelopes at different stages are applied per channel");
+        {
+            ADSREnvelopeBank bank (3);
+            bank.setSampleRate (sampleRate);
+            bank.setParameters (parameters);
+
+            // envelope 0 stays idle, envelope 1 sustains, envelope 2 attacks:
+            bank.noteOn (1);
+            bank.noteOn (2);
+
+            {
+                auto sustainBuffer = getTestBuffer (1, roundToInt ((parameters.attack + parameters.decay) * sampleRate) + 64);
+                bank.applyEnvelopeToBuffer (1, sustainBuffer, 0, sustainBuffer.getNumSamples());
+            }
+
+            auto buffer = getTestBuffer (3, 64);
+            bank.applyEnvelopesToChannels (buffer, 0, buffer.getNumSamples());
+
+            expectEquals (buffer.getMagnitude (0, 0, buffer.getNumSamples()), 0.0f);
+            expect (buffer.findMinMax (1, 0, buffer.getNumSamples()) == Range<float> { parameters.sustain, parameters.sustain });
+            expect (buffer.getSample (2, 1) > buffer.getSample (2, 0));
+            expectWithinAbsoluteError (bank.getEnvelopeValue (2),
+                                       buffer.getSample (2, buffer.getNumSamples() - 1), 1.0e-6f);
+        }
+
+        beginTest ("Zero-length release resets to idle");
+        {
+            ADSREnvelopeBank bank (1);
+            bank.setSampleRate (sampleRate);
+            bank.setParameters ({ parameters.attack, parameters.decay, parameters.sustain, 0.0f });
+
+            bank.noteOn (0);
+            bank.noteOff (0);
+
+            expect (! bank.isActive (0));
+        }
+    }
+
+    static AudioBuffer<float> getTestBuffer (int numChannels, int numSamples)
+    {
+        AudioBuffer<float> buffer { numChannels, numSamples };
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+                buffer.setSample (channel, sample, 1.0f);
+
+        return buffer;
+    }
+};
+
+static ADSREnvelopeBankTests adsrEnvelopeBankTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A bank of ADSR envelopes sharing one set of parameters, with the per-voice
+    state stored in structure-of-arrays form.
+
+    A polyphonic synthesiser with hundreds of voices and several envelopes per
+    voice spends a surprising amount of time inside ADSR::getNextSample(),
+    which branches on the envelope state once per sample. This class keeps the
+    stage, level and release rate of a whole set of envelopes in contiguous
+    arrays and processes each envelope one segment at a time, applying each
+    stretch of samples up to the next stage transition as a single gain ramp.
+    That makes the envelope cost proportional to the number of stage
+    transitions in a block rather than the number of samples.
+
+    All the envelopes in a bank follow the same ADSR::Parameters; each voice
+    has its own note state, so the envelopes can be at different stages.
+
+    @see ADSR, SmoothedValueBank
+
+    @tags{Audio}
+*/
+class JUCE_API  ADSREnvelopeBank
+{
+public:
+    //==============================================================================
+    /** Creates an empty bank - call setSize() before using it. */
+    ADSREnvelopeBank() = default;
+
+    /** Creates a bank holding the given number of envelopes, all idle. */
+    explicit ADSREnvelopeBank (int numberOfEnvelopes);
+
+    //==============================================================================
+    /** Sets the number of envelopes held in the bank.
+
+        This resets all the envelopes to idle, and it allocates, so call it
+        before processing starts - never from the audio thread.
+    */
+    void setSize (int numberOfEnvelopes);
+
+    /** Returns the number of envelopes held in the bank. */
+    int getNumEnvelopes() const noexcept                    { return numEnvelopes; }
+
+    //==============================================================================
+    /** Sets the sample rate used by all the envelopes.
+        This must be called before the process or setParameters() methods.
+    */
+    void setSampleRate (double newSampleRate) noexcept;
+
+    /** Sets the parameters shared by all the envelopes in the bank.
+
+        You must have called setSampleRate() with the correct sample rate before
+        this otherwise the values may be incorrect!
+
+        @see getParameters
+    */
+    void setParameters (const ADSR::Parameters& newParameters) noexcept;
+
+    /** Returns the parameters currently shared by the envelopes.
+        @see setParameters
+    */
+    const ADSR::Parameters& getParameters() const noexcept  { return parameters; }
+
+    //==============================================================================
+    /** Resets all the envelopes to an idle state. */
+    void reset() noexcept;
+
+    /** Resets the envelope at the given index to an idle state. */
+    void reset (int index) noexcept;
+
+    /** Starts the attack phase of the envelope at the given index. */
+    void noteOn (int index) noexcept;
+
+    /** Starts the release phase of the envelope at the given index. */
+    void noteOff (int index) noexcept;
+
+    /** Returns true if the envelope at the given index is in its attack, decay,
+        sustain or release stage.
+    */
+    bool isActive (int index) const noexcept;
+
+    /** Returns the current level of the envelope at the given index. */
+    float getEnvelopeValue (int index) const noexcept;
+
+    //==============================================================================
+    /** Applies the next numSamples values of the envelope at the given index to
+        all the channels of an AudioBuffer, advancing the envelope.
+
+        @see ADSR::applyEnvelopeToBuffer
+    */
+    void applyEnvelopeToBuffer (int index, AudioBuffer<float>& buffer,
+                                int startSample, int numSamples) noexcept;
+
+    /** Applies one envelope per channel: channel i of the buffer is multiplied
+        by the next numSamples values of envelope i, and all the envelopes are
+        advanced together.
+
+        The buffer must not have more channels than the bank has envelopes.
+    */
+    void applyEnvelopesToChannels (AudioBuffer<float>& buffer,
+                                   int startSample, int numSamples) noexcept;
+
+private:
+    //==============================================================================
+    enum class State : uint8  { idle, attack, decay, sustain, release };
+
+    void processEnvelope (int index, float* const* channels, int numChannels,
+                          int startSample, int numSamples) noexcept;
+
+    void recalculateRates() noexcept;
+    void goToNextState (int index) noexcept;
+
+    //==============================================================================
+    ADSR::Parameters parameters;
+    double sampleRate = 44100.0;
+    float attackRate = 0.0f, decayRate = 0.0f, baseReleaseRate = 0.0f;
+
+    int numEnvelopes = 0;
+    HeapBlock<State> states;
+    HeapBlock<float> levels, releaseRates;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ADSREnvelopeBank)
+};
+
+} // namespace juce
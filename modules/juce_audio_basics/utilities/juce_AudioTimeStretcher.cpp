@@ -0,0 +1,272 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+AudioTimeStretcher::AudioTimeStretcher() = default;
+AudioTimeStretcher::~AudioTimeStretcher() = default;
+
+void AudioTimeStretcher::prepare (double sampleRate, int newNumChannels)
+{
+    jassert (sampleRate > 0 && newNumChannels > 0);
+
+    numChannels = newNumChannels;
+
+    // A 60ms window with a 30ms hop keeps transients reasonably sharp while
+    // giving the similarity search enough signal to lock on to; the search
+    // covers +/- 10ms around the nominal read position.
+    overlapSize  = 2 * jmax (32, roundToInt (sampleRate * 0.015));
+    windowSize   = overlapSize * 2;
+    searchRadius = jmax (16, roundToInt (sampleRate * 0.01));
+
+    inputFifo.setSize (numChannels, windowSize * 2 + searchRadius * 2);
+    outputFifo.setSize (numChannels, windowSize * 4);
+    previousTail.setSize (numChannels, overlapSize);
+
+    fadeIn.malloc (overlapSize);
+    fadeOut.malloc (overlapSize);
+
+    for (int i = 0; i < overlapSize; ++i)
+    {
+        fadeIn[i] = 0.5f - 0.5f * std::cos (MathConstants<float>::pi * (float) (i + 1) / (float) (overlapSize + 1));
+        fadeOut[i] = 1.0f - fadeIn[i];
+    }
+
+    reset();
+}
+
+void AudioTimeStretcher::reset() noexcept
+{
+    previousTail.clear();
+    nominalReadPos = 0;
+    inputStreamBase = 0;
+    inputCount = 0;
+    outputReadPos = 0;
+    outputCount = 0;
+    primed = false;
+}
+
+void AudioTimeStretcher::setStretchRatio (double newRatio) noexcept
+{
+    stretchRatio = jlimit (0.25, 4.0, newRatio);
+}
+
+//==============================================================================
+void AudioTimeStretcher::pushSamples (const float* const* input, int numSamples)
+{
+    jassert (numChannels > 0); // must call prepare() first!
+
+    if (numSamples <= 0)
+        return;
+
+    if (inputCount + numSamples > inputFifo.getNumSamples())
+        inputFifo.setSize (numChannels, jmax (inputCount + numSamples, inputFifo.getNumSamples() * 2), true);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        inputFifo.copyFrom (ch, inputCount, input[ch], numSamples);
+
+    inputCount += numSamples;
+
+    while (canGenerateFrame())
+        generateNextFrame();
+}
+
+void AudioTimeStretcher::pushSamples (const AudioBuffer<float>& input)
+{
+    jassert (input.getNumChannels() >= numChannels);
+    pushSamples (input.getArrayOfReadPointers(), input.getNumSamples());
+}
+
+int AudioTimeStretcher::getNumSamplesReady() const noexcept
+{
+    return outputCount;
+}
+
+int AudioTimeStretcher::popSamples (float* const* output, int maxNumSamples)
+{
+    auto numToDo = jmin (maxNumSamples, outputCount);
+
+    if (numToDo > 0)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            FloatVectorOperations::copy (output[ch], outputFifo.getReadPointer (ch, outputReadPos), numToDo);
+
+        outputReadPos += numToDo;
+        outputCount -= numToDo;
+
+        if (outputCount == 0)
+            outputReadPos = 0;
+    }
+
+    return numToDo;
+}
+
+int AudioTimeStretcher::popSamples (AudioBuffer<float>& output)
+{
+    jassert (output.getNumChannels() >= numChannels);
+    return popSamples (output.getArrayOfWritePointers(), output.getNumSamples());
+}
+
+//==============================================================================
+bool AudioTimeStretcher::canGenerateFrame() const noexcept
+{
+    if (numChannels == 0)
+        return false;
+
+    if (! primed)
+        return inputCount >= windowSize;
+
+    auto highestStart = (int64) std::llround (nominalReadPos) + searchRadius;
+    return highestStart + windowSize <= inputStreamBase + inputCount;
+}
+
+void AudioTimeStretcher::generateNextFrame()
+{
+    // Make room in the output FIFO for one more frame
+    if (outputReadPos + outputCount + overlapSize > outputFifo.getNumSamples())
+    {
+        if (outputReadPos > 0)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                auto* data = outputFifo.getWritePointer (ch);
+                std::memmove (data, data + outputReadPos, (size_t) outputCount * sizeof (float));
+            }
+
+            outputReadPos = 0;
+        }
+
+        if (outputCount + overlapSize > outputFifo.getNumSamples())
+            outputFifo.setSize (numChannels, jmax (outputCount + overlapSize, outputFifo.getNumSamples() * 2), true);
+    }
+
+    auto writePos = outputReadPos + outputCount;
+
+    if (! primed)
+    {
+        // The very first frame is passed straight through, seeding the tail
+        // that all later frames will be matched against.
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            outputFifo.copyFrom (ch, writePos, inputFifo, ch, 0, overlapSize);
+            previousTail.copyFrom (ch, 0, inputFifo, ch, overlapSize, overlapSize);
+        }
+
+        primed = true;
+    }
+    else
+    {
+        auto anchor = (int) ((int64) std::llround (nominalReadPos) - inputStreamBase);
+        auto lowest  = jmax (0, anchor - searchRadius);
+        auto highest = jmin (anchor + searchRadius, inputCount - windowSize);
+        auto best = findBestOffset (lowest, jmax (lowest, highest), anchor);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* out = outputFifo.getWritePointer (ch, writePos);
+            auto* frame = inputFifo.getReadPointer (ch, best);
+
+            FloatVectorOperations::multiply (out, frame, fadeIn, overlapSize);
+            FloatVectorOperations::addWithMultiply (out, previousTail.getReadPointer (ch), fadeOut, overlapSize);
+
+            previousTail.copyFrom (ch, 0, inputFifo, ch, best + overlapSize, overlapSize);
+        }
+    }
+
+    outputCount += overlapSize;
+    nominalReadPos += overlapSize / stretchRatio;
+
+    discardUsedInput();
+}
+
+int AudioTimeStretcher::findBestOffset (int lowestStart, int highestStart, int anchor) const noexcept
+{
+    // Search a coarse grid first, then refine around the winner. The exact
+    // nominal position is always tried too, so an unstretched signal splices
+    // back together sample-exactly.
+    auto bestStart = lowestStart;
+    auto bestScore = getCorrelation (lowestStart);
+
+    auto check = [&] (int start)
+    {
+        auto score = getCorrelation (start);
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+            bestStart = start;
+        }
+    };
+
+    for (int start = lowestStart + 4; start <= highestStart; start += 4)
+        check (start);
+
+    for (int start = jmax (lowestStart, bestStart - 3), stop = jmin (highestStart, bestStart + 3); start <= stop; ++start)
+        check (start);
+
+    check (jlimit (lowestStart, highestStart, anchor));
+
+    return bestStart;
+}
+
+float AudioTimeStretcher::getCorrelation (int candidateStart) const noexcept
+{
+    float dot0 = 0.0f, dot1 = 0.0f, energy0 = 0.0f, energy1 = 0.0f;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto* tail = previousTail.getReadPointer (ch);
+        auto* candidate = inputFifo.getReadPointer (ch, candidateStart);
+
+        // Two accumulator pairs so the compiler can keep the loop vectorised
+        for (int i = 0; i < overlapSize - 1; i += 2)
+        {
+            dot0    += tail[i]     * candidate[i];
+            dot1    += tail[i + 1] * candidate[i + 1];
+            energy0 += candidate[i]     * candidate[i];
+            energy1 += candidate[i + 1] * candidate[i + 1];
+        }
+    }
+
+    return (dot0 + dot1) / std::sqrt (energy0 + energy1 + 1.0e-9f);
+}
+
+void AudioTimeStretcher::discardUsedInput()
+{
+    auto numToDiscard = (int) jmin ((int64) inputCount,
+                                    (int64) std::floor (nominalReadPos) - searchRadius - inputStreamBase);
+
+    if (numToDiscard > 0)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* data = inputFifo.getWritePointer (ch);
+            std::memmove (data, data + numToDiscard, (size_t) (inputCount - numToDiscard) * sizeof (float));
+        }
+
+        inputStreamBase += numToDiscard;
+        inputCount -= numToDiscard;
+    }
+}
+
+} // namespace juce
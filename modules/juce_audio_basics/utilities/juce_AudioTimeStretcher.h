@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Stretches audio in time without changing its pitch, using the WSOLA
+    (waveform-similarity overlap-add) technique.
+
+    Push blocks of input with pushSamples() and pull the stretched result out
+    with popSamples() - the two sides don't have to use the same block sizes.
+    The stretcher holds a bounded amount of lookahead, reported by
+    getLookaheadInSamples(), so output only becomes available once that much
+    input has been pushed.
+
+    The stretch ratio can be changed smoothly while running, which makes the
+    class suitable for tempo-matched playback. To alter pitch as well, chain
+    the output through a resampler: stretching by the resampling ratio and
+    then resampling turns the combination into a pitch-shifter.
+
+    @see TimeStretchingAudioSource, ResamplingAudioSource
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioTimeStretcher
+{
+public:
+    //==============================================================================
+    /** Creates an unprepared stretcher - call prepare() before use. */
+    AudioTimeStretcher();
+
+    /** Destructor. */
+    ~AudioTimeStretcher();
+
+    //==============================================================================
+    /** Sets up the stretcher for the given sample rate and channel count.
+
+        This allocates its working buffers, so don't call it from the audio
+        thread.
+    */
+    void prepare (double sampleRate, int numChannels);
+
+    /** Discards all buffered input and output. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Sets how much longer the output should be than the input.
+
+        A ratio of 2.0 makes the audio play at half speed, 0.5 at double
+        speed. The value is clamped to the range 0.25 to 4.0 and can be
+        changed at any time, taking effect from the next internal frame.
+    */
+    void setStretchRatio (double newRatio) noexcept;
+
+    /** Returns the current stretch ratio. */
+    double getStretchRatio() const noexcept             { return stretchRatio; }
+
+    /** Returns the number of input samples the stretcher needs to buffer
+        ahead of its read position, which is also roughly its latency in
+        input samples.
+    */
+    int getLookaheadInSamples() const noexcept          { return windowSize + searchRadius; }
+
+    //==============================================================================
+    /** Adds a block of input samples to the stretcher. */
+    void pushSamples (const float* const* input, int numSamples);
+
+    /** Adds a block of input samples to the stretcher. */
+    void pushSamples (const AudioBuffer<float>& input);
+
+    /** Returns the number of output samples that could currently be popped. */
+    int getNumSamplesReady() const noexcept;
+
+    /** Reads up to maxNumSamples of stretched output, returning the number
+        of samples actually written to the destination.
+    */
+    int popSamples (float* const* output, int maxNumSamples);
+
+    /** Reads stretched output into a buffer, returning the number of samples
+        actually written.
+    */
+    int popSamples (AudioBuffer<float>& output);
+
+private:
+    //==============================================================================
+    bool canGenerateFrame() const noexcept;
+    void generateNextFrame();
+    int findBestOffset (int lowestStart, int highestStart, int anchor) const noexcept;
+    float getCorrelation (int candidateStart) const noexcept;
+    void discardUsedInput();
+
+    //==============================================================================
+    AudioBuffer<float> inputFifo, outputFifo, previousTail;
+    HeapBlock<float> fadeIn, fadeOut;
+    double stretchRatio = 1.0;
+    double nominalReadPos = 0;     // absolute position in the input stream
+    int64 inputStreamBase = 0;     // absolute position of inputFifo sample 0
+    int numChannels = 0, windowSize = 0, overlapSize = 0, searchRadius = 0;
+    int inputCount = 0, outputReadPos = 0, outputCount = 0;
+    bool primed = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioTimeStretcher)
+};
+
+} // namespace juce
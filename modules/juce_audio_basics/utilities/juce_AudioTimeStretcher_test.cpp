@@ -0,0 +1,162 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct AudioTimeStretcherTests  : public UnitTest
+{
+    AudioTimeStretcherTests()  : UnitTest ("AudioTimeStretcher", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        const double sampleRate = 44100.0;
+
+        beginTest ("A ratio of 1.0 passes the signal through unchanged");
+        {
+            AudioTimeStretcher stretcher;
+            stretcher.prepare (sampleRate, 1);
+
+            auto input = createNoiseBuffer (1, 44100, 0x1234);
+            stretcher.pushSamples (input);
+
+            AudioBuffer<float> output (1, stretcher.getNumSamplesReady());
+            auto numPopped = stretcher.popSamples (output);
+            expect (numPopped > 30000);
+
+            for (int i = 0; i < numPopped; ++i)
+                expectWithinAbsoluteError (output.getSample (0, i), input.getSample (0, i), 1.0e-3f);
+        }
+
+        beginTest ("Output duration scales with the stretch ratio");
+        {
+            for (auto ratio : { 0.5, 1.5, 2.0 })
+            {
+                AudioTimeStretcher stretcher;
+                stretcher.prepare (sampleRate, 2);
+                stretcher.setStretchRatio (ratio);
+
+                const int numInputSamples = 44100 * 2;
+                auto input = createNoiseBuffer (2, numInputSamples, 0x5678);
+
+                stretcher.pushSamples (input);
+
+                auto expected = (double) (numInputSamples - stretcher.getLookaheadInSamples()) * ratio;
+                auto actual = (double) stretcher.getNumSamplesReady();
+
+                expect (std::abs (actual - expected) < expected * 0.05 + (double) stretcher.getLookaheadInSamples());
+            }
+        }
+
+        beginTest ("Stretching a sine wave preserves its frequency");
+        {
+            AudioTimeStretcher stretcher;
+            stretcher.prepare (sampleRate, 1);
+            stretcher.setStretchRatio (1.5);
+
+            const int numInputSamples = 44100 * 2;
+            AudioBuffer<float> input (1, numInputSamples);
+
+            for (int i = 0; i < numInputSamples; ++i)
+                input.setSample (0, i, 0.8f * std::sin (MathConstants<float>::twoPi * 440.0f * (float) i / (float) sampleRate));
+
+            stretcher.pushSamples (input);
+
+            AudioBuffer<float> output (1, stretcher.getNumSamplesReady());
+            auto numPopped = stretcher.popSamples (output);
+            expect (numPopped > numInputSamples);
+
+            // Count zero crossings over the middle of the output: the pitch
+            // should still be 440Hz even though playback is 1.5x longer
+            auto* data = output.getReadPointer (0);
+            int crossings = 0;
+            const int start = numPopped / 4, stop = 3 * numPopped / 4;
+
+            for (int i = start + 1; i < stop; ++i)
+                if ((data[i - 1] < 0.0f) != (data[i] < 0.0f))
+                    ++crossings;
+
+            auto measuredFreq = (double) crossings * sampleRate / (2.0 * (stop - start));
+            expect (std::abs (measuredFreq - 440.0) < 440.0 * 0.03);
+        }
+
+        beginTest ("reset() allows the stretcher to be reused from scratch");
+        {
+            AudioTimeStretcher stretcher;
+            stretcher.prepare (sampleRate, 1);
+            stretcher.setStretchRatio (2.0);
+
+            auto input = createNoiseBuffer (1, 22050, 0x9abc);
+            stretcher.pushSamples (input);
+            expect (stretcher.getNumSamplesReady() > 0);
+
+            stretcher.reset();
+            expectEquals (stretcher.getNumSamplesReady(), 0);
+
+            stretcher.pushSamples (input);
+            expect (stretcher.getNumSamplesReady() > 0);
+        }
+
+        beginTest ("TimeStretchingAudioSource reports scaled positions and lengths");
+        {
+            auto sourceBuffer = createNoiseBuffer (2, 44100, 0xdef0);
+
+            auto* memorySource = new MemoryAudioSource (sourceBuffer, true);
+            TimeStretchingAudioSource stretchSource (memorySource, true, 2);
+
+            stretchSource.setStretchRatio (2.0);
+            expectEquals (stretchSource.getTotalLength(), (int64) 88200);
+
+            stretchSource.prepareToPlay (512, sampleRate);
+
+            AudioBuffer<float> output (2, 512);
+            AudioSourceChannelInfo info (&output, 0, 512);
+
+            for (int block = 0; block < 8; ++block)
+                stretchSource.getNextAudioBlock (info);
+
+            expectEquals (stretchSource.getNextReadPosition(), (int64) (8 * 512));
+            expect (output.getMagnitude (0, 512) > 0.0f);
+
+            stretchSource.setNextReadPosition (0);
+            expectEquals (stretchSource.getNextReadPosition(), (int64) 0);
+
+            stretchSource.releaseResources();
+        }
+    }
+
+    static AudioBuffer<float> createNoiseBuffer (int numChannels, int numSamples, int64 seed)
+    {
+        AudioBuffer<float> buffer (numChannels, numSamples);
+        Random random (seed);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+        return buffer;
+    }
+};
+
+static AudioTimeStretcherTests audioTimeStretcherTests;
+
+} // namespace juce
@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+int AutomationCurve::addPoint (double time, float value, float curvature)
+{
+    auto index = times.size();
+
+    while (index > 0 && times.getUnchecked (index - 1) > time)
+        --index;
+
+    times.insert (index, time);
+    values.insert (index, value);
+    curvatures.insert (index, curvature);
+    return index;
+}
+
+void AutomationCurve::removePoint (int index)
+{
+    times.remove (index);
+    values.remove (index);
+    curvatures.remove (index);
+}
+
+void AutomationCurve::clear()
+{
+    times.clearQuick();
+    values.clearQuick();
+    curvatures.clearQuick();
+}
+
+//==============================================================================
+int AutomationCurve::findSegment (double time) const noexcept
+{
+    int low = 0, high = times.size();
+
+    while (low < high)
+    {
+        const auto mid = (low + high) / 2;
+
+        if (times.getUnchecked (mid) <= time)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return low - 1;
+}
+
+void AutomationCurve::updateCursor (double time, Cursor& cursor) const noexcept
+{
+    const auto numPoints = times.size();
+    auto segment = cursor.segment;
+
+    // A cursor that's out of range or ahead of the queried time (a backwards
+    // seek, or an edit that moved points) falls back to a fresh search.
+    if (segment >= numPoints || (segment >= 0 && times.getUnchecked (segment) > time))
+    {
+        cursor.segment = findSegment (time);
+        return;
+    }
+
+    while (segment + 1 < numPoints && times.getUnchecked (segment + 1) <= time)
+        ++segment;
+
+    cursor.segment = segment;
+}
+
+float AutomationCurve::getValueInSegment (int segment, double time) const noexcept
+{
+    const auto numPoints = times.size();
+
+    if (numPoints == 0)
+        return 0.0f;
+
+    if (segment < 0)
+        return values.getFirst();
+
+    if (segment >= numPoints - 1)
+        return values.getLast();
+
+    const auto t0 = times.getUnchecked (segment);
+    const auto t1 = times.getUnchecked (segment + 1);
+    const auto v0 = values.getUnchecked (segment);
+
+    if (t1 <= t0)
+        return v0;
+
+    const auto t = (float) ((time - t0) / (t1 - t0));
+    const auto c = jlimit (-1.0f, 1.0f, curvatures.getUnchecked (segment));
+
+    return v0 + (values.getUnchecked (segment + 1) - v0) * (t * (1.0f + c * (t - 1.0f)));
+}
+
+float AutomationCurve::getValueAt (double time) const noexcept
+{
+    return getValueInSegment (findSegment (time), time);
+}
+
+float AutomationCurve::getValueAt (double time, Cursor& cursor) const noexcept
+{
+    updateCursor (time, cursor);
+    return getValueInSegment (cursor.segment, time);
+}
+
+//==============================================================================
+void AutomationCurve::evaluate (double startTime, double timePerSample,
+                                float* destBuffer, int numSamples, Cursor& cursor) const noexcept
+{
+    if (numSamples <= 0)
+        return;
+
+    const auto numPoints = times.size();
+
+    if (numPoints == 0)
+    {
+        FloatVectorOperations::clear (destBuffer, numSamples);
+        return;
+    }
+
+    updateCursor (startTime, cursor);
+
+    auto time = startTime;
+
+    for (int i = 0; i < numSamples;)
+    {
+        const auto segment = cursor.segment;
+
+        if (segment >= numPoints - 1)
+        {
+            FloatVectorOperations::fill (destBuffer + i, values.getLast(), numSamples - i);
+            return;
+        }
+
+        // Work out how many samples stay within the current (or, before the
+        // first point, the flat leading) region, then render them in one run.
+        const auto regionEnd = times.getUnchecked (segment + 1);
+        auto numHere = numSamples - i;
+
+        if (timePerSample > 0)
+            numHere = jmax (1, jmin (numHere, (int) std::ceil ((regionEnd - time) / timePerSample)));
+
+        if (segment < 0)
+        {
+            FloatVectorOperations::fill (destBuffer + i, values.getFirst(), numHere);
+        }
+        else
+        {
+            const auto t0 = times.getUnchecked (segment);
+            const auto v0 = values.getUnchecked (segment);
+            const auto segmentLength = regionEnd - t0;
+
+            if (segmentLength <= 0)
+            {
+                FloatVectorOperations::fill (destBuffer + i, v0, numHere);
+            }
+            else
+            {
+                const auto dv = values.getUnchecked (segment + 1) - v0;
+                const auto c = jlimit (-1.0f, 1.0f, curvatures.getUnchecked (segment));
+                const auto dt = (float) (timePerSample / segmentLength);
+                auto t = (float) ((time - t0) / segmentLength);
+
+                for (int n = 0; n < numHere; ++n)
+                {
+                    destBuffer[i + n] = v0 + dv * (t * (1.0f + c * (t - 1.0f)));
+                    t += dt;
+                }
+            }
+        }
+
+        i += numHere;
+        time = startTime + (double) i * timePerSample;
+        updateCursor (time, cursor);
+    }
+}
+
+} // namespace juce
@@ -0,0 +1,182 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A sorted set of automation breakpoints with efficient block-based
+    evaluation.
+
+    The points are stored as parallel arrays of time, value and curvature
+    rather than as an array of structs, so scanning times during evaluation
+    touches a single contiguous array. Each point's curvature shapes the
+    segment leaving it: 0 is a linear ramp, +1 bends fully towards the later
+    value and -1 towards the earlier one.
+
+    Random-access lookups binary-search the points, but the intended use for
+    playback is a Cursor per playhead: a cursor remembers which segment it's
+    in, making sequential queries O(1) however many points the curve has, and
+    it recovers automatically (at binary-search cost) when the playhead jumps
+    or the curve is edited.
+
+    evaluate() renders a whole block of per-sample values into a buffer;
+    applyToBlock() instead reports just the block-start value and each
+    breakpoint inside the block at its exact sample offset, which suits
+    parameter interfaces that take timestamped value changes.
+
+    This class performs no locking: edit it and evaluate it from one thread at
+    a time, or arrange synchronisation externally.
+
+    @tags{Audio}
+*/
+class JUCE_API  AutomationCurve
+{
+public:
+    //==============================================================================
+    /** Creates an empty curve. */
+    AutomationCurve() = default;
+
+    //==============================================================================
+    /** Adds a breakpoint, keeping the points sorted by time, and returns the
+        index at which it was inserted.
+
+        Points with equal times are allowed (producing a step); a new point is
+        inserted after any existing points with the same time.
+
+        @param time       the time of the point, in whatever unit the caller
+                          evaluates the curve in (typically seconds or samples)
+        @param value      the value of the curve at that time
+        @param curvature  how to shape the segment leaving this point, from -1
+                          (bends towards the earlier value) through 0 (linear)
+                          to +1 (bends towards the later value)
+    */
+    int addPoint (double time, float value, float curvature = 0.0f);
+
+    /** Removes the point at the given index. */
+    void removePoint (int index);
+
+    /** Removes all points. */
+    void clear();
+
+    /** Returns the number of breakpoints in the curve. */
+    int getNumPoints() const noexcept                   { return times.size(); }
+
+    /** Returns the time of the point at the given index. */
+    double getPointTime (int index) const noexcept      { return times[index]; }
+
+    /** Returns the value of the point at the given index. */
+    float getPointValue (int index) const noexcept      { return values[index]; }
+
+    /** Returns the curvature of the point at the given index. */
+    float getPointCurvature (int index) const noexcept  { return curvatures[index]; }
+
+    //==============================================================================
+    /**
+        Remembers which segment of a curve a playhead is in, so sequential
+        queries don't have to search.
+
+        Use one cursor per playhead. A default-constructed cursor is valid for
+        any position; there's no need to reset it after seeking or editing the
+        curve, as the next query re-finds its segment.
+    */
+    struct Cursor
+    {
+        int segment = -1;
+    };
+
+    //==============================================================================
+    /** Returns the value of the curve at the given time, using a binary search.
+
+        Times before the first point return the first point's value, and times
+        after the last point return the last point's value. An empty curve
+        returns zero.
+    */
+    float getValueAt (double time) const noexcept;
+
+    /** Returns the value of the curve at the given time, advancing the given
+        cursor.
+
+        When the queried times move forwards in small steps - the playback
+        case - this is O(1) regardless of the number of points.
+    */
+    float getValueAt (double time, Cursor& cursor) const noexcept;
+
+    /** Renders per-sample curve values for a whole block into a buffer.
+
+        Each output sample n holds the curve's value at
+        (startTime + n * timePerSample). The work is done one segment at a
+        time, so the inner loop is a simple polynomial ramp.
+    */
+    void evaluate (double startTime, double timePerSample,
+                   float* destBuffer, int numSamples, Cursor& cursor) const noexcept;
+
+    /** Reports the curve's value changes within a block as sparse,
+        sample-accurate events instead of a full buffer.
+
+        The callback is invoked as setValueAt (sampleOffset, value): once with
+        offset 0 for the value at the block start, then once per breakpoint
+        that falls inside the block, at the exact sample containing it. This
+        maps directly onto parameter interfaces that accept timestamped value
+        changes.
+    */
+    template <typename SetValueFn>
+    void applyToBlock (double startTime, double timePerSample, int numSamples,
+                       Cursor& cursor, SetValueFn&& setValueAt) const
+    {
+        if (numSamples <= 0)
+            return;
+
+        setValueAt (0, getValueAt (startTime, cursor));
+
+        const auto endTime = startTime + (double) numSamples * timePerSample;
+
+        for (auto i = cursor.segment + 1; i < times.size(); ++i)
+        {
+            const auto pointTime = times.getUnchecked (i);
+
+            if (pointTime >= endTime)
+                break;
+
+            if (pointTime > startTime)
+            {
+                const auto offset = jlimit (0, numSamples - 1,
+                                            (int) ((pointTime - startTime) / timePerSample));
+                setValueAt (offset, values.getUnchecked (i));
+            }
+        }
+    }
+
+private:
+    //==============================================================================
+    Array<double> times;
+    Array<float> values, curvatures;
+
+    int findSegment (double time) const noexcept;
+    void updateCursor (double time, Cursor&) const noexcept;
+    float getValueInSegment (int segment, double time) const noexcept;
+
+    JUCE_LEAK_DETECTOR (AutomationCurve)
+};
+
+} // namespace juce
@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class AutomationCurveTests  : public UnitTest
+{
+public:
+    AutomationCurveTests()
+        : UnitTest ("AutomationCurve", UnitTestCategories::audio) {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        beginTest ("Lookups interpolate linearly and hold the end values");
+        {
+            AutomationCurve curve;
+            expectEquals (curve.getValueAt (1.0), 0.0f);
+
+            curve.addPoint (2.0, 1.0f);
+            curve.addPoint (1.0, 0.0f);
+
+            expectEquals (curve.getNumPoints(), 2);
+            expectEquals (curve.getPointTime (0), 1.0);
+            expectEquals (curve.getPointTime (1), 2.0);
+
+            expectEquals (curve.getValueAt (0.5), 0.0f);
+            expectEquals (curve.getValueAt (1.0), 0.0f);
+            expectWithinAbsoluteError (curve.getValueAt (1.5), 0.5f, 1.0e-6f);
+            expectEquals (curve.getValueAt (2.0), 1.0f);
+            expectEquals (curve.getValueAt (9.0), 1.0f);
+        }
+
+        beginTest ("Curvature bends a segment towards either end");
+        {
+            AutomationCurve rising;
+            rising.addPoint (0.0, 0.0f, 1.0f);
+            rising.addPoint (1.0, 1.0f);
+            expectWithinAbsoluteError (rising.getValueAt (0.5), 0.25f, 1.0e-6f);
+
+            AutomationCurve falling;
+            falling.addPoint (0.0, 0.0f, -1.0f);
+            falling.addPoint (1.0, 1.0f);
+            expectWithinAbsoluteError (falling.getValueAt (0.5), 0.75f, 1.0e-6f);
+
+            AutomationCurve step;
+            step.addPoint (1.0, 0.0f);
+            step.addPoint (1.0, 1.0f);
+            expectEquals (step.getValueAt (0.999), 0.0f);
+            expectEquals (step.getValueAt (1.0), 1.0f);
+        }
+
+        AutomationCurve curve;
+
+        for (int i = 0; i < 200; ++i)
+            curve.addPoint (random.nextDouble() * 100.0,
+                            random.nextFloat(),
+                            random.nextFloat() * 2.0f - 1.0f);
+
+        beginTest ("Cursor queries match binary-search lookups");
+        {
+            AutomationCurve::Cursor cursor;
+
+            for (double time = -5.0; time < 110.0; time += 0.37)
+                expectEquals (curve.getValueAt (time, cursor), curve.getValueAt (time));
+
+            // Jumping backwards re-finds the segment.
+            expectEquals (curve.getValueAt (31.5, cursor), curve.getValueAt (31.5));
+            expectEquals (curve.getValueAt (3.25, cursor), curve.getValueAt (3.25));
+        }
+
+        beginTest ("evaluate matches per-sample lookups");
+        {
+            constexpr int numSamples = 512;
+            constexpr double timePerSample = 100.0 / 2000.0;
+
+            float buffer[numSamples];
+            AutomationCurve::Cursor cursor;
+
+            for (int block = 0; block < 4; ++block)
+            {
+                const auto startTime = -2.0 + (double) (block * numSamples) * timePerSample;
+                curve.evaluate (startTime, timePerSample, buffer, numSamples, cursor);
+
+                for (int i = 0; i < numSamples; ++i)
+                    expectWithinAbsoluteError (buffer[i],
+                                               curve.getValueAt (startTime + (double) i * timePerSample),
+                                               1.0e-3f);
+            }
+        }
+
+        beginTest ("applyToBlock reports sparse, sample-accurate changes");
+        {
+            AutomationCurve automation;
+            automation.addPoint (10.0, 0.25f);
+            automation.addPoint (20.0, 0.75f);
+
+            AutomationCurve::Cursor cursor;
+            Array<int> offsets;
+            Array<float> reportedValues;
+
+            automation.applyToBlock (0.0, 1.0, 32, cursor, [&] (int offset, float value)
+            {
+                offsets.add (offset);
+                reportedValues.add (value);
+            });
+
+            expectEquals (offsets.size(), 3);
+            expectEquals (offsets[0], 0);
+            expectEquals (offsets[1], 10);
+            expectEquals (offsets[2], 20);
+            expectEquals (reportedValues[0], 0.25f);
+            expectEquals (reportedValues[1], 0.25f);
+            expectEquals (reportedValues[2], 0.75f);
+
+            // The next block holds the last value, so only the block-start
+            // change is reported.
+            offsets.clearQuick();
+            automation.applyToBlock (32.0, 1.0, 32, cursor, [&] (int offset, float)
+            {
+                offsets.add (offset);
+            });
+
+            expectEquals (offsets.size(), 1);
+            expectEquals (offsets[0], 0);
+        }
+    }
+};
+
+static AutomationCurveTests automationCurveTests;
+
+} // namespace juce
@@ -337,4 +337,79 @@ void IIRFilterBase<Mutex>::processSamples (float* const samples, const int numSa
 template class IIRFilterBase<SpinLock>;
 template class IIRFilterBase<DummyCriticalSection>;
 
+//==============================================================================
+void MultichannelIIRFilter::makeInactive() noexcept
+{
+    active = false;
+}
+
+void MultichannelIIRFilter::setCoefficients (const IIRCoefficients& newCoefficients) noexcept
+{
+    coefficients = newCoefficients;
+    active = true;
+}
+
+void MultichannelIIRFilter::setNumChannels (int numChannels)
+{
+    jassert (numChannels >= 0);
+
+    if (numChannels > numAllocatedChannels)
+    {
+        channelStates.realloc ((size_t) numChannels * 2);
+
+        for (int i = numAllocatedChannels * 2; i < numChannels * 2; ++i)
+            channelStates[i] = 0;
+
+        numAllocatedChannels = numChannels;
+    }
+}
+
+void MultichannelIIRFilter::reset() noexcept
+{
+    for (int i = 0; i < numAllocatedChannels * 2; ++i)
+        channelStates[i] = 0;
+}
+
+void MultichannelIIRFilter::processSamples (float* const* channels, int numChannels, int numSamples) noexcept
+{
+    if (! active || numSamples <= 0)
+        return;
+
+    // ideally this has been done up-front by setNumChannels(), so that no
+    // allocation happens here
+    if (numChannels > numAllocatedChannels)
+        setNumChannels (numChannels);
+
+    const auto c0 = coefficients.coefficients[0];
+    const auto c1 = coefficients.coefficients[1];
+    const auto c2 = coefficients.coefficients[2];
+    const auto c3 = coefficients.coefficients[3];
+    const auto c4 = coefficients.coefficients[4];
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto* samples = channels[ch];
+        auto lv1 = channelStates[ch * 2];
+        auto lv2 = channelStates[ch * 2 + 1];
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto in = samples[i];
+            auto out = c0 * in + lv1;
+            samples[i] = out;
+
+            lv1 = c1 * in - c3 * out + lv2;
+            lv2 = c2 * in - c4 * out;
+        }
+
+        JUCE_SNAP_TO_ZERO (lv1);  channelStates[ch * 2]     = lv1;
+        JUCE_SNAP_TO_ZERO (lv2);  channelStates[ch * 2 + 1] = lv2;
+    }
+}
+
+void MultichannelIIRFilter::processSamples (AudioBuffer<float>& buffer) noexcept
+{
+    processSamples (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), buffer.getNumSamples());
+}
+
 } // namespace juce
@@ -251,4 +251,76 @@ public:
     using IIRFilterBase::IIRFilterBase;
 };
 
+//==============================================================================
+/**
+    Applies a single set of IIR coefficients to any number of audio channels.
+
+    Running the same filter shape on every channel of a bus with one IIRFilter
+    per channel means each buffer pays for a lock and its own copy of the
+    coefficients. This class stores the coefficients once, keeps just a pair of
+    state variables per channel, and filters all the channels in one call, so
+    the per-buffer overhead is paid once for the whole bus.
+
+    Like SingleThreadedIIRFilter, this class does no locking, so calls to its
+    member functions must be synchronised externally.
+
+    @see SingleThreadedIIRFilter, IIRCoefficients
+
+    @tags{Audio}
+*/
+class JUCE_API  MultichannelIIRFilter
+{
+public:
+    //==============================================================================
+    /** Creates a filter.
+
+        Initially the filter is inactive, so will have no effect on samples that
+        you process with it. Use the setCoefficients() method to turn it into the
+        type of filter needed.
+    */
+    MultichannelIIRFilter() noexcept = default;
+
+    //==============================================================================
+    /** Clears the filter so that any incoming data passes through unchanged. */
+    void makeInactive() noexcept;
+
+    /** Applies a set of coefficients, which will be shared by all the channels. */
+    void setCoefficients (const IIRCoefficients& newCoefficients) noexcept;
+
+    /** Returns the coefficients that this filter is using. */
+    IIRCoefficients getCoefficients() const noexcept    { return coefficients; }
+
+    //==============================================================================
+    /** Pre-allocates the filter state for a number of channels.
+
+        processSamples() will grow the state on demand if it sees more channels
+        than it has seen before, but that involves allocation, so call this from
+        your prepare-to-play code if the filter will run on an audio thread.
+    */
+    void setNumChannels (int numChannels);
+
+    /** Resets the processing state of every channel, ready to start a new
+        stream of data.
+
+        The type of filter and its coefficients aren't changed.
+    */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Performs the filter operation on a set of channels. */
+    void processSamples (float* const* channels, int numChannels, int numSamples) noexcept;
+
+    /** Performs the filter operation on all the channels of a buffer. */
+    void processSamples (AudioBuffer<float>& buffer) noexcept;
+
+private:
+    //==============================================================================
+    IIRCoefficients coefficients;
+    HeapBlock<float> channelStates;
+    int numAllocatedChannels = 0;
+    bool active = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MultichannelIIRFilter)
+};
+
 } // namespace juce
@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct MultichannelIIRFilterTests  : public UnitTest
+{
+    MultichannelIIRFilterTests()  : UnitTest ("MultichannelIIRFilter", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+        constexpr int numChannels = 6, numSamples = 512;
+
+        AudioBuffer<float> input (numChannels, numSamples);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                input.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+        beginTest ("Inactive filter passes data through unchanged");
+        {
+            auto buffer = input;
+            MultichannelIIRFilter filter;
+            filter.processSamples (buffer);
+
+            expect (buffersMatch (buffer, input, 0.0f));
+        }
+
+        beginTest ("Matches a SingleThreadedIIRFilter per channel");
+        {
+            auto coefficients = IIRCoefficients::makeLowPass (44100.0, 2000.0);
+
+            auto buffer = input;
+            MultichannelIIRFilter filter;
+            filter.setNumChannels (numChannels);
+            filter.setCoefficients (coefficients);
+
+            // process in two blocks, to check that the state carries across calls
+            const int splitPoint = 123;
+            float* firstBlock[numChannels], * secondBlock[numChannels];
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                firstBlock[ch]  = buffer.getWritePointer (ch);
+                secondBlock[ch] = buffer.getWritePointer (ch, splitPoint);
+            }
+
+            filter.processSamples (firstBlock, numChannels, splitPoint);
+            filter.processSamples (secondBlock, numChannels, numSamples - splitPoint);
+
+            auto expected = input;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                SingleThreadedIIRFilter reference;
+                reference.setCoefficients (coefficients);
+                reference.processSamples (expected.getWritePointer (ch), numSamples);
+            }
+
+            expect (buffersMatch (buffer, expected, 1.0e-6f));
+        }
+
+        beginTest ("Reset clears the state on every channel");
+        {
+            MultichannelIIRFilter filter;
+            filter.setCoefficients (IIRCoefficients::makeHighPass (44100.0, 500.0));
+
+            auto buffer = input;
+            filter.processSamples (buffer);
+            filter.reset();
+
+            auto secondPass = input;
+            filter.processSamples (secondPass);
+
+            expect (buffersMatch (buffer, secondPass, 0.0f));
+        }
+    }
+
+    static bool buffersMatch (const AudioBuffer<float>& a, const AudioBuffer<float>& b, float tolerance)
+    {
+        for (int ch = 0; ch < a.getNumChannels(); ++ch)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                if (std::abs (a.getSample (ch, i) - b.getSample (ch, i)) > tolerance)
+                    return false;
+
+        return true;
+    }
+};
+
+static MultichannelIIRFilterTests multichannelIIRFilterTests;
+
+} // namespace juce
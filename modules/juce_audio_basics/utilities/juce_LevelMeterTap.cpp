@@ -0,0 +1,193 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+LevelMeterTap::LevelMeterTap() = default;
+LevelMeterTap::~LevelMeterTap() = default;
+
+void LevelMeterTap::prepare (int newNumChannels, int samplesBetweenSnapshots)
+{
+    jassert (newNumChannels > 0 && samplesBetweenSnapshots > 0);
+
+    numChannels = newNumChannels;
+    samplesPerSnapshot = samplesBetweenSnapshots;
+
+    accumulators.calloc (numChannels);
+    published.calloc (numChannels);
+
+    reset();
+}
+
+void LevelMeterTap::reset() noexcept
+{
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        accumulators[ch] = {};
+        published[ch] = {};
+    }
+
+    samplesAccumulated = 0;
+    sequence = 0;
+}
+
+//==============================================================================
+void LevelMeterTap::process (const AudioBuffer<float>& buffer) noexcept
+{
+    process (buffer.getArrayOfReadPointers(), buffer.getNumChannels(), buffer.getNumSamples());
+}
+
+void LevelMeterTap::process (const float* const* channelData, int numChannelsToProcess, int numSamples) noexcept
+{
+    numChannelsToProcess = jmin (numChannelsToProcess, numChannels);
+
+    int start = 0;
+
+    while (numSamples > 0)
+    {
+        auto numToDo = jmin (numSamples, samplesPerSnapshot - samplesAccumulated);
+
+        for (int ch = 0; ch < numChannelsToProcess; ++ch)
+        {
+            auto* data = channelData[ch] + start;
+            auto& acc = accumulators[ch];
+
+            auto range = FloatVectorOperations::findMinAndMax (data, numToDo);
+            acc.peak = jmax (acc.peak, std::abs (range.getStart()), std::abs (range.getEnd()));
+
+            double sumOfSquares = 0.0;
+
+            for (int i = 0; i < numToDo; ++i)
+                sumOfSquares += (double) data[i] * (double) data[i];
+
+            acc.sumOfSquares += sumOfSquares;
+        }
+
+        samplesAccumulated += numToDo;
+        start += numToDo;
+        numSamples -= numToDo;
+
+        if (samplesAccumulated >= samplesPerSnapshot)
+            publish();
+    }
+}
+
+void LevelMeterTap::publish() noexcept
+{
+    // Seqlock write: odd sequence values tell readers a publish is in progress.
+    auto seq = sequence.load (std::memory_order_relaxed);
+    sequence.store (seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_release);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto& acc = accumulators[ch];
+
+        published[ch].peak = acc.peak;
+        published[ch].rms = samplesAccumulated > 0
+                                ? (float) std::sqrt (acc.sumOfSquares / samplesAccumulated)
+                                : 0.0f;
+        acc = {};
+    }
+
+    sequence.store (seq + 2, std::memory_order_release);
+    samplesAccumulated = 0;
+}
+
+uint32 LevelMeterTap::readLevels (Level* result) const noexcept
+{
+    for (;;)
+    {
+        auto seqBefore = sequence.load (std::memory_order_acquire);
+
+        if ((seqBefore & 1u) == 0)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                result[ch] = published[ch];
+
+            std::atomic_thread_fence (std::memory_order_acquire);
+
+            if (sequence.load (std::memory_order_relaxed) == seqBefore)
+                return seqBefore / 2;
+        }
+
+        // A publish happened mid-read - levels are tiny, so just try again.
+    }
+}
+
+//==============================================================================
+void LevelMeterTap::Ballistics::prepare (int newNumChannels)
+{
+    numChannels = newNumChannels;
+    smoothed.clearQuick();
+    smoothed.insertMultiple (0, {}, numChannels);
+    scratch.calloc (numChannels);
+}
+
+void LevelMeterTap::Ballistics::setTimes (float attackMs, float releaseMs) noexcept
+{
+    attackTimeMs = jmax (0.0f, attackMs);
+    releaseTimeMs = jmax (0.0f, releaseMs);
+}
+
+void LevelMeterTap::Ballistics::update (const LevelMeterTap& tap, double millisecondsElapsed)
+{
+    auto numToDo = jmin (numChannels, tap.getNumChannels());
+
+    if (numToDo <= 0)
+        return;
+
+    tap.readLevels (scratch);
+
+    const auto smoothingAmount = [millisecondsElapsed] (float timeConstantMs) -> float
+    {
+        if (timeConstantMs <= 0.0f)
+            return 1.0f;
+
+        return 1.0f - (float) std::exp (-millisecondsElapsed / timeConstantMs);
+    };
+
+    const auto attack  = smoothingAmount (attackTimeMs);
+    const auto release = smoothingAmount (releaseTimeMs);
+
+    for (int ch = 0; ch < numToDo; ++ch)
+    {
+        auto& level = smoothed.getReference (ch);
+        const auto& target = scratch[ch];
+
+        // Peaks are picked up instantly and fall at the release rate
+        level.peak = target.peak > level.peak
+                        ? target.peak
+                        : level.peak + (target.peak - level.peak) * release;
+
+        level.rms += (target.rms - level.rms) * (target.rms > level.rms ? attack : release);
+    }
+}
+
+LevelMeterTap::Level LevelMeterTap::Ballistics::getLevel (int channel) const noexcept
+{
+    jassert (isPositiveAndBelow (channel, smoothed.size()));
+    return smoothed[channel];
+}
+
+} // namespace juce
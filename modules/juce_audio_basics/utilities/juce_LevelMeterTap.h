@@ -0,0 +1,159 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A wait-free metering tap that accumulates per-channel peak and RMS levels
+    on the audio thread and publishes decimated snapshots for other threads
+    to read.
+
+    Call process() from your audio callback with each block; the tap keeps a
+    running peak and sum-of-squares per channel, and every time the configured
+    number of samples has been accumulated it publishes a snapshot through a
+    seqlock. The audio thread never locks, allocates or waits, and publishing
+    costs a couple of atomic increments.
+
+    Any other thread - typically a UI timer - can call readLevels() at any
+    time to get the most recent snapshot. Meter ballistics are applied on the
+    reader side with the Ballistics helper, so the attack and release times
+    can be changed freely without touching the audio thread.
+
+    @see AudioBuffer, FloatVectorOperations
+
+    @tags{Audio}
+*/
+class JUCE_API  LevelMeterTap
+{
+public:
+    //==============================================================================
+    /** The published level of one channel. */
+    struct Level
+    {
+        float peak = 0.0f;   /**< The highest absolute sample value in the snapshot period. */
+        float rms  = 0.0f;   /**< The root-mean-square level over the snapshot period. */
+    };
+
+    //==============================================================================
+    /** Creates an unprepared tap - call prepare() before using it. */
+    LevelMeterTap();
+
+    /** Destructor. */
+    ~LevelMeterTap();
+
+    //==============================================================================
+    /** Sets up the tap for the given channel count.
+
+        A snapshot is published each time samplesBetweenSnapshots samples have
+        been accumulated, so the value controls the decimation of delivery:
+        at 44.1kHz the default of 1024 publishes at about 43Hz, which is
+        plenty for a meter painted from a timer.
+
+        This allocates, so call it from your prepare callback, not from the
+        audio thread.
+    */
+    void prepare (int numChannels, int samplesBetweenSnapshots = 1024);
+
+    /** Clears the accumulated state and the published levels. */
+    void reset() noexcept;
+
+    /** Returns the number of channels the tap was prepared for. */
+    int getNumChannels() const noexcept         { return numChannels; }
+
+    //==============================================================================
+    /** Accumulates levels from a buffer. Call this from the audio thread.
+        Channels beyond the prepared channel count are ignored.
+    */
+    void process (const AudioBuffer<float>& buffer) noexcept;
+
+    /** Accumulates levels from raw channel data. Call this from the audio thread. */
+    void process (const float* const* channelData, int numChannelsToProcess, int numSamples) noexcept;
+
+    //==============================================================================
+    /** Copies the most recently published levels into the given array, which
+        must hold at least getNumChannels() entries.
+
+        This can be called from any thread; if a snapshot is being published
+        at the same moment, it simply retries. Returns the sequence number of
+        the snapshot, which increases by one per publish, so a caller can tell
+        whether anything new has arrived since it last read.
+    */
+    uint32 readLevels (Level* result) const noexcept;
+
+    //==============================================================================
+    /**
+        Applies attack/release ballistics to the raw snapshots from a
+        LevelMeterTap.
+
+        Keep one of these on the reader side, call update() regularly (e.g.
+        from the timer that repaints your meters), and paint from getLevel().
+        Peaks fall at the release rate but are picked up instantly; RMS is
+        smoothed in both directions.
+    */
+    class JUCE_API  Ballistics
+    {
+    public:
+        Ballistics() = default;
+
+        /** Sets the number of channels to track. */
+        void prepare (int numChannels);
+
+        /** Sets the attack and release time constants, in milliseconds. */
+        void setTimes (float attackMs, float releaseMs) noexcept;
+
+        /** Reads the tap's latest levels and advances the smoothed values by
+            the given time step.
+        */
+        void update (const LevelMeterTap& tap, double millisecondsElapsed);
+
+        /** Returns the current smoothed level of a channel. */
+        Level getLevel (int channel) const noexcept;
+
+    private:
+        Array<Level> smoothed;
+        HeapBlock<Level> scratch;
+        float attackTimeMs = 0.0f, releaseTimeMs = 300.0f;
+        int numChannels = 0;
+    };
+
+private:
+    //==============================================================================
+    void publish() noexcept;
+
+    //==============================================================================
+    struct ChannelAccumulator
+    {
+        float peak = 0.0f;
+        double sumOfSquares = 0.0;
+    };
+
+    HeapBlock<ChannelAccumulator> accumulators;
+    HeapBlock<Level> published;
+    std::atomic<uint32> sequence { 0 };
+    int numChannels = 0, samplesPerSnapshot = 0, samplesAccumulated = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LevelMeterTap)
+};
+
+} // namespace juce
@@ -0,0 +1,155 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct LevelMeterTapTests  : public UnitTest
+{
+    LevelMeterTapTests()  : UnitTest ("LevelMeterTap", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        beginTest ("Constant signals produce the expected peak and RMS");
+        {
+            LevelMeterTap tap;
+            tap.prepare (2, 256);
+
+            AudioBuffer<float> buffer (2, 256);
+            buffer.clear();
+
+            for (int i = 0; i < 256; ++i)
+            {
+                buffer.setSample (0, i, 0.5f);
+                buffer.setSample (1, i, -0.25f);
+            }
+
+            tap.process (buffer);
+
+            LevelMeterTap::Level levels[2];
+            expectEquals ((int) tap.readLevels (levels), 1);
+            expectWithinAbsoluteError (levels[0].peak, 0.5f, 1.0e-6f);
+            expectWithinAbsoluteError (levels[0].rms,  0.5f, 1.0e-6f);
+            expectWithinAbsoluteError (levels[1].peak, 0.25f, 1.0e-6f);
+            expectWithinAbsoluteError (levels[1].rms,  0.25f, 1.0e-6f);
+        }
+
+        beginTest ("Snapshots are only published once enough samples have accumulated");
+        {
+            LevelMeterTap tap;
+            tap.prepare (1, 256);
+
+            AudioBuffer<float> buffer (1, 100);
+
+            for (int i = 0; i < 100; ++i)
+                buffer.setSample (0, i, 1.0f);
+
+            LevelMeterTap::Level level;
+
+            tap.process (buffer);
+            expectEquals ((int) tap.readLevels (&level), 0);
+            expectEquals (level.peak, 0.0f);
+
+            tap.process (buffer);
+            expectEquals ((int) tap.readLevels (&level), 0);
+
+            // The third block crosses the snapshot boundary, and the peak seen
+            // in all three blocks ends up in the published snapshot.
+            tap.process (buffer);
+            expectEquals ((int) tap.readLevels (&level), 1);
+            expectWithinAbsoluteError (level.peak, 1.0f, 1.0e-6f);
+        }
+
+        beginTest ("A sine wave's RMS is amplitude over root two");
+        {
+            LevelMeterTap tap;
+            tap.prepare (1, 1024);
+
+            AudioBuffer<float> buffer (1, 1024);
+
+            for (int i = 0; i < 1024; ++i)
+                buffer.setSample (0, i, 0.8f * std::sin (MathConstants<float>::twoPi * 8.0f * (float) i / 1024.0f));
+
+            tap.process (buffer);
+
+            LevelMeterTap::Level level;
+            tap.readLevels (&level);
+
+            expectWithinAbsoluteError (level.rms, 0.8f / MathConstants<float>::sqrt2, 1.0e-3f);
+            expectWithinAbsoluteError (level.peak, 0.8f, 1.0e-2f);
+        }
+
+        beginTest ("One long buffer can publish several snapshots");
+        {
+            LevelMeterTap tap;
+            tap.prepare (1, 128);
+
+            AudioBuffer<float> buffer (1, 512);
+
+            for (int i = 0; i < 512; ++i)
+                buffer.setSample (0, i, 0.1f);
+
+            tap.process (buffer);
+
+            LevelMeterTap::Level level;
+            expectEquals ((int) tap.readLevels (&level), 4);
+        }
+
+        beginTest ("Ballistics pick peaks up instantly and release them gradually");
+        {
+            LevelMeterTap tap;
+            tap.prepare (1, 64);
+
+            LevelMeterTap::Ballistics ballistics;
+            ballistics.prepare (1);
+            ballistics.setTimes (0.0f, 300.0f);
+
+            AudioBuffer<float> loud (1, 64), quiet (1, 64);
+            quiet.clear();
+
+            for (int i = 0; i < 64; ++i)
+                loud.setSample (0, i, 0.9f);
+
+            tap.process (loud);
+            ballistics.update (tap, 30.0);
+            expectWithinAbsoluteError (ballistics.getLevel (0).peak, 0.9f, 1.0e-6f);
+
+            tap.process (quiet);
+
+            auto previous = ballistics.getLevel (0).peak;
+
+            for (int step = 0; step < 5; ++step)
+            {
+                ballistics.update (tap, 30.0);
+                auto current = ballistics.getLevel (0).peak;
+
+                expect (current < previous);
+                expect (current > 0.0f);
+                previous = current;
+            }
+        }
+    }
+};
+
+static LevelMeterTapTests levelMeterTapTests;
+
+} // namespace juce
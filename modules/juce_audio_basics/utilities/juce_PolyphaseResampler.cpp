@@ -0,0 +1,363 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/*  Evaluates one output sample: a dot-product of numTaps input samples against
+    a kernel interpolated between two adjacent rows of the phase bank.
+
+    numTaps is always a multiple of 4, so the loops below need no tail handling.
+*/
+static forcedinline float convolvePolyphase (const float* inputs,
+                                             const float* lower, const float* upper,
+                                             float phaseFrac, int numTaps) noexcept
+{
+   #if JUCE_USE_SSE_INTRINSICS
+    const auto frac = _mm_set1_ps (phaseFrac);
+    auto acc = _mm_setzero_ps();
+
+    for (int j = 0; j < numTaps; j += 4)
+    {
+        const auto lo = _mm_loadu_ps (lower + j);
+        const auto hi = _mm_loadu_ps (upper + j);
+        const auto in = _mm_loadu_ps (inputs + j);
+        const auto kernel = _mm_add_ps (lo, _mm_mul_ps (frac, _mm_sub_ps (hi, lo)));
+
+        acc = _mm_add_ps (acc, _mm_mul_ps (kernel, in));
+    }
+
+    auto sum = _mm_add_ps (acc, _mm_movehl_ps (acc, acc));
+    sum = _mm_add_ss (sum, _mm_shuffle_ps (sum, sum, 0x55));
+    return _mm_cvtss_f32 (sum);
+   #elif JUCE_USE_ARM_NEON
+    auto acc = vdupq_n_f32 (0.0f);
+
+    for (int j = 0; j < numTaps; j += 4)
+    {
+        const auto lo = vld1q_f32 (lower + j);
+        const auto hi = vld1q_f32 (upper + j);
+        const auto in = vld1q_f32 (inputs + j);
+        const auto kernel = vmlaq_n_f32 (lo, vsubq_f32 (hi, lo), phaseFrac);
+
+        acc = vmlaq_f32 (acc, kernel, in);
+    }
+
+    auto pair = vadd_f32 (vget_low_f32 (acc), vget_high_f32 (acc));
+    pair = vpadd_f32 (pair, pair);
+    return vget_lane_f32 (pair, 0);
+   #else
+    float acc0 = 0.0f, acc1 = 0.0f, acc2 = 0.0f, acc3 = 0.0f;
+
+    for (int j = 0; j < numTaps; j += 4)
+    {
+        acc0 += (lower[j]     + phaseFrac * (upper[j]     - lower[j]))     * inputs[j];
+        acc1 += (lower[j + 1] + phaseFrac * (upper[j + 1] - lower[j + 1])) * inputs[j + 1];
+        acc2 += (lower[j + 2] + phaseFrac * (upper[j + 2] - lower[j + 2])) * inputs[j + 2];
+        acc3 += (lower[j + 3] + phaseFrac * (upper[j + 3] - lower[j + 3])) * inputs[j + 3];
+    }
+
+    return (acc0 + acc1) + (acc2 + acc3);
+   #endif
+}
+
+/*  Lerps between two rows of the phase bank, writing the resulting kernel out
+    so that it can be applied to several channels.
+*/
+static forcedinline void interpolateKernel (const float* lower, const float* upper,
+                                            float phaseFrac, float* dest, int numTaps) noexcept
+{
+   #if JUCE_USE_SSE_INTRINSICS
+    const auto frac = _mm_set1_ps (phaseFrac);
+
+    for (int j = 0; j < numTaps; j += 4)
+    {
+        const auto lo = _mm_loadu_ps (lower + j);
+        const auto hi = _mm_loadu_ps (upper + j);
+
+        _mm_storeu_ps (dest + j, _mm_add_ps (lo, _mm_mul_ps (frac, _mm_sub_ps (hi, lo))));
+    }
+   #elif JUCE_USE_ARM_NEON
+    for (int j = 0; j < numTaps; j += 4)
+    {
+        const auto lo = vld1q_f32 (lower + j);
+        const auto hi = vld1q_f32 (upper + j);
+
+        vst1q_f32 (dest + j, vmlaq_n_f32 (lo, vsubq_f32 (hi, lo), phaseFrac));
+    }
+   #else
+    for (int j = 0; j < numTaps; ++j)
+        dest[j] = lower[j] + phaseFrac * (upper[j] - lower[j]);
+   #endif
+}
+
+static forcedinline float dotProduct (const float* inputs, const float* kernel, int numTaps) noexcept
+{
+   #if JUCE_USE_SSE_INTRINSICS
+    auto acc = _mm_setzero_ps();
+
+    for (int j = 0; j < numTaps; j += 4)
+        acc = _mm_add_ps (acc, _mm_mul_ps (_mm_loadu_ps (kernel + j), _mm_loadu_ps (inputs + j)));
+
+    auto sum = _mm_add_ps (acc, _mm_movehl_ps (acc, acc));
+    sum = _mm_add_ss (sum, _mm_shuffle_ps (sum, sum, 0x55));
+    return _mm_cvtss_f32 (sum);
+   #elif JUCE_USE_ARM_NEON
+    auto acc = vdupq_n_f32 (0.0f);
+
+    for (int j = 0; j < numTaps; j += 4)
+        acc = vmlaq_f32 (acc, vld1q_f32 (kernel + j), vld1q_f32 (inputs + j));
+
+    auto pair = vadd_f32 (vget_low_f32 (acc), vget_high_f32 (acc));
+    pair = vpadd_f32 (pair, pair);
+    return vget_lane_f32 (pair, 0);
+   #else
+    float acc0 = 0.0f, acc1 = 0.0f, acc2 = 0.0f, acc3 = 0.0f;
+
+    for (int j = 0; j < numTaps; j += 4)
+    {
+        acc0 += kernel[j]     * inputs[j];
+        acc1 += kernel[j + 1] * inputs[j + 1];
+        acc2 += kernel[j + 2] * inputs[j + 2];
+        acc3 += kernel[j + 3] * inputs[j + 3];
+    }
+
+    return (acc0 + acc1) + (acc2 + acc3);
+   #endif
+}
+
+//==============================================================================
+PolyphaseResampler::PolyphaseResampler() {}
+PolyphaseResampler::~PolyphaseResampler() {}
+
+void PolyphaseResampler::prepare (double samplesInPerOutputSample, Quality qualityToUse)
+{
+    prepare (samplesInPerOutputSample, qualityToUse, 1);
+}
+
+void PolyphaseResampler::prepare (double samplesInPerOutputSample, Quality qualityToUse, int numChannelsToUse)
+{
+    jassert (samplesInPerOutputSample > 0);
+    jassert (numChannelsToUse > 0);
+
+    switch (qualityToUse)
+    {
+        case Quality::fastest:    numTaps = 8;   numPhases = 64;  break;
+        case Quality::medium:     numTaps = 16;  numPhases = 64;  break;
+        case Quality::best:       numTaps = 32;  numPhases = 64;  break;
+        case Quality::mastering:  numTaps = 200; numPhases = 512; break;
+        default:                  jassertfalse;  numTaps = 16; numPhases = 64; break;
+    }
+
+    ratio = jmax (1.0e-3, samplesInPerOutputSample);
+    numChannels = jmax (1, numChannelsToUse);
+
+    filterBank.malloc ((size_t) numTaps * (size_t) (numPhases + 1));
+    scratchKernel.malloc ((size_t) numTaps);
+    updateFilterBank();
+
+    historyCapacity = numTaps * 8 + 256;
+    history.malloc ((size_t) historyCapacity * (size_t) numChannels);
+
+    reset();
+}
+
+void PolyphaseResampler::setResamplingRatio (double samplesInPerOutputSample) noexcept
+{
+    // this object must be prepare()d before setting a ratio on it
+    jassert (numTaps > 0);
+    jassert (samplesInPerOutputSample > 0);
+
+    ratio = jmax (1.0e-3, samplesInPerOutputSample);
+    updateFilterBank();
+}
+
+void PolyphaseResampler::updateFilterBank() noexcept
+{
+    const auto half = numTaps / 2;
+
+    // when down-sampling, the pass-band has to shrink to the output Nyquist;
+    // the factor leaves a little transition bandwidth for the short kernels
+    const auto cutoff = 0.475 / jmax (1.0, ratio);
+
+    for (int p = 0; p <= numPhases; ++p)
+    {
+        auto* row = filterBank + (size_t) p * (size_t) numTaps;
+        const auto offset = (double) p / (double) numPhases;
+        double sum = 0.0;
+
+        for (int j = 0; j < numTaps; ++j)
+        {
+            const auto t = (double) (j - half + 1) - offset;
+
+            auto value = t == 0.0 ? 2.0 * cutoff
+                                  : std::sin (MathConstants<double>::twoPi * cutoff * t)
+                                       / (MathConstants<double>::pi * t);
+
+            // hann window over the kernel's span
+            value *= 0.5 * (1.0 + std::cos (MathConstants<double>::pi * t / (double) half));
+
+            sum += value;
+            row[j] = (float) value;
+        }
+
+        // normalise each phase to unity DC gain to avoid amplitude ripple
+        const auto scale = (float) (1.0 / sum);
+
+        for (int j = 0; j < numTaps; ++j)
+            row[j] *= scale;
+    }
+}
+
+void PolyphaseResampler::reset() noexcept
+{
+    // priming the history with half a kernel of silence keeps the output
+    // stream time-aligned with the input
+    numStored = jmax (0, numTaps / 2 - 1);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        FloatVectorOperations::clear (history + (size_t) ch * (size_t) historyCapacity, numStored);
+
+    readPos = 0;
+    subSamplePos = 0.0;
+}
+
+void PolyphaseResampler::pushSamples (const float* samples, int numSamples)
+{
+    // use the multi-channel overload with a resampler prepared for several channels
+    jassert (numChannels == 1);
+
+    pushSamples (&samples, numSamples);
+}
+
+void PolyphaseResampler::pushSamples (const float* const* channels, int numSamples)
+{
+    jassert (numTaps > 0); // must call prepare() first!
+
+    if (numStored + numSamples > historyCapacity)
+    {
+        const auto newCapacity = jmax (historyCapacity * 2, numStored + numSamples + numTaps);
+        history.realloc ((size_t) newCapacity * (size_t) numChannels);
+
+        // each channel's history occupies its own stretch of the block, so
+        // they have to be spread out back to front after growing it
+        for (int ch = numChannels; --ch > 0;)
+            memmove (history + (size_t) ch * (size_t) newCapacity,
+                     history + (size_t) ch * (size_t) historyCapacity,
+                     (size_t) numStored * sizeof (float));
+
+        historyCapacity = newCapacity;
+    }
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        FloatVectorOperations::copy (history + (size_t) ch * (size_t) historyCapacity + numStored,
+                                     channels[ch], numSamples);
+
+    numStored += numSamples;
+}
+
+int PolyphaseResampler::getNumOutputSamplesAvailable() const noexcept
+{
+    const auto limit = (double) (numStored - numTaps + 1 - readPos) - subSamplePos;
+    return jmax (0, (int) std::ceil (limit / ratio));
+}
+
+int PolyphaseResampler::getNumInputSamplesNeeded (int numOutputSamplesWanted) const noexcept
+{
+    if (numOutputSamplesWanted <= 0)
+        return 0;
+
+    const auto lastPos = readPos + subSamplePos + ratio * (numOutputSamplesWanted - 1);
+    return jmax (0, (int) lastPos + numTaps - numStored);
+}
+
+int PolyphaseResampler::readSamples (float* dest, int maxNumSamples) noexcept
+{
+    // use the multi-channel overload with a resampler prepared for several channels
+    jassert (numChannels == 1);
+
+    return readSamples (&dest, maxNumSamples);
+}
+
+int PolyphaseResampler::readSamples (float* const* dest, int maxNumSamples) noexcept
+{
+    int numDone = 0;
+
+    while (numDone < maxNumSamples)
+    {
+        if (readPos + numTaps > numStored)
+            break;
+
+        const auto scaledFrac = subSamplePos * numPhases;
+        const auto phase = (int) scaledFrac;
+        const auto* lower = filterBank + (size_t) phase * (size_t) numTaps;
+
+        if (numChannels == 1)
+        {
+            dest[0][numDone] = convolvePolyphase (history + readPos,
+                                                  lower, lower + numTaps,
+                                                  (float) (scaledFrac - phase), numTaps);
+        }
+        else
+        {
+            // compute the interpolated kernel once, and apply it to every channel
+            interpolateKernel (lower, lower + numTaps,
+                               (float) (scaledFrac - phase), scratchKernel, numTaps);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                dest[ch][numDone] = dotProduct (history + (size_t) ch * (size_t) historyCapacity + readPos,
+                                                scratchKernel, numTaps);
+        }
+
+        ++numDone;
+
+        // the sub-sample position is kept in [0, 1) so that the rounding of
+        // these additions doesn't depend on how the stream was chunked
+        subSamplePos += ratio;
+
+        while (subSamplePos >= 1.0)
+        {
+            subSamplePos -= 1.0;
+            ++readPos;
+        }
+    }
+
+    // drop input samples that can no longer contribute to an output
+    const auto numConsumed = jmin (readPos, numStored);
+
+    if (numConsumed > 0)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* channelHistory = history + (size_t) ch * (size_t) historyCapacity;
+            memmove (channelHistory, channelHistory + numConsumed,
+                     (size_t) (numStored - numConsumed) * sizeof (float));
+        }
+
+        numStored -= numConsumed;
+        readPos -= numConsumed;
+    }
+
+    return numDone;
+}
+
+} // namespace juce
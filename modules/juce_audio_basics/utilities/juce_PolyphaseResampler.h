@@ -0,0 +1,167 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A block-based streaming resampler using a polyphase windowed-sinc filter bank.
+
+    Unlike the GenericInterpolator classes, which compute each output sample
+    independently, this class pre-computes a bank of FIR kernels at prepare()
+    time and then produces output samples as plain dot-products over a
+    contiguous history buffer, which is much friendlier to vector units when
+    resampling many streams at once.
+
+    Samples are fed in with pushSamples() and pulled out with readSamples(),
+    so the input and output block sizes are decoupled - the output produced is
+    independent of how the input was chunked.
+
+    The class can also be prepared for several channels at once, in which case
+    all the channels share one stream position and the interpolated kernel is
+    computed once per output sample and reused for every channel - much cheaper
+    than running one resampler per channel when bulk-converting multi-channel
+    files offline. As it's stateful, call reset() whenever there's a break in
+    the continuity of the input.
+
+    Note that prepare() and pushSamples() may allocate memory, but
+    readSamples() never does.
+
+    @see PolyphaseResamplingAudioSource, GenericInterpolator, Interpolators
+
+    @tags{Audio}
+*/
+class JUCE_API  PolyphaseResampler
+{
+public:
+    //==============================================================================
+    /** Determines the length of the FIR kernel, trading quality for speed. */
+    enum class Quality
+    {
+        fastest,    /**< An 8-tap kernel: adequate stop-band rejection for preview
+                         or scrubbing purposes. */
+        medium,     /**< A 16-tap kernel: a good default for playback. */
+        best,       /**< A 32-tap kernel: suitable for offline rendering. */
+        mastering   /**< A 200-tap kernel with a finer phase bank, comparable to
+                         WindowedSincInterpolator but processed as block
+                         dot-products: for mastering-grade offline conversion. */
+    };
+
+    /** Creates an unprepared resampler - call prepare() before use. */
+    PolyphaseResampler();
+
+    /** Destructor. */
+    ~PolyphaseResampler();
+
+    //==============================================================================
+    /** Designs the filter bank for a given ratio and quality, and resets the stream.
+
+        @param samplesInPerOutputSample     the number of input samples consumed per output
+                                            sample, i.e. inputRate / outputRate. Must be
+                                            greater than 0
+        @param qualityToUse                 the kernel length to use
+    */
+    void prepare (double samplesInPerOutputSample, Quality qualityToUse = Quality::medium);
+
+    /** Designs the filter bank for a multi-channel stream.
+
+        All the channels are kept in step and resampled together, sharing the
+        kernel computed for each output sample. Use the multi-channel overloads
+        of pushSamples() and readSamples() with a resampler prepared this way.
+    */
+    void prepare (double samplesInPerOutputSample, Quality qualityToUse, int numChannelsToUse);
+
+    /** Returns the number of channels the resampler was prepared for. */
+    int getNumChannels() const noexcept                 { return numChannels; }
+
+    /** Changes the resampling ratio of an already-prepared resampler.
+
+        This re-designs the kernels in place without allocating, so it's safe to
+        call from an audio callback. The input history is retained.
+    */
+    void setResamplingRatio (double samplesInPerOutputSample) noexcept;
+
+    /** Returns the current resampling ratio. */
+    double getResamplingRatio() const noexcept          { return ratio; }
+
+    /** Returns the length of the FIR kernel in input samples.
+
+        The first few output samples after a reset() are affected by the filter
+        settling, and roughly this many input samples of pre-roll are needed for
+        it to die away. Apart from that transient, the output stream is
+        time-aligned with the input.
+    */
+    int getFilterLength() const noexcept                { return numTaps; }
+
+    /** Clears the input history, as if the stream was starting afresh. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Appends a block of input samples to the resampler's history buffer. */
+    void pushSamples (const float* samples, int numSamples);
+
+    /** Appends a block of input samples for each channel.
+        The array must hold one pointer per channel the resampler was prepared for.
+    */
+    void pushSamples (const float* const* channels, int numSamples);
+
+    /** Returns the number of output samples that can currently be produced
+        from the input that has been pushed so far.
+    */
+    int getNumOutputSamplesAvailable() const noexcept;
+
+    /** Returns the number of further input samples that must be pushed before
+        the given number of output samples can be produced.
+
+        This will return 0 if readSamples() could already satisfy the request.
+    */
+    int getNumInputSamplesNeeded (int numOutputSamplesWanted) const noexcept;
+
+    /** Produces as many output samples as possible, up to maxNumSamples.
+
+        @returns the number of samples that were actually written to dest
+    */
+    int readSamples (float* dest, int maxNumSamples) noexcept;
+
+    /** Produces as many output samples as possible for each channel, up to
+        maxNumSamples, keeping all the channels in step.
+
+        The array must hold one pointer per channel the resampler was prepared for.
+
+        @returns the number of samples that were written to each channel
+    */
+    int readSamples (float* const* dest, int maxNumSamples) noexcept;
+
+private:
+    //==============================================================================
+    void updateFilterBank() noexcept;
+
+    HeapBlock<float> filterBank, scratchKernel, history;
+    double ratio = 1.0, subSamplePos = 0.0;
+    int numTaps = 0, numStored = 0, historyCapacity = 0, readPos = 0;
+    int numChannels = 1, numPhases = 64;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PolyphaseResampler)
+};
+
+} // namespace juce
@@ -0,0 +1,281 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct PolyphaseResamplerTests  : public UnitTest
+{
+    PolyphaseResamplerTests()  : UnitTest ("PolyphaseResampler", UnitTestCategories::audio)  {}
+
+    static std::vector<float> makeSine (int numSamples, double normalisedFrequency)
+    {
+        std::vector<float> result ((size_t) numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+            result[(size_t) i] = (float) std::sin (MathConstants<double>::twoPi * normalisedFrequency * i);
+
+        return result;
+    }
+
+    static std::vector<float> resampleAll (PolyphaseResampler& resampler, const float* input, int numInputSamples)
+    {
+        resampler.pushSamples (input, numInputSamples);
+
+        std::vector<float> result ((size_t) resampler.getNumOutputSamplesAvailable());
+        auto numRead = resampler.readSamples (result.data(), (int) result.size());
+        result.resize ((size_t) numRead);
+
+        return result;
+    }
+
+    void runTest() override
+    {
+        constexpr int numInputSamples = 4096;
+
+        beginTest ("DC is preserved and sines are reconstructed at the right positions");
+        {
+            for (auto quality : { PolyphaseResampler::Quality::fastest,
+                                  PolyphaseResampler::Quality::medium,
+                                  PolyphaseResampler::Quality::best })
+            {
+                for (auto ratio : { 0.5, 1.0, 8000.0 / 44100.0 + 1.0 })
+                {
+                    PolyphaseResampler resampler;
+                    resampler.prepare (ratio, quality);
+
+                    const auto settle = 2 * resampler.getFilterLength();
+
+                    {
+                        std::vector<float> dc ((size_t) numInputSamples, 1.0f);
+                        auto output = resampleAll (resampler, dc.data(), numInputSamples);
+
+                        expect ((int) output.size() > 2 * settle);
+
+                        for (int i = settle; i < (int) output.size() - settle; ++i)
+                            expectWithinAbsoluteError (output[(size_t) i], 1.0f, 1.0e-3f);
+                    }
+
+                    {
+                        resampler.reset();
+
+                        constexpr double frequency = 0.011;
+                        auto sine = makeSine (numInputSamples, frequency);
+                        auto output = resampleAll (resampler, sine.data(), numInputSamples);
+
+                        // the output should be the same sine, sampled at intervals of the ratio
+                        for (int i = settle; i < (int) output.size() - settle; ++i)
+                        {
+                            const auto expected = (float) std::sin (MathConstants<double>::twoPi * frequency * i * ratio);
+                            expectWithinAbsoluteError (output[(size_t) i], expected, 0.05f);
+                        }
+                    }
+                }
+            }
+        }
+
+        beginTest ("Mastering quality reconstructs a sine almost transparently");
+        {
+            for (auto ratio : { 44100.0 / 48000.0, 2.0 })
+            {
+                PolyphaseResampler resampler;
+                resampler.prepare (ratio, PolyphaseResampler::Quality::mastering);
+
+                constexpr double frequency = 0.011;
+                auto sine = makeSine (4 * numInputSamples, frequency);
+                auto output = resampleAll (resampler, sine.data(), 4 * numInputSamples);
+
+                const auto settle = 2 * resampler.getFilterLength();
+                expect ((int) output.size() > 2 * settle);
+
+                for (int i = settle; i < (int) output.size() - settle; ++i)
+                {
+                    const auto expected = (float) std::sin (MathConstants<double>::twoPi * frequency * i * ratio);
+                    expectWithinAbsoluteError (output[(size_t) i], expected, 2.0e-3f);
+                }
+            }
+        }
+
+        beginTest ("Fused multi-channel processing matches independent resamplers");
+        {
+            constexpr int numChannels = 3;
+            constexpr double ratio = 48000.0 / 44100.0;
+
+            std::vector<std::vector<float>> inputs;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                inputs.push_back (makeSine (numInputSamples, 0.003 * (ch + 1)));
+
+            std::vector<std::vector<float>> expected;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                PolyphaseResampler single;
+                single.prepare (ratio, PolyphaseResampler::Quality::best);
+                expected.push_back (resampleAll (single, inputs[(size_t) ch].data(), numInputSamples));
+            }
+
+            PolyphaseResampler fused;
+            fused.prepare (ratio, PolyphaseResampler::Quality::best, numChannels);
+            expectEquals (fused.getNumChannels(), numChannels);
+
+            auto random = getRandom();
+            std::vector<std::vector<float>> output ((size_t) numChannels);
+            int inputPos = 0;
+
+            while (inputPos < numInputSamples)
+            {
+                const auto numToPush = jmin (numInputSamples - inputPos, random.nextInt (200) + 1);
+
+                const float* ins[numChannels];
+                for (int ch = 0; ch < numChannels; ++ch)
+                    ins[ch] = inputs[(size_t) ch].data() + inputPos;
+
+                fused.pushSamples (ins, numToPush);
+                inputPos += numToPush;
+
+                float blocks[numChannels][64];
+                float* outs[numChannels];
+                for (int ch = 0; ch < numChannels; ++ch)
+                    outs[ch] = blocks[ch];
+
+                for (int numRead; (numRead = fused.readSamples (outs, 64)) > 0;)
+                    for (int ch = 0; ch < numChannels; ++ch)
+                        output[(size_t) ch].insert (output[(size_t) ch].end(), blocks[ch], blocks[ch] + numRead);
+            }
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                expectEquals ((int) output[(size_t) ch].size(), (int) expected[(size_t) ch].size());
+
+                for (size_t i = 0; i < expected[(size_t) ch].size(); ++i)
+                    expectWithinAbsoluteError (output[(size_t) ch][i], expected[(size_t) ch][i], 1.0e-6f);
+            }
+        }
+
+        beginTest ("Output is independent of how the input is chunked");
+        {
+            auto random = getRandom();
+
+            std::vector<float> noise ((size_t) numInputSamples);
+
+            for (auto& sample : noise)
+                sample = random.nextFloat() * 2.0f - 1.0f;
+
+            constexpr double ratio = 44100.0 / 48000.0;
+
+            PolyphaseResampler oneShot;
+            oneShot.prepare (ratio);
+            auto reference = resampleAll (oneShot, noise.data(), numInputSamples);
+
+            PolyphaseResampler chunked;
+            chunked.prepare (ratio);
+
+            std::vector<float> output;
+            int inputPos = 0;
+
+            while (inputPos < numInputSamples)
+            {
+                const auto numToPush = jmin (numInputSamples - inputPos, random.nextInt (200) + 1);
+                chunked.pushSamples (noise.data() + inputPos, numToPush);
+                inputPos += numToPush;
+
+                float block[64];
+
+                for (int numRead; (numRead = chunked.readSamples (block, numElementsInArray (block))) > 0;)
+                    output.insert (output.end(), block, block + numRead);
+            }
+
+            expectEquals ((int) output.size(), (int) reference.size());
+
+            for (size_t i = 0; i < reference.size(); ++i)
+                expectEquals (output[i], reference[i]);
+        }
+
+        beginTest ("The AudioSource wrapper matches the raw push API");
+        {
+            struct SineSource  : public AudioSource
+            {
+                void prepareToPlay (int, double) override {}
+                void releaseResources() override {}
+
+                void getNextAudioBlock (const AudioSourceChannelInfo& info) override
+                {
+                    for (int ch = 0; ch < info.buffer->getNumChannels(); ++ch)
+                    {
+                        auto* dest = info.buffer->getWritePointer (ch, info.startSample);
+
+                        for (int i = 0; i < info.numSamples; ++i)
+                            dest[i] = (float) std::sin (MathConstants<double>::twoPi * 0.007 * (numDone + i));
+                    }
+
+                    numDone += info.numSamples;
+                }
+
+                int numDone = 0;
+            };
+
+            constexpr double ratio = 2.0;
+            constexpr int blockSize = 443;
+            constexpr int numBlocks = 10;
+
+            SineSource source;
+            PolyphaseResamplingAudioSource wrapped (&source, false, 2);
+            wrapped.setResamplingRatio (ratio);
+            wrapped.prepareToPlay (blockSize, 48000.0);
+
+            PolyphaseResampler raw;
+            raw.prepare (ratio);
+
+            auto sine = makeSine (roundToInt (numBlocks * blockSize * ratio) + 64, 0.007);
+
+            AudioBuffer<float> buffer (2, blockSize);
+            int outputPos = 0, inputUsed = 0;
+
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                AudioSourceChannelInfo info (&buffer, 0, blockSize);
+                wrapped.getNextAudioBlock (info);
+
+                const auto needed = raw.getNumInputSamplesNeeded (blockSize);
+                raw.pushSamples (sine.data() + inputUsed, needed);
+                inputUsed += needed;
+
+                std::vector<float> expected ((size_t) blockSize);
+                expectEquals (raw.readSamples (expected.data(), blockSize), blockSize);
+
+                for (int i = 0; i < blockSize; ++i)
+                    for (int ch = 0; ch < 2; ++ch)
+                        expectEquals (buffer.getSample (ch, i), expected[(size_t) i],
+                                      "mismatch at output sample " + String (outputPos + i));
+
+                outputPos += blockSize;
+            }
+
+            wrapped.releaseResources();
+        }
+    }
+};
+
+static PolyphaseResamplerTests polyphaseResamplerTests;
+
+} // namespace juce
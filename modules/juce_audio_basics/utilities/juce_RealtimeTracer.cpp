@@ -0,0 +1,278 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace RealtimeTracerState
+{
+    enum class Phase : uint8
+    {
+        begin,
+        end,
+        marker
+    };
+
+    struct Record
+    {
+        const char* name;
+        int64 ticks;
+        Phase phase;
+    };
+
+    /*  Only the owning thread writes to a ring, so writePos needs no
+        read-modify-write - the release store just publishes the record to the
+        exporting thread.
+    */
+    struct ThreadRing
+    {
+        explicit ThreadRing (int capacityToUse)  : capacity (capacityToUse)
+        {
+            records.calloc ((size_t) capacity);
+        }
+
+        void add (const char* name, Phase phase) noexcept
+        {
+            auto pos = writePos.load (std::memory_order_relaxed);
+            auto& record = records[(size_t) (pos % (uint64) capacity)];
+            record.name = name;
+            record.ticks = Time::getHighResolutionTicks();
+            record.phase = phase;
+            writePos.store (pos + 1, std::memory_order_release);
+        }
+
+        HeapBlock<Record> records;
+        std::atomic<uint64> writePos { 0 };
+        const int capacity;
+        Thread::ThreadID threadID = {};
+    };
+
+    static std::atomic<bool> capturing { false };
+    static std::atomic<int> captureGeneration { 0 };
+    static std::atomic<int> numClaimedRings { 0 };
+    static OwnedArray<ThreadRing> rings;
+    static CriticalSection setupLock;
+
+    /*  The first record a thread writes in each capture claims it a ring; any
+        threads beyond maxThreads just drop their records.
+    */
+    static ThreadRing* getRingForCurrentThread() noexcept
+    {
+        static thread_local ThreadRing* claimedRing = nullptr;
+        static thread_local int claimedGeneration = -1;
+
+        auto generation = captureGeneration.load (std::memory_order_acquire);
+
+        if (claimedGeneration != generation)
+        {
+            claimedGeneration = generation;
+            auto index = numClaimedRings.fetch_add (1, std::memory_order_relaxed);
+            claimedRing = index < rings.size() ? rings.getUnchecked (index) : nullptr;
+
+            if (claimedRing != nullptr)
+                claimedRing->threadID = Thread::getCurrentThreadId();
+        }
+
+        return claimedRing;
+    }
+
+    static void addRecord (const char* name, Phase phase) noexcept
+    {
+        if (! capturing.load (std::memory_order_acquire))
+            return;
+
+        if (auto* ring = getRingForCurrentThread())
+            ring->add (name, phase);
+    }
+}
+
+//==============================================================================
+void RealtimeTracer::startCapture (int maxEventsPerThread, int maxThreads)
+{
+    using namespace RealtimeTracerState;
+    jassert (maxEventsPerThread > 0 && maxThreads > 0);
+
+    const ScopedLock sl (setupLock);
+    stopCapture();
+
+    rings.clear();
+
+    for (int i = 0; i < maxThreads; ++i)
+        rings.add (new ThreadRing (maxEventsPerThread));
+
+    numClaimedRings = 0;
+    captureGeneration.fetch_add (1, std::memory_order_release);
+    capturing.store (true, std::memory_order_release);
+}
+
+void RealtimeTracer::stopCapture() noexcept
+{
+    RealtimeTracerState::capturing.store (false, std::memory_order_release);
+}
+
+bool RealtimeTracer::isCapturing() noexcept
+{
+    return RealtimeTracerState::capturing.load (std::memory_order_acquire);
+}
+
+void RealtimeTracer::beginZone (const char* zoneName) noexcept
+{
+    RealtimeTracerState::addRecord (zoneName, RealtimeTracerState::Phase::begin);
+}
+
+void RealtimeTracer::endZone (const char* zoneName) noexcept
+{
+    RealtimeTracerState::addRecord (zoneName, RealtimeTracerState::Phase::end);
+}
+
+void RealtimeTracer::addMarker (const char* markerName) noexcept
+{
+    RealtimeTracerState::addRecord (markerName, RealtimeTracerState::Phase::marker);
+}
+
+//==============================================================================
+void RealtimeTracer::writeChromeTraceFormat (OutputStream& output)
+{
+    using namespace RealtimeTracerState;
+
+    // stop the capture before exporting it
+    jassert (! isCapturing());
+
+    const ScopedLock sl (setupLock);
+
+    auto escape = [] (const char* text)
+    {
+        return String (CharPointer_UTF8 (text))
+                .replace ("\\", "\\\\")
+                .replace ("\"", "\\\"");
+    };
+
+    output << "{\"traceEvents\":[";
+    bool isFirstEvent = true;
+
+    auto numRings = jmin (numClaimedRings.load(), rings.size());
+
+    for (int ringIndex = 0; ringIndex < numRings; ++ringIndex)
+    {
+        auto& ring = *rings.getUnchecked (ringIndex);
+        auto writePos = ring.writePos.load (std::memory_order_acquire);
+        auto numRecords = (uint64) jmin ((int64) writePos, (int64) ring.capacity);
+
+        for (uint64 i = writePos - numRecords; i < writePos; ++i)
+        {
+            auto& record = ring.records[(size_t) (i % (uint64) ring.capacity)];
+            auto microseconds = Time::highResolutionTicksToSeconds (record.ticks) * 1.0e6;
+
+            const char* phase = record.phase == Phase::begin ? "B"
+                              : record.phase == Phase::end   ? "E" : "i";
+
+            if (! isFirstEvent)
+                output << ",";
+
+            isFirstEvent = false;
+
+            output << "\n{\"name\":\"" << escape (record.name)
+                   << "\",\"cat\":\"audio\",\"ph\":\"" << phase
+                   << "\",\"ts\":" << String (microseconds, 3)
+                   << ",\"pid\":1,\"tid\":" << (ringIndex + 1);
+
+            if (record.phase == Phase::marker)
+                output << ",\"s\":\"t\"";
+
+            output << "}";
+        }
+    }
+
+    output << "\n]}\n";
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct RealtimeTracerTest  : public UnitTest
+{
+    RealtimeTracerTest()
+        : UnitTest ("RealtimeTracer", UnitTestCategories::audio)
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest ("Zones are recorded and exported in chrome tracing format");
+        {
+            RealtimeTracer::startCapture (64, 2);
+
+            {
+                RealtimeTracer::ScopedZone outer ("outerZone");
+                RealtimeTracer::addMarker ("someMarker");
+
+                RealtimeTracer::ScopedZone inner ("innerZone");
+            }
+
+            RealtimeTracer::stopCapture();
+
+            MemoryOutputStream out;
+            RealtimeTracer::writeChromeTraceFormat (out);
+            auto json = out.toString();
+
+            expect (json.startsWith ("{\"traceEvents\":["));
+            expect (json.contains ("\"name\":\"outerZone\",\"cat\":\"audio\",\"ph\":\"B\""));
+            expect (json.contains ("\"name\":\"outerZone\",\"cat\":\"audio\",\"ph\":\"E\""));
+            expect (json.contains ("\"name\":\"innerZone\",\"cat\":\"audio\",\"ph\":\"B\""));
+            expect (json.contains ("\"name\":\"someMarker\",\"cat\":\"audio\",\"ph\":\"i\""));
+
+            // nothing should be recorded once the capture has stopped
+            RealtimeTracer::addMarker ("afterStop");
+
+            MemoryOutputStream out2;
+            RealtimeTracer::writeChromeTraceFormat (out2);
+            expect (! out2.toString().contains ("afterStop"));
+        }
+
+        beginTest ("The ring keeps the most recent events when it wraps");
+        {
+            RealtimeTracer::startCapture (8, 1);
+
+            for (int i = 0; i < 100; ++i)
+            {
+                RealtimeTracer::ScopedZone zone (i < 96 ? "earlyZone" : "lateZone");
+            }
+
+            RealtimeTracer::stopCapture();
+
+            MemoryOutputStream out;
+            RealtimeTracer::writeChromeTraceFormat (out);
+            auto json = out.toString();
+
+            expect (json.contains ("lateZone"));
+            expect (! json.contains ("earlyZone"));
+        }
+    }
+};
+
+static RealtimeTracerTest realtimeTracerTest;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A real-time-safe tracing facility for finding out where the time goes
+    inside an audio callback.
+
+    AudioProcessLoadMeasurer tells you that a deadline was missed, but not which
+    part of the callback was responsible. This class lets you mark up sections of
+    real-time code with named zones: each begin/end writes a fixed-size record
+    into a preallocated per-thread ring buffer, so marking a zone is wait-free,
+    takes a few dozen nanoseconds, and never allocates, locks or blocks. When a
+    capture is stopped, the recorded zones can be written out in the JSON format
+    understood by chrome://tracing (and compatible viewers such as Perfetto) to
+    see a timeline of every zone on every audio thread.
+
+    Zones are cheap enough to leave compiled into production builds - when no
+    capture is running, begin/end is a single atomic load.
+
+    e.g.
+    @code
+    void processBlock (AudioBuffer<float>& buffer, MidiBuffer& midi) override
+    {
+        RealtimeTracer::ScopedZone zone ("MySynth::processBlock");
+
+        {
+            RealtimeTracer::ScopedZone filterZone ("filters");
+            runFilters (buffer);
+        }
+        ...
+    }
+    @endcode
+
+    AudioProcessorGraph node rendering and dsp::ProcessorChain stages already
+    contain built-in zones, and AudioProcessLoadMeasurer emits an "xrun" marker
+    whenever it detects an overrun, so a capture of a graph-based app attributes
+    deadline misses to specific processors without any further markup.
+
+    Note that zone names are captured as raw pointers, so they must outlive the
+    capture - string literals, or strings owned by an object that lives longer
+    than the capture, are fine.
+
+    @see AudioProcessLoadMeasurer
+
+    @tags{Audio}
+*/
+class JUCE_API  RealtimeTracer
+{
+public:
+    //==============================================================================
+    /** Starts a capture, preallocating all the storage it will use.
+
+        Each thread that emits zones gets its own ring of maxEventsPerThread
+        fixed-size records; when a ring fills up it wraps, keeping the most
+        recent events. This isn't real-time-safe - call it from a normal thread
+        before the section you want to profile.
+
+        @param maxEventsPerThread   the ring capacity, in begin/end/marker records
+        @param maxThreads           the number of threads that can emit zones -
+                                    events from any further threads are dropped
+    */
+    static void startCapture (int maxEventsPerThread = 16384, int maxThreads = 16);
+
+    /** Stops capturing.
+
+        The records stay available for export until the next startCapture().
+        Before exporting, make sure that any real-time callbacks which might
+        still be inside a zone have finished.
+    */
+    static void stopCapture() noexcept;
+
+    /** Returns true if a capture is currently running. */
+    static bool isCapturing() noexcept;
+
+    //==============================================================================
+    /** Marks the start of a named zone on the calling thread.
+
+        Real-time-safe. The name pointer is stored, not copied, so it must
+        remain valid for the lifetime of the capture.
+    */
+    static void beginZone (const char* zoneName) noexcept;
+
+    /** Marks the end of the most recently begun zone on the calling thread. */
+    static void endZone (const char* zoneName) noexcept;
+
+    /** Records an instantaneous named marker - useful for one-off events like
+        an xrun or a parameter flush. Real-time-safe.
+    */
+    static void addMarker (const char* markerName) noexcept;
+
+    //==============================================================================
+    /** Marks the duration of a scope as a named zone, using RAII. */
+    struct JUCE_API  ScopedZone
+    {
+        explicit ScopedZone (const char* staticZoneName) noexcept  : name (staticZoneName)   { beginZone (name); }
+        ~ScopedZone() noexcept                                                               { endZone (name); }
+
+    private:
+        const char* name;
+        JUCE_DECLARE_NON_COPYABLE (ScopedZone)
+    };
+
+    //==============================================================================
+    /** Writes everything recorded by the last capture to a stream, in the
+        chrome://tracing JSON format.
+
+        Load the result via chrome://tracing or https://ui.perfetto.dev to view
+        the timeline. Call this after stopCapture(); the export itself isn't
+        real-time-safe. Because the rings keep the most recent events, the start
+        of the trace may contain unmatched zone-end records, which the viewers
+        tolerate.
+    */
+    static void writeChromeTraceFormat (OutputStream& output);
+
+private:
+    RealtimeTracer() = delete;
+};
+
+} // namespace juce
@@ -94,16 +94,19 @@ public:
         const int stereoSpread = 23;
         const int intSampleRate = (int) sampleRate;
 
-        for (int i = 0; i < numCombs; ++i)
+        for (int ch = 0; ch < numChannels; ++ch)
         {
-            comb[0][i].setSize ((intSampleRate * combTunings[i]) / 44100);
-            comb[1][i].setSize ((intSampleRate * (combTunings[i] + stereoSpread)) / 44100);
-        }
+            const int spread = ch * stereoSpread;
+            int combSizes[numCombs], allPassSizes[numAllPasses];
 
-        for (int i = 0; i < numAllPasses; ++i)
-        {
-            allPass[0][i].setSize ((intSampleRate * allPassTunings[i]) / 44100);
-            allPass[1][i].setSize ((intSampleRate * (allPassTunings[i] + stereoSpread)) / 44100);
+            for (int i = 0; i < numCombs; ++i)
+                combSizes[i] = (intSampleRate * (combTunings[i] + spread)) / 44100;
+
+            for (int i = 0; i < numAllPasses; ++i)
+                allPassSizes[i] = (intSampleRate * (allPassTunings[i] + spread)) / 44100;
+
+            combs[ch].setSizes (combSizes);
+            allPasses[ch].setSizes (allPassSizes);
         }
 
         const double smoothTime = 0.01;
@@ -117,13 +120,10 @@ public:
     /** Clears the reverb's buffers. */
     void reset()
     {
-        for (int j = 0; j < numChannels; ++j)
+        for (int ch = 0; ch < numChannels; ++ch)
         {
-            for (int i = 0; i < numCombs; ++i)
-                comb[j][i].clear();
-
-            for (int i = 0; i < numAllPasses; ++i)
-                allPass[j][i].clear();
+            combs[ch].clear();
+            allPasses[ch].clear();
         }
     }
 
@@ -134,32 +134,34 @@ public:
         JUCE_BEGIN_IGNORE_WARNINGS_MSVC (6011)
         jassert (left != nullptr && right != nullptr);
 
-        for (int i = 0; i < numSamples; ++i)
+        for (int start = 0; start < numSamples; start += maxChunkSize)
         {
-            const float input = (left[i] + right[i]) * gain;
-            float outL = 0, outR = 0;
+            const int numToDo = jmin ((int) maxChunkSize, numSamples - start);
+            float input[maxChunkSize], outL[maxChunkSize], outR[maxChunkSize];
+            float damp[maxChunkSize], feedbck[maxChunkSize];
+            float dry[maxChunkSize], wet1[maxChunkSize], wet2[maxChunkSize];
 
-            const float damp    = damping.getNextValue();
-            const float feedbck = feedback.getNextValue();
-
-            for (int j = 0; j < numCombs; ++j)  // accumulate the comb filters in parallel
+            for (int i = 0; i < numToDo; ++i)
             {
-                outL += comb[0][j].process (input, damp, feedbck);
-                outR += comb[1][j].process (input, damp, feedbck);
+                input[i]   = (left[start + i] + right[start + i]) * gain;
+                damp[i]    = damping.getNextValue();
+                feedbck[i] = feedback.getNextValue();
+                dry[i]     = dryGain.getNextValue();
+                wet1[i]    = wetGain1.getNextValue();
+                wet2[i]    = wetGain2.getNextValue();
             }
 
-            for (int j = 0; j < numAllPasses; ++j)  // run the allpass filters in series
-            {
-                outL = allPass[0][j].process (outL);
-                outR = allPass[1][j].process (outR);
-            }
+            combs[0].processBlock (input, outL, numToDo, damp, feedbck);
+            combs[1].processBlock (input, outR, numToDo, damp, feedbck);
 
-            const float dry  = dryGain.getNextValue();
-            const float wet1 = wetGain1.getNextValue();
-            const float wet2 = wetGain2.getNextValue();
+            allPasses[0].processBlock (outL, numToDo);
+            allPasses[1].processBlock (outR, numToDo);
 
-            left[i]  = outL * wet1 + outR * wet2 + left[i]  * dry;
-            right[i] = outR * wet1 + outL * wet2 + right[i] * dry;
+            for (int i = 0; i < numToDo; ++i)
+            {
+                left[start + i]  = outL[i] * wet1[i] + outR[i] * wet2[i] + left[start + i]  * dry[i];
+                right[start + i] = outR[i] * wet1[i] + outL[i] * wet2[i] + right[start + i] * dry[i];
+            }
         }
         JUCE_END_IGNORE_WARNINGS_MSVC
     }
@@ -170,24 +172,27 @@ public:
         JUCE_BEGIN_IGNORE_WARNINGS_MSVC (6011)
         jassert (samples != nullptr);
 
-        for (int i = 0; i < numSamples; ++i)
+        for (int start = 0; start < numSamples; start += maxChunkSize)
         {
-            const float input = samples[i] * gain;
-            float output = 0;
-
-            const float damp    = damping.getNextValue();
-            const float feedbck = feedback.getNextValue();
+            const int numToDo = jmin ((int) maxChunkSize, numSamples - start);
+            float input[maxChunkSize], output[maxChunkSize];
+            float damp[maxChunkSize], feedbck[maxChunkSize];
+            float dry[maxChunkSize], wet1[maxChunkSize];
 
-            for (int j = 0; j < numCombs; ++j)  // accumulate the comb filters in parallel
-                output += comb[0][j].process (input, damp, feedbck);
-
-            for (int j = 0; j < numAllPasses; ++j)  // run the allpass filters in series
-                output = allPass[0][j].process (output);
+            for (int i = 0; i < numToDo; ++i)
+            {
+                input[i]   = samples[start + i] * gain;
+                damp[i]    = damping.getNextValue();
+                feedbck[i] = feedback.getNextValue();
+                dry[i]     = dryGain.getNextValue();
+                wet1[i]    = wetGain1.getNextValue();
+            }
 
-            const float dry  = dryGain.getNextValue();
-            const float wet1 = wetGain1.getNextValue();
+            combs[0].processBlock (input, output, numToDo, damp, feedbck);
+            allPasses[0].processBlock (output, numToDo);
 
-            samples[i] = output * wet1 + samples[i] * dry;
+            for (int i = 0; i < numToDo; ++i)
+                samples[start + i] = output[i] * wet1[i] + samples[start + i] * dry[i];
         }
         JUCE_END_IGNORE_WARNINGS_MSVC
     }
@@ -216,98 +221,165 @@ private:
     }
 
     //==============================================================================
-    class CombFilter
+    enum { numCombs = 8, numAllPasses = 4, numChannels = 2, maxChunkSize = 64 };
+
+    //==============================================================================
+    /** A bank of parallel comb filters sharing one delay allocation, with the
+        filter state held in per-lane arrays so that the fused damping/feedback
+        maths in the inner loop can be vectorised across the whole bank.
+    */
+    class CombBank
     {
     public:
-        CombFilter() noexcept {}
+        CombBank() noexcept {}
 
-        void setSize (const int size)
+        void setSizes (const int* newSizes)
         {
-            if (size != bufferSize)
+            totalSize = 0;
+
+            for (int j = 0; j < numCombs; ++j)
             {
-                bufferIndex = 0;
-                buffer.malloc (size);
-                bufferSize = size;
+                offsets[j] = totalSize;
+                sizes[j] = newSizes[j];
+                totalSize += newSizes[j];
             }
 
+            buffer.malloc (totalSize);
             clear();
         }
 
         void clear() noexcept
         {
-            last = 0;
-            buffer.clear ((size_t) bufferSize);
+            buffer.clear ((size_t) totalSize);
+
+            for (int j = 0; j < numCombs; ++j)
+            {
+                indices[j] = 0;
+                lasts[j] = 0.0f;
+            }
         }
 
-        float process (const float input, const float damp, const float feedbackLevel) noexcept
+        void processBlock (const float* input, float* output, const int numSamples,
+                           const float* damp, const float* feedbackLevel) noexcept
         {
-            const float output = buffer[bufferIndex];
-            last = (output * (1.0f - damp)) + (last * damp);
-            JUCE_UNDENORMALISE (last);
-
-            float temp = input + (last * feedbackLevel);
-            JUCE_UNDENORMALISE (temp);
-            buffer[bufferIndex] = temp;
-            bufferIndex = (bufferIndex + 1) % bufferSize;
-            return output;
+            for (int i = 0; i < numSamples; ++i)
+            {
+                float out[numCombs], pushed[numCombs];
+
+                for (int j = 0; j < numCombs; ++j)  // gather the delay-line heads
+                    out[j] = buffer[offsets[j] + indices[j]];
+
+                const float d = damp[i];
+                const float oneMinusDamp = 1.0f - d;
+                const float fb = feedbackLevel[i];
+                const float in = input[i];
+
+                for (int j = 0; j < numCombs; ++j)  // fused damping/feedback, one comb per lane
+                {
+                    float filtered = out[j] * oneMinusDamp + lasts[j] * d;
+                    JUCE_UNDENORMALISE (filtered);
+                    lasts[j] = filtered;
+
+                    float temp = in + filtered * fb;
+                    JUCE_UNDENORMALISE (temp);
+                    pushed[j] = temp;
+                }
+
+                float sum = 0.0f;
+
+                for (int j = 0; j < numCombs; ++j)  // scatter back and advance
+                {
+                    buffer[offsets[j] + indices[j]] = pushed[j];
+
+                    if (++indices[j] >= sizes[j])
+                        indices[j] = 0;
+
+                    sum += out[j];
+                }
+
+                output[i] = sum;
+            }
         }
 
     private:
         HeapBlock<float> buffer;
-        int bufferSize = 0, bufferIndex = 0;
-        float last = 0.0f;
+        int offsets[numCombs], sizes[numCombs], indices[numCombs];
+        float lasts[numCombs];
+        int totalSize = 0;
 
-        JUCE_DECLARE_NON_COPYABLE (CombFilter)
+        JUCE_DECLARE_NON_COPYABLE (CombBank)
     };
 
     //==============================================================================
-    class AllPassFilter
+    /** The series allpass filters, sharing one delay allocation with per-lane
+        state. These can't run in parallel, but the bank layout keeps the state
+        in cache and avoids a modulo per sample.
+    */
+    class AllPassBank
     {
     public:
-        AllPassFilter() noexcept {}
+        AllPassBank() noexcept {}
 
-        void setSize (const int size)
+        void setSizes (const int* newSizes)
         {
-            if (size != bufferSize)
+            totalSize = 0;
+
+            for (int j = 0; j < numAllPasses; ++j)
             {
-                bufferIndex = 0;
-                buffer.malloc (size);
-                bufferSize = size;
+                offsets[j] = totalSize;
+                sizes[j] = newSizes[j];
+                totalSize += newSizes[j];
             }
 
+            buffer.malloc (totalSize);
             clear();
         }
 
         void clear() noexcept
         {
-            buffer.clear ((size_t) bufferSize);
+            buffer.clear ((size_t) totalSize);
+
+            for (int j = 0; j < numAllPasses; ++j)
+                indices[j] = 0;
         }
 
-        float process (const float input) noexcept
+        void processBlock (float* samples, const int numSamples) noexcept
         {
-            const float bufferedValue = buffer [bufferIndex];
-            float temp = input + (bufferedValue * 0.5f);
-            JUCE_UNDENORMALISE (temp);
-            buffer [bufferIndex] = temp;
-            bufferIndex = (bufferIndex + 1) % bufferSize;
-            return bufferedValue - input;
+            for (int i = 0; i < numSamples; ++i)
+            {
+                float v = samples[i];
+
+                for (int j = 0; j < numAllPasses; ++j)
+                {
+                    const float bufferedValue = buffer[offsets[j] + indices[j]];
+                    float temp = v + bufferedValue * 0.5f;
+                    JUCE_UNDENORMALISE (temp);
+                    buffer[offsets[j] + indices[j]] = temp;
+
+                    if (++indices[j] >= sizes[j])
+                        indices[j] = 0;
+
+                    v = bufferedValue - v;
+                }
+
+                samples[i] = v;
+            }
         }
 
     private:
         HeapBlock<float> buffer;
-        int bufferSize = 0, bufferIndex = 0;
+        int offsets[numAllPasses], sizes[numAllPasses], indices[numAllPasses];
+        int totalSize = 0;
 
-        JUCE_DECLARE_NON_COPYABLE (AllPassFilter)
+        JUCE_DECLARE_NON_COPYABLE (AllPassBank)
     };
 
     //==============================================================================
-    enum { numCombs = 8, numAllPasses = 4, numChannels = 2 };
-
     Parameters parameters;
     float gain;
 
-    CombFilter comb [numChannels][numCombs];
-    AllPassFilter allPass [numChannels][numAllPasses];
+    CombBank combs [numChannels];
+    AllPassBank allPasses [numChannels];
 
     SmoothedValue<float> damping, feedback, dryGain, wetGain1, wetGain2;
 
@@ -0,0 +1,358 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct ReverbTests  : public UnitTest
+{
+    ReverbTests()  : UnitTest ("Reverb", UnitTestCategories::audio)  {}
+
+    //==============================================================================
+    /** A straight scalar implementation of the original FreeVerb-style algorithm,
+        with one filter object per comb/allpass, kept here as the reference that
+        the bank-structured engine in Reverb must match.
+    */
+    struct ReferenceReverb
+    {
+        ReferenceReverb()
+        {
+            setParameters (Reverb::Parameters());
+            setSampleRate (44100.0);
+        }
+
+        void setParameters (const Reverb::Parameters& newParams)
+        {
+            const float wetScaleFactor = 3.0f;
+            const float dryScaleFactor = 2.0f;
+
+            const float wet = newParams.wetLevel * wetScaleFactor;
+            dryGain.setTargetValue (newParams.dryLevel * dryScaleFactor);
+            wetGain1.setTargetValue (0.5f * wet * (1.0f + newParams.width));
+            wetGain2.setTargetValue (0.5f * wet * (1.0f - newParams.width));
+
+            gain = newParams.freezeMode >= 0.5f ? 0.0f : 0.015f;
+
+            if (newParams.freezeMode >= 0.5f)
+            {
+                damping.setTargetValue (0.0f);
+                feedback.setTargetValue (1.0f);
+            }
+            else
+            {
+                damping.setTargetValue (newParams.damping * 0.4f);
+                feedback.setTargetValue (newParams.roomSize * 0.28f + 0.7f);
+            }
+        }
+
+        void setSampleRate (const double sampleRate)
+        {
+            static const short combTunings[] = { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 };
+            static const short allPassTunings[] = { 556, 441, 341, 225 };
+            const int stereoSpread = 23;
+            const int intSampleRate = (int) sampleRate;
+
+            for (int i = 0; i < numCombs; ++i)
+            {
+                comb[0][i].setSize ((intSampleRate * combTunings[i]) / 44100);
+                comb[1][i].setSize ((intSampleRate * (combTunings[i] + stereoSpread)) / 44100);
+            }
+
+            for (int i = 0; i < numAllPasses; ++i)
+            {
+                allPass[0][i].setSize ((intSampleRate * allPassTunings[i]) / 44100);
+                allPass[1][i].setSize ((intSampleRate * (allPassTunings[i] + stereoSpread)) / 44100);
+            }
+
+            const double smoothTime = 0.01;
+            damping .reset (sampleRate, smoothTime);
+            feedback.reset (sampleRate, smoothTime);
+            dryGain .reset (sampleRate, smoothTime);
+            wetGain1.reset (sampleRate, smoothTime);
+            wetGain2.reset (sampleRate, smoothTime);
+        }
+
+        void processStereo (float* left, float* right, int numSamples) noexcept
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float input = (left[i] + right[i]) * gain;
+                float outL = 0, outR = 0;
+
+                const float damp    = damping.getNextValue();
+                const float feedbck = feedback.getNextValue();
+
+                for (int j = 0; j < numCombs; ++j)
+                {
+                    outL += comb[0][j].process (input, damp, feedbck);
+                    outR += comb[1][j].process (input, damp, feedbck);
+                }
+
+                for (int j = 0; j < numAllPasses; ++j)
+                {
+                    outL = allPass[0][j].process (outL);
+                    outR = allPass[1][j].process (outR);
+                }
+
+                const float dry  = dryGain.getNextValue();
+                const float wet1 = wetGain1.getNextValue();
+                const float wet2 = wetGain2.getNextValue();
+
+                left[i]  = outL * wet1 + outR * wet2 + left[i]  * dry;
+                right[i] = outR * wet1 + outL * wet2 + right[i] * dry;
+            }
+        }
+
+        void processMono (float* samples, int numSamples) noexcept
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float input = samples[i] * gain;
+                float output = 0;
+
+                const float damp    = damping.getNextValue();
+                const float feedbck = feedback.getNextValue();
+
+                for (int j = 0; j < numCombs; ++j)
+                    output += comb[0][j].process (input, damp, feedbck);
+
+                for (int j = 0; j < numAllPasses; ++j)
+                    output = allPass[0][j].process (output);
+
+                const float dry  = dryGain.getNextValue();
+                const float wet1 = wetGain1.getNextValue();
+
+                samples[i] = output * wet1 + samples[i] * dry;
+            }
+        }
+
+        struct CombFilter
+        {
+            void setSize (int size)
+            {
+                buffer.calloc (size);
+                bufferSize = size;
+                bufferIndex = 0;
+                last = 0;
+            }
+
+            float process (float input, float damp, float feedbackLevel) noexcept
+            {
+                const float output = buffer[bufferIndex];
+                last = (output * (1.0f - damp)) + (last * damp);
+                JUCE_UNDENORMALISE (last);
+
+                float temp = input + (last * feedbackLevel);
+                JUCE_UNDENORMALISE (temp);
+                buffer[bufferIndex] = temp;
+                bufferIndex = (bufferIndex + 1) % bufferSize;
+                return output;
+            }
+
+            HeapBlock<float> buffer;
+            int bufferSize = 0, bufferIndex = 0;
+            float last = 0.0f;
+        };
+
+        struct AllPassFilter
+        {
+            void setSize (int size)
+            {
+                buffer.calloc (size);
+                bufferSize = size;
+                bufferIndex = 0;
+            }
+
+            float process (float input) noexcept
+            {
+                const float bufferedValue = buffer[bufferIndex];
+                float temp = input + (bufferedValue * 0.5f);
+                JUCE_UNDENORMALISE (temp);
+                buffer[bufferIndex] = temp;
+                bufferIndex = (bufferIndex + 1) % bufferSize;
+                return bufferedValue - input;
+            }
+
+            HeapBlock<float> buffer;
+            int bufferSize = 0, bufferIndex = 0;
+        };
+
+        enum { numCombs = 8, numAllPasses = 4 };
+
+        float gain;
+        CombFilter comb [2][numCombs];
+        AllPassFilter allPass [2][numAllPasses];
+        SmoothedValue<float> damping, feedback, dryGain, wetGain1, wetGain2;
+    };
+
+    //==============================================================================
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        const auto fillRandom = [&random] (Array<float>& buffer, int size)
+        {
+            buffer.clearQuick();
+
+            for (int i = 0; i < size; ++i)
+                buffer.add (random.nextFloat() * 2.0f - 1.0f);
+        };
+
+        const auto maxDifference = [] (const Array<float>& a, const Array<float>& b)
+        {
+            float diff = 0;
+
+            for (int i = 0; i < a.size(); ++i)
+                diff = jmax (diff, std::abs (a[i] - b[i]));
+
+            return diff;
+        };
+
+        const auto checkStereoMatches = [&] (const Reverb::Parameters& params, double sampleRate)
+        {
+            Reverb reverb;
+            ReferenceReverb reference;
+
+            reverb.setParameters (params);
+            reference.setParameters (params);
+            reverb.setSampleRate (sampleRate);
+            reference.setSampleRate (sampleRate);
+
+            Array<float> left, right, refLeft, refRight;
+
+            for (int block = 0; block < 20; ++block)
+            {
+                const auto numSamples = 1 + random.nextInt (512);
+
+                fillRandom (left, numSamples);
+                fillRandom (right, numSamples);
+                refLeft = left;
+                refRight = right;
+
+                reverb.processStereo (left.getRawDataPointer(), right.getRawDataPointer(), numSamples);
+                reference.processStereo (refLeft.getRawDataPointer(), refRight.getRawDataPointer(), numSamples);
+
+                expect (maxDifference (left, refLeft) < 1.0e-5f);
+                expect (maxDifference (right, refRight) < 1.0e-5f);
+            }
+        };
+
+        beginTest ("Stereo output matches the reference algorithm");
+        {
+            checkStereoMatches ({}, 44100.0);
+        }
+
+        beginTest ("Stereo output matches the reference for various parameters and rates");
+        {
+            checkStereoMatches ({ 1.0f, 0.0f, 1.0f, 0.0f, 0.25f, 0.0f }, 48000.0);
+            checkStereoMatches ({ 0.1f, 0.9f, 0.5f, 0.5f, 0.0f,  0.0f }, 96000.0);
+            checkStereoMatches ({ 0.8f, 0.2f, 0.7f, 0.3f, 1.0f,  1.0f }, 22050.0);
+        }
+
+        beginTest ("Mono output matches the reference algorithm");
+        {
+            Reverb reverb;
+            ReferenceReverb reference;
+
+            Array<float> samples, refSamples;
+
+            for (int block = 0; block < 20; ++block)
+            {
+                const auto numSamples = 1 + random.nextInt (512);
+
+                fillRandom (samples, numSamples);
+                refSamples = samples;
+
+                reverb.processMono (samples.getRawDataPointer(), numSamples);
+                reference.processMono (refSamples.getRawDataPointer(), numSamples);
+
+                expect (maxDifference (samples, refSamples) < 1.0e-5f);
+            }
+        }
+
+        beginTest ("Parameter changes mid-stream track the reference");
+        {
+            Reverb reverb;
+            ReferenceReverb reference;
+
+            Array<float> left, right, refLeft, refRight;
+
+            for (int block = 0; block < 10; ++block)
+            {
+                Reverb::Parameters params { random.nextFloat(), random.nextFloat(),
+                                            random.nextFloat(), random.nextFloat(),
+                                            random.nextFloat(), 0.0f };
+                reverb.setParameters (params);
+                reference.setParameters (params);
+
+                const auto numSamples = 1 + random.nextInt (300);
+
+                fillRandom (left, numSamples);
+                fillRandom (right, numSamples);
+                refLeft = left;
+                refRight = right;
+
+                reverb.processStereo (left.getRawDataPointer(), right.getRawDataPointer(), numSamples);
+                reference.processStereo (refLeft.getRawDataPointer(), refRight.getRawDataPointer(), numSamples);
+
+                expect (maxDifference (left, refLeft) < 1.0e-5f);
+                expect (maxDifference (right, refRight) < 1.0e-5f);
+            }
+        }
+
+        beginTest ("reset() clears the reverb tail");
+        {
+            Reverb reverb;
+
+            Array<float> left, right;
+            fillRandom (left, 512);
+            fillRandom (right, 512);
+            reverb.processStereo (left.getRawDataPointer(), right.getRawDataPointer(), 512);
+
+            reverb.reset();
+
+            Reverb::Parameters silentDry;
+            silentDry.dryLevel = 0.0f;
+            reverb.setParameters (silentDry);
+
+            // After a reset, processing silence should produce (almost) nothing but the
+            // parameter smoothers settling.
+            left.clearQuick();
+            right.clearQuick();
+            left.insertMultiple (0, 0.0f, 512);
+            right.insertMultiple (0, 0.0f, 512);
+
+            reverb.processStereo (left.getRawDataPointer(), right.getRawDataPointer(), 512);
+
+            float maxLevel = 0;
+
+            for (int i = 0; i < 512; ++i)
+                maxLevel = jmax (maxLevel, std::abs (left[i]), std::abs (right[i]));
+
+            expect (maxLevel < 1.0e-3f);
+        }
+    }
+};
+
+static ReverbTests reverbTests;
+
+} // namespace juce
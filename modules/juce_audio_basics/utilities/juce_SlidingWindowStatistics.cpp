@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+SlidingWindowStatistics::SlidingWindowStatistics() = default;
+SlidingWindowStatistics::~SlidingWindowStatistics() = default;
+
+void SlidingWindowStatistics::reset (int windowLengthInSamples)
+{
+    jassert (windowLengthInSamples > 0);
+
+    windowLength = jmax (1, windowLengthInSamples);
+    window.malloc (windowLength);
+    peakQueue.malloc (windowLength);
+
+    clear();
+}
+
+void SlidingWindowStatistics::clear() noexcept
+{
+    sumOfSquares = 0.0;
+    numPushed = 0;
+    queueHead = 0;
+    queueTail = 0;
+    numInWindow = 0;
+    samplesUntilResync = windowLength;
+}
+
+void SlidingWindowStatistics::advance (float newSample) noexcept
+{
+    jassert (windowLength > 0); // must call reset() first!
+
+    auto absValue = std::abs (newSample);
+    auto slot = (int) (numPushed % windowLength);
+
+    // Retire the sample falling out of the window before overwriting its slot
+    if (numInWindow == windowLength)
+    {
+        auto outgoing = window[slot];
+        sumOfSquares -= (double) outgoing * outgoing;
+    }
+    else
+    {
+        ++numInWindow;
+    }
+
+    window[slot] = absValue;
+    sumOfSquares += (double) absValue * absValue;
+
+    // Expire peak candidates that have left the window, then any that the
+    // new sample supersedes - each index joins and leaves the queue once,
+    // so the cost is O(1) amortised
+    if (queueHead < queueTail && peakQueue[queueHead % windowLength] <= numPushed - windowLength)
+        ++queueHead;
+
+    while (queueHead < queueTail && window[peakQueue[(queueTail - 1) % windowLength] % windowLength] <= absValue)
+        --queueTail;
+
+    peakQueue[queueTail % windowLength] = numPushed;
+    ++queueTail;
+    ++numPushed;
+
+    // Running subtraction slowly accumulates rounding error, so recompute
+    // the sum exactly once per window's worth of samples
+    if (--samplesUntilResync <= 0)
+        resyncSumOfSquares();
+}
+
+void SlidingWindowStatistics::advance (const float* samples, int numSamples) noexcept
+{
+    for (int i = 0; i < numSamples; ++i)
+        advance (samples[i]);
+}
+
+float SlidingWindowStatistics::getMagnitude() const noexcept
+{
+    if (queueHead == queueTail)
+        return 0.0f;
+
+    return window[peakQueue[queueHead % windowLength] % windowLength];
+}
+
+float SlidingWindowStatistics::getRMSLevel() const noexcept
+{
+    if (numInWindow == 0)
+        return 0.0f;
+
+    return (float) std::sqrt (jmax (0.0, sumOfSquares) / numInWindow);
+}
+
+void SlidingWindowStatistics::resyncSumOfSquares() noexcept
+{
+    double sum0 = 0.0, sum1 = 0.0;
+    int i = 0;
+
+    for (; i <= numInWindow - 2; i += 2)
+    {
+        sum0 += (double) window[i]     * window[i];
+        sum1 += (double) window[i + 1] * window[i + 1];
+    }
+
+    if (i < numInWindow)
+        sum0 += (double) window[i] * window[i];
+
+    sumOfSquares = sum0 + sum1;
+    samplesUntilResync = windowLength;
+}
+
+} // namespace juce
@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Maintains the peak and RMS level of a sliding window over a sample stream,
+    updating both in constant time per sample.
+
+    AudioBuffer::getMagnitude() and getRMSLevel() rescan their whole range on
+    every call, which makes loudness analysis over overlapping windows cost
+    O(n * windowLength). This class instead advances one sample at a time: the
+    RMS is kept as a running sum of squares, and the peak with a monotonic
+    queue, so scanning a long file with a hopping window is linear in its
+    length no matter how much the windows overlap.
+
+    Feed it one channel; keep one instance per channel for multichannel
+    analysis. advance() never allocates, so after reset() it is safe to call
+    from the audio thread.
+
+    @see AudioBuffer::getMagnitude, AudioBuffer::getRMSLevel, LevelMeterTap
+
+    @tags{Audio}
+*/
+class JUCE_API  SlidingWindowStatistics
+{
+public:
+    //==============================================================================
+    /** Creates an empty object - call reset() to give it a window length. */
+    SlidingWindowStatistics();
+
+    /** Destructor. */
+    ~SlidingWindowStatistics();
+
+    //==============================================================================
+    /** Sets the window length and clears the state.
+        This allocates, so don't call it from the audio thread.
+    */
+    void reset (int windowLengthInSamples);
+
+    /** Empties the window without changing its length or reallocating. */
+    void clear() noexcept;
+
+    /** Returns the window length set by reset(), or 0 if unprepared. */
+    int getWindowLength() const noexcept            { return windowLength; }
+
+    /** Returns how many samples the window currently holds.
+        This ramps up from 0 to the window length as the first samples arrive.
+    */
+    int getNumSamplesInWindow() const noexcept      { return numInWindow; }
+
+    //==============================================================================
+    /** Pushes one sample into the window, dropping the oldest if it's full. */
+    void advance (float newSample) noexcept;
+
+    /** Pushes a block of samples into the window. */
+    void advance (const float* samples, int numSamples) noexcept;
+
+    //==============================================================================
+    /** Returns the highest absolute sample value currently in the window. */
+    float getMagnitude() const noexcept;
+
+    /** Returns the RMS level of the samples currently in the window. */
+    float getRMSLevel() const noexcept;
+
+private:
+    //==============================================================================
+    HeapBlock<float> window;       // absolute values, circular
+    HeapBlock<int64> peakQueue;    // indices of candidate peaks, decreasing in value
+    double sumOfSquares = 0.0;
+    int64 numPushed = 0, queueHead = 0, queueTail = 0;
+    int windowLength = 0, numInWindow = 0, samplesUntilResync = 0;
+
+    void resyncSumOfSquares() noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SlidingWindowStatistics)
+};
+
+} // namespace juce
@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct SlidingWindowStatisticsTests  : public UnitTest
+{
+    SlidingWindowStatisticsTests()  : UnitTest ("SlidingWindowStatistics", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        beginTest ("Sliding stats match a brute-force rescan at every position");
+        {
+            const int numSamples = 4000, windowLength = 147;
+
+            AudioBuffer<float> buffer (1, numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (0, i, random.nextFloat() * 2.0f - 1.0f);
+
+            SlidingWindowStatistics stats;
+            stats.reset (windowLength);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                stats.advance (buffer.getSample (0, i));
+
+                auto start = jmax (0, i + 1 - windowLength);
+                auto length = i + 1 - start;
+
+                expectEquals (stats.getNumSamplesInWindow(), length);
+                expectWithinAbsoluteError (stats.getMagnitude(), buffer.getMagnitude (0, start, length), 1.0e-6f);
+                expectWithinAbsoluteError (stats.getRMSLevel(), buffer.getRMSLevel (0, start, length), 1.0e-4f);
+            }
+        }
+
+        beginTest ("Block advance gives the same result as per-sample advance");
+        {
+            const int numSamples = 1000, windowLength = 64;
+
+            HeapBlock<float> data (numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+                data[i] = random.nextFloat() * 2.0f - 1.0f;
+
+            SlidingWindowStatistics perSample, perBlock;
+            perSample.reset (windowLength);
+            perBlock.reset (windowLength);
+
+            for (int i = 0; i < numSamples; ++i)
+                perSample.advance (data[i]);
+
+            perBlock.advance (data, numSamples);
+
+            expectEquals (perBlock.getMagnitude(), perSample.getMagnitude());
+            expectEquals (perBlock.getRMSLevel(), perSample.getRMSLevel());
+        }
+
+        beginTest ("The peak tracks both arrival and expiry of the loudest sample");
+        {
+            SlidingWindowStatistics stats;
+            stats.reset (4);
+
+            stats.advance (0.1f);
+            stats.advance (-0.9f);
+            stats.advance (0.2f);
+            expectWithinAbsoluteError (stats.getMagnitude(), 0.9f, 1.0e-6f);
+
+            stats.advance (0.3f);
+            stats.advance (0.4f);
+            expectWithinAbsoluteError (stats.getMagnitude(), 0.9f, 1.0e-6f);
+
+            stats.advance (0.05f);  // the -0.9 falls out of the window here
+            expectWithinAbsoluteError (stats.getMagnitude(), 0.4f, 1.0e-6f);
+        }
+
+        beginTest ("clear() empties the window without losing the length");
+        {
+            SlidingWindowStatistics stats;
+            stats.reset (32);
+
+            for (int i = 0; i < 100; ++i)
+                stats.advance (random.nextFloat());
+
+            stats.clear();
+            expectEquals (stats.getWindowLength(), 32);
+            expectEquals (stats.getNumSamplesInWindow(), 0);
+            expectEquals (stats.getMagnitude(), 0.0f);
+            expectEquals (stats.getRMSLevel(), 0.0f);
+
+            stats.advance (0.5f);
+            expectWithinAbsoluteError (stats.getMagnitude(), 0.5f, 1.0e-6f);
+        }
+
+        beginTest ("The running sum stays accurate over a long stream");
+        {
+            const int windowLength = 256;
+
+            SlidingWindowStatistics stats;
+            stats.reset (windowLength);
+
+            AudioBuffer<float> recent (1, windowLength);
+
+            for (int i = 0; i < 500000; ++i)
+            {
+                auto sample = random.nextFloat() * 2.0f - 1.0f;
+                stats.advance (sample);
+                recent.setSample (0, i % windowLength, sample);
+            }
+
+            expectWithinAbsoluteError (stats.getRMSLevel(), recent.getRMSLevel (0, 0, windowLength), 1.0e-4f);
+        }
+    }
+};
+
+static SlidingWindowStatisticsTests slidingWindowStatisticsTests;
+
+} // namespace juce
@@ -0,0 +1,281 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+SmoothedValueBank::SmoothedValueBank (int numberOfValues)
+{
+    setSize (numberOfValues);
+}
+
+void SmoothedValueBank::setSize (int numberOfValues)
+{
+    jassert (numberOfValues >= 0);
+
+    numValues = numberOfValues;
+    longestRemainingRamp = 0;
+
+    currentValues   .allocate ((size_t) numValues, true);
+    targetValues    .allocate ((size_t) numValues, true);
+    stepSizes       .allocate ((size_t) numValues, true);
+    samplesRemaining.allocate ((size_t) numValues, true);
+    scratch         .allocate ((size_t) numValues, true);
+
+    auto mailboxSize = jmax (minimumMailboxSize, numValues);
+    mailboxQueue.allocate ((size_t) mailboxSize, true);
+    mailbox.setTotalSize (mailboxSize);
+}
+
+void SmoothedValueBank::reset (double sampleRate, double rampLengthInSeconds) noexcept
+{
+    jassert (sampleRate > 0 && rampLengthInSeconds >= 0);
+    reset ((int) std::floor (rampLengthInSeconds * sampleRate));
+}
+
+void SmoothedValueBank::reset (int numSteps) noexcept
+{
+    stepsToTarget = numSteps;
+    longestRemainingRamp = 0;
+
+    FloatVectorOperations::copy (currentValues, targetValues, numValues);
+    FloatVectorOperations::clear (stepSizes, numValues);
+    FloatVectorOperations::clear (samplesRemaining, numValues);
+}
+
+void SmoothedValueBank::setCurrentAndTargetValue (int index, float newValue) noexcept
+{
+    jassert (isPositiveAndBelow (index, numValues));
+
+    currentValues[index] = newValue;
+    targetValues[index] = newValue;
+    stepSizes[index] = 0.0f;
+    samplesRemaining[index] = 0.0f;
+}
+
+void SmoothedValueBank::setTargetValue (int index, float newValue) noexcept
+{
+    jassert (isPositiveAndBelow (index, numValues));
+
+    if (newValue == targetValues[index])
+        return;
+
+    if (stepsToTarget <= 0)
+    {
+        setCurrentAndTargetValue (index, newValue);
+        return;
+    }
+
+    targetValues[index] = newValue;
+    stepSizes[index] = (newValue - currentValues[index]) / (float) stepsToTarget;
+    samplesRemaining[index] = (float) stepsToTarget;
+    longestRemainingRamp = jmax (longestRemainingRamp, stepsToTarget);
+}
+
+bool SmoothedValueBank::postTargetValue (int index, float newValue) noexcept
+{
+    jassert (isPositiveAndBelow (index, numValues));
+
+    int start1, size1, start2, size2;
+    mailbox.prepareToWrite (1, start1, size1, start2, size2);
+
+    if (size1 + size2 < 1)
+        return false;
+
+    mailboxQueue[start1] = { index, newValue };
+    mailbox.finishedWrite (1);
+    return true;
+}
+
+float SmoothedValueBank::getCurrentValue (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, numValues));
+    return currentValues[index];
+}
+
+float SmoothedValueBank::getTargetValue (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, numValues));
+    return targetValues[index];
+}
+
+void SmoothedValueBank::applyPendingTargetValues() noexcept
+{
+    auto numReady = mailbox.getNumReady();
+
+    if (numReady == 0)
+        return;
+
+    int start1, size1, start2, size2;
+    mailbox.prepareToRead (numReady, start1, size1, start2, size2);
+
+    for (int i = 0; i < size1 + size2; ++i)
+    {
+        const auto& update = mailboxQueue[i < size1 ? start1 + i
+                                                    : start2 + (i - size1)];
+
+        if (isPositiveAndBelow (update.index, numValues))
+            setTargetValue (update.index, update.value);
+    }
+
+    mailbox.finishedRead (size1 + size2);
+}
+
+void SmoothedValueBank::advance (int numSamples) noexcept
+{
+    applyPendingTargetValues();
+
+    if (numSamples <= 0 || longestRemainingRamp <= 0)
+        return;
+
+    // Each value moves by step * min (numSamples, samplesRemaining); deriving
+    // the new current value as target - step * samplesRemaining makes every
+    // ramp land exactly on its target, with no accumulated rounding error.
+    FloatVectorOperations::min (scratch, samplesRemaining, (float) numSamples, numValues);
+    FloatVectorOperations::subtract (samplesRemaining, scratch, numValues);
+    FloatVectorOperations::multiply (scratch, stepSizes, samplesRemaining, numValues);
+    FloatVectorOperations::subtract (currentValues, targetValues, scratch, numValues);
+
+    longestRemainingRamp = jmax (0, longestRemainingRamp - numSamples);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SmoothedValueBankTests  : public UnitTest
+{
+public:
+    SmoothedValueBankTests()
+        : UnitTest ("SmoothedValueBankTests", UnitTestCategories::smoothedValues)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Ramps match SmoothedValue");
+        {
+            SmoothedValue<float, ValueSmoothingTypes::Linear> sv;
+            sv.reset (12);
+            sv.setCurrentAndTargetValue (0.25f);
+            sv.setTargetValue (1.0f);
+
+            SmoothedValueBank bank (3);
+            bank.reset (12);
+            bank.setCurrentAndTargetValue (1, 0.25f);
+            bank.setTargetValue (1, 1.0f);
+
+            sv.skip (5);
+            bank.advance (5);
+            expectWithinAbsoluteError (bank.getCurrentValue (1), sv.getCurrentValue(), 1.0e-6f);
+
+            sv.skip (7);
+            bank.advance (7);
+            expectEquals (bank.getCurrentValue (1), 1.0f);
+            expectEquals (sv.getCurrentValue(), 1.0f);
+            expect (! bank.isSmoothing());
+
+            // The other values should have been left alone
+            expectEquals (bank.getCurrentValue (0), 0.0f);
+            expectEquals (bank.getCurrentValue (2), 0.0f);
+        }
+
+        beginTest ("Advancing in blocks matches one big block");
+        {
+            SmoothedValueBank a (4), b (4);
+
+            for (auto* bank : { &a, &b })
+            {
+                bank->reset (100);
+
+                for (int i = 0; i < bank->getNumValues(); ++i)
+                    bank->setTargetValue (i, (float) i - 1.5f);
+            }
+
+            a.advance (13);
+            a.advance (29);
+            a.advance (21);
+            b.advance (63);
+
+            for (int i = 0; i < a.getNumValues(); ++i)
+                expectWithinAbsoluteError (a.getCurrentValue (i), b.getCurrentValue (i), 1.0e-6f);
+
+            expect (a.isSmoothing() && b.isSmoothing());
+        }
+
+        beginTest ("Retargeting mid-ramp");
+        {
+            SmoothedValue<float, ValueSmoothingTypes::Linear> sv;
+            sv.reset (20);
+            sv.setTargetValue (2.0f);
+
+            SmoothedValueBank bank (1);
+            bank.reset (20);
+            bank.setTargetValue (0, 2.0f);
+
+            sv.skip (10);
+            bank.advance (10);
+
+            sv.setTargetValue (-1.0f);
+            bank.setTargetValue (0, -1.0f);
+
+            sv.skip (20);
+            bank.advance (20);
+
+            expectWithinAbsoluteError (bank.getCurrentValue (0), sv.getCurrentValue(), 1.0e-6f);
+            expectEquals (bank.getCurrentValue (0), -1.0f);
+        }
+
+        beginTest ("Posted targets are applied by advance");
+        {
+            SmoothedValueBank bank (2);
+            bank.reset (10);
+
+            expect (bank.postTargetValue (0, 5.0f));
+            expect (bank.postTargetValue (1, -5.0f));
+
+            // Nothing moves until the audio thread advances...
+            expectEquals (bank.getCurrentValue (0), 0.0f);
+            expectEquals (bank.getTargetValue (0), 0.0f);
+
+            bank.advance (10);
+
+            expectEquals (bank.getCurrentValue (0), 5.0f);
+            expectEquals (bank.getCurrentValue (1), -5.0f);
+        }
+
+        beginTest ("Zero ramp length jumps straight to the target");
+        {
+            SmoothedValueBank bank (1);
+            bank.reset (0);
+            bank.setTargetValue (0, 3.0f);
+
+            expectEquals (bank.getCurrentValue (0), 3.0f);
+            expect (! bank.isSmoothing());
+        }
+    }
+};
+
+static SmoothedValueBankTests smoothedValueBankTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,147 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A bank of linearly-smoothed values, stored in structure-of-arrays form so
+    that every ramp can be advanced together in a few vectorized passes.
+
+    Whereas a SmoothedValue is advanced one sample at a time, a
+    SmoothedValueBank keeps the targets, current values and ramp state for a
+    whole set of parameters in contiguous arrays, and advance() moves all of
+    them forward by a block of samples using FloatVectorOperations. With
+    hundreds of automatable parameters, this replaces a per-sample call per
+    value with a handful of array-sized operations per block.
+
+    Target changes can be made directly on the audio thread with
+    setTargetValue(), or posted from a single other thread (typically the UI
+    thread) with postTargetValue(), which sends the update through a lock-free
+    mailbox that advance() drains before moving the ramps.
+
+    Note that the current values are only recalculated by advance(), so
+    getCurrentValue() returns each value as of the end of the last block.
+
+    @see SmoothedValue, FloatVectorOperations
+
+    @tags{Audio}
+*/
+class JUCE_API  SmoothedValueBank
+{
+public:
+    //==============================================================================
+    /** Creates an empty bank - call setSize() before using it. */
+    SmoothedValueBank() = default;
+
+    /** Creates a bank holding the given number of values, all zero. */
+    explicit SmoothedValueBank (int numberOfValues);
+
+    //==============================================================================
+    /** Sets the number of values held in the bank.
+
+        This resets all values to zero and discards any pending posted targets,
+        and it allocates, so call it before processing starts - never from the
+        audio thread.
+    */
+    void setSize (int numberOfValues);
+
+    /** Returns the number of values held in the bank. */
+    int getNumValues() const noexcept                       { return numValues; }
+
+    //==============================================================================
+    /** Sets the length of the ramp used by all the values, and snaps every
+        value to its target.
+    */
+    void reset (double sampleRate, double rampLengthInSeconds) noexcept;
+
+    /** Sets the number of steps over which each value ramps to its target, and
+        snaps every value to its target.
+    */
+    void reset (int numSteps) noexcept;
+
+    //==============================================================================
+    /** Immediately sets both the current and target value at the given index,
+        cancelling any ramp in progress. Call this from the audio thread only.
+    */
+    void setCurrentAndTargetValue (int index, float newValue) noexcept;
+
+    /** Starts the value at the given index ramping towards a new target.
+        Call this from the audio thread only - to change a target from another
+        thread, use postTargetValue() instead.
+    */
+    void setTargetValue (int index, float newValue) noexcept;
+
+    /** Posts a target change through the lock-free mailbox, to be applied by
+        the next call to advance() on the audio thread.
+
+        Like AbstractFifo, the mailbox supports one writing thread, so all
+        calls to this method must come from the same thread.
+
+        @returns false if the mailbox was full and the update was dropped.
+    */
+    bool postTargetValue (int index, float newValue) noexcept;
+
+    //==============================================================================
+    /** Returns the current value at the given index, as of the last advance(). */
+    float getCurrentValue (int index) const noexcept;
+
+    /** Returns the target value at the given index. */
+    float getTargetValue (int index) const noexcept;
+
+    /** Returns the contiguous array of current values, for code that wants to
+        read them all without a call per value.
+    */
+    const float* getCurrentValues() const noexcept          { return currentValues; }
+
+    /** Returns true if any of the values are still mid-ramp. */
+    bool isSmoothing() const noexcept                       { return longestRemainingRamp > 0; }
+
+    //==============================================================================
+    /** Applies any posted target changes, then moves every ramp forward by the
+        given number of samples in one vectorized pass.
+    */
+    void advance (int numSamples) noexcept;
+
+private:
+    //==============================================================================
+    void applyPendingTargetValues() noexcept;
+
+    //==============================================================================
+    struct TargetUpdate
+    {
+        int index;
+        float value;
+    };
+
+    static constexpr int minimumMailboxSize = 256;
+
+    int numValues = 0, stepsToTarget = 0, longestRemainingRamp = 0;
+    HeapBlock<float> currentValues, targetValues, stepSizes, samplesRemaining, scratch;
+    AbstractFifo mailbox { minimumMailboxSize };
+    HeapBlock<TargetUpdate> mailboxQueue { minimumMailboxSize };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SmoothedValueBank)
+};
+
+} // namespace juce
@@ -114,6 +114,11 @@ AudioDeviceManager::~AudioDeviceManager()
 {
     currentAudioDevice.reset();
     defaultMidiOutput.reset();
+
+    // The device has been closed, so the audio thread can no longer be inside a
+    // snapshot and everything can be freed. (Retired snapshots are owned by
+    // retiredCallbackSnapshots and will be deleted with the manager.)
+    delete activeCallbacks.exchange (nullptr);
 }
 
 //==============================================================================
@@ -862,10 +867,59 @@ void AudioDeviceManager::updateXml()
 }
 
 //==============================================================================
+/*  An immutable copy of the registered callbacks. The list that the audio thread
+    fans out to is always one of these: writers build a new snapshot under
+    callbackListLock and publish it with a single atomic pointer swap, so they
+    never contend with the real-time callback.
+*/
+struct AudioDeviceManager::CallbackSnapshot
+{
+    Array<AudioIODeviceCallback*> items;
+    uint64 guardValueWhenRetired = 0;
+};
+
+void AudioDeviceManager::publishCallbackSnapshot()
+{
+    // Must be called with callbackListLock held.
+    auto* newSnapshot = new CallbackSnapshot();
+    newSnapshot->items = callbacks;
+
+    if (auto* retired = activeCallbacks.exchange (newSnapshot))
+    {
+        // If the guard value is odd, the audio thread may still be iterating the
+        // old snapshot, so it's parked in the retired list and freed on the
+        // message thread once the guard has moved on.
+        retired->guardValueWhenRetired = audioCallbackGuard.load();
+        retiredCallbackSnapshots.add (retired);
+
+        MessageManager::callAsync ([weakThis = WeakReference<AudioDeviceManager> (this)]
+        {
+            if (weakThis != nullptr)
+                weakThis->freeRetiredCallbackSnapshots();
+        });
+    }
+}
+
+void AudioDeviceManager::freeRetiredCallbackSnapshots()
+{
+    const ScopedLock sl (callbackListLock);
+
+    for (int i = retiredCallbackSnapshots.size(); --i >= 0;)
+    {
+        auto guardWhenRetired = retiredCallbackSnapshots.getUnchecked (i)->guardValueWhenRetired;
+
+        // A snapshot is quiescent if the audio thread wasn't inside a callback when
+        // it was retired, or has since left the callback it was inside: any later
+        // entry will pick up the newer snapshot.
+        if ((guardWhenRetired & 1) == 0 || audioCallbackGuard.load() != guardWhenRetired)
+            retiredCallbackSnapshots.remove (i);
+    }
+}
+
 void AudioDeviceManager::addAudioCallback (AudioIODeviceCallback* newCallback)
 {
     {
-        const ScopedLock sl (audioCallbackLock);
+        const ScopedLock sl (callbackListLock);
 
         if (callbacks.contains (newCallback))
             return;
@@ -874,8 +928,9 @@ void AudioDeviceManager::addAudioCallback (AudioIODeviceCallback* newCallback)
     if (currentAudioDevice != nullptr && newCallback != nullptr)
         newCallback->audioDeviceAboutToStart (currentAudioDevice.get());
 
-    const ScopedLock sl (audioCallbackLock);
+    const ScopedLock sl (callbackListLock);
     callbacks.add (newCallback);
+    publishCallbackSnapshot();
 }
 
 void AudioDeviceManager::removeAudioCallback (AudioIODeviceCallback* callbackToRemove)
@@ -883,14 +938,24 @@ void AudioDeviceManager::removeAudioCallback (AudioIODeviceCallback* callbackToR
     if (callbackToRemove != nullptr)
     {
         bool needsDeinitialising = currentAudioDevice != nullptr;
+        uint64 guardValueAtPublish;
 
         {
-            const ScopedLock sl (audioCallbackLock);
+            const ScopedLock sl (callbackListLock);
 
             needsDeinitialising = needsDeinitialising && callbacks.contains (callbackToRemove);
             callbacks.removeFirstMatchingValue (callbackToRemove);
+            publishCallbackSnapshot();
+            guardValueAtPublish = audioCallbackGuard.load();
         }
 
+        // Callers are entitled to delete the callback object as soon as this
+        // returns, so if the audio thread was mid-callback on the old snapshot
+        // when it was retired, wait until it has left it: the guard is odd while
+        // a callback is in flight, and any later entry will see the new snapshot.
+        while ((guardValueAtPublish & 1) != 0 && audioCallbackGuard.load() == guardValueAtPublish)
+            Thread::yield();
+
         if (needsDeinitialising)
             callbackToRemove->audioDeviceStopped();
     }
@@ -906,21 +971,26 @@ void AudioDeviceManager::audioDeviceIOCallbackInt (const float** inputChannelDat
 
     inputLevelGetter->updateLevel (inputChannelData, numInputChannels, numSamples);
 
-    if (callbacks.size() > 0)
+    ++audioCallbackGuard;  // odd: the active snapshot may now be in use
+    auto* snapshot = activeCallbacks.load();
+
+    if (snapshot != nullptr && ! snapshot->items.isEmpty())
     {
+        auto& activeItems = snapshot->items;
+
         AudioProcessLoadMeasurer::ScopedTimer timer (loadMeasurer, numSamples);
 
         tempBuffer.setSize (jmax (1, numOutputChannels), jmax (1, numSamples), false, false, true);
 
-        callbacks.getUnchecked(0)->audioDeviceIOCallback (inputChannelData, numInputChannels,
-                                                          outputChannelData, numOutputChannels, numSamples);
+        activeItems.getUnchecked(0)->audioDeviceIOCallback (inputChannelData, numInputChannels,
+                                                            outputChannelData, numOutputChannels, numSamples);
 
         auto** tempChans = tempBuffer.getArrayOfWritePointers();
 
-        for (int i = callbacks.size(); --i > 0;)
+        for (int i = activeItems.size(); --i > 0;)
         {
-            callbacks.getUnchecked(i)->audioDeviceIOCallback (inputChannelData, numInputChannels,
-                                                              tempChans, numOutputChannels, numSamples);
+            activeItems.getUnchecked(i)->audioDeviceIOCallback (inputChannelData, numInputChannels,
+                                                                tempChans, numOutputChannels, numSamples);
 
             for (int chan = 0; chan < numOutputChannels; ++chan)
             {
@@ -937,6 +1007,8 @@ void AudioDeviceManager::audioDeviceIOCallbackInt (const float** inputChannelDat
             zeromem (outputChannelData[i], (size_t) numSamples * sizeof (float));
     }
 
+    ++audioCallbackGuard;  // even: finished with the snapshot
+
     if (testSound != nullptr)
     {
         auto numSamps = jmin (numSamples, testSound->getNumSamples() - testSoundPosition);
@@ -964,7 +1036,7 @@ void AudioDeviceManager::audioDeviceAboutToStartInt (AudioIODevice* const device
     updateCurrentSetup();
 
     {
-        const ScopedLock sl (audioCallbackLock);
+        const ScopedLock sl (callbackListLock);
 
         for (int i = callbacks.size(); --i >= 0;)
             callbacks.getUnchecked(i)->audioDeviceAboutToStart (device);
@@ -977,9 +1049,12 @@ void AudioDeviceManager::audioDeviceStoppedInt()
 {
     sendChangeMessage();
 
-    const ScopedLock sl (audioCallbackLock);
+    {
+        const ScopedLock sl (audioCallbackLock);
+        loadMeasurer.reset();
+    }
 
-    loadMeasurer.reset();
+    const ScopedLock sl (callbackListLock);
 
     for (int i = callbacks.size(); --i >= 0;)
         callbacks.getUnchecked(i)->audioDeviceStopped();
@@ -987,7 +1062,7 @@ void AudioDeviceManager::audioDeviceStoppedInt()
 
 void AudioDeviceManager::audioDeviceErrorInt (const String& message)
 {
-    const ScopedLock sl (audioCallbackLock);
+    const ScopedLock sl (callbackListLock);
 
     for (int i = callbacks.size(); --i >= 0;)
         callbacks.getUnchecked(i)->audioDeviceError (message);
@@ -1077,8 +1152,9 @@ void AudioDeviceManager::setDefaultMidiOutputDevice (const String& identifier)
         Array<AudioIODeviceCallback*> oldCallbacks;
 
         {
-            const ScopedLock sl (audioCallbackLock);
+            const ScopedLock sl (callbackListLock);
             oldCallbacks.swapWith (callbacks);
+            publishCallbackSnapshot();
         }
 
         if (currentAudioDevice != nullptr)
@@ -1100,8 +1176,9 @@ void AudioDeviceManager::setDefaultMidiOutputDevice (const String& identifier)
                 c->audioDeviceAboutToStart (currentAudioDevice.get());
 
         {
-            const ScopedLock sl (audioCallbackLock);
+            const ScopedLock sl (callbackListLock);
             oldCallbacks.swapWith (callbacks);
+            publishCallbackSnapshot();
         }
 
         updateXml();
@@ -1483,6 +1560,39 @@ public:
             ptr->restartDevices (newSr, newBs);
             expectEquals (numCalls, 1);
         }
+
+        beginTest ("Audio callbacks added and removed while the device is running take effect on the next block");
+        {
+            AudioDeviceManager manager;
+            initialiseManager (manager);
+            manager.initialiseWithDefaultDevices (0, 2);
+
+            auto* device = static_cast<MockDevice*> (manager.getCurrentAudioDevice());
+            expect (device != nullptr);
+
+            float left[32], right[32];
+            float* channels[] = { left, right };
+
+            auto numCallsA = 0, numCallsB = 0;
+            MockCallback a, b;
+            a.callback = [&] { ++numCallsA; };
+            b.callback = [&] { ++numCallsB; };
+
+            manager.addAudioCallback (&a);
+            device->processBlock (channels, 2, 32);
+            expectEquals (numCallsA, 1);
+            expectEquals (numCallsB, 0);
+
+            manager.addAudioCallback (&b);
+            device->processBlock (channels, 2, 32);
+            expectEquals (numCallsA, 2);
+            expectEquals (numCallsB, 1);
+
+            manager.removeAudioCallback (&a);
+            device->processBlock (channels, 2, 32);
+            expectEquals (numCallsA, 2);
+            expectEquals (numCallsB, 2);
+        }
     }
 
 private:
@@ -1714,6 +1824,12 @@ private:
         int getOutputLatencyInSamples() override { return 0; }
         int getInputLatencyInSamples() override { return 0; }
 
+        // Call this to emulate the device asking for a block of audio.
+        void processBlock (float** outs, int numOuts, int numSamples)
+        {
+            callback->audioDeviceIOCallback (nullptr, 0, outs, numOuts, numSamples);
+        }
+
     private:
         void restart (double newSr, int newBs) override
         {
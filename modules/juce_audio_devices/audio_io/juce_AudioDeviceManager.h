@@ -493,7 +493,17 @@ private:
 
     AudioDeviceSetup currentSetup;
     std::unique_ptr<AudioIODevice> currentAudioDevice;
+
+    // The master copy of the registered callbacks, only touched with callbackListLock
+    // held. The audio thread never reads this directly: each change to it is published
+    // as an immutable CallbackSnapshot which the audio callback picks up with a single
+    // atomic load, so registering a callback never contends with the audio thread.
+    struct CallbackSnapshot;
     Array<AudioIODeviceCallback*> callbacks;
+    std::atomic<CallbackSnapshot*> activeCallbacks { nullptr };
+    OwnedArray<CallbackSnapshot> retiredCallbackSnapshots;
+    std::atomic<uint64> audioCallbackGuard { 0 };
+    CriticalSection callbackListLock;
     int numInputChansNeeded = 0, numOutputChansNeeded = 2;
     String preferredDeviceName, currentDeviceType;
     std::unique_ptr<XmlElement> lastExplicitSettings;
@@ -533,6 +543,8 @@ private:
     void audioDeviceErrorInt (const String&);
     void handleIncomingMidiMessageInt (MidiInput*, const MidiMessage&);
     void audioDeviceListChanged();
+    void publishCallbackSnapshot();
+    void freeRetiredCallbackSnapshots();
 
     String restartDevice (int blockSizeToUse, double sampleRateToUse,
                           const BigInteger& ins, const BigInteger& outs);
@@ -555,6 +567,7 @@ private:
     AudioIODeviceType* findType (const String& typeName);
     void pickCurrentDeviceTypeWithDevices();
 
+    JUCE_DECLARE_WEAK_REFERENCEABLE (AudioDeviceManager)
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioDeviceManager)
 };
 
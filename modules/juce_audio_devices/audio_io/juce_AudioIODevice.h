@@ -312,6 +312,21 @@ public:
     */
     virtual int getXRunCount() const noexcept;
 
+    //==============================================================================
+    /** Returns the workgroup that the device's audio thread belongs to, where
+        the OS exposes one.
+
+        On macOS and iOS the system schedules the members of a device's
+        workgroup together with its IO thread, so worker threads that help to
+        compute the audio callback should join it with an
+        AudioWorkgroup::ScopedMembership to avoid being descheduled
+        mid-callback. On other platforms, and before the device is started,
+        this returns an invalid workgroup.
+
+        @see AudioWorkgroup
+    */
+    virtual AudioWorkgroup getWorkgroup() const;
+
     //==============================================================================
 protected:
     /** Creates a device, setting its name and type member variables. */
@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_AUDIOWORKGROUP_TYPES_AVAILABLE
+ #include <os/workgroup.h>
+#endif
+
+namespace juce
+{
+
+struct AudioWorkgroup::ScopedMembership::Token
+{
+   #if JUCE_AUDIOWORKGROUP_TYPES_AVAILABLE
+    os_workgroup_t workgroup;
+    os_workgroup_join_token_s joinToken;
+   #endif
+};
+
+AudioWorkgroup::ScopedMembership::ScopedMembership() noexcept = default;
+AudioWorkgroup::ScopedMembership::ScopedMembership (ScopedMembership&&) noexcept = default;
+AudioWorkgroup::ScopedMembership& AudioWorkgroup::ScopedMembership::operator= (ScopedMembership&&) noexcept = default;
+
+AudioWorkgroup::ScopedMembership::ScopedMembership (const AudioWorkgroup& workgroupToJoin)
+{
+   #if JUCE_AUDIOWORKGROUP_TYPES_AVAILABLE
+    if (__builtin_available (macOS 11.0, iOS 14.0, *))
+    {
+        if (auto workgroup = (os_workgroup_t) workgroupToJoin.getNativeHandle())
+        {
+            auto newToken = std::make_unique<Token>();
+            newToken->workgroup = workgroup;
+
+            if (os_workgroup_join (workgroup, &newToken->joinToken) == 0)
+                token = std::move (newToken);
+        }
+    }
+   #else
+    ignoreUnused (workgroupToJoin);
+   #endif
+}
+
+AudioWorkgroup::ScopedMembership::~ScopedMembership()
+{
+   #if JUCE_AUDIOWORKGROUP_TYPES_AVAILABLE
+    if (token != nullptr)
+        if (__builtin_available (macOS 11.0, iOS 14.0, *))
+            os_workgroup_leave (token->workgroup, &token->joinToken);
+   #endif
+}
+
+} // namespace juce
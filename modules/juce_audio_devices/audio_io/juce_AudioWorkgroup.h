@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if ((JUCE_MAC && defined (MAC_OS_VERSION_11_0) && MAC_OS_X_VERSION_MAX_ALLOWED >= MAC_OS_VERSION_11_0) \
+      || (JUCE_IOS && defined (__IPHONE_14_0) && __IPHONE_OS_VERSION_MAX_ALLOWED >= __IPHONE_14_0))
+ #define JUCE_AUDIOWORKGROUP_TYPES_AVAILABLE 1
+#else
+ #define JUCE_AUDIOWORKGROUP_TYPES_AVAILABLE 0
+#endif
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A handle to an OS thread workgroup that an audio device's IO thread belongs to.
+
+    On macOS and iOS, the system schedules all the threads in a device's
+    workgroup together with the device's own IO thread, so worker threads that
+    help to compute an audio callback should join the device's workgroup - if
+    they don't, they may be run on slower cores or descheduled in the middle of
+    the callback. Use AudioIODevice::getWorkgroup() to get the workgroup of a
+    running device, and join it from each worker with a ScopedMembership:
+
+    @code
+    void run() override
+    {
+        AudioWorkgroup::ScopedMembership membership (device->getWorkgroup());
+
+        while (! threadShouldExit())
+            processNextChunk();
+    }
+    @endcode
+
+    On platforms without workgroup support this class is inert: workgroups are
+    never valid and joining them does nothing.
+
+    @see AudioIODevice::getWorkgroup, Thread::startRealtimeThread
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioWorkgroup
+{
+public:
+    //==============================================================================
+    /** Creates an invalid workgroup. */
+    AudioWorkgroup() = default;
+
+    /** Wraps a native workgroup handle - an os_workgroup_t on Apple platforms.
+
+        This is mainly for use by AudioIODevice implementations. The wrapper
+        doesn't retain the handle, so it must stay alive for as long as any
+        AudioWorkgroup or ScopedMembership is using it.
+    */
+    explicit AudioWorkgroup (void* nativeWorkgroupHandle) noexcept
+        : handle (nativeWorkgroupHandle) {}
+
+    /** Returns true if this refers to a real workgroup that can be joined. */
+    bool isValid() const noexcept               { return handle != nullptr; }
+
+    /** Returns the native workgroup handle, or nullptr if invalid. */
+    void* getNativeHandle() const noexcept      { return handle; }
+
+    //==============================================================================
+    /** Makes the calling thread a member of a workgroup for this object's lifetime.
+
+        Create one of these on a worker thread, passing the device's workgroup,
+        and keep it alive for as long as the thread is doing work for the audio
+        callback; the thread leaves the workgroup when it's destroyed. Joining an
+        invalid workgroup is harmless and simply produces an inactive membership.
+    */
+    class JUCE_API  ScopedMembership
+    {
+    public:
+        /** Creates an inactive membership which isn't part of any workgroup. */
+        ScopedMembership() noexcept;
+
+        /** Joins the calling thread to the given workgroup. */
+        explicit ScopedMembership (const AudioWorkgroup& workgroupToJoin);
+
+        /** Move constructor. */
+        ScopedMembership (ScopedMembership&&) noexcept;
+
+        /** Move assignment operator. */
+        ScopedMembership& operator= (ScopedMembership&&) noexcept;
+
+        /** Destructor. Leaves the workgroup if the membership is active. */
+        ~ScopedMembership();
+
+        /** Returns true if the thread actually joined a workgroup.
+
+            This may be false if the workgroup was invalid, or if the OS refused
+            the join - e.g. because the thread is already a member of another
+            workgroup that can't be nested.
+        */
+        bool isActive() const noexcept          { return token != nullptr; }
+
+    private:
+        struct Token;
+        std::unique_ptr<Token> token;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedMembership)
+    };
+
+private:
+    //==============================================================================
+    void* handle = nullptr;
+};
+
+} // namespace juce
@@ -233,7 +233,9 @@ namespace juce
 
 #include "audio_io/juce_AudioDeviceManager.cpp"
 #include "audio_io/juce_AudioIODevice.cpp"
+#include "audio_io/juce_AudioWorkgroup.cpp"
 #include "audio_io/juce_AudioIODeviceType.cpp"
+#include "midi_io/juce_LockFreeMidiMessageCollector.cpp"
 #include "midi_io/juce_MidiMessageCollector.cpp"
 #include "midi_io/juce_MidiDevices.cpp"
 #include "sources/juce_AudioSourcePlayer.cpp"
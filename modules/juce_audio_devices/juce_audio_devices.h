@@ -162,6 +162,7 @@
 //==============================================================================
 #include "midi_io/juce_MidiDevices.h"
 #include "midi_io/juce_MidiMessageCollector.h"
+#include "midi_io/juce_LockFreeMidiMessageCollector.h"
 
 namespace juce
 {
@@ -178,6 +179,7 @@ namespace juce
     };
 }
 
+#include "audio_io/juce_AudioWorkgroup.h"
 #include "audio_io/juce_AudioIODevice.h"
 #include "audio_io/juce_AudioIODeviceType.h"
 #include "audio_io/juce_SystemAudioVolume.h"
@@ -0,0 +1,357 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/*  Each record in a port's ring is the message's timestamp and size followed by
+    its raw bytes. The writer only commits a record once it has been copied in
+    completely, so the reader always sees whole messages.
+*/
+struct LockFreeMidiMessageCollector::Port
+{
+    struct Forwarder  : public MidiInputCallback
+    {
+        Forwarder (LockFreeMidiMessageCollector& o, int index)  : owner (o), portIndex (index) {}
+
+        void handleIncomingMidiMessage (MidiInput*, const MidiMessage& message) override
+        {
+            owner.addMessageToQueue (message, portIndex);
+        }
+
+        LockFreeMidiMessageCollector& owner;
+        int portIndex;
+    };
+
+    Port (LockFreeMidiMessageCollector& owner, int index, int capacity)
+        : forwarder (owner, index), fifo (capacity)
+    {
+        storage.allocate ((size_t) capacity, false);
+    }
+
+    static constexpr int headerBytes = (int) (sizeof (double) + sizeof (int));
+
+    void addMessage (const MidiMessage& message)
+    {
+        const auto numBytes = message.getRawDataSize();
+        const auto totalSize = headerBytes + numBytes;
+
+        // if the ring is full, dropping the message is the only wait-free option
+        if (fifo.getFreeSpace() < totalSize)
+            return;
+
+        uint8 header[headerBytes];
+        const auto timestamp = message.getTimeStamp();
+        memcpy (header, &timestamp, sizeof (timestamp));
+        memcpy (header + sizeof (timestamp), &numBytes, sizeof (numBytes));
+
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite (totalSize, start1, size1, start2, size2);
+
+        int pos = 0;
+
+        auto writeBytes = [&] (const uint8* src, int num)
+        {
+            for (int i = 0; i < num; ++i, ++pos)
+                storage[pos < size1 ? start1 + pos : start2 + (pos - size1)] = src[i];
+        };
+
+        writeBytes (header, headerBytes);
+        writeBytes (message.getRawData(), numBytes);
+
+        fifo.finishedWrite (totalSize);
+    }
+
+    bool readNextMessage (uint8* dest, double& timestamp, int& numBytes)
+    {
+        if (fifo.getNumReady() < headerBytes)
+            return false;
+
+        uint8 header[headerBytes];
+        readBytes (header, headerBytes);
+        memcpy (&timestamp, header, sizeof (timestamp));
+        memcpy (&numBytes, header + sizeof (timestamp), sizeof (numBytes));
+
+        // the writer commits each record in one go, so the payload must be ready
+        jassert (fifo.getNumReady() >= numBytes);
+        readBytes (dest, numBytes);
+        return true;
+    }
+
+    void readBytes (uint8* dest, int num)
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead (num, start1, size1, start2, size2);
+
+        for (int i = 0; i < num; ++i)
+            dest[i] = storage[i < size1 ? start1 + i : start2 + (i - size1)];
+
+        fifo.finishedRead (num);
+    }
+
+    Forwarder forwarder;
+    AbstractFifo fifo;
+    HeapBlock<uint8> storage;
+};
+
+//==============================================================================
+LockFreeMidiMessageCollector::LockFreeMidiMessageCollector (int numPorts, int bytesPerPort)
+{
+    jassert (numPorts > 0 && bytesPerPort > Port::headerBytes);
+
+    for (int i = 0; i < numPorts; ++i)
+        ports.add (new Port (*this, i, bytesPerPort));
+
+    scratch.allocate ((size_t) bytesPerPort, false);
+}
+
+LockFreeMidiMessageCollector::~LockFreeMidiMessageCollector()
+{
+}
+
+int LockFreeMidiMessageCollector::getNumPorts() const noexcept
+{
+    return ports.size();
+}
+
+MidiInputCallback& LockFreeMidiMessageCollector::getCallbackForPort (int portIndex) noexcept
+{
+    jassert (isPositiveAndBelow (portIndex, ports.size()));
+    return ports.getUnchecked (portIndex)->forwarder;
+}
+
+//==============================================================================
+void LockFreeMidiMessageCollector::reset (const double newSampleRate)
+{
+    jassert (newSampleRate > 0);
+
+   #if JUCE_DEBUG
+    hasCalledReset = true;
+   #endif
+    sampleRate = newSampleRate;
+
+    for (auto* port : ports)
+        port->fifo.reset();
+
+    pendingMessages.clear();
+    lastCallbackTime = Time::getMillisecondCounterHiRes();
+}
+
+void LockFreeMidiMessageCollector::addMessageToQueue (const MidiMessage& message, int portIndex)
+{
+   #if JUCE_DEBUG
+    jassert (hasCalledReset); // you need to call reset() to set the correct sample rate before using this object
+   #endif
+
+    // the messages that come in here need to be time-stamped correctly - see MidiInput
+    // for details of what the number should be.
+    jassert (message.getTimeStamp() != 0);
+
+    jassert (isPositiveAndBelow (portIndex, ports.size()));
+    ports.getUnchecked (portIndex)->addMessage (message);
+}
+
+void LockFreeMidiMessageCollector::removeNextBlockOfMessages (MidiBuffer& destBuffer,
+                                                              const int numSamples)
+{
+   #if JUCE_DEBUG
+    jassert (hasCalledReset); // you need to call reset() to set the correct sample rate before using this object
+   #endif
+
+    jassert (numSamples > 0);
+
+    auto timeNow = Time::getMillisecondCounterHiRes();
+    auto msElapsed = timeNow - lastCallbackTime;
+
+    // drain every port's ring, reconciling the wall-clock timestamps against the
+    // audio clock in one batch - inserting by sample position merges the ports
+    for (auto* port : ports)
+    {
+        double timestamp;
+        int numBytes;
+
+        while (port->readNextMessage (scratch, timestamp, numBytes))
+        {
+            auto sampleNumber = (int) ((timestamp - 0.001 * lastCallbackTime) * sampleRate);
+            pendingMessages.addEvent (scratch, numBytes, sampleNumber);
+        }
+    }
+
+    lastCallbackTime = timeNow;
+
+    if (! pendingMessages.isEmpty())
+    {
+        int numSourceSamples = jmax (1, roundToInt (msElapsed * 0.001 * sampleRate));
+        int startSample = 0;
+        int scale = 1 << 16;
+
+        if (numSourceSamples > numSamples)
+        {
+            // if our list of events is longer than the buffer we're being
+            // asked for, scale them down to squeeze them all in..
+            const int maxBlockLengthToUse = numSamples << 5;
+
+            auto iter = pendingMessages.cbegin();
+
+            if (numSourceSamples > maxBlockLengthToUse)
+            {
+                startSample = numSourceSamples - maxBlockLengthToUse;
+                numSourceSamples = maxBlockLengthToUse;
+                iter = pendingMessages.findNextSamplePosition (startSample);
+            }
+
+            scale = (numSamples << 10) / numSourceSamples;
+
+            std::for_each (iter, pendingMessages.cend(), [&] (const MidiMessageMetadata& meta)
+            {
+                const auto pos = ((meta.samplePosition - startSample) * scale) >> 10;
+                destBuffer.addEvent (meta.data, meta.numBytes, jlimit (0, numSamples - 1, pos));
+            });
+        }
+        else
+        {
+            // if our event list is shorter than the number we need, put them
+            // towards the end of the buffer
+            startSample = numSamples - numSourceSamples;
+
+            for (const auto metadata : pendingMessages)
+                destBuffer.addEvent (metadata.data, metadata.numBytes,
+                                     jlimit (0, numSamples - 1, metadata.samplePosition + startSample));
+        }
+
+        pendingMessages.clear();
+    }
+}
+
+void LockFreeMidiMessageCollector::ensureStorageAllocated (size_t bytes)
+{
+    pendingMessages.ensureSize (bytes);
+}
+
+//==============================================================================
+void LockFreeMidiMessageCollector::handleNoteOn (MidiKeyboardState*, int midiChannel, int midiNoteNumber, float velocity)
+{
+    MidiMessage m (MidiMessage::noteOn (midiChannel, midiNoteNumber, velocity));
+    m.setTimeStamp (Time::getMillisecondCounterHiRes() * 0.001);
+
+    addMessageToQueue (m);
+}
+
+void LockFreeMidiMessageCollector::handleNoteOff (MidiKeyboardState*, int midiChannel, int midiNoteNumber, float velocity)
+{
+    MidiMessage m (MidiMessage::noteOff (midiChannel, midiNoteNumber, velocity));
+    m.setTimeStamp (Time::getMillisecondCounterHiRes() * 0.001);
+
+    addMessageToQueue (m);
+}
+
+void LockFreeMidiMessageCollector::handleIncomingMidiMessage (MidiInput*, const MidiMessage& message)
+{
+    addMessageToQueue (message);
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class LockFreeMidiMessageCollectorTests  : public UnitTest
+{
+public:
+    LockFreeMidiMessageCollectorTests()
+        : UnitTest ("LockFreeMidiMessageCollector", UnitTestCategories::midi)
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest ("Messages from multiple ports are merged in timestamp order");
+        {
+            LockFreeMidiMessageCollector collector (2);
+            collector.reset (44100.0);
+
+            const auto base = Time::getMillisecondCounterHiRes() * 0.001;
+
+            collector.addMessageToQueue (timestamped (MidiMessage::controllerEvent (1, 7, 100), base + 0.001), 1);
+            collector.addMessageToQueue (timestamped (MidiMessage::noteOn  (1, 60, 0.5f), base + 0.002), 0);
+            collector.addMessageToQueue (timestamped (MidiMessage::noteOff (1, 60, 0.5f), base + 0.003), 0);
+
+            MidiBuffer block;
+            collector.removeNextBlockOfMessages (block, 512);
+
+            expectEquals (block.getNumEvents(), 3);
+
+            StringArray order;
+
+            for (const auto metadata : block)
+            {
+                auto message = metadata.getMessage();
+                order.add (message.isController() ? "cc" : (message.isNoteOn() ? "on" : "off"));
+                expect (isPositiveAndBelow (metadata.samplePosition, 512));
+            }
+
+            expectEquals (order.joinIntoString (" "), String ("cc on off"));
+        }
+
+        beginTest ("A full ring drops messages instead of blocking");
+        {
+            // each 3-byte message uses 15 bytes of the ring, and one byte of a
+            // 64-byte fifo is reserved, so exactly four messages should fit
+            LockFreeMidiMessageCollector collector (1, 64);
+            collector.reset (44100.0);
+
+            const auto base = Time::getMillisecondCounterHiRes() * 0.001;
+
+            for (int i = 0; i < 100; ++i)
+                collector.addMessageToQueue (timestamped (MidiMessage::noteOn (1, 60 + (i % 12), 0.5f), base + 0.001 * (i + 1)));
+
+            MidiBuffer block;
+            collector.removeNextBlockOfMessages (block, 512);
+
+            expectEquals (block.getNumEvents(), 4);
+
+            for (const auto metadata : block)
+                expect (metadata.getMessage().isNoteOn());
+
+            // once drained, the ring accepts new messages again
+            collector.addMessageToQueue (timestamped (MidiMessage::noteOff (1, 60, 0.5f), base + 0.2));
+
+            block.clear();
+            collector.removeNextBlockOfMessages (block, 512);
+            expectEquals (block.getNumEvents(), 1);
+        }
+    }
+
+private:
+    static MidiMessage timestamped (MidiMessage m, double time)
+    {
+        m.setTimeStamp (time);
+        return m;
+    }
+};
+
+static LockFreeMidiMessageCollectorTests lockFreeMidiMessageCollectorTests;
+
+#endif
+
+} // namespace juce
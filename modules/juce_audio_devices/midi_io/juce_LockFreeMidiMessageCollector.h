@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A lock-free version of MidiMessageCollector, for use where the audio callback
+    must never wait on a MIDI input thread.
+
+    MidiMessageCollector takes a CriticalSection in both addMessageToQueue() and
+    removeNextBlockOfMessages(), so a burst of messages arriving on the MIDI
+    thread can block the audio callback. This class instead gives each input
+    port its own single-producer single-consumer ring buffer: the producer side
+    just copies the raw message bytes and timestamp into its ring, and the
+    timestamps are only reconciled against the audio clock in one batch when the
+    messages are collected. Both sides are wait-free.
+
+    Each port's ring must only be fed from one thread at a time, which is the
+    normal situation where each MIDI input device delivers its callbacks from
+    its own thread - pass the object returned by getCallbackForPort() when
+    opening each input. Messages that arrive when a ring is full are dropped
+    rather than blocking.
+
+    As with MidiMessageCollector, call reset() before use to set the sample
+    rate, and call removeNextBlockOfMessages() regularly from the audio
+    callback.
+
+    @see MidiMessageCollector, MidiInput, AbstractFifo
+
+    @tags{Audio}
+*/
+class JUCE_API  LockFreeMidiMessageCollector   : public MidiKeyboardState::Listener,
+                                                 public MidiInputCallback
+{
+public:
+    //==============================================================================
+    /** Creates a collector with one ring buffer per input port.
+
+        @param numPorts      the number of independent producer threads that will
+                             feed this collector - e.g. the number of MIDI inputs
+        @param bytesPerPort  the capacity of each port's ring buffer. Each queued
+                             message uses its raw size plus a small header, so the
+                             default leaves room for several thousand short messages.
+    */
+    explicit LockFreeMidiMessageCollector (int numPorts = 1, int bytesPerPort = 16384);
+
+    /** Destructor. */
+    ~LockFreeMidiMessageCollector() override;
+
+    //==============================================================================
+    /** Clears any pending messages and sets the sample rate.
+
+        You need to call this method before starting to use the collector. Unlike
+        the other methods it isn't thread-safe, so don't call it while messages
+        are being added or removed.
+    */
+    void reset (double sampleRate);
+
+    /** Returns the number of ports that were passed to the constructor. */
+    int getNumPorts() const noexcept;
+
+    /** Takes an incoming real-time message and adds it to the given port's ring.
+
+        The message's timestamp is kept, and it will be converted to a position in
+        the block returned by the next call to removeNextBlockOfMessages().
+
+        This is wait-free, and safe to call concurrently with
+        removeNextBlockOfMessages(), but each port must only be fed from a single
+        thread. If the port's ring is full the message is dropped.
+    */
+    void addMessageToQueue (const MidiMessage& message, int portIndex = 0);
+
+    /** Removes the pending messages from every port's ring as a single buffer.
+
+        The messages from all ports are merged in timestamp order, and their
+        timestamps corrected to the range 0 to numSamples - 1, in the same way as
+        MidiMessageCollector::removeNextBlockOfMessages().
+
+        This should be made regularly by something like an audio processing
+        callback, because the time that it happens is used in calculating the
+        midi event positions. It's wait-free, but must only be called from one
+        thread at a time.
+
+        Precondition: numSamples must be greater than 0.
+    */
+    void removeNextBlockOfMessages (MidiBuffer& destBuffer, int numSamples);
+
+    /** Preallocates storage for the merged messages, to avoid allocation in the
+        audio callback when an unusually dense block arrives.
+    */
+    void ensureStorageAllocated (size_t bytes);
+
+    //==============================================================================
+    /** Returns a callback that feeds the given port, suitable for passing to
+        MidiInput::openDevice(). The callback remains valid for the lifetime of
+        the collector.
+    */
+    MidiInputCallback& getCallbackForPort (int portIndex) noexcept;
+
+    //==============================================================================
+    /** @internal */
+    void handleNoteOn (MidiKeyboardState*, int midiChannel, int midiNoteNumber, float velocity) override;
+    /** @internal */
+    void handleNoteOff (MidiKeyboardState*, int midiChannel, int midiNoteNumber, float velocity) override;
+    /** @internal This adds the message to the first port - use getCallbackForPort()
+        to route multiple devices to their own ports. */
+    void handleIncomingMidiMessage (MidiInput*, const MidiMessage&) override;
+
+private:
+    //==============================================================================
+    struct Port;
+
+    OwnedArray<Port> ports;
+    MidiBuffer pendingMessages;
+    HeapBlock<uint8> scratch;
+    double lastCallbackTime = 0;
+    double sampleRate = 44100.0;
+   #if JUCE_DEBUG
+    bool hasCalledReset = false;
+   #endif
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LockFreeMidiMessageCollector)
+};
+
+} // namespace juce
@@ -23,6 +23,83 @@
 namespace juce
 {
 
+//==============================================================================
+MidiDeviceListConnectionBroadcaster& MidiDeviceListConnectionBroadcaster::get()
+{
+    static MidiDeviceListConnectionBroadcaster broadcaster;
+    return broadcaster;
+}
+
+MidiDeviceListConnectionBroadcaster::~MidiDeviceListConnectionBroadcaster()
+{
+    cancelPendingUpdate();
+}
+
+int MidiDeviceListConnectionBroadcaster::add (std::function<void()> callback)
+{
+    const ScopedLock sl (callbackLock);
+    auto key = ++nextKey;
+    callbacks.emplace (key, std::move (callback));
+
+    if (callbacks.size() == 1)
+        if (auto factory = getNativeWatcherFactory())
+            nativeWatcher = factory();
+
+    return key;
+}
+
+void MidiDeviceListConnectionBroadcaster::remove (int key)
+{
+    std::shared_ptr<void> retiredWatcher;
+
+    {
+        const ScopedLock sl (callbackLock);
+        callbacks.erase (key);
+
+        if (callbacks.empty())
+            std::swap (retiredWatcher, nativeWatcher);
+    }
+
+    // the watcher is destroyed outside the lock, as tearing down the native
+    // machinery may involve waiting for a service thread to exit
+}
+
+void MidiDeviceListConnectionBroadcaster::notify()
+{
+    triggerAsyncUpdate();
+}
+
+void MidiDeviceListConnectionBroadcaster::handleAsyncUpdate()
+{
+    std::vector<std::function<void()>> active;
+
+    {
+        const ScopedLock sl (callbackLock);
+
+        for (auto& callback : callbacks)
+            active.push_back (callback.second);
+    }
+
+    for (auto& callback : active)
+        callback();
+}
+
+//==============================================================================
+void MidiDeviceListConnection::reset() noexcept
+{
+    if (key != 0)
+    {
+        MidiDeviceListConnectionBroadcaster::get().remove (key);
+        key = 0;
+    }
+}
+
+MidiDeviceListConnection MidiDeviceListConnection::make (std::function<void()> callback)
+{
+    return MidiDeviceListConnection (MidiDeviceListConnectionBroadcaster::get().add (std::move (callback)));
+}
+
+//==============================================================================
 MidiOutput::MidiOutput (const String& deviceName, const String& deviceIdentifier)
     : Thread ("midi out"), deviceInfo (deviceName, deviceIdentifier)
 {
@@ -65,6 +65,108 @@ struct MidiDeviceInfo
     bool operator!= (const MidiDeviceInfo& other) const noexcept   { return ! operator== (other); }
 };
 
+//==============================================================================
+/**
+    Receives a callback when the set of available MIDI devices changes.
+
+    Create one of these with make(), passing the function that should run when
+    a device is connected or disconnected. The callback will keep firing, on the
+    message thread, for as long as the connection object stays alive.
+
+    @code
+    auto connection = MidiDeviceListConnection::make ([]
+    {
+        // refresh your cached device list here
+    });
+    @endcode
+
+    Changes are detected incrementally, without re-enumerating every device, so
+    notifications stay cheap even with a large number of ports connected.
+    Change detection is currently implemented for ALSA on Linux; on other
+    platforms the callback will not fire.
+
+    @see MidiInput::getAvailableDevices, MidiOutput::getAvailableDevices
+
+    @tags{Audio}
+*/
+class JUCE_API  MidiDeviceListConnection
+{
+public:
+    /** Creates an inactive connection. */
+    MidiDeviceListConnection() = default;
+
+    MidiDeviceListConnection (MidiDeviceListConnection&& other) noexcept
+        : key (std::exchange (other.key, 0))
+    {
+    }
+
+    MidiDeviceListConnection& operator= (MidiDeviceListConnection&& other) noexcept
+    {
+        reset();
+        key = std::exchange (other.key, 0);
+        return *this;
+    }
+
+    ~MidiDeviceListConnection() noexcept    { reset(); }
+
+    /** Detaches the callback, so that it will no longer fire. */
+    void reset() noexcept;
+
+    /** Registers a function to be called whenever the set of midi devices changes,
+        returning the connection object that keeps the registration alive.
+    */
+    static MidiDeviceListConnection make (std::function<void()> callback);
+
+private:
+    explicit MidiDeviceListConnection (int keyIn) noexcept  : key (keyIn) {}
+
+    int key = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (MidiDeviceListConnection)
+};
+
+#ifndef DOXYGEN
+/** @internal
+
+    Fans out MidiDeviceListConnection callbacks on the message thread.
+
+    The native backends call notify() when they detect that a device has
+    appeared or disappeared. A backend that needs to actively watch for
+    changes can install a watcher factory at static-initialisation time;
+    the broadcaster will keep one watcher alive while any connections exist.
+*/
+class MidiDeviceListConnectionBroadcaster  : private AsyncUpdater
+{
+public:
+    ~MidiDeviceListConnectionBroadcaster() override;
+
+    int add (std::function<void()> callback);
+    void remove (int key);
+
+    /** May be called from any thread. */
+    void notify();
+
+    static MidiDeviceListConnectionBroadcaster& get();
+
+    using NativeWatcherFactory = std::shared_ptr<void> (*)();
+
+    static NativeWatcherFactory& getNativeWatcherFactory() noexcept
+    {
+        static NativeWatcherFactory factory = nullptr;
+        return factory;
+    }
+
+private:
+    MidiDeviceListConnectionBroadcaster() = default;
+    void handleAsyncUpdate() override;
+
+    std::map<int, std::function<void()>> callbacks;
+    std::shared_ptr<void> nativeWatcher;
+    CriticalSection callbackLock;
+    int nextKey = 0;
+};
+#endif
+
 class MidiInputCallback;
 
 //==============================================================================
@@ -25,6 +25,12 @@ namespace juce
 
 #if JUCE_ALSA
 
+//==============================================================================
+static String getFormattedPortIdentifier (int clientId, int portId)
+{
+    return String (clientId) + "-" + String (portId);
+}
+
 //==============================================================================
 class AlsaClient  : public ReferenceCountedObject
 {
@@ -293,7 +299,234 @@ public:
         decReferenceCount();
     }
 
+    //==============================================================================
+    // An incrementally-maintained cache of the devices exposed by each ALSA
+    // client, kept up to date from announcement events while the input thread
+    // is running, so that device rescans don't have to walk every client.
+    struct ClientPortList
+    {
+        Array<MidiDeviceInfo> inputs, outputs;
+    };
+
+    void buildDeviceCache()
+    {
+        std::map<int, ClientPortList> newCache;
+
+        if (auto seqHandle = handle)
+        {
+            snd_seq_system_info_t* systemInfo = nullptr;
+            snd_seq_client_info_t* clientInfo = nullptr;
+
+            snd_seq_system_info_alloca (&systemInfo);
+
+            if (snd_seq_system_info (seqHandle, systemInfo) == 0)
+            {
+                snd_seq_client_info_alloca (&clientInfo);
+                snd_seq_client_info_set_client (clientInfo, -1);
+
+                auto numClients = snd_seq_system_info_get_cur_clients (systemInfo);
+
+                while (--numClients >= 0)
+                {
+                    if (snd_seq_query_next_client (seqHandle, clientInfo) == 0)
+                    {
+                        ClientPortList portList;
+                        readClientPortList (clientInfo, portList);
+
+                        if (! (portList.inputs.isEmpty() && portList.outputs.isEmpty()))
+                            newCache[snd_seq_client_info_get_client (clientInfo)] = std::move (portList);
+                    }
+                }
+            }
+        }
+
+        const ScopedLock sl (deviceCacheLock);
+        deviceCache = std::move (newCache);
+        deviceCacheValid = true;
+    }
+
+    void invalidateDeviceCache()
+    {
+        const ScopedLock sl (deviceCacheLock);
+        deviceCacheValid = false;
+        deviceCache.clear();
+    }
+
+    bool getCachedDevices (bool forInput, Array<MidiDeviceInfo>& devices)
+    {
+        const ScopedLock sl (deviceCacheLock);
+
+        if (! deviceCacheValid)
+            return false;
+
+        for (auto& client : deviceCache)
+            devices.addArray (forInput ? client.second.inputs : client.second.outputs);
+
+        return true;
+    }
+
+    // Opens a port using only the cached device list, avoiding a full rescan.
+    // Returns nullptr if the cache isn't being maintained or the device is unknown.
+    Port* openPortForIdentifier (bool forInput, const String& identifier)
+    {
+        MidiDeviceInfo device;
+
+        {
+            const ScopedLock sl (deviceCacheLock);
+
+            if (! deviceCacheValid)
+                return nullptr;
+
+            bool found = false;
+
+            for (auto& client : deviceCache)
+            {
+                for (auto& d : (forInput ? client.second.inputs : client.second.outputs))
+                {
+                    if (d.identifier == identifier)
+                    {
+                        device = d;
+                        found = true;
+                        break;
+                    }
+                }
+
+                if (found)
+                    break;
+            }
+
+            if (! found)
+                return nullptr;
+        }
+
+        auto sourceClient = identifier.upToFirstOccurrenceOf ("-", false, false).getIntValue();
+        auto sourcePort = identifier.fromFirstOccurrenceOf ("-", false, false).getIntValue();
+
+        auto* port = createPort (device.name, forInput, false);
+        jassert (port->isValid());
+        port->connectWith (sourceClient, sourcePort);
+        return port;
+    }
+
+    // Called from the input thread when the system announces a change, so that
+    // only the affected client has to be re-enumerated.
+    void handleAnnouncement (const snd_seq_event_t* event)
+    {
+        bool changed = false;
+        auto affectedClient = event->data.addr.client;
+
+        switch (event->type)
+        {
+            case SND_SEQ_EVENT_CLIENT_EXIT:
+                changed = removeClientFromCache (affectedClient);
+                break;
+
+            case SND_SEQ_EVENT_CLIENT_START:
+            case SND_SEQ_EVENT_CLIENT_CHANGE:
+            case SND_SEQ_EVENT_PORT_START:
+            case SND_SEQ_EVENT_PORT_EXIT:
+            case SND_SEQ_EVENT_PORT_CHANGE:
+                changed = refreshClientInCache (affectedClient);
+                break;
+
+            default:
+                break;
+        }
+
+        if (changed)
+            MidiDeviceListConnectionBroadcaster::get().notify();
+    }
+
 private:
+    //==============================================================================
+    void readClientPortList (snd_seq_client_info_t* clientInfo, ClientPortList& result) const
+    {
+        snd_seq_port_info_t* portInfo = nullptr;
+        snd_seq_port_info_alloca (&portInfo);
+
+        auto numPorts = snd_seq_client_info_get_num_ports (clientInfo);
+        auto sourceClient = snd_seq_client_info_get_client (clientInfo);
+
+        snd_seq_port_info_set_client (portInfo, sourceClient);
+        snd_seq_port_info_set_port (portInfo, -1);
+
+        while (--numPorts >= 0)
+        {
+            if (snd_seq_query_next_port (handle, portInfo) == 0)
+            {
+                auto caps = snd_seq_port_info_get_capability (portInfo);
+
+                if ((caps & (SND_SEQ_PORT_CAP_SUBS_READ | SND_SEQ_PORT_CAP_SUBS_WRITE)) == 0)
+                    continue;
+
+                MidiDeviceInfo device (snd_seq_port_info_get_name (portInfo),
+                                       getFormattedPortIdentifier (sourceClient,
+                                                                   snd_seq_port_info_get_port (portInfo)));
+
+                if ((caps & SND_SEQ_PORT_CAP_SUBS_READ) != 0)
+                    result.inputs.add (device);
+
+                if ((caps & SND_SEQ_PORT_CAP_SUBS_WRITE) != 0)
+                    result.outputs.add (device);
+            }
+        }
+    }
+
+    bool removeClientFromCache (int clientId)
+    {
+        const ScopedLock sl (deviceCacheLock);
+
+        if (! deviceCacheValid)
+            return false;
+
+        return deviceCache.erase (clientId) != 0;
+    }
+
+    bool refreshClientInCache (int clientId)
+    {
+        ClientPortList portList;
+        bool clientExists = false;
+
+        {
+            snd_seq_client_info_t* clientInfo = nullptr;
+            snd_seq_client_info_alloca (&clientInfo);
+
+            if (snd_seq_get_any_client_info (handle, clientId, clientInfo) == 0)
+            {
+                clientExists = true;
+                readClientPortList (clientInfo, portList);
+            }
+        }
+
+        const ScopedLock sl (deviceCacheLock);
+
+        if (! deviceCacheValid)
+            return false;
+
+        auto existing = deviceCache.find (clientId);
+
+        if (! clientExists || (portList.inputs.isEmpty() && portList.outputs.isEmpty()))
+        {
+            if (existing == deviceCache.end())
+                return false;
+
+            deviceCache.erase (existing);
+            return true;
+        }
+
+        if (existing != deviceCache.end()
+             && existing->second.inputs == portList.inputs
+             && existing->second.outputs == portList.outputs)
+            return false;
+
+        deviceCache[clientId] = std::move (portList);
+        return true;
+    }
+
+    std::map<int, ClientPortList> deviceCache;
+    bool deviceCacheValid = false;
+    CriticalSection deviceCacheLock;
+
     snd_seq_t* handle = nullptr;
     int clientId = 0;
     OwnedArray<Port> ports;
@@ -321,6 +554,19 @@ private:
 
             if (snd_midi_event_new (maxEventSize, &midiParser) >= 0)
             {
+                // subscribe to the system announce port, so that hot-plug events can
+                // update the device cache without a full rescan
+                auto announcePortId = snd_seq_create_simple_port (seqHandle, "announcements",
+                                                                  SND_SEQ_PORT_CAP_WRITE | SND_SEQ_PORT_CAP_NO_EXPORT,
+                                                                  SND_SEQ_PORT_TYPE_APPLICATION);
+
+                if (announcePortId >= 0)
+                {
+                    snd_seq_connect_from (seqHandle, announcePortId,
+                                          SND_SEQ_CLIENT_SYSTEM, SND_SEQ_PORT_SYSTEM_ANNOUNCE);
+                    client.buildDeviceCache();
+                }
+
                 auto numPfds = snd_seq_poll_descriptors_count (seqHandle, POLLIN);
                 HeapBlock<pollfd> pfd (numPfds);
                 snd_seq_poll_descriptors (seqHandle, pfd, (unsigned int) numPfds, POLLIN);
@@ -340,6 +586,13 @@ private:
 
                             if (snd_seq_event_input (seqHandle, &inputEvent) >= 0)
                             {
+                                if (announcePortId >= 0 && inputEvent->dest.port == announcePortId)
+                                {
+                                    client.handleAnnouncement (inputEvent);
+                                    snd_seq_free_event (inputEvent);
+                                    continue;
+                                }
+
                                 // xxx what about SYSEXes that are too big for the buffer?
                                 auto numBytes = snd_midi_event_decode (midiParser, buffer,
                                                                        maxEventSize, inputEvent);
@@ -357,6 +610,12 @@ private:
                     }
                 }
 
+                if (announcePortId >= 0)
+                {
+                    client.invalidateDeviceCache();
+                    snd_seq_delete_simple_port (seqHandle, announcePortId);
+                }
+
                 snd_midi_event_free (midiParser);
             }
         }
@@ -371,12 +630,6 @@ private:
 
 AlsaClient* AlsaClient::instance = nullptr;
 
-//==============================================================================
-static String getFormattedPortIdentifier (int clientId, int portId)
-{
-    return String (clientId) + "-" + String (portId);
-}
-
 static AlsaClient::Port* iterateMidiClient (const AlsaClient::Ptr& client,
                                             snd_seq_client_info_t* clientInfo,
                                             bool forInput,
@@ -473,6 +726,28 @@ struct AlsaPortPtr
     AlsaClient::Port* ptr = nullptr;
 };
 
+//==============================================================================
+// Keeps the shared client (and with it the announcement subscription and the
+// incremental device cache) alive while any MidiDeviceListConnection exists.
+struct AlsaDeviceListWatcher
+{
+    AlsaDeviceListWatcher()  : client (AlsaClient::getInstance())   { client->registerCallback(); }
+    ~AlsaDeviceListWatcher()                                        { client->unregisterCallback(); }
+
+    AlsaClient::Ptr client;
+};
+
+struct AlsaDeviceListWatcherFactory
+{
+    AlsaDeviceListWatcherFactory()
+    {
+        MidiDeviceListConnectionBroadcaster::getNativeWatcherFactory()
+            = []() -> std::shared_ptr<void> { return std::make_shared<AlsaDeviceListWatcher>(); };
+    }
+};
+
+static AlsaDeviceListWatcherFactory alsaDeviceListWatcherFactory;
+
 //==============================================================================
 class MidiInput::Pimpl : public AlsaPortPtr
 {
@@ -483,7 +758,10 @@ public:
 Array<MidiDeviceInfo> MidiInput::getAvailableDevices()
 {
     Array<MidiDeviceInfo> devices;
-    iterateMidiDevices (true, devices, {});
+    auto client = AlsaClient::getInstance();
+
+    if (! client->getCachedDevices (true, devices))
+        iterateMidiDevices (true, devices, {});
 
     return devices;
 }
@@ -498,14 +776,18 @@ std::unique_ptr<MidiInput> MidiInput::openDevice (const String& deviceIdentifier
     if (deviceIdentifier.isEmpty())
         return {};
 
-    Array<MidiDeviceInfo> devices;
-    auto* port = iterateMidiDevices (true, devices, deviceIdentifier);
+    auto client = AlsaClient::getInstance();
+    auto* port = client->openPortForIdentifier (true, deviceIdentifier);
+
+    if (port == nullptr)
+    {
+        Array<MidiDeviceInfo> devices;
+        port = iterateMidiDevices (true, devices, deviceIdentifier);
+    }
 
     if (port == nullptr || ! port->isValid())
         return {};
 
-    jassert (port->isValid());
-
     std::unique_ptr<MidiInput> midiInput (new MidiInput (port->getPortName(), deviceIdentifier));
 
     port->setupInput (midiInput.get(), callback);
@@ -582,7 +864,10 @@ public:
 Array<MidiDeviceInfo> MidiOutput::getAvailableDevices()
 {
     Array<MidiDeviceInfo> devices;
-    iterateMidiDevices (false, devices, {});
+    auto client = AlsaClient::getInstance();
+
+    if (! client->getCachedDevices (false, devices))
+        iterateMidiDevices (false, devices, {});
 
     return devices;
 }
@@ -597,8 +882,14 @@ std::unique_ptr<MidiOutput> MidiOutput::openDevice (const String& deviceIdentifi
     if (deviceIdentifier.isEmpty())
         return {};
 
-    Array<MidiDeviceInfo> devices;
-    auto* port = iterateMidiDevices (false, devices, deviceIdentifier);
+    auto client = AlsaClient::getInstance();
+    auto* port = client->openPortForIdentifier (false, deviceIdentifier);
+
+    if (port == nullptr)
+    {
+        Array<MidiDeviceInfo> devices;
+        port = iterateMidiDevices (false, devices, deviceIdentifier);
+    }
 
     if (port == nullptr || ! port->isValid())
         return {};
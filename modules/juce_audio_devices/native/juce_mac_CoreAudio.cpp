@@ -196,6 +196,11 @@ public:
         AudioObjectRemovePropertyListener (deviceID, &pa, deviceListenerProc, this);
 
         stop (false);
+
+       #if JUCE_AUDIOWORKGROUP_TYPES_AVAILABLE
+        if (ioThreadWorkgroup != nullptr)
+            os_release (ioThreadWorkgroup);
+       #endif
     }
 
     void allocateTempBuffers()
@@ -407,6 +412,32 @@ public:
         return (int) framesPerBuf;
     }
 
+    AudioWorkgroup getWorkgroup()
+    {
+       #if JUCE_AUDIOWORKGROUP_TYPES_AVAILABLE
+        if (__builtin_available (macOS 11.0, iOS 14.0, *))
+        {
+            if (ioThreadWorkgroup == nullptr && deviceID != 0)
+            {
+                AudioObjectPropertyAddress pa;
+                pa.mScope = kAudioObjectPropertyScopeWildcard;
+                pa.mElement = juceAudioObjectPropertyElementMain;
+                pa.mSelector = kAudioDevicePropertyIOThreadOSWorkgroup;
+
+                os_workgroup_t workgroup = nullptr;
+                UInt32 size = sizeof (workgroup);
+
+                if (OK (AudioObjectGetPropertyData (deviceID, &pa, 0, nullptr, &size, &workgroup)))
+                    ioThreadWorkgroup = workgroup;  // released in the destructor
+            }
+
+            return AudioWorkgroup (ioThreadWorkgroup);
+        }
+       #endif
+
+        return {};
+    }
+
     bool isDeviceAlive() const
     {
         AudioObjectPropertyAddress pa;
@@ -852,6 +883,7 @@ private:
 
     Array<CallbackDetailsForChannel> inputChannelInfo, outputChannelInfo;
     HeapBlock<float*> tempInputBuffers, tempOutputBuffers;
+    void* ioThreadWorkgroup = nullptr;  // an os_workgroup_t, where available
 
     //==============================================================================
     void timerCallback() override
@@ -1021,6 +1053,7 @@ public:
     int getCurrentBitDepth() override                   { return internal->bitDepth; }
     int getCurrentBufferSizeSamples() override          { return internal->getBufferSize(); }
     int getXRunCount() const noexcept override          { return internal->xruns; }
+    AudioWorkgroup getWorkgroup() const override        { return internal->getWorkgroup(); }
 
     int getDefaultBufferSize() override
     {
@@ -50,6 +50,9 @@ void AudioTransportSource::setSource (PositionableAudioSource* const newSource,
     PositionableAudioSource* newPositionableSource = nullptr;
     AudioSource* newMasterSource = nullptr;
 
+    if (newSource != nullptr)
+        seekCrossfadeBuffer.setSize (jmax (2, maxNumChannels), seekCrossfadeLength, false, false, true);
+
     std::unique_ptr<ResamplingAudioSource> oldResamplerSource (resamplerSource);
     std::unique_ptr<BufferingAudioSource> oldBufferingSource (bufferingSource);
     AudioSource* oldMasterSource = masterSource;
@@ -97,6 +100,7 @@ void AudioTransportSource::setSource (PositionableAudioSource* const newSource,
         readAheadBufferSize = readAheadSize;
         sourceSampleRate = sourceSampleRateToCorrectFor;
 
+        pendingSeekPosition = -1;
         playing = false;
     }
 
@@ -138,6 +142,12 @@ void AudioTransportSource::setPosition (double newPosition)
         setNextReadPosition ((int64) (newPosition * sampleRate));
 }
 
+void AudioTransportSource::setPositionAsync (double newPosition)
+{
+    if (sampleRate > 0.0)
+        pendingSeekPosition = jmax ((int64) 0, (int64) (newPosition * sampleRate));
+}
+
 double AudioTransportSource::getCurrentPosition() const
 {
     if (sampleRate > 0.0)
@@ -161,6 +171,12 @@ bool AudioTransportSource::hasStreamFinished() const noexcept
 }
 
 void AudioTransportSource::setNextReadPosition (int64 newPosition)
+{
+    pendingSeekPosition = -1;
+    applyNextReadPosition (newPosition);
+}
+
+void AudioTransportSource::applyNextReadPosition (int64 newPosition)
 {
     if (positionableSource != nullptr)
     {
@@ -176,6 +192,11 @@ void AudioTransportSource::setNextReadPosition (int64 newPosition)
 
 int64 AudioTransportSource::getNextReadPosition() const
 {
+    const auto pendingSeek = pendingSeekPosition.load();
+
+    if (pendingSeek >= 0)
+        return pendingSeek;
+
     const ScopedLock sl (callbackLock);
 
     if (positionableSource != nullptr)
@@ -248,8 +269,37 @@ void AudioTransportSource::getNextAudioBlock (const AudioSourceChannelInfo& info
 
     if (masterSource != nullptr && ! stopped)
     {
+        const auto seekTarget = pendingSeekPosition.exchange (-1);
+        const auto fadeLength = seekTarget >= 0 ? jmin (seekCrossfadeLength, info.numSamples,
+                                                        seekCrossfadeBuffer.getNumSamples()) : 0;
+
+        if (fadeLength > 0)
+        {
+            // A seek was posted from another thread - grab the tail of the
+            // outgoing position before jumping, so the two can be crossfaded.
+            AudioSourceChannelInfo fadeInfo (&seekCrossfadeBuffer, 0, fadeLength);
+            fadeInfo.clearActiveBufferRegion();
+            masterSource->getNextAudioBlock (fadeInfo);
+
+            applyNextReadPosition (seekTarget);
+        }
+        else if (seekTarget >= 0)
+        {
+            applyNextReadPosition (seekTarget);
+        }
+
         masterSource->getNextAudioBlock (info);
 
+        if (fadeLength > 0)
+        {
+            for (int i = info.buffer->getNumChannels(); --i >= 0;)
+                info.buffer->applyGainRamp (i, info.startSample, fadeLength, 0.0f, 1.0f);
+
+            for (int i = jmin (info.buffer->getNumChannels(), seekCrossfadeBuffer.getNumChannels()); --i >= 0;)
+                info.buffer->addFromWithRamp (i, info.startSample, seekCrossfadeBuffer.getReadPointer (i),
+                                              fadeLength, 1.0f, 0.0f);
+        }
+
         if (! playing)
         {
             // just stopped playing, so fade out the last block..
@@ -273,6 +323,11 @@ void AudioTransportSource::getNextAudioBlock (const AudioSourceChannelInfo& info
     }
     else
     {
+        const auto seekTarget = pendingSeekPosition.exchange (-1);
+
+        if (seekTarget >= 0)
+            applyNextReadPosition (seekTarget);
+
         info.clearActiveBufferRegion();
         stopped = true;
     }
@@ -280,4 +335,97 @@ void AudioTransportSource::getNextAudioBlock (const AudioSourceChannelInfo& info
     lastGain = gain;
 }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioTransportSourceTests  : public UnitTest
+{
+public:
+    AudioTransportSourceTests()
+        : UnitTest ("AudioTransportSource", UnitTestCategories::audio) {}
+
+    void runTest() override
+    {
+        constexpr int blockSize = 512;
+        constexpr double rate = 44100.0;
+        constexpr int sourceLength = 8192;
+
+        // Each sample holds its own index, so the read position is visible in the output.
+        AudioBuffer<float> sourceData (1, sourceLength);
+
+        for (int i = 0; i < sourceLength; ++i)
+            sourceData.setSample (0, i, (float) i * 0.001f);
+
+        MemoryAudioSource memorySource (sourceData, false);
+        AudioTransportSource transport;
+        transport.setSource (&memorySource);
+        transport.prepareToPlay (blockSize, rate);
+        transport.start();
+
+        AudioBuffer<float> block (1, blockSize);
+        AudioSourceChannelInfo info (&block, 0, blockSize);
+
+        beginTest ("Posted seeks are visible immediately and applied by the next callback");
+        {
+            transport.getNextAudioBlock (info);
+            expectWithinAbsoluteError (block.getSample (0, blockSize - 1),
+                                       (float) (blockSize - 1) * 0.001f, 1.0e-4f);
+
+            // Seconds-to-samples conversion may truncate by one, so read back the
+            // exact sample target that was posted.
+            transport.setPositionAsync (4096.0 / rate);
+
+            // The pending position is reported before the audio thread has applied it.
+            const auto target = transport.getNextReadPosition();
+            expect (std::abs (target - 4096) <= 1);
+
+            transport.getNextAudioBlock (info);
+
+            // Beyond the crossfade, the block reads from the new position.
+            for (int i = 200; i < blockSize; ++i)
+                expectWithinAbsoluteError (block.getSample (0, i),
+                                           (float) (target + i) * 0.001f, 1.0e-4f);
+
+            // Within it, the old and new streams are blended with unity-sum gains.
+            const float oldStart = (float) blockSize * 0.001f;
+
+            expectWithinAbsoluteError (block.getSample (0, 0), oldStart, 2.0e-3f);
+
+            for (int i = 0; i < 128; ++i)
+            {
+                const auto mix = (float) i / 128.0f;
+                const auto expected = mix * (float) (target + i) * 0.001f
+                                    + (1.0f - mix) * (oldStart + (float) i * 0.001f);
+
+                expectWithinAbsoluteError (block.getSample (0, i), expected, 2.0e-3f);
+            }
+        }
+
+        beginTest ("The latest of several posted seeks wins, and blocking seeks cancel them");
+        {
+            transport.setPositionAsync (1000.0 / rate);
+            transport.setPositionAsync (2000.0 / rate);
+            expect (std::abs (transport.getNextReadPosition() - 2000) <= 1);
+
+            transport.setPositionAsync (3000.0 / rate);
+            transport.setNextReadPosition (1500);
+            expectEquals (transport.getNextReadPosition(), (int64) 1500);
+
+            transport.getNextAudioBlock (info);
+
+            for (int i = 200; i < blockSize; ++i)
+                expectWithinAbsoluteError (block.getSample (0, i),
+                                           (float) (1500 + i) * 0.001f, 1.0e-4f);
+        }
+
+        transport.setSource (nullptr);
+    }
+};
+
+static AudioTransportSourceTests audioTransportSourceTests;
+
+#endif
+
 } // namespace juce
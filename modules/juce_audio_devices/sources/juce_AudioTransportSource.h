@@ -93,6 +93,26 @@ public:
     */
     void setPosition (double newPosition);
 
+    /** Changes the playback position without blocking the audio callback.
+
+        Unlike setPosition, this never touches the callback lock or repositions
+        the source chain itself: the request is posted to an atomic mailbox, and
+        the next audio callback performs the jump, crossfading from the old
+        position to the new one over the first few milliseconds of the block to
+        avoid a click. Rapid calls coalesce, with the latest request winning, so
+        this is safe to call from a scrub control at mouse-move rate.
+
+        The target is honoured to the exact sample; it takes effect at the start
+        of the next audio callback. If nothing is currently playing, the
+        position is simply applied (without a crossfade) by the next callback or
+        when playback starts.
+
+        @param newPosition    the new playback position in seconds
+
+        @see setPosition, getCurrentPosition
+    */
+    void setPositionAsync (double newPosition);
+
     /** Returns the position that the next data block will be read from
         This is a time in seconds.
     */
@@ -172,6 +192,11 @@ private:
     int blockSize = 128, readAheadBufferSize = 0;
     bool isPrepared = false;
 
+    static constexpr int seekCrossfadeLength = 128;
+    std::atomic<int64> pendingSeekPosition { -1 };
+    AudioBuffer<float> seekCrossfadeBuffer;
+
+    void applyNextReadPosition (int64 newPosition);
     void releaseMasterResources();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioTransportSource)
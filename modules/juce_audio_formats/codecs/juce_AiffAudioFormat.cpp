@@ -975,12 +975,104 @@ bool AiffAudioFormat::canHandleFile (const File& f)
 }
 #endif
 
+bool AiffAudioFormat::scanBasicProperties (InputStream& input, BasicProperties& result)
+{
+    using namespace AiffFileHelpers;
+    result = {};
+
+    int bytesPerFrame = 0;
+    bool hasGotType = false, hasGotData = false;
+
+    if (input.readInt() != chunkName ("FORM"))
+        return false;
+
+    auto len = input.readIntBigEndian();
+    auto end = input.getPosition() + len;
+    auto nextType = input.readInt();
+
+    if (nextType != chunkName ("AIFF") && nextType != chunkName ("AIFC"))
+        return false;
+
+    while (input.getPosition() < end && ! input.isExhausted())
+    {
+        auto type = input.readInt();
+        auto length = (uint32) input.readIntBigEndian();
+        auto chunkEnd = input.getPosition() + length;
+
+        if (type == chunkName ("COMM"))
+        {
+            hasGotType = true;
+
+            result.numChannels = (unsigned int) input.readShortBigEndian();
+            result.lengthInSamples = input.readIntBigEndian();
+            result.bitsPerSample = (unsigned int) input.readShortBigEndian();
+            bytesPerFrame = (int) ((result.numChannels * result.bitsPerSample) >> 3);
+
+            unsigned char sampleRateBytes[10];
+            input.read (sampleRateBytes, 10);
+            const int byte0 = sampleRateBytes[0];
+
+            if ((byte0 & 0x80) != 0
+                 || byte0 <= 0x3F || byte0 > 0x40
+                 || (byte0 == 0x40 && sampleRateBytes[1] > 0x1C))
+                break;
+
+            auto sampRate = ByteOrder::bigEndianInt (sampleRateBytes + 2);
+            sampRate >>= (16414 - ByteOrder::bigEndianShort (sampleRateBytes));
+            result.sampleRate = (int) sampRate;
+
+            if (length > 18)
+            {
+                auto compType = input.readInt();
+
+                if (compType != chunkName ("NONE") && compType != chunkName ("twos")
+                     && compType != chunkName ("sowt")
+                     && compType != chunkName ("fl32") && compType != chunkName ("FL32"))
+                {
+                    // a compressed variant - this needs the full reader, not a quick probe
+                    result = {};
+                    return false;
+                }
+            }
+        }
+        else if (type == chunkName ("SSND"))
+        {
+            hasGotData = true;
+
+            if (bytesPerFrame > 0)
+                result.lengthInSamples = jmin (result.lengthInSamples, ((int64) length) / (int64) bytesPerFrame);
+        }
+
+        if (hasGotType && hasGotData)
+            break;
+
+        input.setPosition (chunkEnd);
+    }
+
+    if (hasGotType && hasGotData && result.sampleRate > 0 && result.numChannels > 0 && bytesPerFrame > 0)
+        return true;
+
+    result = {};
+    return false;
+}
+
 AudioFormatReader* AiffAudioFormat::createReaderFor (InputStream* sourceStream, bool deleteStreamIfOpeningFails)
 {
     std::unique_ptr<AiffAudioFormatReader> w (new AiffAudioFormatReader (sourceStream));
 
     if (w->sampleRate > 0 && w->numChannels > 0)
+    {
+        // If the source is a mapped-file view, reads are zero-copy - tell the
+        // OS to start paging the sample data in ahead of the reader.
+        if (auto* mappedStream = dynamic_cast<MemoryMappedInputStream*> (sourceStream))
+        {
+            mappedStream->hintSequentialAccess();
+            mappedStream->hintRangeWillBeNeeded ({ w->dataChunkStart,
+                                                   w->dataChunkStart + w->lengthInSamples * w->bytesPerFrame });
+        }
+
         return w.release();
+    }
 
     if (! deleteStreamIfOpeningFails)
         w->input = nullptr;
@@ -73,6 +73,12 @@ public:
    #endif
 
     //==============================================================================
+    /** Probes only the FORM header and the COMM/SSND chunk headers, skipping
+        markers, comments and other metadata chunks entirely.
+        @see AudioFormat::scanBasicProperties
+    */
+    bool scanBasicProperties (InputStream& stream, BasicProperties& result) override;
+
     AudioFormatReader* createReaderFor (InputStream* sourceStream,
                                         bool deleteStreamIfOpeningFails) override;
 
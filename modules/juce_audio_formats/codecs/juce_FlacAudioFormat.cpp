@@ -372,6 +372,429 @@ private:
 };
 
 
+//==============================================================================
+/**
+    A memory-mapped FLAC reader for fast random access.
+
+    The whole file is mapped into memory and a seek-table of frame byte offsets
+    is built by scanning the frame headers when the mapping is created (no
+    audio is decoded during the scan). Random-access reads then jump straight
+    to the frame containing the requested sample and decode only the touched
+    frames, instead of paying for a full stream re-sync on every seek.
+*/
+class MemoryMappedFlacReader  : public MemoryMappedAudioFormatReader
+{
+public:
+    MemoryMappedFlacReader (const File& flacFile, const FlacReader& details)
+        : MemoryMappedAudioFormatReader (flacFile, details, 0, flacFile.getSize(), 1)
+    {
+        decoder = FlacNamespace::FLAC__stream_decoder_new();
+    }
+
+    ~MemoryMappedFlacReader() override
+    {
+        FlacNamespace::FLAC__stream_decoder_delete (decoder);
+    }
+
+    bool mapSectionOfFile (Range<int64>) override
+    {
+        // Compressed frames don't map linearly onto byte ranges, so the whole
+        // file is always mapped, whatever section was asked for.
+        if (map == nullptr)
+        {
+            map.reset (new MemoryMappedFile (file, MemoryMappedFile::readOnly));
+
+            if (map->getData() == nullptr)
+            {
+                map.reset();
+                return false;
+            }
+
+            if (! initialiseDecoder() || ! buildFrameIndex())
+            {
+                map.reset();
+                return false;
+            }
+        }
+
+        mappedSection = Range<int64> (0, lengthInSamples);
+        return true;
+    }
+
+    bool readSamples (int** destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                      int64 startSampleInFile, int numSamples) override
+    {
+        clearSamplesBeyondAvailableLength (destSamples, numDestChannels, startOffsetInDestBuffer,
+                                           startSampleInFile, numSamples, lengthInSamples);
+
+        if (map == nullptr || ! mappedSection.contains (Range<int64> (startSampleInFile, startSampleInFile + numSamples)))
+        {
+            jassertfalse; // you must make sure that the window contains all the samples you're going to attempt to read.
+            return false;
+        }
+
+        const auto getBufferedRange = [this] { return bufferedRange; };
+
+        const auto readFromReservoir = [this, &destSamples, &numDestChannels, &startOffsetInDestBuffer, &startSampleInFile] (const Range<int64> rangeToRead)
+        {
+            const auto bufferIndices = rangeToRead - bufferedRange.getStart();
+            const auto writePos = (int64) startOffsetInDestBuffer + (rangeToRead.getStart() - startSampleInFile);
+
+            for (int i = jmin (numDestChannels, reservoir.getNumChannels()); --i >= 0;)
+            {
+                if (destSamples[i] != nullptr)
+                {
+                    memcpy (destSamples[i] + writePos,
+                            reservoir.getReadPointer (i) + bufferIndices.getStart(),
+                            (size_t) bufferIndices.getLength() * sizeof (int));
+                }
+            }
+        };
+
+        const auto fillReservoir = [this] (const int64 requestedStart)
+        {
+            decodeFrameContaining (requestedStart);
+        };
+
+        const auto remainingSamples = Reservoir::doBufferedRead (Range<int64> { startSampleInFile, startSampleInFile + numSamples },
+                                                                 getBufferedRange,
+                                                                 readFromReservoir,
+                                                                 fillReservoir);
+
+        if (! remainingSamples.isEmpty())
+            for (int i = numDestChannels; --i >= 0;)
+                if (destSamples[i] != nullptr)
+                    zeromem (destSamples[i] + startOffsetInDestBuffer, (size_t) remainingSamples.getLength() * sizeof (int));
+
+        return true;
+    }
+
+    void getSample (int64 sample, float* result) const noexcept override
+    {
+        auto num = (int) numChannels;
+
+        if (map == nullptr || ! mappedSection.contains (sample))
+        {
+            jassertfalse; // you must make sure that the window contains all the samples you're going to attempt to read.
+
+            zeromem (result, (size_t) num * sizeof (float));
+            return;
+        }
+
+        auto& self = *const_cast<MemoryMappedFlacReader*> (this);
+
+        if (! self.decodeFrameContaining (sample))
+        {
+            zeromem (result, (size_t) num * sizeof (float));
+            return;
+        }
+
+        auto offset = (int) (sample - bufferedRange.getStart());
+
+        for (int i = 0; i < num; ++i)
+            result[i] = (float) (reinterpret_cast<const int*> (reservoir.getReadPointer (i))[offset]
+                                    * (1.0 / 0x80000000u));
+    }
+
+    void useMetadata (const FlacNamespace::FLAC__StreamMetadata_StreamInfo& info)
+    {
+        nominalBlockSize = (int) info.min_blocksize;
+        maxBlockSize = (int) info.max_blocksize;
+
+        reservoir.setSize ((int) numChannels, jmax (1, maxBlockSize), false, false, true);
+    }
+
+    void useSamples (const FlacNamespace::FLAC__Frame& frame, const FlacNamespace::FLAC__int32* const buffer[])
+    {
+        auto numSamples = (int) frame.header.blocksize;
+
+        if (numSamples > reservoir.getNumSamples())
+            reservoir.setSize ((int) numChannels, numSamples, false, false, true);
+
+        auto bitsToShift = 32 - bitsPerSample;
+
+        for (int i = 0; i < (int) numChannels; ++i)
+        {
+            auto* src = buffer[i];
+            int n = i;
+
+            while (src == nullptr && n > 0)
+                src = buffer [--n];
+
+            if (src != nullptr)
+            {
+                auto* dest = reinterpret_cast<int*> (reservoir.getWritePointer (i));
+
+                for (int j = 0; j < numSamples; ++j)
+                    dest[j] = src[j] << bitsToShift;
+            }
+        }
+
+        auto frameStart = frame.header.number_type == FlacNamespace::FLAC__FRAME_NUMBER_TYPE_SAMPLE_NUMBER
+                            ? (int64) frame.header.number.sample_number
+                            : (int64) frame.header.number.frame_number * nominalBlockSize;
+
+        bufferedRange = Range<int64> (frameStart, frameStart + numSamples);
+    }
+
+    //==============================================================================
+    static FlacNamespace::FLAC__StreamDecoderReadStatus readCallback_ (const FlacNamespace::FLAC__StreamDecoder*, FlacNamespace::FLAC__byte buffer[], size_t* bytes, void* client_data)
+    {
+        auto& self = *static_cast<MemoryMappedFlacReader*> (client_data);
+        auto numAvailable = jmax ((int64) 0, (int64) self.map->getSize() - self.readPosition);
+        auto num = jmin ((int64) *bytes, numAvailable);
+
+        memcpy (buffer, addBytesToPointer (self.map->getData(), self.readPosition), (size_t) num);
+        self.readPosition += num;
+        *bytes = (size_t) num;
+
+        return num > 0 ? FlacNamespace::FLAC__STREAM_DECODER_READ_STATUS_CONTINUE
+                       : FlacNamespace::FLAC__STREAM_DECODER_READ_STATUS_END_OF_STREAM;
+    }
+
+    static FlacNamespace::FLAC__StreamDecoderWriteStatus writeCallback_ (const FlacNamespace::FLAC__StreamDecoder*,
+                                                                         const FlacNamespace::FLAC__Frame* frame,
+                                                                         const FlacNamespace::FLAC__int32* const buffer[],
+                                                                         void* client_data)
+    {
+        static_cast<MemoryMappedFlacReader*> (client_data)->useSamples (*frame, buffer);
+        return FlacNamespace::FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
+    }
+
+    static void metadataCallback_ (const FlacNamespace::FLAC__StreamDecoder*,
+                                   const FlacNamespace::FLAC__StreamMetadata* metadata,
+                                   void* client_data)
+    {
+        static_cast<MemoryMappedFlacReader*> (client_data)->useMetadata (metadata->data.stream_info);
+    }
+
+    static void errorCallback_ (const FlacNamespace::FLAC__StreamDecoder*, FlacNamespace::FLAC__StreamDecoderErrorStatus, void*)
+    {
+    }
+
+private:
+    //==============================================================================
+    bool initialiseDecoder()
+    {
+        readPosition = 0;
+
+        if (FLAC__stream_decoder_init_stream (decoder,
+                                              readCallback_, nullptr, nullptr, nullptr, nullptr,
+                                              writeCallback_, metadataCallback_, errorCallback_,
+                                              this) != FlacNamespace::FLAC__STREAM_DECODER_INIT_STATUS_OK)
+            return false;
+
+        return FLAC__stream_decoder_process_until_end_of_metadata (decoder) != 0
+                && maxBlockSize > 0;
+    }
+
+    //==============================================================================
+    struct FrameOffset
+    {
+        int64 byteOffset, firstSample;
+    };
+
+    // Scans the mapped file for frame headers, validating each candidate sync
+    // code by parsing the header and checking its CRC-8. No audio is decoded.
+    // A false positive here is extremely unlikely, but also harmless: it would
+    // only make a seek land slightly off-target, and the decoder re-syncs and
+    // reports the true frame positions while decoding.
+    bool buildFrameIndex()
+    {
+        auto* d = static_cast<const uint8*> (map->getData());
+        auto size = (int64) map->getSize();
+
+        if (size < 8 || memcmp (d, "fLaC", 4) != 0)
+            return false;
+
+        // skip the metadata blocks to find the first frame
+        int64 pos = 4;
+
+        for (;;)
+        {
+            if (pos + 4 > size)
+                return false;
+
+            auto header = d[pos];
+            auto length = ((int64) d[pos + 1] << 16) | ((int64) d[pos + 2] << 8) | (int64) d[pos + 3];
+            pos += 4 + length;
+
+            if ((header & 0x80) != 0)
+                break;
+        }
+
+        int64 lastSample = 0;
+
+        for (int64 i = pos; i + 16 < size; ++i)
+        {
+            if (d[i] == 0xff && (d[i + 1] & 0xfe) == 0xf8)
+            {
+                int64 firstSample;
+                int headerLength;
+
+                if (parseFrameHeader (d + i, (int) jmin ((int64) 32, size - i), firstSample, headerLength)
+                     && firstSample >= lastSample
+                     && firstSample <= lengthInSamples)
+                {
+                    frameIndex.add ({ i, firstSample });
+                    lastSample = firstSample;
+                    i += headerLength - 1;
+                }
+            }
+        }
+
+        return ! frameIndex.isEmpty();
+    }
+
+    bool parseFrameHeader (const uint8* d, int numAvailable, int64& firstSample, int& headerLength) const noexcept
+    {
+        auto blockingStrategy = (d[1] & 1) != 0;
+        auto blockSizeCode    = d[2] >> 4;
+        auto sampleRateCode   = d[2] & 0x0f;
+        auto channelCode      = d[3] >> 4;
+        auto sampleSizeCode   = (d[3] >> 1) & 7;
+
+        if (blockSizeCode == 0 || sampleRateCode == 15
+             || channelCode > 10 || sampleSizeCode == 3 || sampleSizeCode == 7
+             || (d[3] & 1) != 0)
+            return false;
+
+        auto numFrameChannels = channelCode < 8 ? channelCode + 1 : 2;
+
+        if (numFrameChannels != (int) numChannels)
+            return false;
+
+        int pos = 4;
+        uint64 frameOrSampleNumber;
+
+        if (! readUtf8Number (d, numAvailable, pos, frameOrSampleNumber))
+            return false;
+
+        if (blockSizeCode == 6)        pos += 1;
+        else if (blockSizeCode == 7)   pos += 2;
+
+        if (sampleRateCode == 12)                           pos += 1;
+        else if (sampleRateCode == 13 || sampleRateCode == 14) pos += 2;
+
+        if (pos >= numAvailable)
+            return false;
+
+        if (crc8 (d, pos) != d[pos])
+            return false;
+
+        firstSample = blockingStrategy ? (int64) frameOrSampleNumber
+                                       : (int64) frameOrSampleNumber * nominalBlockSize;
+        headerLength = pos + 1;
+        return true;
+    }
+
+    static bool readUtf8Number (const uint8* d, int numAvailable, int& pos, uint64& result) noexcept
+    {
+        if (pos >= numAvailable)
+            return false;
+
+        auto first = d[pos++];
+
+        if ((first & 0x80) == 0)
+        {
+            result = first;
+            return true;
+        }
+
+        int numExtraBytes = 0;
+
+        for (auto bit = 0x40; (first & bit) != 0; bit >>= 1)
+            ++numExtraBytes;
+
+        if (numExtraBytes == 0 || numExtraBytes > 6 || pos + numExtraBytes > numAvailable)
+            return false;
+
+        result = (uint64) (first & (0x7f >> numExtraBytes));
+
+        while (--numExtraBytes >= 0)
+        {
+            auto next = d[pos++];
+
+            if ((next & 0xc0) != 0x80)
+                return false;
+
+            result = (result << 6) | (uint64) (next & 0x3f);
+        }
+
+        return true;
+    }
+
+    static uint8 crc8 (const uint8* d, int numBytes) noexcept
+    {
+        uint8 crc = 0;
+
+        while (--numBytes >= 0)
+        {
+            crc = crc ^ *d++;
+
+            for (int i = 0; i < 8; ++i)
+                crc = (uint8) ((crc & 0x80) != 0 ? (crc << 1) ^ 0x07 : crc << 1);
+        }
+
+        return crc;
+    }
+
+    //==============================================================================
+    // Decodes frames until the reservoir holds the one containing the given
+    // sample, seeking via the frame index if the target isn't just ahead of
+    // the current decode position.
+    bool decodeFrameContaining (int64 sample)
+    {
+        if (sample < 0 || sample >= lengthInSamples)
+            return false;
+
+        if (sample < bufferedRange.getStart()
+             || sample >= bufferedRange.getEnd() + 4 * (int64) maxBlockSize)
+        {
+            // binary-search the index for the last frame starting at or before the target
+            int lo = 0, hi = frameIndex.size();
+
+            while (lo < hi - 1)
+            {
+                auto mid = (lo + hi) / 2;
+
+                if (frameIndex.getReference (mid).firstSample <= sample)
+                    lo = mid;
+                else
+                    hi = mid;
+            }
+
+            auto& entry = frameIndex.getReference (lo);
+            readPosition = entry.byteOffset;
+            bufferedRange = emptyRange (entry.firstSample);
+            FLAC__stream_decoder_flush (decoder);
+        }
+
+        while (! bufferedRange.contains (sample))
+        {
+            auto posBefore = readPosition;
+            auto rangeBefore = bufferedRange;
+
+            if (FLAC__stream_decoder_process_single (decoder) == 0
+                 || (readPosition == posBefore && bufferedRange == rangeBefore))
+                return false;
+        }
+
+        return true;
+    }
+
+    //==============================================================================
+    FlacNamespace::FLAC__StreamDecoder* decoder;
+    AudioBuffer<float> reservoir;
+    Range<int64> bufferedRange;
+    Array<FrameOffset> frameIndex;
+    int64 readPosition = 0;
+    int nominalBlockSize = 0, maxBlockSize = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MemoryMappedFlacReader)
+};
+
+
 //==============================================================================
 class FlacWriter  : public AudioFormatWriter
 {
@@ -569,6 +992,24 @@ AudioFormatReader* FlacAudioFormat::createReaderFor (InputStream* in, const bool
     return nullptr;
 }
 
+MemoryMappedAudioFormatReader* FlacAudioFormat::createMemoryMappedReader (const File& file)
+{
+    return createMemoryMappedReader (file.createInputStream().release());
+}
+
+MemoryMappedAudioFormatReader* FlacAudioFormat::createMemoryMappedReader (FileInputStream* fin)
+{
+    if (fin != nullptr)
+    {
+        FlacReader reader (fin);
+
+        if (reader.sampleRate > 0 && reader.lengthInSamples > 0)
+            return new MemoryMappedFlacReader (fin->getFile(), reader);
+    }
+
+    return nullptr;
+}
+
 AudioFormatWriter* FlacAudioFormat::createWriterFor (OutputStream* out,
                                                      double sampleRate,
                                                      unsigned int numberOfChannels,
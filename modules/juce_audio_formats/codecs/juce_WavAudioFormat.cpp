@@ -1725,6 +1725,131 @@ bool WavAudioFormat::isChannelLayoutSupported (const AudioChannelSet& channelSet
     return true;
 }
 
+bool WavAudioFormat::scanBasicProperties (InputStream& input, BasicProperties& result)
+{
+    using namespace WavFileHelpers;
+    result = {};
+
+    uint64 len = 0, end = 0;
+    int64 dataLength = 0;
+    int bytesPerFrame = 0;
+    bool isRF64 = false, hasGotData = false;
+
+    auto firstChunkType = input.readInt();
+
+    if (firstChunkType == chunkName ("RF64"))
+    {
+        input.skipNextBytes (4); // size is -1 for RF64
+        isRF64 = true;
+    }
+    else if (firstChunkType == chunkName ("RIFF"))
+    {
+        len = (uint64) (uint32) input.readInt();
+        end = len + (uint64) input.getPosition();
+    }
+    else
+    {
+        return false;
+    }
+
+    auto startOfRIFFChunk = input.getPosition();
+
+    if (input.readInt() != chunkName ("WAVE"))
+        return false;
+
+    if (isRF64 && input.readInt() == chunkName ("ds64"))
+    {
+        auto length = (uint32) input.readInt();
+
+        if (length < 28)
+            return false;
+
+        auto chunkEnd = input.getPosition() + length + (length & 1);
+        len = (uint64) input.readInt64();
+        end = len + (uint64) startOfRIFFChunk;
+        dataLength = input.readInt64();
+        input.setPosition (chunkEnd);
+    }
+
+    while ((uint64) input.getPosition() < end && ! input.isExhausted())
+    {
+        auto chunkType = input.readInt();
+        auto length = (uint32) input.readInt();
+        auto chunkEnd = input.getPosition() + length + (length & 1);
+
+        if (chunkType == chunkName ("fmt "))
+        {
+            auto format = (unsigned short) input.readShort();
+            result.numChannels = (unsigned int) input.readShort();
+            auto sampleRate = input.readInt();
+            auto bytesPerSec = input.readInt();
+            input.skipNextBytes (2);
+            result.bitsPerSample = (unsigned int) (int) input.readShort();
+            result.sampleRate = sampleRate;
+
+            if (result.bitsPerSample > 64 && sampleRate != 0)
+            {
+                bytesPerFrame = bytesPerSec / sampleRate;
+
+                if (result.numChannels != 0)
+                    result.bitsPerSample = 8 * (unsigned int) bytesPerFrame / result.numChannels;
+            }
+            else
+            {
+                bytesPerFrame = (int) (result.numChannels * result.bitsPerSample / 8);
+            }
+
+            if (format == 0xfffe) // WAVE_FORMAT_EXTENSIBLE
+            {
+                if (length < 40) // too short
+                {
+                    bytesPerFrame = 0;
+                }
+                else
+                {
+                    input.skipNextBytes (8); // skip over size, bitsPerSample and channel mask
+
+                    ExtensibleWavSubFormat subFormat;
+                    subFormat.data1 = (uint32) input.readInt();
+                    subFormat.data2 = (uint16) input.readShort();
+                    subFormat.data3 = (uint16) input.readShort();
+                    input.read (subFormat.data4, sizeof (subFormat.data4));
+
+                    if (subFormat != IEEEFloatFormat && subFormat != pcmFormat && subFormat != ambisonicFormat)
+                        bytesPerFrame = 0;
+                }
+            }
+            else if (format != 1 && format != 3)
+            {
+                // a compressed subformat - this needs the full reader, not a quick probe
+                result = {};
+                return false;
+            }
+        }
+        else if (chunkType == chunkName ("data"))
+        {
+            hasGotData = true;
+
+            if (! isRF64)
+                dataLength = length;
+        }
+
+        if (hasGotData && result.sampleRate > 0)
+            break;
+
+        input.setPosition (chunkEnd);
+    }
+
+    if (hasGotData && result.sampleRate > 0 && result.numChannels > 0 && bytesPerFrame > 0)
+    {
+        result.lengthInSamples = dataLength / bytesPerFrame;
+        return true;
+    }
+
+    result = {};
+    return false;
+}
+
 AudioFormatReader* WavAudioFormat::createReaderFor (InputStream* sourceStream, bool deleteStreamIfOpeningFails)
 {
     std::unique_ptr<WavAudioFormatReader> r (new WavAudioFormatReader (sourceStream));
@@ -1738,7 +1863,17 @@ AudioFormatReader* WavAudioFormat::createReaderFor (InputStream* sourceStream, b
    #endif
 
     if (r->sampleRate > 0 && r->numChannels > 0 && r->bytesPerFrame > 0 && r->bitsPerSample <= 32)
+    {
+        // If the source is a mapped-file view, reads are zero-copy - tell the
+        // OS to start paging the sample data in ahead of the reader.
+        if (auto* mappedStream = dynamic_cast<MemoryMappedInputStream*> (sourceStream))
+        {
+            mappedStream->hintSequentialAccess();
+            mappedStream->hintRangeWillBeNeeded ({ r->dataChunkStart, r->dataChunkStart + r->dataLength });
+        }
+
         return r.release();
+    }
 
     if (! deleteStreamIfOpeningFails)
         r->input = nullptr;
@@ -1958,6 +2093,24 @@ struct WaveAudioFormatTests : public UnitTest
             expect (a[WavAudioFormat::riffInfoSource] == "source");
             expect (a[WavAudioFormat::internationalStandardRecordingCode] == "UUVVVXXYYYYY");
         }
+
+        {
+            beginTest ("scanBasicProperties finds the format details without creating a reader");
+
+            const auto mb = writeToBlock (format, metadataArray);
+
+            MemoryInputStream in (mb, false);
+            AudioFormat::BasicProperties props;
+            expect (format.scanBasicProperties (in, props));
+            expectEquals (props.sampleRate, 44100.0);
+            expectEquals ((int) props.numChannels, (int) numTestAudioBufferChannels);
+            expectEquals ((int) props.bitsPerSample, 16);
+            expectEquals (props.lengthInSamples, (int64) numTestAudioBufferSamples);
+
+            MemoryInputStream garbage ("this certainly isn't a wav file..", 33, false);
+            expect (! format.scanBasicProperties (garbage, props));
+            expectEquals (props.sampleRate, 0.0);
+        }
     }
 
 private:
@@ -194,6 +194,12 @@ public:
     bool isChannelLayoutSupported (const AudioChannelSet& channelSet) override;
 
     //==============================================================================
+    /** Probes only the RIFF/RF64, fmt and data chunk headers, skipping cue, smpl,
+        bext and other metadata chunks entirely.
+        @see AudioFormat::scanBasicProperties
+    */
+    bool scanBasicProperties (InputStream& stream, BasicProperties& result) override;
+
     AudioFormatReader* createReaderFor (InputStream* sourceStream,
                                         bool deleteStreamIfOpeningFails) override;
 
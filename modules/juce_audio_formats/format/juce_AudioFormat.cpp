@@ -73,6 +73,23 @@ bool AudioFormat::isChannelLayoutSupported (const AudioChannelSet& channelSet)
     return false;
 }
 
+bool AudioFormat::scanBasicProperties (InputStream& stream, BasicProperties& result)
+{
+    result = {};
+
+    // the wrapper keeps the caller's stream alive when the reader deletes its input
+    std::unique_ptr<AudioFormatReader> reader (createReaderFor (new SubregionStream (&stream, stream.getPosition(), -1, false), true));
+
+    if (reader == nullptr)
+        return false;
+
+    result.sampleRate      = reader->sampleRate;
+    result.lengthInSamples = reader->lengthInSamples;
+    result.numChannels     = reader->numChannels;
+    result.bitsPerSample   = reader->bitsPerSample;
+    return result.sampleRate > 0;
+}
+
 AudioFormatWriter* AudioFormat::createWriterFor (OutputStream* streamToWriteTo,
                                                  double sampleRateToUse,
                                                  const AudioChannelSet& channelLayout,
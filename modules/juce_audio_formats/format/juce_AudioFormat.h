@@ -91,6 +91,41 @@ public:
     */
     virtual StringArray getQualityOptions();
 
+    //==============================================================================
+    /** The lightweight set of properties returned by scanBasicProperties().
+        @see scanBasicProperties
+    */
+    struct BasicProperties
+    {
+        double sampleRate = 0;              /**< Zero if the scan failed. */
+        int64 lengthInSamples = 0;          /**< The number of sample frames in the file. */
+        unsigned int numChannels = 0;       /**< The number of audio channels. */
+        unsigned int bitsPerSample = 0;     /**< The bit depth of the samples in the file. */
+
+        /** Returns the duration in seconds, or zero if the scan failed. */
+        double getLengthInSeconds() const noexcept
+        {
+            return sampleRate > 0 ? (double) lengthInSamples / sampleRate : 0.0;
+        }
+    };
+
+    /** Reads just enough of a stream to find its sample rate, length, channel
+        count and bit depth, without creating a reader object.
+
+        Use this when cataloguing large numbers of files for a browser, where
+        creating a full AudioFormatReader per file - which also parses all the
+        metadata chunks - would be needlessly slow. The base class implementation
+        does fall back to opening a temporary reader, but formats with simple
+        header layouts override it with a probe that skips everything else.
+
+        The stream is left at an unspecified position. Returns false if the
+        stream doesn't contain a readable file of this format, in which case
+        the result's fields are zeroed.
+
+        @see AudioFormatManager::scanBasicProperties
+    */
+    virtual bool scanBasicProperties (InputStream& stream, BasicProperties& result);
+
     //==============================================================================
     /** Tries to create an object that can read from a stream containing audio
         data in this format.
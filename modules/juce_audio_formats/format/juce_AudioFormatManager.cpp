@@ -161,4 +161,57 @@ AudioFormatReader* AudioFormatManager::createReaderFor (std::unique_ptr<InputStr
     return nullptr;
 }
 
+//==============================================================================
+bool AudioFormatManager::scanBasicProperties (const File& file, AudioFormat::BasicProperties& result) const
+{
+    result = {};
+
+    if (auto* format = findFormatForFileExtension (file.getFileExtension()))
+    {
+        FileInputStream fin (file);
+
+        if (fin.openedOk())
+        {
+            // the probes make lots of tiny reads, so batch the I/O up-front - the
+            // interesting chunk headers are almost always in the first few KB
+            BufferedInputStream in (fin, 4096);
+            return format->scanBasicProperties (in, result);
+        }
+    }
+
+    return false;
+}
+
+Array<AudioFormat::BasicProperties> AudioFormatManager::scanBasicProperties (const Array<File>& files, ThreadPool& pool) const
+{
+    Array<AudioFormat::BasicProperties> results;
+    results.resize (files.size());
+
+    if (files.isEmpty())
+        return results;
+
+    // each job claims file indices from a shared counter, so the work stays
+    // balanced even when a few files are much slower to probe than the rest
+    auto numJobs = jlimit (1, files.size(), pool.getNumThreads());
+
+    std::atomic<int> nextFileIndex { 0 };
+    std::atomic<int> numJobsRunning { numJobs };
+    WaitableEvent allJobsDone;
+
+    for (int i = 0; i < numJobs; ++i)
+    {
+        pool.addJob ([this, &files, &results, &nextFileIndex, &numJobsRunning, &allJobsDone]
+        {
+            for (int index; (index = nextFileIndex.fetch_add (1)) < files.size();)
+                scanBasicProperties (files.getReference (index), results.getReference (index));
+
+            if (--numJobsRunning == 0)
+                allJobsDone.signal();
+        });
+    }
+
+    allJobsDone.wait();
+    return results;
+}
+
 } // namespace juce
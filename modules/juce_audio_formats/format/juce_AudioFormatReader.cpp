@@ -444,4 +444,176 @@ void MemoryMappedAudioFormatReader::touchSample (int64 sample) const noexcept
         jassertfalse; // you must make sure that the window contains all the samples you're going to attempt to read.
 }
 
+void MemoryMappedAudioFormatReader::prefetchRange (Range<int64> samplesToPreload) const noexcept
+{
+    if (map == nullptr)
+        return;
+
+    auto clipped = samplesToPreload.getIntersectionWith (mappedSection);
+
+    if (clipped.isEmpty())
+        return;
+
+    auto address  = (uintptr_t) sampleToPointer (clipped.getStart());
+    auto numBytes = (size_t) (clipped.getLength() * bytesPerFrame);
+
+   #if JUCE_WINDOWS
+    // PrefetchVirtualMemory only exists on Win8 and later
+    using PrefetchVirtualMemoryFn = BOOL (WINAPI*) (HANDLE, ULONG_PTR, PWIN32_MEMORY_RANGE_ENTRY, ULONG);
+    static auto prefetchVirtualMemory = (PrefetchVirtualMemoryFn)
+        GetProcAddress (GetModuleHandleA ("kernel32.dll"), "PrefetchVirtualMemory");
+
+    if (prefetchVirtualMemory != nullptr)
+    {
+        WIN32_MEMORY_RANGE_ENTRY entry { (PVOID) address, numBytes };
+        prefetchVirtualMemory (GetCurrentProcess(), 1, &entry, 0);
+    }
+   #elif JUCE_MAC || JUCE_IOS || JUCE_LINUX || JUCE_BSD || JUCE_ANDROID
+    // madvise only accepts page-aligned addresses, so round the start down
+    auto pageSize = (uintptr_t) sysconf (_SC_PAGESIZE);
+    auto alignedAddress = address & ~(pageSize - 1);
+
+    madvise (reinterpret_cast<void*> (alignedAddress),
+             numBytes + (size_t) (address - alignedAddress),
+             MADV_WILLNEED);
+   #endif
+}
+
+bool MemoryMappedAudioFormatReader::isRangeResident (Range<int64> samplesToCheck) const noexcept
+{
+    if (map == nullptr)
+        return false;
+
+    auto clipped = samplesToCheck.getIntersectionWith (mappedSection);
+
+    if (clipped.isEmpty())
+        return false;
+
+    auto address  = (uintptr_t) sampleToPointer (clipped.getStart());
+    auto numBytes = (size_t) (clipped.getLength() * bytesPerFrame);
+
+   #if JUCE_WINDOWS
+    using QueryWorkingSetExFn = BOOL (WINAPI*) (HANDLE, PVOID, DWORD);
+    static auto queryWorkingSetEx = (QueryWorkingSetExFn)
+        GetProcAddress (GetModuleHandleA ("kernel32.dll"), "K32QueryWorkingSetEx");
+
+    if (queryWorkingSetEx == nullptr)
+        return false;
+
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo (&systemInfo);
+
+    auto pageSize = (uintptr_t) systemInfo.dwPageSize;
+    auto alignedAddress = address & ~(pageSize - 1);
+    auto numPages = (numBytes + (size_t) (address - alignedAddress) + pageSize - 1) / pageSize;
+
+    // matches PSAPI_WORKING_SET_EX_INFORMATION; bit 0 of the attributes means "valid"
+    struct WorkingSetExInfo { PVOID virtualAddress; ULONG_PTR virtualAttributes; };
+
+    HeapBlock<WorkingSetExInfo> info (numPages, true);
+
+    for (size_t i = 0; i < numPages; ++i)
+        info[i].virtualAddress = reinterpret_cast<PVOID> (alignedAddress + i * pageSize);
+
+    if (! queryWorkingSetEx (GetCurrentProcess(), info, (DWORD) (numPages * sizeof (WorkingSetExInfo))))
+        return false;
+
+    for (size_t i = 0; i < numPages; ++i)
+        if ((info[i].virtualAttributes & 1) == 0)
+            return false;
+
+    return true;
+   #elif JUCE_MAC || JUCE_IOS || JUCE_LINUX || JUCE_BSD || JUCE_ANDROID
+    auto pageSize = (uintptr_t) sysconf (_SC_PAGESIZE);
+    auto alignedAddress = address & ~(pageSize - 1);
+    numBytes += (size_t) (address - alignedAddress);
+    auto numPages = (numBytes + pageSize - 1) / pageSize;
+
+    HeapBlock<char> residency (numPages);
+
+   #if JUCE_LINUX || JUCE_ANDROID
+    auto* vec = reinterpret_cast<unsigned char*> (residency.getData());
+   #else
+    auto* vec = residency.getData();
+   #endif
+
+    if (mincore (reinterpret_cast<void*> (alignedAddress), numBytes, vec) != 0)
+        return false;
+
+    for (size_t i = 0; i < numPages; ++i)
+        if ((residency[i] & 1) == 0)
+            return false;
+
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct MemoryMappedReaderPrefetchTests  : public UnitTest
+{
+    MemoryMappedReaderPrefetchTests()  : UnitTest ("MemoryMappedAudioFormatReader prefetching", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        beginTest ("Prefetched ranges become resident and readable");
+
+        auto file = File::createTempFile (".wav");
+        WavAudioFormat format;
+
+        {
+            std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (new FileOutputStream (file),
+                                                                               44100.0, 2, 16, {}, 0));
+            expect (writer != nullptr);
+
+            AudioBuffer<float> buffer (2, 16384);
+
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    buffer.setSample (ch, i, std::sin ((float) i * 0.01f) * 0.5f);
+
+            expect (writer->writeFromAudioSampleBuffer (buffer, 0, buffer.getNumSamples()));
+        }
+
+        std::unique_ptr<MemoryMappedAudioFormatReader> reader (format.createMemoryMappedReader (file));
+        expect (reader != nullptr);
+
+        if (reader != nullptr)
+        {
+            // before mapping, both calls must be safe no-ops
+            reader->prefetchRange ({ 0, 100 });
+            expect (! reader->isRangeResident ({ 0, 100 }));
+
+            expect (reader->mapEntireFile());
+
+            // out-of-range hints and queries must clip safely
+            reader->prefetchRange ({ -100, reader->lengthInSamples + 100 });
+            expect (! reader->isRangeResident ({ reader->lengthInSamples, reader->lengthInSamples + 50 }));
+
+            const Range<int64> whole (0, reader->lengthInSamples);
+            reader->prefetchRange (whole);
+
+            for (int retries = 0; ! reader->isRangeResident (whole) && retries < 200; ++retries)
+                Thread::sleep (5);
+
+            expect (reader->isRangeResident (whole));
+
+            float samples[2] = {};
+            reader->getSample (1000, samples);
+            expectWithinAbsoluteError (samples[0], std::sin (1000.0f * 0.01f) * 0.5f, 1.0e-3f);
+        }
+
+        file.deleteFile();
+    }
+};
+
+static MemoryMappedReaderPrefetchTests memoryMappedReaderPrefetchTests;
+
+#endif
+
 } // namespace juce
@@ -78,6 +78,59 @@ static void convertFloatsToInts (int* dest, const float* src, int numSamples) no
     }
 }
 
+void AudioFormatWriter::convertFloatsToFixed (int* dest, const float* src, int numSamples, int channelNum) noexcept
+{
+    if (ditherType == DitherType::none || bitsPerSample >= 32 || numSamples <= 0)
+    {
+        convertFloatsToInts (dest, src, numSamples);
+        return;
+    }
+
+    if ((size_t) channelNum >= ditherStates.size())
+        ditherStates.resize ((size_t) channelNum + 1);
+
+    // F-weighted 9th-order error-feedback coefficients, which push the
+    // quantization noise up to where hearing is least sensitive
+    static constexpr double shaperCoefficients[9] = { 2.412, -3.370, 3.937, -4.174, 3.353,
+                                                     -2.205, 1.281, -0.569, 0.0847 };
+
+    const bool shaped = (ditherType == DitherType::noiseShaped);
+    const auto lsb = (double) (1u << (32u - bitsPerSample));
+    const auto maxLevel =  (double) ((1u << (bitsPerSample - 1u)) - 1u);
+    const auto minLevel = -(double) (1u << (bitsPerSample - 1u));
+
+    auto& state = ditherStates[(size_t) channelNum];
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        auto x = (double) src[i] * (double) std::numeric_limits<int>::max();
+
+        if (shaped)
+            for (int j = 0; j < 9; ++j)
+                x -= shaperCoefficients[j] * state.errorHistory[j];
+
+        // high-passed TPDF noise: the difference of consecutive uniform values
+        // has a triangular distribution, and costs one random number per sample
+        const auto newRandom = state.random.nextDouble() - 0.5;
+        const auto noise = (newRandom - state.lastRandomValue) * lsb;
+        state.lastRandomValue = newRandom;
+
+        // round to the destination bit depth's grid, so that the later
+        // truncation down to bitsPerSample bits is exact
+        const auto level = jlimit (minLevel, maxLevel, std::floor ((x + noise) / lsb + 0.5));
+
+        if (shaped)
+        {
+            for (int j = 8; j > 0; --j)
+                state.errorHistory[j] = state.errorHistory[j - 1];
+
+            state.errorHistory[0] = level * lsb - x;
+        }
+
+        dest[i] = (int) (level * lsb);
+    }
+}
+
 bool AudioFormatWriter::writeFromAudioReader (AudioFormatReader& reader,
                                               int64 startSample,
                                               int64 numSamplesToRead)
@@ -106,14 +159,16 @@ bool AudioFormatWriter::writeFromAudioReader (AudioFormatReader& reader,
 
             while (*bufferChan != nullptr)
             {
-                void* const b = *bufferChan++;
+                void* const b = *bufferChan;
 
                 constexpr auto scaleFactor = 1.0f / static_cast<float> (0x7fffffff);
 
                 if (isFloatingPoint())
                     FloatVectorOperations::convertFixedToFloat ((float*) b, (int*) b, scaleFactor, numToDo);
                 else
-                    convertFloatsToInts ((int*) b, (float*) b, numToDo);
+                    convertFloatsToFixed ((int*) b, (float*) b, numToDo, (int) (bufferChan - buffers));
+
+                ++bufferChan;
             }
         }
 
@@ -174,7 +229,7 @@ bool AudioFormatWriter::writeFromFloatArrays (const float* const* channels, int
         auto numToDo = jmin (numSamples, maxSamples);
 
         for (int i = 0; i < numSourceChannels; ++i)
-            convertFloatsToInts (chans[(size_t) i], channels[(size_t) i] + startSample, numToDo);
+            convertFloatsToFixed (chans[(size_t) i], channels[(size_t) i] + startSample, numToDo, i);
 
         if (! write ((const int**) chans.data(), numToDo))
             return false;
@@ -243,7 +298,10 @@ public:
         fifo.prepareToWrite (numSamples, start1, size1, start2, size2);
 
         if (size1 + size2 < numSamples)
+        {
+            ++overrunCount;
             return false;
+        }
 
         for (int i = buffer.getNumChannels(); --i >= 0;)
         {
@@ -321,6 +379,10 @@ public:
         samplesPerFlush = numSamples;
     }
 
+    int getNumBufferedSamples() const noexcept      { return fifo.getNumReady(); }
+    int getBufferSize() const noexcept              { return fifo.getTotalSize(); }
+    int getOverrunCount() const noexcept            { return overrunCount; }
+
 private:
     AbstractFifo fifo;
     AudioBuffer<float> buffer;
@@ -330,6 +392,7 @@ private:
     IncomingDataReceiver* receiver = {};
     int64 samplesWritten = 0;
     int samplesPerFlush = 0, flushSampleCounter = 0;
+    std::atomic<int> overrunCount { 0 };
     std::atomic<bool> isRunning { true };
 
     JUCE_DECLARE_NON_COPYABLE (Buffer)
@@ -359,4 +422,141 @@ void AudioFormatWriter::ThreadedWriter::setFlushInterval (int numSamplesPerFlush
     buffer->setFlushInterval (numSamplesPerFlush);
 }
 
+int AudioFormatWriter::ThreadedWriter::getNumBufferedSamples() const noexcept
+{
+    return buffer->getNumBufferedSamples();
+}
+
+int AudioFormatWriter::ThreadedWriter::getBufferSize() const noexcept
+{
+    return buffer->getBufferSize();
+}
+
+int AudioFormatWriter::ThreadedWriter::getOverrunCount() const noexcept
+{
+    return buffer->getOverrunCount();
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct AudioFormatWriterDitherTests  : public UnitTest
+{
+    AudioFormatWriterDitherTests()  : UnitTest ("AudioFormatWriter dithering", UnitTestCategories::audio)  {}
+
+    // a fixed-point "writer" that just captures the converted integers
+    struct CapturingWriter  : public AudioFormatWriter
+    {
+        CapturingWriter (unsigned int bits)
+            : AudioFormatWriter (nullptr, "capture", 44100.0, 1, bits) {}
+
+        bool write (const int** samples, int numSamples) override
+        {
+            captured.insert (captured.end(), samples[0], samples[0] + numSamples);
+            return true;
+        }
+
+        std::vector<int> captured;
+    };
+
+    void runTest() override
+    {
+        constexpr int numSamples = 20000;
+        constexpr double inputLevel = 0.3; // in units of one 16-bit LSB
+        std::vector<float> input ((size_t) numSamples, (float) (inputLevel / 32768.0));
+        const float* channels[] = { input.data(), nullptr };
+
+        beginTest ("Undithered conversion just rounds");
+        {
+            CapturingWriter writer (16);
+            const float values[] = { 0.0f, 0.5f, -0.25f, 1.5f, -1.5f };
+            const float* chans[] = { values, nullptr };
+            writer.writeFromFloatArrays (chans, 1, numElementsInArray (values));
+
+            expectEquals (writer.captured[0], 0);
+            expectEquals (writer.captured[1], roundToInt (0.5 * std::numeric_limits<int>::max()));
+            expectEquals (writer.captured[2], roundToInt (-0.25 * std::numeric_limits<int>::max()));
+            expectEquals (writer.captured[3], std::numeric_limits<int>::max());
+            expectEquals (writer.captured[4], std::numeric_limits<int>::min());
+        }
+
+        beginTest ("Triangular dither preserves sub-LSB levels");
+        {
+            CapturingWriter writer (16);
+            writer.setDitherType (AudioFormatWriter::DitherType::triangular);
+            writer.writeFromFloatArrays (channels, 1, numSamples);
+
+            auto levels = getQuantizedLevels (writer.captured);
+
+            // a 0.3-LSB input would vanish without dither; with it, the mean
+            // of the quantized output should still sit close to the input
+            expectWithinAbsoluteError (getMean (levels), inputLevel, 0.1);
+            expect (getMaxAbs (levels) <= 3.0);
+        }
+
+        beginTest ("Noise shaping preserves sub-LSB levels");
+        {
+            CapturingWriter writer (16);
+            writer.setDitherType (AudioFormatWriter::DitherType::noiseShaped);
+
+            // write in small blocks, to check that the state carries across calls
+            for (int start = 0; start < numSamples; start += 777)
+            {
+                const float* block[] = { input.data() + start, nullptr };
+                writer.writeFromFloatArrays (block, 1, jmin (777, numSamples - start));
+            }
+
+            auto levels = getQuantizedLevels (writer.captured);
+            expectWithinAbsoluteError (getMean (levels), inputLevel, 0.1);
+            expect (getMaxAbs (levels) <= 30.0);
+        }
+
+        beginTest ("Dithered output stays on the target bit depth's grid");
+        {
+            CapturingWriter writer (24);
+            writer.setDitherType (AudioFormatWriter::DitherType::triangular);
+            writer.writeFromFloatArrays (channels, 1, numSamples);
+
+            for (auto value : writer.captured)
+                expect ((value & 0xff) == 0);
+        }
+    }
+
+    static std::vector<double> getQuantizedLevels (const std::vector<int>& samples)
+    {
+        std::vector<double> levels;
+
+        for (auto s : samples)
+            levels.push_back (s / 65536.0);
+
+        return levels;
+    }
+
+    static double getMean (const std::vector<double>& values)
+    {
+        double total = 0;
+
+        for (auto v : values)
+            total += v;
+
+        return total / (double) values.size();
+    }
+
+    static double getMaxAbs (const std::vector<double>& values)
+    {
+        double maxAbs = 0;
+
+        for (auto v : values)
+            maxAbs = jmax (maxAbs, std::abs (v));
+
+        return maxAbs;
+    }
+};
+
+static AudioFormatWriterDitherTests audioFormatWriterDitherTests;
+
+#endif
+
 } // namespace juce
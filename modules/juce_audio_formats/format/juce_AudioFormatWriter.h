@@ -162,6 +162,39 @@ public:
     /** Writes some samples from a set of float data channels. */
     bool writeFromFloatArrays (const float* const* channels, int numChannels, int numSamples);
 
+    //==============================================================================
+    /** The dithering strategies that can be applied when floating-point data is
+        converted down to a fixed-point format.
+        @see setDitherType
+    */
+    enum class DitherType
+    {
+        none,           /**< The samples are simply rounded - this is the default. */
+        triangular,     /**< TPDF dither of one LSB at the target bit depth is added
+                             before rounding, decorrelating the quantization error
+                             from the signal. */
+        noiseShaped     /**< TPDF dither plus a 9th-order error-feedback filter that
+                             pushes the quantization noise towards the frequencies
+                             where the ear is least sensitive. */
+    };
+
+    /** Chooses how floating-point source data will be dithered when it's converted
+        down to this writer's fixed-point bit depth.
+
+        This affects writeFromFloatArrays() and the other float-based write methods
+        when the destination format is fixed-point. The dither is applied as part of
+        the existing conversion pass, so enabling it doesn't cost an extra traversal
+        of the data.
+
+        The dither state is kept per-channel and persists across write calls, so a
+        file can be written in many small blocks without any seams. For
+        floating-point destination formats this setting has no effect.
+    */
+    void setDitherType (DitherType newType) noexcept        { ditherType = newType; }
+
+    /** Returns the dithering strategy set by setDitherType(). */
+    DitherType getDitherType() const noexcept               { return ditherType; }
+
     //==============================================================================
     /** Returns the sample rate being used. */
     double getSampleRate() const noexcept       { return sampleRate; }
@@ -237,6 +270,30 @@ public:
         */
         void setFlushInterval (int numSamplesPerFlush) noexcept;
 
+        //==============================================================================
+        /** Returns the number of samples currently sitting in the FIFO, waiting for
+            the background thread to write them to disk.
+
+            Comparing this with getBufferSize() tells you how close the incoming data
+            is to overflowing the buffer - if it keeps creeping upwards, the disk
+            isn't keeping up and you may want to enlarge the buffer or reduce the
+            amount of data being recorded.
+        */
+        int getNumBufferedSamples() const noexcept;
+
+        /** Returns the total number of samples that the FIFO can hold, as passed to
+            the constructor.
+        */
+        int getBufferSize() const noexcept;
+
+        /** Returns the number of write() calls that have failed because the FIFO was
+            too full to accept the data.
+
+            A non-zero value means some incoming audio has been dropped, so you might
+            want to warn the user that their recording contains glitches.
+        */
+        int getOverrunCount() const noexcept;
+
     private:
         class Buffer;
         std::unique_ptr<Buffer> buffer;
@@ -293,6 +350,18 @@ private:
     String formatName;
     friend class ThreadedWriter;
 
+    struct DitherState
+    {
+        double errorHistory[9] = {};
+        double lastRandomValue = 0;
+        Random random;
+    };
+
+    DitherType ditherType = DitherType::none;
+    std::vector<DitherState> ditherStates;
+
+    void convertFloatsToFixed (int* dest, const float* src, int numSamples, int channelNum) noexcept;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioFormatWriter)
 };
 
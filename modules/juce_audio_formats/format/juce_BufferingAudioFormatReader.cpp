@@ -26,11 +26,74 @@
 namespace juce
 {
 
+BufferingAudioReader::Cache::Cache (int64 maxSamplesToCache)
+    : maxSamples (jmax ((int64) samplesPerBlock, maxSamplesToCache))
+{
+}
+
+void BufferingAudioReader::Cache::addReader (BufferingAudioReader* reader)
+{
+    const ScopedLock sl (cacheLock);
+    readers.add (reader);
+}
+
+void BufferingAudioReader::Cache::removeReader (BufferingAudioReader* reader)
+{
+    const ScopedLock sl (cacheLock);
+    readers.removeFirstMatchingValue (reader);
+}
+
+void BufferingAudioReader::Cache::trim()
+{
+    const ScopedLock sl (cacheLock);
+
+    for (;;)
+    {
+        int64 total = 0;
+
+        for (auto* reader : readers)
+            total += reader->getNumBufferedSamples();
+
+        if (total <= maxSamples)
+            return;
+
+        BufferingAudioReader* lruReader = nullptr;
+        uint32 lruTime = 0;
+
+        for (auto* reader : readers)
+        {
+            uint32 time;
+
+            if (reader->findLeastRecentlyUsedBlockTime (time)
+                 && (lruReader == nullptr || time < lruTime))
+            {
+                lruReader = reader;
+                lruTime = time;
+            }
+        }
+
+        if (lruReader == nullptr)
+            return;
+
+        lruReader->releaseLeastRecentlyUsedBlock();
+    }
+}
+
+//==============================================================================
 BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
                                             TimeSliceThread& timeSliceThread,
                                             int samplesToBuffer)
+    : BufferingAudioReader (sourceReader, timeSliceThread, samplesToBuffer, nullptr)
+{
+}
+
+BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
+                                            TimeSliceThread& timeSliceThread,
+                                            int samplesToBuffer,
+                                            Cache::Ptr cacheToUse)
     : AudioFormatReader (nullptr, sourceReader->getFormatName()),
       source (sourceReader), thread (timeSliceThread),
+      cache (std::move (cacheToUse)),
       numBlocks (1 + (samplesToBuffer / samplesPerBlock))
 {
     sampleRate            = source->sampleRate;
@@ -40,12 +103,18 @@ BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
     bitsPerSample         = 32;
     usesFloatingPointData = true;
 
+    if (cache != nullptr)
+        cache->addReader (this);
+
     timeSliceThread.addTimeSliceClient (this);
 }
 
 BufferingAudioReader::~BufferingAudioReader()
 {
     thread.removeTimeSliceClient (this);
+
+    if (cache != nullptr)
+        cache->removeReader (this);
 }
 
 void BufferingAudioReader::setReadTimeout (int timeoutMilliseconds) noexcept
@@ -60,57 +129,74 @@ bool BufferingAudioReader::readSamples (int** destSamples, int numDestChannels,
     clearSamplesBeyondAvailableLength (destSamples, numDestChannels, startOffsetInDestBuffer,
                                        startSampleInFile, numSamples, lengthInSamples);
 
-    const ScopedLock sl (lock);
-    nextReadPosition = startSampleInFile;
+    updateSequentialReadCount (startSampleInFile, numSamples);
+
+    bool prefetchNeeded = false;
 
-    while (numSamples > 0)
     {
-        if (auto block = getBlockContaining (startSampleInFile))
-        {
-            auto offset = (int) (startSampleInFile - block->range.getStart());
-            auto numToDo = jmin (numSamples, (int) (block->range.getEnd() - startSampleInFile));
+        const ScopedLock sl (lock);
+        nextReadPosition = startSampleInFile;
 
-            for (int j = 0; j < numDestChannels; ++j)
+        while (numSamples > 0)
+        {
+            if (auto block = getBlockContaining (startSampleInFile))
             {
-                if (auto* dest = (float*) destSamples[j])
-                {
-                    dest += startOffsetInDestBuffer;
+                block->lastUseTime = Time::getApproximateMillisecondCounter();
 
-                    if (j < (int) numChannels)
-                        FloatVectorOperations::copy (dest, block->buffer.getReadPointer (j, offset), numToDo);
-                    else
-                        FloatVectorOperations::clear (dest, numToDo);
-                }
-            }
+                auto offset = (int) (startSampleInFile - block->range.getStart());
+                auto numToDo = jmin (numSamples, (int) (block->range.getEnd() - startSampleInFile));
 
-            startOffsetInDestBuffer += numToDo;
-            startSampleInFile += numToDo;
-            numSamples -= numToDo;
-        }
-        else
-        {
-            if (timeoutMs >= 0 && Time::getMillisecondCounter() >= startTime + (uint32) timeoutMs)
-            {
                 for (int j = 0; j < numDestChannels; ++j)
+                {
                     if (auto* dest = (float*) destSamples[j])
-                        FloatVectorOperations::clear (dest + startOffsetInDestBuffer, numSamples);
+                    {
+                        dest += startOffsetInDestBuffer;
+
+                        if (j < (int) numChannels)
+                            FloatVectorOperations::copy (dest, block->buffer.getReadPointer (j, offset), numToDo);
+                        else
+                            FloatVectorOperations::clear (dest, numToDo);
+                    }
+                }
 
-                break;
+                startOffsetInDestBuffer += numToDo;
+                startSampleInFile += numToDo;
+                numSamples -= numToDo;
             }
             else
             {
-                ScopedUnlock ul (lock);
-                Thread::yield();
+                if (timeoutMs >= 0 && Time::getMillisecondCounter() >= startTime + (uint32) timeoutMs)
+                {
+                    for (int j = 0; j < numDestChannels; ++j)
+                        if (auto* dest = (float*) destSamples[j])
+                            FloatVectorOperations::clear (dest + startOffsetInDestBuffer, numSamples);
+
+                    break;
+                }
+                else
+                {
+                    ScopedUnlock ul (lock);
+                    Thread::yield();
+                }
             }
         }
+
+        prefetchNeeded = startSampleInFile < lengthInSamples
+                          && getBlockContaining (startSampleInFile) == nullptr;
     }
 
+    // kick the background thread now so that the next block is decoded while
+    // the caller works through the data it's just been given
+    if (prefetchNeeded)
+        thread.moveToFrontOfQueue (this);
+
     return true;
 }
 
 BufferingAudioReader::BufferedBlock::BufferedBlock (AudioFormatReader& reader, int64 pos, int numSamples)
     : range (pos, pos + numSamples),
-      buffer ((int) reader.numChannels, numSamples)
+      buffer ((int) reader.numChannels, numSamples),
+      lastUseTime (Time::getApproximateMillisecondCounter())
 {
     reader.read (&buffer, 0, numSamples, pos, true, true);
 }
@@ -129,39 +215,131 @@ int BufferingAudioReader::useTimeSlice()
     return readNextBufferChunk() ? 1 : 100;
 }
 
-bool BufferingAudioReader::readNextBufferChunk()
+void BufferingAudioReader::updateSequentialReadCount (int64 startSample, int numSamples) noexcept
 {
-    auto pos = (nextReadPosition.load() / samplesPerBlock) * samplesPerBlock;
-    auto endPos = jmin (lengthInSamples, pos + numBlocks * samplesPerBlock);
+    if (expectedReadPosition.exchange (startSample + numSamples) == startSample)
+    {
+        auto streak = sequentialReadCount.load();
+
+        if (streak < 1000)
+            sequentialReadCount = streak + 1;
+    }
+    else
+    {
+        sequentialReadCount = 0;
+    }
+}
 
-    OwnedArray<BufferedBlock> newBlocks;
+int BufferingAudioReader::getNumBlocksToBuffer() const noexcept
+{
+    // widens the readahead window while the caller keeps reading sequentially
+    auto streak = sequentialReadCount.load();
+    auto multiplier = streak >= 32 ? 4
+                    : streak >= 8  ? 2
+                                   : 1;
+    return numBlocks * multiplier;
+}
+
+void BufferingAudioReader::trimLocalBlocks (Range<int64> window)
+{
+    OwnedArray<BufferedBlock> evicted;
+    const ScopedLock sl (lock);
 
     for (int i = blocks.size(); --i >= 0;)
-        if (blocks.getUnchecked (i)->range.intersects (Range<int64> (pos, endPos)))
-            newBlocks.add (blocks.getUnchecked (i));
+        if (! blocks.getUnchecked (i)->range.intersects (window))
+            evicted.add (blocks.removeAndReturn (i));
 
-    if (newBlocks.size() == numBlocks)
-    {
-        newBlocks.clear (false);
+    // NB: the evicted blocks are freed after the lock has been released
+}
+
+int64 BufferingAudioReader::getNumBufferedSamples() const noexcept
+{
+    const ScopedLock sl (lock);
+    return (int64) blocks.size() * samplesPerBlock;
+}
+
+bool BufferingAudioReader::findLeastRecentlyUsedBlockTime (uint32& time) const noexcept
+{
+    const ScopedLock sl (lock);
+
+    if (blocks.isEmpty())
         return false;
+
+    time = blocks.getUnchecked (0)->lastUseTime;
+
+    for (int i = 1; i < blocks.size(); ++i)
+        time = jmin (time, blocks.getUnchecked (i)->lastUseTime.load());
+
+    return true;
+}
+
+void BufferingAudioReader::releaseLeastRecentlyUsedBlock()
+{
+    std::unique_ptr<BufferedBlock> evicted;
+    const ScopedLock sl (lock);
+
+    int lruIndex = -1;
+    uint32 lruTime = 0;
+
+    for (int i = 0; i < blocks.size(); ++i)
+    {
+        auto time = blocks.getUnchecked (i)->lastUseTime.load();
+
+        if (lruIndex < 0 || time < lruTime)
+        {
+            lruIndex = i;
+            lruTime = time;
+        }
     }
 
-    for (auto p = pos; p < endPos; p += samplesPerBlock)
+    if (lruIndex >= 0)
+        evicted.reset (blocks.removeAndReturn (lruIndex));
+}
+
+bool BufferingAudioReader::readNextBufferChunk()
+{
+    auto pos = (nextReadPosition.load() / samplesPerBlock) * samplesPerBlock;
+    Range<int64> window (pos, jmin (lengthInSamples,
+                                    pos + (int64) getNumBlocksToBuffer() * samplesPerBlock));
+
+    int64 firstMissingPos = -1;
+
     {
-        if (getBlockContaining (p) == nullptr)
+        const ScopedLock sl (lock);
+
+        for (auto p = window.getStart(); p < window.getEnd(); p += samplesPerBlock)
         {
-            newBlocks.add (new BufferedBlock (*source, p, samplesPerBlock));
-            break; // just do one block
+            if (getBlockContaining (p) == nullptr)
+            {
+                firstMissingPos = p;
+                break;
+            }
         }
     }
 
+    if (firstMissingPos < 0)
+    {
+        if (cache == nullptr)
+            trimLocalBlocks (window);
+
+        return false;
+    }
+
+    // the slow source read happens without holding the lock, so the audio
+    // thread can keep consuming the blocks that are already buffered
+    auto newBlock = std::make_unique<BufferedBlock> (*source, firstMissingPos, samplesPerBlock);
+
     {
         const ScopedLock sl (lock);
-        newBlocks.swapWith (blocks);
+
+        if (getBlockContaining (firstMissingPos) == nullptr)
+            blocks.add (newBlock.release());
     }
 
-    for (int i = blocks.size(); --i >= 0;)
-        newBlocks.removeObject (blocks.getUnchecked (i), false);
+    if (cache != nullptr)
+        cache->trim();
+    else
+        trimLocalBlocks (window);
 
     return true;
 }
@@ -299,6 +477,42 @@ public:
                 expect (buffer == readBuffer);
             }
         }
+
+        beginTest ("Shared cache with random access");
+        {
+            auto random = getRandom();
+
+            BufferingAudioReader::Cache::Ptr cache (new BufferingAudioReader::Cache (3 * 32768));
+
+            auto bufferA = generateTestBuffer (1 << 16);
+            auto bufferB = generateTestBuffer (1 << 16);
+
+            BufferingAudioReader readerA (new TestAudioFormatReader (bufferA), timeSlice, 32768, cache);
+            BufferingAudioReader readerB (new TestAudioFormatReader (bufferB), timeSlice, 32768, cache);
+            readerA.setReadTimeout (-1);
+            readerB.setReadTimeout (-1);
+
+            constexpr int chunkSize = 512;
+
+            for (int i = 0; i < 50; ++i)
+            {
+                auto useA = (i & 1) == 0;
+                auto& source = useA ? bufferA : bufferB;
+                auto& reader = useA ? readerA : readerB;
+
+                auto pos = random.nextInt (source.getNumSamples() - chunkSize);
+
+                AudioBuffer<float> readBuffer { source.getNumChannels(), chunkSize };
+                reader.read (&readBuffer, 0, chunkSize, pos, true, true);
+
+                AudioBuffer<float> expected { source.getNumChannels(), chunkSize };
+
+                for (int channel = 0; channel < source.getNumChannels(); ++channel)
+                    expected.copyFrom (channel, 0, source, channel, pos, chunkSize);
+
+                expect (expected == readBuffer);
+            }
+        }
     }
 
 private:
@@ -39,6 +39,44 @@ class JUCE_API  BufferingAudioReader  : public AudioFormatReader,
                                         private TimeSliceClient
 {
 public:
+    //==============================================================================
+    /**
+        A block cache that can be shared between several BufferingAudioReaders.
+
+        The cache imposes one global limit on the total number of buffered
+        samples and evicts the least-recently-used block across all of its
+        readers when that limit is exceeded. This lets a large pool of readers
+        share a single memory budget, so the readers that are actually being
+        played keep their data buffered instead of each reader being restricted
+        to its own small set of blocks.
+
+        @see BufferingAudioReader
+    */
+    class JUCE_API  Cache  : public ReferenceCountedObject
+    {
+    public:
+        using Ptr = ReferenceCountedObjectPtr<Cache>;
+
+        /** Creates a cache that will hold up to the given total number of
+            samples across all of the readers that share it.
+        */
+        explicit Cache (int64 maxSamplesToCache);
+
+    private:
+        friend class BufferingAudioReader;
+
+        void addReader (BufferingAudioReader*);
+        void removeReader (BufferingAudioReader*);
+        void trim();
+
+        Array<BufferingAudioReader*> readers;
+        CriticalSection cacheLock;
+        const int64 maxSamples;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Cache)
+    };
+
+    //==============================================================================
     /** Creates a reader.
 
         @param sourceReader     the source reader to wrap. This BufferingAudioReader
@@ -53,6 +91,26 @@ public:
                           TimeSliceThread& timeSliceThread,
                           int samplesToBuffer);
 
+    /** Creates a reader that shares its buffered blocks with other readers.
+
+        The samplesToBuffer parameter gives the base readahead window; the
+        window grows automatically (up to four times the base size) while the
+        caller keeps reading sequentially. Blocks that fall out of the window
+        are kept around until the shared cache runs over its budget, which
+        makes random-access-heavy sessions far less likely to re-read data.
+
+        @param sourceReader     the source reader to wrap, which will be owned
+                                by this object
+        @param timeSliceThread  the thread that should be used to do the background reading
+        @param samplesToBuffer  the base number of samples to buffer ahead
+        @param cacheToUse       the shared cache that limits the total number of
+                                samples buffered across readers
+    */
+    BufferingAudioReader (AudioFormatReader* sourceReader,
+                          TimeSliceThread& timeSliceThread,
+                          int samplesToBuffer,
+                          Cache::Ptr cacheToUse);
+
     ~BufferingAudioReader() override;
 
     /** Sets a number of milliseconds that the reader can block for in its readSamples()
@@ -73,17 +131,27 @@ private:
 
         Range<int64> range;
         AudioBuffer<float> buffer;
+        std::atomic<uint32> lastUseTime;
     };
 
     int useTimeSlice() override;
     BufferedBlock* getBlockContaining (int64 pos) const noexcept;
     bool readNextBufferChunk();
+    void updateSequentialReadCount (int64 startSample, int numSamples) noexcept;
+    int getNumBlocksToBuffer() const noexcept;
+    void trimLocalBlocks (Range<int64> window);
+    int64 getNumBufferedSamples() const noexcept;
+    bool findLeastRecentlyUsedBlockTime (uint32& time) const noexcept;
+    void releaseLeastRecentlyUsedBlock();
 
     static constexpr int samplesPerBlock = 32768;
 
     std::unique_ptr<AudioFormatReader> source;
     TimeSliceThread& thread;
+    Cache::Ptr cache;
     std::atomic<int64> nextReadPosition { 0 };
+    std::atomic<int64> expectedReadPosition { 0 };
+    std::atomic<int> sequentialReadCount { 0 };
     const int numBlocks;
     int timeoutMs = 0;
 
@@ -72,6 +72,37 @@ public:
     /** Touches the memory for the given sample, to force it to be loaded into active memory. */
     void touchSample (int64 sample) const noexcept;
 
+    /** Asks the OS to start paging a range of samples into physical memory.
+
+        Unlike touchSample(), this doesn't block while the data is fetched: it
+        issues a read-ahead hint (madvise MADV_WILLNEED, or PrefetchVirtualMemory
+        on Windows) and returns immediately, with the paging happening in the
+        background. A sampler can call this from a background thread when a voice
+        starts - or slightly ahead of where playback will reach - so that by the
+        time the audio thread reads the samples, no major page faults occur.
+
+        The range will be clipped to the currently-mapped section, so it's safe
+        to pass a speculative range here.
+
+        @see isRangeResident, touchSample
+    */
+    void prefetchRange (Range<int64> samplesToPreload) const noexcept;
+
+    /** Returns true if all the pages holding the given range of samples are
+        currently resident in physical memory, meaning that reading them won't
+        stall on a page fault.
+
+        You might use this after prefetchRange() to hold off streaming a region
+        from the audio thread until it's safe to do so. The query itself makes a
+        system call, so do the checking on the thread that's prefetching rather
+        than in the audio callback.
+
+        Returns false if the range is empty or lies outside the mapped section.
+
+        @see prefetchRange
+    */
+    bool isRangeResident (Range<int64> samplesToCheck) const noexcept;
+
     /** Returns the samples for all channels at a given sample position.
         The result array must be large enough to hold a value for each channel
         that this reader contains.
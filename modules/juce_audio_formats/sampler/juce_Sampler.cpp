@@ -66,13 +66,68 @@ bool SamplerSound::appliesToChannel (int /*midiChannel*/)
     return true;
 }
 
+//==============================================================================
+StreamingSamplerSound::StreamingSamplerSound (const String& soundName,
+                                              std::unique_ptr<AudioFormatReader> source,
+                                              TimeSliceThread& backgroundThread,
+                                              const BigInteger& notes,
+                                              int midiNoteForNormalPitch,
+                                              double attackTimeSecs,
+                                              double releaseTimeSecs,
+                                              double preloadLengthSeconds,
+                                              int samplesToBuffer)
+    : name (soundName),
+      sourceSampleRate (source->sampleRate),
+      midiNotes (notes),
+      midiRootNote (midiNoteForNormalPitch)
+{
+    if (sourceSampleRate > 0 && source->lengthInSamples > 0)
+    {
+        length = source->lengthInSamples;
+
+        crossfadeLength = (int) jmin ((int64) 1024, length);
+        preloadLength   = (int) jmin ((int64) (preloadLengthSeconds * sourceSampleRate), length);
+
+        preload.setSize (jmin (2, (int) source->numChannels), preloadLength + crossfadeLength + 4);
+        preload.clear();
+
+        source->read (&preload, 0, (int) jmin ((int64) preload.getNumSamples(), length), 0, true, true);
+
+        reader.reset (new BufferingAudioReader (source.release(), backgroundThread, samplesToBuffer));
+
+        params.attack  = static_cast<float> (attackTimeSecs);
+        params.release = static_cast<float> (releaseTimeSecs);
+    }
+}
+
+StreamingSamplerSound::~StreamingSamplerSound()
+{
+}
+
+void StreamingSamplerSound::setReadTimeout (int timeoutMilliseconds) noexcept
+{
+    if (reader != nullptr)
+        reader->setReadTimeout (timeoutMilliseconds);
+}
+
+bool StreamingSamplerSound::appliesToNote (int midiNoteNumber)
+{
+    return midiNotes[midiNoteNumber];
+}
+
+bool StreamingSamplerSound::appliesToChannel (int /*midiChannel*/)
+{
+    return true;
+}
+
 //==============================================================================
 SamplerVoice::SamplerVoice() {}
 SamplerVoice::~SamplerVoice() {}
 
 bool SamplerVoice::canPlaySound (SynthesiserSound* sound)
 {
-    return dynamic_cast<const SamplerSound*> (sound) != nullptr;
+    return dynamic_cast<const SamplerSound*> (sound) != nullptr
+            || dynamic_cast<const StreamingSamplerSound*> (sound) != nullptr;
 }
 
 void SamplerVoice::startNote (int midiNoteNumber, float velocity, SynthesiserSound* s, int /*currentPitchWheelPosition*/)
@@ -91,6 +146,20 @@ void SamplerVoice::startNote (int midiNoteNumber, float velocity, SynthesiserSou
 
         adsr.noteOn();
     }
+    else if (auto* streamingSound = dynamic_cast<const StreamingSamplerSound*> (s))
+    {
+        pitchRatio = std::pow (2.0, (midiNoteNumber - streamingSound->midiRootNote) / 12.0)
+                        * streamingSound->sourceSampleRate / getSampleRate();
+
+        sourceSamplePosition = 0.0;
+        lgain = velocity;
+        rgain = velocity;
+
+        adsr.setSampleRate (streamingSound->sourceSampleRate);
+        adsr.setParameters (streamingSound->params);
+
+        adsr.noteOn();
+    }
     else
     {
         jassertfalse; // this object can only play SamplerSounds!
@@ -116,7 +185,13 @@ void SamplerVoice::controllerMoved (int /*controllerNumber*/, int /*newValue*/)
 //==============================================================================
 void SamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
 {
-    if (auto* playingSound = static_cast<SamplerSound*> (getCurrentlyPlayingSound().get()))
+    if (auto* streamingSound = dynamic_cast<StreamingSamplerSound*> (getCurrentlyPlayingSound().get()))
+    {
+        renderNextStreamingBlock (*streamingSound, outputBuffer, startSample, numSamples);
+        return;
+    }
+
+    if (auto* playingSound = dynamic_cast<SamplerSound*> (getCurrentlyPlayingSound().get()))
     {
         auto& data = *playingSound->data;
         const float* const inL = data.getReadPointer (0);
@@ -162,4 +237,223 @@ void SamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startS
     }
 }
 
+void SamplerVoice::renderNextStreamingBlock (StreamingSamplerSound& sound, AudioBuffer<float>& outputBuffer,
+                                             int startSample, int numSamples)
+{
+    if (sound.reader == nullptr)
+        return;
+
+    // work out the span of source samples this block will touch, including the
+    // extra sample needed for interpolation
+    const auto firstSample = (int64) sourceSamplePosition;
+    const auto spanLength = (int) ((int64) (sourceSamplePosition + pitchRatio * numSamples) + 2 - firstSample);
+
+    const auto numChannels = sound.preload.getNumChannels();
+
+    if (streamScratch.getNumChannels() < numChannels || streamScratch.getNumSamples() < spanLength)
+        streamScratch.setSize (jmax (numChannels, streamScratch.getNumChannels()),
+                               jmax (spanLength + 64, streamScratch.getNumSamples()),
+                               false, false, true);
+
+    // fetch the streamed part of the span first, then overlay the in-memory head
+    const auto firstStreamed = (int) jlimit ((int64) 0, (int64) spanLength, (int64) sound.preloadLength - firstSample);
+
+    if (firstStreamed < spanLength)
+        sound.reader->read (&streamScratch, firstStreamed, spanLength - firstStreamed,
+                            firstSample + firstStreamed, true, true);
+
+    const auto numFromPreload = (int) jlimit ((int64) 0, (int64) spanLength,
+                                              (int64) sound.preloadLength + sound.crossfadeLength - firstSample);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        if (firstStreamed > 0)
+            streamScratch.copyFrom (channel, 0, sound.preload, channel, (int) firstSample, firstStreamed);
+
+        // inside the crossfade region, blend the preloaded data into the streamed data
+        for (int i = firstStreamed; i < numFromPreload; ++i)
+        {
+            auto sourceIndex = (int) firstSample + i;
+            auto streamGain = (float) (sourceIndex - sound.preloadLength) / (float) sound.crossfadeLength;
+
+            auto& sample = streamScratch.getWritePointer (channel)[i];
+            sample = sound.preload.getSample (channel, sourceIndex) * (1.0f - streamGain) + sample * streamGain;
+        }
+    }
+
+    const float* const inL = streamScratch.getReadPointer (0);
+    const float* const inR = numChannels > 1 ? streamScratch.getReadPointer (1) : nullptr;
+
+    float* outL = outputBuffer.getWritePointer (0, startSample);
+    float* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
+
+    while (--numSamples >= 0)
+    {
+        auto localPosition = sourceSamplePosition - (double) firstSample;
+        auto pos = (int) localPosition;
+        auto alpha = (float) (localPosition - pos);
+        auto invAlpha = 1.0f - alpha;
+
+        // just using a very simple linear interpolation here..
+        float l = (inL[pos] * invAlpha + inL[pos + 1] * alpha);
+        float r = (inR != nullptr) ? (inR[pos] * invAlpha + inR[pos + 1] * alpha)
+                                   : l;
+
+        auto envelopeValue = adsr.getNextSample();
+
+        l *= lgain * envelopeValue;
+        r *= rgain * envelopeValue;
+
+        if (outR != nullptr)
+        {
+            *outL++ += l;
+            *outR++ += r;
+        }
+        else
+        {
+            *outL++ += (l + r) * 0.5f;
+        }
+
+        sourceSamplePosition += pitchRatio;
+
+        if (sourceSamplePosition > (double) sound.length)
+        {
+            stopNote (0.0f, false);
+            break;
+        }
+    }
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class StreamingSamplerSoundTests  : public UnitTest
+{
+public:
+    StreamingSamplerSoundTests()  : UnitTest ("StreamingSamplerSound", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        TimeSliceThread timeSlice ("SamplerTestBackgroundThread");
+        timeSlice.startThread (5);
+
+        auto buffer = generateTestBuffer (10 * 44100);
+
+        beginTest ("Streamed rendering matches fully in-memory rendering");
+        {
+            auto memorySynth = makeSynth();
+            auto streamingSynth = makeSynth();
+
+            {
+                TestAudioFormatReader memoryReader (buffer);
+                memorySynth->addSound (new SamplerSound ("memory", memoryReader, getTestNoteRange(), 74, 0.0, 0.1, 60.0));
+            }
+
+            auto* streamingSound = new StreamingSamplerSound ("streaming",
+                                                              std::make_unique<TestAudioFormatReader> (buffer),
+                                                              timeSlice, getTestNoteRange(), 74, 0.0, 0.1, 0.25);
+            streamingSound->setReadTimeout (-1);
+            streamingSynth->addSound (streamingSound);
+
+            constexpr int blockSize = 512, numBlocks = 64;
+
+            AudioBuffer<float> memoryOutput    (2, blockSize * numBlocks);
+            AudioBuffer<float> streamingOutput (2, blockSize * numBlocks);
+            memoryOutput.clear();
+            streamingOutput.clear();
+
+            render (*memorySynth,    memoryOutput,    blockSize);
+            render (*streamingSynth, streamingOutput, blockSize);
+
+            auto maxDifference = 0.0f;
+
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < memoryOutput.getNumSamples(); ++i)
+                    maxDifference = jmax (maxDifference,
+                                          std::abs (memoryOutput.getSample (channel, i)
+                                                     - streamingOutput.getSample (channel, i)));
+
+            expect (maxDifference < 1.0e-4f);
+        }
+
+        beginTest ("Voice start is rendered from the preload before the stream is ready");
+        {
+            struct SlowReader  : public TestAudioFormatReader
+            {
+                explicit SlowReader (AudioBuffer<float>& b)  : TestAudioFormatReader (b) {}
+
+                bool readSamples (int** destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                                  int64 startSampleInFile, int numSamples) override
+                {
+                    Thread::sleep (50);
+                    return TestAudioFormatReader::readSamples (destChannels, numDestChannels, startOffsetInDestBuffer,
+                                                               startSampleInFile, numSamples);
+                }
+            };
+
+            auto synth = makeSynth();
+            synth->addSound (new StreamingSamplerSound ("slow",
+                                                        std::make_unique<SlowReader> (buffer),
+                                                        timeSlice, getTestNoteRange(), 74, 0.0, 0.1, 0.25));
+
+            constexpr int blockSize = 512;
+            AudioBuffer<float> output (2, blockSize);
+            output.clear();
+
+            // with the default zero read timeout, the first block must come from
+            // the preloaded head even though the background reader is still busy
+            render (*synth, output, blockSize);
+
+            expect (output.findMinMax (0, 0, blockSize) != Range<float>{});
+        }
+    }
+
+private:
+    static BigInteger getTestNoteRange()
+    {
+        BigInteger notes;
+        notes.setRange (0, 128, true);
+        return notes;
+    }
+
+    static std::unique_ptr<Synthesiser> makeSynth()
+    {
+        auto synth = std::make_unique<Synthesiser>();
+        synth->addVoice (new SamplerVoice());
+        synth->setCurrentPlaybackSampleRate (44100.0);
+        return synth;
+    }
+
+    static void render (Synthesiser& synth, AudioBuffer<float>& output, int blockSize)
+    {
+        MidiBuffer midi;
+        midi.addEvent (MidiMessage::noteOn (1, 74, 0.9f), 0);
+
+        for (int start = 0; start < output.getNumSamples(); start += blockSize)
+        {
+            synth.renderNextBlock (output, midi, start, jmin (blockSize, output.getNumSamples() - start));
+            midi.clear();
+        }
+    }
+
+    AudioBuffer<float> generateTestBuffer (int numSamples)
+    {
+        auto random = getRandom();
+
+        AudioBuffer<float> buffer { 2, numSamples };
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+                buffer.setSample (channel, sample, random.nextFloat() - 0.5f);
+
+        return buffer;
+    }
+};
+
+static StreamingSamplerSoundTests streamingSamplerSoundTests;
+
+#endif
+
 } // namespace juce
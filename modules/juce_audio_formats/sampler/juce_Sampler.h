@@ -108,12 +108,116 @@ private:
 
 //==============================================================================
 /**
-    A subclass of SynthesiserVoice that can play a SamplerSound.
+    A subclass of SynthesiserSound that streams a sampled audio clip from disk.
+
+    Unlike SamplerSound, which loads the whole stream into memory, this keeps only
+    a preloaded attack head in memory and streams the body of the sample through a
+    BufferingAudioReader on a background thread, so sample sets can scale with
+    disk size rather than RAM.
+
+    The start of each note is always rendered from the preloaded head, which gives
+    the background thread time to fetch the body of the sample; playback then
+    crossfades from the preloaded data into the streamed data. If the stream can't
+    keep up (e.g. the preload is very short, or the background thread is starved),
+    the affected region is rendered as silence rather than blocking the audio
+    thread.
+
+    To use it, create a Synthesiser, add some SamplerVoice objects to it, then
+    give it some StreamingSamplerSound objects to play.
+
+    @see SamplerSound, SamplerVoice, Synthesiser, BufferingAudioReader
+
+    @tags{Audio}
+*/
+class JUCE_API  StreamingSamplerSound   : public SynthesiserSound
+{
+public:
+    //==============================================================================
+    /** Creates a streaming sound from an audio reader.
+
+        Only the attack head of the sample is read into memory here - the rest is
+        fetched on the background thread while the sound is playing.
+
+        @param name         a name for the sample
+        @param source       the audio to stream. This object takes ownership of the
+                            reader and will keep it open for the lifetime of the sound
+        @param backgroundThread  the thread that will be used to read ahead of the
+                            playback position. Make sure that the thread you supply is
+                            running, and won't be deleted while the sound still exists
+        @param midiNotes    the set of midi keys that this sound should be played on. This
+                            is used by the SynthesiserSound::appliesToNote() method
+        @param midiNoteForNormalPitch   the midi note at which the sample should be played
+                                        with its natural rate. All other notes will be pitched
+                                        up or down relative to this one
+        @param attackTimeSecs   the attack (fade-in) time, in seconds
+        @param releaseTimeSecs  the decay (fade-out) time, in seconds
+        @param preloadLengthSeconds  the length of the attack head to keep in memory. This
+                                     must be long enough for the background thread to start
+                                     delivering streamed data before the playback position
+                                     reaches the end of the preload
+        @param samplesToBuffer  the number of samples the background reader should buffer
+                                ahead of the playback position
+    */
+    StreamingSamplerSound (const String& name,
+                           std::unique_ptr<AudioFormatReader> source,
+                           TimeSliceThread& backgroundThread,
+                           const BigInteger& midiNotes,
+                           int midiNoteForNormalPitch,
+                           double attackTimeSecs,
+                           double releaseTimeSecs,
+                           double preloadLengthSeconds = 0.5,
+                           int samplesToBuffer = 256 * 1024);
+
+    /** Destructor. */
+    ~StreamingSamplerSound() override;
+
+    //==============================================================================
+    /** Returns the sample's name */
+    const String& getName() const noexcept                  { return name; }
+
+    /** Changes the parameters of the ADSR envelope which will be applied to the sample. */
+    void setEnvelopeParameters (ADSR::Parameters parametersToUse)    { params = parametersToUse; }
+
+    /** Sets a number of milliseconds that a voice may block for while waiting for
+        streamed data before giving up and rendering silence.
+
+        The default of 0 never blocks, which is what you want for live playback.
+        Pass a negative value to wait forever, which can be useful when rendering
+        offline. @see BufferingAudioReader::setReadTimeout
+    */
+    void setReadTimeout (int timeoutMilliseconds) noexcept;
+
+    //==============================================================================
+    bool appliesToNote (int midiNoteNumber) override;
+    bool appliesToChannel (int midiChannel) override;
+
+private:
+    //==============================================================================
+    friend class SamplerVoice;
+
+    String name;
+    std::unique_ptr<BufferingAudioReader> reader;
+    AudioBuffer<float> preload;
+    double sourceSampleRate;
+    BigInteger midiNotes;
+    int64 length = 0;
+    int preloadLength = 0, crossfadeLength = 0, midiRootNote = 0;
+
+    ADSR::Parameters params;
+
+    JUCE_LEAK_DETECTOR (StreamingSamplerSound)
+};
+
+
+//==============================================================================
+/**
+    A subclass of SynthesiserVoice that can play a SamplerSound or a
+    StreamingSamplerSound.
 
     To use it, create a Synthesiser, add some SamplerVoice objects to it, then
     give it some SampledSound objects to play.
 
-    @see SamplerSound, Synthesiser, SynthesiserVoice
+    @see SamplerSound, StreamingSamplerSound, Synthesiser, SynthesiserVoice
 
     @tags{Audio}
 */
@@ -141,12 +245,19 @@ public:
 
 private:
     //==============================================================================
+    void renderNextStreamingBlock (StreamingSamplerSound&, AudioBuffer<float>&, int startSample, int numSamples);
+
     double pitchRatio = 0;
     double sourceSamplePosition = 0;
     float lgain = 0, rgain = 0;
 
     ADSR adsr;
 
+    // Scratch space used to assemble the source span for streamed sounds. The voice
+    // objects owned by a Synthesiser act as a pool, so in steady state this is
+    // reused across blocks and notes without allocating.
+    AudioBuffer<float> streamScratch;
+
     JUCE_LEAK_DETECTOR (SamplerVoice)
 };
 
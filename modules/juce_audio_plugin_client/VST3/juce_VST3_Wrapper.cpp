@@ -2238,6 +2238,7 @@ public:
         processSetup.symbolicSampleSize = Vst::kSample32;
 
         pluginInstance->setPlayHead (this);
+        pluginInstance->setParameterChangeList (&sampleAccurateParameterChanges);
 
         // Constructing the underlying static object involves dynamic allocation.
         // This call ensures that the construction won't happen on the audio thread.
@@ -2250,8 +2251,13 @@ public:
             juceVST3EditController->vst3IsPlaying = false;
 
         if (pluginInstance != nullptr)
+        {
             if (pluginInstance->getPlayHead() == this)
                 pluginInstance->setPlayHead (nullptr);
+
+            if (pluginInstance->getParameterChangeList() == &sampleAccurateParameterChanges)
+                pluginInstance->setParameterChangeList (nullptr);
+        }
     }
 
     //==============================================================================
@@ -3094,7 +3100,18 @@ public:
                    #endif
                     {
                         if (auto* param = comPluginInstance->getParamForVSTParamID (vstParamID))
+                        {
                             setValueAndNotifyIfChanged (*param, (float) value);
+
+                            // Also forward every point in the queue, so that processors which
+                            // read the attached change list can apply automation with
+                            // sample-accurate timing rather than once per block.
+                            for (Steinberg::int32 point = 0; point < numPoints; ++point)
+                                if (paramQueue->getPoint (point, offsetSamples, value) == kResultTrue)
+                                    sampleAccurateParameterChanges.addChange (param->getParameterIndex(),
+                                                                              jmax (0, (int) offsetSamples),
+                                                                              (float) value);
+                        }
                     }
                 }
             }
@@ -3145,6 +3162,7 @@ public:
         }
 
         midiBuffer.clear();
+        sampleAccurateParameterChanges.clear();
 
         if (data.inputParameterChanges != nullptr)
             processParameterChanges (*data.inputParameterChanges);
@@ -3528,6 +3546,7 @@ private:
     Vst::ProcessSetup processSetup;
 
     MidiBuffer midiBuffer;
+    AudioProcessorParameterChangeList sampleAccurateParameterChanges;
     Array<float*> channelListFloat;
     Array<double*> channelListDouble;
 
@@ -98,14 +98,53 @@ static std::vector<Vst::ParamID> getAllParamIDs (Vst::IEditController& controlle
     return result;
 }
 
+//==============================================================================
+class EditControllerParameterDispatcher;
+
+/*  A single timer, shared by every hosted instance, which drives all of their
+    parameter flushes from one tick. Hosting hundreds of plugins used to mean
+    one 60Hz Timer per instance; with this they all cost one timer callback.
+*/
+class SharedParameterFlushTimer  : private Timer
+{
+public:
+    SharedParameterFlushTimer() = default;
+    ~SharedParameterFlushTimer() override { stopTimer(); }
+
+    void add (EditControllerParameterDispatcher* dispatcher)
+    {
+        dispatchers.add (dispatcher);
+
+        if (! isTimerRunning())
+            startTimerHz (60);
+    }
+
+    void remove (EditControllerParameterDispatcher* dispatcher)
+    {
+        dispatchers.removeFirstMatchingValue (dispatcher);
+
+        if (dispatchers.isEmpty())
+            stopTimer();
+    }
+
+private:
+    void timerCallback() override;
+
+    Array<EditControllerParameterDispatcher*> dispatchers;
+};
+
 //==============================================================================
 /*  Allows parameter updates to be queued up without blocking,
     and automatically dispatches these updates on the main thread.
 */
-class EditControllerParameterDispatcher  : private Timer
+class EditControllerParameterDispatcher
 {
 public:
-    ~EditControllerParameterDispatcher() override { stopTimer(); }
+    ~EditControllerParameterDispatcher()
+    {
+        if (controller != nullptr)
+            sharedTimer->remove (this);
+    }
 
     void push (Steinberg::int32 index, float value)
     {
@@ -120,9 +159,11 @@ public:
 
     void start (Vst::IEditController& controllerIn)
     {
+        if (controller == nullptr)
+            sharedTimer->add (this);
+
         controller = &controllerIn;
         cache = CachedParamValues { getAllParamIDs (controllerIn) };
-        startTimerHz (60);
     }
 
     void flush()
@@ -134,15 +175,20 @@ public:
     }
 
 private:
-    void timerCallback() override
-    {
-        flush();
-    }
-
     CachedParamValues cache;
     Vst::IEditController* controller = nullptr;
+    SharedResourcePointer<SharedParameterFlushTimer> sharedTimer;
 };
 
+void SharedParameterFlushTimer::timerCallback()
+{
+    // a flush can re-enter the host and remove dispatchers, so this iterates
+    // defensively rather than with a range-for
+    for (int i = dispatchers.size(); --i >= 0;)
+        if (auto* dispatcher = dispatchers[i])
+            dispatcher->flush();
+}
+
 //==============================================================================
 std::array<uint32, 4> getNormalisedTUID (const TUID& tuid) noexcept
 {
@@ -2439,6 +2485,11 @@ public:
 
         setStateForAllMidiBuses (true);
 
+        // cache the parts of the process-call setup that don't change per block
+        processData = {};
+        processData.inputParameterChanges  = inputParameterChanges;
+        processData.outputParameterChanges = outputParameterChanges;
+
         warnOnFailure (holder->component->setActive (true));
         warnOnFailureIfImplemented (processor->setProcessing (true));
 
@@ -2551,13 +2602,13 @@ public:
 
         updateBypass (isProcessBlockBypassedCall);
 
-        ProcessData data;
+        // the structural parts of this were cached by prepareToPlay(), so only
+        // the fields that can change from block to block get refreshed here
+        ProcessData& data = processData;
         data.processMode            = isNonRealtime() ? kOffline : kRealtime;
         data.symbolicSampleSize     = sampleSize;
         data.numInputs              = numInputAudioBuses;
         data.numOutputs             = numOutputAudioBuses;
-        data.inputParameterChanges  = inputParameterChanges;
-        data.outputParameterChanges = outputParameterChanges;
         data.numSamples             = (Steinberg::int32) numSamples;
 
         updateTimingInformation (data, getSampleRate());
@@ -3075,6 +3126,7 @@ private:
     VSTComSmartPtr<ParameterChanges> outputParameterChanges { new ParameterChanges };
     VSTComSmartPtr<MidiEventList> midiInputs, midiOutputs;
     Vst::ProcessContext timingInfo; //< Only use this in processBlock()!
+    Vst::ProcessData processData;   //< The invariant parts are filled in by prepareToPlay()
     bool isControllerInitialised = false, isActive = false, lastProcessBlockCallWasBypass = false;
     VST3Parameter* bypassParam = nullptr;
 
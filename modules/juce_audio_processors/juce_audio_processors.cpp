@@ -187,6 +187,7 @@ private:
 #include "format/juce_AudioPluginFormatManager.cpp"
 #include "format_types/juce_LegacyAudioParameter.cpp"
 #include "processors/juce_AudioProcessor.cpp"
+#include "processors/juce_AudioProcessorParameterChangeList.cpp"
 #include "processors/juce_AudioPluginInstance.cpp"
 #include "processors/juce_AudioProcessorEditor.cpp"
 #include "processors/juce_AudioProcessorGraph.cpp"
@@ -197,7 +198,10 @@ private:
 #include "format_types/juce_VST3PluginFormat.cpp"
 #include "format_types/juce_AudioUnitPluginFormat.mm"
 #include "scanning/juce_KnownPluginList.cpp"
+#include "scanning/juce_KnownPluginListStore.cpp"
+#include "scanning/juce_PluginScanCache.cpp"
 #include "scanning/juce_PluginDirectoryScanner.cpp"
+#include "scanning/juce_PluginScannerCoordinator.cpp"
 #include "scanning/juce_PluginListComponent.cpp"
 #include "processors/juce_AudioProcessorParameterGroup.cpp"
 #include "utilities/juce_AudioProcessorParameterWithID.cpp"
@@ -208,4 +212,5 @@ private:
 #include "utilities/juce_AudioParameterChoice.cpp"
 #include "utilities/juce_ParameterAttachments.cpp"
 #include "utilities/juce_AudioProcessorValueTreeState.cpp"
+#include "utilities/juce_AudioProcessorReplayHarness.cpp"
 #include "utilities/juce_PluginHostType.cpp"
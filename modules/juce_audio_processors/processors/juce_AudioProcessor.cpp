@@ -326,6 +326,11 @@ void AudioProcessor::setPlayHead (AudioPlayHead* newPlayHead)
     playHead = newPlayHead;
 }
 
+void AudioProcessor::setParameterChangeList (AudioProcessorParameterChangeList* newChangeList)
+{
+    parameterChangeList = newChangeList;
+}
+
 void AudioProcessor::addListener (AudioProcessorListener* newListener)
 {
     const ScopedLock sl (listenerLock);
@@ -711,6 +711,18 @@ public:
     */
     AudioPlayHead* getPlayHead() const noexcept                 { return playHead; }
 
+    //==============================================================================
+    /** Returns the list of sample-accurate parameter changes for the block
+        currently being processed, or nullptr if none has been attached.
+
+        As with getPlayHead(), you should ONLY call this from your processBlock()
+        method, and you should not store the pointer or use it outside of the
+        current audio callback.
+
+        @see AudioProcessorParameterChangeList::iterateSubBlocks
+    */
+    AudioProcessorParameterChangeList* getParameterChangeList() const noexcept   { return parameterChangeList; }
+
     //==============================================================================
     /** Returns the total number of input channels.
 
@@ -1132,6 +1144,16 @@ public:
     */
     virtual void setPlayHead (AudioPlayHead* newPlayHead);
 
+    /** Tells the processor to read sample-accurate parameter changes from this list.
+
+        Hosts and plugin wrappers should attach a list once, then fill it before
+        each processBlock() call. The processor will not take ownership of the
+        object, so the caller must delete it when it is no longer being used.
+
+        @see getParameterChangeList
+    */
+    virtual void setParameterChangeList (AudioProcessorParameterChangeList* newChangeList);
+
     //==============================================================================
     /** This is called by the processor to specify its details before being played. Use this
         version of the function if you are not interested in any sidechain and/or aux buses
@@ -1375,6 +1397,9 @@ protected:
     /** @internal */
     std::atomic<AudioPlayHead*> playHead { nullptr };
 
+    /** @internal */
+    std::atomic<AudioProcessorParameterChangeList*> parameterChangeList { nullptr };
+
     /** @internal */
     void sendParamChangeMessageToListeners (int parameterIndex, float newValue);
 
@@ -81,8 +81,15 @@ struct GraphRenderSequence
         {
             const Context context { renderingBuffer.getArrayOfWritePointers(), midiBuffers.begin(), audioPlayHead, numSamples };
 
-            for (auto* op : renderOps)
-                op->perform (context);
+            if (workers.isEmpty())
+            {
+                for (auto* op : renderOps)
+                    op->perform (context);
+            }
+            else
+            {
+                performParallel (context);
+            }
         }
 
         for (int i = 0; i < buffer.getNumChannels(); ++i)
@@ -96,6 +103,7 @@ struct GraphRenderSequence
     void addClearChannelOp (int index)
     {
         createOp ([=] (const Context& c)    { FloatVectorOperations::clear (c.audioBuffers[index], c.numSamples); });
+        recordOpResources ({ audioResourceID (index) });
     }
 
     void addCopyChannelOp (int srcIndex, int dstIndex)
@@ -103,6 +111,7 @@ struct GraphRenderSequence
         createOp ([=] (const Context& c)    { FloatVectorOperations::copy (c.audioBuffers[dstIndex],
                                                                            c.audioBuffers[srcIndex],
                                                                            c.numSamples); });
+        recordOpResources ({ audioResourceID (srcIndex), audioResourceID (dstIndex) });
     }
 
     void addAddChannelOp (int srcIndex, int dstIndex)
@@ -110,33 +119,100 @@ struct GraphRenderSequence
         createOp ([=] (const Context& c)    { FloatVectorOperations::add (c.audioBuffers[dstIndex],
                                                                           c.audioBuffers[srcIndex],
                                                                           c.numSamples); });
+        recordOpResources ({ audioResourceID (srcIndex), audioResourceID (dstIndex) });
     }
 
     void addClearMidiBufferOp (int index)
     {
         createOp ([=] (const Context& c)    { c.midiBuffers[index].clear(); });
+        recordOpResources ({ midiResourceID (index) });
     }
 
     void addCopyMidiBufferOp (int srcIndex, int dstIndex)
     {
         createOp ([=] (const Context& c)    { c.midiBuffers[dstIndex] = c.midiBuffers[srcIndex]; });
+        recordOpResources ({ midiResourceID (srcIndex), midiResourceID (dstIndex) });
     }
 
     void addAddMidiBufferOp (int srcIndex, int dstIndex)
     {
         createOp ([=] (const Context& c)    { c.midiBuffers[dstIndex].addEvents (c.midiBuffers[srcIndex],
                                                                                  0, c.numSamples, 0); });
+        recordOpResources ({ midiResourceID (srcIndex), midiResourceID (dstIndex) });
     }
 
     void addDelayChannelOp (int chan, int delaySize)
     {
+        // Consecutive equal delays - typically the channels of one node's
+        // input - are fused into a single op sharing one delay-line
+        // allocation, rather than creating an op per channel.
+        if (auto* last = dynamic_cast<DelayChannelOp*> (renderOps.getLast()))
+        {
+            if (last->delayLength == delaySize && ! last->channels.contains (chan))
+            {
+                last->addChannel (chan);
+
+                if (chan != 0)
+                    opResources.getReference (opResources.size() - 1)
+                               .addIfNotAlreadyThere (audioResourceID (chan));
+
+                return;
+            }
+        }
+
         renderOps.add (new DelayChannelOp (chan, delaySize));
+        recordOpResources ({ audioResourceID (chan) });
     }
 
     void addProcessOp (const AudioProcessorGraph::Node::Ptr& node,
                        const Array<int>& audioChannelsUsed, int totalNumChans, int midiBuffer)
     {
         renderOps.add (new ProcessOp (node, audioChannelsUsed, totalNumChans, midiBuffer));
+
+        Array<int> resources;
+
+        for (auto chan : audioChannelsUsed)
+            resources.addIfNotAlreadyThere (audioResourceID (chan));
+
+        resources.add (midiResourceID (midiBuffer));
+
+        // The graph's IO nodes all read or write the shared input/output buffers,
+        // so they must be serialised with respect to each other.
+        if (dynamic_cast<AudioProcessorGraph::AudioGraphIOProcessor*> (node->getProcessor()) != nullptr)
+            resources.add (graphIOResourceID);
+
+        recordOpResources (std::move (resources));
+    }
+
+    /** Spins up the given number of worker threads and groups the ops into levels
+        of mutually-independent ops that can be rendered concurrently.
+
+        Must be called after the sequence has been fully built, and before the
+        first call to perform(). Passing zero (the default behaviour) leaves the
+        sequence rendering everything sequentially on the calling thread.
+    */
+    void prepareForParallelRendering (int numWorkerThreads)
+    {
+        workers.clear();
+        opLevels.clear();
+
+        if (numWorkerThreads <= 0 || renderOps.size() < 2)
+            return;
+
+        buildOpLevels();
+
+        // If every level contains a single op the sequence is one long chain of
+        // dependent ops, so there's nothing that could run concurrently.
+        if (opLevels.size() == renderOps.size())
+        {
+            opLevels.clear();
+            return;
+        }
+
+        currentLevel = opLevels.size();
+
+        for (int i = 0; i < numWorkerThreads; ++i)
+            workers.add (new RenderWorker (*this));
     }
 
     void prepareBuffers (int blockSize)
@@ -195,6 +271,164 @@ private:
 
     OwnedArray<RenderingOp> renderOps;
 
+    //==============================================================================
+    // For parallel rendering, each op records the audio and midi buffers it reads
+    // or writes as a list of resource IDs. Two ops sharing a resource must run in
+    // sequence-order; ops with disjoint resources are free to run concurrently.
+    enum { graphIOResourceID = -1 };
+
+    static int audioResourceID (int bufferIndex) noexcept   { return bufferIndex * 2; }
+    static int midiResourceID (int bufferIndex) noexcept    { return bufferIndex * 2 + 1; }
+
+    void recordOpResources (Array<int> resources)
+    {
+        // Buffer 0 is the shared read-only zero buffer, so it creates no dependencies.
+        resources.removeAllInstancesOf (audioResourceID (0));
+        resources.removeAllInstancesOf (midiResourceID (0));
+        opResources.add (std::move (resources));
+    }
+
+    // Groups the ops into levels, where each op lands one level below the deepest
+    // earlier op that touches any of the same buffers. Ops which share a buffer
+    // always end up in different levels in their original order, so running the
+    // levels one after another preserves the sequential semantics.
+    void buildOpLevels()
+    {
+        HashMap<int, int> lastOpUsingResource;
+        Array<int> levelOfOp;
+
+        for (int i = 0; i < renderOps.size(); ++i)
+        {
+            int level = 0;
+
+            for (auto resource : opResources.getReference (i))
+            {
+                if (lastOpUsingResource.contains (resource))
+                    level = jmax (level, levelOfOp.getUnchecked (lastOpUsingResource[resource]) + 1);
+
+                lastOpUsingResource.set (resource, i);
+            }
+
+            levelOfOp.add (level);
+
+            while (opLevels.size() <= level)
+                opLevels.add (new OpLevel());
+
+            opLevels.getUnchecked (level)->ops.add (renderOps.getUnchecked (i));
+        }
+    }
+
+    struct OpLevel
+    {
+        Array<RenderingOp*> ops;
+        std::atomic<int> nextOpToRun { 0 }, numOpsDone { 0 };
+    };
+
+    bool runNextOpInLevel (OpLevel& level, const Context& context)
+    {
+        if (level.nextOpToRun.load() >= level.ops.size())
+            return false;
+
+        auto index = level.nextOpToRun.fetch_add (1);
+
+        if (index >= level.ops.size())
+            return false;
+
+        level.ops.getUnchecked (index)->perform (context);
+        ++level.numOpsDone;
+        return true;
+    }
+
+    void performParallel (const Context& context)
+    {
+        for (auto* level : opLevels)
+        {
+            level->nextOpToRun = 0;
+            level->numOpsDone = 0;
+        }
+
+        currentContext = &context;
+        currentLevel = 0;
+
+        for (auto* worker : workers)
+            worker->notify();
+
+        for (int i = 0; i < opLevels.size(); ++i)
+        {
+            auto& level = *opLevels.getUnchecked (i);
+
+            while (runNextOpInLevel (level, context))
+            {}
+
+            while (level.numOpsDone.load() < level.ops.size())
+                Thread::yield();
+
+            currentLevel = i + 1;
+        }
+
+        // The workers must all have retired before the context goes out of scope.
+        while (numActiveWorkers.load() != 0)
+            Thread::yield();
+
+        currentContext = nullptr;
+    }
+
+    class RenderWorker  : public Thread
+    {
+    public:
+        explicit RenderWorker (GraphRenderSequence& s)
+            : Thread ("Graph Render Worker"), sequence (s)
+        {
+            startThread (realtimeAudioPriority);
+        }
+
+        ~RenderWorker() override
+        {
+            stopThread (-1);
+        }
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                wait (-1);
+
+                ++sequence.numActiveWorkers;
+
+                while (! threadShouldExit())
+                {
+                    auto levelIndex = sequence.currentLevel.load();
+
+                    if (levelIndex >= sequence.opLevels.size())
+                        break;
+
+                    auto& level = *sequence.opLevels.getUnchecked (levelIndex);
+
+                    if (auto* context = sequence.currentContext.load())
+                    {
+                        if (! sequence.runNextOpInLevel (level, *context))
+                            Thread::yield();
+                    }
+                }
+
+                --sequence.numActiveWorkers;
+            }
+        }
+
+    private:
+        GraphRenderSequence& sequence;
+
+        JUCE_DECLARE_NON_COPYABLE (RenderWorker)
+    };
+
+    Array<Array<int>> opResources;
+    OwnedArray<OpLevel> opLevels;
+    std::atomic<int> currentLevel { 0 }, numActiveWorkers { 0 };
+    std::atomic<const Context*> currentContext { nullptr };
+
+    // Destroyed first, so the workers are joined while everything they use is alive.
+    OwnedArray<RenderWorker> workers;
+
     //==============================================================================
     template <typename LambdaType,
               std::enable_if_t<std::is_rvalue_reference<LambdaType&&>::value, int> = 0>
@@ -212,33 +446,55 @@ private:
     }
 
     //==============================================================================
+    // Applies the same latency-compensation delay to a group of channels, using
+    // one shared allocation holding a ring of exactly delayLength samples per
+    // channel. As the ring length equals the delay, each sample is read from
+    // the same slot it's then written to, so a block is applied by exchanging
+    // contiguous runs with the ring - a single vectorisable pass per channel
+    // instead of a per-sample loop.
     struct DelayChannelOp  : public RenderingOp
     {
         DelayChannelOp (int chan, int delaySize)
-            : channel (chan),
-              bufferSize (delaySize + 1),
-              writeIndex (delaySize)
+            : delayLength (delaySize)
         {
-            buffer.calloc ((size_t) bufferSize);
+            jassert (delaySize > 0);
+            addChannel (chan);
         }
 
-        void perform (const Context& c) override
+        void addChannel (int chan)
         {
-            auto* data = c.audioBuffers[channel];
+            channels.add (chan);
+            buffer.calloc ((size_t) delayLength * (size_t) channels.size());
+        }
 
-            for (int i = c.numSamples; --i >= 0;)
+        void perform (const Context& c) override
+        {
+            for (int ch = 0; ch < channels.size(); ++ch)
             {
-                buffer[writeIndex] = *data;
-                *data++ = buffer[readIndex];
+                auto* ring = buffer + (size_t) ch * (size_t) delayLength;
+                auto* data = c.audioBuffers[channels.getUnchecked (ch)];
+                auto pos = writeIndex;
 
-                if (++readIndex  >= bufferSize) readIndex = 0;
-                if (++writeIndex >= bufferSize) writeIndex = 0;
+                for (int numLeft = c.numSamples; numLeft > 0;)
+                {
+                    const auto num = jmin (numLeft, delayLength - pos);
+                    std::swap_ranges (data, data + num, ring + pos);
+                    data += num;
+                    numLeft -= num;
+                    pos += num;
+
+                    if (pos == delayLength)
+                        pos = 0;
+                }
             }
+
+            writeIndex = (writeIndex + c.numSamples) % delayLength;
         }
 
         HeapBlock<FloatType> buffer;
-        const int channel, bufferSize;
-        int readIndex = 0, writeIndex;
+        Array<int> channels;
+        const int delayLength;
+        int writeIndex = 0;
 
         JUCE_DECLARE_NON_COPYABLE (DelayChannelOp)
     };
@@ -263,6 +519,8 @@ private:
 
         void perform (const Context& c) override
         {
+            RealtimeTracer::ScopedZone zone (zoneName.toRawUTF8());
+
             processor.setPlayHead (c.audioPlayHead);
 
             for (int i = 0; i < totalChans; ++i)
@@ -322,6 +580,7 @@ private:
 
         const AudioProcessorGraph::Node::Ptr node;
         AudioProcessor& processor;
+        const String zoneName { processor.getName() };
 
         Array<int> audioChannelsToUse;
         HeapBlock<FloatType*> audioChannels;
@@ -948,6 +1207,17 @@ void AudioProcessorGraph::topologyChanged()
         updateOnMessageThread (*this);
 }
 
+void AudioProcessorGraph::setNumRenderWorkerThreads (int numThreads)
+{
+    numThreads = jmax (0, numThreads);
+
+    if (numRenderWorkerThreads != numThreads)
+    {
+        numRenderWorkerThreads = numThreads;
+        topologyChanged();
+    }
+}
+
 void AudioProcessorGraph::clear()
 {
     const ScopedLock sl (getCallbackLock());
@@ -1270,6 +1540,9 @@ void AudioProcessorGraph::buildRenderingSequence()
     RenderSequenceBuilder<RenderSequenceFloat>  builderF (*this, *newSequenceF);
     RenderSequenceBuilder<RenderSequenceDouble> builderD (*this, *newSequenceD);
 
+    newSequenceF->prepareForParallelRendering (numRenderWorkerThreads);
+    newSequenceD->prepareForParallelRendering (numRenderWorkerThreads);
+
     const ScopedLock sl (getCallbackLock());
 
     const auto currentBlockSize = getBlockSize();
@@ -1585,4 +1858,139 @@ void AudioProcessorGraph::AudioGraphIOProcessor::setParentGraph (AudioProcessorG
     }
 }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct AudioProcessorGraphTests : public UnitTest
+{
+    AudioProcessorGraphTests()
+        : UnitTest ("AudioProcessorGraph", UnitTestCategories::audio)
+    {}
+
+    // A stereo pass-through that really delays its input by the latency it
+    // reports, so compensation errors show up as misaligned samples.
+    struct LatentPassThrough : public AudioProcessor
+    {
+        explicit LatentPassThrough (int latencyToUse)
+            : AudioProcessor (BusesProperties().withInput  ("In",  AudioChannelSet::stereo())
+                                               .withOutput ("Out", AudioChannelSet::stereo()))
+        {
+            setLatencySamples (latencyToUse);
+        }
+
+        void prepareToPlay (double, int) override
+        {
+            delayLines.clear();
+
+            for (int i = 0; i < 2; ++i)
+                delayLines.add (std::vector<float> ((size_t) getLatencySamples(), 0.0f));
+        }
+
+        void releaseResources() override {}
+
+        void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+        {
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            {
+                auto& line = delayLines.getReference (ch);
+                auto* data = buffer.getWritePointer (ch);
+
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                {
+                    line.push_back (data[i]);
+                    data[i] = line.front();
+                    line.erase (line.begin());
+                }
+            }
+        }
+
+        const String getName() const override                   { return "LatentPassThrough"; }
+        double getTailLengthSeconds() const override            { return 0.0; }
+        bool acceptsMidi() const override                       { return false; }
+        bool producesMidi() const override                      { return false; }
+        AudioProcessorEditor* createEditor() override           { return nullptr; }
+        bool hasEditor() const override                         { return false; }
+        int getNumPrograms() override                           { return 1; }
+        int getCurrentProgram() override                        { return 0; }
+        void setCurrentProgram (int) override                   {}
+        const String getProgramName (int) override              { return {}; }
+        void changeProgramName (int, const String&) override    {}
+        void getStateInformation (MemoryBlock&) override        {}
+        void setStateInformation (const void*, int) override    {}
+
+        Array<std::vector<float>> delayLines;
+    };
+
+    void runLatencyTest (int latency, int blockSize)
+    {
+        using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+
+        AudioProcessorGraph graph;
+        graph.setPlayConfigDetails (2, 2, 44100.0, blockSize);
+
+        auto inputNode  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode));
+        auto latentNode = graph.addNode (std::make_unique<LatentPassThrough> (latency));
+        auto outputNode = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode));
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            // A latent path and a direct path, summed at the output: without
+            // compensation of the direct path, the copies won't line up.
+            expect (graph.addConnection ({ { inputNode->nodeID,  ch }, { latentNode->nodeID, ch } }));
+            expect (graph.addConnection ({ { latentNode->nodeID, ch }, { outputNode->nodeID, ch } }));
+            expect (graph.addConnection ({ { inputNode->nodeID,  ch }, { outputNode->nodeID, ch } }));
+        }
+
+        graph.prepareToPlay (44100.0, blockSize);
+        expectEquals (graph.getLatencySamples(), latency);
+
+        constexpr int totalSamples = 2048;
+        AudioBuffer<float> output (2, totalSamples);
+        MidiBuffer midi;
+
+        auto inputSample = [] (int channel, int index)
+        {
+            return (float) index * (channel == 0 ? 0.001f : -0.0005f);
+        };
+
+        for (int pos = 0; pos < totalSamples; pos += blockSize)
+        {
+            const auto num = jmin (blockSize, totalSamples - pos);
+            AudioBuffer<float> block (output.getArrayOfWritePointers(), 2, pos, num);
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < num; ++i)
+                    block.setSample (ch, i, inputSample (ch, pos + i));
+
+            graph.processBlock (block, midi);
+        }
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = latency; i < totalSamples; ++i)
+                expectWithinAbsoluteError (output.getSample (ch, i),
+                                           2.0f * inputSample (ch, i - latency),
+                                           1.0e-5f);
+
+        graph.releaseResources();
+    }
+
+    void runTest() override
+    {
+        beginTest ("Latency compensation aligns parallel paths (delay shorter than block)");
+        runLatencyTest (37, 128);
+
+        beginTest ("Latency compensation aligns parallel paths (delay longer than block)");
+        runLatencyTest (300, 128);
+
+        beginTest ("Latency compensation aligns parallel paths (delay equal to block)");
+        runLatencyTest (64, 64);
+    }
+};
+
+static AudioProcessorGraphTests audioProcessorGraphTests;
+
+#endif
+
 } // namespace juce
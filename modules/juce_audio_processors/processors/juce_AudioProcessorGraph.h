@@ -293,6 +293,32 @@ public:
     */
     bool removeIllegalConnections();
 
+    //==============================================================================
+    /** Sets the number of worker threads used to render the graph.
+
+        By default the graph renders all of its nodes sequentially on the audio
+        thread. When the number of workers is greater than zero, mutually
+        independent branches of the graph are rendered concurrently across the
+        worker threads and the audio thread itself, which can substantially
+        reduce the cost of a callback for graphs that are wider than they are
+        deep. Graphs that form a single serial chain gain nothing from workers
+        and will continue to render entirely on the audio thread.
+
+        Note that with workers enabled a node's processBlock() may be invoked
+        from a worker thread rather than the audio thread (although never from
+        more than one thread at once), so all processors in the graph must be
+        able to cope with that.
+
+        Changing this value triggers a rebuild of the rendering sequence, in the
+        same way as a change to the graph's topology.
+    */
+    void setNumRenderWorkerThreads (int numThreads);
+
+    /** Returns the number of worker threads used to render the graph, as set by
+        setNumRenderWorkerThreads(). This is zero by default.
+    */
+    int getNumRenderWorkerThreads() const noexcept          { return numRenderWorkerThreads; }
+
     //==============================================================================
     /** A special type of AudioProcessor that can live inside an AudioProcessorGraph
         in order to use the audio that comes into and out of the graph itself.
@@ -426,6 +452,7 @@ private:
     //==============================================================================
     ReferenceCountedArray<Node> nodes;
     NodeID lastNodeID = {};
+    int numRenderWorkerThreads = 0;
 
     struct RenderSequenceFloat;
     struct RenderSequenceDouble;
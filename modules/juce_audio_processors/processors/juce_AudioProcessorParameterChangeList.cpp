@@ -0,0 +1,210 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+AudioProcessorParameterChangeList::AudioProcessorParameterChangeList()
+{
+    scheduledChanges.allocate ((size_t) scheduledFifo.getTotalSize(), false);
+}
+
+AudioProcessorParameterChangeList::~AudioProcessorParameterChangeList() = default;
+
+void AudioProcessorParameterChangeList::addChange (int parameterIndex, int sampleOffset, float newNormalisedValue)
+{
+    jassert (sampleOffset >= 0);
+
+    // Binary-search for the insertion point, keeping changes with equal offsets
+    // in the order they were added.
+    int start = 0, end = changes.size();
+
+    while (start < end)
+    {
+        auto halfway = (start + end) / 2;
+
+        if (changes.getReference (halfway).sampleOffset <= sampleOffset)
+            start = halfway + 1;
+        else
+            end = halfway;
+    }
+
+    changes.insert (start, { parameterIndex, sampleOffset, newNormalisedValue });
+}
+
+void AudioProcessorParameterChangeList::clear() noexcept
+{
+    changes.clearQuick();
+}
+
+bool AudioProcessorParameterChangeList::scheduleChange (int parameterIndex, float newNormalisedValue) noexcept
+{
+    const ScopedLock sl (writerLock);
+
+    const auto scope = scheduledFifo.write (1);
+
+    if (scope.blockSize1 + scope.blockSize2 == 0)
+        return false;
+
+    scheduledChanges[scope.startIndex1] = { parameterIndex, 0, newNormalisedValue };
+    return true;
+}
+
+int AudioProcessorParameterChangeList::drainScheduledChanges (int sampleOffset)
+{
+    const auto scope = scheduledFifo.read (scheduledFifo.getNumReady());
+
+    for (int i = 0; i < scope.blockSize1; ++i)
+        addChange (scheduledChanges[scope.startIndex1 + i].parameterIndex, sampleOffset,
+                   scheduledChanges[scope.startIndex1 + i].newValue);
+
+    for (int i = 0; i < scope.blockSize2; ++i)
+        addChange (scheduledChanges[scope.startIndex2 + i].parameterIndex, sampleOffset,
+                   scheduledChanges[scope.startIndex2 + i].newValue);
+
+    return scope.blockSize1 + scope.blockSize2;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct AudioProcessorParameterChangeListTests  : public UnitTest
+{
+    AudioProcessorParameterChangeListTests()
+        : UnitTest ("AudioProcessorParameterChangeList", UnitTestCategories::audioProcessorParameters)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Changes are kept sorted by sample offset, with stable order for equal offsets");
+        {
+            AudioProcessorParameterChangeList list;
+
+            list.addChange (0, 64,  0.5f);
+            list.addChange (1, 0,   0.1f);
+            list.addChange (2, 64,  0.9f);
+            list.addChange (3, 32,  0.3f);
+
+            expectEquals (list.getNumChanges(), 4);
+            expectEquals (list.getChange (0).parameterIndex, 1);
+            expectEquals (list.getChange (1).parameterIndex, 3);
+            expectEquals (list.getChange (2).parameterIndex, 0);
+            expectEquals (list.getChange (3).parameterIndex, 2);
+
+            list.clear();
+            expect (list.isEmpty());
+        }
+
+        beginTest ("An empty list iterates the whole block in one sub-block");
+        {
+            AudioProcessorParameterChangeList list;
+            int calls = 0;
+
+            list.iterateSubBlocks (512, 1, [&] (int start, int length, const AudioProcessorParameterChangeList::Change*, int numChanges)
+            {
+                ++calls;
+                expectEquals (start, 0);
+                expectEquals (length, 512);
+                expectEquals (numChanges, 0);
+            });
+
+            expectEquals (calls, 1);
+        }
+
+        beginTest ("Sub-blocks are split at change points and cover the whole block");
+        {
+            AudioProcessorParameterChangeList list;
+            list.addChange (0, 0,   0.0f);
+            list.addChange (0, 100, 0.25f);
+            list.addChange (1, 100, 0.5f);
+            list.addChange (0, 300, 1.0f);
+
+            int nextExpectedStart = 0;
+            float lastValue = -1.0f;
+
+            list.iterateSubBlocks (512, 1, [&] (int start, int length, const AudioProcessorParameterChangeList::Change* c, int numChanges)
+            {
+                expectEquals (start, nextExpectedStart);
+                nextExpectedStart = start + length;
+
+                for (int i = 0; i < numChanges; ++i)
+                {
+                    expectEquals (c[i].sampleOffset, start);
+
+                    if (c[i].parameterIndex == 0)
+                        lastValue = c[i].newValue;
+                }
+            });
+
+            expectEquals (nextExpectedStart, 512);
+            expectEquals (lastValue, 1.0f);
+        }
+
+        beginTest ("Changes closer together than the minimum sub-block size are grouped");
+        {
+            AudioProcessorParameterChangeList list;
+
+            for (int i = 0; i < 16; ++i)
+                list.addChange (0, i * 4, (float) i / 16.0f);
+
+            int totalChangesSeen = 0, totalSamples = 0;
+
+            list.iterateSubBlocks (128, 32, [&] (int start, int length, const AudioProcessorParameterChangeList::Change*, int numChanges)
+            {
+                expect (length >= 32 || start + length == 128);
+                totalChangesSeen += numChanges;
+                totalSamples += length;
+            });
+
+            expectEquals (totalChangesSeen, 16);
+            expectEquals (totalSamples, 128);
+        }
+
+        beginTest ("Scheduled changes are drained into the list");
+        {
+            AudioProcessorParameterChangeList list;
+
+            expect (list.scheduleChange (5, 0.75f));
+            expect (list.scheduleChange (6, 0.25f));
+            expect (list.isEmpty());
+
+            expectEquals (list.drainScheduledChanges (7), 2);
+            expectEquals (list.getNumChanges(), 2);
+            expectEquals (list.getChange (0).parameterIndex, 5);
+            expectEquals (list.getChange (0).sampleOffset, 7);
+            expectEquals (list.getChange (1).newValue, 0.25f);
+
+            expectEquals (list.drainScheduledChanges(), 0);
+        }
+    }
+};
+
+static AudioProcessorParameterChangeListTests audioProcessorParameterChangeListTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Holds a list of sample-accurate parameter changes that apply within a single
+    audio block.
+
+    Hosts and plugin wrappers can attach one of these to an AudioProcessor with
+    AudioProcessor::setParameterChangeList() and fill it before each call to
+    processBlock(). The processor can then read the changes with
+    AudioProcessor::getParameterChangeList() and use iterateSubBlocks() to render
+    the block in segments between change points, instead of quantising automation
+    to block boundaries or splitting buffers by hand.
+
+    The list also provides a small lock-free scheduling queue, so that code on
+    other threads (e.g. GUI attachments) can post changes which the audio thread
+    moves into the list at the start of each block with drainScheduledChanges().
+
+    Apart from the scheduling queue, this class is not thread-safe: addChange(),
+    clear() and the iteration functions must all be called from the thread that
+    is driving processBlock().
+
+    @see AudioProcessor::setParameterChangeList, AudioProcessor::getParameterChangeList
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioProcessorParameterChangeList
+{
+public:
+    /** Creates an empty list. */
+    AudioProcessorParameterChangeList();
+
+    /** Destructor. */
+    ~AudioProcessorParameterChangeList();
+
+    //==============================================================================
+    /** A single pending parameter change. */
+    struct Change
+    {
+        /** The index of the parameter in AudioProcessor::getParameters(). */
+        int parameterIndex;
+
+        /** The offset into the current block, in samples, at which the change
+            takes effect. This is always in the range [0, numSamples).
+        */
+        int sampleOffset;
+
+        /** The new normalised value, in the range [0, 1]. */
+        float newValue;
+    };
+
+    //==============================================================================
+    /** Adds a change to the list.
+
+        The list is kept sorted by sample offset; changes added with equal offsets
+        keep their insertion order, so the last change added for a parameter at a
+        given offset wins.
+    */
+    void addChange (int parameterIndex, int sampleOffset, float newNormalisedValue);
+
+    /** Removes all changes from the list, without freeing any storage. */
+    void clear() noexcept;
+
+    /** Returns true if the list contains no changes. */
+    bool isEmpty() const noexcept                       { return changes.isEmpty(); }
+
+    /** Returns the number of changes in the list. */
+    int getNumChanges() const noexcept                  { return changes.size(); }
+
+    /** Returns one of the changes, ordered by sample offset. */
+    const Change& getChange (int index) const noexcept  { return changes.getReference (index); }
+
+    /** Returns the start of the list, for range-based-for iteration. */
+    const Change* begin() const noexcept                { return changes.begin(); }
+
+    /** Returns the end of the list, for range-based-for iteration. */
+    const Change* end() const noexcept                  { return changes.end(); }
+
+    //==============================================================================
+    /** Iterates a block of the given length as a series of contiguous sub-blocks,
+        split at the sample offsets where changes occur.
+
+        The callback must be callable as
+
+        @code
+        callback (int startSample, int numSamplesInSubBlock,
+                  const AudioProcessorParameterChangeList::Change* changes, int numChanges);
+        @endcode
+
+        and is invoked once per sub-block, with the changes that take effect at the
+        start of that sub-block. Apply the changes to your parameters, then render
+        startSample..startSample + numSamplesInSubBlock.
+
+        To bound the per-block overhead, no sub-block other than the last will be
+        shorter than minimumSubBlockSize: changes that fall closer together than
+        that are grouped and applied together at the start of a sub-block. Pass 1
+        to split at every change point.
+
+        If the list is empty this simply calls the callback once for the whole
+        block, so the fast path costs no more than an empty check.
+    */
+    template <typename SubBlockCallback>
+    void iterateSubBlocks (int numSamples, int minimumSubBlockSize, SubBlockCallback&& callback) const
+    {
+        jassert (numSamples > 0 && minimumSubBlockSize > 0);
+
+        if (changes.isEmpty())
+        {
+            callback (0, numSamples, static_cast<const Change*> (nullptr), 0);
+            return;
+        }
+
+        auto* data = changes.begin();
+        auto total = changes.size();
+
+        int subBlockStart = 0;
+        int firstChange = 0;
+
+        while (subBlockStart < numSamples)
+        {
+            // Take all changes that are due at, or have fallen behind, the sub-block start.
+            int lastChange = firstChange;
+
+            while (lastChange < total && data[lastChange].sampleOffset <= subBlockStart)
+                ++lastChange;
+
+            auto subBlockEnd = lastChange < total ? jmin (numSamples, data[lastChange].sampleOffset)
+                                                  : numSamples;
+
+            if (subBlockEnd - subBlockStart < minimumSubBlockSize)
+                subBlockEnd = jmin (numSamples, subBlockStart + minimumSubBlockSize);
+
+            callback (subBlockStart, subBlockEnd - subBlockStart,
+                      lastChange > firstChange ? data + firstChange : nullptr,
+                      lastChange - firstChange);
+
+            subBlockStart = subBlockEnd;
+            firstChange = lastChange;
+        }
+
+        // Changes at offsets beyond the end of the block should have been clipped
+        // by whoever filled the list; apply any stragglers so no change is lost.
+        if (firstChange < total)
+            callback (numSamples, 0, data + firstChange, total - firstChange);
+    }
+
+    //==============================================================================
+    /** Posts a change from another thread, to be picked up by the next call to
+        drainScheduledChanges() on the audio thread.
+
+        Concurrent scheduling threads are serialised with a lock, but the
+        audio-thread consumer never takes it, so this will not block the audio
+        thread. Returns false if the scheduling queue is full, in which case
+        the change is dropped.
+    */
+    bool scheduleChange (int parameterIndex, float newNormalisedValue) noexcept;
+
+    /** Moves any changes posted with scheduleChange() into the list, giving them
+        all the specified sample offset.
+
+        Call this from the audio thread at the start of each block, after clearing
+        the previous block's changes. Returns the number of changes drained.
+    */
+    int drainScheduledChanges (int sampleOffset = 0);
+
+private:
+    //==============================================================================
+    Array<Change> changes;
+
+    AbstractFifo scheduledFifo { 1024 };
+    HeapBlock<Change> scheduledChanges;
+    CriticalSection writerLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioProcessorParameterChangeList)
+};
+
+} // namespace juce
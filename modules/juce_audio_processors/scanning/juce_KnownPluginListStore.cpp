@@ -0,0 +1,271 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/*  The file layout is:
+
+        int32   magic number
+        int32   number of records
+        int32   number of blacklisted files, followed by that many strings
+        index:  for each record, { int64 identifier hash, int64 file offset, int32 size }
+        records, each one the UTF-8 XML for a single PluginDescription
+
+    Only the part up to the end of the index needs to be read at startup; the
+    records themselves are paged in individually as they're asked for.
+*/
+static constexpr int knownPluginListStoreMagic = 0x4b504c31; // 'KPL1'
+
+KnownPluginListStore::KnownPluginListStore (const File& storageFile)  : file (storageFile) {}
+KnownPluginListStore::~KnownPluginListStore() = default;
+
+bool KnownPluginListStore::openIndex()
+{
+    const ScopedLock sl (streamLock);
+
+    loader.reset();
+    index.clearQuick();
+    firstRecordWithHash.clear();
+    blacklist.clearQuick();
+    stream = file.createInputStream();
+
+    if (stream == nullptr || stream->readInt() != knownPluginListStoreMagic)
+    {
+        stream.reset();
+        return false;
+    }
+
+    auto numRecords     = stream->readInt();
+    auto numBlacklisted = stream->readInt();
+
+    if (numRecords < 0 || numBlacklisted < 0)
+    {
+        stream.reset();
+        return false;
+    }
+
+    for (int i = 0; i < numBlacklisted; ++i)
+        blacklist.add (stream->readString());
+
+    index.ensureStorageAllocated (numRecords);
+
+    for (int i = 0; i < numRecords; ++i)
+    {
+        IndexEntry entry;
+        entry.identifierHash   = stream->readInt64();
+        entry.offset           = stream->readInt64();
+        entry.size             = stream->readInt();
+        entry.nextWithSameHash = -1;
+
+        if (firstRecordWithHash.contains (entry.identifierHash))
+        {
+            auto chain = firstRecordWithHash[entry.identifierHash];
+
+            while (index.getReference (chain).nextWithSameHash >= 0)
+                chain = index.getReference (chain).nextWithSameHash;
+
+            index.getReference (chain).nextWithSameHash = i;
+        }
+        else
+        {
+            firstRecordWithHash.set (entry.identifierHash, i);
+        }
+
+        index.add (entry);
+    }
+
+    return true;
+}
+
+int KnownPluginListStore::getNumRecords() const noexcept
+{
+    return index.size();
+}
+
+const StringArray& KnownPluginListStore::getBlacklistedFiles() const noexcept
+{
+    return blacklist;
+}
+
+std::unique_ptr<PluginDescription> KnownPluginListStore::loadRecord (int recordIndex) const
+{
+    MemoryBlock recordData;
+
+    {
+        const ScopedLock sl (streamLock);
+
+        if (stream == nullptr || ! isPositiveAndBelow (recordIndex, index.size()))
+            return {};
+
+        auto& entry = index.getReference (recordIndex);
+
+        if (! stream->setPosition (entry.offset))
+            return {};
+
+        if (stream->readIntoMemoryBlock (recordData, entry.size) != (size_t) entry.size)
+            return {};
+    }
+
+    if (auto xml = parseXML (recordData.toString()))
+    {
+        auto desc = std::make_unique<PluginDescription>();
+
+        if (desc->loadFromXml (*xml))
+            return desc;
+    }
+
+    return {};
+}
+
+std::unique_ptr<PluginDescription> KnownPluginListStore::loadRecordWithIdentifier (const String& identifierString) const
+{
+    auto hash = identifierString.hashCode64();
+
+    for (auto i = firstRecordWithHash.contains (hash) ? firstRecordWithHash[hash] : -1;
+         i >= 0;
+         i = index.getReference (i).nextWithSameHash)
+        if (auto desc = loadRecord (i))
+            if (desc->matchesIdentifierString (identifierString))
+                return desc;
+
+    return {};
+}
+
+void KnownPluginListStore::populateList (KnownPluginList& listToFill) const
+{
+    for (auto& b : blacklist)
+        listToFill.addToBlacklist (b);
+
+    for (int i = 0; i < index.size(); ++i)
+        if (auto desc = loadRecord (i))
+            listToFill.addType (*desc);
+}
+
+//==============================================================================
+class KnownPluginListStore::AsyncLoader  : private Timer
+{
+public:
+    AsyncLoader (KnownPluginListStore& storeToUse, KnownPluginList& listToFill, int batchSize)
+        : store (storeToUse), list (listToFill), numPerBatch (jmax (1, batchSize))
+    {
+        for (auto& b : store.getBlacklistedFiles())
+            list.addToBlacklist (b);
+
+        startTimer (1);
+    }
+
+    bool isFinished() const noexcept    { return nextRecord >= store.getNumRecords(); }
+
+private:
+    void timerCallback() override
+    {
+        auto limit = jmin (store.getNumRecords(), nextRecord + numPerBatch);
+
+        while (nextRecord < limit)
+        {
+            if (auto desc = store.loadRecord (nextRecord++))
+                list.addType (*desc);
+        }
+
+        if (isFinished())
+            stopTimer();
+    }
+
+    KnownPluginListStore& store;
+    KnownPluginList& list;
+    const int numPerBatch;
+    int nextRecord = 0;
+};
+
+void KnownPluginListStore::populateListAsync (KnownPluginList& listToFill, int numRecordsPerBatch)
+{
+    loader = std::make_unique<AsyncLoader> (*this, listToFill, numRecordsPerBatch);
+}
+
+bool KnownPluginListStore::isLoading() const noexcept
+{
+    return loader != nullptr && ! loader->isFinished();
+}
+
+//==============================================================================
+bool KnownPluginListStore::writeList (const KnownPluginList& list, const File& file)
+{
+    auto types = list.getTypes();
+    auto& blacklisted = list.getBlacklistedFiles();
+
+    Array<MemoryBlock> records;
+    records.ensureStorageAllocated (types.size());
+
+    for (auto& type : types)
+    {
+        MemoryOutputStream record;
+        record << type.createXml()->toString();
+        records.add (record.getMemoryBlock());
+    }
+
+    MemoryOutputStream header;
+    header.writeInt (knownPluginListStoreMagic);
+    header.writeInt (types.size());
+    header.writeInt (blacklisted.size());
+
+    for (auto& b : blacklisted)
+        header.writeString (b);
+
+    constexpr int64 bytesPerIndexEntry = 8 + 8 + 4;
+    auto recordOffset = (int64) header.getDataSize() + bytesPerIndexEntry * types.size();
+
+    TemporaryFile temp (file);
+
+    {
+        FileOutputStream out (temp.getFile());
+
+        if (! out.openedOk())
+            return false;
+
+        out << header;
+
+        for (int i = 0; i < types.size(); ++i)
+        {
+            out.writeInt64 (types.getReference (i).createIdentifierString().hashCode64());
+            out.writeInt64 (recordOffset);
+            out.writeInt ((int) records.getReference (i).getSize());
+
+            recordOffset += (int64) records.getReference (i).getSize();
+        }
+
+        for (auto& record : records)
+            out << record;
+
+        out.flush();
+
+        if (out.getStatus().failed())
+            return false;
+    }
+
+    return temp.overwriteTargetFileWithTemporary();
+}
+
+} // namespace juce
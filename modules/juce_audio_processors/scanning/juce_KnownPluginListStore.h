@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A file-backed store for the contents of a KnownPluginList.
+
+    Unlike KnownPluginList::createXml(), which serialises every PluginDescription
+    into one XML document that has to be parsed in full before the list can be
+    used, this class keeps each description as a separate record in a binary
+    file, preceded by a compact index. Opening the store only reads the index,
+    so a host with thousands of scanned plug-ins can start up quickly, look up
+    individual records on demand, or stream the whole list in asynchronously
+    while its UI is already running.
+
+    @see KnownPluginList
+
+    @tags{Audio}
+*/
+class JUCE_API  KnownPluginListStore
+{
+public:
+    //==============================================================================
+    /** Creates a store that will read from the given file. */
+    explicit KnownPluginListStore (const File& storageFile);
+
+    /** Destructor. */
+    ~KnownPluginListStore();
+
+    //==============================================================================
+    /** Reads the file's index into memory, without loading any of the records.
+        Returns false if the file doesn't exist or isn't a valid store.
+    */
+    bool openIndex();
+
+    /** Returns the number of plug-in descriptions in the store.
+        Only valid after a successful call to openIndex().
+    */
+    int getNumRecords() const noexcept;
+
+    /** Returns the blacklisted files that were saved along with the list. */
+    const StringArray& getBlacklistedFiles() const noexcept;
+
+    //==============================================================================
+    /** Loads and returns a single record, or nullptr if the index is out of
+        range or the record can't be read.
+    */
+    std::unique_ptr<PluginDescription> loadRecord (int index) const;
+
+    /** Looks for a record whose PluginDescription::createIdentifierString()
+        matches the given string, using the in-memory hash index, and loads
+        just that record. Returns nullptr if there's no match.
+    */
+    std::unique_ptr<PluginDescription> loadRecordWithIdentifier (const String& identifierString) const;
+
+    //==============================================================================
+    /** Synchronously adds every record in the store (and the saved blacklist)
+        to the given list.
+    */
+    void populateList (KnownPluginList& listToFill) const;
+
+    /** Adds the store's records to the given list in batches on the message
+        thread, so that menus and list-boxes attached to the list populate
+        incrementally instead of blocking while the whole file is parsed.
+
+        The list must remain valid until loading has finished or this store is
+        destroyed. The list's change listeners are notified as each batch
+        arrives.
+    */
+    void populateListAsync (KnownPluginList& listToFill, int numRecordsPerBatch = 100);
+
+    /** Returns true if a load started by populateListAsync() is still going on. */
+    bool isLoading() const noexcept;
+
+    //==============================================================================
+    /** Writes the entire contents of a list (and its blacklist) to the given
+        file, replacing anything that was there before.
+        Returns true if the file was written successfully.
+    */
+    static bool writeList (const KnownPluginList& list, const File& file);
+
+private:
+    //==============================================================================
+    struct IndexEntry
+    {
+        int64 identifierHash, offset;
+        int size, nextWithSameHash;
+    };
+
+    File file;
+    Array<IndexEntry> index;
+    FlatHashMap<int64, int> firstRecordWithHash;
+    StringArray blacklist;
+    std::unique_ptr<FileInputStream> stream;
+    CriticalSection streamLock;
+
+    class AsyncLoader;
+    std::unique_ptr<AsyncLoader> loader;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (KnownPluginListStore)
+};
+
+} // namespace juce
@@ -95,6 +95,22 @@ bool PluginDirectoryScanner::scanNextFile (bool dontRescanIfAlreadyInList,
 
             OwnedArray<PluginDescription> typesFound;
 
+            if (scanCache != nullptr
+                 && ! list.getBlacklistedFiles().contains (file)
+                 && scanCache->findCachedScan (file, typesFound))
+            {
+                // The file hasn't changed since it was last scanned, so its cached
+                // results can be used without loading the binary at all.
+                for (auto* type : typesFound)
+                    list.addType (*type);
+
+                if (typesFound.size() == 0)
+                    failedFiles.add (file);
+
+                updateProgress();
+                return index > 0;
+            }
+
             // Add this plugin to the end of the dead-man's pedal list in case it crashes...
             auto crashedPlugins = readDeadMansPedalFile (deadMansPedalFile);
             crashedPlugins.removeString (file);
@@ -107,6 +123,9 @@ bool PluginDirectoryScanner::scanNextFile (bool dontRescanIfAlreadyInList,
             crashedPlugins.removeString (file);
             setDeadMansPedalFile (crashedPlugins);
 
+            if (scanCache != nullptr)
+                scanCache->addScanResult (file, typesFound);
+
             if (typesFound.size() == 0 && ! list.getBlacklistedFiles().contains (file))
                 failedFiles.add (file);
         }
@@ -79,6 +79,17 @@ public:
     */
     void setFilesOrIdentifiersToScan (const StringArray& filesOrIdentifiersToScan);
 
+    /** Tells the scanner to consult a cache of previous scan results.
+
+        When a cache is set, files whose entries are still valid are re-listed
+        from the cache without being loaded or instantiated, and the results of
+        any files that do get scanned are recorded in it. The cache is not owned
+        by the scanner, and the caller should flush it once scanning is done.
+
+        @see PluginScanCache
+    */
+    void setScanCache (PluginScanCache* cacheToUse) noexcept    { scanCache = cacheToUse; }
+
     /** Tries the next likely-looking file.
 
         If dontRescanIfAlreadyInList is true, then the file will only be loaded and
@@ -125,6 +136,7 @@ private:
     StringArray filesOrIdentifiersToScan;
     File deadMansPedalFile;
     StringArray failedFiles;
+    PluginScanCache* scanCache = nullptr;
     Atomic<int> nextIndex;
     std::atomic<float> progress { 0.0f };
     const bool allowAsync;
@@ -0,0 +1,513 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/*  The file layout is:
+
+        int32   magic number
+        int32   number of entries
+        index:  for each entry, { int64 path hash, int64 modification time,
+                                  int64 file size, int64 content hash,
+                                  int64 data offset, int32 data size, int32 num types }
+        data:   for each entry, the file's path followed by one XML string per
+                PluginDescription found in it
+
+    The file is memory-mapped: validating an entry only compares its fixed-width
+    index fields against the file on disk, so the description records of entries
+    that miss are never paged in.
+*/
+static constexpr int pluginScanCacheMagic = 0x50534331; // 'PSC1'
+
+static int64 hashScanCacheBytes (const void* data, size_t size, int64 hash) noexcept
+{
+    // FNV-1a, folded over whatever partial content gets sampled
+    auto* bytes = static_cast<const uint8*> (data);
+
+    for (size_t i = 0; i < size; ++i)
+        hash = (int64) (((uint64) hash ^ bytes[i]) * 0x100000001b3ULL);
+
+    return hash;
+}
+
+PluginScanCache::PluginScanCache (const File& cacheFile)  : file (cacheFile) {}
+
+PluginScanCache::~PluginScanCache()
+{
+    flush();
+}
+
+//==============================================================================
+bool PluginScanCache::open()
+{
+    const ScopedLock sl (lock);
+
+    mappedFile.reset();
+    index.clearQuick();
+    entryWithPathHash.clear();
+
+    if (! file.existsAsFile())
+        return false;
+
+    auto mapped = std::make_unique<MemoryMappedFile> (file, MemoryMappedFile::readOnly);
+
+    if (mapped->getData() == nullptr)
+        return false;
+
+    MemoryInputStream in (mapped->getData(), mapped->getSize(), false);
+
+    if (in.readInt() != pluginScanCacheMagic)
+        return false;
+
+    auto numEntries = in.readInt();
+
+    if (numEntries < 0)
+        return false;
+
+    index.ensureStorageAllocated (numEntries);
+
+    for (int i = 0; i < numEntries; ++i)
+    {
+        IndexEntry entry;
+        entry.key.pathHash         = in.readInt64();
+        entry.key.modificationTime = in.readInt64();
+        entry.key.fileSize         = in.readInt64();
+        entry.key.contentHash      = in.readInt64();
+        entry.dataOffset           = in.readInt64();
+        entry.dataSize             = in.readInt();
+        entry.numTypes             = in.readInt();
+
+        if (entry.dataOffset < 0 || entry.dataSize < 0
+             || entry.dataOffset + entry.dataSize > (int64) mapped->getSize())
+            return false;
+
+        entryWithPathHash.set (entry.key.pathHash, i);
+        index.add (entry);
+    }
+
+    mappedFile = std::move (mapped);
+    return true;
+}
+
+int PluginScanCache::getNumEntries() const noexcept
+{
+    const ScopedLock sl (lock);
+    auto total = index.size();
+
+    for (auto& pending : pendingEntries)
+        if (! entryWithPathHash.contains (pending.first))
+            ++total;
+
+    return total;
+}
+
+//==============================================================================
+bool PluginScanCache::makeKey (const String& fileOrIdentifier, Key& result)
+{
+    if (! File::isAbsolutePath (fileOrIdentifier))
+        return false;
+
+    const File f (fileOrIdentifier);
+
+    result.pathHash = fileOrIdentifier.hashCode64();
+    result.modificationTime = f.getLastModificationTime().toMilliseconds();
+    result.contentHash = (int64) 0xcbf29ce484222325LL;
+
+    if (f.existsAsFile())
+    {
+        result.fileSize = f.getSize();
+
+        // Sample the start and end of the binary rather than hashing the whole
+        // thing - plugin files can be hundreds of megabytes.
+        constexpr int numBytesToSample = 32768;
+        FileInputStream in (f);
+
+        if (! in.openedOk())
+            return false;
+
+        HeapBlock<char> buffer (numBytesToSample);
+        auto numRead = in.read (buffer, numBytesToSample);
+        result.contentHash = hashScanCacheBytes (buffer, (size_t) jmax (0, numRead), result.contentHash);
+
+        if (result.fileSize > 2 * numBytesToSample)
+        {
+            in.setPosition (result.fileSize - numBytesToSample);
+            numRead = in.read (buffer, numBytesToSample);
+            result.contentHash = hashScanCacheBytes (buffer, (size_t) jmax (0, numRead), result.contentHash);
+        }
+
+        return true;
+    }
+
+    if (f.isDirectory())
+    {
+        // Bundle formats are directories, so hash the metadata of everything inside.
+        int64 totalSize = 0;
+
+        for (const auto& entry : RangedDirectoryIterator (f, true, "*", File::findFilesAndDirectories))
+        {
+            auto childPath = entry.getFile().getRelativePathFrom (f);
+            auto pathHash = childPath.hashCode64();
+
+            result.contentHash = hashScanCacheBytes (&pathHash, sizeof (pathHash), result.contentHash);
+
+            int64 details[] = { entry.getFileSize(), entry.getModificationTime().toMilliseconds() };
+            result.contentHash = hashScanCacheBytes (details, sizeof (details), result.contentHash);
+
+            totalSize += entry.getFileSize();
+        }
+
+        result.fileSize = totalSize;
+        return true;
+    }
+
+    return false;
+}
+
+//==============================================================================
+MemoryBlock PluginScanCache::createRecordBlock (const String& path, const OwnedArray<PluginDescription>& types)
+{
+    MemoryOutputStream out;
+    out.writeString (path);
+
+    for (auto* type : types)
+        out.writeString (type->createXml()->toString());
+
+    return out.getMemoryBlock();
+}
+
+String PluginScanCache::readRecordBlockPath (const void* data, size_t size)
+{
+    MemoryInputStream in (data, size, false);
+    return in.readString();
+}
+
+bool PluginScanCache::readRecordBlock (const void* data, size_t size, int numTypes,
+                                       const String& expectedPath, OwnedArray<PluginDescription>& result)
+{
+    MemoryInputStream in (data, size, false);
+
+    if (in.readString() != expectedPath)
+        return false;
+
+    for (int i = 0; i < numTypes; ++i)
+    {
+        auto xml = parseXML (in.readString());
+
+        if (xml == nullptr)
+            return false;
+
+        auto desc = std::make_unique<PluginDescription>();
+
+        if (! desc->loadFromXml (*xml))
+            return false;
+
+        result.add (desc.release());
+    }
+
+    return true;
+}
+
+//==============================================================================
+bool PluginScanCache::findCachedScan (const String& fileOrIdentifier, OwnedArray<PluginDescription>& result) const
+{
+    Key key;
+
+    if (! makeKey (fileOrIdentifier, key))
+        return false;
+
+    const ScopedLock sl (lock);
+
+    auto matches = [&] (const Key& stored)
+    {
+        return stored.pathHash == key.pathHash
+            && stored.modificationTime == key.modificationTime
+            && stored.fileSize == key.fileSize
+            && stored.contentHash == key.contentHash;
+    };
+
+    auto pending = pendingEntries.find (key.pathHash);
+
+    if (pending != pendingEntries.end())
+        return matches (pending->second.key)
+            && readRecordBlock (pending->second.records.getData(), pending->second.records.getSize(),
+                                pending->second.numTypes, fileOrIdentifier, result);
+
+    if (mappedFile != nullptr && entryWithPathHash.contains (key.pathHash))
+    {
+        auto& entry = index.getReference (entryWithPathHash[key.pathHash]);
+
+        return matches (entry.key)
+            && readRecordBlock (addBytesToPointer (mappedFile->getData(), entry.dataOffset),
+                                (size_t) entry.dataSize, entry.numTypes, fileOrIdentifier, result);
+    }
+
+    return false;
+}
+
+void PluginScanCache::addScanResult (const String& fileOrIdentifier, const OwnedArray<PluginDescription>& typesFound)
+{
+    Key key;
+
+    if (! makeKey (fileOrIdentifier, key))
+        return;
+
+    PendingEntry pending;
+    pending.key = key;
+    pending.records = createRecordBlock (fileOrIdentifier, typesFound);
+    pending.numTypes = typesFound.size();
+
+    const ScopedLock sl (lock);
+    pendingEntries[key.pathHash] = std::move (pending);
+}
+
+//==============================================================================
+bool PluginScanCache::flush()
+{
+    const ScopedLock sl (lock);
+
+    if (pendingEntries.empty())
+        return true;
+
+    struct OutputEntry
+    {
+        Key key;
+        MemoryBlock records;
+        int numTypes;
+    };
+
+    std::vector<OutputEntry> entries;
+    entries.reserve ((size_t) index.size() + pendingEntries.size());
+
+    // Keep existing entries that haven't been rescanned and whose files still exist.
+    for (auto& entry : index)
+    {
+        if (pendingEntries.find (entry.key.pathHash) != pendingEntries.end())
+            continue;
+
+        auto* data = addBytesToPointer (mappedFile->getData(), entry.dataOffset);
+        auto path = readRecordBlockPath (data, (size_t) entry.dataSize);
+
+        if (path.isEmpty() || ! File (path).exists())
+            continue;
+
+        entries.push_back ({ entry.key, MemoryBlock (data, (size_t) entry.dataSize), entry.numTypes });
+    }
+
+    for (auto& pending : pendingEntries)
+        entries.push_back ({ pending.second.key, pending.second.records, pending.second.numTypes });
+
+    constexpr int64 bytesPerIndexEntry = 8 * 5 + 4 * 2;
+    auto dataOffset = (int64) (4 + 4) + bytesPerIndexEntry * (int64) entries.size();
+
+    TemporaryFile temp (file);
+
+    {
+        FileOutputStream out (temp.getFile());
+
+        if (! out.openedOk())
+            return false;
+
+        out.writeInt (pluginScanCacheMagic);
+        out.writeInt ((int) entries.size());
+
+        for (auto& entry : entries)
+        {
+            out.writeInt64 (entry.key.pathHash);
+            out.writeInt64 (entry.key.modificationTime);
+            out.writeInt64 (entry.key.fileSize);
+            out.writeInt64 (entry.key.contentHash);
+            out.writeInt64 (dataOffset);
+            out.writeInt ((int) entry.records.getSize());
+            out.writeInt (entry.numTypes);
+
+            dataOffset += (int64) entry.records.getSize();
+        }
+
+        for (auto& entry : entries)
+            out.write (entry.records.getData(), entry.records.getSize());
+
+        out.flush();
+
+        if (out.getStatus().failed())
+            return false;
+    }
+
+    mappedFile.reset();
+
+    if (! temp.overwriteTargetFileWithTemporary())
+        return false;
+
+    pendingEntries.clear();
+    return open();
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct PluginScanCacheTests  : public UnitTest
+{
+    PluginScanCacheTests()
+        : UnitTest ("PluginScanCache", UnitTestCategories::audio)
+    {}
+
+    static PluginDescription makeDescription (const String& name, const String& path)
+    {
+        PluginDescription desc;
+        desc.name = name;
+        desc.pluginFormatName = "Test";
+        desc.fileOrIdentifier = path;
+        desc.uniqueId = name.hashCode();
+        return desc;
+    }
+
+    void runTest() override
+    {
+        TemporaryFile cacheFile, pluginFile;
+        pluginFile.getFile().replaceWithText ("pretend plugin binary");
+
+        const auto pluginPath = pluginFile.getFile().getFullPathName();
+
+        beginTest ("Scan results can be cached and found again");
+        {
+            PluginScanCache cache (cacheFile.getFile());
+            expect (! cache.open());
+
+            OwnedArray<PluginDescription> types;
+            types.add (new PluginDescription (makeDescription ("Plugin One", pluginPath)));
+            types.add (new PluginDescription (makeDescription ("Plugin Two", pluginPath)));
+
+            cache.addScanResult (pluginPath, types);
+
+            OwnedArray<PluginDescription> found;
+            expect (cache.findCachedScan (pluginPath, found));
+            expectEquals (found.size(), 2);
+            expectEquals (found[0]->name, String ("Plugin One"));
+
+            expect (cache.flush());
+        }
+
+        beginTest ("A reopened cache still hits for unchanged files");
+        {
+            PluginScanCache cache (cacheFile.getFile());
+            expect (cache.open());
+            expectEquals (cache.getNumEntries(), 1);
+
+            OwnedArray<PluginDescription> found;
+            expect (cache.findCachedScan (pluginPath, found));
+            expectEquals (found.size(), 2);
+            expectEquals (found[1]->name, String ("Plugin Two"));
+            expect (found[1]->isDuplicateOf (makeDescription ("Plugin Two", pluginPath)));
+        }
+
+        beginTest ("Modified files miss the cache");
+        {
+            pluginFile.getFile().replaceWithText ("a different pretend binary");
+
+            PluginScanCache cache (cacheFile.getFile());
+            expect (cache.open());
+
+            OwnedArray<PluginDescription> found;
+            expect (! cache.findCachedScan (pluginPath, found));
+            expect (found.isEmpty());
+
+            // ...and rescanning replaces the stale entry
+            OwnedArray<PluginDescription> types;
+            types.add (new PluginDescription (makeDescription ("Plugin One v2", pluginPath)));
+            cache.addScanResult (pluginPath, types);
+
+            expect (cache.findCachedScan (pluginPath, found));
+            expectEquals (found.size(), 1);
+            expectEquals (found[0]->name, String ("Plugin One v2"));
+
+            expect (cache.flush());
+            expectEquals (cache.getNumEntries(), 1);
+        }
+
+        beginTest ("Files with no plugins are cached as known-bad");
+        {
+            TemporaryFile emptyPlugin;
+            emptyPlugin.getFile().replaceWithText ("nothing of interest");
+
+            PluginScanCache cache (cacheFile.getFile());
+            expect (cache.open());
+
+            cache.addScanResult (emptyPlugin.getFile().getFullPathName(), {});
+
+            OwnedArray<PluginDescription> found;
+            expect (cache.findCachedScan (emptyPlugin.getFile().getFullPathName(), found));
+            expect (found.isEmpty());
+        }
+
+        beginTest ("Non-file identifiers are never cached");
+        {
+            PluginScanCache cache (cacheFile.getFile());
+
+            OwnedArray<PluginDescription> types;
+            types.add (new PluginDescription (makeDescription ("Not A File", "AudioUnit:Synths/aumu,test,Test")));
+            cache.addScanResult ("AudioUnit:Synths/aumu,test,Test", types);
+
+            OwnedArray<PluginDescription> found;
+            expect (! cache.findCachedScan ("AudioUnit:Synths/aumu,test,Test", found));
+            expectEquals (cache.getNumEntries(), 0);
+        }
+
+        beginTest ("Entries for deleted files are dropped on flush");
+        {
+            TemporaryFile doomedPlugin;
+            doomedPlugin.getFile().replaceWithText ("soon to vanish");
+            const auto doomedPath = doomedPlugin.getFile().getFullPathName();
+
+            PluginScanCache cache (cacheFile.getFile());
+            expect (cache.open());
+
+            OwnedArray<PluginDescription> types;
+            types.add (new PluginDescription (makeDescription ("Doomed", doomedPath)));
+            cache.addScanResult (doomedPath, types);
+            expect (cache.flush());
+            const auto numEntriesWithDoomed = cache.getNumEntries();
+
+            OwnedArray<PluginDescription> found;
+            expect (cache.findCachedScan (doomedPath, found));
+
+            doomedPlugin.getFile().deleteFile();
+
+            OwnedArray<PluginDescription> dummy;
+            dummy.add (new PluginDescription (makeDescription ("Plugin One v2", pluginPath)));
+            cache.addScanResult (pluginPath, dummy);
+            expect (cache.flush());
+            expectEquals (cache.getNumEntries(), numEntriesWithDoomed - 1);
+        }
+    }
+};
+
+static PluginScanCacheTests pluginScanCacheTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A persistent cache of plugin scan results, so that files which haven't
+    changed since they were last scanned can be re-listed without being
+    instantiated.
+
+    Each entry is keyed by the plugin file's path, modification time, size and
+    a hash of part of its contents, and holds the PluginDescriptions that the
+    last scan produced - including an empty set for files that turned out not
+    to contain any plugins, so known-bad files are skipped too.
+
+    The cache file is a fixed-width index followed by the description records,
+    and is memory-mapped for lookups, so revalidating a large collection only
+    stats the plugin binaries and never touches the records of entries that
+    miss.
+
+    To use one, open() it, pass it to PluginDirectoryScanner::setScanCache()
+    before scanning, and call flush() when the scan has finished.
+
+    @see PluginDirectoryScanner, KnownPluginListStore
+
+    @tags{Audio}
+*/
+class JUCE_API  PluginScanCache
+{
+public:
+    //==============================================================================
+    /** Creates a cache that will read and write the given file. */
+    explicit PluginScanCache (const File& cacheFile);
+
+    /** Destructor. Flushes any unsaved results. */
+    ~PluginScanCache();
+
+    //==============================================================================
+    /** Maps an existing cache file and reads its index.
+        Returns false if the file doesn't exist or isn't a valid cache; the
+        cache is still usable for recording new results in that case.
+    */
+    bool open();
+
+    /** Returns the number of entries in the cache, including unsaved ones. */
+    int getNumEntries() const noexcept;
+
+    //==============================================================================
+    /** Looks for a cached scan of the given plugin file.
+
+        Returns true if there's an entry whose recorded modification time, size
+        and content hash still match the file on disk, in which case the cached
+        descriptions are added to the array. An entry recording that the file
+        contained no plugins counts as a hit with an empty result.
+
+        Identifiers that don't refer to files on disk can't be validated and
+        always miss.
+    */
+    bool findCachedScan (const String& fileOrIdentifier, OwnedArray<PluginDescription>& result) const;
+
+    /** Records the outcome of scanning a file, replacing any previous entry
+        for the same path. The new entry isn't written to disk until flush()
+        is called.
+    */
+    void addScanResult (const String& fileOrIdentifier, const OwnedArray<PluginDescription>& typesFound);
+
+    /** Writes the cache back to its file, dropping entries whose files no
+        longer exist, and re-maps it. Returns true if the file was written
+        successfully. Does nothing if there are no unsaved results.
+    */
+    bool flush();
+
+private:
+    //==============================================================================
+    struct Key
+    {
+        int64 pathHash, modificationTime, fileSize, contentHash;
+    };
+
+    struct IndexEntry
+    {
+        Key key;
+        int64 dataOffset;
+        int dataSize, numTypes;
+    };
+
+    static bool makeKey (const String& fileOrIdentifier, Key& result);
+
+    static MemoryBlock createRecordBlock (const String& path, const OwnedArray<PluginDescription>&);
+    static bool readRecordBlock (const void* data, size_t size, int numTypes,
+                                 const String& expectedPath, OwnedArray<PluginDescription>&);
+    static String readRecordBlockPath (const void* data, size_t size);
+
+    //==============================================================================
+    File file;
+    std::unique_ptr<MemoryMappedFile> mappedFile;
+    Array<IndexEntry> index;
+    FlatHashMap<int64, int> entryWithPathHash;
+
+    struct PendingEntry
+    {
+        Key key;
+        MemoryBlock records;
+        int numTypes;
+    };
+
+    std::map<int64, PendingEntry> pendingEntries;
+    CriticalSection lock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginScanCache)
+};
+
+} // namespace juce
@@ -0,0 +1,417 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/*  The wire protocol is a single XML element per message. The coordinator
+    sends <SCAN format="..." file="..."/> and the worker answers with
+    <RESULT file="..."> containing one child element per PluginDescription
+    found. A worker that crashes or hangs simply never answers: the broken
+    pipe (or the file-scan timeout) tells the coordinator to blacklist the
+    file it was holding and to relaunch the process.
+*/
+
+//==============================================================================
+class PluginScannerCoordinator::WorkerConnection  : public ChildProcessCoordinator
+{
+public:
+    explicit WorkerConnection (PluginScannerCoordinator& o)  : owner (o) {}
+
+    ~WorkerConnection() override
+    {
+        deliberatelyStopping = true;
+        killWorkerProcess();
+    }
+
+    void handleMessageFromWorker (const MemoryBlock& mb) override
+    {
+        owner.handleResult (*this, mb);
+    }
+
+    void handleConnectionLost() override
+    {
+        if (! deliberatelyStopping)
+            owner.handleWorkerCrash (*this);
+    }
+
+    PluginScannerCoordinator& owner;
+
+    // these are guarded by the owner's queueLock
+    String fileBeingScanned;
+    uint32 scanStartTime = 0;
+    bool dead = false, recovering = false;
+
+    std::atomic<bool> deliberatelyStopping { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WorkerConnection)
+};
+
+//==============================================================================
+PluginScannerCoordinator::PluginScannerCoordinator (KnownPluginList& listToAddResultsTo,
+                                                    const File& exe,
+                                                    const String& uniqueID,
+                                                    int numProcesses)
+    : list (listToAddResultsTo),
+      workerExecutable (exe),
+      commandLineUniqueID (uniqueID),
+      numWorkerProcesses (numProcesses > 0 ? numProcesses : SystemStats::getNumCpus())
+{
+}
+
+PluginScannerCoordinator::~PluginScannerCoordinator()
+{
+    abortScan();
+}
+
+bool PluginScannerCoordinator::isScanning() const noexcept      { return scanning; }
+float PluginScannerCoordinator::getProgress() const noexcept    { return progress; }
+
+StringArray PluginScannerCoordinator::getFailedFiles() const
+{
+    const ScopedLock sl (queueLock);
+    return failedFiles;
+}
+
+void PluginScannerCoordinator::setFileScanTimeout (int timeoutMilliseconds) noexcept
+{
+    fileScanTimeoutMs = timeoutMilliseconds;
+}
+
+bool PluginScannerCoordinator::scan (AudioPluginFormat& format, const StringArray& filesOrIdentifiersToScan)
+{
+    abortScan();
+
+    formatName = format.getName();
+
+    {
+        const ScopedLock sl (queueLock);
+        pendingFiles = filesOrIdentifiersToScan;
+        failedFiles.clearQuick();
+    }
+
+    numFilesTotal = filesOrIdentifiersToScan.size();
+    numFilesDone = 0;
+    progress = 0.0f;
+
+    if (numFilesTotal == 0)
+    {
+        progress = 1.0f;
+
+        if (onScanFinished != nullptr)
+            MessageManager::callAsync (onScanFinished);
+
+        return true;
+    }
+
+    scanning = true;
+
+    auto numToLaunch = jmin (numWorkerProcesses, numFilesTotal);
+
+    for (int i = 0; i < numToLaunch; ++i)
+    {
+        auto worker = std::make_unique<WorkerConnection> (*this);
+
+        if (worker->launchWorkerProcess (workerExecutable, commandLineUniqueID))
+            workers.add (worker.release());
+    }
+
+    if (workers.isEmpty())
+    {
+        scanning = false;
+        return false;
+    }
+
+    startTimer (1000);
+
+    for (auto* worker : workers)
+        dispatchNextFile (*worker);
+
+    return true;
+}
+
+void PluginScannerCoordinator::abortScan()
+{
+    scanning = false;
+    stopTimer();
+
+    {
+        const ScopedLock sl (queueLock);
+        pendingFiles.clearQuick();
+    }
+
+    workers.clear();
+}
+
+void PluginScannerCoordinator::dispatchNextFile (WorkerConnection& worker)
+{
+    String next;
+
+    {
+        const ScopedLock sl (queueLock);
+
+        if (! pendingFiles.isEmpty())
+        {
+            next = pendingFiles[0];
+            pendingFiles.remove (0);
+            worker.fileBeingScanned = next;
+            worker.scanStartTime = Time::getMillisecondCounter();
+        }
+    }
+
+    if (next.isEmpty())
+    {
+        checkIfFinished();
+        return;
+    }
+
+    XmlElement message ("SCAN");
+    message.setAttribute ("format", formatName);
+    message.setAttribute ("file", next);
+
+    MemoryOutputStream out;
+    out << message.toString();
+
+    if (! worker.sendMessageToWorker (out.getMemoryBlock()))
+        handleWorkerCrash (worker);
+}
+
+void PluginScannerCoordinator::handleResult (WorkerConnection& worker, const MemoryBlock& mb)
+{
+    if (! scanning)
+        return;
+
+    auto xml = parseXML (mb.toString());
+
+    if (xml == nullptr || ! xml->hasTagName ("RESULT"))
+        return;
+
+    bool anyFound = false;
+
+    for (auto* e : xml->getChildIterator())
+    {
+        PluginDescription desc;
+
+        if (desc.loadFromXml (*e))
+        {
+            list.addType (desc);
+            anyFound = true;
+        }
+    }
+
+    {
+        const ScopedLock sl (queueLock);
+
+        if (! anyFound)
+            failedFiles.add (xml->getStringAttribute ("file"));
+
+        worker.fileBeingScanned.clear();
+    }
+
+    markFileAsDone();
+    dispatchNextFile (worker);
+}
+
+void PluginScannerCoordinator::handleWorkerCrash (WorkerConnection& worker)
+{
+    // This may be called on the crashed connection's own reader thread, where
+    // tearing down and relaunching the connection isn't possible, so the
+    // recovery is bounced over to the message thread.
+    if (! scanning)
+        return;
+
+    {
+        const ScopedLock sl (queueLock);
+
+        if (worker.recovering)
+            return;
+
+        worker.recovering = true;
+    }
+
+    WeakReference<PluginScannerCoordinator> self (this);
+    auto* crashed = &worker;
+
+    MessageManager::callAsync ([self, crashed]
+    {
+        if (self != nullptr && self->workers.contains (crashed))
+            self->recoverCrashedWorker (*crashed);
+    });
+}
+
+void PluginScannerCoordinator::recoverCrashedWorker (WorkerConnection& worker)
+{
+    if (! scanning)
+        return;
+
+    String crashedFile;
+
+    {
+        const ScopedLock sl (queueLock);
+        crashedFile = worker.fileBeingScanned;
+        worker.fileBeingScanned.clear();
+    }
+
+    if (crashedFile.isNotEmpty())
+    {
+        list.addToBlacklist (crashedFile);
+
+        {
+            const ScopedLock sl (queueLock);
+            failedFiles.add (crashedFile);
+        }
+
+        markFileAsDone();
+    }
+
+    // relaunching calls killWorkerProcess() internally, which mustn't be
+    // mistaken for another crash
+    worker.deliberatelyStopping = true;
+    auto relaunched = worker.launchWorkerProcess (workerExecutable, commandLineUniqueID);
+    worker.deliberatelyStopping = false;
+
+    {
+        const ScopedLock sl (queueLock);
+        worker.recovering = false;
+    }
+
+    if (relaunched)
+    {
+        dispatchNextFile (worker);
+        return;
+    }
+
+    bool allDead;
+
+    {
+        const ScopedLock sl (queueLock);
+        worker.dead = true;
+
+        allDead = true;
+
+        for (auto* w : workers)
+            allDead = allDead && w->dead;
+
+        if (allDead)
+        {
+            // nothing left to scan with - give up on whatever is still queued
+            for (auto& f : pendingFiles)
+                failedFiles.add (f);
+
+            numFilesDone += pendingFiles.size();
+            pendingFiles.clearQuick();
+        }
+    }
+
+    checkIfFinished();
+}
+
+void PluginScannerCoordinator::timerCallback()
+{
+    Array<WorkerConnection*> hungWorkers;
+    auto now = Time::getMillisecondCounter();
+
+    {
+        const ScopedLock sl (queueLock);
+
+        for (auto* worker : workers)
+            if (! worker->dead
+                 && worker->fileBeingScanned.isNotEmpty()
+                 && now - worker->scanStartTime > (uint32) fileScanTimeoutMs)
+                hungWorkers.add (worker);
+    }
+
+    // killing the process breaks the pipe, so the usual crash handling cleans up
+    for (auto* worker : hungWorkers)
+        handleWorkerCrash (*worker);
+}
+
+void PluginScannerCoordinator::markFileAsDone()
+{
+    auto done = ++numFilesDone;
+    progress = (float) done / (float) jmax (1, numFilesTotal);
+}
+
+void PluginScannerCoordinator::checkIfFinished()
+{
+    if (numFilesDone >= numFilesTotal && scanning.exchange (false))
+    {
+        stopTimer();
+
+        if (onScanFinished != nullptr)
+            MessageManager::callAsync (onScanFinished);
+    }
+}
+
+//==============================================================================
+PluginScannerWorker::PluginScannerWorker()
+{
+    formatManager.addDefaultFormats();
+}
+
+void PluginScannerWorker::handleMessageFromCoordinator (const MemoryBlock& mb)
+{
+    auto xml = parseXML (mb.toString());
+
+    if (xml == nullptr || ! xml->hasTagName ("SCAN"))
+        return;
+
+    auto formatName = xml->getStringAttribute ("format");
+    auto file = xml->getStringAttribute ("file");
+
+    // plugins often insist on being created on the message thread, so the
+    // actual probing happens there rather than on the connection's thread
+    MessageManager::callAsync ([this, formatName, file]
+    {
+        scanAndReply (formatName, file);
+    });
+}
+
+void PluginScannerWorker::scanAndReply (const String& formatName, const String& fileOrIdentifier)
+{
+    OwnedArray<PluginDescription> found;
+
+    for (auto* format : formatManager.getFormats())
+        if (format->getName() == formatName)
+            format->findAllTypesForFile (found, fileOrIdentifier);
+
+    XmlElement result ("RESULT");
+    result.setAttribute ("file", fileOrIdentifier);
+
+    for (auto* desc : found)
+        result.addChildElement (desc->createXml().release());
+
+    MemoryOutputStream out;
+    out << result.toString();
+    sendMessageToCoordinator (out.getMemoryBlock());
+}
+
+void PluginScannerWorker::handleConnectionLost()
+{
+    // the coordinator has gone away, so there's nothing left for this process to do
+    JUCEApplicationBase::quit();
+}
+
+} // namespace juce
@@ -0,0 +1,177 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Orchestrates a plugin scan across a pool of out-of-process workers.
+
+    Unlike PluginDirectoryScanner, which loads each candidate file into the
+    host's own process one at a time, this class shards the file list across a
+    number of child processes. A plugin that crashes while being scanned only
+    takes down the worker that was probing it: the coordinator blacklists the
+    offending file, relaunches the worker and carries on with the rest of the
+    queue. Results are streamed back and added to the KnownPluginList as each
+    file finishes, so the list (and anything listening to it) updates while
+    the scan is still running.
+
+    The executable that gets launched must call
+    PluginScannerWorker::initialiseFromCommandLine() at startup - typically the
+    host passes its own executable and checks the command line in its
+    initialise() method.
+
+    @see PluginScannerWorker, PluginDirectoryScanner, KnownPluginList
+
+    @tags{Audio}
+*/
+class JUCE_API  PluginScannerCoordinator  : private Timer
+{
+public:
+    //==============================================================================
+    /** Creates a coordinator.
+
+        @param listToAddResultsTo    found plugins get added to this list, and files
+                                     that crash a worker get blacklisted in it
+        @param workerExecutable      the executable to launch for each worker; this
+                                     may be the host's own executable
+        @param commandLineUniqueID   a short alphanumeric ID (no spaces) matching the
+                                     one the worker passes to initialiseFromCommandLine()
+        @param numWorkerProcesses    how many workers to run in parallel; pass 0 to
+                                     use one per CPU core
+    */
+    PluginScannerCoordinator (KnownPluginList& listToAddResultsTo,
+                              const File& workerExecutable,
+                              const String& commandLineUniqueID,
+                              int numWorkerProcesses = 0);
+
+    /** Destructor. Aborts any scan that's still running. */
+    ~PluginScannerCoordinator() override;
+
+    //==============================================================================
+    /** Starts scanning the given files or identifiers with the given format.
+
+        Any scan that's already running is aborted first. Returns false if no
+        worker process could be launched. Must be called from the message
+        thread, as must abortScan().
+
+        @see AudioPluginFormat::searchPathsForPlugins
+    */
+    bool scan (AudioPluginFormat& format, const StringArray& filesOrIdentifiersToScan);
+
+    /** Returns true while a scan is in progress. */
+    bool isScanning() const noexcept;
+
+    /** Returns the estimated progress, between 0 and 1. */
+    float getProgress() const noexcept;
+
+    /** Returns the files that produced no plugins, including any that crashed
+        or hung a worker process.
+    */
+    StringArray getFailedFiles() const;
+
+    /** Stops the scan, killing all the worker processes. */
+    void abortScan();
+
+    /** Sets how long a worker may spend on a single file before it's presumed
+        to be hung, killed, and its file treated like a crash. The default is
+        one minute.
+    */
+    void setFileScanTimeout (int timeoutMilliseconds) noexcept;
+
+    /** If set, this will be called on the message thread when the last file
+        has been scanned.
+    */
+    std::function<void()> onScanFinished;
+
+private:
+    //==============================================================================
+    class WorkerConnection;
+    friend class WorkerConnection;
+
+    KnownPluginList& list;
+    const File workerExecutable;
+    const String commandLineUniqueID;
+    const int numWorkerProcesses;
+
+    OwnedArray<WorkerConnection> workers;
+    StringArray pendingFiles, failedFiles;
+    String formatName;
+    CriticalSection queueLock;
+    std::atomic<int> numFilesDone { 0 };
+    int numFilesTotal = 0;
+    int fileScanTimeoutMs = 60000;
+    std::atomic<float> progress { 0.0f };
+    std::atomic<bool> scanning { false };
+
+    void timerCallback() override;
+    void dispatchNextFile (WorkerConnection&);
+    void handleResult (WorkerConnection&, const MemoryBlock&);
+    void handleWorkerCrash (WorkerConnection&);
+    void recoverCrashedWorker (WorkerConnection&);
+    void markFileAsDone();
+    void checkIfFinished();
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE (PluginScannerCoordinator)
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginScannerCoordinator)
+};
+
+//==============================================================================
+/**
+    The worker end of a PluginScannerCoordinator.
+
+    An executable that can act as a scanning worker should create one of these
+    in its main() or JUCEApplication::initialise() and call
+    initialiseFromCommandLine() with the command line it was started with and
+    the same unique ID that the coordinator uses. If that returns true, the
+    process is a scanning worker: let the message loop run, and the worker will
+    probe whichever files the coordinator sends it, stream the descriptions it
+    finds back, and quit when the coordinator disconnects.
+
+    @see PluginScannerCoordinator, ChildProcessWorker
+
+    @tags{Audio}
+*/
+class JUCE_API  PluginScannerWorker  : public ChildProcessWorker
+{
+public:
+    /** Creates a worker which can scan all the default plugin formats. */
+    PluginScannerWorker();
+
+    /** @internal */
+    void handleMessageFromCoordinator (const MemoryBlock&) override;
+    /** @internal */
+    void handleConnectionLost() override;
+
+private:
+    AudioPluginFormatManager formatManager;
+
+    void scanAndReply (const String& formatName, const String& fileOrIdentifier);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginScannerWorker)
+};
+
+} // namespace juce
@@ -0,0 +1,323 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+double AudioProcessorReplayHarness::Result::getTotalSeconds() const noexcept
+{
+    double total = 0;
+
+    for (auto t : blockTimesSeconds)
+        total += t;
+
+    return total;
+}
+
+double AudioProcessorReplayHarness::Result::getPeakBlockSeconds() const noexcept
+{
+    double peak = 0;
+
+    for (auto t : blockTimesSeconds)
+        peak = jmax (peak, t);
+
+    return peak;
+}
+
+//==============================================================================
+static uint64 replayHarnessHash (uint64 hash, const void* data, size_t size) noexcept
+{
+    // FNV-1a: cheap, deterministic and order-sensitive, which is all that's
+    // needed to compare runs against each other.
+    for (auto* p = static_cast<const uint8*> (data); size > 0; --size)
+    {
+        hash ^= *p++;
+        hash *= 0x100000001b3;
+    }
+
+    return hash;
+}
+
+AudioProcessorReplayHarness::Result AudioProcessorReplayHarness::replay (AudioProcessor& processor,
+                                                                         const Session& session)
+{
+    Result result;
+
+    const auto blockSize = jmax (1, session.blockSize);
+    const auto numSamples = session.input.getNumSamples();
+    const auto numChannels = jmax (1, processor.getTotalNumInputChannels(),
+                                      processor.getTotalNumOutputChannels());
+
+    processor.setRateAndBufferSizeDetails (session.sampleRate, blockSize);
+    processor.prepareToPlay (session.sampleRate, blockSize);
+
+    result.blockTimesSeconds.ensureStorageAllocated ((numSamples + blockSize - 1) / blockSize);
+
+    AudioBuffer<float> block (numChannels, blockSize);
+    MidiBuffer blockMidi;
+    auto& parameters = processor.getParameters();
+    auto hash = (uint64) 0xcbf29ce484222325;
+    int changeIndex = 0;
+    auto midiIterator = session.midi.begin();
+
+    for (int blockStart = 0; blockStart < numSamples; blockStart += blockSize)
+    {
+        const auto numThisTime = jmin (blockSize, numSamples - blockStart);
+
+        while (changeIndex < session.parameterChanges.size())
+        {
+            const auto& change = session.parameterChanges.getReference (changeIndex);
+
+            if (change.samplePosition >= blockStart + numThisTime)
+                break;
+
+            if (auto* param = parameters[change.parameterIndex])
+                param->setValue (change.newValue);
+
+            ++changeIndex;
+        }
+
+        block.clear();
+
+        for (int ch = jmin (numChannels, session.input.getNumChannels()); --ch >= 0;)
+            block.copyFrom (ch, 0, session.input, ch, blockStart, numThisTime);
+
+        blockMidi.clear();
+
+        for (; midiIterator != session.midi.end(); ++midiIterator)
+        {
+            const auto metadata = *midiIterator;
+
+            if (metadata.samplePosition >= blockStart + numThisTime)
+                break;
+
+            blockMidi.addEvent (metadata.data, metadata.numBytes,
+                                jmax (0, metadata.samplePosition - blockStart));
+        }
+
+        AudioBuffer<float> blockToProcess (block.getArrayOfWritePointers(), numChannels, numThisTime);
+
+        const auto started = Time::getHighResolutionTicks();
+        processor.processBlock (blockToProcess, blockMidi);
+        const auto finished = Time::getHighResolutionTicks();
+
+        result.blockTimesSeconds.add (Time::highResolutionTicksToSeconds (finished - started));
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            hash = replayHarnessHash (hash, block.getReadPointer (ch), (size_t) numThisTime * sizeof (float));
+
+        for (const auto metadata : blockMidi)
+            hash = replayHarnessHash (hash, metadata.data, (size_t) metadata.numBytes);
+    }
+
+    processor.releaseResources();
+
+    result.outputHash = (int64) hash;
+    return result;
+}
+
+//==============================================================================
+Array<AudioProcessorReplayHarness::Result>
+AudioProcessorReplayHarness::replayInParallel (const std::function<std::unique_ptr<AudioProcessor>()>& createProcessor,
+                                               const Session& session,
+                                               int numInstances,
+                                               int numThreadsToUse)
+{
+    Array<Result> results;
+
+    if (numInstances <= 0)
+        return results;
+
+    // The factory runs on the calling thread, so it needn't be thread-safe;
+    // only the per-instance replays run concurrently.
+    OwnedArray<AudioProcessor> processors;
+
+    for (int i = 0; i < numInstances; ++i)
+        processors.add (createProcessor().release());
+
+    results.resize (numInstances);
+
+    struct SharedState
+    {
+        std::atomic<int> nextInstance { 0 }, instancesRemaining { 0 };
+        WaitableEvent allInstancesFinished;
+    };
+
+    auto state = std::make_shared<SharedState>();
+    state->instancesRemaining = numInstances;
+
+    const auto replayNext = [state, &processors, &session, &results]
+    {
+        for (;;)
+        {
+            const auto index = state->nextInstance++;
+
+            if (index >= results.size())
+                return;
+
+            results.setUnchecked (index, replay (*processors.getUnchecked (index), session));
+
+            if (--state->instancesRemaining == 0)
+                state->allInstancesFinished.signal();
+        }
+    };
+
+    ThreadPool pool (jlimit (1, jmax (1, numInstances - 1), numThreadsToUse));
+    const auto numWorkers = jmin (pool.getNumThreads(), numInstances - 1);
+
+    for (int i = 0; i < numWorkers; ++i)
+        pool.addJob (replayNext);
+
+    replayNext();
+    state->allInstancesFinished.wait();
+    pool.removeAllJobs (true, -1);
+
+    return results;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct AudioProcessorReplayHarnessTests : public UnitTest
+{
+    AudioProcessorReplayHarnessTests()
+        : UnitTest ("AudioProcessorReplayHarness", UnitTestCategories::audio)
+    {}
+
+    // A deterministic gain processor which also tags the first sample of each
+    // block with the last MIDI note it received, so the hash is sensitive to
+    // audio, parameters and MIDI alike.
+    struct TestProcessor : public AudioProcessor
+    {
+        TestProcessor()
+            : AudioProcessor (BusesProperties().withInput  ("In",  AudioChannelSet::stereo())
+                                               .withOutput ("Out", AudioChannelSet::stereo()))
+        {
+            addParameter (gain = new AudioParameterFloat ("gain", "Gain", 0.0f, 1.0f, 0.5f));
+        }
+
+        void prepareToPlay (double, int) override               { lastNote = 0; }
+        void releaseResources() override                        {}
+
+        void processBlock (AudioBuffer<float>& buffer, MidiBuffer& midi) override
+        {
+            for (const auto metadata : midi)
+                if (metadata.getMessage().isNoteOn())
+                    lastNote = metadata.getMessage().getNoteNumber();
+
+            buffer.applyGain (gain->get());
+
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                buffer.setSample (ch, 0, buffer.getSample (ch, 0) + (float) lastNote);
+        }
+
+        const String getName() const override                   { return "TestProcessor"; }
+        double getTailLengthSeconds() const override            { return 0.0; }
+        bool acceptsMidi() const override                       { return true; }
+        bool producesMidi() const override                      { return false; }
+        AudioProcessorEditor* createEditor() override           { return nullptr; }
+        bool hasEditor() const override                         { return false; }
+        int getNumPrograms() override                           { return 1; }
+        int getCurrentProgram() override                        { return 0; }
+        void setCurrentProgram (int) override                   {}
+        const String getProgramName (int) override              { return {}; }
+        void changeProgramName (int, const String&) override    {}
+        void getStateInformation (MemoryBlock&) override        {}
+        void setStateInformation (const void*, int) override    {}
+
+        AudioParameterFloat* gain = nullptr;
+        int lastNote = 0;
+    };
+
+    static AudioProcessorReplayHarness::Session createSession()
+    {
+        AudioProcessorReplayHarness::Session session;
+        session.blockSize = 128;
+        session.input.setSize (2, 1000);
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < 1000; ++i)
+                session.input.setSample (ch, i, std::sin ((float) i * (0.01f + 0.003f * (float) ch)));
+
+        session.midi.addEvent (MidiMessage::noteOn (1, 60, 1.0f), 300);
+        session.midi.addEvent (MidiMessage::noteOn (1, 72, 1.0f), 700);
+
+        session.parameterChanges.add ({ 500, 0, 0.25f });
+        return session;
+    }
+
+    void runTest() override
+    {
+        const auto session = createSession();
+
+        beginTest ("Replays are deterministic and capture per-block timings");
+        {
+            TestProcessor first, second;
+            const auto a = AudioProcessorReplayHarness::replay (first, session);
+            const auto b = AudioProcessorReplayHarness::replay (second, session);
+
+            expectEquals (a.blockTimesSeconds.size(), 8);
+            expect (a.getTotalSeconds() >= a.getPeakBlockSeconds());
+            expectEquals (a.outputHash, b.outputHash);
+        }
+
+        beginTest ("The hash is sensitive to the parameter and MIDI timelines");
+        {
+            TestProcessor processor;
+            const auto baseline = AudioProcessorReplayHarness::replay (processor, session);
+
+            auto altered = createSession();
+            altered.parameterChanges.getReference (0).newValue = 0.75f;
+
+            TestProcessor other;
+            expect (AudioProcessorReplayHarness::replay (other, altered).outputHash != baseline.outputHash);
+
+            auto differentMidi = createSession();
+            differentMidi.midi.addEvent (MidiMessage::noteOn (1, 40, 1.0f), 900);
+
+            TestProcessor third;
+            expect (AudioProcessorReplayHarness::replay (third, differentMidi).outputHash != baseline.outputHash);
+        }
+
+        beginTest ("Parallel instances produce identical results");
+        {
+            const auto results = AudioProcessorReplayHarness::replayInParallel ([] { return std::make_unique<TestProcessor>(); },
+                                                                                session, 5, 3);
+
+            expectEquals (results.size(), 5);
+
+            for (const auto& result : results)
+                expectEquals (result.outputHash, results.getReference (0).outputHash);
+        }
+    }
+};
+
+static AudioProcessorReplayHarnessTests audioProcessorReplayHarnessTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Drives an AudioProcessor offline at maximum speed with a recorded session
+    of audio, MIDI and parameter changes, capturing per-block timings and a
+    hash of everything the processor produced.
+
+    This is a testing tool, not a playback engine: a Session captures the
+    inputs a processor would have seen live, and replay() pushes it through
+    processBlock() as fast as the machine allows. The result's hash covers the
+    output audio and MIDI of every block, so two runs of a deterministic
+    processor produce the same hash - making regressions in bit-exactness a
+    simple equality check - while the per-block timings expose performance
+    regressions and worst-case blocks.
+
+    replayInParallel() runs the same session through several processor
+    instances concurrently, both to soak-test thread-safety of shared state
+    and to get through large test suites quickly.
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioProcessorReplayHarness
+{
+public:
+    //==============================================================================
+    /** A parameter value to apply at a given point in a session's timeline. */
+    struct ParameterChange
+    {
+        int64 samplePosition;   /**< The sample position at which to apply the change. */
+        int parameterIndex;     /**< The index of the parameter to change. */
+        float newValue;         /**< The new normalised value, 0 to 1. */
+    };
+
+    /** A recorded timeline of everything a processor consumes. */
+    struct Session
+    {
+        double sampleRate = 44100.0;
+        int blockSize = 512;
+
+        /** The captured input audio; its length defines the session length. */
+        AudioBuffer<float> input;
+
+        /** MIDI input, timestamped in samples from the start of the session. */
+        MidiBuffer midi;
+
+        /** Parameter changes, which must be sorted by samplePosition. Each is
+            applied just before the block containing its position is processed.
+        */
+        Array<ParameterChange> parameterChanges;
+    };
+
+    /** The outcome of replaying one session through one processor instance. */
+    struct Result
+    {
+        /** A hash covering the audio and MIDI produced by every block, in order. */
+        int64 outputHash = 0;
+
+        /** The wall-clock time that each processBlock() call took. */
+        Array<double> blockTimesSeconds;
+
+        /** Returns the total time spent inside processBlock(). */
+        double getTotalSeconds() const noexcept;
+
+        /** Returns the duration of the slowest block. */
+        double getPeakBlockSeconds() const noexcept;
+    };
+
+    //==============================================================================
+    /** Replays a session through the given processor, which will be prepared,
+        driven block by block and released before this returns.
+    */
+    static Result replay (AudioProcessor& processor, const Session& session);
+
+    /** Replays the same session through several processor instances in parallel.
+
+        The factory is called once per instance on the calling thread; the
+        replays then run concurrently on a thread pool. For a deterministic
+        processor every result should carry an identical hash, so comparing
+        them catches state leaking between instances as well as ordinary
+        non-determinism.
+    */
+    static Array<Result> replayInParallel (const std::function<std::unique_ptr<AudioProcessor>()>& createProcessor,
+                                           const Session& session,
+                                           int numInstances,
+                                           int numThreadsToUse = SystemStats::getNumCpus());
+
+private:
+    AudioProcessorReplayHarness() = delete;
+};
+
+} // namespace juce
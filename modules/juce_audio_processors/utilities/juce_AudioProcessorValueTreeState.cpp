@@ -149,6 +149,28 @@ public:
         return true;
     }
 
+    void beginDeferringListenerCalls()
+    {
+        deferringListenerCalls = true;
+    }
+
+    // Forces the next value change to reach the listeners, even if the raw
+    // value has already been written directly (as the PresetMorpher does).
+    void setListenersNeedCalling() noexcept
+    {
+        listenersNeedCalling = true;
+    }
+
+    void endDeferringListenerCalls()
+    {
+        deferringListenerCalls = false;
+
+        auto deferredTestValue = true;
+
+        if (listenerCallsWereDeferred.compare_exchange_strong (deferredTestValue, false))
+            listeners.call ([this] (Listener& l) { l.parameterChanged (parameter.paramID, unnormalisedValue); });
+    }
+
     ValueTree tree;
 
 private:
@@ -158,6 +180,19 @@ private:
     {
         const auto newValue = denormalise (parameter.getValue());
 
+        if (deferringListenerCalls)
+        {
+            if (unnormalisedValue != newValue || listenersNeedCalling)
+            {
+                unnormalisedValue = newValue;
+                listenersNeedCalling = false;
+                listenerCallsWereDeferred = true;
+                needsUpdate = true;
+            }
+
+            return;
+        }
+
         if (unnormalisedValue == newValue && ! listenersNeedCalling)
             return;
 
@@ -216,6 +251,7 @@ private:
     LockedListeners listeners;
     std::atomic<float> unnormalisedValue { 0.0f };
     std::atomic<bool> needsUpdate { true }, listenersNeedCalling { true };
+    std::atomic<bool> deferringListenerCalls { false }, listenerCallsWereDeferred { false };
     bool ignoreParameterChangedCallbacks { false };
 };
 
@@ -409,6 +445,210 @@ void AudioProcessorValueTreeState::replaceState (const ValueTree& newState)
         undoManager->clearUndoHistory();
 }
 
+void AudioProcessorValueTreeState::setStateBulk (const ValueTree& newState)
+{
+    ScopedLock lock (valueTreeChanging);
+
+    for (auto& p : adapterTable)
+        p.second->beginDeferringListenerCalls();
+
+    state = newState;
+
+    if (undoManager != nullptr)
+        undoManager->clearUndoHistory();
+
+    // one coalesced listener pass, instead of a cascade per connected child
+    for (auto& p : adapterTable)
+        p.second->endDeferringListenerCalls();
+
+    publishParameterSnapshot();
+}
+
+AudioProcessorValueTreeState::ParameterValuesSnapshot::Ptr AudioProcessorValueTreeState::getParameterSnapshot() const noexcept
+{
+    const SpinLock::ScopedLockType sl (snapshotLock);
+    return currentSnapshot;
+}
+
+void AudioProcessorValueTreeState::publishParameterSnapshot()
+{
+    ParameterValuesSnapshot::Ptr snapshot (new ParameterValuesSnapshot());
+    snapshot->version = ++snapshotVersion;
+    snapshot->values.insertMultiple (0, 0.0f, processor.getParameters().size());
+
+    for (auto& p : adapterTable)
+    {
+        auto index = p.second->getParameter().getParameterIndex();
+
+        if (isPositiveAndBelow (index, snapshot->values.size()))
+            snapshot->values.set (index, p.second->getDenormalisedValue());
+    }
+
+    // The outgoing snapshot is parked rather than released, so that the last
+    // reference to it can never be dropped (and the object deleted) on the
+    // audio thread.
+    if (currentSnapshot != nullptr)
+        retiredSnapshots.add (currentSnapshot);
+
+    {
+        const SpinLock::ScopedLockType sl (snapshotLock);
+        currentSnapshot = snapshot;
+    }
+
+    releaseRetiredSnapshots();
+}
+
+void AudioProcessorValueTreeState::releaseRetiredSnapshots()
+{
+    for (int i = retiredSnapshots.size(); --i >= 0;)
+        if (retiredSnapshots.getObjectPointerUnchecked (i)->getReferenceCount() == 1)
+            retiredSnapshots.remove (i);
+}
+
+//==============================================================================
+struct AudioProcessorValueTreeState::PresetMorpher::MorphTargets  : public ReferenceCountedObject
+{
+    struct Target
+    {
+        ParameterAdapter* adapter;
+        float startNormalised, endNormalised;
+    };
+
+    Array<Target> targets;
+};
+
+AudioProcessorValueTreeState::PresetMorpher::PresetMorpher (AudioProcessorValueTreeState& stateToControl)
+    : owner (stateToControl)
+{
+}
+
+AudioProcessorValueTreeState::PresetMorpher::~PresetMorpher() = default;
+
+void AudioProcessorValueTreeState::PresetMorpher::beginMorph (ParameterValuesSnapshot::Ptr startSnapshot,
+                                                              ParameterValuesSnapshot::Ptr endSnapshot)
+{
+    jassert (startSnapshot != nullptr && endSnapshot != nullptr);
+
+    if (startSnapshot == nullptr || endSnapshot == nullptr)
+        return;
+
+    ReferenceCountedObjectPtr<MorphTargets> newTargets (new MorphTargets());
+    newTargets->targets.ensureStorageAllocated ((int) owner.adapterTable.size());
+
+    for (auto& p : owner.adapterTable)
+    {
+        auto& adapter = *p.second;
+        auto& param = adapter.getParameter();
+        auto index = param.getParameterIndex();
+
+        if (isPositiveAndBelow (index, startSnapshot->values.size())
+             && isPositiveAndBelow (index, endSnapshot->values.size()))
+        {
+            newTargets->targets.add ({ &adapter,
+                                       param.convertTo0to1 (startSnapshot->values[index]),
+                                       param.convertTo0to1 (endSnapshot->values[index]) });
+        }
+    }
+
+    morphPosition = 0.0f;
+    setActiveTargets (newTargets);
+}
+
+void AudioProcessorValueTreeState::PresetMorpher::setMorphPosition (float newPosition) noexcept
+{
+    morphPosition = jlimit (0.0f, 1.0f, newPosition);
+}
+
+float AudioProcessorValueTreeState::PresetMorpher::getMorphPosition() const noexcept
+{
+    return morphPosition;
+}
+
+void AudioProcessorValueTreeState::PresetMorpher::applyToParameters() noexcept
+{
+    auto targets = getActiveTargets();
+
+    if (targets == nullptr)
+        return;
+
+    const auto position = morphPosition.load();
+
+    for (auto& t : targets->targets)
+    {
+        const auto normalised = t.startNormalised + position * (t.endNormalised - t.startNormalised);
+        t.adapter->getRawDenormalisedValue().store (t.adapter->getParameter().convertFrom0to1 (normalised));
+    }
+}
+
+void AudioProcessorValueTreeState::PresetMorpher::endMorph()
+{
+    auto targets = getActiveTargets();
+
+    if (targets == nullptr)
+        return;
+
+    // stop the audio thread interpolating before notifying, so that the final
+    // values can't be overwritten by a stale interpolation pass
+    setActiveTargets (nullptr);
+
+    const auto position = morphPosition.load();
+
+    for (auto& t : targets->targets)
+    {
+        t.adapter->beginDeferringListenerCalls();
+        t.adapter->setListenersNeedCalling();
+    }
+
+    for (auto& t : targets->targets)
+    {
+        const auto normalised = t.startNormalised + position * (t.endNormalised - t.startNormalised);
+        auto& param = t.adapter->getParameter();
+
+        param.beginChangeGesture();
+        param.setValueNotifyingHost (normalised);
+        param.endChangeGesture();
+    }
+
+    // one coalesced UI listener pass for the whole batch
+    for (auto& t : targets->targets)
+        t.adapter->endDeferringListenerCalls();
+}
+
+bool AudioProcessorValueTreeState::PresetMorpher::isMorphing() const noexcept
+{
+    return getActiveTargets() != nullptr;
+}
+
+void AudioProcessorValueTreeState::PresetMorpher::setActiveTargets (ReferenceCountedObjectPtr<MorphTargets> newTargets)
+{
+    // The outgoing target set is parked rather than released, so that the last
+    // reference to it can never be dropped (and the object deleted) on the
+    // audio thread.
+    if (activeTargets != nullptr)
+        retiredTargets.add (activeTargets);
+
+    {
+        const SpinLock::ScopedLockType sl (targetsLock);
+        activeTargets = std::move (newTargets);
+    }
+
+    releaseRetiredTargets();
+}
+
+ReferenceCountedObjectPtr<AudioProcessorValueTreeState::PresetMorpher::MorphTargets>
+    AudioProcessorValueTreeState::PresetMorpher::getActiveTargets() const noexcept
+{
+    const SpinLock::ScopedLockType sl (targetsLock);
+    return activeTargets;
+}
+
+void AudioProcessorValueTreeState::PresetMorpher::releaseRetiredTargets()
+{
+    for (int i = retiredTargets.size(); --i >= 0;)
+        if (retiredTargets.getObjectPointerUnchecked (i)->getReferenceCount() == 1)
+            retiredTargets.remove (i);
+}
+
 void AudioProcessorValueTreeState::setNewState (ValueTree vt)
 {
     jassert (vt.getParent() == state);
@@ -479,6 +719,11 @@ void AudioProcessorValueTreeState::timerCallback()
 {
     auto anythingUpdated = flushParameterValuesToValueTree();
 
+    if (anythingUpdated || currentSnapshot == nullptr)
+        publishParameterSnapshot();
+    else
+        releaseRetiredSnapshots();
+
     startTimer (anythingUpdated ? 1000 / 50
                                 : jlimit (50, 500, getTimerInterval() + 20));
 }
@@ -952,6 +1197,144 @@ public:
             expectEquals (listener.value, newValue);
             expectEquals (listener.id, String (key));
         }
+
+        const auto setValueInTree = [] (ValueTree tree, StringRef paramID, float value)
+        {
+            for (auto child : tree)
+                if (child.getProperty ("id").toString() == paramID)
+                    child.setProperty ("value", value, nullptr);
+        };
+
+        beginTest ("setStateBulk applies every value with one callback per changed parameter");
+        {
+            struct CountingListener final : public AudioProcessorValueTreeState::Listener
+            {
+                void parameterChanged (const String&, float newValue) override
+                {
+                    ++numCalls;
+                    value = newValue;
+                }
+
+                int numCalls = 0;
+                float value = 0.0f;
+            };
+
+            TestAudioProcessor proc ({ std::make_unique<AudioParameterFloat> ("a", "", NormalisableRange<float>{}, 0.0f),
+                                       std::make_unique<AudioParameterFloat> ("b", "", NormalisableRange<float>{}, 0.0f),
+                                       std::make_unique<AudioParameterFloat> ("c", "", NormalisableRange<float>{}, 0.0f) });
+
+            CountingListener la, lb, lc;
+            proc.state.addParameterListener ("a", &la);
+            proc.state.addParameterListener ("b", &lb);
+            proc.state.addParameterListener ("c", &lc);
+
+            auto newState = proc.state.copyState();
+            setValueInTree (newState, "a", 0.5f);
+            setValueInTree (newState, "b", 0.25f);
+
+            proc.state.setStateBulk (newState);
+
+            expectEquals (proc.state.getRawParameterValue ("a")->load(), 0.5f);
+            expectEquals (proc.state.getRawParameterValue ("b")->load(), 0.25f);
+            expectEquals (la.numCalls, 1);
+            expectEquals (la.value, 0.5f);
+            expectEquals (lb.numCalls, 1);
+            expectEquals (lb.value, 0.25f);
+            expectEquals (lc.numCalls, 0);
+        }
+
+        beginTest ("setStateBulk publishes a complete, immutable parameter snapshot");
+        {
+            TestAudioProcessor proc ({ std::make_unique<AudioParameterFloat> ("a", "", NormalisableRange<float>{}, 0.0f),
+                                       std::make_unique<AudioParameterFloat> ("b", "", NormalisableRange<float>{}, 0.0f) });
+
+            auto firstState = proc.state.copyState();
+            setValueInTree (firstState, "a", 0.5f);
+            setValueInTree (firstState, "b", 0.25f);
+            proc.state.setStateBulk (firstState);
+
+            auto firstSnapshot = proc.state.getParameterSnapshot();
+            expect (firstSnapshot != nullptr);
+
+            const auto indexA = proc.state.getParameter ("a")->getParameterIndex();
+            const auto indexB = proc.state.getParameter ("b")->getParameterIndex();
+
+            expectEquals (firstSnapshot->values[indexA], 0.5f);
+            expectEquals (firstSnapshot->values[indexB], 0.25f);
+
+            auto secondState = proc.state.copyState();
+            setValueInTree (secondState, "a", 0.75f);
+            proc.state.setStateBulk (secondState);
+
+            auto secondSnapshot = proc.state.getParameterSnapshot();
+            expect (secondSnapshot != firstSnapshot);
+            expectGreaterThan (secondSnapshot->version, firstSnapshot->version);
+            expectEquals (secondSnapshot->values[indexA], 0.75f);
+            expectEquals (secondSnapshot->values[indexB], 0.25f);
+
+            // a snapshot that's still referenced keeps its original values
+            expectEquals (firstSnapshot->values[indexA], 0.5f);
+        }
+
+        beginTest ("PresetMorpher interpolates raw values silently, then notifies in one batch");
+        {
+            struct CountingListener final : public AudioProcessorValueTreeState::Listener
+            {
+                void parameterChanged (const String&, float newValue) override
+                {
+                    ++numCalls;
+                    value = newValue;
+                }
+
+                int numCalls = 0;
+                float value = 0.0f;
+            };
+
+            TestAudioProcessor proc ({ std::make_unique<AudioParameterFloat> ("a", "", NormalisableRange<float> (0.0f, 1.0f), 0.0f),
+                                       std::make_unique<AudioParameterFloat> ("b", "", NormalisableRange<float> (0.0f, 100.0f), 0.0f) });
+
+            auto startState = proc.state.copyState();
+            setValueInTree (startState, "a", 0.0f);
+            setValueInTree (startState, "b", 0.0f);
+            proc.state.setStateBulk (startState);
+            auto startSnapshot = proc.state.getParameterSnapshot();
+
+            auto endState = proc.state.copyState();
+            setValueInTree (endState, "a", 1.0f);
+            setValueInTree (endState, "b", 50.0f);
+            proc.state.setStateBulk (endState);
+            auto endSnapshot = proc.state.getParameterSnapshot();
+
+            CountingListener la, lb;
+            proc.state.addParameterListener ("a", &la);
+            proc.state.addParameterListener ("b", &lb);
+
+            AudioProcessorValueTreeState::PresetMorpher morpher (proc.state);
+            expect (! morpher.isMorphing());
+
+            morpher.beginMorph (startSnapshot, endSnapshot);
+            expect (morpher.isMorphing());
+
+            // halfway through the fade, the raw values track the interpolation
+            // without the host or UI hearing anything about it
+            morpher.setMorphPosition (0.5f);
+            morpher.applyToParameters();
+
+            expectEquals (proc.state.getRawParameterValue ("a")->load(), 0.5f);
+            expectEquals (proc.state.getRawParameterValue ("b")->load(), 25.0f);
+            expectEquals (la.numCalls, 0);
+            expectEquals (lb.numCalls, 0);
+
+            // ending the gesture delivers the final values in a single pass
+            morpher.endMorph();
+            expect (! morpher.isMorphing());
+
+            expectEquals (proc.state.getParameter ("a")->getValue(), 0.5f);
+            expectEquals (la.numCalls, 1);
+            expectEquals (la.value, 0.5f);
+            expectEquals (lb.numCalls, 1);
+            expectEquals (lb.value, 25.0f);
+        }
     }
     JUCE_END_IGNORE_WARNINGS_MSVC
 };
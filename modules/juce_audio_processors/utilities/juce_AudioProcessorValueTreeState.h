@@ -346,6 +346,144 @@ public:
     */
     void replaceState (const ValueTree& newState);
 
+    /** Replaces the state value tree, applying all parameter values in one batched pass.
+
+        This behaves like replaceState(), but it's built for switching presets with
+        large parameter counts: instead of firing a full listener cascade for every
+        parameter as its child tree is connected, the new values are applied first
+        and the callbacks for the parameters that actually changed are coalesced
+        into a single pass at the end. Before returning it also publishes a fresh
+        parameter snapshot, so the audio thread can pick up the whole preset with
+        a single pointer read via getParameterSnapshot().
+
+        Like replaceState(), this is thread-safe but not realtime-safe.
+    */
+    void setStateBulk (const ValueTree& newState);
+
+    //==============================================================================
+    /** An immutable, reference-counted snapshot of every parameter's value.
+        @see getParameterSnapshot
+    */
+    struct ParameterValuesSnapshot  : public ReferenceCountedObject
+    {
+        using Ptr = ReferenceCountedObjectPtr<ParameterValuesSnapshot>;
+
+        /** The denormalised value of each parameter, indexed by
+            AudioProcessorParameter::getParameterIndex().
+        */
+        Array<float> values;
+
+        /** Increases by one each time a new snapshot is published. */
+        int64 version = 0;
+    };
+
+    /** Returns the most recently published snapshot of all parameter values.
+
+        This can be called from the audio thread: it is wait-free apart from a
+        momentary spin if a new snapshot is being swapped in at the same instant,
+        and old snapshots are only ever deleted on the message thread, however
+        long the audio thread hangs on to them.
+
+        A complete new snapshot is published atomically by setStateBulk(), so a
+        preset switch appears to the audio thread as a single pointer change
+        rather than a stream of individual parameter updates. Snapshots are also
+        refreshed periodically (on the same timer that syncs the ValueTree) as
+        parameters change individually.
+
+        This may return nullptr if no snapshot has been published yet.
+    */
+    ParameterValuesSnapshot::Ptr getParameterSnapshot() const noexcept;
+
+    //==============================================================================
+    /**
+        Crossfades all of an AudioProcessorValueTreeState's parameters between two
+        snapshots, with the interpolation itself running on the audio thread.
+
+        Morphing between presets by calling setValueNotifyingHost() from a timer
+        means a stream of per-parameter host and UI notifications for every step
+        of the fade. This class instead captures the two endpoint snapshots up
+        front, and while a morph is active the audio thread interpolates every
+        parameter's value directly into the raw atomic values returned by
+        getRawParameterValue(), without notifying anything. When the gesture
+        finishes, endMorph() pushes the final values to the host and UI in one
+        batched pass.
+
+        To use it, grab a snapshot of each preset with getParameterSnapshot()
+        (loading them with setStateBulk() publishes a snapshot synchronously),
+        then call beginMorph() with the two snapshots, applyToParameters() once
+        per block from your processBlock(), setMorphPosition() from wherever the
+        crossfade is being driven, and endMorph() from the message thread when
+        the morph ends.
+
+        Note that while a morph is running, only the raw values seen by
+        getRawParameterValue() are updated - the host, attached UI components
+        and the ValueTree all catch up when endMorph() is called.
+
+        @see getParameterSnapshot, setStateBulk
+    */
+    class JUCE_API  PresetMorpher
+    {
+    public:
+        /** Creates a morpher for the given state. The state must outlive the morpher. */
+        explicit PresetMorpher (AudioProcessorValueTreeState& stateToControl);
+
+        /** Destructor. */
+        ~PresetMorpher();
+
+        /** Starts morphing between two parameter snapshots.
+
+            The morph position is reset to 0, i.e. the start snapshot. Call this
+            from the message thread; the snapshot pair is handed to the audio
+            thread atomically.
+        */
+        void beginMorph (ParameterValuesSnapshot::Ptr startSnapshot,
+                         ParameterValuesSnapshot::Ptr endSnapshot);
+
+        /** Sets the current crossfade position, from 0 (the start snapshot)
+            to 1 (the end snapshot). This is safe to call from any thread.
+        */
+        void setMorphPosition (float newPosition) noexcept;
+
+        /** Returns the current crossfade position. */
+        float getMorphPosition() const noexcept;
+
+        /** Interpolates every parameter at the current morph position, writing the
+            results into the values returned by getRawParameterValue().
+
+            Call this once per block from the audio thread while a morph is active.
+            It's wait-free apart from a momentary spin if the snapshot pair is
+            being swapped at the same instant, and does nothing when no morph is
+            in progress.
+        */
+        void applyToParameters() noexcept;
+
+        /** Finishes the morph, sending the final interpolated values to the host
+            and any attached UI in a single batched notification pass.
+
+            Call this from the message thread when the morph gesture ends. Does
+            nothing if no morph is in progress.
+        */
+        void endMorph();
+
+        /** Returns true if a morph is currently in progress. */
+        bool isMorphing() const noexcept;
+
+    private:
+        struct MorphTargets;
+
+        void setActiveTargets (ReferenceCountedObjectPtr<MorphTargets>);
+        ReferenceCountedObjectPtr<MorphTargets> getActiveTargets() const noexcept;
+        void releaseRetiredTargets();
+
+        AudioProcessorValueTreeState& owner;
+        mutable SpinLock targetsLock;
+        ReferenceCountedObjectPtr<MorphTargets> activeTargets;
+        ReferenceCountedArray<MorphTargets> retiredTargets;
+        std::atomic<float> morphPosition { 0.0f };
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetMorpher)
+    };
+
     //==============================================================================
     /** A reference to the processor with which this state is associated. */
     AudioProcessor& processor;
@@ -539,6 +677,8 @@ private:
 
     bool flushParameterValuesToValueTree();
     void setNewState (ValueTree);
+    void publishParameterSnapshot();
+    void releaseRetiredSnapshots();
     void timerCallback() override;
 
     void valueTreePropertyChanged (ValueTree&, const Identifier&) override;
@@ -557,6 +697,11 @@ private:
 
     CriticalSection valueTreeChanging;
 
+    mutable SpinLock snapshotLock;
+    ParameterValuesSnapshot::Ptr currentSnapshot;
+    ReferenceCountedArray<ParameterValuesSnapshot> retiredSnapshots;
+    int64 snapshotVersion = 0;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioProcessorValueTreeState)
 };
 
@@ -26,6 +26,46 @@
 namespace juce
 {
 
+namespace detail
+{
+
+ParameterAttachmentHub::~ParameterAttachmentHub()
+{
+    cancelPendingUpdate();
+}
+
+void ParameterAttachmentHub::addAttachment (ParameterAttachment& attachment)
+{
+    const ScopedLock sl (listLock);
+    attachments.add (&attachment);
+}
+
+void ParameterAttachmentHub::removeAttachment (ParameterAttachment& attachment)
+{
+    const ScopedLock sl (listLock);
+    attachments.removeFirstMatchingValue (&attachment);
+}
+
+void ParameterAttachmentHub::triggerUpdate()
+{
+    triggerAsyncUpdate();
+}
+
+void ParameterAttachmentHub::handleAsyncUpdate()
+{
+    const ScopedLock sl (listLock);
+
+    // Iterating in reverse with a range-checked read copes with attachments
+    // being removed from inside their callbacks; clearing the dirty flag
+    // before delivering stops anything from being delivered twice.
+    for (int i = attachments.size(); --i >= 0;)
+        if (auto* attachment = attachments[i])
+            if (attachment->dirty.exchange (false))
+                attachment->deliverUpdate();
+}
+
+} // namespace detail
+
 ParameterAttachment::ParameterAttachment (RangedAudioParameter& param,
                                           std::function<void (float)> parameterChangedCallback,
                                           UndoManager* um)
@@ -33,13 +73,14 @@ ParameterAttachment::ParameterAttachment (RangedAudioParameter& param,
       undoManager (um),
       setValue (std::move (parameterChangedCallback))
 {
+    hub->addAttachment (*this);
     parameter.addListener (this);
 }
 
 ParameterAttachment::~ParameterAttachment()
 {
     parameter.removeListener (this);
-    cancelPendingUpdate();
+    hub->removeAttachment (*this);
 }
 
 void ParameterAttachment::sendInitialUpdate()
@@ -94,16 +135,17 @@ void ParameterAttachment::parameterValueChanged (int, float newValue)
 
     if (MessageManager::getInstance()->isThisTheMessageThread())
     {
-        cancelPendingUpdate();
-        handleAsyncUpdate();
+        dirty = false;
+        deliverUpdate();
     }
     else
     {
-        triggerAsyncUpdate();
+        if (! dirty.exchange (true))
+            hub->triggerUpdate();
     }
 }
 
-void ParameterAttachment::handleAsyncUpdate()
+void ParameterAttachment::deliverUpdate()
 {
     if (setValue != nullptr)
         setValue (parameter.convertFrom0to1 (lastValue));
@@ -26,6 +26,47 @@
 namespace juce
 {
 
+class ParameterAttachment;
+
+#ifndef DOXYGEN
+namespace detail
+{
+
+/*  Shared between every ParameterAttachment in the process.
+
+    Rather than each attachment posting its own AsyncUpdater message per
+    parameter change, attachments flag themselves dirty here and the hub
+    delivers all pending updates in a single async pass. This keeps the UI
+    update cost bounded by the rate of the message loop rather than by
+    automation density - a macro control mapped to dozens of parameters
+    produces one message per pass instead of one per parameter.
+*/
+class ParameterAttachmentHub  : private AsyncUpdater
+{
+public:
+    ParameterAttachmentHub() = default;
+    ~ParameterAttachmentHub() override;
+
+    void addAttachment (ParameterAttachment&);
+    void removeAttachment (ParameterAttachment&);
+
+    /** Called after an attachment has marked itself dirty. Safe to call from
+        any thread; if a pass is already pending this is just an atomic check.
+    */
+    void triggerUpdate();
+
+private:
+    void handleAsyncUpdate() override;
+
+    CriticalSection listLock;
+    Array<ParameterAttachment*> attachments;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterAttachmentHub)
+};
+
+} // namespace detail
+#endif
+
 /** Used to implement 'attachments' or 'controllers' that link a plug-in
     parameter to a UI element.
 
@@ -43,8 +84,7 @@ namespace juce
 
     @tags{Audio}
 */
-class ParameterAttachment   : private AudioProcessorParameter::Listener,
-                              private AsyncUpdater
+class ParameterAttachment   : private AudioProcessorParameter::Listener
 {
 public:
     /** Listens to a parameter and calls the the provided function in response to
@@ -109,10 +149,14 @@ private:
 
     void parameterValueChanged (int, float) override;
     void parameterGestureChanged (int, bool) override {}
-    void handleAsyncUpdate() override;
+    void deliverUpdate();
+
+    friend class detail::ParameterAttachmentHub;
 
     RangedAudioParameter& parameter;
     std::atomic<float> lastValue { 0.0f };
+    std::atomic<bool> dirty { false };
+    SharedResourcePointer<detail::ParameterAttachmentHub> hub;
     UndoManager* undoManager = nullptr;
     std::function<void (float)> setValue;
 
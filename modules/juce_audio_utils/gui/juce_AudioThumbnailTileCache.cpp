@@ -0,0 +1,248 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+AudioThumbnailTileCache::AudioThumbnailTileCache (AudioThumbnailBase& thumbnailToRender,
+                                                  TimeSliceThread& backgroundThread,
+                                                  int tileWidthToUse)
+    : thumbnail (thumbnailToRender),
+      thread (backgroundThread),
+      tileWidth (jmax (16, tileWidthToUse))
+{
+    thumbnail.addChangeListener (this);
+    thread.addTimeSliceClient (this);
+}
+
+AudioThumbnailTileCache::~AudioThumbnailTileCache()
+{
+    thread.removeTimeSliceClient (this);
+    thumbnail.removeChangeListener (this);
+}
+
+bool AudioThumbnailTileCache::Settings::operator== (const Settings& other) const noexcept
+{
+    return timePerPixel == other.timePerPixel
+        && height == other.height
+        && verticalZoom == other.verticalZoom;
+}
+
+//==============================================================================
+void AudioThumbnailTileCache::drawChannel (Graphics& g, const Rectangle<int>& area,
+                                           double startTimeSeconds, double endTimeSeconds,
+                                           int channelNum, float verticalZoomFactor)
+{
+    if (area.isEmpty() || endTimeSeconds <= startTimeSeconds)
+        return;
+
+    auto timePerPixel = (endTimeSeconds - startTimeSeconds) / area.getWidth();
+    auto tileDuration = tileWidth * timePerPixel;
+    bool anyTilesMissing = false;
+
+    Graphics::ScopedSaveState ss (g);
+    g.reduceClipRegion (area);
+
+    {
+        const ScopedLock sl (tileLock);
+        Settings required { timePerPixel, area.getHeight(), verticalZoomFactor };
+
+        if (! (settings == required))
+        {
+            settings = required;
+            tiles.clearQuick();
+            pendingTiles.clearQuick();
+        }
+    }
+
+    auto firstTile = (int64) std::floor (startTimeSeconds / tileDuration);
+
+    for (auto tileIndex = firstTile;; ++tileIndex)
+    {
+        auto tileStartTime = (double) tileIndex * tileDuration;
+
+        if (tileStartTime >= endTimeSeconds)
+            break;
+
+        auto x = area.getX() + roundToInt ((tileStartTime - startTimeSeconds) / timePerPixel);
+        Image tileImage;
+
+        {
+            const ScopedLock sl (tileLock);
+            auto existing = findTile (tileIndex, channelNum);
+
+            if (existing >= 0)
+            {
+                auto& tile = tiles.getReference (existing);
+                tile.lastUseTime = Time::getApproximateMillisecondCounter();
+                tileImage = tile.image;
+            }
+            else
+            {
+                pendingTiles.addIfNotAlreadyThere ({ tileIndex, channelNum });
+                anyTilesMissing = true;
+            }
+        }
+
+        if (tileImage.isValid())
+        {
+            g.drawImageAt (tileImage, x, area.getY(), true);
+        }
+        else
+        {
+            // draw this section the slow way for now - the tile will be ready
+            // for the next repaint
+            thumbnail.drawChannel (g, { x, area.getY(), tileWidth, area.getHeight() },
+                                   tileStartTime, tileStartTime + tileDuration,
+                                   channelNum, verticalZoomFactor);
+        }
+    }
+
+    if (anyTilesMissing)
+        thread.moveToFrontOfQueue (this);
+}
+
+void AudioThumbnailTileCache::drawChannels (Graphics& g, const Rectangle<int>& area,
+                                            double startTimeSeconds, double endTimeSeconds,
+                                            float verticalZoomFactor)
+{
+    auto numChannels = thumbnail.getNumChannels();
+
+    for (int i = 0; i < numChannels; ++i)
+    {
+        auto y1 = roundToInt ((i * area.getHeight()) / numChannels);
+        auto y2 = roundToInt (((i + 1) * area.getHeight()) / numChannels);
+
+        drawChannel (g, { area.getX(), area.getY() + y1, area.getWidth(), y2 - y1 },
+                     startTimeSeconds, endTimeSeconds, i, verticalZoomFactor);
+    }
+}
+
+//==============================================================================
+void AudioThumbnailTileCache::invalidate()
+{
+    const ScopedLock sl (tileLock);
+    tiles.clearQuick();
+    pendingTiles.clearQuick();
+}
+
+void AudioThumbnailTileCache::setMaxNumTiles (int newMaximum) noexcept
+{
+    const ScopedLock sl (tileLock);
+    maxNumTiles = jmax (1, newMaximum);
+    trimOldestTiles();
+}
+
+void AudioThumbnailTileCache::changeListenerCallback (ChangeBroadcaster*)
+{
+    // the thumbnail has new data, so everything we've rendered is out of date
+    invalidate();
+}
+
+int AudioThumbnailTileCache::findTile (int64 tileIndex, int channelNum) const noexcept
+{
+    for (int i = 0; i < tiles.size(); ++i)
+    {
+        auto& tile = tiles.getReference (i);
+
+        if (tile.index == tileIndex && tile.channel == channelNum)
+            return i;
+    }
+
+    return -1;
+}
+
+void AudioThumbnailTileCache::trimOldestTiles()
+{
+    while (tiles.size() > maxNumTiles)
+    {
+        int oldest = 0;
+
+        for (int i = 1; i < tiles.size(); ++i)
+            if (tiles.getReference (i).lastUseTime < tiles.getReference (oldest).lastUseTime)
+                oldest = i;
+
+        tiles.remove (oldest);
+    }
+}
+
+//==============================================================================
+int AudioThumbnailTileCache::useTimeSlice()
+{
+    std::pair<int64, int> request;
+    Settings renderSettings;
+
+    {
+        const ScopedLock sl (tileLock);
+
+        if (pendingTiles.isEmpty())
+            return 100;
+
+        request = pendingTiles.removeAndReturn (0);
+        renderSettings = settings;
+    }
+
+    if (renderSettings.height <= 0 || renderSettings.timePerPixel <= 0)
+        return 100;
+
+    auto tileDuration = tileWidth * renderSettings.timePerPixel;
+    auto tileStartTime = (double) request.first * tileDuration;
+
+    // single-channel tiles are just alpha masks, so they can be blitted in
+    // whatever colour the view happens to be using
+    Image tileImage (Image::SingleChannel, tileWidth, renderSettings.height, true);
+
+    {
+        Graphics g (tileImage);
+        g.setColour (Colours::white);
+        thumbnail.drawChannel (g, tileImage.getBounds(),
+                               tileStartTime, tileStartTime + tileDuration,
+                               request.second, renderSettings.verticalZoom);
+    }
+
+    bool tileStored = false, moreToDo = false;
+
+    {
+        const ScopedLock sl (tileLock);
+
+        // the view may have changed its zoom while this tile was rendering, in
+        // which case the result is useless
+        if (settings == renderSettings && findTile (request.first, request.second) < 0)
+        {
+            tiles.add ({ request.first, request.second, tileImage, Time::getApproximateMillisecondCounter() });
+            trimOldestTiles();
+            tileStored = true;
+        }
+
+        moreToDo = ! pendingTiles.isEmpty();
+    }
+
+    if (tileStored)
+        sendChangeMessage();
+
+    return moreToDo ? 1 : 100;
+}
+
+} // namespace juce
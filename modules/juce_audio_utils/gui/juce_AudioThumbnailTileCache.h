@@ -0,0 +1,154 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Caches rendered sections of an audio thumbnail as fixed-width image tiles,
+    so that scrolling a waveform view only has to blit images instead of
+    re-rasterizing the peak data on every paint.
+
+    Tiles are rendered on a background thread into single-channel images, which
+    are drawn using the Graphics' current colour. While a tile is still being
+    rendered, drawChannel() falls back to drawing that section through the
+    thumbnail directly, so nothing ever appears blank.
+
+    The cache keeps tiles for one zoom level at a time: changing the time scale,
+    the area height or the vertical zoom throws the existing tiles away and
+    re-renders at the new settings. This is a ChangeBroadcaster, and will send a
+    change message when freshly-rendered tiles are ready, so that views can
+    repaint and pick them up.
+
+    @code
+    AudioThumbnailTileCache tileCache (thumbnail, thumbnailCache.getTimeSliceThread());
+    ...
+    g.setColour (Colours::lightgreen);
+    tileCache.drawChannels (g, area, startTime, endTime, 1.0f);
+    @endcode
+
+    @see AudioThumbnail, AudioThumbnailCache
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioThumbnailTileCache   : public ChangeBroadcaster,
+                                            private TimeSliceClient,
+                                            private ChangeListener
+{
+public:
+    //==============================================================================
+    /** Creates a tile cache for a thumbnail.
+
+        @param thumbnailToRender  the thumbnail to rasterize. The cache listens to it
+                                  for changes, and drops its tiles when new data arrives.
+                                  It must outlive this object.
+        @param backgroundThread   the thread on which tiles will be rendered - an
+                                  AudioThumbnailCache's time-slice thread is a good
+                                  choice. Make sure it's running!
+        @param tileWidthToUse     the width in pixels of each cached tile
+    */
+    AudioThumbnailTileCache (AudioThumbnailBase& thumbnailToRender,
+                             TimeSliceThread& backgroundThread,
+                             int tileWidthToUse = 128);
+
+    /** Destructor. */
+    ~AudioThumbnailTileCache() override;
+
+    //==============================================================================
+    /** Draws a channel of the thumbnail, blitting cached tiles where they're
+        available and rendering straight from the thumbnail where they aren't.
+
+        The parameters have the same meaning as AudioThumbnailBase::drawChannel(),
+        and the waveform is drawn in the Graphics' current colour.
+    */
+    void drawChannel (Graphics& g,
+                      const Rectangle<int>& area,
+                      double startTimeSeconds,
+                      double endTimeSeconds,
+                      int channelNum,
+                      float verticalZoomFactor);
+
+    /** Draws all of the thumbnail's channels, stacked above each other within
+        the area, in the same layout as AudioThumbnailBase::drawChannels().
+    */
+    void drawChannels (Graphics& g,
+                       const Rectangle<int>& area,
+                       double startTimeSeconds,
+                       double endTimeSeconds,
+                       float verticalZoomFactor);
+
+    //==============================================================================
+    /** Discards all cached tiles.
+        This happens automatically when the thumbnail broadcasts a change.
+    */
+    void invalidate();
+
+    /** Sets the maximum number of tiles to keep cached.
+        When the limit is exceeded, the least-recently-drawn tiles are dropped.
+    */
+    void setMaxNumTiles (int newMaximum) noexcept;
+
+    /** Returns the width in pixels of the cached tiles. */
+    int getTileWidth() const noexcept       { return tileWidth; }
+
+private:
+    //==============================================================================
+    struct Settings
+    {
+        double timePerPixel = 0;
+        int height = 0;
+        float verticalZoom = 0;
+
+        bool operator== (const Settings&) const noexcept;
+    };
+
+    struct Tile
+    {
+        int64 index;
+        int channel;
+        Image image;
+        uint32 lastUseTime;
+    };
+
+    int useTimeSlice() override;
+    void changeListenerCallback (ChangeBroadcaster*) override;
+    int findTile (int64 tileIndex, int channelNum) const noexcept;
+    void trimOldestTiles();
+
+    AudioThumbnailBase& thumbnail;
+    TimeSliceThread& thread;
+    const int tileWidth;
+    int maxNumTiles = 256;
+
+    CriticalSection tileLock;
+    Settings settings;
+    Array<Tile> tiles;
+    Array<std::pair<int64, int>> pendingTiles;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioThumbnailTileCache)
+};
+
+} // namespace juce
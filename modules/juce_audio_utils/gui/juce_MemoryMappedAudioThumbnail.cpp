@@ -0,0 +1,719 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/*  A peak file starts with this header, followed by a pyramid of levels, each
+    one an array of interleaved per-channel { int8 min, int8 max } pairs. Level
+    0 covers baseSamplesPerValue source samples per pair and every further
+    level doubles that, so any zoom maps onto a level where each pixel touches
+    at most a couple of values. Values are written in the native byte order -
+    peak files are a per-machine cache, not an interchange format.
+*/
+struct MemoryMappedAudioThumbnailHeader
+{
+    char magic[4];              // "japk"
+    int32 version;
+    int32 numChannels;
+    int32 numLevels;
+    int32 baseSamplesPerValue;
+    int32 padding;
+    double sampleRate;
+    int64 totalSamples;
+    int64 numSamplesFinished;
+    int64 sourceHash;
+    int64 reserved[2];
+};
+
+enum
+{
+    peakFileVersion = 1,
+    minValuesInCoarsestLevel = 1024,
+    maxNumPeakFileLevels = 10
+};
+
+static void storePeakPair (int8* dest, Range<float> range) noexcept
+{
+    auto mn = (int8) roundToInt (jlimit (-1.0f, 1.0f, range.getStart()) * 127.0f);
+    auto mx = (int8) roundToInt (jlimit (-1.0f, 1.0f, range.getEnd())   * 127.0f);
+
+    if (mn == mx)
+    {
+        if (mx == 127)
+            --mn;
+        else
+            ++mx;
+    }
+
+    dest[0] = mn;
+    dest[1] = mx;
+}
+
+//==============================================================================
+class MemoryMappedAudioThumbnail::Builder  : public TimeSliceClient
+{
+public:
+    Builder (MemoryMappedAudioThumbnail& thumb, AudioFormatReader* newReader, InputSource* src)
+        : owner (thumb), source (src), reader (newReader)
+    {
+    }
+
+    ~Builder() override
+    {
+        owner.thread.removeTimeSliceClient (this);
+    }
+
+    int useTimeSlice() override
+    {
+        if (owner.isFullyLoaded())
+        {
+            reader.reset();
+            return -1;
+        }
+
+        createReader();
+
+        if (reader == nullptr)
+            return -1;
+
+        readNextChunk();
+        return owner.isFullyLoaded() ? -1 : 0;
+    }
+
+private:
+    enum { valuesPerChunk = 256 };
+
+    void createReader()
+    {
+        if (reader == nullptr && source != nullptr)
+            if (auto* audioFileStream = source->createInputStream())
+                reader.reset (owner.formatManagerToUse.createReaderFor (std::unique_ptr<InputStream> (audioFileStream)));
+    }
+
+    void readNextChunk()
+    {
+        const auto spv = (int64) owner.baseSamplesPerValue;
+        const auto numChans = owner.numChannels;
+        const auto totalValues = owner.levels.getReference (0).numValues;
+
+        auto firstValue = owner.numSamplesFinished / spv;
+        auto numToDo = jmin ((int64) valuesPerChunk, totalValues - firstValue);
+
+        if (numToDo <= 0)
+        {
+            owner.setFinishedSamples (owner.totalSamples);
+            return;
+        }
+
+        // the reading happens into a scratch buffer without holding the owner's
+        // lock, so that paint calls aren't stalled behind disk access
+        HeapBlock<int8> scratch ((size_t) (numToDo * numChans * 2));
+        HeapBlock<Range<float>> levelsRead ((size_t) numChans);
+
+        for (int64 i = 0; i < numToDo; ++i)
+        {
+            auto startSample = (firstValue + i) * spv;
+            auto numSamples = (int) jmin (spv, owner.totalSamples - startSample);
+
+            reader->readMaxLevels (startSample, numSamples, levelsRead, numChans);
+
+            for (int chan = 0; chan < numChans; ++chan)
+                storePeakPair (scratch + (i * numChans + chan) * 2, levelsRead[chan]);
+        }
+
+        {
+            const ScopedLock sl (owner.lock);
+
+            if (owner.mapping == nullptr)
+                return;
+
+            std::memcpy (owner.getLevelData (0) + firstValue * numChans * 2,
+                         scratch, (size_t) (numToDo * numChans * 2));
+
+            owner.updateLevelsForRange (firstValue, firstValue + numToDo);
+            owner.setFinishedSamples (jmin ((firstValue + numToDo) * spv, owner.totalSamples));
+        }
+
+        owner.sendChangeMessage();
+    }
+
+    MemoryMappedAudioThumbnail& owner;
+    std::unique_ptr<InputSource> source;
+    std::unique_ptr<AudioFormatReader> reader;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Builder)
+};
+
+//==============================================================================
+MemoryMappedAudioThumbnail::MemoryMappedAudioThumbnail (const File& file,
+                                                        AudioFormatManager& formatManager,
+                                                        TimeSliceThread& backgroundThread,
+                                                        int baseSamplesPerThumbnailSample)
+    : peakFile (file),
+      formatManagerToUse (formatManager),
+      thread (backgroundThread),
+      baseSamplesPerValue (baseSamplesPerThumbnailSample)
+{
+}
+
+MemoryMappedAudioThumbnail::~MemoryMappedAudioThumbnail()
+{
+    clear();
+}
+
+void MemoryMappedAudioThumbnail::clear()
+{
+    builder.reset();
+
+    const ScopedLock sl (lock);
+    mapping.reset();
+    levels.clearQuick();
+    numChannels = 0;
+    sampleRate = 0;
+    totalSamples = numSamplesFinished = 0;
+    sourceHash = 0;
+
+    sendChangeMessage();
+}
+
+//==============================================================================
+void MemoryMappedAudioThumbnail::computeLevelLayout()
+{
+    levels.clearQuick();
+
+    auto offset = (int64) sizeof (MemoryMappedAudioThumbnailHeader);
+    auto samplesPerValue = (int64) baseSamplesPerValue;
+
+    for (;;)
+    {
+        Level level;
+        level.samplesPerValue = samplesPerValue;
+        level.numValues = (totalSamples + samplesPerValue - 1) / samplesPerValue;
+        level.offsetInFile = offset;
+        levels.add (level);
+
+        offset += level.numValues * numChannels * 2;
+
+        if (level.numValues <= minValuesInCoarsestLevel || levels.size() >= maxNumPeakFileLevels)
+            break;
+
+        samplesPerValue *= 2;
+    }
+}
+
+bool MemoryMappedAudioThumbnail::mapPeakFile()
+{
+    mapping = std::make_unique<MemoryMappedFile> (peakFile, MemoryMappedFile::readWrite);
+
+    if (mapping->getData() == nullptr)
+    {
+        mapping.reset();
+        return false;
+    }
+
+    auto& last = levels.getReference (levels.size() - 1);
+    auto requiredSize = last.offsetInFile + last.numValues * numChannels * 2;
+
+    if ((int64) mapping->getSize() < requiredSize)
+    {
+        mapping.reset();
+        return false;
+    }
+
+    return true;
+}
+
+bool MemoryMappedAudioThumbnail::createPeakFile()
+{
+    computeLevelLayout();
+
+    auto& last = levels.getReference (levels.size() - 1);
+    auto totalSize = last.offsetInFile + last.numValues * numChannels * 2;
+
+    peakFile.deleteFile();
+
+    {
+        FileOutputStream out (peakFile);
+
+        if (out.failedToOpen() || ! out.setPosition (totalSize - 1))
+            return false;
+
+        out.writeByte (0);
+    }
+
+    if (! mapPeakFile())
+        return false;
+
+    numSamplesFinished = 0;
+    storeHeader();
+    return true;
+}
+
+void MemoryMappedAudioThumbnail::storeHeader() const noexcept
+{
+    auto& header = *static_cast<MemoryMappedAudioThumbnailHeader*> (mapping->getData());
+
+    memcpy (header.magic, "japk", 4);
+    header.version = peakFileVersion;
+    header.numChannels = numChannels;
+    header.numLevels = levels.size();
+    header.baseSamplesPerValue = baseSamplesPerValue;
+    header.padding = 0;
+    header.sampleRate = sampleRate;
+    header.totalSamples = totalSamples;
+    header.numSamplesFinished = numSamplesFinished;
+    header.sourceHash = sourceHash;
+    header.reserved[0] = header.reserved[1] = 0;
+}
+
+bool MemoryMappedAudioThumbnail::openExistingPeakFile (int64 expectedHash)
+{
+    mapping.reset();
+
+    if (peakFile.getSize() < (int64) sizeof (MemoryMappedAudioThumbnailHeader))
+        return false;
+
+    auto candidate = std::make_unique<MemoryMappedFile> (peakFile, MemoryMappedFile::readWrite);
+
+    if (candidate->getData() == nullptr || candidate->getSize() < sizeof (MemoryMappedAudioThumbnailHeader))
+        return false;
+
+    auto& header = *static_cast<const MemoryMappedAudioThumbnailHeader*> (candidate->getData());
+
+    if (memcmp (header.magic, "japk", 4) != 0
+         || header.version != peakFileVersion
+         || header.sourceHash != expectedHash
+         || header.baseSamplesPerValue != baseSamplesPerValue
+         || header.numChannels <= 0
+         || header.totalSamples <= 0)
+        return false;
+
+    numChannels = header.numChannels;
+    sampleRate = header.sampleRate;
+    totalSamples = header.totalSamples;
+    numSamplesFinished = jlimit ((int64) 0, totalSamples, header.numSamplesFinished);
+    sourceHash = header.sourceHash;
+
+    computeLevelLayout();
+
+    if (levels.size() != header.numLevels)
+        return false;
+
+    mapping = std::move (candidate);
+
+    auto& last = levels.getReference (levels.size() - 1);
+
+    if ((int64) mapping->getSize() < last.offsetInFile + last.numValues * numChannels * 2)
+    {
+        mapping.reset();
+        return false;
+    }
+
+    return true;
+}
+
+int8* MemoryMappedAudioThumbnail::getLevelData (int level) const noexcept
+{
+    return static_cast<int8*> (mapping->getData()) + levels.getReference (level).offsetInFile;
+}
+
+void MemoryMappedAudioThumbnail::updateLevelsForRange (int64 startValue, int64 endValue)
+{
+    for (int levelIndex = 1; levelIndex < levels.size(); ++levelIndex)
+    {
+        auto& previous = levels.getReference (levelIndex - 1);
+        auto& current  = levels.getReference (levelIndex);
+
+        startValue /= 2;
+        endValue = jmin (current.numValues, (endValue + 1) / 2);
+
+        auto* src  = getLevelData (levelIndex - 1);
+        auto* dest = getLevelData (levelIndex);
+
+        for (auto v = startValue; v < endValue; ++v)
+        {
+            for (int chan = 0; chan < numChannels; ++chan)
+            {
+                auto* first = src + ((v * 2) * numChannels + chan) * 2;
+                auto mn = first[0];
+                auto mx = first[1];
+
+                if (v * 2 + 1 < previous.numValues)
+                {
+                    auto* second = first + numChannels * 2;
+                    mn = jmin (mn, second[0]);
+                    mx = jmax (mx, second[1]);
+                }
+
+                auto* d = dest + (v * numChannels + chan) * 2;
+                d[0] = mn;
+                d[1] = mx;
+            }
+        }
+    }
+}
+
+void MemoryMappedAudioThumbnail::setFinishedSamples (int64 newNumSamplesFinished)
+{
+    numSamplesFinished = newNumSamplesFinished;
+
+    if (mapping != nullptr)
+        static_cast<MemoryMappedAudioThumbnailHeader*> (mapping->getData())->numSamplesFinished = newNumSamplesFinished;
+}
+
+//==============================================================================
+bool MemoryMappedAudioThumbnail::setDataSource (std::unique_ptr<InputSource> src,
+                                                AudioFormatReader* rawReader, int64 hash)
+{
+    JUCE_ASSERT_MESSAGE_MANAGER_IS_LOCKED
+
+    std::unique_ptr<AudioFormatReader> reader (rawReader);
+
+    builder.reset();
+
+    const ScopedLock sl (lock);
+    sourceHash = hash;
+
+    if (openExistingPeakFile (hash) && numSamplesFinished >= totalSamples)
+    {
+        sendChangeMessage();
+        return sampleRate > 0 && totalSamples > 0;
+    }
+
+    if (reader == nullptr && src != nullptr)
+        if (auto* audioFileStream = src->createInputStream())
+            reader.reset (formatManagerToUse.createReaderFor (std::unique_ptr<InputStream> (audioFileStream)));
+
+    if (reader == nullptr || reader->lengthInSamples <= 0)
+        return false;
+
+    if (mapping == nullptr)
+    {
+        // no usable peak file yet, so lay out a fresh one
+        numChannels = (int) reader->numChannels;
+        sampleRate = reader->sampleRate;
+        totalSamples = reader->lengthInSamples;
+
+        if (! createPeakFile())
+            return false;
+    }
+
+    builder = std::make_unique<Builder> (*this, reader.release(), src.release());
+    thread.addTimeSliceClient (builder.get());
+
+    return sampleRate > 0 && totalSamples > 0;
+}
+
+bool MemoryMappedAudioThumbnail::setSource (InputSource* newSource)
+{
+    std::unique_ptr<InputSource> source (newSource);
+
+    if (source == nullptr)
+    {
+        clear();
+        return false;
+    }
+
+    auto hash = source->hashCode();
+    return setDataSource (std::move (source), nullptr, hash);
+}
+
+void MemoryMappedAudioThumbnail::setReader (AudioFormatReader* newReader, int64 hash)
+{
+    if (newReader != nullptr)
+        setDataSource (nullptr, newReader, hash);
+    else
+        clear();
+}
+
+int64 MemoryMappedAudioThumbnail::getHashCode() const
+{
+    const ScopedLock sl (lock);
+    return sourceHash;
+}
+
+//==============================================================================
+bool MemoryMappedAudioThumbnail::loadFrom (InputStream& input)
+{
+    builder.reset();
+
+    const ScopedLock sl (lock);
+    mapping.reset();
+
+    MemoryBlock data;
+    input.readIntoMemoryBlock (data);
+
+    if (data.getSize() < sizeof (MemoryMappedAudioThumbnailHeader)
+         || memcmp (data.getData(), "japk", 4) != 0)
+        return false;
+
+    if (! peakFile.replaceWithData (data.getData(), data.getSize()))
+        return false;
+
+    auto hash = static_cast<const MemoryMappedAudioThumbnailHeader*> (data.getData())->sourceHash;
+    return openExistingPeakFile (hash);
+}
+
+void MemoryMappedAudioThumbnail::saveTo (OutputStream& output) const
+{
+    const ScopedLock sl (lock);
+
+    if (mapping != nullptr)
+        output.write (mapping->getData(), mapping->getSize());
+}
+
+//==============================================================================
+void MemoryMappedAudioThumbnail::reset (int newNumChannels, double newSampleRate, int64 totalSamplesInSource)
+{
+    clear();
+
+    const ScopedLock sl (lock);
+    numChannels = newNumChannels;
+    sampleRate = newSampleRate;
+    totalSamples = totalSamplesInSource;
+
+    if (numChannels > 0 && totalSamples > 0)
+        createPeakFile();
+}
+
+void MemoryMappedAudioThumbnail::addBlock (int64 startSample, const AudioBuffer<float>& incoming,
+                                           int startOffsetInBuffer, int numSamples)
+{
+    jassert (startSample >= 0
+              && startOffsetInBuffer >= 0
+              && startOffsetInBuffer + numSamples <= incoming.getNumSamples());
+
+    const ScopedLock sl (lock);
+
+    if (mapping == nullptr || levels.isEmpty())
+        return;
+
+    auto spv = (int64) baseSamplesPerValue;
+    auto firstValue = startSample / spv;
+    auto lastValue = jmin (levels.getReference (0).numValues,
+                           (startSample + numSamples + spv - 1) / spv);
+
+    auto numChans = jmin (numChannels, incoming.getNumChannels());
+    auto* level0 = getLevelData (0);
+
+    for (auto v = firstValue; v < lastValue; ++v)
+    {
+        auto start = (int) (v * spv - startSample);
+        auto numThisTime = jmin ((int) spv, numSamples - jmax (0, start));
+
+        if (numThisTime <= 0)
+            continue;
+
+        for (int chan = 0; chan < numChans; ++chan)
+        {
+            auto* sourceData = incoming.getReadPointer (chan, startOffsetInBuffer + jmax (0, start));
+            storePeakPair (level0 + (v * numChannels + chan) * 2,
+                           FloatVectorOperations::findMinAndMax (sourceData, numThisTime));
+        }
+    }
+
+    updateLevelsForRange (firstValue, lastValue);
+
+    auto end = lastValue * spv;
+
+    if (numSamplesFinished >= firstValue * spv && end > numSamplesFinished)
+        setFinishedSamples (jmin (end, totalSamples));
+
+    sendChangeMessage();
+}
+
+//==============================================================================
+int MemoryMappedAudioThumbnail::getNumChannels() const noexcept
+{
+    const ScopedLock sl (lock);
+    return numChannels;
+}
+
+double MemoryMappedAudioThumbnail::getTotalLength() const noexcept
+{
+    const ScopedLock sl (lock);
+    return sampleRate > 0 ? ((double) totalSamples / sampleRate) : 0.0;
+}
+
+bool MemoryMappedAudioThumbnail::isFullyLoaded() const noexcept
+{
+    const ScopedLock sl (lock);
+    return totalSamples > 0 && numSamplesFinished >= totalSamples - baseSamplesPerValue;
+}
+
+int64 MemoryMappedAudioThumbnail::getNumSamplesFinished() const noexcept
+{
+    const ScopedLock sl (lock);
+    return numSamplesFinished;
+}
+
+int MemoryMappedAudioThumbnail::chooseLevelFor (double samplesPerPixel) const noexcept
+{
+    int level = 0;
+
+    while (level + 1 < levels.size()
+            && (double) levels.getReference (level + 1).samplesPerValue <= samplesPerPixel)
+        ++level;
+
+    return level;
+}
+
+void MemoryMappedAudioThumbnail::readMinMax (int level, int channelNum, int64 startValue, int64 endValue,
+                                             int& minValue, int& maxValue) const noexcept
+{
+    minValue = 127;
+    maxValue = -128;
+
+    auto& info = levels.getReference (level);
+    startValue = jmax ((int64) 0, startValue);
+    endValue = jmin (info.numValues, endValue);
+
+    auto* data = getLevelData (level);
+
+    for (auto v = startValue; v < endValue; ++v)
+    {
+        auto* pair = data + (v * numChannels + channelNum) * 2;
+        minValue = jmin (minValue, (int) pair[0]);
+        maxValue = jmax (maxValue, (int) pair[1]);
+    }
+}
+
+float MemoryMappedAudioThumbnail::getApproximatePeak() const
+{
+    const ScopedLock sl (lock);
+
+    if (mapping == nullptr || levels.isEmpty())
+        return 0.0f;
+
+    int peak = 0;
+    auto coarsest = levels.size() - 1;
+
+    for (int chan = 0; chan < numChannels; ++chan)
+    {
+        int mn, mx;
+        readMinMax (coarsest, chan, 0, levels.getReference (coarsest).numValues, mn, mx);
+        peak = jmax (peak, std::abs (mn), std::abs (mx));
+    }
+
+    return (float) jlimit (0, 127, peak) / 127.0f;
+}
+
+void MemoryMappedAudioThumbnail::getApproximateMinMax (double startTime, double endTime, int channelIndex,
+                                                       float& minValue, float& maxValue) const noexcept
+{
+    const ScopedLock sl (lock);
+
+    minValue = maxValue = 0.0f;
+
+    if (mapping == nullptr || levels.isEmpty() || sampleRate <= 0
+         || ! isPositiveAndBelow (channelIndex, numChannels))
+        return;
+
+    auto level = chooseLevelFor ((endTime - startTime) * sampleRate / (double) minValuesInCoarsestLevel);
+    auto spv = (double) levels.getReference (level).samplesPerValue;
+
+    int mn, mx;
+    readMinMax (level, channelIndex,
+                (int64) (startTime * sampleRate / spv),
+                (int64) std::ceil (endTime * sampleRate / spv),
+                mn, mx);
+
+    if (mn <= mx)
+    {
+        minValue = (float) mn / 128.0f;
+        maxValue = (float) mx / 128.0f;
+    }
+}
+
+//==============================================================================
+void MemoryMappedAudioThumbnail::drawChannel (Graphics& g, const Rectangle<int>& area,
+                                              double startTime, double endTime,
+                                              int channelNum, float verticalZoomFactor)
+{
+    const ScopedLock sl (lock);
+
+    if (mapping == nullptr || levels.isEmpty() || sampleRate <= 0
+         || area.getWidth() <= 0 || endTime <= startTime
+         || ! isPositiveAndBelow (channelNum, numChannels))
+        return;
+
+    auto clip = g.getClipBounds().getIntersection (area);
+
+    if (clip.isEmpty())
+        return;
+
+    auto timePerPixel = (endTime - startTime) / area.getWidth();
+    auto level = chooseLevelFor (timePerPixel * sampleRate);
+    auto spv = (double) levels.getReference (level).samplesPerValue;
+
+    auto topY = (float) area.getY();
+    auto bottomY = (float) area.getBottom();
+    auto midY = (topY + bottomY) * 0.5f;
+    auto vscale = verticalZoomFactor * (bottomY - topY) / 256.0f;
+
+    RectangleList<float> waveform;
+    waveform.ensureStorageAllocated (clip.getWidth());
+
+    for (int x = clip.getX(); x < clip.getRight(); ++x)
+    {
+        auto t0 = startTime + (x - area.getX()) * timePerPixel;
+        auto t1 = t0 + timePerPixel;
+
+        int mn, mx;
+        readMinMax (level, channelNum,
+                    (int64) (t0 * sampleRate / spv),
+                    (int64) std::ceil (t1 * sampleRate / spv),
+                    mn, mx);
+
+        if (mn < mx)
+        {
+            auto top    = jmax (midY - (float) mx * vscale - 0.3f, topY);
+            auto bottom = jmin (midY - (float) mn * vscale + 0.3f, bottomY);
+
+            waveform.addWithoutMerging (Rectangle<float> ((float) x, top, 1.0f, bottom - top));
+        }
+    }
+
+    g.fillRectList (waveform);
+}
+
+void MemoryMappedAudioThumbnail::drawChannels (Graphics& g, const Rectangle<int>& area,
+                                               double startTimeSeconds, double endTimeSeconds,
+                                               float verticalZoomFactor)
+{
+    auto numChans = getNumChannels();
+
+    for (int i = 0; i < numChans; ++i)
+    {
+        auto y1 = roundToInt ((i * area.getHeight()) / numChans);
+        auto y2 = roundToInt (((i + 1) * area.getHeight()) / numChans);
+
+        drawChannel (g, { area.getX(), area.getY() + y1, area.getWidth(), y2 - y1 },
+                     startTimeSeconds, endTimeSeconds, i, verticalZoomFactor);
+    }
+}
+
+} // namespace juce
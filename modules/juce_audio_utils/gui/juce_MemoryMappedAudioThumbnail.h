@@ -0,0 +1,169 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An AudioThumbnailBase implementation that keeps a multi-resolution pyramid
+    of min/max peaks in a memory-mapped peak file.
+
+    AudioThumbnail holds a single resolution of peaks on the heap, so a session
+    with many long stems pays for all of them in resident memory, and drawing at
+    a zoom level far from the stored resolution has to aggregate long runs of
+    values. This class instead computes a mipmap pyramid - level 0 stores one
+    min/max pair per baseSamplesPerThumbnailSample source samples, and each
+    higher level halves the resolution - and persists the whole pyramid to a
+    peak file which is then memory-mapped. Drawing picks the nearest precomputed
+    level for the current zoom, touching O(pixels) bytes of the mapping, and the
+    OS pages peak data in and out on demand, so an arrange window full of
+    thumbnails keeps almost nothing resident.
+
+    The peak file is built once on the given TimeSliceThread; if the file
+    already exists for the same source it's simply mapped and no scanning
+    happens at all. Peak files use the native byte order, so treat them as a
+    per-machine cache rather than an interchange format.
+
+    @see AudioThumbnail, AudioThumbnailCache
+
+    @tags{Audio}
+*/
+class JUCE_API  MemoryMappedAudioThumbnail    : public AudioThumbnailBase
+{
+public:
+    //==============================================================================
+    /** Creates a thumbnail backed by the given peak file.
+
+        @param peakFile                         where to store (or find) the peak data for
+                                                this thumbnail's source
+        @param formatManagerToUse               the audio file formats to use for parsing
+        @param backgroundThread                 the thread on which the peak file gets built
+        @param baseSamplesPerThumbnailSample    the number of source samples per value in
+                                                the finest pyramid level
+    */
+    MemoryMappedAudioThumbnail (const File& peakFile,
+                                AudioFormatManager& formatManagerToUse,
+                                TimeSliceThread& backgroundThread,
+                                int baseSamplesPerThumbnailSample = 256);
+
+    /** Destructor. */
+    ~MemoryMappedAudioThumbnail() override;
+
+    /** Returns the file that holds (or will hold) the peak data. */
+    const File& getPeakFile() const noexcept            { return peakFile; }
+
+    //==============================================================================
+    /** Closes the mapping and forgets the current source.
+        Note that this doesn't delete the peak file - it stays on disk so that the
+        same source can be re-opened later without a rescan.
+    */
+    void clear() override;
+
+    bool setSource (InputSource* newSource) override;
+    void setReader (AudioFormatReader* newReader, int64 hashCode) override;
+
+    /** Copies a complete peak file, as written by saveTo(), into this thumbnail's
+        peak file and maps it.
+    */
+    bool loadFrom (InputStream& input) override;
+
+    /** Writes the raw contents of the peak file to the stream. */
+    void saveTo (OutputStream& output) const override;
+
+    //==============================================================================
+    int getNumChannels() const noexcept override;
+    double getTotalLength() const noexcept override;
+
+    void drawChannel (Graphics& g,
+                      const Rectangle<int>& area,
+                      double startTimeSeconds,
+                      double endTimeSeconds,
+                      int channelNum,
+                      float verticalZoomFactor) override;
+
+    void drawChannels (Graphics& g,
+                       const Rectangle<int>& area,
+                       double startTimeSeconds,
+                       double endTimeSeconds,
+                       float verticalZoomFactor) override;
+
+    bool isFullyLoaded() const noexcept override;
+    int64 getNumSamplesFinished() const noexcept override;
+    float getApproximatePeak() const override;
+    void getApproximateMinMax (double startTime, double endTime, int channelIndex,
+                               float& minValue, float& maxValue) const noexcept override;
+    int64 getHashCode() const override;
+
+    //==============================================================================
+    /** @internal */
+    void reset (int numChannels, double sampleRate, int64 totalSamplesInSource) override;
+    /** @internal */
+    void addBlock (int64 sampleNumberInSource, const AudioBuffer<float>& newData,
+                   int startOffsetInBuffer, int numSamples) override;
+
+private:
+    //==============================================================================
+    class Builder;
+    friend class Builder;
+
+    struct Level
+    {
+        int64 offsetInFile = 0, numValues = 0;
+        int64 samplesPerValue = 0;
+    };
+
+    File peakFile;
+    AudioFormatManager& formatManagerToUse;
+    TimeSliceThread& thread;
+    const int baseSamplesPerValue;
+
+    std::unique_ptr<MemoryMappedFile> mapping;
+    Array<Level> levels;
+    std::unique_ptr<Builder> builder;
+
+    int numChannels = 0;
+    double sampleRate = 0;
+    int64 totalSamples = 0, numSamplesFinished = 0, sourceHash = 0;
+
+    CriticalSection lock;
+
+    bool setDataSource (std::unique_ptr<InputSource>, AudioFormatReader*, int64 hash);
+    bool openExistingPeakFile (int64 expectedHash);
+    bool createPeakFile();
+    void computeLevelLayout();
+    bool mapPeakFile();
+    void storeHeader() const noexcept;
+    int8* getLevelData (int level) const noexcept;
+    void updateLevelsForRange (int64 startValue, int64 endValue);
+    void setFinishedSamples (int64 newNumSamplesFinished);
+    int chooseLevelFor (double samplesPerPixel) const noexcept;
+    void readMinMax (int level, int channelNum, int64 startValue, int64 endValue,
+                     int& minValue, int& maxValue) const noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MemoryMappedAudioThumbnail)
+};
+
+} // namespace juce
@@ -57,6 +57,8 @@
 #include "gui/juce_AudioDeviceSelectorComponent.cpp"
 #include "gui/juce_AudioThumbnail.cpp"
 #include "gui/juce_AudioThumbnailCache.cpp"
+#include "gui/juce_AudioThumbnailTileCache.cpp"
+#include "gui/juce_MemoryMappedAudioThumbnail.cpp"
 #include "gui/juce_AudioVisualiserComponent.cpp"
 #include "gui/juce_KeyboardComponentBase.cpp"
 #include "gui/juce_MidiKeyboardComponent.cpp"
@@ -79,6 +79,8 @@
 #include "gui/juce_AudioThumbnailBase.h"
 #include "gui/juce_AudioThumbnail.h"
 #include "gui/juce_AudioThumbnailCache.h"
+#include "gui/juce_AudioThumbnailTileCache.h"
+#include "gui/juce_MemoryMappedAudioThumbnail.h"
 #include "gui/juce_AudioVisualiserComponent.h"
 #include "gui/juce_KeyboardComponentBase.h"
 #include "gui/juce_MidiKeyboardComponent.h"
@@ -187,9 +187,14 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	float32 h = step.dt;
 
 	// Integrate velocities and apply damping. Initialize the body state.
+	// Note: the state arrays are always indexed through m_islandIndex rather
+	// than the island-local loop counter. Add() makes the two identical, but
+	// b2World::SolveIslandsParallel assigns indices itself so that static
+	// bodies shared by concurrently solved islands keep a stable index.
 	for (int32 i = 0; i < m_bodyCount; ++i)
 	{
 		b2Body* b = m_bodies[i];
+		int32 index = b->m_islandIndex;
 
 		b2Vec2 c = b->m_sweep.c;
 		float32 a = b->m_sweep.a;
@@ -217,10 +222,10 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 			w *= b2Clamp(1.0f - h * b->m_angularDamping, 0.0f, 1.0f);
 		}
 
-		m_positions[i].c = c;
-		m_positions[i].a = a;
-		m_velocities[i].v = v;
-		m_velocities[i].w = w;
+		m_positions[index].c = c;
+		m_positions[index].a = a;
+		m_velocities[index].v = v;
+		m_velocities[index].w = w;
 	}
 
 	timer.Reset();
@@ -274,10 +279,12 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	// Integrate positions
 	for (int32 i = 0; i < m_bodyCount; ++i)
 	{
-		b2Vec2 c = m_positions[i].c;
-		float32 a = m_positions[i].a;
-		b2Vec2 v = m_velocities[i].v;
-		float32 w = m_velocities[i].w;
+		int32 index = m_bodies[i]->m_islandIndex;
+
+		b2Vec2 c = m_positions[index].c;
+		float32 a = m_positions[index].a;
+		b2Vec2 v = m_velocities[index].v;
+		float32 w = m_velocities[index].w;
 
 		// Check for large velocities
 		b2Vec2 translation = h * v;
@@ -298,10 +305,10 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 		c += h * v;
 		a += h * w;
 
-		m_positions[i].c = c;
-		m_positions[i].a = a;
-		m_velocities[i].v = v;
-		m_velocities[i].w = w;
+		m_positions[index].c = c;
+		m_positions[index].a = a;
+		m_velocities[index].v = v;
+		m_velocities[index].w = w;
 	}
 
 	// Solve position constraints
@@ -330,10 +337,11 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	for (int32 i = 0; i < m_bodyCount; ++i)
 	{
 		b2Body* body = m_bodies[i];
-		body->m_sweep.c = m_positions[i].c;
-		body->m_sweep.a = m_positions[i].a;
-		body->m_linearVelocity = m_velocities[i].v;
-		body->m_angularVelocity = m_velocities[i].w;
+		int32 index = body->m_islandIndex;
+		body->m_sweep.c = m_positions[index].c;
+		body->m_sweep.a = m_positions[index].a;
+		body->m_linearVelocity = m_velocities[index].v;
+		body->m_angularVelocity = m_velocities[index].w;
 		body->SynchronizeTransform();
 	}
 
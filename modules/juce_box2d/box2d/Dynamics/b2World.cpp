@@ -32,12 +32,16 @@
 #include "../Collision/b2TimeOfImpact.h"
 #include "../Common/b2Draw.h"
 #include "../Common/b2Timer.h"
+#include <algorithm>
+#include <atomic>
+#include <map>
 #include <new>
 
 b2World::b2World(const b2Vec2& gravity)
 {
 	m_destructionListener = NULL;
 	m_debugDraw = NULL;
+	m_threadPool = NULL;
 
 	m_bodyList = NULL;
 	m_jointList = NULL;
@@ -104,6 +108,17 @@ void b2World::SetDebugDraw(b2Draw* debugDraw)
 	m_debugDraw = debugDraw;
 }
 
+void b2World::SetThreadPool(juce::ThreadPool* pool)
+{
+	b2Assert(IsLocked() == false);
+	m_threadPool = pool;
+}
+
+juce::ThreadPool* b2World::GetThreadPool() const
+{
+	return m_threadPool;
+}
+
 b2Body* b2World::CreateBody(const b2BodyDef* def)
 {
 	b2Assert(IsLocked() == false);
@@ -389,6 +404,43 @@ void b2World::Solve(const b2TimeStep& step)
 	m_profile.solveVelocity = 0.0f;
 	m_profile.solvePosition = 0.0f;
 
+	if (m_threadPool != NULL && m_threadPool->getNumThreads() > 0)
+	{
+		SolveIslandsParallel(step);
+	}
+	else
+	{
+		SolveIslands(step);
+	}
+
+	{
+		b2Timer timer;
+		// Synchronize fixtures, check for out of range bodies.
+		for (b2Body* b = m_bodyList; b; b = b->GetNext())
+		{
+			// If a body was not in an island then it did not move.
+			if ((b->m_flags & b2Body::e_islandFlag) == 0)
+			{
+				continue;
+			}
+
+			if (b->GetType() == b2_staticBody)
+			{
+				continue;
+			}
+
+			// Update fixtures (for broad-phase).
+			b->SynchronizeFixtures();
+		}
+
+		// Look for new contacts.
+		m_contactManager.FindNewContacts();
+		m_profile.broadphase = timer.GetMilliseconds();
+	}
+}
+
+void b2World::SolveIslands(const b2TimeStep& step)
+{
 	// Size the island for the worst case.
 	b2Island island(m_bodyCount,
 					m_contactManager.m_contactCount,
@@ -546,30 +598,336 @@ void b2World::Solve(const b2TimeStep& step)
 	}
 
 	m_stackAllocator.Free(stack);
+}
 
+// Parallel version of SolveIslands. The islands are built up front on the
+// calling thread and then handed out to the world's thread pool. Islands are
+// disjoint except for the static bodies they share, which are never written
+// to during the solve (their island state slots are assigned up front, and
+// the solver only stores their own unchanging position and zero velocity
+// back into them), so each island can be solved independently.
+void b2World::SolveIslandsParallel(const b2TimeStep& step)
+{
+	// Clear all the island flags, and mark every body as having no state
+	// index yet so that static bodies can be assigned a stable slot below.
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
 	{
-		b2Timer timer;
-		// Synchronize fixtures, check for out of range bodies.
-		for (b2Body* b = m_bodyList; b; b = b->GetNext())
+		b->m_flags &= ~b2Body::e_islandFlag;
+		b->m_islandIndex = -1;
+	}
+	for (b2Contact* c = m_contactManager.m_contactList; c; c = c->m_next)
+	{
+		c->m_flags &= ~b2Contact::e_islandFlag;
+	}
+	for (b2Joint* j = m_jointList; j; j = j->m_next)
+	{
+		j->m_islandFlag = false;
+	}
+
+	struct IslandRange
+	{
+		int32 firstBody, bodyCount;
+		int32 firstContact, contactCount;
+		int32 firstJoint, jointCount;
+		int32 dynamicBodyCount;
+	};
+
+	juce::Array<b2Body*> bodies;
+	juce::Array<b2Contact*> contacts;
+	juce::Array<b2Joint*> joints;
+	juce::Array<b2Body*> staticBodies;
+	juce::Array<IslandRange> islands;
+
+	bodies.ensureStorageAllocated(m_bodyCount);
+	contacts.ensureStorageAllocated(m_contactManager.m_contactCount);
+	joints.ensureStorageAllocated(m_jointCount);
+
+	int32 maxDynamicBodies = 0;
+
+	// Build all the islands, using the same depth first search (DFS) over the
+	// constraint graph as the serial solver.
+	int32 stackSize = m_bodyCount;
+	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
+	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
+	{
+		if (seed->m_flags & b2Body::e_islandFlag)
 		{
-			// If a body was not in an island then it did not move.
-			if ((b->m_flags & b2Body::e_islandFlag) == 0)
+			continue;
+		}
+
+		if (seed->IsAwake() == false || seed->IsActive() == false)
+		{
+			continue;
+		}
+
+		// The seed can be dynamic or kinematic.
+		if (seed->GetType() == b2_staticBody)
+		{
+			continue;
+		}
+
+		IslandRange range;
+		range.firstBody = bodies.size();
+		range.firstContact = contacts.size();
+		range.firstJoint = joints.size();
+		range.dynamicBodyCount = 0;
+
+		int32 stackCount = 0;
+		stack[stackCount++] = seed;
+		seed->m_flags |= b2Body::e_islandFlag;
+
+		while (stackCount > 0)
+		{
+			// Grab the next body off the stack and add it to the island.
+			b2Body* b = stack[--stackCount];
+			b2Assert(b->IsActive() == true);
+			bodies.add(b);
+
+			// Make sure the body is awake.
+			b->SetAwake(true);
+
+			// To keep islands as small as possible, we don't
+			// propagate islands across static bodies.
+			if (b->GetType() == b2_staticBody)
 			{
+				// A static body can be shared between islands that are solved
+				// concurrently, so instead of an island-local state index it
+				// gets a stable slot past the dynamic bodies of every island.
+				// The slot is rebased once the largest dynamic count is known.
+				if (b->m_islandIndex < 0)
+				{
+					b->m_islandIndex = staticBodies.size();
+					staticBodies.add(b);
+				}
+
 				continue;
 			}
 
+			b->m_islandIndex = range.dynamicBodyCount++;
+
+			// Search all contacts connected to this body.
+			for (b2ContactEdge* ce = b->m_contactList; ce; ce = ce->next)
+			{
+				b2Contact* contact = ce->contact;
+
+				// Has this contact already been added to an island?
+				if (contact->m_flags & b2Contact::e_islandFlag)
+				{
+					continue;
+				}
+
+				// Is this contact solid and touching?
+				if (contact->IsEnabled() == false ||
+					contact->IsTouching() == false)
+				{
+					continue;
+				}
+
+				// Skip sensors.
+				bool sensorA = contact->m_fixtureA->m_isSensor;
+				bool sensorB = contact->m_fixtureB->m_isSensor;
+				if (sensorA || sensorB)
+				{
+					continue;
+				}
+
+				contacts.add(contact);
+				contact->m_flags |= b2Contact::e_islandFlag;
+
+				b2Body* other = ce->other;
+
+				// Was the other body already added to this island?
+				if (other->m_flags & b2Body::e_islandFlag)
+				{
+					continue;
+				}
+
+				b2Assert(stackCount < stackSize);
+				stack[stackCount++] = other;
+				other->m_flags |= b2Body::e_islandFlag;
+			}
+
+			// Search all joints connect to this body.
+			for (b2JointEdge* je = b->m_jointList; je; je = je->next)
+			{
+				if (je->joint->m_islandFlag == true)
+				{
+					continue;
+				}
+
+				b2Body* other = je->other;
+
+				// Don't simulate joints connected to inactive bodies.
+				if (other->IsActive() == false)
+				{
+					continue;
+				}
+
+				joints.add(je->joint);
+				je->joint->m_islandFlag = true;
+
+				if (other->m_flags & b2Body::e_islandFlag)
+				{
+					continue;
+				}
+
+				b2Assert(stackCount < stackSize);
+				stack[stackCount++] = other;
+				other->m_flags |= b2Body::e_islandFlag;
+			}
+		}
+
+		range.bodyCount = bodies.size() - range.firstBody;
+		range.contactCount = contacts.size() - range.firstContact;
+		range.jointCount = joints.size() - range.firstJoint;
+		maxDynamicBodies = b2Max(maxDynamicBodies, range.dynamicBodyCount);
+		islands.add(range);
+
+		// Post solve cleanup.
+		for (int32 i = range.firstBody; i < bodies.size(); ++i)
+		{
+			// Allow static bodies to participate in other islands.
+			b2Body* b = bodies.getUnchecked(i);
 			if (b->GetType() == b2_staticBody)
 			{
-				continue;
+				b->m_flags &= ~b2Body::e_islandFlag;
 			}
+		}
+	}
 
-			// Update fixtures (for broad-phase).
-			b->SynchronizeFixtures();
+	m_stackAllocator.Free(stack);
+
+	if (islands.size() == 0)
+	{
+		return;
+	}
+
+	// Now the largest dynamic count is known, move the static bodies' slots
+	// past the end of every island's dynamic bodies. No index is written
+	// again until the parallel phase has finished, so concurrently solved
+	// islands all read consistent values.
+	for (int32 i = 0; i < staticBodies.size(); ++i)
+	{
+		staticBodies.getUnchecked(i)->m_islandIndex += maxDynamicBodies;
+	}
+
+	const int32 bodyCapacity = maxDynamicBodies + staticBodies.size();
+
+	// Hand out the biggest islands first, so that the end of the batch isn't
+	// left waiting on one large island picked up late.
+	juce::Array<int32> order;
+	order.ensureStorageAllocated(islands.size());
+	for (int32 i = 0; i < islands.size(); ++i)
+	{
+		order.add(i);
+	}
+	std::sort(order.begin(), order.end(), [&](int32 a, int32 b)
+	{
+		return islands.getReference(a).bodyCount > islands.getReference(b).bodyCount;
+	});
+
+	// PostSolve callbacks must not run concurrently, so each island records
+	// its impulse reports and they are replayed on this thread afterwards.
+	struct RecordedImpulse
+	{
+		b2Contact* contact;
+		b2ContactImpulse impulse;
+	};
+
+	struct ImpulseRecorder : public b2ContactListener
+	{
+		virtual void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse)
+		{
+			RecordedImpulse recordedImpulse;
+			recordedImpulse.contact = contact;
+			recordedImpulse.impulse = *impulse;
+			recorded.add(recordedImpulse);
 		}
 
-		// Look for new contacts.
-		m_contactManager.FindNewContacts();
-		m_profile.broadphase = timer.GetMilliseconds();
+		juce::Array<RecordedImpulse> recorded;
+	};
+
+	b2ContactListener* userListener = m_contactManager.m_contactListener;
+	juce::OwnedArray<ImpulseRecorder> recorders;
+	if (userListener != NULL)
+	{
+		for (int32 i = 0; i < islands.size(); ++i)
+		{
+			recorders.add(new ImpulseRecorder());
+		}
+	}
+
+	std::atomic<int32> nextIsland { 0 };
+	std::atomic<int32> activeWorkers { 0 };
+	juce::WaitableEvent allWorkersDone;
+	juce::CriticalSection profileLock;
+
+	auto solveIslands = [&]()
+	{
+		// Each worker gets its own stack allocator: the solver's scratch
+		// allocations must not be shared between threads.
+		b2StackAllocator workerAllocator;
+
+		for (;;)
+		{
+			const int32 n = nextIsland.fetch_add(1);
+			if (n >= islands.size())
+			{
+				break;
+			}
+
+			const int32 islandIndex = order.getUnchecked(n);
+			const IslandRange& range = islands.getReference(islandIndex);
+
+			b2Island island(bodyCapacity, range.contactCount, range.jointCount, &workerAllocator,
+							userListener != NULL ? recorders.getUnchecked(islandIndex) : NULL);
+
+			island.m_bodyCount = range.bodyCount;
+			island.m_contactCount = range.contactCount;
+			island.m_jointCount = range.jointCount;
+			memcpy(island.m_bodies, bodies.begin() + range.firstBody, range.bodyCount * sizeof(b2Body*));
+			memcpy(island.m_contacts, contacts.begin() + range.firstContact, range.contactCount * sizeof(b2Contact*));
+			memcpy(island.m_joints, joints.begin() + range.firstJoint, range.jointCount * sizeof(b2Joint*));
+
+			b2Profile profile;
+			island.Solve(&profile, step, m_gravity, m_allowSleep);
+
+			const juce::ScopedLock sl(profileLock);
+			m_profile.solveInit += profile.solveInit;
+			m_profile.solveVelocity += profile.solveVelocity;
+			m_profile.solvePosition += profile.solvePosition;
+		}
+
+		if (--activeWorkers == 0)
+		{
+			allWorkersDone.signal();
+		}
+	};
+
+	// The calling thread works through the islands alongside the pool.
+	const int32 numWorkers = b2Min(islands.size(), m_threadPool->getNumThreads() + 1);
+	activeWorkers = numWorkers;
+
+	for (int32 i = 1; i < numWorkers; ++i)
+	{
+		m_threadPool->addJob(solveIslands);
+	}
+
+	solveIslands();
+	allWorkersDone.wait();
+
+	// Replay the recorded PostSolve reports, in island order.
+	if (userListener != NULL)
+	{
+		for (int32 i = 0; i < recorders.size(); ++i)
+		{
+			const ImpulseRecorder* recorder = recorders.getUnchecked(i);
+			for (int32 j = 0; j < recorder->recorded.size(); ++j)
+			{
+				const RecordedImpulse& recordedImpulse = recorder->recorded.getReference(j);
+				userListener->PostSolve(recordedImpulse.contact, &recordedImpulse.impulse);
+			}
+		}
 	}
 }
 
@@ -962,6 +1320,136 @@ void b2World::Step(float32 dt, int32 velocityIterations, int32 positionIteration
 	m_profile.step = stepTimer.GetMilliseconds();
 }
 
+// Stands in for the user's contact listener during b2World::StepMultiple.
+// PreSolve/PostSolve are passed straight through, while begin/end events are
+// recorded for coalescing. Only the fixture pointers are kept: a contact that
+// ends because its fixtures stop overlapping is destroyed during the step,
+// but fixtures can't be destroyed while the world is locked.
+class b2ContactEventCoalescer : public b2ContactListener
+{
+public:
+	b2ContactEventCoalescer(b2ContactListener* userListener) : m_userListener(userListener)
+	{
+	}
+
+	virtual void BeginContact(b2Contact* contact)
+	{
+		Record(contact, true);
+	}
+
+	virtual void EndContact(b2Contact* contact)
+	{
+		Record(contact, false);
+	}
+
+	virtual void PreSolve(b2Contact* contact, const b2Manifold* oldManifold)
+	{
+		if (m_userListener)
+		{
+			m_userListener->PreSolve(contact, oldManifold);
+		}
+	}
+
+	virtual void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse)
+	{
+		if (m_userListener)
+		{
+			m_userListener->PostSolve(contact, impulse);
+		}
+	}
+
+	void Deliver(b2BatchedContactListener* batchListener)
+	{
+		// Net out each pair's begins against its ends, keeping the events in
+		// the order in which each pair first changed state.
+		std::map<std::pair<b2Fixture*, b2Fixture*>, int32> pairIndices;
+		juce::Array<b2ContactPairEvent> events;
+		juce::Array<int32> netCounts;
+
+		for (int32 i = 0; i < m_recorded.size(); ++i)
+		{
+			const b2ContactPairEvent& e = m_recorded.getReference(i);
+			std::pair<b2Fixture*, b2Fixture*> key(e.fixtureA, e.fixtureB);
+
+			std::map<std::pair<b2Fixture*, b2Fixture*>, int32>::iterator it = pairIndices.find(key);
+			if (it == pairIndices.end())
+			{
+				pairIndices[key] = events.size();
+				events.add(e);
+				netCounts.add(e.begun ? 1 : -1);
+			}
+			else
+			{
+				netCounts.getReference(it->second) += e.begun ? 1 : -1;
+			}
+		}
+
+		juce::Array<b2ContactPairEvent> survivors;
+		for (int32 i = 0; i < events.size(); ++i)
+		{
+			const int32 net = netCounts.getUnchecked(i);
+			if (net != 0)
+			{
+				b2ContactPairEvent e = events.getUnchecked(i);
+				e.begun = net > 0;
+				survivors.add(e);
+			}
+		}
+
+		batchListener->ContactEvents(survivors.begin(), survivors.size());
+	}
+
+private:
+	void Record(b2Contact* contact, bool begun)
+	{
+		b2ContactPairEvent e;
+		e.fixtureA = contact->GetFixtureA();
+		e.fixtureB = contact->GetFixtureB();
+		e.begun = begun;
+		m_recorded.add(e);
+	}
+
+	b2ContactListener* m_userListener;
+	juce::Array<b2ContactPairEvent> m_recorded;
+};
+
+void b2World::StepMultiple(float32 subStepTime, int32 velocityIterations, int32 positionIterations,
+						   int32 subStepCount, b2BatchedContactListener* batchListener)
+{
+	b2Assert(IsLocked() == false);
+	if (IsLocked() || subStepCount <= 0)
+	{
+		return;
+	}
+
+	b2ContactListener* userListener = m_contactManager.m_contactListener;
+	b2ContactEventCoalescer coalescer(userListener);
+	m_contactManager.m_contactListener = &coalescer;
+
+	// Applied forces act for the whole batch, so they are cleared once at the
+	// end rather than after every sub-step.
+	bool autoClearForces = GetAutoClearForces();
+	SetAutoClearForces(false);
+
+	for (int32 i = 0; i < subStepCount; ++i)
+	{
+		Step(subStepTime, velocityIterations, positionIterations);
+	}
+
+	SetAutoClearForces(autoClearForces);
+	if (autoClearForces)
+	{
+		ClearForces();
+	}
+
+	m_contactManager.m_contactListener = userListener;
+
+	if (batchListener)
+	{
+		coalescer.Deliver(batchListener);
+	}
+}
+
 void b2World::ClearForces()
 {
 	for (b2Body* body = m_bodyList; body; body = body->GetNext())
@@ -35,6 +35,8 @@ class b2Draw;
 class b2Fixture;
 class b2Joint;
 
+namespace juce { class ThreadPool; }
+
 /// The world class manages all physics entities, dynamic simulation,
 /// and asynchronous queries. The world also contains efficient memory
 /// management facilities.
@@ -66,6 +68,18 @@ public:
 	/// by you and must remain in scope.
 	void SetDebugDraw(b2Draw* debugDraw);
 
+	/// Give the world a thread pool for solving constraint islands in parallel.
+	/// Islands are independent, so each time step farms them out to the pool
+	/// while also solving on the calling thread. All listener callbacks are
+	/// still made from the thread that called Step. The pool is owned by you
+	/// and must remain in scope; avoid sharing it with long-running jobs, as a
+	/// time step cannot complete until all of its islands have been solved.
+	/// Pass NULL to return to single-threaded solving.
+	void SetThreadPool(juce::ThreadPool* pool);
+
+	/// Get the thread pool used for parallel island solving, or NULL.
+	juce::ThreadPool* GetThreadPool() const;
+
 	/// Create a rigid body given a definition. No reference to the definition
 	/// is retained.
 	/// @warning This function is locked during callbacks.
@@ -95,6 +109,25 @@ public:
 				juce::int32 velocityIterations,
 				juce::int32 positionIterations);
 
+	/// Take several fixed-size time steps in one call. This runs the same
+	/// simulation as calling Step in a loop, but begin/end contact events are
+	/// coalesced across the whole batch: pairs that both begin and end within
+	/// the batch are dropped, and the survivors are delivered to the given
+	/// listener in a single callback after the last sub-step. PreSolve and
+	/// PostSolve still fire per sub-step through the normal contact listener.
+	/// Forces are cleared once after the last sub-step rather than between
+	/// sub-steps, so applied forces act for the whole batch.
+	/// @param subStepTime the fixed duration of each sub-step.
+	/// @param velocityIterations for the velocity constraint solver.
+	/// @param positionIterations for the position constraint solver.
+	/// @param subStepCount the number of sub-steps to take.
+	/// @param batchListener receives the coalesced contact events. May be NULL.
+	void StepMultiple(	float32 subStepTime,
+						juce::int32 velocityIterations,
+						juce::int32 positionIterations,
+						juce::int32 subStepCount,
+						b2BatchedContactListener* batchListener = NULL);
+
 	/// Manually clear the force buffer on all bodies. By default, forces are cleared automatically
 	/// after each call to Step. The default behavior is modified by calling SetAutoClearForces.
 	/// The purpose of this function is to support sub-stepping. Sub-stepping is often used to maintain
@@ -220,6 +253,8 @@ private:
 	friend class b2Controller;
 
 	void Solve(const b2TimeStep& step);
+	void SolveIslands(const b2TimeStep& step);
+	void SolveIslandsParallel(const b2TimeStep& step);
 	void SolveTOI(const b2TimeStep& step);
 
 	void DrawJoint(b2Joint* joint);
@@ -244,6 +279,8 @@ private:
 	b2DestructionListener* m_destructionListener;
 	b2Draw* m_debugDraw;
 
+	juce::ThreadPool* m_threadPool;
+
 	// This is used to compute the time step ratio to
 	// support a variable time step.
 	float32 m_inv_dt0;
@@ -118,6 +118,31 @@ public:
 	}
 };
 
+/// A coalesced begin/end contact event, as reported by b2World::StepMultiple.
+/// When begun is true the fixtures started touching during the batch and were
+/// still touching at the end of it; when false they stopped touching. Pairs
+/// that both began and ended within the batch are not reported at all.
+struct b2ContactPairEvent
+{
+	b2Fixture* fixtureA;
+	b2Fixture* fixtureB;
+	bool begun;
+};
+
+/// Implement this class to receive the coalesced contact events produced by
+/// b2World::StepMultiple. Unlike b2ContactListener, the callback is made only
+/// once per batch, after the last sub-step has completed, so it is safe to
+/// create and destroy Box2D entities from inside it.
+class b2BatchedContactListener
+{
+public:
+	virtual ~b2BatchedContactListener() {}
+
+	/// Called once at the end of a batch with the surviving begin/end events,
+	/// in the order in which each pair first changed state.
+	virtual void ContactEvents(const b2ContactPairEvent* events, juce::int32 count) = 0;
+};
+
 /// Callback class for AABB queries.
 /// See b2World::Query
 class b2QueryCallback
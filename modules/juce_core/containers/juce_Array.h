@@ -45,13 +45,18 @@ namespace juce
     To make all the array's methods thread-safe, pass in "CriticalSection" as the templated
     TypeOfCriticalSectionToUse parameter, instead of the default DummyCriticalSection.
 
-    @see OwnedArray, ReferenceCountedArray, StringArray, CriticalSection
+    The AllocatorType parameter controls where the array's storage comes from: the default
+    uses the heap, but you can pass ArenaArrayAllocator to keep the storage in a block of
+    caller-provided memory, which is useful on real-time threads.
+
+    @see OwnedArray, ReferenceCountedArray, StringArray, CriticalSection, ArenaArrayAllocator
 
     @tags{Core}
 */
 template <typename ElementType,
           typename TypeOfCriticalSectionToUse = DummyCriticalSection,
-          int minimumAllocatedSize = 0>
+          int minimumAllocatedSize = 0,
+          typename AllocatorType = HeapArrayAllocator>
 class Array
 {
 private:
@@ -62,6 +67,14 @@ public:
     /** Creates an empty array. */
     Array() = default;
 
+    /** Creates an empty array whose storage will come from the given allocator.
+        @see ArenaArrayAllocator
+    */
+    explicit Array (AllocatorType allocatorToUse) noexcept
+        : values (std::move (allocatorToUse))
+    {
+    }
+
     /** Creates a copy of another array.
         @param other    the array to copy
     */
@@ -1132,7 +1145,7 @@ public:
 
 private:
     //==============================================================================
-    ArrayBase<ElementType, TypeOfCriticalSectionToUse> values;
+    ArrayBase<ElementType, TypeOfCriticalSectionToUse, AllocatorType> values;
 
     void removeInternal (int indexToRemove)
     {
@@ -537,6 +537,115 @@ public:
             expectEquals (derived.size(), 0);
             expect (derived.data() == nullptr);
         }
+
+        beginTest ("Arena-backed storage lives in caller-provided memory");
+        {
+            alignas (std::max_align_t) char storage[4096];
+            ArrayArena arena (storage, sizeof (storage));
+
+            ArrayBase<CopyableType, DummyCriticalSection, ArenaArrayAllocator> container { ArenaArrayAllocator (arena) };
+
+            for (int i = 0; i < 50; ++i)
+                container.add ({ i });
+
+            expect (arena.contains (container.data()));
+            expect (arena.getNumBytesUsed() >= 50 * sizeof (CopyableType));
+
+            for (int i = 0; i < 50; ++i)
+                expectEquals (container[i].getValue(), i);
+
+            ArrayBase<CopyableType, DummyCriticalSection, ArenaArrayAllocator> movedTo { std::move (container) };
+
+            expect (arena.contains (movedTo.data()));
+            expectEquals (movedTo.size(), 50);
+            expectEquals (movedTo[49].getValue(), 49);
+            expect (container.data() == nullptr);
+            expectEquals (container.size(), 0);
+        }
+
+        beginTest ("Arena allocator relocates non-trivial elements on growth");
+        {
+            alignas (std::max_align_t) char storage[8192];
+            ArrayArena arena (storage, sizeof (storage));
+
+            ArrayBase<NoncopyableType, DummyCriticalSection, ArenaArrayAllocator> container { ArenaArrayAllocator (arena) };
+
+            for (int i = 0; i < 40; ++i)
+                container.add ({ i });
+
+            expect (arena.contains (container.data()));
+
+            for (int i = 0; i < 40; ++i)
+                expectEquals (container[i].getValue(), i);
+        }
+
+        beginTest ("Arena-backed arrays never shrink");
+        {
+            alignas (std::max_align_t) char storage[4096];
+            ArrayArena arena (storage, sizeof (storage));
+
+            ArrayBase<CopyableType, DummyCriticalSection, ArenaArrayAllocator> container { ArenaArrayAllocator (arena) };
+
+            for (int i = 0; i < 64; ++i)
+                container.add ({ i });
+
+            auto capacityBeforeShrinking = container.capacity();
+            expect (capacityBeforeShrinking >= 64);
+
+            container.removeElements (0, 64);
+            container.shrinkToNoMoreThan (0);
+
+            expectEquals (container.capacity(), capacityBeforeShrinking);
+
+            // growing back up to the old capacity shouldn't take more arena space
+            auto arenaBytesUsed = arena.getNumBytesUsed();
+
+            for (int i = 0; i < 64; ++i)
+                container.add ({ i });
+
+            expectEquals ((int) arena.getNumBytesUsed(), (int) arenaBytesUsed);
+        }
+
+        beginTest ("Arena allocator capacities grow geometrically");
+        {
+            expectEquals (ArenaArrayAllocator::getGrownCapacity (1,   0),  8);
+            expectEquals (ArenaArrayAllocator::getGrownCapacity (9,   8),  16);
+            expectEquals (ArenaArrayAllocator::getGrownCapacity (17,  16), 32);
+            expectEquals (ArenaArrayAllocator::getGrownCapacity (100, 32), 100);
+        }
+
+        beginTest ("A default-constructed arena allocator uses the heap");
+        {
+            ArrayBase<NoncopyableType, DummyCriticalSection, ArenaArrayAllocator> container;
+
+            for (int i = 0; i < 50; ++i)
+                container.add ({ i });
+
+            for (int i = 0; i < 50; ++i)
+                expectEquals (container[i].getValue(), i);
+        }
+
+        beginTest ("An arena can be reused after resetting it");
+        {
+            alignas (std::max_align_t) char storage[1024];
+            ArrayArena arena (storage, sizeof (storage));
+
+            {
+                ArrayBase<CopyableType, DummyCriticalSection, ArenaArrayAllocator> container { ArenaArrayAllocator (arena) };
+                container.add ({ 1 });
+            }
+
+            expect (arena.getNumBytesUsed() > 0);
+
+            arena.reset();
+            expectEquals ((int) arena.getNumBytesUsed(), 0);
+
+            ArrayBase<CopyableType, DummyCriticalSection, ArenaArrayAllocator> container { ArenaArrayAllocator (arena) };
+            container.add ({ 2 });
+
+            expect ((const void*) container.data() == (const void*) storage);
+            expectEquals (container[0].getValue(), 2);
+        }
     }
 
 private:
@@ -23,43 +23,259 @@
 namespace juce
 {
 
+//==============================================================================
+/**
+    The default storage policy for ArrayBase and the array classes built on it.
+
+    This allocates from the heap, growing roughly geometrically (by about 1.5x,
+    rounded up to a multiple of 8 elements) and allowing the capacity to shrink
+    again when asked to.
+
+    A replacement policy must provide the same members: see ArenaArrayAllocator
+    for an example that puts the array's storage into caller-provided memory.
+
+    @see ArrayBase, ArenaArrayAllocator
+
+    @tags{Core}
+*/
+struct HeapArrayAllocator
+{
+    /** When this is true, requests to reduce an array's capacity are ignored,
+        so storage only ever grows (until the array itself is destroyed).
+    */
+    static constexpr bool neverShrinks = false;
+
+    /** Returns the capacity to allocate when a container holding currentCapacity
+        elements needs room for at least minNumElements.
+    */
+    static int getGrownCapacity (int minNumElements, int currentCapacity) noexcept
+    {
+        ignoreUnused (currentCapacity);
+        return (minNumElements + minNumElements / 2 + 8) & ~7;
+    }
+
+    /** Allocates a block of at least numBytes bytes. */
+    static void* allocate (size_t numBytes)                                        { return std::malloc (numBytes); }
+
+    /** Grows or shrinks a block previously returned by allocate or reallocate,
+        preserving the first jmin (oldNumBytes, newNumBytes) bytes of its contents.
+    */
+    static void* reallocate (void* data, size_t oldNumBytes, size_t newNumBytes)   { ignoreUnused (oldNumBytes); return std::realloc (data, newNumBytes); }
+
+    /** Frees a block previously returned by allocate or reallocate. */
+    static void deallocate (void* data) noexcept                                   { std::free (data); }
+};
+
+//==============================================================================
+/**
+    A caller-owned bump allocator which hands out chunks of a fixed block of
+    memory, for use with ArenaArrayAllocator.
+
+    Allocations are never returned individually - the whole arena is reclaimed
+    at once with reset(), once nothing is pointing into it any more. This makes
+    allocation a pointer increment, which is cheap enough for real-time threads
+    when the backing memory has been committed up-front.
+
+    @see ArenaArrayAllocator
+
+    @tags{Core}
+*/
+class ArrayArena
+{
+public:
+    /** Creates an arena that allocates from the given block of memory.
+        The caller must keep the memory alive for the lifetime of the arena.
+    */
+    ArrayArena (void* memoryToUse, size_t numBytes) noexcept
+        : buffer (static_cast<char*> (memoryToUse)), totalSize (numBytes)
+    {
+    }
+
+    /** Returns a suitably-aligned block of numBytes bytes, or nullptr if the
+        arena doesn't have enough space left.
+    */
+    void* allocate (size_t numBytes, size_t alignment) noexcept
+    {
+        auto* current = buffer + position;
+        auto* aligned = snapPointerToAlignment (current, alignment);
+        auto newPosition = position + (size_t) (aligned - current) + numBytes;
+
+        if (newPosition > totalSize)
+            return nullptr;
+
+        position = newPosition;
+        return aligned;
+    }
+
+    /** Returns true if the given pointer points into this arena's memory. */
+    bool contains (const void* data) const noexcept
+    {
+        return data >= buffer && data < buffer + totalSize;
+    }
+
+    /** Makes the arena's whole block available for allocation again.
+        Obviously anything still pointing into the arena becomes invalid!
+    */
+    void reset() noexcept                           { position = 0; }
+
+    /** Returns the number of bytes that have been handed out so far. */
+    size_t getNumBytesUsed() const noexcept         { return position; }
+
+    /** Returns the total size of the memory block passed to the constructor. */
+    size_t getTotalSize() const noexcept            { return totalSize; }
+
+private:
+    char* buffer;
+    size_t totalSize, position = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (ArrayArena)
+};
+
+//==============================================================================
+/**
+    An ArrayBase storage policy which allocates from a caller-owned ArrayArena,
+    so framework containers can live in pre-committed memory on real-time
+    threads.
+
+    Capacity grows by doubling and never shrinks, and superseded blocks are
+    simply abandoned inside the arena (they're reclaimed wholesale when the
+    arena is reset), so growth never calls the system allocator while the arena
+    has space. If the arena runs out - or if the allocator was default
+    constructed without one - it falls back to the heap, asserting so that
+    misjudged arena sizes get noticed during development.
+
+    @code
+    alignas (std::max_align_t) char storage[16384];
+    ArrayArena arena (storage, sizeof (storage));
+
+    Array<MyEvent, DummyCriticalSection, 0, ArenaArrayAllocator> events { ArenaArrayAllocator (arena) };
+    @endcode
+
+    @see ArrayArena, HeapArrayAllocator, ArrayBase
+
+    @tags{Core}
+*/
+class ArenaArrayAllocator
+{
+public:
+    /** Creates an allocator with no arena, which just uses the heap. */
+    ArenaArrayAllocator() = default;
+
+    /** Creates an allocator which will allocate from the given arena.
+        The arena must outlive any containers using this allocator.
+    */
+    explicit ArenaArrayAllocator (ArrayArena& arenaToUse,
+                                  size_t alignmentToUse = alignof (std::max_align_t)) noexcept
+        : arena (&arenaToUse), alignment (alignmentToUse)
+    {
+    }
+
+    static constexpr bool neverShrinks = true;
+
+    static int getGrownCapacity (int minNumElements, int currentCapacity) noexcept
+    {
+        return jmax (minNumElements, currentCapacity * 2, 8);
+    }
+
+    void* allocate (size_t numBytes)
+    {
+        if (arena != nullptr)
+        {
+            if (auto* data = arena->allocate (numBytes, alignment))
+                return data;
+
+            // The arena is full! The container will carry on working from the
+            // heap, but an arena that's too small for its workload defeats the
+            // point of using one.
+            jassertfalse;
+        }
+
+        return std::malloc (numBytes);
+    }
+
+    void* reallocate (void* data, size_t oldNumBytes, size_t newNumBytes)
+    {
+        if (data == nullptr)
+            return allocate (newNumBytes);
+
+        if (arena != nullptr && arena->contains (data))
+        {
+            // The old block is abandoned inside the arena until it's reset.
+            auto* newData = allocate (newNumBytes);
+            memcpy (newData, data, jmin (oldNumBytes, newNumBytes));
+            return newData;
+        }
+
+        return std::realloc (data, newNumBytes);
+    }
+
+    void deallocate (void* data) noexcept
+    {
+        if (data != nullptr && ! (arena != nullptr && arena->contains (data)))
+            std::free (data);
+    }
+
+private:
+    ArrayArena* arena = nullptr;
+    size_t alignment = alignof (std::max_align_t);
+};
+
+//==============================================================================
 /**
     A basic object container.
 
     This class isn't really for public use - it's used by the other
     array classes, but might come in handy for some purposes.
 
-    It inherits from a critical section class to allow the arrays to use
-    the "empty base class optimisation" pattern to reduce their footprint.
+    It inherits from a critical section class (and privately from its allocator
+    policy) to allow the arrays to use the "empty base class optimisation"
+    pattern to reduce their footprint.
 
-    @see Array, OwnedArray, ReferenceCountedArray
+    The AllocatorType template parameter decides where the array's storage comes
+    from and how its capacity grows - the default just uses the heap, but
+    ArenaArrayAllocator lets containers live in caller-provided memory.
+
+    @see Array, OwnedArray, ReferenceCountedArray, HeapArrayAllocator, ArenaArrayAllocator
 
     @tags{Core}
 */
-template <class ElementType, class TypeOfCriticalSectionToUse>
-class ArrayBase  : public TypeOfCriticalSectionToUse
+template <class ElementType, class TypeOfCriticalSectionToUse, class AllocatorType = HeapArrayAllocator>
+class ArrayBase  : public TypeOfCriticalSectionToUse,
+                   private AllocatorType
 {
 private:
     using ParameterType = typename TypeHelpers::ParameterType<ElementType>::type;
 
     template <class OtherElementType, class OtherCriticalSection>
     using AllowConversion = typename std::enable_if<! std::is_same<std::tuple<ElementType, TypeOfCriticalSectionToUse>,
-                                                                   std::tuple<OtherElementType, OtherCriticalSection>>::value>::type;
+                                                                   std::tuple<OtherElementType, OtherCriticalSection>>::value
+                                                    && (std::is_same<ElementType, OtherElementType>::value
+                                                        || std::is_base_of<typename std::remove_pointer<ElementType>::type,
+                                                                           typename std::remove_pointer<OtherElementType>::type>::value)>::type;
 
 public:
     //==============================================================================
     ArrayBase() = default;
 
+    /** Creates an array whose storage will come from the given allocator. */
+    explicit ArrayBase (AllocatorType allocatorToUse) noexcept
+        : AllocatorType (std::move (allocatorToUse))
+    {
+    }
+
     ~ArrayBase()
     {
         clear();
+        getAllocator().deallocate (elements);
     }
 
     ArrayBase (ArrayBase&& other) noexcept
-        : elements (std::move (other.elements)),
+        : AllocatorType (std::move (static_cast<AllocatorType&> (other))),
+          elements (other.elements),
           numAllocated (other.numAllocated),
           numUsed (other.numUsed)
     {
+        other.elements = nullptr;
         other.numAllocated = 0;
         other.numUsed = 0;
     }
@@ -76,37 +292,42 @@ public:
     }
 
     /** Converting move constructor.
-        Only enabled when the other array has a different type to this one.
-        If you see a compile error here, it's probably because you're attempting a conversion that
-        HeapBlock won't allow.
+        Only enabled when the other array has a different type to this one, and the
+        conversion would have been allowed between HeapBlocks of those element types.
     */
     template <class OtherElementType,
               class OtherCriticalSection,
               typename = AllowConversion<OtherElementType, OtherCriticalSection>>
-    ArrayBase (ArrayBase<OtherElementType, OtherCriticalSection>&& other) noexcept
-        : elements (std::move (other.elements)),
+    ArrayBase (ArrayBase<OtherElementType, OtherCriticalSection, AllocatorType>&& other) noexcept
+        : AllocatorType (std::move (static_cast<AllocatorType&> (other))),
+          elements (reinterpret_cast<ElementType*> (other.elements)),
           numAllocated (other.numAllocated),
           numUsed (other.numUsed)
     {
+        other.elements = nullptr;
         other.numAllocated = 0;
         other.numUsed = 0;
     }
 
     /** Converting move assignment operator.
-        Only enabled when the other array has a different type to this one.
-        If you see a compile error here, it's probably because you're attempting a conversion that
-        HeapBlock won't allow.
+        Only enabled when the other array has a different type to this one, and the
+        conversion would have been allowed between HeapBlocks of those element types.
     */
     template <class OtherElementType,
               class OtherCriticalSection,
               typename = AllowConversion<OtherElementType, OtherCriticalSection>>
-    ArrayBase& operator= (ArrayBase<OtherElementType, OtherCriticalSection>&& other) noexcept
+    ArrayBase& operator= (ArrayBase<OtherElementType, OtherCriticalSection, AllocatorType>&& other) noexcept
     {
         // No need to worry about assignment to *this, because 'other' must be of a different type.
-        elements = std::move (other.elements);
+        clear();
+        getAllocator().deallocate (elements);
+
+        getAllocator() = std::move (static_cast<AllocatorType&> (other));
+        elements = reinterpret_cast<ElementType*> (other.elements);
         numAllocated = other.numAllocated;
         numUsed = other.numUsed;
 
+        other.elements = nullptr;
         other.numAllocated = 0;
         other.numUsed = 0;
 
@@ -206,6 +427,17 @@ public:
         return numAllocated;
     }
 
+    /** Returns the allocator policy object which provides this array's storage. */
+    AllocatorType& getAllocator() noexcept
+    {
+        return *this;
+    }
+
+    const AllocatorType& getAllocator() const noexcept
+    {
+        return *this;
+    }
+
     //==============================================================================
     void setAllocatedSize (int numElements)
     {
@@ -214,9 +446,14 @@ public:
         if (numAllocated != numElements)
         {
             if (numElements > 0)
+            {
                 setAllocatedSizeInternal (numElements);
+            }
             else
-                elements.free();
+            {
+                getAllocator().deallocate (elements);
+                elements = nullptr;
+            }
         }
 
         numAllocated = numElements;
@@ -225,13 +462,16 @@ public:
     void ensureAllocatedSize (int minNumElements)
     {
         if (minNumElements > numAllocated)
-            setAllocatedSize ((minNumElements + minNumElements / 2 + 8) & ~7);
+            setAllocatedSize (AllocatorType::getGrownCapacity (minNumElements, numAllocated));
 
         jassert (numAllocated <= 0 || elements != nullptr);
     }
 
     void shrinkToNoMoreThan (int maxNumElements)
     {
+        if (AllocatorType::neverShrinks)
+            return;
+
         if (maxNumElements < numAllocated)
             setAllocatedSize (maxNumElements);
     }
@@ -247,7 +487,8 @@ public:
     //==============================================================================
     void swapWith (ArrayBase& other) noexcept
     {
-        elements.swapWith (other.elements);
+        std::swap (getAllocator(), other.getAllocator());
+        std::swap (elements,     other.elements);
         std::swap (numAllocated, other.numAllocated);
         std::swap (numUsed,      other.numUsed);
     }
@@ -428,13 +669,15 @@ private:
     template <typename T = ElementType>
     TriviallyCopyableVoid<T> setAllocatedSizeInternal (int numElements)
     {
-        elements.realloc ((size_t) numElements);
+        elements = static_cast<ElementType*> (getAllocator().reallocate (elements,
+                                                                         (size_t) numAllocated * sizeof (ElementType),
+                                                                         (size_t) numElements  * sizeof (ElementType)));
     }
 
     template <typename T = ElementType>
     NonTriviallyCopyableVoid<T> setAllocatedSizeInternal (int numElements)
     {
-        HeapBlock<ElementType> newElements (numElements);
+        auto* newElements = static_cast<ElementType*> (getAllocator().allocate ((size_t) numElements * sizeof (ElementType)));
 
         for (int i = 0; i < numUsed; ++i)
         {
@@ -442,7 +685,8 @@ private:
             elements[i].~ElementType();
         }
 
-        elements = std::move (newElements);
+        getAllocator().deallocate (elements);
+        elements = newElements;
     }
 
     //==============================================================================
@@ -595,10 +839,10 @@ private:
     }
 
     //==============================================================================
-    HeapBlock<ElementType> elements;
+    ElementType* elements = nullptr;
     int numAllocated = 0, numUsed = 0;
 
-    template <class OtherElementType, class OtherCriticalSection>
+    template <class OtherElementType, class OtherCriticalSection, class OtherAllocatorType>
     friend class ArrayBase;
 
     JUCE_DECLARE_NON_COPYABLE (ArrayBase)
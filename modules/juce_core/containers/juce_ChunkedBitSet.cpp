@@ -0,0 +1,213 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if JUCE_UNIT_TESTS
+
+class ChunkedBitSetTests  : public UnitTest
+{
+public:
+    ChunkedBitSetTests()
+        : UnitTest ("ChunkedBitSet class", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("basic operations");
+        {
+            ChunkedBitSet<int> set;
+
+            expect (set.isEmpty());
+            expectEquals (set.size(), 0);
+            expect (! set.contains (0));
+
+            set.addRange ({ 10, 14 });
+            expect (! set.isEmpty());
+            expectEquals (set.size(), 4);
+            expect (set.contains (10));
+            expect (set.contains (13));
+            expect (! set.contains (14));
+            expect (set.containsRange ({ 10, 14 }));
+            expect (! set.containsRange ({ 10, 15 }));
+            expect (set.overlapsRange ({ 13, 20 }));
+            expect (! set.overlapsRange ({ 14, 20 }));
+
+            set.removeRange ({ 11, 13 });
+            expectEquals (set.size(), 2);
+            expect (set.contains (10));
+            expect (! set.contains (11));
+            expect (set.contains (13));
+
+            set.clear();
+            expect (set.isEmpty());
+        }
+
+        beginTest ("large ranges spanning many chunks");
+        {
+            const int numRows = 1000000;
+
+            ChunkedBitSet<int> set;
+            set.addRange ({ 0, numRows });
+
+            expectEquals (set.size(), numRows);
+            expect (set.contains (0));
+            expect (set.contains (numRows - 1));
+            expect (! set.contains (numRows));
+            expect (set.containsRange ({ 0, numRows }));
+            expect (set.getTotalRange() == Range<int> (0, numRows));
+            expectEquals (set.getRanges().size(), 1);
+
+            // deselect a row in the middle - only the chunk it lives in
+            // should need a bitmap
+            set.removeRange ({ 500000, 500001 });
+            expectEquals (set.size(), numRows - 1);
+            expect (! set.contains (500000));
+            expect (set.contains (499999));
+            expect (set.contains (500001));
+            expectEquals (set.getRanges().size(), 2);
+
+            set.invertRange ({ 0, numRows });
+            expectEquals (set.size(), 1);
+            expect (set.contains (500000));
+
+            set.invertRange ({ 0, numRows });
+            expectEquals (set.size(), numRows - 1);
+        }
+
+        beginTest ("agreement with SparseSet");
+        {
+            auto random = getRandom();
+
+            ChunkedBitSet<int> set;
+            SparseSet<int> reference;
+
+            const int domain = 200000;
+
+            for (int iteration = 0; iteration < 100; ++iteration)
+            {
+                auto start = random.nextInt (domain);
+                auto length = random.nextInt (domain / 4);
+                Range<int> range (start, jmin (domain, start + length));
+
+                switch (random.nextInt (3))
+                {
+                    case 0:  set.addRange (range);    reference.addRange (range);    break;
+                    case 1:  set.removeRange (range); reference.removeRange (range); break;
+                    case 2:  set.invertRange (range); reference.invertRange (range); break;
+                    default: break;
+                }
+
+                expectEquals (set.size(), reference.size());
+            }
+
+            expect (set.getRanges() == reference.getRanges());
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                auto value = random.nextInt (domain);
+                expect (set.contains (value) == reference.contains (value));
+            }
+        }
+
+        beginTest ("bulk operations");
+        {
+            auto random = getRandom();
+
+            const int domain = 300000;
+
+            for (int iteration = 0; iteration < 10; ++iteration)
+            {
+                ChunkedBitSet<int> a, b;
+
+                for (int i = 0; i < 20; ++i)
+                {
+                    auto start = random.nextInt (domain);
+                    Range<int> range (start, jmin (domain, start + random.nextInt (domain / 8)));
+
+                    if (random.nextBool())
+                        a.addRange (range);
+                    else
+                        b.addRange (range);
+                }
+
+                auto orSet = a;
+                orSet.orWith (b);
+
+                auto andSet = a;
+                andSet.andWith (b);
+
+                auto xorSet = a;
+                xorSet.xorWith (b);
+
+                for (int i = 0; i < 1000; ++i)
+                {
+                    auto value = random.nextInt (domain);
+                    auto inA = a.contains (value);
+                    auto inB = b.contains (value);
+
+                    expect (orSet.contains (value)  == (inA || inB));
+                    expect (andSet.contains (value) == (inA && inB));
+                    expect (xorSet.contains (value) == (inA != inB));
+                }
+
+                // (A ^ B) ^ B == A
+                xorSet.xorWith (b);
+                expect (xorSet == a);
+
+                xorSet.xorWith (xorSet);
+                expect (xorSet.isEmpty());
+            }
+        }
+
+        beginTest ("copying and comparison");
+        {
+            ChunkedBitSet<int> set;
+            set.addRange ({ 100, 200000 });
+            set.removeRange ({ 70000, 70001 });
+
+            ChunkedBitSet<int> copy (set);
+            expect (copy == set);
+            expectEquals (copy.size(), set.size());
+
+            copy.addRange ({ 70000, 70001 });
+            expect (copy != set);
+
+            // a chunk filled in bit by bit should compare equal to one
+            // created as a whole range
+            ChunkedBitSet<int> piecewise, whole;
+            whole.addRange ({ 0, 65536 });
+
+            for (int i = 0; i < 65536; i += 2)
+                piecewise.addRange ({ i, i + 2 });
+
+            expect (piecewise == whole);
+        }
+    }
+};
+
+static ChunkedBitSetTests chunkedBitSetTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,694 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Holds a set of non-negative integer values as a sorted list of fixed-size
+    chunks, where each chunk is either completely full or a small bitmap.
+
+    This is a companion to SparseSet for very large selection models. SparseSet
+    stores a flat array of ranges, which is perfect while a selection is a
+    handful of contiguous blocks, but a pattern like select-all-then-toggle on a
+    huge list fragments it into thousands of ranges, after which every edit
+    shifts large parts of the array and every membership test walks it.
+
+    A ChunkedBitSet divides the value space into chunks of 65536 values, kept in
+    a sorted summary array. A completely full chunk is stored as just its
+    summary entry - selecting a million rows creates a few dozen entries and no
+    bitmaps - and a partially-full chunk stores an 8KB bitmap in which set,
+    clear and invert operations are word-wise edits that never disturb
+    neighbouring chunks. The bulk operations orWith(), andWith() and xorWith()
+    combine whole sets a word at a time.
+
+    The type used as a template parameter must be an integer type, such as int,
+    short, int64 etc, and all values stored must be non-negative.
+
+    @see SparseSet
+
+    @tags{Core}
+*/
+template <class Type>
+class ChunkedBitSet
+{
+public:
+    //==============================================================================
+    ChunkedBitSet() = default;
+
+    ChunkedBitSet (const ChunkedBitSet& other)                  { *this = other; }
+    ChunkedBitSet (ChunkedBitSet&& other) noexcept : chunks (std::move (other.chunks)) {}
+
+    ChunkedBitSet& operator= (const ChunkedBitSet& other)
+    {
+        if (this != &other)
+        {
+            chunks.clear();
+            chunks.ensureStorageAllocated (other.chunks.size());
+
+            for (auto* c : other.chunks)
+                chunks.add (new Chunk (*c));
+        }
+
+        return *this;
+    }
+
+    ChunkedBitSet& operator= (ChunkedBitSet&& other) noexcept   { chunks = std::move (other.chunks); return *this; }
+
+    //==============================================================================
+    /** Clears the set. */
+    void clear()                                                { chunks.clear(); }
+
+    /** Checks whether the set is empty.
+        This is much quicker than using (size() == 0).
+    */
+    bool isEmpty() const noexcept                               { return chunks.isEmpty(); }
+
+    /** Returns the number of values in the set.
+        This only needs to total up the per-chunk counts, so it's fast no matter
+        how fragmented the set is.
+    */
+    Type size() const noexcept
+    {
+        int64 total = 0;
+
+        for (auto* c : chunks)
+            total += c->numSet;
+
+        return (Type) total;
+    }
+
+    /** Checks whether a particular value is in the set. */
+    bool contains (Type valueToLookFor) const noexcept
+    {
+        if (valueToLookFor < 0)
+            return false;
+
+        if (auto* c = findChunk (valueToLookFor / chunkSize))
+        {
+            if (c->isFull())
+                return true;
+
+            auto bit = (int) (valueToLookFor % chunkSize);
+            return (c->bits[bit >> 6] & (1ULL << (bit & 63))) != 0;
+        }
+
+        return false;
+    }
+
+    /** Returns the range between the lowest and highest values in the set. */
+    Range<Type> getTotalRange() const noexcept
+    {
+        if (chunks.isEmpty())
+            return {};
+
+        auto* first = chunks.getFirst();
+        auto* last  = chunks.getLast();
+
+        return { first->chunkIndex * chunkSize + (Type) first->getLowestSetBit(),
+                 last->chunkIndex * chunkSize + (Type) last->getHighestSetBit() + 1 };
+    }
+
+    //==============================================================================
+    /** Adds a range of contiguous values to the set.
+        Chunks that the range completely covers are stored as summary entries
+        with no bitmap, so this is fast even for enormous ranges.
+    */
+    void addRange (Range<Type> range)
+    {
+        forEachChunkSpan (range, [this] (Type chunkIndex, int start, int end)
+        {
+            setBitsInChunk (chunkIndex, start, end);
+        });
+    }
+
+    /** Removes a range of values from the set.
+        Only the chunks at the edges of the range need their bitmaps touched -
+        fully-covered chunks are simply dropped from the summary.
+    */
+    void removeRange (Range<Type> rangeToRemove)
+    {
+        forEachChunkSpan (rangeToRemove, [this] (Type chunkIndex, int start, int end)
+        {
+            clearBitsInChunk (chunkIndex, start, end);
+        });
+    }
+
+    /** Does an XOR of the values in a given range. */
+    void invertRange (Range<Type> range)
+    {
+        forEachChunkSpan (range, [this] (Type chunkIndex, int start, int end)
+        {
+            invertBitsInChunk (chunkIndex, start, end);
+        });
+    }
+
+    /** Checks whether any part of a given range overlaps any part of this set. */
+    bool overlapsRange (Range<Type> range) const noexcept
+    {
+        bool found = false;
+
+        forEachChunkSpan (range, [this, &found] (Type chunkIndex, int start, int end)
+        {
+            if (found)
+                return;
+
+            if (auto* c = findChunk (chunkIndex))
+            {
+                if (c->isFull())
+                {
+                    found = true;
+                    return;
+                }
+
+                forEachWordInRange (start, end, [&] (int word, uint64 mask)
+                {
+                    if ((c->bits[word] & mask) != 0)
+                        found = true;
+                });
+            }
+        });
+
+        return found;
+    }
+
+    /** Checks whether the whole of a given range is contained within this one. */
+    bool containsRange (Range<Type> range) const noexcept
+    {
+        if (range.isEmpty())
+            return false;
+
+        bool allPresent = true;
+
+        forEachChunkSpan (range, [this, &allPresent] (Type chunkIndex, int start, int end)
+        {
+            if (! allPresent)
+                return;
+
+            auto* c = findChunk (chunkIndex);
+
+            if (c == nullptr)
+            {
+                allPresent = false;
+            }
+            else if (! c->isFull())
+            {
+                forEachWordInRange (start, end, [&] (int word, uint64 mask)
+                {
+                    if ((c->bits[word] & mask) != mask)
+                        allPresent = false;
+                });
+            }
+        });
+
+        return allPresent;
+    }
+
+    //==============================================================================
+    /** Adds all the values of another set to this one, a word at a time. */
+    void orWith (const ChunkedBitSet& other)
+    {
+        for (auto* oc : other.chunks)
+        {
+            auto pos = findChunkPosition (oc->chunkIndex);
+            auto* c = getChunkAt (pos, oc->chunkIndex);
+
+            if (c == nullptr)
+            {
+                chunks.insert (pos, new Chunk (*oc));
+            }
+            else if (! c->isFull())
+            {
+                if (oc->isFull())
+                {
+                    c->makeFull();
+                }
+                else
+                {
+                    for (int w = 0; w < numWordsPerChunk; ++w)
+                    {
+                        c->numSet += countNumberOfBits (oc->bits[w] & ~c->bits[w]);
+                        c->bits[w] |= oc->bits[w];
+                    }
+
+                    if (c->numSet == chunkSize)
+                        c->makeFull();
+                }
+            }
+        }
+    }
+
+    /** Removes any values which aren't also in another set, a word at a time. */
+    void andWith (const ChunkedBitSet& other)
+    {
+        for (int i = chunks.size(); --i >= 0;)
+        {
+            auto* c = chunks.getUnchecked (i);
+            auto* oc = other.findChunk (c->chunkIndex);
+
+            if (oc == nullptr)
+            {
+                chunks.remove (i);
+            }
+            else if (! oc->isFull())
+            {
+                if (c->isFull())
+                {
+                    chunks.set (i, new Chunk (*oc));
+                }
+                else
+                {
+                    c->numSet = 0;
+
+                    for (int w = 0; w < numWordsPerChunk; ++w)
+                    {
+                        c->bits[w] &= oc->bits[w];
+                        c->numSet += countNumberOfBits (c->bits[w]);
+                    }
+
+                    if (c->numSet == 0)
+                        chunks.remove (i);
+                }
+            }
+        }
+    }
+
+    /** XORs this set with another one, a word at a time. */
+    void xorWith (const ChunkedBitSet& other)
+    {
+        if (this == &other)
+        {
+            clear();
+            return;
+        }
+
+        for (auto* oc : other.chunks)
+        {
+            auto pos = findChunkPosition (oc->chunkIndex);
+            auto* c = getChunkAt (pos, oc->chunkIndex);
+
+            if (c == nullptr)
+            {
+                chunks.insert (pos, new Chunk (*oc));
+                continue;
+            }
+
+            if (c->isFull() && oc->isFull())
+            {
+                chunks.remove (pos);
+                continue;
+            }
+
+            if (c->isFull())
+                c->materialiseBitmap();
+
+            c->numSet = 0;
+
+            for (int w = 0; w < numWordsPerChunk; ++w)
+            {
+                c->bits[w] ^= oc->isFull() ? ~(uint64) 0 : oc->bits[w];
+                c->numSet += countNumberOfBits (c->bits[w]);
+            }
+
+            if (c->numSet == 0)
+                chunks.remove (pos);
+            else if (c->numSet == chunkSize)
+                c->makeFull();
+        }
+    }
+
+    //==============================================================================
+    /** Returns the set's contents as a list of contiguous ranges, in ascending
+        order, e.g. for iterating a selection.
+    */
+    Array<Range<Type>> getRanges() const
+    {
+        Array<Range<Type>> result;
+
+        for (auto* c : chunks)
+        {
+            auto base = c->chunkIndex * chunkSize;
+
+            if (c->isFull())
+            {
+                appendRange (result, { base, base + (Type) chunkSize });
+                continue;
+            }
+
+            int bit = 0;
+
+            while (bit < chunkSize)
+            {
+                if ((c->bits[bit >> 6] & (1ULL << (bit & 63))) == 0)
+                {
+                    ++bit;
+                    continue;
+                }
+
+                auto runStart = bit;
+
+                while (bit < chunkSize && (c->bits[bit >> 6] & (1ULL << (bit & 63))) != 0)
+                    ++bit;
+
+                appendRange (result, { base + (Type) runStart, base + (Type) bit });
+            }
+        }
+
+        return result;
+    }
+
+    //==============================================================================
+    bool operator== (const ChunkedBitSet& other) const noexcept
+    {
+        if (chunks.size() != other.chunks.size())
+            return false;
+
+        for (int i = 0; i < chunks.size(); ++i)
+        {
+            auto* a = chunks.getUnchecked (i);
+            auto* b = other.chunks.getUnchecked (i);
+
+            // full chunks are always normalised to have no bitmap, so the
+            // representation is canonical and can be compared directly
+            if (a->chunkIndex != b->chunkIndex || a->numSet != b->numSet)
+                return false;
+
+            if (! a->isFull() && memcmp (a->bits, b->bits, numWordsPerChunk * sizeof (uint64)) != 0)
+                return false;
+        }
+
+        return true;
+    }
+
+    bool operator!= (const ChunkedBitSet& other) const noexcept  { return ! operator== (other); }
+
+private:
+    //==============================================================================
+    enum
+    {
+        chunkSize = 1 << 16,
+        numWordsPerChunk = chunkSize / 64
+    };
+
+    struct Chunk
+    {
+        Chunk (Type index, bool shouldBeFull)
+            : chunkIndex (index), numSet (shouldBeFull ? (int) chunkSize : 0)
+        {
+            if (! shouldBeFull)
+                bits.calloc (numWordsPerChunk);
+        }
+
+        Chunk (const Chunk& other)
+            : chunkIndex (other.chunkIndex), numSet (other.numSet)
+        {
+            if (other.bits != nullptr)
+            {
+                bits.malloc (numWordsPerChunk);
+                memcpy (bits, other.bits, numWordsPerChunk * sizeof (uint64));
+            }
+        }
+
+        bool isFull() const noexcept        { return bits == nullptr; }
+
+        void makeFull() noexcept
+        {
+            bits.free();
+            numSet = chunkSize;
+        }
+
+        void materialiseBitmap()
+        {
+            jassert (isFull());
+            bits.malloc (numWordsPerChunk);
+            memset (bits, 0xff, numWordsPerChunk * sizeof (uint64));
+        }
+
+        int getLowestSetBit() const noexcept
+        {
+            if (isFull())
+                return 0;
+
+            for (int w = 0; w < numWordsPerChunk; ++w)
+                if (bits[w] != 0)
+                    return w * 64 + findLowestSetBitInWord (bits[w]);
+
+            jassertfalse;  // empty chunks should have been removed
+            return 0;
+        }
+
+        int getHighestSetBit() const noexcept
+        {
+            if (isFull())
+                return chunkSize - 1;
+
+            for (int w = numWordsPerChunk; --w >= 0;)
+                if (bits[w] != 0)
+                    return w * 64 + findHighestSetBitInWord (bits[w]);
+
+            jassertfalse;  // empty chunks should have been removed
+            return 0;
+        }
+
+        Type chunkIndex;
+        int numSet;
+        HeapBlock<uint64> bits;   // null when the chunk is completely full
+    };
+
+    //==============================================================================
+    /** Returns the index into the chunks array of the first chunk whose index
+        isn't below the one given - i.e. the position at which a chunk with this
+        index lives, or should be inserted.
+    */
+    int findChunkPosition (Type chunkIndex) const noexcept
+    {
+        int low = 0, high = chunks.size();
+
+        while (low < high)
+        {
+            auto mid = (low + high) / 2;
+
+            if (chunks.getUnchecked (mid)->chunkIndex < chunkIndex)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+
+        return low;
+    }
+
+    Chunk* getChunkAt (int position, Type chunkIndex) const noexcept
+    {
+        if (position < chunks.size())
+        {
+            auto* c = chunks.getUnchecked (position);
+
+            if (c->chunkIndex == chunkIndex)
+                return c;
+        }
+
+        return nullptr;
+    }
+
+    Chunk* findChunk (Type chunkIndex) const noexcept
+    {
+        return getChunkAt (findChunkPosition (chunkIndex), chunkIndex);
+    }
+
+    //==============================================================================
+    /** Calls the given function for each chunk a range touches, with the local
+        bit range [start, end) that falls within that chunk.
+    */
+    template <typename Fn>
+    void forEachChunkSpan (Range<Type> range, Fn&& fn) const
+    {
+        if (range.isEmpty())
+            return;
+
+        // Values in a ChunkedBitSet must be non-negative
+        jassert (range.getStart() >= 0);
+
+        auto firstChunk = range.getStart() / chunkSize;
+        auto lastChunk  = (range.getEnd() - 1) / chunkSize;
+
+        for (auto chunkIndex = firstChunk; chunkIndex <= lastChunk; ++chunkIndex)
+        {
+            auto base = chunkIndex * chunkSize;
+            auto start = chunkIndex == firstChunk ? (int) (range.getStart() - base) : 0;
+            auto end   = chunkIndex == lastChunk  ? (int) (range.getEnd()   - base) : (int) chunkSize;
+
+            fn (chunkIndex, start, end);
+        }
+    }
+
+    /** Calls the given function with a word index and a mask covering the part
+        of the bit range [start, end) that falls within that word.
+    */
+    template <typename Fn>
+    static void forEachWordInRange (int start, int end, Fn&& fn)
+    {
+        for (int w = start >> 6; w <= (end - 1) >> 6; ++w)
+        {
+            auto wordStart = w * 64;
+            auto mask = ~(uint64) 0;
+
+            if (start > wordStart)
+                mask &= ~(uint64) 0 << (start - wordStart);
+
+            if (end < wordStart + 64)
+                mask &= ~(uint64) 0 >> (wordStart + 64 - end);
+
+            fn (w, mask);
+        }
+    }
+
+    //==============================================================================
+    void setBitsInChunk (Type chunkIndex, int start, int end)
+    {
+        auto pos = findChunkPosition (chunkIndex);
+        auto* c = getChunkAt (pos, chunkIndex);
+
+        if (end - start == chunkSize)
+        {
+            if (c == nullptr)
+                chunks.insert (pos, new Chunk (chunkIndex, true));
+            else
+                c->makeFull();
+
+            return;
+        }
+
+        if (c == nullptr)
+            c = chunks.insert (pos, new Chunk (chunkIndex, false));
+        else if (c->isFull())
+            return;
+
+        forEachWordInRange (start, end, [&] (int word, uint64 mask)
+        {
+            c->numSet += countNumberOfBits (mask & ~c->bits[word]);
+            c->bits[word] |= mask;
+        });
+
+        if (c->numSet == chunkSize)
+            c->makeFull();
+    }
+
+    void clearBitsInChunk (Type chunkIndex, int start, int end)
+    {
+        auto pos = findChunkPosition (chunkIndex);
+        auto* c = getChunkAt (pos, chunkIndex);
+
+        if (c == nullptr)
+            return;
+
+        if (end - start == chunkSize)
+        {
+            chunks.remove (pos);
+            return;
+        }
+
+        if (c->isFull())
+            c->materialiseBitmap();
+
+        forEachWordInRange (start, end, [&] (int word, uint64 mask)
+        {
+            c->numSet -= countNumberOfBits (mask & c->bits[word]);
+            c->bits[word] &= ~mask;
+        });
+
+        if (c->numSet == 0)
+            chunks.remove (pos);
+    }
+
+    void invertBitsInChunk (Type chunkIndex, int start, int end)
+    {
+        auto pos = findChunkPosition (chunkIndex);
+        auto* c = getChunkAt (pos, chunkIndex);
+
+        if (c == nullptr)
+        {
+            setBitsInChunk (chunkIndex, start, end);
+            return;
+        }
+
+        if (c->isFull())
+        {
+            if (end - start == chunkSize)
+            {
+                chunks.remove (pos);
+                return;
+            }
+
+            c->materialiseBitmap();
+        }
+
+        forEachWordInRange (start, end, [&] (int word, uint64 mask)
+        {
+            c->numSet += countNumberOfBits (mask & ~c->bits[word])
+                       - countNumberOfBits (mask & c->bits[word]);
+            c->bits[word] ^= mask;
+        });
+
+        if (c->numSet == 0)
+            chunks.remove (pos);
+        else if (c->numSet == chunkSize)
+            c->makeFull();
+    }
+
+    //==============================================================================
+    static void appendRange (Array<Range<Type>>& ranges, Range<Type> r)
+    {
+        if (! ranges.isEmpty() && ranges.getReference (ranges.size() - 1).getEnd() == r.getStart())
+            ranges.getReference (ranges.size() - 1).setEnd (r.getEnd());
+        else
+            ranges.add (r);
+    }
+
+    static int findLowestSetBitInWord (uint64 word) noexcept
+    {
+        int bit = 0;
+
+        while ((word & 1) == 0)
+        {
+            word >>= 1;
+            ++bit;
+        }
+
+        return bit;
+    }
+
+    static int findHighestSetBitInWord (uint64 word) noexcept
+    {
+        int bit = 0;
+
+        while ((word >>= 1) != 0)
+            ++bit;
+
+        return bit;
+    }
+
+    //==============================================================================
+    OwnedArray<Chunk> chunks;
+};
+
+} // namespace juce
@@ -0,0 +1,330 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+ConcurrentAbstractFifo::ConcurrentAbstractFifo (int capacity)
+    : bufferSize ((uint32) nextPowerOfTwo (jmax (2, capacity))),
+      indexMask (bufferSize - 1)
+{
+    jassert (capacity > 0);
+
+    slots.malloc (bufferSize);
+
+    for (uint32 i = 0; i < bufferSize; ++i)
+        slots[i].store (i, std::memory_order_relaxed);
+}
+
+int ConcurrentAbstractFifo::getTotalSize() const noexcept   { return (int) bufferSize; }
+int ConcurrentAbstractFifo::getFreeSpace() const noexcept   { return (int) bufferSize - getNumReady(); }
+
+int ConcurrentAbstractFifo::getNumReady() const noexcept
+{
+    auto w = writePos.load (std::memory_order_relaxed);
+    auto r = readPos .load (std::memory_order_relaxed);
+    return (int) (w - r);
+}
+
+void ConcurrentAbstractFifo::reset() noexcept
+{
+    writePos.store (0, std::memory_order_relaxed);
+    readPos .store (0, std::memory_order_relaxed);
+
+    for (uint32 i = 0; i < bufferSize; ++i)
+        slots[i].store (i, std::memory_order_relaxed);
+}
+
+//==============================================================================
+void ConcurrentAbstractFifo::splitClaimedRegion (uint64 start, int num, int& startIndex1, int& blockSize1,
+                                                 int& startIndex2, int& blockSize2) const noexcept
+{
+    if (num <= 0)
+    {
+        startIndex1 = 0;
+        startIndex2 = 0;
+        blockSize1 = 0;
+        blockSize2 = 0;
+    }
+    else
+    {
+        startIndex1 = (int) (start & indexMask);
+        blockSize1 = jmin (num, (int) bufferSize - startIndex1);
+        blockSize2 = num - blockSize1;
+        startIndex2 = 0;
+    }
+}
+
+uint64 ConcurrentAbstractFifo::claimForWriting (int numToWrite, int& startIndex1, int& blockSize1,
+                                                int& startIndex2, int& blockSize2) noexcept
+{
+    for (;;)
+    {
+        auto start = writePos.load (std::memory_order_relaxed);
+        int num = 0;
+
+        // A slot can be written once the reader from the previous lap has
+        // released it, which it signals by storing the slot's next write ticket.
+        while (num < numToWrite)
+        {
+            auto ticket = start + (uint64) num;
+
+            if (slots[ticket & indexMask].load (std::memory_order_acquire) != ticket)
+                break;
+
+            ++num;
+        }
+
+        if (num == 0)
+        {
+            splitClaimedRegion (start, 0, startIndex1, blockSize1, startIndex2, blockSize2);
+            return start;
+        }
+
+        if (writePos.compare_exchange_weak (start, start + (uint64) num, std::memory_order_relaxed))
+        {
+            splitClaimedRegion (start, num, startIndex1, blockSize1, startIndex2, blockSize2);
+            return start;
+        }
+    }
+}
+
+uint64 ConcurrentAbstractFifo::claimForReading (int numToRead, int& startIndex1, int& blockSize1,
+                                                int& startIndex2, int& blockSize2) noexcept
+{
+    for (;;)
+    {
+        auto start = readPos.load (std::memory_order_relaxed);
+        int num = 0;
+
+        // A slot can be read once its writer has published it, which it
+        // signals by storing the ticket value plus one.
+        while (num < numToRead)
+        {
+            auto ticket = start + (uint64) num;
+
+            if (slots[ticket & indexMask].load (std::memory_order_acquire) != ticket + 1)
+                break;
+
+            ++num;
+        }
+
+        if (num == 0)
+        {
+            splitClaimedRegion (start, 0, startIndex1, blockSize1, startIndex2, blockSize2);
+            return start;
+        }
+
+        if (readPos.compare_exchange_weak (start, start + (uint64) num, std::memory_order_relaxed))
+        {
+            splitClaimedRegion (start, num, startIndex1, blockSize1, startIndex2, blockSize2);
+            return start;
+        }
+    }
+}
+
+void ConcurrentAbstractFifo::publishWrite (uint64 start, int numWritten) noexcept
+{
+    for (int i = 0; i < numWritten; ++i)
+    {
+        auto ticket = start + (uint64) i;
+        slots[ticket & indexMask].store (ticket + 1, std::memory_order_release);
+    }
+}
+
+void ConcurrentAbstractFifo::releaseRead (uint64 start, int numRead) noexcept
+{
+    for (int i = 0; i < numRead; ++i)
+    {
+        auto ticket = start + (uint64) i;
+        slots[ticket & indexMask].store (ticket + bufferSize, std::memory_order_release);
+    }
+}
+
+//==============================================================================
+template <ConcurrentAbstractFifo::ReadOrWrite mode>
+ConcurrentAbstractFifo::ScopedReadWrite<mode>::ScopedReadWrite (ScopedReadWrite&& other) noexcept
+{
+    swap (other);
+}
+
+template <ConcurrentAbstractFifo::ReadOrWrite mode>
+ConcurrentAbstractFifo::ScopedReadWrite<mode>&
+ConcurrentAbstractFifo::ScopedReadWrite<mode>::operator= (ScopedReadWrite&& other) noexcept
+{
+    swap (other);
+    return *this;
+}
+
+template <ConcurrentAbstractFifo::ReadOrWrite mode>
+void ConcurrentAbstractFifo::ScopedReadWrite<mode>::swap (ScopedReadWrite& other) noexcept
+{
+    std::swap (other.fifo, fifo);
+    std::swap (other.ticket, ticket);
+    std::swap (other.startIndex1, startIndex1);
+    std::swap (other.blockSize1, blockSize1);
+    std::swap (other.startIndex2, startIndex2);
+    std::swap (other.blockSize2, blockSize2);
+}
+
+template <>
+void ConcurrentAbstractFifo::ScopedReadWrite<ConcurrentAbstractFifo::ReadOrWrite::read>::prepare (ConcurrentAbstractFifo& f, int num) noexcept
+{
+    ticket = f.claimForReading (num, startIndex1, blockSize1, startIndex2, blockSize2);
+}
+
+template <>
+void ConcurrentAbstractFifo::ScopedReadWrite<ConcurrentAbstractFifo::ReadOrWrite::write>::prepare (ConcurrentAbstractFifo& f, int num) noexcept
+{
+    ticket = f.claimForWriting (num, startIndex1, blockSize1, startIndex2, blockSize2);
+}
+
+template <>
+void ConcurrentAbstractFifo::ScopedReadWrite<ConcurrentAbstractFifo::ReadOrWrite::read>::finish (ConcurrentAbstractFifo& f, uint64 start, int num) noexcept
+{
+    f.releaseRead (start, num);
+}
+
+template <>
+void ConcurrentAbstractFifo::ScopedReadWrite<ConcurrentAbstractFifo::ReadOrWrite::write>::finish (ConcurrentAbstractFifo& f, uint64 start, int num) noexcept
+{
+    f.publishWrite (start, num);
+}
+
+template class ConcurrentAbstractFifo::ScopedReadWrite<ConcurrentAbstractFifo::ReadOrWrite::read>;
+template class ConcurrentAbstractFifo::ScopedReadWrite<ConcurrentAbstractFifo::ReadOrWrite::write>;
+
+ConcurrentAbstractFifo::ScopedRead  ConcurrentAbstractFifo::read  (int numToRead) noexcept     { return { *this, numToRead }; }
+ConcurrentAbstractFifo::ScopedWrite ConcurrentAbstractFifo::write (int numToWrite) noexcept    { return { *this, numToWrite }; }
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ConcurrentAbstractFifoTests  : public UnitTest
+{
+public:
+    ConcurrentAbstractFifoTests()
+        : UnitTest ("Concurrent Abstract Fifo", UnitTestCategories::containers)
+    {}
+
+    struct WriteThread  : public Thread
+    {
+        WriteThread (ConcurrentAbstractFifo& f, int* b, int numToPush, int valueOffset)
+            : Thread ("mpmc fifo writer"), fifo (f), buffer (b),
+              remaining (numToPush), nextValue (valueOffset)
+        {
+            startThread();
+        }
+
+        ~WriteThread() override
+        {
+            stopThread (5000);
+        }
+
+        void run() override
+        {
+            while (remaining > 0 && ! threadShouldExit())
+            {
+                auto writer = fifo.write (jmin (remaining, 7));
+                writer.forEach ([this] (int index)  { buffer[index] = nextValue++; });
+                remaining -= writer.blockSize1 + writer.blockSize2;
+            }
+        }
+
+        ConcurrentAbstractFifo& fifo;
+        int* buffer;
+        int remaining, nextValue;
+    };
+
+    void runTest() override
+    {
+        beginTest ("Single-threaded wraparound");
+        {
+            int buffer[16];
+            ConcurrentAbstractFifo fifo (16);
+            expectEquals (fifo.getTotalSize(), 16);
+
+            for (int iteration = 0; iteration < 100; ++iteration)
+            {
+                {
+                    auto writer = fifo.write (11);
+                    expectEquals (writer.blockSize1 + writer.blockSize2, 11);
+                    int n = iteration;
+                    writer.forEach ([&] (int index)  { buffer[index] = n++; });
+                }
+
+                expectEquals (fifo.getNumReady(), 11);
+
+                {
+                    auto reader = fifo.read (11);
+                    expectEquals (reader.blockSize1 + reader.blockSize2, 11);
+                    int n = iteration;
+                    reader.forEach ([&] (int index)  { expectEquals (buffer[index], n++); });
+                }
+            }
+
+            expectEquals (fifo.getNumReady(), 0);
+        }
+
+        beginTest ("Multiple producers, single consumer");
+        {
+            constexpr int numWriters = 4;
+            constexpr int numPerWriter = 2500;
+
+            int buffer[64];
+            ConcurrentAbstractFifo fifo (numElementsInArray (buffer));
+
+            BigInteger seen;
+            OwnedArray<WriteThread> writers;
+
+            for (int i = 0; i < numWriters; ++i)
+                writers.add (new WriteThread (fifo, buffer, numPerWriter, i * numPerWriter));
+
+            int numRead = 0;
+
+            for (int timeout = 20000; numRead < numWriters * numPerWriter && --timeout >= 0;)
+            {
+                auto reader = fifo.read (fifo.getNumReady());
+
+                reader.forEach ([&] (int index)
+                {
+                    expect (! seen[buffer[index]]);
+                    seen.setBit (buffer[index]);
+                });
+
+                numRead += reader.blockSize1 + reader.blockSize2;
+                Thread::yield();
+            }
+
+            expectEquals (numRead, numWriters * numPerWriter);
+            expectEquals (seen.countNumberOfSetBits(), numWriters * numPerWriter);
+        }
+    }
+};
+
+static ConcurrentAbstractFifoTests concurrentFifoUnitTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,213 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Encapsulates the logic required to implement a bounded lock-free FIFO that
+    supports multiple concurrent producers and consumers.
+
+    This is the multi-producer/multi-consumer counterpart of AbstractFifo.
+    Like AbstractFifo it doesn't hold any data itself: it just hands out index
+    ranges into a buffer that you own, as a pair of contiguous blocks that may
+    wrap around the end of the buffer.
+
+    Unlike AbstractFifo, several threads may call write() concurrently, and
+    several threads may call read() concurrently, without any external locking.
+    Each slot in the managed buffer carries a sequence number, so writers that
+    complete out-of-order don't block each other - readers will simply only see
+    slots whose contents have actually been published.
+
+    To keep this possible there is one behavioural difference from
+    AbstractFifo: the number of items claimed by a scoped read or write is
+    always finished in full when the scope ends. You can't claim five slots and
+    then decide to only commit three of them.
+
+    e.g.
+    @code
+    struct MyEventFifo
+    {
+        void push (const Event& e)           // called from many threads
+        {
+            const auto scope = fifo.write (1);
+
+            scope.forEach ([&] (int index)  { buffer[index] = e; });
+        }
+
+        void popAll (Array<Event>& dest)     // called from the audio thread
+        {
+            const auto scope = fifo.read (fifo.getNumReady());
+
+            scope.forEach ([&] (int index)  { dest.add (buffer[index]); });
+        }
+
+        ConcurrentAbstractFifo fifo { 1024 };
+        Event buffer[1024];
+    };
+    @endcode
+
+    @see AbstractFifo, SingleThreadedAbstractFifo
+
+    @tags{Core}
+*/
+class JUCE_API  ConcurrentAbstractFifo
+{
+public:
+    //==============================================================================
+    /** Creates a FIFO to manage a buffer with the specified capacity.
+        The capacity will be rounded up to the next power of two, so call
+        getTotalSize() to find out how big the buffer you allocate needs to be.
+    */
+    explicit ConcurrentAbstractFifo (int capacity);
+
+    //==============================================================================
+    /** Returns the total size of the buffer being managed.
+        This may be larger than the capacity passed to the constructor, as the
+        size is always rounded up to a power of two.
+    */
+    int getTotalSize() const noexcept;
+
+    /** Returns an estimate of the number of items that can currently be written.
+        With multiple threads active this can only ever be a snapshot, so treat
+        it as a hint rather than a guarantee.
+    */
+    int getFreeSpace() const noexcept;
+
+    /** Returns an estimate of the number of items that can currently be read.
+        This counts slots that have been claimed by writers but not yet
+        published, so a subsequent read() may return fewer items than this.
+    */
+    int getNumReady() const noexcept;
+
+    /** Clears the buffer positions, so that it appears empty.
+        Note that this isn't thread-safe, so don't call it while any other
+        thread might be reading or writing!
+    */
+    void reset() noexcept;
+
+    //==============================================================================
+private:
+    enum class ReadOrWrite
+    {
+        read,
+        write
+    };
+
+public:
+    /** Class for a scoped reader/writer.
+        The claimed region is described by the same startIndex1/blockSize1/
+        startIndex2/blockSize2 fields that AbstractFifo's scoped handles use,
+        and is committed in full when this object is destroyed.
+    */
+    template <ReadOrWrite mode>
+    class ScopedReadWrite final
+    {
+    public:
+        /** Construct an unassigned reader/writer. Doesn't do anything upon destruction. */
+        ScopedReadWrite() = default;
+
+        /** Construct a reader/writer which immediately claims up to the given
+            number of slots from the fifo which was passed in.
+            This object will hold a pointer back to the fifo, so make sure that
+            the fifo outlives this object.
+        */
+        ScopedReadWrite (ConcurrentAbstractFifo& f, int num) noexcept  : fifo (&f)
+        {
+            prepare (*fifo, num);
+        }
+
+        ScopedReadWrite (const ScopedReadWrite&) = delete;
+        ScopedReadWrite (ScopedReadWrite&&) noexcept;
+
+        ScopedReadWrite& operator= (const ScopedReadWrite&) = delete;
+        ScopedReadWrite& operator= (ScopedReadWrite&&) noexcept;
+
+        /** Publishes (for a writer) or releases (for a reader) the claimed slots. */
+        ~ScopedReadWrite() noexcept
+        {
+            if (fifo != nullptr)
+                finish (*fifo, ticket, blockSize1 + blockSize2);
+        }
+
+        /** Calls the passed function with each index that was claimed for the
+            current read/write operation.
+        */
+        template <typename FunctionToApply>
+        void forEach (FunctionToApply&& func) const
+        {
+            for (auto i = startIndex1, e = startIndex1 + blockSize1; i != e; ++i)  func (i);
+            for (auto i = startIndex2, e = startIndex2 + blockSize2; i != e; ++i)  func (i);
+        }
+
+        int startIndex1 = 0, blockSize1 = 0, startIndex2 = 0, blockSize2 = 0;
+
+    private:
+        void prepare (ConcurrentAbstractFifo&, int) noexcept;
+        static void finish (ConcurrentAbstractFifo&, uint64, int) noexcept;
+        void swap (ScopedReadWrite&) noexcept;
+
+        ConcurrentAbstractFifo* fifo = nullptr;
+        uint64 ticket = 0;
+    };
+
+    using ScopedRead  = ScopedReadWrite<ReadOrWrite::read>;
+    using ScopedWrite = ScopedReadWrite<ReadOrWrite::write>;
+
+    /** Claims up to the given number of items for reading, returning an object
+        which holds the start indices and block sizes, and which will release
+        the claimed slots back to the writers when it goes out of scope.
+
+        If fewer items than requested have been published, the returned blocks
+        will cover only the published prefix, so blockSize1 + blockSize2 may be
+        smaller than numToRead (and may be zero).
+    */
+    ScopedRead read (int numToRead) noexcept;
+
+    /** Claims up to the given number of items for writing, returning an object
+        which holds the start indices and block sizes, and which will publish
+        the slots to readers when it goes out of scope.
+
+        If there's not enough free space, blockSize1 + blockSize2 may be smaller
+        than numToWrite (and may be zero). All slots that are claimed must be
+        filled in before the returned object is destroyed.
+    */
+    ScopedWrite write (int numToWrite) noexcept;
+
+private:
+    //==============================================================================
+    uint64 claimForWriting (int, int&, int&, int&, int&) noexcept;
+    uint64 claimForReading (int, int&, int&, int&, int&) noexcept;
+    void publishWrite (uint64, int) noexcept;
+    void releaseRead (uint64, int) noexcept;
+    void splitClaimedRegion (uint64, int, int&, int&, int&, int&) const noexcept;
+
+    uint32 bufferSize, indexMask;
+    HeapBlock<std::atomic<uint64>> slots;
+    std::atomic<uint64> writePos { 0 }, readPos { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ConcurrentAbstractFifo)
+};
+
+
+} // namespace juce
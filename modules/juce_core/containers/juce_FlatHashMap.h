@@ -0,0 +1,463 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Holds a set of mappings between key/value pairs in a flat, open-addressed
+    hash table.
+
+    This offers the same basic facilities as HashMap, using the same
+    HashFunctionType concept, but stores its entries contiguously in a single
+    allocation, using robin-hood probing to resolve collisions. A lookup
+    therefore touches one or two consecutive cache lines rather than chasing
+    per-entry heap nodes, which makes it considerably faster for large maps
+    and hot lookup paths.
+
+    The trade-offs compared to HashMap: the table is rehashed as it grows, so
+    unlike HashMap, references returned by getReference() are only valid until
+    the next modification of the map; and key/value types must be movable.
+
+    @code
+    FlatHashMap<int, String> map;
+    map.set (1, "item1");
+    map.set (2, "item2");
+
+    DBG (map [1]); // prints "item1"
+
+    for (FlatHashMap<int, String>::Iterator i (map); i.next();)
+        DBG (i.getKey() << " -> " << i.getValue());
+    @endcode
+
+    @tparam HashFunctionType The class of hash function, which must be copy-constructible.
+    @see HashMap, DefaultHashFunctions
+
+    @tags{Core}
+*/
+template <typename KeyType,
+          typename ValueType,
+          class HashFunctionType = DefaultHashFunctions,
+          class TypeOfCriticalSectionToUse = DummyCriticalSection>
+class FlatHashMap
+{
+private:
+    using KeyTypeParameter   = typename TypeHelpers::ParameterType<KeyType>::type;
+    using ValueTypeParameter = typename TypeHelpers::ParameterType<ValueType>::type;
+
+public:
+    //==============================================================================
+    /** Creates an empty map.
+
+        @param numberOfSlots Specifies the initial number of hash slots, which will be
+                             rounded up to a power of two. The table grows automatically
+                             when it becomes three-quarters full.
+        @param hashFunction  An instance of HashFunctionType, which will be copied and
+                             stored to use with the map. This parameter can be omitted
+                             if HashFunctionType has a default constructor.
+    */
+    explicit FlatHashMap (int numberOfSlots = 0,
+                          HashFunctionType hashFunction = HashFunctionType())
+        : hashFunctionToUse (hashFunction)
+    {
+        if (numberOfSlots > 0)
+            rehash (nextPowerOfTwo (numberOfSlots));
+    }
+
+    /** Destructor. */
+    ~FlatHashMap()
+    {
+        destroyAllEntries();
+    }
+
+    //==============================================================================
+    /** Removes all values from the map.
+        This keeps the table's current allocation, so it can be refilled without
+        rehashing.
+    */
+    void clear()
+    {
+        const ScopedLockType sl (getLock());
+
+        destroyAllEntries();
+
+        if (numSlots > 0)
+            distances.clear ((size_t) numSlots);
+
+        totalNumItems = 0;
+    }
+
+    //==============================================================================
+    /** Returns the current number of items in the map. */
+    inline int size() const noexcept
+    {
+        return totalNumItems;
+    }
+
+    /** Returns the value corresponding to a given key.
+        If the map doesn't contain the key, a default instance of the value type is returned.
+        @param keyToLookFor    the key of the item being requested
+    */
+    inline ValueType operator[] (KeyTypeParameter keyToLookFor) const
+    {
+        const ScopedLockType sl (getLock());
+        auto i = findSlot (keyToLookFor);
+
+        return i >= 0 ? entries[i].value : ValueType();
+    }
+
+    /** Returns a reference to the value corresponding to a given key.
+        If the map doesn't contain the key, a default instance of the value type is
+        added to the map and a reference to this is returned.
+
+        Note that unlike HashMap, the reference is only guaranteed to remain valid
+        until the next modification of the map, as the table may be rehashed.
+        @param keyToLookFor    the key of the item being requested
+    */
+    inline ValueType& getReference (KeyTypeParameter keyToLookFor)
+    {
+        const ScopedLockType sl (getLock());
+        auto i = findSlot (keyToLookFor);
+
+        if (i >= 0)
+            return entries[i].value;
+
+        if ((totalNumItems + 1) * 4 > numSlots * 3)
+            rehash (jmax ((int) minimumNumSlots, numSlots * 2));
+
+        auto placed = placeEntry ({ KeyType (keyToLookFor), ValueType() });
+        ++totalNumItems;
+        return entries[placed].value;
+    }
+
+    //==============================================================================
+    /** Returns true if the map contains an item with the specified key. */
+    bool contains (KeyTypeParameter keyToLookFor) const
+    {
+        const ScopedLockType sl (getLock());
+
+        return findSlot (keyToLookFor) >= 0;
+    }
+
+    /** Returns true if the map contains at least one occurrence of a given value. */
+    bool containsValue (ValueTypeParameter valueToLookFor) const
+    {
+        const ScopedLockType sl (getLock());
+
+        for (int i = 0; i < numSlots; ++i)
+            if (distances[i] != 0 && entries[i].value == valueToLookFor)
+                return true;
+
+        return false;
+    }
+
+    //==============================================================================
+    /** Adds or replaces an element in the map.
+        If there's already an item with the given key, this will replace its value.
+        Otherwise, a new item will be added to the map.
+    */
+    void set (KeyTypeParameter newKey, ValueTypeParameter newValue)        { getReference (newKey) = newValue; }
+
+    /** Removes an item with the given key. */
+    void remove (KeyTypeParameter keyToRemove)
+    {
+        const ScopedLockType sl (getLock());
+        auto i = findSlot (keyToRemove);
+
+        if (i < 0)
+            return;
+
+        // backward-shift deletion: pull any displaced followers one slot closer
+        // to their home, so no tombstones are needed
+        entries[i].~Entry();
+        auto mask = numSlots - 1;
+
+        for (;;)
+        {
+            auto next = (i + 1) & mask;
+
+            if (distances[next] <= 1)
+                break;
+
+            new (entries + i) Entry (std::move (entries[next]));
+            entries[next].~Entry();
+            distances[i] = distances[next] - 1;
+            i = next;
+        }
+
+        distances[i] = 0;
+        --totalNumItems;
+    }
+
+    /** Removes all items with the given value. */
+    void removeValue (ValueTypeParameter valueToRemove)
+    {
+        const ScopedLockType sl (getLock());
+
+        // gather the keys first, as each removal shuffles other entries around
+        Array<KeyType> keysToRemove;
+
+        for (int i = 0; i < numSlots; ++i)
+            if (distances[i] != 0 && entries[i].value == valueToRemove)
+                keysToRemove.add (entries[i].key);
+
+        for (auto& key : keysToRemove)
+            remove (key);
+    }
+
+    /** Returns the number of slots currently allocated for the table. */
+    inline int getNumSlots() const noexcept
+    {
+        return numSlots;
+    }
+
+    //==============================================================================
+    /** Efficiently swaps the contents of two maps. */
+    template <class OtherHashMapType>
+    void swapWith (OtherHashMapType& otherHashMap) noexcept
+    {
+        const ScopedLockType lock1 (getLock());
+        const typename OtherHashMapType::ScopedLockType lock2 (otherHashMap.getLock());
+
+        distances.swapWith (otherHashMap.distances);
+        entries.swapWith (otherHashMap.entries);
+        std::swap (numSlots, otherHashMap.numSlots);
+        std::swap (totalNumItems, otherHashMap.totalNumItems);
+    }
+
+    //==============================================================================
+    /** Returns the CriticalSection that locks this structure.
+        To lock, you can call getLock().enter() and getLock().exit(), or preferably use
+        an object of ScopedLockType as an RAII lock for it.
+    */
+    inline const TypeOfCriticalSectionToUse& getLock() const noexcept      { return lock; }
+
+    /** Returns the type of scoped lock to use for locking this map */
+    using ScopedLockType = typename TypeOfCriticalSectionToUse::ScopedLockType;
+
+private:
+    //==============================================================================
+    struct Entry
+    {
+        KeyType key;
+        ValueType value;
+    };
+
+public:
+    //==============================================================================
+    /** Iterates over the items in a FlatHashMap.
+
+        To use it, repeatedly call next() until it returns false, e.g.
+        @code
+        FlatHashMap<String, String> myMap;
+
+        FlatHashMap<String, String>::Iterator i (myMap);
+
+        while (i.next())
+            DBG (i.getKey() << " -> " << i.getValue());
+        @endcode
+
+        The order in which items are iterated bears no resemblance to the order in
+        which they were added, and any non-const method called on the map will
+        invalidate iterators that were created beforehand.
+
+        @see FlatHashMap
+    */
+    struct Iterator
+    {
+        Iterator (const FlatHashMap& mapToIterate) noexcept
+            : map (mapToIterate)
+        {}
+
+        Iterator (const Iterator& other) noexcept
+            : map (other.map), index (other.index)
+        {}
+
+        /** Moves to the next item, if one is available.
+            When this returns true, you can get the item's key and value using getKey() and
+            getValue(). If it returns false, the iteration has finished and you should stop.
+        */
+        bool next() noexcept
+        {
+            while (++index < map.numSlots)
+                if (map.distances[index] != 0)
+                    return true;
+
+            index = map.numSlots;
+            return false;
+        }
+
+        /** Returns the current item's key.
+            This should only be called when a call to next() has just returned true.
+        */
+        KeyType getKey() const
+        {
+            return isPositiveAndBelow (index, map.numSlots) ? map.entries[index].key : KeyType();
+        }
+
+        /** Returns the current item's value.
+            This should only be called when a call to next() has just returned true.
+        */
+        ValueType getValue() const
+        {
+            return isPositiveAndBelow (index, map.numSlots) ? map.entries[index].value : ValueType();
+        }
+
+        /** Resets the iterator to its starting position. */
+        void reset() noexcept
+        {
+            index = -1;
+        }
+
+        Iterator& operator++() noexcept                         { next(); return *this; }
+        ValueType operator*() const                             { return getValue(); }
+        bool operator!= (const Iterator& other) const noexcept  { return index != other.index; }
+        void resetToEnd() noexcept                              { index = map.numSlots; }
+
+    private:
+        //==============================================================================
+        const FlatHashMap& map;
+        int index = -1;
+
+        // using the copy constructor is ok, but you cannot assign iterators
+        Iterator& operator= (const Iterator&) = delete;
+
+        JUCE_LEAK_DETECTOR (Iterator)
+    };
+
+    /** Returns a start iterator for the values in this map. */
+    Iterator begin() const noexcept             { Iterator i (*this); i.next(); return i; }
+
+    /** Returns an end iterator for the values in this map. */
+    Iterator end() const noexcept               { Iterator i (*this); i.resetToEnd(); return i; }
+
+private:
+    //==============================================================================
+    enum { minimumNumSlots = 16 };
+    friend struct Iterator;
+
+    HashFunctionType hashFunctionToUse;
+    HeapBlock<int> distances;       // 0 == empty, otherwise probe distance + 1
+    HeapBlock<Entry> entries;       // raw storage; only slots with a non-zero distance are constructed
+    int numSlots = 0;               // always zero or a power of two
+    int totalNumItems = 0;
+    TypeOfCriticalSectionToUse lock;
+
+    int generateHashFor (KeyTypeParameter key, int upperLimit) const
+    {
+        const int hash = hashFunctionToUse.generateHash (key, upperLimit);
+        jassert (isPositiveAndBelow (hash, upperLimit)); // your hash function is generating out-of-range numbers!
+        return hash;
+    }
+
+    int findSlot (KeyTypeParameter keyToLookFor) const
+    {
+        if (totalNumItems == 0)
+            return -1;
+
+        auto mask = numSlots - 1;
+        auto i = generateHashFor (keyToLookFor, numSlots);
+
+        // robin-hood invariant: if the key were present, it would be stored at
+        // exactly its probe distance, and no occupied slot on the way can have a
+        // smaller distance - so the search can stop as soon as one does
+        for (int distance = 1; ; ++distance, i = (i + 1) & mask)
+        {
+            auto d = distances[i];
+
+            if (d < distance)
+                return -1;
+
+            if (d == distance && entries[i].key == keyToLookFor)
+                return i;
+        }
+    }
+
+    // robin-hood insertion of a new entry, displacing any richer entries found on
+    // the way; returns the slot where the given entry ended up
+    int placeEntry (Entry&& entryToPlace)
+    {
+        Entry toPlace (std::move (entryToPlace));
+        auto mask = numSlots - 1;
+        auto i = generateHashFor (toPlace.key, numSlots);
+        int distance = 1, resultIndex = -1;
+
+        for (;;)
+        {
+            if (distances[i] == 0)
+            {
+                new (entries + i) Entry (std::move (toPlace));
+                distances[i] = distance;
+                return resultIndex >= 0 ? resultIndex : i;
+            }
+
+            if (distances[i] < distance)
+            {
+                std::swap (toPlace, entries[i]);
+                std::swap (distance, distances[i]);
+
+                if (resultIndex < 0)
+                    resultIndex = i;
+            }
+
+            ++distance;
+            i = (i + 1) & mask;
+        }
+    }
+
+    void rehash (int newNumSlots)
+    {
+        jassert (newNumSlots > totalNumItems && isPowerOfTwo (newNumSlots));
+
+        HeapBlock<int> oldDistances;
+        HeapBlock<Entry> oldEntries;
+        auto oldNumSlots = numSlots;
+
+        oldDistances.swapWith (distances);
+        oldEntries.swapWith (entries);
+
+        distances.calloc ((size_t) newNumSlots);
+        entries.malloc ((size_t) newNumSlots);
+        numSlots = newNumSlots;
+
+        for (int i = 0; i < oldNumSlots; ++i)
+        {
+            if (oldDistances[i] != 0)
+            {
+                placeEntry (std::move (oldEntries[i]));
+                oldEntries[i].~Entry();
+            }
+        }
+    }
+
+    void destroyAllEntries() noexcept
+    {
+        for (int i = 0; i < numSlots; ++i)
+            if (distances[i] != 0)
+                entries[i].~Entry();
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlatHashMap)
+};
+
+} // namespace juce
@@ -84,9 +84,14 @@ public:
     void add (ListenerClass* listenerToAdd)
     {
         if (listenerToAdd != nullptr)
-            listeners.addIfNotAlreadyThere (listenerToAdd);
+        {
+            if (listeners.addIfNotAlreadyThere (listenerToAdd))
+                ++epoch;
+        }
         else
+        {
             jassertfalse;  // Listeners can't be null pointers!
+        }
     }
 
     /** Removes a listener from the list.
@@ -96,6 +101,7 @@ public:
     {
         jassert (listenerToRemove != nullptr); // Listeners can't be null pointers!
         listeners.removeFirstMatchingValue (listenerToRemove);
+        ++epoch;
     }
 
     /** Returns the number of registered listeners. */
@@ -105,7 +111,7 @@ public:
     bool isEmpty() const noexcept                            { return listeners.isEmpty(); }
 
     /** Clears the list. */
-    void clear()                                             { listeners.clear(); }
+    void clear()                                             { listeners.clear(); ++epoch; }
 
     /** Returns true if the specified listener has been added to the list. */
     bool contains (ListenerClass* listener) const noexcept   { return listeners.contains (listener); }
@@ -114,14 +120,28 @@ public:
     const ArrayType& getListeners() const noexcept           { return listeners; }
 
     //==============================================================================
-    /** Calls a member function on each listener in the list, with multiple parameters. */
+    /** Calls a member function on each listener in the list, with multiple parameters.
+
+        While the list isn't modified from inside a callback, this is a plain walk
+        over the listener array - the per-callee re-validation only kicks in once
+        an add or remove actually happens mid-traversal.
+
+        If a ScopedBatchNotification is currently alive, the callback is queued
+        instead of being delivered, and all queued callbacks are delivered in a
+        single traversal when the last ScopedBatchNotification goes out of scope.
+    */
     template <typename Callback>
     void call (Callback&& callback)
     {
         typename ArrayType::ScopedLockType lock (listeners.getLock());
 
-        for (Iterator<DummyBailOutChecker, ThisType> iter (*this); iter.next();)
-            callback (*iter.getListener());
+        if (batchDepth > 0)
+        {
+            batchedCallbacks.add (std::function<void (ListenerClass&)> (callback));
+            return;
+        }
+
+        callNow (callback);
     }
 
     /** Calls a member function with 1 parameter, on all but the specified listener in the list.
@@ -185,6 +205,49 @@ public:
     using ThisType      = ListenerList<ListenerClass, ArrayType>;
     using ListenerType  = ListenerClass;
 
+    //==============================================================================
+    /** Puts a ListenerList into batched-notification mode for as long as it's alive.
+
+        While at least one of these objects exists for a list, lambdas passed to
+        call() are queued rather than delivered. When the last one is destroyed,
+        all the queued callbacks are delivered in a single traversal, so each
+        listener is visited once rather than once per broadcast - a big win when
+        many broadcasts hit a large list in quick succession.
+
+        Note that this changes the delivery order: unbatched, the first callback
+        reaches every listener before the second is sent to any of them; batched,
+        each listener receives all the pending callbacks in turn.
+
+        E.g.
+        @code
+        {
+            ListenerList<MyListenerType>::ScopedBatchNotification batch (listeners);
+
+            for (auto& change : changes)
+                listeners.call ([&] (MyListenerType& l) { l.somethingChanged (change); });
+        } // <- all the queued callbacks are delivered here, in one pass
+        @endcode
+    */
+    class ScopedBatchNotification
+    {
+    public:
+        explicit ScopedBatchNotification (ThisType& listToBatch)  : list (listToBatch)
+        {
+            typename ArrayType::ScopedLockType lock (list.listeners.getLock());
+            ++list.batchDepth;
+        }
+
+        ~ScopedBatchNotification()
+        {
+            list.endBatch();
+        }
+
+    private:
+        ThisType& list;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedBatchNotification)
+    };
+
     //==============================================================================
     /** Iterates the listeners in a ListenerList. */
     template <class BailOutCheckerType, class ListType>
@@ -194,6 +257,13 @@ public:
             : list (listToIterate), index (listToIterate.size())
         {}
 
+        /** Creates an iterator that resumes partway through a traversal, so that
+            the remaining listeners below the given index are visited.
+        */
+        Iterator (const ListType& listToIterate, int startIndex) noexcept
+            : list (listToIterate), index (jmin (startIndex, listToIterate.size()))
+        {}
+
         ~Iterator() = default;
 
         //==============================================================================
@@ -260,10 +330,9 @@ public:
     template <typename... MethodArgs, typename... Args>
     void call (void (ListenerClass::*callbackFunction) (MethodArgs...), Args&&... args)
     {
-        typename ArrayType::ScopedLockType lock (listeners.getLock());
-
-        for (Iterator<DummyBailOutChecker, ThisType> iter (*this); iter.next();)
-            (iter.getListener()->*callbackFunction) (static_cast<typename TypeHelpers::ParameterType<Args>::type> (args)...);
+        // Capturing by value keeps the arguments alive if this call ends up
+        // queued by a ScopedBatchNotification.
+        call ([=] (ListenerClass& l) { (l.*callbackFunction) (static_cast<typename TypeHelpers::ParameterType<Args>::type> (args)...); });
     }
 
     template <typename... MethodArgs, typename... Args>
@@ -306,6 +375,52 @@ public:
 private:
     //==============================================================================
     ArrayType listeners;
+    Array<std::function<void (ListenerClass&)>> batchedCallbacks;
+    int batchDepth = 0;
+    int epoch = 0;
+
+    //==============================================================================
+    template <typename Callback>
+    void callNow (Callback&& callback)
+    {
+        const auto epochAtStart = epoch;
+
+        // As long as no callback modifies the list, this is a plain backwards walk
+        // over the array - the epoch only changes when an add or remove happens,
+        // at which point the rest of the traversal drops back to the re-validating
+        // iterator.
+        for (int i = listeners.size(); --i >= 0;)
+        {
+            callback (*listeners.getUnchecked (i));
+
+            if (epoch != epochAtStart)
+            {
+                for (Iterator<DummyBailOutChecker, ThisType> iter (*this, i); iter.next();)
+                    callback (*iter.getListener());
+
+                return;
+            }
+        }
+    }
+
+    void endBatch()
+    {
+        typename ArrayType::ScopedLockType lock (listeners.getLock());
+
+        if (--batchDepth > 0 || batchedCallbacks.isEmpty())
+            return;
+
+        // Moving the queue aside means that any call() made from inside one of
+        // these callbacks is delivered immediately rather than re-queued.
+        Array<std::function<void (ListenerClass&)>> callbacksToDeliver;
+        callbacksToDeliver.swapWith (batchedCallbacks);
+
+        callNow ([&] (ListenerClass& l)
+        {
+            for (auto& fn : callbacksToDeliver)
+                fn (l);
+        });
+    }
 
     JUCE_DECLARE_NON_COPYABLE (ListenerList)
 };
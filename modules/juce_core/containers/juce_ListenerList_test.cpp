@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct ListenerListTest  : public UnitTest
+{
+    ListenerListTest()
+        : UnitTest ("ListenerList", UnitTestCategories::containers)
+    {}
+
+    struct TestListener
+    {
+        void changed (int value)    { values.add (value); }
+
+        Array<int> values;
+    };
+
+    void runTest() override
+    {
+        beginTest ("Basic call");
+        {
+            TestListener a, b, c;
+            ListenerList<TestListener> list;
+            list.add (&a);
+            list.add (&b);
+            list.add (&c);
+
+            list.call ([] (TestListener& l) { l.changed (1); });
+            list.call (&TestListener::changed, 2);
+
+            for (auto* l : { &a, &b, &c })
+            {
+                expectEquals (l->values.size(), 2);
+                expectEquals (l->values[0], 1);
+                expectEquals (l->values[1], 2);
+            }
+        }
+
+        beginTest ("Removal during a callback");
+        {
+            struct SelfRemovingListener  : public TestListener
+            {
+                void changedAndRemove (ListenerList<SelfRemovingListener>& list, int value)
+                {
+                    changed (value);
+
+                    if (shouldRemoveSelf)
+                        list.remove (this);
+                }
+
+                bool shouldRemoveSelf = false;
+            };
+
+            SelfRemovingListener a, b, c;
+            b.shouldRemoveSelf = true;
+
+            ListenerList<SelfRemovingListener> list;
+            list.add (&a);
+            list.add (&b);
+            list.add (&c);
+
+            list.call ([&] (SelfRemovingListener& l) { l.changedAndRemove (list, 1); });
+            list.call ([&] (SelfRemovingListener& l) { l.changedAndRemove (list, 2); });
+
+            expectEquals (list.size(), 2);
+            expectEquals (b.values.size(), 1);
+            expectEquals (a.values.size(), 2);
+            expectEquals (c.values.size(), 2);
+        }
+
+        beginTest ("Batched notification");
+        {
+            TestListener a, b;
+            ListenerList<TestListener> list;
+            list.add (&a);
+            list.add (&b);
+
+            {
+                ListenerList<TestListener>::ScopedBatchNotification batch (list);
+
+                list.call ([] (TestListener& l) { l.changed (1); });
+                list.call (&TestListener::changed, 2);
+                list.call ([] (TestListener& l) { l.changed (3); });
+
+                // Nothing should have been delivered yet...
+                expectEquals (a.values.size(), 0);
+                expectEquals (b.values.size(), 0);
+            }
+
+            // ...and each listener should now have received all the queued
+            // callbacks, in the order they were issued.
+            for (auto* l : { &a, &b })
+            {
+                expectEquals (l->values.size(), 3);
+                expectEquals (l->values[0], 1);
+                expectEquals (l->values[1], 2);
+                expectEquals (l->values[2], 3);
+            }
+        }
+
+        beginTest ("Nested batches deliver once");
+        {
+            TestListener a;
+            ListenerList<TestListener> list;
+            list.add (&a);
+
+            {
+                ListenerList<TestListener>::ScopedBatchNotification outer (list);
+
+                {
+                    ListenerList<TestListener>::ScopedBatchNotification inner (list);
+                    list.call ([] (TestListener& l) { l.changed (1); });
+                }
+
+                // The outer batch is still alive, so nothing is delivered yet.
+                expectEquals (a.values.size(), 0);
+
+                list.call ([] (TestListener& l) { l.changed (2); });
+            }
+
+            expectEquals (a.values.size(), 2);
+            expectEquals (a.values[0], 1);
+            expectEquals (a.values[1], 2);
+        }
+
+        beginTest ("Removal during batched delivery");
+        {
+            TestListener a, b, c;
+            ListenerList<TestListener> list;
+            list.add (&a);
+            list.add (&b);
+            list.add (&c);
+
+            {
+                ListenerList<TestListener>::ScopedBatchNotification batch (list);
+
+                list.call ([] (TestListener& l) { l.changed (1); });
+                list.call ([&] (TestListener& l)
+                {
+                    l.changed (2);
+
+                    if (&l == &b)
+                        list.remove (&b);
+                });
+            }
+
+            expectEquals (list.size(), 2);
+            expectEquals (b.values.size(), 2);
+
+            for (auto* l : { &a, &c })
+            {
+                expectEquals (l->values.size(), 2);
+                expectEquals (l->values[0], 1);
+                expectEquals (l->values[1], 2);
+            }
+        }
+    }
+};
+
+static ListenerListTest listenerListTest;
+
+} // namespace juce
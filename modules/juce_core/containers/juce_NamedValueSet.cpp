@@ -165,6 +165,15 @@ const var* NamedValueSet::getVarPointer (const Identifier& name) const noexcept
     return {};
 }
 
+const var* NamedValueSet::getVarPointerFromString (StringRef name) const noexcept
+{
+    for (auto& i : values)
+        if (i.name == name)
+            return &(i.value);
+
+    return {};
+}
+
 bool NamedValueSet::set (const Identifier& name, var&& newValue)
 {
     if (auto* v = getVarPointer (name))
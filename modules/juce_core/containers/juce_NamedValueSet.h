@@ -143,6 +143,16 @@ public:
     */
     const var* getVarPointer (const Identifier& name) const noexcept;
 
+    /** Returns a pointer to the var that holds a named value, or null if there is
+        no value with this name, comparing the name as a raw string.
+
+        Unlike getVarPointer(), this doesn't require an Identifier, so the caller
+        avoids interning the name in the global string pool just to do a lookup -
+        useful in parsing code that probes for attributes which may not exist.
+        The same caveats about the lifetime of the returned pointer apply.
+    */
+    const var* getVarPointerFromString (StringRef name) const noexcept;
+
     /** Returns the value of the item at a given index.
         The index must be between 0 and size() - 1.
     */
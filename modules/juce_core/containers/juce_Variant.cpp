@@ -32,8 +32,9 @@ enum VariantStreamMarkers
     varMarker_String    = 5,
     varMarker_Int64     = 6,
     varMarker_Array     = 7,
-    varMarker_Binary    = 8,
-    varMarker_Undefined = 9
+    varMarker_Binary      = 8,
+    varMarker_Undefined   = 9,
+    varMarker_DoubleArray = 10
 };
 
 //==============================================================================
@@ -47,9 +48,10 @@ struct var::VariantType
     struct BoolTag      {};
     struct StringTag    {};
     struct ObjectTag    {};
-    struct ArrayTag     {};
-    struct BinaryTag    {};
-    struct MethodTag    {};
+    struct ArrayTag       {};
+    struct DoubleArrayTag {};
+    struct BinaryTag      {};
+    struct MethodTag      {};
 
     // members =====================================================================
     bool isVoid         = false;
@@ -61,6 +63,7 @@ struct var::VariantType
     bool isString       = false;
     bool isObject       = false;
     bool isArray        = false;
+    bool isDoubleArray  = false;
     bool isBinary       = false;
     bool isMethod       = false;
     bool isComparable   = false;
@@ -72,6 +75,7 @@ struct var::VariantType
     bool                    (*toBool)        (const ValueUnion&)                 = defaultToBool;
     ReferenceCountedObject* (*toObject)      (const ValueUnion&)                 = defaultToObject;
     Array<var>*             (*toArray)       (const ValueUnion&)                 = defaultToArray;
+    Array<double>*          (*toDoubleArray) (const ValueUnion&)                 = defaultToDoubleArray;
     MemoryBlock*            (*toBinary)      (const ValueUnion&)                 = defaultToBinary;
     var                     (*clone)         (const var&)                        = defaultClone;
     void                    (*cleanUp)       (ValueUnion&)                       = defaultCleanUp;
@@ -88,6 +92,7 @@ struct var::VariantType
     static bool                    defaultToBool        (const ValueUnion&)                          { return false; }
     static ReferenceCountedObject* defaultToObject      (const ValueUnion&)                          { return nullptr; }
     static Array<var>*             defaultToArray       (const ValueUnion&)                          { return nullptr; }
+    static Array<double>*          defaultToDoubleArray (const ValueUnion&)                          { return nullptr; }
     static MemoryBlock*            defaultToBinary      (const ValueUnion&)                          { return nullptr; }
     static var                     defaultClone         (const var& other)                           { return other; }
     static void                    defaultCleanUp       (ValueUnion&)                                {}
@@ -421,6 +426,66 @@ struct var::VariantType
           equals        (arrayEquals),
           writeToStream (arrayWriteToStream) {}
 
+    // double array ================================================================
+    // Unlike a normal array, which boxes each element as a var behind a
+    // refcounted object, this stores its elements as one contiguous,
+    // shareable block of doubles.
+    struct RefCountedDoubleArray  : public ReferenceCountedObject
+    {
+        RefCountedDoubleArray (const Array<double>& a)  : array (a)  { incReferenceCount(); }
+        RefCountedDoubleArray (Array<double>&& a)  : array (std::move (a))  { incReferenceCount(); }
+        Array<double> array;
+    };
+
+    static Array<double>* doubleArrayToDoubleArray (const ValueUnion& data) noexcept
+    {
+        if (auto* a = dynamic_cast<RefCountedDoubleArray*> (data.objectValue))
+            return &(a->array);
+
+        return nullptr;
+    }
+
+    static bool doubleArrayEquals (const ValueUnion& data, const ValueUnion& otherData, const VariantType& otherType) noexcept
+    {
+        auto* thisArray = doubleArrayToDoubleArray (data);
+        auto* otherArray = otherType.toDoubleArray (otherData);
+        return thisArray == otherArray || (thisArray != nullptr && otherArray != nullptr && *otherArray == *thisArray);
+    }
+
+    static var doubleArrayClone (const var& original)
+    {
+        if (auto* array = doubleArrayToDoubleArray (original.value))
+            return var (*array);
+
+        return {};
+    }
+
+    static void doubleArrayWriteToStream (const ValueUnion& data, OutputStream& output)
+    {
+        if (auto* array = doubleArrayToDoubleArray (data))
+        {
+            output.writeCompressedInt (5 + 8 * array->size());
+            output.writeByte (varMarker_DoubleArray);
+            output.writeInt (array->size());
+
+            for (auto d : *array)
+                output.writeDouble (d);
+        }
+    }
+
+    constexpr explicit VariantType (DoubleArrayTag) noexcept
+        : isObject      (true),
+          isDoubleArray (true),
+          toString      (arrayToString),
+          toBool        (objectToBool),
+          toObject      (arrayToObject),
+          toDoubleArray (doubleArrayToDoubleArray),
+          clone         (doubleArrayClone),
+          cleanUp       (objectCleanUp),
+          createCopy    (objectCreateCopy),
+          equals        (doubleArrayEquals),
+          writeToStream (doubleArrayWriteToStream) {}
+
     // binary ======================================================================
     static void binaryCleanUp    (ValueUnion& data) noexcept                    { delete data.binaryValue; }
     static void binaryCreateCopy (ValueUnion& dest, const ValueUnion& source)   { dest.binaryValue = new MemoryBlock (*source.binaryValue); }
@@ -488,6 +553,7 @@ struct var::Instance
     static constexpr VariantType attributesDouble         { VariantType::DoubleTag{} };
     static constexpr VariantType attributesMethod         { VariantType::MethodTag{} };
     static constexpr VariantType attributesArray          { VariantType::ArrayTag{} };
+    static constexpr VariantType attributesDoubleArray    { VariantType::DoubleArrayTag{} };
     static constexpr VariantType attributesString         { VariantType::StringTag{} };
     static constexpr VariantType attributesBinary         { VariantType::BinaryTag{} };
     static constexpr VariantType attributesObject         { VariantType::ObjectTag{} };
@@ -501,6 +567,7 @@ constexpr var::VariantType var::Instance::attributesBool;
 constexpr var::VariantType var::Instance::attributesDouble;
 constexpr var::VariantType var::Instance::attributesMethod;
 constexpr var::VariantType var::Instance::attributesArray;
+constexpr var::VariantType var::Instance::attributesDoubleArray;
 constexpr var::VariantType var::Instance::attributesString;
 constexpr var::VariantType var::Instance::attributesBinary;
 constexpr var::VariantType var::Instance::attributesObject;
@@ -522,6 +589,7 @@ var::var (const bool v) noexcept      : type (&Instance::attributesBool)   { val
 var::var (const double v) noexcept    : type (&Instance::attributesDouble) { value.doubleValue = v; }
 var::var (NativeFunction m) noexcept  : type (&Instance::attributesMethod) { value.methodValue = new NativeFunction (m); }
 var::var (const Array<var>& v)        : type (&Instance::attributesArray)  { value.objectValue = new VariantType::RefCountedArray (v); }
+var::var (const Array<double>& v)     : type (&Instance::attributesDoubleArray) { value.objectValue = new VariantType::RefCountedDoubleArray (v); }
 var::var (const String& v)            : type (&Instance::attributesString) { new (value.stringValue) String (v); }
 var::var (const char* const v)        : type (&Instance::attributesString) { new (value.stringValue) String (v); }
 var::var (const wchar_t* const v)     : type (&Instance::attributesString) { new (value.stringValue) String (v); }
@@ -559,6 +627,7 @@ bool var::isDouble() const noexcept     { return type->isDouble; }
 bool var::isString() const noexcept     { return type->isString; }
 bool var::isObject() const noexcept     { return type->isObject; }
 bool var::isArray() const noexcept      { return type->isArray; }
+bool var::isDoubleArray() const noexcept { return type->isDoubleArray; }
 bool var::isBinaryData() const noexcept { return type->isBinary; }
 bool var::isMethod() const noexcept     { return type->isMethod; }
 
@@ -571,6 +640,7 @@ String var::toString() const                            { return type->toString
 var::operator String() const                            { return type->toString (value); }
 ReferenceCountedObject* var::getObject() const noexcept { return type->toObject (value); }
 Array<var>* var::getArray() const noexcept              { return type->toArray (value); }
+Array<double>* var::getDoubleArray() const noexcept     { return type->toDoubleArray (value); }
 MemoryBlock* var::getBinaryData() const noexcept        { return type->toBinary (value); }
 DynamicObject* var::getDynamicObject() const noexcept   { return dynamic_cast<DynamicObject*> (getObject()); }
 
@@ -591,6 +661,7 @@ var& var::operator= (const wchar_t* const v)     { type->cleanUp (value); type =
 var& var::operator= (const String& v)            { type->cleanUp (value); type = &Instance::attributesString; new (value.stringValue) String (v); return *this; }
 var& var::operator= (const MemoryBlock& v)       { type->cleanUp (value); type = &Instance::attributesBinary; value.binaryValue = new MemoryBlock (v); return *this; }
 var& var::operator= (const Array<var>& v)        { var v2 (v); swapWith (v2); return *this; }
+var& var::operator= (const Array<double>& v)     { var v2 (v); swapWith (v2); return *this; }
 var& var::operator= (ReferenceCountedObject* v)  { var v2 (v); swapWith (v2); return *this; }
 var& var::operator= (NativeFunction v)           { var v2 (v); swapWith (v2); return *this; }
 
@@ -622,6 +693,11 @@ var::var (Array<var>&& v)  : type (&Instance::attributesArray)
     value.objectValue = new VariantType::RefCountedArray (std::move (v));
 }
 
+var::var (Array<double>&& v)  : type (&Instance::attributesDoubleArray)
+{
+    value.objectValue = new VariantType::RefCountedDoubleArray (std::move (v));
+}
+
 var& var::operator= (String&& v)
 {
     type->cleanUp (value);
@@ -761,6 +837,9 @@ int var::size() const
     if (auto array = getArray())
         return array->size();
 
+    if (auto doubles = getDoubleArray())
+        return doubles->size();
+
     return 0;
 }
 
@@ -869,6 +948,18 @@ var var::readFromStream (InputStream& input)
                 return var (mb);
             }
 
+            case varMarker_DoubleArray:
+            {
+                Array<double> doubles;
+                auto numElements = input.readInt();
+                doubles.ensureStorageAllocated (numElements);
+
+                while (--numElements >= 0)
+                    doubles.add (input.readDouble());
+
+                return var (std::move (doubles));
+            }
+
             case varMarker_Array:
             {
                 var v;
@@ -906,4 +997,73 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 
 #endif
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class VariantTests  : public UnitTest
+{
+public:
+    VariantTests()
+        : UnitTest ("Variant", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Double arrays");
+        {
+            Array<double> doubles { 1.0, 2.5, -4.0 };
+
+            var v (doubles);
+            expect (v.isDoubleArray());
+            expect (! v.isArray());
+            expectEquals (v.size(), 3);
+            expect (v.getArray() == nullptr);
+
+            auto* stored = v.getDoubleArray();
+            expect (stored != nullptr && *stored == doubles);
+
+            // copies share the same underlying buffer
+            var copy (v);
+            expect (copy.getDoubleArray() == v.getDoubleArray());
+            expect (copy.equals (v));
+
+            // but clones don't
+            auto cloned = v.clone();
+            expect (cloned.getDoubleArray() != v.getDoubleArray());
+            expect (cloned.equals (v));
+        }
+
+        beginTest ("Double array streaming");
+        {
+            Array<double> doubles;
+
+            for (int i = 0; i < 1000; ++i)
+                doubles.add (i * 0.25);
+
+            MemoryOutputStream out;
+            var (doubles).writeToStream (out);
+            out.writeInt (0x12345678); // make sure the reader stops in the right place
+
+            MemoryInputStream in (out.getData(), out.getDataSize(), false);
+            auto restored = var::readFromStream (in);
+
+            expect (restored.isDoubleArray());
+            expect (*restored.getDoubleArray() == doubles);
+            expectEquals (in.readInt(), 0x12345678);
+        }
+
+        beginTest ("Double arrays as JSON");
+        {
+            var v (Array<double> { 1.0, 2.5 });
+            expectEquals (JSON::toString (v, true), String ("[1.0, 2.5]"));
+        }
+    }
+};
+
+static VariantTests variantTests;
+
+#endif
+
 } // namespace juce
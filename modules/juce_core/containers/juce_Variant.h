@@ -72,6 +72,7 @@ public:
     var (const wchar_t* value);
     var (const String& value);
     var (const Array<var>& value);
+    var (const Array<double>& value);
     var (const StringArray& value);
     var (ReferenceCountedObject* object);
     var (NativeFunction method) noexcept;
@@ -88,6 +89,7 @@ public:
     var& operator= (const String& value);
     var& operator= (const MemoryBlock& value);
     var& operator= (const Array<var>& value);
+    var& operator= (const Array<double>& value);
     var& operator= (ReferenceCountedObject* object);
     var& operator= (NativeFunction method);
 
@@ -95,6 +97,7 @@ public:
     var (String&&);
     var (MemoryBlock&&);
     var (Array<var>&&);
+    var (Array<double>&&);
     var& operator= (var&&) noexcept;
     var& operator= (String&&);
 
@@ -120,6 +123,20 @@ public:
     */
     Array<var>* getArray() const noexcept;
 
+    /** If this variant holds a packed double array, this provides access to it.
+
+        Unlike a normal array var, which boxes every element as a separate var, a
+        double-array var stores its elements as one contiguous block of doubles, so
+        it's a much more compact way of passing around large numeric datasets.
+        You can create one by constructing or assigning a var from an Array<double>.
+
+        NOTE: Beware when you use this - the array pointer is only valid for the lifetime
+        of the variant that returned it, so be very careful not to call this method on temporary
+        var objects that are the return-value of a function, and which may go out of scope before
+        you use the array!
+    */
+    Array<double>* getDoubleArray() const noexcept;
+
     /** If this variant holds a memory block, this provides access to it.
         NOTE: Beware when you use this - the MemoryBlock pointer is only valid for the lifetime
         of the variant that returned it, so be very careful not to call this method on temporary
@@ -141,6 +158,7 @@ public:
     bool isString() const noexcept;
     bool isObject() const noexcept;
     bool isArray() const noexcept;
+    bool isDoubleArray() const noexcept;
     bool isBinaryData() const noexcept;
     bool isMethod() const noexcept;
 
@@ -80,63 +80,86 @@ struct JSONParser
         return {};
     }
 
-    String parseString (const juce_wchar quoteChar)
+    // reads the next decoded character of a string constant, returning 0 when
+    // the closing quote is reached
+    juce_wchar readNextStringChar (const juce_wchar quoteChar)
     {
-        MemoryOutputStream buffer (256);
+        auto c = readChar();
 
-        for (;;)
-        {
-            auto c = readChar();
+        if (c == quoteChar)
+            return 0;
 
-            if (c == quoteChar)
-                break;
+        if (c == '\\')
+        {
+            auto errorLocation = currentLocation;
+            c = readChar();
 
-            if (c == '\\')
+            switch (c)
             {
-                auto errorLocation = currentLocation;
-                c = readChar();
-
-                switch (c)
+                case '"':
+                case '\'':
+                case '\\':
+                case '/':  break;
+
+                case 'a':  c = '\a'; break;
+                case 'b':  c = '\b'; break;
+                case 'f':  c = '\f'; break;
+                case 'n':  c = '\n'; break;
+                case 'r':  c = '\r'; break;
+                case 't':  c = '\t'; break;
+
+                case 'u':
                 {
-                    case '"':
-                    case '\'':
-                    case '\\':
-                    case '/':  break;
-
-                    case 'a':  c = '\a'; break;
-                    case 'b':  c = '\b'; break;
-                    case 'f':  c = '\f'; break;
-                    case 'n':  c = '\n'; break;
-                    case 'r':  c = '\r'; break;
-                    case 't':  c = '\t'; break;
-
-                    case 'u':
-                    {
-                        c = 0;
-
-                        for (int i = 4; --i >= 0;)
-                        {
-                            auto digitValue = CharacterFunctions::getHexDigitValue (readChar());
+                    c = 0;
 
-                            if (digitValue < 0)
-                                throwError ("Syntax error in unicode escape sequence", errorLocation);
+                    for (int i = 4; --i >= 0;)
+                    {
+                        auto digitValue = CharacterFunctions::getHexDigitValue (readChar());
 
-                            c = (juce_wchar) ((c << 4) + static_cast<juce_wchar> (digitValue));
-                        }
+                        if (digitValue < 0)
+                            throwError ("Syntax error in unicode escape sequence", errorLocation);
 
-                        break;
+                        c = (juce_wchar) ((c << 4) + static_cast<juce_wchar> (digitValue));
                     }
 
-                    default:  break;
+                    break;
                 }
+
+                default:  break;
             }
+        }
 
-            if (c == 0)
-                throwError ("Unexpected EOF in string constant", currentLocation);
+        if (c == 0)
+            throwError ("Unexpected EOF in string constant", currentLocation);
 
-            buffer.appendUTF8Char (c);
+        return c;
+    }
+
+    String parseString (const juce_wchar quoteChar)
+    {
+        // fast path: a string without any escape sequences can be created
+        // directly from the source text, without an intermediate buffer
+        for (auto p = currentLocation;;)
+        {
+            auto charStart = p;
+            auto c = p.getAndAdvance();
+
+            if (c == quoteChar)
+            {
+                String result (currentLocation, charStart);
+                currentLocation = p;
+                return result;
+            }
+
+            if (c == '\\' || c == 0)
+                break;
         }
 
+        MemoryOutputStream buffer (256);
+
+        while (auto c = readNextStringChar (quoteChar))
+            buffer.appendUTF8Char (c);
+
         return buffer.toUTF8();
     }
 
@@ -301,6 +324,139 @@ struct JSONParser
 
         return result;
     }
+
+    //==============================================================================
+    // The methods below move over values without materialising anything - they're
+    // used by JSONCursor to scan a document in place.
+
+    // reads a string constant, comparing it against the given name rather than
+    // building a String
+    bool matchStringConstant (StringRef name, const juce_wchar quoteChar)
+    {
+        auto n = name.text;
+        bool matches = true;
+
+        while (auto c = readNextStringChar (quoteChar))
+            matches = matches && ! n.isEmpty() && n.getAndAdvance() == c;
+
+        return matches && n.isEmpty();
+    }
+
+    void skipAny()
+    {
+        skipWhitespace();
+        auto originalLocation = currentLocation;
+
+        switch (readChar())
+        {
+            case '{':    skipObject();       return;
+            case '[':    skipArray();        return;
+            case '"':    skipString ('"');   return;
+            case '\'':   skipString ('\'');  return;
+
+            case '-':
+            case '0': case '1': case '2': case '3': case '4':
+            case '5': case '6': case '7': case '8': case '9':
+                skipNumber();
+                return;
+
+            case 't':   if (matchString ("rue"))  return;  break;   // "true"
+            case 'f':   if (matchString ("alse")) return;  break;   // "false"
+            case 'n':   if (matchString ("ull"))  return;  break;   // "null"
+
+            default:    break;
+        }
+
+        throwError ("Syntax error", originalLocation);
+    }
+
+    void skipString (const juce_wchar quoteChar)
+    {
+        while (readNextStringChar (quoteChar) != 0)
+        {}
+    }
+
+    void skipNumber()
+    {
+        for (;;)
+        {
+            auto lastPos = currentLocation;
+            auto c = readChar();
+
+            if (isPositiveAndBelow (((int) c) - '0', 10)
+                 || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-')
+                continue;
+
+            if (CharacterFunctions::isWhitespace (c)
+                 || c == ',' || c == '}' || c == ']' || c == 0)
+            {
+                currentLocation = lastPos;
+                return;
+            }
+
+            throwError ("Syntax error in number", lastPos);
+        }
+    }
+
+    void skipObject()
+    {
+        auto startOfObjectDecl = currentLocation;
+
+        for (;;)
+        {
+            skipWhitespace();
+            auto errorLocation = currentLocation;
+            auto c = readChar();
+
+            if (c == '}')
+                return;
+
+            if (c == 0)
+                throwError ("Unexpected EOF in object declaration", startOfObjectDecl);
+
+            if (c != '"')
+                throwError ("Expected a property name in double-quotes", errorLocation);
+
+            skipString ('"');
+            skipWhitespace();
+            errorLocation = currentLocation;
+
+            if (readChar() != ':')
+                throwError ("Expected ':'", errorLocation);
+
+            skipAny();
+            skipWhitespace();
+
+            if (matchIf (',')) continue;
+            if (matchIf ('}')) return;
+
+            throwError ("Expected ',' or '}'", currentLocation);
+        }
+    }
+
+    void skipArray()
+    {
+        auto startOfArrayDecl = currentLocation;
+
+        for (;;)
+        {
+            skipWhitespace();
+
+            if (matchIf (']'))
+                return;
+
+            if (isEOF())
+                throwError ("Unexpected EOF in array declaration", startOfArrayDecl);
+
+            skipAny();
+            skipWhitespace();
+
+            if (matchIf (',')) continue;
+            if (matchIf (']')) return;
+
+            throwError ("Expected ',' or ']'", currentLocation);
+        }
+    }
 };
 
 //==============================================================================
@@ -344,6 +500,21 @@ struct JSONFormatter
         {
             writeArray (out, *v.getArray(), indentLevel, allOnOneLine, maximumDecimalPlaces);
         }
+        else if (v.isDoubleArray())
+        {
+            auto& doubles = *v.getDoubleArray();
+            out << '[';
+
+            for (int i = 0; i < doubles.size(); ++i)
+            {
+                if (i > 0)
+                    out << ", ";
+
+                out << serialiseDouble (doubles.getReference (i));
+            }
+
+            out << ']';
+        }
         else if (v.isObject())
         {
             if (auto* object = v.getDynamicObject())
@@ -540,6 +711,212 @@ Result JSON::parseQuotedString (String::CharPointerType& t, var& result)
     return Result::ok();
 }
 
+//==============================================================================
+JSONCursor::JSONCursor (const String& jsonText)
+    : sourceText (jsonText), position (sourceText.getCharPointer())
+{
+    determineType();
+}
+
+JSONCursor::JSONCursor (const String& text, String::CharPointerType pos)
+    : sourceText (text), position (pos)
+{
+    determineType();
+}
+
+void JSONCursor::determineType()
+{
+    position = position.findEndOfWhitespace();
+
+    auto matchesLiteral = [this] (const char* t)
+    {
+        for (auto p = position; *t != 0;)
+            if (p.getAndAdvance() != (juce_wchar) *t++)
+                return false;
+
+        return true;
+    };
+
+    switch (*position)
+    {
+        case '{':    type = Type::object;   break;
+        case '[':    type = Type::array;    break;
+        case '"':
+        case '\'':   type = Type::string;   break;
+        case 't':    type = matchesLiteral ("true")  ? Type::boolean : Type::invalid;  break;
+        case 'f':    type = matchesLiteral ("false") ? Type::boolean : Type::invalid;  break;
+        case 'n':    type = matchesLiteral ("null")  ? Type::null    : Type::invalid;  break;
+        case '-':    type = Type::number;   break;
+
+        default:     type = CharacterFunctions::isDigit (*position) ? Type::number
+                                                                    : Type::invalid;
+            break;
+    }
+}
+
+JSONCursor JSONCursor::operator[] (StringRef propertyName) const
+{
+    if (type != Type::object)
+        return {};
+
+    try
+    {
+        JSONParser parser (position);
+        parser.skipWhitespace();
+        parser.readChar(); // the '{'
+
+        for (;;)
+        {
+            parser.skipWhitespace();
+
+            if (parser.readChar() != '"')
+                return {}; // '}', EOF, or malformed
+
+            const auto found = parser.matchStringConstant (propertyName, '"');
+            parser.skipWhitespace();
+
+            if (parser.readChar() != ':')
+                return {};
+
+            if (found)
+                return { sourceText, parser.currentLocation };
+
+            parser.skipAny();
+            parser.skipWhitespace();
+
+            if (! parser.matchIf (','))
+                return {};
+        }
+    }
+    catch (const JSONParser::ErrorException&) {}
+
+    return {};
+}
+
+JSONCursor JSONCursor::operator[] (int indexOfArrayElement) const
+{
+    if (type != Type::array || indexOfArrayElement < 0)
+        return {};
+
+    try
+    {
+        JSONParser parser (position);
+        parser.skipWhitespace();
+        parser.readChar(); // the '['
+
+        for (auto remaining = indexOfArrayElement;;)
+        {
+            parser.skipWhitespace();
+
+            if (parser.matchIf (']') || parser.isEOF())
+                return {};
+
+            if (remaining == 0)
+                return { sourceText, parser.currentLocation };
+
+            --remaining;
+            parser.skipAny();
+            parser.skipWhitespace();
+
+            if (! parser.matchIf (','))
+                return {};
+        }
+    }
+    catch (const JSONParser::ErrorException&) {}
+
+    return {};
+}
+
+int JSONCursor::getNumChildren() const
+{
+    int num = 0;
+
+    if (type == Type::array)
+        forEachElement ([&] (const JSONCursor&)  { ++num; });
+    else if (type == Type::object)
+        forEachProperty ([&] (const String&, const JSONCursor&)  { ++num; });
+
+    return num;
+}
+
+void JSONCursor::forEachElement (const std::function<void (const JSONCursor&)>& callback) const
+{
+    if (type != Type::array)
+        return;
+
+    try
+    {
+        JSONParser parser (position);
+        parser.skipWhitespace();
+        parser.readChar(); // the '['
+
+        for (;;)
+        {
+            parser.skipWhitespace();
+
+            if (parser.matchIf (']') || parser.isEOF())
+                return;
+
+            callback (JSONCursor (sourceText, parser.currentLocation));
+            parser.skipAny();
+            parser.skipWhitespace();
+
+            if (! parser.matchIf (','))
+                return;
+        }
+    }
+    catch (const JSONParser::ErrorException&) {}
+}
+
+void JSONCursor::forEachProperty (const std::function<void (const String&, const JSONCursor&)>& callback) const
+{
+    if (type != Type::object)
+        return;
+
+    try
+    {
+        JSONParser parser (position);
+        parser.skipWhitespace();
+        parser.readChar(); // the '{'
+
+        for (;;)
+        {
+            parser.skipWhitespace();
+
+            if (parser.readChar() != '"')
+                return; // '}', EOF, or malformed
+
+            auto name = parser.parseString ('"');
+            parser.skipWhitespace();
+
+            if (parser.readChar() != ':')
+                return;
+
+            callback (name, JSONCursor (sourceText, parser.currentLocation));
+            parser.skipAny();
+            parser.skipWhitespace();
+
+            if (! parser.matchIf (','))
+                return;
+        }
+    }
+    catch (const JSONParser::ErrorException&) {}
+}
+
+var JSONCursor::getValue() const
+{
+    if (type == Type::invalid)
+        return {};
+
+    try
+    {
+        return JSONParser (position).parseAny();
+    }
+    catch (const JSONParser::ErrorException&) {}
+
+    return {};
+}
+
 
 //==============================================================================
 //==============================================================================
@@ -658,9 +1035,70 @@ public:
                 var parsed = JSON::parse ("[" + asString + "]")[0];
                 String parsedString (JSON::toString (parsed, oneLine));
                 expect (asString.isNotEmpty() && parsedString == asString);
+
+                // scanning over the first element to reach the second should
+                // produce an identical value
+                var scanned = JSONCursor ("[" + asString + ", " + asString + "]")[1].getValue();
+                expectEquals (JSON::toString (scanned, oneLine), asString);
             }
         }
 
+        {
+            beginTest ("JSONCursor");
+
+            auto doc = String ("{ \"name\": \"fred\", \"count\": 3, \"empty\": {}, "
+                               "\"scores\": [10, 20.5, { \"deep\": \"value\" }], "
+                               "\"flag\\u0041\": true, \"nothing\": null }");
+
+            JSONCursor root (doc);
+            expect (root.getType() == JSONCursor::Type::object);
+            expectEquals (root.getNumChildren(), 6);
+
+            expect (root["name"].getType() == JSONCursor::Type::string);
+            expectEquals (root["name"].getValue().toString(), String ("fred"));
+
+            expect (root["count"].getType() == JSONCursor::Type::number);
+            expectEquals ((int) root["count"].getValue(), 3);
+
+            expectEquals (root["empty"].getNumChildren(), 0);
+
+            // the key is escaped in the document, but should still match
+            expect (root["flagA"].getType() == JSONCursor::Type::boolean);
+            expect ((bool) root["flagA"].getValue());
+
+            expect (root["nothing"].getType() == JSONCursor::Type::null);
+            expect (! root["nonexistent"].isValid());
+            expect (! root["name"]["x"].isValid());
+            expect (! JSONCursor ("nonsense").isValid());
+
+            auto scores = root["scores"];
+            expect (scores.getType() == JSONCursor::Type::array);
+            expectEquals (scores.getNumChildren(), 3);
+            expectEquals ((int) scores[0].getValue(), 10);
+            expectEquals ((double) scores[1].getValue(), 20.5);
+            expectEquals (scores[2]["deep"].getValue().toString(), String ("value"));
+            expect (! scores[3].isValid());
+            expect (! scores[-1].isValid());
+
+            int numElements = 0;
+            double total = 0;
+
+            scores.forEachElement ([&] (const JSONCursor& c)
+            {
+                ++numElements;
+
+                if (c.getType() == JSONCursor::Type::number)
+                    total += (double) c.getValue();
+            });
+
+            expectEquals (numElements, 3);
+            expectEquals (total, 30.5);
+
+            StringArray names;
+            root.forEachProperty ([&] (const String& name, const JSONCursor&)  { names.add (name); });
+            expectEquals (names.joinIntoString (","), String ("name,count,empty,scores,flagA,nothing"));
+        }
+
         {
             beginTest ("Float formatting");
 
@@ -133,4 +133,108 @@ private:
     JSON() = delete; // This class can't be instantiated - just use its static methods.
 };
 
+//==============================================================================
+/**
+    A lightweight read-only cursor for scanning values inside JSON-formatted
+    text without materialising it.
+
+    JSON::parse() builds a full tree of vars, DynamicObjects and property sets,
+    which for very large documents can cost far more than the scan itself. A
+    JSONCursor just points at a position inside the original text - moving to a
+    property or an array element scans forwards over the text, and nothing is
+    allocated until you actually materialise a value with getValue().
+
+    e.g. @code
+    JSONCursor root (jsonText);
+    auto name = root["user"]["name"].getValue().toString();
+    @endcode
+
+    Each navigation step re-scans the children of its parent node, so to visit
+    every child of a large object or array, iterate with forEachProperty() or
+    forEachElement(), or materialise that one subtree with getValue().
+
+    A cursor keeps a reference to the text it was created from, so copies of it
+    remain valid after the original String has gone out of scope.
+
+    Scanning is lenient - the type of a value is judged from its leading
+    characters, and text that is skipped over isn't fully validated. If you need
+    to check a document for errors, use JSON::parse().
+
+    @see JSON, var
+
+    @tags{Core}
+*/
+class JUCE_API  JSONCursor
+{
+public:
+    //==============================================================================
+    /** The kind of value a cursor is pointing at. */
+    enum class Type
+    {
+        invalid,     /**< The cursor doesn't point at a value - e.g. a property or
+                          element that was asked for didn't exist. */
+        object,      /**< An object, written as { ... } */
+        array,       /**< An array, written as [ ... ] */
+        string,      /**< A quoted string constant. */
+        number,      /**< An integer or floating-point number. */
+        boolean,     /**< The literal true or false. */
+        null         /**< The literal null. */
+    };
+
+    /** Creates a cursor pointing at the first value in the given text. */
+    explicit JSONCursor (const String& jsonText);
+
+    /** Creates an invalid cursor. */
+    JSONCursor() = default;
+
+    //==============================================================================
+    /** Returns the type of the value this cursor points at. */
+    Type getType() const noexcept           { return type; }
+
+    /** Returns true if this cursor points at a value of any type. */
+    bool isValid() const noexcept           { return type != Type::invalid; }
+
+    //==============================================================================
+    /** Returns a cursor for a named property of an object.
+        If this isn't an object, or no such property exists, the result will
+        be an invalid cursor.
+    */
+    JSONCursor operator[] (StringRef propertyName) const;
+
+    /** Returns a cursor for an element of an array.
+        If this isn't an array, or the index is out of range, the result will
+        be an invalid cursor.
+    */
+    JSONCursor operator[] (int indexOfArrayElement) const;
+
+    /** Counts the properties of an object or the elements of an array.
+        This scans the whole of the value, so is O(n) in its length.
+    */
+    int getNumChildren() const;
+
+    /** Calls a functor for each element of an array, in order. */
+    void forEachElement (const std::function<void (const JSONCursor&)>& callback) const;
+
+    /** Calls a functor for each property of an object, in order. */
+    void forEachProperty (const std::function<void (const String& name, const JSONCursor&)>& callback) const;
+
+    //==============================================================================
+    /** Parses and returns the value this cursor points at.
+
+        This materialises just this value (and, for objects and arrays,
+        everything inside it), returning void if the cursor is invalid or the
+        text is malformed.
+    */
+    var getValue() const;
+
+private:
+    //==============================================================================
+    JSONCursor (const String&, String::CharPointerType);
+    void determineType();
+
+    String sourceText;
+    String::CharPointerType position { nullptr };
+    Type type = Type::invalid;
+};
+
 } // namespace juce
@@ -75,6 +75,18 @@ struct JavascriptEngine::RootObject   : public DynamicObject
     using Args = const var::NativeFunctionArgs&;
     using TokenType = const char*;
 
+    struct Expression;
+
+    struct CachedExpression
+    {
+        int64 hash;
+        String source;
+        std::unique_ptr<Expression> expression;
+    };
+
+    enum { maxNumCompiledExpressions = 64 };
+    OwnedArray<CachedExpression> compiledExpressions;
+
     void execute (const String& code)
     {
         ExpressionTreeBuilder tb (code);
@@ -83,8 +95,38 @@ struct JavascriptEngine::RootObject   : public DynamicObject
 
     var evaluate (const String& code)
     {
+        return getCompiledExpression (code)->getResult (Scope ({}, *this, *this));
+    }
+
+    /** Expression trees are stateless once parsed, so frequently-evaluated
+        snippets can skip the parser entirely. The cache is a small MRU list
+        keyed by the source hash, checked against the full source to be safe.
+    */
+    Expression* getCompiledExpression (const String& code)
+    {
+        auto hash = code.hashCode64();
+
+        for (int i = 0; i < compiledExpressions.size(); ++i)
+        {
+            auto* cached = compiledExpressions.getUnchecked (i);
+
+            if (cached->hash == hash && cached->source == code)
+            {
+                if (i > 0)
+                    compiledExpressions.move (i, 0);
+
+                return cached->expression.get();
+            }
+        }
+
         ExpressionTreeBuilder tb (code);
-        return ExpPtr (tb.parseExpression())->getResult (Scope ({}, *this, *this));
+        auto* compiled = new CachedExpression { hash, code, ExpPtr (tb.parseExpression()) };
+        compiledExpressions.insert (0, compiled);
+
+        while (compiledExpressions.size() > maxNumCompiledExpressions)
+            compiledExpressions.removeLast();
+
+        return compiled->expression.get();
     }
 
     //==============================================================================
@@ -498,7 +540,14 @@ struct JavascriptEngine::RootObject   : public DynamicObject
 
         var getResult (const Scope& s) const override
         {
-            var a (lhs->getResult (s)), b (rhs->getResult (s));
+            return getResultFor (lhs->getResult (s), rhs->getResult (s));
+        }
+
+        var getResultFor (const var& a, const var& b) const
+        {
+            // Fast paths for the overwhelmingly common all-numeric cases
+            if (a.isDouble() && b.isDouble())   return getWithDoubles (a, b);
+            if (a.isInt()    && b.isInt())      return getWithInts (a, b);
 
             if ((a.isUndefined() || a.isVoid()) && (b.isUndefined() || b.isVoid()))
                 return getWithUndefinedArg();
@@ -1418,10 +1467,31 @@ struct JavascriptEngine::RootObject   : public DynamicObject
             return f.release();
         }
 
+        template <typename OpType>
+        Expression* newBinaryOp (ExpPtr& a, ExpPtr& b)
+        {
+            std::unique_ptr<OpType> op (new OpType (location, a, b));
+
+            // Fold operators whose operands are both literals down to a single literal
+            if (auto* lhsLiteral = dynamic_cast<LiteralValue*> (op->lhs.get()))
+            {
+                if (auto* rhsLiteral = dynamic_cast<LiteralValue*> (op->rhs.get()))
+                {
+                    try
+                    {
+                        return new LiteralValue (op->location, op->getResultFor (lhsLiteral->value, rhsLiteral->value));
+                    }
+                    catch (String&) {} // ..if the fold would fail, let it fail at run time instead
+                }
+            }
+
+            return op.release();
+        }
+
         Expression* parseUnary()
         {
-            if (matchIf (TokenTypes::minus))       { ExpPtr a (new LiteralValue (location, (int) 0)), b (parseUnary()); return new SubtractionOp   (location, a, b); }
-            if (matchIf (TokenTypes::logicalNot))  { ExpPtr a (new LiteralValue (location, (int) 0)), b (parseUnary()); return new EqualsOp        (location, a, b); }
+            if (matchIf (TokenTypes::minus))       { ExpPtr a (new LiteralValue (location, (int) 0)), b (parseUnary()); return newBinaryOp<SubtractionOp> (a, b); }
+            if (matchIf (TokenTypes::logicalNot))  { ExpPtr a (new LiteralValue (location, (int) 0)), b (parseUnary()); return newBinaryOp<EqualsOp> (a, b); }
             if (matchIf (TokenTypes::plusplus))    return parsePreIncDec<AdditionOp>();
             if (matchIf (TokenTypes::minusminus))  return parsePreIncDec<SubtractionOp>();
             if (matchIf (TokenTypes::typeof_))     return parseTypeof();
@@ -1435,9 +1505,9 @@ struct JavascriptEngine::RootObject   : public DynamicObject
 
             for (;;)
             {
-                if (matchIf (TokenTypes::times))        { ExpPtr b (parseUnary()); a.reset (new MultiplyOp (location, a, b)); }
-                else if (matchIf (TokenTypes::divide))  { ExpPtr b (parseUnary()); a.reset (new DivideOp   (location, a, b)); }
-                else if (matchIf (TokenTypes::modulo))  { ExpPtr b (parseUnary()); a.reset (new ModuloOp   (location, a, b)); }
+                if (matchIf (TokenTypes::times))        { ExpPtr b (parseUnary()); a.reset (newBinaryOp<MultiplyOp> (a, b)); }
+                else if (matchIf (TokenTypes::divide))  { ExpPtr b (parseUnary()); a.reset (newBinaryOp<DivideOp> (a, b)); }
+                else if (matchIf (TokenTypes::modulo))  { ExpPtr b (parseUnary()); a.reset (newBinaryOp<ModuloOp> (a, b)); }
                 else break;
             }
 
@@ -1450,8 +1520,8 @@ struct JavascriptEngine::RootObject   : public DynamicObject
 
             for (;;)
             {
-                if (matchIf (TokenTypes::plus))            { ExpPtr b (parseMultiplyDivide()); a.reset (new AdditionOp    (location, a, b)); }
-                else if (matchIf (TokenTypes::minus))      { ExpPtr b (parseMultiplyDivide()); a.reset (new SubtractionOp (location, a, b)); }
+                if (matchIf (TokenTypes::plus))            { ExpPtr b (parseMultiplyDivide()); a.reset (newBinaryOp<AdditionOp> (a, b)); }
+                else if (matchIf (TokenTypes::minus))      { ExpPtr b (parseMultiplyDivide()); a.reset (newBinaryOp<SubtractionOp> (a, b)); }
                 else break;
             }
 
@@ -1464,9 +1534,9 @@ struct JavascriptEngine::RootObject   : public DynamicObject
 
             for (;;)
             {
-                if (matchIf (TokenTypes::leftShift))                { ExpPtr b (parseExpression()); a.reset (new LeftShiftOp          (location, a, b)); }
-                else if (matchIf (TokenTypes::rightShift))          { ExpPtr b (parseExpression()); a.reset (new RightShiftOp         (location, a, b)); }
-                else if (matchIf (TokenTypes::rightShiftUnsigned))  { ExpPtr b (parseExpression()); a.reset (new RightShiftUnsignedOp (location, a, b)); }
+                if (matchIf (TokenTypes::leftShift))                { ExpPtr b (parseExpression()); a.reset (newBinaryOp<LeftShiftOp> (a, b)); }
+                else if (matchIf (TokenTypes::rightShift))          { ExpPtr b (parseExpression()); a.reset (newBinaryOp<RightShiftOp> (a, b)); }
+                else if (matchIf (TokenTypes::rightShiftUnsigned))  { ExpPtr b (parseExpression()); a.reset (newBinaryOp<RightShiftUnsignedOp> (a, b)); }
                 else break;
             }
 
@@ -1479,14 +1549,14 @@ struct JavascriptEngine::RootObject   : public DynamicObject
 
             for (;;)
             {
-                if (matchIf (TokenTypes::equals))                  { ExpPtr b (parseShiftOperator()); a.reset (new EqualsOp             (location, a, b)); }
-                else if (matchIf (TokenTypes::notEquals))          { ExpPtr b (parseShiftOperator()); a.reset (new NotEqualsOp          (location, a, b)); }
+                if (matchIf (TokenTypes::equals))                  { ExpPtr b (parseShiftOperator()); a.reset (newBinaryOp<EqualsOp> (a, b)); }
+                else if (matchIf (TokenTypes::notEquals))          { ExpPtr b (parseShiftOperator()); a.reset (newBinaryOp<NotEqualsOp> (a, b)); }
                 else if (matchIf (TokenTypes::typeEquals))         { ExpPtr b (parseShiftOperator()); a.reset (new TypeEqualsOp         (location, a, b)); }
                 else if (matchIf (TokenTypes::typeNotEquals))      { ExpPtr b (parseShiftOperator()); a.reset (new TypeNotEqualsOp      (location, a, b)); }
-                else if (matchIf (TokenTypes::lessThan))           { ExpPtr b (parseShiftOperator()); a.reset (new LessThanOp           (location, a, b)); }
-                else if (matchIf (TokenTypes::lessThanOrEqual))    { ExpPtr b (parseShiftOperator()); a.reset (new LessThanOrEqualOp    (location, a, b)); }
-                else if (matchIf (TokenTypes::greaterThan))        { ExpPtr b (parseShiftOperator()); a.reset (new GreaterThanOp        (location, a, b)); }
-                else if (matchIf (TokenTypes::greaterThanOrEqual)) { ExpPtr b (parseShiftOperator()); a.reset (new GreaterThanOrEqualOp (location, a, b)); }
+                else if (matchIf (TokenTypes::lessThan))           { ExpPtr b (parseShiftOperator()); a.reset (newBinaryOp<LessThanOp> (a, b)); }
+                else if (matchIf (TokenTypes::lessThanOrEqual))    { ExpPtr b (parseShiftOperator()); a.reset (newBinaryOp<LessThanOrEqualOp> (a, b)); }
+                else if (matchIf (TokenTypes::greaterThan))        { ExpPtr b (parseShiftOperator()); a.reset (newBinaryOp<GreaterThanOp> (a, b)); }
+                else if (matchIf (TokenTypes::greaterThanOrEqual)) { ExpPtr b (parseShiftOperator()); a.reset (newBinaryOp<GreaterThanOrEqualOp> (a, b)); }
                 else break;
             }
 
@@ -1501,9 +1571,9 @@ struct JavascriptEngine::RootObject   : public DynamicObject
             {
                 if (matchIf (TokenTypes::logicalAnd))       { ExpPtr b (parseComparator()); a.reset (new LogicalAndOp (location, a, b)); }
                 else if (matchIf (TokenTypes::logicalOr))   { ExpPtr b (parseComparator()); a.reset (new LogicalOrOp  (location, a, b)); }
-                else if (matchIf (TokenTypes::bitwiseAnd))  { ExpPtr b (parseComparator()); a.reset (new BitwiseAndOp (location, a, b)); }
-                else if (matchIf (TokenTypes::bitwiseOr))   { ExpPtr b (parseComparator()); a.reset (new BitwiseOrOp  (location, a, b)); }
-                else if (matchIf (TokenTypes::bitwiseXor))  { ExpPtr b (parseComparator()); a.reset (new BitwiseXorOp (location, a, b)); }
+                else if (matchIf (TokenTypes::bitwiseAnd))  { ExpPtr b (parseComparator()); a.reset (newBinaryOp<BitwiseAndOp> (a, b)); }
+                else if (matchIf (TokenTypes::bitwiseOr))   { ExpPtr b (parseComparator()); a.reset (newBinaryOp<BitwiseOrOp> (a, b)); }
+                else if (matchIf (TokenTypes::bitwiseXor))  { ExpPtr b (parseComparator()); a.reset (newBinaryOp<BitwiseXorOp> (a, b)); }
                 else break;
             }
 
@@ -1916,4 +1986,81 @@ const NamedValueSet& JavascriptEngine::getRootObjectProperties() const noexcept
 
 JUCE_END_IGNORE_WARNINGS_MSVC
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class JavascriptTests  : public UnitTest
+{
+public:
+    JavascriptTests()
+        : UnitTest ("Javascript", UnitTestCategories::javascript)
+    {}
+
+    void runTest() override
+    {
+        JavascriptEngine engine;
+        engine.maximumExecutionTime = RelativeTime::seconds (5);
+
+        beginTest ("Constant expressions are evaluated correctly");
+        {
+            expectEquals ((int) engine.evaluate ("1 + 2 * 3"), 7);
+            expectEquals ((int) engine.evaluate ("(1 + 2) * 3"), 9);
+            expectEquals ((double) engine.evaluate ("10 / 4"), 2.5);
+            expectEquals ((int) engine.evaluate ("-5 + 3"), -2);
+            expectEquals ((int) engine.evaluate ("1 << 4"), 16);
+            expectEquals ((int) engine.evaluate ("255 & 0x0f"), 15);
+            expectEquals (engine.evaluate ("\"x\" + 1").toString(), String ("x1"));
+            expect ((bool) engine.evaluate ("5 > 2"));
+            expect ((bool) engine.evaluate ("! (1 == 2)"));
+            expect (std::isinf ((double) engine.evaluate ("1.0 / 0.0")));
+        }
+
+        beginTest ("Cached expressions re-read the current scope on each evaluation");
+        {
+            Result result = Result::ok();
+            engine.execute ("var counter = 1;");
+
+            expectEquals ((int) engine.evaluate ("counter + 1", &result), 2);
+            expect (result.wasOk());
+
+            engine.execute ("counter = 41;");
+
+            // the same source string must pick up the new value, not a stale result
+            expectEquals ((int) engine.evaluate ("counter + 1", &result), 42);
+            expect (result.wasOk());
+        }
+
+        beginTest ("Repeated evaluation of the same expression stays correct");
+        {
+            engine.execute ("function square (x) { return x * x; }");
+
+            for (int i = 0; i < 100; ++i)
+            {
+                engine.execute ("counter = " + String (i) + ";");
+                expectEquals ((int) engine.evaluate ("square (counter) + 1"), i * i + 1);
+            }
+        }
+
+        beginTest ("Evaluation errors are reported and don't poison the cache");
+        {
+            Result result = Result::ok();
+            engine.evaluate ("1 +", &result);
+            expect (result.failed());
+
+            engine.evaluate ("undefinedFunction (3)", &result);
+            expect (result.failed());
+
+            // ..and the engine keeps working normally afterwards
+            expectEquals ((int) engine.evaluate ("2 + 2", &result), 4);
+            expect (result.wasOk());
+        }
+    }
+};
+
+static JavascriptTests javascriptTests;
+
+#endif
+
 } // namespace juce
@@ -128,11 +128,13 @@
 //==============================================================================
 #include "containers/juce_AbstractFifo.cpp"
 #include "containers/juce_ArrayBase.cpp"
+#include "containers/juce_ConcurrentAbstractFifo.cpp"
 #include "containers/juce_NamedValueSet.cpp"
 #include "containers/juce_OwnedArray.cpp"
 #include "containers/juce_PropertySet.cpp"
 #include "containers/juce_ReferenceCountedArray.cpp"
 #include "containers/juce_SparseSet.cpp"
+#include "containers/juce_ChunkedBitSet.cpp"
 #include "files/juce_DirectoryIterator.cpp"
 #include "files/juce_RangedDirectoryIterator.cpp"
 #include "files/juce_File.cpp"
@@ -142,24 +144,30 @@
 #include "files/juce_TemporaryFile.cpp"
 #include "logging/juce_FileLogger.cpp"
 #include "logging/juce_Logger.cpp"
+#include "logging/juce_RealtimeLogger.cpp"
 #include "maths/juce_BigInteger.cpp"
 #include "maths/juce_Expression.cpp"
 #include "maths/juce_Random.cpp"
+#include "memory/juce_HeapBlock.cpp"
 #include "memory/juce_MemoryBlock.cpp"
 #include "memory/juce_AllocationHooks.cpp"
 #include "misc/juce_RuntimePermissions.cpp"
 #include "misc/juce_Result.cpp"
 #include "misc/juce_Uuid.cpp"
 #include "misc/juce_ConsoleApplication.cpp"
+#include "misc/juce_StartupProfile.cpp"
 #include "network/juce_MACAddress.cpp"
 #include "network/juce_NamedPipe.cpp"
 #include "network/juce_Socket.cpp"
+#include "network/juce_SocketPoller.cpp"
 #include "network/juce_IPAddress.cpp"
 #include "streams/juce_BufferedInputStream.cpp"
 #include "streams/juce_FileInputSource.cpp"
 #include "streams/juce_InputStream.cpp"
 #include "streams/juce_MemoryInputStream.cpp"
+#include "streams/juce_MemoryMappedInputStream.cpp"
 #include "streams/juce_MemoryOutputStream.cpp"
+#include "streams/juce_ChunkedOutputStream.cpp"
 #include "streams/juce_SubregionStream.cpp"
 #include "system/juce_SystemStats.cpp"
 #include "text/juce_CharacterFunctions.cpp"
@@ -168,24 +176,29 @@
 #include "text/juce_String.cpp"
 #include "streams/juce_OutputStream.cpp"
 #include "text/juce_StringArray.cpp"
+#include "text/juce_StringBuilder.cpp"
 #include "text/juce_StringPairArray.cpp"
 #include "text/juce_StringPool.cpp"
 #include "text/juce_TextDiff.cpp"
 #include "text/juce_Base64.cpp"
 #include "threads/juce_ReadWriteLock.cpp"
+#include "threads/juce_ScalableReadWriteLock.cpp"
 #include "threads/juce_Thread.cpp"
 #include "threads/juce_ThreadPool.cpp"
 #include "threads/juce_TimeSliceThread.cpp"
+#include "threads/juce_DeadlineScheduler.cpp"
 #include "time/juce_PerformanceCounter.cpp"
 #include "time/juce_RelativeTime.cpp"
 #include "time/juce_Time.cpp"
 #include "unit_tests/juce_UnitTest.cpp"
+#include "unit_tests/juce_Benchmark.cpp"
 #include "containers/juce_Variant.cpp"
 #include "javascript/juce_JSON.cpp"
 #include "javascript/juce_Javascript.cpp"
 #include "containers/juce_DynamicObject.cpp"
 #include "xml/juce_XmlDocument.cpp"
 #include "xml/juce_XmlElement.cpp"
+#include "xml/juce_XmlStreamParser.cpp"
 #include "zip/juce_GZIPDecompressorInputStream.cpp"
 #include "zip/juce_GZIPCompressorOutputStream.cpp"
 #include "zip/juce_ZipFile.cpp"
@@ -255,12 +268,16 @@
 #if ! JUCE_WASM
  #include "threads/juce_ChildProcess.cpp"
  #include "network/juce_WebInputStream.cpp"
+ #include "network/juce_BatchDownloader.cpp"
  #include "streams/juce_URLInputSource.cpp"
 #endif
 
 //==============================================================================
 #if JUCE_UNIT_TESTS
  #include "containers/juce_HashMap_test.cpp"
+ #include "containers/juce_ListenerList_test.cpp"
+ #include "containers/juce_FlatHashMap_test.cpp"
+ #include "misc/juce_MoveOnlyFunction_test.cpp"
 #endif
 
 //==============================================================================
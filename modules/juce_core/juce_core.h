@@ -249,6 +249,8 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "memory/juce_WeakReference.h"
 #include "threads/juce_ScopedLock.h"
 #include "threads/juce_CriticalSection.h"
+#include "threads/juce_WaitableEvent.h"
+#include "threads/juce_ScalableReadWriteLock.h"
 #include "maths/juce_Range.h"
 #include "maths/juce_NormalisableRange.h"
 #include "maths/juce_StatisticsAccumulator.h"
@@ -262,9 +264,12 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "containers/juce_ReferenceCountedArray.h"
 #include "containers/juce_SortedSet.h"
 #include "containers/juce_SparseSet.h"
+#include "containers/juce_ChunkedBitSet.h"
 #include "containers/juce_AbstractFifo.h"
 #include "containers/juce_SingleThreadedAbstractFifo.h"
+#include "containers/juce_ConcurrentAbstractFifo.h"
 #include "text/juce_NewLine.h"
+#include "text/juce_StringBuilder.h"
 #include "text/juce_StringPool.h"
 #include "text/juce_Identifier.h"
 #include "text/juce_StringArray.h"
@@ -275,13 +280,17 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "text/juce_LocalisedStrings.h"
 #include "text/juce_Base64.h"
 #include "misc/juce_Functional.h"
+#include "misc/juce_FixedSizeFunction.h"
+#include "misc/juce_MoveOnlyFunction.h"
 #include "misc/juce_Result.h"
 #include "misc/juce_Uuid.h"
 #include "misc/juce_ConsoleApplication.h"
+#include "misc/juce_StartupProfile.h"
 #include "containers/juce_Variant.h"
 #include "containers/juce_NamedValueSet.h"
 #include "containers/juce_DynamicObject.h"
 #include "containers/juce_HashMap.h"
+#include "containers/juce_FlatHashMap.h"
 #include "time/juce_RelativeTime.h"
 #include "time/juce_Time.h"
 #include "streams/juce_InputStream.h"
@@ -298,7 +307,9 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "files/juce_FileOutputStream.h"
 #include "files/juce_FileSearchPath.h"
 #include "files/juce_MemoryMappedFile.h"
+#include "streams/juce_MemoryMappedInputStream.h"
 #include "files/juce_TemporaryFile.h"
+#include "streams/juce_ChunkedOutputStream.h"
 #include "files/juce_FileFilter.h"
 #include "files/juce_WildcardFileFilter.h"
 #include "streams/juce_FileInputSource.h"
@@ -316,11 +327,11 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "threads/juce_InterProcessLock.h"
 #include "threads/juce_Process.h"
 #include "threads/juce_SpinLock.h"
-#include "threads/juce_WaitableEvent.h"
 #include "threads/juce_Thread.h"
 #include "threads/juce_ThreadLocalValue.h"
 #include "threads/juce_ThreadPool.h"
 #include "threads/juce_TimeSliceThread.h"
+#include "threads/juce_DeadlineScheduler.h"
 #include "threads/juce_ReadWriteLock.h"
 #include "threads/juce_ScopedReadLock.h"
 #include "threads/juce_ScopedWriteLock.h"
@@ -328,13 +339,18 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "network/juce_MACAddress.h"
 #include "network/juce_NamedPipe.h"
 #include "network/juce_Socket.h"
+#include "network/juce_SocketPoller.h"
 #include "network/juce_URL.h"
 #include "network/juce_WebInputStream.h"
+#include "network/juce_BatchDownloader.h"
 #include "streams/juce_URLInputSource.h"
 #include "time/juce_PerformanceCounter.h"
+#include "logging/juce_RealtimeLogger.h"
 #include "unit_tests/juce_UnitTest.h"
+#include "unit_tests/juce_Benchmark.h"
 #include "xml/juce_XmlDocument.h"
 #include "xml/juce_XmlElement.h"
+#include "xml/juce_XmlStreamParser.h"
 #include "zip/juce_GZIPCompressorOutputStream.h"
 #include "zip/juce_GZIPDecompressorInputStream.h"
 #include "zip/juce_ZipFile.h"
@@ -0,0 +1,214 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+RealtimeLogger::RealtimeLogger (int capacityInMessages)
+    : RealtimeLogger (nullptr, capacityInMessages)
+{
+}
+
+RealtimeLogger::RealtimeLogger (std::function<void (const String&)> messageDestination,
+                                int capacityInMessages)
+    : Thread ("Realtime Logger"),
+      destination (std::move (messageDestination)),
+      fifo (jmax (2, capacityInMessages) + 1),  // AbstractFifo keeps one slot free
+      events ((size_t) fifo.getTotalSize()),
+      startTicks (Time::getHighResolutionTicks())
+{
+    startThread (2);
+}
+
+RealtimeLogger::~RealtimeLogger()
+{
+    stopThread (5000);
+    drain(); // flush anything posted since the thread's last pass
+}
+
+//==============================================================================
+bool RealtimeLogger::post (const char* message) noexcept                                 { return postEvent (message, 0, 0, 0); }
+bool RealtimeLogger::post (const char* message, double value) noexcept                   { return postEvent (message, 1, value, 0); }
+bool RealtimeLogger::post (const char* message, double value1, double value2) noexcept   { return postEvent (message, 2, value1, value2); }
+
+bool RealtimeLogger::postEvent (const char* message, int numValues, double v1, double v2) noexcept
+{
+    const auto scope = fifo.write (1);
+
+    if (scope.blockSize1 + scope.blockSize2 < 1)
+    {
+        numDropped.fetch_add (1, std::memory_order_relaxed);
+        return false;
+    }
+
+    auto& e = events[scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2];
+    e.ticks = Time::getHighResolutionTicks();
+    e.message = message;
+    e.values[0] = v1;
+    e.values[1] = v2;
+    e.numValues = numValues;
+    return true; // the record becomes visible when the scope commits the write
+}
+
+//==============================================================================
+void RealtimeLogger::run()
+{
+    while (! threadShouldExit())
+    {
+        drain();
+        wait (5);
+    }
+}
+
+void RealtimeLogger::drain()
+{
+    for (;;)
+    {
+        const auto scope = fifo.read (fifo.getNumReady());
+
+        if (scope.blockSize1 + scope.blockSize2 == 0)
+            break;
+
+        scope.forEach ([this] (int index)  { deliver (formatEvent (events[index])); });
+    }
+
+    auto dropped = numDropped.load (std::memory_order_relaxed);
+
+    if (dropped != numDroppedReported)
+    {
+        deliver ("*** RealtimeLogger: dropped " + String (dropped - numDroppedReported) + " messages");
+        numDroppedReported = dropped;
+    }
+}
+
+void RealtimeLogger::deliver (const String& message) const
+{
+    if (destination != nullptr)
+        destination (message);
+    else
+        Logger::writeToLog (message);
+}
+
+String RealtimeLogger::formatEvent (const Event& e) const
+{
+    String s;
+    s.preallocateBytes (48);
+    s << '[' << String (Time::highResolutionTicksToSeconds (e.ticks - startTicks), 6) << "] " << e.message;
+
+    for (int i = 0; i < e.numValues; ++i)
+        s << ' ' << String (e.values[i]);
+
+    return s;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class RealtimeLoggerTests  : public UnitTest
+{
+public:
+    RealtimeLoggerTests()
+        : UnitTest ("RealtimeLogger", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("posted records arrive formatted, in order");
+        {
+            CriticalSection lock;
+            StringArray received;
+
+            {
+                RealtimeLogger logger ([&] (const String& s)
+                                       {
+                                           const ScopedLock sl (lock);
+                                           received.add (s);
+                                       },
+                                       256);
+
+                // capacity covers every record, so none of these can fail
+                for (int i = 0; i < 200; ++i)
+                    expect (logger.post ("value", (double) i));
+            }
+
+            expectEquals (received.size(), 200);
+
+            for (int i = 0; i < received.size(); ++i)
+            {
+                expect (received[i].startsWith ("["));
+                expect (received[i].contains ("] value "));
+                expectEquals (received[i].fromLastOccurrenceOf (" ", false, false).getDoubleValue(), (double) i);
+            }
+        }
+
+        beginTest ("overflow drops records and reports the count");
+        {
+            WaitableEvent entered, release;
+            CriticalSection lock;
+            StringArray received;
+            bool firstCall = true;
+
+            {
+                RealtimeLogger logger ([&] (const String& s)
+                                       {
+                                           {
+                                               const ScopedLock sl (lock);
+                                               received.add (s);
+                                           }
+
+                                           if (firstCall)
+                                           {
+                                               firstCall = false;
+                                               entered.signal();
+                                               release.wait();
+                                           }
+                                       },
+                                       8);
+
+                logger.post ("blocker");
+                expect (entered.wait (5000));
+
+                // the drain thread is now stuck inside the callback, so these
+                // must eventually overflow the 8-slot fifo
+                for (int i = 0; i < 50; ++i)
+                    logger.post ("flood", (double) i);
+
+                expectGreaterThan ((int) logger.getNumDroppedMessages(), 0);
+                release.signal();
+            }
+
+            bool reportFound = false;
+
+            for (auto& s : received)
+                reportFound = reportFound || s.contains ("dropped");
+
+            expect (reportFound);
+        }
+    }
+};
+
+static RealtimeLoggerTests realtimeLoggerUnitTests;
+
+#endif
+
+} // namespace juce
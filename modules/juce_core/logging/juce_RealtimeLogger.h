@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A logging channel that can safely be written to from a realtime thread.
+
+    Logger::writeToLog allocates Strings and may touch the file system, so it
+    can't be used from an audio callback. This class instead lets the realtime
+    thread post small fixed-size records - a string literal plus up to two
+    numeric values - into a preallocated lock-free FIFO. A low-priority
+    background thread drains the FIFO, formats the records (prefixed with a
+    high-resolution timestamp taken when the record was posted) and passes the
+    resulting strings on, by default to Logger::writeToLog.
+
+    Posting is wait-free: no locks, no allocation, no system calls beyond
+    reading the high-resolution clock. If the FIFO is full the record is
+    simply dropped and counted, and the drop count is reported on the log the
+    next time the background thread catches up.
+
+    Note that, like AbstractFifo, this is a single-producer queue: it's safe
+    for one thread to call post() while the background thread drains, but two
+    threads may not post concurrently. Use one RealtimeLogger per realtime
+    thread if you need more.
+
+    Because the message text isn't copied, the pointer passed to post() must
+    stay valid until the record has been formatted - in practice, only pass
+    string literals.
+
+    e.g.
+    @code
+    RealtimeLogger logger;
+
+    void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+    {
+        if (buffer.hasBeenCleared())
+            logger.post ("processBlock called with cleared buffer, samples:",
+                         (double) buffer.getNumSamples());
+    }
+    @endcode
+
+    @see Logger, AbstractFifo, ConcurrentAbstractFifo
+
+    @tags{Core}
+*/
+class JUCE_API  RealtimeLogger  final  : private Thread
+{
+public:
+    //==============================================================================
+    /** Creates a logger whose formatted messages go to Logger::writeToLog.
+
+        @param capacityInMessages   the number of records that can be queued up
+                                    before posts start being dropped
+    */
+    explicit RealtimeLogger (int capacityInMessages = 1024);
+
+    /** Creates a logger which passes each formatted message to the given function.
+
+        The function is called on the logger's background thread.
+    */
+    RealtimeLogger (std::function<void (const String&)> messageDestination,
+                    int capacityInMessages = 1024);
+
+    /** Destructor. Flushes any queued records before returning. */
+    ~RealtimeLogger() override;
+
+    //==============================================================================
+    /** Posts a message from the realtime thread.
+
+        The message must be a string literal (or otherwise outlive this object),
+        as only the pointer is queued.
+
+        @returns false if the FIFO was full and the record was dropped
+    */
+    bool post (const char* message) noexcept;
+
+    /** Posts a message and a numeric value from the realtime thread. */
+    bool post (const char* message, double value) noexcept;
+
+    /** Posts a message and two numeric values from the realtime thread. */
+    bool post (const char* message, double value1, double value2) noexcept;
+
+    //==============================================================================
+    /** Returns the number of records that have been dropped because the FIFO was full. */
+    int64 getNumDroppedMessages() const noexcept        { return numDropped; }
+
+private:
+    //==============================================================================
+    struct Event
+    {
+        int64 ticks;
+        const char* message;
+        double values[2];
+        int numValues;
+    };
+
+    std::function<void (const String&)> destination;
+    AbstractFifo fifo;
+    HeapBlock<Event> events;
+    const int64 startTicks;
+    std::atomic<int64> numDropped { 0 };
+    int64 numDroppedReported = 0;
+
+    bool postEvent (const char* message, int numValues, double v1, double v2) noexcept;
+    void drain();
+    void deliver (const String&) const;
+    String formatEvent (const Event&) const;
+    void run() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RealtimeLogger)
+};
+
+} // namespace juce
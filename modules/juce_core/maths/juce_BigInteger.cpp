@@ -28,6 +28,10 @@ namespace
     inline uint32 bitToMask  (const int bit) noexcept           { return (uint32) 1 << (bit & 31); }
     inline size_t bitToIndex (const int bit) noexcept           { return (size_t) (bit >> 5); }
     inline size_t sizeNeededToHold (int highestBit) noexcept    { return (size_t) (highestBit >> 5) + 1; }
+
+    // Multiplications where both operands are at least this large will use the
+    // Karatsuba algorithm rather than the schoolbook loop.
+    constexpr int karatsubaThresholdBits = 2048;
 }
 
 int findHighestSetBit (uint32 n) noexcept
@@ -515,6 +519,35 @@ BigInteger& BigInteger::operator-= (const BigInteger& other)
     return *this;
 }
 
+/*  Splits each operand around a word-aligned midpoint h and recurses, using the
+    identity a*b = (a1*b1 << 2h) + (((a0 + a1) * (b0 + b1) - a1*b1 - a0*b0) << h)
+    + a0*b0, which costs three half-sized multiplies instead of four. The
+    recursive multiplies drop back to the schoolbook loop once the halves fall
+    below the threshold.
+*/
+static BigInteger multiplyKaratsuba (const BigInteger& a, const BigInteger& b)
+{
+    const auto half = ((jmax (a.getHighestBit(), b.getHighestBit()) + 1) / 2) & ~31;
+
+    auto a0 = a.getBitRange (0, half);
+    auto a1 = a.getBitRange (half, a.getHighestBit() + 1 - half);
+    auto b0 = b.getBitRange (0, half);
+    auto b1 = b.getBitRange (half, b.getHighestBit() + 1 - half);
+
+    auto z0 = a0 * b0;
+    auto z2 = a1 * b1;
+    auto z1 = (a0 + a1) * (b0 + b1);
+    z1 -= z0;
+    z1 -= z2;
+
+    z1 <<= half;
+    z2 <<= half * 2;
+
+    z2 += z1;
+    z2 += z0;
+    return z2;
+}
+
 BigInteger& BigInteger::operator*= (const BigInteger& other)
 {
     if (this == &other)
@@ -526,6 +559,17 @@ BigInteger& BigInteger::operator*= (const BigInteger& other)
     auto wasNegative = isNegative();
     setNegative (false);
 
+    if (jmin (n, t) >= karatsubaThresholdBits)
+    {
+        auto m = other;
+        m.setNegative (false);
+
+        auto total = multiplyKaratsuba (*this, m);
+        total.setNegative (wasNegative ^ other.isNegative());
+        swapWith (total);
+        return *this;
+    }
+
     BigInteger total;
     total.highestBit = n + t + 1;
     auto* totalValues = total.ensureSize (sizeNeededToHold (total.highestBit) + 1);
@@ -899,6 +943,97 @@ BigInteger BigInteger::findGreatestCommonDivisor (BigInteger n) const
     return m;
 }
 
+/*  Returns -n0^-1 (mod 2^32) for an odd n0, as needed by Montgomery reduction.
+    Every odd word is its own inverse mod 8, and each Newton step doubles the
+    number of correct low bits, so four steps cover all 32.
+*/
+static uint32 negatedInverseMod32 (uint32 n0) noexcept
+{
+    auto x = n0;
+
+    for (int i = 4; --i >= 0;)
+        x *= 2u - n0 * x;
+
+    return (uint32) 0 - x;
+}
+
+/*  One Montgomery modular multiplication: result = a * b * R^-1 (mod n), where
+    R = 2^(32 * numWords) and all operands are numWords-word little-endian
+    arrays with a, b < n. This is the CIOS (coarsely integrated operand
+    scanning) formulation, which interleaves the multiply and the reduction one
+    word at a time so no full double-length product is ever formed. The scratch
+    buffer must hold numWords + 2 words; result may alias a or b.
+*/
+static void montgomeryMultiplyWords (uint32* result, const uint32* a, const uint32* b,
+                                     const uint32* n, uint32 negatedInverse,
+                                     uint32* scratch, size_t numWords) noexcept
+{
+    auto* t = scratch;
+    zeromem (t, (numWords + 2) * sizeof (uint32));
+
+    for (size_t i = 0; i < numWords; ++i)
+    {
+        const auto ai = (uint64) a[i];
+        uint64 carry = 0;
+
+        for (size_t j = 0; j < numWords; ++j)
+        {
+            auto uv = t[j] + ai * b[j] + carry;
+            t[j] = (uint32) uv;
+            carry = uv >> 32;
+        }
+
+        auto uv = t[numWords] + carry;
+        t[numWords] = (uint32) uv;
+        t[numWords + 1] = (uint32) (uv >> 32);
+
+        const auto m = (uint64) (t[0] * negatedInverse);
+        carry = (t[0] + m * n[0]) >> 32;
+
+        for (size_t j = 1; j < numWords; ++j)
+        {
+            uv = t[j] + m * n[j] + carry;
+            t[j - 1] = (uint32) uv;
+            carry = uv >> 32;
+        }
+
+        uv = t[numWords] + carry;
+        t[numWords - 1] = (uint32) uv;
+        t[numWords] = t[numWords + 1] + (uint32) (uv >> 32);
+    }
+
+    // The loop leaves t < 2n, so at most one trailing subtraction is needed.
+    bool needsSubtraction = true;
+
+    if (t[numWords] == 0)
+    {
+        for (size_t i = numWords; i-- > 0;)
+        {
+            if (t[i] != n[i])
+            {
+                needsSubtraction = t[i] > n[i];
+                break;
+            }
+        }
+    }
+
+    if (needsSubtraction)
+    {
+        uint64 borrow = 0;
+
+        for (size_t i = 0; i < numWords; ++i)
+        {
+            auto diff = (uint64) t[i] - n[i] - borrow;
+            result[i] = (uint32) diff;
+            borrow = (diff >> 32) & 1;
+        }
+    }
+    else
+    {
+        memcpy (result, t, numWords * sizeof (uint32));
+    }
+}
+
 void BigInteger::exponentModulo (const BigInteger& exponent, const BigInteger& modulus)
 {
     *this %= modulus;
@@ -923,45 +1058,56 @@ void BigInteger::exponentModulo (const BigInteger& exponent, const BigInteger& m
     }
     else
     {
-        auto Rfactor = modulus.getHighestBit() + 1;
-        BigInteger R (1);
-        R.shiftLeft (Rfactor, 0);
-
-        BigInteger R1, m1, g;
-        g.extendedEuclidean (modulus, R, m1, R1);
-
-        if (! g.isOne())
+        // An odd modulus is always coprime to a power of two, so Montgomery
+        // form can be used unconditionally: after converting the base once,
+        // each step of the ladder is a single word-level multiply-reduce pass
+        // with no division at all.
+        if (isNegative())
+            *this += modulus;
+
+        const auto numWords = sizeNeededToHold (modulus.getHighestBit());
+        const auto k = (int) numWords * 32;
+
+        auto am = *this;
+        am.shiftLeft (k, 0);
+        am %= modulus;
+
+        HeapBlock<uint32> workspace (numWords * 4 + 2);
+        auto* x = workspace.get();
+        auto* a = x + numWords;
+        auto* n = a + numWords;
+        auto* scratch = n + numWords;
+
+        auto copyWords = [numWords] (uint32* dest, const BigInteger& source)
         {
-            BigInteger a (*this);
+            auto count = jmin (numWords, source.allocatedSize);
+            memcpy (dest, source.getValues(), count * sizeof (uint32));
+            zeromem (dest + count, (numWords - count) * sizeof (uint32));
+        };
 
-            for (int i = exp.getHighestBit(); --i >= 0;)
-            {
-                *this *= *this;
+        copyWords (x, am);
+        copyWords (a, am);
+        copyWords (n, modulus);
 
-                if (exp[i])
-                    *this *= a;
+        const auto negatedInverse = negatedInverseMod32 (n[0]);
 
-                if (compareAbsolute (modulus) >= 0)
-                    *this %= modulus;
-            }
-        }
-        else
+        for (int i = exp.getHighestBit(); --i >= 0;)
         {
-            auto am  = (*this * R) % modulus;
-            auto xm = am;
-            auto um = R % modulus;
+            montgomeryMultiplyWords (x, x, x, n, negatedInverse, scratch, numWords);
 
-            for (int i = exp.getHighestBit(); --i >= 0;)
-            {
-                xm.montgomeryMultiplication (xm, modulus, m1, Rfactor);
+            if (exp[i])
+                montgomeryMultiplyWords (x, x, a, n, negatedInverse, scratch, numWords);
+        }
 
-                if (exp[i])
-                    xm.montgomeryMultiplication (am, modulus, m1, Rfactor);
-            }
+        // Multiplying by plain 1 converts the result back out of Montgomery form.
+        zeromem (a, numWords * sizeof (uint32));
+        a[0] = 1;
+        montgomeryMultiplyWords (x, x, a, n, negatedInverse, scratch, numWords);
 
-            xm.montgomeryMultiplication (1, modulus, m1, Rfactor);
-            swapWith (xm);
-        }
+        clear();
+        memcpy (ensureSize (numWords), x, numWords * sizeof (uint32));
+        highestBit = k - 1;
+        highestBit = getHighestBit();
     }
 }
 
@@ -1332,6 +1478,62 @@ public:
             }
         }
 
+        {
+            beginTest ("Karatsuba multiplication");
+
+            Random r = getRandom();
+
+            for (int j = 5; --j >= 0;)
+            {
+                BigInteger b1, b2;
+                r.fillBitsRandomly (b1, 0, 2500 + r.nextInt (500));
+                r.fillBitsRandomly (b2, 0, 2500 + r.nextInt (500));
+
+                // Compare against a sum of narrow partial products, which stay
+                // below the Karatsuba threshold and use the schoolbook loop.
+                BigInteger expected;
+
+                for (int start = 0; start <= b2.getHighestBit(); start += 512)
+                {
+                    auto partial = b1 * b2.getBitRange (start, 512);
+                    partial <<= start;
+                    expected += partial;
+                }
+
+                expect (b1 * b2 == expected);
+            }
+        }
+
+        {
+            beginTest ("Montgomery exponentiation");
+
+            Random r = getRandom();
+
+            for (int j = 10; --j >= 0;)
+            {
+                BigInteger modulus;
+                r.fillBitsRandomly (modulus, 0, 150 + r.nextInt (100));
+                modulus.setBit (0);   // an odd modulus of more than 32 bits takes the Montgomery path
+                modulus.setBit (100);
+
+                auto exponent = r.nextInt (1000) + 2;
+
+                auto result = getBigRandom (r);
+                auto reduced = result % modulus;
+                result.exponentModulo (exponent, modulus);
+
+                BigInteger expected (1);
+
+                for (int i = exponent; --i >= 0;)
+                {
+                    expected *= reduced;
+                    expected %= modulus;
+                }
+
+                expect (result == expected);
+            }
+        }
+
         {
             beginTest ("Bit setting");
 
@@ -0,0 +1,167 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_LINUX || JUCE_ANDROID
+ #include <sys/mman.h>
+#endif
+
+namespace juce
+{
+
+namespace HeapBlockHelper
+{
+
+#if JUCE_LINUX || JUCE_ANDROID
+static void markAsEligibleForHugePages (void* block, size_t numBytes)
+{
+   #ifdef MADV_HUGEPAGE
+    // huge pages are only worthwhile for blocks spanning at least one of them
+    constexpr size_t hugePageSize = 2 * 1024 * 1024;
+
+    if (numBytes >= hugePageSize)
+    {
+        auto address = reinterpret_cast<uintptr_t> (block);
+        auto pageSize = (uintptr_t) sysconf (_SC_PAGESIZE);
+        auto first = (address + pageSize - 1) & ~(pageSize - 1);
+        auto last  = (address + numBytes) & ~(pageSize - 1);
+
+        if (first < last)
+            madvise (reinterpret_cast<void*> (first), last - first, MADV_HUGEPAGE);
+    }
+   #else
+    ignoreUnused (block, numBytes);
+   #endif
+}
+#endif
+
+void* allocateAligned (size_t alignmentBytes, size_t numBytes, bool initialiseToZero)
+{
+    jassert (alignmentBytes >= sizeof (void*) && (alignmentBytes & (alignmentBytes - 1)) == 0);
+
+    // the allocation functions below fail for a zero size, but HeapBlock users
+    // expect malloc-like behaviour
+    numBytes = jmax (numBytes, (size_t) 1);
+
+   #if JUCE_WINDOWS
+    auto* block = _aligned_malloc (numBytes, alignmentBytes);
+   #else
+    void* block = nullptr;
+
+    if (posix_memalign (&block, alignmentBytes, numBytes) != 0)
+        block = nullptr;
+   #endif
+
+    if (block != nullptr)
+    {
+       #if JUCE_LINUX || JUCE_ANDROID
+        markAsEligibleForHugePages (block, numBytes);
+       #endif
+
+        if (initialiseToZero)
+            zeromem (block, numBytes);
+    }
+
+    return block;
+}
+
+void freeAligned (void* block) noexcept
+{
+   #if JUCE_WINDOWS
+    _aligned_free (block);
+   #else
+    std::free (block);
+   #endif
+}
+
+} // namespace HeapBlockHelper
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class HeapBlockTests  : public UnitTest
+{
+public:
+    HeapBlockTests()
+        : UnitTest ("HeapBlock", UnitTestCategories::containers)
+    {}
+
+    template <size_t alignment>
+    void testAlignment()
+    {
+        HeapBlock<char, false, alignment> block (128);
+        expect (isAligned<alignment> (block.get()));
+
+        block.calloc (1024);
+        expect (isAligned<alignment> (block.get()));
+
+        for (int i = 0; i < 1024; ++i)
+            expect (block[i] == 0);
+
+        HeapBlock<char, false, alignment> other;
+        other.swapWith (block);
+        expect (block.get() == nullptr);
+        expect (isAligned<alignment> (other.get()));
+
+        auto moved = std::move (other);
+        expect (other.get() == nullptr);
+        expect (isAligned<alignment> (moved.get()));
+
+        moved.free();
+        expect (moved.get() == nullptr);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Over-aligned blocks are correctly aligned");
+        {
+            testAlignment<sizeof (void*)>();
+            testAlignment<64>();
+            testAlignment<4096>();
+        }
+
+        beginTest ("Huge allocations are usable");
+        {
+            HeapBlock<char, false, 2 * 1024 * 1024> block;
+            block.allocate (3 * 1024 * 1024, true);
+            expect (isAligned<2 * 1024 * 1024> (block.get()));
+
+            block[0] = 1;
+            block[3 * 1024 * 1024 - 1] = 1;
+            expect (block[1] == 0);
+        }
+    }
+
+private:
+    template <size_t alignment>
+    static bool isAligned (const void* p) noexcept
+    {
+        return p != nullptr && (reinterpret_cast<uintptr_t> (p) % alignment) == 0;
+    }
+};
+
+static HeapBlockTests heapBlockTests;
+
+#endif
+
+} // namespace juce
@@ -23,16 +23,26 @@
 namespace juce
 {
 
-#if ! (DOXYGEN || JUCE_EXCEPTIONS_DISABLED)
 namespace HeapBlockHelper
 {
+   #if ! (DOXYGEN || JUCE_EXCEPTIONS_DISABLED)
     template <bool shouldThrow>
     struct ThrowOnFail          { static void checkPointer (void*) {} };
 
     template <>
     struct ThrowOnFail<true>    { static void checkPointer (void* data) { if (data == nullptr) throw std::bad_alloc(); } };
+   #endif
+
+    /** Allocates a block whose address is a multiple of the given alignment, optionally
+        zeroed. The alignment must be a power of two and a multiple of sizeof (void*).
+        Blocks of 2MB or more are marked as eligible for promotion to huge pages on
+        platforms that support it. The result must be freed with freeAligned().
+    */
+    JUCE_API void* allocateAligned (size_t alignmentBytes, size_t numBytes, bool initialiseToZero);
+
+    /** Frees a block that was created by allocateAligned(). */
+    JUCE_API void freeAligned (void* block) noexcept;
 }
-#endif
 
 //==============================================================================
 /**
@@ -78,13 +88,26 @@ namespace HeapBlockHelper
     then a failed allocation will just leave the heapblock with a null pointer (assuming
     that the system's malloc() function doesn't throw).
 
+    The alignmentBytes template parameter can be used to over-align the allocations,
+    e.g. to a cache line (64), a page (4096), or a huge page (2MB - blocks that big
+    will also be marked as eligible for huge-page promotion on platforms that support
+    it). It must be a power of two and a multiple of sizeof (void*); zero means the
+    platform's default malloc alignment. On NUMA systems, physical pages are placed
+    on the node of the thread that first writes to them, so to bind a large block to
+    a particular node, allocate it uninitialised and write to it (or clear() it) from
+    a thread running on that node.
+
     @see Array, OwnedArray, MemoryBlock
 
     @tags{Core}
 */
-template <class ElementType, bool throwOnFailure = false>
+template <class ElementType, bool throwOnFailure = false, size_t alignmentBytes = 0>
 class HeapBlock
 {
+    static_assert (alignmentBytes == 0 || ((alignmentBytes & (alignmentBytes - 1)) == 0
+                                             && alignmentBytes % sizeof (void*) == 0),
+                   "alignmentBytes must be a power of two and a multiple of the pointer size");
+
 private:
     template <class OtherElementType>
     using AllowConversion = typename std::enable_if<std::is_base_of<typename std::remove_pointer<ElementType>::type,
@@ -109,7 +132,7 @@ public:
     */
     template <typename SizeType, std::enable_if_t<std::is_convertible<SizeType, int>::value, int> = 0>
     explicit HeapBlock (SizeType numElements)
-        : data (static_cast<ElementType*> (std::malloc (static_cast<size_t> (numElements) * sizeof (ElementType))))
+        : data (allocateBlock (static_cast<size_t> (numElements) * sizeof (ElementType), false))
     {
         throwOnAllocationFailure();
     }
@@ -121,9 +144,7 @@ public:
     */
     template <typename SizeType, std::enable_if_t<std::is_convertible<SizeType, int>::value, int> = 0>
     HeapBlock (SizeType numElements, bool initialiseToZero)
-        : data (static_cast<ElementType*> (initialiseToZero
-                                               ? std::calloc (static_cast<size_t> (numElements), sizeof (ElementType))
-                                               : std::malloc (static_cast<size_t> (numElements) * sizeof (ElementType))))
+        : data (allocateBlock (static_cast<size_t> (numElements) * sizeof (ElementType), initialiseToZero))
     {
         throwOnAllocationFailure();
     }
@@ -133,7 +154,7 @@ public:
     */
     ~HeapBlock()
     {
-        std::free (data);
+        freeBlock (data);
     }
 
     /** Move constructor */
@@ -155,7 +176,7 @@ public:
         where std::is_base_of<Base, Derived>::value == true.
     */
     template <class OtherElementType, bool otherThrowOnFailure, typename = AllowConversion<OtherElementType>>
-    HeapBlock (HeapBlock<OtherElementType, otherThrowOnFailure>&& other) noexcept
+    HeapBlock (HeapBlock<OtherElementType, otherThrowOnFailure, alignmentBytes>&& other) noexcept
         : data (reinterpret_cast<ElementType*> (other.data))
     {
         other.data = nullptr;
@@ -166,7 +187,7 @@ public:
         where std::is_base_of<Base, Derived>::value == true.
     */
     template <class OtherElementType, bool otherThrowOnFailure, typename = AllowConversion<OtherElementType>>
-    HeapBlock& operator= (HeapBlock<OtherElementType, otherThrowOnFailure>&& other) noexcept
+    HeapBlock& operator= (HeapBlock<OtherElementType, otherThrowOnFailure, alignmentBytes>&& other) noexcept
     {
         free();
         data = reinterpret_cast<ElementType*> (other.data);
@@ -251,8 +272,8 @@ public:
     template <typename SizeType>
     void malloc (SizeType newNumElements, size_t elementSize = sizeof (ElementType))
     {
-        std::free (data);
-        data = static_cast<ElementType*> (std::malloc (static_cast<size_t> (newNumElements) * elementSize));
+        freeBlock (data);
+        data = allocateBlock (static_cast<size_t> (newNumElements) * elementSize, false);
         throwOnAllocationFailure();
     }
 
@@ -262,8 +283,8 @@ public:
     template <typename SizeType>
     void calloc (SizeType newNumElements, const size_t elementSize = sizeof (ElementType))
     {
-        std::free (data);
-        data = static_cast<ElementType*> (std::calloc (static_cast<size_t> (newNumElements), elementSize));
+        freeBlock (data);
+        data = allocateBlock (static_cast<size_t> (newNumElements) * elementSize, true);
         throwOnAllocationFailure();
     }
 
@@ -274,10 +295,8 @@ public:
     template <typename SizeType>
     void allocate (SizeType newNumElements, bool initialiseToZero)
     {
-        std::free (data);
-        data = static_cast<ElementType*> (initialiseToZero
-                                             ? std::calloc (static_cast<size_t> (newNumElements), sizeof (ElementType))
-                                             : std::malloc (static_cast<size_t> (newNumElements) * sizeof (ElementType)));
+        freeBlock (data);
+        data = allocateBlock (static_cast<size_t> (newNumElements) * sizeof (ElementType), initialiseToZero);
         throwOnAllocationFailure();
     }
 
@@ -285,10 +304,15 @@ public:
 
         The semantics of this method are the same as malloc() and calloc(), but it
         uses realloc() to keep as much of the existing data as possible.
+
+        This isn't available for over-aligned blocks, as realloc() can't preserve
+        the alignment of an existing allocation.
     */
     template <typename SizeType>
     void realloc (SizeType newNumElements, size_t elementSize = sizeof (ElementType))
     {
+        static_assert (alignmentBytes == 0, "realloc() isn't available for over-aligned HeapBlocks");
+
         data = static_cast<ElementType*> (data == nullptr ? std::malloc (static_cast<size_t> (newNumElements) * elementSize)
                                                           : std::realloc (data, static_cast<size_t> (newNumElements) * elementSize));
         throwOnAllocationFailure();
@@ -299,7 +323,7 @@ public:
     */
     void free() noexcept
     {
-        std::free (data);
+        freeBlock (data);
         data = nullptr;
     }
 
@@ -307,7 +331,7 @@ public:
         The two objects simply exchange their data pointers.
     */
     template <bool otherBlockThrows>
-    void swapWith (HeapBlock<ElementType, otherBlockThrows>& other) noexcept
+    void swapWith (HeapBlock<ElementType, otherBlockThrows, alignmentBytes>& other) noexcept
     {
         std::swap (data, other.data);
     }
@@ -329,6 +353,23 @@ private:
     //==============================================================================
     ElementType* data = nullptr;
 
+    static ElementType* allocateBlock (size_t numBytes, bool initialiseToZero)
+    {
+        if (alignmentBytes == 0)
+            return static_cast<ElementType*> (initialiseToZero ? std::calloc (numBytes, 1)
+                                                               : std::malloc (numBytes));
+
+        return static_cast<ElementType*> (HeapBlockHelper::allocateAligned (alignmentBytes, numBytes, initialiseToZero));
+    }
+
+    static void freeBlock (ElementType* block) noexcept
+    {
+        if (alignmentBytes == 0)
+            std::free (block);
+        else
+            HeapBlockHelper::freeAligned (block);
+    }
+
     void throwOnAllocationFailure() const
     {
        #if JUCE_EXCEPTIONS_DISABLED
@@ -338,7 +379,7 @@ private:
        #endif
     }
 
-    template <class OtherElementType, bool otherThrowOnFailure>
+    template <class OtherElementType, bool otherThrowOnFailure, size_t otherAlignmentBytes>
     friend class HeapBlock;
 
    #if ! (defined (JUCE_DLL) || defined (JUCE_DLL_BUILD))
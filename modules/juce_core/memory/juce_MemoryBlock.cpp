@@ -29,7 +29,7 @@ MemoryBlock::MemoryBlock (size_t initialSize, bool initialiseToZero)
 {
     if (initialSize > 0)
     {
-        size = initialSize;
+        size = capacity = initialSize;
         data.allocate (initialSize, initialiseToZero);
     }
     else
@@ -39,7 +39,7 @@ MemoryBlock::MemoryBlock (size_t initialSize, bool initialiseToZero)
 }
 
 MemoryBlock::MemoryBlock (const MemoryBlock& other)
-    : size (other.size)
+    : size (other.size), capacity (other.size)
 {
     if (size > 0)
     {
@@ -50,7 +50,7 @@ MemoryBlock::MemoryBlock (const MemoryBlock& other)
 }
 
 MemoryBlock::MemoryBlock (const void* const dataToInitialiseFrom, const size_t sizeInBytes)
-    : size (sizeInBytes)
+    : size (sizeInBytes), capacity (sizeInBytes)
 {
     jassert (((ssize_t) sizeInBytes) >= 0);
 
@@ -82,14 +82,18 @@ MemoryBlock& MemoryBlock::operator= (const MemoryBlock& other)
 
 MemoryBlock::MemoryBlock (MemoryBlock&& other) noexcept
     : data (std::move (other.data)),
-      size (other.size)
+      size (other.size),
+      capacity (other.capacity)
 {
+    other.size = other.capacity = 0;
 }
 
 MemoryBlock& MemoryBlock::operator= (MemoryBlock&& other) noexcept
 {
     data = std::move (other.data);
     size = other.size;
+    capacity = other.capacity;
+    other.size = other.capacity = 0;
     return *this;
 }
 
@@ -120,6 +124,13 @@ void MemoryBlock::setSize (const size_t newSize, const bool initialiseToZero)
         {
             reset();
         }
+        else if (newSize <= capacity)
+        {
+            if (initialiseToZero && (newSize > size))
+                zeromem (data + size, newSize - size);
+
+            size = newSize;
+        }
         else
         {
             if (data != nullptr)
@@ -134,7 +145,7 @@ void MemoryBlock::setSize (const size_t newSize, const bool initialiseToZero)
                 data.allocate (newSize, initialiseToZero);
             }
 
-            size = newSize;
+            size = capacity = newSize;
         }
     }
 }
@@ -143,6 +154,7 @@ void MemoryBlock::reset()
 {
     data.free();
     size = 0;
+    capacity = 0;
 }
 
 void MemoryBlock::ensureSize (size_t minimumSize, bool initialiseToZero)
@@ -151,9 +163,38 @@ void MemoryBlock::ensureSize (size_t minimumSize, bool initialiseToZero)
         setSize (minimumSize, initialiseToZero);
 }
 
+void MemoryBlock::reserve (size_t minimumCapacity)
+{
+    if (capacity < minimumCapacity)
+    {
+        if (data != nullptr)
+            data.realloc (minimumCapacity);
+        else
+            data.allocate (minimumCapacity, false);
+
+        capacity = minimumCapacity;
+    }
+}
+
+// grows the capacity in power-of-two steps, so that a run of appends costs
+// amortised linear time instead of a reallocation per call
+void MemoryBlock::growToFit (size_t newSize)
+{
+    if (newSize > capacity)
+    {
+        auto newCapacity = jmax ((size_t) 64, capacity);
+
+        while (newCapacity < newSize)
+            newCapacity += newCapacity;
+
+        reserve (newCapacity);
+    }
+}
+
 void MemoryBlock::swapWith (MemoryBlock& other) noexcept
 {
     std::swap (size, other.size);
+    std::swap (capacity, other.capacity);
     data.swapWith (other.data);
 }
 
@@ -169,6 +210,7 @@ void MemoryBlock::append (const void* srcData, size_t numBytes)
     {
         jassert (srcData != nullptr); // this must not be null!
         auto oldSize = size;
+        growToFit (size + numBytes);
         setSize (size + numBytes);
         memcpy (data + oldSize, srcData, numBytes);
     }
@@ -194,6 +236,7 @@ void MemoryBlock::insert (const void* srcData, size_t numBytes, size_t insertPos
         jassert (srcData != nullptr); // this must not be null!
         insertPosition = jmin (size, insertPosition);
         auto trailingDataSize = size - insertPosition;
+        growToFit (size + numBytes);
         setSize (size + numBytes, false);
 
         if (trailingDataSize > 0)
@@ -410,4 +453,96 @@ bool MemoryBlock::fromBase64Encoding (StringRef s)
     }
 }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct MemoryBlockTests  : public UnitTest
+{
+    MemoryBlockTests()  : UnitTest ("MemoryBlock", UnitTestCategories::containers)  {}
+
+    void runTest() override
+    {
+        beginTest ("Appending grows the capacity geometrically");
+        {
+            MemoryBlock block;
+            int numReallocations = 0;
+            const void* lastAllocation = nullptr;
+            char chunk[16] = {};
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                block.append (chunk, sizeof (chunk));
+
+                if (block.getData() != lastAllocation)
+                {
+                    lastAllocation = block.getData();
+                    ++numReallocations;
+                }
+            }
+
+            expectEquals ((int) block.getSize(), 16000);
+            expect (block.getCapacity() >= block.getSize());
+
+            // power-of-two growth means the number of reallocations should be
+            // logarithmic in the final size, not one per append
+            expect (numReallocations <= 12);
+        }
+
+        beginTest ("Reserve avoids reallocation entirely");
+        {
+            MemoryBlock block;
+            block.reserve (1024);
+            expectEquals ((int) block.getSize(), 0);
+            expect (block.getCapacity() >= 1024);
+
+            auto* allocation = block.getData();
+
+            for (int i = 0; i < 128; ++i)
+            {
+                uint64 value = (uint64) i;
+                block.append (&value, sizeof (value));
+            }
+
+            expect (block.getData() == allocation);
+            expectEquals ((int) block.getSize(), 1024);
+        }
+
+        beginTest ("Size changes within capacity preserve contents");
+        {
+            MemoryBlock block ("hello world", 11);
+            block.setSize (5);
+            expectEquals ((int) block.getSize(), 5);
+            expect (block.matches ("hello", 5));
+
+            block.setSize (11, true);
+            expect (block.matches ("hello\0\0\0\0\0\0", 11));
+        }
+
+        beginTest ("Swap and move transfer the capacity");
+        {
+            MemoryBlock built;
+            built.reserve (512);
+            built.append ("abc", 3);
+
+            MemoryBlock target;
+            target.swapWith (built);
+            expect (target.getCapacity() >= 512);
+            expect (target.matches ("abc", 3));
+            expectEquals ((int) built.getSize(), 0);
+
+            MemoryBlock moved (std::move (target));
+            expect (moved.getCapacity() >= 512);
+            expect (moved.matches ("abc", 3));
+            expectEquals ((int) target.getSize(), 0);
+            expectEquals ((int) target.getCapacity(), 0);
+        }
+    }
+};
+
+static MemoryBlockTests memoryBlockTests;
+
+#endif
+
 } // namespace juce
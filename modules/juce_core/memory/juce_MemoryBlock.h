@@ -132,11 +132,15 @@ public:
         When enlarging the block, the new space that is allocated at the end can either be
         cleared, or left uninitialised.
 
+        Note that shrinking the block, or enlarging it within space that has been
+        set aside by reserve(), just changes its size without touching the
+        allocation - use reset() if you need the memory to actually be freed.
+
         @param newSize                      the new desired size for the block
         @param initialiseNewSpaceToZero     if the block gets enlarged, this determines
                                             whether to clear the new section or just leave it
                                             uninitialised
-        @see ensureSize
+        @see ensureSize, reserve
     */
     void setSize (const size_t newSize,
                   bool initialiseNewSpaceToZero = false);
@@ -153,6 +157,25 @@ public:
     void ensureSize (const size_t minimumSize,
                      bool initialiseNewSpaceToZero = false);
 
+    /** Pre-allocates space for at least the given number of bytes, without
+        changing the block's size.
+
+        Appends and resizes within the reserved capacity don't need to
+        reallocate, so if you're building up a block of a roughly-known size
+        with a series of append() calls, reserving it up-front avoids all the
+        intermediate copying.
+
+        @see getCapacity, append, setSize
+    */
+    void reserve (size_t minimumCapacity);
+
+    /** Returns the number of bytes currently allocated for this block.
+
+        This may be greater than getSize() if space has been set aside with
+        reserve(), or left over from an earlier resize or append.
+    */
+    size_t getCapacity() const noexcept                             { return capacity; }
+
     /** Frees all the blocks data, setting its size to 0. */
     void reset();
 
@@ -163,7 +186,13 @@ public:
     void fillWith (uint8 valueToUse) noexcept;
 
     /** Adds another block of data to the end of this one.
+
         The data pointer must not be null. This block's size will be increased accordingly.
+
+        When the block runs out of capacity, the allocation is grown
+        geometrically, so repeatedly appending small chunks costs amortised
+        linear time rather than a reallocation per call. A finished block can be
+        handed off cheaply with swapWith().
     */
     void append (const void* data, size_t numBytes);
 
@@ -282,7 +311,9 @@ private:
     //==============================================================================
     using HeapBlockType = HeapBlock<char, true>;
     HeapBlockType data;
-    size_t size = 0;
+    size_t size = 0, capacity = 0;
+
+    void growToFit (size_t newSize);
 
     JUCE_LEAK_DETECTOR (MemoryBlock)
 };
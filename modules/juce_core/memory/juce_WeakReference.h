@@ -119,6 +119,22 @@ public:
     bool operator== (ObjectType* object) const noexcept         { return get() == object; }
     bool operator!= (ObjectType* object) const noexcept         { return get() != object; }
 
+    //==============================================================================
+    /** Clears the master references of a whole group of objects in one pass.
+
+        When tearing down a large batch of weak-referenceable objects, calling
+        this first nulls every outstanding reference to all of them up-front:
+        references between members of the group can't observe partially
+        destroyed objects, and each individual destructor's clear() becomes a
+        no-op. Null entries in the array are skipped.
+    */
+    static void clearMastersOf (ObjectType* const* objects, int numObjects) noexcept
+    {
+        for (int i = 0; i < numObjects; ++i)
+            if (objects[i] != nullptr)
+                objects[i]->masterReference.clear();
+    }
+
     //==============================================================================
     /** This class is used internally by the WeakReference class - don't use it directly
         in your code!
@@ -132,9 +148,74 @@ public:
         inline ObjectType* get() const noexcept     { return owner; }
         void clearPointer() noexcept                { owner = nullptr; }
 
+        // SharedPointers are tiny, fixed-size objects that churn with every
+        // weak-referenceable object, so their storage is recycled through a
+        // per-type free list rather than going to the heap allocator each time.
+        // (The shared pointer can't live inside the Master itself, as weak
+        // references keep it alive after the owner object has been destroyed.)
+        static void* operator new (size_t size)         { return getRecycler().allocate (size); }
+        static void operator delete (void* p) noexcept  { getRecycler().release (p); }
+
     private:
         ObjectType* owner;
 
+        struct RecycledStorage
+        {
+            RecycledStorage* next;
+        };
+
+        struct Recycler
+        {
+            // A hand-rolled spin-lock, as this header is included before the
+            // library's threading primitives. The critical sections are a
+            // couple of pointer operations, so spinning is appropriate.
+            struct ScopedSpin
+            {
+                explicit ScopedSpin (std::atomic<bool>& f) noexcept  : flag (f)
+                {
+                    while (flag.exchange (true, std::memory_order_acquire)) {}
+                }
+
+                ~ScopedSpin() noexcept   { flag.store (false, std::memory_order_release); }
+
+                std::atomic<bool>& flag;
+            };
+
+            void* allocate (size_t size)
+            {
+                {
+                    const ScopedSpin sl (locked);
+
+                    if (auto* head = freeList)
+                    {
+                        freeList = head->next;
+                        return head;
+                    }
+                }
+
+                return ::operator new (size);
+            }
+
+            void release (void* p) noexcept
+            {
+                auto* node = static_cast<RecycledStorage*> (p);
+                const ScopedSpin sl (locked);
+                node->next = freeList;
+                freeList = node;
+            }
+
+            std::atomic<bool> locked { false };
+            RecycledStorage* freeList = nullptr;
+        };
+
+        static Recycler& getRecycler()
+        {
+            // Deliberately leaked: masters with static lifetime may release
+            // their shared pointer after static destruction has begun.
+            static Recycler* recycler = new Recycler();
+            return *recycler;
+        }
+
         JUCE_DECLARE_NON_COPYABLE (SharedPointer)
     };
 
@@ -0,0 +1,263 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#ifndef DOXYGEN
+
+namespace detail
+{
+    template <typename Ret, typename... Args>
+    struct MoveOnlyFunctionVtable
+    {
+        using Move    = void (*) (void*, void*);
+        using Call    = Ret  (*) (void*, Args...);
+        using Destroy = void (*) (void*);
+
+        constexpr MoveOnlyFunctionVtable (Move moveIn, Call callIn, Destroy destroyIn) noexcept
+            : move (moveIn), call (callIn), destroy (destroyIn) {}
+
+        Move    move    = nullptr;
+        Call    call    = nullptr;
+        Destroy destroy = nullptr;
+    };
+
+    template <typename Fn>
+    Fn& getInlineObject (void* storage)     { return *reinterpret_cast<Fn*> (storage); }
+
+    template <typename Fn>
+    Fn& getHeapObject (void* storage)       { return **reinterpret_cast<Fn**> (storage); }
+
+    template <typename Fn>
+    void moveInlineObject (void* from, void* to)
+    {
+        auto& fn = getInlineObject<Fn> (from);
+        new (to) Fn (std::move (fn));
+        fn.~Fn();
+    }
+
+    template <typename Fn>
+    void moveHeapObject (void* from, void* to)
+    {
+        *reinterpret_cast<void**> (to) = *reinterpret_cast<void**> (from);
+    }
+
+    template <typename Fn, Fn& (*get) (void*), typename Ret, typename... Args>
+    typename std::enable_if<std::is_same<Ret, void>::value, Ret>::type callObject (void* s, Args... args)
+    {
+        get (s) (std::forward<Args> (args)...);
+    }
+
+    template <typename Fn, Fn& (*get) (void*), typename Ret, typename... Args>
+    typename std::enable_if<! std::is_same<Ret, void>::value, Ret>::type callObject (void* s, Args... args)
+    {
+        return get (s) (std::forward<Args> (args)...);
+    }
+
+    template <typename Fn>
+    void destroyInlineObject (void* s)      { getInlineObject<Fn> (s).~Fn(); }
+
+    template <typename Fn>
+    void destroyHeapObject (void* s)        { delete &getHeapObject<Fn> (s); }
+
+    template <typename Fn, typename Ret, typename... Args>
+    constexpr MoveOnlyFunctionVtable<Ret, Args...> makeInlineVtable()
+    {
+        return { moveInlineObject<Fn>, callObject<Fn, getInlineObject<Fn>, Ret, Args...>, destroyInlineObject<Fn> };
+    }
+
+    template <typename Fn, typename Ret, typename... Args>
+    constexpr MoveOnlyFunctionVtable<Ret, Args...> makeHeapVtable()
+    {
+        return { moveHeapObject<Fn>, callObject<Fn, getHeapObject<Fn>, Ret, Args...>, destroyHeapObject<Fn> };
+    }
+} // namespace detail
+
+template <typename Signature, size_t inlineBytes = 64>
+class MoveOnlyFunction;
+
+#endif
+
+/**
+    A move-only replacement for `std::function` with a configurable inline buffer.
+
+    Callables that fit into the inline buffer are stored inside the MoveOnlyFunction
+    itself, so creating, moving and destroying the function won't touch the heap.
+    Unlike FixedSizeFunction, larger callables are still accepted - they simply fall
+    back to a heap allocation, exactly as `std::function` would behave. This makes
+    MoveOnlyFunction a drop-in replacement for `std::function` parameters in APIs
+    that mostly receive small lambdas, while removing the allocation from the
+    common case.
+
+    Because the wrapper is move-only, it can also hold callables that capture
+    non-copyable state such as std::unique_ptr, which std::function cannot.
+
+    @see FixedSizeFunction
+
+    @tags{Core}
+*/
+template <size_t inlineBytes, typename Ret, typename... Args>
+class MoveOnlyFunction<Ret (Args...), inlineBytes>
+{
+private:
+    static_assert (inlineBytes >= sizeof (void*),
+                   "The inline buffer must be large enough to hold at least a pointer");
+
+    using Storage = typename std::aligned_storage<inlineBytes, alignof (std::max_align_t)>::type;
+
+    template <typename Item>
+    using Decay = typename std::decay<Item>::type;
+
+    template <typename Fn>
+    static constexpr bool fitsInline()
+    {
+        return sizeof (Fn) <= inlineBytes
+                && alignof (Fn) <= alignof (Storage)
+                && std::is_nothrow_move_constructible<Fn>::value;
+    }
+
+    template <typename Item, typename Fn = Decay<Item>>
+    using IntIfValidConversion = typename std::enable_if<! std::is_same<Fn, MoveOnlyFunction>::value
+                                                             && (std::is_same<Ret, void>::value
+                                                                  || std::is_convertible<decltype (std::declval<Fn&>() (std::declval<Args>()...)), Ret>::value),
+                                                         int>::type;
+
+public:
+    /** Create an empty function. */
+    MoveOnlyFunction() noexcept = default;
+
+    /** Create an empty function. */
+    MoveOnlyFunction (std::nullptr_t) noexcept
+        : MoveOnlyFunction() {}
+
+    MoveOnlyFunction (const MoveOnlyFunction&) = delete;
+    MoveOnlyFunction& operator= (const MoveOnlyFunction&) = delete;
+
+    /** Stores the passed callable, allocating only if it cannot fit into the inline buffer. */
+    template <typename Callable,
+              typename Fn = Decay<Callable>,
+              IntIfValidConversion<Callable> = 0>
+    MoveOnlyFunction (Callable&& callable)
+    {
+        construct (std::integral_constant<bool, fitsInline<Fn>()>(), std::forward<Callable> (callable));
+    }
+
+    /** Move constructor. */
+    MoveOnlyFunction (MoveOnlyFunction&& other) noexcept
+        : vtable (other.vtable)
+    {
+        if (vtable != nullptr)
+            vtable->move (&other.storage, &storage);
+
+        other.vtable = nullptr;
+    }
+
+    /** Nulls this instance. */
+    MoveOnlyFunction& operator= (std::nullptr_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    /** Assigns a new callable to this instance. */
+    template <typename Callable, IntIfValidConversion<Callable> = 0>
+    MoveOnlyFunction& operator= (Callable&& callable)
+    {
+        return *this = MoveOnlyFunction (std::forward<Callable> (callable));
+    }
+
+    /** Move assignment operator. */
+    MoveOnlyFunction& operator= (MoveOnlyFunction&& other) noexcept
+    {
+        reset();
+        vtable = other.vtable;
+
+        if (vtable != nullptr)
+            vtable->move (&other.storage, &storage);
+
+        other.vtable = nullptr;
+        return *this;
+    }
+
+    /** Destructor. */
+    ~MoveOnlyFunction() noexcept { reset(); }
+
+    /** If this instance is currently storing a callable object, calls that object,
+        otherwise throws `std::bad_function_call`.
+    */
+    Ret operator() (Args... args) const
+    {
+        if (vtable != nullptr)
+            return vtable->call (&storage, std::forward<Args> (args)...);
+
+        throw std::bad_function_call();
+    }
+
+    /** Returns true if this instance currently holds a callable. */
+    explicit operator bool() const noexcept { return vtable != nullptr; }
+
+private:
+    template <typename Callable, typename Fn = Decay<Callable>>
+    void construct (std::true_type, Callable&& callable)
+    {
+        static constexpr auto vtableForCallable = detail::makeInlineVtable<Fn, Ret, Args...>();
+
+        auto* ptr = new (&storage) Fn (std::forward<Callable> (callable));
+        jassertquiet ((void*) ptr == (void*) &storage);
+        vtable = &vtableForCallable;
+    }
+
+    template <typename Callable, typename Fn = Decay<Callable>>
+    void construct (std::false_type, Callable&& callable)
+    {
+        static constexpr auto vtableForCallable = detail::makeHeapVtable<Fn, Ret, Args...>();
+
+        *reinterpret_cast<void**> (&storage) = new Fn (std::forward<Callable> (callable));
+        vtable = &vtableForCallable;
+    }
+
+    void reset() noexcept
+    {
+        if (vtable != nullptr)
+            vtable->destroy (&storage);
+
+        vtable = nullptr;
+    }
+
+    const detail::MoveOnlyFunctionVtable<Ret, Args...>* vtable = nullptr;
+    mutable Storage storage;
+};
+
+template <typename T, size_t inlineBytes>
+bool operator!= (const MoveOnlyFunction<T, inlineBytes>& fn, std::nullptr_t) { return bool (fn); }
+
+template <typename T, size_t inlineBytes>
+bool operator!= (std::nullptr_t, const MoveOnlyFunction<T, inlineBytes>& fn) { return bool (fn); }
+
+template <typename T, size_t inlineBytes>
+bool operator== (const MoveOnlyFunction<T, inlineBytes>& fn, std::nullptr_t) { return ! (fn != nullptr); }
+
+template <typename T, size_t inlineBytes>
+bool operator== (std::nullptr_t, const MoveOnlyFunction<T, inlineBytes>& fn) { return ! (fn != nullptr); }
+
+} // namespace juce
@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class MoveOnlyFunctionTest  : public UnitTest
+{
+public:
+    MoveOnlyFunctionTest()
+        : UnitTest ("MoveOnlyFunction", UnitTestCategories::function)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Default constructed functions are empty");
+        {
+            MoveOnlyFunction<void()> fn;
+            expect (! bool (fn));
+            expect (fn == nullptr);
+
+            MoveOnlyFunction<void()> fn2 (nullptr);
+            expect (fn2 == nullptr);
+        }
+
+        beginTest ("Small callables are stored and called inline");
+        {
+            int value = 0;
+            MoveOnlyFunction<void (int)> fn ([&value] (int i) { value += i; });
+            expect (fn != nullptr);
+
+            fn (5);
+            fn (7);
+            expectEquals (value, 12);
+        }
+
+        beginTest ("Callables too big for the inline buffer still work");
+        {
+            std::array<char, 256> big;
+            big.fill (3);
+
+            MoveOnlyFunction<int()> fn ([big] { return (int) big[100]; });
+            static_assert (sizeof (big) > 64, "this test should exercise the heap fallback");
+
+            expectEquals (fn(), 3);
+
+            auto moved = std::move (fn);
+            expect (fn == nullptr);
+            expectEquals (moved(), 3);
+        }
+
+        beginTest ("Return values are propagated");
+        {
+            MoveOnlyFunction<int (int, int)> fn ([] (int a, int b) { return a + b; });
+            expectEquals (fn (3, 4), 7);
+        }
+
+        beginTest ("Moving transfers ownership of the stored callable");
+        {
+            auto shared = std::make_shared<int>();
+            MoveOnlyFunction<void()> a ([shared] { *shared += 1; });
+            expectEquals ((int) shared.use_count(), 2);
+
+            auto b = std::move (a);
+            expect (a == nullptr);
+            expectEquals ((int) shared.use_count(), 2);
+
+            b();
+            expectEquals (*shared, 1);
+
+            b = nullptr;
+            expectEquals ((int) shared.use_count(), 1);
+        }
+
+        beginTest ("Non-copyable callables can be stored");
+        {
+            auto ptr = std::make_unique<int> (42);
+            MoveOnlyFunction<int()> fn ([p = std::move (ptr)] { return *p; });
+            expectEquals (fn(), 42);
+
+            MoveOnlyFunction<int()> other (std::move (fn));
+            expectEquals (other(), 42);
+        }
+
+        beginTest ("Assigning a new callable destroys the old one");
+        {
+            auto shared = std::make_shared<int>();
+            MoveOnlyFunction<void()> fn ([shared] {});
+            expectEquals ((int) shared.use_count(), 2);
+
+            fn = [] {};
+            expectEquals ((int) shared.use_count(), 1);
+        }
+
+        beginTest ("Calling an empty function throws");
+        {
+            bool caught = false;
+            MoveOnlyFunction<void()> fn;
+
+            try { fn(); }
+            catch (const std::bad_function_call&) { caught = true; }
+
+            expect (caught);
+        }
+    }
+};
+
+static MoveOnlyFunctionTest moveOnlyFunctionTest;
+
+} // namespace juce
@@ -0,0 +1,218 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct StartupProfileState
+{
+    CriticalSection lock;
+    Array<StartupProfile::Event> events;
+    double timeZero = 0;
+};
+
+static StartupProfileState& getStartupProfileState()
+{
+    static StartupProfileState state;
+    return state;
+}
+
+void StartupProfile::recordEvent (const String& eventName)
+{
+    const auto now = Time::getMillisecondCounterHiRes();
+    auto& state = getStartupProfileState();
+
+    const ScopedLock sl (state.lock);
+
+    if (state.events.isEmpty())
+        state.timeZero = now;
+
+    state.events.add ({ eventName, now - state.timeZero });
+}
+
+Array<StartupProfile::Event> StartupProfile::getEvents()
+{
+    auto& state = getStartupProfileState();
+
+    const ScopedLock sl (state.lock);
+    return state.events;
+}
+
+String StartupProfile::createReport()
+{
+    const auto events = getEvents();
+
+    if (events.isEmpty())
+        return "No startup events have been recorded";
+
+    String report ("Startup events (ms since first event):");
+
+    for (auto& event : events)
+        report << newLine << "  +" << String (event.milliseconds, 3) << "  " << event.name;
+
+    return report;
+}
+
+void StartupProfile::clear()
+{
+    auto& state = getStartupProfileState();
+
+    const ScopedLock sl (state.lock);
+    state.events.clearQuick();
+    state.timeZero = 0;
+}
+
+//==============================================================================
+enum { deferredInitPending = 0, deferredInitRunning = 1, deferredInitDone = 2 };
+
+// Constant-initialised, so registering an initialiser costs nothing at library load.
+static std::atomic<DeferredInitialiser*> deferredInitialiserList { nullptr };
+
+DeferredInitialiser::DeferredInitialiser (const char* subsystemName, void (*initFunction)()) noexcept
+    : name (subsystemName), initialiser (initFunction)
+{
+    next = deferredInitialiserList.load (std::memory_order_relaxed);
+
+    while (! deferredInitialiserList.compare_exchange_weak (next, this,
+                                                            std::memory_order_release,
+                                                            std::memory_order_relaxed))
+    {}
+}
+
+void DeferredInitialiser::ensureInitialised()
+{
+    auto expected = (int) deferredInitPending;
+
+    if (state.compare_exchange_strong (expected, deferredInitRunning, std::memory_order_acquire))
+    {
+        StartupProfile::recordEvent (String (name) + ": deferred init started");
+        initialiser();
+        StartupProfile::recordEvent (String (name) + ": deferred init finished");
+
+        state.store (deferredInitDone, std::memory_order_release);
+    }
+    else
+    {
+        while (state.load (std::memory_order_acquire) != deferredInitDone)
+            Thread::yield();
+    }
+}
+
+bool DeferredInitialiser::isInitialised() const noexcept
+{
+    return state.load (std::memory_order_acquire) == deferredInitDone;
+}
+
+void DeferredInitialiser::initialiseAll()
+{
+    for (auto* i = deferredInitialiserList.load (std::memory_order_acquire); i != nullptr; i = i->next)
+        i->ensureInitialised();
+}
+
+int DeferredInitialiser::getNumPending() noexcept
+{
+    int numPending = 0;
+
+    for (auto* i = deferredInitialiserList.load (std::memory_order_acquire); i != nullptr; i = i->next)
+        if (! i->isInitialised())
+            ++numPending;
+
+    return numPending;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+static int deferredInitTestRunCount = 0;
+static void runDeferredInitTest()                   { ++deferredInitTestRunCount; }
+
+static int deferredInitTestSecondRunCount = 0;
+static void runSecondDeferredInitTest()             { ++deferredInitTestSecondRunCount; }
+
+// Registered at static-init time, as in normal use - the registry holds onto
+// these, so they must outlive the test run.
+static DeferredInitialiser deferredInitTest       ("StartupProfileTestSubsystem",       runDeferredInitTest);
+static DeferredInitialiser deferredInitSecondTest ("StartupProfileTestOtherSubsystem",  runSecondDeferredInitTest);
+
+class StartupProfileTests  : public UnitTest
+{
+public:
+    StartupProfileTests()
+        : UnitTest ("StartupProfile", UnitTestCategories::time) {}
+
+    void runTest() override
+    {
+        beginTest ("Deferred initialisers run exactly once, on first use");
+        {
+            expect (! deferredInitTest.isInitialised());
+            expectEquals (deferredInitTestRunCount, 0);
+
+            deferredInitTest.ensureInitialised();
+            expect (deferredInitTest.isInitialised());
+            expectEquals (deferredInitTestRunCount, 1);
+
+            deferredInitTest.ensureInitialised();
+            expectEquals (deferredInitTestRunCount, 1);
+        }
+
+        beginTest ("initialiseAll runs whatever is still pending");
+        {
+            const auto numPendingBefore = DeferredInitialiser::getNumPending();
+            expectGreaterOrEqual (numPendingBefore, 1);
+
+            DeferredInitialiser::initialiseAll();
+
+            expectEquals (DeferredInitialiser::getNumPending(), 0);
+            expectEquals (deferredInitTestRunCount, 1);
+            expectEquals (deferredInitTestSecondRunCount, 1);
+        }
+
+        beginTest ("Recorded events form an ordered, timestamped report");
+        {
+            StartupProfile::clear();
+
+            StartupProfile::recordEvent ("first thing");
+            StartupProfile::recordEvent ("second thing");
+
+            const auto events = StartupProfile::getEvents();
+            expectEquals (events.size(), 2);
+            expectEquals (events[0].name, String ("first thing"));
+            expectEquals (events[0].milliseconds, 0.0);
+            expectGreaterOrEqual (events[1].milliseconds, 0.0);
+
+            const auto report = StartupProfile::createReport();
+            expect (report.contains ("first thing"));
+            expect (report.contains ("second thing"));
+
+            StartupProfile::clear();
+            expect (StartupProfile::getEvents().isEmpty());
+        }
+    }
+};
+
+static StartupProfileTests startupProfileTests;
+
+#endif
+
+} // namespace juce
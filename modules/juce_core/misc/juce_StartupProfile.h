@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Collects timestamped initialisation events, so the cost of framework and
+    application startup can be audited.
+
+    Subsystems call recordEvent() when they initialise something potentially
+    expensive (building a cache, scanning fonts, creating a default
+    LookAndFeel), and createReport() turns the collected events into a
+    readable timeline. This is particularly useful for plugins being scanned
+    by a host, where any initialisation that happens eagerly is paid once per
+    scanned plugin.
+
+    Recording is always on - an event is one timestamp and one string, so the
+    overhead is negligible next to the work being recorded.
+
+    @see DeferredInitialiser
+
+    @tags{Core}
+*/
+class JUCE_API  StartupProfile
+{
+public:
+    //==============================================================================
+    /** An initialisation event, timestamped relative to the first recorded event. */
+    struct Event
+    {
+        String name;
+        double milliseconds;
+    };
+
+    /** Records a named event at the current time.
+
+        This is thread-safe, and can be called from anywhere - the first call
+        defines time zero for the timeline.
+    */
+    static void recordEvent (const String& eventName);
+
+    /** Returns a copy of all the events recorded so far, in the order they happened. */
+    static Array<Event> getEvents();
+
+    /** Returns a readable timeline of the recorded events, one per line. */
+    static String createReport();
+
+    /** Discards all recorded events and resets time zero. */
+    static void clear();
+
+private:
+    StartupProfile() = delete;
+};
+
+//==============================================================================
+/**
+    Registers a named chunk of initialisation work to run on first use instead
+    of at static-initialisation time.
+
+    Declare one of these at namespace scope with a function that does the
+    expensive setup; constructing it just links it into a global registry, so
+    library load stays cheap. The work runs the first time ensureInitialised()
+    is called - typically from the accessor of whatever the initialiser sets
+    up - or when initialiseAll() is called to pay the remaining cost at a
+    moment the application chooses. Either way it runs exactly once, even when
+    several threads race, and its start and end are recorded with the
+    StartupProfile so deferred costs stay visible in the startup report.
+
+    These are intended to be statics with process lifetime: the registry keeps
+    a pointer to every instance ever constructed, so don't create them on the
+    stack.
+
+    @see StartupProfile
+
+    @tags{Core}
+*/
+class JUCE_API  DeferredInitialiser
+{
+public:
+    //==============================================================================
+    /** Registers an initialiser.
+
+        @param subsystemName  a static string naming the subsystem, used in
+                              the startup report
+        @param initialiser    the function to run on first use
+    */
+    DeferredInitialiser (const char* subsystemName, void (*initialiser)()) noexcept;
+
+    //==============================================================================
+    /** Runs the initialiser if it hasn't already run.
+
+        If another thread is running it at the same time, this blocks until
+        it has finished.
+    */
+    void ensureInitialised();
+
+    /** Returns true if the initialiser has finished running. */
+    bool isInitialised() const noexcept;
+
+    //==============================================================================
+    /** Runs every registered initialiser that hasn't already run. */
+    static void initialiseAll();
+
+    /** Returns the number of registered initialisers that haven't run yet. */
+    static int getNumPending() noexcept;
+
+private:
+    //==============================================================================
+    const char* const name;
+    void (* const initialiser)();
+    std::atomic<int> state { 0 };
+    DeferredInitialiser* next = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE (DeferredInitialiser)
+};
+
+} // namespace juce
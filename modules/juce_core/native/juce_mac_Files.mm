@@ -322,12 +322,19 @@ class DirectoryIterator::NativeIterator::Pimpl
 {
 public:
     Pimpl (const File& directory, const String& wildcard)
-        : parentDir (File::addTrailingSeparator (directory.getFullPathName())),
-          wildCard (wildcard)
+        : wildCard (wildcard)
     {
         JUCE_AUTORELEASEPOOL
         {
-            enumerator = [[[NSFileManager defaultManager] enumeratorAtPath: juceStringToNS (directory.getFullPathName())] retain];
+            // Enumerating by URL with pre-fetched attribute keys lets the OS gather the
+            // metadata for whole batches of entries in one filesystem request (it uses
+            // getattrlistbulk() internally), instead of statting each file individually.
+            enumerator = [[[NSFileManager defaultManager] enumeratorAtURL: createNSURLFromFile (directory)
+                                               includingPropertiesForKeys: [NSArray arrayWithObjects: NSURLIsDirectoryKey, NSURLIsHiddenKey,
+                                                                            NSURLFileSizeKey, NSURLContentModificationDateKey,
+                                                                            NSURLCreationDateKey, NSURLIsWritableKey, nil]
+                                                                  options: NSDirectoryEnumerationSkipsSubdirectoryDescendants
+                                                             errorHandler: nil] retain];
         }
     }
 
@@ -349,13 +356,12 @@ public:
                 if (enumerator == nil)
                     return false;
 
-                NSString* file = [enumerator nextObject];
+                NSURL* file = [enumerator nextObject];
 
                 if (file == nil)
                     return false;
 
-                [enumerator skipDescendents];
-                filenameFound = nsStringToJuce (file).convertToPrecomposedUnicode();
+                filenameFound = nsStringToJuce ([file lastPathComponent]).convertToPrecomposedUnicode();
 
                 if (wildcardUTF8 == nullptr)
                     wildcardUTF8 = wildCard.toUTF8();
@@ -363,11 +369,12 @@ public:
                 if (fnmatch (wildcardUTF8, filenameFound.toUTF8(), FNM_CASEFOLD) != 0)
                     continue;
 
-                auto fullPath = parentDir + filenameFound;
-                updateStatInfoForFile (fullPath, isDir, fileSize, modTime, creationTime, isReadOnly);
-
-                if (isHidden != nullptr)
-                    *isHidden = MacFileHelpers::isHiddenFile (fullPath);
+                if (isDir != nullptr)         *isDir        = getBoolAttribute (file, NSURLIsDirectoryKey);
+                if (isHidden != nullptr)      *isHidden     = getBoolAttribute (file, NSURLIsHiddenKey);
+                if (isReadOnly != nullptr)    *isReadOnly   = ! getBoolAttribute (file, NSURLIsWritableKey);
+                if (fileSize != nullptr)      *fileSize     = getFileSizeAttribute (file);
+                if (modTime != nullptr)       *modTime      = getTimeAttribute (file, NSURLContentModificationDateKey);
+                if (creationTime != nullptr)  *creationTime = getTimeAttribute (file, NSURLCreationDateKey);
 
                 return true;
             }
@@ -375,7 +382,31 @@ public:
     }
 
 private:
-    String parentDir, wildCard;
+    // These all read values that were already fetched during enumeration, so they
+    // don't normally need to touch the filesystem again
+    static bool getBoolAttribute (NSURL* file, NSString* key)
+    {
+        NSNumber* value = nil;
+        return [file getResourceValue: &value forKey: key error: nil] && [value boolValue];
+    }
+
+    static int64 getFileSizeAttribute (NSURL* file)
+    {
+        NSNumber* size = nil;
+        return [file getResourceValue: &size forKey: NSURLFileSizeKey error: nil] ? (int64) [size longLongValue] : 0;
+    }
+
+    static Time getTimeAttribute (NSURL* file, NSString* key)
+    {
+        NSDate* date = nil;
+
+        if (! [file getResourceValue: &date forKey: key error: nil] || date == nil)
+            return Time();
+
+        return Time ((int64) ([date timeIntervalSince1970] * 1000.0));
+    }
+
+    String wildCard;
     NSDirectoryEnumerator* enumerator = nil;
 
     JUCE_DECLARE_NON_COPYABLE (Pimpl)
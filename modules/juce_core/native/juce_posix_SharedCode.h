@@ -169,10 +169,12 @@ namespace
 {
    #if JUCE_LINUX || (JUCE_IOS && ! __DARWIN_ONLY_64_BIT_INO_T) // (this iOS stuff is to avoid a simulator bug)
     using juce_statStruct = struct stat64;
-    #define JUCE_STAT  stat64
+    #define JUCE_STAT     stat64
+    #define JUCE_FSTATAT  fstatat64
    #else
     using juce_statStruct = struct stat;
-    #define JUCE_STAT  stat
+    #define JUCE_STAT     stat
+    #define JUCE_FSTATAT  fstatat
    #endif
 
     bool juce_stat (const String& fileName, juce_statStruct& info)
@@ -992,6 +994,77 @@ bool Thread::setThreadPriority (void* handle, int priority)
     return pthread_setschedparam ((pthread_t) handle, policy, &param) == 0;
 }
 
+#if JUCE_LINUX
+ #include <sys/syscall.h>
+#endif
+
+bool Thread::setCurrentThreadRealtimeOptions (const RealtimeOptions& options)
+{
+   #if JUCE_MAC || JUCE_IOS
+    // The mach scheduler accepts an explicit period/computation pair, measured
+    // in timebase ticks, and guarantees the thread that much time per period.
+    mach_timebase_info_data_t timebase;
+    mach_timebase_info (&timebase);
+
+    const auto ticksPerMs = ((double) timebase.denom * 1000000.0) / (double) timebase.numer;
+    const auto periodMs = options.periodMs > 0 ? options.periodMs : 1.0;
+    const auto computationMs = options.processingTimeMs > 0 ? jmin (options.processingTimeMs, periodMs)
+                                                            : periodMs / 2;
+
+    const auto toTicks = [ticksPerMs] (double ms)
+    {
+        return (uint32_t) jmin ((double) std::numeric_limits<uint32_t>::max(), ms * ticksPerMs);
+    };
+
+    thread_time_constraint_policy_data_t policy;
+    policy.period      = toTicks (periodMs);
+    policy.computation = toTicks (computationMs);
+    policy.constraint  = policy.period;
+    policy.preemptible = true;
+
+    return thread_policy_set (pthread_mach_thread_np (pthread_self()),
+                              THREAD_TIME_CONSTRAINT_POLICY,
+                              (thread_policy_t) &policy,
+                              THREAD_TIME_CONSTRAINT_POLICY_COUNT) == KERN_SUCCESS;
+   #else
+    #if JUCE_LINUX && defined (SYS_sched_setattr)
+     if (options.periodMs > 0 && options.processingTimeMs > 0)
+     {
+        // SCHED_DEADLINE reserves the processing time out of every period for
+        // this thread, so other realtime work can't deschedule it mid-callback.
+        // glibc doesn't wrap sched_setattr, so the struct is declared here.
+        struct SchedAttr
+        {
+            uint32_t size;
+            uint32_t schedPolicy;
+            uint64_t schedFlags;
+            int32_t  schedNice;
+            uint32_t schedPriority;
+            uint64_t schedRuntime, schedDeadline, schedPeriod;
+        };
+
+        SchedAttr attr = {};
+        attr.size = sizeof (attr);
+        attr.schedPolicy   = 6; // SCHED_DEADLINE
+        attr.schedRuntime  = (uint64_t) (options.processingTimeMs * 1000000.0);
+        attr.schedDeadline = (uint64_t) (options.periodMs * 1000000.0);
+        attr.schedPeriod   = attr.schedDeadline;
+
+        // NB: this will fail if the thread's affinity has been restricted, or
+        // without the right privileges, in which case we fall back to SCHED_RR.
+        if (syscall (SYS_sched_setattr, (pid_t) syscall (SYS_gettid), &attr, 0u) == 0)
+            return true;
+     }
+    #else
+     ignoreUnused (options);
+    #endif
+
+    struct sched_param param;
+    param.sched_priority = sched_get_priority_max (SCHED_RR);
+    return pthread_setschedparam (pthread_self(), SCHED_RR, &param) == 0;
+   #endif
+}
+
 Thread::ThreadID JUCE_CALLTYPE Thread::getCurrentThreadId()
 {
     return (ThreadID) pthread_self();
@@ -146,6 +146,29 @@ bool Thread::setThreadPriority (void* handle, int priority)
     return SetThreadPriority (handle, pri) != FALSE;
 }
 
+bool Thread::setCurrentThreadRealtimeOptions (const RealtimeOptions& options)
+{
+    ignoreUnused (options);
+
+    // Joining the "Pro Audio" MMCSS task class tells the scheduler that this
+    // thread is doing low-latency audio work, which stops it being starved by
+    // ordinary high-priority threads. Avrt.dll isn't available everywhere, so
+    // it's loaded dynamically.
+    static DynamicLibrary avrtDll ("avrt.dll");
+    JUCE_LOAD_WINAPI_FUNCTION (avrtDll, AvSetMmThreadCharacteristicsW,
+                               avSetMmThreadCharacteristics, HANDLE, (LPCWSTR, LPDWORD))
+
+    if (avSetMmThreadCharacteristics != nullptr)
+    {
+        DWORD taskIndex = 0;
+
+        if (avSetMmThreadCharacteristics (L"Pro Audio", &taskIndex) != nullptr)
+            return true;
+    }
+
+    return SetThreadPriority (GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL) != FALSE;
+}
+
 void JUCE_CALLTYPE Thread::setCurrentThreadAffinityMask (const uint32 affinityMask)
 {
     SetThreadAffinityMask (GetCurrentThread(), affinityMask);
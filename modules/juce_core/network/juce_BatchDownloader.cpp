@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+BatchDownloader::BatchDownloader (int maxConcurrentFetches)
+    : pool (jmax (1, maxConcurrentFetches))
+{
+}
+
+BatchDownloader::~BatchDownloader()
+{
+    cancelAllFetches();
+}
+
+void BatchDownloader::fetchAsync (const URL& urlToFetch, FetchCallback callbackToInvoke)
+{
+    ++numPending;
+    auto gen = generation.load();
+
+    pool.addJob ([this, urlToFetch, callback = std::move (callbackToInvoke), gen]
+    {
+        FetchResult result;
+        result.url = urlToFetch;
+
+        if (gen == generation.load())
+        {
+            WebInputStream stream (urlToFetch, false);
+            stream.withExtraHeaders ("Connection: keep-alive");
+
+            {
+                const ScopedLock sl (activeStreamLock);
+                activeStreams.add (&stream);
+            }
+
+            if (stream.connect (nullptr) && ! stream.isError())
+            {
+                result.statusCode = stream.getStatusCode();
+                stream.readIntoMemoryBlock (result.data);
+
+                result.success = (result.statusCode == 0 || result.statusCode < 400)
+                                  && ! stream.isError()
+                                  && gen == generation.load();
+            }
+
+            {
+                const ScopedLock sl (activeStreamLock);
+                activeStreams.removeFirstMatchingValue (&stream);
+            }
+        }
+
+        if (callback != nullptr)
+            callback (result);
+
+        if (--numPending == 0)
+            allFetchesDone.signal();
+    });
+}
+
+int BatchDownloader::getNumPendingFetches() const noexcept
+{
+    return numPending.load();
+}
+
+bool BatchDownloader::waitForAllFetches (int timeOutMilliseconds)
+{
+    auto endTime = Time::getMillisecondCounter() + (uint32) jmax (0, timeOutMilliseconds);
+
+    while (numPending.load() > 0)
+    {
+        if (timeOutMilliseconds >= 0 && Time::getMillisecondCounter() >= endTime)
+            return false;
+
+        allFetchesDone.wait (20);
+    }
+
+    return true;
+}
+
+void BatchDownloader::cancelAllFetches()
+{
+    // makes jobs that haven't started yet, and fetches still reading,
+    // complete immediately with success = false
+    ++generation;
+
+    const ScopedLock sl (activeStreamLock);
+
+    for (auto* stream : activeStreams)
+        stream->cancel();
+}
+
+} // namespace juce
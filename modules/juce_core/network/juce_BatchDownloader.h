@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Fetches batches of URLs concurrently, delivering each result to a callback.
+
+    Downloading many small resources one WebInputStream at a time leaves the
+    link idle while each connection and TLS handshake completes. This class
+    keeps a fixed number of fetches in flight at once on its own thread pool,
+    so the handshakes overlap and bulk downloads are limited by bandwidth
+    rather than round-trips. Requests are marked keep-alive so that platform
+    backends which pool connections can reuse them between fetches to the
+    same host.
+
+    Completion callbacks are invoked on the downloader's worker threads, so
+    use something like MessageManager::callAsync inside the callback if the
+    result needs to reach the message thread.
+
+    @see WebInputStream, URL::downloadToFile
+
+    @tags{Core}
+*/
+class JUCE_API  BatchDownloader
+{
+public:
+    //==============================================================================
+    /** Creates a downloader which will run up to the given number of fetches
+        in parallel.
+    */
+    explicit BatchDownloader (int maxConcurrentFetches = 4);
+
+    /** Destructor.
+        Cancels any fetches that are still running and waits for them to stop.
+        Fetches still queued when the downloader is destroyed are dropped
+        without their callbacks being invoked.
+    */
+    ~BatchDownloader();
+
+    //==============================================================================
+    /** The outcome of a single fetch, handed to the completion callback. */
+    struct FetchResult
+    {
+        URL url;             /**< The URL that was requested. */
+        MemoryBlock data;    /**< The body of the response, if any was read. */
+        int statusCode = 0;  /**< The HTTP status code, or 0 for non-HTTP streams. */
+        bool success = false;/**< True if the stream connected and was read without error. */
+    };
+
+    /** A callback invoked on a worker thread when a fetch completes or fails. */
+    using FetchCallback = std::function<void (const FetchResult&)>;
+
+    //==============================================================================
+    /** Queues a URL to be fetched.
+
+        The callback is always invoked exactly once per call - with success set
+        to false if the fetch failed or was cancelled - unless the downloader is
+        destroyed while the fetch is still queued.
+    */
+    void fetchAsync (const URL& urlToFetch, FetchCallback callbackToInvoke);
+
+    /** Returns the number of fetches that are queued or in flight. */
+    int getNumPendingFetches() const noexcept;
+
+    /** Blocks until all queued fetches have completed.
+        @param timeOutMilliseconds  how long to wait, or a value < 0 to wait forever
+        @returns true if everything completed in time
+    */
+    bool waitForAllFetches (int timeOutMilliseconds);
+
+    /** Cancels all fetches that are currently queued or in flight.
+
+        Their callbacks will still be invoked, with success set to false.
+        Fetches queued after this call are unaffected.
+    */
+    void cancelAllFetches();
+
+private:
+    //==============================================================================
+    mutable CriticalSection activeStreamLock;
+    Array<WebInputStream*> activeStreams;
+    std::atomic<int> numPending { 0 };
+    std::atomic<int> generation { 0 };
+    WaitableEvent allFetchesDone;
+    ThreadPool pool;  // must be the last member, so its jobs stop before anything else is destroyed
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BatchDownloader)
+};
+
+} // namespace juce
@@ -0,0 +1,519 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_LINUX || JUCE_ANDROID
+ #include <sys/epoll.h>
+ #define JUCE_SOCKETPOLLER_EPOLL 1
+#elif JUCE_MAC || JUCE_IOS || JUCE_BSD
+ #include <sys/event.h>
+ #define JUCE_SOCKETPOLLER_KQUEUE 1
+#endif
+
+namespace juce
+{
+
+#if ! JUCE_WASM
+
+//==============================================================================
+SocketPoller::SocketPoller()  : Thread ("Socket Poller")
+{
+    SocketHelpers::initSockets();
+}
+
+SocketPoller::~SocketPoller()
+{
+    signalThreadShouldExit();
+    wake();
+    stopThread (5000);
+
+   #if JUCE_SOCKETPOLLER_EPOLL || JUCE_SOCKETPOLLER_KQUEUE
+    if (wakeReceiveHandle >= 0)   ::close (wakeReceiveHandle);
+    if (wakeSendHandle >= 0)      ::close (wakeSendHandle);
+    if (multiplexerHandle >= 0)   ::close (multiplexerHandle);
+   #else
+    if (wakeReceiveHandle >= 0)
+    {
+       #if JUCE_WINDOWS
+        closesocket ((SocketHandle) wakeReceiveHandle);
+       #else
+        ::close (wakeReceiveHandle);
+       #endif
+    }
+   #endif
+}
+
+//==============================================================================
+bool SocketPoller::ensureInitialised()
+{
+    if (wakeReceiveHandle >= 0)
+        return true;
+
+   #if JUCE_SOCKETPOLLER_EPOLL || JUCE_SOCKETPOLLER_KQUEUE
+    int pipeHandles[2];
+
+    if (::pipe (pipeHandles) != 0)
+        return false;
+
+    for (auto h : pipeHandles)
+        fcntl (h, F_SETFL, fcntl (h, F_GETFL) | O_NONBLOCK);
+
+   #if JUCE_SOCKETPOLLER_EPOLL
+    multiplexerHandle = epoll_create1 (0);
+   #else
+    multiplexerHandle = kqueue();
+   #endif
+
+    if (multiplexerHandle < 0)
+    {
+        ::close (pipeHandles[0]);
+        ::close (pipeHandles[1]);
+        return false;
+    }
+
+    wakeReceiveHandle = pipeHandles[0];
+    wakeSendHandle = pipeHandles[1];
+
+   #if JUCE_SOCKETPOLLER_EPOLL
+    epoll_event ev {};
+    ev.events = EPOLLIN;
+    ev.data.fd = wakeReceiveHandle;
+    epoll_ctl (multiplexerHandle, EPOLL_CTL_ADD, wakeReceiveHandle, &ev);
+   #else
+    struct kevent ev;
+    EV_SET (&ev, (uintptr_t) wakeReceiveHandle, EVFILT_READ, EV_ADD, 0, 0, nullptr);
+    kevent (multiplexerHandle, &ev, 1, nullptr, 0, nullptr);
+   #endif
+
+    return true;
+   #else
+    // The fallback backend wakes its select() call through a loopback datagram
+    // socket that is connected to itself.
+    auto wakeSocket = socket (AF_INET, SOCK_DGRAM, 0);
+
+    if (wakeSocket == invalidSocket)
+        return false;
+
+    struct sockaddr_in addr;
+    zerostruct (addr);
+    addr.sin_family = PF_INET;
+    addr.sin_addr.s_addr = inet_addr ("127.0.0.1");
+
+    socklen_t len = sizeof (addr);
+
+    if (::bind (wakeSocket, (struct sockaddr*) &addr, sizeof (addr)) != 0
+         || getsockname (wakeSocket, (struct sockaddr*) &addr, &len) != 0
+         || ::connect (wakeSocket, (struct sockaddr*) &addr, sizeof (addr)) != 0)
+    {
+       #if JUCE_WINDOWS
+        closesocket (wakeSocket);
+       #else
+        ::close (wakeSocket);
+       #endif
+        return false;
+    }
+
+    SocketHelpers::setSocketBlockingState (wakeSocket, false);
+    wakeReceiveHandle = wakeSendHandle = (int) wakeSocket;
+    return true;
+   #endif
+}
+
+void SocketPoller::wake() const noexcept
+{
+    if (wakeSendHandle >= 0)
+    {
+        char c = 0;
+
+       #if JUCE_SOCKETPOLLER_EPOLL || JUCE_SOCKETPOLLER_KQUEUE
+        [[maybe_unused]] auto result = ::write (wakeSendHandle, &c, 1);
+       #else
+        ::send ((SocketHandle) wakeSendHandle, &c, 1, 0);
+       #endif
+    }
+}
+
+//==============================================================================
+bool SocketPoller::addSocket (int rawSocketHandle, bool listenForReading, bool listenForWriting,
+                              ReadinessCallback callback)
+{
+    if ((SocketHandle) rawSocketHandle == invalidSocket
+         || callback == nullptr
+         || ! (listenForReading || listenForWriting))
+        return false;
+
+    const ScopedLock sl (lock);
+
+    if (! ensureInitialised())
+        return false;
+
+   #if JUCE_SOCKETPOLLER_EPOLL
+    epoll_event ev {};
+    ev.events = (listenForReading ? (uint32_t) EPOLLIN : 0u) | (listenForWriting ? (uint32_t) EPOLLOUT : 0u);
+    ev.data.fd = rawSocketHandle;
+
+    if (epoll_ctl (multiplexerHandle, EPOLL_CTL_ADD, rawSocketHandle, &ev) != 0
+         && (errno != EEXIST || epoll_ctl (multiplexerHandle, EPOLL_CTL_MOD, rawSocketHandle, &ev) != 0))
+        return false;
+   #elif JUCE_SOCKETPOLLER_KQUEUE
+    auto applyFilter = [this, rawSocketHandle] (int16_t filter, bool enable)
+    {
+        struct kevent ev;
+        EV_SET (&ev, (uintptr_t) rawSocketHandle, filter, enable ? EV_ADD : EV_DELETE, 0, 0, nullptr);
+        return kevent (multiplexerHandle, &ev, 1, nullptr, 0, nullptr) == 0;
+    };
+
+    // drop any previous registration before adding the requested filters
+    applyFilter (EVFILT_READ, false);
+    applyFilter (EVFILT_WRITE, false);
+
+    if ((listenForReading && ! applyFilter (EVFILT_READ, true))
+         || (listenForWriting && ! applyFilter (EVFILT_WRITE, true)))
+        return false;
+   #endif
+
+    auto registered = false;
+
+    for (auto& s : sockets)
+    {
+        if (s.handle == rawSocketHandle)
+        {
+            s = { rawSocketHandle, listenForReading, listenForWriting, std::move (callback) };
+            registered = true;
+            break;
+        }
+    }
+
+    if (! registered)
+        sockets.add ({ rawSocketHandle, listenForReading, listenForWriting, std::move (callback) });
+
+    if (! isThreadRunning())
+        startThread();
+
+    wake();
+    return true;
+}
+
+bool SocketPoller::addSocket (const StreamingSocket& socket, bool listenForReading, bool listenForWriting,
+                              ReadinessCallback callback)
+{
+    return addSocket (socket.getRawSocketHandle(), listenForReading, listenForWriting, std::move (callback));
+}
+
+bool SocketPoller::addSocket (const DatagramSocket& socket, bool listenForReading, bool listenForWriting,
+                              ReadinessCallback callback)
+{
+    return addSocket (socket.getRawSocketHandle(), listenForReading, listenForWriting, std::move (callback));
+}
+
+void SocketPoller::removeSocket (int rawSocketHandle)
+{
+    const ScopedLock sl (lock);
+
+    for (int i = sockets.size(); --i >= 0;)
+    {
+        if (sockets.getReference (i).handle == rawSocketHandle)
+        {
+            sockets.remove (i);
+
+           #if JUCE_SOCKETPOLLER_EPOLL
+            epoll_ctl (multiplexerHandle, EPOLL_CTL_DEL, rawSocketHandle, nullptr);
+           #elif JUCE_SOCKETPOLLER_KQUEUE
+            for (auto filter : { EVFILT_READ, EVFILT_WRITE })
+            {
+                struct kevent ev;
+                EV_SET (&ev, (uintptr_t) rawSocketHandle, filter, EV_DELETE, 0, 0, nullptr);
+                kevent (multiplexerHandle, &ev, 1, nullptr, 0, nullptr);
+            }
+           #endif
+
+            wake();
+            break;
+        }
+    }
+}
+
+void SocketPoller::removeSocket (const StreamingSocket& socket)   { removeSocket (socket.getRawSocketHandle()); }
+void SocketPoller::removeSocket (const DatagramSocket& socket)    { removeSocket (socket.getRawSocketHandle()); }
+
+int SocketPoller::getNumSockets() const
+{
+    const ScopedLock sl (lock);
+    return sockets.size();
+}
+
+//==============================================================================
+void SocketPoller::dispatch (int handle, bool readable, bool writable)
+{
+    for (auto& s : sockets)
+    {
+        if (s.handle == handle)
+        {
+            auto wantedRead  = readable && s.wantsRead;
+            auto wantedWrite = writable && s.wantsWrite;
+
+            if (wantedRead || wantedWrite || ! (readable || writable))
+            {
+                // take a copy, as the callback may remove its own registration
+                auto callback = s.callback;
+                callback (wantedRead, wantedWrite);
+            }
+
+            return;
+        }
+    }
+}
+
+void SocketPoller::run()
+{
+    constexpr int maxEventsPerBatch = 64;
+
+    while (! threadShouldExit())
+    {
+       #if JUCE_SOCKETPOLLER_EPOLL
+        epoll_event events[maxEventsPerBatch];
+        auto numEvents = epoll_wait (multiplexerHandle, events, maxEventsPerBatch, 1000);
+
+        if (numEvents <= 0)
+            continue;
+
+        const ScopedLock sl (lock);
+
+        for (int i = 0; i < numEvents; ++i)
+        {
+            auto h = events[i].data.fd;
+
+            if (h == wakeReceiveHandle)
+            {
+                char buffer[256];
+                while (::read (wakeReceiveHandle, buffer, sizeof (buffer)) > 0) {}
+            }
+            else
+            {
+                dispatch (h, (events[i].events & EPOLLIN) != 0,
+                             (events[i].events & EPOLLOUT) != 0);
+            }
+        }
+       #elif JUCE_SOCKETPOLLER_KQUEUE
+        struct kevent events[maxEventsPerBatch];
+        struct timespec timeout { 1, 0 };
+        auto numEvents = kevent (multiplexerHandle, nullptr, 0, events, maxEventsPerBatch, &timeout);
+
+        if (numEvents <= 0)
+            continue;
+
+        const ScopedLock sl (lock);
+
+        for (int i = 0; i < numEvents; ++i)
+        {
+            auto h = (int) events[i].ident;
+
+            if (h == wakeReceiveHandle)
+            {
+                char buffer[256];
+                while (::read (wakeReceiveHandle, buffer, sizeof (buffer)) > 0) {}
+            }
+            else if ((events[i].flags & EV_ERROR) != 0)
+            {
+                dispatch (h, false, false);
+            }
+            else
+            {
+                dispatch (h, events[i].filter == EVFILT_READ,
+                             events[i].filter == EVFILT_WRITE);
+            }
+        }
+       #else
+        struct Interest { int handle; bool wantsRead, wantsWrite; };
+        Array<Interest> interests;
+
+        fd_set readSet, writeSet;
+        FD_ZERO (&readSet);
+        FD_ZERO (&writeSet);
+        FD_SET ((SocketHandle) wakeReceiveHandle, &readSet);
+        auto maxHandle = wakeReceiveHandle;
+
+        {
+            const ScopedLock sl (lock);
+
+            for (auto& s : sockets)
+            {
+                if (s.wantsRead)    FD_SET ((SocketHandle) s.handle, &readSet);
+                if (s.wantsWrite)   FD_SET ((SocketHandle) s.handle, &writeSet);
+
+                interests.add ({ s.handle, s.wantsRead, s.wantsWrite });
+                maxHandle = jmax (maxHandle, s.handle);
+            }
+        }
+
+        struct timeval timeout { 1, 0 };
+
+        if (select (maxHandle + 1, &readSet, &writeSet, nullptr, &timeout) <= 0)
+            continue;
+
+        if (FD_ISSET ((SocketHandle) wakeReceiveHandle, &readSet))
+        {
+            char buffer[256];
+            recv ((SocketHandle) wakeReceiveHandle, buffer, sizeof (buffer), 0);
+        }
+
+        const ScopedLock sl (lock);
+
+        for (auto& s : interests)
+        {
+            auto readable = s.wantsRead  && FD_ISSET ((SocketHandle) s.handle, &readSet) != 0;
+            auto writable = s.wantsWrite && FD_ISSET ((SocketHandle) s.handle, &writeSet) != 0;
+
+            if (readable || writable)
+                dispatch (s.handle, readable, writable);
+        }
+       #endif
+    }
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct SocketPollerTests : public UnitTest
+{
+    SocketPollerTests()
+        : UnitTest ("SocketPoller", UnitTestCategories::networking)
+    {
+    }
+
+    void runTest() override
+    {
+        auto localHost = IPAddress::local();
+        int portNum = 12346;
+
+        beginTest ("Accept, read and write callbacks");
+        {
+            StreamingSocket listener;
+            expect (listener.createListener (portNum, localHost.toString()));
+
+            WaitableEvent accepted, dataArrived, writable;
+            std::unique_ptr<StreamingSocket> serverSide;
+            StreamingSocket client;
+            SocketPoller poller;
+
+            expect (poller.addSocket (listener, true, false,
+                                      [&] (bool readyForReading, bool)
+                                      {
+                                          if (readyForReading)
+                                              accepted.signal();
+                                      }));
+            expectEquals (poller.getNumSockets(), 1);
+
+            expect (client.connect (localHost.toString(), portNum));
+            expect (accepted.wait (5000));
+
+            poller.removeSocket (listener);
+            expectEquals (poller.getNumSockets(), 0);
+
+            serverSide.reset (listener.waitForNextConnection());
+            expect (serverSide != nullptr);
+
+            if (serverSide != nullptr)
+            {
+                expect (poller.addSocket (*serverSide, true, false,
+                                          [&] (bool readyForReading, bool)
+                                          {
+                                              if (readyForReading)
+                                                  dataArrived.signal();
+                                          }));
+
+                expect (client.write ("hello", 5) == 5);
+                expect (dataArrived.wait (5000));
+
+                char buffer[8] = {};
+                expect (serverSide->read (buffer, 5, true) == 5);
+                expect (memcmp (buffer, "hello", 5) == 0);
+
+                poller.removeSocket (*serverSide);
+            }
+
+            // a connected socket with free send buffer space should report
+            // writability straight away
+            expect (poller.addSocket (client, false, true,
+                                      [&] (bool, bool readyForWriting)
+                                      {
+                                          if (readyForWriting)
+                                              writable.signal();
+                                      }));
+            expect (writable.wait (5000));
+            poller.removeSocket (client);
+        }
+
+        beginTest ("Batched delivery across many sockets");
+        {
+            StreamingSocket listener;
+            expect (listener.createListener (portNum, localHost.toString()));
+
+            constexpr int numConnections = 8;
+            OwnedArray<StreamingSocket> clients, serverSides;
+
+            for (int i = 0; i < numConnections; ++i)
+            {
+                auto* client = clients.add (new StreamingSocket());
+                expect (client->connect (localHost.toString(), portNum));
+                expect (serverSides.add (listener.waitForNextConnection()) != nullptr);
+            }
+
+            std::atomic<int> numSignalled { 0 };
+            WaitableEvent allSignalled;
+            SocketPoller poller;
+
+            for (auto* s : serverSides)
+            {
+                poller.addSocket (*s, true, false,
+                                  [&, s] (bool readyForReading, bool)
+                                  {
+                                      if (readyForReading)
+                                      {
+                                          poller.removeSocket (*s);
+
+                                          if (++numSignalled == numConnections)
+                                              allSignalled.signal();
+                                      }
+                                  });
+            }
+
+            expectEquals (poller.getNumSockets(), numConnections);
+
+            for (auto* client : clients)
+                expect (client->write ("!", 1) == 1);
+
+            expect (allSignalled.wait (5000));
+            expectEquals (numSignalled.load(), numConnections);
+            expectEquals (poller.getNumSockets(), 0);
+        }
+    }
+};
+
+static SocketPollerTests socketPollerTests;
+
+#endif
+
+#endif
+
+} // namespace juce
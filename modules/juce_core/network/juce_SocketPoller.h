@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if ! JUCE_WASM
+
+//==============================================================================
+/**
+    Watches a collection of sockets from a single background thread, and calls
+    back when any of them become ready to read or write.
+
+    StreamingSocket::waitUntilReady() blocks one thread per socket, which
+    doesn't scale to servers with many connections. A single SocketPoller
+    multiplexes all of its registered sockets onto one service thread, backed
+    by epoll or kqueue where the OS provides them: each wait wakes up with a
+    batch of ready sockets, so the cost of a cycle is proportional to the
+    number of active sockets rather than the number registered.
+
+    The poller is level-triggered: a socket's callback will fire again on the
+    next cycle for as long as the socket remains ready, so a callback should
+    read or write until the socket would block, or remove it from the poller.
+
+    Callbacks are always invoked on the poller's own thread, and a callback
+    may safely add or remove sockets (including its own) from inside the call.
+    Once removeSocket() has returned, the callback for that socket will not be
+    invoked again. Always remove a socket before closing it - the poller
+    watches the raw OS handle, which the system may reuse for an unrelated
+    socket once closed.
+
+    @see StreamingSocket, DatagramSocket
+
+    @tags{Core}
+*/
+class JUCE_API  SocketPoller  final : private Thread
+{
+public:
+    //==============================================================================
+    /** Creates an empty poller.
+
+        The service thread is started when the first socket is added.
+    */
+    SocketPoller();
+
+    /** Destructor.
+
+        Stops the service thread. Any sockets still registered are forgotten,
+        but not closed.
+    */
+    ~SocketPoller() override;
+
+    //==============================================================================
+    /** The type of callback invoked when a watched socket becomes ready.
+
+        The flags indicate which of the requested events are signalled. If an
+        error or hang-up is detected on the socket, the callback is invoked
+        with both flags false, and the socket should normally be removed.
+    */
+    using ReadinessCallback = std::function<void (bool readyForReading, bool readyForWriting)>;
+
+    //==============================================================================
+    /** Starts watching a raw socket handle.
+
+        If the handle is already being watched, its events of interest and
+        callback are replaced.
+
+        @param rawSocketHandle    a handle as returned by getRawSocketHandle()
+        @param listenForReading   if true, the callback fires when there's data to read
+                                  (or, for a listener socket, a connection to accept)
+        @param listenForWriting   if true, the callback fires when the socket can be
+                                  written without blocking
+        @param callback           invoked on the poller's thread when the socket is ready
+
+        @returns  true if the socket was registered successfully
+    */
+    bool addSocket (int rawSocketHandle, bool listenForReading, bool listenForWriting,
+                    ReadinessCallback callback);
+
+    /** Starts watching a StreamingSocket. @see addSocket */
+    bool addSocket (const StreamingSocket& socket, bool listenForReading, bool listenForWriting,
+                    ReadinessCallback callback);
+
+    /** Starts watching a DatagramSocket. @see addSocket */
+    bool addSocket (const DatagramSocket& socket, bool listenForReading, bool listenForWriting,
+                    ReadinessCallback callback);
+
+    //==============================================================================
+    /** Stops watching a socket handle.
+
+        If this is called from anywhere other than the socket's own callback,
+        it will block until any callback that is currently in progress has
+        returned, so on return it's safe to close the socket.
+    */
+    void removeSocket (int rawSocketHandle);
+
+    /** Stops watching a StreamingSocket. @see removeSocket */
+    void removeSocket (const StreamingSocket& socket);
+
+    /** Stops watching a DatagramSocket. @see removeSocket */
+    void removeSocket (const DatagramSocket& socket);
+
+    /** Returns the number of sockets currently being watched. */
+    int getNumSockets() const;
+
+private:
+    //==============================================================================
+    struct WatchedSocket
+    {
+        int handle;
+        bool wantsRead, wantsWrite;
+        ReadinessCallback callback;
+    };
+
+    void run() override;
+    bool ensureInitialised();
+    void wake() const noexcept;
+    void dispatch (int handle, bool readable, bool writable);
+
+    mutable CriticalSection lock;
+    Array<WatchedSocket> sockets;
+    int multiplexerHandle = -1;
+    int wakeSendHandle = -1, wakeReceiveHandle = -1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SocketPoller)
+};
+
+#endif
+
+} // namespace juce
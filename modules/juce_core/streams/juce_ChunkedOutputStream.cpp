@@ -0,0 +1,297 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+ChunkedOutputStream::ChunkedOutputStream (size_t chunkSizeToUse, int64 maxBytesToKeepInMemory)
+    : chunkSize (jmax ((size_t) 64, chunkSizeToUse)),
+      maxBytesInMemory (maxBytesToKeepInMemory)
+{
+}
+
+ChunkedOutputStream::~ChunkedOutputStream()
+{
+    // The TemporaryFile removes any spilled data from disk when it goes away.
+}
+
+void ChunkedOutputStream::reset()
+{
+    spilledStream.reset();
+    spilledFile.reset();
+    chunks.clear();
+    bytesUsedInLastChunk = 0;
+    size = 0;
+    spillAttemptFailed = false;
+}
+
+//==============================================================================
+bool ChunkedOutputStream::writeToMemory (const void* data, size_t numBytes)
+{
+    auto* source = static_cast<const char*> (data);
+
+    while (numBytes > 0)
+    {
+        if (chunks.isEmpty() || bytesUsedInLastChunk == chunkSize)
+        {
+            chunks.add (new MemoryBlock (chunkSize));
+            bytesUsedInLastChunk = 0;
+        }
+
+        const auto numThisTime = jmin (numBytes, chunkSize - bytesUsedInLastChunk);
+        memcpy (static_cast<char*> (chunks.getLast()->getData()) + bytesUsedInLastChunk,
+                source, numThisTime);
+
+        bytesUsedInLastChunk += numThisTime;
+        source += numThisTime;
+        numBytes -= numThisTime;
+    }
+
+    return true;
+}
+
+bool ChunkedOutputStream::spillToDisk()
+{
+    auto file = std::make_unique<TemporaryFile>();
+    auto stream = std::make_unique<FileOutputStream> (file->getFile(), chunkSize);
+
+    if (stream->failedToOpen() || ! writeTo (*stream))
+        return false;
+
+    chunks.clear();
+    bytesUsedInLastChunk = 0;
+    spilledFile = std::move (file);
+    spilledStream = std::move (stream);
+    return true;
+}
+
+bool ChunkedOutputStream::write (const void* data, size_t numBytes)
+{
+    if (spilledStream != nullptr)
+    {
+        if (! spilledStream->write (data, numBytes))
+            return false;
+    }
+    else
+    {
+        writeToMemory (data, numBytes);
+    }
+
+    size += (int64) numBytes;
+
+    if (spilledStream == nullptr && ! spillAttemptFailed
+         && maxBytesInMemory >= 0 && size > maxBytesInMemory)
+    {
+        // If the temporary file can't be created there's nothing for it but
+        // to carry on in memory - but don't retry on every write.
+        spillAttemptFailed = ! spillToDisk();
+    }
+
+    return true;
+}
+
+void ChunkedOutputStream::flush()
+{
+    if (spilledStream != nullptr)
+        spilledStream->flush();
+}
+
+bool ChunkedOutputStream::setPosition (int64 newPosition)
+{
+    return newPosition == size;
+}
+
+//==============================================================================
+bool ChunkedOutputStream::writeTo (OutputStream& destStream)
+{
+    if (spilledFile != nullptr)
+    {
+        spilledStream->flush();
+        FileInputStream in (spilledFile->getFile());
+
+        return in.openedOk()
+                && destStream.writeFromInputStream (in, size) == size;
+    }
+
+    for (int i = 0; i < chunks.size(); ++i)
+    {
+        const auto numBytes = i == chunks.size() - 1 ? bytesUsedInLastChunk
+                                                     : chunkSize;
+
+        if (! destStream.write (chunks.getUnchecked (i)->getData(), numBytes))
+            return false;
+    }
+
+    return true;
+}
+
+bool ChunkedOutputStream::writeToFile (const File& destFile)
+{
+    if (spilledFile != nullptr)
+    {
+        // The data's already on disk, so this is just a rename.
+        spilledStream->flush();
+        spilledStream.reset();
+
+        if (! spilledFile->getFile().moveFileTo (destFile))
+        {
+            // Reopen at the end of the temporary file, so that the stream can
+            // still be appended to or retried.
+            spilledStream = std::make_unique<FileOutputStream> (spilledFile->getFile(), chunkSize);
+            return false;
+        }
+
+        spilledFile.reset();
+        reset();
+        return true;
+    }
+
+    TemporaryFile temp (destFile);
+
+    {
+        FileOutputStream out (temp.getFile(), chunkSize);
+
+        if (out.failedToOpen() || ! writeTo (out))
+            return false;
+    }
+
+    if (! temp.overwriteTargetFileWithTemporary())
+        return false;
+
+    reset();
+    return true;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ChunkedOutputStreamTests  : public UnitTest
+{
+public:
+    ChunkedOutputStreamTests()
+        : UnitTest ("ChunkedOutputStream", UnitTestCategories::streams)
+    {}
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        MemoryBlock reference;
+
+        {
+            MemoryOutputStream mo (reference, false);
+
+            for (int i = 0; i < 10000; ++i)
+                mo.writeByte ((char) r.nextInt (256));
+        }
+
+        const auto writeInRandomPieces = [&] (OutputStream& dest)
+        {
+            size_t pos = 0;
+
+            while (pos < reference.getSize())
+            {
+                const auto numBytes = jmin (reference.getSize() - pos,
+                                            (size_t) (1 + r.nextInt (300)));
+                dest.write (addBytesToPointer (reference.getData(), pos), numBytes);
+                pos += numBytes;
+            }
+        };
+
+        beginTest ("Chunked writes round-trip without spilling");
+        {
+            ChunkedOutputStream stream (128);
+            writeInRandomPieces (stream);
+
+            expect (! stream.hasSpilledToDisk());
+            expectEquals (stream.getDataSize(), (int64) reference.getSize());
+
+            MemoryOutputStream out;
+            expect (stream.writeTo (out));
+            expect (out.getDataSize() == reference.getSize()
+                     && memcmp (out.getData(), reference.getData(), reference.getSize()) == 0);
+
+            // The contents survive being streamed out, and can go out again.
+            MemoryOutputStream again;
+            expect (stream.writeTo (again));
+            expectEquals ((int) again.getDataSize(), (int) reference.getSize());
+        }
+
+        beginTest ("Contents spill to a temporary file past the memory limit");
+        {
+            ChunkedOutputStream stream (128, 1000);
+            writeInRandomPieces (stream);
+
+            expect (stream.hasSpilledToDisk());
+            expectEquals (stream.getDataSize(), (int64) reference.getSize());
+
+            MemoryOutputStream out;
+            expect (stream.writeTo (out));
+            expect (out.getDataSize() == reference.getSize()
+                     && memcmp (out.getData(), reference.getData(), reference.getSize()) == 0);
+        }
+
+        beginTest ("writeToFile hands the contents over and empties the stream");
+        {
+            for (auto memoryLimit : { (int64) -1, (int64) 1000 })
+            {
+                const auto target = File::getSpecialLocation (File::tempDirectory)
+                                        .getNonexistentChildFile ("juce_chunked_stream_test", ".dat");
+
+                ChunkedOutputStream stream (256, memoryLimit);
+                writeInRandomPieces (stream);
+                expect (stream.hasSpilledToDisk() == (memoryLimit >= 0));
+
+                expect (stream.writeToFile (target));
+                expectEquals (stream.getDataSize(), (int64) 0);
+                expect (! stream.hasSpilledToDisk());
+
+                MemoryBlock loaded;
+                expect (target.loadFileAsData (loaded));
+                expect (loaded == reference);
+                expect (target.deleteFile());
+
+                // The emptied stream is immediately reusable.
+                stream.writeByte (42);
+                expectEquals (stream.getDataSize(), (int64) 1);
+            }
+        }
+
+        beginTest ("Position reporting and append-only setPosition");
+        {
+            ChunkedOutputStream stream (64);
+            stream.writeRepeatedByte (7, 1000);
+
+            expectEquals (stream.getPosition(), (int64) 1000);
+            expect (stream.setPosition (1000));
+            expect (! stream.setPosition (0));
+        }
+    }
+};
+
+static ChunkedOutputStreamTests chunkedOutputStreamTests;
+
+#endif
+
+} // namespace juce
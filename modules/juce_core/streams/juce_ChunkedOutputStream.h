@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Writes data to a chain of fixed-size memory chunks, optionally spilling to
+    a temporary file beyond a size limit.
+
+    Unlike MemoryOutputStream, which keeps everything in one contiguous block
+    and therefore has to reallocate and copy as it grows, this stream appends
+    new chunks as needed, so writing N bytes never needs more than N bytes plus
+    one chunk of memory, and never copies what's already been written. That
+    makes it the better choice for serialising very large objects, at the cost
+    of not offering a contiguous getData() pointer - the contents can only be
+    streamed out or handed to a file.
+
+    If a memory limit is given, the stream transparently moves its contents to
+    a temporary file when the limit is exceeded and writes there from then on,
+    so arbitrarily large serialisations run in bounded memory. A spilled
+    stream's contents can be handed to their final destination with
+    writeToFile(), which just moves the temporary file into place rather than
+    copying the data.
+
+    @see MemoryOutputStream, TemporaryFile
+
+    @tags{Core}
+*/
+class JUCE_API  ChunkedOutputStream  : public OutputStream
+{
+public:
+    //==============================================================================
+    /** Creates an empty stream, ready to be written into.
+
+        @param chunkSize                the size of the blocks in which memory will be
+                                        allocated - each allocation is this size, and
+                                        on average half a chunk is wasted at the end
+        @param maxBytesToKeepInMemory   if this is >= 0, the stream's contents will be
+                                        moved to a temporary file once they exceed this
+                                        many bytes; if negative, the stream stays in
+                                        memory no matter how large it grows
+    */
+    ChunkedOutputStream (size_t chunkSize = 65536,
+                         int64 maxBytesToKeepInMemory = -1);
+
+    /** Destructor.
+        This frees the chunks, and deletes the temporary file if one was used.
+    */
+    ~ChunkedOutputStream() override;
+
+    //==============================================================================
+    /** Returns the number of bytes of data that have been written to the stream. */
+    int64 getDataSize() const noexcept                  { return size; }
+
+    /** Returns true if the stream's contents have been moved to a temporary file. */
+    bool hasSpilledToDisk() const noexcept              { return spilledFile != nullptr; }
+
+    /** Resets the stream, clearing any data that has been written to it so far
+        and deleting the temporary file if one was used.
+    */
+    void reset();
+
+    //==============================================================================
+    /** Writes the stream's entire contents to another stream.
+        Returns false if the contents couldn't be read back from the temporary
+        file or written to the destination.
+    */
+    bool writeTo (OutputStream& destStream);
+
+    /** Hands the stream's contents over to the given file, replacing anything
+        that the file previously contained, and leaving this stream empty.
+
+        If the contents have spilled to disk this simply moves the temporary
+        file into place, so no data is copied no matter how large the stream
+        got. Otherwise the chunks are written to a temporary file alongside
+        the target, which then atomically replaces it.
+
+        Returns false if the file couldn't be written, in which case the
+        target file and this stream's contents are left unchanged.
+    */
+    bool writeToFile (const File& destFile);
+
+    //==============================================================================
+    void flush() override;
+    bool write (const void*, size_t) override;
+    int64 getPosition() override                        { return size; }
+
+    /** The stream is append-only, so this only returns true for the position
+        that's already current.
+    */
+    bool setPosition (int64) override;
+
+private:
+    //==============================================================================
+    const size_t chunkSize;
+    const int64 maxBytesInMemory;
+
+    OwnedArray<MemoryBlock> chunks;
+    size_t bytesUsedInLastChunk = 0;
+    int64 size = 0;
+
+    std::unique_ptr<TemporaryFile> spilledFile;
+    std::unique_ptr<FileOutputStream> spilledStream;
+    bool spillAttemptFailed = false;
+
+    bool writeToMemory (const void*, size_t);
+    bool spillToDisk();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChunkedOutputStream)
+};
+
+} // namespace juce
@@ -0,0 +1,217 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+static Range<int64> clipRangeToMappedData (Range<int64> range, size_t mappedSize) noexcept
+{
+    return range.getIntersectionWith ({ 0, (int64) mappedSize });
+}
+
+MemoryMappedInputStream::MemoryMappedInputStream (const MemoryMappedFile& file) noexcept
+    : data (static_cast<const char*> (file.getData())),
+      dataSize (data != nullptr ? file.getSize() : 0)
+{
+}
+
+MemoryMappedInputStream::MemoryMappedInputStream (const MemoryMappedFile& file, Range<int64> subrange) noexcept
+    : data (static_cast<const char*> (file.getData())),
+      dataSize (0)
+{
+    if (data != nullptr)
+    {
+        auto clipped = clipRangeToMappedData (subrange, file.getSize());
+
+        data += clipped.getStart();
+        dataSize = (size_t) clipped.getLength();
+    }
+}
+
+MemoryMappedInputStream::~MemoryMappedInputStream() = default;
+
+//==============================================================================
+#if JUCE_MAC || JUCE_IOS || JUCE_LINUX || JUCE_BSD || JUCE_ANDROID
+static void adviseMappedPages (const void* start, size_t numBytes, int advice) noexcept
+{
+    if (numBytes == 0)
+        return;
+
+    // madvise only accepts page-aligned addresses, so round the start down.
+    auto pageSize = (uintptr_t) sysconf (_SC_PAGESIZE);
+    auto address = (uintptr_t) start;
+    auto alignedAddress = address & ~(pageSize - 1);
+
+    madvise (reinterpret_cast<void*> (alignedAddress),
+             numBytes + (size_t) (address - alignedAddress),
+             advice);
+}
+#endif
+
+void MemoryMappedInputStream::hintSequentialAccess() noexcept
+{
+   #if JUCE_MAC || JUCE_IOS || JUCE_LINUX || JUCE_BSD || JUCE_ANDROID
+    adviseMappedPages (data, dataSize, MADV_SEQUENTIAL);
+   #endif
+}
+
+void MemoryMappedInputStream::hintRangeWillBeNeeded (Range<int64> rangeToPreload) noexcept
+{
+   #if JUCE_MAC || JUCE_IOS || JUCE_LINUX || JUCE_BSD || JUCE_ANDROID
+    auto clipped = clipRangeToMappedData (rangeToPreload, dataSize);
+    adviseMappedPages (data + clipped.getStart(), (size_t) clipped.getLength(), MADV_WILLNEED);
+   #else
+    ignoreUnused (rangeToPreload);
+   #endif
+}
+
+//==============================================================================
+int64 MemoryMappedInputStream::getTotalLength()
+{
+    return (int64) dataSize;
+}
+
+int MemoryMappedInputStream::read (void* buffer, int howMany)
+{
+    jassert (buffer != nullptr && howMany >= 0);
+
+    if (howMany <= 0 || position >= dataSize)
+        return 0;
+
+    auto num = jmin ((size_t) howMany, dataSize - position);
+
+    if (num > 0)
+    {
+        memcpy (buffer, data + position, num);
+        position += num;
+    }
+
+    return (int) num;
+}
+
+bool MemoryMappedInputStream::isExhausted()
+{
+    return position >= dataSize;
+}
+
+bool MemoryMappedInputStream::setPosition (const int64 pos)
+{
+    position = (size_t) jlimit ((int64) 0, (int64) dataSize, pos);
+    return true;
+}
+
+int64 MemoryMappedInputStream::getPosition()
+{
+    return (int64) position;
+}
+
+void MemoryMappedInputStream::skipNextBytes (int64 numBytesToSkip)
+{
+    if (numBytesToSkip > 0)
+        setPosition (getPosition() + numBytesToSkip);
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MemoryMappedInputStreamTests  : public UnitTest
+{
+public:
+    MemoryMappedInputStreamTests()
+        : UnitTest ("MemoryMappedInputStream", UnitTestCategories::streams)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("The stream reads the mapped data without copying it");
+
+        auto file = File::createTempFile (".dat");
+        MemoryBlock contents (512);
+
+        auto r = getRandom();
+
+        for (size_t i = 0; i < contents.getSize(); ++i)
+            contents[i] = (char) r.nextInt (256);
+
+        expect (file.replaceWithData (contents.getData(), contents.getSize()));
+
+        {
+            MemoryMappedFile mapping (file, MemoryMappedFile::readOnly);
+            expect (mapping.getData() != nullptr);
+
+            {
+                MemoryMappedInputStream stream (mapping);
+
+                expect (stream.getData() == mapping.getData());
+                expectEquals (stream.getTotalLength(), (int64) contents.getSize());
+
+                MemoryBlock readBack (contents.getSize());
+                expectEquals (stream.read (readBack.getData(), (int) readBack.getSize()),
+                              (int) contents.getSize());
+                expect (readBack == contents);
+                expect (stream.isExhausted());
+            }
+
+            beginTest ("Subrange views are clipped to the mapping and read the right bytes");
+            {
+                MemoryMappedInputStream stream (mapping, { 100, 200 });
+
+                expectEquals (stream.getTotalLength(), (int64) 100);
+                expect (stream.getData() == addBytesToPointer (mapping.getData(), 100));
+
+                char buffer[100];
+                expectEquals (stream.read (buffer, 200), 100);
+                expect (memcmp (buffer, addBytesToPointer (contents.getData(), 100), 100) == 0);
+
+                MemoryMappedInputStream outOfRange (mapping, { 400, 10000 });
+                expectEquals (outOfRange.getTotalLength(), (int64) (contents.getSize() - 400));
+            }
+
+            beginTest ("Positioning and read-ahead hints");
+            {
+                MemoryMappedInputStream stream (mapping);
+
+                stream.hintSequentialAccess();
+                stream.hintRangeWillBeNeeded ({ 0, stream.getTotalLength() });
+                stream.hintRangeWillBeNeeded ({ -50, 100000 });  // hints must clip safely
+
+                expect (stream.setPosition (500));
+                expectEquals (stream.getPosition(), (int64) 500);
+                expectEquals (stream.readInt(), *reinterpret_cast<const int*> (addBytesToPointer (contents.getData(), 500)));
+
+                stream.skipNextBytes (10000);
+                expect (stream.isExhausted());
+                expectEquals (stream.getPosition(), stream.getTotalLength());
+            }
+        }
+
+        file.deleteFile();
+    }
+};
+
+static MemoryMappedInputStreamTests memoryMappedInputStreamTests;
+
+#endif
+
+} // namespace juce
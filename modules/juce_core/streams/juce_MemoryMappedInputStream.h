@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A zero-copy stream that reads directly from a MemoryMappedFile.
+
+    Unlike copying a mapping into a MemoryInputStream, this just keeps a pointer
+    into the mapped pages, so streaming a multi-gigabyte sample library costs no
+    heap at all - the OS pages data in as the stream reads it. The stream doesn't
+    own the mapping, which must stay open for the stream's lifetime; any number
+    of streams can view the same mapping at once.
+
+    A stream can view the whole mapping or a subrange of it, and can pass
+    madvise-style hints to the OS about how the mapped pages are about to be
+    accessed, to get read-ahead started before the reads actually happen.
+
+    @see MemoryMappedFile, MemoryInputStream
+
+    @tags{Core}
+*/
+class JUCE_API  MemoryMappedInputStream  : public InputStream
+{
+public:
+    //==============================================================================
+    /** Creates a stream that reads the whole of a mapped file.
+
+        The MemoryMappedFile must remain open for the lifetime of the stream.
+        If the file failed to map, the stream will simply be empty.
+    */
+    explicit MemoryMappedInputStream (const MemoryMappedFile& file) noexcept;
+
+    /** Creates a stream that reads a subrange of a mapped file.
+
+        The range is measured in bytes from the start of the mapped region, and
+        gets clipped to the region's actual size. The MemoryMappedFile must
+        remain open for the lifetime of the stream.
+    */
+    MemoryMappedInputStream (const MemoryMappedFile& file, Range<int64> subrange) noexcept;
+
+    /** Destructor. This doesn't affect the mapping that was being read. */
+    ~MemoryMappedInputStream() override;
+
+    //==============================================================================
+    /** Returns a pointer to the first byte of mapped data that this stream reads. */
+    const void* getData() const noexcept        { return data; }
+
+    /** Returns the number of bytes that this stream can read. */
+    size_t getDataSize() const noexcept         { return dataSize; }
+
+    //==============================================================================
+    /** Tells the OS that the stream's pages are about to be read from start to
+        end, so it can read further ahead than it would by default.
+
+        This is a hint in the style of madvise (MADV_SEQUENTIAL), and does
+        nothing on platforms without an equivalent.
+    */
+    void hintSequentialAccess() noexcept;
+
+    /** Tells the OS that a range of this stream, in bytes relative to the start
+        of the stream, will be needed soon, so it can start paging it in now.
+
+        This is a hint in the style of madvise (MADV_WILLNEED), and does
+        nothing on platforms without an equivalent.
+    */
+    void hintRangeWillBeNeeded (Range<int64> rangeToPreload) noexcept;
+
+    //==============================================================================
+    int64 getPosition() override;
+    bool setPosition (int64) override;
+    int64 getTotalLength() override;
+    bool isExhausted() override;
+    int read (void* destBuffer, int maxBytesToRead) override;
+    void skipNextBytes (int64 numBytesToSkip) override;
+
+private:
+    //==============================================================================
+    const char* data;
+    size_t dataSize, position = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MemoryMappedInputStream)
+};
+
+} // namespace juce
@@ -132,6 +132,145 @@ bool SystemStats::hasAVX512VL() noexcept        { return getCPUInformation().has
 bool SystemStats::hasAVX512VPOPCNTDQ() noexcept { return getCPUInformation().hasAVX512VPOPCNTDQ; }
 bool SystemStats::hasNeon() noexcept            { return getCPUInformation().hasNeon; }
 
+//==============================================================================
+bool SystemStats::CpuTopology::isHybrid() const noexcept
+{
+    for (auto& core : cores)
+        if (! core.isPerformanceCore)
+            return true;
+
+    return false;
+}
+
+int SystemStats::CpuTopology::getNumPerformanceCores() const noexcept
+{
+    SortedSet<int> physicalCores;
+
+    for (auto& core : cores)
+        if (core.isPerformanceCore)
+            physicalCores.add (core.physicalIndex);
+
+    return physicalCores.size();
+}
+
+uint32 SystemStats::CpuTopology::getAffinityMask (bool performanceCoresOnly) const noexcept
+{
+    uint32 mask = 0;
+
+    for (auto& core : cores)
+        if (core.logicalIndex < 32 && (core.isPerformanceCore || ! performanceCoresOnly))
+            mask |= (1u << core.logicalIndex);
+
+    return mask;
+}
+
+static SystemStats::CpuTopology createCpuTopology()
+{
+    SystemStats::CpuTopology topology;
+
+   #if JUCE_LINUX || JUCE_ANDROID
+    auto readValue = [] (const String& path) { return File (path).loadFileAsString().trim(); };
+
+    auto parseCacheSize = [] (const String& size) -> int
+    {
+        if (size.endsWithChar ('M'))    return size.dropLastCharacters (1).getIntValue() * 1024;
+        if (size.endsWithChar ('K'))    return size.dropLastCharacters (1).getIntValue();
+
+        return size.getIntValue() / 1024;
+    };
+
+    Array<int64> physicalCoreIDs;   // maps (package, core) pairs to dense physical indices
+    Array<int64> coreCapacities;
+
+    for (int i = 0; i < SystemStats::getNumCpus(); ++i)
+    {
+        auto cpuPath = "/sys/devices/system/cpu/cpu" + String (i) + "/";
+
+        if (! File (cpuPath + "topology").isDirectory())
+            break;
+
+        SystemStats::CpuCore core;
+        core.logicalIndex = i;
+
+        auto packageID = readValue (cpuPath + "topology/physical_package_id").getIntValue();
+        auto coreID    = readValue (cpuPath + "topology/core_id").getIntValue();
+        auto coreKey   = ((int64) packageID << 32) | (int64) (uint32) coreID;
+
+        core.physicalIndex = physicalCoreIDs.indexOf (coreKey);
+
+        if (core.physicalIndex < 0)
+        {
+            physicalCoreIDs.add (coreKey);
+            core.physicalIndex = physicalCoreIDs.size() - 1;
+        }
+
+        for (int cacheIndex = 0; cacheIndex < 8; ++cacheIndex)
+        {
+            auto cachePath = cpuPath + "cache/index" + String (cacheIndex) + "/";
+            auto level = readValue (cachePath + "level");
+
+            if (level.isEmpty())
+                break;
+
+            auto type = readValue (cachePath + "type");
+            auto sizeKb = parseCacheSize (readValue (cachePath + "size"));
+
+            if      (level == "1" && type != "Instruction")  core.l1CacheSize = sizeKb;
+            else if (level == "2")                           core.l2CacheSize = sizeKb;
+            else if (level == "3")                           core.l3CacheSize = sizeKb;
+        }
+
+        // arm big.LITTLE parts expose a capacity per core; hybrid x86 parts
+        // don't, but their efficiency cores report a lower maximum frequency
+        auto capacity = readValue (cpuPath + "cpu_capacity").getLargeIntValue();
+
+        if (capacity == 0)
+            capacity = readValue (cpuPath + "cpufreq/cpuinfo_max_freq").getLargeIntValue();
+
+        coreCapacities.add (capacity);
+        topology.cores.add (core);
+    }
+
+    int64 bestCapacity = 0;
+
+    for (auto c : coreCapacities)
+        bestCapacity = jmax (bestCapacity, c);
+
+    if (bestCapacity > 0)
+        for (int i = 0; i < topology.cores.size(); ++i)
+            topology.cores.getReference (i).isPerformanceCore
+                = coreCapacities[i] * 10 >= bestCapacity * 9;
+   #endif
+
+    if (topology.cores.isEmpty())
+    {
+        // best-effort fallback: a uniform layout derived from the core counts
+        auto numLogical  = jmax (1, SystemStats::getNumCpus());
+        auto numPhysical = jlimit (1, numLogical, SystemStats::getNumPhysicalCpus());
+        auto smtWidth    = numLogical / numPhysical;
+
+        for (int i = 0; i < numLogical; ++i)
+        {
+            SystemStats::CpuCore core;
+            core.logicalIndex = i;
+            core.physicalIndex = jmin (numPhysical - 1, i / jmax (1, smtWidth));
+            topology.cores.add (core);
+        }
+    }
+
+    return topology;
+}
+
+const SystemStats::CpuTopology& SystemStats::getCpuTopology()
+{
+    static CpuTopology topology = createCpuTopology();
+    return topology;
+}
+
+uint32 SystemStats::getPerformanceCoreAffinityMask()
+{
+    return getCpuTopology().getAffinityMask (true);
+}
 
 //==============================================================================
 String SystemStats::getStackBacktrace()
@@ -253,4 +392,59 @@ bool SystemStats::isRunningInAppExtensionSandbox() noexcept
    #endif
 }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct CpuTopologyTests  : public UnitTest
+{
+    CpuTopologyTests()
+        : UnitTest ("CpuTopology", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+        const auto& topology = SystemStats::getCpuTopology();
+
+        beginTest ("The topology covers every logical CPU in order");
+        {
+            expectEquals (topology.cores.size(), SystemStats::getNumCpus());
+
+            for (int i = 0; i < topology.cores.size(); ++i)
+            {
+                expectEquals (topology.cores.getReference (i).logicalIndex, i);
+                expect (topology.cores.getReference (i).physicalIndex >= 0);
+            }
+        }
+
+        beginTest ("The affinity masks are consistent");
+        {
+            auto allCores  = topology.getAffinityMask (false);
+            auto perfCores = topology.getAffinityMask (true);
+
+            expect (allCores != 0);
+            expect (perfCores != 0);  // a machine can't consist solely of efficiency cores
+            expect ((perfCores & ~allCores) == 0);
+            expect (perfCores == SystemStats::getPerformanceCoreAffinityMask());
+
+            if (! topology.isHybrid())
+                expect (perfCores == allCores);
+        }
+
+        beginTest ("Performance core counts are sane");
+        {
+            auto numPerformance = topology.getNumPerformanceCores();
+
+            expect (numPerformance >= 1);
+            expect (numPerformance <= SystemStats::getNumPhysicalCpus()
+                      || SystemStats::getNumPhysicalCpus() == 0);
+        }
+    }
+};
+
+static CpuTopologyTests cpuTopologyTests;
+
+#endif
+
 } // namespace juce
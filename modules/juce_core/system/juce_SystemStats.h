@@ -155,6 +155,67 @@ public:
     /** Returns the number of physical CPU cores. */
     static int getNumPhysicalCpus() noexcept;
 
+    //==============================================================================
+    /** Describes one logical CPU in the topology returned by getCpuTopology(). */
+    struct CpuCore
+    {
+        int logicalIndex = 0;           /**< The OS's index for this logical CPU. */
+        int physicalIndex = 0;          /**< The index of the physical core that this logical CPU
+                                             belongs to. SMT siblings share a physical index. */
+        bool isPerformanceCore = true;  /**< False for the efficiency cores of a hybrid part. On
+                                             machines with a uniform design, every core reports true. */
+        int l1CacheSize = 0;            /**< This core's L1 data cache size in kilobytes, or 0 if unknown. */
+        int l2CacheSize = 0;            /**< The L2 cache size in kilobytes (possibly shared with
+                                             sibling cores), or 0 if unknown. */
+        int l3CacheSize = 0;            /**< The size in kilobytes of the L3 cluster that this core
+                                             belongs to, or 0 if unknown. */
+    };
+
+    /** The machine's CPU core layout.
+        @see getCpuTopology
+    */
+    struct CpuTopology
+    {
+        /** One entry per logical CPU, in logical index order. */
+        Array<CpuCore> cores;
+
+        /** Returns true if the machine mixes performance and efficiency cores. */
+        bool isHybrid() const noexcept;
+
+        /** Returns the number of physical cores that are performance cores. */
+        int getNumPerformanceCores() const noexcept;
+
+        /** Returns a mask with a bit set for each logical CPU, suitable for
+            Thread::setAffinityMask().
+
+            If performanceCoresOnly is true, only performance cores are included -
+            use this to keep real-time DSP workers off the efficiency cores of a
+            hybrid part. Logical CPUs with indices above 31 can't be represented
+            in the mask and are left out.
+        */
+        uint32 getAffinityMask (bool performanceCoresOnly) const noexcept;
+    };
+
+    /** Returns the machine's CPU topology, for sizing and placing worker threads.
+
+        The topology is queried once, on the first call. On platforms where the
+        details can't be discovered (currently everything except Linux/Android),
+        the result is a best-effort uniform layout derived from the core counts,
+        with every core classed as a performance core and cache sizes of zero.
+
+        @see getPerformanceCoreAffinityMask, ThreadPool
+    */
+    static const CpuTopology& getCpuTopology();
+
+    /** Returns an affinity mask covering the performance cores, for pinning
+        real-time workers on hybrid parts. The same as calling
+        getCpuTopology().getAffinityMask (true).
+
+        @see Thread::setAffinityMask, ThreadPool
+    */
+    static uint32 getPerformanceCoreAffinityMask();
+
+    //==============================================================================
     /** Returns the approximate CPU speed.
         @returns    the speed in megahertz, e.g. 1500, 2500, 32000 (depending on
                     what year you're reading this...)
@@ -68,6 +68,21 @@ public:
     static CharPointerType createUninitialisedBytes (size_t numBytes)
     {
         numBytes = (numBytes + 3) & ~(size_t) 3;
+
+        if (numBytes <= smallBufferNumBytes)
+        {
+            auto& cache = getSmallHolderCache();
+
+            if (cache.numHolders > 0)
+            {
+                auto s = unalignedPointerCast<StringHolder*> (cache.holders[--cache.numHolders]);
+                s->refCount.value = 0;
+                return CharPointerType (s->text);
+            }
+
+            numBytes = smallBufferNumBytes;
+        }
+
         auto s = unalignedPointerCast<StringHolder*> (new char [sizeof (StringHolder) - sizeof (CharType) + numBytes]);
         s->refCount.value = 0;
         s->allocatedNumBytes = numBytes;
@@ -160,8 +175,23 @@ public:
     static void release (StringHolder* const b) noexcept
     {
         if (! isEmptyString (b))
+        {
             if (--(b->refCount) == -1)
+            {
+                if (b->allocatedNumBytes == smallBufferNumBytes)
+                {
+                    auto& cache = getSmallHolderCache();
+
+                    if (cache.numHolders < maxCachedHolders)
+                    {
+                        cache.holders[cache.numHolders++] = reinterpret_cast<char*> (b);
+                        return;
+                    }
+                }
+
                 delete[] reinterpret_cast<char*> (b);
+            }
+        }
     }
 
     static void release (const CharPointerType text) noexcept
@@ -207,6 +237,34 @@ public:
     CharType text[1];
 
 private:
+    //==============================================================================
+    /*  Holders for short strings are rounded up to a fixed size and recycled on a
+        per-thread free-list when their refcount hits zero, so that parse-heavy code
+        which creates and destroys lots of small strings doesn't hammer the heap
+        allocator. Holders may be allocated and released on different threads - a
+        released holder just joins the cache of whichever thread let go of it.
+    */
+    enum { smallBufferNumBytes = 64, maxCachedHolders = 32 };
+
+    struct SmallHolderCache
+    {
+        ~SmallHolderCache()
+        {
+            while (numHolders > 0)
+                delete[] holders[--numHolders];
+        }
+
+        char* holders[maxCachedHolders];
+        int numHolders = 0;
+    };
+
+    static SmallHolderCache& getSmallHolderCache()
+    {
+        thread_local SmallHolderCache cache;
+        return cache;
+    }
+
+    //==============================================================================
     static StringHolder* bufferFromText (const CharPointerType text) noexcept
     {
         // (Can't use offsetof() here because of warnings about this not being a POD)
@@ -0,0 +1,587 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+StringBuilder::StringBuilder() noexcept  : data (inlineStorage)
+{
+    data[0] = 0;
+}
+
+void StringBuilder::ensureCapacity (size_t numBytesNeeded)
+{
+    if (numBytesNeeded <= capacity)
+        return;
+
+    auto newCapacity = capacity;
+
+    while (newCapacity < numBytesNeeded)
+        newCapacity *= 2;
+
+    if (heapStorage != nullptr)
+    {
+        heapStorage.realloc (newCapacity);
+    }
+    else
+    {
+        heapStorage.malloc (newCapacity);
+        memcpy (heapStorage, inlineStorage, size + 1);
+    }
+
+    data = heapStorage;
+    capacity = newCapacity;
+}
+
+void StringBuilder::clear() noexcept
+{
+    size = 0;
+    data[0] = 0;
+}
+
+String StringBuilder::toString() const
+{
+    return String (CharPointer_UTF8 (data), CharPointer_UTF8 (data + size));
+}
+
+StringBuilder& StringBuilder::append (StringRef text)
+{
+    auto numBytes = CharPointer_UTF8::getBytesRequiredFor (text.text);
+    ensureCapacity (size + numBytes + 1);
+    CharPointer_UTF8 (data + size).writeAll (text.text);
+    size += numBytes;
+    return *this;
+}
+
+StringBuilder& StringBuilder::append (const char* utf8Text, size_t numBytes)
+{
+    ensureCapacity (size + numBytes + 1);
+    memcpy (data + size, utf8Text, numBytes);
+    size += numBytes;
+    data[size] = 0;
+    return *this;
+}
+
+StringBuilder& StringBuilder::append (char character)
+{
+    ensureCapacity (size + 2);
+    data[size++] = character;
+    data[size] = 0;
+    return *this;
+}
+
+StringBuilder& StringBuilder::append (int value)       { return append ((int64) value); }
+
+StringBuilder& StringBuilder::append (int64 value)
+{
+    char buffer[charsNeededForInt];
+    return append (buffer, (size_t) formatInt (buffer, value));
+}
+
+StringBuilder& StringBuilder::append (uint64 value)
+{
+    char buffer[charsNeededForInt];
+    return append (buffer, (size_t) formatUint (buffer, value));
+}
+
+StringBuilder& StringBuilder::append (double value)
+{
+    char buffer[charsNeededForDouble];
+    return append (buffer, (size_t) formatDouble (buffer, value));
+}
+
+//==============================================================================
+int StringBuilder::formatUint (char* destBuffer, uint64 value) noexcept
+{
+    static const char digitPairs[] = "00010203040506070809101112131415161718192021222324"
+                                     "25262728293031323334353637383940414243444546474849"
+                                     "50515253545556575859606162636465666768697071727374"
+                                     "75767778798081828384858687888990919293949596979899";
+    char temp[20];
+    auto* t = temp + numElementsInArray (temp);
+
+    while (value >= 100)
+    {
+        auto digits = (int) (value % 100) * 2;
+        value /= 100;
+        *--t = digitPairs[digits + 1];
+        *--t = digitPairs[digits];
+    }
+
+    if (value >= 10)
+    {
+        auto digits = (int) value * 2;
+        *--t = digitPairs[digits + 1];
+        *--t = digitPairs[digits];
+    }
+    else
+    {
+        *--t = (char) ('0' + (char) value);
+    }
+
+    auto len = (int) (temp + numElementsInArray (temp) - t);
+    memcpy (destBuffer, t, (size_t) len);
+    return len;
+}
+
+int StringBuilder::formatInt (char* destBuffer, int64 value) noexcept
+{
+    if (value >= 0)
+        return formatUint (destBuffer, (uint64) value);
+
+    // NB: this needs to be careful not to call -std::numeric_limits<int64>::min(),
+    // which has undefined behaviour
+    *destBuffer = '-';
+    return 1 + formatUint (destBuffer + 1, (uint64) (-(value + 1)) + 1);
+}
+
+//==============================================================================
+/*  A Grisu2 shortest round-trip double-to-decimal conversion, working entirely
+    in 64-bit integer arithmetic. See Loitsch, "Printing Floating-Point Numbers
+    Quickly and Accurately with Integers" (PLDI 2010).
+*/
+namespace GrisuDoubleToText
+{
+    struct DiyFp
+    {
+        uint64 f;
+        int e;
+    };
+
+    static constexpr uint64 hiddenBit       = 0x0010000000000000ULL;
+    static constexpr uint64 significandMask = 0x000fffffffffffffULL;
+    static constexpr uint64 exponentMask    = 0x7ff0000000000000ULL;
+    static constexpr int significandSize    = 52;
+    static constexpr int exponentBias       = 0x3ff + significandSize;
+
+    static DiyFp multiply (DiyFp x, DiyFp y) noexcept
+    {
+        // 64x64 -> 128-bit multiplication, keeping the (rounded) top 64 bits
+        const uint64 mask32 = 0xffffffffULL;
+        auto a = x.f >> 32, b = x.f & mask32,
+             c = y.f >> 32, d = y.f & mask32;
+        auto ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+        auto mid = (bd >> 32) + (ad & mask32) + (bc & mask32) + (1ULL << 31);
+
+        return { ac + (ad >> 32) + (bc >> 32) + (mid >> 32), x.e + y.e + 64 };
+    }
+
+    static DiyFp fromDouble (double value) noexcept
+    {
+        uint64 bits;
+        memcpy (&bits, &value, sizeof (bits));
+
+        auto biasedExponent = (int) ((bits & exponentMask) >> significandSize);
+        auto significand = bits & significandMask;
+
+        if (biasedExponent != 0)
+            return { significand + hiddenBit, biasedExponent - exponentBias };
+
+        return { significand, 1 - exponentBias };
+    }
+
+    static DiyFp normalize (DiyFp value) noexcept
+    {
+        while ((value.f & (1ULL << 63)) == 0)
+        {
+            value.f <<= 1;
+            --value.e;
+        }
+
+        return value;
+    }
+
+    static void getNormalizedBoundaries (DiyFp v, DiyFp& minus, DiyFp& plus) noexcept
+    {
+        plus = { (v.f << 1) + 1, v.e - 1 };
+
+        while ((plus.f & (hiddenBit << 1)) == 0)
+        {
+            plus.f <<= 1;
+            --plus.e;
+        }
+
+        constexpr int shift = 64 - significandSize - 2;
+        plus.f <<= shift;
+        plus.e -= shift;
+
+        minus = (v.f == hiddenBit) ? DiyFp { (v.f << 2) - 1, v.e - 2 }
+                                   : DiyFp { (v.f << 1) - 1, v.e - 1 };
+        minus.f <<= minus.e - plus.e;
+        minus.e = plus.e;
+    }
+
+    /*  Normalized values of 10^k for k = -348, -340 .. 340, generated with
+        exact big-integer arithmetic.
+    */
+    static const uint64 cachedPowerSignificands[] =
+    {
+        0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL, 0xcf42894a5dce35eaULL,
+        0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL, 0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL,
+        0xbe5691ef416bd60cULL, 0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+        0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL, 0xc21094364dfb5637ULL,
+        0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL, 0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL,
+        0xb23867fb2a35b28eULL, 0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+        0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL, 0xb5b5ada8aaff80b8ULL,
+        0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL, 0x964e858c91ba2655ULL, 0xdff9772470297ebdULL,
+        0xa6dfbd9fb8e5b88fULL, 0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+        0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL, 0xaa242499697392d3ULL,
+        0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL, 0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL,
+        0x9c40000000000000ULL, 0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+        0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL, 0x9f4f2726179a2245ULL,
+        0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL, 0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL,
+        0x924d692ca61be758ULL, 0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+        0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL, 0x952ab45cfa97a0b3ULL,
+        0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL, 0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL,
+        0x88fcf317f22241e2ULL, 0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+        0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL, 0x8bab8eefb6409c1aULL,
+        0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL, 0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL,
+        0x80444b5e7aa7cf85ULL, 0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+        0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL
+    };
+
+    static const int16 cachedPowerExponents[] =
+    {
+        -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034,
+        -1007,  -980,  -954,  -927,  -901,  -874,  -847,  -821,
+         -794,  -768,  -741,  -715,  -688,  -661,  -635,  -608,
+         -582,  -555,  -529,  -502,  -475,  -449,  -422,  -396,
+         -369,  -343,  -316,  -289,  -263,  -236,  -210,  -183,
+         -157,  -130,  -103,   -77,   -50,   -24,     3,    30,
+           56,    83,   109,   136,   162,   189,   216,   242,
+          269,   295,   322,   348,   375,   402,   428,   455,
+          481,   508,   534,   561,   588,   614,   641,   667,
+          694,   720,   747,   774,   800,   827,   853,   880,
+          907,   933,   960,   986,  1013,  1039,  1066
+    };
+
+    static DiyFp getCachedPower (int binaryExponent, int& decimalExponent) noexcept
+    {
+        // finds a power of ten whose product with the value lands in the
+        // exponent range where digits can be cut with 64-bit arithmetic
+        auto dk = (-61 - binaryExponent) * 0.30102999566398114 + 347;
+        auto k = (int) dk;
+
+        if (dk - k > 0)
+            ++k;
+
+        auto index = (k >> 3) + 1;
+        decimalExponent = -(-348 + (index << 3));
+
+        return { cachedPowerSignificands[index], cachedPowerExponents[index] };
+    }
+
+    static void roundDigits (char* buffer, int len, uint64 delta, uint64 rest,
+                             uint64 tenKappa, uint64 distance) noexcept
+    {
+        while (rest < distance && delta - rest >= tenKappa
+                && (rest + tenKappa < distance || distance - rest > rest + tenKappa - distance))
+        {
+            --buffer[len - 1];
+            rest += tenKappa;
+        }
+    }
+
+    static void generateDigits (DiyFp w, DiyFp mp, uint64 delta,
+                                char* buffer, int& len, int& k) noexcept
+    {
+        static const uint32 powersOf10[] = { 1, 10, 100, 1000, 10000, 100000,
+                                             1000000, 10000000, 100000000, 1000000000 };
+        DiyFp one { 1ULL << -mp.e, mp.e };
+        auto distance = mp.f - w.f;
+        auto p1 = (uint32) (mp.f >> -one.e);
+        auto p2 = mp.f & (one.f - 1);
+        len = 0;
+
+        int kappa = 10;
+
+        while (kappa > 1 && p1 < powersOf10[kappa - 1])
+            --kappa;
+
+        while (kappa > 0)
+        {
+            auto d = p1 / powersOf10[kappa - 1];
+            p1 %= powersOf10[kappa - 1];
+
+            if (d != 0 || len != 0)
+                buffer[len++] = (char) ('0' + d);
+
+            --kappa;
+            auto rest = ((uint64) p1 << -one.e) + p2;
+
+            if (rest <= delta)
+            {
+                k += kappa;
+                roundDigits (buffer, len, delta, rest, (uint64) powersOf10[kappa] << -one.e, distance);
+                return;
+            }
+        }
+
+        for (;;)
+        {
+            p2 *= 10;
+            delta *= 10;
+            auto d = (char) (p2 >> -one.e);
+
+            if (d != 0 || len != 0)
+                buffer[len++] = (char) ('0' + d);
+
+            p2 &= one.f - 1;
+            --kappa;
+
+            if (p2 < delta)
+            {
+                k += kappa;
+                roundDigits (buffer, len, delta, p2, one.f, distance * powersOf10[-kappa]);
+                return;
+            }
+        }
+    }
+
+    static void grisu2 (double value, char* buffer, int& len, int& decimalExponent) noexcept
+    {
+        auto v = fromDouble (value);
+        DiyFp wMinus, wPlus;
+        getNormalizedBoundaries (v, wMinus, wPlus);
+
+        decimalExponent = 0;
+        auto cached = getCachedPower (wPlus.e, decimalExponent);
+        auto w = multiply (normalize (v), cached);
+        auto high = multiply (wPlus, cached);
+        auto low = multiply (wMinus, cached);
+        ++low.f;
+        --high.f;
+
+        generateDigits (w, high, high.f - low.f, buffer, len, decimalExponent);
+    }
+
+    static int writeExponent (char* dest, int exponent) noexcept
+    {
+        auto* d = dest;
+        *d++ = 'e';
+        *d++ = exponent < 0 ? '-' : '+';
+        d += StringBuilder::formatUint (d, (uint64) std::abs (exponent));
+        return (int) (d - dest);
+    }
+
+    // lays the digits out as plain or exponent notation, whichever reads better
+    static int prettify (char* dest, const char* digits, int numDigits, int decimalExponent) noexcept
+    {
+        auto pointPos = numDigits + decimalExponent;
+
+        if (numDigits <= pointPos && pointPos <= 21)
+        {
+            // 1234000.0
+            memcpy (dest, digits, (size_t) numDigits);
+
+            for (int i = numDigits; i < pointPos; ++i)
+                dest[i] = '0';
+
+            dest[pointPos] = '.';
+            dest[pointPos + 1] = '0';
+            return pointPos + 2;
+        }
+
+        if (0 < pointPos && pointPos <= 21)
+        {
+            // 123.4
+            memcpy (dest, digits, (size_t) pointPos);
+            dest[pointPos] = '.';
+            memcpy (dest + pointPos + 1, digits + pointPos, (size_t) (numDigits - pointPos));
+            return numDigits + 1;
+        }
+
+        if (-6 < pointPos && pointPos <= 0)
+        {
+            // 0.0001234
+            dest[0] = '0';
+            dest[1] = '.';
+
+            for (int i = 0; i < -pointPos; ++i)
+                dest[2 + i] = '0';
+
+            memcpy (dest + 2 - pointPos, digits, (size_t) numDigits);
+            return numDigits + 2 - pointPos;
+        }
+
+        // 1.234e+30
+        auto* d = dest;
+        *d++ = digits[0];
+
+        if (numDigits > 1)
+        {
+            *d++ = '.';
+            memcpy (d, digits + 1, (size_t) (numDigits - 1));
+            d += numDigits - 1;
+        }
+
+        return (int) (d - dest) + writeExponent (d, pointPos - 1);
+    }
+}
+
+int StringBuilder::formatDouble (char* destBuffer, double value) noexcept
+{
+    auto* d = destBuffer;
+
+    if (std::isnan (value))
+    {
+        memcpy (d, "nan", 3);
+        return 3;
+    }
+
+    if (std::signbit (value))
+    {
+        *d++ = '-';
+        value = -value;
+    }
+
+    if (std::isinf (value))
+    {
+        memcpy (d, "inf", 3);
+        return (int) (d - destBuffer) + 3;
+    }
+
+    if (value == 0.0)
+    {
+        memcpy (d, "0.0", 3);
+        return (int) (d - destBuffer) + 3;
+    }
+
+    char digits[24];
+    int numDigits = 0, decimalExponent = 0;
+    GrisuDoubleToText::grisu2 (value, digits, numDigits, decimalExponent);
+
+    return (int) (d - destBuffer)
+            + GrisuDoubleToText::prettify (d, digits, numDigits, decimalExponent);
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class StringBuilderTests  : public UnitTest
+{
+public:
+    StringBuilderTests()
+        : UnitTest ("StringBuilder", UnitTestCategories::text)
+    {}
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        beginTest ("Integer formatting matches the String constructors");
+        {
+            const int64 values[] = { 0, 1, -1, 9, 10, 99, 100, 101, -100000,
+                                     std::numeric_limits<int64>::max(),
+                                     std::numeric_limits<int64>::min() };
+
+            for (auto v : values)
+            {
+                StringBuilder b;
+                b << v;
+                expectEquals (b.toString(), String (v));
+            }
+
+            for (int i = 0; i < 100; ++i)
+            {
+                auto v = r.nextInt64();
+                char buffer[StringBuilder::charsNeededForInt];
+                auto len = StringBuilder::formatInt (buffer, v);
+                expectEquals (String (buffer, (size_t) len), String (v));
+            }
+
+            StringBuilder b;
+            b << (uint64) std::numeric_limits<uint64>::max();
+            expectEquals (b.toString(), String (std::numeric_limits<uint64>::max()));
+        }
+
+        beginTest ("Double formatting produces the expected text");
+        {
+            expectDouble (0.0,      "0.0");
+            expectDouble (-0.0,     "-0.0");
+            expectDouble (1.0,      "1.0");
+            expectDouble (-2.5,     "-2.5");
+            expectDouble (0.1,      "0.1");
+            expectDouble (0.25,     "0.25");
+            expectDouble (100.5,    "100.5");
+            expectDouble (3.14159,  "3.14159");
+            expectDouble (1.0e30,   "1e+30");
+            expectDouble (2.5e-9,   "2.5e-9");
+        }
+
+        beginTest ("Doubles round-trip exactly");
+        {
+            for (int i = 0; i < 1000; ++i)
+            {
+                double v;
+                auto bits = (uint64) r.nextInt64();
+                memcpy (&v, &bits, sizeof (v));
+
+                if (std::isnan (v) || std::isinf (v))
+                    continue;
+
+                char buffer[StringBuilder::charsNeededForDouble + 1];
+                auto len = StringBuilder::formatDouble (buffer, v);
+                expect (len <= StringBuilder::charsNeededForDouble);
+                buffer[len] = 0;
+                expect (std::strtod (buffer, nullptr) == v);
+            }
+        }
+
+        beginTest ("Composition without intermediate Strings");
+        {
+            StringBuilder b;
+            b << "x=" << 42 << ", y=" << -1.5 << ';';
+            expectEquals (b.toString(), String ("x=42, y=-1.5;"));
+            expectEquals (b.getLength(), 13);
+            expect (CharPointer_UTF8 (b.toUTF8()).compare (CharPointer_ASCII ("x=42, y=-1.5;")) == 0);
+
+            b.clear();
+            expect (b.isEmpty());
+
+            String expected;
+
+            for (int i = 0; i < 200; ++i)
+            {
+                b << "chunk " << i << ' ';
+                expected << "chunk " << i << ' ';
+            }
+
+            expectEquals (b.toString(), expected);
+        }
+    }
+
+    void expectDouble (double value, StringRef expected)
+    {
+        char buffer[StringBuilder::charsNeededForDouble];
+        auto len = StringBuilder::formatDouble (buffer, value);
+        expectEquals (String (buffer, (size_t) len), String (expected));
+    }
+};
+
+static StringBuilderTests stringBuilderUnitTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Assembles a UTF-8 string in a re-usable buffer, avoiding the intermediate
+    heap allocations that composing Strings with operator+ would make.
+
+    Short results are built entirely in inline storage, so a typical log line
+    or OSC address can be put together and handed to a sink without touching
+    the heap at all. Numbers are converted with the fast integer and
+    shortest-round-trip double formatters below rather than the locale-aware
+    iostream path used by the String numeric constructors.
+
+    @code
+    StringBuilder message;
+    message << "gain changed to " << newGain << " at " << sampleNumber;
+    logSink.write (message.toUTF8(), message.getLength());
+    @endcode
+
+    @see String, StringRef
+
+    @tags{Core}
+*/
+class JUCE_API  StringBuilder  final
+{
+public:
+    /** Creates an empty builder. */
+    StringBuilder() noexcept;
+
+    //==============================================================================
+    /** Appends some text. */
+    StringBuilder& append (StringRef text);
+
+    /** Appends a block of raw UTF-8 text which needn't be null-terminated. */
+    StringBuilder& append (const char* utf8Text, size_t numBytes);
+
+    /** Appends a single ASCII character. */
+    StringBuilder& append (char character);
+
+    /** Appends an integer, formatted in decimal. */
+    StringBuilder& append (int value);
+
+    /** Appends an integer, formatted in decimal. */
+    StringBuilder& append (int64 value);
+
+    /** Appends an unsigned integer, formatted in decimal. */
+    StringBuilder& append (uint64 value);
+
+    /** Appends a double, using the shortest decimal form that parses back to
+        exactly the same value. See formatDouble() for details of the format.
+    */
+    StringBuilder& append (double value);
+
+    /** Appends some text. */
+    StringBuilder& operator<< (StringRef text)          { return append (text); }
+    /** Appends a single ASCII character. */
+    StringBuilder& operator<< (char character)          { return append (character); }
+    /** Appends an integer, formatted in decimal. */
+    StringBuilder& operator<< (int value)               { return append (value); }
+    /** Appends an integer, formatted in decimal. */
+    StringBuilder& operator<< (int64 value)             { return append (value); }
+    /** Appends an unsigned integer, formatted in decimal. */
+    StringBuilder& operator<< (uint64 value)            { return append (value); }
+    /** Appends a double in its shortest round-trippable form. */
+    StringBuilder& operator<< (double value)            { return append (value); }
+
+    //==============================================================================
+    /** Discards the contents, keeping any storage that has already been
+        allocated so the builder can be re-used.
+    */
+    void clear() noexcept;
+
+    /** Returns the length of the assembled text in bytes. */
+    int getLength() const noexcept                      { return (int) size; }
+
+    /** Returns true if nothing has been appended yet. */
+    bool isEmpty() const noexcept                       { return size == 0; }
+
+    /** Returns the assembled text as a null-terminated UTF-8 string.
+        The pointer is only valid until the builder is next modified.
+    */
+    const char* toUTF8() const noexcept                 { return data; }
+
+    /** Returns the assembled text as a String. */
+    String toString() const;
+
+    //==============================================================================
+    /** The buffer sizes needed by the formatting functions below. */
+    enum
+    {
+        charsNeededForInt = 21,     /**< Worst case for formatInt/formatUint, without a null terminator. */
+        charsNeededForDouble = 32   /**< Worst case for formatDouble, without a null terminator. */
+    };
+
+    /** Formats a signed integer in decimal into the caller's buffer.
+
+        The buffer must hold at least charsNeededForInt bytes. No null
+        terminator is written.
+
+        @returns the number of characters written.
+    */
+    static int formatInt (char* destBuffer, int64 value) noexcept;
+
+    /** Formats an unsigned integer in decimal into the caller's buffer.
+
+        The buffer must hold at least charsNeededForInt bytes. No null
+        terminator is written.
+
+        @returns the number of characters written.
+    */
+    static int formatUint (char* destBuffer, uint64 value) noexcept;
+
+    /** Formats a double into the caller's buffer, using the shortest decimal
+        representation that parses back to exactly the same value.
+
+        This uses a Grisu-style conversion working entirely in integer
+        arithmetic, so unlike String (double) it never touches the heap or the
+        locale machinery. Values whose decimal point falls in a readable range
+        are written in plain notation with at least one digit after the point
+        (e.g. "1.0", "0.25", "-100.5"); very large or small values switch to
+        exponent notation (e.g. "1e+30", "2.5e-9"). Infinities and NaNs come
+        out as "inf", "-inf" and "nan".
+
+        The buffer must hold at least charsNeededForDouble bytes. No null
+        terminator is written.
+
+        @returns the number of characters written.
+    */
+    static int formatDouble (char* destBuffer, double value) noexcept;
+
+private:
+    //==============================================================================
+    enum { inlineCapacity = 256 };
+
+    char* data;
+    size_t size = 0, capacity = inlineCapacity;
+    HeapBlock<char> heapStorage;
+    char inlineStorage[inlineCapacity];
+
+    void ensureCapacity (size_t numBytesNeeded);
+
+    JUCE_DECLARE_NON_COPYABLE (StringBuilder)
+};
+
+} // namespace juce
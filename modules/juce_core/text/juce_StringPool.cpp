@@ -57,6 +57,40 @@ static int compareStrings (const StartEndString& string1, const String& string2)
     return 0;
 }
 
+template <typename NewStringType>
+static const String* findPooledString (const Array<String>& strings, const NewStringType& newString) noexcept
+{
+    int start = 0;
+    int end = strings.size();
+
+    while (start < end)
+    {
+        const String& startString = strings.getReference (start);
+        const int startComp = compareStrings (newString, startString);
+
+        if (startComp == 0)
+            return &startString;
+
+        const int halfway = (start + end) / 2;
+
+        if (halfway == start)
+            break;
+
+        const String& halfwayString = strings.getReference (halfway);
+        const int halfwayComp = compareStrings (newString, halfwayString);
+
+        if (halfwayComp == 0)
+            return &halfwayString;
+
+        if (halfwayComp > 0)
+            start = halfway;
+        else
+            end = halfway;
+    }
+
+    return nullptr;
+}
+
 template <typename NewStringType>
 static String addPooledString (Array<String>& strings, const NewStringType& newString)
 {
@@ -102,7 +136,14 @@ String StringPool::getPooledString (const char* const newString)
     if (newString == nullptr || *newString == 0)
         return {};
 
-    const ScopedLock sl (lock);
+    {
+        const ScalableReadWriteLock::ScopedReadLockType sl (lock);
+
+        if (auto* existing = findPooledString (strings, CharPointer_UTF8 (newString)))
+            return *existing;
+    }
+
+    const ScalableReadWriteLock::ScopedWriteLockType sl (lock);
     garbageCollectIfNeeded();
     return addPooledString (strings, CharPointer_UTF8 (newString));
 }
@@ -112,7 +153,14 @@ String StringPool::getPooledString (String::CharPointerType start, String::CharP
     if (start.isEmpty() || start == end)
         return {};
 
-    const ScopedLock sl (lock);
+    {
+        const ScalableReadWriteLock::ScopedReadLockType sl (lock);
+
+        if (auto* existing = findPooledString (strings, StartEndString (start, end)))
+            return *existing;
+    }
+
+    const ScalableReadWriteLock::ScopedWriteLockType sl (lock);
     garbageCollectIfNeeded();
     return addPooledString (strings, StartEndString (start, end));
 }
@@ -122,7 +170,14 @@ String StringPool::getPooledString (StringRef newString)
     if (newString.isEmpty())
         return {};
 
-    const ScopedLock sl (lock);
+    {
+        const ScalableReadWriteLock::ScopedReadLockType sl (lock);
+
+        if (auto* existing = findPooledString (strings, newString.text))
+            return *existing;
+    }
+
+    const ScalableReadWriteLock::ScopedWriteLockType sl (lock);
     garbageCollectIfNeeded();
     return addPooledString (strings, newString.text);
 }
@@ -132,7 +187,14 @@ String StringPool::getPooledString (const String& newString)
     if (newString.isEmpty())
         return {};
 
-    const ScopedLock sl (lock);
+    {
+        const ScalableReadWriteLock::ScopedReadLockType sl (lock);
+
+        if (auto* existing = findPooledString (strings, newString))
+            return *existing;
+    }
+
+    const ScalableReadWriteLock::ScopedWriteLockType sl (lock);
     garbageCollectIfNeeded();
     return addPooledString (strings, newString);
 }
@@ -146,7 +208,8 @@ void StringPool::garbageCollectIfNeeded()
 
 void StringPool::garbageCollect()
 {
-    const ScopedLock sl (lock);
+    // the write lock is recursive, so this is safe when called from within getPooledString
+    const ScalableReadWriteLock::ScopedWriteLockType sl (lock);
 
     for (int i = strings.size(); --i >= 0;)
         if (strings.getReference(i).getReferenceCount() == 1)
@@ -161,4 +224,73 @@ StringPool& StringPool::getGlobalPool() noexcept
     return pool;
 }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class StringPoolTests  : public UnitTest
+{
+public:
+    StringPoolTests()
+        : UnitTest ("StringPool", UnitTestCategories::text)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Pooled strings share storage");
+        {
+            StringPool pool;
+
+            auto s1 = pool.getPooledString ("test string");
+            auto s2 = pool.getPooledString (String ("test") + " string");
+
+            expect (s1 == "test string");
+            expect (s1.getCharPointer() == s2.getCharPointer());
+            expect (s1.getCharPointer() != pool.getPooledString ("other").getCharPointer());
+        }
+
+        beginTest ("Concurrent interning");
+        {
+            StringPool pool;
+
+            const int numThreads = 4;
+            const int numStrings = 200;
+
+            WaitableEvent finishedEvents[numThreads];
+            std::atomic<int> mismatches { 0 };
+
+            for (auto& finished : finishedEvents)
+            {
+                Thread::launch ([&pool, &finished, &mismatches]
+                {
+                    for (int iteration = 0; iteration < 20; ++iteration)
+                        for (int i = 0; i < numStrings; ++i)
+                        {
+                            auto name = "string" + String (i);
+
+                            if (pool.getPooledString (name).getCharPointer()
+                                  != pool.getPooledString (name).getCharPointer())
+                                ++mismatches;
+                        }
+
+                    finished.signal();
+                });
+            }
+
+            for (auto& finished : finishedEvents)
+                expect (finished.wait (30000));
+
+            expectEquals (mismatches.load(), 0);
+
+            for (int i = 0; i < numStrings; ++i)
+                expect (pool.getPooledString ("string" + String (i)) == "string" + String (i));
+        }
+    }
+};
+
+static StringPoolTests stringPoolTests;
+
+#endif
+
 } // namespace juce
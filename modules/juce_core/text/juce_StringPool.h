@@ -34,6 +34,10 @@ namespace juce
     compare two pooled strings for equality, as you can simply compare their pointers. It
     also cuts down on storage if you're using many copies of the same string.
 
+    Lookups of strings which are already pooled only take a shared read-lock, so
+    many threads can intern the same identifiers concurrently without contending;
+    the exclusive lock is only taken when a new string has to be inserted.
+
     @tags{Core}
 */
 class JUCE_API  StringPool
@@ -76,7 +80,7 @@ public:
 
 private:
     Array<String> strings;
-    CriticalSection lock;
+    ScalableReadWriteLock lock;
     uint32 lastGarbageCollectionTime;
 
     void garbageCollectIfNeeded();
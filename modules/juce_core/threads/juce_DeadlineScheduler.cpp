@@ -0,0 +1,418 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+// deadlines are millisecond-counter values, so comparisons must be done on the
+// wrap-safe difference rather than on the raw values
+static bool isDeadlineEarlier (uint32 d1, uint32 d2) noexcept    { return (int32) (d1 - d2) < 0; }
+
+struct DeadlineScheduler::ServiceThread  : public Thread
+{
+    ServiceThread (DeadlineScheduler& ds, const String& name)  : Thread (name), owner (ds) {}
+
+    void run() override    { owner.serviceClients (*this); }
+
+    DeadlineScheduler& owner;
+};
+
+//==============================================================================
+DeadlineScheduler::DeadlineScheduler (const String& threadName, int numServiceThreads)
+{
+    for (int i = jmax (1, numServiceThreads); --i >= 0;)
+        threads.add (new ServiceThread (*this, threadName));
+}
+
+DeadlineScheduler::~DeadlineScheduler()
+{
+    removeAllClients();
+
+    for (auto* t : threads)
+        t->signalThreadShouldExit();
+
+    for (auto* t : threads)
+        t->stopThread (2000);
+}
+
+//==============================================================================
+void DeadlineScheduler::siftUp (int index)
+{
+    auto* client = heap.getUnchecked (index);
+
+    while (index > 0)
+    {
+        const int parent = (index - 1) / 2;
+        auto* parentClient = heap.getUnchecked (parent);
+
+        if (! isDeadlineEarlier (client->deadline, parentClient->deadline))
+            break;
+
+        heap.set (index, parentClient);
+        parentClient->heapPosition = index;
+        index = parent;
+    }
+
+    heap.set (index, client);
+    client->heapPosition = index;
+}
+
+void DeadlineScheduler::siftDown (int index)
+{
+    auto* client = heap.getUnchecked (index);
+    const int size = heap.size();
+
+    for (;;)
+    {
+        int earliest = 2 * index + 1;
+
+        if (earliest >= size)
+            break;
+
+        if (earliest + 1 < size
+             && isDeadlineEarlier (heap.getUnchecked (earliest + 1)->deadline,
+                                   heap.getUnchecked (earliest)->deadline))
+            ++earliest;
+
+        auto* earliestClient = heap.getUnchecked (earliest);
+
+        if (! isDeadlineEarlier (earliestClient->deadline, client->deadline))
+            break;
+
+        heap.set (index, earliestClient);
+        earliestClient->heapPosition = index;
+        index = earliest;
+    }
+
+    heap.set (index, client);
+    client->heapPosition = index;
+}
+
+void DeadlineScheduler::pushClient (Client* client, uint32 newDeadline)
+{
+    client->deadline = newDeadline;
+    heap.add (client);
+    client->heapPosition = heap.size() - 1;
+    siftUp (client->heapPosition);
+}
+
+void DeadlineScheduler::removeFromHeap (Client* client) noexcept
+{
+    const int index = client->heapPosition;
+    auto* last = heap.getLast();
+    heap.removeLast();
+    client->heapPosition = -1;
+
+    if (last != client)
+    {
+        heap.set (index, last);
+        last->heapPosition = index;
+        siftDown (index);
+        siftUp (last->heapPosition);
+    }
+}
+
+DeadlineScheduler::Client* DeadlineScheduler::popOverdueClient (uint32 now) noexcept
+{
+    if (heap.isEmpty())
+        return nullptr;
+
+    auto* client = heap.getFirst();
+
+    if (isDeadlineEarlier (now, client->deadline))
+        return nullptr;
+
+    removeFromHeap (client);
+    return client;
+}
+
+//==============================================================================
+void DeadlineScheduler::addClient (Client* const client, int millisecondsBeforeStarting)
+{
+    if (client != nullptr)
+    {
+        const ScopedLock sl (heapLock);
+
+        auto newDeadline = Time::getMillisecondCounter() + (uint32) jmax (0, millisecondsBeforeStarting);
+
+        if (client->heapPosition >= 0)
+        {
+            client->deadline = newDeadline;
+            siftUp (client->heapPosition);
+            siftDown (client->heapPosition);
+        }
+        else if (! (client->beingServed || client->pendingRemoval))
+        {
+            pushClient (client, newDeadline);
+            ++numClients;
+        }
+
+        startThreadsIfNeeded();
+
+        for (auto* t : threads)
+            t->notify();
+    }
+}
+
+void DeadlineScheduler::removeClient (Client* const client)
+{
+    if (client == nullptr)
+        return;
+
+    for (;;)
+    {
+        {
+            const ScopedLock sl (heapLock);
+
+            if (! client->beingServed)
+            {
+                if (client->heapPosition >= 0)
+                {
+                    removeFromHeap (client);
+                    --numClients;
+                }
+                else if (client->pendingRemoval)
+                {
+                    // it finished its last slice after we asked for removal
+                    --numClients;
+                }
+
+                client->pendingRemoval = false;
+                return;
+            }
+
+            // a thread is in the middle of calling this client - ask the
+            // service loop not to requeue it, and wait for the call to finish
+            client->pendingRemoval = true;
+        }
+
+        clientServed.wait (20);
+    }
+}
+
+void DeadlineScheduler::removeAllClients()
+{
+    for (;;)
+    {
+        Client* clientToRemove = nullptr;
+
+        {
+            const ScopedLock sl (heapLock);
+
+            if (! heap.isEmpty())
+                clientToRemove = heap.getFirst();
+            else if (numClients == 0)
+                return;
+        }
+
+        if (clientToRemove != nullptr)
+            removeClient (clientToRemove);
+        else
+            clientServed.wait (20); // some clients are mid-callback
+    }
+}
+
+void DeadlineScheduler::makeDeadlineImmediate (Client* const client)
+{
+    const ScopedLock sl (heapLock);
+
+    if (client != nullptr && client->heapPosition >= 0)
+    {
+        client->deadline = Time::getMillisecondCounter();
+        siftUp (client->heapPosition);
+
+        for (auto* t : threads)
+            t->notify();
+    }
+}
+
+int DeadlineScheduler::getNumClients() const
+{
+    const ScopedLock sl (heapLock);
+    return numClients;
+}
+
+void DeadlineScheduler::startThreadsIfNeeded()
+{
+    for (auto* t : threads)
+        if (! t->isThreadRunning())
+            t->startThread();
+}
+
+//==============================================================================
+void DeadlineScheduler::serviceClients (Thread& thread)
+{
+    while (! thread.threadShouldExit())
+    {
+        int timeToWait = 500;
+        Client* client = nullptr;
+
+        {
+            const ScopedLock sl (heapLock);
+            auto now = Time::getMillisecondCounter();
+
+            client = popOverdueClient (now);
+
+            if (client != nullptr)
+                client->beingServed = true;
+            else if (! heap.isEmpty())
+                timeToWait = (int) jmin ((uint32) 500, heap.getFirst()->deadline - now);
+        }
+
+        if (client != nullptr)
+        {
+            const int msUntilNextDeadline = client->useTimeSlice();
+
+            {
+                const ScopedLock sl (heapLock);
+                client->beingServed = false;
+
+                if (client->pendingRemoval || msUntilNextDeadline < 0)
+                {
+                    if (! client->pendingRemoval)
+                        --numClients; // it removed itself by returning < 0
+                }
+                else
+                {
+                    pushClient (client, Time::getMillisecondCounter() + (uint32) msUntilNextDeadline);
+                }
+            }
+
+            clientServed.signal();
+            timeToWait = 0;
+        }
+
+        if (timeToWait > 0)
+            thread.wait (timeToWait);
+    }
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class DeadlineSchedulerTests  : public UnitTest
+{
+public:
+    DeadlineSchedulerTests()
+        : UnitTest ("DeadlineScheduler", UnitTestCategories::threads)
+    {}
+
+    struct CountingClient  : public DeadlineScheduler::Client
+    {
+        int useTimeSlice() override
+        {
+            ++numSlices;
+            return numSlices.load() < slicesWanted ? interval : -1;
+        }
+
+        std::atomic<int> numSlices { 0 };
+        int slicesWanted = 10, interval = 1;
+    };
+
+    void runTest() override
+    {
+        beginTest ("Clients are serviced in deadline order");
+        {
+            DeadlineScheduler scheduler ("test scheduler");
+
+            struct OrderedClient  : public DeadlineScheduler::Client
+            {
+                int useTimeSlice() override    { order->add (index); return -1; }
+
+                Array<int, CriticalSection>* order = nullptr;
+                int index = 0;
+            };
+
+            Array<int, CriticalSection> order;
+            OrderedClient clients[4];
+            const int delays[] = { 120, 40, 160, 80 };
+
+            for (int i = 0; i < 4; ++i)
+            {
+                clients[i].order = &order;
+                clients[i].index = i;
+                scheduler.addClient (&clients[i], delays[i]);
+            }
+
+            expectEquals (scheduler.getNumClients(), 4);
+
+            auto deadline = Time::getMillisecondCounter() + 5000;
+
+            while (scheduler.getNumClients() > 0 && Time::getMillisecondCounter() < deadline)
+                Thread::sleep (5);
+
+            expectEquals (order.size(), 4);
+            expectEquals (order[0], 1);
+            expectEquals (order[1], 3);
+            expectEquals (order[2], 0);
+            expectEquals (order[3], 2);
+        }
+
+        beginTest ("Multiple service threads share one client set");
+        {
+            DeadlineScheduler scheduler ("test scheduler", 3);
+
+            CountingClient clients[8];
+
+            for (auto& c : clients)
+                scheduler.addClient (&c);
+
+            auto deadline = Time::getMillisecondCounter() + 10000;
+
+            while (scheduler.getNumClients() > 0 && Time::getMillisecondCounter() < deadline)
+                Thread::sleep (5);
+
+            expectEquals (scheduler.getNumClients(), 0);
+
+            for (auto& c : clients)
+                expectEquals (c.numSlices.load(), c.slicesWanted);
+        }
+
+        beginTest ("Removal waits for callbacks in progress");
+        {
+            DeadlineScheduler scheduler ("test scheduler", 2);
+
+            CountingClient client;
+            client.slicesWanted = std::numeric_limits<int>::max();
+
+            scheduler.addClient (&client);
+
+            while (client.numSlices.load() == 0)
+                Thread::sleep (1);
+
+            scheduler.removeClient (&client);
+            expectEquals (scheduler.getNumClients(), 0);
+
+            auto slicesAfterRemoval = client.numSlices.load();
+            Thread::sleep (50);
+            expectEquals (client.numSlices.load(), slicesAfterRemoval);
+        }
+    }
+};
+
+static DeadlineSchedulerTests deadlineSchedulerTests;
+
+#endif
+
+} // namespace juce
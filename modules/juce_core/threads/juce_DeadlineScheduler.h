@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A deadline-ordered alternative to TimeSliceThread which can serve one set
+    of clients from several threads.
+
+    Each client has a deadline - the time at which it next wants a slice - and
+    the scheduler keeps its clients in a priority heap keyed by that deadline,
+    so picking the most urgent client is O(log n) rather than a linear scan of
+    the whole list. That matters when a few time-critical clients (e.g. disk
+    streamers about to underrun) share a scheduler with hundreds of mostly-idle
+    ones.
+
+    The scheduler can run any number of service threads over the same client
+    set. A client is only ever given a slice by one thread at a time, but
+    different clients whose deadlines have passed are serviced concurrently.
+
+    @see TimeSliceThread, TimeSliceClient
+
+    @tags{Core}
+*/
+class JUCE_API  DeadlineScheduler
+{
+public:
+    //==============================================================================
+    /**
+        The base class for things that can be registered with a DeadlineScheduler.
+
+        The callback contract is the same as TimeSliceClient::useTimeSlice() - do
+        a short piece of work and return the number of milliseconds until the
+        next slice is due, or a negative number to be removed from the scheduler.
+
+        A client may only be registered with one DeadlineScheduler at a time.
+
+        @tags{Core}
+    */
+    class JUCE_API  Client
+    {
+    public:
+        /** Destructor. */
+        virtual ~Client() = default;
+
+        /** Called back by one of the scheduler's service threads.
+
+            The implementation of this method should use its time-slice to do
+            something that's quick - never block for longer than absolutely
+            necessary.
+
+            @returns    the number of milliseconds until this client's next
+                        deadline. Returning 0 makes the deadline immediate, so
+                        the client is re-served as soon as a thread is free
+                        (after any other overdue clients). A negative return
+                        value removes the client from the scheduler.
+        */
+        virtual int useTimeSlice() = 0;
+
+    private:
+        friend class DeadlineScheduler;
+        uint32 deadline = 0;
+        int heapPosition = -1;
+        bool beingServed = false, pendingRemoval = false;
+    };
+
+    //==============================================================================
+    /** Creates a scheduler with the given number of service threads.
+
+        The threads aren't started until the first client is added.
+    */
+    explicit DeadlineScheduler (const String& threadName, int numServiceThreads = 1);
+
+    /** Destructor.
+        Any remaining clients are removed and the service threads are stopped.
+    */
+    ~DeadlineScheduler();
+
+    //==============================================================================
+    /** Adds a client, with its first deadline the given number of milliseconds
+        from now. The first callback may happen before this method has returned.
+    */
+    void addClient (Client* clientToAdd, int millisecondsBeforeStarting = 0);
+
+    /** Removes a client.
+        This method will make sure that all callbacks to the client have
+        completely finished before it returns.
+    */
+    void removeClient (Client* clientToRemove);
+
+    /** Removes all clients, waiting for any callbacks in progress to finish. */
+    void removeAllClients();
+
+    /** Moves a client's deadline to now, so that it will be serviced as soon as
+        a thread is free. If the client isn't registered, nothing happens.
+    */
+    void makeDeadlineImmediate (Client* clientToPromote);
+
+    /** Returns the number of registered clients. */
+    int getNumClients() const;
+
+private:
+    //==============================================================================
+    struct ServiceThread;
+
+    mutable CriticalSection heapLock;
+    Array<Client*> heap;
+    int numClients = 0;
+    WaitableEvent clientServed;
+    OwnedArray<ServiceThread> threads;
+
+    void siftUp (int index);
+    void siftDown (int index);
+    void pushClient (Client*, uint32 newDeadline);
+    void removeFromHeap (Client*) noexcept;
+    Client* popOverdueClient (uint32 now) noexcept;
+    void serviceClients (Thread&);
+    void startThreadsIfNeeded();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DeadlineScheduler)
+};
+
+} // namespace juce
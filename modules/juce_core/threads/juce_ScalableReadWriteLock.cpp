@@ -0,0 +1,220 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+ScalableReadWriteLock::ScalableReadWriteLock() noexcept {}
+
+ScalableReadWriteLock::~ScalableReadWriteLock() noexcept
+{
+    jassert (writerActive.load() == 0);
+
+   #if JUCE_DEBUG
+    for (auto& slot : readerSlots)
+        jassert (slot.count.load() == 0);
+   #endif
+}
+
+const ScalableReadWriteLock::ReaderSlot& ScalableReadWriteLock::getSlotForCurrentThread() const noexcept
+{
+    // thread IDs are pointers or small integers, so mix the bits a little
+    // before folding them down to a slot index
+    auto id = (pointer_sized_uint) Thread::getCurrentThreadId();
+    return readerSlots[((id >> 4) ^ (id >> 12)) & (pointer_sized_uint) (numReaderSlots - 1)];
+}
+
+//==============================================================================
+void ScalableReadWriteLock::enterRead() const noexcept
+{
+    while (! tryEnterRead())
+        readWaitEvent.wait (100);
+}
+
+bool ScalableReadWriteLock::tryEnterRead() const noexcept
+{
+    auto& slot = getSlotForCurrentThread();
+
+    // The increment must be globally ordered against the writer's flag-then-scan
+    // sequence, so that either the writer sees this reader, or this reader sees
+    // the writer - hence the sequentially-consistent operations here and below.
+    slot.count.fetch_add (1);
+
+    if (writerActive.load() == 0)
+        return true;
+
+    // a writer holds or is waiting for the lock - back out and let it through
+    if (slot.count.fetch_sub (1) == 1)
+        writeWaitEvent.signal();
+
+    return false;
+}
+
+void ScalableReadWriteLock::exitRead() const noexcept
+{
+    getSlotForCurrentThread().count.fetch_sub (1);
+
+    if (writerActive.load() != 0)
+        writeWaitEvent.signal();
+}
+
+//==============================================================================
+void ScalableReadWriteLock::enterWrite() const noexcept
+{
+    writerLock.enter();
+
+    if (++writeCount > 1)
+        return; // this thread is already the writer
+
+    writerActive.store (1);
+
+    for (auto& slot : readerSlots)
+        while (slot.count.load() != 0)
+            writeWaitEvent.wait (100);
+}
+
+bool ScalableReadWriteLock::tryEnterWrite() const noexcept
+{
+    if (! writerLock.tryEnter())
+        return false;
+
+    if (++writeCount > 1)
+        return true; // this thread is already the writer
+
+    writerActive.store (1);
+
+    for (auto& slot : readerSlots)
+    {
+        if (slot.count.load() != 0)
+        {
+            writerActive.store (0);
+            --writeCount;
+            writerLock.exit();
+            readWaitEvent.signal();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ScalableReadWriteLock::exitWrite() const noexcept
+{
+    // check this thread actually had the lock..
+    jassert (writeCount > 0);
+
+    if (--writeCount == 0)
+    {
+        writerActive.store (0);
+        readWaitEvent.signal();
+    }
+
+    writerLock.exit();
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct ScalableReadWriteLockTests  : public UnitTest
+{
+    ScalableReadWriteLockTests()
+        : UnitTest ("ScalableReadWriteLock", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Writers are exclusive against concurrent readers");
+        {
+            ScalableReadWriteLock lock;
+            int sharedA = 0, sharedB = 0;
+            std::atomic<bool> sawTornState { false };
+            std::atomic<int> threadsRunning { 0 };
+            WaitableEvent allFinished;
+
+            const int numThreads = 4;
+
+            for (int t = 0; t < numThreads; ++t)
+            {
+                ++threadsRunning;
+
+                Thread::launch ([&, t]
+                {
+                    Random random ((int64) t + 1);
+
+                    for (int i = 0; i < 2000; ++i)
+                    {
+                        if (random.nextInt (50) == 0)
+                        {
+                            const ScalableReadWriteLock::ScopedWriteLockType sl (lock);
+                            ++sharedA;
+                            Thread::yield();
+                            ++sharedB;
+                        }
+                        else
+                        {
+                            const ScalableReadWriteLock::ScopedReadLockType sl (lock);
+
+                            if (sharedA != sharedB)
+                                sawTornState = true;
+                        }
+                    }
+
+                    if (--threadsRunning == 0)
+                        allFinished.signal();
+                });
+            }
+
+            allFinished.wait();
+
+            expect (! sawTornState);
+            expectEquals (sharedA, sharedB);
+        }
+
+        beginTest ("Try-enter respects current holders");
+        {
+            ScalableReadWriteLock lock;
+
+            lock.enterRead();
+            expect (lock.tryEnterRead());     // other readers can share
+            expect (! lock.tryEnterWrite());  // but a writer can't get in
+            lock.exitRead();
+            lock.exitRead();
+
+            lock.enterWrite();
+            expect (! lock.tryEnterRead());
+            expect (lock.tryEnterWrite());    // the write lock is recursive
+            lock.exitWrite();
+            lock.exitWrite();
+
+            expect (lock.tryEnterWrite());
+            lock.exitWrite();
+        }
+    }
+};
+
+static ScalableReadWriteLockTests scalableReadWriteLockTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A reader-writer lock designed for read-mostly data shared between many threads.
+
+    ReadWriteLock takes an internal lock on every enterRead(), so with many
+    concurrent readers the threads end up serialising on that lock word and the
+    cache line holding it bounces between cores. This class instead spreads the
+    reader count across a set of independent, cache-line-padded slots chosen by
+    thread identity: uncontended readers touch only their own slot, so read
+    throughput scales with the number of reader threads. Writers pay for this -
+    taking the write lock publishes a flag that diverts new readers, then scans
+    every slot until the readers already inside have drained.
+
+    Use it for structures that are read constantly and rebuilt rarely (routing
+    tables, graph topology, lookup maps). If writes are frequent, or readers and
+    writers are balanced, plain ReadWriteLock or a CriticalSection will serve
+    better.
+
+    The write lock is recursive, but unlike ReadWriteLock the read lock is not:
+    a thread must not call enterRead() again while a writer is waiting, and
+    must not take the write lock while it holds a read lock (or vice versa), or
+    it will deadlock against itself.
+
+    @see ReadWriteLock, CriticalSection
+
+    @tags{Core}
+*/
+class JUCE_API  ScalableReadWriteLock
+{
+public:
+    //==============================================================================
+    /** Creates a ScalableReadWriteLock. */
+    ScalableReadWriteLock() noexcept;
+
+    /** Destructor.
+        If the object is deleted whilst locked, any subsequent behaviour is undefined.
+    */
+    ~ScalableReadWriteLock() noexcept;
+
+    //==============================================================================
+    /** Locks this object for reading.
+        Multiple threads can hold the read lock simultaneously; this blocks only
+        while a writer holds or is waiting for the lock.
+        @see exitRead
+    */
+    void enterRead() const noexcept;
+
+    /** Tries to lock this object for reading, failing if a writer holds or is
+        waiting for the lock.
+        @returns true if the lock was gained
+        @see exitRead
+    */
+    bool tryEnterRead() const noexcept;
+
+    /** Releases the read lock.
+        This must be called on the same thread that called enterRead().
+        @see enterRead
+    */
+    void exitRead() const noexcept;
+
+    //==============================================================================
+    /** Locks this object for writing.
+        This blocks until all current readers and any other writer have released
+        the lock; new readers arriving in the meantime are held back.
+        @see exitWrite
+    */
+    void enterWrite() const noexcept;
+
+    /** Tries to lock this object for writing, without blocking.
+        @returns true if the lock was gained
+        @see enterWrite
+    */
+    bool tryEnterWrite() const noexcept;
+
+    /** Releases the write lock.
+        @see enterWrite
+    */
+    void exitWrite() const noexcept;
+
+    //==============================================================================
+    /** Automatically locks and unlocks the read side of a ScalableReadWriteLock. */
+    struct ScopedReadLockType
+    {
+        explicit ScopedReadLockType (const ScalableReadWriteLock& l) noexcept : lock (l)  { lock.enterRead(); }
+        ~ScopedReadLockType() noexcept                                                    { lock.exitRead(); }
+
+        const ScalableReadWriteLock& lock;
+        JUCE_DECLARE_NON_COPYABLE (ScopedReadLockType)
+    };
+
+    /** Automatically locks and unlocks the write side of a ScalableReadWriteLock. */
+    struct ScopedWriteLockType
+    {
+        explicit ScopedWriteLockType (const ScalableReadWriteLock& l) noexcept : lock (l) { lock.enterWrite(); }
+        ~ScopedWriteLockType() noexcept                                                   { lock.exitWrite(); }
+
+        const ScalableReadWriteLock& lock;
+        JUCE_DECLARE_NON_COPYABLE (ScopedWriteLockType)
+    };
+
+private:
+    //==============================================================================
+    enum { numReaderSlots = 16 };
+
+    struct alignas (64) ReaderSlot
+    {
+        mutable std::atomic<int> count { 0 };
+    };
+
+    const ReaderSlot& getSlotForCurrentThread() const noexcept;
+
+    ReaderSlot readerSlots[numReaderSlots];
+    mutable std::atomic<int> writerActive { 0 };
+    mutable int writeCount = 0;   // guarded by writerLock
+    CriticalSection writerLock;
+    WaitableEvent readWaitEvent, writeWaitEvent;
+
+    JUCE_DECLARE_NON_COPYABLE (ScalableReadWriteLock)
+};
+
+} // namespace juce
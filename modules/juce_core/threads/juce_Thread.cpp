@@ -91,6 +91,9 @@ void Thread::threadEntryPoint()
         if (affinityMask != 0)
             setCurrentThreadAffinityMask (affinityMask);
 
+        if (useRealtimeOptions)
+            setCurrentThreadRealtimeOptions (realtimeOptions);
+
         try
         {
             run();
@@ -143,6 +146,7 @@ void Thread::startThread (int priority)
         isAndroidRealtimeThread = (priority == realtimeAudioPriority);
        #endif
 
+        useRealtimeOptions = false;
         threadPriority = getAdjustedPriority (priority);
         startThread();
     }
@@ -152,6 +156,37 @@ void Thread::startThread (int priority)
     }
 }
 
+bool Thread::startRealtimeThread (const RealtimeOptions& options)
+{
+    const ScopedLock sl (startStopLock);
+
+    if (threadHandle.get() != nullptr)
+        return false;
+
+    realtimeOptions = options;
+    useRealtimeOptions = true;
+
+    if (isPositiveAndBelow (options.processorToUse, 32))
+        affinityMask = (uint32) (1u << options.processorToUse);
+
+   #if JUCE_ANDROID
+    isAndroidRealtimeThread = true;
+   #endif
+
+    threadPriority = getAdjustedPriority (realtimeAudioPriority);
+    shouldExit = 0;
+    launchThread();
+
+    // The new thread is suspended until the event below is signalled, so it's
+    // safe to look at the handle here even if run() will return immediately.
+    const auto launched = threadHandle.get() != nullptr;
+
+    setThreadPriority (threadHandle.get(), threadPriority);
+    startSuspensionEvent.signal();
+
+    return launched;
+}
+
 bool Thread::isThreadRunning() const
 {
     return threadHandle.get() != nullptr;
@@ -290,6 +325,48 @@ void Thread::setAffinityMask (const uint32 newAffinityMask)
     affinityMask = newAffinityMask;
 }
 
+//==============================================================================
+Thread::RealtimeOptions Thread::RealtimeOptions::withPeriodMs (double newPeriodMs) const noexcept
+{
+    jassert (newPeriodMs > 0);
+    auto copy = *this;
+    copy.periodMs = newPeriodMs;
+    return copy;
+}
+
+Thread::RealtimeOptions Thread::RealtimeOptions::withPeriodHz (double newPeriodHz) const noexcept
+{
+    jassert (newPeriodHz > 0);
+    return withPeriodMs (1000.0 / newPeriodHz);
+}
+
+Thread::RealtimeOptions Thread::RealtimeOptions::withProcessingTimeMs (double newProcessingTimeMs) const noexcept
+{
+    jassert (newProcessingTimeMs > 0);
+    auto copy = *this;
+    copy.processingTimeMs = newProcessingTimeMs;
+    return copy;
+}
+
+Thread::RealtimeOptions Thread::RealtimeOptions::withApproximateAudioProcessingTime (int samplesPerFrame,
+                                                                                     double sampleRate) const noexcept
+{
+    jassert (samplesPerFrame > 0 && sampleRate > 0);
+    const auto periodForBuffer = 1000.0 * samplesPerFrame / sampleRate;
+
+    // Budget most of the callback period for processing, leaving a little slack
+    // for the thread that consumes the results.
+    return withPeriodMs (periodForBuffer).withProcessingTimeMs (0.75 * periodForBuffer);
+}
+
+Thread::RealtimeOptions Thread::RealtimeOptions::withProcessorToUse (int processorIndex) const noexcept
+{
+    auto copy = *this;
+    copy.processorToUse = processorIndex;
+    return copy;
+}
+
+//==============================================================================
 int Thread::getAdjustedPriority (int newPriority)
 {
     return jlimit (0, 10, newPriority == realtimeAudioPriority ? 9 : newPriority);
@@ -96,6 +96,83 @@ public:
     */
     void startThread (int priority);
 
+    //==============================================================================
+    /** A set of requirements used to ask the OS for real-time scheduling.
+
+        Real-time scheduling policies give much stronger guarantees when they're
+        told how often a thread needs to run and how much work it does each time,
+        so describe the thread's duty cycle here as accurately as you can. The
+        options are built up by chaining the with methods:
+
+        @code
+        thread.startRealtimeThread (Thread::RealtimeOptions()
+                                       .withApproximateAudioProcessingTime (blockSize, sampleRate));
+        @endcode
+
+        @see startRealtimeThread, setCurrentThreadRealtimeOptions
+    */
+    struct JUCE_API  RealtimeOptions
+    {
+        /** Specifies the interval, in milliseconds, at which the thread will wake
+            up and do its work. Leave unset if the thread doesn't run periodically.
+        */
+        RealtimeOptions withPeriodMs (double newPeriodMs) const noexcept;
+
+        /** Specifies the thread's wake-up rate as a frequency in Hz, as an
+            alternative to withPeriodMs().
+        */
+        RealtimeOptions withPeriodHz (double newPeriodHz) const noexcept;
+
+        /** Specifies the amount of work, in milliseconds, that the thread is
+            expected to do in each period. Where the OS supports reservation-based
+            scheduling (SCHED_DEADLINE on Linux, the time-constraint policy on the
+            Mac), this much time per period is reserved for the thread.
+        */
+        RealtimeOptions withProcessingTimeMs (double newProcessingTimeMs) const noexcept;
+
+        /** Sets a period and processing time suitable for a thread that helps to
+            compute an audio callback of the given block size and sample rate.
+        */
+        RealtimeOptions withApproximateAudioProcessingTime (int samplesPerFrame, double sampleRate) const noexcept;
+
+        /** Specifies the index of the processor that the thread should prefer to
+            run on, or -1 for no preference.
+
+            Note that on Linux, pinning a thread to one core is incompatible with
+            deadline scheduling, so setting this makes the thread fall back to
+            round-robin scheduling.
+        */
+        RealtimeOptions withProcessorToUse (int processorIndex) const noexcept;
+
+        /** The thread's period in milliseconds, or 0 if unspecified. */
+        double periodMs = 0.0;
+
+        /** The expected work per period in milliseconds, or 0 if unspecified. */
+        double processingTimeMs = 0.0;
+
+        /** The preferred processor index, or -1 for no preference. */
+        int processorToUse = -1;
+    };
+
+    /** Starts the thread under the OS's real-time scheduling policy.
+
+        This is like startThread (realtimeAudioPriority), but also passes the
+        period and expected processing time on to schedulers that can make use of
+        them - SCHED_DEADLINE on Linux, the time-constraint policy on macOS and
+        iOS, and MMCSS on Windows - which stops the thread being descheduled in
+        the middle of its work by other high-priority activity.
+
+        If this thread is already running, nothing happens and false is returned.
+
+        @returns  true if the thread was started. Note that the scheduling request
+                  itself is made from the new thread, and may be refused by the OS
+                  (e.g. for lack of privileges), in which case the thread runs with
+                  an ordinary high priority instead.
+        @see RealtimeOptions, startThread, setCurrentThreadRealtimeOptions
+    */
+    bool startRealtimeThread (const RealtimeOptions& options);
+
+    //==============================================================================
     /** Attempts to stop the thread running.
 
         This method will cause the threadShouldExit() method to return true
@@ -243,6 +320,17 @@ public:
     */
     static bool setCurrentThreadPriority (int priority);
 
+    /** Applies real-time scheduling to the caller thread.
+
+        Similar to startRealtimeThread(), but acts on the thread that calls this
+        static method, which needn't belong to a Thread object - e.g. a worker
+        supplied by a ThreadPool, or a thread created by a third-party library.
+        May return false if the OS refuses the scheduling request.
+
+        @see RealtimeOptions, startRealtimeThread
+    */
+    static bool setCurrentThreadRealtimeOptions (const RealtimeOptions& options);
+
     //==============================================================================
     /** Sets the affinity mask for the thread.
 
@@ -390,6 +478,8 @@ private:
     int threadPriority = 5;
     size_t threadStackSize;
     uint32 affinityMask = 0;
+    RealtimeOptions realtimeOptions;
+    bool useRealtimeOptions = false;
     bool deleteOnThreadEnd = false;
     Atomic<int32> shouldExit { 0 };
     ListenerList<Listener, Array<Listener*, CriticalSection>> listeners;
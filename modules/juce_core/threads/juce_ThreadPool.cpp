@@ -33,12 +33,44 @@ struct ThreadPool::ThreadPoolThread  : public Thread
     void run() override
     {
         while (! threadShouldExit())
-            if (! pool.runNextJob (*this))
+            if (! (pool.runNextTask (this) || pool.runNextJob (*this)))
                 wait (500);
     }
 
+    void pushLocalTask (ThreadPool::Task&& task)
+    {
+        const SpinLock::ScopedLockType sl (taskLock);
+        localTasks.add (std::move (task));
+    }
+
+    // The owning thread takes tasks from the newest end of its deque, which
+    // keeps recursively-forked work hot in its cache.
+    ThreadPool::Task popLocalTask()
+    {
+        const SpinLock::ScopedLockType sl (taskLock);
+
+        if (localTasks.isEmpty())
+            return {};
+
+        return localTasks.removeAndReturn (localTasks.size() - 1);
+    }
+
+    // Thieves take from the oldest end, so they pick up the biggest
+    // still-unsplit pieces of work and don't fight the owner for the newest.
+    ThreadPool::Task tryToStealTask()
+    {
+        const SpinLock::ScopedTryLockType sl (taskLock);
+
+        if (! sl.isLocked() || localTasks.isEmpty())
+            return {};
+
+        return localTasks.removeAndReturn (0);
+    }
+
     std::atomic<ThreadPoolJob*> currentJob { nullptr };
     ThreadPool& pool;
+    SpinLock taskLock;
+    Array<ThreadPool::Task> localTasks;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ThreadPoolThread)
 };
@@ -90,11 +122,11 @@ ThreadPoolJob* ThreadPoolJob::getCurrentThreadPoolJob()
 }
 
 //==============================================================================
-ThreadPool::ThreadPool (int numThreads, size_t threadStackSize)
+ThreadPool::ThreadPool (int numThreads, size_t threadStackSize, uint32 threadAffinityMask)
 {
     jassert (numThreads > 0); // not much point having a pool without any threads!
 
-    createThreads (numThreads, threadStackSize);
+    createThreads (numThreads, threadStackSize, threadAffinityMask);
 }
 
 ThreadPool::ThreadPool()
@@ -108,13 +140,18 @@ ThreadPool::~ThreadPool()
     stopThreads();
 }
 
-void ThreadPool::createThreads (int numThreads, size_t threadStackSize)
+void ThreadPool::createThreads (int numThreads, size_t threadStackSize, uint32 threadAffinityMask)
 {
     for (int i = jmax (1, numThreads); --i >= 0;)
         threads.add (new ThreadPoolThread (*this, threadStackSize));
 
     for (auto* t : threads)
+    {
+        if (threadAffinityMask != 0)
+            t->setAffinityMask (threadAffinityMask);
+
         t->startThread();
+    }
 }
 
 void ThreadPool::stopThreads()
@@ -148,30 +185,30 @@ void ThreadPool::addJob (ThreadPoolJob* job, bool deleteJobWhenFinished)
     }
 }
 
-void ThreadPool::addJob (std::function<ThreadPoolJob::JobStatus()> jobToRun)
+void ThreadPool::addJob (MoveOnlyFunction<ThreadPoolJob::JobStatus()> jobToRun)
 {
     struct LambdaJobWrapper  : public ThreadPoolJob
     {
-        LambdaJobWrapper (std::function<ThreadPoolJob::JobStatus()> j) : ThreadPoolJob ("lambda"), job (j) {}
+        LambdaJobWrapper (MoveOnlyFunction<ThreadPoolJob::JobStatus()> j) : ThreadPoolJob ("lambda"), job (std::move (j)) {}
         JobStatus runJob() override      { return job(); }
 
-        std::function<ThreadPoolJob::JobStatus()> job;
+        MoveOnlyFunction<ThreadPoolJob::JobStatus()> job;
     };
 
-    addJob (new LambdaJobWrapper (jobToRun), true);
+    addJob (new LambdaJobWrapper (std::move (jobToRun)), true);
 }
 
-void ThreadPool::addJob (std::function<void()> jobToRun)
+void ThreadPool::addJob (MoveOnlyFunction<void()> jobToRun)
 {
     struct LambdaJobWrapper  : public ThreadPoolJob
     {
-        LambdaJobWrapper (std::function<void()> j) : ThreadPoolJob ("lambda"), job (j) {}
+        LambdaJobWrapper (MoveOnlyFunction<void()> j) : ThreadPoolJob ("lambda"), job (std::move (j)) {}
         JobStatus runJob() override      { job(); return ThreadPoolJob::jobHasFinished; }
 
-        std::function<void()> job;
+        MoveOnlyFunction<void()> job;
     };
 
-    addJob (new LambdaJobWrapper (jobToRun), true);
+    addJob (new LambdaJobWrapper (std::move (jobToRun)), true);
 }
 
 int ThreadPool::getNumJobs() const noexcept
@@ -341,6 +378,92 @@ bool ThreadPool::setThreadPriorities (int newPriority)
     return ok;
 }
 
+//==============================================================================
+ThreadPool::ThreadPoolThread* ThreadPool::getCurrentPoolThread() const
+{
+    auto* t = dynamic_cast<ThreadPoolThread*> (Thread::getCurrentThread());
+    return (t != nullptr && &t->pool == this) ? t : nullptr;
+}
+
+void ThreadPool::pushTaskToAnyThread (Task&& task)
+{
+    // The counter is unsigned so that wrapping after ~4 billion pushes can't
+    // produce a negative index.
+    auto index = (int) (nextTaskPushIndex.fetch_add (1) % (uint32) threads.size());
+    auto* t = threads.getUnchecked (index);
+
+    t->pushLocalTask (std::move (task));
+    t->notify();
+}
+
+ThreadPool::Task ThreadPool::stealTaskFromAnotherThread (ThreadPoolThread* threadToExclude)
+{
+    for (auto* t : threads)
+    {
+        if (t != threadToExclude)
+        {
+            auto task = t->tryToStealTask();
+
+            if (task != nullptr)
+                return task;
+        }
+    }
+
+    return {};
+}
+
+void ThreadPool::addTask (Task task)
+{
+    jassert (task != nullptr);
+
+    if (auto* t = getCurrentPoolThread())
+        t->pushLocalTask (std::move (task));
+    else
+        pushTaskToAnyThread (std::move (task));
+}
+
+void ThreadPool::parallelInvoke (Task task1, Task task2)
+{
+    jassert (task1 != nullptr && task2 != nullptr);
+
+    std::atomic<bool> task2Done { false };
+    auto* currentThread = getCurrentPoolThread();
+
+    Task forkedTask = [&task2, &task2Done]
+    {
+        task2();
+        task2Done.store (true, std::memory_order_release);
+    };
+
+    if (currentThread != nullptr)
+        currentThread->pushLocalTask (std::move (forkedTask));
+    else
+        pushTaskToAnyThread (std::move (forkedTask));
+
+    task1();
+
+    // Rather than blocking, keep running other queued tasks until the forked
+    // one has completed - this is what allows tasks to fork recursively
+    // without exhausting the pool's threads.
+    while (! task2Done.load (std::memory_order_acquire))
+        if (! runNextTask (currentThread))
+            Thread::yield();
+}
+
+bool ThreadPool::runNextTask (ThreadPoolThread* thread)
+{
+    auto task = thread != nullptr ? thread->popLocalTask() : Task();
+
+    if (task == nullptr)
+        task = stealTaskFromAnotherThread (thread);
+
+    if (task == nullptr)
+        return false;
+
+    task();
+    return true;
+}
+
 ThreadPoolJob* ThreadPool::pickNextJobToRun()
 {
     OwnedArray<ThreadPoolJob> deletionList;
@@ -429,4 +552,189 @@ void ThreadPool::addToDeleteList (OwnedArray<ThreadPoolJob>& deletionList, Threa
         deletionList.add (job);
 }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ThreadPoolTests  : public UnitTest
+{
+public:
+    ThreadPoolTests()
+        : UnitTest ("ThreadPool", UnitTestCategories::threads)
+    {}
+
+    static bool waitFor (std::function<bool()> condition, int timeOutMs = 10000)
+    {
+        auto endTime = Time::getMillisecondCounter() + (uint32) timeOutMs;
+
+        while (! condition())
+        {
+            if (Time::getMillisecondCounter() > endTime)
+                return false;
+
+            Thread::sleep (1);
+        }
+
+        return true;
+    }
+
+    void runTest() override
+    {
+        beginTest ("Tasks pushed from outside the pool all run");
+        {
+            ThreadPool pool (4);
+            std::atomic<int> counter { 0 };
+            const int numTasks = 5000;
+
+            for (int i = 0; i < numTasks; ++i)
+                pool.addTask ([&counter] { ++counter; });
+
+            expect (waitFor ([&] { return counter.load() == numTasks; }));
+        }
+
+        beginTest ("A pool thread services its own deque newest-first");
+        {
+            // Block the only pool thread, queue a recognisable sequence onto
+            // its deque, then let it drain: with nobody to steal, the owner
+            // should run the tasks in LIFO order.
+            ThreadPool pool (1);
+            WaitableEvent blockerStarted, unblock;
+            CriticalSection orderLock;
+            Array<int> order;
+            std::atomic<int> numRun { 0 };
+
+            pool.addTask ([&] { blockerStarted.signal(); unblock.wait(); });
+            blockerStarted.wait();
+
+            const int numTasks = 10;
+
+            for (int i = 0; i < numTasks; ++i)
+            {
+                pool.addTask ([&, i]
+                {
+                    const ScopedLock sl (orderLock);
+                    order.add (i);
+                    ++numRun;
+                });
+            }
+
+            unblock.signal();
+            expect (waitFor ([&] { return numRun.load() == numTasks; }));
+
+            for (int i = 0; i < numTasks; ++i)
+                expectEquals (order[i], numTasks - 1 - i);
+        }
+
+        beginTest ("Thieves steal from the oldest end of a deque");
+        {
+            // Block the only pool thread so its deque can't be drained by its
+            // owner, then call parallelInvoke from this (external) thread: while
+            // waiting for its forked task it steals the queued tasks, which
+            // should arrive oldest-first.
+            ThreadPool pool (1);
+            WaitableEvent blockerStarted, unblock;
+            CriticalSection orderLock;
+            Array<int> order;
+
+            pool.addTask ([&] { blockerStarted.signal(); unblock.wait(); });
+            blockerStarted.wait();
+
+            const int numTasks = 10;
+
+            for (int i = 0; i < numTasks; ++i)
+            {
+                pool.addTask ([&, i]
+                {
+                    const ScopedLock sl (orderLock);
+                    order.add (i);
+                });
+            }
+
+            bool task1Run = false, task2Run = false;
+            pool.parallelInvoke ([&task1Run] { task1Run = true; },
+                                 [&task2Run] { task2Run = true; });
+
+            expect (task1Run && task2Run);
+            expectEquals (order.size(), numTasks);
+
+            for (int i = 0; i < numTasks; ++i)
+                expectEquals (order[i], i);
+
+            unblock.signal();
+        }
+
+        beginTest ("Tasks queued on a blocked thread are stolen and still run");
+        {
+            ThreadPool pool (2);
+            WaitableEvent unblock;
+            std::atomic<int> counter { 0 };
+            const int numTasks = 1000;
+
+            pool.addTask ([&unblock] { unblock.wait(); });
+
+            for (int i = 0; i < numTasks; ++i)
+                pool.addTask ([&counter] { ++counter; });
+
+            // Round-robin pushing puts half of these on the blocked thread's
+            // deque, so they can only complete if the other thread steals them.
+            expect (waitFor ([&] { return counter.load() == numTasks; }));
+            unblock.signal();
+        }
+
+        beginTest ("parallelInvoke can be nested recursively");
+        {
+            ThreadPool pool (4);
+
+            std::function<int64 (int, int)> parallelSum = [&] (int start, int end) -> int64
+            {
+                if (end - start <= 64)
+                {
+                    int64 total = 0;
+
+                    for (int i = start; i < end; ++i)
+                        total += i;
+
+                    return total;
+                }
+
+                auto mid = (start + end) / 2;
+                int64 low = 0, high = 0;
+
+                pool.parallelInvoke ([&] { low  = parallelSum (start, mid); },
+                                     [&] { high = parallelSum (mid, end); });
+
+                return low + high;
+            };
+
+            const int n = 100000;
+            expect (parallelSum (0, n) == (int64) n * (n - 1) / 2);
+        }
+
+        beginTest ("Deleting the pool discards pending tasks without running them on dead threads");
+        {
+            std::atomic<int> counter { 0 };
+            const int numTasks = 500;
+
+            {
+                ThreadPool pool (2);
+
+                for (int i = 0; i < numTasks; ++i)
+                    pool.addTask ([&counter] { ++counter; Thread::sleep (1); });
+            }
+
+            // Whatever ran, ran to completion before the threads stopped; the
+            // rest were discarded. Either way the count must never move again.
+            auto countAtExit = counter.load();
+            Thread::sleep (50);
+            expectEquals (counter.load(), countAtExit);
+            expect (countAtExit <= numTasks);
+        }
+    }
+};
+
+static ThreadPoolTests threadPoolTests;
+
+#endif
+
 } // namespace juce
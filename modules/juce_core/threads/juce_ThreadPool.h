@@ -164,8 +164,13 @@ public:
         @param threadStackSize  the size of the stack of each thread. If this value
                                 is zero then the default stack size of the OS will
                                 be used.
+        @param threadAffinityMask  if non-zero, each worker thread will have its
+                                affinity set to this mask. Pass
+                                SystemStats::getPerformanceCoreAffinityMask() to
+                                keep the workers off the efficiency cores of a
+                                hybrid CPU. @see Thread::setAffinityMask
     */
-    ThreadPool (int numberOfThreads, size_t threadStackSize = 0);
+    ThreadPool (int numberOfThreads, size_t threadStackSize = 0, uint32 threadAffinityMask = 0);
 
     /** Creates a thread pool with one thread per CPU core.
         Once you've created a pool, you can give it some jobs by calling addJob().
@@ -223,12 +228,12 @@ public:
     /** Adds a lambda function to be called as a job.
         This will create an internal ThreadPoolJob object to encapsulate and call the lambda.
     */
-    void addJob (std::function<ThreadPoolJob::JobStatus()> job);
+    void addJob (MoveOnlyFunction<ThreadPoolJob::JobStatus()> job);
 
     /** Adds a lambda function to be called as a job.
         This will create an internal ThreadPoolJob object to encapsulate and call the lambda.
     */
-    void addJob (std::function<void()> job);
+    void addJob (MoveOnlyFunction<void()> job);
 
     /** Tries to remove a job from the pool.
 
@@ -315,6 +320,43 @@ public:
     */
     bool setThreadPriorities (int newPriority);
 
+    //==============================================================================
+    /** A lightweight unit of work for the pool's work-stealing scheduler.
+        @see addTask, parallelInvoke
+    */
+    using Task = std::function<void()>;
+
+    /** Adds a lightweight task to the pool's work-stealing scheduler.
+
+        Unlike addJob(), tasks don't go through the shared job queue and its
+        lock: each pool thread keeps its own deque of tasks, and idle threads
+        steal from the other threads' deques. This makes tasks much cheaper
+        than jobs for very fine-grained work, at the cost of the job queue's
+        management facilities - a task can't be removed, interrupted or waited
+        for once it has been added.
+
+        When called from inside one of this pool's threads, the task is pushed
+        onto that thread's own deque, which is the cheap path to use when
+        recursively splitting up a larger piece of work.
+
+        Tasks that are still queued when the pool is deleted are discarded
+        without being run.
+    */
+    void addTask (Task task);
+
+    /** Runs two tasks, potentially in parallel, and returns when both have
+        completed.
+
+        The second task is made available to the pool's work-stealing
+        scheduler and the first is run on the calling thread, so this can be
+        called recursively from inside tasks to fork off arbitrarily
+        fine-grained work. While waiting for the second task to complete, the
+        calling thread runs other queued tasks rather than blocking, so nested
+        forks can't starve the pool.
+
+        This may be called from threads that don't belong to the pool.
+    */
+    void parallelInvoke (Task task1, Task task2);
 
 private:
     //==============================================================================
@@ -326,11 +368,16 @@ private:
 
     CriticalSection lock;
     WaitableEvent jobFinishedSignal;
+    std::atomic<uint32> nextTaskPushIndex { 0 };
 
     bool runNextJob (ThreadPoolThread&);
+    bool runNextTask (ThreadPoolThread*);
+    Task stealTaskFromAnotherThread (ThreadPoolThread* threadToExclude);
+    ThreadPoolThread* getCurrentPoolThread() const;
+    void pushTaskToAnyThread (Task&&);
     ThreadPoolJob* pickNextJobToRun();
     void addToDeleteList (OwnedArray<ThreadPoolJob>&, ThreadPoolJob*) const;
-    void createThreads (int numThreads, size_t threadStackSize = 0);
+    void createThreads (int numThreads, size_t threadStackSize = 0, uint32 threadAffinityMask = 0);
     void stopThreads();
 
     // Note that this method has changed, and no longer has a parameter to indicate
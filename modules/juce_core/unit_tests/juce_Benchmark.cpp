@@ -0,0 +1,235 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+Benchmark::Benchmark (const String& nm, const String& ctg)
+    : name (nm), category (ctg)
+{
+    getAllBenchmarks().add (this);
+}
+
+Benchmark::~Benchmark()
+{
+    getAllBenchmarks().removeFirstMatchingValue (this);
+}
+
+Array<Benchmark*>& Benchmark::getAllBenchmarks()
+{
+    static Array<Benchmark*> benchmarks;
+    return benchmarks;
+}
+
+Array<Benchmark*> Benchmark::getBenchmarksInCategory (const String& category)
+{
+    if (category.isEmpty())
+        return getAllBenchmarks();
+
+    Array<Benchmark*> benchmarks;
+
+    for (auto* benchmark : getAllBenchmarks())
+        if (benchmark->getCategory() == category)
+            benchmarks.add (benchmark);
+
+    return benchmarks;
+}
+
+StringArray Benchmark::getAllCategories()
+{
+    StringArray categories;
+
+    for (auto* benchmark : getAllBenchmarks())
+        if (benchmark->getCategory().isNotEmpty())
+            categories.addIfNotAlreadyThere (benchmark->getCategory());
+
+    return categories;
+}
+
+void Benchmark::initialise()  {}
+void Benchmark::shutdown()   {}
+
+void Benchmark::performBenchmark (BenchmarkRunner* const newRunner)
+{
+    jassert (newRunner != nullptr);
+    runner = newRunner;
+
+    initialise();
+    runBenchmark();
+    shutdown();
+}
+
+void Benchmark::logMessage (const String& message)
+{
+    // This method's only valid while the benchmark is being run!
+    jassert (runner != nullptr);
+
+    runner->logMessage (message);
+}
+
+void Benchmark::addResult (const String& sectionName, int numWarmupIterations,
+                           Array<double>& secondsPerIteration)
+{
+    // This method's only valid while the benchmark is being run!
+    jassert (runner != nullptr);
+
+    const auto numIterations = secondsPerIteration.size();
+
+    if (numIterations == 0)
+        return;
+
+    std::sort (secondsPerIteration.begin(), secondsPerIteration.end());
+
+    BenchmarkRunner::BenchmarkResult r;
+    r.benchmarkName       = name;
+    r.sectionName         = sectionName;
+    r.numIterations       = numIterations;
+    r.numWarmupIterations = numWarmupIterations;
+
+    r.minimumSeconds = secondsPerIteration.getFirst();
+
+    r.medianSeconds = (numIterations & 1) != 0
+                        ? secondsPerIteration[numIterations / 2]
+                        : (secondsPerIteration[numIterations / 2 - 1]
+                            + secondsPerIteration[numIterations / 2]) * 0.5;
+
+    r.percentile99Seconds = secondsPerIteration[jlimit (0, numIterations - 1,
+                                                        (int) std::ceil (0.99 * numIterations) - 1)];
+
+    for (auto seconds : secondsPerIteration)
+        r.totalSeconds += seconds;
+
+    r.meanSeconds = r.totalSeconds / numIterations;
+
+    runner->addResult (r);
+}
+
+//==============================================================================
+BenchmarkRunner::BenchmarkRunner() {}
+BenchmarkRunner::~BenchmarkRunner() {}
+
+int BenchmarkRunner::getNumResults() const noexcept
+{
+    return results.size();
+}
+
+const BenchmarkRunner::BenchmarkResult* BenchmarkRunner::getResult (int index) const noexcept
+{
+    return results [index];
+}
+
+String BenchmarkRunner::getResultsAsJSON() const
+{
+    Array<var> resultList;
+
+    const ScopedLock sl (results.getLock());
+
+    for (auto* r : results)
+    {
+        auto* obj = new DynamicObject();
+
+        obj->setProperty ("benchmark",           r->benchmarkName);
+        obj->setProperty ("section",             r->sectionName);
+        obj->setProperty ("iterations",          r->numIterations);
+        obj->setProperty ("warmupIterations",    r->numWarmupIterations);
+        obj->setProperty ("minimumSeconds",      r->minimumSeconds);
+        obj->setProperty ("medianSeconds",       r->medianSeconds);
+        obj->setProperty ("meanSeconds",         r->meanSeconds);
+        obj->setProperty ("percentile99Seconds", r->percentile99Seconds);
+        obj->setProperty ("totalSeconds",        r->totalSeconds);
+
+        resultList.add (var (obj));
+    }
+
+    return JSON::toString (var (resultList));
+}
+
+void BenchmarkRunner::resultsUpdated()
+{
+}
+
+void BenchmarkRunner::runBenchmarks (const Array<Benchmark*>& benchmarks)
+{
+    results.clear();
+    resultsUpdated();
+
+    for (auto* b : benchmarks)
+    {
+        if (shouldAbortBenchmarks())
+            break;
+
+        logMessage ("-----------------------------------------------------------------");
+        logMessage ("Starting benchmark: " + b->getName() + "...");
+
+       #if JUCE_EXCEPTIONS_DISABLED
+        b->performBenchmark (this);
+       #else
+        try
+        {
+            b->performBenchmark (this);
+        }
+        catch (...)
+        {
+            logMessage ("!!! Benchmark " + b->getName() + " threw an unhandled exception!");
+        }
+       #endif
+    }
+}
+
+void BenchmarkRunner::runAllBenchmarks()
+{
+    runBenchmarks (Benchmark::getAllBenchmarks());
+}
+
+void BenchmarkRunner::runBenchmarksInCategory (const String& category)
+{
+    runBenchmarks (Benchmark::getBenchmarksInCategory (category));
+}
+
+void BenchmarkRunner::logMessage (const String& message)
+{
+    Logger::writeToLog (message);
+}
+
+bool BenchmarkRunner::shouldAbortBenchmarks()
+{
+    return false;
+}
+
+void BenchmarkRunner::addResult (const BenchmarkResult& result)
+{
+    {
+        const ScopedLock sl (results.getLock());
+        results.add (new BenchmarkResult (result));
+    }
+
+    String m (result.benchmarkName + " / " + result.sectionName + ": ");
+    m << "median " << String (result.medianSeconds * 1000.0, 6) << " ms, "
+      << "p99 "    << String (result.percentile99Seconds * 1000.0, 6) << " ms, "
+      << "min "    << String (result.minimumSeconds * 1000.0, 6) << " ms "
+      << "(" << result.numIterations << " iterations)";
+
+    logMessage (m);
+    resultsUpdated();
+}
+
+} // namespace juce
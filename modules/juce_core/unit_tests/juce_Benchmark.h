@@ -0,0 +1,312 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class BenchmarkRunner;
+
+
+//==============================================================================
+/**
+    This is a base class for classes that measure the performance of a piece of code.
+
+    It's the benchmarking counterpart of UnitTest: each subclass times one or more
+    sections of code, and the results are gathered and reported by a BenchmarkRunner.
+
+    To write a benchmark using this class, your code should look something like this:
+
+    @code
+    class MyBenchmark  : public Benchmark
+    {
+    public:
+        MyBenchmark()  : Benchmark ("Foobar benchmarking") {}
+
+        void runBenchmark() override
+        {
+            measure ("fast path", [&] { myFoobar.doSomething(); });
+
+            // ..or with explicit control over the iteration counts:
+            measure ("slow path", 500, 50, [&] { myFoobar.doSomethingElse(); });
+        }
+    };
+
+    // Creating a static instance will automatically add the instance to the array
+    // returned by Benchmark::getAllBenchmarks(), so the benchmark will be included
+    // when you call BenchmarkRunner::runAllBenchmarks()
+    static MyBenchmark benchmark;
+    @endcode
+
+    To run a benchmark, use the BenchmarkRunner class.
+
+    @see BenchmarkRunner, UnitTest
+
+    @tags{Core}
+*/
+class JUCE_API  Benchmark
+{
+public:
+    //==============================================================================
+    /** Creates a benchmark with the given name and optionally places it in a category. */
+    explicit Benchmark (const String& name, const String& category = String());
+
+    /** Destructor. */
+    virtual ~Benchmark();
+
+    /** Returns the name of the benchmark. */
+    const String& getName() const noexcept       { return name; }
+
+    /** Returns the category of the benchmark. */
+    const String& getCategory() const noexcept   { return category; }
+
+    /** Runs the benchmark, using the specified BenchmarkRunner.
+        You shouldn't need to call this method directly - use
+        BenchmarkRunner::runBenchmarks() instead.
+    */
+    void performBenchmark (BenchmarkRunner* runner);
+
+    /** Returns the set of all Benchmark objects that currently exist. */
+    static Array<Benchmark*>& getAllBenchmarks();
+
+    /** Returns the set of Benchmarks in a specified category. */
+    static Array<Benchmark*> getBenchmarksInCategory (const String& category);
+
+    /** Returns a StringArray containing all of the categories of Benchmarks that have been registered. */
+    static StringArray getAllCategories();
+
+    //==============================================================================
+    /** You can optionally implement this method to set up your benchmark.
+        This method will be called before runBenchmark().
+    */
+    virtual void initialise();
+
+    /** You can optionally implement this method to clear up after your benchmark has been run.
+        This method will be called after runBenchmark() has returned.
+    */
+    virtual void shutdown();
+
+    /** Implement this method in your subclass to actually run your benchmark.
+
+        The content of your implementation should call measure() for each section
+        of code whose performance you want to record.
+    */
+    virtual void runBenchmark() = 0;
+
+    //==============================================================================
+    /** The number of timed iterations that measure() will perform if you don't
+        specify a count explicitly.
+    */
+    static constexpr int defaultNumIterations = 100;
+
+    /** The number of untimed warm-up iterations that measure() will perform if you
+        don't specify a count explicitly. Warming up gives caches, branch predictors
+        and CPU frequency scaling a chance to settle before any timing is done.
+    */
+    static constexpr int defaultNumWarmupIterations = 10;
+
+    /** Times a section of code, and logs the result.
+
+        This should be called from your runBenchmark() method, and may be called as
+        many times as you like, to measure different sections of code. The function
+        is first invoked defaultNumWarmupIterations times without being timed, and
+        then defaultNumIterations times with each invocation being timed individually
+        using the high-resolution clock, so that the spread of the timings can be
+        reported as well as their central tendency.
+    */
+    template <typename FunctionType>
+    void measure (const String& sectionName, FunctionType&& functionToMeasure)
+    {
+        measure (sectionName, defaultNumIterations, defaultNumWarmupIterations,
+                 std::forward<FunctionType> (functionToMeasure));
+    }
+
+    /** Times a section of code with explicit control over the number of timed and
+        warm-up iterations. Slow sections can use fewer iterations, and very fast
+        ones can use more to reduce the influence of timer granularity.
+    */
+    template <typename FunctionType>
+    void measure (const String& sectionName, int numIterations, int numWarmupIterations,
+                  FunctionType&& functionToMeasure)
+    {
+        // This method's only valid while the benchmark is being run!
+        jassert (runner != nullptr);
+        jassert (numIterations > 0 && numWarmupIterations >= 0);
+
+        for (int i = 0; i < numWarmupIterations; ++i)
+            functionToMeasure();
+
+        Array<double> secondsPerIteration;
+        secondsPerIteration.ensureStorageAllocated (numIterations);
+
+        for (int i = 0; i < numIterations; ++i)
+        {
+            const auto startTicks = Time::getHighResolutionTicks();
+            functionToMeasure();
+            const auto endTicks = Time::getHighResolutionTicks();
+
+            secondsPerIteration.add (Time::highResolutionTicksToSeconds (endTicks - startTicks));
+        }
+
+        addResult (sectionName, numWarmupIterations, secondsPerIteration);
+    }
+
+    //==============================================================================
+    /** Writes a message to the benchmark log.
+        This can only be called from within your runBenchmark() method.
+    */
+    void logMessage (const String& message);
+
+private:
+    //==============================================================================
+    void addResult (const String& sectionName, int numWarmupIterations,
+                    Array<double>& secondsPerIteration);
+
+    //==============================================================================
+    const String name, category;
+    BenchmarkRunner* runner = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE (Benchmark)
+};
+
+
+//==============================================================================
+/**
+    Runs a set of benchmarks.
+
+    You can instantiate one of these objects and use it to invoke a set of Benchmark
+    objects, then collect the timing statistics that they produce, either
+    programmatically via getResult() or as a JSON document that can be archived and
+    compared across runs to catch performance regressions.
+
+    By using a subclass of BenchmarkRunner, you can intercept logging messages and
+    perform custom behaviour when each result arrives.
+
+    @see Benchmark
+
+    @tags{Core}
+*/
+class JUCE_API  BenchmarkRunner
+{
+public:
+    //==============================================================================
+    /** */
+    BenchmarkRunner();
+
+    /** Destructor. */
+    virtual ~BenchmarkRunner();
+
+    /** Runs a set of benchmarks.
+
+        The benchmarks are performed in order, and the results are logged. To run all
+        the registered Benchmark objects that exist, use runAllBenchmarks().
+    */
+    void runBenchmarks (const Array<Benchmark*>& benchmarks);
+
+    /** Runs all the Benchmark objects that currently exist.
+        This calls runBenchmarks() for all the objects listed in Benchmark::getAllBenchmarks().
+    */
+    void runAllBenchmarks();
+
+    /** Runs all the Benchmark objects within a specified category.
+        This calls runBenchmarks() for all the objects listed in
+        Benchmark::getBenchmarksInCategory().
+    */
+    void runBenchmarksInCategory (const String& category);
+
+    //==============================================================================
+    /** Contains the timing statistics for one measured section.
+
+        One of these objects is created each time Benchmark::measure() is called, and
+        it summarises the distribution of the individual iteration timings.
+    */
+    struct BenchmarkResult
+    {
+        /** The main name of this benchmark (i.e. the name of the Benchmark object being run). */
+        String benchmarkName;
+        /** The name of the section that was passed to Benchmark::measure(). */
+        String sectionName;
+
+        /** The number of timed iterations that were performed. */
+        int numIterations = 0;
+        /** The number of untimed warm-up iterations that were performed. */
+        int numWarmupIterations = 0;
+
+        /** The fastest single iteration, in seconds. */
+        double minimumSeconds = 0;
+        /** The median iteration time, in seconds. */
+        double medianSeconds = 0;
+        /** The mean iteration time, in seconds. */
+        double meanSeconds = 0;
+        /** The 99th-percentile iteration time, in seconds. */
+        double percentile99Seconds = 0;
+        /** The total time spent in timed iterations, in seconds. */
+        double totalSeconds = 0;
+    };
+
+    /** Returns the number of BenchmarkResult objects that have been gathered.
+        @see getResult
+    */
+    int getNumResults() const noexcept;
+
+    /** Returns one of the BenchmarkResult objects that describes a section that has been measured.
+        @see getNumResults
+    */
+    const BenchmarkResult* getResult (int index) const noexcept;
+
+    /** Returns all the results gathered so far as a JSON document.
+
+        The document is an array with one object per measured section, containing the
+        same fields as BenchmarkResult - handy for archiving results from a CI run so
+        that they can be compared against a baseline.
+    */
+    String getResultsAsJSON() const;
+
+protected:
+    //==============================================================================
+    /** Called when the list of results changes.
+        You can override this to perform some sort of behaviour when results are added.
+    */
+    virtual void resultsUpdated();
+
+    /** Logs a message about the current benchmark progress.
+        By default this just writes the message to the Logger class, but you could override
+        this to do something else with the data.
+    */
+    virtual void logMessage (const String& message);
+
+    /** This can be overridden to let the runner know that it should abort the benchmarks
+        as soon as possible, e.g. because the thread needs to stop.
+    */
+    virtual bool shouldAbortBenchmarks();
+
+private:
+    //==============================================================================
+    friend class Benchmark;
+
+    OwnedArray<BenchmarkResult, CriticalSection> results;
+
+    void addResult (const BenchmarkResult&);
+
+    JUCE_DECLARE_NON_COPYABLE (BenchmarkRunner)
+};
+
+} // namespace juce
@@ -68,6 +68,8 @@ StringArray UnitTest::getAllCategories()
 void UnitTest::initialise()  {}
 void UnitTest::shutdown()   {}
 
+bool UnitTest::isRunnableInParallel() const     { return false; }
+
 void UnitTest::performTest (UnitTestRunner* const newRunner)
 {
     jassert (newRunner != nullptr);
@@ -157,21 +159,137 @@ void UnitTestRunner::runTests (const Array<UnitTest*>& tests, int64 randomSeed)
         if (shouldAbortTests())
             break;
 
-       #if JUCE_EXCEPTIONS_DISABLED
+        runTestOnCurrentThread (t);
+    }
+
+    endTest();
+}
+
+void UnitTestRunner::runTestOnCurrentThread (UnitTest* t)
+{
+   #if JUCE_EXCEPTIONS_DISABLED
+    t->performTest (this);
+   #else
+    try
+    {
         t->performTest (this);
-       #else
-        try
+    }
+    catch (...)
+    {
+        addFail ("An unhandled exception was thrown!");
+    }
+   #endif
+}
+
+void UnitTestRunner::runTestsInParallel (const Array<UnitTest*>& tests, int numberOfThreads, int64 randomSeed)
+{
+    results.clear();
+    resultsUpdated();
+
+    if (randomSeed == 0)
+        randomSeed = Random().nextInt (0x7ffffff);
+
+    randomForTest = Random (randomSeed);
+    logMessage ("Random seed: 0x" + String::toHexString (randomSeed));
+
+    // Each parallel test gets a private runner, so results and log lines
+    // can't interleave - everything is merged back in the original order
+    struct BufferedRunner  : public UnitTestRunner
+    {
+        explicit BufferedRunner (UnitTestRunner& ownerToUse)  : owner (ownerToUse)
         {
-            t->performTest (this);
+            setAssertOnFailure (owner.assertOnFailure);
+            setPassesAreLogged (owner.logPasses);
         }
-        catch (...)
+
+        void logMessage (const String& m) override      { bufferedLog.add (m); }
+        bool shouldAbortTests() override                { return owner.shouldAbortTests(); }
+
+        UnitTestRunner& owner;
+        StringArray bufferedLog;
+    };
+
+    Array<UnitTest*> parallelTests, serialTests;
+
+    for (auto* t : tests)
+        (t->isRunnableInParallel() ? parallelTests : serialTests).add (t);
+
+    auto startTicks = Time::getMillisecondCounterHiRes();
+    auto numThreadsToUse = jlimit (1, jmax (1, parallelTests.size()),
+                                   numberOfThreads > 0 ? numberOfThreads
+                                                       : SystemStats::getNumCpus());
+
+    if (! parallelTests.isEmpty())
+    {
+        OwnedArray<BufferedRunner> subRunners;
+
+        for (int i = 0; i < parallelTests.size(); ++i)
+            subRunners.add (new BufferedRunner (*this));
+
+        {
+            ThreadPool pool (numThreadsToUse);
+
+            for (int i = 0; i < parallelTests.size(); ++i)
+            {
+                auto* sub = subRunners.getUnchecked (i);
+                auto* test = parallelTests.getUnchecked (i);
+
+                pool.addJob ([sub, test, randomSeed]
+                {
+                    sub->randomForTest = Random (randomSeed);
+                    sub->runTestOnCurrentThread (test);
+                    sub->endTest();
+                });
+            }
+
+            while (pool.getNumJobs() > 0)
+                Thread::sleep (2);
+        }
+
+        for (int i = 0; i < parallelTests.size(); ++i)
         {
-            addFail ("An unhandled exception was thrown!");
+            auto* sub = subRunners.getUnchecked (i);
+
+            for (auto& line : sub->bufferedLog)
+                logMessage (line);
+
+            double elapsedMs = 0;
+
+            {
+                const ScopedLock sl (results.getLock());
+
+                for (int j = 0; j < sub->getNumResults(); ++j)
+                {
+                    auto* r = sub->getResult (j);
+                    elapsedMs += (r->endTime - r->startTime).inMilliseconds();
+                    results.add (new TestResult (*r));
+                }
+            }
+
+            logMessage (parallelTests.getUnchecked (i)->getName()
+                          + " took " + String (elapsedMs, 1) + " ms");
+            resultsUpdated();
         }
-       #endif
+    }
+
+    for (auto* t : serialTests)
+    {
+        if (shouldAbortTests())
+            break;
+
+        auto testStart = Time::getMillisecondCounterHiRes();
+        runTestOnCurrentThread (t);
+
+        logMessage (t->getName() + " took "
+                      + String (Time::getMillisecondCounterHiRes() - testStart, 1) + " ms");
     }
 
     endTest();
+
+    logMessage ("Ran " + String (tests.size()) + " tests ("
+                  + String (parallelTests.size()) + " in parallel on "
+                  + String (numThreadsToUse) + (numThreadsToUse == 1 ? " thread" : " threads")
+                  + ") in " + String (Time::getMillisecondCounterHiRes() - startTicks, 1) + " ms");
 }
 
 void UnitTestRunner::runAllTests (int64 randomSeed)
@@ -278,4 +396,87 @@ void UnitTestRunner::addFail (const String& failureMessage)
     if (assertOnFailure) { jassertfalse; }
 }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+// Tiny self-contained tests used below to exercise the parallel runner;
+// they also run (and trivially pass) as part of a normal suite run.
+struct ParallelRunnerDummyTest  : public UnitTest
+{
+    ParallelRunnerDummyTest (const String& name, int numPassesToLog, bool parallel)
+        : UnitTest (name, UnitTestCategories::threads),
+          numPasses (numPassesToLog), runnableInParallel (parallel)
+    {}
+
+    bool isRunnableInParallel() const override   { return runnableInParallel; }
+
+    void runTest() override
+    {
+        beginTest ("counting");
+
+        for (int i = 0; i < numPasses; ++i)
+            expect (true);
+    }
+
+    const int numPasses;
+    const bool runnableInParallel;
+};
+
+static ParallelRunnerDummyTest parallelRunnerDummy1 { "UnitTestRunner dummy (parallel 1)", 3, true };
+static ParallelRunnerDummyTest parallelRunnerDummy2 { "UnitTestRunner dummy (parallel 2)", 5, true };
+static ParallelRunnerDummyTest parallelRunnerDummy3 { "UnitTestRunner dummy (serial)",     2, false };
+
+struct UnitTestRunnerTests  : public UnitTest
+{
+    UnitTestRunnerTests()  : UnitTest ("UnitTestRunner", UnitTestCategories::threads) {}
+
+    struct QuietRunner  : public UnitTestRunner
+    {
+        void logMessage (const String&) override {}
+    };
+
+    void checkResults (const QuietRunner& runner)
+    {
+        expectEquals (runner.getNumResults(), 3);
+
+        expectEquals (runner.getResult (0)->unitTestName, parallelRunnerDummy1.getName());
+        expectEquals (runner.getResult (1)->unitTestName, parallelRunnerDummy2.getName());
+        expectEquals (runner.getResult (2)->unitTestName, parallelRunnerDummy3.getName());
+
+        expectEquals (runner.getResult (0)->passes, 3);
+        expectEquals (runner.getResult (1)->passes, 5);
+        expectEquals (runner.getResult (2)->passes, 2);
+
+        for (int i = 0; i < runner.getNumResults(); ++i)
+            expectEquals (runner.getResult (i)->failures, 0);
+    }
+
+    void runTest() override
+    {
+        Array<UnitTest*> testsToRun { &parallelRunnerDummy1, &parallelRunnerDummy2, &parallelRunnerDummy3 };
+
+        beginTest ("Parallel results come back in input order with correct counts");
+        {
+            QuietRunner runner;
+            runner.setAssertOnFailure (false);
+            runner.runTestsInParallel (testsToRun, 2, 42);
+            checkResults (runner);
+        }
+
+        beginTest ("A single worker thread gives identical results");
+        {
+            QuietRunner runner;
+            runner.setAssertOnFailure (false);
+            runner.runTestsInParallel (testsToRun, 1, 42);
+            checkResults (runner);
+        }
+    }
+};
+
+static UnitTestRunnerTests unitTestRunnerTests;
+
+#endif
+
 } // namespace juce
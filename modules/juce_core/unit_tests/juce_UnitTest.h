@@ -264,6 +264,16 @@ public:
     */
     void logMessage (const String& message);
 
+    /** Returns true if this test can safely run at the same time as other tests.
+
+        Tests which only touch their own local state can override this to
+        return true, which allows UnitTestRunner::runTestsInParallel() to
+        shard them across worker threads. Tests that use the message thread,
+        singletons, or any other shared state should leave it returning
+        false, and will be run serially.
+    */
+    virtual bool isRunnableInParallel() const;
+
     /** Returns a shared RNG that all unit tests should use.
         If a test needs random numbers, it's important that when an error is found, the
         exact circumstances can be re-created in order to re-test the problem, by
@@ -357,6 +367,24 @@ public:
     */
     void runTestsInCategory (const String& category, int64 randomSeed = 0);
 
+    /** Runs a set of tests, sharding the thread-safe ones across a pool of
+        worker threads.
+
+        Tests whose UnitTest::isRunnableInParallel() returns true are run
+        concurrently, each with its own private sub-runner so their results
+        and log output don't interleave; everything else then runs serially
+        on the calling thread, exactly as runTests() would. The aggregated
+        results appear through getResult() in the same order as the tests
+        were passed in, and a per-test timing line is logged for each one.
+
+        @param tests            the tests to run
+        @param numberOfThreads  how many worker threads to use, or 0 to use
+                                one per CPU core
+        @param randomSeed       as for runTests(); every test sees the same
+                                seed so failures stay reproducible
+    */
+    void runTestsInParallel (const Array<UnitTest*>& tests, int numberOfThreads = 0, int64 randomSeed = 0);
+
     /** Sets a flag to indicate whether an assertion should be triggered if a test fails.
         This is true by default.
     */
@@ -442,6 +470,7 @@ private:
 
     void beginNewTest (UnitTest* test, const String& subCategory);
     void endTest();
+    void runTestOnCurrentThread (UnitTest*);
 
     void addPass();
     void addFail (const String& failureMessage);
@@ -0,0 +1,714 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct XmlStreamParserState
+{
+    XmlStreamParserState (InputStream& in, XmlStreamParser::Handler& h)
+        : input (in), handler (h)
+    {
+    }
+
+    //==============================================================================
+    bool parseDocument()
+    {
+        if (! checkByteOrderMark())
+            return false;
+
+        // prolog: whitespace, comments, processing instructions and an optional doctype
+        for (;;)
+        {
+            skipWhitespace();
+            auto c = peekByte();
+
+            if (c < 0)
+                return setError ("no root element found");
+
+            if (c != '<')
+                return setError ("illegal characters found outside the root element");
+
+            readByte();
+            c = peekByte();
+
+            if (c == '?')
+            {
+                if (! skipProcessingInstruction())
+                    return false;
+            }
+            else if (c == '!')
+            {
+                if (! skipCommentOrDoctype())
+                    return false;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        if (! parseRootElement())
+            return false;
+
+        if (! handlerWantsToContinue)
+            return true;
+
+        // epilog: only whitespace, comments and processing instructions may follow the root
+        for (;;)
+        {
+            skipWhitespace();
+
+            if (peekByte() < 0)
+                return true;
+
+            if (readByte() != '<')
+                return setError ("illegal characters found outside the root element");
+
+            auto c = peekByte();
+
+            if (c == '?')
+            {
+                if (! skipProcessingInstruction())
+                    return false;
+            }
+            else if (c == '!')
+            {
+                if (! skipCommentOrDoctype())
+                    return false;
+            }
+            else
+            {
+                return setError ("expected a single root element");
+            }
+        }
+    }
+
+    String error;
+
+private:
+    //==============================================================================
+    InputStream& input;
+    XmlStreamParser::Handler& handler;
+    bool handlerWantsToContinue = true;
+
+    enum { bufferCapacity = 8192 };
+    HeapBlock<char> buffer { bufferCapacity };
+    int bufferPos = 0, bufferLen = 0;
+    int lineNumber = 1;
+
+    MemoryOutputStream scratch;
+
+    //==============================================================================
+    bool ensureBuffered (int numBytes)
+    {
+        while (bufferLen - bufferPos < numBytes)
+        {
+            if (bufferPos > 0)
+            {
+                auto numRemaining = bufferLen - bufferPos;
+
+                if (numRemaining > 0)
+                    memmove (buffer, buffer + bufferPos, (size_t) numRemaining);
+
+                bufferLen = jmax (0, numRemaining);
+                bufferPos = 0;
+            }
+
+            auto numRead = input.read (buffer + bufferLen, bufferCapacity - bufferLen);
+
+            if (numRead <= 0)
+                return false;
+
+            bufferLen += numRead;
+        }
+
+        return true;
+    }
+
+    int peekByte()
+    {
+        if (! ensureBuffered (1))
+            return -1;
+
+        return (uint8) buffer[bufferPos];
+    }
+
+    int readByte()
+    {
+        auto c = peekByte();
+
+        if (c >= 0)
+        {
+            ++bufferPos;
+
+            if (c == '\n')
+                ++lineNumber;
+        }
+
+        return c;
+    }
+
+    bool skipIfMatches (const char* literal)
+    {
+        auto len = (int) strlen (literal);
+
+        if (! ensureBuffered (len))
+            return false;
+
+        if (memcmp (buffer + bufferPos, literal, (size_t) len) != 0)
+            return false;
+
+        for (int i = 0; i < len; ++i)
+            readByte();
+
+        return true;
+    }
+
+    // consumes everything up to and including the given literal, optionally
+    // collecting the skipped bytes in the scratch buffer
+    bool skipPast (const char* literal, bool collectInScratch)
+    {
+        for (;;)
+        {
+            if (skipIfMatches (literal))
+                return true;
+
+            auto c = readByte();
+
+            if (c < 0)
+                return false;
+
+            if (collectInScratch)
+                scratch.writeByte ((char) c);
+        }
+    }
+
+    static bool isWhitespaceByte (int c) noexcept
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    void skipWhitespace()
+    {
+        while (isWhitespaceByte (peekByte()))
+            readByte();
+    }
+
+    String stringFromScratch()
+    {
+        auto s = String::fromUTF8 (static_cast<const char*> (scratch.getData()), (int) scratch.getDataSize());
+        scratch.reset();
+        return s;
+    }
+
+    bool setError (String message)
+    {
+        if (error.isEmpty())
+            error = message + " (line " + String (lineNumber) + ")";
+
+        return false;
+    }
+
+    //==============================================================================
+    bool checkByteOrderMark()
+    {
+        auto c = peekByte();
+
+        if (c == 0xef)
+        {
+            if (! skipIfMatches ("\xef\xbb\xbf"))
+                return setError ("invalid byte-order mark");
+        }
+        else if (c == 0xfe || c == 0xff || c == 0)
+        {
+            return setError ("only UTF-8 input is supported by the streaming parser");
+        }
+
+        return true;
+    }
+
+    bool skipProcessingInstruction()
+    {
+        readByte(); // the '?'
+
+        if (! skipPast ("?>", false))
+            return setError ("unterminated processing instruction");
+
+        return true;
+    }
+
+    bool skipCommentOrDoctype()
+    {
+        readByte(); // the '!'
+
+        if (skipIfMatches ("--"))
+        {
+            if (! skipPast ("-->", false))
+                return setError ("unterminated comment");
+
+            return true;
+        }
+
+        // skip a DOCTYPE declaration, which may contain nested angle-brackets
+        for (int depth = 1; depth != 0;)
+        {
+            auto c = readByte();
+
+            if (c < 0)
+                return setError ("unterminated doctype declaration");
+
+            if (c == '<')       ++depth;
+            else if (c == '>')  --depth;
+        }
+
+        return true;
+    }
+
+    //==============================================================================
+    String readName()
+    {
+        for (;;)
+        {
+            auto c = peekByte();
+
+            if (c < 0 || isWhitespaceByte (c) || c == '/' || c == '>' || c == '=' || c == '<')
+                break;
+
+            scratch.writeByte ((char) readByte());
+        }
+
+        return stringFromScratch();
+    }
+
+    bool readEntityIntoScratch()
+    {
+        // (the '&' has already been consumed)
+        char entity[16] = {};
+
+        for (size_t i = 0; i < sizeof (entity); ++i)
+        {
+            auto c = readByte();
+
+            if (c < 0)
+                return setError ("unterminated entity");
+
+            if (c == ';')
+            {
+                String name (entity);
+
+                if      (name == "amp")   { scratch.writeByte ('&');  return true; }
+                else if (name == "lt")    { scratch.writeByte ('<');  return true; }
+                else if (name == "gt")    { scratch.writeByte ('>');  return true; }
+                else if (name == "quot")  { scratch.writeByte ('"');  return true; }
+                else if (name == "apos")  { scratch.writeByte ('\''); return true; }
+
+                if (entity[0] == '#')
+                {
+                    auto charCode = entity[1] == 'x' || entity[1] == 'X'
+                                      ? name.substring (2).getHexValue32()
+                                      : name.substring (1).getIntValue();
+
+                    if (charCode > 0)
+                    {
+                        writeCharToScratch ((juce_wchar) charCode);
+                        return true;
+                    }
+                }
+
+                return setError ("unknown or invalid entity: &" + name + ";");
+            }
+
+            entity[i] = (char) c;
+        }
+
+        return setError ("unterminated entity");
+    }
+
+    void writeCharToScratch (juce_wchar c)
+    {
+        char utf8[8];
+        CharPointer_UTF8 p (utf8);
+        p.write (c);
+        scratch.write (utf8, (size_t) (p.getAddress() - utf8));
+    }
+
+    //==============================================================================
+    bool emitText()
+    {
+        auto text = stringFromScratch();
+
+        if (text.isNotEmpty() && handlerWantsToContinue)
+            if (text.containsNonWhitespaceChars())
+                handlerWantsToContinue = handler.textRead (text);
+
+        return true;
+    }
+
+    bool parseRootElement()
+    {
+        // (the '<' of the root's start-tag has already been consumed)
+        Array<String> openTags;
+
+        if (! parseStartTag (openTags))
+            return false;
+
+        while (! openTags.isEmpty() && handlerWantsToContinue)
+            if (! parseContent (openTags))
+                return false;
+
+        return true;
+    }
+
+    // parses one item of element content: a run of text, a child element,
+    // a close-tag, a comment, a CDATA section or a processing instruction
+    bool parseContent (Array<String>& openTags)
+    {
+        // accumulate text up to the next tag
+        for (;;)
+        {
+            auto c = readByte();
+
+            if (c < 0)
+                return setError ("unmatched tags");
+
+            if (c == '<')
+                break;
+
+            if (c == '&')
+            {
+                if (! readEntityIntoScratch())
+                    return false;
+            }
+            else
+            {
+                scratch.writeByte ((char) c);
+            }
+        }
+
+        if (! emitText())
+            return false;
+
+        auto c = peekByte();
+
+        if (c == '/')
+        {
+            readByte();
+            auto name = readName();
+            skipWhitespace();
+
+            if (readByte() != '>')
+                return setError ("illegal character in close tag");
+
+            if (openTags.isEmpty() || openTags.getLast() != name)
+                return setError ("unmatched close tag: " + name);
+
+            openTags.removeLast();
+
+            if (handlerWantsToContinue)
+                handlerWantsToContinue = handler.elementEnded (name);
+
+            return true;
+        }
+
+        if (c == '!')
+        {
+            readByte();
+
+            if (skipIfMatches ("[CDATA["))
+            {
+                if (! skipPast ("]]>", true))
+                    return setError ("unterminated CDATA section");
+
+                auto text = stringFromScratch();
+
+                if (text.isNotEmpty() && handlerWantsToContinue)
+                    handlerWantsToContinue = handler.textRead (text);
+
+                return true;
+            }
+
+            if (skipIfMatches ("--"))
+            {
+                if (! skipPast ("-->", false))
+                    return setError ("unterminated comment");
+
+                return true;
+            }
+
+            return setError ("unexpected markup inside element content");
+        }
+
+        if (c == '?')
+            return skipProcessingInstruction();
+
+        return parseStartTag (openTags);
+    }
+
+    bool parseStartTag (Array<String>& openTags)
+    {
+        auto name = readName();
+
+        if (name.isEmpty())
+            return setError ("malformed tag name");
+
+        if (handlerWantsToContinue)
+            handlerWantsToContinue = handler.elementStarted (name);
+
+        for (;;)
+        {
+            skipWhitespace();
+            auto c = peekByte();
+
+            if (c < 0)
+                return setError ("unmatched tags");
+
+            if (c == '>')
+            {
+                readByte();
+                openTags.add (name);
+                return true;
+            }
+
+            if (c == '/')
+            {
+                readByte();
+
+                if (readByte() != '>')
+                    return setError ("expected '>' after '/' in tag");
+
+                if (handlerWantsToContinue)
+                    handlerWantsToContinue = handler.elementEnded (name);
+
+                return true;
+            }
+
+            if (! parseAttribute())
+                return false;
+        }
+    }
+
+    bool parseAttribute()
+    {
+        auto name = readName();
+
+        if (name.isEmpty())
+            return setError ("illegal character in tag");
+
+        skipWhitespace();
+
+        if (readByte() != '=')
+            return setError ("expected '=' after attribute name");
+
+        skipWhitespace();
+        auto quote = readByte();
+
+        if (quote != '"' && quote != '\'')
+            return setError ("expected a quoted attribute value");
+
+        for (;;)
+        {
+            auto c = readByte();
+
+            if (c < 0)
+                return setError ("unterminated attribute value");
+
+            if (c == quote)
+                break;
+
+            if (c == '&')
+            {
+                if (! readEntityIntoScratch())
+                    return false;
+            }
+            else
+            {
+                scratch.writeByte ((char) c);
+            }
+        }
+
+        auto value = stringFromScratch();
+
+        if (handlerWantsToContinue)
+            handlerWantsToContinue = handler.attributeRead (name, value);
+
+        return true;
+    }
+};
+
+Result XmlStreamParser::parse (InputStream& source, Handler& handler)
+{
+    XmlStreamParserState state (source, handler);
+
+    if (! state.parseDocument())
+        return Result::fail (state.error);
+
+    return Result::ok();
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class XmlStreamParserTests  : public UnitTest
+{
+public:
+    XmlStreamParserTests()
+        : UnitTest ("XmlStreamParser", UnitTestCategories::xml)
+    {}
+
+    // rebuilds an XmlElement tree from the stream events, for comparison with XmlDocument
+    struct TreeBuildingHandler  : public XmlStreamParser::Handler
+    {
+        bool elementStarted (const String& tagName) override
+        {
+            auto* e = new XmlElement (tagName);
+
+            if (stack.isEmpty())
+                root.reset (e);
+            else
+                stack.getLast()->addChildElement (e);
+
+            stack.add (e);
+            return true;
+        }
+
+        bool attributeRead (const String& name, const String& value) override
+        {
+            stack.getLast()->setAttribute (name, value);
+            return true;
+        }
+
+        bool elementEnded (const String&) override
+        {
+            stack.removeLast();
+            return true;
+        }
+
+        bool textRead (const String& text) override
+        {
+            stack.getLast()->addTextElement (text);
+            return true;
+        }
+
+        std::unique_ptr<XmlElement> root;
+        Array<XmlElement*> stack;
+    };
+
+    void expectParsesLikeXmlDocument (const String& doc)
+    {
+        TreeBuildingHandler builder;
+        MemoryInputStream in (doc.toRawUTF8(), doc.getNumBytesAsUTF8(), false);
+
+        expect (XmlStreamParser::parse (in, builder).wasOk());
+        expect (builder.root != nullptr);
+
+        auto reference = XmlDocument::parse (doc);
+        expect (reference != nullptr);
+        expect (builder.root->isEquivalentTo (reference.get(), false));
+    }
+
+    void expectParseFails (const String& doc)
+    {
+        XmlStreamParser::Handler ignoring;
+        MemoryInputStream in (doc.toRawUTF8(), doc.getNumBytesAsUTF8(), false);
+        expect (XmlStreamParser::parse (in, ignoring).failed());
+    }
+
+    void runTest() override
+    {
+        beginTest ("well-formed documents");
+        {
+            expectParsesLikeXmlDocument ("<a/>");
+            expectParsesLikeXmlDocument ("<a b=\"1\" c='2 &amp; 3'><d>text &lt;here&gt;</d><e/></a>");
+            expectParsesLikeXmlDocument ("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                                         "<!DOCTYPE thing [<!ENTITY x \"y\">]>\n"
+                                         "<root><!-- a comment --><child attr=\"&#65;&#x42;\"/>\n"
+                                         "<child2><![CDATA[raw <junk> & more]]></child2></root>\n"
+                                         "<!-- trailing comment -->");
+            expectParsesLikeXmlDocument (String::fromUTF8 ("<r a=\"caf\xc3\xa9\"><t>d\xc3\xa9j\xc3\xa0 vu</t></r>"));
+        }
+
+        beginTest ("malformed documents");
+        {
+            expectParseFails ("");
+            expectParseFails ("<a>");
+            expectParseFails ("<a></b>");
+            expectParseFails ("<a/><b/>");
+            expectParseFails ("<a x=1/>");
+            expectParseFails ("<a x=\"&bogus;\"/>");
+            expectParseFails ("<a><!-- unterminated ->");
+        }
+
+        beginTest ("stopping from a callback");
+        {
+            struct CountingHandler  : public XmlStreamParser::Handler
+            {
+                bool elementStarted (const String&) override   { return ++numElements < 3; }
+                int numElements = 0;
+            };
+
+            CountingHandler counter;
+            const char* doc = "<a><b/><c/><d/><e/></a>";
+            MemoryInputStream in (doc, strlen (doc), false);
+
+            expect (XmlStreamParser::parse (in, counter).wasOk());
+            expectEquals (counter.numElements, 3);
+        }
+
+        beginTest ("randomised round-trip");
+        {
+            auto r = getRandom();
+
+            for (int i = 10; --i >= 0;)
+            {
+                auto tree = createRandomElement (r, 0);
+                expectParsesLikeXmlDocument (tree->toString());
+            }
+        }
+    }
+
+    std::unique_ptr<XmlElement> createRandomElement (Random& r, int depth)
+    {
+        auto e = std::make_unique<XmlElement> ("e" + String (r.nextInt (100)));
+
+        for (int i = r.nextInt (4); --i >= 0;)
+            e->setAttribute ("a" + String (r.nextInt (10)), "v<&>\"' " + String (r.nextInt()));
+
+        for (int i = r.nextInt (depth < 4 ? 5 : 1); --i >= 0;)
+        {
+            if (r.nextBool())
+                e->addChildElement (createRandomElement (r, depth + 1).release());
+            else
+                e->addTextElement ("text & more " + String (r.nextInt()));
+        }
+
+        return e;
+    }
+};
+
+static XmlStreamParserTests xmlStreamParserTests;
+
+#endif
+
+} // namespace juce
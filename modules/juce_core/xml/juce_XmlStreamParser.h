@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A streaming, SAX-style XML parser.
+
+    Unlike XmlDocument, which materialises a whole XmlElement tree, this reads
+    an XML document from an InputStream in fixed-size chunks and emits a
+    callback for each element, attribute and piece of text it encounters, so
+    arbitrarily large documents can be processed with constant memory.
+
+    To use it, subclass XmlStreamParser::Handler, override the callbacks you
+    care about, and pass it to parse(). Any callback can return false to stop
+    parsing early without an error.
+
+    Note that the input must be UTF-8 (with or without a byte-order mark).
+    For other encodings, or when you actually want a tree, use XmlDocument.
+
+    @see XmlDocument, XmlElement
+
+    @tags{Core}
+*/
+class JUCE_API  XmlStreamParser
+{
+public:
+    //==============================================================================
+    /** Receives the events emitted by XmlStreamParser::parse().
+
+        The default implementations all just return true, so a subclass only
+        needs to override the callbacks it's interested in.
+    */
+    struct JUCE_API  Handler
+    {
+        virtual ~Handler() = default;
+
+        /** Called when an element's opening tag has been parsed.
+            Any attributeRead() callbacks for this element will arrive immediately
+            after this, before any of the element's content.
+            Return false to stop parsing.
+        */
+        virtual bool elementStarted (const String& tagName)                     { ignoreUnused (tagName); return true; }
+
+        /** Called once for each attribute of the element that has just started.
+            Return false to stop parsing.
+        */
+        virtual bool attributeRead (const String& name, const String& value)    { ignoreUnused (name, value); return true; }
+
+        /** Called when an element's closing tag has been parsed (or immediately
+            after elementStarted() and its attributes, for self-closing tags).
+            Return false to stop parsing.
+        */
+        virtual bool elementEnded (const String& tagName)                       { ignoreUnused (tagName); return true; }
+
+        /** Called for each run of text content inside an element, with entities
+            already decoded. Whitespace-only runs are skipped, but text is
+            otherwise passed through untrimmed. CDATA sections also arrive here.
+            Return false to stop parsing.
+        */
+        virtual bool textRead (const String& text)                              { ignoreUnused (text); return true; }
+    };
+
+    //==============================================================================
+    /** Parses a complete XML document from a stream, emitting events to the
+        given handler as it goes.
+
+        Returns Result::ok() if the document was well-formed (or if a handler
+        callback deliberately stopped the parse), or a failure result describing
+        the first syntax error found.
+    */
+    static Result parse (InputStream& source, Handler& handler);
+};
+
+} // namespace juce
@@ -23,23 +23,96 @@
 namespace juce
 {
 
+//==============================================================================
+/*  Deflate states that have finished with their stream are parked here rather than
+    being torn down, so that the next compressor with the same window size can reuse
+    their internal buffers via deflateReset() instead of re-running deflateInit2().
+*/
+class DeflateStatePool
+{
+public:
+    ~DeflateStatePool()
+    {
+        for (auto& s : states)
+            zlibNamespace::deflateEnd (&s.stream);
+    }
+
+    bool acquire (zlibNamespace::z_stream& stream, int windowBits)
+    {
+        using namespace zlibNamespace;
+
+        {
+            const ScopedLock sl (lock);
+
+            for (int i = states.size(); --i >= 0;)
+            {
+                if (states.getReference (i).windowBits == windowBits)
+                {
+                    stream = states.getReference (i).stream;
+                    states.remove (i);
+
+                    // deflateReset() re-links the internal state to the stream's new address
+                    if (deflateReset (&stream) == Z_OK)
+                        return true;
+
+                    deflateEnd (&stream);
+                    break;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    bool release (const zlibNamespace::z_stream& stream, int windowBits)
+    {
+        const ScopedLock sl (lock);
+
+        if (states.size() >= maxPooledStates)
+            return false;
+
+        states.add ({ stream, windowBits });
+        return true;
+    }
+
+private:
+    enum { maxPooledStates = 16 };
+
+    struct PooledState
+    {
+        zlibNamespace::z_stream stream;
+        int windowBits;
+    };
+
+    CriticalSection lock;
+    Array<PooledState> states;
+};
+
+static DeflateStatePool& getDeflateStatePool()
+{
+    static DeflateStatePool pool;
+    return pool;
+}
+
+//==============================================================================
 class GZIPCompressorOutputStream::GZIPCompressorHelper
 {
 public:
-    GZIPCompressorHelper (int compressionLevel, int windowBits)
-        : compLevel ((compressionLevel < 0 || compressionLevel > 9) ? -1 : compressionLevel)
+    GZIPCompressorHelper (int compressionLevel, int windowBitsToUse)
+        : compLevel ((compressionLevel < 0 || compressionLevel > 9) ? -1 : compressionLevel),
+          windowBits (windowBitsToUse != 0 ? windowBitsToUse : MAX_WBITS)
     {
         using namespace zlibNamespace;
         zerostruct (stream);
 
-        streamIsValid = (deflateInit2 (&stream, compLevel, Z_DEFLATED,
-                                       windowBits != 0 ? windowBits : MAX_WBITS,
-                                       8, strategy) == Z_OK);
+        streamIsValid = getDeflateStatePool().acquire (stream, windowBits)
+                         || deflateInit2 (&stream, compLevel, Z_DEFLATED,
+                                          windowBits, 8, strategy) == Z_OK;
     }
 
     ~GZIPCompressorHelper()
     {
-        if (streamIsValid)
+        if (streamIsValid && ! getDeflateStatePool().release (stream, windowBits))
             zlibNamespace::deflateEnd (&stream);
     }
 
@@ -65,11 +138,31 @@ public:
             doNextBlock (data, dataSize, out, Z_FINISH);
     }
 
+    /*  Terminates an independent deflate block at a byte boundary without closing the
+        stream, so that blocks compressed separately can be concatenated into one stream.
+    */
+    bool endBlock (OutputStream& out)
+    {
+        jassert (! finished);
+
+        const uint8* data = nullptr;
+        size_t dataSize = 0;
+
+        for (;;)
+        {
+            if (! doNextBlock (data, dataSize, out, Z_FULL_FLUSH))
+                return false;
+
+            if (stream.avail_out != 0)
+                return true;
+        }
+    }
+
 private:
     enum { strategy = 0 };
 
     zlibNamespace::z_stream stream;
-    const int compLevel;
+    const int compLevel, windowBits;
     bool isFirstDeflate = true, streamIsValid = false, finished = false;
     zlibNamespace::Bytef buffer[32768];
 
@@ -154,6 +247,112 @@ bool GZIPCompressorOutputStream::setPosition (int64 /*newPosition*/)
     return false;
 }
 
+//==============================================================================
+bool GZIPCompressorOutputStream::compressInParallel (const void* sourceData, size_t sourceSize,
+                                                     OutputStream& destStream, int compressionLevel,
+                                                     ThreadPool* threadPoolToUse, size_t blockSize)
+{
+    jassert (sourceData != nullptr || sourceSize == 0);
+
+    blockSize = jmax ((size_t) 65536, blockSize);
+
+    auto* data = static_cast<const uint8*> (sourceData);
+    auto numBlocks = (int) jmax ((size_t) 1, (sourceSize + blockSize - 1) / blockSize);
+
+    // gzip member header: magic number, deflate method, no flags, no timestamp, unknown OS
+    const uint8 header[] = { 0x1f, 0x8b, 0x08, 0, 0, 0, 0, 0, 0, 0xff };
+
+    if (! destStream.write (header, sizeof (header)))
+        return false;
+
+    struct Block
+    {
+        MemoryOutputStream compressed;
+        uint32 crc = 0;
+        size_t length = 0;
+        bool ok = false;
+    };
+
+    OwnedArray<Block> blocks;
+
+    for (int i = 0; i < numBlocks; ++i)
+        blocks.add (new Block());
+
+    auto compressBlock = [&] (int index)
+    {
+        using namespace zlibNamespace;
+
+        auto& block = *blocks.getUnchecked (index);
+        auto offset = (size_t) index * blockSize;
+        block.length = jmin (blockSize, sourceSize - offset);
+
+        if (block.length > 0)
+            block.crc = (uint32) crc32 (0, data + offset, (z_uInt) block.length);
+
+        GZIPCompressorHelper helper (compressionLevel, windowBitsRaw);
+
+        block.ok = helper.write (data + offset, block.length, block.compressed);
+
+        if (block.ok)
+        {
+            if (index == numBlocks - 1)
+                helper.finish (block.compressed);
+            else
+                block.ok = helper.endBlock (block.compressed);
+        }
+    };
+
+    {
+        std::unique_ptr<ThreadPool> localPool;
+
+        if (threadPoolToUse == nullptr && numBlocks > 1)
+        {
+            localPool = std::make_unique<ThreadPool> (jmin (numBlocks, SystemStats::getNumCpus()));
+            threadPoolToUse = localPool.get();
+        }
+
+        if (threadPoolToUse != nullptr && numBlocks > 1)
+        {
+            WaitableEvent allDone;
+            Atomic<int> blocksRemaining { numBlocks };
+
+            for (int i = 0; i < numBlocks; ++i)
+            {
+                threadPoolToUse->addJob ([&, i]
+                {
+                    compressBlock (i);
+
+                    if (--blocksRemaining == 0)
+                        allDone.signal();
+                });
+            }
+
+            allDone.wait();
+        }
+        else
+        {
+            for (int i = 0; i < numBlocks; ++i)
+                compressBlock (i);
+        }
+    }
+
+    zlibNamespace::uLong combinedCrc = 0;
+
+    for (auto* block : blocks)
+    {
+        if (! block->ok)
+            return false;
+
+        if (! destStream.write (block->compressed.getData(), block->compressed.getDataSize()))
+            return false;
+
+        combinedCrc = zlibNamespace::crc32_combine (combinedCrc, block->crc, (long) block->length);
+    }
+
+    return destStream.writeInt ((int) combinedCrc)
+        && destStream.writeInt ((int) (sourceSize & 0xffffffffu));
+}
+
 
 //==============================================================================
 //==============================================================================
@@ -204,6 +403,34 @@ struct GZIPTests  : public UnitTest
                                 original.getData(),
                                 original.getDataSize()) == 0);
         }
+
+        beginTest ("Parallel GZIP");
+
+        for (auto size : { 0, 1, 100, 1024 * 1024 + 37 })
+        {
+            MemoryBlock original ((size_t) size);
+            auto* bytes = static_cast<uint8*> (original.getData());
+
+            for (int k = 0; k < size; ++k)
+                bytes[k] = (uint8) rng.nextInt (0x30);
+
+            MemoryOutputStream compressed, uncompressed;
+
+            expect (GZIPCompressorOutputStream::compressInParallel (original.getData(), original.getSize(),
+                                                                    compressed, rng.nextInt (10),
+                                                                    nullptr, 65536));
+
+            // gzipFormat makes the decompressor verify the stream's own CRC and length trailer
+            MemoryInputStream compressedInput (compressed.getData(), compressed.getDataSize(), false);
+            GZIPDecompressorInputStream unzipper (&compressedInput, false,
+                                                  GZIPDecompressorInputStream::gzipFormat);
+            uncompressed << unzipper;
+
+            expectEquals ((int) uncompressed.getDataSize(), size);
+
+            if ((int) uncompressed.getDataSize() == size)
+                expect (memcmp (uncompressed.getData(), original.getData(), (size_t) size) == 0);
+        }
     }
 };
 
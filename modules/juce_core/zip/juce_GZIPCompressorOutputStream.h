@@ -95,6 +95,37 @@ public:
         windowBitsGZIP = 15 + 16
     };
 
+    //==============================================================================
+    /** Compresses a block of memory on several threads at once, writing the result
+        to a stream as standard gzip data.
+
+        The source is split into independently-compressed blocks which are farmed out
+        across a thread pool and concatenated in order, so large buffers compress at
+        roughly one-core-per-block speed rather than tying up the calling thread.
+        The output is an ordinary gzip stream that any decompressor can read - pass
+        GZIPDecompressorInputStream::gzipFormat to read it back with JUCE.
+
+        Because the compression dictionary restarts at each block boundary, the result
+        is typically a fraction of a percent larger than the equivalent serial stream.
+
+        @param sourceData        the uncompressed data - unlike the streaming class, this
+                                 must all be available up-front
+        @param sourceSize        the number of bytes to compress
+        @param destStream        the stream into which the gzip data will be written
+        @param compressionLevel  how much to compress the data, as for the constructor
+        @param threadPoolToUse   the pool whose threads should carry out the compression,
+                                 or nullptr to use a temporary pool with one thread per core
+        @param blockSize         the size of the independently-compressed blocks - smaller
+                                 blocks spread across more cores, larger blocks compress
+                                 slightly better
+        @returns true if the data was compressed and written successfully
+    */
+    static bool compressInParallel (const void* sourceData, size_t sourceSize,
+                                    OutputStream& destStream,
+                                    int compressionLevel = -1,
+                                    ThreadPool* threadPoolToUse = nullptr,
+                                    size_t blockSize = 256 * 1024);
+
 private:
     //==============================================================================
     OptionalScopedPointer<OutputStream> destStream;
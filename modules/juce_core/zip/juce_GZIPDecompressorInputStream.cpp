@@ -87,6 +87,20 @@ namespace zlibNamespace
 
 JUCE_END_IGNORE_WARNINGS_MSVC
 
+//==============================================================================
+static int getBitsForGZIPFormat (GZIPDecompressorInputStream::Format f) noexcept
+{
+    switch (f)
+    {
+        case GZIPDecompressorInputStream::zlibFormat:     return  MAX_WBITS;
+        case GZIPDecompressorInputStream::deflateFormat:  return -MAX_WBITS;
+        case GZIPDecompressorInputStream::gzipFormat:     return  MAX_WBITS | 16;
+        default:                                          jassertfalse; break;
+    }
+
+    return MAX_WBITS;
+}
+
 //==============================================================================
 // internal helper object that holds the zlib structures so they don't have to be
 // included publicly.
@@ -97,7 +111,7 @@ public:
     {
         using namespace zlibNamespace;
         zerostruct (stream);
-        streamIsValid = (inflateInit2 (&stream, getBitsForFormat (f)) == Z_OK);
+        streamIsValid = (inflateInit2 (&stream, getBitsForGZIPFormat (f)) == Z_OK);
         finished = error = ! streamIsValid;
     }
 
@@ -154,19 +168,6 @@ public:
         return 0;
     }
 
-    static int getBitsForFormat (Format f) noexcept
-    {
-        switch (f)
-        {
-            case zlibFormat:     return  MAX_WBITS;
-            case deflateFormat:  return -MAX_WBITS;
-            case gzipFormat:     return  MAX_WBITS | 16;
-            default:             jassertfalse; break;
-        }
-
-        return MAX_WBITS;
-    }
-
     bool finished = true, needsDictionary = false, error = true, streamIsValid = false;
 
     enum { gzipDecompBufferSize = 32768 };
@@ -289,6 +290,99 @@ bool GZIPDecompressorInputStream::setPosition (int64 newPos)
     return true;
 }
 
+//==============================================================================
+// A per-thread inflate context that's reset rather than torn down between
+// one-shot decompressions, so repeated small payloads don't pay for zlib
+// state construction every time.
+struct ThreadLocalInflateContext
+{
+    ~ThreadLocalInflateContext()
+    {
+        if (isValid)
+            zlibNamespace::inflateEnd (&stream);
+    }
+
+    bool resetFor (GZIPDecompressorInputStream::Format format)
+    {
+        using namespace zlibNamespace;
+        const auto bits = getBitsForGZIPFormat (format);
+
+        if (isValid && bits == currentBits)
+            return inflateReset (&stream) == Z_OK;
+
+        if (isValid)
+            inflateEnd (&stream);
+
+        zerostruct (stream);
+        currentBits = bits;
+        isValid = (inflateInit2 (&stream, bits) == Z_OK);
+        return isValid;
+    }
+
+    zlibNamespace::z_stream stream;
+    int currentBits = 0;
+    bool isValid = false;
+};
+
+static ThreadLocalInflateContext& getThreadLocalInflateContext()
+{
+    static thread_local ThreadLocalInflateContext context;
+    return context;
+}
+
+int64 GZIPDecompressorInputStream::decompressInto (const void* sourceData, size_t sourceSize,
+                                                   MemoryBlock& destBlock, Format sourceFormat)
+{
+    using namespace zlibNamespace;
+
+    jassert (sourceData != nullptr || sourceSize == 0);
+
+    auto& context = getThreadLocalInflateContext();
+
+    if (! context.resetFor (sourceFormat))
+        return -1;
+
+    if (destBlock.getSize() == 0)
+        destBlock.ensureSize (jmax ((size_t) 256, sourceSize * 3));
+
+    auto& stream = context.stream;
+    stream.next_in = const_cast<uint8*> (static_cast<const uint8*> (sourceData));
+    stream.avail_in = (z_uInt) sourceSize;
+
+    size_t totalOut = 0;
+
+    for (;;)
+    {
+        if (totalOut == destBlock.getSize())
+            destBlock.ensureSize (destBlock.getSize() * 2);
+
+        // The block may have moved when it grew, so the output pointer is
+        // re-derived on every pass.
+        stream.next_out = static_cast<uint8*> (destBlock.getData()) + totalOut;
+        stream.avail_out = (z_uInt) (destBlock.getSize() - totalOut);
+
+        const auto availOutBefore = stream.avail_out;
+        const auto result = inflate (&stream, Z_NO_FLUSH);
+        totalOut += (size_t) (availOutBefore - stream.avail_out);
+
+        if (result == Z_STREAM_END)
+            return (int64) totalOut;
+
+        if (result != Z_OK && ! (result == Z_BUF_ERROR && stream.avail_out == 0))
+            return -1;
+
+        // Out of input with room still left in the block means the payload is truncated.
+        if (stream.avail_out > 0 && stream.avail_in == 0)
+            return -1;
+    }
+}
+
+int64 GZIPDecompressorInputStream::decompressInto (const MemoryBlock& source,
+                                                   MemoryBlock& destBlock, Format sourceFormat)
+{
+    return decompressInto (source.getData(), source.getSize(), destBlock, sourceFormat);
+}
+
 
 //==============================================================================
 //==============================================================================
@@ -362,6 +456,46 @@ struct GZIPDecompressorInputStreamTests   : public UnitTest
         expectEquals (stream.getPosition(), (int64) data.getSize());
         expectEquals (stream.getNumBytesRemaining(), (int64) 0);
         expect (stream.isExhausted());
+
+        beginTest ("One-shot decompressInto");
+
+        MemoryBlock decompressed;
+        expectEquals (GZIPDecompressorInputStream::decompressInto (mo.getMemoryBlock(), decompressed),
+                      (int64) data.getSize());
+        expect (memcmp (decompressed.getData(), data.getData(), data.getSize()) == 0);
+
+        // Reusing the same destination block mustn't disturb the result, even
+        // when the new payload is smaller than the block.
+        const MemoryBlock shortData ("12345", 5);
+
+        MemoryOutputStream shortOut;
+
+        {
+            GZIPCompressorOutputStream shortGzip (shortOut);
+            shortGzip.write (shortData.getData(), shortData.getSize());
+        }
+
+        expectEquals (GZIPDecompressorInputStream::decompressInto (shortOut.getMemoryBlock(), decompressed),
+                      (int64) shortData.getSize());
+        expect (memcmp (decompressed.getData(), shortData.getData(), shortData.getSize()) == 0);
+        expectGreaterOrEqual ((int) decompressed.getSize(), (int) data.getSize());
+
+        beginTest ("decompressInto rejects malformed and truncated data");
+
+        MemoryBlock corrupt (mo.getData(), mo.getDataSize());
+
+        for (size_t i = 4; i < corrupt.getSize(); ++i)
+            corrupt[i] ^= 0x55;
+
+        expectEquals (GZIPDecompressorInputStream::decompressInto (corrupt, decompressed), (int64) -1);
+
+        expectEquals (GZIPDecompressorInputStream::decompressInto (mo.getData(), mo.getDataSize() / 2, decompressed),
+                      (int64) -1);
+
+        // A rejected payload mustn't poison the thread's context for the next one.
+        expectEquals (GZIPDecompressorInputStream::decompressInto (mo.getMemoryBlock(), decompressed),
+                      (int64) data.getSize());
+        expect (memcmp (decompressed.getData(), data.getData(), data.getSize()) == 0);
     }
 };
 
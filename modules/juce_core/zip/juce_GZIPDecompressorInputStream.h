@@ -72,6 +72,39 @@ public:
     /** Destructor. */
     ~GZIPDecompressorInputStream() override;
 
+    //==============================================================================
+    /** Decompresses a complete in-memory payload in a single call.
+
+        This skips the stream abstraction entirely: the whole payload is
+        inflated straight into the given block using a per-thread zlib context
+        that's reset rather than recreated between calls. For lots of small
+        objects (preset files, cached blobs) this avoids both the zlib state
+        allocation and the intermediate read buffer that creating a
+        decompressor stream per object would cost.
+
+        The destination block is grown if it's too small, and never shrunk, so
+        reusing the same block across calls quickly makes the whole operation
+        allocation-free. The data beyond the returned size is left unspecified.
+
+        @param sourceData    the compressed payload
+        @param sourceSize    the size of the payload in bytes
+        @param destBlock     the block to decompress into, which will be grown
+                             if necessary
+        @param sourceFormat  the format the payload is expected to be in
+        @returns the number of decompressed bytes written to the block, or -1
+                 if the data was malformed or truncated
+    */
+    static int64 decompressInto (const void* sourceData, size_t sourceSize,
+                                 MemoryBlock& destBlock,
+                                 Format sourceFormat = zlibFormat);
+
+    /** Decompresses a complete in-memory payload in a single call.
+        @see decompressInto
+    */
+    static int64 decompressInto (const MemoryBlock& source,
+                                 MemoryBlock& destBlock,
+                                 Format sourceFormat = zlibFormat);
+
     //==============================================================================
     int64 getPosition() override;
     bool setPosition (int64 pos) override;
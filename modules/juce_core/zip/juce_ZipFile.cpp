@@ -412,6 +412,84 @@ Result ZipFile::uncompressTo (const File& targetDirectory,
     return Result::ok();
 }
 
+Result ZipFile::uncompressTo (const File& targetDirectory,
+                              const bool shouldOverwriteFiles,
+                              ThreadPool& threadPool)
+{
+    // A user-supplied stream is shared by all the entry streams, so entries can
+    // only be extracted one at a time.
+    if (inputStream != nullptr)
+        return uncompressTo (targetDirectory, shouldOverwriteFiles);
+
+    // Create the whole directory tree up-front, so that the parallel jobs never
+    // race to create the same folder.
+    Array<int> fileEntryIndexes;
+
+    for (int i = 0; i < entries.size(); ++i)
+    {
+        auto& entry = entries.getUnchecked (i)->entry;
+
+       #if JUCE_WINDOWS
+        auto entryPath = entry.filename;
+       #else
+        auto entryPath = entry.filename.replaceCharacter ('\\', '/');
+       #endif
+
+        if (entryPath.isEmpty())
+            continue;
+
+        auto targetFile = targetDirectory.getChildFile (entryPath);
+
+        if (! targetFile.isAChildOf (targetDirectory))
+            return Result::fail ("Entry " + entryPath + " is outside the target directory");
+
+        if (entryPath.endsWithChar ('/') || entryPath.endsWithChar ('\\'))
+        {
+            auto result = targetFile.createDirectory();
+
+            if (result.failed())
+                return result;
+        }
+        else
+        {
+            if (! targetFile.getParentDirectory().createDirectory())
+                return Result::fail ("Failed to create target folder: " + targetFile.getParentDirectory().getFullPathName());
+
+            fileEntryIndexes.add (i);
+        }
+    }
+
+    CriticalSection resultLock;
+    Result result = Result::ok();
+    std::atomic<int> jobsRemaining { fileEntryIndexes.size() };
+    WaitableEvent allJobsDone;
+
+    for (auto index : fileEntryIndexes)
+    {
+        threadPool.addJob ([this, index, targetDirectory, shouldOverwriteFiles,
+                            &resultLock, &result, &jobsRemaining, &allJobsDone]
+        {
+            auto jobResult = uncompressEntry (index, targetDirectory, shouldOverwriteFiles);
+
+            if (jobResult.failed())
+            {
+                const ScopedLock sl (resultLock);
+
+                if (result.wasOk())
+                    result = jobResult;
+            }
+
+            if (--jobsRemaining == 0)
+                allJobsDone.signal();
+        });
+    }
+
+    if (fileEntryIndexes.size() > 0)
+        allJobsDone.wait();
+
+    return result;
+}
+
 Result ZipFile::uncompressEntry (int index, const File& targetDirectory, bool shouldOverwriteFiles)
 {
     return uncompressEntry (index,
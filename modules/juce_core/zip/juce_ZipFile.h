@@ -164,6 +164,29 @@ public:
     Result uncompressTo (const File& targetDirectory,
                          bool shouldOverwriteFiles = true);
 
+    /** Uncompresses all of the files in the zip file, decompressing entries in
+        parallel on a thread pool.
+
+        This behaves like the two-argument uncompressTo(), but independent entries
+        are expanded concurrently across the pool's threads, which can be much
+        faster for large archives on multi-core machines. The call blocks until
+        every entry has been written, and returns the first failure encountered
+        (the remaining jobs are still run to completion).
+
+        Note that this is only possible when each entry can be given its own input
+        stream, i.e. the ZipFile must have been created from a File or InputSource.
+        If it was created from a user-supplied InputStream, all entry streams share
+        that stream, so this falls back to extracting sequentially.
+
+        @param targetDirectory      the root folder to uncompress to
+        @param shouldOverwriteFiles whether to overwrite existing files with similarly-named ones
+        @param threadPool           the pool on which to run the decompression jobs
+        @returns success if the file is successfully unzipped
+    */
+    Result uncompressTo (const File& targetDirectory,
+                         bool shouldOverwriteFiles,
+                         ThreadPool& threadPool);
+
     /** Uncompresses one of the entries from the zip file.
 
         This will expand the entry and write it in a target directory. The entry's path is used to
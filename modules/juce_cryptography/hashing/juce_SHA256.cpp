@@ -23,54 +23,202 @@
   ==============================================================================
 */
 
+#if (defined (__GNUC__) || defined (__clang__)) && (defined (__x86_64__) || defined (__i386__))
+ #define JUCE_SHA256_HAS_SHA_NI 1
+ #include <immintrin.h>
+#elif defined (__ARM_FEATURE_CRYPTO)
+ #define JUCE_SHA256_HAS_ARM_CRYPTO 1
+ #include <arm_neon.h>
+#endif
+
 namespace juce
 {
 
-struct SHA256Processor
+namespace SHA256Helpers
 {
-    // expects 64 bytes of data
-    void processFullBlock (const void* data) noexcept
+    static const uint32_t roundConstants[64] =
     {
-        const uint32_t constants[] =
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+
+   #if ! JUCE_SHA256_HAS_ARM_CRYPTO
+    static uint32_t rotate (uint32_t x, uint32_t y) noexcept            { return (x >> y) | (x << (32 - y)); }
+    static uint32_t ch  (uint32_t x, uint32_t y, uint32_t z) noexcept   { return z ^ ((y ^ z) & x); }
+    static uint32_t maj (uint32_t x, uint32_t y, uint32_t z) noexcept   { return y ^ ((y ^ z) & (x ^ y)); }
+
+    static uint32_t s0 (uint32_t x) noexcept     { return rotate (x, 7)  ^ rotate (x, 18) ^ (x >> 3); }
+    static uint32_t s1 (uint32_t x) noexcept     { return rotate (x, 17) ^ rotate (x, 19) ^ (x >> 10); }
+    static uint32_t S0 (uint32_t x) noexcept     { return rotate (x, 2)  ^ rotate (x, 13) ^ rotate (x, 22); }
+    static uint32_t S1 (uint32_t x) noexcept     { return rotate (x, 6)  ^ rotate (x, 11) ^ rotate (x, 25); }
+
+    static void processBlocksGeneric (uint32_t* state, const uint8_t* data, size_t numBlocks) noexcept
+    {
+        while (numBlocks-- != 0)
         {
-            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
-            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
-            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
-            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
-            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
-            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
-        };
-
-        uint32_t block[16], s[8];
-        memcpy (s, state, sizeof (s));
-
-        auto d = static_cast<const uint8_t*> (data);
-
-        for (auto& b : block)
+            uint32_t block[16], s[8];
+            memcpy (s, state, sizeof (s));
+
+            for (auto& b : block)
+            {
+                b = (uint32_t (data[0]) << 24) | (uint32_t (data[1]) << 16) | (uint32_t (data[2]) << 8) | data[3];
+                data += 4;
+            }
+
+            auto convolve = [&] (uint32_t i, uint32_t j)
+            {
+                s[(7 - i) & 7] += S1 (s[(4 - i) & 7]) + ch (s[(4 - i) & 7], s[(5 - i) & 7], s[(6 - i) & 7]) + roundConstants[i + j]
+                                     + (j != 0 ? (block[i & 15] += s1 (block[(i - 2) & 15]) + block[(i - 7) & 15] + s0 (block[(i - 15) & 15]))
+                                               : block[i]);
+                s[(3 - i) & 7] += s[(7 - i) & 7];
+                s[(7 - i) & 7] += S0 (s[(0 - i) & 7]) + maj (s[(0 - i) & 7], s[(1 - i) & 7], s[(2 - i) & 7]);
+            };
+
+            for (uint32_t j = 0; j < 64; j += 16)
+                for (uint32_t i = 0; i < 16; ++i)
+                    convolve (i, j);
+
+            for (int i = 0; i < 8; ++i)
+                state[i] += s[i];
+        }
+    }
+   #endif
+
+   #if JUCE_SHA256_HAS_SHA_NI
+    __attribute__ ((target ("sha,sse4.1")))
+    static void processBlocksAccelerated (uint32_t* state, const uint8_t* data, size_t numBlocks) noexcept
+    {
+        const auto byteSwapMask = _mm_set_epi64x ((int64_t) 0x0c0d0e0f08090a0b, (int64_t) 0x0405060700010203);
+
+        // the state words are kept in the (ABEF, CDGH) layout that the sha256rnds2
+        // instruction expects while processing, and swapped back at the end
+        auto tmp    = _mm_shuffle_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (state)),     0xb1);
+        auto state1 = _mm_shuffle_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (state + 4)), 0x1b);
+        auto state0 = _mm_alignr_epi8 (tmp, state1, 8);
+        state1 = _mm_blend_epi16 (state1, tmp, 0xf0);
+
+        while (numBlocks-- != 0)
+        {
+            const auto savedState0 = state0;
+            const auto savedState1 = state1;
+
+            __m128i msgs[4];
+
+            for (uint32_t group = 0; group < 16; ++group)
+            {
+                if (group < 4)
+                    msgs[group] = _mm_shuffle_epi8 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (data + 16 * group)),
+                                                    byteSwapMask);
+
+                auto msg = _mm_add_epi32 (msgs[group & 3],
+                                          _mm_loadu_si128 (reinterpret_cast<const __m128i*> (roundConstants + 4 * group)));
+                state1 = _mm_sha256rnds2_epu32 (state1, state0, msg);
+
+                if (group >= 3 && group <= 14)
+                {
+                    auto& next = msgs[(group + 1) & 3];
+                    next = _mm_sha256msg2_epu32 (_mm_add_epi32 (next, _mm_alignr_epi8 (msgs[group & 3], msgs[(group - 1) & 3], 4)),
+                                                 msgs[group & 3]);
+                }
+
+                state0 = _mm_sha256rnds2_epu32 (state0, state1, _mm_shuffle_epi32 (msg, 0x0e));
+
+                if (group >= 1 && group <= 12)
+                    msgs[(group - 1) & 3] = _mm_sha256msg1_epu32 (msgs[(group - 1) & 3], msgs[group & 3]);
+            }
+
+            state0 = _mm_add_epi32 (state0, savedState0);
+            state1 = _mm_add_epi32 (state1, savedState1);
+            data += 64;
+        }
+
+        tmp    = _mm_shuffle_epi32 (state0, 0x1b);
+        state1 = _mm_shuffle_epi32 (state1, 0xb1);
+        state0 = _mm_blend_epi16 (tmp, state1, 0xf0);
+        state1 = _mm_alignr_epi8 (state1, tmp, 8);
+
+        _mm_storeu_si128 (reinterpret_cast<__m128i*> (state),     state0);
+        _mm_storeu_si128 (reinterpret_cast<__m128i*> (state + 4), state1);
+    }
+   #elif JUCE_SHA256_HAS_ARM_CRYPTO
+    static void processBlocksAccelerated (uint32_t* state, const uint8_t* data, size_t numBlocks) noexcept
+    {
+        auto state0 = vld1q_u32 (state);
+        auto state1 = vld1q_u32 (state + 4);
+
+        while (numBlocks-- != 0)
         {
-            b = (uint32_t (d[0]) << 24) | (uint32_t (d[1]) << 16) | (uint32_t (d[2]) << 8) | d[3];
-            d += 4;
+            const auto savedState0 = state0;
+            const auto savedState1 = state1;
+
+            uint32x4_t msgs[4];
+
+            for (uint32_t group = 0; group < 4; ++group)
+                msgs[group] = vreinterpretq_u32_u8 (vrev32q_u8 (vld1q_u8 (data + 16 * group)));
+
+            for (uint32_t group = 0; group < 16; ++group)
+            {
+                const auto wk = vaddq_u32 (msgs[group & 3], vld1q_u32 (roundConstants + 4 * group));
+
+                if (group <= 11)
+                    msgs[group & 3] = vsha256su1q_u32 (vsha256su0q_u32 (msgs[group & 3], msgs[(group + 1) & 3]),
+                                                       msgs[(group + 2) & 3], msgs[(group + 3) & 3]);
+
+                const auto previousState0 = state0;
+                state0 = vsha256hq_u32  (state0, state1, wk);
+                state1 = vsha256h2q_u32 (state1, previousState0, wk);
+            }
+
+            state0 = vaddq_u32 (state0, savedState0);
+            state1 = vaddq_u32 (state1, savedState1);
+            data += 64;
         }
 
-        auto convolve = [&] (uint32_t i, uint32_t j)
+        vst1q_u32 (state, state0);
+        vst1q_u32 (state + 4, state1);
+    }
+   #endif
+
+    static void processBlocks (uint32_t* state, const void* data, size_t numBlocks) noexcept
+    {
+        auto* d = static_cast<const uint8_t*> (data);
+
+       #if JUCE_SHA256_HAS_SHA_NI
+        static const bool hasShaInstructions = __builtin_cpu_supports ("sha") && __builtin_cpu_supports ("sse4.1");
+
+        if (hasShaInstructions)
         {
-            s[(7 - i) & 7] += S1 (s[(4 - i) & 7]) + ch (s[(4 - i) & 7], s[(5 - i) & 7], s[(6 - i) & 7]) + constants[i + j]
-                                 + (j != 0 ? (block[i & 15] += s1 (block[(i - 2) & 15]) + block[(i - 7) & 15] + s0 (block[(i - 15) & 15]))
-                                           : block[i]);
-            s[(3 - i) & 7] += s[(7 - i) & 7];
-            s[(7 - i) & 7] += S0 (s[(0 - i) & 7]) + maj (s[(0 - i) & 7], s[(1 - i) & 7], s[(2 - i) & 7]);
-        };
+            processBlocksAccelerated (state, d, numBlocks);
+            return;
+        }
 
-        for (uint32_t j = 0; j < 64; j += 16)
-            for (uint32_t i = 0; i < 16; ++i)
-                convolve (i, j);
+        processBlocksGeneric (state, d, numBlocks);
+       #elif JUCE_SHA256_HAS_ARM_CRYPTO
+        processBlocksAccelerated (state, d, numBlocks);
+       #else
+        processBlocksGeneric (state, d, numBlocks);
+       #endif
+    }
+}
 
-        for (int i = 0; i < 8; ++i)
-            state[i] += s[i];
+struct SHA256Processor
+{
+    // expects 64 bytes of data
+    void processFullBlock (const void* data) noexcept
+    {
+        processFullBlocks (data, 1);
+    }
 
-        length += 64;
+    void processFullBlocks (const void* data, size_t numBlocks) noexcept
+    {
+        SHA256Helpers::processBlocks (state, data, numBlocks);
+        length += 64 * (uint64_t) numBlocks;
     }
 
     void processFinalBlock (const void* data, uint32_t numBytes) noexcept
@@ -93,10 +241,7 @@ struct SHA256Processor
 
         jassert (numBytes == 64 || numBytes == 128);
 
-        processFullBlock (finalBlocks);
-
-        if (numBytes > 64)
-            processFullBlock (finalBlocks + 64);
+        SHA256Helpers::processBlocks (state, finalBlocks, numBytes / 64);
     }
 
     void copyResult (uint8_t* result) const noexcept
@@ -117,17 +262,19 @@ struct SHA256Processor
 
         for (;;)
         {
-            uint8_t buffer[64];
+            uint8_t buffer[4096];
             auto bytesRead = input.read (buffer, (int) jmin (numBytesToRead, (int64_t) sizeof (buffer)));
 
             if (bytesRead < (int) sizeof (buffer))
             {
-                processFinalBlock (buffer, (unsigned int) bytesRead);
+                auto numWholeBlocks = (size_t) bytesRead / 64;
+                processFullBlocks (buffer, numWholeBlocks);
+                processFinalBlock (buffer + numWholeBlocks * 64, (unsigned int) bytesRead % 64);
                 break;
             }
 
             numBytesToRead -= (int64_t) sizeof (buffer);
-            processFullBlock (buffer);
+            processFullBlocks (buffer, sizeof (buffer) / 64);
         }
 
         copyResult (result);
@@ -137,15 +284,6 @@ private:
     uint32_t state[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
                           0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
     uint64_t length = 0;
-
-    static uint32_t rotate (uint32_t x, uint32_t y) noexcept            { return (x >> y) | (x << (32 - y)); }
-    static uint32_t ch  (uint32_t x, uint32_t y, uint32_t z) noexcept   { return z ^ ((y ^ z) & x); }
-    static uint32_t maj (uint32_t x, uint32_t y, uint32_t z) noexcept   { return y ^ ((y ^ z) & (x ^ y)); }
-
-    static uint32_t s0 (uint32_t x) noexcept     { return rotate (x, 7)  ^ rotate (x, 18) ^ (x >> 3); }
-    static uint32_t s1 (uint32_t x) noexcept     { return rotate (x, 17) ^ rotate (x, 19) ^ (x >> 10); }
-    static uint32_t S0 (uint32_t x) noexcept     { return rotate (x, 2)  ^ rotate (x, 13) ^ rotate (x, 22); }
-    static uint32_t S1 (uint32_t x) noexcept     { return rotate (x, 6)  ^ rotate (x, 11) ^ rotate (x, 25); }
 };
 
 //==============================================================================
@@ -211,6 +349,141 @@ String SHA256::toHexString() const
 bool SHA256::operator== (const SHA256& other) const noexcept  { return memcmp (result, other.result, sizeof (result)) == 0; }
 bool SHA256::operator!= (const SHA256& other) const noexcept  { return ! operator== (other); }
 
+Array<SHA256::FileHash> SHA256::hashFileTree (const File& rootDirectory,
+                                              ThreadPool& threadPool,
+                                              const String& wildcardPattern)
+{
+    auto files = rootDirectory.findChildFiles (File::findFiles, true, wildcardPattern);
+
+    std::sort (files.begin(), files.end(),
+               [] (const File& a, const File& b) { return a.getFullPathName() < b.getFullPathName(); });
+
+    Array<FileHash> results;
+    results.resize (files.size());
+
+    std::atomic<int> nextIndex { 0 };
+
+    auto hashNextFiles = [&]
+    {
+        for (;;)
+        {
+            auto index = nextIndex.fetch_add (1);
+
+            if (index >= files.size())
+                break;
+
+            auto& entry = results.getReference (index);
+            entry.file = files.getReference (index);
+            entry.hash = SHA256 (entry.file);
+        }
+    };
+
+    // the calling thread joins in rather than sitting idle, so one fewer job is needed
+    auto numJobs = jlimit (0, threadPool.getNumThreads(), files.size() - 1);
+    std::atomic<int> numUnfinishedJobs { numJobs };
+    WaitableEvent allJobsFinished;
+
+    for (int i = 0; i < numJobs; ++i)
+    {
+        threadPool.addJob ([&]
+        {
+            hashNextFiles();
+
+            if (--numUnfinishedJobs == 0)
+                allJobsFinished.signal();
+        });
+    }
+
+    hashNextFiles();
+
+    if (numJobs > 0)
+        allJobsFinished.wait();
+
+    return results;
+}
+
+//==============================================================================
+SHA256Builder::SHA256Builder() noexcept
+{
+    const uint32 initialState[] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+    memcpy (state, initialState, sizeof (state));
+}
+
+void SHA256Builder::update (const void* data, size_t numBytes) noexcept
+{
+    auto* d = static_cast<const uint8*> (data);
+    length += numBytes;
+
+    if (numPendingBytes > 0)
+    {
+        auto numToCopy = jmin (numBytes, sizeof (pendingBlock) - numPendingBytes);
+        memcpy (pendingBlock + numPendingBytes, d, numToCopy);
+        numPendingBytes += numToCopy;
+        d += numToCopy;
+        numBytes -= numToCopy;
+
+        if (numPendingBytes == sizeof (pendingBlock))
+        {
+            SHA256Helpers::processBlocks (state, pendingBlock, 1);
+            numPendingBytes = 0;
+        }
+    }
+
+    if (auto numWholeBlocks = numBytes / sizeof (pendingBlock))
+    {
+        SHA256Helpers::processBlocks (state, d, numWholeBlocks);
+        d += numWholeBlocks * sizeof (pendingBlock);
+        numBytes -= numWholeBlocks * sizeof (pendingBlock);
+    }
+
+    if (numBytes > 0)
+    {
+        memcpy (pendingBlock, d, numBytes);
+        numPendingBytes = numBytes;
+    }
+}
+
+void SHA256Builder::update (const MemoryBlock& data) noexcept
+{
+    update (data.getData(), data.getSize());
+}
+
+SHA256 SHA256Builder::finalise() noexcept
+{
+    auto numBits = length * 8;
+
+    uint8 finalBlocks[128];
+    auto numBytes = (uint32) numPendingBytes;
+
+    memcpy (finalBlocks, pendingBlock, numPendingBytes);
+    finalBlocks[numBytes++] = 128; // append a '1' bit
+
+    while (numBytes != 56 && numBytes < 64 + 56)
+        finalBlocks[numBytes++] = 0; // pad with zeros..
+
+    for (int i = 8; --i >= 0;)
+        finalBlocks[numBytes++] = (uint8) (numBits >> (i * 8)); // append the length.
+
+    jassert (numBytes == 64 || numBytes == 128);
+
+    SHA256Helpers::processBlocks (state, finalBlocks, numBytes / 64);
+
+    SHA256 hash;
+    auto* result = hash.result;
+
+    for (auto s : state)
+    {
+        *result++ = (uint8) (s >> 24);
+        *result++ = (uint8) (s >> 16);
+        *result++ = (uint8) (s >> 8);
+        *result++ = (uint8) s;
+    }
+
+    *this = SHA256Builder();
+    return hash;
+}
+
 
 //==============================================================================
 #if JUCE_UNIT_TESTS
@@ -249,6 +522,81 @@ public:
         test ("", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
         test ("The quick brown fox jumps over the lazy dog",  "d7a8fbb307d7809469ca9abcb0082e4f8d5651e46d3cdb762d02d0bf37c9e592");
         test ("The quick brown fox jumps over the lazy dog.", "ef537f25c895bfa782526529a9b63d97aa631564d5d789c2b765448c8635fb6c");
+
+        beginTest ("Multi-block input");
+        {
+            MemoryBlock data ((size_t) 1000000);
+            memset (data.getData(), 'a', data.getSize());
+
+            SHA256 hash (data);
+            expectEquals (hash.toHexString(), String ("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"));
+        }
+
+        beginTest ("Incremental hashing matches one-shot hashing");
+        {
+            auto r = getRandom();
+
+            MemoryBlock data ((size_t) 20000);
+            auto* bytes = static_cast<uint8*> (data.getData());
+
+            for (size_t i = 0; i < data.getSize(); ++i)
+                bytes[i] = (uint8) r.nextInt (256);
+
+            SHA256 oneShot (data);
+
+            SHA256Builder builder;
+
+            for (size_t pos = 0; pos < data.getSize();)
+            {
+                auto numBytes = jmin (data.getSize() - pos, (size_t) r.nextInt (997));
+                builder.update (bytes + pos, numBytes);
+                pos += numBytes;
+            }
+
+            expect (builder.finalise() == oneShot);
+
+            // finalising resets the builder, ready for the next hash
+            builder.update (data);
+            expect (builder.finalise() == oneShot);
+        }
+
+        beginTest ("Parallel file tree hashing");
+        {
+            auto root = File::getSpecialLocation (File::tempDirectory)
+                            .getChildFile ("sha256_tree_test")
+                            .getNonexistentSibling();
+            auto r = getRandom();
+            int numFilesCreated = 0;
+
+            for (int i = 0; i < 20; ++i)
+            {
+                auto file = root.getChildFile ("dir" + String (i % 3))
+                                .getChildFile ("file" + String (i) + ".bin");
+                file.getParentDirectory().createDirectory();
+
+                MemoryBlock contents ((size_t) r.nextInt (100000));
+                auto* bytes = static_cast<uint8*> (contents.getData());
+
+                for (size_t j = 0; j < contents.getSize(); ++j)
+                    bytes[j] = (uint8) r.nextInt (256);
+
+                if (file.replaceWithData (contents.getData(), contents.getSize()))
+                    ++numFilesCreated;
+            }
+
+            ThreadPool pool (4);
+            auto results = SHA256::hashFileTree (root, pool);
+
+            expectEquals (results.size(), numFilesCreated);
+
+            for (auto& entry : results)
+                expect (entry.hash == SHA256 (entry.file));
+
+            for (int i = 1; i < results.size(); ++i)
+                expect (results[i - 1].file.getFullPathName() < results[i].file.getFullPathName());
+
+            expect (root.deleteRecursively());
+        }
     }
 };
 
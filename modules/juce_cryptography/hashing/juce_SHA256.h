@@ -96,13 +96,85 @@ public:
     bool operator== (const SHA256&) const noexcept;
     bool operator!= (const SHA256&) const noexcept;
 
+    //==============================================================================
+    /** The hash of a single file, as produced by hashFileTree(). */
+    struct FileHash;
+
+    /** Recursively hashes all the files in a directory tree, sharing the work
+        across the threads of a pool.
+
+        This finds every file beneath rootDirectory whose name matches the
+        wildcard pattern, hashes them in parallel (the calling thread helps out,
+        and blocks until all the hashes are ready), and returns one FileHash per
+        file, sorted by full path.
+    */
+    static Array<FileHash> hashFileTree (const File& rootDirectory,
+                                         ThreadPool& threadPool,
+                                         const String& wildcardPattern = "*");
 
 private:
     //==============================================================================
     uint8 result[32] = {};
     void process (const void*, size_t);
 
+    friend class SHA256Builder;
+
     JUCE_LEAK_DETECTOR (SHA256)
 };
 
+/** The hash of a single file, as produced by SHA256::hashFileTree(). */
+struct SHA256::FileHash
+{
+    File file;
+    SHA256 hash;
+};
+
+//==============================================================================
+/**
+    Incrementally calculates a SHA-256 hash from data supplied in multiple calls.
+
+    Unlike the SHA256 constructors, which need all of the source data at once,
+    this lets you feed in data as it arrives - useful when hashing something
+    that's being streamed or generated on the fly.
+
+    @code
+    SHA256Builder builder;
+
+    while (auto numBytes = getMoreData (buffer))
+        builder.update (buffer, numBytes);
+
+    auto hash = builder.finalise();
+    @endcode
+
+    @see SHA256
+
+    @tags{Cryptography}
+*/
+class JUCE_API  SHA256Builder
+{
+public:
+    /** Creates a builder ready to receive data. */
+    SHA256Builder() noexcept;
+
+    /** Adds a chunk of data to the hash. */
+    void update (const void* data, size_t numBytes) noexcept;
+
+    /** Adds a block of data to the hash. */
+    void update (const MemoryBlock& data) noexcept;
+
+    /** Completes the hash calculation and returns the result.
+        This also resets the builder, leaving it ready to calculate a new hash.
+    */
+    SHA256 finalise() noexcept;
+
+private:
+    //==============================================================================
+    uint32 state[8];
+    uint64 length = 0;
+    uint8 pendingBlock[64];
+    size_t numPendingBytes = 0;
+
+    JUCE_LEAK_DETECTOR (SHA256Builder)
+};
+
 } // namespace juce
@@ -30,6 +30,10 @@ namespace PropertyFileConstants
 {
     constexpr static const int magicNumber            = (int) ByteOrder::makeInt ('P', 'R', 'O', 'P');
     constexpr static const int magicNumberCompressed  = (int) ByteOrder::makeInt ('C', 'P', 'R', 'P');
+    constexpr static const int magicNumberJournal     = (int) ByteOrder::makeInt ('J', 'P', 'R', 'P');
+
+    constexpr static const char journalSetRecord      = 1;
+    constexpr static const char journalRemoveRecord   = 2;
 
     constexpr static const char* const fileTag        = "PROPERTIES";
     constexpr static const char* const valueTag       = "VALUE";
@@ -133,6 +137,10 @@ bool PropertiesFile::reload()
     if (pl != nullptr && ! pl->isLocked())
         return false; // locking failure..
 
+    lastSavedProperties.clear();
+    numJournalledChanges = 0;
+    journalIsValid = false;
+
     loadedOk = (! file.exists()) || loadAsBinary() || loadAsXml();
     return loadedOk;
 }
@@ -180,6 +188,9 @@ bool PropertiesFile::save()
     if (options.storageFormat == storeAsXML)
         return saveAsXml();
 
+    if (options.storageFormat == storeAsJournalledBinary)
+        return saveAsJournal();
+
     return saveAsBinary();
 }
 
@@ -250,6 +261,9 @@ bool PropertiesFile::loadAsBinary()
             return loadAsBinary (gzip);
         }
 
+        if (magicNumber == PropertyFileConstants::magicNumberJournal)
+            return loadAsJournal (fileStream);
+
         if (magicNumber == PropertyFileConstants::magicNumber)
             return loadAsBinary (fileStream);
     }
@@ -276,6 +290,139 @@ bool PropertiesFile::loadAsBinary (InputStream& input)
     return true;
 }
 
+bool PropertiesFile::loadAsJournal (InputStream& input)
+{
+    BufferedInputStream in (input, 2048);
+
+    int numValues = in.readInt();
+
+    while (--numValues >= 0 && ! in.isExhausted())
+    {
+        auto key = in.readString();
+        auto value = in.readString();
+        jassert (key.isNotEmpty());
+
+        if (key.isNotEmpty())
+            getAllProperties().set (key, value);
+    }
+
+    // ..then replay any delta records that have been appended since the snapshot was written
+    while (! in.isExhausted())
+    {
+        auto type = in.readByte();
+
+        if (type == PropertyFileConstants::journalSetRecord)
+        {
+            auto key = in.readString();
+            getAllProperties().set (key, in.readString());
+        }
+        else if (type == PropertyFileConstants::journalRemoveRecord)
+        {
+            auto key = in.readString();
+            getAllProperties().remove (StringRef (key));
+        }
+        else
+        {
+            // an interrupted append can leave a truncated record at the end of the file -
+            // just ignore the tail, as it'll be cleaned up by the next compaction
+            break;
+        }
+
+        ++numJournalledChanges;
+    }
+
+    lastSavedProperties = getAllProperties();
+    journalIsValid = true;
+    return true;
+}
+
+bool PropertiesFile::saveAsJournal()
+{
+    auto& props = getAllProperties();
+
+    // work out which keys have changed since the file was last written..
+    StringArray changedKeys, removedKeys;
+
+    if (journalIsValid)
+    {
+        auto& keys   = props.getAllKeys();
+        auto& values = props.getAllValues();
+
+        for (int i = 0; i < props.size(); ++i)
+            if ((! lastSavedProperties.containsKey (keys[i])) || lastSavedProperties[keys[i]] != values[i])
+                changedKeys.add (keys[i]);
+
+        for (auto& oldKey : lastSavedProperties.getAllKeys())
+            if (! props.containsKey (oldKey))
+                removedKeys.add (oldKey);
+    }
+
+    auto numChanges = changedKeys.size() + removedKeys.size();
+
+    // once the journal is mostly stale records, fold it back into a fresh snapshot
+    auto shouldCompact = (! journalIsValid)
+                           || numJournalledChanges + numChanges > jmax (128, 2 * props.size());
+
+    ProcessScopedLock pl (createProcessLock());
+
+    if (pl != nullptr && ! pl->isLocked())
+        return false; // locking failure..
+
+    if (shouldCompact)
+    {
+        TemporaryFile tempFile (file);
+
+        {
+            FileOutputStream out (tempFile.getFile());
+
+            if (! out.openedOk())
+                return false;
+
+            out.writeInt (PropertyFileConstants::magicNumberJournal);
+
+            if (! writeToStream (out))
+                return false;
+        }
+
+        if (! tempFile.overwriteTargetFileWithTemporary())
+            return false;
+
+        numJournalledChanges = 0;
+    }
+    else if (numChanges > 0)
+    {
+        FileOutputStream out (file); // opens the existing file and appends to it
+
+        if (! out.openedOk())
+            return false;
+
+        for (auto& key : changedKeys)
+        {
+            out.writeByte (PropertyFileConstants::journalSetRecord);
+            out.writeString (key);
+            out.writeString (props[key]);
+        }
+
+        for (auto& key : removedKeys)
+        {
+            out.writeByte (PropertyFileConstants::journalRemoveRecord);
+            out.writeString (key);
+        }
+
+        out.flush();
+
+        if (out.getStatus().failed())
+            return false;
+
+        numJournalledChanges += numChanges;
+    }
+
+    lastSavedProperties = props;
+    journalIsValid = true;
+    needsWriting = false;
+    return true;
+}
+
 bool PropertiesFile::saveAsBinary()
 {
     ProcessScopedLock pl (createProcessLock());
@@ -355,4 +502,90 @@ void PropertiesFile::propertyChanged()
         saveIfNeeded();
 }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class PropertiesFileTests  : public UnitTest
+{
+public:
+    PropertiesFileTests()
+        : UnitTest ("PropertiesFile", UnitTestCategories::files)
+    {}
+
+    void runTest() override
+    {
+        TemporaryFile temp (".settings");
+        auto file = temp.getFile();
+
+        PropertiesFile::Options options;
+        options.millisecondsBeforeSaving = -1;
+        options.storageFormat = PropertiesFile::storeAsJournalledBinary;
+
+        auto bigValue = String::repeatedString ("windowLayout", 1000);
+
+        beginTest ("Journalled files round-trip");
+        {
+            PropertiesFile props (file, options);
+
+            for (int i = 0; i < 50; ++i)
+                props.setValue ("key" + String (i), bigValue + String (i));
+
+            expect (props.save());
+
+            PropertiesFile reloaded (file, options);
+            expect (reloaded.isValidFile());
+            expectEquals (reloaded.getAllProperties().size(), 50);
+            expectEquals (reloaded.getValue ("key7"), bigValue + "7");
+        }
+
+        beginTest ("Small changes are appended rather than re-writing the file");
+        {
+            PropertiesFile props (file, options);
+            auto sizeBefore = file.getSize();
+
+            props.setValue ("key3", "changed");
+            props.removeValue ("key4");
+            expect (props.save());
+
+            expect (file.getSize() > sizeBefore);
+            expect (file.getSize() < sizeBefore + 128);
+
+            PropertiesFile reloaded (file, options);
+            expectEquals (reloaded.getValue ("key3"), String ("changed"));
+            expect (! reloaded.containsKey ("key4"));
+            expectEquals (reloaded.getAllProperties().size(), 49);
+        }
+
+        beginTest ("The journal is periodically compacted");
+        {
+            PropertiesFile props (file, options);
+
+            bool sawCompaction = false;
+            auto lastSize = file.getSize();
+
+            for (int i = 0; i < 300; ++i)
+            {
+                props.setValue ("counter", i);
+                expect (props.save());
+
+                auto newSize = file.getSize();
+                sawCompaction = sawCompaction || newSize < lastSize;
+                lastSize = newSize;
+            }
+
+            expect (sawCompaction);
+
+            PropertiesFile reloaded (file, options);
+            expectEquals (reloaded.getIntValue ("counter"), 299);
+            expectEquals (reloaded.getValue ("key3"), String ("changed"));
+        }
+    }
+};
+
+static PropertiesFileTests propertiesFileTests;
+
+#endif
+
 } // namespace juce
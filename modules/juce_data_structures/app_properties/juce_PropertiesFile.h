@@ -52,7 +52,8 @@ public:
     {
         storeAsBinary,
         storeAsCompressedBinary,
-        storeAsXML
+        storeAsXML,
+        storeAsJournalledBinary
     };
 
     //==============================================================================
@@ -130,6 +131,13 @@ public:
         /** Specifies whether the file should be written as XML, binary, etc.
             The default constructor sets this to storeAsXML, so you only need to set it explicitly
             if you want to use a different format.
+
+            The storeAsJournalledBinary format writes an uncompressed binary snapshot of all the
+            values, and subsequent saves append just the key/value pairs that have changed since
+            the last save, rather than re-writing the whole file. Once enough of these delta
+            records have accumulated, the file is compacted back into a single snapshot. This
+            makes frequent small changes very cheap to save even when the file as a whole has
+            grown large, at the cost of the file temporarily containing some stale records.
         */
         StorageFormat storageFormat;
 
@@ -238,15 +246,21 @@ private:
     Options options;
     bool loadedOk = false, needsWriting = false;
 
+    StringPairArray lastSavedProperties;
+    int numJournalledChanges = 0;
+    bool journalIsValid = false;
+
     using ProcessScopedLock = const std::unique_ptr<InterProcessLock::ScopedLockType>;
     InterProcessLock::ScopedLockType* createProcessLock() const;
 
     void timerCallback() override;
     bool saveAsXml();
     bool saveAsBinary();
+    bool saveAsJournal();
     bool loadAsXml();
     bool loadAsBinary();
     bool loadAsBinary (InputStream&);
+    bool loadAsJournal (InputStream&);
     bool writeToStream (OutputStream&);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PropertiesFile)
@@ -37,6 +37,7 @@
 #include "values/juce_Value.cpp"
 #include "values/juce_ValueTree.cpp"
 #include "values/juce_ValueTreeSynchroniser.cpp"
+#include "values/juce_ValueTreeDeltaSerialiser.cpp"
 #include "values/juce_CachedValue.cpp"
 #include "undomanager/juce_UndoManager.cpp"
 #include "app_properties/juce_ApplicationProperties.cpp"
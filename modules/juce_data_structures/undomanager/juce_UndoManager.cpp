@@ -31,6 +31,73 @@ struct UndoManager::ActionSet
     ActionSet (const String& transactionName)  : name (transactionName)
     {}
 
+    ~ActionSet()
+    {
+        for (auto* a : actions)
+            destroyAction (a);
+    }
+
+    //==============================================================================
+    /* A chunked bump-allocator which holds the storage for actions created with
+       the templated UndoManager::perform(). All of its blocks are released
+       wholesale when the set leaves the undo history, so gesture-heavy editing
+       doesn't produce an individual heap allocation per action.
+    */
+    struct Arena
+    {
+        void* allocate (size_t numBytes, size_t alignment)
+        {
+            if (auto* b = blocks.getLast())
+            {
+                auto offset = (b->numBytesUsed + alignment - 1) & ~(alignment - 1);
+
+                if (offset + numBytes <= b->size)
+                {
+                    b->numBytesUsed = offset + numBytes;
+                    return b->data + offset;
+                }
+            }
+
+            auto* b = blocks.add (new Block (jmax ((size_t) defaultBlockSize, numBytes)));
+            b->numBytesUsed = numBytes;
+            return b->data;
+        }
+
+        bool contains (const void* p) const noexcept
+        {
+            auto* c = static_cast<const char*> (p);
+
+            for (auto* b : blocks)
+                if (c >= b->data && c < b->data + b->size)
+                    return true;
+
+            return false;
+        }
+
+        enum { defaultBlockSize = 4096 };
+
+        struct Block
+        {
+            explicit Block (size_t sizeToUse)  : data (sizeToUse), size (sizeToUse) {}
+
+            HeapBlock<char> data;
+            size_t size, numBytesUsed = 0;
+        };
+
+        OwnedArray<Block> blocks;
+    };
+
+    void destroyAction (UndoableAction* action) const
+    {
+        // actions that live in the arena just get their destructor called - their
+        // memory is reclaimed when the whole set is thrown away
+        if (arena.contains (action))
+            action->~UndoableAction();
+        else
+            delete action;
+    }
+
+    //==============================================================================
     bool perform() const
     {
         for (auto* a : actions)
@@ -59,9 +126,15 @@ struct UndoManager::ActionSet
         return total;
     }
 
-    OwnedArray<UndoableAction> actions;
+    bool isPagedOut() const noexcept   { return pageOffset >= 0; }
+
+    Array<UndoableAction*> actions;
+    Arena arena;
     String name;
     Time time { Time::getCurrentTime() };
+    int64 pageOffset = -1;
+
+    JUCE_DECLARE_NON_COPYABLE (ActionSet)
 };
 
 //==============================================================================
@@ -80,6 +153,15 @@ void UndoManager::clearUndoHistory()
     transactions.clear();
     totalUnitsStored = 0;
     nextIndex = 0;
+
+    if (pagingStream != nullptr)
+    {
+        // reclaim the space taken up by the paged-out transactions
+        pagedData.reset();
+        pagingStream->setPosition (0);
+        pagingStream->truncate();
+    }
+
     sendChangeMessage();
 }
 
@@ -133,6 +215,7 @@ bool UndoManager::perform (UndoableAction* newAction)
                     {
                         action.reset (coalescedAction);
                         totalUnitsStored -= lastAction->getSizeInUnits();
+                        actionSet->destroyAction (lastAction);
                         actionSet->actions.removeLast();
                     }
                 }
@@ -145,7 +228,7 @@ bool UndoManager::perform (UndoableAction* newAction)
             }
 
             totalUnitsStored += action->getSizeInUnits();
-            actionSet->actions.add (std::move (action));
+            actionSet->actions.add (action.release());
             newTransaction = false;
 
             moveFutureTransactionsToStash();
@@ -158,6 +241,73 @@ bool UndoManager::perform (UndoableAction* newAction)
     return false;
 }
 
+void* UndoManager::allocateActionSpace (size_t numBytes, size_t alignment)
+{
+    if (isPerformingUndoRedo())
+    {
+        jassertfalse;  // Don't call perform() recursively from the UndoableAction::perform()
+                       // or undo() methods, or else these actions will be discarded!
+        return nullptr;
+    }
+
+    auto* actionSet = getCurrentSet();
+
+    if (actionSet == nullptr || newTransaction)
+    {
+        // the set has to exist before the action can be built inside its arena; if
+        // the action then fails to perform, performArenaAllocatedAction() removes
+        // the empty set again
+        actionSet = new ActionSet (newTransactionName);
+        transactions.insert (nextIndex, actionSet);
+        ++nextIndex;
+    }
+
+    return actionSet->arena.allocate (numBytes, alignment);
+}
+
+bool UndoManager::performArenaAllocatedAction (UndoableAction* action)
+{
+    auto* actionSet = getCurrentSet();
+    jassert (actionSet != nullptr);  // allocateActionSpace() must have been called first!
+
+    if (action->perform())
+    {
+        if (! newTransaction)
+        {
+            if (auto* lastAction = actionSet->actions.getLast())
+            {
+                if (auto coalescedAction = lastAction->createCoalescedAction (action))
+                {
+                    actionSet->destroyAction (action);
+                    action = coalescedAction;
+                    totalUnitsStored -= lastAction->getSizeInUnits();
+                    actionSet->destroyAction (lastAction);
+                    actionSet->actions.removeLast();
+                }
+            }
+        }
+
+        totalUnitsStored += action->getSizeInUnits();
+        actionSet->actions.add (action);
+        newTransaction = false;
+
+        moveFutureTransactionsToStash();
+        dropOldTransactionsIfTooLarge();
+        sendChangeMessage();
+        return true;
+    }
+
+    actionSet->destroyAction (action);
+
+    if (actionSet->actions.isEmpty())
+    {
+        transactions.removeObject (actionSet);
+        --nextIndex;
+    }
+
+    return false;
+}
+
 void UndoManager::moveFutureTransactionsToStash()
 {
     if (nextIndex < transactions.size())
@@ -192,6 +342,12 @@ void UndoManager::restoreStashedFutureTransactions()
 
 void UndoManager::dropOldTransactionsIfTooLarge()
 {
+    if (isHistoryPagingEnabled())
+    {
+        pageOutColdTransactions();
+        return;
+    }
+
     while (nextIndex > 0
             && totalUnitsStored > maxNumUnitsToKeep
             && transactions.size() > minimumTransactionsToKeep)
@@ -206,6 +362,177 @@ void UndoManager::dropOldTransactionsIfTooLarge()
     }
 }
 
+//==============================================================================
+bool UndoManager::enableHistoryPaging (std::function<UndoableAction* (InputStream&)> actionLoader)
+{
+    jassert (actionLoader != nullptr);
+
+    disableHistoryPaging();
+
+    auto file = std::make_unique<TemporaryFile> (".undohistory");
+    auto stream = std::make_unique<FileOutputStream> (file->getFile());
+
+    if (stream->failedToOpen())
+        return false;
+
+    pagingFile = std::move (file);
+    pagingStream = std::move (stream);
+    pagedActionLoader = std::move (actionLoader);
+
+    pageOutColdTransactions();
+    return true;
+}
+
+void UndoManager::disableHistoryPaging()
+{
+    if (! isHistoryPagingEnabled())
+        return;
+
+    auto rehydrateAll = [this] (OwnedArray<ActionSet>& sets, bool adjustNextIndex)
+    {
+        for (int i = sets.size(); --i >= 0;)
+        {
+            auto* s = sets.getUnchecked (i);
+
+            if (s->isPagedOut() && ! rehydrateTransaction (*s))
+            {
+                sets.remove (i);
+
+                if (adjustNextIndex && i < nextIndex)
+                    --nextIndex;
+            }
+        }
+    };
+
+    rehydrateAll (transactions, true);
+    rehydrateAll (stashedFutureTransactions, false);
+
+    pagedActionLoader = nullptr;
+    pagedData.reset();
+    pagingStream.reset();
+    pagingFile.reset();
+}
+
+bool UndoManager::isHistoryPagingEnabled() const noexcept
+{
+    return pagingStream != nullptr;
+}
+
+void UndoManager::pageOutColdTransactions()
+{
+    if (! isHistoryPagingEnabled())
+        return;
+
+    // Walks inwards from both ends of the history towards the current
+    // position, so that the transactions which an undo or redo would reach
+    // soonest are the last to be paged out
+    int lo = 0, hi = transactions.size() - 1;
+    auto current = nextIndex - 1;
+
+    while (totalUnitsStored > maxNumUnitsToKeep)
+    {
+        int index;
+
+        if (lo < current && (current - lo) >= (hi - current))
+            index = lo++;
+        else if (hi > current)
+            index = hi--;
+        else
+            break;
+
+        if (auto* s = transactions[index])
+            if (! s->isPagedOut())
+                pageOutTransaction (*s);
+    }
+}
+
+bool UndoManager::pageOutTransaction (ActionSet& set)
+{
+    MemoryOutputStream record;
+    record.writeInt (set.actions.size());
+
+    for (auto* a : set.actions)
+    {
+        MemoryOutputStream blob;
+
+        if (! a->writeToStream (blob))
+            return false;  // the set contains an unserializable action, so it has to stay resident
+
+        record.writeInt64 ((int64) blob.getDataSize());
+        record.write (blob.getData(), blob.getDataSize());
+    }
+
+    auto offset = pagingStream->getPosition();
+
+    if (! pagingStream->write (record.getData(), record.getDataSize()))
+        return false;
+
+    pagingStream->flush();
+
+    totalUnitsStored -= set.getTotalSize();
+
+    for (auto* a : set.actions)
+        set.destroyAction (a);
+
+    set.actions.clearQuick();
+    set.arena.blocks.clear();
+    set.pageOffset = offset;
+    return true;
+}
+
+bool UndoManager::rehydrateTransaction (ActionSet& set)
+{
+    if (! set.isPagedOut())
+        return true;
+
+    jassert (isHistoryPagingEnabled());
+
+    pagingStream->flush();
+    auto fileSize = pagingStream->getPosition();
+
+    if (pagedData == nullptr || (int64) pagedData->getSize() < fileSize)
+        pagedData = std::make_unique<MemoryMappedFile> (pagingFile->getFile(), MemoryMappedFile::readOnly);
+
+    if (pagedData->getData() == nullptr || set.pageOffset >= fileSize)
+        return false;
+
+    MemoryInputStream record (addBytesToPointer (pagedData->getData(), set.pageOffset),
+                              (size_t) (fileSize - set.pageOffset), false);
+
+    auto numActions = record.readInt();
+    Array<UndoableAction*> loaded;
+
+    for (int i = 0; i < numActions; ++i)
+    {
+        auto blobSize = record.readInt64();
+        auto* blobData = static_cast<const char*> (record.getData()) + record.getPosition();
+
+        UndoableAction* action = nullptr;
+
+        if (blobSize >= 0 && record.getPosition() + blobSize <= (int64) record.getDataSize())
+        {
+            MemoryInputStream blob (blobData, (size_t) blobSize, false);
+            action = pagedActionLoader (blob);
+        }
+
+        if (action == nullptr)
+        {
+            for (auto* a : loaded)
+                delete a;
+
+            return false;
+        }
+
+        loaded.add (action);
+        record.setPosition (record.getPosition() + blobSize);
+    }
+
+    set.actions.swapWith (loaded);
+    set.pageOffset = -1;
+    totalUnitsStored += set.getTotalSize();
+    return true;
+}
+
 void UndoManager::beginNewTransaction()
 {
     beginNewTransaction ({});
@@ -246,12 +573,23 @@ bool UndoManager::undo()
 {
     if (auto* s = getCurrentSet())
     {
+        if (! rehydrateTransaction (*s))
+        {
+            clearUndoHistory();
+            return false;
+        }
+
         const ScopedValueSetter<bool> setter (isInsideUndoRedoCall, true);
 
         if (s->undo())
+        {
             --nextIndex;
+            pageOutColdTransactions();
+        }
         else
+        {
             clearUndoHistory();
+        }
 
         beginNewTransaction();
         sendChangeMessage();
@@ -265,12 +603,23 @@ bool UndoManager::redo()
 {
     if (auto* s = getNextSet())
     {
+        if (! rehydrateTransaction (*s))
+        {
+            clearUndoHistory();
+            return false;
+        }
+
         const ScopedValueSetter<bool> setter (isInsideUndoRedoCall, true);
 
         if (s->perform())
+        {
             ++nextIndex;
+            pageOutColdTransactions();
+        }
         else
+        {
             clearUndoHistory();
+        }
 
         beginNewTransaction();
         sendChangeMessage();
@@ -366,4 +715,233 @@ int UndoManager::getNumActionsInCurrentTransaction() const
     return 0;
 }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class UndoManagerTests  : public UnitTest
+{
+public:
+    UndoManagerTests()
+        : UnitTest ("UndoManager", UnitTestCategories::values)
+    {}
+
+    struct TestState
+    {
+        int value = 0;
+        int numLiveActions = 0;
+    };
+
+    struct AddValueAction  : public UndoableAction
+    {
+        AddValueAction (TestState& s, int amountToAdd, bool shouldSucceed = true)
+            : state (s), amount (amountToAdd), succeeds (shouldSucceed)
+        {
+            ++state.numLiveActions;
+        }
+
+        ~AddValueAction() override       { --state.numLiveActions; }
+
+        bool perform() override          { if (! succeeds) return false; state.value += amount; return true; }
+        bool undo() override             { state.value -= amount; return true; }
+        int getSizeInUnits() override    { return 10; }
+
+        TestState& state;
+        int amount;
+        bool succeeds;
+    };
+
+    struct SerializableAddAction  : public AddValueAction
+    {
+        using AddValueAction::AddValueAction;
+
+        bool writeToStream (OutputStream& stream) override
+        {
+            stream.writeInt (amount);
+            return true;
+        }
+    };
+
+    static std::function<UndoableAction* (InputStream&)> getActionLoader (TestState& state)
+    {
+        return [&state] (InputStream& stream) -> UndoableAction*
+        {
+            return new SerializableAddAction (state, stream.readInt());
+        };
+    }
+
+    void runTest() override
+    {
+        beginTest ("arena-allocated actions");
+        {
+            TestState state;
+            UndoManager um;
+
+            for (int transaction = 0; transaction < 10; ++transaction)
+            {
+                um.beginNewTransaction();
+
+                for (int i = 0; i < 50; ++i)
+                    expect (um.perform<AddValueAction> (state, 1));
+            }
+
+            expectEquals (state.value, 500);
+            expectEquals (um.getNumActionsInCurrentTransaction(), 50);
+
+            while (um.canUndo())
+                expect (um.undo());
+
+            expectEquals (state.value, 0);
+
+            while (um.canRedo())
+                expect (um.redo());
+
+            expectEquals (state.value, 500);
+
+            um.clearUndoHistory();
+            expectEquals (state.numLiveActions, 0);
+        }
+
+        beginTest ("mixing arena and heap actions");
+        {
+            TestState state;
+            UndoManager um;
+
+            um.beginNewTransaction();
+            expect (um.perform (new AddValueAction (state, 1)));
+            expect (um.perform<AddValueAction> (state, 2));
+            expect (um.perform (new AddValueAction (state, 4)));
+
+            expectEquals (state.value, 7);
+            expect (um.undo());
+            expectEquals (state.value, 0);
+            expect (um.redo());
+            expectEquals (state.value, 7);
+
+            um.clearUndoHistory();
+            expectEquals (state.numLiveActions, 0);
+        }
+
+        beginTest ("failed arena actions leave no trace");
+        {
+            TestState state;
+            UndoManager um;
+
+            um.beginNewTransaction();
+            expect (! um.perform<AddValueAction> (state, 1, false));
+            expect (! um.canUndo());
+            expectEquals (state.numLiveActions, 0);
+
+            expect (um.perform<AddValueAction> (state, 3));
+            expect (! um.perform<AddValueAction> (state, 1, false));
+
+            expectEquals (state.value, 3);
+            expect (um.undo());
+            expectEquals (state.value, 0);
+            expect (! um.canUndo());
+
+            um.clearUndoHistory();
+            expectEquals (state.numLiveActions, 0);
+        }
+
+        beginTest ("paging cold transactions to disk");
+        {
+            TestState state;
+            UndoManager um (100, 1);
+
+            expect (um.enableHistoryPaging (getActionLoader (state)));
+
+            for (int t = 0; t < 40; ++t)
+            {
+                um.beginNewTransaction();
+
+                // mix heap and arena allocated actions, so both get paged
+                if ((t & 1) == 0)
+                    expect (um.perform (new SerializableAddAction (state, t + 1)));
+                else
+                    expect (um.perform<SerializableAddAction> (state, t + 1));
+            }
+
+            expectEquals (state.value, 820);
+            expect (um.getNumberOfUnitsTakenUpByStoredCommands() <= 100);
+            expect (state.numLiveActions < 40);  // the cold actions should have left memory
+
+            int numUndos = 0;
+
+            while (um.canUndo())
+            {
+                expect (um.undo());
+                ++numUndos;
+            }
+
+            expectEquals (numUndos, 40);  // the full history should still be reachable
+            expectEquals (state.value, 0);
+
+            while (um.canRedo())
+                expect (um.redo());
+
+            expectEquals (state.value, 820);
+
+            um.clearUndoHistory();
+            expectEquals (state.numLiveActions, 0);
+        }
+
+        beginTest ("unserializable transactions stay resident");
+        {
+            TestState state;
+            UndoManager um (100, 1);
+
+            expect (um.enableHistoryPaging (getActionLoader (state)));
+
+            for (int t = 0; t < 30; ++t)
+            {
+                um.beginNewTransaction();
+
+                // plain AddValueActions can't be paged, so these transactions
+                // must survive in memory instead
+                if (t % 10 == 5)
+                    expect (um.perform (new AddValueAction (state, 1000)));
+                else
+                    expect (um.perform (new SerializableAddAction (state, 1)));
+            }
+
+            expectEquals (state.value, 3027);
+
+            while (um.canUndo())
+                expect (um.undo());
+
+            expectEquals (state.value, 0);
+        }
+
+        beginTest ("disabling paging rehydrates the history");
+        {
+            TestState state;
+            UndoManager um (100, 1);
+
+            expect (um.enableHistoryPaging (getActionLoader (state)));
+
+            for (int t = 0; t < 25; ++t)
+            {
+                um.beginNewTransaction();
+                expect (um.perform (new SerializableAddAction (state, t + 1)));
+            }
+
+            expect (state.numLiveActions < 25);
+
+            um.disableHistoryPaging();
+            expectEquals (state.numLiveActions, 25);
+
+            while (um.canUndo())
+                expect (um.undo());
+
+            expectEquals (state.value, 0);
+        }
+    }
+};
+
+static UndoManagerTests undoManagerTests;
+
+#endif
+
 } // namespace juce
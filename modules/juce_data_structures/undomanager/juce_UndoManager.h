@@ -119,6 +119,30 @@ public:
     */
     bool perform (UndoableAction* action, const String& actionName);
 
+    /** Constructs an action inside the current transaction's storage and performs it.
+
+        This behaves like calling perform (new ActionType (actionArgs...)), except
+        that the action is bump-allocated from an arena belonging to the current
+        transaction rather than being individually heap-allocated, and its memory
+        is released wholesale when the transaction leaves the undo history.
+
+        For operations that generate a large number of small actions, such as
+        dragging automation points, this greatly reduces allocator traffic and
+        fragmentation. Arena-allocated and heap-allocated actions can be freely
+        mixed within the same transaction.
+
+        @returns true if the command succeeds - see UndoableAction::perform
+        @see perform, beginNewTransaction
+    */
+    template <typename ActionType, typename... Args>
+    bool perform (Args&&... actionArgs)
+    {
+        if (auto* space = allocateActionSpace (sizeof (ActionType), alignof (ActionType)))
+            return performArenaAllocatedAction (new (space) ActionType (std::forward<Args> (actionArgs)...));
+
+        return false;
+    }
+
     /** Starts a new group of actions that together will be treated as a single transaction.
 
         All actions that are passed to the perform() method between calls to this
@@ -245,6 +269,43 @@ public:
     /** Returns true if the caller code is in the middle of an undo or redo action. */
     bool isPerformingUndoRedo() const;
 
+    //==============================================================================
+    /** Enables paging of cold transactions to a temporary scratch file on disk.
+
+        Normally, when the stored actions exceed the limit set by
+        setMaxNumberOfStoredUnits(), the oldest transactions are simply thrown
+        away. With paging enabled, transactions furthest from the current undo
+        position are instead serialized to a memory-mapped scratch file and
+        destroyed, and are transparently reloaded when an undo or redo reaches
+        them - so an effectively unlimited history fits within the in-memory
+        budget set by setMaxNumberOfStoredUnits().
+
+        Only actions which override UndoableAction::writeToStream() can be paged
+        out; transactions containing any unserializable action stay resident and
+        continue to count against the memory budget. The actionLoader function
+        you supply is called to rebuild each action from the bytes its
+        writeToStream() wrote, and should return nullptr on failure (which will
+        clear the undo history, just like a failed undo).
+
+        The scratch file is created in the system's temporary directory and is
+        deleted when paging is disabled or the UndoManager is destroyed.
+
+        @returns false if the scratch file couldn't be created
+        @see disableHistoryPaging, UndoableAction::writeToStream
+    */
+    bool enableHistoryPaging (std::function<UndoableAction* (InputStream&)> actionLoader);
+
+    /** Reloads any paged-out transactions into memory, deletes the scratch file,
+        and reverts to the normal policy of dropping old transactions.
+
+        Any paged transaction that fails to reload is removed from the history.
+        @see enableHistoryPaging
+    */
+    void disableHistoryPaging();
+
+    /** Returns true if enableHistoryPaging() has been called successfully. */
+    bool isHistoryPagingEnabled() const noexcept;
+
 private:
     //==============================================================================
     struct ActionSet;
@@ -254,9 +315,18 @@ private:
     bool newTransaction = true, isInsideUndoRedoCall = false;
     ActionSet* getCurrentSet() const;
     ActionSet* getNextSet() const;
+    void* allocateActionSpace (size_t numBytes, size_t alignment);
+    bool performArenaAllocatedAction (UndoableAction* action);
+    std::function<UndoableAction* (InputStream&)> pagedActionLoader;
+    std::unique_ptr<TemporaryFile> pagingFile;
+    std::unique_ptr<FileOutputStream> pagingStream;
+    std::unique_ptr<MemoryMappedFile> pagedData;
     void moveFutureTransactionsToStash();
     void restoreStashedFutureTransactions();
     void dropOldTransactionsIfTooLarge();
+    void pageOutColdTransactions();
+    bool pageOutTransaction (ActionSet&);
+    bool rehydrateTransaction (ActionSet&);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (UndoManager)
 };
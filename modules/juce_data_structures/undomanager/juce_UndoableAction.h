@@ -95,6 +95,20 @@ public:
         If it's not possible to merge the two actions, the method should return a nullptr.
     */
     virtual UndoableAction* createCoalescedAction (UndoableAction* nextAction)  { ignoreUnused (nextAction); return nullptr; }
+
+    /** Writes a description of this action to a stream, so that an UndoManager with
+        history paging enabled can move it out of memory and into a scratch file.
+
+        The default implementation returns false, which marks the action as
+        unserializable - transactions containing such an action will simply stay
+        resident in memory. To support paging, write whatever data the action needs
+        to be reconstructed and return true; the loader function passed to
+        UndoManager::enableHistoryPaging() will later be handed a stream containing
+        exactly these bytes and must recreate an equivalent action from them.
+
+        @see UndoManager::enableHistoryPaging
+    */
+    virtual bool writeToStream (OutputStream& stream)  { ignoreUnused (stream); return false; }
 };
 
 } // namespace juce
@@ -44,6 +44,19 @@ public:
         }
     }
 
+    struct SnapshotTag {};
+
+    SharedObject (const SharedObject& other, SnapshotTag)
+        : ReferenceCountedObject(), type (other.type), properties (other.properties), isSnapshotObject (true)
+    {
+        for (auto* c : other.children)
+        {
+            auto* child = new SharedObject (*c, SnapshotTag());
+            child->parent = this;
+            children.add (child);
+        }
+    }
+
     SharedObject& operator= (const SharedObject&) = delete;
 
     ~SharedObject()
@@ -132,6 +145,9 @@ public:
     void setProperty (const Identifier& name, const var& newValue, UndoManager* undoManager,
                       ValueTree::Listener* listenerToExclude = nullptr)
     {
+        if (! canBeModified())
+            return;
+
         if (undoManager == nullptr)
         {
             if (properties.set (name, newValue))
@@ -160,6 +176,9 @@ public:
 
     void removeProperty (const Identifier& name, UndoManager* undoManager)
     {
+        if (! canBeModified())
+            return;
+
         if (undoManager == nullptr)
         {
             if (properties.remove (name))
@@ -174,6 +193,9 @@ public:
 
     void removeAllProperties (UndoManager* undoManager)
     {
+        if (! canBeModified())
+            return;
+
         if (undoManager == nullptr)
         {
             while (properties.size() > 0)
@@ -246,6 +268,9 @@ public:
 
     void addChild (SharedObject* child, int index, UndoManager* undoManager)
     {
+        if (! canBeModified())
+            return;
+
         if (child != nullptr && child->parent != this)
         {
             if (child != this && ! isAChildOf (child))
@@ -287,6 +312,9 @@ public:
 
     void removeChild (int childIndex, UndoManager* undoManager)
     {
+        if (! canBeModified())
+            return;
+
         if (auto child = Ptr (children.getObjectPointer (childIndex)))
         {
             if (undoManager == nullptr)
@@ -311,6 +339,9 @@ public:
 
     void moveChild (int currentIndex, int newIndex, UndoManager* undoManager)
     {
+        if (! canBeModified())
+            return;
+
         // The source index must be a valid index!
         jassert (isPositiveAndBelow (currentIndex, children.size()));
 
@@ -564,12 +595,21 @@ public:
         JUCE_DECLARE_NON_COPYABLE (MoveChildAction)
     };
 
+    bool canBeModified() const
+    {
+        // Trees created by ValueTree::createSnapshot() are immutable -
+        // trying to modify one is almost certainly a mistake!
+        jassert (! isSnapshotObject);
+        return ! isSnapshotObject;
+    }
+
     //==============================================================================
     const Identifier type;
     NamedValueSet properties;
     ReferenceCountedArray<SharedObject> children;
     SortedSet<ValueTree*> valueTreesWithListeners;
     SharedObject* parent = nullptr;
+    const bool isSnapshotObject = false;
 
     JUCE_LEAK_DETECTOR (SharedObject)
 };
@@ -665,6 +705,47 @@ ValueTree ValueTree::createCopy() const
     return {};
 }
 
+ValueTree ValueTree::createSnapshot() const
+{
+    if (object != nullptr)
+        return ValueTree (*new SharedObject (*object, SharedObject::SnapshotTag()));
+
+    return {};
+}
+
+bool ValueTree::isSnapshot() const noexcept
+{
+    return object != nullptr && object->isSnapshotObject;
+}
+
+//==============================================================================
+ValueTree::SnapshotExchange::~SnapshotExchange()
+{
+    delete pending.exchange (nullptr);
+    delete retired.exchange (nullptr);
+}
+
+void ValueTree::SnapshotExchange::publish (const ValueTree& tree)
+{
+    // Free anything the reader has finished with, then hand it the new snapshot.
+    delete retired.exchange (nullptr);
+    delete pending.exchange (new ValueTree (tree.createSnapshot()));
+}
+
+ValueTree ValueTree::SnapshotExchange::getLatestSnapshot() noexcept
+{
+    if (auto* fresh = pending.exchange (nullptr))
+    {
+        // The retired slot is always empty at this point: the publish() call that
+        // provided this snapshot will have cleared it, and only this method fills it.
+        auto* old = retired.exchange (current.release());
+        jassertquiet (old == nullptr);
+        current.reset (fresh);
+    }
+
+    return current != nullptr ? *current : ValueTree();
+}
+
 void ValueTree::copyPropertiesFrom (const ValueTree& source, UndoManager* undoManager)
 {
     jassert (object != nullptr || source.object == nullptr); // Trying to add properties to a null ValueTree will fail!
@@ -1241,6 +1322,59 @@ public:
                 expectEquals (lines[numLines - 1], "<Test number=\"" + test.second + "\"/>");
             }
         }
+
+        {
+            beginTest ("Snapshots");
+
+            auto r = getRandom();
+
+            for (int i = 5; --i >= 0;)
+            {
+                auto original = createRandomTree (nullptr, 0, r);
+                auto snapshot = original.createSnapshot();
+
+                expect (snapshot.isSnapshot());
+                expect (! original.isSnapshot());
+                expect (original.isEquivalentTo (snapshot));
+
+                for (auto child : snapshot)
+                    expect (child.isSnapshot());
+
+                // modifying the original mustn't be visible in the snapshot
+                auto reference = original.createCopy();
+                original.setProperty ("newProperty", 123, nullptr);
+                original.addChild (ValueTree ("NewChild"), -1, nullptr);
+                original.removeAllProperties (nullptr);
+
+                expect (reference.isEquivalentTo (snapshot));
+                expect (! original.isEquivalentTo (snapshot));
+            }
+        }
+
+        {
+            beginTest ("SnapshotExchange");
+
+            auto r = getRandom();
+            ValueTree::SnapshotExchange exchange;
+
+            expect (! exchange.getLatestSnapshot().isValid());
+
+            auto tree = createRandomTree (nullptr, 0, r);
+            exchange.publish (tree);
+
+            auto snapshot = exchange.getLatestSnapshot();
+            expect (snapshot.isSnapshot());
+            expect (snapshot.isEquivalentTo (tree));
+
+            // calling again without a new publish must return the same snapshot
+            expect (exchange.getLatestSnapshot() == snapshot);
+
+            tree.setProperty ("updated", true, nullptr);
+            exchange.publish (tree);
+            exchange.publish (tree); // overwriting an unclaimed snapshot must also work
+
+            expect (exchange.getLatestSnapshot().isEquivalentTo (tree));
+        }
     }
 };
 
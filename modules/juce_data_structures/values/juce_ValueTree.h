@@ -176,6 +176,72 @@ public:
     /** Returns a deep copy of this tree and all its sub-trees. */
     ValueTree createCopy() const;
 
+    /** Returns an immutable deep copy of this tree and all its sub-trees.
+
+        Snapshots behave exactly like a normal tree for all read operations, but any
+        attempt to modify one is a no-op (and will trigger an assertion in a debug
+        build). Because nothing can ever change a snapshot, it's safe to read it from
+        another thread without any locking, while the original tree continues to be
+        edited - the property values themselves are shared with the original via
+        reference-counting, so taking a snapshot doesn't duplicate any string or
+        binary data.
+
+        Note that taking the snapshot itself must be done on the thread that owns the
+        source tree - use a SnapshotExchange to pass the result to a real-time thread.
+
+        @see isSnapshot, SnapshotExchange
+    */
+    ValueTree createSnapshot() const;
+
+    /** Returns true if this tree is an immutable snapshot created by createSnapshot(). */
+    bool isSnapshot() const noexcept;
+
+    //==============================================================================
+    /**
+        Passes immutable ValueTree snapshots from a thread that edits a tree to a
+        real-time thread that only reads it.
+
+        The writing thread calls publish() whenever the tree has changed, and the
+        reading thread calls getLatestSnapshot() whenever it wants the most recent
+        state. getLatestSnapshot() never locks, allocates or frees anything, so it's
+        safe to call from an audio callback; all allocation and deletion happens in
+        publish(). There must be no more than one reader thread and one writer thread.
+
+        @see ValueTree::createSnapshot
+
+        @tags{DataStructures}
+    */
+    class JUCE_API  SnapshotExchange
+    {
+    public:
+        SnapshotExchange() = default;
+        ~SnapshotExchange();
+
+        /** Takes a snapshot of the given tree and makes it available to the reading
+            thread, discarding any previously-published snapshot that the reader
+            hasn't picked up yet.
+
+            This allocates and may delete old snapshots, so call it from your normal
+            message or data thread, never from the real-time thread.
+        */
+        void publish (const ValueTree& tree);
+
+        /** Returns the most recently published snapshot, or an invalid tree if
+            nothing has been published yet.
+
+            This is lock-free and never allocates or deletes, so it's safe to call
+            from a real-time thread. The returned tree remains valid until the next
+            call to this method.
+        */
+        ValueTree getLatestSnapshot() noexcept;
+
+    private:
+        std::atomic<ValueTree*> pending { nullptr }, retired { nullptr };
+        std::unique_ptr<ValueTree> current;
+
+        JUCE_DECLARE_NON_COPYABLE (SnapshotExchange)
+    };
+
     /** Overwrites all the properties in this tree with the properties of the source tree.
         Any properties that already exist will be updated; and new ones will be added, and
         any that are not present in the source tree will be removed.
@@ -0,0 +1,330 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace ValueTreeDeltaSerialiserHelpers
+{
+    enum RecordType
+    {
+        endOfDelta         = 0,
+        subtreeReplaced    = 1,
+        propertiesReplaced = 2
+    };
+
+    static void writePath (OutputStream& output, ValueTree v, const ValueTree& topLevelTree)
+    {
+        Array<int> path;
+
+        while (v != topLevelTree)
+        {
+            ValueTree parent (v.getParent());
+
+            if (! parent.isValid())
+                break;
+
+            path.add (parent.indexOf (v));
+            v = parent;
+        }
+
+        output.writeCompressedInt (path.size());
+
+        for (int i = path.size(); --i >= 0;)
+            output.writeCompressedInt (path.getUnchecked (i));
+    }
+
+    static ValueTree readPath (InputStream& input, ValueTree v)
+    {
+        const int numLevels = input.readCompressedInt();
+
+        if (! isPositiveAndBelow (numLevels, 65536)) // sanity-check
+            return {};
+
+        for (int i = numLevels; --i >= 0;)
+        {
+            const int index = input.readCompressedInt();
+
+            if (! isPositiveAndBelow (index, v.getNumChildren()))
+                return {};
+
+            v = v.getChild (index);
+        }
+
+        return v;
+    }
+}
+
+ValueTreeDeltaSerialiser::ValueTreeDeltaSerialiser (const ValueTree& treeToTrack)  : valueTree (treeToTrack)
+{
+    valueTree.addListener (this);
+}
+
+ValueTreeDeltaSerialiser::~ValueTreeDeltaSerialiser()
+{
+    valueTree.removeListener (this);
+}
+
+bool ValueTreeDeltaSerialiser::hasPendingChanges() const noexcept
+{
+    return ! (dirtySubtrees.isEmpty() && dirtyProperties.isEmpty());
+}
+
+void ValueTreeDeltaSerialiser::clearPendingChanges() noexcept
+{
+    dirtySubtrees.clearQuick();
+    dirtyProperties.clearQuick();
+}
+
+bool ValueTreeDeltaSerialiser::isInsideDirtySubtree (ValueTree v) const
+{
+    for (; v.isValid(); v = v.getParent())
+        if (dirtySubtrees.contains (v))
+            return true;
+
+    return false;
+}
+
+void ValueTreeDeltaSerialiser::markSubtreeDirty (ValueTree v)
+{
+    if (isInsideDirtySubtree (v))
+        return;
+
+    for (int i = dirtySubtrees.size(); --i >= 0;)
+        if (dirtySubtrees.getReference (i).isAChildOf (v))
+            dirtySubtrees.remove (i);
+
+    for (int i = dirtyProperties.size(); --i >= 0;)
+        if (dirtyProperties.getReference (i) == v || dirtyProperties.getReference (i).isAChildOf (v))
+            dirtyProperties.remove (i);
+
+    dirtySubtrees.add (v);
+}
+
+void ValueTreeDeltaSerialiser::valueTreePropertyChanged (ValueTree& vt, const Identifier&)
+{
+    if (! isInsideDirtySubtree (vt))
+        dirtyProperties.addIfNotAlreadyThere (vt);
+}
+
+void ValueTreeDeltaSerialiser::valueTreeChildAdded (ValueTree& parentTree, ValueTree&)
+{
+    markSubtreeDirty (parentTree);
+}
+
+void ValueTreeDeltaSerialiser::valueTreeChildRemoved (ValueTree& parentTree, ValueTree&, int)
+{
+    markSubtreeDirty (parentTree);
+}
+
+void ValueTreeDeltaSerialiser::valueTreeChildOrderChanged (ValueTree& parentTree, int, int)
+{
+    markSubtreeDirty (parentTree);
+}
+
+void ValueTreeDeltaSerialiser::valueTreeRedirected (ValueTree& vt)
+{
+    if (vt == valueTree)
+        markSubtreeDirty (valueTree);
+}
+
+void ValueTreeDeltaSerialiser::writeDeltaToStream (OutputStream& output)
+{
+    using namespace ValueTreeDeltaSerialiserHelpers;
+
+    for (auto& v : dirtySubtrees)
+    {
+        // skip nodes that have been detached since they were marked - their old
+        // position is covered by the subtree record for the parent they left
+        if (v != valueTree && ! v.isAChildOf (valueTree))
+            continue;
+
+        if (isInsideDirtySubtree (v.getParent()))
+            continue;
+
+        output.writeByte ((char) subtreeReplaced);
+        writePath (output, v, valueTree);
+        v.writeToStream (output);
+    }
+
+    for (auto& v : dirtyProperties)
+    {
+        if (v != valueTree && ! v.isAChildOf (valueTree))
+            continue;
+
+        if (isInsideDirtySubtree (v))
+            continue;
+
+        output.writeByte ((char) propertiesReplaced);
+        writePath (output, v, valueTree);
+
+        const int numProperties = v.getNumProperties();
+        output.writeCompressedInt (numProperties);
+
+        for (int i = 0; i < numProperties; ++i)
+        {
+            auto name = v.getPropertyName (i);
+            output.writeString (name.toString());
+            v.getProperty (name).writeToStream (output);
+        }
+    }
+
+    output.writeByte ((char) endOfDelta);
+    clearPendingChanges();
+}
+
+bool ValueTreeDeltaSerialiser::applyDelta (ValueTree& target, InputStream& input, UndoManager* undoManager)
+{
+    using namespace ValueTreeDeltaSerialiserHelpers;
+
+    for (;;)
+    {
+        const int type = input.readByte();
+
+        if (type == endOfDelta)
+            return true;
+
+        ValueTree v (readPath (input, target));
+
+        if (! v.isValid())
+            return false;
+
+        if (type == subtreeReplaced)
+        {
+            v.copyPropertiesAndChildrenFrom (ValueTree::readFromStream (input), undoManager);
+        }
+        else if (type == propertiesReplaced)
+        {
+            const int numProperties = input.readCompressedInt();
+
+            if (numProperties < 0)
+                return false;
+
+            ValueTree newProperties (v.getType());
+
+            for (int i = 0; i < numProperties; ++i)
+            {
+                Identifier name (input.readString());
+                newProperties.setProperty (name, var::readFromStream (input), nullptr);
+            }
+
+            v.copyPropertiesFrom (newProperties, undoManager);
+        }
+        else
+        {
+            jassertfalse; // Seem to have received some corrupt data?
+            return false;
+        }
+    }
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ValueTreeDeltaSerialiserTests  : public UnitTest
+{
+public:
+    ValueTreeDeltaSerialiserTests()
+        : UnitTest ("ValueTreeDeltaSerialiser", UnitTestCategories::values)
+    {}
+
+    static void mutateRandomly (ValueTree& v, Random& r, int depth)
+    {
+        for (int i = 1 + r.nextInt (4); --i >= 0;)
+        {
+            switch (r.nextInt (6))
+            {
+                case 0: v.setProperty ("p" + String (r.nextInt (8)), r.nextInt(), nullptr); break;
+                case 1: if (v.getNumProperties() > 0) v.removeProperty (v.getPropertyName (r.nextInt (v.getNumProperties())), nullptr); break;
+                case 2: if (depth < 4) v.addChild (ValueTree ("c" + String (r.nextInt (8))), r.nextInt (v.getNumChildren() + 1), nullptr); break;
+                case 3: if (v.getNumChildren() > 0) v.removeChild (r.nextInt (v.getNumChildren()), nullptr); break;
+                case 4: if (v.getNumChildren() > 1) v.moveChild (r.nextInt (v.getNumChildren()), r.nextInt (v.getNumChildren()), nullptr); break;
+                case 5: if (v.getNumChildren() > 0)
+                        {
+                            auto child = v.getChild (r.nextInt (v.getNumChildren()));
+                            mutateRandomly (child, r, depth + 1);
+                        }
+                        break;
+                default: break;
+            }
+        }
+    }
+
+    void runTest() override
+    {
+        beginTest ("delta round-trip");
+
+        auto r = getRandom();
+
+        for (int run = 20; --run >= 0;)
+        {
+            ValueTree source ("root");
+            mutateRandomly (source, r, 0);
+
+            ValueTreeDeltaSerialiser serialiser (source);
+
+            // start the destination off as a full copy of the source..
+            ValueTree copy;
+            {
+                MemoryOutputStream full;
+                source.writeToStream (full);
+                MemoryInputStream in (full.getData(), full.getDataSize(), false);
+                copy = ValueTree::readFromStream (in);
+            }
+
+            serialiser.clearPendingChanges();
+
+            // ..then check that repeated mutate/delta/apply cycles keep it in sync
+            for (int cycle = 5; --cycle >= 0;)
+            {
+                mutateRandomly (source, r, 0);
+                source.setProperty ("cycle", cycle, nullptr); // guarantees at least one real change
+                expect (serialiser.hasPendingChanges());
+
+                MemoryOutputStream delta;
+                serialiser.writeDeltaToStream (delta);
+                expect (! serialiser.hasPendingChanges());
+
+                MemoryInputStream in (delta.getData(), delta.getDataSize(), false);
+                expect (ValueTreeDeltaSerialiser::applyDelta (copy, in, nullptr));
+                expect (source.isEquivalentTo (copy));
+            }
+
+            // an untouched tree should produce an empty delta which applies cleanly
+            MemoryOutputStream emptyDelta;
+            serialiser.writeDeltaToStream (emptyDelta);
+            MemoryInputStream in (emptyDelta.getData(), emptyDelta.getDataSize(), false);
+            expect (ValueTreeDeltaSerialiser::applyDelta (copy, in, nullptr));
+            expect (source.isEquivalentTo (copy));
+        }
+    }
+};
+
+static ValueTreeDeltaSerialiserTests valueTreeDeltaSerialiserTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Tracks the parts of a ValueTree that have changed, and serialises just those
+    parts as a compact binary delta.
+
+    Unlike ValueTree::writeToStream(), which always writes the whole tree, this
+    class watches a tree and remembers which subtrees have been touched since the
+    last call to writeDeltaToStream(). The cost of writing a delta is therefore
+    proportional to the amount of data that actually changed, which makes it
+    suitable for autosaving large trees at frequent intervals.
+
+    To use it, keep an up-to-date copy of the tree at the destination: start by
+    writing the full tree once with ValueTree::writeToStream(), then periodically
+    call writeDeltaToStream() and apply each delta to the copy with applyDelta().
+
+    Unlike ValueTreeSynchroniser, which emits a message for every individual
+    change as it happens, this class coalesces repeated changes to the same
+    subtree, so the size of a delta is bounded by the amount of the tree it
+    covers rather than by the number of edits made.
+
+    @see ValueTree, ValueTreeSynchroniser
+
+    @tags{DataStructures}
+*/
+class JUCE_API  ValueTreeDeltaSerialiser  : private ValueTree::Listener
+{
+public:
+    /** Creates a serialiser that watches the given tree for changes. */
+    ValueTreeDeltaSerialiser (const ValueTree& treeToTrack);
+
+    /** Destructor. */
+    ~ValueTreeDeltaSerialiser() override;
+
+    //==============================================================================
+    /** Returns true if the tree has changed since the last call to
+        writeDeltaToStream() or clearPendingChanges().
+    */
+    bool hasPendingChanges() const noexcept;
+
+    /** Writes a binary delta covering all the changes made since the last call,
+        and clears the pending change list.
+
+        If nothing has changed, this just writes an empty (but valid) delta.
+        The data written can be applied to a copy of the tree with applyDelta().
+    */
+    void writeDeltaToStream (OutputStream& output);
+
+    /** Discards the pending change list without writing anything.
+
+        Call this after re-writing the full tree, so that the next delta is
+        relative to that snapshot.
+    */
+    void clearPendingChanges() noexcept;
+
+    //==============================================================================
+    /** Applies a delta that was created by writeDeltaToStream() to a target tree.
+
+        The target must be an up-to-date copy of the tracked tree as it was when
+        the delta was written, i.e. all earlier deltas must already have been
+        applied to it, in order.
+
+        Returns false if the stream appears to be corrupt or doesn't match the
+        structure of the target tree.
+    */
+    static bool applyDelta (ValueTree& target, InputStream& input, UndoManager* undoManager);
+
+    //==============================================================================
+    /** Returns the tree that is being observed. */
+    const ValueTree& getRoot() const noexcept           { return valueTree; }
+
+private:
+    //==============================================================================
+    ValueTree valueTree;
+    Array<ValueTree> dirtySubtrees, dirtyProperties;
+
+    void markSubtreeDirty (ValueTree);
+    bool isInsideDirtySubtree (ValueTree) const;
+
+    void valueTreePropertyChanged (ValueTree&, const Identifier&) override;
+    void valueTreeChildAdded (ValueTree&, ValueTree&) override;
+    void valueTreeChildRemoved (ValueTree&, ValueTree&, int) override;
+    void valueTreeChildOrderChanged (ValueTree&, int, int) override;
+    void valueTreeRedirected (ValueTree&) override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ValueTreeDeltaSerialiser)
+};
+
+} // namespace juce
@@ -0,0 +1,461 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+//==============================================================================
+/**
+    An AudioBlock-style view whose channel count is fixed at compile time.
+
+    Where AudioBlock carries its channel count at runtime, here the extent is a
+    template parameter, so every per-channel loop has a constant trip count that
+    the compiler can fully unroll, and the channel pointers live directly inside
+    the object instead of behind an extra indirection. For the common case of a
+    known-stereo signal path this removes all the runtime channel bookkeeping
+    from the inner loops.
+
+    Like AudioBlock, this class doesn't own the data it points to - it's just a
+    view, and the caller must keep the underlying buffer alive for as long as
+    any block refers to it.
+
+    Only a subset of AudioBlock's operations is provided here; for anything
+    else, toAudioBlock() cheaply produces an equivalent dynamic view.
+
+    @see AudioBlock, FixedChannelProcessContextReplacing
+
+    @tags{DSP}
+*/
+template <typename SampleType, size_t numChannelsAtCompileTime>
+class FixedChannelAudioBlock
+{
+private:
+    template <typename OtherSampleType>
+    using MayUseConvertingConstructor =
+        std::enable_if_t<std::is_same<std::remove_const_t<SampleType>,
+                                      std::remove_const_t<OtherSampleType>>::value
+                             && std::is_const<SampleType>::value
+                             && ! std::is_const<OtherSampleType>::value,
+                         int>;
+
+    template <typename OtherType>
+    using EnableIfBlockType = std::enable_if_t<! std::is_arithmetic<std::remove_reference_t<OtherType>>::value, int>;
+
+public:
+    //==============================================================================
+    using NumericType = typename SampleTypeHelpers::ElementType<SampleType>::Type;
+
+    static_assert (numChannelsAtCompileTime > 0, "A FixedChannelAudioBlock must have at least one channel");
+
+    //==============================================================================
+    /** Create a zero-sized FixedChannelAudioBlock. */
+    FixedChannelAudioBlock() noexcept = default;
+
+    /** Creates a FixedChannelAudioBlock from a pointer to an array of channels.
+        FixedChannelAudioBlock does not copy nor own the memory pointed to by dataToUse.
+        Therefore it is the user's responsibility to ensure that the memory is retained
+        throughout the life-time of the FixedChannelAudioBlock and released when no longer needed.
+    */
+    FixedChannelAudioBlock (SampleType* const* channelData, size_t numberOfSamples) noexcept
+        : numSamples (numberOfSamples)
+    {
+        for (size_t ch = 0; ch < numChannelsAtCompileTime; ++ch)
+            channels[ch] = channelData[ch];
+    }
+
+    /** Creates a FixedChannelAudioBlock that points to the first channels of an AudioBuffer.
+        The buffer must have at least as many channels as the compile-time extent.
+    */
+    template <typename OtherSampleType>
+    FixedChannelAudioBlock (AudioBuffer<OtherSampleType>& buffer) noexcept
+        : numSamples (static_cast<size_t> (buffer.getNumSamples()))
+    {
+        jassert (static_cast<size_t> (buffer.getNumChannels()) >= numChannelsAtCompileTime);
+
+        for (size_t ch = 0; ch < numChannelsAtCompileTime; ++ch)
+            channels[ch] = buffer.getArrayOfWritePointers()[ch];
+    }
+
+    /** Creates a FixedChannelAudioBlock that views the same data as an AudioBlock.
+        The AudioBlock's channel count must match the compile-time extent.
+    */
+    template <typename OtherSampleType>
+    explicit FixedChannelAudioBlock (AudioBlock<OtherSampleType> block) noexcept
+        : numSamples (block.getNumSamples())
+    {
+        jassert (block.getNumChannels() == numChannelsAtCompileTime);
+
+        for (size_t ch = 0; ch < numChannelsAtCompileTime; ++ch)
+            channels[ch] = block.getChannelPointer (ch);
+    }
+
+    FixedChannelAudioBlock (const FixedChannelAudioBlock& other) noexcept = default;
+    FixedChannelAudioBlock& operator= (const FixedChannelAudioBlock& other) noexcept = default;
+
+    template <typename OtherSampleType, MayUseConvertingConstructor<OtherSampleType> = 0>
+    FixedChannelAudioBlock (const FixedChannelAudioBlock<OtherSampleType, numChannelsAtCompileTime>& other) noexcept
+        : numSamples (other.numSamples)
+    {
+        for (size_t ch = 0; ch < numChannelsAtCompileTime; ++ch)
+            channels[ch] = other.channels[ch];
+    }
+
+    //==============================================================================
+    template <typename OtherSampleType>
+    bool operator== (const FixedChannelAudioBlock<OtherSampleType, numChannelsAtCompileTime>& other) const noexcept
+    {
+        return std::equal (channels.begin(), channels.end(), other.channels.begin())
+                && numSamples == other.numSamples;
+    }
+
+    template <typename OtherSampleType>
+    bool operator!= (const FixedChannelAudioBlock<OtherSampleType, numChannelsAtCompileTime>& other) const noexcept
+    {
+        return ! (*this == other);
+    }
+
+    //==============================================================================
+    /** Returns the number of channels referenced by this block. */
+    static constexpr size_t getNumChannels() noexcept         { return numChannelsAtCompileTime; }
+
+    /** Returns the number of samples referenced by this block. */
+    constexpr size_t getNumSamples() const noexcept           { return numSamples; }
+
+    /** Returns a raw pointer into one of the channels in this block. */
+    SampleType* getChannelPointer (size_t channel) const noexcept
+    {
+        jassert (channel < numChannelsAtCompileTime);
+        jassert (numSamples > 0);
+        return channels[channel];
+    }
+
+    /** Returns an AudioBlock viewing the same data as this block.
+
+        The returned block refers to this object's channel list, so it must not
+        outlive this block.
+    */
+    AudioBlock<SampleType> toAudioBlock() const noexcept
+    {
+        return { channels.data(), numChannelsAtCompileTime, numSamples };
+    }
+
+    /** Returns a sample from the buffer.
+        The channel and index are not checked - they are expected to be in-range. If not,
+        an assertion will be thrown, but in a release build, you're into 'undefined behaviour'
+        territory.
+    */
+    SampleType getSample (int channel, int sampleIndex) const noexcept
+    {
+        jassert (isPositiveAndBelow (channel, numChannelsAtCompileTime));
+        jassert (isPositiveAndBelow (sampleIndex, numSamples));
+        return channels[(size_t) channel][(size_t) sampleIndex];
+    }
+
+    /** Modifies a sample in the buffer.
+        The channel and index are not checked - they are expected to be in-range. If not,
+        an assertion will be thrown, but in a release build, you're into 'undefined behaviour'
+        territory.
+    */
+    void setSample (int destChannel, int destSample, SampleType newValue) const noexcept
+    {
+        jassert (isPositiveAndBelow (destChannel, numChannelsAtCompileTime));
+        jassert (isPositiveAndBelow (destSample, numSamples));
+        channels[(size_t) destChannel][(size_t) destSample] = newValue;
+    }
+
+    /** Adds a value to a sample in the buffer.
+        The channel and index are not checked - they are expected to be in-range. If not,
+        an assertion will be thrown, but in a release build, you're into 'undefined behaviour'
+        territory.
+    */
+    void addSample (int destChannel, int destSample, SampleType valueToAdd) const noexcept
+    {
+        jassert (isPositiveAndBelow (destChannel, numChannelsAtCompileTime));
+        jassert (isPositiveAndBelow (destSample, numSamples));
+        channels[(size_t) destChannel][(size_t) destSample] += valueToAdd;
+    }
+
+    /** Return a new block pointing to a sub-block inside this block. This
+        function does not copy the memory and you must ensure that the original memory
+        pointed to by the receiver remains valid through-out the life-time of the
+        returned sub-block.
+    */
+    FixedChannelAudioBlock getSubBlock (size_t newOffset, size_t newLength) const noexcept
+    {
+        jassert (newOffset < numSamples);
+        jassert (newOffset + newLength <= numSamples);
+
+        FixedChannelAudioBlock result;
+
+        for (size_t ch = 0; ch < numChannelsAtCompileTime; ++ch)
+            result.channels[ch] = channels[ch] + newOffset;
+
+        result.numSamples = newLength;
+        return result;
+    }
+
+    /** Return a new block pointing to a sub-block inside this block, extending
+        to the end of the receiver.
+    */
+    FixedChannelAudioBlock getSubBlock (size_t newOffset) const noexcept
+    {
+        return getSubBlock (newOffset, numSamples - newOffset);
+    }
+
+    //==============================================================================
+    /** Clears the memory referenced by this block. */
+    const FixedChannelAudioBlock& clear() const noexcept
+    {
+        for (size_t ch = 0; ch < numChannelsAtCompileTime; ++ch)
+            FloatVectorOperations::clear (channels[ch], numSamples);
+
+        return *this;
+    }
+
+    /** Fills the memory referenced by this block with value. */
+    const FixedChannelAudioBlock& JUCE_VECTOR_CALLTYPE fill (NumericType value) const noexcept
+    {
+        for (size_t ch = 0; ch < numChannelsAtCompileTime; ++ch)
+            FloatVectorOperations::fill (channels[ch], value, numSamples);
+
+        return *this;
+    }
+
+    /** Copies the values in src to this block. */
+    template <typename OtherBlockType, EnableIfBlockType<OtherBlockType> = 0>
+    const FixedChannelAudioBlock& copyFrom (const OtherBlockType& src) const noexcept
+    {
+        auto n = jmin (numSamples, src.getNumSamples());
+
+        for (size_t ch = 0; ch < numChannelsAtCompileTime; ++ch)
+            FloatVectorOperations::copy (channels[ch], src.getChannelPointer (ch), n);
+
+        return *this;
+    }
+
+    //==============================================================================
+    /** Adds a fixed value to the elements in this block. */
+    const FixedChannelAudioBlock& JUCE_VECTOR_CALLTYPE add (NumericType value) const noexcept
+    {
+        for (size_t ch = 0; ch < numChannelsAtCompileTime; ++ch)
+            FloatVectorOperations::add (channels[ch], value, numSamples);
+
+        return *this;
+    }
+
+    /** Adds the elements in the src block to the elements in this block. */
+    template <typename OtherBlockType, EnableIfBlockType<OtherBlockType> = 0>
+    const FixedChannelAudioBlock& add (const OtherBlockType& src) const noexcept
+    {
+        auto n = jmin (numSamples, src.getNumSamples());
+
+        for (size_t ch = 0; ch < numChannelsAtCompileTime; ++ch)
+            FloatVectorOperations::add (channels[ch], src.getChannelPointer (ch), n);
+
+        return *this;
+    }
+
+    /** Adds a fixed value to each source value and replaces the contents of this block. */
+    template <typename OtherBlockType, EnableIfBlockType<OtherBlockType> = 0>
+    const FixedChannelAudioBlock& JUCE_VECTOR_CALLTYPE replaceWithSumOf (const OtherBlockType& src, NumericType value) const noexcept
+    {
+        auto n = jmin (numSamples, src.getNumSamples());
+
+        for (size_t ch = 0; ch < numChannelsAtCompileTime; ++ch)
+            FloatVectorOperations::add (channels[ch], src.getChannelPointer (ch), value, n);
+
+        return *this;
+    }
+
+    /** Adds each source1 value to the corresponding source2 value and replaces the contents of this block. */
+    template <typename Src1BlockType, typename Src2BlockType>
+    const FixedChannelAudioBlock& replaceWithSumOf (const Src1BlockType& src1, const Src2BlockType& src2) const noexcept
+    {
+        auto n = jmin (numSamples, src1.getNumSamples(), src2.getNumSamples());
+
+        for (size_t ch = 0; ch < numChannelsAtCompileTime; ++ch)
+            FloatVectorOperations::add (channels[ch], src1.getChannelPointer (ch), src2.getChannelPointer (ch), n);
+
+        return *this;
+    }
+
+    //==============================================================================
+    /** Subtracts a fixed value from the elements in this block. */
+    const FixedChannelAudioBlock& JUCE_VECTOR_CALLTYPE subtract (NumericType value) const noexcept
+    {
+        return add (value * static_cast<NumericType> (-1.0));
+    }
+
+    /** Subtracts the source values from the elements in this block. */
+    template <typename OtherBlockType, EnableIfBlockType<OtherBlockType> = 0>
+    const FixedChannelAudioBlock& subtract (const OtherBlockType& src) const noexcept
+    {
+        auto n = jmin (numSamples, src.getNumSamples());
+
+        for (size_t ch = 0; ch < numChannelsAtCompileTime; ++ch)
+            FloatVectorOperations::subtract (channels[ch], src.getChannelPointer (ch), n);
+
+        return *this;
+    }
+
+    //==============================================================================
+    /** Multiplies the elements in this block by a fixed value. */
+    const FixedChannelAudioBlock& JUCE_VECTOR_CALLTYPE multiplyBy (NumericType value) const noexcept
+    {
+        for (size_t ch = 0; ch < numChannelsAtCompileTime; ++ch)
+            FloatVectorOperations::multiply (channels[ch], value, numSamples);
+
+        return *this;
+    }
+
+    /** Multiplies the elements in this block by the elements in the src block. */
+    template <typename OtherBlockType, EnableIfBlockType<OtherBlockType> = 0>
+    const FixedChannelAudioBlock& multiplyBy (const OtherBlockType& src) const noexcept
+    {
+        auto n = jmin (numSamples, src.getNumSamples());
+
+        for (size_t ch = 0; ch < numChannelsAtCompileTime; ++ch)
+            FloatVectorOperations::multiply (channels[ch], src.getChannelPointer (ch), n);
+
+        return *this;
+    }
+
+    /** Replaces the elements in this block with the product of the elements in the source src block and a fixed value. */
+    template <typename OtherBlockType, EnableIfBlockType<OtherBlockType> = 0>
+    const FixedChannelAudioBlock& JUCE_VECTOR_CALLTYPE replaceWithProductOf (const OtherBlockType& src, NumericType value) const noexcept
+    {
+        auto n = jmin (numSamples, src.getNumSamples());
+
+        for (size_t ch = 0; ch < numChannelsAtCompileTime; ++ch)
+            FloatVectorOperations::multiply (channels[ch], src.getChannelPointer (ch), value, n);
+
+        return *this;
+    }
+
+    /** Replaces the elements in this block with the product of the elements in the src1 and src2 blocks. */
+    template <typename Src1BlockType, typename Src2BlockType>
+    const FixedChannelAudioBlock& replaceWithProductOf (const Src1BlockType& src1, const Src2BlockType& src2) const noexcept
+    {
+        auto n = jmin (numSamples, src1.getNumSamples(), src2.getNumSamples());
+
+        for (size_t ch = 0; ch < numChannelsAtCompileTime; ++ch)
+            FloatVectorOperations::multiply (channels[ch], src1.getChannelPointer (ch), src2.getChannelPointer (ch), n);
+
+        return *this;
+    }
+
+    /** Multiplies each value in src by a fixed value and adds the result to this block. */
+    template <typename OtherBlockType, EnableIfBlockType<OtherBlockType> = 0>
+    const FixedChannelAudioBlock& JUCE_VECTOR_CALLTYPE addProductOf (const OtherBlockType& src, NumericType factor) const noexcept
+    {
+        auto n = jmin (numSamples, src.getNumSamples());
+
+        for (size_t ch = 0; ch < numChannelsAtCompileTime; ++ch)
+            FloatVectorOperations::addWithMultiply (channels[ch], src.getChannelPointer (ch), factor, n);
+
+        return *this;
+    }
+
+    /** Multiplies each value in srcA with the corresponding value in srcB and adds the result to this block. */
+    template <typename Src1BlockType, typename Src2BlockType>
+    const FixedChannelAudioBlock& addProductOf (const Src1BlockType& src1, const Src2BlockType& src2) const noexcept
+    {
+        auto n = jmin (numSamples, src1.getNumSamples(), src2.getNumSamples());
+
+        for (size_t ch = 0; ch < numChannelsAtCompileTime; ++ch)
+            FloatVectorOperations::addWithMultiply (channels[ch], src1.getChannelPointer (ch), src2.getChannelPointer (ch), n);
+
+        return *this;
+    }
+
+    //==============================================================================
+    /** Negates each value of this block. */
+    const FixedChannelAudioBlock& negate() const noexcept
+    {
+        return multiplyBy (static_cast<NumericType> (-1.0));
+    }
+
+    /** Finds the minimum and maximum value of the buffer. */
+    Range<typename std::remove_const<NumericType>::type> findMinAndMax() const noexcept
+    {
+        auto minmax = FloatVectorOperations::findMinAndMax (channels[0], numSamples);
+
+        for (size_t ch = 1; ch < numChannelsAtCompileTime; ++ch)
+            minmax = minmax.getUnionWith (FloatVectorOperations::findMinAndMax (channels[ch], numSamples));
+
+        return minmax;
+    }
+
+    //==============================================================================
+    // Convenient operator wrappers.
+    const FixedChannelAudioBlock& JUCE_VECTOR_CALLTYPE operator+= (NumericType value) const noexcept   { return add (value); }
+    const FixedChannelAudioBlock&                      operator+= (const FixedChannelAudioBlock& src) const noexcept   { return add (src); }
+
+    const FixedChannelAudioBlock& JUCE_VECTOR_CALLTYPE operator-= (NumericType value) const noexcept   { return subtract (value); }
+    const FixedChannelAudioBlock&                      operator-= (const FixedChannelAudioBlock& src) const noexcept   { return subtract (src); }
+
+    const FixedChannelAudioBlock& JUCE_VECTOR_CALLTYPE operator*= (NumericType value) const noexcept   { return multiplyBy (value); }
+    const FixedChannelAudioBlock&                      operator*= (const FixedChannelAudioBlock& src) const noexcept   { return multiplyBy (src); }
+
+    //==============================================================================
+    // This class can only be used with floating point types
+    static_assert (std::is_same<std::remove_const_t<SampleType>, float>::value
+                    || std::is_same<std::remove_const_t<SampleType>, double>::value,
+                   "FixedChannelAudioBlock only supports single or double precision floating point types");
+
+    //==============================================================================
+    /** Applies a function to each value in an input block, putting the result into an output block.
+        The function supplied must take a SampleType as its parameter, and return a SampleType.
+        The two blocks must have the same number of samples.
+    */
+    template <typename Src1BlockType, typename Src2BlockType, typename FunctionType>
+    static void process (const Src1BlockType& inBlock, const Src2BlockType& outBlock, FunctionType&& function)
+    {
+        auto len = inBlock.getNumSamples();
+        jassert (len == outBlock.getNumSamples());
+
+        for (size_t ch = 0; ch < numChannelsAtCompileTime; ++ch)
+        {
+            auto* src = inBlock.getChannelPointer (ch);
+            auto* dst = outBlock.getChannelPointer (ch);
+
+            for (size_t i = 0; i < len; ++i)
+                dst[i] = function (src[i]);
+        }
+    }
+
+private:
+    //==============================================================================
+    std::array<SampleType*, numChannelsAtCompileTime> channels {};
+    size_t numSamples = 0;
+
+    template <typename OtherSampleType, size_t otherNumChannels>
+    friend class FixedChannelAudioBlock;
+};
+
+} // namespace dsp
+} // namespace juce
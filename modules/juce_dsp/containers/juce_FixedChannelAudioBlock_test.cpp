@@ -0,0 +1,194 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+template <typename SampleType>
+class FixedChannelAudioBlockUnitTests   : public UnitTest
+{
+public:
+    //==============================================================================
+    static constexpr size_t numChannels = 2;
+    static constexpr int numSamples = 32;
+
+    using FixedBlockType = FixedChannelAudioBlock<SampleType, numChannels>;
+
+    FixedChannelAudioBlockUnitTests()
+        : UnitTest ("FixedChannelAudioBlock", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        AudioBuffer<SampleType> fixedStorage ((int) numChannels, numSamples),
+                                dynamicStorage ((int) numChannels, numSamples),
+                                sourceStorage ((int) numChannels, numSamples);
+
+        FixedBlockType fixedBlock (fixedStorage);
+        AudioBlock<SampleType> dynamicBlock (dynamicStorage), sourceBlock (sourceStorage);
+
+        auto resetBlocks = [&]
+        {
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    auto value = (SampleType) (ch * 100 + (size_t) i);
+                    fixedBlock.setSample ((int) ch, i, value);
+                    dynamicBlock.setSample ((int) ch, i, value);
+                    sourceBlock.setSample ((int) ch, i, (SampleType) 3 - value);
+                }
+        };
+
+        auto blocksMatch = [&]
+        {
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < numSamples; ++i)
+                    if (! approximatelyEqual (fixedBlock.getSample ((int) ch, i),
+                                              dynamicBlock.getSample ((int) ch, i)))
+                        return false;
+
+            return true;
+        };
+
+        beginTest ("Arithmetic matches AudioBlock");
+        {
+            resetBlocks();
+
+            fixedBlock.add ((SampleType) 2);
+            dynamicBlock.add ((SampleType) 2);
+            expect (blocksMatch());
+
+            fixedBlock.multiplyBy ((SampleType) 0.5);
+            dynamicBlock.multiplyBy ((SampleType) 0.5);
+            expect (blocksMatch());
+
+            fixedBlock.add (FixedBlockType (sourceBlock));
+            dynamicBlock.add (sourceBlock);
+            expect (blocksMatch());
+
+            fixedBlock.addProductOf (FixedBlockType (sourceBlock), (SampleType) 3);
+            dynamicBlock.addProductOf (sourceBlock, (SampleType) 3);
+            expect (blocksMatch());
+
+            fixedBlock.replaceWithProductOf (FixedBlockType (sourceBlock), (SampleType) -2);
+            dynamicBlock.replaceWithProductOf (sourceBlock, (SampleType) -2);
+            expect (blocksMatch());
+
+            expect (fixedBlock.findMinAndMax() == dynamicBlock.findMinAndMax());
+        }
+
+        beginTest ("Mixed fixed and dynamic operands");
+        {
+            resetBlocks();
+
+            // A fixed block can use a dynamic block as a source directly.
+            fixedBlock.copyFrom (sourceBlock);
+            dynamicBlock.copyFrom (sourceBlock);
+            expect (blocksMatch());
+
+            fixedBlock.multiplyBy (sourceBlock);
+            dynamicBlock.multiplyBy (sourceBlock);
+            expect (blocksMatch());
+        }
+
+        beginTest ("Sub-blocks and conversion to AudioBlock");
+        {
+            resetBlocks();
+
+            auto fixedSub = fixedBlock.getSubBlock (8, 16);
+            expectEquals ((int) fixedSub.getNumSamples(), 16);
+            expect (fixedSub.getChannelPointer (1) == fixedBlock.getChannelPointer (1) + 8);
+
+            auto converted = fixedBlock.toAudioBlock();
+            expectEquals ((int) converted.getNumChannels(), (int) numChannels);
+            expectEquals ((int) converted.getNumSamples(), numSamples);
+            expect (converted.getChannelPointer (0) == fixedBlock.getChannelPointer (0));
+        }
+
+        beginTest ("ProcessorChain keeps the fixed extent between stages");
+        {
+            resetBlocks();
+
+            ProcessorChain<Gain<SampleType>, BlockTypeProbe> chain;
+            chain.template get<0>().setGainLinear ((SampleType) 2);
+            chain.template get<0>().setRampDurationSeconds (0.0);
+            chain.prepare ({ 44100.0, (uint32) numSamples, (uint32) numChannels });
+
+            FixedChannelAudioBlock<const SampleType, numChannels> inBlock (sourceBlock);
+            FixedChannelProcessContextNonReplacing<SampleType, numChannels> context (inBlock, fixedBlock);
+            chain.process (context);
+
+            expect (chain.template get<1>().sawFixedBlock);
+
+            dsp::ProcessContextNonReplacing<SampleType> dynamicContext (sourceBlock, dynamicBlock);
+            ProcessorChain<Gain<SampleType>, BlockTypeProbe> dynamicChain;
+            dynamicChain.template get<0>().setGainLinear ((SampleType) 2);
+            dynamicChain.template get<0>().setRampDurationSeconds (0.0);
+            dynamicChain.prepare ({ 44100.0, (uint32) numSamples, (uint32) numChannels });
+            dynamicChain.process (dynamicContext);
+
+            expect (! dynamicChain.template get<1>().sawFixedBlock);
+            expect (blocksMatch());
+        }
+
+        beginTest ("Static process applies a function per sample");
+        {
+            resetBlocks();
+
+            FixedBlockType::process (FixedChannelAudioBlock<const SampleType, numChannels> (sourceBlock),
+                                     fixedBlock,
+                                     [] (SampleType x) { return x * x; });
+
+            AudioBlock<SampleType>::process (sourceBlock, dynamicBlock,
+                                             [] (SampleType x) { return x * x; });
+            expect (blocksMatch());
+        }
+    }
+
+private:
+    //==============================================================================
+    struct BlockTypeProbe
+    {
+        void prepare (const ProcessSpec&) noexcept {}
+        void reset() noexcept {}
+
+        template <typename ProcessContext>
+        void process (const ProcessContext& context) noexcept
+        {
+            using BlockType = std::remove_const_t<std::remove_reference_t<decltype (context.getOutputBlock())>>;
+            sawFixedBlock = std::is_same<BlockType, FixedBlockType>::value;
+        }
+
+        bool sawFixedBlock = false;
+    };
+};
+
+static FixedChannelAudioBlockUnitTests<float> fixedChannelAudioBlockFloatUnitTests;
+static FixedChannelAudioBlockUnitTests<double> fixedChannelAudioBlockDoubleUnitTests;
+
+} // namespace dsp
+} // namespace juce
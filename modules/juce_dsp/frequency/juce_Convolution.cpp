@@ -439,6 +439,234 @@ struct ConvolutionEngine
     std::vector<AudioBuffer<float>> buffersInputSegments, buffersImpulseSegments;
 };
 
+//==============================================================================
+// Runs a set of tail convolution engines on a dedicated worker thread, so that
+// the periodic large-partition FFT bursts never land on the audio thread.
+//
+// The audio thread pushes dry input into a per-channel FIFO and pops
+// previously-computed tail output. The pipeline adds exactly one engine block
+// of delay on top of the engine's own added latency, so the engines are
+// created with half the block size that an audio-thread tail would use,
+// keeping the tail's overall alignment identical.
+class BackgroundTailProcessor  : private Thread
+{
+public:
+    explicit BackgroundTailProcessor (std::vector<std::unique_ptr<ConvolutionEngine>> enginesIn)
+        : Thread ("Convolution tail"),
+          engines (std::move (enginesIn)),
+          blockSize ((int) engines.front()->blockSize)
+    {
+        for (size_t i = 0; i < engines.size(); ++i)
+            channels.push_back (std::make_unique<ChannelState> (blockSize));
+
+        scratchInput .setSize (1, blockSize);
+        scratchOutput.setSize (1, blockSize);
+
+        startThread (8);
+    }
+
+    ~BackgroundTailProcessor() override
+    {
+        stopThread (-1);
+    }
+
+    // Called on the audio thread once per channel per block. Writes the
+    // already-computed tail output for this channel into `output`, zero-filling
+    // if the worker has fallen behind (alignment is recovered afterwards by
+    // discarding the late samples when they eventually arrive).
+    void processSamples (size_t channel, const float* input, float* output, int numSamples)
+    {
+        auto& state = *channels[channel];
+
+        pushInput (state, input, numSamples);
+        popOutput (state, output, numSamples);
+
+        if (state.inputFifo.getNumReady() >= blockSize)
+            notify();
+    }
+
+    // May be called from the audio thread, so the engines are actually reset
+    // by the worker, and the audio-side FIFO state is rebuilt lazily.
+    void reset()
+    {
+        for (auto& state : channels)
+            state->needsReset = true;
+
+        needsEngineReset = true;
+        notify();
+    }
+
+private:
+    struct ChannelState
+    {
+        explicit ChannelState (int engineBlockSize)
+            : inputFifo  (engineBlockSize * 4),
+              outputFifo (engineBlockSize * 4),
+              inputStorage  (1, engineBlockSize * 4),
+              outputStorage (1, engineBlockSize * 4),
+              pipelineZerosRemaining (engineBlockSize)
+        {
+            inputStorage.clear();
+            outputStorage.clear();
+        }
+
+        AbstractFifo inputFifo, outputFifo;
+        AudioBuffer<float> inputStorage, outputStorage;
+        int pipelineZerosRemaining, lateOutputToDiscard = 0;
+        std::atomic<bool> needsReset { false };
+    };
+
+    void pushInput (ChannelState& state, const float* input, int numSamples)
+    {
+        if (state.needsReset.load())
+            return;  // the worker hasn't rebuilt this channel yet
+
+        const auto writer = state.inputFifo.write (numSamples);
+        auto* storage = state.inputStorage.getWritePointer (0);
+
+        if (writer.blockSize1 > 0)
+            FloatVectorOperations::copy (storage + writer.startIndex1, input, writer.blockSize1);
+
+        if (writer.blockSize2 > 0)
+            FloatVectorOperations::copy (storage + writer.startIndex2, input + writer.blockSize1, writer.blockSize2);
+
+        // If the FIFO overflowed, the samples that didn't fit are silently
+        // dropped; the matching output samples will be missing too, so the
+        // two sides stay aligned.
+        state.lateOutputToDiscard += numSamples - (writer.blockSize1 + writer.blockSize2);
+    }
+
+    void popOutput (ChannelState& state, float* output, int numSamples)
+    {
+        if (state.needsReset.load())
+        {
+            FloatVectorOperations::clear (output, numSamples);
+            return;
+        }
+
+        // Throw away output that corresponds to samples we had to zero-fill
+        // for in an earlier underrun, so the tail stays time-aligned.
+        if (state.lateOutputToDiscard > 0)
+        {
+            const auto discarded = state.outputFifo.read (state.lateOutputToDiscard);
+            state.lateOutputToDiscard -= discarded.blockSize1 + discarded.blockSize2;
+        }
+
+        auto numWritten = 0;
+
+        // The first engine-block of output is the pipeline delay.
+        if (state.pipelineZerosRemaining > 0)
+        {
+            numWritten = jmin (numSamples, state.pipelineZerosRemaining);
+            FloatVectorOperations::clear (output, numWritten);
+            state.pipelineZerosRemaining -= numWritten;
+        }
+
+        const auto reader = state.outputFifo.read (numSamples - numWritten);
+        auto* storage = state.outputStorage.getReadPointer (0);
+
+        if (reader.blockSize1 > 0)
+            FloatVectorOperations::copy (output + numWritten, storage + reader.startIndex1, reader.blockSize1);
+
+        if (reader.blockSize2 > 0)
+            FloatVectorOperations::copy (output + numWritten + reader.blockSize1, storage + reader.startIndex2, reader.blockSize2);
+
+        numWritten += reader.blockSize1 + reader.blockSize2;
+
+        if (numWritten < numSamples)
+        {
+            // The worker missed its deadline; these samples' worth of output
+            // will be discarded when it catches up.
+            FloatVectorOperations::clear (output + numWritten, numSamples - numWritten);
+            state.lateOutputToDiscard += numSamples - numWritten;
+        }
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            if (needsEngineReset.exchange (false))
+            {
+                for (size_t i = 0; i < channels.size(); ++i)
+                {
+                    auto& state = *channels[i];
+
+                    if (state.needsReset.load())
+                    {
+                        engines[i]->reset();
+                        state.inputFifo.reset();
+                        state.outputFifo.reset();
+                        state.pipelineZerosRemaining = blockSize;
+                        state.lateOutputToDiscard = 0;
+                        state.needsReset = false;
+                    }
+                }
+            }
+
+            if (! processPendingBlocks())
+                wait (100);
+        }
+    }
+
+    // Each channel's engine is advanced independently, so a channel that isn't
+    // currently being fed (e.g. the second engine of a stereo pair receiving
+    // mono input) can't stall the others.
+    bool processPendingBlocks()
+    {
+        auto didWork = false;
+
+        for (size_t i = 0; i < channels.size(); ++i)
+        {
+            auto& state = *channels[i];
+
+            while (! state.needsReset.load()
+                    && state.inputFifo.getNumReady() >= blockSize
+                    && state.outputFifo.getFreeSpace() >= blockSize)
+            {
+                auto* in  = scratchInput .getWritePointer (0);
+                auto* out = scratchOutput.getWritePointer (0);
+
+                {
+                    const auto reader = state.inputFifo.read (blockSize);
+                    auto* storage = state.inputStorage.getReadPointer (0);
+
+                    if (reader.blockSize1 > 0)
+                        FloatVectorOperations::copy (in, storage + reader.startIndex1, reader.blockSize1);
+
+                    if (reader.blockSize2 > 0)
+                        FloatVectorOperations::copy (in + reader.blockSize1, storage + reader.startIndex2, reader.blockSize2);
+                }
+
+                engines[i]->processSamplesWithAddedLatency (in, out, (size_t) blockSize);
+
+                {
+                    const auto writer = state.outputFifo.write (blockSize);
+                    auto* storage = state.outputStorage.getWritePointer (0);
+
+                    if (writer.blockSize1 > 0)
+                        FloatVectorOperations::copy (storage + writer.startIndex1, out, writer.blockSize1);
+
+                    if (writer.blockSize2 > 0)
+                        FloatVectorOperations::copy (storage + writer.startIndex2, out + writer.blockSize1, writer.blockSize2);
+                }
+
+                didWork = true;
+            }
+        }
+
+        return didWork;
+    }
+
+    std::vector<std::unique_ptr<ConvolutionEngine>> engines;
+    std::vector<std::unique_ptr<ChannelState>> channels;
+    AudioBuffer<float> scratchInput, scratchOutput;
+    const int blockSize;
+    std::atomic<bool> needsEngineReset { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BackgroundTailProcessor)
+};
+
 //==============================================================================
 class MultichannelEngine
 {
@@ -475,11 +703,28 @@ public:
             for (int i = 0; i < numChannels; ++i)
                 head.emplace_back (makeEngine (i, 0, size, static_cast<uint32> (maxBufferSize)));
 
-            const auto tailBufferSize = static_cast<uint32> (headSizeIn.headSizeInSamples + (isZeroDelay ? 0 : maxBufferSize));
+            auto tailBufferSize = static_cast<uint32> (headSizeIn.headSizeInSamples + (isZeroDelay ? 0 : maxBufferSize));
+
+            // The background worker's FIFO pipeline adds one engine block of
+            // delay, so its engines use half-sized blocks to keep the tail's
+            // overall time alignment the same as the audio-thread version.
+            const auto useBackgroundTail = headSizeIn.processTailInBackground && tailBufferSize >= 2;
+
+            if (useBackgroundTail)
+                tailBufferSize /= 2;
 
             if (size != buf.getNumSamples())
+            {
+                std::vector<std::unique_ptr<ConvolutionEngine>> tailEngines;
+
                 for (int i = 0; i < numChannels; ++i)
-                    tail.emplace_back (makeEngine (i, size, buf.getNumSamples() - size, tailBufferSize));
+                    tailEngines.emplace_back (makeEngine (i, size, buf.getNumSamples() - size, tailBufferSize));
+
+                if (useBackgroundTail)
+                    backgroundTail = std::make_unique<BackgroundTailProcessor> (std::move (tailEngines));
+                else
+                    tail = std::move (tailEngines);
+            }
         }
     }
 
@@ -490,6 +735,9 @@ public:
 
         for (const auto& e : tail)
             e->reset();
+
+        if (backgroundTail != nullptr)
+            backgroundTail->reset();
     }
 
     void processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output)
@@ -500,11 +748,16 @@ public:
         const AudioBlock<float> fullTailBlock (tailBuffer);
         const auto tailBlock = fullTailBlock.getSubBlock (0, (size_t) numSamples);
 
-        const auto isUniform = tail.empty();
+        const auto isUniform = tail.empty() && backgroundTail == nullptr;
 
         for (size_t channel = 0; channel < numChannels; ++channel)
         {
-            if (! isUniform)
+            if (backgroundTail != nullptr)
+                backgroundTail->processSamples (channel,
+                                                input.getChannelPointer (channel),
+                                                tailBlock.getChannelPointer (0),
+                                                (int) numSamples);
+            else if (! isUniform)
                 tail[channel]->processSamplesWithAddedLatency (input.getChannelPointer (channel),
                                                                tailBlock.getChannelPointer (0),
                                                                numSamples);
@@ -534,6 +787,7 @@ public:
 
 private:
     std::vector<std::unique_ptr<ConvolutionEngine>> head, tail;
+    std::unique_ptr<BackgroundTailProcessor> backgroundTail;
     AudioBuffer<float> tailBuffer;
 
     const int latency;
@@ -1262,6 +1516,7 @@ void Convolution::loadImpulseResponse (AudioBuffer<float>&& buffer,
 
 void Convolution::prepare (const ProcessSpec& spec)
 {
+    denormalsDisabled = spec.disableDenormals;
     mixer.prepare (spec);
     pimpl->prepare (spec);
     isActive = true;
@@ -1280,6 +1535,8 @@ void Convolution::processSamples (const AudioBlock<const float>& input,
     if (! isActive)
         return;
 
+    const ScopedNoDenormals noDenormals (denormalsDisabled);
+
     jassert (input.getNumChannels() == output.getNumChannels());
     jassert (isPositiveAndBelow (input.getNumChannels(), static_cast<size_t> (3))); // only mono and stereo is supported
 
@@ -130,8 +130,19 @@ public:
     */
     explicit Convolution (const Latency& requiredLatency);
 
-    /** Contains configuration information for a non-uniform convolution. */
-    struct NonUniform { int headSizeInSamples; };
+    /** Contains configuration information for a non-uniform convolution.
+
+        If processTailInBackground is true, the large tail partitions are
+        computed on a dedicated background thread instead of on the audio
+        thread, which removes the periodic FFT bursts that the tail would
+        otherwise add to the audio callback. The head partitions always run on
+        the audio thread, and the reported latency is unchanged - half of the
+        head size is spent on the worker pipeline instead of on the tail
+        engine's internal buffering. For the tail to stay sample-aligned the
+        head size should be a power of two, and needs to be large enough
+        (256 samples or more) for the worker to keep up reliably.
+    */
+    struct NonUniform { int headSizeInSamples; bool processTailInBackground; };
 
     /** Initialises an object for performing convolution in the frequency domain
         using a non-uniform partitioned algorithm.
@@ -301,6 +312,7 @@ private:
     //==============================================================================
     Mixer mixer;
     bool isActive = false;
+    bool denormalsDisabled = false;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Convolution)
@@ -95,6 +95,22 @@ struct FFTFallback  : public FFT::Instance
         configInverse.reset (new FFTConfig (1 << order, true));
 
         size = 1 << order;
+
+        if (size >= 4)
+        {
+            configRealForward.reset (new FFTConfig (size / 2, false));
+            configRealInverse.reset (new FFTConfig (size / 2, true));
+
+            realTwiddles.malloc ((size_t) (size / 2 + 1));
+
+            for (int i = 0; i <= size / 2; ++i)
+            {
+                auto phase = -2.0 * MathConstants<double>::pi * i / size;
+
+                realTwiddles[i] = { (float) std::cos (phase),
+                                    (float) std::sin (phase) };
+            }
+        }
     }
 
     void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept override
@@ -168,26 +184,91 @@ struct FFTFallback  : public FFT::Instance
 
     void performRealOnlyForwardTransform (Complex<float>* scratch, float* d) const noexcept
     {
-        for (int i = 0; i < size; ++i)
-            scratch[i] = { d[i], 0 };
+        auto* out = reinterpret_cast<Complex<float>*> (d);
+
+        if (size == 2)
+        {
+            auto r0 = d[0], r1 = d[1];
+            out[0] = { r0 + r1, 0 };
+            out[1] = { r0 - r1, 0 };
+            return;
+        }
+
+        const SpinLock::ScopedLockType sl (processLock);
+
+        // Treat the real input as size/2 interleaved complex values and transform
+        // them with a half-length FFT, then untangle the spectrum using conjugate
+        // symmetry - roughly half the cost of the full-length complex transform.
+        const auto half = size / 2;
+        memcpy (scratch, d, (size_t) half * sizeof (Complex<float>));
+        configRealForward->perform (scratch, out);
+
+        const auto z0 = out[0];
+        out[0]    = { z0.real() + z0.imag(), 0 };
+        out[half] = { z0.real() - z0.imag(), 0 };
+
+        for (int k = 1; k <= half / 2; ++k)
+        {
+            const auto zk = out[k];
+            const auto zh = std::conj (out[half - k]);
+
+            const auto sum  = zk + zh;
+            const auto diff = zk - zh;
+            const auto t    = FFTConfig::mul (realTwiddles[k], diff);
 
-        perform (scratch, reinterpret_cast<Complex<float>*> (d), false);
+            // X[k] = (sum - i*t) / 2,  X[half - k] = conj (sum + i*t) / 2
+            const Complex<float> xk {  0.5f * (sum.real() + t.imag()),  0.5f * (sum.imag() - t.real()) };
+            const Complex<float> xh {  0.5f * (sum.real() - t.imag()),  0.5f * (- sum.imag() - t.real()) };
+
+            out[k]        = xk;
+            out[half - k] = xh;
+
+            // .. and the negative-frequency bins are just the conjugates
+            out[size - k] = std::conj (xk);
+            out[half + k] = std::conj (xh);
+        }
     }
 
     void performRealOnlyInverseTransform (Complex<float>* scratch, float* d) const noexcept
     {
         auto* input = reinterpret_cast<Complex<float>*> (d);
 
-        for (int i = size >> 1; i < size; ++i)
-            input[i] = std::conj (input[size - i]);
+        if (size == 2)
+        {
+            auto x0 = input[0], x1 = input[1];
+            d[0] = 0.5f * (x0.real() + x1.real());
+            d[1] = 0.5f * (x0.real() - x1.real());
+            d[2] = d[3] = 0;
+            return;
+        }
 
-        perform (input, scratch, true);
+        const SpinLock::ScopedLockType sl (processLock);
 
-        for (int i = 0; i < size; ++i)
+        // Pack the conjugate-symmetric spectrum into a half-length complex
+        // spectrum, inverse-transform it, and read out pairs of real samples.
+        const auto half = size / 2;
+
+        for (int k = 0; k < half; ++k)
         {
-            d[i] = scratch[i].real();
-            d[i + size] = scratch[i].imag();
+            const auto xk = input[k];
+            const auto xh = std::conj (input[half - k]);
+
+            const auto sum  = xk + xh;
+            const auto diff = xk - xh;
+            const auto t    = FFTConfig::mul (std::conj (realTwiddles[k]), diff);
+
+            // Z[k] = sum + i*t  (the 1/2 is folded into the final scale factor)
+            scratch[k] = { sum.real() - t.imag(), sum.imag() + t.real() };
         }
+
+        configRealInverse->perform (scratch, input);
+
+        const auto scaleFactor = 1.0f / (float) size;
+
+        for (int i = 0; i < size; ++i)
+            d[i] *= scaleFactor;
+
+        zeromem (d + size, (size_t) size * sizeof (float));
     }
 
     //==============================================================================
@@ -267,6 +348,15 @@ struct FFTFallback  : public FFT::Instance
         const int fftSize;
         const bool inverse;
 
+        // Multiplies two complex values without the NaN/infinity bookkeeping that
+        // std::complex's operator* performs, which keeps the butterflies branch-free
+        // and lets the compiler vectorise them.
+        static forcedinline Complex<float> mul (Complex<float> a, Complex<float> b) noexcept
+        {
+            return { a.real() * b.real() - a.imag() * b.imag(),
+                     a.real() * b.imag() + a.imag() * b.real() };
+        }
+
         struct Factor { int radix, length; };
         Factor factors[32];
         HeapBlock<Complex<float>> twiddleTable;
@@ -346,7 +436,7 @@ struct FFTFallback  : public FFT::Instance
                             twiddleIndex -= fftSize;
 
                         JUCE_BEGIN_IGNORE_WARNINGS_MSVC (6385)
-                        data[k] += scratch[q] * twiddleTable[twiddleIndex];
+                        data[k] += mul (scratch[q], twiddleTable[twiddleIndex]);
                         JUCE_END_IGNORE_WARNINGS_MSVC
                     }
 
@@ -362,8 +452,7 @@ struct FFTFallback  : public FFT::Instance
 
             for (int i = length; --i >= 0;)
             {
-                auto s = *dataEnd;
-                s *= (*tw);
+                auto s = mul (*dataEnd, *tw);
                 tw += stride;
                 *dataEnd++ = *data - s;
                 *data++ += s;
@@ -384,9 +473,9 @@ struct FFTFallback  : public FFT::Instance
 
             for (int i = length; --i >= 0;)
             {
-                auto s0 = data[length]   * *twiddle1;
-                auto s1 = data[lengthX2] * *twiddle2;
-                auto s2 = data[lengthX3] * *twiddle3;
+                auto s0 = mul (data[length],   *twiddle1);
+                auto s1 = mul (data[lengthX2], *twiddle2);
+                auto s2 = mul (data[lengthX3], *twiddle3);
                 auto s3 = s0;             s3 += s2;
                 auto s4 = s0;             s4 -= s2;
                 auto s5 = *data;          s5 -= s1;
@@ -425,7 +514,9 @@ struct FFTFallback  : public FFT::Instance
 
     //==============================================================================
     SpinLock processLock;
-    std::unique_ptr<FFTConfig> configForward, configInverse;
+    std::unique_ptr<FFTConfig> configForward, configInverse,
+                               configRealForward, configRealInverse;
+    HeapBlock<Complex<float>> realTwiddles;
     int size;
 };
 
@@ -0,0 +1,227 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    Performs fast fourier transforms of a size fixed at compile time.
+
+    This is a companion to FFT for code that hammers one small transform size -
+    phase vocoders, pitch shifters and the like, which may perform millions of
+    64 or 128 point transforms per second. Because the transform size is a
+    template parameter, there is no engine dispatch and every loop bound in the
+    butterfly stages is a compile-time constant, so the optimiser can unroll
+    and vectorise the whole transform; at small sizes this is considerably
+    faster than going through FFT's dynamic engine selection.
+
+    The array layouts, scaling and real-only conventions all match FFT, so the
+    two are interchangeable apart from the size being baked in:
+
+    @code
+    FixedSizeFFT<6> fft;   // a 64-point transform
+
+    fft.perform (timeDomain, freqDomain, false);
+    @endcode
+
+    Like FFT, an instance holds lookup tables, so create one per transform
+    size you need and re-use it. The real-only transforms use internal scratch
+    storage, so share an instance between threads only if calls are serialised.
+
+    @see FFT
+
+    @tags{DSP}
+*/
+template <int order>
+class FixedSizeFFT
+{
+public:
+    /** The number of points the transform operates on. */
+    static constexpr int size = 1 << order;
+
+    //==============================================================================
+    /** Initialises the twiddle and bit-reversal tables. */
+    FixedSizeFFT() noexcept
+    {
+        for (int i = 0; i < size; ++i)
+        {
+            int reversed = 0;
+
+            for (int bit = 0; bit < order; ++bit)
+                if ((i & (1 << bit)) != 0)
+                    reversed |= (1 << (order - 1 - bit));
+
+            bitReversedIndices[i] = reversed;
+        }
+
+        for (int i = 0; i < size / 2; ++i)
+        {
+            auto phase = -MathConstants<double>::twoPi * (double) i / (double) size;
+            twiddles[i] = { (float) std::cos (phase), (float) std::sin (phase) };
+        }
+    }
+
+    //==============================================================================
+    /** Performs an out-of-place FFT, either forward or inverse.
+        The arrays must contain at least size elements, and must not overlap.
+    */
+    void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept
+    {
+        for (int i = 0; i < size; ++i)
+            output[bitReversedIndices[i]] = input[i];
+
+        performInPlace (output, inverse);
+
+        if (inverse)
+        {
+            constexpr auto scaleFactor = 1.0f / (float) size;
+
+            for (int i = 0; i < size; ++i)
+                output[i] *= scaleFactor;
+        }
+    }
+
+    /** Performs an in-place forward transform on a block of real data.
+
+        As with FFT::performRealOnlyForwardTransform, the array passed in must
+        contain 2 * size floats, with the first half holding the input samples;
+        on return it holds size complex numbers as interleaved real/imaginary
+        pairs. The full spectrum is always produced, so the
+        onlyCalculateNonNegativeFrequencies hint is accepted but ignored.
+    */
+    void performRealOnlyForwardTransform (float* inputOutputData,
+                                          bool onlyCalculateNonNegativeFrequencies = false) const noexcept
+    {
+        ignoreUnused (onlyCalculateNonNegativeFrequencies);
+
+        auto* out = reinterpret_cast<Complex<float>*> (inputOutputData);
+
+        // Unpack the real input into bit-reversed complex order, walking
+        // backwards so nothing is overwritten before it's been read.
+        for (int i = size; --i >= 0;)
+            scratch[bitReversedIndices[i]] = { inputOutputData[i], 0 };
+
+        performInPlace (scratch, false);
+
+        for (int i = 0; i < size; ++i)
+            out[i] = scratch[i];
+    }
+
+    /** Performs a reverse operation to data created in performRealOnlyForwardTransform().
+
+        As with FFT, only the first (size / 2) + 1 complex numbers are read -
+        the negative frequencies are reconstituted from their conjugate
+        symmetry - and on return the first half of the array contains the
+        recovered samples.
+    */
+    void performRealOnlyInverseTransform (float* inputOutputData) const noexcept
+    {
+        auto* in = reinterpret_cast<const Complex<float>*> (inputOutputData);
+
+        for (int i = 0; i <= size / 2; ++i)
+            scratch[bitReversedIndices[i]] = in[i];
+
+        for (int i = size / 2 + 1; i < size; ++i)
+            scratch[bitReversedIndices[i]] = std::conj (in[size - i]);
+
+        performInPlace (scratch, true);
+
+        constexpr auto scaleFactor = 1.0f / (float) size;
+
+        for (int i = 0; i < size; ++i)
+            inputOutputData[i] = scratch[i].real() * scaleFactor;
+    }
+
+    /** Takes an array of 2 * size floats and transforms it to its magnitude
+        frequency response spectrum, as FFT::performFrequencyOnlyForwardTransform
+        does.
+    */
+    void performFrequencyOnlyForwardTransform (float* inputOutputData) const noexcept
+    {
+        if (size == 1)
+            return;
+
+        performRealOnlyForwardTransform (inputOutputData);
+
+        auto* out = reinterpret_cast<const Complex<float>*> (inputOutputData);
+
+        // Writing the magnitude for bin i only ever touches floats that belong
+        // to bins below i, which have already been read, so this is safe in place.
+        for (int i = 0; i < size; ++i)
+            inputOutputData[i] = std::abs (out[i]);
+
+        zeromem (inputOutputData + size, (size_t) size * sizeof (float));
+    }
+
+    /** Returns the number of data points the transform operates on, for
+        interchangeability with FFT::getSize(). */
+    static constexpr int getSize() noexcept         { return size; }
+
+private:
+    //==============================================================================
+    void performInPlace (Complex<float>* data, bool inverse) const noexcept
+    {
+        // With order a template parameter every bound below folds to a
+        // constant, so the optimiser can fully unroll and vectorise the
+        // butterflies - there's no dynamic dispatch anywhere on this path.
+        for (int stage = 1; stage <= order; ++stage)
+        {
+            const int halfBlockSize = 1 << (stage - 1);
+            const int blockSize = halfBlockSize << 1;
+            const int twiddleStep = size >> stage;
+
+            for (int blockStart = 0; blockStart < size; blockStart += blockSize)
+            {
+                for (int j = 0; j < halfBlockSize; ++j)
+                {
+                    auto twiddle = twiddles[j * twiddleStep];
+
+                    if (inverse)
+                        twiddle = std::conj (twiddle);
+
+                    auto& a = data[blockStart + j];
+                    auto& b = data[blockStart + j + halfBlockSize];
+
+                    const auto t = b * twiddle;
+
+                    b = a - t;
+                    a = a + t;
+                }
+            }
+        }
+    }
+
+    //==============================================================================
+    int bitReversedIndices[size];
+    Complex<float> twiddles[size / 2 + 1];
+    mutable Complex<float> scratch[size];
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FixedSizeFFT)
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+struct FixedSizeFFTUnitTest  : public UnitTest
+{
+    FixedSizeFFTUnitTest()
+        : UnitTest ("FixedSizeFFT", UnitTestCategories::dsp)
+    {}
+
+    static void fillRandom (Random& random, float* buffer, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+            buffer[i] = (2.0f * random.nextFloat()) - 1.0f;
+    }
+
+    static bool checkArrayIsSimilar (const float* a, const float* b, size_t n) noexcept
+    {
+        for (size_t i = 0; i < n; ++i)
+            if (std::abs (a[i] - b[i]) > 1e-3f)
+                return false;
+
+        return true;
+    }
+
+    //==============================================================================
+    template <int order>
+    void compareAgainstDynamicFFT (Random& random)
+    {
+        constexpr auto n = (size_t) 1 << order;
+
+        FixedSizeFFT<order> fixedFFT;
+        FFT dynamicFFT (order);
+
+        expectEquals (fixedFFT.getSize(), dynamicFFT.getSize());
+
+        // complex transforms, both directions
+        for (auto inverse : { false, true })
+        {
+            HeapBlock<Complex<float>> input (n), reference (n), output (n);
+            fillRandom (random, reinterpret_cast<float*> (input.getData()), 2 * n);
+
+            dynamicFFT.perform (input.getData(), reference.getData(), inverse);
+            fixedFFT.perform (input.getData(), output.getData(), inverse);
+
+            expect (checkArrayIsSimilar (reinterpret_cast<const float*> (reference.getData()),
+                                         reinterpret_cast<const float*> (output.getData()), 2 * n));
+        }
+
+        // real-only forward
+        HeapBlock<float> realInput (2 * n), realReference (2 * n), realOutput (2 * n);
+
+        fillRandom (random, realInput.getData(), n);
+        zeromem (realInput.getData() + n, n * sizeof (float));
+
+        memcpy (realReference.getData(), realInput.getData(), 2 * n * sizeof (float));
+        memcpy (realOutput.getData(),    realInput.getData(), 2 * n * sizeof (float));
+
+        dynamicFFT.performRealOnlyForwardTransform (realReference.getData());
+        fixedFFT  .performRealOnlyForwardTransform (realOutput.getData());
+
+        expect (checkArrayIsSimilar (realReference.getData(), realOutput.getData(), 2 * n));
+
+        // real-only round trip should recover the input
+        fixedFFT.performRealOnlyInverseTransform (realOutput.getData());
+        expect (checkArrayIsSimilar (realOutput.getData(), realInput.getData(), n));
+
+        // frequency-only transform
+        memcpy (realReference.getData(), realInput.getData(), 2 * n * sizeof (float));
+        memcpy (realOutput.getData(),    realInput.getData(), 2 * n * sizeof (float));
+
+        dynamicFFT.performFrequencyOnlyForwardTransform (realReference.getData());
+        fixedFFT  .performFrequencyOnlyForwardTransform (realOutput.getData());
+
+        expect (checkArrayIsSimilar (realReference.getData(), realOutput.getData(), n));
+    }
+
+    void runTest() override
+    {
+        Random random (902783);
+
+        beginTest ("64 point transforms match dsp::FFT");
+        compareAgainstDynamicFFT<6> (random);
+
+        beginTest ("128 point transforms match dsp::FFT");
+        compareAgainstDynamicFFT<7> (random);
+
+        beginTest ("Other small orders match dsp::FFT");
+        compareAgainstDynamicFFT<0> (random);
+        compareAgainstDynamicFFT<1> (random);
+        compareAgainstDynamicFFT<4> (random);
+        compareAgainstDynamicFFT<8> (random);
+    }
+};
+
+static FixedSizeFFTUnitTest fixedSizeFFTUnitTest;
+
+} // namespace dsp
+} // namespace juce
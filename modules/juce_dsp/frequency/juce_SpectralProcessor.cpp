@@ -0,0 +1,148 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+SpectralProcessor::SpectralProcessor (int fftOrder, int hopSizeInSamples,
+                                      WindowingFunction<float>::WindowingMethod windowingMethod)
+    : fft (fftOrder),
+      fftSize (1 << fftOrder),
+      hopSize (hopSizeInSamples)
+{
+    jassert (hopSize > 0 && hopSize <= fftSize);
+
+    windowTable.resize (fftSize);
+    WindowingFunction<float>::fillWindowingTables (windowTable.getRawDataPointer(),
+                                                   (size_t) fftSize, windowingMethod, false);
+
+    // The overlap-added output of each sample is scaled by the sum of the
+    // squared window values of all frames overlapping it. Computing that sum
+    // numerically (rather than relying on a closed-form COLA identity) keeps
+    // the reconstruction exact for any window shape and hop size.
+    normalisation.resize (hopSize);
+
+    for (int i = 0; i < hopSize; ++i)
+    {
+        auto sum = 0.0;
+
+        for (int j = i; j < fftSize; j += hopSize)
+            sum += square ((double) windowTable.getReference (j));
+
+        normalisation.set (i, sum > 1.0e-6 ? (float) (1.0 / sum) : 0.0f);
+    }
+}
+
+void SpectralProcessor::prepare (const ProcessSpec& spec)
+{
+    const auto numChannels = (int) spec.numChannels;
+
+    inputBuffer  .setSize (numChannels, fftSize);
+    overlapBuffer.setSize (numChannels, fftSize);
+    outputStage  .setSize (numChannels, hopSize);
+    frameData.allocate ((size_t) fftSize * 2, true);
+
+    reset();
+}
+
+void SpectralProcessor::reset() noexcept
+{
+    inputBuffer.clear();
+    overlapBuffer.clear();
+    outputStage.clear();
+    fifoCount = 0;
+}
+
+void SpectralProcessor::processInternal (const AudioBlock<const float>& input,
+                                         AudioBlock<float>& output) noexcept
+{
+    const auto numChannels = (int) jmin (input.getNumChannels(), output.getNumChannels(),
+                                         (size_t) inputBuffer.getNumChannels());
+    const auto numSamples = (int) jmin (input.getNumSamples(), output.getNumSamples());
+
+    for (int position = 0; position < numSamples;)
+    {
+        const auto numThisTime = jmin (numSamples - position, hopSize - fifoCount);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto* in  = input .getChannelPointer ((size_t) channel) + position;
+            auto* out = output.getChannelPointer ((size_t) channel) + position;
+
+            // The input must be staged before the output is written, as the
+            // two may alias when using a replacing context.
+            FloatVectorOperations::copy (inputBuffer.getWritePointer (channel, fftSize - hopSize + fifoCount),
+                                         in, numThisTime);
+            FloatVectorOperations::copy (out, outputStage.getReadPointer (channel, fifoCount), numThisTime);
+        }
+
+        position += numThisTime;
+        fifoCount += numThisTime;
+
+        if (fifoCount == hopSize)
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+                processFrame (channel);
+
+            fifoCount = 0;
+        }
+    }
+}
+
+void SpectralProcessor::processFrame (int channel) noexcept
+{
+    auto* frame = frameData.getData();
+    auto* window = windowTable.getRawDataPointer();
+
+    FloatVectorOperations::multiply (frame, inputBuffer.getReadPointer (channel), window, fftSize);
+    FloatVectorOperations::clear (frame + fftSize, fftSize);
+
+    fft.performRealOnlyForwardTransform (frame, true);
+
+    if (spectrumCallback != nullptr)
+        spectrumCallback ((size_t) channel,
+                          reinterpret_cast<Complex<float>*> (frame),
+                          (size_t) (fftSize / 2 + 1));
+
+    fft.performRealOnlyInverseTransform (frame);
+
+    auto* overlap = overlapBuffer.getWritePointer (channel);
+    FloatVectorOperations::multiply (frame, window, fftSize);
+    FloatVectorOperations::add (overlap, frame, fftSize);
+
+    FloatVectorOperations::multiply (outputStage.getWritePointer (channel),
+                                     overlap, normalisation.getRawDataPointer(), hopSize);
+
+    std::memmove (overlap, overlap + hopSize, (size_t) (fftSize - hopSize) * sizeof (float));
+    FloatVectorOperations::clear (overlap + (fftSize - hopSize), hopSize);
+
+    auto* staged = inputBuffer.getWritePointer (channel);
+    std::memmove (staged, staged + hopSize, (size_t) (fftSize - hopSize) * sizeof (float));
+}
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,148 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    An allocation-free short-time Fourier transform (STFT) backbone for
+    spectral effects.
+
+    This class takes care of the buffering that every spectral processor
+    needs: the incoming stream is sliced into overlapping frames, each frame
+    is multiplied by an analysis window and transformed with an FFT, the
+    frequency-domain bins are handed to a user-provided callback, and the
+    modified spectrum is transformed back, windowed again and overlap-added
+    into the output with the normalization required for perfect
+    reconstruction at the chosen hop size.
+
+    All buffers are allocated in prepare(); process() performs no allocation,
+    so the class is safe to use on the audio thread. With no callback set, the
+    output reproduces the input delayed by getLatencyInSamples().
+
+    @see FFT, WindowingFunction
+
+    @tags{DSP}
+*/
+class SpectralProcessor
+{
+public:
+    //==============================================================================
+    /** Creates an STFT processor.
+
+        @param fftOrder          the order of the FFT, so each analysis frame
+                                 contains (1 << fftOrder) samples
+        @param hopSizeInSamples  the number of samples between consecutive frames.
+                                 Must be positive and no larger than the FFT size;
+                                 a quarter of the FFT size is a good default for
+                                 hann windows
+        @param windowingMethod   the window applied before the forward and after
+                                 the inverse transform
+    */
+    SpectralProcessor (int fftOrder,
+                       int hopSizeInSamples,
+                       WindowingFunction<float>::WindowingMethod windowingMethod
+                           = WindowingFunction<float>::hann);
+
+    //==============================================================================
+    /** The type of a function which is given access to the spectrum of each
+        analysis frame.
+
+        The bins cover the non-negative frequencies only, so numBins is
+        (fftSize / 2) + 1; the negative frequencies are reconstructed from them
+        by the inverse transform. The callback runs on the audio thread, so the
+        usual realtime constraints apply.
+    */
+    using SpectrumCallback = std::function<void (size_t channel, Complex<float>* bins, size_t numBins)>;
+
+    /** Sets the function called with the spectrum of each analysis frame.
+
+        Pass nullptr for a straight (delayed) pass-through. Don't call this
+        while process() is running on another thread.
+    */
+    void setSpectrumCallback (SpectrumCallback callback)    { spectrumCallback = std::move (callback); }
+
+    //==============================================================================
+    /** Allocates the internal buffers for the given number of channels. */
+    void prepare (const ProcessSpec&);
+
+    /** Clears the internal state without deallocating. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Returns the delay between input and output imposed by the STFT buffering.
+
+        This is one full FFT frame: a sample can only be emitted once every
+        analysis frame overlapping it has been processed.
+    */
+    int getLatencyInSamples() const noexcept    { return fftSize; }
+
+    /** Returns the number of samples in each analysis frame. */
+    int getFFTSize() const noexcept             { return fftSize; }
+
+    /** Returns the number of samples between consecutive analysis frames. */
+    int getHopSize() const noexcept             { return hopSize; }
+
+    //==============================================================================
+    /** Processes the input and output buffers supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock = context.getOutputBlock();
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom (inputBlock);
+
+            return;
+        }
+
+        processInternal (inputBlock, outputBlock);
+    }
+
+private:
+    //==============================================================================
+    void processInternal (const AudioBlock<const float>& input, AudioBlock<float>& output) noexcept;
+    void processFrame (int channel) noexcept;
+
+    //==============================================================================
+    FFT fft;
+    int fftSize, hopSize;
+    SpectrumCallback spectrumCallback;
+
+    Array<float> windowTable, normalisation;
+    AudioBuffer<float> inputBuffer, overlapBuffer, outputStage;
+    HeapBlock<float> frameData;
+    int fifoCount = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectralProcessor)
+};
+
+} // namespace dsp
+} // namespace juce
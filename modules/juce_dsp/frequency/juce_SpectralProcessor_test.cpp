@@ -0,0 +1,158 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class SpectralProcessorTest : public UnitTest
+{
+public:
+    SpectralProcessorTest()
+        : UnitTest ("SpectralProcessor", UnitTestCategories::dsp) {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        beginTest ("With no spectrum callback, the input is reconstructed with the reported latency");
+        {
+            for (auto hopDivisor : { 2, 4, 8 })
+            {
+                constexpr int order = 9;
+                const int fftSize = 1 << order;
+                const int hopSize = fftSize / hopDivisor;
+                const int blockSize = 160;
+                const int numSamples = fftSize * 8;
+
+                SpectralProcessor processor (order, hopSize);
+                processor.prepare ({ 44100.0, (uint32) blockSize, 1 });
+
+                AudioBuffer<float> input (1, numSamples), output (1, numSamples);
+
+                for (int i = 0; i < numSamples; ++i)
+                    input.setSample (0, i, random.nextFloat() * 2.0f - 1.0f);
+
+                render (processor, input, output, blockSize);
+
+                const auto latency = processor.getLatencyInSamples();
+                expectEquals (latency, fftSize);
+
+                // The first frames are built from partially-filled analysis
+                // buffers, so only compare once the pipeline has filled up.
+                auto maxDifference = 0.0f;
+
+                for (int i = latency + fftSize; i < numSamples; ++i)
+                    maxDifference = jmax (maxDifference,
+                                          std::abs (output.getSample (0, i) - input.getSample (0, i - latency)));
+
+                expectLessThan (maxDifference, 1.0e-4f);
+            }
+        }
+
+        beginTest ("The spectrum callback can modify the signal");
+        {
+            constexpr int order = 8;
+            const int fftSize = 1 << order;
+            const int numSamples = fftSize * 8;
+
+            SpectralProcessor processor (order, fftSize / 4);
+            processor.prepare ({ 44100.0, 128, 1 });
+            processor.setSpectrumCallback ([] (size_t, Complex<float>* bins, size_t numBins)
+            {
+                for (size_t i = 0; i < numBins; ++i)
+                    bins[i] = {};
+            });
+
+            AudioBuffer<float> input (1, numSamples), output (1, numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+                input.setSample (0, i, random.nextFloat() * 2.0f - 1.0f);
+
+            render (processor, input, output, 128);
+
+            expectEquals (output.getMagnitude (0, numSamples), 0.0f);
+        }
+
+        beginTest ("Processing in place matches processing into a separate buffer");
+        {
+            constexpr int order = 8;
+            const int numSamples = (1 << order) * 4;
+
+            SpectralProcessor separate (order, 1 << (order - 2)),
+                              inPlace  (order, 1 << (order - 2));
+
+            separate.prepare ({ 44100.0, 96, 1 });
+            inPlace .prepare ({ 44100.0, 96, 1 });
+
+            AudioBuffer<float> input (1, numSamples), output (1, numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+                input.setSample (0, i, random.nextFloat() * 2.0f - 1.0f);
+
+            render (separate, input, output, 96);
+
+            for (int position = 0; position < numSamples; position += 96)
+            {
+                AudioBlock<float> block (input.getArrayOfWritePointers(), 1,
+                                         (size_t) position, (size_t) jmin (96, numSamples - position));
+                inPlace.process (ProcessContextReplacing<float> (block));
+            }
+
+            auto maxDifference = 0.0f;
+
+            for (int i = 0; i < numSamples; ++i)
+                maxDifference = jmax (maxDifference,
+                                      std::abs (input.getSample (0, i) - output.getSample (0, i)));
+
+            expectLessThan (maxDifference, 1.0e-6f);
+        }
+    }
+
+private:
+    static void render (SpectralProcessor& processor,
+                        const AudioBuffer<float>& input,
+                        AudioBuffer<float>& output,
+                        int blockSize)
+    {
+        const auto numSamples = input.getNumSamples();
+
+        for (int position = 0; position < numSamples; position += blockSize)
+        {
+            const auto numThisTime = (size_t) jmin (blockSize, numSamples - position);
+
+            AudioBlock<const float> in  (input .getArrayOfReadPointers(),  1, (size_t) position, numThisTime);
+            AudioBlock<float>       out (output.getArrayOfWritePointers(), 1, (size_t) position, numThisTime);
+
+            processor.process (ProcessContextNonReplacing<float> (in, out));
+        }
+    }
+};
+
+static SpectralProcessorTest spectralProcessorUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+SpectrogramEngine::SpectrogramEngine (int fftOrder, int hopSizeInSamples,
+                                      WindowingFunction<float>::WindowingMethod windowingMethod)
+    : fft (fftOrder),
+      fftSize (1 << fftOrder),
+      hopSize (hopSizeInSamples),
+      fifo (jmax (1 << 15, fftSize * 8))
+{
+    jassert (hopSize > 0 && hopSize <= fftSize);
+
+    windowTable.resize (fftSize);
+    WindowingFunction<float>::fillWindowingTables (windowTable.getRawDataPointer(),
+                                                   (size_t) fftSize, windowingMethod, false);
+
+    frame.calloc (fftSize);
+    fftData.calloc (2 * fftSize);
+    fifoBuffer.calloc (fifo.getTotalSize());
+
+    static const uint32 defaultStops[] = { 0xff000000, 0xff1c0b80, 0xff00a2ff, 0xffffe100, 0xffffffff };
+    setColourMap (defaultStops, numElementsInArray (defaultStops));
+    updateIndexMapping();
+}
+
+void SpectrogramEngine::setLevelRange (float minimumLevelDb, float maximumLevelDb) noexcept
+{
+    jassert (minimumLevelDb < maximumLevelDb);
+
+    minDb = minimumLevelDb;
+    maxDb = maximumLevelDb;
+    updateIndexMapping();
+}
+
+void SpectrogramEngine::updateIndexMapping() noexcept
+{
+    // a bin's palette index is (20 * log10 (magnitude) + normalisation - minDb)
+    // scaled into 0..255; everything except the log folds into two constants
+    auto indicesPerDb = 255.0f / (maxDb - minDb);
+    auto normalisationDb = 20.0f * std::log10 (2.0f / (float) fftSize);
+
+    indexScale = 20.0f * indicesPerDb;
+    indexOffset = (normalisationDb - minDb) * indicesPerDb;
+}
+
+void SpectrogramEngine::setColourMap (const uint32* colourStops, int numStops) noexcept
+{
+    jassert (numStops >= 2);
+
+    for (int i = 0; i < 256; ++i)
+    {
+        auto pos = (float) i * (float) (numStops - 1) / 255.0f;
+        auto index = jmin (numStops - 2, (int) pos);
+        auto frac = pos - (float) index;
+
+        auto c1 = colourStops[index];
+        auto c2 = colourStops[index + 1];
+        uint32 mixed = 0;
+
+        for (int shift = 0; shift <= 24; shift += 8)
+        {
+            auto v1 = (float) ((c1 >> shift) & 0xff);
+            auto v2 = (float) ((c2 >> shift) & 0xff);
+            mixed |= (uint32) roundToInt (v1 + (v2 - v1) * frac) << shift;
+        }
+
+        colourMap[i] = mixed;
+    }
+}
+
+void SpectrogramEngine::pushSamples (const float* samples, int numSamples) noexcept
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite (numSamples, start1, size1, start2, size2);
+
+    if (size1 > 0)  FloatVectorOperations::copy (fifoBuffer + start1, samples, size1);
+    if (size2 > 0)  FloatVectorOperations::copy (fifoBuffer + start2, samples + size1, size2);
+
+    fifo.finishedWrite (size1 + size2);
+}
+
+int SpectrogramEngine::getNumReadyColumns() const noexcept
+{
+    return fifo.getNumReady() / hopSize;
+}
+
+int SpectrogramEngine::produceColumns (uint32* dest, int maxNumColumns) noexcept
+{
+    auto numBins = fftSize / 2;
+    int numDone = 0;
+
+    while (numDone < maxNumColumns && fifo.getNumReady() >= hopSize)
+    {
+        // slide the analysis frame along by one hop and append the new samples
+        std::memmove (frame, frame + hopSize, (size_t) (fftSize - hopSize) * sizeof (float));
+        auto* incoming = frame + (fftSize - hopSize);
+
+        int start1, size1, start2, size2;
+        fifo.prepareToRead (hopSize, start1, size1, start2, size2);
+
+        if (size1 > 0)  FloatVectorOperations::copy (incoming, fifoBuffer + start1, size1);
+        if (size2 > 0)  FloatVectorOperations::copy (incoming + size1, fifoBuffer + start2, size2);
+
+        fifo.finishedRead (size1 + size2);
+
+        FloatVectorOperations::multiply (fftData, frame, windowTable.getRawDataPointer(), fftSize);
+        FloatVectorOperations::clear (fftData + fftSize, fftSize);
+        fft.performFrequencyOnlyForwardTransform (fftData, true);
+
+        // map the magnitudes to palette indices: the log has to be scalar, but
+        // the scaling and clamping run through the vectorised ops
+        for (int i = 0; i < numBins; ++i)
+            fftData[i] = std::log10 (jmax (fftData[i], 1.0e-12f));
+
+        FloatVectorOperations::multiply (fftData, indexScale, numBins);
+        FloatVectorOperations::add (fftData, indexOffset, numBins);
+        FloatVectorOperations::clip (fftData, fftData, 0.0f, 255.0f, numBins);
+
+        auto* column = dest + (size_t) numDone * (size_t) numBins;
+
+        for (int i = 0; i < numBins; ++i)
+            column[i] = colourMap[(int) fftData[i]];
+
+        ++numDone;
+    }
+
+    return numDone;
+}
+
+void SpectrogramEngine::reset() noexcept
+{
+    fifo.reset();
+    FloatVectorOperations::clear (frame, fftSize);
+}
+
+} // namespace dsp
+} // namespace juce
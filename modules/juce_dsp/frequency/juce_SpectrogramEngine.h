@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    Turns a stream of audio samples into ready-to-upload spectrogram pixel
+    columns.
+
+    The audio thread feeds samples in with pushSamples(), which is lock-free
+    and doesn't allocate. A rendering thread (or timer on the message thread)
+    then calls produceColumns(), which slices the buffered audio into
+    overlapping analysis frames, transforms as many frames as possible in one
+    call, and maps each magnitude spectrum through a palette straight into
+    packed ARGB pixels - so the per-column cost is just one FFT plus a lookup
+    per bin, with no intermediate Image.
+
+    Each output column holds getNumBins() pixels, DC first, as fully-opaque
+    0xAARRGGBB words with the same in-memory layout as PixelARGB. Columns can
+    therefore be handed directly to a texture upload - for example
+    OpenGLTexture::updateARGBArea() for a scrolling GPU spectrogram - or
+    blitted into an Image's bitmap data.
+
+    @code
+    SpectrogramEngine engine (11, 512);   // 2048-point FFT, 4x overlap
+
+    // audio thread:
+    engine.pushSamples (monoMix, numSamples);
+
+    // render callback:
+    HeapBlock<uint32> columns (64 * (size_t) engine.getNumBins());
+    auto num = engine.produceColumns (columns, 64);
+    // ...upload the columns to the scrolling texture...
+    @endcode
+
+    @see FFT, SpectralProcessor, WindowingFunction
+
+    @tags{DSP}
+*/
+class JUCE_API  SpectrogramEngine
+{
+public:
+    //==============================================================================
+    /** Creates an engine.
+
+        @param fftOrder          the order of the FFT, so each column is computed
+                                 from (1 << fftOrder) samples and contains
+                                 (1 << fftOrder) / 2 pixels
+        @param hopSizeInSamples  the number of samples between consecutive columns.
+                                 Must be positive and no larger than the FFT size
+        @param windowingMethod   the window applied to each analysis frame
+    */
+    SpectrogramEngine (int fftOrder,
+                       int hopSizeInSamples,
+                       WindowingFunction<float>::WindowingMethod windowingMethod
+                           = WindowingFunction<float>::hann);
+
+    //==============================================================================
+    /** Returns the number of pixels in each output column, i.e. half the FFT size. */
+    int getNumBins() const noexcept             { return fftSize / 2; }
+
+    /** Returns the number of samples in each analysis frame. */
+    int getFFTSize() const noexcept             { return fftSize; }
+
+    /** Returns the number of samples between consecutive columns. */
+    int getHopSize() const noexcept             { return hopSize; }
+
+    //==============================================================================
+    /** Sets the range of levels spanned by the palette.
+
+        Magnitudes at or below minimumLevelDb map to the first palette entry,
+        and those at or above maximumLevelDb to the last. The defaults are
+        -90dB and 0dB, where 0dB is a full-scale sine.
+    */
+    void setLevelRange (float minimumLevelDb, float maximumLevelDb) noexcept;
+
+    /** Sets the palette as a set of colour stops which are spread evenly over
+        the level range and interpolated between.
+
+        Each stop is a packed 0xAARRGGBB word. There must be at least two of
+        them. The default palette runs black - blue - cyan - yellow - white.
+    */
+    void setColourMap (const uint32* colourStops, int numStops) noexcept;
+
+    //==============================================================================
+    /** Adds samples to the internal FIFO. Safe to call from the audio thread
+        while another thread calls produceColumns(); if the consumer has fallen
+        so far behind that the FIFO is full, the excess samples are dropped.
+        Multi-channel audio should be mixed to mono before being pushed.
+    */
+    void pushSamples (const float* samples, int numSamples) noexcept;
+
+    /** Returns the number of columns that the buffered samples would produce. */
+    int getNumReadyColumns() const noexcept;
+
+    /** Computes up to maxNumColumns new columns, writing getNumBins() pixels
+        per column to dest, and returns the number of columns written. Columns
+        are only produced while a full hop of new samples is available, so the
+        count may be anything from zero to maxNumColumns.
+    */
+    int produceColumns (uint32* dest, int maxNumColumns) noexcept;
+
+    /** Discards any buffered samples and clears the analysis frame. */
+    void reset() noexcept;
+
+private:
+    //==============================================================================
+    FFT fft;
+    int fftSize, hopSize;
+    float minDb = -90.0f, maxDb = 0.0f;
+    float indexScale = 0, indexOffset = 0;
+
+    Array<float> windowTable;
+    HeapBlock<float> frame, fftData, fifoBuffer;
+    AbstractFifo fifo;
+    uint32 colourMap[256];
+
+    void updateIndexMapping() noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrogramEngine)
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class SpectrogramEngineTest : public UnitTest
+{
+public:
+    SpectrogramEngineTest()
+        : UnitTest ("SpectrogramEngine", UnitTestCategories::dsp) {}
+
+    void runTest() override
+    {
+        constexpr int order = 9;
+        constexpr int fftSize = 1 << order;
+        constexpr int hopSize = fftSize / 2;
+        constexpr int numBins = fftSize / 2;
+
+        beginTest ("Columns are produced once per hop of buffered samples");
+        {
+            SpectrogramEngine engine (order, hopSize);
+            expectEquals (engine.getNumBins(), numBins);
+
+            std::vector<float> silence ((size_t) hopSize * 3 + 1, 0.0f);
+            engine.pushSamples (silence.data(), (int) silence.size());
+            expectEquals (engine.getNumReadyColumns(), 3);
+
+            std::vector<uint32> columns ((size_t) numBins * 8);
+            expectEquals (engine.produceColumns (columns.data(), 8), 3);
+            expectEquals (engine.produceColumns (columns.data(), 8), 0);
+        }
+
+        beginTest ("A full-scale sine lights up its own bin and leaves distant bins dark");
+        {
+            SpectrogramEngine engine (order, hopSize);
+
+            // a greyscale palette makes the pixel values directly comparable
+            const uint32 greyscale[] = { 0xff000000, 0xffffffff };
+            engine.setColourMap (greyscale, 2);
+
+            constexpr int sineBin = 32;
+            constexpr int numColumns = 8;
+            std::vector<float> sine ((size_t) hopSize * numColumns);
+
+            for (size_t i = 0; i < sine.size(); ++i)
+                sine[i] = std::sin (MathConstants<float>::twoPi * sineBin * (float) i / (float) fftSize);
+
+            engine.pushSamples (sine.data(), (int) sine.size());
+
+            std::vector<uint32> columns ((size_t) numBins * numColumns);
+            expectEquals (engine.produceColumns (columns.data(), numColumns), numColumns);
+
+            // by the last column the analysis frame holds nothing but the sine
+            const auto* column = columns.data() + (size_t) numBins * (numColumns - 1);
+
+            int brightestBin = 0;
+
+            for (int i = 1; i < numBins; ++i)
+                if ((column[i] & 0xff) > (column[brightestBin] & 0xff))
+                    brightestBin = i;
+
+            expectEquals (brightestBin, sineBin);
+            expect ((column[sineBin] & 0xff) > 180, "the peak should sit near the top of the level range");
+            expect ((column[sineBin / 2] & 0xff) < 60, "distant bins should be near the bottom of the range");
+            expect ((column[sineBin] >> 24) == 0xff, "columns should be fully opaque");
+        }
+
+        beginTest ("reset discards the buffered samples");
+        {
+            SpectrogramEngine engine (order, hopSize);
+
+            std::vector<float> silence ((size_t) hopSize * 4, 0.0f);
+            engine.pushSamples (silence.data(), (int) silence.size());
+            engine.reset();
+            expectEquals (engine.getNumReadyColumns(), 0);
+        }
+    }
+};
+
+static SpectrogramEngineTest spectrogramEngineUnitTest;
+
+} // namespace dsp
+} // namespace juce
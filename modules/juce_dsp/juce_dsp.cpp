@@ -70,6 +70,8 @@
 #include "frequency/juce_FFT.cpp"
 #include "frequency/juce_Convolution.cpp"
 #include "frequency/juce_Windowing.cpp"
+#include "frequency/juce_SpectralProcessor.cpp"
+#include "frequency/juce_SpectrogramEngine.cpp"
 #include "filter_design/juce_FilterDesign.cpp"
 #include "widgets/juce_LadderFilter.cpp"
 #include "widgets/juce_Compressor.cpp"
@@ -92,18 +94,30 @@
  #endif
 #endif
 
+#include "native/juce_RuntimeSIMDKernels.cpp"
+
 #if JUCE_UNIT_TESTS
  #include "maths/juce_Matrix_test.cpp"
  #include "maths/juce_LogRampedValue_test.cpp"
+ #include "maths/juce_LookupTable_test.cpp"
 
  #if JUCE_USE_SIMD
   #include "containers/juce_SIMDRegister_test.cpp"
  #endif
 
  #include "containers/juce_AudioBlock_test.cpp"
+ #include "containers/juce_FixedChannelAudioBlock_test.cpp"
  #include "containers/juce_FixedSizeFunction_test.cpp"
  #include "frequency/juce_Convolution_test.cpp"
  #include "frequency/juce_FFT_test.cpp"
+ #include "frequency/juce_FixedSizeFFT_test.cpp"
+ #include "frequency/juce_SpectralProcessor_test.cpp"
+ #include "frequency/juce_SpectrogramEngine_test.cpp"
+ #include "processors/juce_DelayLine_test.cpp"
  #include "processors/juce_FIRFilter_test.cpp"
+ #include "processors/juce_GainRamp_test.cpp"
+ #include "processors/juce_IIRFilter_test.cpp"
  #include "processors/juce_ProcessorChain_test.cpp"
+ #include "processors/juce_StateVariableTPTFilter_test.cpp"
+ #include "widgets/juce_WavetableOscillatorBank_test.cpp"
 #endif
@@ -236,6 +236,7 @@ namespace juce
  #include "containers/juce_SIMDRegister.h"
 #endif
 
+#include "native/juce_RuntimeSIMDKernels.h"
 #include "maths/juce_SpecialFunctions.h"
 #include "maths/juce_Matrix.h"
 #include "maths/juce_Phase.h"
@@ -244,6 +245,7 @@ namespace juce
 #include "maths/juce_LookupTable.h"
 #include "maths/juce_LogRampedValue.h"
 #include "containers/juce_AudioBlock.h"
+#include "containers/juce_FixedChannelAudioBlock.h"
 #include "containers/juce_FixedSizeFunction.h"
 #include "processors/juce_ProcessContext.h"
 #include "processors/juce_ProcessorWrapper.h"
@@ -253,6 +255,7 @@ namespace juce
 #include "processors/juce_FIRFilter.h"
 #include "processors/juce_StateVariableFilter.h"
 #include "processors/juce_FirstOrderTPTFilter.h"
+#include "processors/juce_GainRamp.h"
 #include "processors/juce_Panner.h"
 #include "processors/juce_DelayLine.h"
 #include "processors/juce_Oversampling.h"
@@ -261,14 +264,18 @@ namespace juce
 #include "processors/juce_DryWetMixer.h"
 #include "processors/juce_StateVariableTPTFilter.h"
 #include "frequency/juce_FFT.h"
+#include "frequency/juce_FixedSizeFFT.h"
 #include "frequency/juce_Convolution.h"
 #include "frequency/juce_Windowing.h"
+#include "frequency/juce_SpectralProcessor.h"
+#include "frequency/juce_SpectrogramEngine.h"
 #include "filter_design/juce_FilterDesign.h"
 #include "widgets/juce_Reverb.h"
 #include "widgets/juce_Bias.h"
 #include "widgets/juce_Gain.h"
 #include "widgets/juce_WaveShaper.h"
 #include "widgets/juce_Oscillator.h"
+#include "widgets/juce_WavetableOscillatorBank.h"
 #include "widgets/juce_LadderFilter.h"
 #include "widgets/juce_Compressor.h"
 #include "widgets/juce_NoiseGate.h"
@@ -145,6 +145,153 @@ double LookupTableTransform<FloatType>::calculateRelativeDifference (double x, d
     return absDiff / std::min (absX, absY);
 }
 
+//==============================================================================
+template <typename FloatType>
+void NonUniformLookupTableTransform<FloatType>::initialise (const std::function<FloatType (FloatType)>& functionToApproximate,
+                                                            FloatType minInputValueToUse,
+                                                            FloatType maxInputValueToUse,
+                                                            double maxRelativeErrorToUse,
+                                                            size_t numSegmentsToUse)
+{
+    jassert (maxInputValueToUse > minInputValueToUse);
+    jassert (maxRelativeErrorToUse > 0);
+    jassert (numSegmentsToUse > 0);
+
+    minInputValue = minInputValueToUse;
+    maxInputValue = maxInputValueToUse;
+    segmentScaler = FloatType (numSegmentsToUse) / (maxInputValueToUse - minInputValueToUse);
+    segmentOffset = -minInputValueToUse * segmentScaler;
+
+    // Estimate how much resolution each segment needs. The error of linear
+    // interpolation grows with the curvature of the function, so giving each
+    // segment a share of the points proportional to sqrt (|f''|) roughly
+    // equalises the interpolation error across the input range.
+    const auto numSegments = (int) numSegmentsToUse;
+    constexpr int curvatureSamplesPerSegment = 16;
+
+    const auto clampedFunction = [&] (double x)
+    {
+        return (double) functionToApproximate (jlimit (minInputValueToUse, maxInputValueToUse, (FloatType) x));
+    };
+
+    auto h = ((double) maxInputValueToUse - (double) minInputValueToUse) / (numSegments * curvatureSamplesPerSegment);
+
+    Array<double> cumulativeShare;
+    cumulativeShare.resize (numSegments + 1);
+
+    double total = 0;
+
+    for (int s = 0; s < numSegments; ++s)
+    {
+        double density = 0;
+
+        for (int k = 0; k < curvatureSamplesPerSegment; ++k)
+        {
+            auto x = (double) minInputValueToUse + ((double) (s * curvatureSamplesPerSegment + k) + 0.5) * h;
+            auto curvature = (clampedFunction (x + h) - 2.0 * clampedFunction (x) + clampedFunction (x - h)) / (h * h);
+
+            if (std::isfinite (curvature))
+                density += std::sqrt (std::abs (curvature));
+        }
+
+        // every segment gets at least a small share, so that the warp stays
+        // strictly monotonic and flat regions still contain some points
+        total += density + 1.0;
+        cumulativeShare.set (s + 1, total);
+    }
+
+    for (int s = 0; s <= numSegments; ++s)
+        cumulativeShare.getReference (s) /= total;
+
+    // grow the table until the measured error meets the requested bound
+    constexpr size_t maxNumPoints = (size_t) 1 << 20;
+
+    for (auto numPoints = jmax ((size_t) 256, 4 * numSegmentsToUse);; numPoints *= 2)
+    {
+        buildTable (functionToApproximate, numPoints, cumulativeShare);
+
+        // The error is measured relative to the peak output magnitude rather than
+        // to each individual output value: close to a zero crossing the pointwise
+        // relative error of any interpolating table diverges, which would make
+        // the bound impossible to satisfy.
+        auto numTestPoints = 8 * numPoints;
+        double maxAbsoluteError = 0, peakMagnitude = 0;
+
+        for (size_t i = 0; i < numTestPoints; ++i)
+        {
+            auto inputValue = jmap (FloatType (i), FloatType (0), FloatType (numTestPoints - 1), minInputValueToUse, maxInputValueToUse);
+            auto approximatedOutputValue = (double) processSample (inputValue);
+            auto referenceOutputValue = (double) functionToApproximate (inputValue);
+
+            maxAbsoluteError = jmax (maxAbsoluteError, std::abs (referenceOutputValue - approximatedOutputValue));
+            peakMagnitude = jmax (peakMagnitude, std::abs (referenceOutputValue));
+        }
+
+        achievedMaxRelativeError = peakMagnitude > 0 ? maxAbsoluteError / peakMagnitude
+                                                     : maxAbsoluteError;
+        auto maxError = achievedMaxRelativeError;
+
+        if (maxError <= maxRelativeErrorToUse)
+            break;
+
+        if (numPoints >= maxNumPoints)
+        {
+            // If this is hit, the requested error bound couldn't be met even with a
+            // very large table - the function probably contains a discontinuity or
+            // a pole inside the specified input range.
+            jassertfalse;
+            break;
+        }
+    }
+}
+
+template <typename FloatType>
+void NonUniformLookupTableTransform<FloatType>::buildTable (const std::function<FloatType (FloatType)>& functionToApproximate,
+                                                            size_t numPoints,
+                                                            const Array<double>& cumulativeShare)
+{
+    auto numSegments = cumulativeShare.size() - 1;
+    auto segmentWidth = ((double) maxInputValue - (double) minInputValue) / numSegments;
+
+    Array<double> boundaryIndex;
+    boundaryIndex.resize (numSegments + 1);
+
+    for (int s = 0; s <= numSegments; ++s)
+        boundaryIndex.set (s, cumulativeShare[s] * (double) (numPoints - 1));
+
+    warpScale.resize (numSegments);
+    warpOffset.resize (numSegments);
+
+    for (int s = 0; s < numSegments; ++s)
+    {
+        auto segmentStart = (double) minInputValue + s * segmentWidth;
+        auto scale = (boundaryIndex[s + 1] - boundaryIndex[s]) / segmentWidth;
+
+        warpScale.set (s, (FloatType) scale);
+        warpOffset.set (s, (FloatType) (boundaryIndex[s] - segmentStart * scale));
+    }
+
+    // each table entry samples the function at the input value that the warp
+    // maps to that entry's index
+    Array<FloatType> values;
+    values.resize ((int) numPoints);
+
+    for (size_t i = 0, s = 0; i < numPoints; ++i)
+    {
+        auto index = (double) i;
+
+        while ((int) s < numSegments - 1 && boundaryIndex[(int) s + 1] < index)
+            ++s;
+
+        auto span = boundaryIndex[(int) s + 1] - boundaryIndex[(int) s];
+        auto x = (double) minInputValue + segmentWidth * ((double) s + (index - boundaryIndex[(int) s]) / span);
+
+        values.set ((int) i, functionToApproximate (jlimit (minInputValue, maxInputValue, (FloatType) x)));
+    }
+
+    lookupTable.initialise ([&values] (size_t i) { return values[(int) i]; }, numPoints);
+}
+
 //==============================================================================
 template class LookupTable<float>;
 template class LookupTable<double>;
@@ -152,5 +299,8 @@ template class LookupTable<double>;
 template class LookupTableTransform<float>;
 template class LookupTableTransform<double>;
 
+template class NonUniformLookupTableTransform<float>;
+template class NonUniformLookupTableTransform<double>;
+
 } // namespace dsp
 } // namespace juce
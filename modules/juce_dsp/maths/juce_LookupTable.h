@@ -28,6 +28,11 @@ namespace juce
 namespace dsp
 {
 
+#ifndef DOXYGEN
+template <typename SampleType>
+class AudioBlock;
+#endif
+
 /**
     Class for efficiently approximating expensive arithmetic operations.
 
@@ -285,6 +290,25 @@ public:
             output[i] = processSample (input[i]);
     }
 
+    //==============================================================================
+    /** Processes every channel of the input block and stores the results in the
+        output block, with range checking.
+
+        The blocks must have matching channel and sample counts.
+
+        @see process
+    */
+    void process (const AudioBlock<const FloatType>& inBlock, AudioBlock<FloatType>& outBlock) const noexcept
+    {
+        jassert (inBlock.getNumChannels() == outBlock.getNumChannels());
+        jassert (inBlock.getNumSamples()  == outBlock.getNumSamples());
+
+        for (size_t channel = 0; channel < inBlock.getNumChannels(); ++channel)
+            process (inBlock.getChannelPointer (channel),
+                     outBlock.getChannelPointer (channel),
+                     inBlock.getNumSamples());
+    }
+
     //==============================================================================
     /** Calculates the maximum relative error of the approximation for the specified
         parameter set.
@@ -326,5 +350,202 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LookupTableTransform)
 };
 
+//==============================================================================
+/** Class for approximating expensive arithmetic operations with a non-uniformly
+    sampled lookup table.
+
+    This behaves like LookupTableTransform, but instead of spacing its
+    pre-calculated points evenly across the input range, it assigns more points
+    to the regions where the approximated function bends the most. For functions
+    with localised steep regions - tanh, dB mappings and other waveshaper-style
+    curves - this reaches a given error budget with a much smaller table than
+    uniform sampling would need, making it more likely that the whole table
+    stays resident in the cache.
+
+    The input range is split into a fixed number of uniform segments, each of
+    which stores a linear mapping into the shared table, so a lookup costs just
+    one extra indexed read compared to LookupTableTransform. Rather than
+    specifying a table size, you specify the maximum error that you can
+    tolerate - measured relative to the largest output magnitude of the
+    function - and the table is grown until the measured error falls below
+    that bound.
+
+    Example:
+
+        NonUniformLookupTableTransform<float> tanhApprox ([] (float x) { return std::tanh (x); },
+                                                          -5.0f, 5.0f, 1.0e-4);
+        auto outValue = tanhApprox (4.2f);
+
+    @see LookupTableTransform, LookupTable
+
+    @tags{DSP}
+*/
+template <typename FloatType>
+class NonUniformLookupTableTransform
+{
+public:
+    //==============================================================================
+    /** Creates an uninitialised NonUniformLookupTableTransform object.
+
+        You need to call initialise() before using the object. Prefer using the
+        non-default constructor instead.
+
+        @see initialise
+    */
+    NonUniformLookupTableTransform() = default;
+
+    //==============================================================================
+    /** Creates and initialises a NonUniformLookupTableTransform object.
+
+        @param functionToApproximate The function to be approximated. This should be a
+                                     mapping from a FloatType to FloatType.
+        @param minInputValueToUse    The lowest input value used. The approximation will
+                                     fail for values lower than this.
+        @param maxInputValueToUse    The highest input value used. The approximation will
+                                     fail for values higher than this.
+        @param maxRelativeErrorToUse The maximum error to allow, measured relative to the
+                                     largest output magnitude of the function over the
+                                     specified range. The number of pre-calculated values
+                                     is doubled until the measured error falls below this
+                                     bound.
+        @param numSegmentsToUse      The number of uniform segments the input range is
+                                     split into when distributing the points.
+    */
+    NonUniformLookupTableTransform (const std::function<FloatType (FloatType)>& functionToApproximate,
+                                    FloatType minInputValueToUse,
+                                    FloatType maxInputValueToUse,
+                                    double maxRelativeErrorToUse,
+                                    size_t numSegmentsToUse = 64)
+    {
+        initialise (functionToApproximate, minInputValueToUse, maxInputValueToUse,
+                    maxRelativeErrorToUse, numSegmentsToUse);
+    }
+
+    //==============================================================================
+    /** Initialises or changes the parameters of a NonUniformLookupTableTransform object.
+
+        @param functionToApproximate The function to be approximated. This should be a
+                                     mapping from a FloatType to FloatType.
+        @param minInputValueToUse    The lowest input value used. The approximation will
+                                     fail for values lower than this.
+        @param maxInputValueToUse    The highest input value used. The approximation will
+                                     fail for values higher than this.
+        @param maxRelativeErrorToUse The maximum error to allow, measured relative to the
+                                     largest output magnitude of the function over the
+                                     specified range. The number of pre-calculated values
+                                     is doubled until the measured error falls below this
+                                     bound.
+        @param numSegmentsToUse      The number of uniform segments the input range is
+                                     split into when distributing the points.
+    */
+    void initialise (const std::function<FloatType (FloatType)>& functionToApproximate,
+                     FloatType minInputValueToUse,
+                     FloatType maxInputValueToUse,
+                     double maxRelativeErrorToUse,
+                     size_t numSegmentsToUse = 64);
+
+    //==============================================================================
+    /** Calculates the approximated value for the given input value without range checking.
+
+        Use this if you can guarantee that the input value is within the range specified
+        in the constructor or initialise(), otherwise use processSample().
+
+        @see processSample, operator(), operator[]
+    */
+    FloatType processSampleUnchecked (FloatType value) const noexcept
+    {
+        jassert (value >= minInputValue && value <= maxInputValue);
+
+        auto segment = jlimit (0, warpScale.size() - 1, (int) (segmentScaler * value + segmentOffset));
+        auto index = jmax (FloatType (0), warpScale.getUnchecked (segment) * value + warpOffset.getUnchecked (segment));
+
+        return lookupTable[index];
+    }
+
+    //==============================================================================
+    /** Calculates the approximated value for the given input value with range checking.
+
+        This can be called with any input values. Out-of-range input values will be
+        clipped to the specified input range.
+
+        @see processSampleUnchecked, operator(), operator[]
+    */
+    FloatType processSample (FloatType value) const noexcept
+    {
+        return processSampleUnchecked (jlimit (minInputValue, maxInputValue, value));
+    }
+
+    //==============================================================================
+    /** @see processSampleUnchecked */
+    FloatType operator[] (FloatType value) const noexcept       { return processSampleUnchecked (value); }
+
+    /** @see processSample */
+    FloatType operator() (FloatType value) const noexcept       { return processSample (value); }
+
+    //==============================================================================
+    /** Processes an array of input values without range checking
+        @see process
+    */
+    void processUnchecked (const FloatType* input, FloatType* output, size_t numSamples) const noexcept
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+            output[i] = processSampleUnchecked (input[i]);
+    }
+
+    //==============================================================================
+    /** Processes an array of input values with range checking
+        @see processUnchecked
+    */
+    void process (const FloatType* input, FloatType* output, size_t numSamples) const noexcept
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+            output[i] = processSample (input[i]);
+    }
+
+    //==============================================================================
+    /** Processes every channel of the input block and stores the results in the
+        output block, with range checking.
+
+        The blocks must have matching channel and sample counts.
+
+        @see process
+    */
+    void process (const AudioBlock<const FloatType>& inBlock, AudioBlock<FloatType>& outBlock) const noexcept
+    {
+        jassert (inBlock.getNumChannels() == outBlock.getNumChannels());
+        jassert (inBlock.getNumSamples()  == outBlock.getNumSamples());
+
+        for (size_t channel = 0; channel < inBlock.getNumChannels(); ++channel)
+            process (inBlock.getChannelPointer (channel),
+                     outBlock.getChannelPointer (channel),
+                     inBlock.getNumSamples());
+    }
+
+    //==============================================================================
+    /** Returns the number of pre-calculated values stored. */
+    size_t getNumPoints() const noexcept                        { return lookupTable.getNumPoints(); }
+
+    /** Returns the maximum error that was measured when the table was built, relative
+        to the largest output magnitude of the function over the input range. */
+    double getMaxRelativeError() const noexcept                 { return achievedMaxRelativeError; }
+
+    /** Returns true if the table is initialised and ready to be used. */
+    bool isInitialised() const noexcept                         { return lookupTable.isInitialised(); }
+
+private:
+    //==============================================================================
+    void buildTable (const std::function<FloatType (FloatType)>&, size_t numPoints, const Array<double>& cumulativeShare);
+
+    //==============================================================================
+    LookupTable<FloatType> lookupTable;
+    Array<FloatType> warpScale, warpOffset;
+
+    FloatType minInputValue, maxInputValue;
+    FloatType segmentScaler, segmentOffset;
+    double achievedMaxRelativeError = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (NonUniformLookupTableTransform)
+};
+
 } // namespace dsp
 } // namespace juce
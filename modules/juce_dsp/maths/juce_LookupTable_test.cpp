@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class LookupTableTests  : public UnitTest
+{
+public:
+    LookupTableTests()
+        : UnitTest ("LookupTableTests", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        // a waveshaper-style curve with a steep region around zero
+        const auto tanhFunction = [] (float x) { return std::tanh (25.0f * x); };
+        constexpr float minInput = -5.0f, maxInput = 5.0f;
+        constexpr double errorBound = 1.0e-4;
+
+        // measures the error of an approximation relative to the peak output magnitude
+        const auto measureError = [&] (const std::function<float (float)>& approximation)
+        {
+            constexpr int numTestPoints = 100000;
+            double maxAbsoluteError = 0, peakMagnitude = 0;
+
+            for (int i = 0; i < numTestPoints; ++i)
+            {
+                auto x = jmap ((float) i, 0.0f, (float) (numTestPoints - 1), minInput, maxInput);
+                maxAbsoluteError = jmax (maxAbsoluteError, std::abs ((double) approximation (x) - (double) tanhFunction (x)));
+                peakMagnitude = jmax (peakMagnitude, std::abs ((double) tanhFunction (x)));
+            }
+
+            return maxAbsoluteError / peakMagnitude;
+        };
+
+        beginTest ("Non-uniform tables meet the requested error bound");
+        {
+            NonUniformLookupTableTransform<float> transform (tanhFunction, minInput, maxInput, errorBound);
+            expect (transform.isInitialised());
+            expect (transform.getMaxRelativeError() <= errorBound);
+
+            // allow a little headroom, as these test points don't exactly match the
+            // points used for the error measurement during construction
+            expect (measureError ([&] (float x) { return transform.processSample (x); }) <= 2.0 * errorBound);
+        }
+
+        beginTest ("Non-uniform tables are smaller than uniform tables of the same accuracy");
+        {
+            NonUniformLookupTableTransform<float> transform (tanhFunction, minInput, maxInput, errorBound);
+
+            size_t uniformNumPoints = 256;
+
+            for (;;)
+            {
+                LookupTableTransform<float> uniform (tanhFunction, minInput, maxInput, uniformNumPoints);
+
+                if (measureError ([&] (float x) { return uniform.processSample (x); }) <= errorBound
+                     || uniformNumPoints >= (size_t) 1 << 22)
+                    break;
+
+                uniformNumPoints *= 2;
+            }
+
+            expect (transform.getNumPoints() < uniformNumPoints);
+        }
+
+        beginTest ("Out-of-range inputs are clipped to the table limits");
+        {
+            NonUniformLookupTableTransform<float> transform (tanhFunction, minInput, maxInput, errorBound);
+
+            expectWithinAbsoluteError (transform (-100.0f), transform.processSampleUnchecked (minInput), 1.0e-6f);
+            expectWithinAbsoluteError (transform (100.0f),  transform.processSampleUnchecked (maxInput), 1.0e-6f);
+        }
+
+        beginTest ("Block processing matches per-sample processing");
+        {
+            NonUniformLookupTableTransform<float> nonUniform (tanhFunction, minInput, maxInput, errorBound);
+            LookupTableTransform<float> uniform (tanhFunction, minInput, maxInput, 512);
+
+            Random random (4321);
+            constexpr size_t numChannels = 2, numSamples = 257;
+
+            HeapBlock<char> inData, outData;
+            auto inBlock  = AudioBlock<float> (inData,  numChannels, numSamples);
+            auto outBlock = AudioBlock<float> (outData, numChannels, numSamples);
+
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                for (size_t i = 0; i < numSamples; ++i)
+                    inBlock.setSample ((int) ch, (int) i, jmap (random.nextFloat(), -8.0f, 8.0f));
+
+            AudioBlock<const float> constInBlock (inBlock);
+
+            nonUniform.process (constInBlock, outBlock);
+
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                for (size_t i = 0; i < numSamples; ++i)
+                    expectEquals (outBlock.getSample ((int) ch, (int) i),
+                                  nonUniform.processSample (inBlock.getSample ((int) ch, (int) i)));
+
+            uniform.process (constInBlock, outBlock);
+
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                for (size_t i = 0; i < numSamples; ++i)
+                    expectEquals (outBlock.getSample ((int) ch, (int) i),
+                                  uniform.processSample (inBlock.getSample ((int) ch, (int) i)));
+        }
+    }
+};
+
+static LookupTableTests lookupTableTests;
+
+} // namespace dsp
+} // namespace juce
@@ -28,6 +28,9 @@ namespace juce
 namespace dsp
 {
 
+template <typename SampleType>
+class AudioBlock;
+
 /**
     General matrix and vectors class, meant for classic math manipulation such as
     additions, multiplications, and linear systems of equations solving.
@@ -160,6 +163,28 @@ public:
     /** Matrix multiplication */
     Matrix operator* (const Matrix& other) const;
 
+    /** Multiplies this matrix by a column vector, writing the product into
+        outputVector.
+
+        inputVector must hold getNumColumns() values and outputVector must
+        have room for getNumRows() values; the two must not overlap. This
+        never allocates, so it's safe to call from the audio thread.
+    */
+    void multiplyVector (const ElementType* inputVector, ElementType* outputVector) const noexcept;
+
+    /** Mixes the channels of an audio block through this matrix, treating
+        each sample frame as a column vector.
+
+        Output channel r receives sum over c of (*this)(r, c) * input channel c,
+        so the input block must have at least getNumColumns() channels and the
+        output block at least getNumRows(). The output channels must not alias
+        the input channels - to matrix a block in place, mix into a scratch
+        block and copy back.
+
+        This never allocates, so it's safe to call from the audio thread.
+    */
+    void multiplyInto (const AudioBlock<const ElementType>& input, AudioBlock<ElementType>& output) const noexcept;
+
     /** Does a hadarmard product with the receiver and other and stores the result in the receiver */
     inline Matrix& hadarmard (const Matrix& other) noexcept             { return apply (other, [] (ElementType a, ElementType b) { return a * b; } ); }
 
@@ -118,6 +118,96 @@ struct LinearAlgebraUnitTest  : public UnitTest
         }
     };
 
+    struct LargeMultiplicationTest
+    {
+        // Sizes chosen to exercise the blocked kernel's remainder paths
+        template <typename ElementType>
+        static void run (LinearAlgebraUnitTest& u)
+        {
+            const size_t n = 66, m = 37, p = 70;
+
+            Random random (0x3cf2a);
+            Matrix<ElementType> a (n, p), b (p, m);
+
+            for (auto& value : a)   value = static_cast<ElementType> (random.nextDouble() * 2.0 - 1.0);
+            for (auto& value : b)   value = static_cast<ElementType> (random.nextDouble() * 2.0 - 1.0);
+
+            Matrix<ElementType> expected (n, m);
+
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = 0; j < m; ++j)
+                {
+                    ElementType sum = {};
+
+                    for (size_t k = 0; k < p; ++k)
+                        sum += a (i, k) * b (k, j);
+
+                    expected (i, j) = sum;
+                }
+
+            u.expect (Matrix<ElementType>::compare (a * b, expected, (ElementType) 1e-3));
+        }
+    };
+
+    struct MatrixVectorMultiplicationTest
+    {
+        template <typename ElementType>
+        static void run (LinearAlgebraUnitTest& u)
+        {
+            const size_t n = 23, p = 66;
+
+            Random random (0x6b81d);
+            Matrix<ElementType> a (n, p), x (p, 1);
+
+            for (auto& value : a)   value = static_cast<ElementType> (random.nextDouble() * 2.0 - 1.0);
+            for (auto& value : x)   value = static_cast<ElementType> (random.nextDouble() * 2.0 - 1.0);
+
+            Matrix<ElementType> result (n, 1);
+            a.multiplyVector (x.getRawDataPointer(), result.getRawDataPointer());
+
+            u.expect (Matrix<ElementType>::compare (result, a * x, (ElementType) 1e-3));
+        }
+    };
+
+    struct AudioBlockMatrixingTest
+    {
+        template <typename ElementType>
+        static void run (LinearAlgebraUnitTest& u)
+        {
+            const size_t numInputs = 4, numOutputs = 3, numSamples = 64;
+
+            Random random (0x18d9c);
+            Matrix<ElementType> mixer (numOutputs, numInputs);
+
+            for (auto& value : mixer)
+                value = static_cast<ElementType> (random.nextDouble() * 2.0 - 1.0);
+
+            HeapBlock<char> inputData, outputData;
+            AudioBlock<ElementType> inputBlock (inputData, numInputs, numSamples);
+            AudioBlock<ElementType> outputBlock (outputData, numOutputs, numSamples);
+
+            for (size_t ch = 0; ch < numInputs; ++ch)
+                for (size_t i = 0; i < numSamples; ++i)
+                    inputBlock.setSample ((int) ch, (int) i, static_cast<ElementType> (random.nextDouble() * 2.0 - 1.0));
+
+            mixer.multiplyInto (AudioBlock<const ElementType> (inputBlock), outputBlock);
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                Matrix<ElementType> frame (numInputs, 1), expected (numOutputs, 1);
+
+                for (size_t ch = 0; ch < numInputs; ++ch)
+                    frame (ch, 0) = inputBlock.getSample ((int) ch, (int) i);
+
+                mixer.multiplyVector (frame.getRawDataPointer(), expected.getRawDataPointer());
+
+                for (size_t ch = 0; ch < numOutputs; ++ch)
+                    u.expectWithinAbsoluteError (outputBlock.getSample ((int) ch, (int) i),
+                                                 expected (ch, 0), (ElementType) 1e-3);
+            }
+        }
+    };
+
     struct IdentityMatrixTest
     {
         template <typename ElementType>
@@ -162,6 +252,9 @@ struct LinearAlgebraUnitTest  : public UnitTest
         runTestForAllTypes<ScalarMultiplicationTest> ("ScalarMultiplication");
         runTestForAllTypes<HadamardProductTest> ("HadamardProductTest");
         runTestForAllTypes<MultiplicationTest> ("MultiplicationTest");
+        runTestForAllTypes<LargeMultiplicationTest> ("LargeMultiplicationTest");
+        runTestForAllTypes<MatrixVectorMultiplicationTest> ("MatrixVectorMultiplicationTest");
+        runTestForAllTypes<AudioBlockMatrixingTest> ("AudioBlockMatrixingTest");
         runTestForAllTypes<IdentityMatrixTest> ("IdentityMatrixTest");
         runTestForAllTypes<SolvingTest> ("SolvingTest");
     }
@@ -0,0 +1,211 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+
+ // These compilers can compile AVX intrinsics in individual functions even when
+ // the translation unit's baseline architecture is plain SSE2, which is what
+ // makes the run-time selection below possible.
+ #if JUCE_GCC || JUCE_CLANG
+  #define JUCE_DSP_HAS_AVX2_KERNELS 1
+  #define JUCE_DSP_HAS_AVX512_KERNELS 1
+  #define JUCE_DSP_AVX2_TARGET    __attribute__ ((target ("avx2")))
+  #define JUCE_DSP_AVX512_TARGET  __attribute__ ((target ("avx512f")))
+ #elif JUCE_MSVC
+  // MSVC allows intrinsics of any width to be used without changing /arch
+  #define JUCE_DSP_HAS_AVX2_KERNELS 1
+  #if _MSC_VER >= 1911
+   #define JUCE_DSP_HAS_AVX512_KERNELS 1
+  #endif
+  #define JUCE_DSP_AVX2_TARGET
+  #define JUCE_DSP_AVX512_TARGET
+ #endif
+#endif
+
+namespace juce
+{
+namespace dsp
+{
+
+template <typename FloatType>
+static FloatType dotProductFallback (const FloatType* a, const FloatType* b, size_t num) noexcept
+{
+    FloatType sum (0);
+
+    for (size_t i = 0; i < num; ++i)
+        sum += a[i] * b[i];
+
+    return sum;
+}
+
+static float  dotProductFallbackFloat  (const float* a,  const float* b,  size_t num) noexcept  { return dotProductFallback (a, b, num); }
+static double dotProductFallbackDouble (const double* a, const double* b, size_t num) noexcept  { return dotProductFallback (a, b, num); }
+
+//==============================================================================
+#if JUCE_DSP_HAS_AVX2_KERNELS
+
+JUCE_DSP_AVX2_TARGET
+static float dotProductAVX2Float (const float* a, const float* b, size_t num) noexcept
+{
+    auto sum = _mm256_setzero_ps();
+    size_t i = 0;
+
+    for (; i + 8 <= num; i += 8)
+        sum = _mm256_add_ps (sum, _mm256_mul_ps (_mm256_loadu_ps (a + i),
+                                                 _mm256_loadu_ps (b + i)));
+
+    alignas (32) float lanes[8];
+    _mm256_store_ps (lanes, sum);
+
+    auto total = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3]))
+                  + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+
+    for (; i < num; ++i)
+        total += a[i] * b[i];
+
+    return total;
+}
+
+JUCE_DSP_AVX2_TARGET
+static double dotProductAVX2Double (const double* a, const double* b, size_t num) noexcept
+{
+    auto sum = _mm256_setzero_pd();
+    size_t i = 0;
+
+    for (; i + 4 <= num; i += 4)
+        sum = _mm256_add_pd (sum, _mm256_mul_pd (_mm256_loadu_pd (a + i),
+                                                 _mm256_loadu_pd (b + i)));
+
+    alignas (32) double lanes[4];
+    _mm256_store_pd (lanes, sum);
+
+    auto total = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+    for (; i < num; ++i)
+        total += a[i] * b[i];
+
+    return total;
+}
+
+#endif
+
+//==============================================================================
+#if JUCE_DSP_HAS_AVX512_KERNELS
+
+JUCE_DSP_AVX512_TARGET
+static float dotProductAVX512Float (const float* a, const float* b, size_t num) noexcept
+{
+    auto sum = _mm512_setzero_ps();
+    size_t i = 0;
+
+    for (; i + 16 <= num; i += 16)
+        sum = _mm512_add_ps (sum, _mm512_mul_ps (_mm512_loadu_ps (a + i),
+                                                 _mm512_loadu_ps (b + i)));
+
+    alignas (64) float lanes[16];
+    _mm512_store_ps (lanes, sum);
+
+    auto total = (((lanes[0]  + lanes[1])  + (lanes[2]  + lanes[3]))
+                   + ((lanes[4]  + lanes[5])  + (lanes[6]  + lanes[7])))
+                  + (((lanes[8]  + lanes[9])  + (lanes[10] + lanes[11]))
+                   + ((lanes[12] + lanes[13]) + (lanes[14] + lanes[15])));
+
+    for (; i < num; ++i)
+        total += a[i] * b[i];
+
+    return total;
+}
+
+JUCE_DSP_AVX512_TARGET
+static double dotProductAVX512Double (const double* a, const double* b, size_t num) noexcept
+{
+    auto sum = _mm512_setzero_pd();
+    size_t i = 0;
+
+    for (; i + 8 <= num; i += 8)
+        sum = _mm512_add_pd (sum, _mm512_mul_pd (_mm512_loadu_pd (a + i),
+                                                 _mm512_loadu_pd (b + i)));
+
+    alignas (64) double lanes[8];
+    _mm512_store_pd (lanes, sum);
+
+    auto total = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3]))
+                  + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+
+    for (; i < num; ++i)
+        total += a[i] * b[i];
+
+    return total;
+}
+
+#endif
+
+//==============================================================================
+struct SelectedKernels
+{
+    float  (*dotProductFloat)  (const float*,  const float*,  size_t);
+    double (*dotProductDouble) (const double*, const double*, size_t);
+    int vectorWidthBits;
+};
+
+static const SelectedKernels& getSelectedKernels() noexcept
+{
+    static const SelectedKernels selected = []() -> SelectedKernels
+    {
+       #if JUCE_DSP_HAS_AVX512_KERNELS
+        if (SystemStats::hasAVX512F())
+            return { dotProductAVX512Float, dotProductAVX512Double, 512 };
+       #endif
+
+       #if JUCE_DSP_HAS_AVX2_KERNELS
+        if (SystemStats::hasAVX2())
+            return { dotProductAVX2Float, dotProductAVX2Double, 256 };
+       #endif
+
+        return { dotProductFallbackFloat, dotProductFallbackDouble, 128 };
+    }();
+
+    return selected;
+}
+
+//==============================================================================
+int RuntimeSIMDKernels::getPreferredVectorWidthBits() noexcept
+{
+    return getSelectedKernels().vectorWidthBits;
+}
+
+float RuntimeSIMDKernels::dotProduct (const float* a, const float* b, size_t num) noexcept
+{
+    return getSelectedKernels().dotProductFloat (a, b, num);
+}
+
+double RuntimeSIMDKernels::dotProduct (const double* a, const double* b, size_t num) noexcept
+{
+    return getSelectedKernels().dotProductDouble (a, b, num);
+}
+
+} // namespace dsp
+} // namespace juce
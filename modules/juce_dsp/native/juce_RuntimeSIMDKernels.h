@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+//==============================================================================
+/**
+    Vector kernels that are compiled for several SIMD widths, with the widest
+    variant supported by the machine the code is actually running on selected
+    at run-time.
+
+    SIMDRegister's width is a compile-time constant that's baked into its type,
+    so code built for a baseline of SSE2 or NEON can't make use of the wider
+    vector units found on newer CPUs. On x86, these kernels are additionally
+    compiled for AVX2 and AVX-512, and the first call checks the CPU's
+    capabilities and picks the widest usable implementation - so a binary built
+    for a plain SSE2 baseline will still use 256-bit or 512-bit lanes where the
+    hardware has them. On other architectures (and compilers without support
+    for per-function targets) they simply fall back to portable code.
+
+    @see SIMDRegister, FIR::Filter
+
+    @tags{DSP}
+*/
+struct RuntimeSIMDKernels
+{
+    /** Returns the width in bits (128, 256 or 512) of the widest vector unit
+        that these kernels will use on this machine.
+    */
+    static int getPreferredVectorWidthBits() noexcept;
+
+    /** Returns the dot product of two float arrays. */
+    static float dotProduct (const float* a, const float* b, size_t num) noexcept;
+
+    /** Returns the dot product of two double arrays. */
+    static double dotProduct (const double* a, const double* b, size_t num) noexcept;
+};
+
+} // namespace dsp
+} // namespace juce
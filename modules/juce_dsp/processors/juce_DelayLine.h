@@ -160,6 +160,82 @@ public:
     */
     SampleType popSample (int channel, SampleType delayInSamples = -1, bool updateReadPointer = true);
 
+    //==============================================================================
+    /** Pushes a whole block of samples into one channel of the delay line.
+
+        This is equivalent to calling pushSample for each value in turn, and is
+        intended for use with popBlockMultiTap: push the input block first, then
+        read all the taps from it in one call.
+
+        @see pushSample, popBlockMultiTap
+    */
+    void pushBlock (int channel, const SampleType* inputSamples, int numSamples)
+    {
+        jassert (isPositiveAndBelow (channel, bufferData.getNumChannels()));
+        jassert (numSamples <= totalSize);
+
+        auto* buffer = bufferData.getWritePointer (channel);
+        auto pos = writePos[(size_t) channel];
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            buffer[pos] = inputSamples[i];
+            pos = (pos == 0 ? totalSize - 1 : pos - 1);
+        }
+
+        writePos[(size_t) channel] = pos;
+    }
+
+    /** Reads a whole block of output for several delay taps in one call.
+
+        This produces the same result as looping over the block calling popSample
+        once per tap with updateReadPointer set to false, but it hoists the
+        circular-buffer arithmetic and fractional-delay setup out of the per-tap
+        inner loops, which makes a big difference to dense tap configurations
+        such as a modulated multi-tap chorus.
+
+        To use it, push the corresponding input with pushBlock() first, then pass
+        one array of per-sample fractional delay times and one output array for
+        each tap. Because the whole input block is pushed before any taps are
+        read, the delay line needs enough headroom to keep the oldest samples
+        alive: make sure that setMaximumDelayInSamples() allows for the largest
+        tap delay plus the maximum block size.
+
+        Note that Thiran interpolation is stateful per-tap, so it isn't supported
+        by this function; use Lagrange3rd for modulated taps instead.
+
+        @param channel             the target channel for the delay line
+        @param delayTimesPerTap    numTaps arrays, each holding numSamples fractional
+                                   delay times in samples
+        @param outputPerTap        numTaps arrays, each receiving numSamples of output
+        @param numTaps             the number of taps to read
+        @param numSamples          the number of samples in the block
+        @param updateReadPointer   true to advance the read pointer past the block
+                                   afterwards, as popSample would
+
+        @see pushBlock, popSample
+    */
+    template <typename T = InterpolationType>
+    typename std::enable_if <! std::is_same <T, DelayLineInterpolationTypes::Thiran>::value, void>::type
+    popBlockMultiTap (int channel,
+                      const SampleType* const* delayTimesPerTap,
+                      SampleType* const* outputPerTap,
+                      int numTaps, int numSamples,
+                      bool updateReadPointer = true)
+    {
+        jassert (isPositiveAndBelow (channel, bufferData.getNumChannels()));
+        jassert (numTaps >= 0 && numSamples >= 0 && numSamples <= totalSize);
+
+        auto* buffer = bufferData.getReadPointer (channel);
+        auto basePos = readPos[(size_t) channel];
+
+        for (int tap = 0; tap < numTaps; ++tap)
+            readTapBlock (buffer, basePos, delayTimesPerTap[tap], outputPerTap[tap], numSamples);
+
+        if (updateReadPointer)
+            readPos[(size_t) channel] = (basePos + totalSize - (numSamples % totalSize)) % totalSize;
+    }
+
     //==============================================================================
     /** Processes the input and output samples supplied in the processing context.
 
@@ -286,6 +362,99 @@ private:
         return output;
     }
 
+    //==============================================================================
+    // These read one tap's worth of output for a whole block. The index for
+    // sample i is taken relative to the block-start read position, so several
+    // taps can be read without moving the read pointer between them.
+    template <typename T = InterpolationType>
+    typename std::enable_if <std::is_same <T, DelayLineInterpolationTypes::None>::value, void>::type
+    readTapBlock (const SampleType* buffer, int basePos, const SampleType* delayTimes, SampleType* output, int numSamples) const
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto index = basePos + totalSize - i + static_cast<int> (std::floor (delayTimes[i]));
+
+            while (index >= totalSize)
+                index -= totalSize;
+
+            output[i] = buffer[index];
+        }
+    }
+
+    template <typename T = InterpolationType>
+    typename std::enable_if <std::is_same <T, DelayLineInterpolationTypes::Linear>::value, void>::type
+    readTapBlock (const SampleType* buffer, int basePos, const SampleType* delayTimes, SampleType* output, int numSamples) const
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto tapDelay = delayTimes[i];
+            auto tapDelayInt = static_cast<int> (std::floor (tapDelay));
+            auto tapDelayFrac = tapDelay - (SampleType) tapDelayInt;
+
+            auto index1 = basePos + totalSize - i + tapDelayInt;
+
+            while (index1 >= totalSize)
+                index1 -= totalSize;
+
+            auto index2 = index1 + 1 == totalSize ? 0 : index1 + 1;
+
+            auto value1 = buffer[index1];
+            auto value2 = buffer[index2];
+
+            output[i] = value1 + tapDelayFrac * (value2 - value1);
+        }
+    }
+
+    template <typename T = InterpolationType>
+    typename std::enable_if <std::is_same <T, DelayLineInterpolationTypes::Lagrange3rd>::value, void>::type
+    readTapBlock (const SampleType* buffer, int basePos, const SampleType* delayTimes, SampleType* output, int numSamples) const
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto tapDelay = delayTimes[i];
+            auto tapDelayInt = static_cast<int> (std::floor (tapDelay));
+            auto tapDelayFrac = tapDelay - (SampleType) tapDelayInt;
+
+            if (tapDelayInt >= 1)
+            {
+                tapDelayFrac++;
+                tapDelayInt--;
+            }
+
+            auto index1 = basePos + totalSize - i + tapDelayInt;
+
+            while (index1 >= totalSize)
+                index1 -= totalSize;
+
+            auto index2 = index1 + 1;
+            auto index3 = index2 + 1;
+            auto index4 = index3 + 1;
+
+            if (index4 >= totalSize)
+            {
+                index2 %= totalSize;
+                index3 %= totalSize;
+                index4 %= totalSize;
+            }
+
+            auto value1 = buffer[index1];
+            auto value2 = buffer[index2];
+            auto value3 = buffer[index3];
+            auto value4 = buffer[index4];
+
+            auto d1 = tapDelayFrac - 1.f;
+            auto d2 = tapDelayFrac - 2.f;
+            auto d3 = tapDelayFrac - 3.f;
+
+            auto c1 = -d1 * d2 * d3 / 6.f;
+            auto c2 = d2 * d3 * 0.5f;
+            auto c3 = -d1 * d3 * 0.5f;
+            auto c4 = d1 * d2 / 6.f;
+
+            output[i] = value1 * c1 + tapDelayFrac * (value2 * c2 + value3 * c3 + value4 * c4);
+        }
+    }
+
     //==============================================================================
     template <typename T = InterpolationType>
     typename std::enable_if <std::is_same <T, DelayLineInterpolationTypes::None>::value, void>::type
@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class DelayLineTests  : public UnitTest
+{
+public:
+    DelayLineTests()
+        : UnitTest ("DelayLine", UnitTestCategories::dsp)
+    {}
+
+    template <typename InterpolationType>
+    void runMultiTapTestForType (const String& typeName)
+    {
+        beginTest ("Multi-tap block reads match per-sample popSample: " + typeName);
+
+        constexpr int numTaps = 16, numBlocks = 4, blockSize = 128, maxTapDelay = 300;
+        auto random = getRandom();
+
+        DelayLine<float, InterpolationType> blockDelay (maxTapDelay + blockSize);
+        DelayLine<float, InterpolationType> referenceDelay (maxTapDelay + blockSize);
+
+        const ProcessSpec spec { 44100.0, (uint32) blockSize, 1 };
+        blockDelay.prepare (spec);
+        referenceDelay.prepare (spec);
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            float input[blockSize];
+            float delayTimes[numTaps][blockSize];
+            float blockOutput[numTaps][blockSize];
+            float referenceOutput[numTaps][blockSize];
+
+            const float* delaysPerTap[numTaps];
+            float* outputPerTap[numTaps];
+
+            for (int tap = 0; tap < numTaps; ++tap)
+            {
+                delaysPerTap[tap] = delayTimes[tap];
+                outputPerTap[tap] = blockOutput[tap];
+            }
+
+            for (int i = 0; i < blockSize; ++i)
+            {
+                input[i] = random.nextFloat() * 2.0f - 1.0f;
+
+                // slowly-modulated fractional delays, a few samples apart per tap
+                for (int tap = 0; tap < numTaps; ++tap)
+                    delayTimes[tap][i] = 4.0f + (float) tap * 18.0f
+                                          + 3.0f * std::sin ((float) (block * blockSize + i) * 0.01f + (float) tap);
+
+                if (std::is_same<InterpolationType, DelayLineInterpolationTypes::None>::value)
+                    for (int tap = 0; tap < numTaps; ++tap)
+                        delayTimes[tap][i] = std::floor (delayTimes[tap][i]);
+            }
+
+            // reference: interleaved per-sample pushes and multi-tap pops
+            for (int i = 0; i < blockSize; ++i)
+            {
+                referenceDelay.pushSample (0, input[i]);
+
+                for (int tap = 0; tap < numTaps; ++tap)
+                    referenceOutput[tap][i] = referenceDelay.popSample (0, delayTimes[tap][i], false);
+
+                referenceDelay.popSample (0, delayTimes[0][i], true);
+            }
+
+            blockDelay.pushBlock (0, input, blockSize);
+            blockDelay.popBlockMultiTap (0, delaysPerTap, outputPerTap, numTaps, blockSize);
+
+            for (int tap = 0; tap < numTaps; ++tap)
+                for (int i = 0; i < blockSize; ++i)
+                    expectWithinAbsoluteError (blockOutput[tap][i], referenceOutput[tap][i], 1.0e-5f);
+        }
+    }
+
+    void runTest() override
+    {
+        runMultiTapTestForType<DelayLineInterpolationTypes::None> ("None");
+        runMultiTapTestForType<DelayLineInterpolationTypes::Linear> ("Linear");
+        runMultiTapTestForType<DelayLineInterpolationTypes::Lagrange3rd> ("Lagrange3rd");
+    }
+};
+
+static DelayLineTests delayLineTests;
+
+} // namespace dsp
+} // namespace juce
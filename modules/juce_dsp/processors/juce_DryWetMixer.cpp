@@ -79,6 +79,7 @@ void DryWetMixer<SampleType>::prepare (const ProcessSpec& spec)
     sampleRate = spec.sampleRate;
 
     dryDelayLine.prepare (spec);
+    gainRamp.prepare (spec);
     bufferDry.setSize ((int) spec.numChannels, (int) spec.maximumBlockSize, false, false, true);
 
     update();
@@ -128,7 +129,7 @@ void DryWetMixer<SampleType>::pushDrySamples (const AudioBlock<const SampleType>
 template <typename SampleType>
 void DryWetMixer<SampleType>::mixWetSamples (AudioBlock<SampleType> inOutBlock)
 {
-    inOutBlock.multiplyBy (wetVolume);
+    gainRamp.applyGain (wetVolume, inOutBlock);
 
     jassert (inOutBlock.getNumSamples() <= (size_t) fifo.getNumReadable());
 
@@ -141,8 +142,10 @@ void DryWetMixer<SampleType>::mixWetSamples (AudioBlock<SampleType> inOutBlock)
 
         auto block = AudioBlock<SampleType> (bufferDry).getSubsetChannelBlock (0, inOutBlock.getNumChannels())
                                                        .getSubBlock ((size_t) range.getStart(), (size_t) range.getLength());
-        block.multiplyBy (dryVolume);
-        inOutBlock.getSubBlock ((size_t) offset).add (block);
+
+        // A single add-with-multiply pass, rather than scaling the dry
+        // buffer in place and then adding it.
+        gainRamp.addWithGain (inOutBlock.getSubBlock ((size_t) offset, (size_t) range.getLength()), block, dryVolume);
 
         offset += range.getLength();
     }
@@ -106,6 +106,7 @@ private:
 
     //==============================================================================
     SmoothedValue<SampleType, ValueSmoothingTypes::Linear> dryVolume, wetVolume;
+    GainRamp<SampleType> gainRamp;
     DelayLine<SampleType, DelayLineInterpolationTypes::Thiran> dryDelayLine;
     AudioBuffer<SampleType> bufferDry;
 
@@ -186,22 +186,37 @@ namespace FIR
         static SampleType JUCE_VECTOR_CALLTYPE processSingleSample (SampleType sample, SampleType* buf,
                                                                     const NumericType* fir, size_t m, size_t& p) noexcept
         {
-            SampleType out (0);
-
             buf[p] = sample;
 
-            size_t k;
-            for (k = 0; k < m - p; ++k)
-                out += buf[(p + k)] * fir[k];
+            // the fifo wraps around, so the convolution is done as two dot products
+            auto out = dotProduct (buf + p, fir, m - p);
 
-            for (size_t j = 0; j < p; ++j)
-                out += buf[j] * fir[j + k];
+            if (p != 0)
+                out += dotProduct (buf, fir + (m - p), p);
 
             p = (p == 0 ? m - 1 : p - 1);
 
             return out;
         }
 
+        //==============================================================================
+        // For plain float and double samples these use kernels that are dispatched at
+        // run-time to the widest vector unit the CPU has; other sample types get a
+        // portable loop.
+        static float  dotProduct (const float* a,  const float* b,  size_t num) noexcept   { return RuntimeSIMDKernels::dotProduct (a, b, num); }
+        static double dotProduct (const double* a, const double* b, size_t num) noexcept   { return RuntimeSIMDKernels::dotProduct (a, b, num); }
+
+        template <typename OtherNumericType>
+        static SampleType dotProduct (const SampleType* buf, const OtherNumericType* fir, size_t num) noexcept
+        {
+            SampleType out (0);
+
+            for (size_t k = 0; k < num; ++k)
+                out += buf[k] * fir[k];
+
+            return out;
+        }
+
 
         JUCE_LEAK_DETECTOR (Filter)
     };
@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    Applies the gain described by a SmoothedValue to whole blocks at a time.
+
+    Calling AudioBlock::multiplyBy (SmoothedValue&) advances the smoother and
+    multiplies one sample at a time, for every channel. This helper instead
+    precomputes the block's gain ramp into a scratch buffer once, then applies
+    it to each channel with FloatVectorOperations, so the smoother is only
+    stepped once per block however many channels there are - and when the
+    smoother has already reached its target, the whole thing collapses to a
+    single vectorised multiply by a constant. Utility stages like Panner and
+    DryWetMixer use one of these per smoothed gain, which keeps the cost of a
+    long chain of them down.
+
+    The results are identical to the per-sample equivalents, including the
+    smoother's position afterwards.
+
+    @see SmoothedValue, Panner, DryWetMixer
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class GainRamp
+{
+public:
+    using SmoothedGain = SmoothedValue<SampleType, ValueSmoothingTypes::Linear>;
+
+    GainRamp() = default;
+
+    /** Allocates the scratch ramp for the largest block that will be processed. */
+    void prepare (const ProcessSpec& spec)
+    {
+        rampBuffer.allocate (spec.maximumBlockSize, false);
+        maximumBlockSize = (size_t) spec.maximumBlockSize;
+    }
+
+    /** Multiplies a block's channels by the gain, advancing the smoother by
+        the block's length. Equivalent to AudioBlock::multiplyBy (gain).
+    */
+    void applyGain (SmoothedGain& gain, AudioBlock<SampleType> block) noexcept
+    {
+        const auto numSamples = block.getNumSamples();
+
+        if (! gain.isSmoothing())
+        {
+            block.multiplyBy (gain.getTargetValue());
+            return;
+        }
+
+        const auto* ramp = fillRamp (gain, numSamples);
+
+        for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+            FloatVectorOperations::multiply (block.getChannelPointer (channel), ramp, (int) numSamples);
+    }
+
+    /** Adds src multiplied by the gain to dest, advancing the smoother by the
+        block's length. Equivalent to multiplying src in place and adding it,
+        but in a single pass that leaves src untouched.
+    */
+    void addWithGain (AudioBlock<SampleType> dest,
+                      AudioBlock<const SampleType> src,
+                      SmoothedGain& gain) noexcept
+    {
+        const auto numSamples = dest.getNumSamples();
+        jassert (src.getNumSamples() == numSamples);
+
+        if (! gain.isSmoothing())
+        {
+            dest.addProductOf (src, gain.getTargetValue());
+            return;
+        }
+
+        const auto* ramp = fillRamp (gain, numSamples);
+
+        for (size_t channel = 0; channel < dest.getNumChannels(); ++channel)
+            FloatVectorOperations::addWithMultiply (dest.getChannelPointer (channel),
+                                                    src.getChannelPointer (channel),
+                                                    ramp, (int) numSamples);
+    }
+
+private:
+    //==============================================================================
+    const SampleType* fillRamp (SmoothedGain& gain, size_t numSamples) noexcept
+    {
+        // If this fires, the block is larger than the one passed to prepare().
+        jassert (numSamples <= maximumBlockSize);
+
+        auto* ramp = rampBuffer.getData();
+
+        for (size_t i = 0; i < numSamples; ++i)
+            ramp[i] = gain.getNextValue();
+
+        return ramp;
+    }
+
+    HeapBlock<SampleType> rampBuffer;
+    size_t maximumBlockSize = 0;
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class GainRampTests  : public UnitTest
+{
+public:
+    GainRampTests()
+        : UnitTest ("GainRamp", UnitTestCategories::dsp)
+    {}
+
+    template <typename SampleType>
+    void runTestsForType()
+    {
+        constexpr ProcessSpec spec { 44100.0, 512, 4 };
+        auto random = getRandom();
+
+        const auto makeNoise = [&]
+        {
+            AudioBuffer<SampleType> buffer ((int) spec.numChannels, (int) spec.maximumBlockSize);
+
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    buffer.setSample (ch, i, (SampleType) (random.nextDouble() * 2.0 - 1.0));
+
+            return buffer;
+        };
+
+        const auto makeSmoother = [&]
+        {
+            SmoothedValue<SampleType, ValueSmoothingTypes::Linear> smoother ((SampleType) 0.1);
+            smoother.reset (spec.sampleRate, 0.05);
+            smoother.setTargetValue ((SampleType) 0.9);
+            return smoother;
+        };
+
+        beginTest ("applyGain matches per-sample smoothing");
+        {
+            GainRamp<SampleType> ramp;
+            ramp.prepare (spec);
+
+            auto rampSmoother = makeSmoother();
+            auto referenceSmoother = makeSmoother();
+
+            auto processed = makeNoise();
+            auto reference = processed;
+
+            // Uneven sub-block sizes, running well past the end of the ramp.
+            for (int start = 0; start < reference.getNumSamples();)
+            {
+                const auto length = jmin (reference.getNumSamples() - start, 1 + random.nextInt (100));
+
+                ramp.applyGain (rampSmoother, AudioBlock<SampleType> (processed).getSubBlock ((size_t) start, (size_t) length));
+                AudioBlock<SampleType> (reference).getSubBlock ((size_t) start, (size_t) length).multiplyBy (referenceSmoother);
+
+                start += length;
+            }
+
+            for (int ch = 0; ch < reference.getNumChannels(); ++ch)
+                for (int i = 0; i < reference.getNumSamples(); ++i)
+                    expectWithinAbsoluteError (processed.getSample (ch, i),
+                                               reference.getSample (ch, i),
+                                               (SampleType) 1.0e-6);
+
+            expectEquals ((double) rampSmoother.getCurrentValue(),
+                          (double) referenceSmoother.getCurrentValue());
+            expect (rampSmoother.isSmoothing() == referenceSmoother.isSmoothing());
+        }
+
+        beginTest ("addWithGain matches multiply-then-add");
+        {
+            GainRamp<SampleType> ramp;
+            ramp.prepare (spec);
+
+            auto rampSmoother = makeSmoother();
+            auto referenceSmoother = makeSmoother();
+
+            const auto source = makeNoise();
+            const auto sourceCopy = source;
+            auto dest = makeNoise();
+            auto referenceDest = dest;
+
+            ramp.addWithGain (AudioBlock<SampleType> (dest),
+                              AudioBlock<const SampleType> (source),
+                              rampSmoother);
+
+            auto scaledSource = source;
+            AudioBlock<SampleType> scaledBlock (scaledSource);
+            scaledBlock.multiplyBy (referenceSmoother);
+            AudioBlock<SampleType> (referenceDest).add (scaledBlock);
+
+            for (int ch = 0; ch < dest.getNumChannels(); ++ch)
+                for (int i = 0; i < dest.getNumSamples(); ++i)
+                    expectWithinAbsoluteError (dest.getSample (ch, i),
+                                               referenceDest.getSample (ch, i),
+                                               (SampleType) 1.0e-6);
+
+            // The source must be left untouched.
+            for (int ch = 0; ch < source.getNumChannels(); ++ch)
+                for (int i = 0; i < source.getNumSamples(); ++i)
+                    expectEquals ((double) source.getSample (ch, i),
+                                  (double) sourceCopy.getSample (ch, i));
+        }
+    }
+
+    void runTest() override
+    {
+        runTestsForType<float>();
+        runTestsForType<double>();
+    }
+};
+
+static GainRampTests gainRampTests;
+
+} // namespace dsp
+} // namespace juce
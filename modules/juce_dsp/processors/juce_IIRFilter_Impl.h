@@ -212,14 +212,46 @@ SampleType JUCE_VECTOR_CALLTYPE Filter<SampleType>::processSample (SampleType sa
     check();
     auto* c = coefficients->getRawCoefficients();
 
-    auto output = (c[0] * sample) + state[0];
+    // the lower orders are unrolled in the same way as processInternal, so
+    // per-sample processing produces identical results to the block kernel
+    switch (order)
+    {
+        case 1:
+        {
+            auto output = (c[0] * sample) + state[0];
+            state[0] = (c[1] * sample) - (c[2] * output);
+            return output;
+        }
+
+        case 2:
+        {
+            auto output = (c[0] * sample) + state[0];
+            state[0] = (c[1] * sample) - (c[3] * output) + state[1];
+            state[1] = (c[2] * sample) - (c[4] * output);
+            return output;
+        }
 
-    for (size_t j = 0; j < order - 1; ++j)
-        state[j] = (c[j + 1] * sample) - (c[order + j + 1] * output) + state[j + 1];
+        case 3:
+        {
+            auto output = (c[0] * sample) + state[0];
+            state[0] = (c[1] * sample) - (c[4] * output) + state[1];
+            state[1] = (c[2] * sample) - (c[5] * output) + state[2];
+            state[2] = (c[3] * sample) - (c[6] * output);
+            return output;
+        }
 
-    state[order - 1] = (c[order] * sample) - (c[order * 2] * output);
+        default:
+        {
+            auto output = (c[0] * sample) + state[0];
 
-    return output;
+            for (size_t j = 0; j < order - 1; ++j)
+                state[j] = (c[j + 1] * sample) - (c[order + j + 1] * output) + state[j + 1];
+
+            state[order - 1] = (c[order] * sample) - (c[order * 2] * output);
+
+            return output;
+        }
+    }
 }
 
 template <typename SampleType>
@@ -0,0 +1,159 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class IIRFilterTest  : public UnitTest
+{
+    template <typename NumericType>
+    static typename IIR::Coefficients<NumericType>::Ptr makeCoefficientsOfOrder (size_t order)
+    {
+        constexpr auto sampleRate = 48000.0;
+        constexpr auto frequency = static_cast<NumericType> (440.0);
+
+        switch (order)
+        {
+            case 1:   return *new IIR::Coefficients<NumericType> (IIR::ArrayCoefficients<NumericType>::makeFirstOrderLowPass (sampleRate, frequency));
+            case 2:   return *new IIR::Coefficients<NumericType> (IIR::ArrayCoefficients<NumericType>::makeLowPass (sampleRate, frequency));
+
+            // chain two biquads into a single higher-order coefficient set
+            case 4:
+            {
+                auto second = IIR::Coefficients<NumericType>::makeLowPass (sampleRate, frequency);
+                typename IIR::Coefficients<NumericType>::Ptr result = *new IIR::Coefficients<NumericType>();
+                result->coefficients.clearQuick();
+
+                for (int i = 0; i < 4; ++i)   result->coefficients.add (second->coefficients[jmin (2, i)]);
+                result->coefficients.add (0); // b4
+
+                for (int i = 0; i < 2; ++i)   result->coefficients.add (second->coefficients[3 + i]);
+                result->coefficients.add (0); // a3
+                result->coefficients.add (0); // a4
+
+                return result;
+            }
+
+            default:  jassertfalse; break;
+        }
+
+        return {};
+    }
+
+    template <typename NumericType>
+    void runTestForType()
+    {
+        Random random (482913);
+
+        for (auto order : { (size_t) 1, (size_t) 2, (size_t) 4 })
+        {
+            constexpr size_t n = 512;
+
+            std::vector<NumericType> input (n), blockOutput (n), sampleOutput (n);
+
+            for (auto& sample : input)
+                sample = static_cast<NumericType> ((2.0 * random.nextDouble()) - 1.0);
+
+            auto coefficients = makeCoefficientsOfOrder<NumericType> (order);
+
+            IIR::Filter<NumericType> blockFilter (coefficients), sampleFilter (coefficients);
+
+            {
+                auto* src = input.data();
+                auto* dst = blockOutput.data();
+                AudioBlock<const NumericType> inBlock (&src, 1, n);
+                AudioBlock<NumericType> outBlock (&dst, 1, n);
+                blockFilter.process (ProcessContextNonReplacing<NumericType> (inBlock, outBlock));
+            }
+
+            for (size_t i = 0; i < n; ++i)
+                sampleOutput[i] = sampleFilter.processSample (input[i]);
+
+            for (size_t i = 0; i < n; ++i)
+                expectEquals (sampleOutput[i], blockOutput[i],
+                              "processSample and process disagree for order " + String (order));
+        }
+    }
+
+    template <typename NumericType>
+    void runCoefficientReuseTestForType()
+    {
+        constexpr auto sampleRate = 48000.0;
+        constexpr size_t n = 64;
+
+        Random random (918273);
+        std::vector<NumericType> input (n), freshOutput (n), reusedOutput (n);
+
+        for (auto& sample : input)
+            sample = static_cast<NumericType> ((2.0 * random.nextDouble()) - 1.0);
+
+        // sweeping a cutoff by re-assigning ArrayCoefficients into the same
+        // instance should behave identically to making a fresh instance each time
+        IIR::Filter<NumericType> freshFilter, reusedFilter;
+        reusedFilter.coefficients = new IIR::Coefficients<NumericType>();
+        reusedFilter.reset();
+
+        for (auto frequency : { 200.0f, 450.0f, 1000.0f, 2500.0f })
+        {
+            freshFilter.coefficients = IIR::Coefficients<NumericType>::makeLowPass (sampleRate, (NumericType) frequency);
+            *reusedFilter.coefficients = IIR::ArrayCoefficients<NumericType>::makeLowPass (sampleRate, (NumericType) frequency);
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                freshOutput[i]  = freshFilter .processSample (input[i]);
+                reusedOutput[i] = reusedFilter.processSample (input[i]);
+            }
+
+            for (size_t i = 0; i < n; ++i)
+                expectEquals (reusedOutput[i], freshOutput[i],
+                              "re-assigned coefficients disagree at " + String (frequency) + " Hz");
+        }
+    }
+
+public:
+    IIRFilterTest()  : UnitTest ("IIR Filter", UnitTestCategories::dsp)  {}
+
+    void runTest() override
+    {
+        beginTest ("Sample-by-sample processing matches block processing (float)");
+        runTestForType<float>();
+
+        beginTest ("Sample-by-sample processing matches block processing (double)");
+        runTestForType<double>();
+
+        beginTest ("Re-assigning coefficients in place matches fresh instances (float)");
+        runCoefficientReuseTestForType<float>();
+
+        beginTest ("Re-assigning coefficients in place matches fresh instances (double)");
+        runCoefficientReuseTestForType<double>();
+    }
+};
+
+static IIRFilterTest iirFilterUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -103,11 +103,50 @@ struct OversamplingDummy   : public Oversampling<SampleType>::OversamplingStage
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OversamplingDummy)
 };
 
+//==============================================================================
+/** Returns the coefficients for a given half-band FIR design, sharing the
+    result between all the Oversampling instances which request the same
+    specification, so that each plugin instance doesn't redo the (expensive)
+    equiripple design or keep its own copy of the tables.
+*/
+template <typename SampleType>
+static typename FIR::Coefficients<SampleType>::Ptr getSharedEquirippleCoefficients (SampleType normalisedTransitionWidth,
+                                                                                    SampleType stopbandAmplitudedB)
+{
+    struct CachedDesign
+    {
+        SampleType transitionWidth, stopbandDb;
+        typename FIR::Coefficients<SampleType>::Ptr coefficients;
+    };
+
+    static CriticalSection designLock;
+    static Array<CachedDesign> designs;
+
+    const ScopedLock sl (designLock);
+
+    for (auto& d : designs)
+        if (d.transitionWidth == normalisedTransitionWidth && d.stopbandDb == stopbandAmplitudedB)
+            return d.coefficients;
+
+    auto coefficients = FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalisedTransitionWidth,
+                                                                                            stopbandAmplitudedB);
+    if (designs.size() < 16)
+        designs.add ({ normalisedTransitionWidth, stopbandAmplitudedB, coefficients });
+
+    return coefficients;
+}
+
 //==============================================================================
 /** Oversampling stage class performing 2 times oversampling using the Filter
     Design FIR Equiripple method. The resulting filter is linear phase,
     symmetric, and has every two samples but the middle one equal to zero,
     leading to specific processing optimizations.
+
+    Since only the even-numbered taps of the half-band filter are non-zero
+    (apart from the centre one, which is handled separately), the filter state
+    is kept as a packed polyphase history with one entry per input sample, and
+    the symmetric convolution is folded into a plain dot product over
+    SIMD-aligned arrays so it can use SIMDRegister.
 */
 template <typename SampleType>
 struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::OversamplingStage
@@ -121,34 +160,36 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
                                      SampleType stopbandAmplitudedBDown)
         : ParentType (numChans, 2)
     {
-        coefficientsUp   = *FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalisedTransitionWidthUp,   stopbandAmplitudedBUp);
-        coefficientsDown = *FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalisedTransitionWidthDown, stopbandAmplitudedBDown);
+        coefficientsUp   = getSharedEquirippleCoefficients (normalisedTransitionWidthUp,   stopbandAmplitudedBUp);
+        coefficientsDown = getSharedEquirippleCoefficients (normalisedTransitionWidthDown, stopbandAmplitudedBDown);
 
-        auto N = coefficientsUp.getFilterOrder() + 1;
-        stateUp.setSize (static_cast<int> (this->numChannels), static_cast<int> (N));
+        packTaps (*coefficientsUp,   upTapsData,   upTaps,   upLength,   upPaddedLength);
+        packTaps (*coefficientsDown, downTapsData, downTaps, downLength, downPaddedLength);
 
-        N = coefficientsDown.getFilterOrder() + 1;
-        auto Ndiv2 = N / 2;
-        auto Ndiv4 = Ndiv2 / 2;
+        upHistory   = AudioBlock<SampleType> (upHistoryData,   this->numChannels, upPaddedLength);
+        downHistory = AudioBlock<SampleType> (downHistoryData, this->numChannels, downPaddedLength);
+        upHistory.clear();
+        downHistory.clear();
 
-        stateDown.setSize  (static_cast<int> (this->numChannels), static_cast<int> (N));
-        stateDown2.setSize (static_cast<int> (this->numChannels), static_cast<int> (Ndiv4 + 1));
+        auto N = coefficientsDown->getFilterOrder() + 1;
+        auto Ndiv4 = (N / 2) / 2;
 
+        stateDown2.setSize (static_cast<int> (this->numChannels), static_cast<int> (Ndiv4 + 1));
         position.resize (static_cast<int> (this->numChannels));
     }
 
     //==============================================================================
     SampleType getLatencyInSamples() const override
     {
-        return static_cast<SampleType> (coefficientsUp.getFilterOrder() + coefficientsDown.getFilterOrder()) * 0.5f;
+        return static_cast<SampleType> (coefficientsUp->getFilterOrder() + coefficientsDown->getFilterOrder()) * 0.5f;
     }
 
     void reset() override
     {
         ParentType::reset();
 
-        stateUp.clear();
-        stateDown.clear();
+        upHistory.clear();
+        downHistory.clear();
         stateDown2.clear();
 
         position.fill (0);
@@ -160,36 +201,29 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
         jassert (inputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
 
         // Initialization
-        auto fir = coefficientsUp.getRawCoefficients();
-        auto N = coefficientsUp.getFilterOrder() + 1;
-        auto Ndiv2 = N / 2;
+        auto fir = coefficientsUp->getRawCoefficients();
+        auto Ndiv2 = (coefficientsUp->getFilterOrder() + 1) / 2;
+        auto centreTap = fir[Ndiv2];
+        auto centreIndex = (Ndiv2 + 1) / 2;
+        auto taps = upTaps.getChannelPointer (0);
         auto numSamples = inputBlock.getNumSamples();
 
         // Processing
         for (size_t channel = 0; channel < inputBlock.getNumChannels(); ++channel)
         {
             auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto buf = stateUp.getWritePointer (static_cast<int> (channel));
+            auto hist = upHistory.getChannelPointer (channel);
             auto samples = inputBlock.getChannelPointer (channel);
 
             for (size_t i = 0; i < numSamples; ++i)
             {
-                // Input
-                buf[N - 1] = 2 * samples[i];
-
-                // Convolution
-                auto out = static_cast<SampleType> (0.0);
-
-                for (size_t k = 0; k < Ndiv2; k += 2)
-                    out += (buf[k] + buf[N - k - 1]) * fir[k];
+                // Shift data and add the new input
+                std::memmove (hist, hist + 1, (upLength - 1) * sizeof (SampleType));
+                hist[upLength - 1] = 2 * samples[i];
 
                 // Outputs
-                bufferSamples[i << 1] = out;
-                bufferSamples[(i << 1) + 1] = buf[Ndiv2 + 1] * fir[Ndiv2];
-
-                // Shift data
-                for (size_t k = 0; k < N - 2; k += 2)
-                    buf[k] = buf[k + 2];
+                bufferSamples[i << 1] = convolve (hist, taps, upPaddedLength);
+                bufferSamples[(i << 1) + 1] = hist[centreIndex] * centreTap;
             }
         }
     }
@@ -200,55 +234,94 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
         jassert (outputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
 
         // Initialization
-        auto fir = coefficientsDown.getRawCoefficients();
-        auto N = coefficientsDown.getFilterOrder() + 1;
-        auto Ndiv2 = N / 2;
+        auto fir = coefficientsDown->getRawCoefficients();
+        auto Ndiv2 = (coefficientsDown->getFilterOrder() + 1) / 2;
         auto Ndiv4 = Ndiv2 / 2;
+        auto centreTap = fir[Ndiv2];
+        auto taps = downTaps.getChannelPointer (0);
         auto numSamples = outputBlock.getNumSamples();
 
         // Processing
         for (size_t channel = 0; channel < outputBlock.getNumChannels(); ++channel)
         {
             auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto buf = stateDown.getWritePointer (static_cast<int> (channel));
+            auto hist = downHistory.getChannelPointer (channel);
             auto buf2 = stateDown2.getWritePointer (static_cast<int> (channel));
             auto samples = outputBlock.getChannelPointer (channel);
             auto pos = position.getUnchecked (static_cast<int> (channel));
 
             for (size_t i = 0; i < numSamples; ++i)
             {
-                // Input
-                buf[N - 1] = bufferSamples[i << 1];
+                // Shift data and add the new input
+                std::memmove (hist, hist + 1, (downLength - 1) * sizeof (SampleType));
+                hist[downLength - 1] = bufferSamples[i << 1];
 
                 // Convolution
-                auto out = static_cast<SampleType> (0.0);
-
-                for (size_t k = 0; k < Ndiv2; k += 2)
-                    out += (buf[k] + buf[N - k - 1]) * fir[k];
+                auto out = convolve (hist, taps, downPaddedLength);
 
                 // Output
-                out += buf2[pos] * fir[Ndiv2];
+                out += buf2[pos] * centreTap;
                 buf2[pos] = bufferSamples[(i << 1) + 1];
 
                 samples[i] = out;
 
-                // Shift data
-                for (size_t k = 0; k < N - 2; ++k)
-                    buf[k] = buf[k + 2];
-
                 // Circular buffer
                 pos = (pos == 0 ? Ndiv4 : pos - 1);
             }
 
             position.setUnchecked (static_cast<int> (channel), pos);
         }
-
     }
 
 private:
     //==============================================================================
-    FIR::Coefficients<SampleType> coefficientsUp, coefficientsDown;
-    AudioBuffer<SampleType> stateUp, stateDown, stateDown2;
+    /** Folds the symmetric half-band convolution into a packed tap array with
+        one entry per history sample, zero-padded up to a whole number of SIMD
+        registers, so that processing becomes a single aligned dot product.
+    */
+    void packTaps (const FIR::Coefficients<SampleType>& coefficients,
+                   HeapBlock<char>& heapData, AudioBlock<SampleType>& packed,
+                   size_t& length, size_t& paddedLength)
+    {
+        auto fir = coefficients.getRawCoefficients();
+        auto N = coefficients.getFilterOrder() + 1;
+        auto Ndiv2 = N / 2;
+
+        // the half-band structure relies on the centre tap sitting at an odd index
+        jassert ((Ndiv2 & 1) == 1);
+
+        length = (N + 1) / 2;
+        constexpr auto numLanes = SIMDRegister<SampleType>::SIMDNumElements;
+        paddedLength = ((length + numLanes - 1) / numLanes) * numLanes;
+
+        packed = AudioBlock<SampleType> (heapData, 1, paddedLength);
+        packed.clear();
+        auto taps = packed.getChannelPointer (0);
+
+        for (size_t k = 0; k < Ndiv2; k += 2)
+        {
+            taps[k / 2] += fir[k];
+            taps[length - 1 - k / 2] += fir[k];
+        }
+    }
+
+    static SampleType convolve (const SampleType* hist, const SampleType* taps, size_t paddedLength) noexcept
+    {
+        using Vec = SIMDRegister<SampleType>;
+        auto acc = Vec::expand (0);
+
+        for (size_t m = 0; m < paddedLength; m += Vec::SIMDNumElements)
+            acc = Vec::multiplyAdd (acc, Vec::fromRawArray (hist + m), Vec::fromRawArray (taps + m));
+
+        return acc.sum();
+    }
+
+    //==============================================================================
+    typename FIR::Coefficients<SampleType>::Ptr coefficientsUp, coefficientsDown;
+    HeapBlock<char> upTapsData, downTapsData, upHistoryData, downHistoryData;
+    AudioBlock<SampleType> upTaps, downTaps, upHistory, downHistory;
+    size_t upLength = 0, upPaddedLength = 0, downLength = 0, downPaddedLength = 0;
+    AudioBuffer<SampleType> stateDown2;
     Array<size_t> position;
 
     //==============================================================================
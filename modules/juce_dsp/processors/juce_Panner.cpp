@@ -62,6 +62,8 @@ void Panner<SampleType>::prepare (const ProcessSpec& spec)
 
     sampleRate = spec.sampleRate;
 
+    gainRamp.prepare (spec);
+
     reset();
 }
 
@@ -102,8 +102,8 @@ public:
         if (context.isBypassed)
             return;
 
-        outputBlock.getSingleChannelBlock (0).multiplyBy (leftVolume);
-        outputBlock.getSingleChannelBlock (1).multiplyBy (rightVolume);
+        gainRamp.applyGain (leftVolume,  outputBlock.getSingleChannelBlock (0));
+        gainRamp.applyGain (rightVolume, outputBlock.getSingleChannelBlock (1));
     }
 
 private:
@@ -114,6 +114,7 @@ private:
     Rule currentRule = Rule::balanced;
     SampleType pan = 0.0;
     SmoothedValue<SampleType> leftVolume, rightVolume;
+    GainRamp<SampleType> gainRamp;
     double sampleRate = 44100.0;
 };
 
@@ -44,13 +44,27 @@ struct ProcessSpec
 
     /** The number of channels that the process() method will be expected to handle. */
     uint32 numChannels;
+
+    /** If true, processors which support it (such as ProcessorChain and Convolution)
+        will disable denormalised number support on the CPU for the duration of each
+        process call, as if the caller had created a ScopedNoDenormals.
+
+        This makes denormal protection part of the processing setup rather than
+        something each call site has to remember, which matters for tail-heavy
+        algorithms like long reverbs whose decaying state would otherwise hit
+        denormal stalls.
+
+        @see ScopedNoDenormals, FloatVectorOperations::flushDenormalsToZero
+    */
+    bool disableDenormals = false;
 };
 
 constexpr bool operator== (const ProcessSpec& a, const ProcessSpec& b)
 {
     return a.sampleRate         == b.sampleRate
         && a.maximumBlockSize   == b.maximumBlockSize
-        && a.numChannels        == b.numChannels;
+        && a.numChannels        == b.numChannels
+        && a.disableDenormals   == b.disableDenormals;
 }
 
 constexpr bool operator!= (const ProcessSpec& a, const ProcessSpec& b) { return ! (a == b); }
@@ -93,6 +107,12 @@ public:
     using AudioBlockType = AudioBlock<SampleType>;
     using ConstAudioBlockType = AudioBlock<const SampleType>;
 
+    /** The replacing context type that a ProcessorChain should use when handing
+        the output of one stage to the next. Contexts with fixed-extent blocks
+        override this to keep the compile-time channel count intact.
+    */
+    using ReplacingContextType = ProcessContextReplacing<SampleType>;
+
     /** Creates a ProcessContextReplacing that uses the given audio block.
         Note that the caller must not delete the block while it is still in use by this object!
     */
@@ -146,6 +166,13 @@ public:
     using AudioBlockType = AudioBlock<SampleType>;
     using ConstAudioBlockType = AudioBlock<const SampleType>;
 
+    /** The replacing context type that a ProcessorChain should use when handing
+        the output of one stage to the next.
+
+        @see ProcessContextReplacing::ReplacingContextType
+    */
+    using ReplacingContextType = ProcessContextReplacing<SampleType>;
+
     /** Creates a ProcessContextNonReplacing that uses the given input and output blocks.
         Note that the caller must not delete these blocks while they are still in use by this object!
     */
@@ -182,5 +209,125 @@ private:
     AudioBlockType& outputBlock;
 };
 
+//==============================================================================
+/**
+    A ProcessContextReplacing analogue whose audio blocks have a compile-time
+    channel count.
+
+    Processing a chain with one of these instead of a ProcessContextReplacing
+    lets every stage's per-channel loops unroll for the fixed extent, since
+    ProcessorChain propagates the context's block type through each stage.
+
+    @see FixedChannelAudioBlock, ProcessContextReplacing
+
+    @tags{DSP}
+*/
+template <typename ContextSampleType, size_t contextNumChannels>
+struct FixedChannelProcessContextReplacing
+{
+public:
+    /** The type of a single sample (which may be a vector if multichannel). */
+    using SampleType     = ContextSampleType;
+    /** The type of audio block that this context handles. */
+    using AudioBlockType = FixedChannelAudioBlock<SampleType, contextNumChannels>;
+    using ConstAudioBlockType = FixedChannelAudioBlock<const SampleType, contextNumChannels>;
+
+    /** The replacing context type that a ProcessorChain should use when handing
+        the output of one stage to the next - this keeps the compile-time
+        channel count intact from stage to stage.
+    */
+    using ReplacingContextType = FixedChannelProcessContextReplacing<SampleType, contextNumChannels>;
+
+    /** Creates a FixedChannelProcessContextReplacing that uses the given audio block.
+        Note that the caller must not delete the block while it is still in use by this object!
+    */
+    FixedChannelProcessContextReplacing (AudioBlockType& block) noexcept : ioBlock (block) {}
+
+    FixedChannelProcessContextReplacing (const FixedChannelProcessContextReplacing&) = default;
+    FixedChannelProcessContextReplacing (FixedChannelProcessContextReplacing&&) = default;
+
+    /** Returns the audio block to use as the input to a process function. */
+    const ConstAudioBlockType& getInputBlock() const noexcept   { return constBlock; }
+
+    /** Returns the audio block to use as the output to a process function. */
+    AudioBlockType& getOutputBlock() const noexcept             { return ioBlock; }
+
+    /** All process context classes will define this constant method so that templated
+        code can determine whether the input and output blocks refer to the same buffer,
+        or to two different ones.
+    */
+    static constexpr bool usesSeparateInputAndOutputBlocks()    { return false; }
+
+    /** If set to true, then a processor's process() method is expected to do whatever
+        is appropriate for it to be in a bypassed state.
+    */
+    bool isBypassed = false;
+
+private:
+    AudioBlockType& ioBlock;
+    ConstAudioBlockType constBlock { ioBlock };
+};
+
+//==============================================================================
+/**
+    A ProcessContextNonReplacing analogue whose audio blocks have a compile-time
+    channel count.
+
+    @see FixedChannelAudioBlock, ProcessContextNonReplacing
+
+    @tags{DSP}
+*/
+template <typename ContextSampleType, size_t contextNumChannels>
+struct FixedChannelProcessContextNonReplacing
+{
+public:
+    /** The type of a single sample (which may be a vector if multichannel). */
+    using SampleType     = ContextSampleType;
+    /** The type of audio block that this context handles. */
+    using AudioBlockType = FixedChannelAudioBlock<SampleType, contextNumChannels>;
+    using ConstAudioBlockType = FixedChannelAudioBlock<const SampleType, contextNumChannels>;
+
+    /** The replacing context type that a ProcessorChain should use when handing
+        the output of one stage to the next - this keeps the compile-time
+        channel count intact from stage to stage.
+    */
+    using ReplacingContextType = FixedChannelProcessContextReplacing<SampleType, contextNumChannels>;
+
+    /** Creates a FixedChannelProcessContextNonReplacing that uses the given input and output blocks.
+        Note that the caller must not delete these blocks while they are still in use by this object!
+    */
+    FixedChannelProcessContextNonReplacing (const ConstAudioBlockType& input, AudioBlockType& output) noexcept
+        : inputBlock (input), outputBlock (output)
+    {
+        // If the input and output blocks are the same then you should use
+        // FixedChannelProcessContextReplacing instead.
+        jassert (input != output);
+    }
+
+    FixedChannelProcessContextNonReplacing (const FixedChannelProcessContextNonReplacing&) = default;
+    FixedChannelProcessContextNonReplacing (FixedChannelProcessContextNonReplacing&&) = default;
+
+    /** Returns the audio block to use as the input to a process function. */
+    const ConstAudioBlockType& getInputBlock() const noexcept   { return inputBlock; }
+
+    /** Returns the audio block to use as the output to a process function. */
+    AudioBlockType& getOutputBlock() const noexcept             { return outputBlock; }
+
+    /** All process context classes will define this constant method so that templated
+        code can determine whether the input and output blocks refer to the same buffer,
+        or to two different ones.
+    */
+    static constexpr bool usesSeparateInputAndOutputBlocks()    { return true; }
+
+    /** If set to true, then a processor's process() method is expected to do whatever
+        is appropriate for it to be in a bypassed state.
+    */
+    bool isBypassed = false;
+
+private:
+    ConstAudioBlockType inputBlock;
+    AudioBlockType& outputBlock;
+};
+
 } // namespace dsp
 } // namespace juce
@@ -56,9 +56,110 @@ namespace detail
     {
         static constexpr auto value = ! Context::usesSeparateInputAndOutputBlocks() || Ix == 0;
     };
+
+    // RealtimeTracer zone names must be static strings, so the stage index is
+    // baked into a fixed set of literals rather than formatted at runtime
+    template <size_t Ix>
+    constexpr const char* getProcessorChainZoneName() noexcept
+    {
+        constexpr const char* names[] = { "ProcessorChain stage 0", "ProcessorChain stage 1",
+                                          "ProcessorChain stage 2", "ProcessorChain stage 3",
+                                          "ProcessorChain stage 4", "ProcessorChain stage 5",
+                                          "ProcessorChain stage 6", "ProcessorChain stage 7",
+                                          "ProcessorChain stage 8+" };
+        return names[Ix < 8 ? Ix : 8];
+    }
 }
 #endif
 
+//==============================================================================
+/**
+    A fixed-size ring of per-stage, per-block timings written by the profiling
+    overload of ProcessorChain::process.
+
+    The audio thread writes one duration per stage per block; another thread
+    (e.g. a load dashboard timer) can call getStatistics() to obtain the
+    minimum, median and maximum stage duration over the retained blocks.
+
+    The ring is allocation-free, so it's safe to share with the audio thread.
+    Computing the statistics copies and sorts the retained durations, so
+    getStatistics() should only be called from a non-realtime thread.
+
+    @see ProcessorChain
+
+    @tags{DSP}
+*/
+template <size_t numStages, size_t numBlocksToRetain = 128>
+class ProcessorChainProfile
+{
+public:
+    /** The timing statistics of a single stage over the retained blocks. */
+    struct Statistics
+    {
+        double minSeconds = 0, medianSeconds = 0, maxSeconds = 0;
+    };
+
+    /** Records the duration of one stage of one block, in high-resolution ticks.
+
+        This is called by the profiling overload of ProcessorChain::process,
+        and is safe to call from the audio thread.
+    */
+    void push (size_t stage, int64 durationTicks) noexcept
+    {
+        jassert (stage < numStages);
+
+        auto& ring = rings[stage];
+        const auto head = ring.head.load (std::memory_order_relaxed);
+
+        ring.durations[head % numBlocksToRetain].store (durationTicks, std::memory_order_relaxed);
+        ring.head.store (head + 1, std::memory_order_release);
+    }
+
+    /** Returns the minimum, median and maximum duration of the retained blocks
+        for the given stage.
+
+        If nothing has been recorded for the stage yet, all fields will be zero.
+    */
+    Statistics getStatistics (size_t stage) const
+    {
+        jassert (stage < numStages);
+
+        const auto& ring = rings[stage];
+        const auto numStored = (size_t) jmin ((uint64) numBlocksToRetain,
+                                              ring.head.load (std::memory_order_acquire));
+
+        if (numStored == 0)
+            return {};
+
+        std::array<int64, numBlocksToRetain> sorted;
+
+        for (size_t i = 0; i < numStored; ++i)
+            sorted[i] = ring.durations[i].load (std::memory_order_relaxed);
+
+        std::sort (sorted.begin(), sorted.begin() + (ptrdiff_t) numStored);
+
+        return { Time::highResolutionTicksToSeconds (sorted.front()),
+                 Time::highResolutionTicksToSeconds (sorted[numStored / 2]),
+                 Time::highResolutionTicksToSeconds (sorted[numStored - 1]) };
+    }
+
+    /** Returns the number of stages this profile can record. */
+    static constexpr size_t getNumStages() noexcept             { return numStages; }
+
+    /** Returns the number of blocks that are retained per stage. */
+    static constexpr size_t getNumBlocksToRetain() noexcept     { return numBlocksToRetain; }
+
+private:
+    struct StageRing
+    {
+        std::array<std::atomic<int64>, numBlocksToRetain> durations {};
+        std::atomic<uint64> head { 0 };
+    };
+
+    std::array<StageRing, numStages> rings;
+};
+
+//==============================================================================
 /** This variadically-templated class lets you join together any number of processor
     classes into a single processor which will call process() on them all in sequence.
 
@@ -82,9 +183,14 @@ public:
     template <int Index>
     bool isBypassed() const noexcept    { return bypassed[(size_t) Index]; }
 
-    /** Prepare all inner processors with the provided `ProcessSpec`. */
+    /** Prepare all inner processors with the provided `ProcessSpec`.
+
+        If the spec has disableDenormals set, every subsequent process() call will
+        run with denormal support switched off, as if under a ScopedNoDenormals.
+    */
     void prepare (const ProcessSpec& spec)
     {
+        denormalsDisabled = spec.disableDenormals;
         detail::forEachInTuple ([&] (auto& proc, auto) { proc.prepare (spec); }, processors);
     }
 
@@ -98,18 +204,46 @@ public:
     template <typename ProcessContext>
     void process (const ProcessContext& context) noexcept
     {
+        const ScopedNoDenormals noDenormals (denormalsDisabled);
+
         detail::forEachInTuple ([this, &context] (auto& proc, auto index) noexcept { this->processOne (context, proc, index); },
                                 processors);
     }
 
+    /** Process `context` through all inner processors in sequence, recording the
+        time taken by each stage into the caller-provided profile.
+
+        Instrumentation is opted into at compile time by calling this overload:
+        the plain process() method is completely unaffected, so profiling costs
+        nothing unless it is requested at the call site.
+
+        @see ProcessorChainProfile
+    */
+    template <typename ProcessContext, size_t numStages, size_t numBlocksToRetain>
+    void process (const ProcessContext& context, ProcessorChainProfile<numStages, numBlocksToRetain>& profile) noexcept
+    {
+        static_assert (numStages >= sizeof... (Processors),
+                       "The profile must have a slot for every processor in the chain");
+
+        const ScopedNoDenormals noDenormals (denormalsDisabled);
+
+        detail::forEachInTuple ([this, &context, &profile] (auto& proc, auto index) noexcept
+        {
+            const auto startTicks = Time::getHighResolutionTicks();
+            this->processOne (context, proc, index);
+            profile.push (index, Time::getHighResolutionTicks() - startTicks);
+        }, processors);
+    }
+
 private:
     template <typename Context, typename Proc, size_t Ix, std::enable_if_t<! detail::UseContextDirectly<Context, Ix>::value, int> = 0>
     void processOne (const Context& context, Proc& proc, std::integral_constant<size_t, Ix>) noexcept
     {
         jassert (context.getOutputBlock().getNumChannels() == context.getInputBlock().getNumChannels());
-        ProcessContextReplacing<typename Context::SampleType> replacingContext (context.getOutputBlock());
+        typename Context::ReplacingContextType replacingContext (context.getOutputBlock());
         replacingContext.isBypassed = (bypassed[Ix] || context.isBypassed);
 
+        RealtimeTracer::ScopedZone zone (detail::getProcessorChainZoneName<Ix>());
         proc.process (replacingContext);
     }
 
@@ -119,11 +253,13 @@ private:
         auto contextCopy = context;
         contextCopy.isBypassed = (bypassed[Ix] || context.isBypassed);
 
+        RealtimeTracer::ScopedZone zone (detail::getProcessorChainZoneName<Ix>());
         proc.process (contextCopy);
     }
 
     std::tuple<Processors...> processors;
     std::array<bool, sizeof...(Processors)> bypassed { {} };
+    bool denormalsDisabled = false;
 };
 
 /** Non-member equivalent of ProcessorChain::get which avoids awkward
@@ -50,6 +50,20 @@ class ProcessorChainTest : public UnitTest
         bool bufferWasClear = false;
     };
 
+    struct DenormalCheckingProcessor
+    {
+        void prepare (const ProcessSpec&) noexcept {}
+        void reset() noexcept {}
+
+        template <typename Context>
+        void process (const Context&) noexcept
+        {
+            denormalsWereDisabled = FloatVectorOperations::areDenormalsDisabled();
+        }
+
+        bool denormalsWereDisabled = false;
+    };
+
 public:
     ProcessorChainTest()
         : UnitTest ("ProcessorChain", UnitTestCategories::dsp) {}
@@ -133,6 +147,65 @@ public:
             expect (! get<1> (chain).bufferWasClear);
         }
 
+        beginTest ("The disableDenormals spec option takes effect during process");
+        {
+            ProcessorChain<DenormalCheckingProcessor> chain;
+
+            AudioBuffer<float> buffer (1, 1);
+            AudioBlock<float> block (buffer);
+            ProcessContextReplacing<float> context (block);
+
+            ProcessSpec spec { 44100.0, 1, 1 };
+            const auto stateOutside = FloatVectorOperations::areDenormalsDisabled();
+
+            chain.prepare (spec);
+            chain.process (context);
+            expect (get<0> (chain).denormalsWereDisabled == stateOutside);
+
+            spec.disableDenormals = true;
+            chain.prepare (spec);
+            chain.process (context);
+
+           #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON || defined (__arm64__) || defined (__aarch64__)
+            expect (get<0> (chain).denormalsWereDisabled);
+           #endif
+
+            // the previous FP state must be restored once process returns
+            expect (FloatVectorOperations::areDenormalsDisabled() == stateOutside);
+        }
+
+        beginTest ("The profiling overload of process records per-stage statistics");
+        {
+            ProcessorChain<MockProcessor<1>, MockProcessor<2>> chain;
+            ProcessorChainProfile<2, 16> profile;
+
+            expectEquals (profile.getStatistics (0).maxSeconds, 0.0);
+            expectEquals (profile.getStatistics (1).maxSeconds, 0.0);
+
+            AudioBuffer<float> buffer (1, 1);
+            AudioBlock<float> block (buffer);
+            ProcessContextReplacing<float> context (block);
+
+            constexpr int numBlocks = 32;
+
+            for (int i = 0; i < numBlocks; ++i)
+            {
+                block.clear();
+                chain.process (context, profile);
+            }
+
+            expectEquals (buffer.getSample (0, 0), 3.0f);
+
+            for (size_t stage = 0; stage < profile.getNumStages(); ++stage)
+            {
+                const auto stats = profile.getStatistics (stage);
+
+                expect (stats.minSeconds >= 0.0);
+                expect (stats.minSeconds <= stats.medianSeconds);
+                expect (stats.medianSeconds <= stats.maxSeconds);
+            }
+        }
+
         beginTest ("Chains with trailing items that only support replacing contexts can be built");
         {
             AudioBuffer<float> inBuf (1, 1), outBuf (1, 1);
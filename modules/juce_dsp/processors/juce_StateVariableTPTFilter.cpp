@@ -120,6 +120,91 @@ SampleType StateVariableTPTFilter<SampleType>::processSample (int channel, Sampl
     }
 }
 
+//==============================================================================
+template <typename SampleType>
+bool StateVariableTPTFilter<SampleType>::processPackedChannels (const AudioBlock<const SampleType>& inputBlock,
+                                                                AudioBlock<SampleType>& outputBlock) noexcept
+{
+   #if ! JUCE_USE_SIMD
+    ignoreUnused (inputBlock, outputBlock);
+    return false;
+   #else
+    using Reg = SIMDRegister<SampleType>;
+    constexpr auto numLanes = Reg::SIMDNumElements;
+
+    const auto numChannels = outputBlock.getNumChannels();
+    const auto numSamples  = outputBlock.getNumSamples();
+
+    if (numChannels < numLanes)
+        return false;
+
+    const auto vg   = Reg::expand (g);
+    const auto vh   = Reg::expand (h);
+    const auto vgR2 = Reg::expand (g + R2);
+
+    size_t channel = 0;
+
+    for (; channel + numLanes <= numChannels; channel += numLanes)
+    {
+        const SampleType* inputs[numLanes];
+        SampleType* outputs[numLanes];
+        alignas (Reg) SampleType lanes[numLanes];
+
+        Reg ls1, ls2;
+
+        for (size_t k = 0; k < numLanes; ++k)
+        {
+            inputs[k]  = inputBlock .getChannelPointer (channel + k);
+            outputs[k] = outputBlock.getChannelPointer (channel + k);
+            ls1.set (k, s1[channel + k]);
+            ls2.set (k, s2[channel + k]);
+        }
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            for (size_t k = 0; k < numLanes; ++k)
+                lanes[k] = inputs[k][i];
+
+            auto input = Reg::fromRawArray (lanes);
+
+            auto yHP = vh * (input - ls1 * vgR2 - ls2);
+
+            auto yBP = yHP * vg + ls1;
+            ls1      = yHP * vg + yBP;
+
+            auto yLP = yBP * vg + ls2;
+            ls2      = yBP * vg + yLP;
+
+            auto result = filterType == Type::highpass ? yHP
+                        : filterType == Type::bandpass ? yBP
+                                                       : yLP;
+            result.copyToRawArray (lanes);
+
+            for (size_t k = 0; k < numLanes; ++k)
+                outputs[k][i] = lanes[k];
+        }
+
+        for (size_t k = 0; k < numLanes; ++k)
+        {
+            s1[channel + k] = ls1.get (k);
+            s2[channel + k] = ls2.get (k);
+        }
+    }
+
+    // any channels left over that can't fill a whole register go through the scalar path
+    for (; channel < numChannels; ++channel)
+    {
+        auto* inputSamples  = inputBlock .getChannelPointer (channel);
+        auto* outputSamples = outputBlock.getChannelPointer (channel);
+
+        for (size_t i = 0; i < numSamples; ++i)
+            outputSamples[i] = processSample ((int) channel, inputSamples[i]);
+    }
+
+    return true;
+   #endif
+}
+
 //==============================================================================
 template <typename SampleType>
 void StateVariableTPTFilter<SampleType>::update()
@@ -111,7 +111,13 @@ public:
     void snapToZero() noexcept;
 
     //==============================================================================
-    /** Processes the input and output samples supplied in the processing context. */
+    /** Processes the input and output samples supplied in the processing context.
+
+        When the block holds at least one full SIMD register's worth of channels,
+        groups of channel states are packed into SIMDRegister lanes and advanced
+        together per sample, so multichannel throughput scales with the SIMD
+        width. The results are identical to the scalar per-channel path.
+    */
     template <typename ProcessContext>
     void process (const ProcessContext& context) noexcept
     {
@@ -130,13 +136,16 @@ public:
             return;
         }
 
-        for (size_t channel = 0; channel < numChannels; ++channel)
+        if (! processPackedChannels (inputBlock, outputBlock))
         {
-            auto* inputSamples  = inputBlock .getChannelPointer (channel);
-            auto* outputSamples = outputBlock.getChannelPointer (channel);
-
-            for (size_t i = 0; i < numSamples; ++i)
-                outputSamples[i] = processSample ((int) channel, inputSamples[i]);
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                auto* inputSamples  = inputBlock .getChannelPointer (channel);
+                auto* outputSamples = outputBlock.getChannelPointer (channel);
+
+                for (size_t i = 0; i < numSamples; ++i)
+                    outputSamples[i] = processSample ((int) channel, inputSamples[i]);
+            }
         }
 
        #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
@@ -152,6 +161,12 @@ private:
     //==============================================================================
     void update();
 
+    /*  Advances groups of channel states together in SIMDRegister lanes.
+        Returns false if the block has too few channels to fill a register,
+        in which case the caller falls back to the scalar path. */
+    bool processPackedChannels (const AudioBlock<const SampleType>& inputBlock,
+                                AudioBlock<SampleType>& outputBlock) noexcept;
+
     //==============================================================================
     SampleType g, h, R2;
     std::vector<SampleType> s1 { 2 }, s2 { 2 };
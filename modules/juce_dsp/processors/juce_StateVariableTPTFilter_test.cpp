@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class StateVariableTPTFilterTest  : public UnitTest
+{
+public:
+    StateVariableTPTFilterTest()
+        : UnitTest ("StateVariableTPTFilter", UnitTestCategories::dsp)
+    {}
+
+    template <typename SampleType>
+    void runTypeTests (const String& typeName)
+    {
+        // enough channels to exercise the packed SIMD path plus a scalar remainder
+        constexpr int numChannels = 7;
+        constexpr int numSamples  = 256;
+
+        for (auto type : { StateVariableTPTFilterType::lowpass,
+                           StateVariableTPTFilterType::bandpass,
+                           StateVariableTPTFilterType::highpass })
+        {
+            beginTest (typeName + ": block processing matches per-sample processing");
+
+            StateVariableTPTFilter<SampleType> blockFilter, sampleFilter;
+
+            for (auto* filter : { &blockFilter, &sampleFilter })
+            {
+                filter->prepare ({ 44100.0, (uint32) numSamples, (uint32) numChannels });
+                filter->setType (type);
+                filter->setCutoffFrequency (static_cast<SampleType> (1200.0));
+                filter->setResonance (static_cast<SampleType> (0.8));
+            }
+
+            AudioBuffer<SampleType> blockData (numChannels, numSamples),
+                                    sampleData (numChannels, numSamples);
+
+            auto random = getRandom();
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    auto value = static_cast<SampleType> (2.0f * random.nextFloat() - 1.0f);
+                    blockData .setSample (channel, i, value);
+                    sampleData.setSample (channel, i, value);
+                }
+            }
+
+            AudioBlock<SampleType> block (blockData);
+            blockFilter.process (ProcessContextReplacing<SampleType> (block));
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    sampleData.setSample (channel, i,
+                                          sampleFilter.processSample (channel, sampleData.getSample (channel, i)));
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    expectWithinAbsoluteError (blockData.getSample (channel, i),
+                                               sampleData.getSample (channel, i),
+                                               static_cast<SampleType> (1e-6));
+        }
+    }
+
+    void runTest() override
+    {
+        runTypeTests<float>  ("float");
+        runTypeTests<double> ("double");
+    }
+};
+
+static StateVariableTPTFilterTest stateVariableTPTFilterTest;
+
+} // namespace dsp
+} // namespace juce
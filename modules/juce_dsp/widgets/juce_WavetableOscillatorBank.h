@@ -0,0 +1,284 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    A bank of wavetable oscillators sharing one set of band-limited tables.
+
+    Oscillator evaluates its generator per sample per voice, which is too
+    expensive when hundreds of partials are running - an additive engine wants
+    the cost of a voice to be a table read and an add. This class keeps the
+    state of a whole bank in structure-of-arrays form (separate phase,
+    increment and gain arrays), renders each oscillator block-wise from a
+    precomputed LookupTable, and advances all of the phase accumulators for a
+    block in a single vectorised pass.
+
+    The waveform is turned into a mip chain at initialise() time: level 0
+    contains the full spectrum and each further level halves the number of
+    harmonics kept, computed by zeroing FFT bins of the sampled waveform. When
+    an oscillator's frequency is set, the shallowest level whose highest
+    harmonic stays below Nyquist is selected for it, so high notes read from a
+    duller table instead of aliasing.
+
+    process() mixes the whole bank into every channel of an AudioBlock,
+    adding to whatever the block already contains.
+
+    @see Oscillator, LookupTable
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class WavetableOscillatorBank
+{
+public:
+    static_assert (std::is_floating_point<SampleType>::value,
+                   "WavetableOscillatorBank only supports primitive floating point types");
+
+    /** Creates an uninitialised bank. Call initialise before first use. */
+    WavetableOscillatorBank() = default;
+
+    //==============================================================================
+    /** Builds the wavetable mip chain from a periodic function (-pi..pi).
+
+        The table size must be a power of two. If numMipLevelsToUse is zero, a
+        level is created for every halving of the harmonic count down to a
+        single harmonic; otherwise the chain stops after the requested number
+        of levels and the last one is reused for all higher frequencies.
+    */
+    void initialise (const std::function<SampleType (SampleType)>& waveFunction,
+                     size_t tableSize = 2048,
+                     int numMipLevelsToUse = 0)
+    {
+        jassert (isPowerOfTwo ((int) tableSize));
+
+        numTablePoints = tableSize;
+        auto fftOrder = 0;
+
+        while ((size_t (1) << fftOrder) < tableSize)
+            ++fftOrder;
+
+        FFT fft (fftOrder);
+
+        // Sample one cycle and transform it, then build each mip level by
+        // zeroing the bins above its harmonic limit and transforming back.
+        std::vector<float> spectrum (2 * tableSize, 0.0f);
+
+        for (size_t i = 0; i < tableSize; ++i)
+        {
+            auto phase = (SampleType (2) * MathConstants<SampleType>::pi * (SampleType) i) / (SampleType) tableSize
+                           - MathConstants<SampleType>::pi;
+            spectrum[i] = (float) waveFunction (phase);
+        }
+
+        fft.performRealOnlyForwardTransform (spectrum.data());
+
+        auto maxNumLevels = 1;
+
+        while ((int) (tableSize / 2) >> maxNumLevels > 0)
+            ++maxNumLevels;
+
+        auto numLevels = numMipLevelsToUse > 0 ? jmin (numMipLevelsToUse, maxNumLevels)
+                                               : maxNumLevels;
+        tables.clear();
+        maxHarmonics.clearQuick();
+
+        std::vector<float> levelSpectrum (2 * tableSize);
+        std::vector<SampleType> cycle (tableSize);
+
+        for (int level = 0; level < numLevels; ++level)
+        {
+            auto maxHarmonic = jmax (1, (int) (tableSize / 2 - 1) >> level);
+            maxHarmonics.add (maxHarmonic);
+
+            levelSpectrum = spectrum;
+
+            // Zero everything above the harmonic limit, including the
+            // conjugate (negative-frequency) bins and Nyquist.
+            for (auto bin = maxHarmonic + 1; bin <= (int) tableSize - (maxHarmonic + 1); ++bin)
+            {
+                levelSpectrum[(size_t) bin * 2]     = 0.0f;
+                levelSpectrum[(size_t) bin * 2 + 1] = 0.0f;
+            }
+
+            fft.performRealOnlyInverseTransform (levelSpectrum.data());
+
+            for (size_t i = 0; i < tableSize; ++i)
+                cycle[i] = (SampleType) levelSpectrum[i];
+
+            auto* table = new LookupTable<SampleType>();
+
+            // One extra point wrapping back to the start, so interpolation at
+            // the end of the cycle is seamless.
+            table->initialise ([&] (size_t i) { return cycle[i % tableSize]; }, tableSize + 1);
+            tables.add (table);
+        }
+    }
+
+    /** Returns true if initialise has been called. */
+    bool isInitialised() const noexcept             { return ! tables.isEmpty(); }
+
+    //==============================================================================
+    /** Sets the number of oscillators in the bank.
+
+        New oscillators start silent, at phase zero and frequency zero. Don't
+        call this from the audio thread while the bank is rendering.
+    */
+    void setNumOscillators (int numOscillators)
+    {
+        jassert (numOscillators >= 0);
+
+        phases    .resize ((size_t) numOscillators, SampleType (0));
+        increments.resize ((size_t) numOscillators, SampleType (0));
+        gains     .resize ((size_t) numOscillators, SampleType (0));
+        tableIndices.resize ((size_t) numOscillators, 0);
+    }
+
+    /** Returns the number of oscillators in the bank. */
+    int getNumOscillators() const noexcept          { return (int) phases.size(); }
+
+    /** Sets the frequency of one oscillator, picking the band-limited mip
+        level appropriate for it at the current sample rate.
+    */
+    void setFrequency (int oscillatorIndex, SampleType frequencyHz) noexcept
+    {
+        jassert (isPositiveAndBelow (oscillatorIndex, getNumOscillators()));
+        jassert (sampleRate > 0);
+        jassert (frequencyHz >= 0 && frequencyHz < (SampleType) sampleRate / 2);
+
+        increments[(size_t) oscillatorIndex] = frequencyHz / (SampleType) sampleRate;
+
+        auto maxAllowedHarmonic = frequencyHz > 0 ? (SampleType) sampleRate / (SampleType (2) * frequencyHz)
+                                                  : (SampleType) std::numeric_limits<int>::max();
+        auto level = 0;
+
+        while (level < tables.size() - 1 && (SampleType) maxHarmonics[level] > maxAllowedHarmonic)
+            ++level;
+
+        tableIndices[(size_t) oscillatorIndex] = level;
+    }
+
+    /** Sets the gain that one oscillator is mixed in with. A gain of zero
+        skips the oscillator entirely.
+    */
+    void setGain (int oscillatorIndex, SampleType gain) noexcept
+    {
+        jassert (isPositiveAndBelow (oscillatorIndex, getNumOscillators()));
+        gains[(size_t) oscillatorIndex] = gain;
+    }
+
+    /** Sets the phase of one oscillator, in the range [0, 1). */
+    void setPhase (int oscillatorIndex, SampleType newPhase) noexcept
+    {
+        jassert (isPositiveAndBelow (oscillatorIndex, getNumOscillators()));
+        phases[(size_t) oscillatorIndex] = newPhase - std::floor (newPhase);
+    }
+
+    //==============================================================================
+    /** Called before processing starts. */
+    void prepare (const ProcessSpec& spec)
+    {
+        sampleRate = spec.sampleRate;
+        mixBuffer.resize ((size_t) spec.maximumBlockSize);
+
+        reset();
+    }
+
+    /** Resets all phase accumulators to zero. */
+    void reset() noexcept
+    {
+        std::fill (phases.begin(), phases.end(), SampleType (0));
+    }
+
+    //==============================================================================
+    /** Renders the next block, mixing the sum of the bank into every channel
+        of the given block.
+    */
+    void process (AudioBlock<SampleType> outBlock) noexcept
+    {
+        jassert (isInitialised());
+
+        auto numSamples = outBlock.getNumSamples();
+        jassert (numSamples <= mixBuffer.size());
+
+        auto numOscillators = phases.size();
+
+        if (numSamples == 0 || numOscillators == 0)
+            return;
+
+        std::fill (mixBuffer.begin(), mixBuffer.begin() + numSamples, SampleType (0));
+
+        auto indexScale = (SampleType) numTablePoints;
+
+        for (size_t i = 0; i < numOscillators; ++i)
+        {
+            auto gain = gains[i];
+
+            if (gain == SampleType (0))
+                continue;
+
+            const auto& table = *tables.getUnchecked (tableIndices[i]);
+            auto phase = phases[i];
+            auto increment = increments[i];
+
+            for (size_t j = 0; j < numSamples; ++j)
+            {
+                mixBuffer[j] += gain * table.getUnchecked (phase * indexScale);
+                phase += increment;
+
+                if (phase >= SampleType (1))
+                    phase -= SampleType (1);
+            }
+        }
+
+        // Advance all accumulators for the whole block in one vectorised pass,
+        // then wrap them back into [0, 1).
+        FloatVectorOperations::addWithMultiply (phases.data(), increments.data(),
+                                                (SampleType) numSamples, (int) numOscillators);
+
+        for (auto& phase : phases)
+            phase -= std::floor (phase);
+
+        for (size_t chan = 0; chan < outBlock.getNumChannels(); ++chan)
+            FloatVectorOperations::add (outBlock.getChannelPointer (chan), mixBuffer.data(), (int) numSamples);
+    }
+
+private:
+    //==============================================================================
+    OwnedArray<LookupTable<SampleType>> tables;
+    Array<int> maxHarmonics;
+    size_t numTablePoints = 0;
+
+    std::vector<SampleType> phases, increments, gains, mixBuffer;
+    std::vector<int> tableIndices;
+
+    double sampleRate = 0.0;
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class WavetableOscillatorBankTests : public UnitTest
+{
+public:
+    WavetableOscillatorBankTests()
+        : UnitTest ("WavetableOscillatorBank", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("A bank of sines matches directly-evaluated oscillators");
+        {
+            WavetableOscillatorBank<float> bank;
+            bank.initialise ([] (float x) { return std::sin (x); }, 1024);
+            bank.prepare ({ 44100.0, 512, 1 });
+
+            bank.setNumOscillators (2);
+            bank.setFrequency (0, 440.0f);
+            bank.setGain      (0, 0.5f);
+            bank.setFrequency (1, 880.0f);
+            bank.setGain      (1, 0.25f);
+
+            AudioBuffer<float> buffer (1, 512);
+            buffer.clear();
+            bank.process (AudioBlock<float> (buffer));
+
+            auto phase0 = 0.0, phase1 = 0.0;
+
+            for (int j = 0; j < buffer.getNumSamples(); ++j)
+            {
+                auto expected = 0.5  * std::sin (MathConstants<double>::twoPi * phase0 - MathConstants<double>::pi)
+                              + 0.25 * std::sin (MathConstants<double>::twoPi * phase1 - MathConstants<double>::pi);
+
+                expectWithinAbsoluteError (buffer.getSample (0, j), (float) expected, 1.0e-3f);
+
+                phase0 += 440.0 / 44100.0;
+                phase1 += 880.0 / 44100.0;
+            }
+        }
+
+        beginTest ("Rendering in several blocks matches one long block");
+        {
+            auto saw = [] (float x) { return x / MathConstants<float>::pi; };
+
+            WavetableOscillatorBank<float> reference, split;
+
+            for (auto* bank : { &reference, &split })
+            {
+                bank->initialise (saw, 2048);
+                bank->prepare ({ 48000.0, 512, 1 });
+                bank->setNumOscillators (1);
+                bank->setFrequency (0, 523.25f);
+                bank->setGain (0, 1.0f);
+            }
+
+            AudioBuffer<float> oneBlock (1, 512), twoBlocks (1, 512);
+            oneBlock.clear();
+            twoBlocks.clear();
+
+            reference.process (AudioBlock<float> (oneBlock));
+
+            AudioBlock<float> block (twoBlocks);
+            split.process (block.getSubBlock (0, 200));
+            split.process (block.getSubBlock (200, 312));
+
+            // The vectorised block advance rounds the accumulators slightly
+            // differently to the per-sample loop, so a small tolerance is needed.
+            for (int j = 0; j < oneBlock.getNumSamples(); ++j)
+                expectWithinAbsoluteError (twoBlocks.getSample (0, j), oneBlock.getSample (0, j), 5.0e-4f);
+        }
+
+        beginTest ("process() adds to the existing contents of the block");
+        {
+            WavetableOscillatorBank<float> bank;
+            bank.initialise ([] (float x) { return std::sin (x); }, 1024);
+            bank.prepare ({ 44100.0, 64, 2 });
+            bank.setNumOscillators (1);
+            bank.setFrequency (0, 1000.0f);
+            bank.setGain (0, 1.0f);
+
+            AudioBuffer<float> silent (2, 64), offset (2, 64);
+            silent.clear();
+
+            for (int chan = 0; chan < 2; ++chan)
+                for (int j = 0; j < 64; ++j)
+                    offset.setSample (chan, j, 1.0f);
+
+            bank.process (AudioBlock<float> (silent));
+            bank.reset();
+            bank.process (AudioBlock<float> (offset));
+
+            for (int chan = 0; chan < 2; ++chan)
+                for (int j = 0; j < 64; ++j)
+                    expectWithinAbsoluteError (offset.getSample (chan, j),
+                                               silent.getSample (chan, j) + 1.0f, 1.0e-6f);
+        }
+
+        beginTest ("High frequencies use a mip level without aliasing harmonics");
+        {
+            auto saw = [] (float x) { return x / MathConstants<float>::pi; };
+
+            WavetableOscillatorBank<float> bank;
+            bank.initialise (saw, 2048);
+            bank.prepare ({ 1024.0, 1024, 1 });
+            bank.setNumOscillators (1);
+
+            // 32 cycles per 1024 samples: harmonic h lands exactly on bin 32h,
+            // and only harmonics below Nyquist (h <= 16) may be present.
+            bank.setFrequency (0, 32.0f);
+            bank.setGain (0, 1.0f);
+
+            AudioBuffer<float> buffer (1, 1024);
+            buffer.clear();
+            bank.process (AudioBlock<float> (buffer));
+
+            FFT fft (10);
+            std::vector<float> spectrum (2048, 0.0f);
+            std::copy (buffer.getReadPointer (0), buffer.getReadPointer (0) + 1024, spectrum.begin());
+            fft.performFrequencyOnlyForwardTransform (spectrum.data());
+
+            // The fundamental should be strong...
+            expect (spectrum[32] > 100.0f);
+
+            // ...and bins where a non-band-limited sawtooth would alias should be empty.
+            for (auto h = 17; h * 32 < 512; ++h)
+                expect (spectrum[(size_t) (h * 32)] < 1.0f);
+        }
+    }
+};
+
+static WavetableOscillatorBankTests wavetableOscillatorBankTests;
+
+} // namespace dsp
+} // namespace juce
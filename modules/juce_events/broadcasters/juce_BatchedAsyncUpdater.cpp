@@ -0,0 +1,179 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/*  The shared dispatcher behind all BatchedAsyncUpdaters.
+
+    Each latency tier has its own queue of triggered updaters, and at most one
+    dispatch scheduled at a time: the first trigger of a burst posts a message
+    (or starts a timer), and every further trigger just appends to the queue.
+    When the scheduled callback arrives, it drains the whole queue in one pass.
+*/
+class BatchedAsyncUpdater::Dispatcher  : private MultiTimer
+{
+public:
+    static Dispatcher& get()
+    {
+        static Dispatcher dispatcher;
+        return dispatcher;
+    }
+
+    void trigger (BatchedAsyncUpdater* updater)
+    {
+        const auto tierIndex = (int) updater->tier;
+        bool shouldSchedule;
+
+        {
+            const ScopedLock sl (queueLock);
+            queues[tierIndex].add (updater);
+            shouldSchedule = ! dispatchScheduled[tierIndex];
+            dispatchScheduled[tierIndex] = true;
+        }
+
+        if (shouldSchedule)
+            scheduleDispatch (updater->tier);
+    }
+
+    void cancel (BatchedAsyncUpdater* updater) noexcept
+    {
+        const ScopedLock sl (queueLock);
+        queues[(int) updater->tier].removeFirstMatchingValue (updater);
+    }
+
+private:
+    Dispatcher() = default;
+
+    void scheduleDispatch (LatencyTier tier)
+    {
+        switch (tier)
+        {
+            case LatencyTier::nextTick:
+                if (! MessageManager::callAsync ([] { get().dispatch ((int) LatencyTier::nextTick); }))
+                {
+                    // the message queue is shutting down, so let a later
+                    // trigger try again
+                    const ScopedLock sl (queueLock);
+                    dispatchScheduled[(int) LatencyTier::nextTick] = false;
+                }
+                break;
+
+            case LatencyTier::nextFrame:  startTimer ((int) LatencyTier::nextFrame, 15);  break;
+            case LatencyTier::idle:       startTimer ((int) LatencyTier::idle, 100);      break;
+        }
+    }
+
+    void timerCallback (int timerID) override
+    {
+        stopTimer (timerID);
+        dispatch (timerID);
+    }
+
+    void dispatch (int tierIndex)
+    {
+        {
+            const ScopedLock sl (queueLock);
+            dispatchScheduled[tierIndex] = false;
+        }
+
+        // Updaters are popped one at a time so that a callback which deletes
+        // (or cancels) another queued updater can't leave us holding a stale
+        // pointer. Anything triggered during this pass gets drained here too.
+        for (;;)
+        {
+            BatchedAsyncUpdater* updater;
+
+            {
+                const ScopedLock sl (queueLock);
+                auto& queue = queues[tierIndex];
+
+                if (queue.isEmpty())
+                    break;
+
+                updater = queue.removeAndReturn (0);
+            }
+
+            if (updater->updatePending.exchange (false))
+                updater->handleAsyncUpdate();
+        }
+    }
+
+    enum { numTiers = 3 };
+
+    CriticalSection queueLock;
+    Array<BatchedAsyncUpdater*> queues[numTiers];
+    bool dispatchScheduled[numTiers] = {};
+};
+
+//==============================================================================
+BatchedAsyncUpdater::BatchedAsyncUpdater (LatencyTier tierToUse)  : tier (tierToUse)
+{
+}
+
+BatchedAsyncUpdater::~BatchedAsyncUpdater()
+{
+    // You're deleting this object with a background thread while there's an update
+    // pending on the main event thread - that's pretty dodgy threading, as the callback could
+    // happen after this destructor has finished. You should either use a MessageManagerLock while
+    // deleting this object, or find some other way to avoid such a race condition.
+    jassert ((! isUpdatePending())
+              || MessageManager::getInstanceWithoutCreating() == nullptr
+              || MessageManager::getInstanceWithoutCreating()->currentThreadHasLockedMessageManager());
+
+    cancelPendingUpdate();
+}
+
+void BatchedAsyncUpdater::triggerAsyncUpdate()
+{
+    // If you're calling this before (or after) the MessageManager is
+    // running, then you're not going to get any callbacks!
+    JUCE_ASSERT_MESSAGE_MANAGER_EXISTS
+
+    if (! updatePending.exchange (true))
+        Dispatcher::get().trigger (this);
+}
+
+void BatchedAsyncUpdater::cancelPendingUpdate() noexcept
+{
+    if (updatePending.exchange (false))
+        Dispatcher::get().cancel (this);
+}
+
+void BatchedAsyncUpdater::handleUpdateNowIfNeeded()
+{
+    // This can only be called by the event thread.
+    JUCE_ASSERT_MESSAGE_MANAGER_IS_LOCKED
+
+    if (updatePending.exchange (false))
+    {
+        Dispatcher::get().cancel (this);
+        handleAsyncUpdate();
+    }
+}
+
+bool BatchedAsyncUpdater::isUpdatePending() const noexcept
+{
+    return updatePending;
+}
+
+} // namespace juce
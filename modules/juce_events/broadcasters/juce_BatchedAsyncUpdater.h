@@ -0,0 +1,148 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An AsyncUpdater-style callback whose delivery is batched through a shared
+    dispatcher instead of posting one message per trigger.
+
+    A plain AsyncUpdater posts a message to the system queue every time one of
+    its pending updates is triggered, so when thousands of objects trigger
+    updates in the same burst, the message queue receives thousands of posts
+    and the message thread pays a full dispatch for each one. All
+    BatchedAsyncUpdaters share a single dispatcher: however many of them are
+    triggered, each burst costs one message post, and all the pending callbacks
+    are delivered in a single pass of the message loop.
+
+    The dispatcher maintains a queue per latency tier, so updaters can declare
+    how urgent their callbacks are:
+
+    - nextTick updates are delivered by the next message-loop callback, just
+      like a plain AsyncUpdater.
+    - nextFrame updates are delivered within roughly one frame (15ms) of the
+      first trigger, which suits repaint-style notifications where sub-frame
+      latency would be wasted work anyway.
+    - idle updates are delivered within about 100ms, for housekeeping that
+      just needs to happen "soonish" without competing with more urgent work.
+
+    Triggers in a lower-latency tier never wait behind a slower tier - each
+    tier is drained by its own pass. Within a tier, callbacks happen in the
+    order in which the updaters were first triggered, so a storm of triggers
+    can't starve any individual updater.
+
+    The public interface mirrors AsyncUpdater, so switching a class between the
+    two is usually just a change of base class.
+
+    @see AsyncUpdater
+
+    @tags{Events}
+*/
+class JUCE_API  BatchedAsyncUpdater
+{
+public:
+    //==============================================================================
+    /** The latency tiers that a BatchedAsyncUpdater can be assigned to.
+        @see BatchedAsyncUpdater::BatchedAsyncUpdater
+    */
+    enum class LatencyTier
+    {
+        nextTick,   /**< Deliver by the next message-loop callback. */
+        nextFrame,  /**< Deliver within roughly one frame of the first trigger. */
+        idle        /**< Deliver within about 100ms, when things are quieter. */
+    };
+
+    //==============================================================================
+    /** Creates a BatchedAsyncUpdater for the given latency tier. */
+    explicit BatchedAsyncUpdater (LatencyTier tierToUse = LatencyTier::nextTick);
+
+    /** Destructor.
+        If there are any pending callbacks when the object is deleted, these are lost.
+    */
+    virtual ~BatchedAsyncUpdater();
+
+    //==============================================================================
+    /** Causes the callback to be triggered at a later time.
+
+        This method returns immediately, and a callback to handleAsyncUpdate()
+        will be made by the message thread within the latency that this
+        object's tier allows.
+
+        If an update callback is already pending but hasn't happened yet,
+        calling this method will have no effect.
+
+        It's thread-safe to call this method from any thread, BUT beware of calling
+        it from a real-time (e.g. audio) thread, because the first trigger of a
+        burst has to post a message or start a timer, which may block.
+    */
+    void triggerAsyncUpdate();
+
+    /** This will stop any pending updates from happening.
+
+        If called after triggerAsyncUpdate() and before the handleAsyncUpdate()
+        callback happens, this will cancel the handleAsyncUpdate() callback.
+
+        Note that this method simply cancels the next callback - if a callback is already
+        in progress on a different thread, this won't block until the callback finishes, so
+        there's no guarantee that the callback isn't still running when the method returns.
+    */
+    void cancelPendingUpdate() noexcept;
+
+    /** If an update has been triggered and is pending, this will invoke it
+        synchronously.
+
+        Use this as a kind of "flush" operation - if an update is pending, the
+        handleAsyncUpdate() method will be called immediately; if no update is
+        pending, then nothing will be done.
+
+        Because this may invoke the callback, this method must only be called on
+        the main event thread.
+    */
+    void handleUpdateNowIfNeeded();
+
+    /** Returns true if there's an update callback in the pipeline. */
+    bool isUpdatePending() const noexcept;
+
+    /** Returns the latency tier that was passed to the constructor. */
+    LatencyTier getLatencyTier() const noexcept     { return tier; }
+
+    //==============================================================================
+    /** Called back to do whatever your class needs to do.
+
+        This method is called by the message thread at the next convenient time
+        after the triggerAsyncUpdate() method has been called.
+    */
+    virtual void handleAsyncUpdate() = 0;
+
+private:
+    //==============================================================================
+    class Dispatcher;
+
+    const LatencyTier tier;
+    std::atomic<bool> updatePending { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BatchedAsyncUpdater)
+};
+
+} // namespace juce
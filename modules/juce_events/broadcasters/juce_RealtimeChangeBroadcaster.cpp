@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/*  One dispatcher is shared by every RealtimeChangeBroadcaster. It sweeps the
+    registered broadcasters on a timer and delivers the changes of all of them
+    in one pass, so triggering a broadcaster costs an atomic store rather than
+    a posted message, however many broadcasters there are.
+*/
+class RealtimeChangeBroadcaster::Dispatcher  : private Timer,
+                                               private DeletedAtShutdown
+{
+public:
+    Dispatcher() = default;
+
+    ~Dispatcher() override
+    {
+        stopTimer();
+        clearSingletonInstance();
+    }
+
+    void registerBroadcaster (RealtimeChangeBroadcaster* b)
+    {
+        broadcasters.add (b);
+
+        if (! isTimerRunning())
+            startTimerHz (sweepRateHz);
+    }
+
+    void unregisterBroadcaster (RealtimeChangeBroadcaster* b)
+    {
+        broadcasters.remove (b);
+
+        if (broadcasters.isEmpty())
+            stopTimer();
+    }
+
+    JUCE_DECLARE_SINGLETON (Dispatcher, false)
+
+private:
+    void timerCallback() override
+    {
+        // Using a ListenerList makes the sweep safe against broadcasters being
+        // deleted from inside a listener callback mid-iteration.
+        broadcasters.call ([] (RealtimeChangeBroadcaster& b) { b.dispatchPendingMessages(); });
+    }
+
+    enum { sweepRateHz = 60 };
+
+    ListenerList<RealtimeChangeBroadcaster> broadcasters;
+};
+
+JUCE_IMPLEMENT_SINGLETON (RealtimeChangeBroadcaster::Dispatcher)
+
+//==============================================================================
+RealtimeChangeBroadcaster::RealtimeChangeBroadcaster()
+{
+    // The dispatcher runs on the message thread, so broadcasters must be
+    // created there too.
+    JUCE_ASSERT_MESSAGE_MANAGER_IS_LOCKED
+
+    Dispatcher::getInstance()->registerBroadcaster (this);
+}
+
+RealtimeChangeBroadcaster::~RealtimeChangeBroadcaster()
+{
+    JUCE_ASSERT_MESSAGE_MANAGER_IS_LOCKED
+
+    if (auto* dispatcher = Dispatcher::getInstanceWithoutCreating())
+        dispatcher->unregisterBroadcaster (this);
+}
+
+void RealtimeChangeBroadcaster::sendChangeMessage() noexcept
+{
+    changePending.store (true, std::memory_order_release);
+}
+
+void RealtimeChangeBroadcaster::sendSynchronousChangeMessage()
+{
+    changePending.store (false, std::memory_order_relaxed);
+    ChangeBroadcaster::sendSynchronousChangeMessage();
+}
+
+void RealtimeChangeBroadcaster::dispatchPendingMessages()
+{
+    // The exchange means a trigger racing with the sweep is either delivered
+    // now or leaves the flag set for the next one - it can never be lost.
+    if (changePending.exchange (false, std::memory_order_acquire))
+        ChangeBroadcaster::sendSynchronousChangeMessage();
+
+    // A change posted through the base class still gets flushed here too.
+    ChangeBroadcaster::dispatchPendingMessages();
+}
+
+} // namespace juce
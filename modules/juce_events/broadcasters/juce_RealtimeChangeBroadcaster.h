@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A ChangeBroadcaster whose sendChangeMessage() is safe to call from a
+    real-time thread.
+
+    ChangeBroadcaster::sendChangeMessage() posts a message to the event queue,
+    which may lock or allocate, so it can't legally be called from an audio
+    callback. The version here just sets an atomic flag belonging to this
+    broadcaster - a wait-free operation - and a single dispatcher shared by
+    all RealtimeChangeBroadcasters sweeps the flags periodically on the
+    message thread, calling the listeners of any broadcaster that was
+    triggered since the previous sweep.
+
+    Delivery is therefore coalesced aggressively: however many times a
+    broadcaster is triggered between two sweeps, its listeners are called
+    once, so an object that changes thousands of times per second costs no
+    more to observe than one that changes rarely. The trade-off is latency -
+    listeners hear about a change on the next sweep rather than on the next
+    message-loop iteration.
+
+    Because this derives from ChangeBroadcaster it can be observed with an
+    ordinary ChangeListener, and the listener's source pointer is this object
+    as usual. Note that sendChangeMessage() is statically dispatched, so the
+    wait-free version is only used when calling through a pointer or
+    reference of this type; through a plain ChangeBroadcaster* you'll get the
+    base class's message-posting version, which still delivers correctly but
+    isn't real-time safe.
+
+    Broadcasters must be created and deleted on the message thread, like the
+    listener methods; only sendChangeMessage() may be called from elsewhere.
+
+    @see ChangeBroadcaster, ChangeListener
+
+    @tags{Events}
+*/
+class JUCE_API  RealtimeChangeBroadcaster   : public ChangeBroadcaster
+{
+public:
+    //==============================================================================
+    /** Creates a RealtimeChangeBroadcaster.
+        This must be called on the message thread.
+    */
+    RealtimeChangeBroadcaster();
+
+    /** Destructor.
+        This must be called on the message thread.
+    */
+    ~RealtimeChangeBroadcaster() override;
+
+    //==============================================================================
+    /** Flags this broadcaster as changed, so that its listeners will be called
+        on the dispatcher's next sweep of the message thread.
+
+        This is wait-free - it performs a single atomic store and will never
+        lock, allocate or post a message - so it's safe to call from any
+        thread, including an audio callback, at any rate.
+    */
+    void sendChangeMessage() noexcept;
+
+    /** Sends a synchronous change message to all the registered listeners,
+        clearing any pending flag first so that the dispatcher won't deliver
+        the same change again.
+
+        For thread-safety reasons, you must only call this method on the main
+        message thread.
+    */
+    void sendSynchronousChangeMessage();
+
+    /** If a change has been flagged but not yet dispatched, this will call
+        sendSynchronousChangeMessage() to make the callbacks immediately
+        rather than waiting for the dispatcher's next sweep.
+
+        For thread-safety reasons, you must only call this method on the main
+        message thread.
+    */
+    void dispatchPendingMessages();
+
+private:
+    //==============================================================================
+    class Dispatcher;
+
+    std::atomic<bool> changePending { false };
+
+    JUCE_DECLARE_NON_COPYABLE (RealtimeChangeBroadcaster)
+};
+
+} // namespace juce
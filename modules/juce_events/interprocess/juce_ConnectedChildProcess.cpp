@@ -28,6 +28,7 @@ enum { magicCoordWorkerConnectionHeader = 0x712baf04 };
 static const char* startMessage = "__ipc_st";
 static const char* killMessage  = "__ipc_k_";
 static const char* pingMessage  = "__ipc_p_";
+static const char* shmMessage   = "__ipc_sh";
 enum { specialMessageSize = 8, defaultTimeoutMs = 8000 };
 
 static bool isMessageType (const MemoryBlock& mb, const char* messageType) noexcept
@@ -35,6 +36,12 @@ static bool isMessageType (const MemoryBlock& mb, const char* messageType) noexc
     return mb.matches (messageType, (size_t) specialMessageSize);
 }
 
+static bool isMessageTypeWithPayload (const MemoryBlock& mb, const char* messageType) noexcept
+{
+    return mb.getSize() > (size_t) specialMessageSize
+            && memcmp (mb.getData(), messageType, (size_t) specialMessageSize) == 0;
+}
+
 static String getCommandLinePrefix (const String& commandLineUniqueID)
 {
     return "--" + commandLineUniqueID + ":";
@@ -179,6 +186,34 @@ bool ChildProcessCoordinator::launchWorkerProcess (const File& executable, const
     return false;
 }
 
+bool ChildProcessCoordinator::createSharedMemoryTransport (size_t capacityBytes)
+{
+    if (connection == nullptr)
+    {
+        jassertfalse; // this can only be used when the connection is active!
+        return false;
+    }
+
+    auto name = "t" + String::toHexString (Random().nextInt64());
+
+    std::unique_ptr<SharedMemoryRingBuffer> toWorker (new SharedMemoryRingBuffer()),
+                                            fromWorker (new SharedMemoryRingBuffer());
+
+    if (! (toWorker->createNewBuffer (name + "_c2w", capacityBytes)
+            && fromWorker->createNewBuffer (name + "_w2c", capacityBytes)))
+        return false;
+
+    MemoryBlock message (shmMessage, (size_t) specialMessageSize);
+    message.append (name.toRawUTF8(), name.getNumBytesAsUTF8());
+
+    if (! sendMessageToWorker (message))
+        return false;
+
+    transportToWorker   = std::move (toWorker);
+    transportFromWorker = std::move (fromWorker);
+    return true;
+}
+
 void ChildProcessCoordinator::killWorkerProcess()
 {
     if (connection != nullptr)
@@ -188,6 +223,8 @@ void ChildProcessCoordinator::killWorkerProcess()
         connection.reset();
     }
 
+    transportToWorker.reset();
+    transportFromWorker.reset();
     childProcess.reset();
 }
 
@@ -233,6 +270,10 @@ private:
         if (isMessageType (m, startMessage))
             return owner.handleConnectionMade();
 
+        if (isMessageTypeWithPayload (m, shmMessage))
+            return owner.openSharedMemoryTransport (String::fromUTF8 (static_cast<const char*> (m.getData()) + specialMessageSize,
+                                                                      (int) m.getSize() - specialMessageSize));
+
         owner.handleMessageFromCoordinator (m);
     }
 
@@ -245,6 +286,25 @@ ChildProcessWorker::~ChildProcessWorker() = default;
 
 void ChildProcessWorker::handleConnectionMade() {}
 void ChildProcessWorker::handleConnectionLost() {}
+void ChildProcessWorker::handleSharedMemoryTransportCreated() {}
+
+void ChildProcessWorker::openSharedMemoryTransport (const String& name)
+{
+    std::unique_ptr<SharedMemoryRingBuffer> fromCoordinator (new SharedMemoryRingBuffer()),
+                                            toCoordinator (new SharedMemoryRingBuffer());
+
+    if (fromCoordinator->openExisting (name + "_c2w")
+         && toCoordinator->openExisting (name + "_w2c"))
+    {
+        transportFromCoordinator = std::move (fromCoordinator);
+        transportToCoordinator   = std::move (toCoordinator);
+        handleSharedMemoryTransportCreated();
+    }
+    else
+    {
+        jassertfalse; // the coordinator announced a transport that couldn't be opened!
+    }
+}
 
 void ChildProcessWorker::handleMessageFromCoordinator (const MemoryBlock& mb)
 {
@@ -108,10 +108,35 @@ public:
     [[deprecated ("Replaced by sendMessageToCoordinator.")]]
     bool sendMessageToMaster (const MemoryBlock& mb) { return sendMessageToCoordinator (mb); }
 
+    //==============================================================================
+    /** This will be called when the coordinator process has set up a shared memory
+        transport with ChildProcessCoordinator::createSharedMemoryTransport() and
+        this process has attached to it.
+        The call will probably be made on a background thread, so be careful with
+        your thread-safety!
+    */
+    virtual void handleSharedMemoryTransportCreated();
+
+    /** Returns the shared memory buffer for sending bulk data to the coordinator,
+        or nullptr if no shared memory transport has been set up.
+        Only this process may write to the returned buffer.
+    */
+    SharedMemoryRingBuffer* getTransportToCoordinator() const noexcept    { return transportToCoordinator.get(); }
+
+    /** Returns the shared memory buffer carrying bulk data sent by the coordinator,
+        or nullptr if no shared memory transport has been set up.
+        Only this process may read from the returned buffer.
+    */
+    SharedMemoryRingBuffer* getTransportFromCoordinator() const noexcept  { return transportFromCoordinator.get(); }
+
 private:
     struct Connection;
     std::unique_ptr<Connection> connection;
 
+    std::unique_ptr<SharedMemoryRingBuffer> transportToCoordinator, transportFromCoordinator;
+
+    void openSharedMemoryTransport (const String& name);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChildProcessWorker)
 };
 
@@ -214,12 +239,43 @@ public:
     [[deprecated ("Replaced by sendMessageToWorker.")]]
     bool sendMessageToSlave (const MemoryBlock& mb) { return sendMessageToWorker (mb); }
 
+    //==============================================================================
+    /** Sets up a pair of shared memory ring buffers for bulk data transfer with
+        the worker process, one for each direction.
+
+        This can be called once the worker has been launched successfully. It
+        creates the shared region and tells the worker to attach to it, which
+        triggers a call to ChildProcessWorker::handleSharedMemoryTransportCreated()
+        at the other end. Large payloads such as audio buffers can then be moved
+        through the shared pages without any copying, keeping the pipe free for
+        control messages.
+
+        Returns true if the buffers were created and the worker was notified.
+
+        @see getTransportToWorker, getTransportFromWorker, SharedMemoryRingBuffer
+    */
+    bool createSharedMemoryTransport (size_t capacityBytes);
+
+    /** Returns the shared memory buffer for sending bulk data to the worker, or
+        nullptr if createSharedMemoryTransport() hasn't been called successfully.
+        Only this process may write to the returned buffer.
+    */
+    SharedMemoryRingBuffer* getTransportToWorker() const noexcept    { return transportToWorker.get(); }
+
+    /** Returns the shared memory buffer carrying bulk data sent by the worker, or
+        nullptr if createSharedMemoryTransport() hasn't been called successfully.
+        Only this process may read from the returned buffer.
+    */
+    SharedMemoryRingBuffer* getTransportFromWorker() const noexcept  { return transportFromWorker.get(); }
+
 private:
     std::unique_ptr<ChildProcess> childProcess;
 
     struct Connection;
     std::unique_ptr<Connection> connection;
 
+    std::unique_ptr<SharedMemoryRingBuffer> transportToWorker, transportFromWorker;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChildProcessCoordinator)
 };
 
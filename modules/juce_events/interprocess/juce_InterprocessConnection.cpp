@@ -147,6 +147,9 @@ bool InterprocessConnection::createPipe (const String& pipeName, int timeoutMs,
 
 void InterprocessConnection::disconnect (int timeoutMs, Notify notify)
 {
+    if (batchingEnabled)
+        flushOutgoingMessages();
+
     thread->signalThreadShouldExit();
 
     {
@@ -202,6 +205,35 @@ bool InterprocessConnection::sendMessage (const MemoryBlock& message)
     uint32 messageHeader[2] = { ByteOrder::swapIfBigEndian (magicMessageHeader),
                                 ByteOrder::swapIfBigEndian ((uint32) message.getSize()) };
 
+    if (batchingEnabled)
+    {
+        bool usingSocket;
+
+        {
+            const ScopedReadLock sl (pipeAndSocketLock);
+            usingSocket = socket != nullptr;
+        }
+
+        bool flushNow;
+
+        {
+            const ScopedLock sl (outgoingQueueLock);
+            outgoingQueue.append (messageHeader, sizeof (messageHeader));
+            outgoingQueue.append (message.getData(), message.getSize());
+
+            // Big batches are written straight away; pipes don't take part in
+            // batching because their reader may block for long periods
+            flushNow = outgoingQueue.getSize() >= maxBatchBytes || ! usingSocket;
+        }
+
+        if (flushNow)
+            return flushOutgoingMessages();
+
+        // ..otherwise the connection thread picks the batch up within the
+        // coalescing window
+        return isConnected();
+    }
+
     MemoryBlock messageData (sizeof (messageHeader) + message.getSize());
     messageData.copyFrom (messageHeader, 0, sizeof (messageHeader));
     messageData.copyFrom (message.getData(), sizeof (messageHeader), message.getSize());
@@ -209,6 +241,36 @@ bool InterprocessConnection::sendMessage (const MemoryBlock& message)
     return writeData (messageData.getData(), (int) messageData.getSize()) == (int) messageData.getSize();
 }
 
+void InterprocessConnection::setMessageBatchingEnabled (bool shouldBatchMessages, int maxBatchDelayMilliseconds)
+{
+    maxBatchDelayMs = jmax (1, maxBatchDelayMilliseconds);
+    batchingEnabled = shouldBatchMessages;
+
+    if (! shouldBatchMessages)
+        flushOutgoingMessages();
+}
+
+void InterprocessConnection::flushPendingMessages()
+{
+    flushOutgoingMessages();
+}
+
+bool InterprocessConnection::flushOutgoingMessages()
+{
+    MemoryBlock toSend;
+
+    {
+        const ScopedLock sl (outgoingQueueLock);
+
+        if (outgoingQueue.getSize() == 0)
+            return true;
+
+        toSend.swapWith (outgoingQueue);
+    }
+
+    return writeData (toSend.getData(), (int) toSend.getSize()) == (int) toSend.getSize();
+}
+
 int InterprocessConnection::writeData (void* data, int dataSize)
 {
     const ScopedReadLock sl (pipeAndSocketLock);
@@ -313,14 +375,51 @@ struct DataDeliveryMessage  : public Message
     MemoryBlock data;
 };
 
+struct BatchedDataDeliveryMessage  : public Message
+{
+    BatchedDataDeliveryMessage (std::shared_ptr<SafeActionImpl> ipc, Array<MemoryBlock>&& d)
+        : safeAction (ipc), messages (std::move (d))
+    {}
+
+    void messageCallback() override
+    {
+        safeAction->ifSafe ([this] (InterprocessConnection& owner)
+        {
+            for (auto& m : messages)
+                owner.messageReceived (m);
+        });
+    }
+
+    std::shared_ptr<SafeActionImpl> safeAction;
+    Array<MemoryBlock> messages;
+};
+
 void InterprocessConnection::deliverDataInt (const MemoryBlock& data)
 {
     jassert (callbackConnectionState);
 
     if (useMessageThread)
-        (new DataDeliveryMessage (safeAction, data))->post();
+    {
+        // With batching on, messages read in one drain of the socket are
+        // collected up and delivered with a single message-thread wakeup
+        if (batchingEnabled)
+            incomingBatch.add (data);
+        else
+            (new DataDeliveryMessage (safeAction, data))->post();
+    }
     else
+    {
         messageReceived (data);
+    }
+}
+
+void InterprocessConnection::deliverBatchedIncomingMessages()
+{
+    if (! incomingBatch.isEmpty())
+    {
+        (new BatchedDataDeliveryMessage (safeAction, std::move (incomingBatch)))->post();
+        incomingBatch.clearQuick();
+    }
 }
 
 //==============================================================================
@@ -390,9 +489,13 @@ void InterprocessConnection::runThread()
 {
     while (! thread->threadShouldExit())
     {
+        const bool batching = batchingEnabled;
+
         if (socket != nullptr)
         {
-            auto ready = socket->waitUntilReady (true, 100);
+            // The wait doubles as the coalescing window when batching, so
+            // queued output never sits for longer than the configured delay
+            auto ready = socket->waitUntilReady (true, batching ? jlimit (1, 100, maxBatchDelayMs.load()) : 100);
 
             if (ready < 0)
             {
@@ -401,6 +504,9 @@ void InterprocessConnection::runThread()
                 break;
             }
 
+            if (batching)
+                flushOutgoingMessages();
+
             if (ready == 0)
             {
                 thread->wait (1);
@@ -421,7 +527,25 @@ void InterprocessConnection::runThread()
             break;
         }
 
-        if (thread->threadShouldExit() || ! readNextMessage())
+        if (thread->threadShouldExit())
+            break;
+
+        auto ok = readNextMessage();
+
+        if (batching)
+        {
+            // Drain whatever else has already arrived before handing the
+            // whole group to the message thread in one go
+            if (socket != nullptr)
+                for (int numRead = 1; ok && numRead < maxMessagesPerBatch
+                                       && ! thread->threadShouldExit()
+                                       && socket->waitUntilReady (true, 0) == 1; ++numRead)
+                    ok = readNextMessage();
+
+            deliverBatchedIncomingMessages();
+        }
+
+        if (! ok)
             break;
     }
 
@@ -0,0 +1,313 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace
+{
+    enum
+    {
+        sharedRingBufferMagic = 0x6a726e67,
+        frameHeaderBytes = 4
+    };
+
+    // marks a frame header at the end of the ring whose frame has been
+    // wrapped round to the start:
+    constexpr uint32 wrapAroundMarker = 0xffffffff;
+
+    constexpr size_t roundUpToMultipleOfFour (size_t n) noexcept    { return (n + 3) & ~(size_t) 3; }
+
+    /*  This sits at the start of the mapped region. The read and write
+        positions are kept on separate cache lines so that the two processes
+        don't false-share them.
+    */
+    struct SharedRegionHeader
+    {
+        uint32 magic;
+        uint32 capacity;
+        char pad1[56];
+        std::atomic<uint32> writePos;
+        char pad2[60];
+        std::atomic<uint32> readPos;
+        char pad3[60];
+    };
+
+    static_assert (sizeof (SharedRegionHeader) == 192,
+                   "The region header must keep its positions on separate cache lines");
+
+    SharedRegionHeader& getRegionHeader (MemoryMappedFile& region) noexcept
+    {
+        return *static_cast<SharedRegionHeader*> (region.getData());
+    }
+
+    uint8* getRingBase (MemoryMappedFile& region) noexcept
+    {
+        return static_cast<uint8*> (region.getData()) + sizeof (SharedRegionHeader);
+    }
+
+    File getBackingFileForName (const String& name)
+    {
+        return File::getSpecialLocation (File::tempDirectory)
+                    .getChildFile ("juce_shm_" + File::createLegalFileName (name));
+    }
+}
+
+//==============================================================================
+SharedMemoryRingBuffer::SharedMemoryRingBuffer() = default;
+
+SharedMemoryRingBuffer::~SharedMemoryRingBuffer()
+{
+    close();
+}
+
+bool SharedMemoryRingBuffer::mapRegion (bool createNew, size_t capacityBytes)
+{
+    if (createNew)
+    {
+        backingFile.deleteFile();
+
+        const auto totalSize = sizeof (SharedRegionHeader) + capacityBytes;
+
+        {
+            FileOutputStream out (backingFile);
+
+            if (out.failedToOpen() || ! out.writeRepeatedByte (0, totalSize))
+                return false;
+
+            out.flush();
+        }
+    }
+    else if (! backingFile.existsAsFile())
+    {
+        return false;
+    }
+
+    mappedRegion.reset (new MemoryMappedFile (backingFile, MemoryMappedFile::readWrite));
+
+    if (mappedRegion->getData() == nullptr
+         || mappedRegion->getSize() < sizeof (SharedRegionHeader))
+    {
+        mappedRegion.reset();
+        return false;
+    }
+
+    auto& header = getRegionHeader (*mappedRegion);
+
+    if (createNew)
+    {
+        header.capacity = (uint32) capacityBytes;
+        new (&header.writePos) std::atomic<uint32> (0);
+        new (&header.readPos)  std::atomic<uint32> (0);
+        header.magic = sharedRingBufferMagic;
+    }
+    else if (header.magic != (uint32) sharedRingBufferMagic
+              || mappedRegion->getSize() < sizeof (SharedRegionHeader) + header.capacity)
+    {
+        mappedRegion.reset();
+        return false;
+    }
+
+    return true;
+}
+
+bool SharedMemoryRingBuffer::createNewBuffer (const String& name, size_t capacityBytes)
+{
+    close();
+    jassert (name.isNotEmpty() && capacityBytes > 0);
+
+    backingFile = getBackingFileForName (name);
+
+    // Each frame needs contiguous space, so when one wraps round to the start
+    // of the ring it may leave up to a frame's worth of the tail unused. The
+    // ring is made twice the largest frame size so that an empty ring can
+    // always accept a frame of the requested size, wherever its positions are.
+    if (mapRegion (true, 2 * (roundUpToMultipleOfFour (capacityBytes) + frameHeaderBytes)))
+    {
+        deleteFileOnClose = true;
+        return true;
+    }
+
+    backingFile.deleteFile();
+    backingFile = File();
+    return false;
+}
+
+bool SharedMemoryRingBuffer::openExisting (const String& name)
+{
+    close();
+    backingFile = getBackingFileForName (name);
+
+    if (mapRegion (false, 0))
+        return true;
+
+    backingFile = File();
+    return false;
+}
+
+void SharedMemoryRingBuffer::close()
+{
+    mappedRegion.reset();
+
+    if (deleteFileOnClose)
+    {
+        backingFile.deleteFile();
+        deleteFileOnClose = false;
+    }
+
+    backingFile = File();
+    pendingWriteOffset = pendingWriteLimit = pendingReadEnd = 0;
+}
+
+//==============================================================================
+size_t SharedMemoryRingBuffer::getCapacity() const noexcept
+{
+    return mappedRegion != nullptr ? getRegionHeader (*mappedRegion).capacity : 0;
+}
+
+size_t SharedMemoryRingBuffer::getFreeSpace() const noexcept
+{
+    if (mappedRegion == nullptr)
+        return 0;
+
+    auto& header = getRegionHeader (*mappedRegion);
+    const size_t capacity = header.capacity;
+    const size_t w = header.writePos.load (std::memory_order_relaxed);
+    const size_t r = header.readPos.load (std::memory_order_acquire);
+
+    return (r + capacity - w - frameHeaderBytes) % capacity;
+}
+
+//==============================================================================
+void* SharedMemoryRingBuffer::startWrite (size_t maxNumBytes) noexcept
+{
+    if (mappedRegion == nullptr)
+        return nullptr;
+
+    auto& header = getRegionHeader (*mappedRegion);
+    auto* ring = getRingBase (*mappedRegion);
+
+    const size_t capacity = header.capacity;
+    const size_t w = header.writePos.load (std::memory_order_relaxed);
+    const size_t r = header.readPos.load (std::memory_order_acquire);
+    const size_t freeSpace = (r + capacity - w - frameHeaderBytes) % capacity;
+    const size_t bytesNeeded = frameHeaderBytes + roundUpToMultipleOfFour (maxNumBytes);
+
+    if (capacity - w >= bytesNeeded)
+    {
+        if (freeSpace < bytesNeeded)
+            return nullptr;
+
+        pendingWriteOffset = w;
+    }
+    else
+    {
+        // the frame won't fit before the end of the ring, so mark the tail as
+        // skipped and wrap the frame round to the start:
+        if (freeSpace < (capacity - w) + bytesNeeded)
+            return nullptr;
+
+        *reinterpret_cast<uint32*> (ring + w) = wrapAroundMarker;
+        pendingWriteOffset = 0;
+    }
+
+    pendingWriteLimit = maxNumBytes;
+    return ring + pendingWriteOffset + frameHeaderBytes;
+}
+
+void SharedMemoryRingBuffer::finishWrite (size_t numBytesWritten) noexcept
+{
+    if (mappedRegion == nullptr)
+        return;
+
+    // can't publish more than was reserved by startWrite()!
+    jassert (numBytesWritten <= pendingWriteLimit);
+
+    auto& header = getRegionHeader (*mappedRegion);
+    auto* ring = getRingBase (*mappedRegion);
+
+    *reinterpret_cast<uint32*> (ring + pendingWriteOffset) = (uint32) numBytesWritten;
+
+    const auto next = (pendingWriteOffset + frameHeaderBytes
+                        + roundUpToMultipleOfFour (numBytesWritten)) % (size_t) header.capacity;
+    header.writePos.store ((uint32) next, std::memory_order_release);
+}
+
+bool SharedMemoryRingBuffer::write (const void* sourceData, size_t numBytes) noexcept
+{
+    if (auto* dest = startWrite (numBytes))
+    {
+        memcpy (dest, sourceData, numBytes);
+        finishWrite (numBytes);
+        return true;
+    }
+
+    return false;
+}
+
+//==============================================================================
+const void* SharedMemoryRingBuffer::startRead (size_t& numBytesAvailable) noexcept
+{
+    numBytesAvailable = 0;
+
+    if (mappedRegion == nullptr)
+        return nullptr;
+
+    auto& header = getRegionHeader (*mappedRegion);
+    auto* ring = getRingBase (*mappedRegion);
+
+    size_t r = header.readPos.load (std::memory_order_relaxed);
+    const size_t w = header.writePos.load (std::memory_order_acquire);
+
+    if (r == w)
+        return nullptr;
+
+    if (*reinterpret_cast<const uint32*> (ring + r) == wrapAroundMarker)
+        r = 0;
+
+    const size_t frameSize = *reinterpret_cast<const uint32*> (ring + r);
+
+    numBytesAvailable = frameSize;
+    pendingReadEnd = (r + frameHeaderBytes + roundUpToMultipleOfFour (frameSize)) % (size_t) header.capacity;
+    return ring + r + frameHeaderBytes;
+}
+
+void SharedMemoryRingBuffer::finishRead() noexcept
+{
+    if (mappedRegion != nullptr)
+        getRegionHeader (*mappedRegion).readPos.store ((uint32) pendingReadEnd, std::memory_order_release);
+}
+
+size_t SharedMemoryRingBuffer::read (MemoryBlock& destData)
+{
+    size_t numBytes = 0;
+
+    if (auto* source = startRead (numBytes))
+    {
+        destData.replaceWith (source, numBytes);
+        finishRead();
+    }
+
+    return numBytes;
+}
+
+} // namespace juce
@@ -0,0 +1,162 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A lock-free, single-producer single-consumer ring buffer held in a region
+    of memory that is shared between two processes.
+
+    Unlike a NamedPipe, which copies every message through the kernel, this
+    class frames variable-sized chunks of data inside a memory-mapped region,
+    so large payloads such as blocks of audio samples can be handed from one
+    process to another without being copied at all: the producer writes its
+    data straight into the shared pages with startWrite()/finishWrite(), and
+    the consumer reads it in place with startRead()/finishRead(). The pointers
+    returned by those methods can be used directly - for example by pointing
+    an AudioBuffer at a frame of sample data using its external-data
+    constructor - for true zero-copy transfers.
+
+    Each buffer is strictly one-directional: exactly one process may write to
+    it and exactly one other process may read from it. For two-way traffic,
+    create a pair of buffers, one for each direction.
+
+    One process creates the buffer with createNewBuffer(), and the other
+    attaches to it by passing the same name to openExisting(). The process
+    that created the buffer removes the backing storage when it closes it.
+
+    @see ChildProcessCoordinator::createSharedMemoryTransport, NamedPipe
+
+    @tags{Events}
+*/
+class JUCE_API  SharedMemoryRingBuffer
+{
+public:
+    //==============================================================================
+    /** Creates an unopened buffer.
+        Use createNewBuffer() or openExisting() to open it.
+    */
+    SharedMemoryRingBuffer();
+
+    /** Destructor. */
+    ~SharedMemoryRingBuffer();
+
+    //==============================================================================
+    /** Creates a new shared memory region holding a ring buffer, which another
+        process can attach to by calling openExisting() with the same name.
+
+        capacityBytes is the size of the largest single frame that the ring
+        guarantees to accept whenever it is empty - the mapped region is made
+        somewhat larger than this, to leave room for the framing and for the
+        wasted stretch that a frame wrapping round the end of the ring can
+        leave behind. To queue up several frames at once, ask for a capacity
+        of several times your frame size.
+
+        The name should be a short alphanumeric identifier (no spaces!), and
+        needs to be unique on the machine. Returns false if the region can't
+        be created and mapped.
+    */
+    bool createNewBuffer (const String& name, size_t capacityBytes);
+
+    /** Attaches to a shared memory region that another process has already set
+        up with createNewBuffer(), returning false if it doesn't exist or
+        doesn't contain a valid ring buffer.
+    */
+    bool openExisting (const String& name);
+
+    /** Unmaps the shared region.
+        If this side created the buffer, the backing storage is removed.
+    */
+    void close();
+
+    /** Returns true if the buffer has been successfully created or opened. */
+    bool isOpen() const noexcept                { return mappedRegion != nullptr; }
+
+    /** Returns the size in bytes of the ring's data area. */
+    size_t getCapacity() const noexcept;
+
+    /** Returns the approximate number of bytes currently free in the ring.
+
+        Only the writing process should call this. A few bytes of each frame
+        are used for framing, so slightly less than the returned amount can
+        actually be written.
+    */
+    size_t getFreeSpace() const noexcept;
+
+    //==============================================================================
+    /** Begins writing a frame of up to maxNumBytes bytes, returning a pointer
+        into the shared region for the caller to fill in, or nullptr if there's
+        not enough free space in the ring.
+
+        The returned pointer is 4-byte aligned. Each successful call must be
+        paired with a call to finishWrite() before the next startWrite().
+    */
+    void* startWrite (size_t maxNumBytes) noexcept;
+
+    /** Publishes the frame begun by the last startWrite(), making its first
+        numBytesWritten bytes visible to the reading process.
+
+        numBytesWritten must not exceed the size passed to startWrite().
+    */
+    void finishWrite (size_t numBytesWritten) noexcept;
+
+    /** Copies a block of data into the ring as a single frame.
+        Returns false if there wasn't enough free space.
+    */
+    bool write (const void* sourceData, size_t numBytes) noexcept;
+
+    //==============================================================================
+    /** Begins reading the oldest unread frame, returning a pointer to its data
+        inside the shared region and setting numBytesAvailable to its size, or
+        returning nullptr if the ring is empty.
+
+        The frame remains valid until finishRead() is called, so it can be
+        consumed in place. Each successful call must be paired with a call to
+        finishRead() before the next startRead().
+    */
+    const void* startRead (size_t& numBytesAvailable) noexcept;
+
+    /** Releases the frame returned by the last startRead(), making its space
+        available to the writing process again.
+    */
+    void finishRead() noexcept;
+
+    /** Copies the next frame out of the ring into a MemoryBlock, resizing it
+        to fit, and returns the frame size, or 0 if the ring is empty.
+    */
+    size_t read (MemoryBlock& destData);
+
+private:
+    //==============================================================================
+    File backingFile;
+    std::unique_ptr<MemoryMappedFile> mappedRegion;
+    bool deleteFileOnClose = false;
+    size_t pendingWriteOffset = 0, pendingWriteLimit = 0, pendingReadEnd = 0;
+
+    bool mapRegion (bool createNew, size_t capacityBytes);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedMemoryRingBuffer)
+};
+
+} // namespace juce
@@ -58,13 +58,18 @@
 #include "messages/juce_DeletedAtShutdown.cpp"
 #include "messages/juce_MessageListener.cpp"
 #include "messages/juce_MessageManager.cpp"
+#include "messages/juce_TaskGraph.cpp"
 #include "broadcasters/juce_ActionBroadcaster.cpp"
 #include "broadcasters/juce_AsyncUpdater.cpp"
+#include "broadcasters/juce_BatchedAsyncUpdater.cpp"
 #include "broadcasters/juce_ChangeBroadcaster.cpp"
+#include "broadcasters/juce_RealtimeChangeBroadcaster.cpp"
 #include "timers/juce_MultiTimer.cpp"
 #include "timers/juce_Timer.cpp"
+#include "timers/juce_IdleWorkScheduler.cpp"
 #include "interprocess/juce_InterprocessConnection.cpp"
 #include "interprocess/juce_InterprocessConnectionServer.cpp"
+#include "interprocess/juce_SharedMemoryRingBuffer.cpp"
 #include "interprocess/juce_ConnectedChildProcess.cpp"
 #include "interprocess/juce_NetworkServiceDiscovery.cpp"
 #include "native/juce_ScopedLowPowerModeDisabler.cpp"
@@ -76,18 +76,23 @@
 #include "messages/juce_CallbackMessage.h"
 #include "messages/juce_DeletedAtShutdown.h"
 #include "messages/juce_NotificationType.h"
+#include "messages/juce_TaskGraph.h"
 #include "messages/juce_ApplicationBase.h"
 #include "messages/juce_Initialisation.h"
 #include "messages/juce_MountedVolumeListChangeDetector.h"
 #include "broadcasters/juce_ActionBroadcaster.h"
 #include "broadcasters/juce_ActionListener.h"
 #include "broadcasters/juce_AsyncUpdater.h"
+#include "broadcasters/juce_BatchedAsyncUpdater.h"
 #include "broadcasters/juce_ChangeListener.h"
 #include "broadcasters/juce_ChangeBroadcaster.h"
+#include "broadcasters/juce_RealtimeChangeBroadcaster.h"
 #include "timers/juce_Timer.h"
 #include "timers/juce_MultiTimer.h"
+#include "timers/juce_IdleWorkScheduler.h"
 #include "interprocess/juce_InterprocessConnection.h"
 #include "interprocess/juce_InterprocessConnectionServer.h"
+#include "interprocess/juce_SharedMemoryRingBuffer.h"
 #include "interprocess/juce_ConnectedChildProcess.h"
 #include "interprocess/juce_NetworkServiceDiscovery.h"
 #include "native/juce_ScopedLowPowerModeDisabler.h"
@@ -187,13 +187,13 @@ void* MessageManager::callFunctionOnMessageThread (MessageCallbackFunction* func
     return nullptr;
 }
 
-bool MessageManager::callAsync (std::function<void()> fn)
+bool MessageManager::callAsync (MoveOnlyFunction<void()> fn)
 {
     struct AsyncCallInvoker  : public MessageBase
     {
-        AsyncCallInvoker (std::function<void()> f) : callback (std::move (f)) {}
+        AsyncCallInvoker (MoveOnlyFunction<void()> f) : callback (std::move (f)) {}
         void messageCallback() override  { callback(); }
-        std::function<void()> callback;
+        MoveOnlyFunction<void()> callback;
     };
 
     return (new AsyncCallInvoker (std::move (fn)))->post();
@@ -91,10 +91,13 @@ public:
     //==============================================================================
     /** Asynchronously invokes a function or C++11 lambda on the message thread.
 
+        Lambdas whose captures fit into the MoveOnlyFunction's inline buffer are
+        posted without allocating any std::function state on the heap.
+
         @returns  true if the message was successfully posted to the message queue,
                   or false otherwise.
     */
-    static bool callAsync (std::function<void()> functionToCall);
+    static bool callAsync (MoveOnlyFunction<void()> functionToCall);
 
     /** Calls a function using the message-thread.
 
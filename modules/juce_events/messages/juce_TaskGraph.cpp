@@ -0,0 +1,156 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+TaskGraph::TaskGraph (ThreadPool* poolToUse)  : externalPool (poolToUse)
+{
+}
+
+TaskGraph::~TaskGraph()
+{
+    waitForCompletion();
+}
+
+void TaskGraph::onCompletion (std::function<void()> callback)
+{
+    jassert (! started);
+    completionCallback = std::move (callback);
+}
+
+void TaskGraph::registerDependency (int dependency, int dependent)
+{
+    // Dependencies must be tasks that were added to this graph earlier, which
+    // is also what makes cycles impossible.
+    jassert (isPositiveAndBelow (dependency, dependent));
+
+    nodes.getUnchecked (dependency)->dependents.add (dependent);
+    ++nodes.getUnchecked (dependent)->numUnfinishedDependencies;
+}
+
+//==============================================================================
+void TaskGraph::start()
+{
+    jassert (! started);
+    started = true;
+
+    numUnfinishedTasks = nodes.size();
+
+    if (nodes.isEmpty())
+    {
+        allTasksDone.signal();
+
+        if (completionCallback != nullptr)
+            MessageManager::callAsync (std::function<void()> (completionCallback));
+
+        return;
+    }
+
+    // Make sure any pools that will be needed exist before tasks start
+    // dispatching their dependents from other threads.
+    for (auto* node : nodes)
+    {
+        if (node->executor == Executor::threadPool)
+            getPool();
+        else if (node->executor == Executor::ioThread)
+            getIOThread();
+    }
+
+    for (int i = 0; i < nodes.size(); ++i)
+        if (nodes.getUnchecked (i)->numUnfinishedDependencies == 0)
+            dispatch (i);
+}
+
+void TaskGraph::dispatch (int index)
+{
+    switch (nodes.getUnchecked (index)->executor)
+    {
+        case Executor::messageThread:
+            MessageManager::callAsync ([this, index] { runTask (index); });
+            break;
+
+        case Executor::threadPool:
+            getPool().addJob ([this, index] { runTask (index); });
+            break;
+
+        case Executor::ioThread:
+            getIOThread().addJob ([this, index] { runTask (index); });
+            break;
+    }
+}
+
+void TaskGraph::runTask (int index)
+{
+    auto& node = *nodes.getUnchecked (index);
+    node.run();
+
+    for (auto dependent : node.dependents)
+        if (--nodes.getUnchecked (dependent)->numUnfinishedDependencies == 0)
+            dispatch (dependent);
+
+    if (--numUnfinishedTasks == 0)
+    {
+        // Take a copy so that the callback survives the graph being destroyed
+        // from inside waitForCompletion() before the message arrives.
+        if (completionCallback != nullptr)
+            MessageManager::callAsync (std::function<void()> (completionCallback));
+
+        allTasksDone.signal();
+    }
+}
+
+//==============================================================================
+ThreadPool& TaskGraph::getPool()
+{
+    if (externalPool != nullptr)
+        return *externalPool;
+
+    if (ownedPool == nullptr)
+        ownedPool = std::make_unique<ThreadPool>();
+
+    return *ownedPool;
+}
+
+ThreadPool& TaskGraph::getIOThread()
+{
+    if (ioThread == nullptr)
+        ioThread = std::make_unique<ThreadPool> (1);
+
+    return *ioThread;
+}
+
+//==============================================================================
+bool TaskGraph::isRunning() const noexcept
+{
+    return started && numUnfinishedTasks > 0;
+}
+
+bool TaskGraph::waitForCompletion (int timeOutMilliseconds) const
+{
+    if (! started || nodes.isEmpty())
+        return true;
+
+    return allTasksDone.wait (timeOutMilliseconds);
+}
+
+} // namespace juce
@@ -0,0 +1,249 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A graph of dependent tasks that run on a choice of executors, for expressing
+    multi-stage background work without nesting Thread::launch and
+    MessageManager::callAsync lambdas.
+
+    Each task declares which executor it should run on - the message thread, a
+    thread pool, or a dedicated serial I/O thread - and which previously-added
+    tasks it depends on. When the graph is started, tasks whose dependencies
+    have finished are dispatched immediately, so independent stages run
+    concurrently.
+
+    A task's return value is stored in the graph, and dependent tasks read it
+    through the TaskRef returned by addTask(), so values flow between stages
+    without any shared_ptr plumbing:
+
+    @code
+    TaskGraph graph;
+
+    auto file   = graph.addTask (TaskGraph::Executor::ioThread,
+                                 [] { return loadProjectFile(); });
+    auto parsed = graph.addTask (TaskGraph::Executor::threadPool,
+                                 [file] { return parse (file.get()); }, file);
+
+    graph.addTask (TaskGraph::Executor::messageThread,
+                   [parsed] { showEditor (parsed.get()); }, parsed);
+
+    graph.onCompletion ([] { projectLoadFinished(); });
+    graph.start();
+    @endcode
+
+    Because dependencies can only refer to tasks that have already been added,
+    a graph can never contain a cycle. A graph is single-shot: once started, no
+    more tasks can be added, and it can't be restarted.
+
+    The graph must stay alive until it has completed. Don't destroy one from
+    the message thread while it still has unfinished message-thread tasks, as
+    the destructor would have to wait for work that can no longer run.
+
+    @see MessageManager::callAsync, ThreadPool
+
+    @tags{Events}
+*/
+class JUCE_API  TaskGraph
+{
+public:
+    //==============================================================================
+    /** The threads that a task can be dispatched to. */
+    enum class Executor
+    {
+        messageThread,   /**< The task runs asynchronously on the message thread. */
+        threadPool,      /**< The task runs on the graph's thread pool, concurrently with other pool tasks. */
+        ioThread         /**< The task runs on a single dedicated thread, so I/O tasks are serialised. */
+    };
+
+    //==============================================================================
+    /** Creates an empty graph.
+
+        If a ThreadPool is given, tasks with Executor::threadPool run on it; the
+        pool must outlive the graph, and shouldn't be filled with long-running
+        jobs that could starve the graph. If no pool is given, the graph creates
+        its own when the first pool task is added.
+    */
+    explicit TaskGraph (ThreadPool* poolToUse = nullptr);
+
+    /** Destructor. Waits for any tasks that are still running. */
+    ~TaskGraph();
+
+    //==============================================================================
+    /** A lightweight, copyable reference to a task that has been added to a graph.
+
+        Capture these in downstream task functions and call get() to read the
+        result of a dependency. get() is only valid while the graph is alive,
+        and only after the referenced task has run - which the graph guarantees
+        for tasks that were declared as dependencies.
+    */
+    template <typename ResultType>
+    class TaskRef
+    {
+    public:
+        TaskRef() = default;
+
+        /** Returns the value that the referenced task produced. */
+        const ResultType& get() const
+        {
+            auto& node = static_cast<ResultNode<ResultType>&> (*graph->nodes.getUnchecked (index));
+
+            // Calling get() on a task that hasn't run yet means it wasn't
+            // declared as a dependency of the task that's asking for it.
+            jassert (node.result != nullptr);
+            return *node.result;
+        }
+
+    private:
+        friend class TaskGraph;
+        TaskRef (TaskGraph* g, int i)  : graph (g), index (i) {}
+
+        TaskGraph* graph = nullptr;
+        int index = -1;
+    };
+
+    //==============================================================================
+    /** Adds a task to the graph, returning a reference that dependent tasks can
+        use to read its result.
+
+        The function takes no arguments; to consume the results of dependencies,
+        capture their TaskRefs. Any number of dependencies can be passed after
+        the function - the task won't be dispatched until all of them have
+        finished. Tasks must be added before the graph is started.
+    */
+    template <typename FunctionType, typename... Deps>
+    auto addTask (Executor executor, FunctionType&& taskFunction, Deps... dependencies)
+    {
+        using ResultType = decltype (taskFunction());
+
+        jassert (! started);
+
+        auto* node = new TaskNodeImpl<typename std::decay<FunctionType>::type, ResultType>
+                            (std::forward<FunctionType> (taskFunction));
+        node->executor = executor;
+
+        auto index = nodes.size();
+        nodes.add (node);
+
+        auto ignore = { 0, (registerDependency (dependencies.index, index), 0)... };
+        ignoreUnused (ignore);
+
+        return TaskRef<ResultType> (this, index);
+    }
+
+    /** Gives the graph a function to call on the message thread once every task
+        has finished. Must be called before start().
+    */
+    void onCompletion (std::function<void()> callback);
+
+    //==============================================================================
+    /** Starts the graph, dispatching every task whose dependencies are already met. */
+    void start();
+
+    /** Returns true if the graph has been started and hasn't finished yet. */
+    bool isRunning() const noexcept;
+
+    /** Blocks until every task has finished, or the timeout expires.
+
+        Don't call this from the message thread if the graph contains
+        message-thread tasks that haven't run yet. Returns true if the graph
+        finished.
+    */
+    bool waitForCompletion (int timeOutMilliseconds = -1) const;
+
+private:
+    //==============================================================================
+    struct TaskNode
+    {
+        virtual ~TaskNode() = default;
+        virtual void run() = 0;
+
+        Executor executor = Executor::threadPool;
+        Array<int> dependents;
+        std::atomic<int> numUnfinishedDependencies { 0 };
+    };
+
+    template <typename ResultType>
+    struct ResultNode  : public TaskNode
+    {
+        std::unique_ptr<ResultType> result;
+    };
+
+    template <typename FunctionType, typename ResultType>
+    struct TaskNodeImpl  : public ResultNode<ResultType>
+    {
+        explicit TaskNodeImpl (FunctionType fn)  : taskFunction (std::move (fn)) {}
+        void run() override     { this->result.reset (new ResultType (taskFunction())); }
+
+        FunctionType taskFunction;
+    };
+
+    template <typename FunctionType>
+    struct TaskNodeImpl<FunctionType, void>  : public TaskNode
+    {
+        explicit TaskNodeImpl (FunctionType fn)  : taskFunction (std::move (fn)) {}
+        void run() override     { taskFunction(); }
+
+        FunctionType taskFunction;
+    };
+
+    //==============================================================================
+    void registerDependency (int dependency, int dependent);
+    void dispatch (int index);
+    void runTask (int index);
+    ThreadPool& getPool();
+    ThreadPool& getIOThread();
+
+    //==============================================================================
+    OwnedArray<TaskNode> nodes;
+    ThreadPool* externalPool;
+    std::unique_ptr<ThreadPool> ownedPool, ioThread;
+    std::function<void()> completionCallback;
+    std::atomic<int> numUnfinishedTasks { 0 };
+    mutable WaitableEvent allTasksDone { true };
+    bool started = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TaskGraph)
+};
+
+//==============================================================================
+/** References to tasks that don't return a value can still be used as
+    dependencies, but have no result to read.
+*/
+template <>
+class TaskGraph::TaskRef<void>
+{
+public:
+    TaskRef() = default;
+
+private:
+    friend class TaskGraph;
+    TaskRef (TaskGraph* g, int i)  : graph (g), index (i) {}
+
+    TaskGraph* graph = nullptr;
+    int index = -1;
+};
+
+} // namespace juce
@@ -33,17 +33,7 @@ public:
         jassertquiet (err == 0);
 
         LinuxEventLoop::registerFdCallback (getReadHandle(),
-                                            [this] (int fd)
-                                            {
-                                                while (auto msg = popNextMessage (fd))
-                                                {
-                                                    JUCE_TRY
-                                                    {
-                                                        msg->messageCallback();
-                                                    }
-                                                    JUCE_CATCH_EXCEPTION
-                                                }
-                                            });
+                                            [this] (int fd) { dispatchNextBatch (fd); });
     }
 
     ~InternalMessageQueue()
@@ -83,10 +73,46 @@ private:
     int msgpipe[2];
     int bytesInSocket = 0;
     static constexpr int maxBytesInSocketQueue = 128;
+    static constexpr int maxMessagesPerBatch = 64;
 
     int getWriteHandle() const noexcept  { return msgpipe[0]; }
     int getReadHandle() const noexcept   { return msgpipe[1]; }
 
+    void dispatchNextBatch (int fd)
+    {
+        // Dispatching a bounded batch per wake-up stops a flood of posted messages
+        // from monopolising the run loop - between batches, poll() gets a chance to
+        // service the other registered fds (input events, timers etc.), so heavy
+        // posting can't starve user interaction.
+        for (int i = 0; i < maxMessagesPerBatch; ++i)
+        {
+            auto msg = popNextMessage (fd);
+
+            if (msg == nullptr)
+                return;
+
+            JUCE_TRY
+            {
+                msg->messageCallback();
+            }
+            JUCE_CATCH_EXCEPTION
+        }
+
+        // There's still work queued: if the backlog has outrun the bytes in the
+        // socket, write another one so the run loop comes straight back to us.
+        const ScopedLock sl (lock);
+
+        if (! queue.isEmpty() && bytesInSocket < maxBytesInSocketQueue)
+        {
+            bytesInSocket++;
+
+            ScopedUnlock ul (lock);
+            unsigned char x = 0xff;
+            auto numBytes = write (getWriteHandle(), &x, 1);
+            ignoreUnused (numBytes);
+        }
+    }
+
     MessageManager::MessageBase::Ptr popNextMessage (int fd) noexcept
     {
         const ScopedLock sl (lock);
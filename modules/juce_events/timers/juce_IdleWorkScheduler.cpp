@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+IdleWorkScheduler::IdleWorkScheduler() {}
+
+IdleWorkScheduler::~IdleWorkScheduler()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    cancelPendingUpdate();
+}
+
+int IdleWorkScheduler::addJob (std::function<bool()> jobStep, int priority)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    jassert (jobStep != nullptr);
+
+    // keep the list sorted by descending priority, adding at the back of the
+    // group so that an old job isn't pushed behind a stream of new ones
+    int index = 0;
+
+    while (index < jobs.size() && jobs.getReference (index).priority >= priority)
+        ++index;
+
+    auto jobID = nextJobID++;
+    jobs.insert (index, { std::move (jobStep), priority, jobID });
+
+    if (jobs.size() == 1)
+    {
+        frameDeadline = 0;  // the frame clock is stale after an idle period
+        triggerAsyncUpdate();
+    }
+
+    return jobID;
+}
+
+void IdleWorkScheduler::removeJob (int jobID)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    for (int i = jobs.size(); --i >= 0;)
+        if (jobs.getReference (i).jobID == jobID)
+            jobs.remove (i);
+}
+
+int IdleWorkScheduler::getNumJobs() const noexcept
+{
+    return jobs.size();
+}
+
+void IdleWorkScheduler::setFrameRate (double framesPerSecond) noexcept
+{
+    jassert (framesPerSecond > 0);
+    frameIntervalMs = 1000.0 / framesPerSecond;
+}
+
+void IdleWorkScheduler::setFrameHeadroom (double milliseconds) noexcept
+{
+    jassert (milliseconds >= 0);
+    headroomMs = milliseconds;
+}
+
+void IdleWorkScheduler::serviceJobs()
+{
+    auto now = Time::getMillisecondCounterHiRes();
+
+    // if we're already past the previous deadline, this wake-up begins a new frame
+    if (now >= frameDeadline)
+        frameDeadline = now + frameIntervalMs;
+
+    const auto stopTime = frameDeadline - headroomMs;
+
+    while (! jobs.isEmpty() && Time::getMillisecondCounterHiRes() < stopTime)
+    {
+        // the front job has the highest priority; rotate it to the back of its
+        // priority group after each step so equal-priority jobs take turns
+        auto& job = jobs.getReference (0);
+        auto jobID = job.jobID;
+        auto hasMoreWork = job.step();
+
+        // the step may itself have added or removed jobs, so find it again
+        for (int i = 0; i < jobs.size(); ++i)
+        {
+            if (jobs.getReference (i).jobID == jobID)
+            {
+                if (! hasMoreWork)
+                {
+                    jobs.remove (i);
+                    break;
+                }
+
+                auto lastInGroup = i;
+
+                while (lastInGroup + 1 < jobs.size()
+                        && jobs.getReference (lastInGroup + 1).priority == jobs.getReference (i).priority)
+                    ++lastInGroup;
+
+                jobs.move (i, lastInGroup);
+                break;
+            }
+        }
+    }
+
+    if (! jobs.isEmpty())
+        scheduleNextWakeUp();
+}
+
+void IdleWorkScheduler::scheduleNextWakeUp()
+{
+    const auto now = Time::getMillisecondCounterHiRes();
+
+    if (now < frameDeadline - headroomMs)
+    {
+        // there's still headroom this frame, so requeue behind any events that
+        // arrived while we were working, rather than starving the UI
+        triggerAsyncUpdate();
+    }
+    else
+    {
+        // budget spent - sleep until the next frame starts instead of spinning
+        startTimer (jmax (1, roundToInt (frameDeadline - now)));
+    }
+}
+
+void IdleWorkScheduler::handleAsyncUpdate()
+{
+    serviceJobs();
+}
+
+void IdleWorkScheduler::timerCallback()
+{
+    stopTimer();
+    serviceJobs();
+}
+
+} // namespace juce
@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Runs incremental background jobs on the message thread, in the gaps between
+    event handling, without letting them overrun the frame budget.
+
+    The common alternative - chaining MessageManager::callAsync calls, doing a
+    chunk of work in each - gives you no control over how much work lands in
+    any one frame: a single oversized chunk blows the frame deadline and the UI
+    drops a frame. This scheduler instead runs many small steps per wake-up,
+    checking the clock against the current frame's deadline between steps, and
+    yields back to the event loop as soon as the remaining headroom drops below
+    a safety margin. If the budget for this frame is spent, it sleeps until the
+    next frame starts rather than spinning the event queue.
+
+    Jobs are incremental: each call to the job function should do one small
+    slice of work (aim for well under a millisecond) and return true if there's
+    more to do. Higher-priority jobs always run first; jobs of equal priority
+    take turns, so they all make progress.
+
+    @code
+    IdleWorkScheduler scheduler;
+
+    scheduler.addJob ([this]
+    {
+        renderNextWaveformTile();
+        return numTilesLeft > 0;
+    });
+    @endcode
+
+    The scheduler paces itself against its own frame clock, which you should
+    set to the display rate with setFrameRate() - it has no way of observing
+    the compositor's actual vertical blank. All methods must be called from
+    the message thread.
+
+    @see MessageManager::callAsync, TaskGraph, ThreadPool
+
+    @tags{Events}
+*/
+class JUCE_API  IdleWorkScheduler  : private Timer,
+                                     private AsyncUpdater
+{
+public:
+    //==============================================================================
+    /** Creates a scheduler with an empty job list. */
+    IdleWorkScheduler();
+
+    /** Destructor. Any jobs still registered are discarded. */
+    ~IdleWorkScheduler() override;
+
+    //==============================================================================
+    /** Adds an incremental job, returning an ID that can be passed to removeJob().
+
+        The function is called repeatedly on the message thread, once per work
+        slice, while the frame budget has headroom. It should return true to be
+        called again, or false when the job has finished, which removes it from
+        the scheduler.
+
+        Jobs with a higher priority value run ahead of lower-priority ones;
+        jobs sharing a priority are stepped round-robin.
+    */
+    int addJob (std::function<bool()> jobStep, int priority = 0);
+
+    /** Removes a job before it has finished. Does nothing if the ID isn't
+        registered, e.g. because the job already returned false.
+    */
+    void removeJob (int jobID);
+
+    /** Returns the number of jobs that haven't finished yet. */
+    int getNumJobs() const noexcept;
+
+    //==============================================================================
+    /** Sets the frame rate that the scheduler paces itself against.
+
+        This defaults to 60fps; set it to the refresh rate of the display the
+        UI is on. Work is scheduled so that each frame's deadline is met, so
+        overestimating the rate just makes the scheduler more conservative.
+    */
+    void setFrameRate (double framesPerSecond) noexcept;
+
+    /** Sets how much of each frame to leave free for event handling and
+        painting, in milliseconds.
+
+        No job step is started once the time left before the frame deadline
+        drops below this margin. The default is 3ms. Remember that the margin
+        also has to absorb the overrun of the last step started, so keep the
+        steps small rather than shrinking the margin.
+    */
+    void setFrameHeadroom (double milliseconds) noexcept;
+
+private:
+    //==============================================================================
+    struct Job
+    {
+        std::function<bool()> step;
+        int priority, jobID;
+    };
+
+    Array<Job> jobs;
+    int nextJobID = 1;
+    double frameIntervalMs = 1000.0 / 60.0;
+    double headroomMs = 3.0;
+    double frameDeadline = 0;
+
+    void serviceJobs();
+    void scheduleNextWakeUp();
+    void handleAsyncUpdate() override;
+    void timerCallback() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (IdleWorkScheduler)
+};
+
+} // namespace juce
@@ -23,6 +23,20 @@
 namespace juce
 {
 
+/*  The timers are stored in a hierarchical timer wheel: each level is a ring of
+    256 slots, with each slot holding an intrusive doubly-linked list of the
+    timers which are due to fire when the wheel's cursor reaches it. Slots on
+    level 0 are 1ms apart, on level 1 they're 256ms apart, and so on, which is
+    enough to cover the full 32-bit range of Time::getMillisecondCounter().
+    Scheduling, unscheduling and cascading a timer to a lower level are all O(1)
+    list operations, so the lock is only ever held for tiny amounts of time no
+    matter how many timers are running.
+
+    Starting a timer doesn't even need the lock: the timer is pushed onto a
+    lock-free stack of pending registrations which the timer thread folds into
+    the wheel before computing its next wake-up. Stopping still locks, because
+    stopTimer() guarantees that no callback will arrive after it returns.
+*/
 class Timer::TimerThread  : private Thread,
                             private DeletedAtShutdown,
                             private AsyncUpdater
@@ -32,7 +46,7 @@ public:
 
     TimerThread()  : Thread ("JUCE Timer")
     {
-        timers.reserve (32);
+        wheelTime = Time::getMillisecondCounter();
         triggerAsyncUpdate();
     }
 
@@ -46,21 +60,28 @@ public:
 
         if (instance == this)
             instance = nullptr;
+
+        // leave any remaining timers in a state where they can be safely
+        // restarted if a new TimerThread gets created later
+        const LockType::ScopedLockType sl (lock);
+        drainPendingTimers();
+
+        while (dueTimers != nullptr)
+            unlink (dueTimers);
+
+        for (auto& level : slots)
+            for (auto& slot : level)
+                while (slot != nullptr)
+                    unlink (slot);
     }
 
     void run() override
     {
-        auto lastTime = Time::getMillisecondCounter();
         ReferenceCountedObjectPtr<CallTimersMessage> messageToSend (new CallTimersMessage());
 
         while (! threadShouldExit())
         {
-            auto now = Time::getMillisecondCounter();
-            auto elapsed = (int) (now >= lastTime ? (now - lastTime)
-                                                  : (std::numeric_limits<uint32>::max() - (lastTime - now)));
-            lastTime = now;
-
-            auto timeUntilFirstTimer = getTimeUntilFirstTimer (elapsed);
+            auto timeUntilFirstTimer = getTimeUntilFirstTimer();
 
             if (timeUntilFirstTimer <= 0)
             {
@@ -95,17 +116,24 @@ public:
         auto timeout = Time::getMillisecondCounter() + 100;
 
         const LockType::ScopedLockType sl (lock);
+        drainPendingTimers();
+        advanceWheel (Time::getMillisecondCounter());
 
-        while (! timers.empty())
+        while (dueTimers != nullptr)
         {
-            auto& first = timers.front();
+            auto* timer = dueTimers;
+            unlink (timer);
 
-            if (first.countdownMs > 0)
-                break;
+            auto period = timer->timerPeriodMs.get();
+
+            // A cross-thread stopTimer() zeroes the period lock-free before it
+            // can take our lock to remove the timer, so a just-stopped timer can
+            // still be sitting on the wheel here. Skip it without rescheduling
+            // or invoking it - it's left unlinked for removeTimer() to finish off.
+            if (period <= 0)
+                continue;
 
-            auto* timer = first.timer;
-            first.countdownMs = timer->timerPeriodMs;
-            shuffleTimerBackInQueue (0);
+            scheduleTimer (timer, wheelTime + (uint32) period);
             notify();
 
             const LockType::ScopedUnlockType ul (lock);
@@ -137,12 +165,17 @@ public:
         callTimers();
     }
 
-    static void add (Timer* tim) noexcept
+    static void startOrReset (Timer* tim) noexcept
     {
         if (instance == nullptr)
-            instance = new TimerThread();
+        {
+            const LockType::ScopedLockType sl (lock);
 
-        instance->addTimer (tim);
+            if (instance == nullptr)
+                instance = new TimerThread();
+        }
+
+        instance->queueTimer (tim);
     }
 
     static void remove (Timer* tim) noexcept
@@ -151,23 +184,17 @@ public:
             instance->removeTimer (tim);
     }
 
-    static void resetCounter (Timer* tim) noexcept
-    {
-        if (instance != nullptr)
-            instance->resetTimerCounter (tim);
-    }
-
     static TimerThread* instance;
     static LockType lock;
 
 private:
-    struct TimerCountdown
-    {
-        Timer* timer;
-        int countdownMs;
-    };
+    enum { numLevels = 4, slotsPerLevel = 256 };
 
-    std::vector<TimerCountdown> timers;
+    Timer* slots[numLevels][slotsPerLevel] = {};
+    Timer* dueTimers = nullptr;
+    uint32 wheelTime = 0;
+    int numLiveTimers = 0;
+    Atomic<Timer*> pendingTimers { nullptr };
 
     WaitableEvent callbackArrived;
 
@@ -183,122 +210,198 @@ private:
     };
 
     //==============================================================================
-    void addTimer (Timer* t)
+    void linkFirst (Timer*& head, Timer* t) noexcept
     {
-        // Trying to add a timer that's already here - shouldn't get to this point,
-        // so if you get this assertion, let me know!
-        jassert (std::none_of (timers.begin(), timers.end(),
-                               [t] (TimerCountdown i) { return i.timer == t; }));
+        jassert (t->previousNextPtr == nullptr);
 
-        auto pos = timers.size();
+        t->nextTimer = head;
+        t->previousNextPtr = &head;
 
-        timers.push_back ({ t, t->timerPeriodMs });
-        t->positionInQueue = pos;
-        shuffleTimerForwardInQueue (pos);
-        notify();
+        if (head != nullptr)
+            head->previousNextPtr = &t->nextTimer;
+
+        head = t;
+        ++numLiveTimers;
     }
 
-    void removeTimer (Timer* t)
+    void unlink (Timer* t) noexcept
     {
-        auto pos = t->positionInQueue;
-        auto lastIndex = timers.size() - 1;
+        jassert (t->previousNextPtr != nullptr);
 
-        jassert (pos <= lastIndex);
-        jassert (timers[pos].timer == t);
+        *(t->previousNextPtr) = t->nextTimer;
 
-        for (auto i = pos; i < lastIndex; ++i)
+        if (t->nextTimer != nullptr)
+            t->nextTimer->previousNextPtr = t->previousNextPtr;
+
+        t->previousNextPtr = nullptr;
+        --numLiveTimers;
+    }
+
+    void scheduleTimer (Timer* t, uint32 triggerTime) noexcept
+    {
+        t->timerTriggerTime = triggerTime;
+        auto delta = triggerTime - wheelTime;
+
+        if (delta == 0 || delta > 0x80000000u)  // due now (or overdue, after a clock jump)
         {
-            timers[i] = timers[i + 1];
-            timers[i].timer->positionInQueue = i;
+            linkFirst (dueTimers, t);
+            return;
         }
 
-        timers.pop_back();
+        int level = delta < 0x100 ? 0 : delta < 0x10000 ? 1 : delta < 0x1000000 ? 2 : 3;
+        linkFirst (slots[level][(triggerTime >> (8 * level)) & 0xff], t);
     }
 
-    void resetTimerCounter (Timer* t) noexcept
+    void cascadeLevel (int level) noexcept
     {
-        auto pos = t->positionInQueue;
+        auto& head = slots[level][(wheelTime >> (8 * level)) & 0xff];
 
-        jassert (pos < timers.size());
-        jassert (timers[pos].timer == t);
+        while (head != nullptr)
+        {
+            auto* t = head;
+            unlink (t);
+            scheduleTimer (t, t->timerTriggerTime);
+        }
+    }
 
-        auto lastCountdown = timers[pos].countdownMs;
-        auto newCountdown = t->timerPeriodMs;
+    void advanceWheel (uint32 now) noexcept
+    {
+        // after a huge gap (machine sleep etc.) it's cheaper to rebuild the wheel
+        // than to step through every intervening millisecond
+        if (now - wheelTime > 0x10000)
+        {
+            rebuildWheel (now);
+            return;
+        }
 
-        if (newCountdown != lastCountdown)
+        while (wheelTime != now)
         {
-            timers[pos].countdownMs = newCountdown;
+            ++wheelTime;
 
-            if (newCountdown > lastCountdown)
-                shuffleTimerBackInQueue (pos);
-            else
-                shuffleTimerForwardInQueue (pos);
+            if ((wheelTime & 0xff) == 0)
+            {
+                if ((wheelTime & 0xffffff) == 0)
+                    cascadeLevel (3);
 
-            notify();
+                if ((wheelTime & 0xffff) == 0)
+                    cascadeLevel (2);
+
+                cascadeLevel (1);
+            }
+
+            auto& head = slots[0][wheelTime & 0xff];
+
+            while (head != nullptr)
+            {
+                auto* t = head;
+                unlink (t);
+                linkFirst (dueTimers, t);
+            }
         }
     }
 
-    void shuffleTimerBackInQueue (size_t pos)
+    void rebuildWheel (uint32 now) noexcept
     {
-        auto numTimers = timers.size();
+        Timer* gathered = nullptr;
 
-        if (pos < numTimers - 1)
+        for (auto& level : slots)
         {
-            auto t = timers[pos];
+            for (auto& slot : level)
+            {
+                while (slot != nullptr)
+                {
+                    auto* t = slot;
+                    unlink (t);
+                    linkFirst (gathered, t);
+                }
+            }
+        }
+
+        wheelTime = now;
 
+        while (gathered != nullptr)
+        {
+            auto* t = gathered;
+            unlink (t);
+            scheduleTimer (t, t->timerTriggerTime);
+        }
+    }
+
+    void queueTimer (Timer* t) noexcept
+    {
+        // push onto the pending stack unless the timer is already waiting in it,
+        // in which case the eventual drain will pick up the latest period anyway
+        if (t->timerQueueFlag.compareAndSetBool (1, 0))
+        {
             for (;;)
             {
-                auto next = pos + 1;
+                auto* head = pendingTimers.get();
+                t->nextQueuedTimer = head;
 
-                if (next == numTimers || timers[next].countdownMs >= t.countdownMs)
+                if (pendingTimers.compareAndSetBool (t, head))
                     break;
-
-                timers[pos] = timers[next];
-                timers[pos].timer->positionInQueue = pos;
-
-                ++pos;
             }
-
-            timers[pos] = t;
-            t.timer->positionInQueue = pos;
         }
+
+        notify();
     }
 
-    void shuffleTimerForwardInQueue (size_t pos)
+    void drainPendingTimers() noexcept
     {
-        if (pos > 0)
+        for (auto* t = pendingTimers.exchange (nullptr); t != nullptr;)
         {
-            auto t = timers[pos];
+            // the next pointer has to be read before clearing the flag, as the
+            // timer can be re-queued (and its link overwritten) the moment it's out
+            auto* next = t->nextQueuedTimer;
+            t->timerQueueFlag.set (0);
 
-            while (pos > 0)
-            {
-                auto& prev = timers[(size_t) pos - 1];
+            if (t->previousNextPtr != nullptr)
+                unlink (t);
 
-                if (prev.countdownMs <= t.countdownMs)
-                    break;
-
-                timers[pos] = prev;
-                timers[pos].timer->positionInQueue = pos;
+            auto period = t->timerPeriodMs.get();
 
-                --pos;
-            }
+            if (period > 0)
+                scheduleTimer (t, wheelTime + (uint32) period);
 
-            timers[pos] = t;
-            t.timer->positionInQueue = pos;
+            t = next;
         }
     }
 
-    int getTimeUntilFirstTimer (int numMillisecsElapsed)
+    void removeTimer (Timer* t) noexcept
+    {
+        const LockType::ScopedLockType sl (lock);
+
+        // if the timer is sitting in the pending stack, it has to be flushed out
+        // before it can be deleted - its period is already 0, so it won't be rescheduled
+        if (t->timerQueueFlag.get() != 0)
+            drainPendingTimers();
+
+        if (t->previousNextPtr != nullptr)
+            unlink (t);
+    }
+
+    int getTimeUntilFirstTimer()
     {
         const LockType::ScopedLockType sl (lock);
 
-        if (timers.empty())
+        drainPendingTimers();
+        advanceWheel (Time::getMillisecondCounter());
+
+        if (dueTimers != nullptr)
+            return 0;
+
+        if (numLiveTimers == 0)
             return 1000;
 
-        for (auto& t : timers)
-            t.countdownMs -= numMillisecsElapsed;
+        // nothing can fire before the next occupied level-0 slot, or the next
+        // 256ms boundary where the higher levels cascade down
+        auto boundary = (int) (0x100 - (wheelTime & 0xff));
+
+        for (int d = 1; d < 0x100; ++d)
+            if (slots[0][(wheelTime + (uint32) d) & 0xff] != nullptr)
+                return jmin (d, boundary);
 
-        return timers.front().countdownMs;
+        return boundary;
     }
 
     void handleAsyncUpdate() override
@@ -335,15 +438,8 @@ void Timer::startTimer (int interval) noexcept
     // running, then you're not going to get any timer callbacks!
     JUCE_ASSERT_MESSAGE_MANAGER_EXISTS
 
-    const TimerThread::LockType::ScopedLockType sl (TimerThread::lock);
-
-    bool wasStopped = (timerPeriodMs == 0);
-    timerPeriodMs = jmax (1, interval);
-
-    if (wasStopped)
-        TimerThread::add (this);
-    else
-        TimerThread::resetCounter (this);
+    timerPeriodMs.set (jmax (1, interval));
+    TimerThread::startOrReset (this);
 }
 
 void Timer::startTimerHz (int timerFrequencyHz) noexcept
@@ -356,13 +452,8 @@ void Timer::startTimerHz (int timerFrequencyHz) noexcept
 
 void Timer::stopTimer() noexcept
 {
-    const TimerThread::LockType::ScopedLockType sl (TimerThread::lock);
-
-    if (timerPeriodMs > 0)
-    {
+    if (timerPeriodMs.exchange (0) > 0)
         TimerThread::remove (this);
-        timerPeriodMs = 0;
-    }
 }
 
 void JUCE_CALLTYPE Timer::callPendingTimersSynchronously()
@@ -373,26 +464,26 @@ void JUCE_CALLTYPE Timer::callPendingTimersSynchronously()
 
 struct LambdaInvoker  : private Timer
 {
-    LambdaInvoker (int milliseconds, std::function<void()> f)  : function (f)
+    LambdaInvoker (int milliseconds, MoveOnlyFunction<void()> f)  : function (std::move (f))
     {
         startTimer (milliseconds);
     }
 
     void timerCallback() override
     {
-        auto f = function;
+        auto f = std::move (function);
         delete this;
         f();
     }
 
-    std::function<void()> function;
+    MoveOnlyFunction<void()> function;
 
     JUCE_DECLARE_NON_COPYABLE (LambdaInvoker)
 };
 
-void JUCE_CALLTYPE Timer::callAfterDelay (int milliseconds, std::function<void()> f)
+void JUCE_CALLTYPE Timer::callAfterDelay (int milliseconds, MoveOnlyFunction<void()> f)
 {
-    new LambdaInvoker (milliseconds, f);
+    new LambdaInvoker (milliseconds, std::move (f));
 }
 
 } // namespace juce
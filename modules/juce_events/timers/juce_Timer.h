@@ -108,16 +108,16 @@ public:
 
     //==============================================================================
     /** Returns true if the timer is currently running. */
-    bool isTimerRunning() const noexcept                    { return timerPeriodMs > 0; }
+    bool isTimerRunning() const noexcept                    { return timerPeriodMs.get() > 0; }
 
     /** Returns the timer's interval.
         @returns the timer's interval in milliseconds if it's running, or 0 if it's not.
     */
-    int getTimerInterval() const noexcept                   { return timerPeriodMs; }
+    int getTimerInterval() const noexcept                   { return timerPeriodMs.get(); }
 
     //==============================================================================
     /** Invokes a lambda after a given number of milliseconds. */
-    static void JUCE_CALLTYPE callAfterDelay (int milliseconds, std::function<void()> functionToCall);
+    static void JUCE_CALLTYPE callAfterDelay (int milliseconds, MoveOnlyFunction<void()> functionToCall);
 
     //==============================================================================
     /** For internal use only: invokes any timers that need callbacks.
@@ -128,8 +128,13 @@ public:
 private:
     class TimerThread;
     friend class TimerThread;
-    size_t positionInQueue = (size_t) -1;
-    int timerPeriodMs = 0;
+
+    Timer* nextTimer = nullptr;          // intrusive links for the timer-wheel slot lists
+    Timer** previousNextPtr = nullptr;
+    Timer* nextQueuedTimer = nullptr;    // link for the lock-free registration stack
+    Atomic<int> timerQueueFlag { 0 };
+    uint32 timerTriggerTime = 0;
+    Atomic<int> timerPeriodMs { 0 };
 
     Timer& operator= (const Timer&) = delete;
 };
@@ -23,6 +23,16 @@
   ==============================================================================
 */
 
+#if ! JUCE_ANDROID
+ #if JUCE_INTEL && (defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+  #define JUCE_COLOURGRADIENT_USE_SSE 1
+  #include <emmintrin.h>
+ #elif JUCE_ARM && (defined (__ARM_NEON__) || defined (__ARM_NEON))
+  #define JUCE_COLOURGRADIENT_USE_NEON 1
+  #include <arm_neon.h>
+ #endif
+#endif
+
 namespace juce
 {
 
@@ -104,6 +114,41 @@ bool ColourGradient::operator!= (const ColourGradient& other) const noexcept
     return ! operator== (other);
 }
 
+static uint64 colourGradientBitPattern (float value) noexcept
+{
+    uint32 result = 0;
+    memcpy (&result, &value, sizeof (result));
+    return result;
+}
+
+static uint64 colourGradientBitPattern (double value) noexcept
+{
+    uint64 result = 0;
+    memcpy (&result, &value, sizeof (result));
+    return result;
+}
+
+int64 ColourGradient::getHashCode() const noexcept
+{
+    // unsigned arithmetic, as the multiplications are meant to wrap
+    auto hash = isRadial ? 0x79e1c2a35d40b4a3ULL : 0x53a2b8f19c6e8d51ULL;
+
+    auto combine = [&hash] (uint64 n) noexcept  { hash = hash * 0x100000001b3ULL + n; };
+
+    combine (colourGradientBitPattern (point1.x));
+    combine (colourGradientBitPattern (point1.y));
+    combine (colourGradientBitPattern (point2.x));
+    combine (colourGradientBitPattern (point2.y));
+
+    for (auto& c : colours)
+    {
+        combine (colourGradientBitPattern (c.position));
+        combine (c.colour.getARGB());
+    }
+
+    return (int64) hash;
+}
+
 //==============================================================================
 void ColourGradient::clearColours()
 {
@@ -193,6 +238,153 @@ Colour ColourGradient::getColourAtPosition (double position) const noexcept
     return p1.colour.interpolatedWith (p2.colour, (float) ((position - p1.position) / (p2.position - p1.position)));
 }
 
+//==============================================================================
+/*  Gradient fills regenerate their lookup table on every paint, and things like
+    component backgrounds repeat the same gradient frame after frame, so the most
+    recently generated tables are kept here and re-used with a single memcpy.
+*/
+class GradientLookupTableCache
+{
+public:
+    static GradientLookupTableCache& getInstance()
+    {
+        static GradientLookupTableCache cache;
+        return cache;
+    }
+
+    bool copyTable (int64 hash, int numEntries, PixelARGB* dest)
+    {
+        const ScopedLock sl (lock);
+
+        for (auto* e : entries)
+        {
+            if (e->hash == hash && e->numEntries == numEntries)
+            {
+                e->lastUsed = ++counter;
+                memcpy (dest, e->table, (size_t) numEntries * sizeof (PixelARGB));
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void storeTable (int64 hash, int numEntries, const PixelARGB* data)
+    {
+        auto entry = std::make_unique<Entry>();
+        entry->hash = hash;
+        entry->numEntries = numEntries;
+        entry->table.malloc (numEntries);
+        memcpy (entry->table, data, (size_t) numEntries * sizeof (PixelARGB));
+
+        const ScopedLock sl (lock);
+        entry->lastUsed = ++counter;
+
+        if (entries.size() >= maxNumTables)
+        {
+            int oldest = 0;
+
+            for (int i = 1; i < entries.size(); ++i)
+                if (entries.getUnchecked (i)->lastUsed < entries.getUnchecked (oldest)->lastUsed)
+                    oldest = i;
+
+            entries.remove (oldest);
+        }
+
+        entries.add (entry.release());
+    }
+
+private:
+    GradientLookupTableCache() = default;
+
+    enum { maxNumTables = 32 };
+
+    struct Entry
+    {
+        int64 hash;
+        int numEntries;
+        uint32 lastUsed;
+        HeapBlock<PixelARGB> table;
+    };
+
+    CriticalSection lock;
+    OwnedArray<Entry> entries;
+    uint32 counter = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (GradientLookupTableCache)
+};
+
+//==============================================================================
+#if JUCE_COLOURGRADIENT_USE_SSE
+
+/*  Fills a run of table entries interpolating from pix1 towards pix2, two pixels
+    per iteration. Each 16-bit lane computes c1 + (((c2 - c1) * amount) >> 8),
+    which is bit-for-bit what PixelARGB::tween produces per component, so the
+    scalar tail and a non-vectorized build give identical tables.
+*/
+static forcedinline void fillGradientSpan (PixelARGB* dest, PixelARGB pix1, PixelARGB pix2, int numToDo) noexcept
+{
+    auto d8   = _mm_cvtsi32_si128 ((int) pix1.getNativeARGB());
+    auto s8   = _mm_cvtsi32_si128 ((int) pix2.getNativeARGB());
+    auto zero = _mm_setzero_si128();
+    auto d16  = _mm_unpacklo_epi8 (_mm_unpacklo_epi32 (d8, d8), zero);
+    auto diff = _mm_sub_epi16 (_mm_unpacklo_epi8 (_mm_unpacklo_epi32 (s8, s8), zero), d16);
+
+    int i = 0;
+
+    for (; i + 2 <= numToDo; i += 2)
+    {
+        auto amt0 = (short) ((i << 8) / numToDo);
+        auto amt1 = (short) (((i + 1) << 8) / numToDo);
+        auto amt  = _mm_set_epi16 (amt1, amt1, amt1, amt1, amt0, amt0, amt0, amt0);
+
+        // the full 32-bit product is reassembled from its two halves, as
+        // (diff * amount) doesn't fit into a signed 16-bit lane
+        auto lo = _mm_mullo_epi16 (diff, amt);
+        auto hi = _mm_mulhi_epi16 (diff, amt);
+        auto t  = _mm_or_si128 (_mm_srli_epi16 (lo, 8), _mm_slli_epi16 (hi, 8));
+
+        _mm_storel_epi64 (reinterpret_cast<__m128i*> (dest + i),
+                          _mm_packus_epi16 (_mm_add_epi16 (d16, t), zero));
+    }
+
+    for (; i < numToDo; ++i)
+    {
+        dest[i] = pix1;
+        dest[i].tween (pix2, (uint32) ((i << 8) / numToDo));
+    }
+}
+
+#elif JUCE_COLOURGRADIENT_USE_NEON
+
+static forcedinline void fillGradientSpan (PixelARGB* dest, PixelARGB pix1, PixelARGB pix2, int numToDo) noexcept
+{
+    auto d16   = vget_low_s16 (vreinterpretq_s16_u16 (vmovl_u8 (vreinterpret_u8_u32 (vdup_n_u32 (pix1.getNativeARGB())))));
+    auto s16   = vget_low_s16 (vreinterpretq_s16_u16 (vmovl_u8 (vreinterpret_u8_u32 (vdup_n_u32 (pix2.getNativeARGB())))));
+    auto diff  = vsub_s16 (s16, d16);
+    auto d32x4 = vmovl_s16 (d16);
+
+    int i = 0;
+
+    for (; i + 2 <= numToDo; i += 2)
+    {
+        auto p0 = vshrq_n_s32 (vmull_s16 (diff, vdup_n_s16 ((int16) ((i << 8) / numToDo))), 8);
+        auto p1 = vshrq_n_s32 (vmull_s16 (diff, vdup_n_s16 ((int16) (((i + 1) << 8) / numToDo))), 8);
+        auto r  = vcombine_u16 (vqmovun_s32 (vaddq_s32 (d32x4, p0)),
+                                vqmovun_s32 (vaddq_s32 (d32x4, p1)));
+
+        vst1_u8 (reinterpret_cast<uint8*> (dest + i), vmovn_u16 (r));
+    }
+
+    for (; i < numToDo; ++i)
+    {
+        dest[i] = pix1;
+        dest[i].tween (pix2, (uint32) ((i << 8) / numToDo));
+    }
+}
+
+#endif
+
 //==============================================================================
 void ColourGradient::createLookupTable (PixelARGB* const lookupTable, const int numEntries) const noexcept
 {
@@ -210,13 +402,21 @@ void ColourGradient::createLookupTable (PixelARGB* const lookupTable, const int
         auto numToDo = roundToInt (p.position * (numEntries - 1)) - index;
         auto pix2 = p.colour.getPixelARGB();
 
-        for (int i = 0; i < numToDo; ++i)
+        if (numToDo > 0)
         {
-            jassert (index >= 0 && index < numEntries);
-
-            lookupTable[index] = pix1;
-            lookupTable[index].tween (pix2, (uint32) ((i << 8) / numToDo));
-            ++index;
+            jassert (index >= 0 && index + numToDo <= numEntries);
+
+           #if JUCE_COLOURGRADIENT_USE_SSE || JUCE_COLOURGRADIENT_USE_NEON
+            fillGradientSpan (lookupTable + index, pix1, pix2, numToDo);
+           #else
+            for (int i = 0; i < numToDo; ++i)
+            {
+                lookupTable[index + i] = pix1;
+                lookupTable[index + i].tween (pix2, (uint32) ((i << 8) / numToDo));
+            }
+           #endif
+
+            index += numToDo;
         }
 
         pix1 = pix2;
@@ -235,7 +435,16 @@ int ColourGradient::createLookupTable (const AffineTransform& transform, HeapBlo
                               3 * (int) point1.transformedBy (transform)
                                               .getDistanceFrom (point2.transformedBy (transform)));
     lookupTable.malloc (numEntries);
-    createLookupTable (lookupTable, numEntries);
+
+    auto& cache = GradientLookupTableCache::getInstance();
+    auto hash = getHashCode();
+
+    if (! cache.copyTable (hash, numEntries, lookupTable))
+    {
+        createLookupTable (lookupTable, numEntries);
+        cache.storeTable (hash, numEntries, lookupTable);
+    }
+
     return numEntries;
 }
 
@@ -191,6 +191,11 @@ public:
     /** Returns true if all colours are completely transparent. */
     bool isInvisible() const noexcept;
 
+    /** Returns a hash identifying this gradient's points, type and colour stops.
+        Two gradients that compare equal with operator== return the same hash.
+    */
+    int64 getHashCode() const noexcept;
+
     //==============================================================================
     Point<float> point1, point2;
 
@@ -0,0 +1,181 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if ! JUCE_ANDROID
+ #if JUCE_INTEL && (defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+  #define JUCE_PIXELOPERATIONS_USE_SSE 1
+  #include <emmintrin.h>
+ #elif JUCE_ARM && (defined (__ARM_NEON__) || defined (__ARM_NEON))
+  #define JUCE_PIXELOPERATIONS_USE_NEON 1
+  #include <arm_neon.h>
+ #endif
+#endif
+
+namespace juce
+{
+
+void PixelOperations::premultiply (PixelARGB* pixels, int numPixels) noexcept
+{
+    // The kernels below rely on the alpha byte being at index 3, which holds
+    // for all the little-endian layouts; the scalar loop covers the rest.
+   #if JUCE_PIXELOPERATIONS_USE_SSE
+    // Two pixels per iteration, widened to 16-bit lanes. Lanes with alpha 0xff
+    // are left untouched to match the scalar fast path exactly.
+    const auto zero      = _mm_setzero_si128();
+    const auto half      = _mm_set1_epi16 (0x7f);
+    const auto full      = _mm_set1_epi16 (0xff);
+    const auto rgbMask   = _mm_set_epi16 (0, -1, -1, -1, 0, -1, -1, -1);
+    const auto alphaMask = _mm_set_epi16 (-1, 0, 0, 0, -1, 0, 0, 0);
+
+    for (; numPixels >= 2; numPixels -= 2, pixels += 2)
+    {
+        auto v16   = _mm_unpacklo_epi8 (_mm_loadl_epi64 (reinterpret_cast<const __m128i*> (pixels)), zero);
+        auto alpha = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (v16, _MM_SHUFFLE (3, 3, 3, 3)),
+                                          _MM_SHUFFLE (3, 3, 3, 3));
+
+        auto opaque = _mm_cmpeq_epi16 (alpha, full);
+        auto scaled = _mm_srli_epi16 (_mm_add_epi16 (_mm_mullo_epi16 (v16, alpha), half), 8);
+        auto result = _mm_or_si128 (_mm_and_si128 (opaque, v16), _mm_andnot_si128 (opaque, scaled));
+
+        result = _mm_or_si128 (_mm_and_si128 (result, rgbMask), _mm_and_si128 (v16, alphaMask));
+        _mm_storel_epi64 (reinterpret_cast<__m128i*> (pixels), _mm_packus_epi16 (result, zero));
+    }
+   #elif JUCE_PIXELOPERATIONS_USE_NEON
+    // Eight pixels per iteration, with the channels deinterleaved by vld4.
+    const auto half = vdupq_n_u16 (0x7f);
+    const auto full = vdup_n_u8 (0xff);
+
+    for (; numPixels >= 8; numPixels -= 8, pixels += 8)
+    {
+        auto px = vld4_u8 (reinterpret_cast<const uint8_t*> (pixels));
+        auto opaque = vceq_u8 (px.val[3], full);
+
+        for (int channel = 0; channel < 3; ++channel)
+        {
+            auto scaled = vshrn_n_u16 (vaddq_u16 (vmull_u8 (px.val[channel], px.val[3]), half), 8);
+            px.val[channel] = vbsl_u8 (opaque, px.val[channel], scaled);
+        }
+
+        vst4_u8 (reinterpret_cast<uint8_t*> (pixels), px);
+    }
+   #endif
+
+    for (; numPixels > 0; --numPixels)
+        (pixels++)->premultiply();
+}
+
+void PixelOperations::unpremultiply (PixelARGB* pixels, int numPixels) noexcept
+{
+    // Replaces the three divisions per pixel with a reciprocal-table multiply.
+    // The rounded multipliers reproduce (c * 255) / alpha exactly over the
+    // 8-bit domain, so the results match PixelARGB::unpremultiply().
+    static const auto& reciprocals = [] () -> const auto&
+    {
+        static uint32 table[256] = {};
+
+        for (uint32 alpha = 1; alpha < 256; ++alpha)
+            table[alpha] = ((255u << 16) + alpha - 1) / alpha;
+
+        return table;
+    }();
+
+    for (; numPixels > 0; --numPixels, ++pixels)
+    {
+        const auto alpha = pixels->getAlpha();
+
+        if (alpha < 0xff)
+        {
+            if (alpha == 0)
+            {
+                pixels->setARGB (0, 0, 0, 0);
+            }
+            else
+            {
+                const auto scale = reciprocals[alpha];
+
+                pixels->setARGB (alpha,
+                                 (uint8) jmin (0xffu, (pixels->getRed()   * scale) >> 16),
+                                 (uint8) jmin (0xffu, (pixels->getGreen() * scale) >> 16),
+                                 (uint8) jmin (0xffu, (pixels->getBlue()  * scale) >> 16));
+            }
+        }
+    }
+}
+
+//==============================================================================
+void PixelOperations::swapRedBlue (PixelARGB* dest, const PixelARGB* source, int numPixels) noexcept
+{
+    // A pure integer swizzle, which the compiler vectorises well by itself.
+    auto* d = reinterpret_cast<uint32*> (dest);
+    auto* s = reinterpret_cast<const uint32*> (source);
+
+    for (int i = 0; i < numPixels; ++i)
+    {
+        const auto x = s[i];
+        d[i] = (x & 0xff00ff00u) | ((x & 0x00ff0000u) >> 16) | ((x & 0x000000ffu) << 16);
+    }
+}
+
+void PixelOperations::swapRedBlue (PixelARGB* pixels, int numPixels) noexcept
+{
+    swapRedBlue (pixels, pixels, numPixels);
+}
+
+//==============================================================================
+void PixelOperations::convertSRGBToLinear (float* dest, const uint8* src, int numValues) noexcept
+{
+    static const auto& table = [] () -> const auto&
+    {
+        static float values[256] = {};
+
+        for (int i = 0; i < 256; ++i)
+        {
+            const auto s = (float) i / 255.0f;
+
+            values[i] = s <= 0.04045f ? s / 12.92f
+                                      : std::pow ((s + 0.055f) / 1.055f, 2.4f);
+        }
+
+        return values;
+    }();
+
+    for (int i = 0; i < numValues; ++i)
+        dest[i] = table[(size_t) src[i]];
+}
+
+void PixelOperations::convertLinearToSRGB (uint8* dest, const float* src, int numValues) noexcept
+{
+    for (int i = 0; i < numValues; ++i)
+    {
+        const auto v = jlimit (0.0f, 1.0f, src[i]);
+
+        const auto s = v <= 0.0031308f ? v * 12.92f
+                                       : 1.055f * std::pow (v, 1.0f / 2.4f) - 0.055f;
+
+        dest[i] = (uint8) jlimit (0, 255, roundToInt (s * 255.0f));
+    }
+}
+
+} // namespace juce
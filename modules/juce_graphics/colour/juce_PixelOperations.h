@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A collection of batch operations on spans of pixel data, in the same spirit
+    as FloatVectorOperations.
+
+    These cover the conversions that come up when moving whole frames between
+    producers with different conventions - video decoders, GPU uploads,
+    image-file loaders - where converting pixel-at-a-time through PixelARGB
+    becomes a bottleneck. The per-pixel results match the corresponding
+    PixelARGB methods exactly, they're just applied to a whole span at once
+    using vectorised kernels where the platform allows.
+
+    @see PixelARGB, FloatVectorOperations
+
+    @tags{Graphics}
+*/
+class JUCE_API  PixelOperations
+{
+public:
+    //==============================================================================
+    /** Premultiplies a span of pixels' RGB values by their alpha.
+        This produces results identical to calling PixelARGB::premultiply()
+        on each pixel.
+    */
+    static void premultiply (PixelARGB* pixels, int numPixels) noexcept;
+
+    /** Unpremultiplies a span of pixels' RGB values.
+        This produces results identical to calling PixelARGB::unpremultiply()
+        on each pixel.
+    */
+    static void unpremultiply (PixelARGB* pixels, int numPixels) noexcept;
+
+    //==============================================================================
+    /** Swaps the red and blue channels of each pixel in a span, converting
+        between RGBA and BGRA byte orderings in either direction.
+    */
+    static void swapRedBlue (PixelARGB* pixels, int numPixels) noexcept;
+
+    /** Swaps the red and blue channels of each pixel while copying a span.
+        The source and destination must either be identical or non-overlapping.
+    */
+    static void swapRedBlue (PixelARGB* dest, const PixelARGB* source, int numPixels) noexcept;
+
+    //==============================================================================
+    /** Converts a span of 8-bit sRGB-encoded values to linear floats, 0 to 1.
+
+        This works on raw component values rather than whole pixels, so a
+        frame's worth of channels can be converted with a single call by
+        passing the pixel bytes directly. Note that alpha channels are not
+        sRGB-encoded, so interleaved ARGB data should have its alpha handled
+        separately.
+    */
+    static void convertSRGBToLinear (float* dest, const uint8* src, int numValues) noexcept;
+
+    /** Converts a span of linear float values, 0 to 1, to 8-bit sRGB.
+        Values outside the 0 to 1 range are clamped. Converting a value
+        produced by convertSRGBToLinear() returns the exact original byte.
+    */
+    static void convertLinearToSRGB (uint8* dest, const float* src, int numValues) noexcept;
+
+private:
+    PixelOperations() = delete;
+};
+
+} // namespace juce
@@ -0,0 +1,167 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class PixelOperationsTests  : public UnitTest
+{
+public:
+    PixelOperationsTests()
+        : UnitTest ("PixelOperations", UnitTestCategories::graphics) {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        beginTest ("Batch premultiply matches the per-pixel method");
+        {
+            // Odd span lengths exercise the vector kernels' scalar remainders.
+            for (auto length : { 1, 2, 7, 8, 64, 333 })
+            {
+                Array<PixelARGB> batch, reference;
+
+                for (int i = 0; i < length; ++i)
+                {
+                    const auto alpha = i == 0 ? (uint8) 0
+                                              : i == 1 ? (uint8) 0xff
+                                                       : (uint8) random.nextInt (256);
+
+                    const PixelARGB pixel (alpha,
+                                           (uint8) random.nextInt (256),
+                                           (uint8) random.nextInt (256),
+                                           (uint8) random.nextInt (256));
+                    batch.add (pixel);
+                    reference.add (pixel);
+                }
+
+                PixelOperations::premultiply (batch.getRawDataPointer(), length);
+
+                for (int i = 0; i < length; ++i)
+                {
+                    reference.getReference (i).premultiply();
+                    expectEquals ((int) batch.getReference (i).getNativeARGB(),
+                                  (int) reference.getReference (i).getNativeARGB());
+                }
+            }
+        }
+
+        beginTest ("Batch unpremultiply matches the per-pixel method exhaustively");
+        {
+            for (int alpha = 0; alpha < 256; ++alpha)
+            {
+                Array<PixelARGB> batch, reference;
+
+                for (int c = 0; c < 256; ++c)
+                {
+                    const PixelARGB pixel ((uint8) alpha, (uint8) c, (uint8) (255 - c), (uint8) (c / 2));
+                    batch.add (pixel);
+                    reference.add (pixel);
+                }
+
+                PixelOperations::unpremultiply (batch.getRawDataPointer(), 256);
+
+                for (int c = 0; c < 256; ++c)
+                {
+                    reference.getReference (c).unpremultiply();
+                    expectEquals ((int) batch.getReference (c).getNativeARGB(),
+                                  (int) reference.getReference (c).getNativeARGB());
+                }
+            }
+        }
+
+        beginTest ("Red/blue swizzle swaps channels and round-trips");
+        {
+            Array<PixelARGB> pixels;
+
+            for (int i = 0; i < 100; ++i)
+                pixels.add (PixelARGB ((uint8) random.nextInt (256), (uint8) random.nextInt (256),
+                                       (uint8) random.nextInt (256), (uint8) random.nextInt (256)));
+
+            Array<PixelARGB> swapped;
+            swapped.resize (pixels.size());
+
+            PixelOperations::swapRedBlue (swapped.getRawDataPointer(), pixels.getRawDataPointer(), pixels.size());
+
+            for (int i = 0; i < pixels.size(); ++i)
+            {
+                const auto& original = pixels.getReference (i);
+                const auto& result = swapped.getReference (i);
+
+                expectEquals ((int) result.getAlpha(), (int) original.getAlpha());
+                expectEquals ((int) result.getRed(),   (int) original.getBlue());
+                expectEquals ((int) result.getGreen(), (int) original.getGreen());
+                expectEquals ((int) result.getBlue(),  (int) original.getRed());
+            }
+
+            // Swapping in place twice is the identity.
+            PixelOperations::swapRedBlue (swapped.getRawDataPointer(), swapped.size());
+            PixelOperations::swapRedBlue (swapped.getRawDataPointer(), swapped.size());
+
+            for (int i = 0; i < pixels.size(); ++i)
+            {
+                const auto& original = pixels.getReference (i);
+                const auto& result = swapped.getReference (i);
+
+                expectEquals ((int) result.getRed(),  (int) original.getBlue());
+                expectEquals ((int) result.getBlue(), (int) original.getRed());
+            }
+        }
+
+        beginTest ("sRGB conversion is monotonic and round-trips every 8-bit value");
+        {
+            uint8 srgb[256];
+
+            for (int i = 0; i < 256; ++i)
+                srgb[i] = (uint8) i;
+
+            float linear[256];
+            PixelOperations::convertSRGBToLinear (linear, srgb, 256);
+
+            expectEquals (linear[0], 0.0f);
+            expectEquals (linear[255], 1.0f);
+
+            for (int i = 1; i < 256; ++i)
+                expect (linear[i] > linear[i - 1]);
+
+            uint8 roundTripped[256];
+            PixelOperations::convertLinearToSRGB (roundTripped, linear, 256);
+
+            for (int i = 0; i < 256; ++i)
+                expectEquals ((int) roundTripped[i], i);
+
+            // Out-of-range values clamp rather than wrapping.
+            const float outOfRange[] = { -1.0f, 2.0f };
+            uint8 clamped[2];
+            PixelOperations::convertLinearToSRGB (clamped, outOfRange, 2);
+            expectEquals ((int) clamped[0], 0);
+            expectEquals ((int) clamped[1], 255);
+        }
+    }
+};
+
+static PixelOperationsTests pixelOperationsTests;
+
+} // namespace juce
@@ -0,0 +1,234 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/*  A LowLevelGraphicsContext that appends each call it receives to its owner's
+    command list, capturing the arguments by value. Path, Image and Font all
+    share their underlying data, so the captures are cheap; replaying just
+    re-issues the calls against a real context.
+
+    Clip queries can't be answered while recording, because the target isn't
+    known yet - they report a huge, never-empty clip so that nothing is culled.
+    The current font is tracked locally (with a stack mirroring save/restoreState)
+    so that getFont() behaves during recording.
+*/
+class DisplayList::RecordingContext  : public LowLevelGraphicsContext
+{
+public:
+    explicit RecordingContext (DisplayList& list)  : owner (list) {}
+
+    bool isVectorDevice() const override                    { return true; }
+    float getPhysicalPixelScaleFactor() override            { return 1.0f; }
+
+    void setOrigin (Point<int> o) override                  { record ([o] (LowLevelGraphicsContext& c)  { c.setOrigin (o); }); }
+    void addTransform (const AffineTransform& t) override   { record ([t] (LowLevelGraphicsContext& c)  { c.addTransform (t); }); }
+
+    bool clipToRectangle (const Rectangle<int>& r) override
+    {
+        record ([r] (LowLevelGraphicsContext& c)  { c.clipToRectangle (r); });
+        return true;
+    }
+
+    bool clipToRectangleList (const RectangleList<int>& r) override
+    {
+        record ([r] (LowLevelGraphicsContext& c)  { c.clipToRectangleList (r); });
+        return true;
+    }
+
+    void excludeClipRectangle (const Rectangle<int>& r) override
+    {
+        record ([r] (LowLevelGraphicsContext& c)  { c.excludeClipRectangle (r); });
+    }
+
+    void clipToPath (const Path& path, const AffineTransform& t) override
+    {
+        record ([path, t] (LowLevelGraphicsContext& c)  { c.clipToPath (path, t); });
+    }
+
+    void clipToImageAlpha (const Image& image, const AffineTransform& t) override
+    {
+        record ([image, t] (LowLevelGraphicsContext& c)  { c.clipToImageAlpha (image, t); });
+    }
+
+    bool clipRegionIntersects (const Rectangle<int>&) override  { return true; }
+    bool isClipEmpty() const override                           { return false; }
+
+    Rectangle<int> getClipBounds() const override
+    {
+        const auto huge = std::numeric_limits<int>::max() / 4;
+        return { -huge, -huge, huge * 2, huge * 2 };
+    }
+
+    void saveState() override
+    {
+        fontStack.add (font);
+        record ([] (LowLevelGraphicsContext& c)  { c.saveState(); });
+    }
+
+    void restoreState() override
+    {
+        if (! fontStack.isEmpty())
+        {
+            font = fontStack.getLast();
+            fontStack.removeLast();
+        }
+
+        record ([] (LowLevelGraphicsContext& c)  { c.restoreState(); });
+    }
+
+    void beginTransparencyLayer (float opacity) override
+    {
+        record ([opacity] (LowLevelGraphicsContext& c)  { c.beginTransparencyLayer (opacity); });
+    }
+
+    void endTransparencyLayer() override
+    {
+        record ([] (LowLevelGraphicsContext& c)  { c.endTransparencyLayer(); });
+    }
+
+    void setFill (const FillType& fill) override
+    {
+        record ([fill] (LowLevelGraphicsContext& c)  { c.setFill (fill); });
+    }
+
+    void setOpacity (float opacity) override
+    {
+        record ([opacity] (LowLevelGraphicsContext& c)  { c.setOpacity (opacity); });
+    }
+
+    void setInterpolationQuality (Graphics::ResamplingQuality quality) override
+    {
+        record ([quality] (LowLevelGraphicsContext& c)  { c.setInterpolationQuality (quality); });
+    }
+
+    void fillRect (const Rectangle<int>& r, bool replaceExistingContents) override
+    {
+        record ([r, replaceExistingContents] (LowLevelGraphicsContext& c)  { c.fillRect (r, replaceExistingContents); });
+    }
+
+    void fillRect (const Rectangle<float>& r) override
+    {
+        record ([r] (LowLevelGraphicsContext& c)  { c.fillRect (r); });
+    }
+
+    void fillRectList (const RectangleList<float>& rects) override
+    {
+        record ([rects] (LowLevelGraphicsContext& c)  { c.fillRectList (rects); });
+    }
+
+    void fillPath (const Path& path, const AffineTransform& t) override
+    {
+        record ([path, t] (LowLevelGraphicsContext& c)  { c.fillPath (path, t); });
+    }
+
+    void fillPathInstanced (const Path& path, const AffineTransform* transforms, int numTransforms) override
+    {
+        std::vector<AffineTransform> batch (transforms, transforms + numTransforms);
+        record ([path, batch] (LowLevelGraphicsContext& c)  { c.fillPathInstanced (path, batch.data(), (int) batch.size()); });
+    }
+
+    void drawImage (const Image& image, const AffineTransform& t) override
+    {
+        record ([image, t] (LowLevelGraphicsContext& c)  { c.drawImage (image, t); });
+    }
+
+    void drawImageBatch (const Image& image, const AffineTransform* transforms, int numTransforms) override
+    {
+        std::vector<AffineTransform> batch (transforms, transforms + numTransforms);
+        record ([image, batch] (LowLevelGraphicsContext& c)  { c.drawImageBatch (image, batch.data(), (int) batch.size()); });
+    }
+
+    void drawLine (const Line<float>& line) override
+    {
+        record ([line] (LowLevelGraphicsContext& c)  { c.drawLine (line); });
+    }
+
+    void setFont (const Font& newFont) override
+    {
+        font = newFont;
+        record ([newFont] (LowLevelGraphicsContext& c)  { c.setFont (newFont); });
+    }
+
+    const Font& getFont() override      { return font; }
+
+    void drawGlyph (int glyphNumber, const AffineTransform& t) override
+    {
+        record ([glyphNumber, t] (LowLevelGraphicsContext& c)  { c.drawGlyph (glyphNumber, t); });
+    }
+
+private:
+    template <typename Command>
+    void record (Command&& command)
+    {
+        owner.commands.push_back (std::forward<Command> (command));
+    }
+
+    DisplayList& owner;
+    Font font;
+    Array<Font> fontStack;
+
+    JUCE_DECLARE_NON_COPYABLE (RecordingContext)
+};
+
+//==============================================================================
+DisplayList::DisplayList() = default;
+DisplayList::~DisplayList() = default;
+
+LowLevelGraphicsContext& DisplayList::beginRecording()
+{
+    clear();
+    recorder = std::make_unique<RecordingContext> (*this);
+    return *recorder;
+}
+
+void DisplayList::replay (Graphics& target) const
+{
+    replay (target.getInternalContext());
+}
+
+void DisplayList::replay (LowLevelGraphicsContext& target) const
+{
+    target.saveState();
+
+    for (auto& command : commands)
+        command (target);
+
+    target.restoreState();
+}
+
+void DisplayList::clear()
+{
+    commands.clear();
+}
+
+bool DisplayList::isEmpty() const noexcept
+{
+    return commands.empty();
+}
+
+} // namespace juce
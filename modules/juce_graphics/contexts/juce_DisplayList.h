@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Records a sequence of drawing operations so that it can be replayed cheaply.
+
+    If a component paints the same complex content on every frame - a grid of
+    cells, an axis with tick marks and labels - the cost of re-issuing all of
+    the Graphics calls can dominate its paint() method even when each individual
+    call is cheap. A DisplayList captures the sequence once, at normal drawing
+    cost, and then replays it into any context without re-doing the geometry
+    setup, text layout or argument marshalling that produced it.
+
+    To record, wrap the list in a Graphics object and paint as usual:
+
+    @code
+    DisplayList gridList;
+
+    {
+        Graphics g (gridList.beginRecording());
+        paintGrid (g);   // ordinary Graphics calls
+    }
+
+    // ...then in each subsequent paint():
+    gridList.replay (g);
+    @endcode
+
+    Unlike caching to an Image, the recording is resolution-independent: it
+    stores the drawing commands themselves, so replaying under a different
+    transform or scale re-renders at full quality.
+
+    While recording, the context reports a very large clip region and a pixel
+    scale of 1.0, so nothing gets culled at record time - clipping happens when
+    the list is replayed. For the same reason, content whose appearance depends
+    on the physical pixel scale should be recorded against the scale it will be
+    shown at.
+
+    Replaying restores the target's state afterwards, so a list can be replayed
+    several times, interleaved with other drawing.
+
+    @see Graphics, LowLevelGraphicsContext
+
+    @tags{Graphics}
+*/
+class JUCE_API  DisplayList
+{
+public:
+    //==============================================================================
+    /** Creates an empty DisplayList. */
+    DisplayList();
+
+    /** Destructor. */
+    ~DisplayList();
+
+    //==============================================================================
+    /** Discards any previous recording and returns a context that records into
+        this list.
+
+        Pass the returned context to the Graphics constructor and paint as
+        normal; every operation is appended to the list. The context remains
+        valid until beginRecording() is called again or the list is deleted.
+    */
+    LowLevelGraphicsContext& beginRecording();
+
+    /** Replays the recorded sequence into a graphics context.
+
+        The target's state is saved before replaying and restored afterwards.
+    */
+    void replay (Graphics& target) const;
+
+    /** Replays the recorded sequence into a low-level context. */
+    void replay (LowLevelGraphicsContext& target) const;
+
+    //==============================================================================
+    /** Discards the recorded sequence. */
+    void clear();
+
+    /** Returns true if nothing has been recorded. */
+    bool isEmpty() const noexcept;
+
+private:
+    //==============================================================================
+    class RecordingContext;
+
+    std::vector<std::function<void (LowLevelGraphicsContext&)>> commands;
+    std::unique_ptr<RecordingContext> recorder;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DisplayList)
+};
+
+} // namespace juce
@@ -398,6 +398,18 @@ void Graphics::fillPath (const Path& path, const AffineTransform& transform) con
         context.fillPath (path, transform);
 }
 
+void Graphics::fillPath (CachedPath& cachedPath, const AffineTransform& transform) const
+{
+    if (! (context.isClipEmpty() || cachedPath.getPath().isEmpty()))
+        context.fillCachedPath (cachedPath, transform);
+}
+
+void Graphics::fillPathInstanced (const Path& path, const AffineTransform* transforms, int numTransforms) const
+{
+    if (! (context.isClipEmpty() || path.isEmpty() || numTransforms <= 0))
+        context.fillPathInstanced (path, transforms, numTransforms);
+}
+
 void Graphics::strokePath (const Path& path,
                            const PathStrokeType& strokeType,
                            const AffineTransform& transform) const
@@ -683,6 +695,25 @@ void Graphics::drawImageTransformed (const Image& imageToDraw,
     }
 }
 
+void Graphics::drawImageBatch (const Image& imageToDraw,
+                               const AffineTransform* transforms,
+                               int numTransforms,
+                               const bool fillAlphaChannelWithCurrentBrush) const
+{
+    if (imageToDraw.isValid() && numTransforms > 0 && ! context.isClipEmpty())
+    {
+        if (fillAlphaChannelWithCurrentBrush)
+        {
+            for (int i = 0; i < numTransforms; ++i)
+                drawImageTransformed (imageToDraw, transforms[i], true);
+        }
+        else
+        {
+            context.drawImageBatch (imageToDraw, transforms, numTransforms);
+        }
+    }
+}
+
 //==============================================================================
 Graphics::ScopedSaveState::ScopedSaveState (Graphics& g)  : context (g)
 {
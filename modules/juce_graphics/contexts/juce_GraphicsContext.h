@@ -435,6 +435,30 @@ public:
     /** Fills a path using the currently selected colour or brush, and adds a transform. */
     void fillPath (const Path& path, const AffineTransform& transform) const;
 
+    /** Fills a CachedPath using the currently selected colour or brush.
+
+        If the path is drawn repeatedly with an unchanged transform and clip region,
+        renderers that rasterise through edge tables will re-use the table cached in
+        the CachedPath instead of re-rasterising the path each time.
+
+        @see CachedPath
+    */
+    void fillPath (CachedPath& cachedPath, const AffineTransform& transform = {}) const;
+
+    /** Fills several copies of the same path, each with its own transform.
+
+        This is equivalent to calling fillPath (path, transforms[i]) once per
+        transform, but hands the whole batch to the renderer in a single call, so
+        that stamping one shape many times - the cells of a sequencer grid, the
+        points of a scatter plot - doesn't pay the per-primitive overhead over
+        and over.
+
+        @see fillPath, drawImageBatch
+    */
+    void fillPathInstanced (const Path& path,
+                            const AffineTransform* transforms,
+                            int numTransforms) const;
+
     /** Draws a path's outline using the currently selected colour or brush. */
     void strokePath (const Path& path,
                      const PathStrokeType& strokeType,
@@ -536,6 +560,19 @@ public:
                                const AffineTransform& transform,
                                bool fillAlphaChannelWithCurrentBrush = false) const;
 
+    /** Draws several copies of the same image, each with its own transform.
+
+        This is equivalent to calling drawImageTransformed() once per transform,
+        but hands the whole batch to the renderer in a single call, which lets it
+        amortize its per-image setup when the same image is stamped many times.
+
+        @see drawImageTransformed, fillPathInstanced
+    */
+    void drawImageBatch (const Image& imageToDraw,
+                         const AffineTransform* transforms,
+                         int numTransforms,
+                         bool fillAlphaChannelWithCurrentBrush = false) const;
+
     /** Draws an image to fit within a designated rectangle.
 
         @param imageToDraw              the source image to draw
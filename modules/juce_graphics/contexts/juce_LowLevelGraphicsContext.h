@@ -90,7 +90,36 @@ public:
     virtual void fillRect (const Rectangle<float>&) = 0;
     virtual void fillRectList (const RectangleList<float>&) = 0;
     virtual void fillPath (const Path&, const AffineTransform&) = 0;
+
+    /** Fills a CachedPath, re-using its cached edge table where possible.
+        The default implementation just fills the path in the normal way, which is
+        the right thing to do for contexts that don't rasterise via edge tables.
+    */
+    virtual void fillCachedPath (CachedPath& cachedPath, const AffineTransform& t)  { fillPath (cachedPath.getPath(), t); }
+
+    /** Fills several copies of the same path, one per transform.
+        The default implementation just calls fillPath() once per copy; contexts
+        backed by APIs with instanced drawing can override it to submit the whole
+        batch in a single call.
+    */
+    virtual void fillPathInstanced (const Path& path, const AffineTransform* transforms, int numTransforms)
+    {
+        for (int i = 0; i < numTransforms; ++i)
+            fillPath (path, transforms[i]);
+    }
+
     virtual void drawImage (const Image&, const AffineTransform&) = 0;
+
+    /** Draws several copies of the same image, one per transform.
+        Like fillPathInstanced(), the default implementation just calls drawImage()
+        in a loop, and exists so that batching contexts can handle the whole set at once.
+    */
+    virtual void drawImageBatch (const Image& image, const AffineTransform* transforms, int numTransforms)
+    {
+        for (int i = 0; i < numTransforms; ++i)
+            drawImage (image, transforms[i]);
+    }
+
     virtual void drawLine (const Line<float>&) = 0;
 
     virtual void setFont (const Font&) = 0;
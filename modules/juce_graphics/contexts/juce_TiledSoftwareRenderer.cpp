@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+TiledSoftwareRenderer::TiledSoftwareRenderer (int numThreadsToUse)
+    : pool (jmax (1, numThreadsToUse))
+{
+}
+
+TiledSoftwareRenderer::~TiledSoftwareRenderer()
+{
+    pool.removeAllJobs (true, -1);
+}
+
+void TiledSoftwareRenderer::render (const Image& destImage, const std::function<void (Graphics&)>& paintFunction)
+{
+    DisplayList commands;
+
+    {
+        Graphics g (commands.beginRecording());
+        paintFunction (g);
+    }
+
+    render (destImage, commands);
+}
+
+void TiledSoftwareRenderer::render (const Image& destImage, const DisplayList& commands, int minimumBandHeight)
+{
+    if (destImage.isNull() || commands.isEmpty())
+        return;
+
+    auto bounds = destImage.getBounds();
+    auto numBands = jlimit (1, pool.getNumThreads(),
+                            bounds.getHeight() / jmax (1, minimumBandHeight));
+
+    if (numBands <= 1)
+    {
+        LowLevelGraphicsSoftwareRenderer context (destImage);
+        commands.replay (context);
+        return;
+    }
+
+    // Each band is rendered through a context whose clip is just that band, so
+    // the workers rasterise disjoint rows of the destination. The calling
+    // thread takes the first band itself instead of sitting idle.
+    WaitableEvent allBandsFinished;
+    std::atomic<int> bandsRemaining { numBands - 1 };
+
+    auto getBandBounds = [bounds, numBands] (int band)
+    {
+        auto y1 = bounds.getY() + (bounds.getHeight() * band)       / numBands;
+        auto y2 = bounds.getY() + (bounds.getHeight() * (band + 1)) / numBands;
+
+        return bounds.withTop (y1).withBottom (y2);
+    };
+
+    for (int band = 1; band < numBands; ++band)
+    {
+        pool.addJob ([&destImage, &commands, &allBandsFinished, &bandsRemaining,
+                      bandBounds = getBandBounds (band)]
+        {
+            {
+                LowLevelGraphicsSoftwareRenderer context (destImage, {}, RectangleList<int> (bandBounds));
+                commands.replay (context);
+            }
+
+            if (--bandsRemaining == 0)
+                allBandsFinished.signal();
+        });
+    }
+
+    {
+        LowLevelGraphicsSoftwareRenderer context (destImage, {}, RectangleList<int> (getBandBounds (0)));
+        commands.replay (context);
+    }
+
+    allBandsFinished.wait();
+}
+
+} // namespace juce
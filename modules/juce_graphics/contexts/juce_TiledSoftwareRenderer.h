@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Renders a recorded drawing sequence into an image using several threads.
+
+    The software renderer paints the whole dirty region on a single thread, so
+    on machines without GPU acceleration a large repaint is limited by the
+    speed of one core. This class splits the destination image into horizontal
+    bands and renders each band on a worker thread, using a separate
+    LowLevelGraphicsSoftwareRenderer whose clip region is that band. Because
+    the bands are disjoint, the workers never write to the same pixels and no
+    locking of the destination is needed.
+
+    The drawing has to be captured as a DisplayList first, since the same
+    command sequence is replayed once per band:
+
+    @code
+    TiledSoftwareRenderer renderer;
+
+    renderer.render (image, [&] (Graphics& g)
+    {
+        paintEverything (g);   // ordinary Graphics calls
+    });
+    @endcode
+
+    The paint routine runs once, on the calling thread, to record the display
+    list; only the rasterisation is parallel. Any images, paths or fonts it
+    draws will be read concurrently by the workers during rendering, which is
+    safe as long as nothing else is mutating them at the same time.
+
+    render() blocks until all bands are finished, so the destination image is
+    complete when it returns.
+
+    @see DisplayList, LowLevelGraphicsSoftwareRenderer
+
+    @tags{Graphics}
+*/
+class JUCE_API  TiledSoftwareRenderer
+{
+public:
+    //==============================================================================
+    /** Creates a renderer with a pool of worker threads.
+
+        By default one worker per CPU core is created. The calling thread
+        renders a band itself while the workers run, so small images or low
+        thread counts don't leave it idle.
+    */
+    explicit TiledSoftwareRenderer (int numThreadsToUse = SystemStats::getNumCpus());
+
+    /** Destructor. Waits for any render in progress to finish. */
+    ~TiledSoftwareRenderer();
+
+    //==============================================================================
+    /** Records the given paint routine into a DisplayList and renders it into
+        the image in parallel.
+
+        The paint routine is invoked exactly once, on the calling thread.
+    */
+    void render (const Image& destImage, const std::function<void (Graphics&)>& paintFunction);
+
+    /** Renders an already-recorded DisplayList into the image in parallel.
+
+        The image is divided into horizontal bands of at least
+        minimumBandHeight pixels, up to one band per thread; if it's too small
+        to split usefully, it's rendered directly on the calling thread.
+    */
+    void render (const Image& destImage, const DisplayList& commands, int minimumBandHeight = 64);
+
+private:
+    //==============================================================================
+    ThreadPool pool;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TiledSoftwareRenderer)
+};
+
+} // namespace juce
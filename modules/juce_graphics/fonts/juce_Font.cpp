@@ -51,7 +51,8 @@ class TypefaceCache  : private DeletedAtShutdown
 public:
     TypefaceCache()
     {
-        setSize (10);
+        StartupProfile::recordEvent ("TypefaceCache created");
+        setSize (defaultNumTypefacesToCache);
     }
 
     ~TypefaceCache()
@@ -142,6 +143,11 @@ public:
     }
 
 private:
+    // The old default of 10 was small enough that mixed-script UIs would cycle
+    // typefaces in and out of the cache during a single layout pass; this can
+    // still be overridden with Typeface::setTypefaceCacheSize().
+    enum { defaultNumTypefacesToCache = 32 };
+
     struct CachedFace
     {
         CachedFace() noexcept {}
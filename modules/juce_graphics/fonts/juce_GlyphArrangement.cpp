@@ -34,6 +34,132 @@ static constexpr bool isNonBreakingSpace (const juce_wchar c)
         || c == 0x2060;
 }
 
+//==============================================================================
+/*  Caches the output of Font::getGlyphPositions(), so that repeatedly laying
+    out an unchanged piece of text (e.g. a label that's repainted every frame)
+    costs an array copy rather than a full shaping pass.
+
+    This uses the same adaptive LRU scheme as the renderer's GlyphCache, which
+    plays the equivalent role for the rasterised glyph images.
+*/
+class ShapedTextCache  : private DeletedAtShutdown
+{
+public:
+    ShapedTextCache()
+    {
+        addNewRunSlots (48);
+    }
+
+    ~ShapedTextCache() override
+    {
+        getSingletonPointer() = nullptr;
+    }
+
+    static ShapedTextCache& getInstance()
+    {
+        auto& s = getSingletonPointer();
+
+        if (s == nullptr)
+            s = new ShapedTextCache();
+
+        return *s;
+    }
+
+    void getGlyphPositions (const Font& font, const String& text,
+                            Array<int>& glyphsOut, Array<float>& xOffsetsOut)
+    {
+        // very long runs of text are unlikely to repeat, so aren't worth caching
+        if (text.length() > maxCachedStringLength)
+        {
+            font.getGlyphPositions (text, glyphsOut, xOffsetsOut);
+            return;
+        }
+
+        const ScopedLock sl (lock);
+
+        if (auto* run = findExistingRun (font, text))
+        {
+            ++hits;
+            run->lastAccessCount = ++accessCounter;
+            glyphsOut = run->glyphs;
+            xOffsetsOut = run->xOffsets;
+            return;
+        }
+
+        ++misses;
+        auto* run = getRunForReuse();
+        run->font = font;
+        run->text = text;
+        run->lastAccessCount = ++accessCounter;
+        run->glyphs.clearQuick();
+        run->xOffsets.clearQuick();
+        font.getGlyphPositions (text, run->glyphs, run->xOffsets);
+        glyphsOut = run->glyphs;
+        xOffsetsOut = run->xOffsets;
+    }
+
+private:
+    struct ShapedRun
+    {
+        Font font;
+        String text;
+        Array<int> glyphs;
+        Array<float> xOffsets;
+        int lastAccessCount = 0;
+    };
+
+    enum { maxCachedStringLength = 128, maxNumRuns = 256 };
+
+    OwnedArray<ShapedRun> runs;
+    CriticalSection lock;
+    int accessCounter = 0, hits = 0, misses = 0;
+
+    ShapedRun* findExistingRun (const Font& font, const String& text) const noexcept
+    {
+        for (auto* run : runs)
+            if (run->text == text && run->font == font)
+                return run;
+
+        return nullptr;
+    }
+
+    ShapedRun* getRunForReuse()
+    {
+        if (hits + misses > runs.size() * 16)
+        {
+            if (misses * 2 > hits && runs.size() < maxNumRuns)
+                addNewRunSlots (16);
+
+            hits = 0;
+            misses = 0;
+        }
+
+        auto* oldest = runs.getFirst();
+
+        for (auto* run : runs)
+            if (run->lastAccessCount < oldest->lastAccessCount)
+                oldest = run;
+
+        return oldest;
+    }
+
+    void addNewRunSlots (int num)
+    {
+        runs.ensureStorageAllocated (runs.size() + num);
+
+        while (--num >= 0)
+            runs.add (new ShapedRun());
+    }
+
+    static ShapedTextCache*& getSingletonPointer() noexcept
+    {
+        static ShapedTextCache* s = nullptr;
+        return s;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ShapedTextCache)
+};
+
 PositionedGlyph::PositionedGlyph() noexcept
     : character (0), glyph (0), x (0), y (0), w (0), whitespace (false)
 {
@@ -154,7 +280,7 @@ void GlyphArrangement::addCurtailedLineOfText (const Font& font, const String& t
     {
         Array<int> newGlyphs;
         Array<float> xOffsets;
-        font.getGlyphPositions (text, newGlyphs, xOffsets);
+        ShapedTextCache::getInstance().getGlyphPositions (font, text, newGlyphs, xOffsets);
         auto textLen = newGlyphs.size();
         glyphs.ensureStorageAllocated (glyphs.size() + textLen);
 
@@ -192,7 +318,7 @@ int GlyphArrangement::insertEllipsis (const Font& font, float maxXPos, int start
     {
         Array<int> dotGlyphs;
         Array<float> dotXs;
-        font.getGlyphPositions ("..", dotGlyphs, dotXs);
+        ShapedTextCache::getInstance().getGlyphPositions (font, "..", dotGlyphs, dotXs);
 
         auto dx = dotXs[1];
         float xOffset = 0.0f, yOffset = 0.0f;
@@ -26,6 +26,161 @@
 namespace juce
 {
 
+//==============================================================================
+/*  Remembers the results of expensive font lookups - the concrete family names
+    that the placeholder names resolve to, and the vertical hinting metrics that
+    are otherwise measured from glyph outlines the first time a typeface is
+    drawn at a small size. When a cache file has been set, these survive between
+    runs so that cold-start text layout avoids re-querying the platform font APIs.
+*/
+class TypefaceMetricsCache  : private DeletedAtShutdown
+{
+public:
+    TypefaceMetricsCache() = default;
+
+    ~TypefaceMetricsCache() override
+    {
+        clearSingletonInstance();
+    }
+
+    JUCE_DECLARE_SINGLETON (TypefaceMetricsCache, false)
+
+    struct HintingMetrics
+    {
+        float top = 0, middle = 0, bottom = 0;
+    };
+
+    void setFile (const File& newFile)
+    {
+        const ScopedLock sl (lock);
+
+        cacheFile = newFile;
+        families.clear();
+        hintingMetrics.clear();
+
+        if (cacheFile == File())
+            return;
+
+        cacheFile.getParentDirectory().createDirectory();
+
+        if (auto xml = parseXML (cacheFile))
+        {
+            if (xml->hasTagName ("TYPEFACE_METRICS"))
+            {
+                for (auto* e : xml->getChildIterator())
+                {
+                    if (e->hasTagName ("FAMILY"))
+                    {
+                        families.set (e->getStringAttribute ("placeholder"),
+                                      e->getStringAttribute ("concrete"));
+                    }
+                    else if (e->hasTagName ("HINTING"))
+                    {
+                        hintingMetrics.set (e->getStringAttribute ("face"),
+                                            { (float) e->getDoubleAttribute ("top"),
+                                              (float) e->getDoubleAttribute ("middle"),
+                                              (float) e->getDoubleAttribute ("bottom") });
+                    }
+                }
+            }
+        }
+    }
+
+    void clear()
+    {
+        const ScopedLock sl (lock);
+
+        families.clear();
+        hintingMetrics.clear();
+        cacheFile.deleteFile();
+    }
+
+    bool findConcreteFamilyName (const String& placeholder, String& result) const
+    {
+        const ScopedLock sl (lock);
+
+        if (! families.contains (placeholder))
+            return false;
+
+        result = families[placeholder];
+        return true;
+    }
+
+    void storeConcreteFamilyName (const String& placeholder, const String& concrete)
+    {
+        const ScopedLock sl (lock);
+
+        if (cacheFile == File() || families.contains (placeholder))
+            return;
+
+        families.set (placeholder, concrete);
+        save();
+    }
+
+    bool findHintingMetrics (const String& name, const String& style, HintingMetrics& result) const
+    {
+        const ScopedLock sl (lock);
+        const auto key = keyFor (name, style);
+
+        if (! hintingMetrics.contains (key))
+            return false;
+
+        result = hintingMetrics[key];
+        return true;
+    }
+
+    void storeHintingMetrics (const String& name, const String& style, const HintingMetrics& metrics)
+    {
+        const ScopedLock sl (lock);
+        const auto key = keyFor (name, style);
+
+        if (cacheFile == File() || hintingMetrics.contains (key))
+            return;
+
+        hintingMetrics.set (key, metrics);
+        save();
+    }
+
+private:
+    static String keyFor (const String& name, const String& style)
+    {
+        return name + ";" + style;
+    }
+
+    void save() const
+    {
+        XmlElement xml ("TYPEFACE_METRICS");
+
+        for (HashMap<String, String>::Iterator i (families); i.next();)
+        {
+            auto* e = xml.createNewChildElement ("FAMILY");
+            e->setAttribute ("placeholder", i.getKey());
+            e->setAttribute ("concrete", i.getValue());
+        }
+
+        for (HashMap<String, HintingMetrics>::Iterator i (hintingMetrics); i.next();)
+        {
+            auto* e = xml.createNewChildElement ("HINTING");
+            e->setAttribute ("face", i.getKey());
+            e->setAttribute ("top", i.getValue().top);
+            e->setAttribute ("middle", i.getValue().middle);
+            e->setAttribute ("bottom", i.getValue().bottom);
+        }
+
+        xml.writeTo (cacheFile);
+    }
+
+    CriticalSection lock;
+    File cacheFile;
+    HashMap<String, String> families;
+    HashMap<String, HintingMetrics> hintingMetrics;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TypefaceMetricsCache)
+};
+
+JUCE_IMPLEMENT_SINGLETON (TypefaceMetricsCache)
+
+//==============================================================================
 struct FontStyleHelpers
 {
     static const char* getStyleName (const bool bold,
@@ -82,8 +237,16 @@ struct FontStyleHelpers
     private:
         static String findName (const String& placeholder)
         {
+            auto* cache = TypefaceMetricsCache::getInstance();
+            String cached;
+
+            if (cache->findConcreteFamilyName (placeholder, cached))
+                return cached;
+
             const Font f (placeholder, Font::getDefaultStyle(), 15.0f);
-            return Font::getDefaultTypefaceForFont (f)->getName();
+            auto concrete = Font::getDefaultTypefaceForFont (f)->getName();
+            cache->storeConcreteFamilyName (placeholder, concrete);
+            return concrete;
         }
 
         String sans, serif, mono;
@@ -118,6 +281,16 @@ Typeface::Ptr Typeface::getFallbackTypeface()
     return fallbackFont.getTypefacePtr();
 }
 
+void Typeface::setPersistentMetricsCacheFile (const File& file)
+{
+    TypefaceMetricsCache::getInstance()->setFile (file);
+}
+
+void Typeface::clearPersistentMetricsCache()
+{
+    TypefaceMetricsCache::getInstance()->clear();
+}
+
 EdgeTable* Typeface::getEdgeTableForGlyph (int glyphNumber, const AffineTransform& transform, float fontHeight)
 {
     Path path;
@@ -138,12 +311,25 @@ struct Typeface::HintingParams
 {
     HintingParams (Typeface& t)
     {
+        auto* cache = TypefaceMetricsCache::getInstance();
+        TypefaceMetricsCache::HintingMetrics cached;
+
+        if (cache->findHintingMetrics (t.getName(), t.getStyle(), cached))
+        {
+            top = cached.top;
+            middle = cached.middle;
+            bottom = cached.bottom;
+            return;
+        }
+
         Font font (t);
         font = font.withHeight ((float) standardHeight);
 
         top = getAverageY (font, "BDEFPRTZOQ", true);
         middle = getAverageY (font, "acegmnopqrsuvwxy", true);
         bottom = getAverageY (font, "BDELZOC", false);
+
+        cache->storeHintingMetrics (t.getName(), t.getStyle(), { top, middle, bottom });
     }
 
     void applyVerticalHintingTransform (float fontSize, Path& path)
@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+CachedPath::CachedPath() = default;
+CachedPath::~CachedPath() = default;
+
+CachedPath::CachedPath (Path pathToUse)  : path (std::move (pathToUse))
+{
+}
+
+void CachedPath::setPath (Path newPath)
+{
+    path = std::move (newPath);
+    invalidate();
+}
+
+void CachedPath::invalidate() noexcept
+{
+    edgeTable.reset();
+}
+
+const EdgeTable& CachedPath::getEdgeTableFor (Rectangle<int> clipArea, const AffineTransform& transform)
+{
+    if (edgeTable == nullptr || clipArea != cachedClipArea || transform != cachedTransform)
+    {
+        edgeTable = std::make_unique<EdgeTable> (clipArea, path, transform);
+        edgeTable->optimiseTable();
+        cachedClipArea = clipArea;
+        cachedTransform = transform;
+    }
+
+    return *edgeTable;
+}
+
+} // namespace juce
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Holds a path along with a cached, rasterised version of it, to speed up
+    repeatedly filling the same shape.
+
+    When a path is filled with Graphics::fillPath, the renderer has to convert it
+    into an EdgeTable, which involves scan-converting the whole shape. If your
+    component redraws the same path with the same transform on every frame - a
+    spectrum analyser or waveform display, say - that work is identical each time.
+    Wrapping the path in a CachedPath lets the software renderer keep the edge
+    table from the previous frame and re-use it whenever the transform and clip
+    region haven't changed.
+
+    The cache is refreshed automatically when the path is filled with a different
+    transform or clip region, so using one of these objects is never wrong - it
+    just only pays off when those stay stable between paints. Call setPath() to
+    change the shape (which discards the cached table), or invalidate() to throw
+    the table away explicitly.
+
+    Note that renderers which don't rasterise through edge tables (e.g.
+    CoreGraphics) simply fill the path in the normal way.
+
+    @see Path, Graphics::fillPath, EdgeTable
+
+    @tags{Graphics}
+*/
+class JUCE_API  CachedPath
+{
+public:
+    //==============================================================================
+    /** Creates an empty CachedPath. */
+    CachedPath();
+
+    /** Creates a CachedPath for the given path. */
+    explicit CachedPath (Path pathToUse);
+
+    /** Destructor. */
+    ~CachedPath();
+
+    //==============================================================================
+    /** Replaces the path, discarding any cached rasterisation of the old one. */
+    void setPath (Path newPath);
+
+    /** Returns the path that this object is caching. */
+    const Path& getPath() const noexcept            { return path; }
+
+    /** Discards the cached edge table, so that the next fill re-rasterises the path.
+
+        You only need to call this if you've changed something that affects the
+        rendered shape without going through setPath().
+    */
+    void invalidate() noexcept;
+
+    //==============================================================================
+    /** @internal Returns an edge table for the path rasterised with the given clip
+        area and transform, re-using the cached table when both match the previous
+        call. Used by the rendering code - not intended to be called directly.
+    */
+    const EdgeTable& getEdgeTableFor (Rectangle<int> clipArea, const AffineTransform& transform);
+
+private:
+    //==============================================================================
+    Path path;
+    std::unique_ptr<EdgeTable> edgeTable;
+    Rectangle<int> cachedClipArea;
+    AffineTransform cachedTransform;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CachedPath)
+};
+
+} // namespace juce
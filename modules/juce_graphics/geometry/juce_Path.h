@@ -618,6 +618,15 @@ public:
     */
     void preallocateSpace (int numExtraCoordsToMakeSpaceFor);
 
+    /** Returns the number of coordinates the path currently contains, using the
+        same units as preallocateSpace.
+
+        This is handy for estimating how much space to preallocate in a path
+        that's about to be built from this one - e.g. a flattened or stroked
+        version of it.
+    */
+    int getNumCoordinates() const noexcept          { return data.size(); }
+
     //==============================================================================
     /** Applies a 2D transform to all the vertices in the path.
 
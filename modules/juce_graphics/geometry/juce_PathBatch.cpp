@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+PathBatch::PathBatch (int numThreadsToUse)
+    : pool (jmax (1, numThreadsToUse))
+{
+}
+
+PathBatch::~PathBatch()
+{
+    pool.removeAllJobs (true, -1);
+}
+
+void PathBatch::runBatch (int numPaths, const std::function<void (int)>& processPath)
+{
+    if (numPaths <= 0)
+        return;
+
+    // Workers and the calling thread pull the next unclaimed path from a
+    // shared counter, so a few expensive paths can't unbalance the batch.
+    // The counters are shared-owned by every job because a worker may still
+    // be claiming (and rejecting) an index after the final path has finished
+    // and this call has returned.
+    struct SharedState
+    {
+        std::atomic<int> nextPath { 0 }, pathsRemaining { 0 };
+        WaitableEvent allPathsFinished;
+    };
+
+    auto state = std::make_shared<SharedState>();
+    state->pathsRemaining = numPaths;
+
+    auto processNextPaths = [state, &processPath, numPaths]
+    {
+        for (;;)
+        {
+            auto index = state->nextPath++;
+
+            if (index >= numPaths)
+                break;
+
+            processPath (index);
+
+            if (--(state->pathsRemaining) == 0)
+                state->allPathsFinished.signal();
+        }
+    };
+
+    auto numWorkers = jmin (pool.getNumThreads(), numPaths - 1);
+
+    for (int i = 0; i < numWorkers; ++i)
+        pool.addJob (processNextPaths);
+
+    processNextPaths();
+    state->allPathsFinished.wait();
+}
+
+void PathBatch::createStrokedPaths (const PathStrokeType& strokeType,
+                                    const Path* const* sourcePaths,
+                                    Path* const* destPaths,
+                                    int numPaths,
+                                    const AffineTransform& transform,
+                                    float extraAccuracy)
+{
+    runBatch (numPaths, [&] (int i)
+    {
+        jassert (sourcePaths[i] != destPaths[i]);
+
+        auto& dest = *destPaths[i];
+        dest.clear();
+
+        // Each flattened segment yields an edge on both sides of the stroke,
+        // plus joints and caps - four coords per source coord plus a little
+        // headroom covers typical strokes without a mid-stroke reallocation.
+        dest.preallocateSpace (4 * sourcePaths[i]->getNumCoordinates() + 32);
+
+        strokeType.createStrokedPath (dest, *sourcePaths[i], transform, extraAccuracy);
+    });
+}
+
+void PathBatch::flattenPaths (const Path* const* sourcePaths,
+                              Path* const* destPaths,
+                              int numPaths,
+                              const AffineTransform& transform,
+                              float tolerance)
+{
+    runBatch (numPaths, [&] (int i)
+    {
+        jassert (sourcePaths[i] != destPaths[i]);
+
+        auto& dest = *destPaths[i];
+        dest.clear();
+        dest.preallocateSpace (3 * sourcePaths[i]->getNumCoordinates() + 32);
+
+        for (PathFlatteningIterator it (*sourcePaths[i], transform, tolerance); it.next();)
+        {
+            if (it.subPathIndex == 0)
+                dest.startNewSubPath (it.x1, it.y1);
+
+            dest.lineTo (it.x2, it.y2);
+
+            if (it.closesSubPath)
+                dest.closeSubPath();
+        }
+    });
+}
+
+} // namespace juce
@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Strokes or flattens a set of paths in parallel across a pool of worker
+    threads.
+
+    Generating stroked outlines for many paths at once - say, waveform
+    outlines for every clip in a freshly-loaded project - is embarrassingly
+    parallel, but PathStrokeType::createStrokedPath only works on one path at
+    a time on the calling thread. This class distributes a whole batch across
+    a ThreadPool, with the calling thread joining in, and blocks until every
+    path is done.
+
+    Each source/destination pair is touched by exactly one thread, so the
+    usual Path thread-safety rules are satisfied as long as the sources aren't
+    modified elsewhere while a batch is running. Destination paths keep their
+    allocated storage between batches (Path::clear doesn't free), so reusing
+    the same destinations avoids regrowing their vertex arrays on every
+    regeneration.
+
+    @see Path, PathStrokeType, PathFlatteningIterator
+
+    @tags{Graphics}
+*/
+class JUCE_API  PathBatch
+{
+public:
+    //==============================================================================
+    /** Creates a batch with a pool of worker threads.
+
+        The default spawns one thread fewer than there are cores, as the
+        calling thread also processes paths while the workers run.
+    */
+    explicit PathBatch (int numThreadsToUse = SystemStats::getNumCpus() - 1);
+
+    /** Destructor. Waits for any batch in progress to finish. */
+    ~PathBatch();
+
+    //==============================================================================
+    /** Strokes each source path into the corresponding destination path,
+        spreading the work across the pool.
+
+        This produces the same results as calling strokeType.createStrokedPath
+        on each pair in turn. The destination paths are cleared and
+        preallocated before stroking; a source and its destination may not be
+        the same object.
+
+        @param strokeType     the stroke to apply to every path in the batch
+        @param sourcePaths    the paths to stroke
+        @param destPaths      one destination per source, to fill with the outlines
+        @param numPaths       the number of entries in both arrays
+        @param transform      an optional transform to apply to the sources
+        @param extraAccuracy  curve quality multiplier, as for createStrokedPath
+    */
+    void createStrokedPaths (const PathStrokeType& strokeType,
+                             const Path* const* sourcePaths,
+                             Path* const* destPaths,
+                             int numPaths,
+                             const AffineTransform& transform = AffineTransform(),
+                             float extraAccuracy = 1.0f);
+
+    /** Flattens each source path into the corresponding destination path,
+        replacing all curves with line segments, spreading the work across
+        the pool.
+
+        The destinations are cleared and preallocated before flattening; a
+        source and its destination may not be the same object.
+
+        @param sourcePaths  the paths to flatten
+        @param destPaths    one destination per source, to fill with line segments
+        @param numPaths     the number of entries in both arrays
+        @param transform    an optional transform to apply to the sources
+        @param tolerance    the max error allowed when replacing a curve with lines,
+                            as for PathFlatteningIterator
+    */
+    void flattenPaths (const Path* const* sourcePaths,
+                       Path* const* destPaths,
+                       int numPaths,
+                       const AffineTransform& transform = AffineTransform(),
+                       float tolerance = Path::defaultToleranceForMeasurement);
+
+private:
+    //==============================================================================
+    void runBatch (int numPaths, const std::function<void (int)>& processPath);
+
+    ThreadPool pool;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PathBatch)
+};
+
+} // namespace juce
@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class PathBatchTests  : public UnitTest
+{
+public:
+    PathBatchTests()
+        : UnitTest ("PathBatch", UnitTestCategories::graphics) {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        OwnedArray<Path> sources;
+        Array<const Path*> sourcePointers;
+
+        for (int i = 0; i < 40; ++i)
+        {
+            auto* path = sources.add (new Path());
+
+            path->startNewSubPath (random.nextFloat() * 100.0f, random.nextFloat() * 100.0f);
+
+            for (int j = random.nextInt ({ 2, 50 }); --j >= 0;)
+            {
+                switch (random.nextInt (3))
+                {
+                    case 0:  path->lineTo (random.nextFloat() * 100.0f, random.nextFloat() * 100.0f); break;
+                    case 1:  path->quadraticTo (random.nextFloat() * 100.0f, random.nextFloat() * 100.0f,
+                                                random.nextFloat() * 100.0f, random.nextFloat() * 100.0f); break;
+                    default: path->cubicTo (random.nextFloat() * 100.0f, random.nextFloat() * 100.0f,
+                                            random.nextFloat() * 100.0f, random.nextFloat() * 100.0f,
+                                            random.nextFloat() * 100.0f, random.nextFloat() * 100.0f); break;
+                }
+            }
+
+            if (random.nextBool())
+                path->closeSubPath();
+
+            sourcePointers.add (path);
+        }
+
+        PathBatch batch (3);
+
+        beginTest ("Batch stroking matches stroking each path individually");
+        {
+            const PathStrokeType strokeType (2.5f, PathStrokeType::curved, PathStrokeType::rounded);
+            const auto transform = AffineTransform::rotation (0.3f).scaled (1.5f);
+
+            OwnedArray<Path> results;
+            Array<Path*> resultPointers;
+
+            for (int i = 0; i < sources.size(); ++i)
+                resultPointers.add (results.add (new Path()));
+
+            batch.createStrokedPaths (strokeType, sourcePointers.data(), resultPointers.data(),
+                                      sources.size(), transform);
+
+            for (int i = 0; i < sources.size(); ++i)
+            {
+                Path expected;
+                strokeType.createStrokedPath (expected, *sources[i], transform);
+                expect (*results[i] == expected);
+            }
+        }
+
+        beginTest ("Batch flattening matches a serial PathFlatteningIterator");
+        {
+            OwnedArray<Path> results;
+            Array<Path*> resultPointers;
+
+            for (int i = 0; i < sources.size(); ++i)
+                resultPointers.add (results.add (new Path()));
+
+            batch.flattenPaths (sourcePointers.data(), resultPointers.data(), sources.size());
+
+            for (int i = 0; i < sources.size(); ++i)
+            {
+                Path expected;
+
+                for (PathFlatteningIterator it (*sources[i]); it.next();)
+                {
+                    if (it.subPathIndex == 0)
+                        expected.startNewSubPath (it.x1, it.y1);
+
+                    expected.lineTo (it.x2, it.y2);
+
+                    if (it.closesSubPath)
+                        expected.closeSubPath();
+                }
+
+                expect (*results[i] == expected);
+            }
+        }
+
+        beginTest ("Destinations are overwritten and empty batches are harmless");
+        {
+            Path source, dest;
+            source.addRectangle (1.0f, 2.0f, 3.0f, 4.0f);
+            dest.addEllipse (0.0f, 0.0f, 10.0f, 10.0f);
+
+            const Path* sourcePtr = &source;
+            Path* destPtr = &dest;
+
+            batch.flattenPaths (&sourcePtr, &destPtr, 1);
+
+            Path previousContents;
+            previousContents.addEllipse (0.0f, 0.0f, 10.0f, 10.0f);
+            expect (dest != previousContents);
+            expect (dest.getBounds() == source.getBounds());
+
+            batch.flattenPaths (nullptr, nullptr, 0);
+            batch.createStrokedPaths (PathStrokeType (1.0f), nullptr, nullptr, 0);
+        }
+    }
+};
+
+static PathBatchTests pathBatchTests;
+
+} // namespace juce
@@ -192,8 +192,28 @@ public:
     */
     void add (const RectangleList& other)
     {
-        for (auto& r : other)
-            add (r);
+        addMany (other.rects.begin(), other.rects.size());
+    }
+
+    /** Merges an array of rectangles into the list.
+
+        The result covers the union of the list and all the given rectangles,
+        which may overlap each other. For a small total number of rectangles
+        this simply calls add() repeatedly; past a size threshold it switches
+        to a single banded sweep, which avoids the quadratic pairwise clipping
+        that makes large region algebra expensive.
+    */
+    void addMany (const RectangleType* rectanglesToAdd, int numRectangles)
+    {
+        if (rects.size() + numRectangles < bandedOperationThreshold)
+        {
+            for (int i = 0; i < numRectangles; ++i)
+                add (rectanglesToAdd[i]);
+
+            return;
+        }
+
+        performBandedOperation (rectanglesToAdd, numRectangles, false);
     }
 
     /** Removes a rectangular region from the list.
@@ -291,12 +311,32 @@ public:
     */
     bool subtract (const RectangleList& otherList)
     {
-        for (auto& r : otherList)
+        return subtractMany (otherList.rects.begin(), otherList.rects.size());
+    }
+
+    /** Removes an array of rectangular regions from the list.
+
+        Like subtract, but for a whole batch at once: small batches are
+        subtracted one rectangle at a time, while past a size threshold the
+        result is rebuilt with a single banded sweep instead.
+
+        @returns true if the resulting list is non-empty.
+    */
+    bool subtractMany (const RectangleType* rectanglesToSubtract, int numRectangles)
+    {
+        if (rects.size() + numRectangles < bandedOperationThreshold)
         {
-            if (isEmpty())
-                return false;
+            for (int i = 0; i < numRectangles; ++i)
+            {
+                if (isEmpty())
+                    return false;
 
-            subtract (r);
+                subtract (rectanglesToSubtract[i]);
+            }
+        }
+        else
+        {
+            performBandedOperation (rectanglesToSubtract, numRectangles, true);
         }
 
         return ! isEmpty();
@@ -648,6 +688,177 @@ public:
 private:
     //==============================================================================
     Array<RectangleType> rects;
+
+    // Above this combined rectangle count, the bulk operations stop doing
+    // pairwise clipping and rebuild the list with a single banded sweep.
+    enum { bandedOperationThreshold = 64 };
+
+    struct BandItem
+    {
+        ValueType x1, x2, y1, y2;
+        bool isSubtrahend;
+    };
+
+    struct BandSpan
+    {
+        ValueType x1, x2;
+    };
+
+    // Rebuilds the list as the union of its current contents and the given
+    // rectangles (or, when subtracting, the current contents minus them) by
+    // sweeping horizontal bands between consecutive y edges. Each band's
+    // spans are merged in x, and bands with identical spans are coalesced
+    // vertically, so the cost is O(n log n) rather than quadratic.
+    void performBandedOperation (const RectangleType* otherRects, int numOther, bool isSubtraction)
+    {
+        Array<BandItem> items;
+        Array<ValueType> edges;
+        items.ensureStorageAllocated (rects.size() + numOther);
+        edges.ensureStorageAllocated (2 * (rects.size() + numOther));
+
+        auto addItem = [&] (const RectangleType& r, bool isSubtrahend)
+        {
+            if (! r.isEmpty())
+            {
+                items.add ({ r.getX(), r.getRight(), r.getY(), r.getBottom(), isSubtrahend });
+                edges.add (r.getY());
+                edges.add (r.getBottom());
+            }
+        };
+
+        for (auto& r : rects)
+            addItem (r, false);
+
+        for (int i = 0; i < numOther; ++i)
+            addItem (otherRects[i], isSubtraction);
+
+        std::sort (edges.begin(), edges.end());
+        edges.removeRange ((int) (std::unique (edges.begin(), edges.end()) - edges.begin()),
+                           edges.size());
+
+        std::sort (items.begin(), items.end(),
+                   [] (const BandItem& a, const BandItem& b) { return a.y1 < b.y1; });
+
+        Array<RectangleType> result;
+        result.ensureStorageAllocated (rects.size() + numOther);
+
+        Array<int> active;
+        Array<BandSpan> spans, holes, bandSpans;
+
+        int nextItem = 0;
+        int prevBandStart = 0, prevBandEnd = 0;
+        auto prevBottom = ValueType();
+        bool canExtendPrevBand = false;
+
+        for (int band = 0; band + 1 < edges.size(); ++band)
+        {
+            const auto bandTop    = edges.getUnchecked (band);
+            const auto bandBottom = edges.getUnchecked (band + 1);
+
+            while (nextItem < items.size() && items.getReference (nextItem).y1 <= bandTop)
+                active.add (nextItem++);
+
+            for (int i = active.size(); --i >= 0;)
+                if (items.getReference (active.getUnchecked (i)).y2 <= bandTop)
+                    active.remove (i);
+
+            spans.clearQuick();
+            holes.clearQuick();
+            bandSpans.clearQuick();
+
+            for (auto index : active)
+            {
+                auto& item = items.getReference (index);
+                (item.isSubtrahend ? holes : spans).add ({ item.x1, item.x2 });
+            }
+
+            if (! spans.isEmpty())
+            {
+                auto compareSpans = [] (const BandSpan& a, const BandSpan& b) { return a.x1 < b.x1; };
+                std::sort (spans.begin(), spans.end(), compareSpans);
+                std::sort (holes.begin(), holes.end(), compareSpans);
+
+                auto carveSpan = [&] (BandSpan s)
+                {
+                    auto x = s.x1;
+
+                    for (auto& h : holes)
+                    {
+                        if (h.x2 <= x)      continue;
+                        if (h.x1 >= s.x2)   break;
+
+                        if (h.x1 > x)
+                            bandSpans.add ({ x, h.x1 });
+
+                        x = jmax (x, h.x2);
+
+                        if (x >= s.x2)
+                            break;
+                    }
+
+                    if (x < s.x2)
+                        bandSpans.add ({ x, s.x2 });
+                };
+
+                auto current = spans.getReference (0);
+
+                for (int i = 1; i <= spans.size(); ++i)
+                {
+                    if (i < spans.size() && spans.getReference (i).x1 <= current.x2)
+                    {
+                        current.x2 = jmax (current.x2, spans.getReference (i).x2);
+                    }
+                    else
+                    {
+                        carveSpan (current);
+
+                        if (i < spans.size())
+                            current = spans.getReference (i);
+                    }
+                }
+            }
+
+            if (bandSpans.isEmpty())
+            {
+                canExtendPrevBand = false;
+                continue;
+            }
+
+            auto matchesPrevBand = canExtendPrevBand
+                                    && prevBottom == bandTop
+                                    && prevBandEnd - prevBandStart == bandSpans.size();
+
+            for (int i = 0; matchesPrevBand && i < bandSpans.size(); ++i)
+            {
+                auto& prev = result.getReference (prevBandStart + i);
+                matchesPrevBand = prev.getX() == bandSpans.getReference (i).x1
+                                   && prev.getRight() == bandSpans.getReference (i).x2;
+            }
+
+            if (matchesPrevBand)
+            {
+                for (int i = prevBandStart; i < prevBandEnd; ++i)
+                {
+                    auto& r = result.getReference (i);
+                    r.setHeight (bandBottom - r.getY());
+                }
+            }
+            else
+            {
+                prevBandStart = result.size();
+
+                for (auto& s : bandSpans)
+                    result.add (RectangleType (s.x1, bandTop, s.x2 - s.x1, bandBottom - bandTop));
+
+                prevBandEnd = result.size();
+                canExtendPrevBand = true;
+            }
+
+            prevBottom = bandBottom;
+        }
+
+        rects.swapWith (result);
+    }
 };
 
 } // namespace juce
@@ -0,0 +1,182 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class RectangleListTests  : public UnitTest
+{
+public:
+    RectangleListTests()
+        : UnitTest ("RectangleList", UnitTestCategories::graphics) {}
+
+    static int64 computeArea (const RectangleList<int>& list)
+    {
+        int64 total = 0;
+
+        for (auto& r : list)
+            total += (int64) r.getWidth() * (int64) r.getHeight();
+
+        return total;
+    }
+
+    static bool hasNoOverlaps (const RectangleList<int>& list)
+    {
+        for (auto& a : list)
+            for (auto& b : list)
+                if (&a != &b && a.intersects (b))
+                    return false;
+
+        return true;
+    }
+
+    // Checks region equality by naive per-rectangle subtraction in both
+    // directions, so the banded path is never used to validate itself.
+    static bool coversSameRegion (const RectangleList<int>& a, const RectangleList<int>& b)
+    {
+        auto differenceIsEmpty = [] (const RectangleList<int>& x, const RectangleList<int>& y)
+        {
+            RectangleList<int> remainder;
+
+            for (auto& r : x)
+                remainder.addWithoutMerging (r);
+
+            for (auto& r : y)
+                remainder.subtract (r);
+
+            return remainder.isEmpty();
+        };
+
+        return differenceIsEmpty (a, b) && differenceIsEmpty (b, a);
+    }
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        auto createRandomRect = [&]
+        {
+            return Rectangle<int> (random.nextInt (380), random.nextInt (380),
+                                   1 + random.nextInt (60), 1 + random.nextInt (60));
+        };
+
+        beginTest ("addMany matches repeated add");
+        {
+            Array<Rectangle<int>> rectsToAdd;
+
+            for (int i = 0; i < 150; ++i)
+                rectsToAdd.add (createRandomRect());
+
+            RectangleList<int> expected;
+
+            for (auto& r : rectsToAdd)
+                expected.add (r);
+
+            RectangleList<int> banded;
+            banded.addMany (rectsToAdd.begin(), rectsToAdd.size());
+
+            expect (hasNoOverlaps (banded));
+            expect (coversSameRegion (expected, banded));
+            expectEquals (computeArea (banded), computeArea (expected));
+        }
+
+        beginTest ("subtractMany matches repeated subtract");
+        {
+            Array<Rectangle<int>> rectsToSubtract;
+
+            for (int i = 0; i < 100; ++i)
+                rectsToSubtract.add (createRandomRect());
+
+            RectangleList<int> expected (Rectangle<int> (0, 0, 400, 400));
+
+            for (auto& r : rectsToSubtract)
+                expected.subtract (r);
+
+            RectangleList<int> banded (Rectangle<int> (0, 0, 400, 400));
+            banded.subtractMany (rectsToSubtract.begin(), rectsToSubtract.size());
+
+            expect (hasNoOverlaps (banded));
+            expect (coversSameRegion (expected, banded));
+            expectEquals (computeArea (banded), computeArea (expected));
+        }
+
+        beginTest ("Bulk operations on small and empty batches");
+        {
+            RectangleList<int> list;
+            list.addMany (nullptr, 0);
+            expect (list.isEmpty());
+
+            const Rectangle<int> pair[] = { { 0, 0, 10, 10 }, { 5, 5, 10, 10 } };
+            list.addMany (pair, 2);
+
+            RectangleList<int> expected;
+            expected.add (pair[0]);
+            expected.add (pair[1]);
+
+            expect (coversSameRegion (expected, list));
+
+            const Rectangle<int> everything (0, 0, 20, 20);
+            expect (! list.subtractMany (&everything, 1));
+            expect (list.isEmpty());
+        }
+
+        beginTest ("List-to-list operations use the bulk paths");
+        {
+            RectangleList<int> base, other;
+
+            for (int i = 0; i < 80; ++i)
+                base.add (createRandomRect());
+
+            for (int i = 0; i < 80; ++i)
+                other.add (createRandomRect());
+
+            RectangleList<int> unionOfBoth (base);
+            unionOfBoth.add (other);
+
+            RectangleList<int> expectedUnion;
+
+            for (auto& r : base)         expectedUnion.add (r);
+            for (auto& r : other)        expectedUnion.add (r);
+
+            expect (hasNoOverlaps (unionOfBoth));
+            expect (coversSameRegion (expectedUnion, unionOfBoth));
+
+            RectangleList<int> difference (base);
+            difference.subtract (other);
+
+            RectangleList<int> expectedDifference;
+
+            for (auto& r : base)
+                expectedDifference.addWithoutMerging (r);
+
+            for (auto& r : other)
+                expectedDifference.subtract (r);
+
+            expect (hasNoOverlaps (difference));
+            expect (coversSameRegion (expectedDifference, difference));
+        }
+    }
+};
+
+static RectangleListTests rectangleListTests;
+
+} // namespace juce
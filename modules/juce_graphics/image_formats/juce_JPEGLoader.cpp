@@ -249,11 +249,9 @@ bool JPEGImageFormat::canUnderstand (InputStream& in)
  Image juce_loadWithCoreImage (InputStream& input);
 #endif
 
-Image JPEGImageFormat::decodeImage (InputStream& in)
+#if ! JUCE_USING_COREIMAGE_LOADER
+static Image decodeJPEGImage (InputStream& in, int targetWidth, int targetHeight)
 {
-   #if JUCE_USING_COREIMAGE_LOADER
-    return juce_loadWithCoreImage (in);
-   #else
     using namespace jpeglibNamespace;
     using namespace JPEGHelpers;
 
@@ -291,6 +289,22 @@ Image JPEGImageFormat::decodeImage (InputStream& in)
 
         if (! hasFailed)
         {
+            if (targetWidth > 0 && targetHeight > 0)
+            {
+                // libjpeg can downscale by any factor of M/8 in the DCT domain, which
+                // costs far less than decoding the full image - pick the smallest
+                // factor whose output still covers the requested size.
+                int scale = 8;
+
+                while (scale > 1
+                        && (int) (jpegDecompStruct.image_width  * (unsigned int) (scale - 1) + 7) / 8 >= targetWidth
+                        && (int) (jpegDecompStruct.image_height * (unsigned int) (scale - 1) + 7) / 8 >= targetHeight)
+                    --scale;
+
+                jpegDecompStruct.scale_num = (unsigned int) scale;
+                jpegDecompStruct.scale_denom = 8;
+            }
+
             jpeg_calc_output_dimensions (&jpegDecompStruct);
 
             if (! hasFailed)
@@ -356,6 +370,27 @@ Image JPEGImageFormat::decodeImage (InputStream& in)
     }
 
     return image;
+}
+#endif
+
+Image JPEGImageFormat::decodeImage (InputStream& in)
+{
+   #if JUCE_USING_COREIMAGE_LOADER
+    return juce_loadWithCoreImage (in);
+   #else
+    return decodeJPEGImage (in, 0, 0);
+   #endif
+}
+
+Image JPEGImageFormat::decodeReducedImage (InputStream& in, int targetWidth, int targetHeight)
+{
+   #if JUCE_USING_COREIMAGE_LOADER
+    return decodeImage (in);
+   #else
+    if (targetWidth <= 0 || targetHeight <= 0)
+        return decodeImage (in);
+
+    return decodeJPEGImage (in, targetWidth, targetHeight);
    #endif
 }
 
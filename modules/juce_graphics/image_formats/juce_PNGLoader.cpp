@@ -413,6 +413,58 @@ namespace PNGHelpers
         return false;
     }
 
+    static bool readReducedImageData (png_structp pngReadStruct, png_infop pngInfoStruct, jmp_buf& errorJumpBuf,
+                                      int srcWidth, int srcHeight, png_bytep rowBuffer,
+                                      const Image::BitmapData& destData, bool hasAlphaChan) noexcept
+    {
+        if (setjmp (errorJumpBuf) == 0)
+        {
+            if (png_get_valid (pngReadStruct, pngInfoStruct, PNG_INFO_tRNS))
+                png_set_expand (pngReadStruct);
+
+            png_set_add_alpha (pngReadStruct, 0xff, PNG_FILLER_AFTER);
+
+            // Streams the source one row at a time, keeping only the rows that map
+            // onto the reduced image, so memory use scales with the output size.
+            int nextDestY = 0;
+
+            for (int y = 0; y < srcHeight; ++y)
+            {
+                png_read_row (pngReadStruct, rowBuffer, nullptr);
+
+                while (nextDestY < destData.height
+                        && (int) (((int64) nextDestY * 2 + 1) * srcHeight / ((int64) destData.height * 2)) == y)
+                {
+                    uint8* dest = destData.getLinePointer (nextDestY);
+
+                    for (int x = 0; x < destData.width; ++x)
+                    {
+                        const uint8* src = rowBuffer + 4 * ((((int64) x * 2 + 1) * srcWidth) / ((int64) destData.width * 2));
+
+                        if (hasAlphaChan)
+                        {
+                            ((PixelARGB*) dest)->setARGB (src[3], src[0], src[1], src[2]);
+                            ((PixelARGB*) dest)->premultiply();
+                        }
+                        else
+                        {
+                            ((PixelRGB*) dest)->setARGB (0, src[0], src[1], src[2]);
+                        }
+
+                        dest += destData.pixelStride;
+                    }
+
+                    ++nextDestY;
+                }
+            }
+
+            png_read_end (pngReadStruct, pngInfoStruct);
+            return true;
+        }
+
+        return false;
+    }
+
     JUCE_END_IGNORE_WARNINGS_MSVC
 
     static Image createImageFromData (bool hasAlphaChan, int width, int height, png_bytepp rows)
@@ -454,7 +506,8 @@ namespace PNGHelpers
         return image;
     }
 
-    static Image readImage (InputStream& in, png_structp pngReadStruct, png_infop pngInfoStruct)
+    static Image readImage (InputStream& in, png_structp pngReadStruct, png_infop pngInfoStruct,
+                            int targetWidth, int targetHeight)
     {
         jmp_buf errorJumpBuf;
         png_set_error_fn (pngReadStruct, &errorJumpBuf, errorCallback, warningCallback);
@@ -465,6 +518,37 @@ namespace PNGHelpers
         if (readHeader (in, pngReadStruct, pngInfoStruct, errorJumpBuf,
                         width, height, bitDepth, colorType, interlaceType))
         {
+            png_bytep trans_alpha = nullptr;
+            png_color_16p trans_color = nullptr;
+            int num_trans = 0;
+            png_get_tRNS (pngReadStruct, pngInfoStruct, &trans_alpha, &num_trans, &trans_color);
+
+            const bool hasAlphaChan = (colorType & PNG_COLOR_MASK_ALPHA) != 0 || num_trans != 0;
+
+            // Interlaced images can't be streamed row-by-row, so they always take
+            // the full-size path.
+            if (targetWidth > 0 && targetHeight > 0
+                 && interlaceType == PNG_INTERLACE_NONE
+                 && ((int) width > targetWidth || (int) height > targetHeight))
+            {
+                auto scale = jmin (1.0, jmax (targetWidth / (double) width, targetHeight / (double) height));
+                auto destWidth  = jlimit (1, (int) width,  (int) std::ceil (width  * scale));
+                auto destHeight = jlimit (1, (int) height, (int) std::ceil (height * scale));
+
+                Image image (hasAlphaChan ? Image::ARGB : Image::RGB, destWidth, destHeight, hasAlphaChan);
+                image.getProperties()->set ("originalImageHadAlpha", hasAlphaChan);
+
+                const Image::BitmapData destData (image, Image::BitmapData::writeOnly);
+                HeapBlock<uint8> rowBuffer (width * 4);
+
+                if (readReducedImageData (pngReadStruct, pngInfoStruct, errorJumpBuf,
+                                          (int) width, (int) height, rowBuffer,
+                                          destData, image.hasAlphaChannel()))
+                    return image;
+
+                return {};
+            }
+
             // Load the image into a temp buffer..
             const size_t lineStride = width * 4;
             HeapBlock<uint8> tempBuffer (height * lineStride);
@@ -473,26 +557,20 @@ namespace PNGHelpers
             for (size_t y = 0; y < height; ++y)
                 rows[y] = (png_bytep) (tempBuffer + lineStride * y);
 
-            png_bytep trans_alpha = nullptr;
-            png_color_16p trans_color = nullptr;
-            int num_trans = 0;
-            png_get_tRNS (pngReadStruct, pngInfoStruct, &trans_alpha, &num_trans, &trans_color);
-
             if (readImageData (pngReadStruct, pngInfoStruct, errorJumpBuf, rows))
-                return createImageFromData ((colorType & PNG_COLOR_MASK_ALPHA) != 0 || num_trans != 0,
-                                            (int) width, (int) height, rows);
+                return createImageFromData (hasAlphaChan, (int) width, (int) height, rows);
         }
 
         return Image();
     }
 
-    static Image readImage (InputStream& in)
+    static Image readImage (InputStream& in, int targetWidth = 0, int targetHeight = 0)
     {
         if (png_structp pngReadStruct = png_create_read_struct (PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr))
         {
             if (png_infop pngInfoStruct = png_create_info_struct (pngReadStruct))
             {
-                Image image (readImage (in, pngReadStruct, pngInfoStruct));
+                Image image (readImage (in, pngReadStruct, pngInfoStruct, targetWidth, targetHeight));
                 png_destroy_read_struct (&pngReadStruct, &pngInfoStruct, nullptr);
                 return image;
             }
@@ -536,6 +614,18 @@ Image PNGImageFormat::decodeImage (InputStream& in)
    #endif
 }
 
+Image PNGImageFormat::decodeReducedImage (InputStream& in, int targetWidth, int targetHeight)
+{
+   #if JUCE_USING_COREIMAGE_LOADER
+    return decodeImage (in);
+   #else
+    if (targetWidth <= 0 || targetHeight <= 0)
+        return decodeImage (in);
+
+    return PNGHelpers::readImage (in, targetWidth, targetHeight);
+   #endif
+}
+
 bool PNGImageFormat::writeImageToStream (const Image& image, OutputStream& out)
 {
     using namespace pnglibNamespace;
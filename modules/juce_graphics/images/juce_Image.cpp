@@ -40,7 +40,12 @@ ImagePixelData::~ImagePixelData()
 
 void ImagePixelData::sendDataChangeMessage()
 {
-    listeners.call ([this] (Listener& l) { l.imageDataChanged (this); });
+    sendDataChangeMessage (Rectangle<int> (width, height));
+}
+
+void ImagePixelData::sendDataChangeMessage (const Rectangle<int>& area)
+{
+    listeners.call ([this, area] (Listener& l) { l.imageAreaChanged (this, area); });
 }
 
 int ImagePixelData::getSharedCount() const noexcept
@@ -48,6 +53,11 @@ int ImagePixelData::getSharedCount() const noexcept
     return getReferenceCount();
 }
 
+ImagePixelData::Residency ImagePixelData::getResidency() const noexcept
+{
+    return Residency::software;
+}
+
 //==============================================================================
 ImageType::ImageType() {}
 ImageType::~ImageType() {}
@@ -103,9 +113,6 @@ public:
         bitmap.pixelFormat = pixelFormat;
         bitmap.lineStride = lineStride;
         bitmap.pixelStride = pixelStride;
-
-        if (mode != Image::BitmapData::readOnly)
-            sendDataChangeMessage();
     }
 
     ImagePixelData::Ptr clone() override
@@ -174,9 +181,14 @@ public:
     void initialiseBitmapData (Image::BitmapData& bitmap, int x, int y, Image::BitmapData::ReadWriteMode mode) override
     {
         sourceImage->initialiseBitmapData (bitmap, x + area.getX(), y + area.getY(), mode);
+    }
+
+    void sendDataChangeMessage (const Rectangle<int>& changedArea) override
+    {
+        ImagePixelData::sendDataChangeMessage (changedArea);
 
-        if (mode != Image::BitmapData::readOnly)
-            sendDataChangeMessage();
+        // the image that owns the data needs to hear about the change too
+        sourceImage->sendDataChangeMessage (changedArea + area.getPosition());
     }
 
     ImagePixelData::Ptr clone() override
@@ -386,6 +398,9 @@ Image::BitmapData::BitmapData (Image& im, int x, int y, int w, int h, BitmapData
 
     im.image->initialiseBitmapData (*this, x, y, mode);
     jassert (data != nullptr && pixelStride > 0 && lineStride != 0);
+
+    if (mode != readOnly)
+        im.image->sendDataChangeMessage (Rectangle<int> (x, y, w, h));
 }
 
 Image::BitmapData::BitmapData (const Image& im, int x, int y, int w, int h)
@@ -408,6 +423,9 @@ Image::BitmapData::BitmapData (const Image& im, BitmapData::ReadWriteMode mode)
 
     im.image->initialiseBitmapData (*this, 0, 0, mode);
     jassert (data != nullptr && pixelStride > 0 && lineStride != 0);
+
+    if (mode != readOnly)
+        im.image->sendDataChangeMessage (Rectangle<int> (width, height));
 }
 
 Image::BitmapData::~BitmapData()
@@ -463,7 +463,26 @@ public:
         can internally depend on another ImagePixelData via it's member variables. */
     virtual int getSharedCount() const noexcept;
 
+    //==============================================================================
+    /** The kinds of memory in which an image's pixels can currently live.
+        @see getResidency
+    */
+    enum class Residency
+    {
+        software,   /**< The pixels live in CPU memory only. */
+        hardware,   /**< The pixels live in GPU memory only, so BitmapData access implies a readback. */
+        shared      /**< CPU and GPU copies are both kept, with changes synced lazily. */
+    };
+
+    /** Returns where this image's pixel data currently lives.
+
+        Renderers can use this to pick a paint path that avoids copying the
+        pixels between CPU and GPU memory. The default implementation returns
+        Residency::software, which is correct for plain in-memory images.
+    */
+    virtual Residency getResidency() const noexcept;
 
+    //==============================================================================
     /** The pixel format of the image data. */
     const Image::PixelFormat pixelFormat;
     const int width, height;
@@ -480,6 +499,16 @@ public:
         virtual ~Listener() = default;
 
         virtual void imageDataChanged (ImagePixelData*) = 0;
+
+        /** Called when a known area of the image may have changed.
+
+            The default implementation just calls imageDataChanged(), so
+            listeners which don't care about the area involved can ignore
+            this method. The area is the smallest rectangle that the writer
+            could determine - it may cover the whole image.
+        */
+        virtual void imageAreaChanged (ImagePixelData* image, const Rectangle<int>&)    { imageDataChanged (image); }
+
         virtual void imageDataBeingDeleted (ImagePixelData*) = 0;
     };
 
@@ -487,6 +516,12 @@ public:
 
     void sendDataChangeMessage();
 
+    /** Tells any listeners that the given area of the image may have changed.
+        Subclasses which are views onto another image can override this to
+        pass the change on to the image that holds the real data.
+    */
+    virtual void sendDataChangeMessage (const Rectangle<int>& area);
+
 private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ImagePixelData)
 };
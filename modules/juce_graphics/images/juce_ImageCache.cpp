@@ -29,8 +29,16 @@ namespace juce
 struct ImageCache::Pimpl     : private Timer,
                                private DeletedAtShutdown
 {
-    Pimpl() = default;
-    ~Pimpl() override { clearSingletonInstance(); }
+    Pimpl()
+    {
+        StartupProfile::recordEvent ("ImageCache created");
+    }
+
+    ~Pimpl() override
+    {
+        pool.reset(); // waits for any decode jobs that refer to this object
+        clearSingletonInstance();
+    }
 
     JUCE_DECLARE_SINGLETON (ImageCache::Pimpl, false)
 
@@ -59,6 +67,81 @@ struct ImageCache::Pimpl     : private Timer,
 
             const ScopedLock sl (lock);
             images.add ({ image, hashCode, Time::getApproximateMillisecondCounter() });
+            enforceByteBudget();
+        }
+    }
+
+    //==============================================================================
+    void loadAsync (const File& file, std::function<void (const Image&)> callback, int priority)
+    {
+        auto hashCode = file.hashCode64();
+        auto cached = getFromHashCode (hashCode);
+
+        if (cached.isValid())
+        {
+            if (callback != nullptr)
+                callback (cached);
+
+            return;
+        }
+
+        bool isNewRequest = false;
+
+        {
+            const ScopedLock sl (lock);
+            auto* request = findPendingRequest (hashCode);
+
+            if (request == nullptr)
+            {
+                request = pending.add (new PendingRequest());
+                request->file = file;
+                request->hashCode = hashCode;
+                request->priority = priority;
+                isNewRequest = true;
+            }
+            else
+            {
+                // several requests for the same file share one decode, at the
+                // highest priority that anything has asked for
+                request->priority = jmax (request->priority, priority);
+            }
+
+            if (callback != nullptr)
+                request->callbacks.add (std::move (callback));
+        }
+
+        if (isNewRequest)
+            getPool().addJob ([this] { decodeNextPendingRequest(); });
+    }
+
+    void decodeNextPendingRequest()
+    {
+        std::unique_ptr<PendingRequest> request;
+
+        {
+            const ScopedLock sl (lock);
+            int best = -1;
+
+            for (int i = 0; i < pending.size(); ++i)
+                if (best < 0 || pending.getUnchecked (i)->priority > pending.getUnchecked (best)->priority)
+                    best = i;
+
+            if (best < 0)
+                return;
+
+            request.reset (pending.removeAndReturn (best));
+        }
+
+        auto image = ImageFileFormat::loadFrom (request->file);
+        addImageToCache (image, request->hashCode);
+
+        if (! request->callbacks.isEmpty())
+        {
+            MessageManager::callAsync ([callbacks = std::move (request->callbacks), image]
+            {
+                for (auto& callback : callbacks)
+                    callback (image);
+            });
         }
     }
 
@@ -103,9 +186,80 @@ struct ImageCache::Pimpl     : private Timer,
         uint32 lastUseTime;
     };
 
+    struct PendingRequest
+    {
+        File file;
+        int64 hashCode;
+        int priority;
+        Array<std::function<void (const Image&)>> callbacks;
+    };
+
+    PendingRequest* findPendingRequest (int64 hashCode) const noexcept
+    {
+        // called with the lock held
+        for (auto* request : pending)
+            if (request->hashCode == hashCode)
+                return request;
+
+        return nullptr;
+    }
+
+    ThreadPool& getPool()
+    {
+        const ScopedLock sl (lock);
+
+        if (pool == nullptr)
+            pool = std::make_unique<ThreadPool> (jlimit (1, 4, SystemStats::getNumCpus() / 2));
+
+        return *pool;
+    }
+
+    void enforceByteBudget()
+    {
+        // called with the lock held
+        if (maxCacheSizeBytes <= 0)
+            return;
+
+        int64 total = 0;
+
+        for (auto& item : images)
+            total += getPixelDataBytes (item.image);
+
+        while (total > maxCacheSizeBytes)
+        {
+            int oldest = -1;
+
+            for (int i = 0; i < images.size(); ++i)
+            {
+                auto& item = images.getReference (i);
+
+                if (item.image.getReferenceCount() <= 1
+                     && (oldest < 0 || item.lastUseTime < images.getReference (oldest).lastUseTime))
+                    oldest = i;
+            }
+
+            if (oldest < 0)
+                break; // everything left is still referenced elsewhere
+
+            total -= getPixelDataBytes (images.getReference (oldest).image);
+            images.remove (oldest);
+        }
+    }
+
+    static int64 getPixelDataBytes (const Image& image) noexcept
+    {
+        auto bytesPerPixel = image.getFormat() == Image::ARGB ? 4
+                           : image.getFormat() == Image::RGB  ? 3 : 1;
+
+        return (int64) image.getWidth() * image.getHeight() * bytesPerPixel;
+    }
+
     Array<Item> images;
+    OwnedArray<PendingRequest> pending;
+    std::unique_ptr<ThreadPool> pool;
     CriticalSection lock;
     unsigned int cacheTimeout = 5000;
+    int64 maxCacheSizeBytes = 0;
 
     JUCE_DECLARE_NON_COPYABLE (Pimpl)
 };
@@ -155,12 +309,37 @@ Image ImageCache::getFromMemory (const void* imageData, const int dataSize)
     return image;
 }
 
+void ImageCache::getFromFileAsync (const File& file,
+                                   std::function<void (const Image&)> callback,
+                                   int priority)
+{
+    // the result is only delivered through the callback, so it must be valid
+    jassert (callback != nullptr);
+
+    Pimpl::getInstance()->loadAsync (file, std::move (callback), priority);
+}
+
+void ImageCache::prefetchFile (const File& file, int priority)
+{
+    Pimpl::getInstance()->loadAsync (file, nullptr, priority);
+}
+
 void ImageCache::setCacheTimeout (const int millisecs)
 {
     jassert (millisecs >= 0);
     Pimpl::getInstance()->cacheTimeout = (unsigned int) millisecs;
 }
 
+void ImageCache::setMaxCacheSizeBytes (const int64 numBytes)
+{
+    jassert (numBytes >= 0);
+
+    auto& cache = *Pimpl::getInstance();
+    const ScopedLock sl (cache.lock);
+    cache.maxCacheSizeBytes = numBytes;
+    cache.enforceByteBudget();
+}
+
 void ImageCache::releaseUnusedImages()
 {
     Pimpl::getInstance()->releaseUnusedImages();
@@ -80,6 +80,42 @@ public:
     */
     static Image getFromMemory (const void* imageData, int dataSize);
 
+    //==============================================================================
+    /** Asynchronously loads an image from a file, without ever decoding pixels on
+        the calling thread.
+
+        If the image is already cached the callback is invoked immediately, before
+        this returns. Otherwise the file is decoded on a shared background pool and
+        the callback is invoked later on the message thread, with the loaded image,
+        or with an invalid image if loading failed.
+
+        When several requests for the same file are outstanding, they share a
+        single decode, and the highest requested priority wins. Higher priority
+        values are decoded first, so a scrolling view can, for instance, request
+        the images entering the viewport with a high priority while pre-fetching
+        further ahead with a lower one.
+
+        @param file       the file to try to load
+        @param callback   called on the message thread with the result; must be non-null
+        @param priority   requests with a higher priority are decoded first
+        @see getFromFile, prefetchFile
+    */
+    static void getFromFileAsync (const File& file,
+                                  std::function<void (const Image&)> callback,
+                                  int priority = 0);
+
+    /** Hints that an image file will probably be needed soon.
+
+        This queues a low-priority background decode of the file into the cache,
+        so that a later call to getFromFile() or getFromFileAsync() is likely to
+        hit. Use it to warm the cache ahead of time - e.g. for the items a list is
+        about to scroll to, scaling the priority or number of files pre-fetched by
+        the scroll velocity.
+
+        @see getFromFileAsync
+    */
+    static void prefetchFile (const File& file, int priority = -100);
+
     //==============================================================================
     /** Checks the cache for an image with a particular hashcode.
 
@@ -108,6 +144,15 @@ public:
     */
     static void setCacheTimeout (int millisecs);
 
+    /** Sets a limit on the total size of the pixel data held by the cache.
+
+        When adding an image would take the cache beyond this many bytes, the
+        least-recently-used images that aren't referenced by any active Image
+        objects are dropped first. A value of 0 (the default) means no byte
+        limit, leaving just the time-based expiry.
+    */
+    static void setMaxCacheSizeBytes (int64 numBytes);
+
     /** Releases any images in the cache that aren't being referenced by active
         Image objects.
     */
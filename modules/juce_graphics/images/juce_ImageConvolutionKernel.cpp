@@ -101,6 +101,217 @@ void ImageConvolutionKernel::createGaussianBlur (const float radius)
     setOverallSum (1.0f);
 }
 
+//==============================================================================
+bool ImageConvolutionKernel::getSeparableComponents (HeapBlock<float>& horizontal,
+                                                     HeapBlock<float>& vertical) const
+{
+    int pivotX = 0, pivotY = 0;
+    float maxAbsValue = 0;
+
+    for (int y = 0; y < size; ++y)
+    {
+        for (int x = 0; x < size; ++x)
+        {
+            const float v = std::abs (values [x + y * size]);
+
+            if (v > maxAbsValue)
+            {
+                maxAbsValue = v;
+                pivotX = x;
+                pivotY = y;
+            }
+        }
+    }
+
+    if (maxAbsValue <= 0)
+        return false;
+
+    horizontal.malloc (size);
+    vertical.malloc (size);
+
+    const float pivot = values [pivotX + pivotY * size];
+
+    for (int x = 0; x < size; ++x)
+        horizontal[x] = values [x + pivotY * size];
+
+    for (int y = 0; y < size; ++y)
+        vertical[y] = values [pivotX + y * size] / pivot;
+
+    // the kernel is separable if every value matches the outer product of
+    // these two vectors, allowing a little slack for rounding
+    const float tolerance = maxAbsValue * 1.0e-4f;
+
+    for (int y = 0; y < size; ++y)
+        for (int x = 0; x < size; ++x)
+            if (std::abs (values [x + y * size] - horizontal[x] * vertical[y]) > tolerance)
+                return false;
+
+    return true;
+}
+
+static void applySeparableKernel (const Image::BitmapData& destData,
+                                  const Image::BitmapData& srcData,
+                                  const Rectangle<int>& area,
+                                  const float* horizontal,
+                                  const float* vertical,
+                                  const int size)
+{
+    const int half = size >> 1;
+    const int lastTap = size - 1 - half;
+    const int w = area.getWidth();
+    const int stride = destData.pixelStride;
+    const int rowFloats = w * stride;
+
+    // a ring buffer holding the horizontally-filtered version of each source
+    // row that the vertical pass currently needs
+    HeapBlock<float> ring ((size_t) rowFloats * (size_t) size);
+
+    auto getRingRow = [&] (int sourceY) noexcept
+    {
+        return ring.get() + (size_t) rowFloats * (size_t) (((sourceY % size) + size) % size);
+    };
+
+    auto filterRowHorizontally = [&] (int sourceY) noexcept
+    {
+        auto* filtered = getRingRow (sourceY);
+
+        if (! isPositiveAndBelow (sourceY, srcData.height))
+        {
+            zeromem (filtered, (size_t) rowFloats * sizeof (float));
+            return;
+        }
+
+        for (int x = 0; x < w; ++x)
+        {
+            float sums[4] = {};
+            const int firstX = area.getX() + x - half;
+
+            for (int xx = 0; xx < size; ++xx)
+            {
+                const int sx = firstX + xx;
+
+                if (isPositiveAndBelow (sx, srcData.width))
+                {
+                    const float kernelMult = horizontal[xx];
+                    const uint8* src = srcData.getPixelPointer (sx, sourceY);
+
+                    for (int c = 0; c < stride; ++c)
+                        sums[c] += kernelMult * src[c];
+                }
+            }
+
+            for (int c = 0; c < stride; ++c)
+                filtered [x * stride + c] = sums[c];
+        }
+    };
+
+    for (int sy = area.getY() - half; sy < area.getY() + lastTap; ++sy)
+        filterRowHorizontally (sy);
+
+    uint8* line = destData.data;
+
+    for (int y = area.getY(); y < area.getBottom(); ++y)
+    {
+        filterRowHorizontally (y + lastTap);
+
+        uint8* dest = line;
+        line += destData.lineStride;
+
+        for (int x = 0; x < w; ++x)
+        {
+            float sums[4] = {};
+
+            for (int yy = 0; yy < size; ++yy)
+            {
+                const float kernelMult = vertical[yy];
+                const float* filtered = getRingRow (y + yy - half) + x * stride;
+
+                for (int c = 0; c < stride; ++c)
+                    sums[c] += kernelMult * filtered[c];
+            }
+
+            if (stride == 4)
+                for (int c = 0; c < stride; ++c)
+                    *dest++ = (uint8) jmin (0xff, roundToInt (sums[c]));
+            else
+                for (int c = 0; c < stride; ++c)
+                    *dest++ = (uint8) roundToInt (sums[c]);
+        }
+    }
+}
+
+//==============================================================================
+static void boxBlurLine (const uint8* src, uint8* dest, int numPixels, int step, int radius) noexcept
+{
+    const int windowSize = radius * 2 + 1;
+    const int last = numPixels - 1;
+    int sum = src[0] * (radius + 1);
+
+    for (int i = 1; i <= radius; ++i)
+        sum += src [jmin (i, last) * step];
+
+    for (int i = 0; i < numPixels; ++i)
+    {
+        dest [i * step] = (uint8) ((sum + windowSize / 2) / windowSize);
+
+        sum += src [jmin (i + radius + 1, last) * step]
+             - src [jmax (i - radius, 0) * step];
+    }
+}
+
+static void applyBoxBlurPass (const Image::BitmapData& data, uint8* temp, int radius) noexcept
+{
+    for (int y = 0; y < data.height; ++y)
+    {
+        const uint8* src = data.data + (size_t) y * (size_t) data.lineStride;
+        uint8* dest      = temp      + (size_t) y * (size_t) data.lineStride;
+
+        for (int c = 0; c < data.pixelStride; ++c)
+            boxBlurLine (src + c, dest + c, data.width, data.pixelStride, radius);
+    }
+
+    for (int x = 0; x < data.width; ++x)
+    {
+        for (int c = 0; c < data.pixelStride; ++c)
+        {
+            const size_t offset = (size_t) x * (size_t) data.pixelStride + (size_t) c;
+            boxBlurLine (temp + offset, data.data + offset, data.height, data.lineStride, radius);
+        }
+    }
+}
+
+void ImageConvolutionKernel::applyGaussianBlurApproximation (Image& image, float radius)
+{
+    if (image.isNull() || ! (radius >= 1.0f))
+        return;
+
+    image.duplicateIfShared();
+    const Image::BitmapData data (image, Image::BitmapData::readWrite);
+
+    // the widths of three box filters whose repeated application best matches
+    // a gaussian with the given standard deviation
+    const double idealWidth = std::sqrt (4.0 * radius * radius + 1.0);
+    int lowerWidth = (int) idealWidth;
+
+    if ((lowerWidth & 1) == 0)
+        --lowerWidth;
+
+    const int numLowerPasses = roundToInt ((12.0 * radius * radius
+                                              - 3.0 * lowerWidth * lowerWidth
+                                              - 12.0 * lowerWidth - 9.0)
+                                            / (-4.0 * lowerWidth - 4.0));
+
+    HeapBlock<uint8> temp ((size_t) data.lineStride * (size_t) data.height);
+
+    for (int pass = 0; pass < 3; ++pass)
+    {
+        const int boxRadius = ((pass < numLowerPasses ? lowerWidth : lowerWidth + 2) - 1) / 2;
+
+        if (boxRadius > 0)
+            applyBoxBlurPass (data, temp, boxRadius);
+    }
+}
+
 //==============================================================================
 void ImageConvolutionKernel::applyToImage (Image& destImage,
                                            const Image& sourceImage,
@@ -135,6 +346,16 @@ void ImageConvolutionKernel::applyToImage (Image& destImage,
 
     const Image::BitmapData srcData (sourceImage, Image::BitmapData::readOnly);
 
+    {
+        HeapBlock<float> horizontal, vertical;
+
+        if (getSeparableComponents (horizontal, vertical))
+        {
+            applySeparableKernel (destData, srcData, area, horizontal, vertical, size);
+            return;
+        }
+    }
+
     if (destData.pixelStride == 4)
     {
         for (int y = area.getY(); y < bottom; ++y)
@@ -91,6 +91,11 @@ public:
     //==============================================================================
     /** Applies the kernel to an image.
 
+        If the kernel is separable - i.e. it's the outer product of a horizontal and
+        a vertical vector, which is the case for the gaussian kernels produced by
+        createGaussianBlur() - it is applied as two one-dimensional passes, which
+        produces the same result but costs O(k) per pixel rather than O(k^2).
+
         @param destImage        the image that will receive the resultant convoluted pixels.
         @param sourceImage      the source image to read from - this can be the same image as
                                 the destination, but if different, it must be exactly the same
@@ -101,11 +106,28 @@ public:
                        const Image& sourceImage,
                        const Rectangle<int>& destinationArea) const;
 
+    //==============================================================================
+    /** Blurs an image in-place with a fast approximation of a gaussian blur.
+
+        This runs a chain of three sliding-window box blurs whose combined response
+        closely matches a gaussian of the given radius. The cost per pixel is
+        constant regardless of the radius, so unlike createGaussianBlur() followed
+        by applyToImage(), it stays fast at the large radii used for glows and
+        soft shadows.
+
+        @param image    the image to blur - all of its channels, including alpha,
+                        are blurred
+        @param radius   the standard deviation of the gaussian to approximate
+    */
+    static void applyGaussianBlurApproximation (Image& image, float radius);
+
 private:
     //==============================================================================
     HeapBlock<float> values;
     const int size;
 
+    bool getSeparableComponents (HeapBlock<float>& horizontal, HeapBlock<float>& vertical) const;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ImageConvolutionKernel)
 };
 
@@ -0,0 +1,182 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct ImageConvolutionKernelTests  : public UnitTest
+{
+    ImageConvolutionKernelTests()  : UnitTest ("ImageConvolutionKernel", UnitTestCategories::graphics) {}
+
+    Image createRandomImage (int width, int height)
+    {
+        Image image (Image::ARGB, width, height, false);
+        auto random = getRandom();
+
+        const Image::BitmapData data (image, Image::BitmapData::writeOnly);
+
+        for (int y = 0; y < height; ++y)
+            for (int x = 0; x < width * data.pixelStride; ++x)
+                data.getLinePointer (y) [x] = (uint8) random.nextInt (256);
+
+        return image;
+    }
+
+    // a straightforward O(k^2) convolution, matching the zero-padded edge
+    // handling and rounding of the non-separable path in applyToImage()
+    static Image referenceConvolution (const ImageConvolutionKernel& kernel, const Image& source)
+    {
+        const int size = kernel.getKernelSize();
+        const int half = size >> 1;
+
+        Image result (source.getFormat(), source.getWidth(), source.getHeight(), true);
+
+        const Image::BitmapData srcData (source, Image::BitmapData::readOnly);
+        const Image::BitmapData destData (result, Image::BitmapData::writeOnly);
+
+        for (int y = 0; y < destData.height; ++y)
+        {
+            for (int x = 0; x < destData.width; ++x)
+            {
+                float sums[4] = {};
+
+                for (int yy = 0; yy < size; ++yy)
+                    for (int xx = 0; xx < size; ++xx)
+                        if (isPositiveAndBelow (x + xx - half, srcData.width)
+                             && isPositiveAndBelow (y + yy - half, srcData.height))
+                            for (int c = 0; c < srcData.pixelStride; ++c)
+                                sums[c] += kernel.getKernelValue (xx, yy)
+                                            * srcData.getPixelPointer (x + xx - half, y + yy - half) [c];
+
+                for (int c = 0; c < destData.pixelStride; ++c)
+                    destData.getPixelPointer (x, y) [c] = (uint8) jmin (0xff, roundToInt (sums[c]));
+            }
+        }
+
+        return result;
+    }
+
+    void expectImagesMatch (const Image& actual, const Image& expected, int tolerance)
+    {
+        const Image::BitmapData actualData (actual, Image::BitmapData::readOnly);
+        const Image::BitmapData expectedData (expected, Image::BitmapData::readOnly);
+
+        int largestDifference = 0;
+
+        for (int y = 0; y < actualData.height; ++y)
+            for (int x = 0; x < actualData.width * actualData.pixelStride; ++x)
+                largestDifference = jmax (largestDifference,
+                                          std::abs ((int) actualData.getLinePointer (y) [x]
+                                                     - (int) expectedData.getLinePointer (y) [x]));
+
+        expectLessOrEqual (largestDifference, tolerance);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Separable kernels produce the same result as direct convolution");
+        {
+            auto source = createRandomImage (40, 30);
+
+            ImageConvolutionKernel kernel (7);
+            kernel.createGaussianBlur (2.0f);
+
+            Image blurred (source.getFormat(), source.getWidth(), source.getHeight(), true);
+            kernel.applyToImage (blurred, source, blurred.getBounds());
+
+            // the two passes accumulate in a different order, so allow a little rounding slack
+            expectImagesMatch (blurred, referenceConvolution (kernel, source), 1);
+        }
+
+        beginTest ("Non-separable kernels still work");
+        {
+            auto source = createRandomImage (24, 24);
+            auto random = getRandom();
+
+            ImageConvolutionKernel kernel (5);
+
+            for (int y = 0; y < 5; ++y)
+                for (int x = 0; x < 5; ++x)
+                    kernel.setKernelValue (x, y, random.nextFloat() * 0.1f);
+
+            kernel.setKernelValue (1, 3, 0.5f); // make sure it isn't rank-1
+            kernel.setOverallSum (1.0f);
+
+            Image filtered (source.getFormat(), source.getWidth(), source.getHeight(), true);
+            kernel.applyToImage (filtered, source, filtered.getBounds());
+
+            expectImagesMatch (filtered, referenceConvolution (kernel, source), 1);
+        }
+
+        beginTest ("Gaussian blur approximation");
+        {
+            // a constant image should be unchanged by a blur
+            Image flat (Image::RGB, 50, 50, false);
+            flat.clear (flat.getBounds(), Colour (120, 80, 200));
+
+            ImageConvolutionKernel::applyGaussianBlurApproximation (flat, 8.0f);
+
+            auto centre = flat.getPixelAt (25, 25);
+            expect (std::abs ((int) centre.getRed()   - 120) <= 1);
+            expect (std::abs ((int) centre.getGreen() - 80)  <= 1);
+            expect (std::abs ((int) centre.getBlue()  - 200) <= 1);
+
+            // a bright spot should be spread out, keeping its total energy
+            Image impulse (Image::SingleChannel, 101, 101, true);
+
+            {
+                const Image::BitmapData data (impulse, Image::BitmapData::writeOnly);
+
+                for (int y = 45; y < 56; ++y)
+                    for (int x = 45; x < 56; ++x)
+                        *data.getPixelPointer (x, y) = 255;
+            }
+
+            ImageConvolutionKernel::applyGaussianBlurApproximation (impulse, 6.0f);
+
+            const Image::BitmapData data (impulse, Image::BitmapData::readOnly);
+            int64 total = 0;
+            int maxValue = 0;
+
+            for (int y = 0; y < data.height; ++y)
+            {
+                for (int x = 0; x < data.width; ++x)
+                {
+                    const int v = *data.getPixelPointer (x, y);
+                    total += v;
+                    maxValue = jmax (maxValue, v);
+                }
+            }
+
+            expect (maxValue > 0 && maxValue < 255);                   // the spot has been softened
+            expect (*data.getPixelPointer (50, 35) > 0);               // and spread well beyond its original area
+            expect (std::abs ((double) total / (255.0 * 11 * 11) - 1.0) < 0.05);
+        }
+    }
+};
+
+static ImageConvolutionKernelTests imageConvolutionKernelTests;
+
+} // namespace juce
@@ -50,6 +50,11 @@ private:
     ImageFileFormat* formats[4];
 };
 
+Image ImageFileFormat::decodeReducedImage (InputStream& input, int, int)
+{
+    return decodeImage (input);
+}
+
 ImageFileFormat* ImageFileFormat::findImageFormatForStream (InputStream& input)
 {
     const int64 streamPos = input.getPosition();
@@ -84,6 +84,27 @@ public:
     */
     virtual Image decodeImage (InputStream& input) = 0;
 
+    /** Tries to decode a reduced-size version of the image from the given stream.
+
+        This is intended for thumbnailing: codecs that can decode at a lower
+        resolution for less than the cost of decoding every source pixel will do
+        so. The returned image preserves the source's aspect ratio and will be no
+        smaller than the requested size (unless the source itself is smaller), but
+        it may be larger - it's a cheap starting point, so if you need an exact
+        size, rescale the result, which is far quicker than rescaling the
+        full-resolution image.
+
+        The default implementation just decodes the image at full size.
+
+        @param input          the stream to read the data from, positioned at the
+                              start of the image data
+        @param targetWidth    the minimum width that the result needs to cover
+        @param targetHeight   the minimum height that the result needs to cover
+        @returns              the image that was decoded, or an invalid image if it fails
+        @see decodeImage
+    */
+    virtual Image decodeReducedImage (InputStream& input, int targetWidth, int targetHeight);
+
     //==============================================================================
     /** Attempts to write an image to a stream.
 
@@ -159,6 +180,12 @@ public:
     bool usesFileExtension (const File&) override;
     bool canUnderstand (InputStream&) override;
     Image decodeImage (InputStream&) override;
+
+    /** Decodes a reduced-size image by streaming rows into the target size, so
+        only one source row is held in memory at a time.
+    */
+    Image decodeReducedImage (InputStream&, int targetWidth, int targetHeight) override;
+
     bool writeImageToStream (const Image&, OutputStream&) override;
 };
 
@@ -191,6 +218,12 @@ public:
     bool usesFileExtension (const File&) override;
     bool canUnderstand (InputStream&) override;
     Image decodeImage (InputStream&) override;
+
+    /** Decodes a reduced-size image by downscaling in the DCT domain, so the cost
+        scales with the output size rather than the source size.
+    */
+    Image decodeReducedImage (InputStream&, int targetWidth, int targetHeight) override;
+
     bool writeImageToStream (const Image&, OutputStream&) override;
 
 private:
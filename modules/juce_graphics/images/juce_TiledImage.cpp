@@ -0,0 +1,229 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+TiledImage::TiledImage() noexcept {}
+TiledImage::~TiledImage() {}
+
+TiledImage::TiledImage (Image::PixelFormat formatToUse, int width, int height, int tileSizeToUse)
+    : area (width, height),
+      tileSize (jmax (1, tileSizeToUse)),
+      format (formatToUse)
+{
+    jassert (width > 0 && height > 0); // It's illegal to create a zero-sized image!
+
+    tilesAcross = (width + tileSize - 1) / tileSize;
+    const auto tilesDown = (height + tileSize - 1) / tileSize;
+
+    for (int ty = 0; ty < tilesDown; ++ty)
+        for (int tx = 0; tx < tilesAcross; ++tx)
+            tiles.add (Image (format,
+                              jmin (tileSize, width  - tx * tileSize),
+                              jmin (tileSize, height - ty * tileSize),
+                              true));
+}
+
+TiledImage::TiledImage (const TiledImage& other)
+    : tiles (other.tiles), area (other.area),
+      tileSize (other.tileSize), tilesAcross (other.tilesAcross),
+      format (other.format)
+{
+}
+
+TiledImage& TiledImage::operator= (const TiledImage& other)
+{
+    tiles = other.tiles;
+    area = other.area;
+    tileSize = other.tileSize;
+    tilesAcross = other.tilesAcross;
+    format = other.format;
+    dirtyRegion.clear();
+    return *this;
+}
+
+TiledImage::TiledImage (TiledImage&& other) noexcept
+    : tiles (std::move (other.tiles)), area (other.area),
+      tileSize (other.tileSize), tilesAcross (other.tilesAcross),
+      format (other.format), dirtyRegion (std::move (other.dirtyRegion))
+{
+}
+
+TiledImage& TiledImage::operator= (TiledImage&& other) noexcept
+{
+    tiles = std::move (other.tiles);
+    area = other.area;
+    tileSize = other.tileSize;
+    tilesAcross = other.tilesAcross;
+    format = other.format;
+    dirtyRegion = std::move (other.dirtyRegion);
+    return *this;
+}
+
+//==============================================================================
+Rectangle<int> TiledImage::getTileBounds (int index) const noexcept
+{
+    return tiles.getReference (index).getBounds()
+            .withPosition ((index % tilesAcross) * tileSize,
+                           (index / tilesAcross) * tileSize);
+}
+
+Image& TiledImage::getWritableTile (int index)
+{
+    auto& tile = tiles.getReference (index);
+    tile.duplicateIfShared();
+    return tile;
+}
+
+template <typename TileOperation>
+void TiledImage::forEachTileIntersecting (Rectangle<int> globalArea, TileOperation&& op) const
+{
+    const auto firstTx = globalArea.getX() / tileSize;
+    const auto firstTy = globalArea.getY() / tileSize;
+    const auto lastTx  = (globalArea.getRight()  - 1) / tileSize;
+    const auto lastTy  = (globalArea.getBottom() - 1) / tileSize;
+
+    for (int ty = firstTy; ty <= lastTy; ++ty)
+        for (int tx = firstTx; tx <= lastTx; ++tx)
+            op (ty * tilesAcross + tx);
+}
+
+//==============================================================================
+TiledImage TiledImage::getSubImage (Rectangle<int> areaToView) const
+{
+    const auto clipped = areaToView.getIntersection (getBounds());
+
+    if (clipped.isEmpty())
+        return {};
+
+    TiledImage view (*this);
+    view.area = clipped + area.getPosition();
+    return view;
+}
+
+//==============================================================================
+void TiledImage::clear (Rectangle<int> localArea, Colour colourToClearTo)
+{
+    const auto clipped = localArea.getIntersection (getBounds());
+
+    if (clipped.isEmpty())
+        return;
+
+    const auto global = clipped + area.getPosition();
+
+    forEachTileIntersecting (global, [&] (int index)
+    {
+        const auto tileBounds = getTileBounds (index);
+        const auto target = global.getIntersection (tileBounds);
+
+        getWritableTile (index).clear (target - tileBounds.getPosition(), colourToClearTo);
+    });
+
+    dirtyRegion.add (clipped);
+}
+
+void TiledImage::drawImageAt (const Image& imageToDraw, int x, int y)
+{
+    if (imageToDraw.isNull())
+        return;
+
+    paintArea (imageToDraw.getBounds().withPosition (x, y),
+               [&] (Graphics& g) { g.drawImageAt (imageToDraw, x, y); });
+}
+
+void TiledImage::paintArea (Rectangle<int> localArea, std::function<void (Graphics&)> paintFunction)
+{
+    const auto clipped = localArea.getIntersection (getBounds());
+
+    if (clipped.isEmpty())
+        return;
+
+    const auto global = clipped + area.getPosition();
+
+    forEachTileIntersecting (global, [&] (int index)
+    {
+        const auto tileBounds = getTileBounds (index);
+        const auto target = global.getIntersection (tileBounds);
+
+        Graphics g (getWritableTile (index));
+        g.setOrigin (area.getPosition() - tileBounds.getPosition());
+        g.reduceClipRegion (target - area.getPosition());
+
+        paintFunction (g);
+    });
+
+    dirtyRegion.add (clipped);
+}
+
+//==============================================================================
+void TiledImage::draw (Graphics& g, int x, int y) const
+{
+    forEachTileIntersecting (area, [&] (int index)
+    {
+        const auto tileBounds = getTileBounds (index);
+        const auto visible = area.getIntersection (tileBounds);
+        const auto destination = (visible - area.getPosition()).translated (x, y);
+
+        if (! g.clipRegionIntersects (destination))
+            return;
+
+        g.drawImageAt (tiles.getReference (index).getClippedImage (visible - tileBounds.getPosition()),
+                       destination.getX(), destination.getY());
+    });
+}
+
+Image TiledImage::render (Rectangle<int> localArea) const
+{
+    const auto clipped = localArea.getIntersection (getBounds());
+
+    if (clipped.isEmpty())
+        return {};
+
+    Image result (format, clipped.getWidth(), clipped.getHeight(), true);
+
+    Graphics g (result);
+    g.setOrigin (-clipped.getPosition());
+    draw (g, 0, 0);
+
+    return result;
+}
+
+Image TiledImage::getTileContaining (int x, int y) const noexcept
+{
+    if (! (isPositiveAndBelow (x, getWidth()) && isPositiveAndBelow (y, getHeight())))
+        return {};
+
+    const auto p = Point<int> (x, y) + area.getPosition();
+    return tiles[(p.y / tileSize) * tilesAcross + p.x / tileSize];
+}
+
+//==============================================================================
+void TiledImage::markDirty (Rectangle<int> localArea)
+{
+    dirtyRegion.add (localArea.getIntersection (getBounds()));
+}
+
+} // namespace juce
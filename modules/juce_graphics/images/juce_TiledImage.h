@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An image made of a grid of fixed-size tiles, where each tile is shared and
+    copied-on-write independently.
+
+    A plain Image shares its pixel data between copies, but as soon as one of
+    them needs to be written, duplicateIfShared() copies the entire frame. For
+    large images that are mostly unchanged from copy to copy - layer caches,
+    undo snapshots, compositor back-buffers - that means megabytes of copying
+    to change a few pixels. A TiledImage instead keeps each tile as its own
+    shared Image, so writing through one copy duplicates only the tiles it
+    actually touches.
+
+    Unlike Image, a TiledImage behaves as a value: copies (and sub-images) are
+    cheap, and writing to one never changes the pixels seen by another. Each
+    copy also keeps its own dirty region, accumulating the areas that have
+    been written through it, which a compositor can use to repaint only what
+    changed.
+
+    Use getSubImage() to make a view of a section: the view shares the parent's
+    tiles and tracks its own dirty region, and writing through it copies only
+    the tiles under the written area.
+
+    Note that the tiles are ordinary Image objects, so a TiledImage can't be
+    painted into with an arbitrary Graphics - use paintArea(), which runs a
+    paint callback over each touched tile, or the clear() and drawImageAt()
+    helpers.
+
+    @see Image, Image::duplicateIfShared, Graphics
+
+    @tags{Graphics}
+*/
+class JUCE_API  TiledImage
+{
+public:
+    //==============================================================================
+    /** The tile edge length used when none is specified. */
+    static constexpr int defaultTileSize = 128;
+
+    /** Creates a null tiled image. */
+    TiledImage() noexcept;
+
+    /** Creates a cleared tiled image of the given size.
+
+        The tile size trades sharing granularity against per-tile overhead:
+        smaller tiles mean less copying per write, but more objects and more
+        draw calls when compositing.
+    */
+    TiledImage (Image::PixelFormat format, int width, int height,
+                int tileSizeToUse = defaultTileSize);
+
+    /** Creates a copy that shares every tile with the original.
+        The pixel data is only copied, tile by tile, when one of the copies is
+        written to. The new copy starts with an empty dirty region.
+    */
+    TiledImage (const TiledImage&);
+
+    /** Shares the other image's tiles, starting with an empty dirty region. */
+    TiledImage& operator= (const TiledImage&);
+
+    /** Move constructor. */
+    TiledImage (TiledImage&&) noexcept;
+
+    /** Move assignment operator. */
+    TiledImage& operator= (TiledImage&&) noexcept;
+
+    /** Destructor. */
+    ~TiledImage();
+
+    //==============================================================================
+    /** Returns true if this image holds pixels. */
+    bool isValid() const noexcept                       { return tiles.size() > 0; }
+
+    /** Returns true if this is a default-constructed, empty image. */
+    bool isNull() const noexcept                        { return ! isValid(); }
+
+    /** Returns the width in pixels. */
+    int getWidth() const noexcept                       { return area.getWidth(); }
+
+    /** Returns the height in pixels. */
+    int getHeight() const noexcept                      { return area.getHeight(); }
+
+    /** Returns the bounds, with the position at (0, 0). */
+    Rectangle<int> getBounds() const noexcept           { return area.withZeroOrigin(); }
+
+    /** Returns the pixel format shared by all the tiles. */
+    Image::PixelFormat getFormat() const noexcept       { return format; }
+
+    /** Returns the edge length of the tiles. */
+    int getTileSize() const noexcept                    { return tileSize; }
+
+    //==============================================================================
+    /** Returns a view of a section of this image.
+
+        The view shares this image's tiles, so creating it copies nothing, and
+        it has its own, initially empty, dirty region. Writing through the
+        view copies only the tiles under the written area, and never changes
+        the pixels seen by this image.
+    */
+    TiledImage getSubImage (Rectangle<int> areaToView) const;
+
+    //==============================================================================
+    /** Fills an area with a colour, copying only the tiles the area touches. */
+    void clear (Rectangle<int> localArea, Colour colourToClearTo = Colour (0x00000000));
+
+    /** Draws another image on top of this one, copying only the touched tiles. */
+    void drawImageAt (const Image& imageToDraw, int x, int y);
+
+    /** Runs a paint callback over the tiles that intersect an area.
+
+        The callback may be invoked several times, once per touched tile, with
+        a Graphics whose origin and clip are set up so that it can simply
+        paint in this image's own coordinate space. Only the touched tiles are
+        copied, and the area is added to the dirty region.
+
+        As each tile is rasterised separately, antialiased coverage along the
+        tile seams can differ by a level or two from painting the same thing
+        into a single Image, just as it does when painting with a reduced clip
+        region.
+    */
+    void paintArea (Rectangle<int> localArea, std::function<void (Graphics&)> paintFunction);
+
+    //==============================================================================
+    /** Draws this image into a Graphics context at the given position.
+        Tiles that fall outside the context's clip region are skipped.
+    */
+    void draw (Graphics& g, int x, int y) const;
+
+    /** Flattens an area of this image into a single, freshly-allocated Image. */
+    Image render (Rectangle<int> localArea) const;
+
+    /** Returns the tile holding the given position, sharing its pixel data.
+
+        Note that for a sub-image view, the returned tile can extend beyond the
+        view's bounds. Returns a null image if the position is out of range.
+    */
+    Image getTileContaining (int x, int y) const noexcept;
+
+    //==============================================================================
+    /** Returns the areas that have been written through this particular copy
+        since its dirty region was last cleared.
+    */
+    const RectangleList<int>& getDirtyRegion() const noexcept   { return dirtyRegion; }
+
+    /** Adds an area to the dirty region without touching any pixels. */
+    void markDirty (Rectangle<int> localArea);
+
+    /** Empties the dirty region, e.g. after the changes have been composited. */
+    void clearDirtyRegion()                             { dirtyRegion.clear(); }
+
+private:
+    //==============================================================================
+    Array<Image> tiles;
+    Rectangle<int> area;
+    int tileSize = 0, tilesAcross = 0;
+    Image::PixelFormat format = Image::UnknownFormat;
+    RectangleList<int> dirtyRegion;
+
+    Rectangle<int> getTileBounds (int index) const noexcept;
+    Image& getWritableTile (int index);
+
+    template <typename TileOperation>
+    void forEachTileIntersecting (Rectangle<int> globalArea, TileOperation&& op) const;
+
+    JUCE_LEAK_DETECTOR (TiledImage)
+};
+
+} // namespace juce
@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct TiledImageTests  : public UnitTest
+{
+    TiledImageTests()  : UnitTest ("TiledImage", UnitTestCategories::graphics) {}
+
+    static bool tilesAreShared (const TiledImage& a, const TiledImage& b, int x, int y)
+    {
+        return a.getTileContaining (x, y).getPixelData() == b.getTileContaining (x, y).getPixelData();
+    }
+
+    // The software renderer's antialiased coverage can differ by a couple of
+    // levels at the edge of a clip region, so pixels along the tile seams are
+    // compared with a small tolerance rather than exactly.
+    static bool coloursRoughlyEqual (Colour a, Colour b) noexcept
+    {
+        return std::abs ((int) a.getAlpha() - (int) b.getAlpha()) <= 2
+            && std::abs ((int) a.getRed()   - (int) b.getRed())   <= 2
+            && std::abs ((int) a.getGreen() - (int) b.getGreen()) <= 2
+            && std::abs ((int) a.getBlue()  - (int) b.getBlue())  <= 2;
+    }
+
+    void runTest() override
+    {
+        beginTest ("Copies share tiles until they are written to");
+        {
+            TiledImage original (Image::ARGB, 300, 300, 128);
+            TiledImage copy (original);
+
+            expect (tilesAreShared (original, copy, 0, 0));
+            expect (tilesAreShared (original, copy, 200, 200));
+
+            copy.clear ({ 0, 0, 10, 10 }, Colours::red);
+
+            expect (! tilesAreShared (original, copy, 0, 0));
+            expect (tilesAreShared (original, copy, 200, 0));
+            expect (tilesAreShared (original, copy, 0, 200));
+            expect (tilesAreShared (original, copy, 200, 200));
+
+            expectEquals ((int) original.render ({ 0, 0, 10, 10 }).getPixelAt (5, 5).getARGB(), 0);
+            expect (copy.render ({ 0, 0, 10, 10 }).getPixelAt (5, 5) == Colours::red);
+        }
+
+        beginTest ("Each copy tracks its own dirty region");
+        {
+            TiledImage a (Image::ARGB, 256, 256);
+            a.clear ({ 0, 0, 5, 5 }, Colours::white);
+
+            TiledImage b (a);
+            expect (! a.getDirtyRegion().isEmpty());
+            expect (b.getDirtyRegion().isEmpty());
+
+            b.clear ({ 100, 100, 5, 5 }, Colours::white);
+            expectEquals (b.getDirtyRegion().getBounds().toString(),
+                          Rectangle<int> (100, 100, 5, 5).toString());
+            expectEquals (a.getDirtyRegion().getBounds().toString(),
+                          Rectangle<int> (0, 0, 5, 5).toString());
+
+            a.clearDirtyRegion();
+            expect (a.getDirtyRegion().isEmpty());
+
+            a.markDirty ({ 10, 10, 20, 20 });
+            expectEquals (a.getDirtyRegion().getBounds().toString(),
+                          Rectangle<int> (10, 10, 20, 20).toString());
+        }
+
+        beginTest ("Sub-image views share tiles and write in their own coordinates");
+        {
+            TiledImage parent (Image::ARGB, 300, 300, 128);
+            parent.clear (parent.getBounds(), Colours::blue);
+
+            auto view = parent.getSubImage ({ 150, 150, 100, 100 });
+            expectEquals (view.getWidth(), 100);
+            expectEquals (view.getHeight(), 100);
+            expect (view.getDirtyRegion().isEmpty());
+
+            // the view's tiles are the parent's tiles...
+            expect (view.getTileContaining (0, 0).getPixelData()
+                      == parent.getTileContaining (150, 150).getPixelData());
+
+            // ...until written through, which must not affect the parent
+            view.clear ({ 0, 0, 10, 10 }, Colours::red);
+
+            expect (view.render ({ 0, 0, 10, 10 }).getPixelAt (5, 5) == Colours::red);
+            expect (parent.render ({ 150, 150, 10, 10 }).getPixelAt (5, 5) == Colours::blue);
+
+            expectEquals (view.getDirtyRegion().getBounds().toString(),
+                          Rectangle<int> (0, 0, 10, 10).toString());
+            expect (! tilesAreShared (parent, parent.getSubImage ({ 0, 0, 10, 10 }), -1, -1)
+                      || parent.getDirtyRegion().getBounds() != Rectangle<int> (150, 150, 10, 10));
+        }
+
+        beginTest ("Painting across tile boundaries matches a plain image");
+        {
+            constexpr int size = 200;
+
+            Image reference (Image::ARGB, size, size, true);
+            TiledImage tiled (Image::ARGB, size, size, 64);
+
+            auto paint = [] (Graphics& g)
+            {
+                g.setColour (Colours::green);
+                g.fillEllipse (30.0f, 50.0f, 140.0f, 120.0f);
+                g.setColour (Colours::orange);
+                g.drawLine (0.0f, 0.0f, (float) size, (float) size, 5.0f);
+            };
+
+            {
+                Graphics g (reference);
+                paint (g);
+            }
+
+            tiled.paintArea (tiled.getBounds(), paint);
+
+            auto flattened = tiled.render (tiled.getBounds());
+            expectEquals (flattened.getWidth(), size);
+            expectEquals (flattened.getHeight(), size);
+
+            for (int y = 0; y < size; y += 7)
+                for (int x = 0; x < size; x += 7)
+                    expect (coloursRoughlyEqual (flattened.getPixelAt (x, y), reference.getPixelAt (x, y)),
+                            "mismatch at " + Point<int> (x, y).toString());
+        }
+
+        beginTest ("drawImageAt only copies the touched tiles");
+        {
+            TiledImage background (Image::ARGB, 512, 512, 128);
+            TiledImage layer (background);
+
+            Image sprite (Image::ARGB, 40, 40, true);
+            {
+                Graphics g (sprite);
+                g.fillAll (Colours::yellow);
+            }
+
+            layer.drawImageAt (sprite, 50, 50); // entirely inside the top-left tile
+
+            expect (! tilesAreShared (background, layer, 50, 50));
+
+            int numSharedTiles = 0, numTiles = 0;
+
+            for (int y = 0; y < 512; y += 128)
+                for (int x = 0; x < 512; x += 128, ++numTiles)
+                    if (tilesAreShared (background, layer, x, y))
+                        ++numSharedTiles;
+
+            expectEquals (numTiles, 16);
+            expectEquals (numSharedTiles, 15);
+
+            expect (layer.render ({ 50, 50, 40, 40 }).getPixelAt (20, 20) == Colours::yellow);
+        }
+    }
+};
+
+static TiledImageTests tiledImageTests;
+
+} // namespace juce
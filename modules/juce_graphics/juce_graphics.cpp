@@ -108,20 +108,26 @@
 #include "colour/juce_Colour.cpp"
 #include "colour/juce_ColourGradient.cpp"
 #include "colour/juce_Colours.cpp"
+#include "colour/juce_PixelOperations.cpp"
 #include "colour/juce_FillType.cpp"
 #include "geometry/juce_AffineTransform.cpp"
+#include "geometry/juce_CachedPath.cpp"
 #include "geometry/juce_EdgeTable.cpp"
 #include "geometry/juce_Path.cpp"
 #include "geometry/juce_PathIterator.cpp"
 #include "geometry/juce_PathStrokeType.cpp"
+#include "geometry/juce_PathBatch.cpp"
 #include "placement/juce_RectanglePlacement.cpp"
+#include "contexts/juce_DisplayList.cpp"
 #include "contexts/juce_GraphicsContext.cpp"
 #include "contexts/juce_LowLevelGraphicsPostScriptRenderer.cpp"
 #include "contexts/juce_LowLevelGraphicsSoftwareRenderer.cpp"
+#include "contexts/juce_TiledSoftwareRenderer.cpp"
 #include "images/juce_Image.cpp"
 #include "images/juce_ImageCache.cpp"
 #include "images/juce_ImageConvolutionKernel.cpp"
 #include "images/juce_ImageFileFormat.cpp"
+#include "images/juce_TiledImage.cpp"
 #include "image_formats/juce_GIFLoader.cpp"
 #include "image_formats/juce_JPEGLoader.cpp"
 #include "image_formats/juce_PNGLoader.cpp"
@@ -136,6 +142,12 @@
 
 #if JUCE_UNIT_TESTS
  #include "geometry/juce_Rectangle_test.cpp"
+ #include "geometry/juce_RectangleList_test.cpp"
+ #include "colour/juce_PixelOperations_test.cpp"
+ #include "native/juce_RenderingHelpers_test.cpp"
+ #include "geometry/juce_PathBatch_test.cpp"
+ #include "images/juce_ImageConvolutionKernel_test.cpp"
+ #include "images/juce_TiledImage_test.cpp"
 #endif
 
 #if JUCE_USE_FREETYPE
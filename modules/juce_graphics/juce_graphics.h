@@ -120,6 +120,7 @@ namespace juce
 #include "geometry/juce_Path.h"
 #include "geometry/juce_RectangleList.h"
 #include "colour/juce_PixelFormats.h"
+#include "colour/juce_PixelOperations.h"
 #include "colour/juce_Colour.h"
 #include "colour/juce_ColourGradient.h"
 #include "colour/juce_Colours.h"
@@ -127,6 +128,8 @@ namespace juce
 #include "geometry/juce_EdgeTable.h"
 #include "geometry/juce_PathIterator.h"
 #include "geometry/juce_PathStrokeType.h"
+#include "geometry/juce_PathBatch.h"
+#include "geometry/juce_CachedPath.h"
 #include "placement/juce_RectanglePlacement.h"
 #include "images/juce_ImageCache.h"
 #include "images/juce_ImageConvolutionKernel.h"
@@ -139,11 +142,14 @@ namespace juce
 #include "fonts/juce_CustomTypeface.h"
 #include "contexts/juce_GraphicsContext.h"
 #include "contexts/juce_LowLevelGraphicsContext.h"
+#include "contexts/juce_DisplayList.h"
 #include "images/juce_Image.h"
 #include "images/juce_ScaledImage.h"
+#include "images/juce_TiledImage.h"
 #include "colour/juce_FillType.h"
 #include "native/juce_RenderingHelpers.h"
 #include "contexts/juce_LowLevelGraphicsSoftwareRenderer.h"
+#include "contexts/juce_TiledSoftwareRenderer.h"
 #include "contexts/juce_LowLevelGraphicsPostScriptRenderer.h"
 #include "effects/juce_ImageEffectFilter.h"
 #include "effects/juce_DropShadowEffect.h"
@@ -23,6 +23,16 @@
   ==============================================================================
 */
 
+#if ! JUCE_ANDROID
+ #if JUCE_INTEL && (defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+  #define JUCE_RENDERING_HELPERS_USE_SSE 1
+  #include <emmintrin.h>
+ #elif JUCE_ARM && (defined (__ARM_NEON__) || defined (__ARM_NEON))
+  #define JUCE_RENDERING_HELPERS_USE_NEON 1
+  #include <arm_neon.h>
+ #endif
+#endif
+
 namespace juce
 {
 
@@ -134,6 +144,138 @@ public:
     bool isOnlyTranslated = true, isRotated = false;
 };
 
+//==============================================================================
+/** A glyph's anti-aliased coverage, rasterised at one subpixel x-phase.
+
+    Iterating a glyph's edge-table recomputes its coverage on every draw, so
+    the glyph cache flattens each table it holds into one of these per
+    quantised fractional x-position, and smooth-scrolled text becomes a
+    repeated blit of the same bytes rather than a re-rasterisation per frame.
+
+    @tags{Graphics}
+*/
+struct GlyphRaster
+{
+    enum { numXPhases = 4 };
+
+    Rectangle<int> bounds;      // relative to the glyph origin
+    HeapBlock<uint8> coverage;  // bounds.getWidth() * bounds.getHeight() alpha levels
+
+    static std::unique_ptr<GlyphRaster> createFromEdgeTable (const EdgeTable& edgeTable, int phase)
+    {
+        jassert (isPositiveAndBelow (phase, (int) numXPhases));
+
+        EdgeTable translated (edgeTable);
+        translated.translate ((float) phase / (float) numXPhases, 0);
+
+        auto raster = std::make_unique<GlyphRaster>();
+        raster->bounds = translated.getMaximumBounds();
+
+        if (! raster->bounds.isEmpty())
+        {
+            raster->coverage.calloc ((size_t) raster->bounds.getWidth() * (size_t) raster->bounds.getHeight());
+
+            Builder builder { raster->coverage.getData(), raster->bounds, 0 };
+            translated.iterate (builder);
+        }
+
+        return raster;
+    }
+
+private:
+    struct Builder
+    {
+        uint8* coverage;
+        Rectangle<int> area;
+        int y;
+
+        uint8* getRow() const noexcept                          { return coverage + (size_t) y * (size_t) area.getWidth() - area.getX(); }
+
+        void setEdgeTableYPos (int newY) noexcept               { y = newY - area.getY(); }
+        void handleEdgeTablePixel (int x, int alpha) noexcept   { getRow()[x] = (uint8) alpha; }
+        void handleEdgeTablePixelFull (int x) noexcept          { getRow()[x] = 255; }
+        void handleEdgeTableLine (int x, int width, int alpha) noexcept  { memset (getRow() + x, alpha, (size_t) width); }
+        void handleEdgeTableLineFull (int x, int width) noexcept         { memset (getRow() + x, 255, (size_t) width); }
+    };
+};
+
+//==============================================================================
+/** An edge-table-style iterator which walks a GlyphRaster's coverage bytes,
+    clipped to a rectangle list, emitting runs of equal alpha.
+
+    @tags{Graphics}
+*/
+class GlyphRasterIterator
+{
+public:
+    GlyphRasterIterator (const GlyphRaster& r, const RectangleList<int>& clipList,
+                         Point<int> origin) noexcept
+        : raster (r), clip (clipList), area (r.bounds + origin)
+    {}
+
+    template <class Renderer>
+    void iterate (Renderer& r) const noexcept
+    {
+        for (auto& c : clip)
+        {
+            auto rect = c.getIntersection (area);
+
+            if (rect.isEmpty())
+                continue;
+
+            for (int y = rect.getY(); y < rect.getBottom(); ++y)
+            {
+                const auto* row = raster.coverage.getData()
+                                    + (size_t) (y - area.getY()) * (size_t) raster.bounds.getWidth()
+                                    + (size_t) (rect.getX() - area.getX());
+
+                const auto width = rect.getWidth();
+                bool rowStarted = false;
+
+                for (int x = 0; x < width;)
+                {
+                    const auto alpha = (int) row[x];
+                    auto runEnd = x + 1;
+
+                    while (runEnd < width && (int) row[runEnd] == alpha)
+                        ++runEnd;
+
+                    if (alpha != 0)
+                    {
+                        if (! rowStarted)
+                        {
+                            r.setEdgeTableYPos (y);
+                            rowStarted = true;
+                        }
+
+                        const auto runX = rect.getX() + x;
+
+                        if (alpha >= 255)
+                        {
+                            if (runEnd == x + 1)  r.handleEdgeTablePixelFull (runX);
+                            else                  r.handleEdgeTableLineFull (runX, runEnd - x);
+                        }
+                        else
+                        {
+                            if (runEnd == x + 1)  r.handleEdgeTablePixel (runX, alpha);
+                            else                  r.handleEdgeTableLine (runX, runEnd - x, alpha);
+                        }
+                    }
+
+                    x = runEnd;
+                }
+            }
+        }
+    }
+
+private:
+    const GlyphRaster& raster;
+    const RectangleList<int>& clip;
+    const Rectangle<int> area;
+
+    JUCE_DECLARE_NON_COPYABLE (GlyphRasterIterator)
+};
+
 //==============================================================================
 /** Holds a cache of recently-used glyph objects of some type.
 
@@ -282,8 +424,26 @@ public:
         if (snapToIntegerCoordinate)
             pos.x = std::floor (pos.x + 0.5f);
 
-        if (edgeTable != nullptr)
-            state.fillEdgeTable (*edgeTable, pos.x, roundToInt (pos.y));
+        if (edgeTable == nullptr)
+            return;
+
+        // Quantise the fractional x-position to one of a handful of phases and
+        // draw from a coverage raster cached for that phase, so that scrolling
+        // text at subpixel positions doesn't re-rasterise the glyph per draw.
+        auto xFloor = std::floor (pos.x);
+        auto phase = roundToInt ((pos.x - xFloor) * (float) GlyphRaster::numXPhases);
+
+        if (phase == GlyphRaster::numXPhases)
+        {
+            phase = 0;
+            xFloor += 1.0f;
+        }
+
+        if (auto* raster = getRasterForPhase (phase))
+            if (state.fillGlyphRaster (*raster, { (int) xFloor, roundToInt (pos.y) }))
+                return;
+
+        state.fillEdgeTable (*edgeTable, pos.x, roundToInt (pos.y));
     }
 
     void generate (const Font& newFont, int glyphNumber)
@@ -297,6 +457,11 @@ public:
         edgeTable.reset (typeface->getEdgeTableForGlyph (glyphNumber,
                                                          AffineTransform::scale (fontHeight * font.getHorizontalScale(),
                                                                                  fontHeight), fontHeight));
+
+        const ScopedLock sl (rasterLock);
+
+        for (auto& r : rasters)
+            r.reset();
     }
 
     Font font;
@@ -304,6 +469,23 @@ public:
     int glyph = 0, lastAccessCount = 0;
     bool snapToIntegerCoordinate = false;
 
+private:
+    const GlyphRaster* getRasterForPhase (int phase) const
+    {
+        // Rasters are built lazily, but once built they stay immutable until
+        // the cache regenerates this slot, so the lock only guards creation.
+        const ScopedLock sl (rasterLock);
+        auto& raster = rasters[phase];
+
+        if (raster == nullptr)
+            raster = GlyphRaster::createFromEdgeTable (*edgeTable, phase);
+
+        return raster.get();
+    }
+
+    mutable std::unique_ptr<GlyphRaster> rasters[GlyphRaster::numXPhases];
+    mutable CriticalSection rasterLock;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CachedGlyphEdgeTable)
 };
 
@@ -561,6 +743,103 @@ namespace GradientPixelIterators
     do { dest->op; dest = addBytesToPointer (dest, destStride); } while (--width > 0); \
 }
 
+//==============================================================================
+#if JUCE_RENDERING_HELPERS_USE_SSE || JUCE_RENDERING_HELPERS_USE_NEON
+
+/** Vectorised span blending for densely-packed premultiplied ARGB scanlines.
+
+    These helpers perform exactly the same arithmetic as PixelARGB::blend(),
+    several pixels per iteration, and may only be used on pixel data whose
+    stride is sizeof (PixelARGB).
+*/
+struct ARGBSpanBlender
+{
+    /** Blends a single colour onto a span of packed PixelARGB pixels. */
+    static void blendConstantColour (PixelARGB* dest, PixelARGB colour, int width) noexcept
+    {
+       #if JUCE_RENDERING_HELPERS_USE_SSE
+        const auto zero = _mm_setzero_si128();
+        const auto src16 = _mm_unpacklo_epi8 (_mm_set1_epi32 ((int) colour.getNativeARGB()), zero);
+        const auto factor16 = _mm_set1_epi16 ((int16) (0x100 - colour.getAlpha()));
+
+        for (; width >= 4; width -= 4, dest += 4)
+        {
+            auto d = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (dest));
+            auto lo = _mm_add_epi16 (src16, _mm_srli_epi16 (_mm_mullo_epi16 (_mm_unpacklo_epi8 (d, zero), factor16), 8));
+            auto hi = _mm_add_epi16 (src16, _mm_srli_epi16 (_mm_mullo_epi16 (_mm_unpackhi_epi8 (d, zero), factor16), 8));
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest), _mm_packus_epi16 (lo, hi));
+        }
+       #elif JUCE_RENDERING_HELPERS_USE_NEON
+        const auto factor = (uint16) (0x100 - colour.getAlpha());
+        const auto src16 = vmovl_u8 (vreinterpret_u8_u32 (vdup_n_u32 (colour.getNativeARGB())));
+
+        for (; width >= 4; width -= 4, dest += 4)
+        {
+            auto d = vld1q_u8 (reinterpret_cast<const uint8_t*> (dest));
+            auto lo = vaddq_u16 (src16, vshrq_n_u16 (vmulq_n_u16 (vmovl_u8 (vget_low_u8  (d)), factor), 8));
+            auto hi = vaddq_u16 (src16, vshrq_n_u16 (vmulq_n_u16 (vmovl_u8 (vget_high_u8 (d)), factor), 8));
+            vst1q_u8 (reinterpret_cast<uint8_t*> (dest), vcombine_u8 (vqmovn_u16 (lo), vqmovn_u16 (hi)));
+        }
+       #endif
+
+        while (--width >= 0)
+        {
+            dest->blend (colour);
+            ++dest;
+        }
+    }
+
+    /** Blends a span of premultiplied source pixels onto a span of packed PixelARGB pixels. */
+    static void blendSpan (PixelARGB* dest, const PixelARGB* src, int width) noexcept
+    {
+       #if JUCE_RENDERING_HELPERS_USE_SSE
+        const auto zero = _mm_setzero_si128();
+        const auto full = _mm_set1_epi16 (0x100);
+
+        for (; width >= 4; width -= 4, dest += 4, src += 4)
+        {
+            auto s = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src));
+            auto d = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (dest));
+            auto sLo = _mm_unpacklo_epi8 (s, zero);
+            auto sHi = _mm_unpackhi_epi8 (s, zero);
+
+            // broadcast each pixel's alpha across its four lanes, and convert to (0x100 - alpha)
+            auto fLo = _mm_sub_epi16 (full, _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (sLo, _MM_SHUFFLE (3, 3, 3, 3)), _MM_SHUFFLE (3, 3, 3, 3)));
+            auto fHi = _mm_sub_epi16 (full, _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (sHi, _MM_SHUFFLE (3, 3, 3, 3)), _MM_SHUFFLE (3, 3, 3, 3)));
+
+            auto lo = _mm_add_epi16 (sLo, _mm_srli_epi16 (_mm_mullo_epi16 (_mm_unpacklo_epi8 (d, zero), fLo), 8));
+            auto hi = _mm_add_epi16 (sHi, _mm_srli_epi16 (_mm_mullo_epi16 (_mm_unpackhi_epi8 (d, zero), fHi), 8));
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest), _mm_packus_epi16 (lo, hi));
+        }
+       #elif JUCE_RENDERING_HELPERS_USE_NEON
+        for (; width >= 4; width -= 4, dest += 4, src += 4)
+        {
+            auto s = vld1q_u8 (reinterpret_cast<const uint8_t*> (src));
+            auto d = vld1q_u8 (reinterpret_cast<const uint8_t*> (dest));
+
+            // broadcast each pixel's (0x100 - alpha) across its four lanes
+            auto f16 = vmovn_u32 (vsubq_u32 (vdupq_n_u32 (0x100), vshrq_n_u32 (vreinterpretq_u32_u8 (s), 24)));
+            auto pairs = vzip_u16 (f16, f16);
+            auto fLo = vcombine_u16 (vzip_u16 (pairs.val[0], pairs.val[0]).val[0], vzip_u16 (pairs.val[0], pairs.val[0]).val[1]);
+            auto fHi = vcombine_u16 (vzip_u16 (pairs.val[1], pairs.val[1]).val[0], vzip_u16 (pairs.val[1], pairs.val[1]).val[1]);
+
+            auto lo = vaddq_u16 (vmovl_u8 (vget_low_u8  (s)), vshrq_n_u16 (vmulq_u16 (vmovl_u8 (vget_low_u8  (d)), fLo), 8));
+            auto hi = vaddq_u16 (vmovl_u8 (vget_high_u8 (s)), vshrq_n_u16 (vmulq_u16 (vmovl_u8 (vget_high_u8 (d)), fHi), 8));
+            vst1q_u8 (reinterpret_cast<uint8_t*> (dest), vcombine_u8 (vqmovn_u16 (lo), vqmovn_u16 (hi)));
+        }
+       #endif
+
+        while (--width >= 0)
+        {
+            dest->blend (*src);
+            ++dest;
+            ++src;
+        }
+    }
+};
+
+#endif
+
 //==============================================================================
 /** Contains classes for filling edge tables with various fill types. */
 namespace EdgeTableFillers
@@ -667,6 +946,14 @@ namespace EdgeTableFillers
 
         inline void blendLine (PixelType* dest, PixelARGB colour, int width) const noexcept
         {
+           #if JUCE_RENDERING_HELPERS_USE_SSE || JUCE_RENDERING_HELPERS_USE_NEON
+            if (sizeof (PixelType) == sizeof (PixelARGB) && (size_t) destData.pixelStride == sizeof (PixelARGB))
+            {
+                ARGBSpanBlender::blendConstantColour ((PixelARGB*) dest, colour, width);
+                return;
+            }
+           #endif
+
             JUCE_PERFORM_PIXEL_OP_LOOP (blend (colour))
         }
 
@@ -727,14 +1014,42 @@ namespace EdgeTableFillers
             auto* dest = getPixel (x);
 
             if (alphaLevel < 0xff)
+            {
                 JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++), (uint32) alphaLevel))
+            }
             else
-                JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
+            {
+                handleEdgeTableLineFull (x, width);
+            }
         }
 
         void handleEdgeTableLineFull (int x, int width) const noexcept
         {
             auto* dest = getPixel (x);
+
+           #if JUCE_RENDERING_HELPERS_USE_SSE || JUCE_RENDERING_HELPERS_USE_NEON
+            if (sizeof (PixelType) == sizeof (PixelARGB) && (size_t) destData.pixelStride == sizeof (PixelARGB))
+            {
+                // generate a run of gradient colours on the stack, then blend whole spans at once
+                PixelARGB scratch[128];
+
+                while (width > 0)
+                {
+                    auto num = jmin (width, (int) numElementsInArray (scratch));
+
+                    for (int i = 0; i < num; ++i)
+                        scratch[i] = GradientType::getPixel (x + i);
+
+                    ARGBSpanBlender::blendSpan ((PixelARGB*) dest, scratch, num);
+                    dest += num;
+                    x += num;
+                    width -= num;
+                }
+
+                return;
+            }
+           #endif
+
             JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
         }
 
@@ -913,6 +1228,14 @@ namespace EdgeTableFillers
             {
                 memcpy ((void*) dest, src, (size_t) (width * srcStride));
             }
+           #if JUCE_RENDERING_HELPERS_USE_SSE || JUCE_RENDERING_HELPERS_USE_NEON
+            else if ((size_t) destStride == sizeof (PixelARGB) && (size_t) srcStride == sizeof (PixelARGB)
+                      && srcData.pixelFormat  == Image::ARGB
+                      && destData.pixelFormat == Image::ARGB)
+            {
+                ARGBSpanBlender::blendSpan ((PixelARGB*) dest, (const PixelARGB*) src, width);
+            }
+           #endif
             else
             {
                 do
@@ -1600,6 +1923,13 @@ struct ClipRegions
         virtual Ptr clone() const = 0;
         virtual Ptr applyClipTo (const Ptr& target) const = 0;
 
+        /** Returns a copy of this region reduced to the given rectangle, leaving this
+            region untouched. The default just clones and clips, but subclasses can
+            avoid copying the parts of a shared clip that the intersection is about
+            to discard anyway.
+        */
+        virtual Ptr cloneClippedToRectangle (Rectangle<int> r) const    { return clone()->clipToRectangle (r); }
+
         virtual Ptr clipToRectangle (Rectangle<int>) = 0;
         virtual Ptr clipToRectangleList (const RectangleList<int>&) = 0;
         virtual Ptr excludeClipRectangle (Rectangle<int>) = 0;
@@ -1611,6 +1941,10 @@ struct ClipRegions
         virtual bool clipRegionIntersects (Rectangle<int>) const = 0;
         virtual Rectangle<int> getClipBounds() const = 0;
 
+        /** Returns the clip as a rectangle list if it takes that form, or nullptr
+            if it's an arbitrary shape. */
+        virtual const RectangleList<int>* getAsRectangleList() const     { return nullptr; }
+
         virtual void fillRectWithColour (SavedStateType&, Rectangle<int>, PixelARGB colour, bool replaceContents) const = 0;
         virtual void fillRectWithColour (SavedStateType&, Rectangle<float>, PixelARGB colour) const = 0;
         virtual void fillAllWithColour (SavedStateType&, PixelARGB colour, bool replaceContents) const = 0;
@@ -1811,6 +2145,7 @@ struct ClipRegions
     public:
         RectangleListRegion (Rectangle<int> r) : clip (r) {}
         RectangleListRegion (const RectangleList<int>& r)  : clip (r) {}
+        RectangleListRegion (RectangleList<int>&& r)  : clip (std::move (r)) {}
         RectangleListRegion (const RectangleListRegion& other) : Base(), clip (other.clip) {}
 
         using Ptr = typename Base::Ptr;
@@ -1818,6 +2153,16 @@ struct ClipRegions
         Ptr clone() const override                           { return *new RectangleListRegion (*this); }
         Ptr applyClipTo (const Ptr& target) const override   { return target->clipToRectangleList (clip); }
 
+        Ptr cloneClippedToRectangle (Rectangle<int> r) const override
+        {
+            RectangleList<int> intersection;
+
+            if (! clip.getIntersectionWith (r, intersection))
+                return {};
+
+            return *new RectangleListRegion (std::move (intersection));
+        }
+
         Ptr clipToRectangle (Rectangle<int> r) override
         {
             clip.clipTo (r);
@@ -1847,6 +2192,7 @@ struct ClipRegions
         void translate (Point<int> delta) override                    { clip.offsetAll (delta); }
         bool clipRegionIntersects (Rectangle<int> r) const override   { return clip.intersects (r); }
         Rectangle<int> getClipBounds() const override                 { return clip.getBounds(); }
+        const RectangleList<int>* getAsRectangleList() const override { return &clip; }
 
         void fillRectWithColour (SavedStateType& state, Rectangle<int> area, PixelARGB colour, bool replaceContents) const override
         {
@@ -2074,13 +2420,11 @@ public:
         {
             if (transform.isOnlyTranslated)
             {
-                cloneClipIfMultiplyReferenced();
-                clip = clip->clipToRectangle (transform.translated (r));
+                clipRegionToRectangle (transform.translated (r));
             }
             else if (! transform.isRotated)
             {
-                cloneClipIfMultiplyReferenced();
-                clip = clip->clipToRectangle (transform.transformed (r));
+                clipRegionToRectangle (transform.transformed (r));
             }
             else
             {
@@ -2332,6 +2676,18 @@ public:
         }
     }
 
+    void fillCachedPath (CachedPath& cachedPath, const AffineTransform& t)
+    {
+        if (clip != nullptr)
+        {
+            auto trans = transform.getTransformWith (t);
+            auto clipRect = clip->getClipBounds();
+
+            if (cachedPath.getPath().getBoundsTransformed (trans).getSmallestIntegerContainer().intersects (clipRect))
+                fillShape (*new EdgeTableRegionType (cachedPath.getEdgeTableFor (clipRect, trans)), false);
+        }
+    }
+
     void fillEdgeTable (const EdgeTable& edgeTable, float x, int y)
     {
         if (clip != nullptr)
@@ -2351,6 +2707,33 @@ public:
         }
     }
 
+    bool fillGlyphRaster (const GlyphRaster& raster, Point<int> origin)
+    {
+        if (clip == nullptr)
+            return true;
+
+        // The blit only handles solid colours and rectangle-list clips - for
+        // gradient fills or shaped clips the caller falls back to the
+        // edge-table path. Bright colours also fall back, because their
+        // contrast boost multiplies the edge levels before coverage is
+        // accumulated, which can't be reproduced from the flattened raster.
+        if (! fillType.isColour() || fillType.colour.getBrightness() > 0.5f)
+            return false;
+
+        auto* clipRects = clip->getAsRectangleList();
+
+        if (clipRects == nullptr)
+            return false;
+
+        if (! raster.bounds.isEmpty())
+        {
+            GlyphRasterIterator iter (raster, *clipRects, origin);
+            getThis().fillWithSolidColour (iter, fillType.colour.getPixelARGB(), false);
+        }
+
+        return true;
+    }
+
     void drawLine (Line<float> line)
     {
         Path p;
@@ -2469,6 +2852,17 @@ public:
             clip = clip->clone();
     }
 
+    void clipRegionToRectangle (Rectangle<int> r)
+    {
+        // When the clip is shared with an enclosing saved state, build the reduced
+        // clip directly rather than deep-copying the shared one and then throwing
+        // most of the copy away again.
+        if (clip->getReferenceCount() > 1)
+            clip = clip->cloneClippedToRectangle (r);
+        else
+            clip = clip->clipToRectangle (r);
+    }
+
     typename BaseRegionType::Ptr clip;
     RenderingHelpers::TranslationOrTransform transform;
     FillType fillType;
@@ -2721,6 +3115,7 @@ public:
     void fillRect (const Rectangle<float>& r) override                           { stack->fillRect (r); }
     void fillRectList (const RectangleList<float>& list) override                { stack->fillRectList (list); }
     void fillPath (const Path& path, const AffineTransform& t) override          { stack->fillPath (path, t); }
+    void fillCachedPath (CachedPath& path, const AffineTransform& t) override    { stack->fillCachedPath (path, t); }
     void drawImage (const Image& im, const AffineTransform& t) override          { stack->drawImage (im, t); }
     void drawGlyph (int glyphNumber, const AffineTransform& t) override          { stack->drawGlyph (glyphNumber, t); }
     void drawLine (const Line<float>& line) override                             { stack->drawLine (line); }
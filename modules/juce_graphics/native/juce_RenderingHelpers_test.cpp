@@ -0,0 +1,228 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class GlyphRasterCacheTests  : public UnitTest
+{
+public:
+    GlyphRasterCacheTests()
+        : UnitTest ("Glyph raster cache", UnitTestCategories::graphics)
+    {}
+
+    static Image renderText (Colour background, Colour text, Point<float> pos,
+                             bool forceEdgeTableClip)
+    {
+        Image image (Image::ARGB, 200, 60, true);
+        Graphics g (image);
+        g.fillAll (background);
+
+        if (forceEdgeTableClip)
+        {
+            // Clipping to a path turns the clip region into an edge table,
+            // which sends the glyphs down the non-cached rendering path.
+            Path p;
+            p.addRectangle (image.getBounds().toFloat());
+            g.reduceClipRegion (p, {});
+        }
+
+        g.setColour (text);
+
+        // Align every glyph to an exact quarter-pixel, so that the cache's
+        // subpixel quantisation leaves the positions untouched and the two
+        // rendering paths see identical coordinates.
+        GlyphArrangement arrangement;
+        arrangement.addLineOfText (Font (22.0f), "Waves 123", pos.x, pos.y);
+
+        for (int i = 0; i < arrangement.getNumGlyphs(); ++i)
+        {
+            auto& glyph = arrangement.getGlyph (i);
+            glyph.moveBy (std::floor (glyph.getLeft() * 4.0f + 0.5f) / 4.0f - glyph.getLeft(), 0.0f);
+        }
+
+        arrangement.draw (g);
+        return image;
+    }
+
+    void compareImages (const Image& a, const Image& b, int tolerance, int xOffsetInB = 0)
+    {
+        auto maxDifference = 0;
+
+        for (int y = 0; y < a.getHeight(); ++y)
+        {
+            for (int x = 0; x < a.getWidth(); ++x)
+            {
+                const auto xb = x + xOffsetInB;
+
+                if (! isPositiveAndBelow (xb, b.getWidth()))
+                    continue;
+
+                const auto c1 = a.getPixelAt (x, y);
+                const auto c2 = b.getPixelAt (xb, y);
+
+                maxDifference = jmax (maxDifference,
+                                      std::abs ((int) c1.getRed()   - (int) c2.getRed()),
+                                      std::abs ((int) c1.getGreen() - (int) c2.getGreen()),
+                                      std::abs ((int) c1.getBlue()  - (int) c2.getBlue()));
+            }
+        }
+
+        expectLessOrEqual (maxDifference, tolerance);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Cached glyph rasters match the edge-table path");
+        {
+            // At integer positions the subpixel quantisation is a no-op, so a
+            // dark fill must render identically through both paths.
+            // Intersecting the glyph with the path-based clip's edge table
+            // introduces up to one level of rounding, so allow that much.
+            const auto cached   = renderText (Colours::white, Colours::black, { 10.0f, 40.0f }, false);
+            const auto fallback = renderText (Colours::white, Colours::black, { 10.0f, 40.0f }, true);
+            compareImages (cached, fallback, 1);
+
+            // Bright colours take the edge-table path in both cases, because
+            // their contrast boost can't be applied to a flattened raster.
+            const auto cachedBright   = renderText (Colours::black, Colours::white, { 10.0f, 40.0f }, false);
+            const auto fallbackBright = renderText (Colours::black, Colours::white, { 10.0f, 40.0f }, true);
+            compareImages (cachedBright, fallbackBright, 1);
+        }
+
+        beginTest ("Equal subpixel phases render identically at different positions");
+        {
+            const auto first  = renderText (Colours::white, Colours::darkblue, { 10.25f, 40.0f }, false);
+            const auto second = renderText (Colours::white, Colours::darkblue, { 14.25f, 40.0f }, false);
+            compareImages (first, second, 0, 4);
+        }
+
+        beginTest ("Clipping still applies to cached glyph rasters");
+        {
+            Image clipped (Image::ARGB, 200, 60, true);
+
+            {
+                Graphics g (clipped);
+                g.fillAll (Colours::white);
+                g.reduceClipRegion (20, 10, 60, 30);
+                g.setColour (Colours::black);
+                g.setFont (Font (22.0f));
+                g.drawSingleLineText ("Waves 123", 10, 40);
+            }
+
+            const auto unclipped = renderText (Colours::white, Colours::black, { 10.0f, 40.0f }, false);
+
+            for (int y = 0; y < clipped.getHeight(); ++y)
+            {
+                for (int x = 0; x < clipped.getWidth(); ++x)
+                {
+                    const auto inside = x >= 20 && x < 80 && y >= 10 && y < 40;
+                    const auto expected = inside ? unclipped.getPixelAt (x, y) : Colours::white;
+                    expect (clipped.getPixelAt (x, y) == expected);
+                }
+            }
+        }
+    }
+};
+
+static GlyphRasterCacheTests glyphRasterCacheTests;
+
+//==============================================================================
+class ClipRegionSharingTests  : public UnitTest
+{
+public:
+    ClipRegionSharingTests()
+        : UnitTest ("Clip region sharing", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Reducing a shared clip leaves the enclosing state's clip intact");
+        {
+            Image image (Image::ARGB, 100, 100, true);
+
+            {
+                Graphics g (image);
+                g.fillAll (Colours::white);
+
+                g.saveState();
+                g.reduceClipRegion (10, 10, 80, 80);
+
+                g.saveState();
+                g.reduceClipRegion (20, 20, 40, 40);
+                g.setColour (Colours::red);
+                g.fillRect (0, 0, 100, 100);
+                g.restoreState();
+
+                g.setColour (Colours::blue);
+                g.fillRect (0, 0, 100, 15);
+                g.restoreState();
+            }
+
+            expect (image.getPixelAt (5, 5)   == Colours::white);
+            expect (image.getPixelAt (30, 30) == Colours::red);
+            expect (image.getPixelAt (70, 70) == Colours::white); // outside the inner clip
+            expect (image.getPixelAt (50, 12) == Colours::blue);  // the inner reduction mustn't stick after restoring
+            expect (image.getPixelAt (5, 12)  == Colours::white); // ...but the outer clip still applies
+        }
+
+        beginTest ("Deeply nested save/restore pairs");
+        {
+            constexpr int depth = 30;
+            Image image (Image::ARGB, 128, 128, true);
+
+            {
+                Graphics g (image);
+                g.fillAll (Colours::white);
+
+                for (int i = 1; i <= depth; ++i)
+                {
+                    g.saveState();
+                    g.reduceClipRegion (i, i, 128 - 2 * i, 128 - 2 * i);
+                }
+
+                g.fillAll (Colours::black);
+
+                for (int i = 0; i < depth; ++i)
+                    g.restoreState();
+
+                // the clip should now be fully restored
+                g.setColour (Colours::blue);
+                g.fillRect (0, 0, 3, 3);
+            }
+
+            expect (image.getPixelAt (1, 1) == Colours::blue);
+            expect (image.getPixelAt (depth - 1, depth - 1) == Colours::white);
+            expect (image.getPixelAt (depth, depth) == Colours::black);
+            expect (image.getPixelAt (64, 64) == Colours::black);
+            expect (image.getPixelAt (127 - depth, 127 - depth) == Colours::black);
+            expect (image.getPixelAt (128 - depth, 128 - depth) == Colours::white);
+        }
+    }
+};
+
+static ClipRegionSharingTests clipRegionSharingTests;
+
+} // namespace juce
@@ -79,10 +79,7 @@ public:
         bitmap.pixelStride = pixelStride;
 
         if (mode != Image::BitmapData::readOnly)
-        {
             freeCachedImageRef();
-            sendDataChangeMessage();
-        }
     }
 
     ImagePixelData::Ptr clone() override
@@ -39,6 +39,7 @@ enum class InternalAccessibilityEvent
 };
 
 void notifyAccessibilityEventInternal (const AccessibilityHandler&, InternalAccessibilityEvent);
+void notifyAccessibilityEventInternal (const AccessibilityHandler&, AccessibilityEvent);
 
 inline String getAccessibleApplicationOrPluginName()
 {
@@ -52,6 +53,76 @@ inline String getAccessibleApplicationOrPluginName()
    #endif
 }
 
+//==============================================================================
+/*  Coalesces change notifications per handler, so that a burst of updates
+    posted during a single message loop callback reaches the platform bridge
+    only once per handler and event type.
+*/
+class AccessibilityEventBatcher  : private AsyncUpdater
+{
+public:
+    static AccessibilityEventBatcher& getInstance()
+    {
+        static AccessibilityEventBatcher instance;
+        return instance;
+    }
+
+    void addEvent (const AccessibilityHandler& handler, AccessibilityEvent event)
+    {
+        {
+            const ScopedLock sl (lock);
+
+            for (const auto& pending : events)
+                if (pending.handler == &handler && pending.event == event)
+                    return;
+
+            events.push_back ({ &handler, event });
+        }
+
+        triggerAsyncUpdate();
+    }
+
+    void cancelPendingEvents (const AccessibilityHandler& handler)
+    {
+        const ScopedLock sl (lock);
+
+        events.erase (std::remove_if (events.begin(), events.end(),
+                                      [&] (const PendingEvent& pending) { return pending.handler == &handler; }),
+                      events.end());
+    }
+
+private:
+    AccessibilityEventBatcher() = default;
+
+    ~AccessibilityEventBatcher() override
+    {
+        cancelPendingUpdate();
+    }
+
+    void handleAsyncUpdate() override
+    {
+        std::vector<PendingEvent> eventsToSend;
+
+        {
+            const ScopedLock sl (lock);
+            std::swap (eventsToSend, events);
+        }
+
+        for (const auto& pending : eventsToSend)
+            notifyAccessibilityEventInternal (*pending.handler, pending.event);
+    }
+
+    struct PendingEvent
+    {
+        const AccessibilityHandler* handler;
+        AccessibilityEvent event;
+    };
+
+    CriticalSection lock;
+    std::vector<PendingEvent> events;
+};
+
+//==============================================================================
 AccessibilityHandler::AccessibilityHandler (Component& comp,
                                             AccessibilityRole accessibilityRole,
                                             AccessibilityActions accessibilityActions,
@@ -60,18 +131,34 @@ AccessibilityHandler::AccessibilityHandler (Component& comp,
       typeIndex (typeid (component)),
       role (accessibilityRole),
       actions (std::move (accessibilityActions)),
-      interfaces (std::move (interfacesIn)),
-      nativeImpl (createNativeImpl (*this))
+      interfaces (std::move (interfacesIn))
 {
     notifyAccessibilityEventInternal (*this, InternalAccessibilityEvent::elementCreated);
 }
 
 AccessibilityHandler::~AccessibilityHandler()
 {
+    AccessibilityEventBatcher::getInstance().cancelPendingEvents (*this);
     giveAwayFocus();
     notifyAccessibilityEventInternal (*this, InternalAccessibilityEvent::elementDestroyed);
 }
 
+void AccessibilityHandler::notifyAccessibilityEvent (AccessibilityEvent event) const
+{
+    AccessibilityEventBatcher::getInstance().addEvent (*this, event);
+}
+
+AccessibilityHandler::AccessibilityNativeImpl* AccessibilityHandler::getOrCreateNativeImpl() const
+{
+    // The native wrapper is created on demand, the first time the platform
+    // bridge asks for it, so that applications which are never inspected by
+    // an accessibility client don't pay for building the native tree.
+    if (nativeImpl == nullptr)
+        nativeImpl = createNativeImpl (const_cast<AccessibilityHandler&> (*this));
+
+    return nativeImpl.get();
+}
+
 //==============================================================================
 AccessibleState AccessibilityHandler::getCurrentState() const
 {
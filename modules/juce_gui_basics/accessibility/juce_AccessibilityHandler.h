@@ -261,6 +261,10 @@ public:
     /** Used to send a notification to any observing accessibility clients that something
         has changed in the UI element.
 
+        Notifications are coalesced: repeated events of the same type posted for the
+        same UI element during a single message loop callback are delivered to the
+        platform only once, asynchronously.
+
         @see AccessibilityEvent
     */
     void notifyAccessibilityEvent (AccessibilityEvent event) const;
@@ -287,7 +291,13 @@ public:
     static void postAnnouncement (const String& announcementString, AnnouncementPriority priority);
 
     //==============================================================================
-    /** @internal */
+    /** @internal
+
+        Returns the platform-specific wrapper for this UI element, creating it if
+        it doesn't yet exist. The wrapper is built lazily, the first time an
+        accessibility client queries the element, so that applications which are
+        never inspected don't pay for constructing the native tree.
+    */
     AccessibilityNativeHandle* getNativeImplementation() const;
     /** @internal */
     std::type_index getTypeIndex() const  { return typeIndex; }
@@ -314,7 +324,8 @@ private:
 
     //==============================================================================
     class AccessibilityNativeImpl;
-    std::unique_ptr<AccessibilityNativeImpl> nativeImpl;
+    AccessibilityNativeImpl* getOrCreateNativeImpl() const;
+    mutable std::unique_ptr<AccessibilityNativeImpl> nativeImpl;
 
     static std::unique_ptr<AccessibilityNativeImpl> createNativeImpl (AccessibilityHandler&);
 
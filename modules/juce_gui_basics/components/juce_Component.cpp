@@ -513,6 +513,110 @@ struct Component::ComponentHelpers
     }
 };
 
+//==============================================================================
+/*  Created for components that opt in via setChildPaintCullingEnabled().
+
+    The index buckets the untransformed, clippable children into a uniform grid
+    so that painting only needs to visit children that can intersect the clip
+    region. Children that can't be culled by their bounds (transformed or
+    unclipped ones) go into a separate list which is always visited. The index
+    is invalidated whenever the child list or a child's geometry changes, and
+    rebuilt lazily on the next paint.
+*/
+class Component::ChildPaintIndex
+{
+public:
+    ChildPaintIndex() = default;
+
+    bool isValid() const noexcept   { return valid; }
+    void invalidate() noexcept      { valid = false; }
+
+    void rebuild (const Array<Component*>& children, Rectangle<int> parentArea)
+    {
+        area = parentArea;
+        numCellsX = numCellsY = jlimit (1, 32, (int) std::sqrt ((double) children.size()));
+
+        cells.resize (numCellsX * numCellsY);
+
+        for (int i = cells.size(); --i >= 0;)
+            cells.getReference (i).clearQuick();
+
+        alwaysVisit.clearQuick();
+        opaqueChildren.clearQuick();
+
+        for (int i = 0; i < children.size(); ++i)
+        {
+            auto& child = *children.getUnchecked (i);
+
+            if (child.affineTransform != nullptr || child.flags.dontClipGraphicsFlag)
+            {
+                alwaysVisit.add (i);
+                continue;
+            }
+
+            forEachCellIntersecting (child.getBounds(), [i] (Array<int>& cell) { cell.add (i); });
+
+            if (child.flags.opaqueFlag)
+                opaqueChildren.add (i);
+        }
+
+        valid = true;
+    }
+
+    /*  Returns, in z-order, the indices of the children which may intersect the
+        given clip region. The returned set is scratch space owned by the index,
+        which is fine as painting only happens on the message thread.
+    */
+    const SortedSet<int>& getCandidates (Rectangle<int> clip)
+    {
+        candidates.clearQuick();
+
+        for (auto i : alwaysVisit)
+            candidates.add (i);
+
+        forEachCellIntersecting (clip, [this] (Array<int>& cell)
+        {
+            for (auto i : cell)
+                candidates.add (i);
+        });
+
+        return candidates;
+    }
+
+    /*  The indices of the opaque, untransformed children, used to exclude
+        obscured regions when painting the children behind them.
+    */
+    const Array<int>& getOpaqueChildren() const noexcept    { return opaqueChildren; }
+
+private:
+    template <typename Fn>
+    void forEachCellIntersecting (Rectangle<int> r, Fn&& fn)
+    {
+        // Children (and clip regions) outside the parent's bounds get clamped
+        // into the edge cells, which keeps the mapping conservative.
+        const auto cellW = jmax (1, area.getWidth()  / numCellsX + 1);
+        const auto cellH = jmax (1, area.getHeight() / numCellsY + 1);
+
+        const auto x0 = jlimit (0, numCellsX - 1, (r.getX()      - area.getX()) / cellW);
+        const auto x1 = jlimit (0, numCellsX - 1, (r.getRight()  - area.getX()) / cellW);
+        const auto y0 = jlimit (0, numCellsY - 1, (r.getY()      - area.getY()) / cellH);
+        const auto y1 = jlimit (0, numCellsY - 1, (r.getBottom() - area.getY()) / cellH);
+
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x)
+                fn (cells.getReference (y * numCellsX + x));
+    }
+
+    Rectangle<int> area;
+    int numCellsX = 1, numCellsY = 1;
+    Array<Array<int>> cells;
+    Array<int> alwaysVisit, opaqueChildren;
+    SortedSet<int> candidates;
+    bool valid = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChildPaintIndex)
+};
+
 //==============================================================================
 Component::Component() noexcept
   : componentFlags (0)
@@ -822,6 +926,9 @@ void Component::setOpaque (bool shouldBeOpaque)
     {
         flags.opaqueFlag = shouldBeOpaque;
 
+        if (parentComponent != nullptr)
+            parentComponent->invalidateChildPaintIndex();
+
         if (flags.hasHeavyweightPeerFlag)
             if (auto* peer = ComponentPeer::getPeerFor (this))
                 addToDesktop (peer->getStyleFlags());  // recreates the heavyweight window
@@ -925,6 +1032,23 @@ void Component::setBufferedToImage (bool shouldBeBuffered)
     }
 }
 
+void Component::setChildPaintCullingEnabled (bool shouldBeEnabled)
+{
+    if (shouldBeEnabled != (childPaintIndex != nullptr))
+    {
+        if (shouldBeEnabled)
+            childPaintIndex.reset (new ChildPaintIndex());
+        else
+            childPaintIndex.reset();
+    }
+}
+
+void Component::invalidateChildPaintIndex() noexcept
+{
+    if (childPaintIndex != nullptr)
+        childPaintIndex->invalidate();
+}
+
 //==============================================================================
 void Component::reorderChildInternal (int sourceIndex, int destIndex)
 {
@@ -935,6 +1059,7 @@ void Component::reorderChildInternal (int sourceIndex, int destIndex)
         c->repaintParent();
 
         childComponentList.move (sourceIndex, destIndex);
+        invalidateChildPaintIndex();
 
         sendFakeMouseMove();
         internalChildrenChanged();
@@ -1166,6 +1291,9 @@ void Component::setBounds (int x, int y, int w, int h)
 
         boundsRelativeToParent.setBounds (x, y, w, h);
 
+        if (parentComponent != nullptr)
+            parentComponent->invalidateChildPaintIndex();
+
         if (showing)
         {
             if (wasResized)
@@ -1189,6 +1317,75 @@ void Component::setBounds (int x, int y, int w, int h)
     }
 }
 
+void Component::setBoundsBatch (const Array<ChildBoundsUpdate>& updates)
+{
+    // if component methods are being called from threads other than the message
+    // thread, you'll need to use a MessageManagerLock object to make sure it's thread-safe.
+    JUCE_ASSERT_MESSAGE_MANAGER_IS_LOCKED_OR_OFFSCREEN
+
+    const bool showing = isShowing();
+    Rectangle<int> areaToRepaint;
+    Array<SafePointer<Component>> changedChildren;
+
+    for (auto& update : updates)
+    {
+        auto* child = update.child;
+
+        // Batched updates only work for lightweight children of this component.
+        jassert (child != nullptr
+                  && child->parentComponent == this
+                  && ! child->flags.hasHeavyweightPeerFlag);
+
+        auto newBounds = update.newBounds.withWidth  (jmax (0, update.newBounds.getWidth()))
+                                         .withHeight (jmax (0, update.newBounds.getHeight()));
+
+        const bool wasResized = child->getWidth() != newBounds.getWidth()
+                                 || child->getHeight() != newBounds.getHeight();
+        const bool wasMoved = child->getX() != newBounds.getX()
+                                 || child->getY() != newBounds.getY();
+
+        if (! (wasMoved || wasResized))
+            continue;
+
+        if (child->flags.visibleFlag)
+            areaToRepaint = areaToRepaint.getUnion (child->getBoundsInParent());
+
+        child->boundsRelativeToParent = newBounds;
+
+        if (child->flags.visibleFlag)
+            areaToRepaint = areaToRepaint.getUnion (child->getBoundsInParent());
+
+        if (wasResized && child->cachedImage != nullptr)
+            child->cachedImage->invalidateAll();
+
+        child->flags.isMoveCallbackPending = wasMoved;
+        child->flags.isResizeCallbackPending = wasResized;
+        changedChildren.add (child);
+    }
+
+    if (! changedChildren.isEmpty())
+        invalidateChildPaintIndex();
+
+    if (showing && ! changedChildren.isEmpty())
+    {
+        sendFakeMouseMove();
+
+        if (! areaToRepaint.isEmpty())
+            repaint (areaToRepaint);
+    }
+
+    BailOutChecker checker (this);
+
+    for (auto& child : changedChildren)
+    {
+        if (child != nullptr)
+            child->sendMovedResizedMessagesIfPending();
+
+        if (checker.shouldBailOut())
+            return;
+    }
+}
+
 void Component::sendMovedResizedMessagesIfPending()
 {
     const bool wasMoved   = flags.isMoveCallbackPending;
@@ -1334,6 +1531,9 @@ void Component::setTransform (const AffineTransform& newTransform)
     // and there will be all sorts of maths errors when converting coordinates.
     jassert (! newTransform.isSingularity());
 
+    if (parentComponent != nullptr && (affineTransform == nullptr) == ! newTransform.isIdentity())
+        parentComponent->invalidateChildPaintIndex();
+
     if (newTransform.isIdentity())
     {
         if (affineTransform != nullptr)
@@ -1523,6 +1723,7 @@ void Component::addChildComponent (Component& child, int zOrder)
         }
 
         childComponentList.insert (zOrder, &child);
+        invalidateChildPaintIndex();
 
         child.internalHierarchyChanged();
         internalChildrenChanged();
@@ -1585,6 +1786,7 @@ Component* Component::removeChildComponent (int index, bool sendParentEvents, bo
         }
 
         childComponentList.remove (index);
+        invalidateChildPaintIndex();
         child->parentComponent = nullptr;
 
         ComponentHelpers::releaseAllCachedImageResources (*child);
@@ -1958,7 +2160,7 @@ void Component::internalRepaintUnchecked (Rectangle<int> area, bool isEntireComp
                 auto scaled = area * Point<float> ((float) peerBounds.getWidth()  / (float) getWidth(),
                                                    (float) peerBounds.getHeight() / (float) getHeight());
 
-                peer->repaint (affineTransform != nullptr ? scaled.transformedBy (*affineTransform) : scaled);
+                peer->invalidateArea (affineTransform != nullptr ? scaled.transformedBy (*affineTransform) : scaled);
             }
         }
         else
@@ -2009,7 +2211,7 @@ void Component::paintComponentAndChildren (Graphics& g)
             paint (g);
     }
 
-    for (int i = 0; i < childComponentList.size(); ++i)
+    const auto paintChild = [&] (int i)
     {
         auto& child = *childComponentList.getUnchecked (i);
 
@@ -2036,15 +2238,27 @@ void Component::paintComponentAndChildren (Graphics& g)
                 {
                     bool nothingClipped = true;
 
-                    for (int j = i + 1; j < childComponentList.size(); ++j)
+                    const auto excludeOpaqueSibling = [&] (Component& sibling)
                     {
-                        auto& sibling = *childComponentList.getUnchecked (j);
-
                         if (sibling.flags.opaqueFlag && sibling.isVisible() && sibling.affineTransform == nullptr)
                         {
                             nothingClipped = false;
                             g.excludeClipRegion (sibling.getBounds());
                         }
+                    };
+
+                    if (childPaintIndex != nullptr)
+                    {
+                        // excluding regions outside the clip is a no-op, so only
+                        // the opaque siblings intersecting it need to be visited
+                        for (auto j : childPaintIndex->getOpaqueChildren())
+                            if (j > i && clipBounds.intersects (childComponentList.getUnchecked (j)->getBounds()))
+                                excludeOpaqueSibling (*childComponentList.getUnchecked (j));
+                    }
+                    else
+                    {
+                        for (int j = i + 1; j < childComponentList.size(); ++j)
+                            excludeOpaqueSibling (*childComponentList.getUnchecked (j));
                     }
 
                     if (nothingClipped || ! g.isClipEmpty())
@@ -2052,6 +2266,21 @@ void Component::paintComponentAndChildren (Graphics& g)
                 }
             }
         }
+    };
+
+    if (childPaintIndex != nullptr && ! childComponentList.isEmpty())
+    {
+        if (! childPaintIndex->isValid())
+            childPaintIndex->rebuild (childComponentList, getLocalBounds());
+
+        for (auto i : childPaintIndex->getCandidates (clipBounds))
+            if (i < childComponentList.size())  // in case a paint callback removes children
+                paintChild (i);
+    }
+    else
+    {
+        for (int i = 0; i < childComponentList.size(); ++i)
+            paintChild (i);
     }
 
     Graphics::ScopedSaveState ss (g);
@@ -2114,6 +2343,9 @@ void Component::paintEntireComponent (Graphics& g, bool ignoreAlphaLevel)
 void Component::setPaintingIsUnclipped (bool shouldPaintWithoutClipping) noexcept
 {
     flags.dontClipGraphicsFlag = shouldPaintWithoutClipping;
+
+    if (parentComponent != nullptr)
+        parentComponent->invalidateChildPaintIndex();
 }
 
 bool Component::isPaintingUnclipped() const noexcept
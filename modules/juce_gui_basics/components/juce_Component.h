@@ -497,6 +497,34 @@ public:
     */
     void setBounds (Rectangle<int> newBounds);
 
+    /** A child component and the bounds to give it, used by setBoundsBatch.
+
+        @see setBoundsBatch
+    */
+    struct ChildBoundsUpdate
+    {
+        Component* child;           /**< The child component to reposition. */
+        Rectangle<int> newBounds;   /**< Its new bounds, relative to this component. */
+    };
+
+    /** Repositions a set of child components in one go, repainting the
+        affected area only once.
+
+        Calling setBounds() on each child separately queues a repaint of the
+        old and new area per child, which can dominate the cost of laying out
+        a container with many children. This method applies all of the bounds
+        first and then issues a single repaint of the union of the areas that
+        changed.
+
+        Every entry's component must be a child of this component, and must
+        not have its own heavyweight window. The usual moved() and resized()
+        callbacks are still sent to each child whose bounds actually changed,
+        after all of the new bounds are in place.
+
+        @see setBounds
+    */
+    void setBoundsBatch (const Array<ChildBoundsUpdate>& updates);
+
     /** Changes the component's position and size in terms of fractions of its parent's size.
 
         The values are factors of the parent's size, so for example
@@ -1068,6 +1096,24 @@ public:
     */
     void setBufferedToImage (bool shouldBeBuffered);
 
+    /** Enables a spatial index over this component's children to speed up painting.
+
+        Normally a paint callback walks every visible child and intersects the
+        clip region with each one, which is fine for typical components but can
+        cost more than the drawing itself when a component has thousands of
+        children (e.g. a large mixer or playlist). Setting this flag makes the
+        component maintain a grid index over its children's bounds, so painting
+        only visits the subtrees that can intersect the clip region. The index
+        is rebuilt lazily after children are added, removed, reordered or moved.
+
+        This only affects painting - hit-testing and layout are unchanged. It
+        can be combined with setBufferedToImage() on the children themselves,
+        which keeps their repaints scoped to the areas that actually changed.
+
+        @see setBufferedToImage, repaint, paint
+    */
+    void setChildPaintCullingEnabled (bool shouldBeEnabled);
+
     /** Generates a snapshot of part of this component.
 
         This will return a new Image, the size of the rectangle specified,
@@ -2542,6 +2588,9 @@ private:
     ImageEffectFilter* effect = nullptr;
     std::unique_ptr<CachedComponentImage> cachedImage;
 
+    class ChildPaintIndex;
+    std::unique_ptr<ChildPaintIndex> childPaintIndex;
+
     class MouseListenerList;
     std::unique_ptr<MouseListenerList> mouseListeners;
     std::unique_ptr<Array<KeyListener*>> keyListeners;
@@ -2614,6 +2663,7 @@ private:
     Component* removeChildComponent (int index, bool sendParentEvents, bool sendChildEvents);
     void reorderChildInternal (int sourceIndex, int destIndex);
     void paintComponentAndChildren (Graphics&);
+    void invalidateChildPaintIndex() noexcept;
     void paintWithinParentContext (Graphics&);
     void sendMovedResizedMessages (bool wasMoved, bool wasResized);
     void sendMovedResizedMessagesIfPending();
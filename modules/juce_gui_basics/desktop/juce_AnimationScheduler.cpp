@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+JUCE_IMPLEMENT_SINGLETON (AnimationScheduler)
+
+AnimationScheduler::AnimationScheduler() {}
+
+AnimationScheduler::~AnimationScheduler()
+{
+    clearSingletonInstance();
+}
+
+void AnimationScheduler::addListener (Listener* listener)
+{
+    listeners.add (listener);
+    startOrStopTimer();
+}
+
+void AnimationScheduler::removeListener (Listener* listener)
+{
+    listeners.remove (listener);
+    startOrStopTimer();
+}
+
+void AnimationScheduler::setFrameRate (double framesPerSecond)
+{
+    jassert (framesPerSecond > 0);
+    frameRate = framesPerSecond;
+
+    if (isTimerRunning())
+        startTimer (jmax (1, roundToInt (1000.0 / frameRate)));
+}
+
+void AnimationScheduler::startOrStopTimer()
+{
+    if (listeners.isEmpty())
+    {
+        stopTimer();
+    }
+    else if (! isTimerRunning())
+    {
+        lastFrameTimeMs = Time::getMillisecondCounterHiRes();
+        startTimer (jmax (1, roundToInt (1000.0 / frameRate)));
+    }
+}
+
+void AnimationScheduler::timerCallback()
+{
+    auto now = Time::getMillisecondCounterHiRes();
+    auto deltaSeconds = jmax (0.0, now - lastFrameTimeMs) / 1000.0;
+    lastFrameTimeMs = now;
+
+    listeners.call ([deltaSeconds] (Listener& l) { l.animationFrameCallback (deltaSeconds); });
+}
+
+} // namespace juce
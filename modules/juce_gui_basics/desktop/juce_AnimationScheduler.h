@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A shared tick source that drives all animations from a single per-frame
+    callback.
+
+    When every animated widget runs its own Timer at its own rate, the message
+    thread is woken far more often than the display can show, and timers at
+    slightly different rates beat against each other, bunching repaints
+    unevenly. This class runs one timer at the display frame rate and fans each
+    tick out to all of its listeners, so any number of animations cost one
+    wakeup per frame and their repaints land together, to be coalesced into a
+    single redraw.
+
+    Listeners receive the time elapsed since the previous frame and should
+    advance their animations by that amount rather than assuming a fixed step,
+    so that a dropped frame makes the motion coarser but not slower.
+
+    ComponentAnimator ticks from this scheduler, so animations run through
+    Desktop::getInstance().getAnimator() already share it; register any
+    Timer-driven animations of your own (meters, spinners, scrolling) as
+    listeners to join them.
+
+    @see ComponentAnimator, Timer
+
+    @tags{GUI}
+*/
+class JUCE_API  AnimationScheduler  : private Timer,
+                                      private DeletedAtShutdown
+{
+public:
+    //==============================================================================
+    /** Receives the per-frame callback. @see AnimationScheduler::addListener */
+    class JUCE_API  Listener
+    {
+    public:
+        virtual ~Listener() = default;
+
+        /** Called once per frame on the message thread.
+
+            @param deltaSeconds  the time that has passed since the previous
+                                 frame callback, by which any animations should
+                                 be advanced
+        */
+        virtual void animationFrameCallback (double deltaSeconds) = 0;
+    };
+
+    /** Registers a listener to be called on each frame.
+
+        The scheduler only ticks while it has listeners, so a listener that
+        animates intermittently should add itself when its animation starts and
+        remove itself when the animation finishes, rather than staying
+        registered and ignoring the callbacks.
+    */
+    void addListener (Listener* listener);
+
+    /** Unregisters a listener. It's safe to call this from inside the frame
+        callback.
+    */
+    void removeListener (Listener* listener);
+
+    //==============================================================================
+    /** Sets the rate at which frame callbacks are made.
+
+        By default this is 60 frames per second. Set it to match the display
+        if you know its refresh rate differs.
+    */
+    void setFrameRate (double framesPerSecond);
+
+    /** Returns the current frame callback rate in frames per second. */
+    double getFrameRate() const noexcept                { return frameRate; }
+
+    //==============================================================================
+   #ifndef DOXYGEN
+    JUCE_DECLARE_SINGLETON_SINGLETHREADED (AnimationScheduler, false)
+   #endif
+
+private:
+    //==============================================================================
+    AnimationScheduler();
+    ~AnimationScheduler() override;
+
+    void timerCallback() override;
+    void startOrStopTimer();
+
+    ListenerList<Listener> listeners;
+    double frameRate = 60.0;
+    double lastFrameTimeMs = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnimationScheduler)
+};
+
+} // namespace juce
@@ -95,7 +95,10 @@ LookAndFeel& Desktop::getDefaultLookAndFeel() noexcept
         return *lf;
 
     if (defaultLookAndFeel == nullptr)
+    {
+        StartupProfile::recordEvent ("Default LookAndFeel created");
         defaultLookAndFeel.reset (new LookAndFeel_V4());
+    }
 
     auto lf = defaultLookAndFeel.get();
     jassert (lf != nullptr);
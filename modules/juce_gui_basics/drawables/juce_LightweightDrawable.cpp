@@ -0,0 +1,303 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct LightweightDrawable::SharedState  : public ReferenceCountedObject
+{
+    enum { maxCachedRenders = 8 };
+
+    CriticalSection lock;
+    MemoryBlock sourceData;   // freed once parsed
+    bool parsed = false;
+    DisplayList commands;
+    Rectangle<float> bounds;
+
+    struct CachedRender
+    {
+        int width, height;
+        Image image;
+    };
+
+    Array<CachedRender> cache;
+
+    void parseIfNeeded()
+    {
+        if (parsed)
+            return;
+
+        parsed = true;
+
+        if (auto drawable = Drawable::createFromImageData (sourceData.getData(), sourceData.getSize()))
+        {
+            bounds = drawable->getDrawableBounds();
+
+            Graphics g (commands.beginRecording());
+            drawable->draw (g, 1.0f);
+        }
+
+        sourceData.reset();
+    }
+
+    Image getRenderAtSize (int width, int height)
+    {
+        for (int i = cache.size(); --i >= 0;)
+        {
+            auto& entry = cache.getReference (i);
+
+            if (entry.width == width && entry.height == height)
+            {
+                // keep recently-used entries at the end, so the first is evicted
+                cache.move (i, cache.size() - 1);
+                return cache.getReference (cache.size() - 1).image;
+            }
+        }
+
+        Image render (Image::ARGB, width, height, true);
+
+        {
+            Graphics g (render);
+            g.addTransform (AffineTransform::translation (-bounds.getX(), -bounds.getY())
+                               .followedBy (AffineTransform::scale ((float) width  / bounds.getWidth(),
+                                                                    (float) height / bounds.getHeight())));
+            commands.replay (g);
+        }
+
+        if (cache.size() >= maxCachedRenders)
+            cache.remove (0);
+
+        cache.add ({ width, height, render });
+        return render;
+    }
+};
+
+//==============================================================================
+LightweightDrawable::LightweightDrawable() noexcept {}
+LightweightDrawable::LightweightDrawable (SharedState* s) noexcept  : state (s) {}
+LightweightDrawable::LightweightDrawable (const LightweightDrawable&) noexcept = default;
+LightweightDrawable& LightweightDrawable::operator= (const LightweightDrawable&) noexcept = default;
+LightweightDrawable::LightweightDrawable (LightweightDrawable&&) noexcept = default;
+LightweightDrawable& LightweightDrawable::operator= (LightweightDrawable&&) noexcept = default;
+LightweightDrawable::~LightweightDrawable() = default;
+
+//==============================================================================
+LightweightDrawable LightweightDrawable::createFromSVG (const XmlElement& svgDocument)
+{
+    auto text = svgDocument.toString();
+    return createFromImageData (text.toRawUTF8(), text.getNumBytesAsUTF8());
+}
+
+LightweightDrawable LightweightDrawable::createFromImageData (const void* data, size_t numBytes)
+{
+    if (data == nullptr || numBytes == 0)
+        return {};
+
+    auto* s = new SharedState();
+    s->sourceData.append (data, numBytes);
+    return LightweightDrawable (s);
+}
+
+LightweightDrawable LightweightDrawable::createFromImageFile (const File& file)
+{
+    MemoryBlock data;
+
+    if (! file.loadFileAsData (data))
+        return {};
+
+    return createFromImageData (data.getData(), data.getSize());
+}
+
+//==============================================================================
+bool LightweightDrawable::isValid() const noexcept
+{
+    if (state == nullptr)
+        return false;
+
+    const ScopedLock sl (state->lock);
+    return state->parsed ? ! state->commands.isEmpty()
+                         : state->sourceData.getSize() != 0;
+}
+
+Rectangle<float> LightweightDrawable::getDrawableBounds() const
+{
+    if (state == nullptr)
+        return {};
+
+    const ScopedLock sl (state->lock);
+    state->parseIfNeeded();
+    return state->bounds;
+}
+
+//==============================================================================
+void LightweightDrawable::draw (Graphics& g, float opacity, const AffineTransform& transform) const
+{
+    if (state == nullptr)
+        return;
+
+    const ScopedLock sl (state->lock);
+    state->parseIfNeeded();
+
+    if (state->commands.isEmpty())
+        return;
+
+    Graphics::ScopedSaveState ss (g);
+    g.addTransform (transform);
+
+    if (opacity < 1.0f)
+    {
+        g.beginTransparencyLayer (opacity);
+        state->commands.replay (g);
+        g.endTransparencyLayer();
+    }
+    else
+    {
+        state->commands.replay (g);
+    }
+}
+
+void LightweightDrawable::drawAt (Graphics& g, float x, float y, float opacity) const
+{
+    draw (g, opacity, AffineTransform::translation (x, y));
+}
+
+void LightweightDrawable::drawWithin (Graphics& g, Rectangle<float> destArea,
+                                      RectanglePlacement placement, float opacity) const
+{
+    if (state == nullptr)
+        return;
+
+    const ScopedLock sl (state->lock);
+    state->parseIfNeeded();
+
+    if (state->commands.isEmpty() || state->bounds.isEmpty() || destArea.isEmpty())
+        return;
+
+    auto placed = state->bounds.transformedBy (placement.getTransformToFit (state->bounds, destArea));
+
+    auto width  = jmax (1, roundToInt (placed.getWidth()));
+    auto height = jmax (1, roundToInt (placed.getHeight()));
+
+    auto render = state->getRenderAtSize (width, height);
+
+    Graphics::ScopedSaveState ss (g);
+    g.setOpacity (opacity);
+    g.drawImage (render, placed, RectanglePlacement::stretchToFit, false);
+}
+
+//==============================================================================
+void LightweightDrawable::clearCachedImages()
+{
+    if (state != nullptr)
+    {
+        const ScopedLock sl (state->lock);
+        state->cache.clear();
+    }
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct LightweightDrawableTests  : public UnitTest
+{
+    LightweightDrawableTests()
+        : UnitTest ("LightweightDrawable", UnitTestCategories::gui)
+    {}
+
+    void runTest() override
+    {
+        const String svg ("<svg width=\"100\" height=\"100\" xmlns=\"http://www.w3.org/2000/svg\">"
+                            "<rect x=\"0\" y=\"0\" width=\"100\" height=\"100\" fill=\"#ff0000\"/>"
+                          "</svg>");
+
+        beginTest ("Parsing is deferred until first use");
+        {
+            auto drawable = LightweightDrawable::createFromImageData (svg.toRawUTF8(),
+                                                                      svg.getNumBytesAsUTF8());
+            expect (drawable.isValid());
+
+            auto bounds = drawable.getDrawableBounds();
+            expect (! bounds.isEmpty());
+            expectWithinAbsoluteError (bounds.getWidth(),  100.0f, 1.0f);
+            expectWithinAbsoluteError (bounds.getHeight(), 100.0f, 1.0f);
+
+            expect (! LightweightDrawable().isValid());
+            expect (! LightweightDrawable::createFromImageData (nullptr, 0).isValid());
+        }
+
+        beginTest ("Vector and cached rendering both produce the content");
+        {
+            auto xml = parseXML (svg);
+            expect (xml != nullptr);
+
+            auto drawable = LightweightDrawable::createFromSVG (*xml);
+
+            {
+                Image target (Image::ARGB, 100, 100, true);
+                Graphics g (target);
+                drawable.draw (g, 1.0f);
+                expect (target.getPixelAt (50, 50) == Colours::red);
+            }
+
+            {
+                Image target (Image::ARGB, 40, 40, true);
+
+                for (int repeat = 0; repeat < 2; ++repeat) // second pass hits the cache
+                {
+                    Graphics g (target);
+                    drawable.drawWithin (g, { 0.0f, 0.0f, 40.0f, 40.0f },
+                                         RectanglePlacement::centred, 1.0f);
+                }
+
+                expect (target.getPixelAt (20, 20) == Colours::red);
+                expect (target.getPixelAt (2, 2) == Colours::red);
+            }
+        }
+
+        beginTest ("Copies share the parsed geometry");
+        {
+            auto xml = parseXML (svg);
+            auto a = LightweightDrawable::createFromSVG (*xml);
+            auto b = a;
+
+            expectEquals (b.getDrawableBounds().toString(), a.getDrawableBounds().toString());
+
+            Image target (Image::ARGB, 20, 20, true);
+            Graphics g (target);
+            b.drawWithin (g, { 0.0f, 0.0f, 20.0f, 20.0f }, RectanglePlacement::centred, 1.0f);
+            expect (target.getPixelAt (10, 10) == Colours::red);
+
+            a.clearCachedImages();
+        }
+    }
+};
+
+static LightweightDrawableTests lightweightDrawableTests;
+
+#endif
+
+} // namespace juce
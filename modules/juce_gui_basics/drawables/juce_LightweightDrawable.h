@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A cheap, non-Component alternative to Drawable for rendering lots of icons.
+
+    Drawable::createFromSVG builds a full Component hierarchy per document,
+    which is flexible but expensive when a UI contains thousands of icons. A
+    LightweightDrawable instead keeps the raw image data and, the first time
+    it's asked to draw, parses it once into a flat DisplayList of drawing
+    commands - no Components are retained. Drawing replays that list, and
+    drawWithin() additionally caches the rasterised result per target size, so
+    repeated paints of an icon at the same size cost a single image blit.
+
+    The class behaves as a value: copies share the parsed command list and the
+    rasterisation cache, so the same icon used by many buttons is parsed and
+    rendered once. Use an ordinary Drawable instead when you need to restyle,
+    hit-test or animate the individual elements of the document.
+
+    @see Drawable, DisplayList
+
+    @tags{GUI}
+*/
+class JUCE_API  LightweightDrawable
+{
+public:
+    //==============================================================================
+    /** Creates an empty, invalid drawable. */
+    LightweightDrawable() noexcept;
+
+    /** Creates a copy which shares the parsed geometry and rasterisation cache. */
+    LightweightDrawable (const LightweightDrawable&) noexcept;
+
+    /** Shares the other object's parsed geometry and rasterisation cache. */
+    LightweightDrawable& operator= (const LightweightDrawable&) noexcept;
+
+    /** Move constructor. */
+    LightweightDrawable (LightweightDrawable&&) noexcept;
+
+    /** Move assignment operator. */
+    LightweightDrawable& operator= (LightweightDrawable&&) noexcept;
+
+    /** Destructor. */
+    ~LightweightDrawable();
+
+    //==============================================================================
+    /** Creates a drawable from an SVG document.
+
+        Note that the document isn't parsed here - that's deferred until the
+        first time the drawable is asked to draw or report its bounds, so
+        creating a large set of these at startup is cheap.
+    */
+    static LightweightDrawable createFromSVG (const XmlElement& svgDocument);
+
+    /** Creates a drawable from some image data, which can be an SVG document or
+        anything that ImageFileFormat understands. The data is copied, and not
+        parsed until first use.
+    */
+    static LightweightDrawable createFromImageData (const void* data, size_t numBytes);
+
+    /** Creates a drawable from an image or SVG file. The file is read here, but
+        not parsed until first use.
+    */
+    static LightweightDrawable createFromImageFile (const File& file);
+
+    //==============================================================================
+    /** Returns true if this object holds something that can be drawn.
+
+        Before the source has been parsed this just means some data is present;
+        afterwards it means the parse actually produced some content.
+    */
+    bool isValid() const noexcept;
+
+    /** Returns the bounds of the content, parsing the source if that hasn't
+        happened yet.
+    */
+    Rectangle<float> getDrawableBounds() const;
+
+    //==============================================================================
+    /** Renders the content by replaying its command list through the given
+        transform. This path doesn't use the rasterisation cache, so it stays
+        sharp under arbitrary transforms.
+    */
+    void draw (Graphics& g, float opacity, const AffineTransform& transform = AffineTransform()) const;
+
+    /** Renders the content with its own origin translated to the given position. */
+    void drawAt (Graphics& g, float x, float y, float opacity) const;
+
+    /** Renders the content scaled to fit a rectangle, using the rasterisation
+        cache.
+
+        The content is rasterised the first time each distinct target size is
+        used and blitted from the cache thereafter. A handful of recently-used
+        sizes are kept per drawable; if the target size changes continuously -
+        during an animation, say - prefer draw(), which skips the cache.
+    */
+    void drawWithin (Graphics& g, Rectangle<float> destArea,
+                     RectanglePlacement placement, float opacity) const;
+
+    //==============================================================================
+    /** Frees any cached rasterisations, e.g. after a global rescale has made
+        the old sizes useless. The parsed geometry is kept.
+    */
+    void clearCachedImages();
+
+private:
+    //==============================================================================
+    struct SharedState;
+    ReferenceCountedObjectPtr<SharedState> state;
+
+    explicit LightweightDrawable (SharedState*) noexcept;
+
+    JUCE_LEAK_DETECTOR (LightweightDrawable)
+};
+
+} // namespace juce
@@ -249,13 +249,7 @@ bool DirectoryContentsList::addFile (const File& file, const bool isDir,
         info->isDirectory      = isDir;
         info->isReadOnly       = isReadOnly;
 
-        for (int i = files.size(); --i >= 0;)
-            if (files.getUnchecked(i)->filename == info->filename)
-                return false;
-
-        files.add (std::move (info));
-
-        std::sort (files.begin(), files.end(), [] (const FileInfo* a, const FileInfo* b)
+        auto comesBefore = [] (const FileInfo* a, const FileInfo* b)
         {
            #if JUCE_WINDOWS
             if (a->isDirectory != b->isDirectory)
@@ -263,8 +257,18 @@ bool DirectoryContentsList::addFile (const File& file, const bool isDir,
            #endif
 
             return a->filename.compareNatural (b->filename) < 0;
-        });
+        };
+
+        // The list is kept sorted as it's built, so a binary search finds both the
+        // insertion point and any existing duplicate - rescanning and re-sorting the
+        // whole array for each file would make big directories quadratically slow
+        auto insertPos = std::lower_bound (files.begin(), files.end(), info.get(), comesBefore);
+
+        for (auto i = insertPos; i != files.end() && ! comesBefore (info.get(), *i); ++i)
+            if ((*i)->filename == info->filename)
+                return false;
 
+        files.insert ((int) std::distance (files.begin(), insertPos), std::move (info));
         return true;
     }
 
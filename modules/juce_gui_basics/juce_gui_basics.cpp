@@ -134,6 +134,7 @@ namespace juce
 #include "components/juce_ComponentListener.cpp"
 #include "components/juce_FocusTraverser.cpp"
 #include "mouse/juce_MouseInputSource.cpp"
+#include "desktop/juce_AnimationScheduler.cpp"
 #include "desktop/juce_Displays.cpp"
 #include "desktop/juce_Desktop.cpp"
 #include "components/juce_ModalComponentManager.cpp"
@@ -163,6 +164,7 @@ namespace juce
 #include "drawables/juce_DrawableRectangle.cpp"
 #include "drawables/juce_DrawableShape.cpp"
 #include "drawables/juce_DrawableText.cpp"
+#include "drawables/juce_LightweightDrawable.cpp"
 #include "drawables/juce_SVGParser.cpp"
 #include "filebrowser/juce_DirectoryContentsDisplayComponent.cpp"
 #include "filebrowser/juce_DirectoryContentsList.cpp"
@@ -179,6 +181,7 @@ namespace juce
 #include "layout/juce_ComponentBoundsConstrainer.cpp"
 #include "layout/juce_ComponentBuilder.cpp"
 #include "layout/juce_ComponentMovementWatcher.cpp"
+#include "layout/juce_DeferredComponentLayout.cpp"
 #include "layout/juce_ConcertinaPanel.cpp"
 #include "layout/juce_GroupComponent.cpp"
 #include "layout/juce_MultiDocumentPanel.cpp"
@@ -230,6 +233,7 @@ namespace juce
 #include "widgets/juce_Toolbar.cpp"
 #include "widgets/juce_ToolbarItemPalette.cpp"
 #include "widgets/juce_TreeView.cpp"
+#include "widgets/juce_ValueTreeItem.cpp"
 #include "windows/juce_AlertWindow.cpp"
 #include "windows/juce_CallOutBox.cpp"
 #include "windows/juce_ComponentPeer.cpp"
@@ -348,10 +352,10 @@ namespace juce
 {
    #if ! JUCE_NATIVE_ACCESSIBILITY_INCLUDED
     class AccessibilityHandler::AccessibilityNativeImpl { public: AccessibilityNativeImpl (AccessibilityHandler&) {} };
-    void AccessibilityHandler::notifyAccessibilityEvent (AccessibilityEvent) const {}
     void AccessibilityHandler::postAnnouncement (const String&, AnnouncementPriority) {}
     AccessibilityNativeHandle* AccessibilityHandler::getNativeImplementation() const { return nullptr; }
     void notifyAccessibilityEventInternal (const AccessibilityHandler&, InternalAccessibilityEvent) {}
+    void notifyAccessibilityEventInternal (const AccessibilityHandler&, AccessibilityEvent) {}
     std::unique_ptr<AccessibilityHandler::AccessibilityNativeImpl> AccessibilityHandler::createNativeImpl (AccessibilityHandler&)
     {
         return nullptr;
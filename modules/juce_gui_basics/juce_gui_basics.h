@@ -182,6 +182,7 @@ namespace juce
 #include "components/juce_ComponentListener.h"
 #include "components/juce_CachedComponentImage.h"
 #include "components/juce_Component.h"
+#include "desktop/juce_AnimationScheduler.h"
 #include "layout/juce_ComponentAnimator.h"
 #include "desktop/juce_Desktop.h"
 #include "desktop/juce_Displays.h"
@@ -216,6 +217,7 @@ namespace juce
 #include "layout/juce_AnimatedPositionBehaviours.h"
 #include "layout/juce_ComponentBuilder.h"
 #include "layout/juce_ComponentMovementWatcher.h"
+#include "layout/juce_DeferredComponentLayout.h"
 #include "layout/juce_ConcertinaPanel.h"
 #include "layout/juce_GroupComponent.h"
 #include "layout/juce_ResizableBorderComponent.h"
@@ -245,6 +247,7 @@ namespace juce
 #include "drawables/juce_DrawablePath.h"
 #include "drawables/juce_DrawableRectangle.h"
 #include "drawables/juce_DrawableText.h"
+#include "drawables/juce_LightweightDrawable.h"
 #include "widgets/juce_TextEditor.h"
 #include "widgets/juce_Label.h"
 #include "widgets/juce_ComboBox.h"
@@ -264,6 +267,7 @@ namespace juce
 #include "misc/juce_FocusOutline.h"
 #include "misc/juce_JUCESplashScreen.h"
 #include "widgets/juce_TreeView.h"
+#include "widgets/juce_ValueTreeItem.h"
 #include "windows/juce_TopLevelWindow.h"
 #include "windows/juce_MessageBoxOptions.h"
 #include "windows/juce_AlertWindow.h"
@@ -214,8 +214,12 @@ private:
 };
 
 //==============================================================================
-ComponentAnimator::ComponentAnimator()  : lastTime (0) {}
-ComponentAnimator::~ComponentAnimator() {}
+ComponentAnimator::ComponentAnimator() {}
+
+ComponentAnimator::~ComponentAnimator()
+{
+    detachFromScheduler();
+}
 
 //==============================================================================
 ComponentAnimator::AnimationTask* ComponentAnimator::findTaskFor (Component* const component) const noexcept
@@ -252,10 +256,11 @@ void ComponentAnimator::animateComponent (Component* const component,
         at->reset (finalBounds, finalAlpha, millisecondsToSpendMoving,
                    useProxyComponent, startSpeed, endSpeed);
 
-        if (! isTimerRunning())
+        if (! attachedToScheduler)
         {
-            lastTime = Time::getMillisecondCounter();
-            startTimerHz (50);
+            pendingTime = 0;
+            attachedToScheduler = true;
+            AnimationScheduler::getInstance()->addListener (this);
         }
     }
 }
@@ -327,14 +332,13 @@ bool ComponentAnimator::isAnimating() const noexcept
     return tasks.size() != 0;
 }
 
-void ComponentAnimator::timerCallback()
+void ComponentAnimator::animationFrameCallback (double deltaSeconds)
 {
-    auto timeNow = Time::getMillisecondCounter();
-
-    if (lastTime == 0)
-        lastTime = timeNow;
-
-    auto elapsed = (int) (timeNow - lastTime);
+    // carry any fractional milliseconds over to the next frame, so that slower
+    // frame rates don't accumulate rounding error and slow the animation down
+    pendingTime += deltaSeconds * 1000.0;
+    auto elapsed = (int) pendingTime;
+    pendingTime -= elapsed;
 
     for (auto* task : Array<AnimationTask*> (tasks.begin(), tasks.size()))
     {
@@ -345,10 +349,19 @@ void ComponentAnimator::timerCallback()
         }
     }
 
-    lastTime = timeNow;
-
     if (tasks.size() == 0)
-        stopTimer();
+        detachFromScheduler();
+}
+
+void ComponentAnimator::detachFromScheduler()
+{
+    if (attachedToScheduler)
+    {
+        attachedToScheduler = false;
+
+        if (auto* scheduler = AnimationScheduler::getInstanceWithoutCreating())
+            scheduler->removeListener (this);
+    }
 }
 
 } // namespace juce
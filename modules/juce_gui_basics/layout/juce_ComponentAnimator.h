@@ -50,7 +50,7 @@ namespace juce
     @tags{GUI}
 */
 class JUCE_API  ComponentAnimator  : public ChangeBroadcaster,
-                                     private Timer
+                                     private AnimationScheduler::Listener
 {
 public:
     //==============================================================================
@@ -151,10 +151,12 @@ private:
     //==============================================================================
     class AnimationTask;
     OwnedArray<AnimationTask> tasks;
-    uint32 lastTime;
+    double pendingTime = 0;
+    bool attachedToScheduler = false;
 
     AnimationTask* findTaskFor (Component*) const noexcept;
-    void timerCallback() override;
+    void animationFrameCallback (double) override;
+    void detachFromScheduler();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ComponentAnimator)
 };
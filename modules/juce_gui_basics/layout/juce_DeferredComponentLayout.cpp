@@ -0,0 +1,286 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+class DeferredComponentLayout::DirtyComponent  : public ComponentMovementWatcher
+{
+public:
+    DirtyComponent (DeferredComponentLayout& o, Component& c)
+        : ComponentMovementWatcher (&c), owner (o)
+    {
+    }
+
+    void componentMovedOrResized (bool, bool) override {}
+    void componentPeerChanged() override {}
+
+    void componentVisibilityChanged() override
+    {
+        // A subtree that was skipped while hidden gets another pass as soon
+        // as it's showing again.
+        if (auto* c = getComponent())
+            if (c->isShowing())
+                owner.triggerAsyncUpdate();
+    }
+
+private:
+    DeferredComponentLayout& owner;
+
+    JUCE_DECLARE_NON_COPYABLE (DirtyComponent)
+};
+
+//==============================================================================
+DeferredComponentLayout::DeferredComponentLayout() = default;
+
+DeferredComponentLayout::~DeferredComponentLayout()
+{
+    cancelPendingUpdate();
+}
+
+void DeferredComponentLayout::markDirty (Component& component)
+{
+    if (! isDirty (component))
+    {
+        dirtyComponents.add (new DirtyComponent (*this, component));
+        triggerAsyncUpdate();
+    }
+}
+
+bool DeferredComponentLayout::isDirty (const Component& component) const noexcept
+{
+    for (auto* entry : dirtyComponents)
+        if (entry->getComponent() == &component)
+            return true;
+
+    return false;
+}
+
+int DeferredComponentLayout::getNumPendingComponents() const noexcept
+{
+    return dirtyComponents.size();
+}
+
+void DeferredComponentLayout::handleAsyncUpdate()
+{
+    resolveNow();
+}
+
+static bool isInsideInvisibleSubtree (const Component& component) noexcept
+{
+    for (auto* c = &component; c != nullptr; c = c->getParentComponent())
+        if (! c->isVisible())
+            return true;
+
+    return false;
+}
+
+static int getComponentDepth (const Component* component) noexcept
+{
+    int depth = 0;
+
+    for (auto* c = component; c != nullptr; c = c->getParentComponent())
+        ++depth;
+
+    return depth;
+}
+
+void DeferredComponentLayout::resolveNow()
+{
+    cancelPendingUpdate();
+
+    // Anything marked dirty from inside a resized() callback lands in
+    // dirtyComponents again and gets its own pass.
+    OwnedArray<DirtyComponent> batch;
+    batch.swapWith (dirtyComponents);
+
+    std::stable_sort (batch.begin(), batch.end(),
+                      [] (const DirtyComponent* a, const DirtyComponent* b)
+                      {
+                          return getComponentDepth (a->getComponent())
+                               < getComponentDepth (b->getComponent());
+                      });
+
+    while (! batch.isEmpty())
+    {
+        std::unique_ptr<DirtyComponent> entry (batch.removeAndReturn (0));
+        auto* component = entry->getComponent();
+
+        if (component == nullptr)  // deleted while it was pending
+            continue;
+
+        if (isInsideInvisibleSubtree (*component))
+        {
+            // Skipped: it stays marked, and its watcher re-schedules a pass
+            // when it becomes visible.
+            dirtyComponents.add (entry.release());
+            continue;
+        }
+
+        entry.reset();  // stop watching before user code runs
+        component->resized();
+    }
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class DeferredComponentLayoutTests  : public UnitTest
+{
+public:
+    DeferredComponentLayoutTests()
+        : UnitTest ("DeferredComponentLayout", UnitTestCategories::gui)
+    {}
+
+    struct CountingComponent  : public Component
+    {
+        void resized() override   { ++numResizedCalls; }
+
+        int numResizedCalls = 0;
+    };
+
+    void runTest() override
+    {
+        beginTest ("Repeated marking resolves to a single layout pass");
+        {
+            DeferredComponentLayout layout;
+            CountingComponent component;
+            component.setVisible (true);
+
+            layout.markDirty (component);
+            layout.markDirty (component);
+            layout.markDirty (component);
+
+            expect (layout.isDirty (component));
+            expectEquals (component.numResizedCalls, 0);
+
+            layout.resolveNow();
+
+            expectEquals (component.numResizedCalls, 1);
+            expect (! layout.isDirty (component));
+
+            layout.resolveNow();
+            expectEquals (component.numResizedCalls, 1);
+        }
+
+        beginTest ("Invisible subtrees are skipped and stay marked");
+        {
+            DeferredComponentLayout layout;
+
+            CountingComponent parent, child;
+            parent.setVisible (true);
+            child.setVisible (true);
+            parent.addChildComponent (child);
+
+            parent.setVisible (false);
+            layout.markDirty (child);
+            layout.resolveNow();
+
+            expectEquals (child.numResizedCalls, 0);
+            expect (layout.isDirty (child));
+
+            parent.setVisible (true);
+            layout.resolveNow();
+
+            expectEquals (child.numResizedCalls, 1);
+            expect (! layout.isDirty (child));
+        }
+
+        beginTest ("Parents are laid out before their children");
+        {
+            DeferredComponentLayout layout;
+            StringArray order;
+            struct Recorder : public Component
+            {
+                Recorder (StringArray& o, String n) : order (o), name (std::move (n)) { setVisible (true); }
+                void resized() override { order.add (name); }
+
+                StringArray& order;
+                String name;
+            };
+
+            Recorder outer (order, "outer"), inner (order, "inner");
+            outer.addChildComponent (inner);
+
+            layout.markDirty (inner);
+            layout.markDirty (outer);
+            layout.resolveNow();
+
+            expectEquals (order.joinIntoString (","), String ("outer,inner"));
+        }
+
+        beginTest ("Deleting a marked component is safe");
+        {
+            DeferredComponentLayout layout;
+
+            auto component = std::make_unique<CountingComponent>();
+            component->setVisible (true);
+            layout.markDirty (*component);
+            component.reset();
+
+            layout.resolveNow();
+            expectEquals (layout.getNumPendingComponents(), 0);
+        }
+
+        beginTest ("setBoundsBatch applies bounds and sends the usual callbacks");
+        {
+            Component parent;
+            parent.setBounds (0, 0, 400, 400);
+
+            CountingComponent childA, childB, childC;
+
+            for (auto* c : { &childA, &childB, &childC })
+            {
+                c->setVisible (true);
+                parent.addChildComponent (c);
+            }
+
+            childC.setBounds (7, 8, 9, 10);
+
+            Array<Component::ChildBoundsUpdate> updates;
+            updates.add ({ &childA, { 0,  0, 100, 20 } });
+            updates.add ({ &childB, { 0, 20, 100, 30 } });
+            updates.add ({ &childC, { 7,  8,   9, 10 } });
+
+            parent.setBoundsBatch (updates);
+
+            expect (childA.getBounds() == Rectangle<int> (0,  0, 100, 20));
+            expect (childB.getBounds() == Rectangle<int> (0, 20, 100, 30));
+            expectEquals (childA.numResizedCalls, 1);
+            expectEquals (childB.numResizedCalls, 1);
+
+            // An entry whose bounds didn't change shouldn't produce callbacks.
+            expectEquals (childC.numResizedCalls, 1);  // from the setBounds above
+        }
+    }
+};
+
+static DeferredComponentLayoutTests deferredComponentLayoutTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Defers and coalesces component layout instead of running it synchronously.
+
+    resized() cascades synchronously through a hierarchy, so during a window
+    drag every intermediate size re-runs layout for all descendants, including
+    ones that aren't even visible. This class offers mark-dirty semantics
+    instead: call markDirty() any number of times on any number of components,
+    and each of them has its resized() run just once, asynchronously, on the
+    next pass of the message loop.
+
+    Components whose subtree is invisible when a pass runs are skipped - they
+    stay marked, and are laid out when they become visible again (or on the
+    next pass after that if there's no window peer to report the change).
+
+    When a pass resolves several components, parents are laid out before their
+    children, so a container that repositions a dirty child does so before the
+    child's own layout runs.
+
+    A typical use is a resized() override that forwards to the scheduler for
+    expensive subtrees:
+
+    @code
+    void resized() override
+    {
+        layoutHeader();                       // cheap, keep synchronous
+        deferredLayout.markDirty (bigGrid);   // expensive, once per frame
+    }
+    @endcode
+
+    @see Component::setBoundsBatch
+
+    @tags{GUI}
+*/
+class JUCE_API  DeferredComponentLayout  : private AsyncUpdater
+{
+public:
+    //==============================================================================
+    DeferredComponentLayout();
+
+    /** Destructor. Any components still marked dirty are abandoned without
+        being laid out.
+    */
+    ~DeferredComponentLayout() override;
+
+    //==============================================================================
+    /** Marks a component as needing its layout re-run.
+
+        Marking an already-marked component does nothing, so this can be called
+        on every change notification however often they arrive.
+    */
+    void markDirty (Component& component);
+
+    /** Returns true if a component is currently waiting to be laid out. */
+    bool isDirty (const Component& component) const noexcept;
+
+    /** Returns the number of components waiting to be laid out. */
+    int getNumPendingComponents() const noexcept;
+
+    /** Runs the layout pass right now instead of waiting for the message loop.
+
+        Invisible subtrees are still skipped and stay marked.
+    */
+    void resolveNow();
+
+private:
+    //==============================================================================
+    class DirtyComponent;
+    OwnedArray<DirtyComponent> dirtyComponents;
+
+    void handleAsyncUpdate() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DeferredComponentLayout)
+};
+
+} // namespace juce
@@ -74,9 +74,85 @@ LookAndFeel_V4::~LookAndFeel_V4()  {}
 void LookAndFeel_V4::setColourScheme (ColourScheme newColourScheme)
 {
     currentColourScheme = newColourScheme;
+    clearDrawingCache();
     initialiseColours();
 }
 
+//==============================================================================
+void LookAndFeel_V4::clearDrawingCache() noexcept
+{
+    cachedDrawings.clearQuick();
+}
+
+void LookAndFeel_V4::setDrawingCacheSize (int maxNumberOfCachedImages) noexcept
+{
+    maxNumCachedDrawings = jmax (0, maxNumberOfCachedImages);
+
+    while (cachedDrawings.size() > maxNumCachedDrawings)
+        cachedDrawings.remove (0);
+}
+
+static uint64 addToDrawingCacheKey (uint64 key, uint64 value) noexcept
+{
+    return key * 31 + value;
+}
+
+void LookAndFeel_V4::drawCachedImage (Graphics& g, uint64 cacheKey, Rectangle<int> area,
+                                      const std::function<void (Graphics&)>& render)
+{
+    if (maxNumCachedDrawings <= 0 || area.isEmpty())
+    {
+        Graphics::ScopedSaveState ss (g);
+        g.setOrigin (area.getPosition());
+        render (g);
+        return;
+    }
+
+    // the cached rasters have to match the physical resolution they'll be
+    // drawn at, so the context's scale becomes part of the key
+    auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    cacheKey = addToDrawingCacheKey (cacheKey, (uint64) roundToInt (scale * 256.0f));
+
+    Image image;
+
+    for (auto& cached : cachedDrawings)
+    {
+        if (cached.key == cacheKey)
+        {
+            cached.lastUseTime = Time::getApproximateMillisecondCounter();
+            image = cached.image;
+            break;
+        }
+    }
+
+    if (image.isNull())
+    {
+        image = Image (Image::ARGB,
+                       jmax (1, roundToInt ((float) area.getWidth()  * scale)),
+                       jmax (1, roundToInt ((float) area.getHeight() * scale)),
+                       true);
+
+        Graphics imageContext (image);
+        imageContext.addTransform (AffineTransform::scale (scale));
+        render (imageContext);
+
+        while (cachedDrawings.size() >= maxNumCachedDrawings)
+        {
+            int oldest = 0;
+
+            for (int i = 1; i < cachedDrawings.size(); ++i)
+                if (cachedDrawings.getReference (i).lastUseTime < cachedDrawings.getReference (oldest).lastUseTime)
+                    oldest = i;
+
+            cachedDrawings.remove (oldest);
+        }
+
+        cachedDrawings.add ({ cacheKey, image, Time::getApproximateMillisecondCounter() });
+    }
+
+    g.drawImage (image, area.toFloat());
+}
+
 LookAndFeel_V4::ColourScheme LookAndFeel_V4::getDarkColourScheme()
 {
     return { 0xff323e44, 0xff263238, 0xff323e44,
@@ -974,11 +1050,26 @@ void LookAndFeel_V4::drawLinearSlider (Graphics& g, int x, int y, int width, int
         Point<float> endPoint (slider.isHorizontal() ? (float) (width + x) : startPoint.x,
                                slider.isHorizontal() ? startPoint.y : (float) y);
 
-        Path backgroundTrack;
-        backgroundTrack.startNewSubPath (startPoint);
-        backgroundTrack.lineTo (endPoint);
-        g.setColour (slider.findColour (Slider::backgroundColourId));
-        g.strokePath (backgroundTrack, { trackWidth, PathStrokeType::curved, PathStrokeType::rounded });
+        auto backgroundColour = slider.findColour (Slider::backgroundColourId);
+
+        auto backgroundKey = addToDrawingCacheKey ((uint64) CachedWidget::linearSliderBackground, (uint64) (uint32) width);
+        backgroundKey = addToDrawingCacheKey (backgroundKey, (uint64) (uint32) height);
+        backgroundKey = addToDrawingCacheKey (backgroundKey, (uint64) backgroundColour.getARGB());
+        backgroundKey = addToDrawingCacheKey (backgroundKey, slider.isHorizontal() ? 1u : 0u);
+
+        // the cached area is expanded a little, as the track's rounded end-caps
+        // poke out beyond the slider rectangle
+        auto cacheArea = Rectangle<int> (x, y, width, height).expanded (4);
+        auto localOffset = -cacheArea.getPosition().toFloat();
+
+        drawCachedImage (g, backgroundKey, cacheArea, [&] (Graphics& cached)
+        {
+            Path backgroundTrack;
+            backgroundTrack.startNewSubPath (startPoint + localOffset);
+            backgroundTrack.lineTo (endPoint + localOffset);
+            cached.setColour (backgroundColour);
+            cached.strokePath (backgroundTrack, { trackWidth, PathStrokeType::curved, PathStrokeType::rounded });
+        });
 
         Path valueTrack;
         Point<float> minPoint, maxPoint, thumbPoint;
@@ -1058,18 +1149,31 @@ void LookAndFeel_V4::drawRotarySlider (Graphics& g, int x, int y, int width, int
     auto lineW = jmin (8.0f, radius * 0.5f);
     auto arcRadius = radius - lineW * 0.5f;
 
-    Path backgroundArc;
-    backgroundArc.addCentredArc (bounds.getCentreX(),
-                                 bounds.getCentreY(),
-                                 arcRadius,
-                                 arcRadius,
-                                 0.0f,
-                                 rotaryStartAngle,
-                                 rotaryEndAngle,
-                                 true);
-
-    g.setColour (outline);
-    g.strokePath (backgroundArc, PathStrokeType (lineW, PathStrokeType::curved, PathStrokeType::rounded));
+    // the background arc is the same for every frame (and for every knob of the
+    // same size and colours), so it's drawn via the raster cache
+    auto backgroundKey = addToDrawingCacheKey ((uint64) CachedWidget::rotarySliderBackground, (uint64) (uint32) width);
+    backgroundKey = addToDrawingCacheKey (backgroundKey, (uint64) (uint32) height);
+    backgroundKey = addToDrawingCacheKey (backgroundKey, (uint64) outline.getARGB());
+    backgroundKey = addToDrawingCacheKey (backgroundKey, (uint64) (uint32) roundToInt (rotaryStartAngle * 1024.0f));
+    backgroundKey = addToDrawingCacheKey (backgroundKey, (uint64) (uint32) roundToInt (rotaryEndAngle   * 1024.0f));
+
+    drawCachedImage (g, backgroundKey, { x, y, width, height }, [&] (Graphics& cached)
+    {
+        auto localBounds = Rectangle<int> (0, 0, width, height).toFloat().reduced (10);
+
+        Path backgroundArc;
+        backgroundArc.addCentredArc (localBounds.getCentreX(),
+                                     localBounds.getCentreY(),
+                                     arcRadius,
+                                     arcRadius,
+                                     0.0f,
+                                     rotaryStartAngle,
+                                     rotaryEndAngle,
+                                     true);
+
+        cached.setColour (outline);
+        cached.strokePath (backgroundArc, PathStrokeType (lineW, PathStrokeType::curved, PathStrokeType::rounded));
+    });
 
     if (slider.isEnabled())
     {
@@ -100,6 +100,27 @@ public:
     void setColourScheme (ColourScheme);
     ColourScheme& getCurrentColourScheme() noexcept       { return currentColourScheme; }
 
+    //==============================================================================
+    /** Discards any widget images that have been cached by the drawing methods.
+
+        Repeated drawing of static widget geometry (e.g. a rotary slider's
+        background arc) goes through a small raster cache, keyed by the widget
+        type, size, state and colours, so a colour or size change simply renders
+        a fresh image rather than producing stale results. This method throws
+        away all the cached images - it's called automatically by
+        setColourScheme(), since a theme change makes most of them garbage, but
+        you can also call it yourself to reclaim the memory.
+    */
+    void clearDrawingCache() noexcept;
+
+    /** Sets the maximum number of widget images that the drawing cache will hold
+        before it starts dropping the least-recently-drawn ones.
+
+        The default is 128. Setting this to 0 disables the cache completely, and
+        all widgets will be rendered from scratch on every draw call.
+    */
+    void setDrawingCacheSize (int maxNumberOfCachedImages) noexcept;
+
     static ColourScheme getDarkColourScheme();
     static ColourScheme getMidnightColourScheme();
     static ColourScheme getGreyColourScheme();
@@ -247,6 +268,26 @@ private:
 
     int getPropertyComponentIndent (PropertyComponent&);
 
+    //==============================================================================
+    enum class CachedWidget
+    {
+        rotarySliderBackground = 1,
+        linearSliderBackground
+    };
+
+    struct CachedDrawing
+    {
+        uint64 key;
+        Image image;
+        uint32 lastUseTime;
+    };
+
+    void drawCachedImage (Graphics&, uint64 cacheKey, Rectangle<int> area,
+                          const std::function<void (Graphics&)>& render);
+
+    Array<CachedDrawing> cachedDrawings;
+    int maxNumCachedDrawings = 128;
+
     //==============================================================================
     void initialiseColours();
     ColourScheme currentColourScheme;
@@ -755,7 +755,7 @@ public:
 //==============================================================================
 AccessibilityNativeHandle* AccessibilityHandler::getNativeImplementation() const
 {
-    return nativeImpl.get();
+    return getOrCreateNativeImpl();
 }
 
 static bool areAnyAccessibilityClientsActive()
@@ -822,6 +822,11 @@ void sendAccessibilityEventImpl (const AccessibilityHandler& handler, int eventT
 void notifyAccessibilityEventInternal (const AccessibilityHandler& handler,
                                        InternalAccessibilityEvent eventType)
 {
+    // Checking this up front avoids walking the handler hierarchy below during
+    // bulk component creation and destruction when no clients are listening.
+    if (! areAnyAccessibilityClientsActive())
+        return;
+
     if (eventType == InternalAccessibilityEvent::elementCreated
         || eventType == InternalAccessibilityEvent::elementDestroyed
         || eventType == InternalAccessibilityEvent::elementMovedOrResized)
@@ -855,7 +860,7 @@ void notifyAccessibilityEventInternal (const AccessibilityHandler& handler,
         sendAccessibilityEventImpl (handler, notification, 0);
 }
 
-void AccessibilityHandler::notifyAccessibilityEvent (AccessibilityEvent eventType) const
+void notifyAccessibilityEventInternal (const AccessibilityHandler& handler, AccessibilityEvent eventType)
 {
     auto notification = [eventType]
     {
@@ -885,7 +890,7 @@ void AccessibilityHandler::notifyAccessibilityEvent (AccessibilityEvent eventTyp
         return 0;
     }();
 
-    sendAccessibilityEventImpl (*this, notification, contentChangeTypes);
+    sendAccessibilityEventImpl (handler, notification, contentChangeTypes);
 }
 
 void AccessibilityHandler::postAnnouncement (const String& announcementString,
@@ -515,7 +515,7 @@ private:
 //==============================================================================
 AccessibilityNativeHandle* AccessibilityHandler::getNativeImplementation() const
 {
-    return (AccessibilityNativeHandle*) nativeImpl->getAccessibilityElement();
+    return (AccessibilityNativeHandle*) getOrCreateNativeImpl()->getAccessibilityElement();
 }
 
 static bool areAnyAccessibilityClientsActive()
@@ -535,6 +535,9 @@ static void sendAccessibilityEvent (UIAccessibilityNotifications notification, i
 
 void notifyAccessibilityEventInternal (const AccessibilityHandler& handler, InternalAccessibilityEvent eventType)
 {
+    if (! areAnyAccessibilityClientsActive())
+        return;
+
     auto notification = [eventType]
     {
         switch (eventType)
@@ -561,8 +564,11 @@ void notifyAccessibilityEventInternal (const AccessibilityHandler& handler, Inte
 
 }
 
-void AccessibilityHandler::notifyAccessibilityEvent (AccessibilityEvent eventType) const
+void notifyAccessibilityEventInternal (const AccessibilityHandler& handler, AccessibilityEvent eventType)
 {
+    if (! areAnyAccessibilityClientsActive())
+        return;
+
     auto notification = [eventType]
     {
         switch (eventType)
@@ -580,7 +586,7 @@ void AccessibilityHandler::notifyAccessibilityEvent (AccessibilityEvent eventTyp
     }();
 
     if (notification != UIAccessibilityNotifications{})
-        sendAccessibilityEvent (notification, (id) getNativeImplementation());
+        sendAccessibilityEvent (notification, (id) handler.getNativeImplementation());
 }
 
 void AccessibilityHandler::postAnnouncement (const String& announcementString, AnnouncementPriority)
@@ -839,7 +839,7 @@ private:
 //==============================================================================
 AccessibilityNativeHandle* AccessibilityHandler::getNativeImplementation() const
 {
-    return (AccessibilityNativeHandle*) nativeImpl->getAccessibilityElement();
+    return (AccessibilityNativeHandle*) getOrCreateNativeImpl()->getAccessibilityElement();
 }
 
 static bool areAnyAccessibilityClientsActive()
@@ -911,7 +911,7 @@ void notifyAccessibilityEventInternal (const AccessibilityHandler& handler, Inte
     sendHandlerNotification (handler, notification);
 }
 
-void AccessibilityHandler::notifyAccessibilityEvent (AccessibilityEvent eventType) const
+void notifyAccessibilityEventInternal (const AccessibilityHandler& handler, AccessibilityEvent eventType)
 {
     auto notification = [eventType]
     {
@@ -929,7 +929,7 @@ void AccessibilityHandler::notifyAccessibilityEvent (AccessibilityEvent eventTyp
         return NSAccessibilityNotificationName{};
     }();
 
-    sendHandlerNotification (*this, notification);
+    sendHandlerNotification (handler, notification);
 }
 
 void AccessibilityHandler::postAnnouncement (const String& announcementString, AnnouncementPriority priority)
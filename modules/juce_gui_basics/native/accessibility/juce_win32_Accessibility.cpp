@@ -91,7 +91,7 @@ int AccessibilityHandler::AccessibilityNativeImpl::providerCount = 0;
 //==============================================================================
 AccessibilityNativeHandle* AccessibilityHandler::getNativeImplementation() const
 {
-    return nativeImpl->accessibilityElement;
+    return getOrCreateNativeImpl()->accessibilityElement;
 }
 
 static bool areAnyAccessibilityClientsActive()
@@ -155,6 +155,12 @@ void sendAccessibilityPropertyChangedEvent (const AccessibilityHandler& handler,
 
 void notifyAccessibilityEventInternal (const AccessibilityHandler& handler, InternalAccessibilityEvent eventType)
 {
+    // Checking this here as well as when sending the event avoids walking the
+    // handler hierarchy below during bulk component creation and destruction
+    // when no accessibility clients are listening.
+    if (! areAnyAccessibilityClientsActive() || isStartingUpOrShuttingDown())
+        return;
+
     if (eventType == InternalAccessibilityEvent::elementCreated
         || eventType == InternalAccessibilityEvent::elementDestroyed)
     {
@@ -191,25 +197,25 @@ void notifyAccessibilityEventInternal (const AccessibilityHandler& handler, Inte
         sendAccessibilityAutomationEvent (handler, event);
 }
 
-void AccessibilityHandler::notifyAccessibilityEvent (AccessibilityEvent eventType) const
+void notifyAccessibilityEventInternal (const AccessibilityHandler& handler, AccessibilityEvent eventType)
 {
     if (eventType == AccessibilityEvent::titleChanged)
     {
         VARIANT newValue;
-        VariantHelpers::setString (getTitle(), &newValue);
+        VariantHelpers::setString (handler.getTitle(), &newValue);
 
-        sendAccessibilityPropertyChangedEvent (*this, UIA_NamePropertyId, newValue);
+        sendAccessibilityPropertyChangedEvent (handler, UIA_NamePropertyId, newValue);
         return;
     }
 
     if (eventType == AccessibilityEvent::valueChanged)
     {
-        if (auto* valueInterface = getValueInterface())
+        if (auto* valueInterface = handler.getValueInterface())
         {
             VARIANT newValue;
             VariantHelpers::setString (valueInterface->getCurrentValueAsString(), &newValue);
 
-            sendAccessibilityPropertyChangedEvent (*this, UIA_ValueValuePropertyId, newValue);
+            sendAccessibilityPropertyChangedEvent (handler, UIA_ValueValuePropertyId, newValue);
         }
 
         return;
@@ -231,7 +237,7 @@ void AccessibilityHandler::notifyAccessibilityEvent (AccessibilityEvent eventTyp
     }();
 
     if (event != EVENTID{})
-        sendAccessibilityAutomationEvent (*this, event);
+        sendAccessibilityAutomationEvent (handler, event);
 }
 
 struct SpVoiceWrapper  : public DeletedAtShutdown
@@ -993,7 +993,7 @@ public:
         return std::make_unique<LowLevelGraphicsSoftwareRenderer> (Image (this));
     }
 
-    void initialiseBitmapData (Image::BitmapData& bitmap, int x, int y, Image::BitmapData::ReadWriteMode mode) override
+    void initialiseBitmapData (Image::BitmapData& bitmap, int x, int y, Image::BitmapData::ReadWriteMode /*mode*/) override
     {
         const auto offset = (size_t) (x * pixelStride + y * lineStride);
         bitmap.data = imageData + offset;
@@ -1001,9 +1001,6 @@ public:
         bitmap.pixelFormat = pixelFormat;
         bitmap.lineStride = lineStride;
         bitmap.pixelStride = pixelStride;
-
-        if (mode != Image::BitmapData::readOnly)
-            sendDataChangeMessage();
     }
 
     ImagePixelData::Ptr clone() override
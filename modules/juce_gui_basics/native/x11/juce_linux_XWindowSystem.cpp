@@ -966,7 +966,7 @@ public:
     }
 
     void initialiseBitmapData (Image::BitmapData& bitmap, int x, int y,
-                               Image::BitmapData::ReadWriteMode mode) override
+                               Image::BitmapData::ReadWriteMode /*mode*/) override
     {
         const auto offset = (size_t) (x * pixelStride + y * lineStride);
         bitmap.data = imageData + offset;
@@ -974,9 +974,6 @@ public:
         bitmap.pixelFormat = pixelFormat;
         bitmap.lineStride = lineStride;
         bitmap.pixelStride = pixelStride;
-
-        if (mode != Image::BitmapData::readOnly)
-            sendDataChangeMessage();
     }
 
     ImagePixelData::Ptr clone() override
@@ -155,6 +155,54 @@ Component* RelativeCoordinatePositionerBase::ComponentScope::findSiblingComponen
     return nullptr;
 }
 
+//==============================================================================
+RelativeCoordinatePositionerBase::CachedComponentScope::CachedComponentScope (Component& comp,
+                                                                              RelativeCoordinatePositionerBase& p)
+    : ComponentScope (comp), positioner (p)
+{
+}
+
+Expression RelativeCoordinatePositionerBase::CachedComponentScope::getSymbolValue (const String& symbol) const
+{
+    auto type = RelativeCoordinate::StandardStrings::getTypeOf (symbol);
+
+    if (type != RelativeCoordinate::StandardStrings::parent
+         && type != RelativeCoordinate::StandardStrings::unknown)
+        return ComponentScope::getSymbolValue (symbol); // a direct member read - nothing worth caching
+
+    const auto key = getScopeUID() + "/" + symbol;
+
+    Expression cached;
+
+    if (positioner.lookupCachedSymbol (key, cached))
+        return cached;
+
+    if (auto* parent = component.getParentComponent())
+    {
+        MarkerList* list = nullptr;
+
+        if (auto* marker = MarkerListScope::findMarker (*parent, symbol, list))
+        {
+            MarkerListScope scope (*parent);
+            Expression value (marker->position.getExpression().evaluate (scope));
+            positioner.cacheSymbolValue (key, value, parent, list);
+            return value;
+        }
+    }
+
+    return ComponentScope::getSymbolValue (symbol);
+}
+
+void RelativeCoordinatePositionerBase::CachedComponentScope::visitRelativeScope (const String& scopeName, Visitor& visitor) const
+{
+    if (auto* targetComp = (scopeName == RelativeCoordinate::Strings::parent)
+                               ? component.getParentComponent()
+                               : findSiblingComponent (scopeName))
+        visitor.visit (CachedComponentScope (*targetComp, positioner));
+    else
+        Expression::Scope::visitRelativeScope (scopeName, visitor);
+}
+
 //==============================================================================
 class RelativeCoordinatePositionerBase::DependencyFinderScope  : public ComponentScope
 {
@@ -243,13 +291,15 @@ RelativeCoordinatePositionerBase::~RelativeCoordinatePositionerBase()
     unregisterListeners();
 }
 
-void RelativeCoordinatePositionerBase::componentMovedOrResized (Component&, bool /*wasMoved*/, bool /*wasResized*/)
+void RelativeCoordinatePositionerBase::componentMovedOrResized (Component& comp, bool /*wasMoved*/, bool /*wasResized*/)
 {
+    invalidateCachedSymbolsFor (&comp);
     apply();
 }
 
 void RelativeCoordinatePositionerBase::componentParentHierarchyChanged (Component&)
 {
+    symbolCache.clear();
     apply();
 }
 
@@ -263,11 +313,13 @@ void RelativeCoordinatePositionerBase::componentBeingDeleted (Component& comp)
 {
     jassert (sourceComponents.contains (&comp));
     sourceComponents.removeFirstMatchingValue (&comp);
+    invalidateCachedSymbolsFor (&comp);
     registeredOk = false;
 }
 
-void RelativeCoordinatePositionerBase::markersChanged (MarkerList*)
+void RelativeCoordinatePositionerBase::markersChanged (MarkerList* markerList)
 {
+    invalidateCachedSymbolsFor (markerList);
     apply();
 }
 
@@ -275,6 +327,7 @@ void RelativeCoordinatePositionerBase::markerListBeingDeleted (MarkerList* marke
 {
     jassert (sourceMarkerLists.contains (markerList));
     sourceMarkerLists.removeFirstMatchingValue (markerList);
+    invalidateCachedSymbolsFor (markerList);
 }
 
 void RelativeCoordinatePositionerBase::apply()
@@ -282,6 +335,7 @@ void RelativeCoordinatePositionerBase::apply()
     if (! registeredOk)
     {
         unregisterListeners();
+        symbolCache.clear();
         registeredOk = registerCoordinates();
     }
 
@@ -302,6 +356,45 @@ bool RelativeCoordinatePositionerBase::addPoint (const RelativePoint& point)
     return addCoordinate (point.y) && ok;
 }
 
+bool RelativeCoordinatePositionerBase::lookupCachedSymbol (const String& key, Expression& result) const
+{
+    if (! symbolCache.contains (key))
+        return false;
+
+    result = symbolCache[key].value;
+    return true;
+}
+
+void RelativeCoordinatePositionerBase::cacheSymbolValue (const String& key, const Expression& value,
+                                                         Component* sourceComponent, MarkerList* sourceMarkerList)
+{
+    symbolCache.set (key, { sourceComponent, sourceMarkerList, value });
+}
+
+void RelativeCoordinatePositionerBase::invalidateCachedSymbolsFor (const Component* comp)
+{
+    StringArray keysToRemove;
+
+    for (HashMap<String, CachedSymbol>::Iterator i (symbolCache); i.next();)
+        if (i.getValue().sourceComponent == comp)
+            keysToRemove.add (i.getKey());
+
+    for (auto& key : keysToRemove)
+        symbolCache.remove (key);
+}
+
+void RelativeCoordinatePositionerBase::invalidateCachedSymbolsFor (const MarkerList* list)
+{
+    StringArray keysToRemove;
+
+    for (HashMap<String, CachedSymbol>::Iterator i (symbolCache); i.next();)
+        if (i.getValue().sourceMarkerList == list)
+            keysToRemove.add (i.getKey());
+
+    for (auto& key : keysToRemove)
+        symbolCache.remove (key);
+}
+
 void RelativeCoordinatePositionerBase::registerComponentListener (Component& comp)
 {
     if (! sourceComponents.contains (&comp))
@@ -69,6 +69,30 @@ public:
         Component* findSiblingComponent (const String& componentID) const;
     };
 
+    //==============================================================================
+    /** A ComponentScope which serves expensive symbols from a cache owned by the positioner.
+
+        Standard component attributes (left, right, width, etc.) are already direct
+        member reads, so these are resolved as normal, but symbols that are costly
+        to look up - marker positions in particular, which involve finding the
+        marker by name and evaluating its own expression tree - are resolved once
+        and then re-used. Each cached value remembers which component and marker
+        list it came from, and the positioner discards it when that source
+        changes, so a single moved anchor only forces re-evaluation of the
+        symbols that actually depend on it.
+    */
+    class CachedComponentScope  : public ComponentScope
+    {
+    public:
+        CachedComponentScope (Component&, RelativeCoordinatePositionerBase&);
+
+        Expression getSymbolValue (const String& symbol) const override;
+        void visitRelativeScope (const String& scopeName, Visitor&) const override;
+
+    private:
+        RelativeCoordinatePositionerBase& positioner;
+    };
+
 protected:
     virtual bool registerCoordinates() = 0;
     virtual void applyToComponentBounds() = 0;
@@ -80,6 +104,20 @@ private:
     Array<MarkerList*> sourceMarkerLists;
     bool registeredOk;
 
+    struct CachedSymbol
+    {
+        Component* sourceComponent = nullptr;
+        MarkerList* sourceMarkerList = nullptr;
+        Expression value;
+    };
+
+    HashMap<String, CachedSymbol> symbolCache;
+
+    bool lookupCachedSymbol (const String& key, Expression& result) const;
+    void cacheSymbolValue (const String& key, const Expression& value, Component*, MarkerList*);
+    void invalidateCachedSymbolsFor (const Component*);
+    void invalidateCachedSymbolsFor (const MarkerList*);
+
     void registerComponentListener (Component&);
     void registerMarkerListListener (MarkerList*);
     void unregisterListeners();
@@ -224,7 +224,7 @@ public:
     {
         for (int i = 32; --i >= 0;)
         {
-            ComponentScope scope (getComponent());
+            CachedComponentScope scope (getComponent(), *this);
             const Rectangle<int> newBounds (rectangle.resolve (&scope).getSmallestIntegerContainer());
 
             if (newBounds == getComponent().getBounds())
@@ -240,7 +240,7 @@ public:
     {
         if (newBounds != getComponent().getBounds())
         {
-            ComponentScope scope (getComponent());
+            CachedComponentScope scope (getComponent(), *this);
             rectangle.moveToAbsolute (newBounds.toFloat(), &scope);
 
             applyToComponentBounds();
@@ -83,6 +83,7 @@ public:
         {
             setMouseCursor (m->getMouseCursorForRow (row));
 
+            rowId = m->getIdForRow (newRow);
             customComponent.reset (m->refreshComponentForRow (newRow, nowSelected, customComponent.release()));
 
             if (customComponent != nullptr)
@@ -99,6 +100,22 @@ public:
         }
     }
 
+    /** Called by the incremental update path for a row whose underlying item is
+        unchanged: renumbers and repaints, but keeps the custom component and skips
+        the model refresh callbacks that update() performs.
+    */
+    void updateRowNumberOnly (const int newRow, const bool nowSelected)
+    {
+        if (row != newRow || isSelected != nowSelected)
+        {
+            row = newRow;
+            isSelected = nowSelected;
+            repaint();
+        }
+    }
+
+    int64 getDisplayedRowId() const noexcept    { return rowId; }
+
     void performSelection (const MouseEvent& e, bool isMouseUp)
     {
         owner.selectRowsBasedOnModifierKeys (row, e.mods, isMouseUp);
@@ -266,6 +283,7 @@ public:
     ListBox& owner;
     std::unique_ptr<Component> customComponent;
     int row = -1;
+    int64 rowId = std::numeric_limits<int64>::min();
     bool isSelected = false, isDragging = false, isDraggingToScroll = false, selectRowOnMouseUp = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RowComponent)
@@ -373,6 +391,9 @@ public:
 
             auto startIndex = jmax (0, firstIndex - 1);
 
+            if (activeRowChanges != nullptr)
+                reassignComponentsByRowId (startIndex, numNeeded);
+
             for (int i = 0; i < numNeeded; ++i)
             {
                 const int row = i + startIndex;
@@ -380,7 +401,15 @@ public:
                 if (auto* rowComp = getComponentForRowWrapped (row))
                 {
                     rowComp->setBounds (0, row * rowH, w, rowH);
-                    rowComp->update (row, owner.isRowSelected (row));
+
+                    if (activeRowChanges != nullptr
+                         && owner.model != nullptr
+                         && isPositiveAndBelow (row, owner.totalItems)
+                         && rowComp->getDisplayedRowId() == owner.model->getIdForRow (row)
+                         && ! activeRowChanges->rowNeedsRefresh (row))
+                        rowComp->updateRowNumberOnly (row, owner.isRowSelected (row));
+                    else
+                        rowComp->update (row, owner.isRowSelected (row));
                 }
             }
         }
@@ -393,6 +422,21 @@ public:
                                               owner.headerComponent->getHeight());
     }
 
+    int getFirstVisibleRow() const noexcept     { return firstIndex; }
+
+    void patchVisibleRows (const ListBox::RowChanges& changes, int anchorDeltaInRows)
+    {
+        const ScopedValueSetter<const ListBox::RowChanges*> setter (activeRowChanges, &changes);
+
+        // shifting the view by the anchor row's displacement keeps the same item
+        // at the top of the view, including any partial-row scroll offset
+        if (anchorDeltaInRows != 0)
+            setViewPosition (getViewPositionX(),
+                             jmax (0, getViewPositionY() + anchorDeltaInRows * owner.getRowHeight()));
+
+        updateVisibleArea (true);
+    }
+
     void selectRow (const int row, const int rowH, const bool dontScroll,
                     const int lastSelectedRow, const int totalRows, const bool isMouseClick)
     {
@@ -474,8 +518,60 @@ private:
             handler->notifyAccessibilityEvent (AccessibilityEvent::structureChanged);
     }
 
+    /* Permutes the component pool so that any component which is already showing
+       the item that has ended up at each visible row lands in that row's slot,
+       letting the update loop renumber it instead of rebuilding it.
+    */
+    void reassignComponentsByRowId (int startIndex, int numNeeded)
+    {
+        auto* m = owner.getModel();
+        const int num = rows.size();
+
+        if (m == nullptr || num == 0)
+            return;
+
+        Array<RowComponent*> pool, slots;
+        pool.ensureStorageAllocated (num);
+
+        for (auto* r : rows)
+            pool.add (r);
+
+        slots.insertMultiple (0, nullptr, num);
+
+        for (int i = 0; i < numNeeded; ++i)
+        {
+            const int row = startIndex + i;
+
+            if (! isPositiveAndBelow (row, owner.totalItems))
+                continue;
+
+            const auto id = m->getIdForRow (row);
+
+            for (int j = 0; j < pool.size(); ++j)
+            {
+                if (pool.getUnchecked (j)->getDisplayedRowId() == id)
+                {
+                    slots.set (row % num, pool.removeAndReturn (j));
+                    break;
+                }
+            }
+        }
+
+        for (int i = 0; i < num; ++i)
+            if (slots.getUnchecked (i) == nullptr)
+                slots.set (i, pool.removeAndReturn (pool.size() - 1));
+
+        jassert (pool.isEmpty());
+
+        rows.clearQuick (false);
+
+        for (auto* r : slots)
+            rows.add (r);
+    }
+
     ListBox& owner;
     OwnedArray<RowComponent> rows;
+    const ListBox::RowChanges* activeRowChanges = nullptr;
     int firstIndex = 0, firstWholeIndex = 0, lastWholeIndex = 0;
     bool hasUpdated = false;
 
@@ -511,6 +607,140 @@ struct ListBoxMouseMoveSelector  : public MouseListener
 };
 
 
+//==============================================================================
+void ListBox::RowChanges::rowsInserted (int firstRowNumber, int numRows)
+{
+    jassert (firstRowNumber >= 0 && numRows > 0);
+    changes.add ({ Change::Type::insert, firstRowNumber, 0, numRows });
+}
+
+void ListBox::RowChanges::rowsRemoved (int firstRowNumber, int numRows)
+{
+    jassert (firstRowNumber >= 0 && numRows > 0);
+    changes.add ({ Change::Type::remove, firstRowNumber, 0, numRows });
+}
+
+void ListBox::RowChanges::rowsMoved (int oldStartRowNumber, int newStartRowNumber, int numRows)
+{
+    jassert (oldStartRowNumber >= 0 && newStartRowNumber >= 0 && numRows > 0);
+    changes.add ({ Change::Type::move, oldStartRowNumber, newStartRowNumber, numRows });
+}
+
+void ListBox::RowChanges::rowsChanged (int firstRowNumber, int numRows)
+{
+    jassert (firstRowNumber >= 0 && numRows > 0);
+    changes.add ({ Change::Type::refresh, firstRowNumber, 0, numRows });
+}
+
+bool ListBox::RowChanges::isEmpty() const noexcept
+{
+    return changes.isEmpty();
+}
+
+int ListBox::RowChanges::getUpdatedRowNumber (int rowNumber) const noexcept
+{
+    if (rowNumber < 0)
+        return -1;
+
+    auto result = rowNumber;
+
+    for (auto& c : changes)
+    {
+        switch (c.type)
+        {
+            case Change::Type::insert:
+                if (result >= c.index)
+                    result += c.numRows;
+
+                break;
+
+            case Change::Type::remove:
+                if (result >= c.index + c.numRows)
+                    result -= c.numRows;
+                else if (result >= c.index)
+                    return -1;
+
+                break;
+
+            case Change::Type::move:
+                if (result >= c.index && result < c.index + c.numRows)
+                {
+                    result = c.destIndex + (result - c.index);
+                }
+                else
+                {
+                    // the block is pulled out, closing the gap, and re-inserted
+                    if (result >= c.index + c.numRows)
+                        result -= c.numRows;
+
+                    if (result >= c.destIndex)
+                        result += c.numRows;
+                }
+
+                break;
+
+            case Change::Type::refresh:
+                break;
+        }
+    }
+
+    return result;
+}
+
+bool ListBox::RowChanges::rowNeedsRefresh (int updatedRowNumber) const noexcept
+{
+    // walks the edits backwards, tracking where this row was at each point in
+    // time, to see whether it was freshly inserted or marked as changed
+    auto row = updatedRowNumber;
+
+    for (int i = changes.size(); --i >= 0;)
+    {
+        auto& c = changes.getReference (i);
+
+        switch (c.type)
+        {
+            case Change::Type::insert:
+                if (row >= c.index && row < c.index + c.numRows)
+                    return true;
+
+                if (row >= c.index + c.numRows)
+                    row -= c.numRows;
+
+                break;
+
+            case Change::Type::remove:
+                if (row >= c.index)
+                    row += c.numRows;
+
+                break;
+
+            case Change::Type::move:
+                if (row >= c.destIndex && row < c.destIndex + c.numRows)
+                {
+                    row = c.index + (row - c.destIndex);
+                }
+                else
+                {
+                    if (row >= c.destIndex + c.numRows)
+                        row -= c.numRows;
+
+                    if (row >= c.index)
+                        row += c.numRows;
+                }
+
+                break;
+
+            case Change::Type::refresh:
+                if (row >= c.index && row < c.index + c.numRows)
+                    return true;
+
+                break;
+        }
+    }
+
+    return false;
+}
+
 //==============================================================================
 ListBox::ListBox (const String& name, ListBoxModel* const m)
     : Component (name), model (m)
@@ -622,6 +852,51 @@ void ListBox::updateContent()
     }
 }
 
+void ListBox::updateContent (const RowChanges& changes)
+{
+    if (model == nullptr || changes.isEmpty() || ! hasDoneInitialUpdate)
+    {
+        updateContent();
+        return;
+    }
+
+    const auto previousAnchorRow = viewport->getFirstVisibleRow();
+    totalItems = model->getNumRows();
+
+    // move the selection along with the rows it refers to
+    SparseSet<int> newSelection;
+    bool selectionChanged = false;
+
+    for (int i = 0; i < selected.size(); ++i)
+    {
+        const auto newRow = changes.getUpdatedRowNumber (selected[i]);
+
+        if (isPositiveAndBelow (newRow, totalItems))
+            newSelection.addRange ({ newRow, newRow + 1 });
+        else
+            selectionChanged = true;  // a selected row was removed
+    }
+
+    selected = newSelection;
+    lastRowSelected = changes.getUpdatedRowNumber (lastRowSelected);
+
+    if (lastRowSelected < 0)
+        lastRowSelected = getSelectedRow (0);
+
+    const auto newAnchorRow = changes.getUpdatedRowNumber (previousAnchorRow);
+
+    viewport->patchVisibleRows (changes, newAnchorRow >= 0 ? newAnchorRow - previousAnchorRow : 0);
+    viewport->resized();
+
+    if (selectionChanged)
+    {
+        model->selectedRowsChanged (lastRowSelected);
+
+        if (auto* handler = getAccessibilityHandler())
+            handler->notifyAccessibilityEvent (AccessibilityEvent::rowSelectionChanged);
+    }
+}
+
 //==============================================================================
 void ListBox::selectRow (int row, bool dontScroll, bool deselectOthersFirst)
 {
@@ -1177,6 +1452,7 @@ Component* ListBoxModel::refreshComponentForRow (int, bool, Component* existingC
 }
 
 String ListBoxModel::getNameForRow (int rowNumber)                      { return "Row " + String (rowNumber + 1); }
+int64 ListBoxModel::getIdForRow (int rowNumber)                         { return rowNumber; }
 void ListBoxModel::listBoxItemClicked (int, const MouseEvent&) {}
 void ListBoxModel::listBoxItemDoubleClicked (int, const MouseEvent&) {}
 void ListBoxModel::backgroundClicked (const MouseEvent&) {}
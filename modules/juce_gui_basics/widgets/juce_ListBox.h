@@ -92,6 +92,24 @@ public:
     */
     virtual String getNameForRow (int rowNumber);
 
+    /** This can be overridden to give each row a stable identity that survives
+        insertions, removals and re-sorts.
+
+        The incremental overload of ListBox::updateContent() uses these IDs to
+        recognise which on-screen row components are still showing the same item
+        after an edit, so that they can simply be renumbered and repositioned
+        rather than rebuilt.
+
+        The default implementation returns the row number, which means a row is
+        only considered unchanged if it hasn't shifted. If your model supplies
+        custom row components, you should override this to return a genuinely
+        stable ID (for example a hash of a key, or a pointer-derived value), or
+        shifted rows will keep showing their old components' content.
+
+        @see ListBox::updateContent (const ListBox::RowChanges&)
+    */
+    virtual int64 getIdForRow (int rowNumber);
+
     /** This can be overridden to react to the user clicking on a row.
         @see listBoxItemDoubleClicked
     */
@@ -213,6 +231,86 @@ public:
     */
     void updateContent();
 
+    //==============================================================================
+    /** Describes a set of edits that have been applied to a ListBoxModel's rows,
+        for use with the incremental overload of updateContent().
+
+        Record each edit in the order it was applied to your model's data; the
+        row numbers passed to each method refer to the state of the data at the
+        moment that particular edit was made, which is the natural way to record
+        them while performing the edits.
+
+        @see ListBox::updateContent (const ListBox::RowChanges&), ListBoxModel::getIdForRow
+    */
+    class JUCE_API  RowChanges
+    {
+    public:
+        RowChanges() = default;
+
+        /** Records that a contiguous block of rows was inserted. */
+        void rowsInserted (int firstRowNumber, int numRows);
+
+        /** Records that a contiguous block of rows was removed. */
+        void rowsRemoved (int firstRowNumber, int numRows);
+
+        /** Records that a contiguous block of rows was moved to a new position.
+
+            The arguments work like Array::move: oldStartRowNumber is where the
+            block started before the move, and newStartRowNumber is where it
+            starts once it has been re-inserted.
+        */
+        void rowsMoved (int oldStartRowNumber, int newStartRowNumber, int numRows);
+
+        /** Records that the content of a contiguous block of rows changed in
+            place, so their components must be fully refreshed even though their
+            position and identity are unchanged.
+        */
+        void rowsChanged (int firstRowNumber, int numRows);
+
+        /** Returns true if no edits have been recorded. */
+        bool isEmpty() const noexcept;
+
+        /** Returns the row number at which the given row ends up once all the
+            recorded edits have been applied, or -1 if that row was removed.
+        */
+        int getUpdatedRowNumber (int rowNumber) const noexcept;
+
+    private:
+        friend class ListBox;
+
+        struct Change
+        {
+            enum class Type { insert, remove, move, refresh };
+
+            Type type;
+            int index, destIndex, numRows;
+        };
+
+        bool rowNeedsRefresh (int updatedRowNumber) const noexcept;
+
+        Array<Change> changes;
+    };
+
+    /** Refreshes the list incrementally after a known set of model edits.
+
+        Unlike the plain updateContent(), which refreshes every visible row
+        component, this only patches the components whose content has actually
+        changed: components whose rows merely shifted keep their custom component
+        and are just renumbered and repositioned, the selection follows the rows
+        it refers to, and the scroll position is adjusted so that the row at the
+        top of the view stays anchored. The cost is proportional to the number of
+        edits and visible rows, not the total size of the list.
+
+        For this to work properly with custom row components, the model should
+        override ListBoxModel::getIdForRow() to give its rows a stable identity.
+
+        This must only be called from the main message thread, after the model's
+        data has already been updated.
+
+        @see RowChanges, updateContent, ListBoxModel::getIdForRow
+    */
+    void updateContent (const RowChanges& changes);
+
     //==============================================================================
     /** Turns on multiple-selection of rows.
 
@@ -470,6 +470,11 @@ Component* TableListBox::refreshComponentForRow (int rowNumber, bool rowSelected
     return existingComponentToUpdate;
 }
 
+int64 TableListBox::getIdForRow (int rowNumber)
+{
+    return model != nullptr ? model->getIdForRow (rowNumber) : rowNumber;
+}
+
 void TableListBox::selectedRowsChanged (int row)
 {
     if (model != nullptr)
@@ -600,6 +605,7 @@ void TableListBoxModel::cellDoubleClicked (int, int, const MouseEvent&) {}
 void TableListBoxModel::backgroundClicked (const MouseEvent&)           {}
 void TableListBoxModel::sortOrderChanged (int, bool)                    {}
 int TableListBoxModel::getColumnAutoSizeWidth (int)                     { return 0; }
+int64 TableListBoxModel::getIdForRow (int rowNumber)                    { return rowNumber; }
 void TableListBoxModel::selectedRowsChanged (int)                       {}
 void TableListBoxModel::deleteKeyPressed (int)                          {}
 void TableListBoxModel::returnKeyPressed (int)                          {}
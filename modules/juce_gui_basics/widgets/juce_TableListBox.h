@@ -127,6 +127,17 @@ public:
     */
     virtual void backgroundClicked (const MouseEvent&);
 
+    //==============================================================================
+    /** This can be overridden to give each row a stable identity that survives
+        insertions, removals and re-sorts, for use with the incremental overload
+        of TableListBox::updateContent().
+
+        The default implementation returns the row number.
+
+        @see ListBoxModel::getIdForRow, ListBox::RowChanges
+    */
+    virtual int64 getIdForRow (int rowNumber);
+
     //==============================================================================
     /** This callback is made when the table's sort order is changed.
 
@@ -307,6 +318,8 @@ public:
     /** @internal */
     Component* refreshComponentForRow (int rowNumber, bool isRowSelected, Component* existingComponentToUpdate) override;
     /** @internal */
+    int64 getIdForRow (int rowNumber) override;
+    /** @internal */
     void selectedRowsChanged (int row) override;
     /** @internal */
     void deleteKeyPressed (int currentSelectedRow) override;
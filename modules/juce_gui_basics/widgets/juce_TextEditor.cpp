@@ -282,10 +282,21 @@ struct TextEditor::Iterator
         wordWrapWidth ((float) ed.getWordWrapWidth()),
         passwordCharacter (ed.passwordCharacter),
         lineSpacing (ed.lineSpacing),
-        underlineWhitespace (ed.underlineWhitespace)
+        underlineWhitespace (ed.underlineWhitespace),
+        layoutIndex (&ed.layoutIndex)
     {
         jassert (wordWrapWidth > 0);
 
+        if (layoutIndex->wordWrapWidth != wordWrapWidth
+             || layoutIndex->lineSpacing != lineSpacing
+             || layoutIndex->passwordCharacter != passwordCharacter)
+        {
+            layoutIndex->checkpoints.clearQuick();
+            layoutIndex->wordWrapWidth = wordWrapWidth;
+            layoutIndex->lineSpacing = lineSpacing;
+            layoutIndex->passwordCharacter = passwordCharacter;
+        }
+
         if (! sections.isEmpty())
         {
             currentSection = sections.getUnchecked (sectionIndex);
@@ -304,7 +315,10 @@ struct TextEditor::Iterator
     bool next()
     {
         if (atom == &longAtom && chunkLongAtom (true))
+        {
+            maxLineRight = jmax (maxLineRight, atomRight);
             return true;
+        }
 
         if (sectionIndex >= sections.size())
         {
@@ -380,9 +394,14 @@ struct TextEditor::Iterator
             indexInText += atom->numChars;
 
             if (atom->isNewLine())
+            {
                 beginNewLine();
+                recordCheckpoint (atomIndex);
+            }
             else
+            {
                 isInPreviousAtom = true;
+            }
         }
 
         atom = &(currentSection->atoms.getReference (atomIndex));
@@ -406,10 +425,12 @@ struct TextEditor::Iterator
             else
             {
                 beginNewLine();
+                recordCheckpoint (atomIndex - 1);
                 atomRight = atomX + atom->width;
             }
         }
 
+        maxLineRight = jmax (maxLineRight, atomRight);
         return true;
     }
 
@@ -596,9 +617,55 @@ struct TextEditor::Iterator
         return indexInText + j;
     }
 
+    //==============================================================================
+    /** Fast-forwards to the last recorded line-start at or before the given index,
+        so that the next call to next() resumes from there rather than the top of
+        the document. Only ever jumps forwards.
+    */
+    void seekToIndex (int index)
+    {
+        auto& checkpoints = layoutIndex->checkpoints;
+        int start = 0, end = checkpoints.size();
+
+        while (start < end)
+        {
+            auto mid = (start + end) / 2;
+
+            if (checkpoints.getReference (mid).indexInText <= index)
+                start = mid + 1;
+            else
+                end = mid;
+        }
+
+        resumeFromNearestCheckpoint (start - 1);
+    }
+
+    /** As seekToIndex(), but targets a vertical position. */
+    void seekToY (float y)
+    {
+        auto& checkpoints = layoutIndex->checkpoints;
+        int start = 0, end = checkpoints.size();
+
+        while (start < end)
+        {
+            auto mid = (start + end) / 2;
+
+            if (checkpoints.getReference (mid).lineY < y)
+                start = mid + 1;
+            else
+                end = mid;
+        }
+
+        // step back an extra checkpoint, as an unusually tall line starting just before
+        // the target can extend beyond later line-starts
+        resumeFromNearestCheckpoint (start - 2);
+    }
+
     //==============================================================================
     bool getCharPosition (int index, Point<float>& anchor, float& lineHeightFound)
     {
+        seekToIndex (index);
+
         while (next())
         {
             if (indexInText + atom->numChars > index)
@@ -619,6 +686,8 @@ struct TextEditor::Iterator
         if (justification.testFlags (Justification::top) || lineY >= bottomRight.y)
             return 0;
 
+        seekToIndex (std::numeric_limits<int>::max());
+
         while (next())
         {
             if (lineY >= bottomRight.y)
@@ -635,6 +704,8 @@ struct TextEditor::Iterator
 
     int getTotalTextHeight()
     {
+        seekToIndex (std::numeric_limits<int>::max());
+
         while (next()) {}
 
         auto height = lineY + lineHeight + getYOffset();
@@ -647,12 +718,11 @@ struct TextEditor::Iterator
 
     int getTextRight()
     {
-        float maxWidth = 0.0f;
+        seekToIndex (std::numeric_limits<int>::max());
 
-        while (next())
-            maxWidth = jmax (maxWidth, atomRight);
+        while (next()) {}
 
-        return roundToInt (maxWidth);
+        return roundToInt (maxLineRight);
     }
 
     Rectangle<int> getTextBounds (Range<int> range) const
@@ -680,6 +750,66 @@ private:
     const float lineSpacing;
     const bool underlineWhitespace;
     TextAtom longAtom;
+    LayoutIndex* layoutIndex;
+    float maxLineRight = 0;
+
+    void recordCheckpoint (int atomIndexOfLineStart)
+    {
+        // don't record a line that starts on the last atom of a section, as the wrap
+        // decision for it can depend on words joined across the section boundary,
+        // which wouldn't be replayed identically when resuming
+        if (atomIndexOfLineStart >= currentSection->atoms.size() - 1)
+            return;
+
+        auto& checkpoints = layoutIndex->checkpoints;
+        const auto lastRecordedIndex = checkpoints.isEmpty()
+                                          ? 0 : checkpoints.getReference (checkpoints.size() - 1).indexInText;
+
+        if (indexInText >= lastRecordedIndex + LayoutIndex::interval)
+            checkpoints.add ({ indexInText, sectionIndex, atomIndexOfLineStart, lineY, maxLineRight });
+    }
+
+    bool resumeFromCheckpoint (const LayoutCheckpoint& checkpoint)
+    {
+        if (! isPositiveAndBelow (checkpoint.sectionIndex, sections.size()))
+            return false;
+
+        auto* section = sections.getUnchecked (checkpoint.sectionIndex);
+
+        if (! isPositiveAndBelow (checkpoint.atomIndex, section->atoms.size()))
+            return false;
+
+        sectionIndex = checkpoint.sectionIndex;
+        atomIndex = checkpoint.atomIndex;
+        currentSection = section;
+        indexInText = checkpoint.indexInText;
+        lineY = checkpoint.lineY;
+        maxLineRight = checkpoint.maxLineRight;
+        atom = nullptr;
+        atomX = atomRight = lineHeight = maxDescent = 0;
+        beginNewLine();
+        return true;
+    }
+
+    void resumeFromNearestCheckpoint (int lastCandidate)
+    {
+        auto& checkpoints = layoutIndex->checkpoints;
+
+        for (int i = jmin (lastCandidate, checkpoints.size() - 1); i >= 0; --i)
+        {
+            auto& checkpoint = checkpoints.getReference (i);
+
+            if (checkpoint.indexInText <= indexInText)
+                break;  // already at or past it
+
+            if (resumeFromCheckpoint (checkpoint))
+                return;
+
+            // a checkpoint that no longer maps onto the sections must be stale, and
+            // anything recorded after it can't be trusted either
+            checkpoints.removeRange (i, checkpoints.size());
+        }
+    }
 
     bool chunkLongAtom (bool shouldStartNewLine)
     {
@@ -1082,6 +1212,7 @@ void TextEditor::applyFontToAllText (const Font& newFont, bool changeCurrentFont
     }
 
     coalesceSimilarSections();
+    invalidateLayoutIndex (0);
     checkLayout();
     scrollToMakeSureCursorIsVisible();
     repaint();
@@ -1464,9 +1595,13 @@ RectangleList<int> TextEditor::getTextBounds (Range<int> textRange)
 {
     RectangleList<int> boundingBox;
     Iterator i (*this);
+    i.seekToIndex (textRange.getStart());
 
     while (i.next())
     {
+        if (i.indexInText >= textRange.getEnd())
+            break;
+
         if (textRange.intersects ({ i.indexInText,
                                     i.indexInText + i.atom->numChars }))
         {
@@ -1711,6 +1846,7 @@ void TextEditor::drawContent (Graphics& g)
         }
 
         Iterator i (*this);
+        i.seekToY ((float) clip.getY());
         Colour selectedTextColour;
 
         if (! selection.isEmpty())
@@ -1746,6 +1882,7 @@ void TextEditor::drawContent (Graphics& g)
         for (auto& underlinedSection : underlinedSections)
         {
             Iterator i2 (*this);
+            i2.seekToY ((float) clip.getY());
 
             while (i2.next() && i2.lineY < (float) clip.getBottom())
             {
@@ -2344,6 +2481,7 @@ void TextEditor::insert (const String& text, int insertIndex, const Font& font,
                 sections.add (new UniformTextSection (text, font, colour, passwordCharacter));
 
             coalesceSimilarSections();
+            invalidateLayoutIndex (insertIndex);
             totalNumChars = -1;
             valueTextNeedsUpdating = true;
 
@@ -2390,6 +2528,7 @@ void TextEditor::reinsert (int insertIndex, const OwnedArray<UniformTextSection>
             sections.add (new UniformTextSection (*s));
 
     coalesceSimilarSections();
+    invalidateLayoutIndex (insertIndex);
     totalNumChars = -1;
     valueTextNeedsUpdating = true;
 }
@@ -2474,6 +2613,7 @@ void TextEditor::remove (Range<int> range, UndoManager* const um, const int care
             }
 
             coalesceSimilarSections();
+            invalidateLayoutIndex (range.getStart());
             totalNumChars = -1;
             valueTextNeedsUpdating = true;
 
@@ -2575,7 +2715,10 @@ int TextEditor::indexAtPosition (const float x, const float y) const
 {
     if (getWordWrapWidth() > 0)
     {
-        for (Iterator i (*this); i.next();)
+        Iterator i (*this);
+        i.seekToY (y);
+
+        while (i.next())
         {
             if (y < i.lineY + i.lineHeight)
             {
@@ -2650,6 +2793,26 @@ void TextEditor::splitSection (const int sectionIndex, const int charToSplitAt)
                      sections.getUnchecked (sectionIndex)->split (charToSplitAt));
 }
 
+void TextEditor::invalidateLayoutIndex (int fromTextIndex)
+{
+    auto& checkpoints = layoutIndex.checkpoints;
+    int start = 0, end = checkpoints.size();
+
+    while (start < end)
+    {
+        auto mid = (start + end) / 2;
+
+        if (checkpoints.getReference (mid).indexInText < fromTextIndex)
+            start = mid + 1;
+        else
+            end = mid;
+    }
+
+    // also drop the last checkpoint before the edit, as the position of the line-start
+    // nearest to the edit can depend on atoms slightly before it
+    checkpoints.removeRange (jmax (0, start - 1), checkpoints.size());
+}
+
 void TextEditor::coalesceSimilarSections()
 {
     for (int i = 0; i < sections.size() - 1; ++i)
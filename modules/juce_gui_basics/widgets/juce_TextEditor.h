@@ -766,6 +766,27 @@ private:
     bool consumeEscAndReturnKeys = true;
     bool underlineWhitespace = true;
 
+    struct LayoutCheckpoint
+    {
+        int indexInText, sectionIndex, atomIndex;
+        float lineY, maxLineRight;
+    };
+
+    // Line-start states recorded at intervals while iterating the text, so that layout
+    // queries near the end of a long document can resume from the nearest recorded
+    // line-start instead of re-wrapping the whole document. Edits only invalidate the
+    // checkpoints at or after the point that changed.
+    struct LayoutIndex
+    {
+        static constexpr int interval = 256;
+
+        Array<LayoutCheckpoint> checkpoints;
+        float wordWrapWidth = -1.0f, lineSpacing = 0;
+        juce_wchar passwordCharacter = 0;
+    };
+
+    mutable LayoutIndex layoutIndex;
+
     UndoManager undoManager;
     std::unique_ptr<CaretComponent> caret;
     Range<int> selection;
@@ -802,6 +823,7 @@ private:
     void handleCommandMessage (int) override;
     void coalesceSimilarSections();
     void splitSection (int sectionIndex, int charToSplitAt);
+    void invalidateLayoutIndex (int fromTextIndex);
     void clearInternal (UndoManager*);
     void insert (const String&, int insertIndex, const Font&, Colour, UndoManager*, int newCaretPos);
     void reinsert (int insertIndex, const OwnedArray<UniformTextSection>&);
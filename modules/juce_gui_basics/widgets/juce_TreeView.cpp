@@ -599,64 +599,39 @@ private:
         }
     }
 
-    static TreeViewItem* getNextVisibleItem (TreeViewItem* item, bool forwards)
-    {
-        if (item == nullptr || item->ownerView == nullptr)
-            return nullptr;
-
-        auto* nextItem = item->ownerView->getItemOnRow (item->getRowNumberInTree() + (forwards ? 1 : -1));
-
-        return nextItem == item->ownerView->rootItem && ! item->ownerView->rootItemVisible ? nullptr
-                                                                                           : nextItem;
-    }
-
     std::vector<TreeViewItem*> getAllVisibleItems() const
     {
         if (owner.rootItem == nullptr)
             return {};
 
-        const auto visibleTop = -getY();
-        const auto visibleBottom = visibleTop + getParentHeight();
+        const auto& rows = owner.getRowCache();
+        const auto* begin = rows.begin() + (owner.rootItemVisible ? 0 : 1);
+        const auto* end = rows.end();
 
-        std::vector<TreeViewItem*> visibleItems;
+        if (begin >= end)
+            return {};
 
-        auto* item = [&]
-        {
-            auto* i = owner.rootItemVisible ? owner.rootItem
-                                            : owner.rootItem->subItems.getFirst();
+        const auto visibleTop = -getY();
+        const auto visibleBottom = visibleTop + getParentHeight();
 
-            while (i != nullptr && i->y < visibleTop)
-                i = getNextVisibleItem (i, true);
+        // find the first row starting at or below the top of the view, keeping
+        // a couple of off-screen items above it as a buffer
+        const auto* i = std::lower_bound (begin, end, visibleTop,
+                                          [] (const TreeViewItem* item, int top)  { return item->y < top; });
+        i = std::max (begin, i - 2);
 
-            return i;
-        }();
+        std::vector<TreeViewItem*> visibleItems;
 
-        auto addOffscreenItemBuffer = [&visibleItems] (TreeViewItem* i, int num, bool forwards)
+        // add everything down to the bottom of the view, plus a similar buffer
+        // of off-screen items below it
+        for (int numBelowView = 0; i != end && numBelowView < 3; ++i)
         {
-            while (--num >= 0)
-            {
-                i = getNextVisibleItem (i, forwards);
-
-                if (i == nullptr)
-                    return;
+            if ((*i)->y >= visibleBottom)
+                ++numBelowView;
 
-                visibleItems.push_back (i);
-            }
-        };
-
-        addOffscreenItemBuffer (item, 2, false);
-
-        while (item != nullptr && item->y < visibleBottom)
-        {
-            visibleItems.push_back (item);
-            item = getNextVisibleItem (item, true);
+            visibleItems.push_back (*i);
         }
 
-        if (item != nullptr)
-            visibleItems.push_back (item);
-
-        addOffscreenItemBuffer (item, 2, true);
-
         return visibleItems;
     }
 
@@ -816,6 +791,7 @@ void TreeView::setRootItem (TreeViewItem* const newRootItem)
             rootItem->setOpen (true);
         }
 
+        rowCacheValid = false;
         viewport->recalculatePositions (TreeViewport::Async::no);
     }
 }
@@ -905,9 +881,24 @@ TreeViewItem* TreeView::getSelectedItem (const int index) const noexcept
     return rootItem != nullptr ? rootItem->getSelectedItemWithIndex (index) : nullptr;
 }
 
+const Array<TreeViewItem*>& TreeView::getRowCache() const
+{
+    if (! rowCacheValid)
+    {
+        rowCache.clearQuick();
+
+        if (rootItem != nullptr)
+            rootItem->addToRowCache (rowCache);
+
+        rowCacheValid = true;
+    }
+
+    return rowCache;
+}
+
 int TreeView::getNumRowsInTree() const
 {
-    return rootItem != nullptr ? (rootItem->getNumRows() - (rootItemVisible ? 0 : 1)) : 0;
+    return rootItem != nullptr ? (getRowCache().size() - (rootItemVisible ? 0 : 1)) : 0;
 }
 
 TreeViewItem* TreeView::getItemOnRow (int index) const
@@ -915,10 +906,7 @@ TreeViewItem* TreeView::getItemOnRow (int index) const
     if (! rootItemVisible)
         ++index;
 
-    if (rootItem != nullptr && index >= 0)
-        return rootItem->getItemOnRow (index);
-
-    return nullptr;
+    return getRowCache()[index];
 }
 
 TreeViewItem* TreeView::getItemAt (int y) const noexcept
@@ -1176,6 +1164,10 @@ bool TreeView::keyPressed (const KeyPress& key)
 
 void TreeView::updateVisibleItems()
 {
+    // everything that changes the set of open rows funnels through here, so the
+    // flattened row cache can be rebuilt lazily the next time it's queried
+    rowCacheValid = false;
+
     viewport->recalculatePositions (TreeViewport::Async::yes);
 }
 
@@ -1925,6 +1917,16 @@ TreeViewItem* TreeViewItem::getItemOnRow (int index) noexcept
     return nullptr;
 }
 
+void TreeViewItem::addToRowCache (Array<TreeViewItem*>& rows)
+{
+    cachedRowIndex = rows.size();
+    rows.add (this);
+
+    if (isOpen())
+        for (auto* i : subItems)
+            i->addToRowCache (rows);
+}
+
 int TreeViewItem::countSelectedItemsRecursively (int depth) const noexcept
 {
     int total = isSelected() ? 1 : 0;
@@ -1964,6 +1966,14 @@ int TreeViewItem::getRowNumberInTree() const noexcept
 {
     if (parentItem != nullptr && ownerView != nullptr)
     {
+        // items that are currently on a row can read their position straight
+        // out of the view's flattened row cache
+        const auto& rows = ownerView->getRowCache();
+
+        if (isPositiveAndBelow (cachedRowIndex, rows.size())
+             && rows.getUnchecked (cachedRowIndex) == this)
+            return cachedRowIndex - (ownerView->rootItemVisible ? 0 : 1);
+
         if (! parentItem->isOpen())
             return parentItem->getRowNumberInTree();
 
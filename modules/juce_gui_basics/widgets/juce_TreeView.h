@@ -616,6 +616,7 @@ private:
     TreeViewItem* getDeepestOpenParentItem() noexcept;
     int getNumRows() const noexcept;
     TreeViewItem* getItemOnRow (int) noexcept;
+    void addToRowCache (Array<TreeViewItem*>&);
     void deselectAllRecursively (TreeViewItem*);
     int countSelectedItemsRecursively (int) const noexcept;
     TreeViewItem* getSelectedItemWithIndex (int) noexcept;
@@ -635,6 +636,7 @@ private:
 
     Openness openness = Openness::opennessDefault;
     int y = 0, itemHeight = 0, totalHeight = 0, itemWidth = 0, totalWidth = 0, uid = 0;
+    int cachedRowIndex = -1;
     bool selected = false, redrawNeeded = true, drawLinesInside = false, drawLinesSet = false,
          drawsInLeftMargin = false, drawsInRightMargin = false;
 
@@ -945,11 +947,14 @@ private:
     void moveOutOfSelectedItem();
     void moveIntoSelectedItem();
     void moveByPages (int);
+    const Array<TreeViewItem*>& getRowCache() const;
 
     std::unique_ptr<TreeViewport> viewport;
     TreeViewItem* rootItem = nullptr;
     std::unique_ptr<InsertPointHighlight> dragInsertPointHighlight;
     std::unique_ptr<TargetGroupHighlight> dragTargetGroupHighlight;
+    mutable Array<TreeViewItem*> rowCache;
+    mutable bool rowCacheValid = false;
     int indentSize = -1;
     bool defaultOpenness = false, rootItemVisible = true, multiSelectEnabled = false, openCloseButtonsVisible = true;
 
@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+ValueTreeItem::ValueTreeItem (const ValueTree& treeToMirror)  : tree (treeToMirror)
+{
+    tree.addListener (this);
+}
+
+ValueTreeItem::~ValueTreeItem()
+{
+    tree.removeListener (this);
+}
+
+ValueTreeItem* ValueTreeItem::findSubItemFor (const ValueTree& childTree) const noexcept
+{
+    for (int i = getNumSubItems(); --i >= 0;)
+        if (auto* item = dynamic_cast<ValueTreeItem*> (getSubItem (i)))
+            if (item->tree == childTree)
+                return item;
+
+    return nullptr;
+}
+
+bool ValueTreeItem::mightContainSubItems()
+{
+    return tree.getNumChildren() > 0;
+}
+
+void ValueTreeItem::itemOpennessChanged (bool isNowOpen)
+{
+    // The sub-items are created the first time the item is opened, and are then
+    // kept alive and updated incrementally, so that re-opening is instant.
+    if (isNowOpen && ! subItemsCreated)
+        rebuildSubItems();
+}
+
+String ValueTreeItem::getUniqueName() const
+{
+    auto parent = tree.getParent();
+
+    return tree.getType().toString() + "_" + String (parent.isValid() ? parent.indexOf (tree) : 0);
+}
+
+void ValueTreeItem::rebuildSubItems()
+{
+    clearSubItems();
+
+    for (const auto& child : tree)
+        addSubItem (createItemForChild (child));
+
+    subItemsCreated = true;
+}
+
+//==============================================================================
+// Note that these callbacks are also triggered by changes to nodes deeper in
+// the subtree, so each one must act only if this item's own node was affected -
+// the item that mirrors the deeper node will handle its own events.
+
+void ValueTreeItem::valueTreePropertyChanged (ValueTree& changedTree, const Identifier&)
+{
+    if (changedTree == tree)
+        repaintItem();
+}
+
+void ValueTreeItem::valueTreeChildAdded (ValueTree& parentTree, ValueTree& childTree)
+{
+    if (parentTree != tree)
+        return;
+
+    if (subItemsCreated)
+        addSubItem (createItemForChild (childTree), tree.indexOf (childTree));
+    else
+        treeHasChanged();  // the openness arrow may need to appear
+}
+
+void ValueTreeItem::valueTreeChildRemoved (ValueTree& parentTree, ValueTree&, int oldIndex)
+{
+    if (parentTree != tree)
+        return;
+
+    if (subItemsCreated)
+    {
+        if (isPositiveAndBelow (oldIndex, getNumSubItems()))
+            removeSubItem (oldIndex);
+    }
+    else
+    {
+        treeHasChanged();
+    }
+}
+
+void ValueTreeItem::valueTreeChildOrderChanged (ValueTree& parentTree, int oldIndex, int newIndex)
+{
+    if (parentTree != tree || ! subItemsCreated)
+        return;
+
+    if (auto* item = getSubItem (oldIndex))
+    {
+        removeSubItem (oldIndex, false);
+        addSubItem (item, newIndex);
+    }
+}
+
+void ValueTreeItem::valueTreeParentChanged (ValueTree&)
+{
+    // nothing to do here - if this node was moved to another parent, the items
+    // mirroring the old and new parents will see childRemoved/childAdded events
+}
+
+} // namespace juce
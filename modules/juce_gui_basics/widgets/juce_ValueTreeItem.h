@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A TreeViewItem that mirrors the children of a ValueTree node.
+
+    Subclass this to bind a ValueTree model to a TreeView: each item represents
+    one node of the tree, and keeps its sub-items in sync with the node's
+    children by listening for changes and applying them as targeted insertions,
+    removals and moves. This means that editing a large model updates the view
+    incrementally, rather than requiring whole subtrees of items to be
+    rebuilt after every change.
+
+    To use it, implement createItemForChild() to construct items of your own
+    subclass, along with the usual TreeViewItem drawing methods, and hand an
+    item for the model's root node to TreeView::setRootItem():
+
+    @code
+    struct MyItem  : public ValueTreeItem
+    {
+        explicit MyItem (const ValueTree& v) : ValueTreeItem (v) {}
+
+        ValueTreeItem* createItemForChild (const ValueTree& child) override  { return new MyItem (child); }
+        void paintItem (Graphics& g, int width, int height) override         { ... }
+    };
+
+    treeView.setRootItem (rootItem = std::make_unique<MyItem> (model));
+    @endcode
+
+    Sub-items are created lazily when an item is first opened, so a huge model
+    only pays for the items that are actually visible.
+
+    @see TreeView, TreeViewItem, ValueTree
+
+    @tags{GUI}
+*/
+class JUCE_API  ValueTreeItem  : public TreeViewItem,
+                                 private ValueTree::Listener
+{
+public:
+    //==============================================================================
+    /** Creates an item that will mirror the given ValueTree node. */
+    explicit ValueTreeItem (const ValueTree& treeToMirror);
+
+    /** Destructor. */
+    ~ValueTreeItem() override;
+
+    //==============================================================================
+    /** Returns the ValueTree node that this item represents. */
+    const ValueTree& getValueTree() const noexcept      { return tree; }
+
+    /** Returns the sub-item that represents the given child of this item's node,
+        or nullptr if that child's item hasn't been created yet.
+    */
+    ValueTreeItem* findSubItemFor (const ValueTree& childTree) const noexcept;
+
+    //==============================================================================
+    bool mightContainSubItems() override;
+    void itemOpennessChanged (bool isNowOpen) override;
+
+    /** The default implementation builds a name from the node's type and its
+        index among its siblings. If your model gives nodes a persistent unique
+        identifier, override this to return it, so that openness and selection
+        are correctly restored by TreeView::restoreOpennessState() even after
+        the model has been reordered.
+    */
+    String getUniqueName() const override;
+
+protected:
+    //==============================================================================
+    /** Must create a new item to represent one of this node's children.
+
+        This will be called as the view needs them - when this item is first
+        opened, and when new children are added to the node afterwards. Return
+        an instance of your own ValueTreeItem subclass; it'll be owned and
+        positioned by this item.
+    */
+    virtual ValueTreeItem* createItemForChild (const ValueTree& childTree) = 0;
+
+private:
+    //==============================================================================
+    void valueTreePropertyChanged (ValueTree&, const Identifier&) override;
+    void valueTreeChildAdded (ValueTree&, ValueTree&) override;
+    void valueTreeChildRemoved (ValueTree&, ValueTree&, int) override;
+    void valueTreeChildOrderChanged (ValueTree&, int, int) override;
+    void valueTreeParentChanged (ValueTree&) override;
+
+    void rebuildSubItems();
+
+    ValueTree tree;
+    bool subItemsCreated = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ValueTreeItem)
+};
+
+} // namespace juce
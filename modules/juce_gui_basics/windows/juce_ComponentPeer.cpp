@@ -99,6 +99,97 @@ void ComponentPeer::handleMagnifyGesture (MouseInputSource::InputSourceType type
         MouseInputSource (*mouse).handleMagnifyGesture (*this, pos, time, scaleFactor);
 }
 
+//==============================================================================
+void ComponentPeer::invalidateArea (const Rectangle<int>& area)
+{
+    if (! repaintBatchingEnabled)
+    {
+        repaint (area);
+        return;
+    }
+
+    JUCE_ASSERT_MESSAGE_MANAGER_IS_LOCKED
+
+    deferredRepaints.addWithoutMerging (area);
+
+    if (! deferredRepaintTimer.isTimerRunning())
+    {
+        // When going from clean to dirty, flush straight away so that sporadic
+        // repaints aren't delayed; anything that arrives while the timer is
+        // running is held back until the next frame.
+        flushDeferredRepaints();
+        deferredRepaintTimer.startTimerHz (repaintBatchingFrameRate);
+    }
+}
+
+void ComponentPeer::setRepaintBatchingEnabled (bool shouldBeEnabled, int frameRateHz)
+{
+    repaintBatchingFrameRate = jmax (1, frameRateHz);
+    repaintBatchingEnabled = shouldBeEnabled;
+
+    if (! shouldBeEnabled)
+    {
+        deferredRepaintTimer.stopTimer();
+        flushDeferredRepaints();
+    }
+}
+
+void ComponentPeer::setRepaintMergingThreshold (float proportion) noexcept
+{
+    repaintMergingThreshold = jlimit (0.0f, 1.0f, proportion);
+}
+
+void ComponentPeer::flushDeferredRepaints()
+{
+    if (deferredRepaints.isEmpty())
+        return;
+
+    Array<Rectangle<int>> merged;
+
+    for (auto& r : deferredRepaints)
+        merged.add (r);
+
+    deferredRepaints.clear();
+
+    // Collapse regions which overlap by at least the merging threshold (or
+    // merely touch, if the threshold is zero) into their union, rescanning
+    // after each merge as the union may overlap rects that its parts didn't.
+    for (int i = 0; i < merged.size(); ++i)
+    {
+        for (int j = merged.size(); --j > i;)
+        {
+            auto& a = merged.getReference (i);
+            auto& b = merged.getReference (j);
+            auto intersection = a.getIntersection (b);
+
+            if (intersection.isEmpty() && ! (repaintMergingThreshold <= 0.0f && a.expanded (1).intersects (b)))
+                continue;
+
+            auto intersectionArea = (int64) intersection.getWidth() * intersection.getHeight();
+            auto smallerArea = jmin ((int64) a.getWidth() * a.getHeight(),
+                                     (int64) b.getWidth() * b.getHeight());
+
+            if ((float) intersectionArea >= repaintMergingThreshold * (float) smallerArea)
+            {
+                a = a.getUnion (b);
+                merged.remove (j);
+                j = merged.size();
+            }
+        }
+    }
+
+    for (auto& r : merged)
+        repaint (r);
+}
+
+void ComponentPeer::DeferredRepaintTimer::timerCallback()
+{
+    if (peer.deferredRepaints.isEmpty())
+        stopTimer();
+    else
+        peer.flushDeferredRepaints();
+}
+
 //==============================================================================
 void ComponentPeer::handlePaint (LowLevelGraphicsContext& contextToPaintTo)
 {
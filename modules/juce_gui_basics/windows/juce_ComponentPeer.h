@@ -370,6 +370,48 @@ public:
     /** Invalidates a region of the window to be repainted asynchronously. */
     virtual void repaint (const Rectangle<int>& area) = 0;
 
+    /** Invalidates a region of the window, optionally batching the request.
+
+        This is the method that Component::repaint() funnels into. By default it
+        forwards straight to repaint(), but when batching has been enabled with
+        setRepaintBatchingEnabled(), the requested regions are accumulated into
+        a RectangleList and merged, and the merged list is flushed to repaint()
+        once per frame.
+    */
+    void invalidateArea (const Rectangle<int>& area);
+
+    /** Enables or disables per-frame batching of repaint requests.
+
+        When enabled, regions passed to invalidateArea() are coalesced instead
+        of each producing an OS invalidation rect of its own: overlapping and
+        adjacent regions are merged according to the threshold set by
+        setRepaintMergingThreshold(), and the merged list is flushed once per
+        frame at approximately the given rate. This can dramatically reduce the
+        invalidation and paint-traversal cost of UIs which repaint many small
+        components at once (e.g. banks of meters), at the cost of up to one
+        frame of extra latency on repaints that arrive mid-frame.
+    */
+    void setRepaintBatchingEnabled (bool shouldBeEnabled, int frameRateHz = 60);
+
+    /** Returns true if per-frame repaint batching is enabled.
+        @see setRepaintBatchingEnabled
+    */
+    bool isRepaintBatchingEnabled() const noexcept          { return repaintBatchingEnabled; }
+
+    /** Sets how aggressively batched repaint regions are merged.
+
+        Two regions are replaced by their union when their overlap covers at
+        least this proportion of the smaller of the two. The range is 0 (merge
+        regions that merely touch) to 1.0 (only merge regions that completely
+        contain one another); the default is 0.5.
+    */
+    void setRepaintMergingThreshold (float proportion) noexcept;
+
+    /** Sends any batched repaint regions to the OS immediately.
+        @see setRepaintBatchingEnabled
+    */
+    void flushDeferredRepaints();
+
     /** This can be called (from the message thread) to cause the immediate redrawing
         of any areas of this window that need repainting.
 
@@ -526,6 +568,21 @@ private:
 
     Component* getTargetForKeyPress();
 
+    //==============================================================================
+    struct DeferredRepaintTimer  : public Timer
+    {
+        explicit DeferredRepaintTimer (ComponentPeer& p) : peer (p) {}
+        void timerCallback() override;
+
+        ComponentPeer& peer;
+    };
+
+    RectangleList<int> deferredRepaints;
+    DeferredRepaintTimer deferredRepaintTimer { *this };
+    float repaintMergingThreshold = 0.5f;
+    int repaintBatchingFrameRate = 60;
+    bool repaintBatchingEnabled = false;
+
     WeakReference<Component> lastFocusedComponent, dragAndDropTargetComponent;
     Component* lastDragAndDropCompUnderMouse = nullptr;
     const uint32 uniqueID;
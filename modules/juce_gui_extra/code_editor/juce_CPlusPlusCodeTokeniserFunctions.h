@@ -33,16 +33,67 @@ namespace juce
 */
 struct CppTokeniserFunctions
 {
+    //==============================================================================
+    /*  The character classes tested by the hot parsing loops below, precomputed for
+        the ASCII range so that each test is a single table lookup rather than a
+        chain of CharacterFunctions calls per character.
+    */
+    enum CharacterFlags
+    {
+        identifierStartFlag = 1 << 0,
+        identifierBodyFlag  = 1 << 1,
+        decimalDigitFlag    = 1 << 2,
+        hexDigitFlag        = 1 << 3,
+        octalDigitFlag      = 1 << 4
+    };
+
+    static uint8 getAsciiCharacterFlags (const juce_wchar c) noexcept
+    {
+        static const auto table = []
+        {
+            std::array<uint8, 128> flags {};
+
+            for (int i = 0; i < 128; ++i)
+            {
+                auto character = (juce_wchar) i;
+                uint8 f = 0;
+
+                if ((character >= 'a' && character <= 'z')
+                     || (character >= 'A' && character <= 'Z')
+                     || character == '_' || character == '@')
+                    f |= identifierStartFlag | identifierBodyFlag;
+
+                if (character >= '0' && character <= '9')
+                {
+                    f |= identifierBodyFlag | decimalDigitFlag | hexDigitFlag;
+
+                    if (character <= '7')
+                        f |= octalDigitFlag;
+                }
+
+                if ((character >= 'a' && character <= 'f')
+                     || (character >= 'A' && character <= 'F'))
+                    f |= hexDigitFlag;
+
+                flags[(size_t) i] = f;
+            }
+
+            return flags;
+        }();
+
+        return (uint32) c < 128 ? table[(size_t) c] : 0;
+    }
+
     static bool isIdentifierStart (const juce_wchar c) noexcept
     {
-        return CharacterFunctions::isLetter (c)
-                || c == '_' || c == '@';
+        return (getAsciiCharacterFlags (c) & identifierStartFlag) != 0
+                || ((uint32) c >= 128 && CharacterFunctions::isLetter (c));
     }
 
     static bool isIdentifierBody (const juce_wchar c) noexcept
     {
-        return CharacterFunctions::isLetterOrDigit (c)
-                || c == '_' || c == '@';
+        return (getAsciiCharacterFlags (c) & identifierBodyFlag) != 0
+                || ((uint32) c >= 128 && CharacterFunctions::isLetterOrDigit (c));
     }
 
     static bool isReservedKeyword (String::CharPointerType token, const int tokenLength) noexcept
@@ -151,9 +202,7 @@ struct CppTokeniserFunctions
 
     static bool isHexDigit (const juce_wchar c) noexcept
     {
-        return (c >= '0' && c <= '9')
-                || (c >= 'a' && c <= 'f')
-                || (c >= 'A' && c <= 'F');
+        return (getAsciiCharacterFlags (c) & hexDigitFlag) != 0;
     }
 
     template <typename Iterator>
@@ -186,7 +235,7 @@ struct CppTokeniserFunctions
 
     static bool isOctalDigit (const juce_wchar c) noexcept
     {
-        return c >= '0' && c <= '7';
+        return (getAsciiCharacterFlags (c) & octalDigitFlag) != 0;
     }
 
     template <typename Iterator>
@@ -209,7 +258,7 @@ struct CppTokeniserFunctions
 
     static bool isDecimalDigit (const juce_wchar c) noexcept
     {
-        return c >= '0' && c <= '9';
+        return (getAsciiCharacterFlags (c) & decimalDigitFlag) != 0;
     }
 
     template <typename Iterator>
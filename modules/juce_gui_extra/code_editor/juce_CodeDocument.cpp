@@ -414,7 +414,7 @@ void CodeDocument::Position::setLineAndIndex (const int newLineNum, const int ne
 
             auto& l = *owner->lines.getUnchecked (line);
             indexInLine = l.lineLengthWithoutNewLines;
-            characterPos = l.lineStartInFile + indexInLine;
+            characterPos = owner->getLineStart (line) + indexInLine;
         }
         else
         {
@@ -427,7 +427,7 @@ void CodeDocument::Position::setLineAndIndex (const int newLineNum, const int ne
             else
                 indexInLine = 0;
 
-            characterPos = l.lineStartInFile + indexInLine;
+            characterPos = owner->getLineStart (line) + indexInLine;
         }
     }
 }
@@ -452,13 +452,14 @@ void CodeDocument::Position::setPosition (const int newPosition)
                 for (int i = lineStart; i < lineEnd; ++i)
                 {
                     auto& l = *owner->lines.getUnchecked (i);
-                    auto index = newPosition - l.lineStartInFile;
+                    auto startOfLine = owner->getLineStart (i);
+                    auto index = newPosition - startOfLine;
 
                     if (index >= 0 && (index < l.lineLength || i == lineEnd - 1))
                     {
                         line = i;
                         indexInLine = jmin (l.lineLengthWithoutNewLines, index);
-                        characterPos = l.lineStartInFile + indexInLine;
+                        characterPos = startOfLine + indexInLine;
                     }
                 }
 
@@ -468,7 +469,7 @@ void CodeDocument::Position::setPosition (const int newPosition)
             {
                 auto midIndex = (lineStart + lineEnd + 1) / 2;
 
-                if (newPosition >= owner->lines.getUnchecked (midIndex)->lineStartInFile)
+                if (newPosition >= owner->getLineStart (midIndex))
                     lineStart = midIndex;
                 else
                     lineEnd = midIndex;
@@ -615,11 +616,42 @@ String CodeDocument::getTextBetween (const Position& start, const Position& end)
 int CodeDocument::getNumCharacters() const noexcept
 {
     if (auto* lastLine = lines.getLast())
-        return lastLine->lineStartInFile + lastLine->lineLength;
+        return getLineStart (lines.size() - 1) + lastLine->lineLength;
 
     return 0;
 }
 
+int CodeDocument::getLineStart (int lineIndex) const noexcept
+{
+    auto start = lines.getUnchecked (lineIndex)->lineStartInFile;
+    return lineIndex >= firstShiftedLine ? start + pendingLineStartShift : start;
+}
+
+void CodeDocument::shiftLineStarts (int fromLine, int delta) noexcept
+{
+    if (delta == 0 || fromLine >= lines.size())
+        return;
+
+    if (pendingLineStartShift != 0 && firstShiftedLine != fromLine)
+        applyPendingShift();
+
+    firstShiftedLine = fromLine;
+    pendingLineStartShift += delta;
+}
+
+void CodeDocument::applyPendingShift() noexcept
+{
+    if (pendingLineStartShift != 0)
+    {
+        for (int i = firstShiftedLine; i < lines.size(); ++i)
+            lines.getUnchecked (i)->lineStartInFile += pendingLineStartShift;
+
+        pendingLineStartShift = 0;
+    }
+
+    firstShiftedLine = 0;
+}
+
 String CodeDocument::getLine (const int lineIndex) const noexcept
 {
     if (auto* line = lines[lineIndex])
@@ -861,6 +893,7 @@ void CodeDocument::checkLastLineStatus()
             && (lines.size() == 1 || ! lines.getUnchecked (lines.size() - 2)->endsWithLineBreak()))
     {
         // remove any empty lines at the end if the preceding line doesn't end in a newline.
+        applyPendingShift();
         lines.removeLast();
     }
 
@@ -869,6 +902,7 @@ void CodeDocument::checkLastLineStatus()
     if (lastLine != nullptr && lastLine->endsWithLineBreak())
     {
         // check that there's an empty line at the end if the preceding one ends in a newline..
+        applyPendingShift();
         lines.add (new CodeDocumentLine (StringRef(), StringRef(), 0, 0,
                                          lastLine->lineStartInFile + lastLine->lineLength));
     }
@@ -938,6 +972,12 @@ void CodeDocument::insert (const String& text, const int insertPos, const bool u
             CodeDocumentLine::createLines (newLines, textInsideOriginalLine);
             jassert (newLines.size() > 0);
 
+            // If the line indices are about to change, or an unrelated range is still
+            // pending, fold any deferred offset into the stored values first.
+            if (newLines.size() > 1
+                 || (pendingLineStartShift != 0 && firstShiftedLine != firstAffectedLine + 1))
+                applyPendingShift();
+
             auto* newFirstLine = newLines.getUnchecked (0);
             newFirstLine->lineStartInFile = firstLine != nullptr ? firstLine->lineStartInFile : 0;
             lines.set (firstAffectedLine, newFirstLine);
@@ -947,13 +987,17 @@ void CodeDocument::insert (const String& text, const int insertPos, const bool u
 
             int lineStart = newFirstLine->lineStartInFile;
 
-            for (int i = firstAffectedLine; i < lines.size(); ++i)
+            for (int i = firstAffectedLine; i < firstAffectedLine + newLines.size(); ++i)
             {
                 auto& l = *lines.getUnchecked (i);
                 l.lineStartInFile = lineStart;
                 lineStart += l.lineLength;
             }
 
+            // Lines beyond the insertion just move along by the inserted length, so that
+            // offset is deferred rather than rewriting every line's start position.
+            shiftLineStarts (firstAffectedLine + newLines.size(), text.length());
+
             checkLastLineStatus();
             auto newTextLength = text.length();
 
@@ -1016,6 +1060,17 @@ void CodeDocument::remove (const int startPos, const int endPos, const bool undo
         maximumLineLength = -1;
         auto firstAffectedLine = startPosition.getLineNumber();
         auto endLine = endPosition.getLineNumber();
+
+        // The positions may have been clamped, so the number of characters actually
+        // removed can be smaller than the range that was asked for.
+        auto numCharsRemoved = endPosition.getPosition() - startPosition.getPosition();
+
+        // As for insert(), a pending offset can only be kept if the line indices aren't
+        // changing and it already covers the lines after the edit.
+        if (firstAffectedLine != endLine
+             || (pendingLineStartShift != 0 && firstShiftedLine != firstAffectedLine + 1))
+            applyPendingShift();
+
         auto& firstLine = *lines.getUnchecked (firstAffectedLine);
 
         if (firstAffectedLine == endLine)
@@ -1036,12 +1091,7 @@ void CodeDocument::remove (const int startPos, const int endPos, const bool undo
             lines.removeRange (firstAffectedLine + 1, numLinesToRemove);
         }
 
-        for (int i = firstAffectedLine + 1; i < lines.size(); ++i)
-        {
-            auto& l = *lines.getUnchecked (i);
-            auto& previousLine = *lines.getUnchecked (i - 1);
-            l.lineStartInFile = previousLine.lineStartInFile + previousLine.lineLength;
-        }
+        shiftLineStarts (firstAffectedLine + 1, -numCharsRemoved);
 
         checkLastLineStatus();
         auto totalChars = getNumCharacters();
@@ -437,12 +437,16 @@ private:
     UndoManager undoManager;
     int currentActionIndex = 0, indexOfSavedState = -1;
     int maximumLineLength = -1;
+    int firstShiftedLine = 0, pendingLineStartShift = 0;
     ListenerList<Listener> listeners;
     String newLineChars { "\r\n" };
 
     void insert (const String& text, int insertPos, bool undoable);
     void remove (int startPos, int endPos, bool undoable);
     void checkLastLineStatus();
+    int getLineStart (int lineIndex) const noexcept;
+    void shiftLineStarts (int fromLine, int delta) noexcept;
+    void applyPendingShift() noexcept;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CodeDocument)
 };
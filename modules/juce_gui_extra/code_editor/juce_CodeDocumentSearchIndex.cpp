@@ -0,0 +1,249 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+CodeDocumentSearchIndex::CodeDocumentSearchIndex (CodeDocument& documentToIndex)
+    : document (documentToIndex)
+{
+    rebuildWholeDocument();
+    document.addListener (this);
+}
+
+CodeDocumentSearchIndex::~CodeDocumentSearchIndex()
+{
+    document.removeListener (this);
+}
+
+//==============================================================================
+static int packTrigram (juce_wchar c1, juce_wchar c2, juce_wchar c3) noexcept
+{
+    // This can collide for exotic character combinations, but that only makes
+    // the filter slightly less selective - candidate lines get verified against
+    // the real text anyway.
+    auto hash = (int) CharacterFunctions::toLowerCase (c1);
+    hash = hash * 31 + (int) CharacterFunctions::toLowerCase (c2);
+    hash = hash * 31 + (int) CharacterFunctions::toLowerCase (c3);
+    return hash;
+}
+
+SortedSet<int> CodeDocumentSearchIndex::getTrigramsForLine (const String& lineText)
+{
+    SortedSet<int> trigrams;
+    auto t = lineText.getCharPointer();
+
+    if (t.isEmpty())
+        return trigrams;
+
+    auto c1 = t.getAndAdvance();
+
+    if (t.isEmpty())
+        return trigrams;
+
+    auto c2 = t.getAndAdvance();
+
+    while (! t.isEmpty())
+    {
+        auto c3 = t.getAndAdvance();
+        trigrams.add (packTrigram (c1, c2, c3));
+        c1 = c2;
+        c2 = c3;
+    }
+
+    return trigrams;
+}
+
+Array<int> CodeDocumentSearchIndex::getTrigramsForTerm (const String& term)
+{
+    Array<int> trigrams;
+
+    for (auto t : getTrigramsForLine (term))
+        trigrams.add (t);
+
+    return trigrams;
+}
+
+//==============================================================================
+void CodeDocumentSearchIndex::addLineToCounts (const SortedSet<int>& trigrams)
+{
+    for (auto t : trigrams)
+        ++trigramCounts[t];
+}
+
+void CodeDocumentSearchIndex::removeLineFromCounts (const SortedSet<int>& trigrams)
+{
+    for (auto t : trigrams)
+    {
+        auto found = trigramCounts.find (t);
+        jassert (found != trigramCounts.end());
+
+        if (found != trigramCounts.end() && --(found->second) == 0)
+            trigramCounts.erase (found);
+    }
+}
+
+void CodeDocumentSearchIndex::rebuildWholeDocument()
+{
+    lineTrigrams.clearQuick();
+    trigramCounts.clear();
+
+    auto numLines = document.getNumLines();
+    lineTrigrams.ensureStorageAllocated (numLines);
+
+    for (int i = 0; i < numLines; ++i)
+    {
+        auto trigrams = getTrigramsForLine (document.getLine (i));
+        addLineToCounts (trigrams);
+        lineTrigrams.add (std::move (trigrams));
+    }
+}
+
+void CodeDocumentSearchIndex::reindexLines (int firstLine, int numOldLines, int numNewLines)
+{
+    if (firstLine < 0
+         || firstLine + numOldLines > lineTrigrams.size()
+         || document.getNumLines() != lineTrigrams.size() - numOldLines + numNewLines)
+    {
+        // the change didn't line up with what we had indexed, so re-sync fully
+        rebuildWholeDocument();
+        return;
+    }
+
+    for (int i = 0; i < numOldLines; ++i)
+        removeLineFromCounts (lineTrigrams.getReference (firstLine + i));
+
+    lineTrigrams.removeRange (firstLine, numOldLines);
+
+    for (int i = 0; i < numNewLines; ++i)
+    {
+        auto trigrams = getTrigramsForLine (document.getLine (firstLine + i));
+        addLineToCounts (trigrams);
+        lineTrigrams.insert (firstLine + i, std::move (trigrams));
+    }
+}
+
+void CodeDocumentSearchIndex::codeDocumentTextInserted (const String&, int insertIndex)
+{
+    // the document has already been updated, so the insertion added
+    // (new number of lines - old number of lines) lines starting at the
+    // line containing the insert position
+    auto firstLine = CodeDocument::Position (document, insertIndex).getLineNumber();
+    auto numAddedLines = document.getNumLines() - lineTrigrams.size();
+
+    reindexLines (firstLine, 1, 1 + numAddedLines);
+}
+
+void CodeDocumentSearchIndex::codeDocumentTextDeleted (int startIndex, int)
+{
+    auto firstLine = CodeDocument::Position (document, startIndex).getLineNumber();
+    auto numRemovedLines = lineTrigrams.size() - document.getNumLines();
+
+    reindexLines (firstLine, 1 + numRemovedLines, 1);
+}
+
+//==============================================================================
+bool CodeDocumentSearchIndex::couldContainAll (const Array<int>& termTrigrams) const noexcept
+{
+    for (auto t : termTrigrams)
+        if (trigramCounts.find (t) == trigramCounts.end())
+            return false;
+
+    return true;
+}
+
+Array<CodeDocumentSearchIndex::Match> CodeDocumentSearchIndex::search (const String& term, bool caseSensitive) const
+{
+    Array<Match> results;
+
+    if (term.isEmpty())
+        return results;
+
+    auto termTrigrams = getTrigramsForTerm (term);
+
+    if (! couldContainAll (termTrigrams))
+        return results;
+
+    for (int i = 0; i < lineTrigrams.size(); ++i)
+    {
+        auto& trigrams = lineTrigrams.getReference (i);
+
+        if (std::any_of (termTrigrams.begin(), termTrigrams.end(),
+                         [&] (int t) { return ! trigrams.contains (t); }))
+            continue;
+
+        auto line = document.getLine (i);
+
+        for (auto index = caseSensitive ? line.indexOf (0, term) : line.indexOfIgnoreCase (0, term);
+             index >= 0;
+             index = caseSensitive ? line.indexOf (index + 1, term) : line.indexOfIgnoreCase (index + 1, term))
+        {
+            results.add ({ &document, i, index });
+        }
+    }
+
+    return results;
+}
+
+Array<CodeDocumentSearchIndex::Match> CodeDocumentSearchIndex::searchDocuments (const Array<CodeDocumentSearchIndex*>& indexes,
+                                                                                const String& term,
+                                                                                bool caseSensitive,
+                                                                                ThreadPool* threadPoolToUse)
+{
+    std::vector<Array<Match>> perDocument ((size_t) indexes.size());
+
+    if (threadPoolToUse != nullptr && indexes.size() > 1)
+    {
+        std::atomic<int> jobsRemaining { indexes.size() };
+        WaitableEvent allDone;
+
+        for (int i = 0; i < indexes.size(); ++i)
+        {
+            threadPoolToUse->addJob ([&, i]
+            {
+                perDocument[(size_t) i] = indexes.getUnchecked (i)->search (term, caseSensitive);
+
+                if (--jobsRemaining == 0)
+                    allDone.signal();
+            });
+        }
+
+        allDone.wait();
+    }
+    else
+    {
+        for (int i = 0; i < indexes.size(); ++i)
+            perDocument[(size_t) i] = indexes.getUnchecked (i)->search (term, caseSensitive);
+    }
+
+    Array<Match> results;
+
+    for (auto& matches : perDocument)
+        results.addArray (matches);
+
+    return results;
+}
+
+} // namespace juce
@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Maintains an incremental trigram index for a CodeDocument, making repeated
+    sub-string searches much faster than scanning the text each time.
+
+    The index registers itself as a listener on its document and re-indexes only
+    the lines that an edit actually touches, so it's cheap to keep alive while
+    the user types. A query uses the trigrams of the search term to reject lines
+    - and, via searchDocuments(), entire documents - without looking at their
+    text, and only the remaining candidate lines are scanned for real matches.
+
+    Terms shorter than three characters can't use the trigram filter, so they
+    fall back to a plain line-by-line scan. Matches that span a line-break won't
+    be found, as the index works on whole lines.
+
+    @see CodeDocument, CodeEditorComponent
+
+    @tags{GUI}
+*/
+class JUCE_API  CodeDocumentSearchIndex  : private CodeDocument::Listener
+{
+public:
+    /** Creates an index for the given document, which must outlive this object. */
+    explicit CodeDocumentSearchIndex (CodeDocument& documentToIndex);
+
+    /** Destructor. */
+    ~CodeDocumentSearchIndex() override;
+
+    //==============================================================================
+    /** A single occurrence of a search term.
+        @see search, searchDocuments
+    */
+    struct Match
+    {
+        CodeDocument* document;   /**< The document containing the match. */
+        int lineNumber;           /**< The zero-based line on which the match starts. */
+        int indexInLine;          /**< The character index of the match within that line. */
+    };
+
+    /** Returns all occurrences of the given term in this index's document,
+        in order of their position.
+    */
+    Array<Match> search (const String& term, bool caseSensitive = false) const;
+
+    /** Searches several indexed documents at once, optionally spreading the
+        work across a thread pool.
+
+        The results are grouped by document, in the order the indexes were
+        given, and by position within each document. None of the documents may
+        be modified while this call is in progress.
+    */
+    static Array<Match> searchDocuments (const Array<CodeDocumentSearchIndex*>& indexes,
+                                         const String& term,
+                                         bool caseSensitive = false,
+                                         ThreadPool* threadPoolToUse = nullptr);
+
+    /** Returns the document that this index is attached to. */
+    CodeDocument& getDocument() const noexcept      { return document; }
+
+private:
+    //==============================================================================
+    void codeDocumentTextInserted (const String&, int) override;
+    void codeDocumentTextDeleted (int, int) override;
+
+    void rebuildWholeDocument();
+    void reindexLines (int firstLine, int numOldLines, int numNewLines);
+    void addLineToCounts (const SortedSet<int>&);
+    void removeLineFromCounts (const SortedSet<int>&);
+    bool couldContainAll (const Array<int>& termTrigrams) const noexcept;
+
+    static SortedSet<int> getTrigramsForLine (const String& lineText);
+    static Array<int> getTrigramsForTerm (const String& term);
+
+    CodeDocument& document;
+    Array<SortedSet<int>> lineTrigrams;
+    std::map<int, int> trigramCounts;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CodeDocumentSearchIndex)
+};
+
+} // namespace juce
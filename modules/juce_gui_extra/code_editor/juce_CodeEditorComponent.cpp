@@ -170,44 +170,63 @@ public:
         {
             auto line = codeDoc.getLine (lineNum);
             addToken (newTokens, line, line.length(), -1);
+            invalidateCache();
         }
         else if (lineNum < codeDoc.getNumLines())
         {
             const CodeDocument::Position pos (codeDoc, lineNum, 0);
             createTokens (pos.getPosition(), pos.getLineText(),
                           source, *tokeniser, newTokens);
+            cachedLineNum = lineNum;
+            cachedLineText = pos.getLineText();
         }
-
-        replaceTabsWithSpaces (newTokens, tabSpaces);
-
-        int newHighlightStart = 0;
-        int newHighlightEnd = 0;
-
-        if (selStart.getLineNumber() <= lineNum && selEnd.getLineNumber() >= lineNum)
+        else
         {
-            auto line = codeDoc.getLine (lineNum);
-
-            CodeDocument::Position lineStart (codeDoc, lineNum, 0), lineEnd (codeDoc, lineNum + 1, 0);
-            newHighlightStart = indexToColumn (jmax (0, selStart.getPosition() - lineStart.getPosition()),
-                                               line, tabSpaces);
-            newHighlightEnd = indexToColumn (jmin (lineEnd.getPosition() - lineStart.getPosition(), selEnd.getPosition() - lineStart.getPosition()),
-                                             line, tabSpaces);
+            invalidateCache();
         }
 
-        if (newHighlightStart != highlightColumnStart || newHighlightEnd != highlightColumnEnd)
-        {
-            highlightColumnStart = newHighlightStart;
-            highlightColumnEnd = newHighlightEnd;
-        }
-        else if (tokens == newTokens)
-        {
+        replaceTabsWithSpaces (newTokens, tabSpaces);
+
+        if (! updateHighlight (codeDoc, lineNum, tabSpaces, selStart, selEnd)
+             && tokens == newTokens)
             return false;
-        }
 
         tokens.swapWith (newTokens);
         return true;
     }
 
+    /*  True if this line was last lexed as the same document line with identical
+        text, so its tokens can be reused without running the tokeniser again.
+    */
+    bool canReuseTokensFor (CodeDocument& codeDoc, int lineNum) const noexcept
+    {
+        return cachedLineNum == lineNum
+                && lineNum < codeDoc.getNumLines()
+                && cachedLineText == codeDoc.getLine (lineNum);
+    }
+
+    /*  Refreshes just the selection highlight for a line whose cached tokens are
+        being reused. Returns true if the line needs repainting.
+    */
+    bool updateSelectionOnly (CodeDocument& codeDoc, int lineNum, const int tabSpaces,
+                              const CodeDocument::Position& selStart,
+                              const CodeDocument::Position& selEnd)
+    {
+        return updateHighlight (codeDoc, lineNum, tabSpaces, selStart, selEnd);
+    }
+
+    void invalidateCache() noexcept
+    {
+        cachedLineNum = -1;
+        cachedLineText.clear();
+    }
+
+    void invalidateCacheFrom (int firstAffectedLine) noexcept
+    {
+        if (cachedLineNum >= firstAffectedLine)
+            invalidateCache();
+    }
+
     void getHighlightArea (RectangleList<float>& area, float x, int y, int lineH, float characterWidth) const
     {
         if (highlightColumnStart < highlightColumnEnd)
@@ -238,6 +257,34 @@ public:
     }
 
 private:
+    bool updateHighlight (CodeDocument& codeDoc, int lineNum, const int tabSpaces,
+                          const CodeDocument::Position& selStart,
+                          const CodeDocument::Position& selEnd)
+    {
+        int newHighlightStart = 0;
+        int newHighlightEnd = 0;
+
+        if (selStart.getLineNumber() <= lineNum && selEnd.getLineNumber() >= lineNum)
+        {
+            auto line = codeDoc.getLine (lineNum);
+
+            CodeDocument::Position lineStart (codeDoc, lineNum, 0), lineEnd (codeDoc, lineNum + 1, 0);
+            newHighlightStart = indexToColumn (jmax (0, selStart.getPosition() - lineStart.getPosition()),
+                                               line, tabSpaces);
+            newHighlightEnd = indexToColumn (jmin (lineEnd.getPosition() - lineStart.getPosition(), selEnd.getPosition() - lineStart.getPosition()),
+                                             line, tabSpaces);
+        }
+
+        if (newHighlightStart != highlightColumnStart || newHighlightEnd != highlightColumnEnd)
+        {
+            highlightColumnStart = newHighlightStart;
+            highlightColumnEnd = newHighlightEnd;
+            return true;
+        }
+
+        return false;
+    }
+
     struct SyntaxToken
     {
         SyntaxToken (const String& t, const int len, const int type) noexcept
@@ -258,6 +305,8 @@ private:
 
     Array<SyntaxToken> tokens;
     int highlightColumnStart = 0, highlightColumnEnd = 0;
+    int cachedLineNum = -1;
+    String cachedLineText;
 
     static void createTokens (int startPosition, const String& lineText,
                               CodeDocument::Iterator& source,
@@ -653,16 +702,66 @@ void CodeEditorComponent::rebuildLineTokens()
         minLineToRepaint = 0;
         maxLineToRepaint = numNeeded;
     }
+    else
+    {
+        // realign the per-line caches with the rows they now represent, so that
+        // scrolling only has to re-lex the lines that have just come into view
+        auto delta = firstLineOnScreen - cachedFirstLineOnScreen;
+
+        if (delta != 0 && std::abs (delta) < numNeeded)
+        {
+            for (int k = std::abs (delta); --k >= 0;)
+            {
+                if (delta > 0)
+                {
+                    lines.getUnchecked (0)->invalidateCache();
+                    lines.move (0, numNeeded - 1);
+                }
+                else
+                {
+                    lines.getUnchecked (numNeeded - 1)->invalidateCache();
+                    lines.move (numNeeded - 1, 0);
+                }
+            }
+        }
+    }
+
+    cachedFirstLineOnScreen = firstLineOnScreen;
 
     jassert (numNeeded == lines.size());
 
     CodeDocument::Iterator source (document);
     getIteratorForPosition (CodeDocument::Position (document, firstLineOnScreen, 0).getPosition(), source);
+    bool sourceValid = true;
 
     for (int i = 0; i < numNeeded; ++i)
     {
-        if (lines.getUnchecked(i)->update (document, firstLineOnScreen + i, source, codeTokeniser,
-                                           spacesPerTab, selectionStart, selectionEnd))
+        auto& line = *lines.getUnchecked (i);
+        auto lineNum = firstLineOnScreen + i;
+        bool changed;
+
+        if (codeTokeniser != nullptr && line.canReuseTokensFor (document, lineNum))
+        {
+            // the cached tokens are still valid, so skip re-lexing this line; the
+            // shared iterator will need re-seeking if a later line does need lexing
+            changed = line.updateSelectionOnly (document, lineNum, spacesPerTab,
+                                                selectionStart, selectionEnd);
+            sourceValid = false;
+        }
+        else
+        {
+            if (! sourceValid)
+            {
+                source = CodeDocument::Iterator (document);
+                getIteratorForPosition (CodeDocument::Position (document, lineNum, 0).getPosition(), source);
+                sourceValid = true;
+            }
+
+            changed = line.update (document, lineNum, source, codeTokeniser,
+                                   spacesPerTab, selectionStart, selectionEnd);
+        }
+
+        if (changed)
         {
             minLineToRepaint = jmin (minLineToRepaint, i);
             maxLineToRepaint = jmax (maxLineToRepaint, i);
@@ -706,6 +805,11 @@ void CodeEditorComponent::retokenise (int startIndex, int endIndex)
 
     clearCachedIterators (affectedTextStart.getLineNumber());
 
+    // a change can alter the lexer state for everything that follows it, so any
+    // cached tokens from the affected line onwards can no longer be trusted
+    for (auto* line : lines)
+        line->invalidateCacheFrom (affectedTextStart.getLineNumber());
+
     rebuildLineTokensAsync();
 }
 
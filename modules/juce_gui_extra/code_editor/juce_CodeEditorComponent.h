@@ -421,6 +421,7 @@ private:
 
     class CodeEditorLine;
     OwnedArray<CodeEditorLine> lines;
+    int cachedFirstLineOnScreen = 0;
     void rebuildLineTokens();
     void rebuildLineTokensAsync();
     void codeDocumentChanged (int start, int end);
@@ -124,6 +124,7 @@
 //==============================================================================
 #include "documents/juce_FileBasedDocument.cpp"
 #include "code_editor/juce_CodeDocument.cpp"
+#include "code_editor/juce_CodeDocumentSearchIndex.cpp"
 #include "code_editor/juce_CodeEditorComponent.cpp"
 #include "code_editor/juce_CPlusPlusCodeTokeniser.cpp"
 #include "code_editor/juce_XMLCodeTokeniser.cpp"
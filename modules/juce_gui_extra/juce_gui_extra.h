@@ -95,6 +95,7 @@
 //==============================================================================
 #include "documents/juce_FileBasedDocument.h"
 #include "code_editor/juce_CodeDocument.h"
+#include "code_editor/juce_CodeDocumentSearchIndex.h"
 #include "code_editor/juce_CodeEditorComponent.h"
 #include "code_editor/juce_CodeTokeniser.h"
 #include "code_editor/juce_CPlusPlusCodeTokeniser.h"
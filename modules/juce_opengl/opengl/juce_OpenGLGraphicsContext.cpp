@@ -68,7 +68,14 @@ struct CachedImageList  : public ReferenceCountedObject,
 
         if (c == nullptr)
         {
-            if (auto fb = OpenGLImageType::getFrameBufferFrom (image))
+            auto fb = OpenGLImageType::getFrameBufferFrom (image);
+
+            // Shared images composite straight from their framebuffer too,
+            // after any pending CPU-side changes have been uploaded
+            if (fb == nullptr)
+                fb = OpenGLSharedImageType::getFrameBufferFrom (image);
+
+            if (fb != nullptr)
             {
                 TextureInfo t;
                 t.textureID = fb->getTextureID();
@@ -116,8 +123,13 @@ struct CachedImageList  : public ReferenceCountedObject,
             if (textureNeedsReloading)
             {
                 textureNeedsReloading = false;
+                dirtyRegions.clear();
                 texture.loadImage (Image (*pixelData));
             }
+            else if (! dirtyRegions.isEmpty())
+            {
+                uploadDirtyRegions();
+            }
 
             t.textureID = texture.getTextureID();
             t.imageWidth = pixelData->width;
@@ -129,9 +141,52 @@ struct CachedImageList  : public ReferenceCountedObject,
             return t;
         }
 
+        void uploadDirtyRegions()
+        {
+            const Image image (*pixelData);
+            const auto imageBounds = image.getBounds();
+
+            // round each changed area out to a tile grid and merge them, so that
+            // lots of scattered little changes don't each pay for their own upload
+            RectangleList<int> tiles;
+
+            for (auto& r : dirtyRegions)
+                tiles.add (imageBounds.getIntersection (getTileAlignedRectangle (r)));
+
+            dirtyRegions.clear();
+
+            int64 dirtyArea = 0;
+
+            for (auto& r : tiles)
+                dirtyArea += (int64) r.getWidth() * (int64) r.getHeight();
+
+            // if most of the image has changed anyway, one big upload is cheaper
+            if (dirtyArea * 4 >= (int64) imageBounds.getWidth() * (int64) imageBounds.getHeight() * 3)
+            {
+                texture.loadImage (image);
+                return;
+            }
+
+            for (auto& r : tiles)
+                texture.updateImageArea (image, r);
+        }
+
+        static Rectangle<int> getTileAlignedRectangle (const Rectangle<int>& r) noexcept
+        {
+            constexpr int tileSize = 64;
+
+            auto x = r.getX() & ~(tileSize - 1);
+            auto y = r.getY() & ~(tileSize - 1);
+
+            return { x, y,
+                     ((r.getRight()  + (tileSize - 1)) & ~(tileSize - 1)) - x,
+                     ((r.getBottom() + (tileSize - 1)) & ~(tileSize - 1)) - y };
+        }
+
         CachedImageList& owner;
         ImagePixelData* pixelData;
         OpenGLTexture texture;
+        RectangleList<int> dirtyRegions;
         Time lastUsed;
         const size_t imageSize;
         bool textureNeedsReloading = true;
@@ -158,6 +213,17 @@ private:
             c->textureNeedsReloading = true;
     }
 
+    void imageAreaChanged (ImagePixelData* im, const Rectangle<int>& area) override
+    {
+        if (auto* c = findCachedImage (im))
+        {
+            if (area.contains (Rectangle<int> (im->width, im->height)))
+                c->textureNeedsReloading = true;
+            else if (! (c->textureNeedsReloading || area.isEmpty()))
+                c->dirtyRegions.add (area);
+        }
+    }
+
     void imageDataBeingDeleted (ImagePixelData* im) override
     {
         for (int i = images.size(); --i >= 0;)
@@ -422,10 +488,10 @@ struct ShaderPrograms  : public ReferenceCountedObject
             screenBounds.set (bounds.getX(), bounds.getY(), 0.5f * bounds.getWidth(), 0.5f * bounds.getHeight());
         }
 
-        void bindAttributes()
+        void bindAttributes (size_t vertexDataOffset = 0)
         {
-            gl::glVertexAttribPointer ((GLuint) positionAttribute.attributeID, 2, GL_SHORT, GL_FALSE, 8, nullptr);
-            gl::glVertexAttribPointer ((GLuint) colourAttribute.attributeID, 4, GL_UNSIGNED_BYTE, GL_TRUE, 8, (void*) 4);
+            gl::glVertexAttribPointer ((GLuint) positionAttribute.attributeID, 2, GL_SHORT, GL_FALSE, 8, (void*) vertexDataOffset);
+            gl::glVertexAttribPointer ((GLuint) colourAttribute.attributeID, 4, GL_UNSIGNED_BYTE, GL_TRUE, 8, (void*) (vertexDataOffset + 4));
             gl::glEnableVertexAttribArray ((GLuint) positionAttribute.attributeID);
             gl::glEnableVertexAttribArray ((GLuint) colourAttribute.attributeID);
         }
@@ -1148,6 +1214,13 @@ struct StateHelpers
     };
 
     //==============================================================================
+    /** Batches quads into a shared vertex buffer that persists across draws.
+
+        Quads added with the same program/blend/texture state accumulate until
+        something actually changes, and each draw appends its vertices further
+        along the buffer, orphaning it when full, so the driver never has to
+        stall waiting for in-flight data before a write can proceed.
+    */
     struct ShaderQuadQueue
     {
         ShaderQuadQueue (const OpenGLContext& c) noexcept  : context (c)
@@ -1171,9 +1244,13 @@ struct StateHelpers
             GLint maxIndices = 0;
             glGetIntegerv (GL_MAX_ELEMENTS_INDICES, &maxIndices);
             auto numQuads = jmin ((int) maxNumQuads, (int) maxIndices / 6);
-            maxVertices = numQuads * 4 - 4;
            #endif
 
+            maxVertices = numQuads * 4 - 4;
+            vertexData.malloc (numQuads * 4);
+
+            HeapBlock<GLushort> indexData (numQuads * 6);
+
             for (int i = 0, v = 0; i < numQuads * 6; i += 6, v += 4)
             {
                 indexData[i] = (GLushort) v;
@@ -1182,14 +1259,21 @@ struct StateHelpers
                 indexData[i + 5] = (GLushort) (v + 3);
             }
 
+            vertexBufferSize = (GLsizeiptr) ((size_t) numQuads * 4 * sizeof (VertexInfo));
+
             context.extensions.glGenBuffers (2, buffers);
             context.extensions.glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, buffers[0]);
-            context.extensions.glBufferData (GL_ELEMENT_ARRAY_BUFFER, sizeof (indexData), indexData, GL_STATIC_DRAW);
+            context.extensions.glBufferData (GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr) ((size_t) numQuads * 6 * sizeof (GLushort)), indexData, GL_STATIC_DRAW);
             context.extensions.glBindBuffer (GL_ARRAY_BUFFER, buffers[1]);
-            context.extensions.glBufferData (GL_ARRAY_BUFFER, sizeof (vertexData), vertexData, GL_STREAM_DRAW);
+            context.extensions.glBufferData (GL_ARRAY_BUFFER, vertexBufferSize, nullptr, GL_STREAM_DRAW);
             JUCE_CHECK_OPENGL_ERROR
         }
 
+        void setActiveShader (ShaderPrograms::ShaderBase* shader) noexcept
+        {
+            activeShader = shader;
+        }
+
         void add (int x, int y, int w, int h, PixelARGB colour) noexcept
         {
             jassert (w > 0 && h > 0);
@@ -1267,27 +1351,41 @@ struct StateHelpers
             GLuint colour;
         };
 
-        enum { maxNumQuads = 256 };
+        enum { maxNumQuads = 4096 };
 
         GLuint buffers[2];
-        VertexInfo vertexData[maxNumQuads * 4];
-        GLushort indexData[maxNumQuads * 6];
+        HeapBlock<VertexInfo> vertexData;
         const OpenGLContext& context;
+        ShaderPrograms::ShaderBase* activeShader = nullptr;
+        GLsizeiptr vertexBufferSize = 0, vertexBufferOffset = 0;
         int numVertices = 0;
-
-       #if JUCE_ANDROID || JUCE_IOS
-        enum { maxVertices = maxNumQuads * 4 - 4 };
-       #else
         int maxVertices = 0;
-       #endif
 
         void draw() noexcept
         {
-            context.extensions.glBufferSubData (GL_ARRAY_BUFFER, 0, (GLsizeiptr) ((size_t) numVertices * sizeof (VertexInfo)), vertexData);
+            auto numBytes = (GLsizeiptr) ((size_t) numVertices * sizeof (VertexInfo));
+
+            if (vertexBufferOffset + numBytes > vertexBufferSize)
+            {
+                // The buffer is full, so orphan it: the driver keeps the old storage alive
+                // for any in-flight draws and hands us a fresh block, which means writing
+                // can restart at the front without blocking on the GPU.
+                context.extensions.glBufferData (GL_ARRAY_BUFFER, vertexBufferSize, nullptr, GL_STREAM_DRAW);
+                vertexBufferOffset = 0;
+            }
+
+            context.extensions.glBufferSubData (GL_ARRAY_BUFFER, vertexBufferOffset, numBytes, vertexData);
+
+            jassert (activeShader != nullptr); // quads can only be drawn with a shader active!
+
+            if (activeShader != nullptr)
+                activeShader->bindAttributes ((size_t) vertexBufferOffset);
+
             // NB: If you get a random crash in here and are running in a Parallels VM, it seems to be a bug in
             // their driver.. Can't find a workaround unfortunately.
             glDrawElements (GL_TRIANGLES, (numVertices * 3) / 2, GL_UNSIGNED_SHORT, nullptr);
             JUCE_CHECK_OPENGL_ERROR
+            vertexBufferOffset += numBytes;
             numVertices = 0;
         }
 
@@ -1323,6 +1421,7 @@ struct StateHelpers
                 activeShader = &shader;
                 shader.program.use();
                 shader.bindAttributes();
+                quadQueue.setActiveShader (&shader);
 
                 if (shader.onShaderActivated)
                     shader.onShaderActivated (shader.program);
@@ -1349,6 +1448,7 @@ struct StateHelpers
             if (activeShader != nullptr)
             {
                 quadQueue.flush();
+                quadQueue.setActiveShader (nullptr);
                 activeShader->unbindAttributes();
                 activeShader = nullptr;
                 context.extensions.glUseProgram (0);
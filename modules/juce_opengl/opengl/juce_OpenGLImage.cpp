@@ -81,9 +81,11 @@ public:
             case Image::BitmapData::readWrite:  DataReleaser<Reader, Writer>::initialise (frameBuffer, bitmapData, x, y); break;
             default:                            jassertfalse; break;
         }
+    }
 
-        if (mode != Image::BitmapData::readOnly)
-            sendDataChangeMessage();
+    ImagePixelData::Residency getResidency() const noexcept override
+    {
+        return Residency::hardware;
     }
 
     OpenGLContext& context;
@@ -214,4 +216,166 @@ OpenGLFrameBuffer* OpenGLImageType::getFrameBufferFrom (const Image& image)
     return nullptr;
 }
 
+//==============================================================================
+class OpenGLSharedImage   : public ImagePixelData
+{
+public:
+    OpenGLSharedImage (OpenGLContext& c, int w, int h)
+        : ImagePixelData (Image::ARGB, w, h),
+          context (c),
+          cpuCopy (SoftwareImageType().create (Image::ARGB, w, h, true))
+    {
+    }
+
+    bool initialise()
+    {
+        if (! frameBuffer.initialise (context, width, height))
+            return false;
+
+        frameBuffer.clear (Colours::transparentBlack);
+        return true;
+    }
+
+    std::unique_ptr<LowLevelGraphicsContext> createLowLevelContext() override
+    {
+        // GL paints go straight into the framebuffer; until something reads
+        // the pixels back we can't tell which of them will be touched
+        flushToGpu();
+        gpuDirtyArea = Rectangle<int> (width, height);
+        sendDataChangeMessage();
+        return createOpenGLGraphicsContext (context, frameBuffer);
+    }
+
+    std::unique_ptr<ImageType> createType() const override     { return std::make_unique<OpenGLSharedImageType>(); }
+
+    Residency getResidency() const noexcept override           { return Residency::shared; }
+
+    ImagePixelData::Ptr clone() override
+    {
+        flushToCpu();
+
+        std::unique_ptr<OpenGLSharedImage> im (new OpenGLSharedImage (context, width, height));
+
+        if (! im->initialise())
+            return ImagePixelData::Ptr();
+
+        {
+            Image source (this), target (im.get());
+            const Image::BitmapData src (source, Image::BitmapData::readOnly);
+            Image::BitmapData dest (target, Image::BitmapData::writeOnly);
+
+            for (int y = 0; y < height; ++y)
+                memcpy (dest.getLinePointer (y), src.getLinePointer (y),
+                        (size_t) width * sizeof (PixelARGB));
+        }
+
+        return *im.release();
+    }
+
+    void initialiseBitmapData (Image::BitmapData& bitmapData, int x, int y, Image::BitmapData::ReadWriteMode mode) override
+    {
+        if (mode != Image::BitmapData::writeOnly)
+            flushToCpu();
+
+        cpuCopy->initialiseBitmapData (bitmapData, x, y, mode);
+
+        // The lock covers everything the caller can write, so that's the
+        // area that will need uploading before the GPU side is used again
+        if (mode != Image::BitmapData::readOnly)
+            cpuDirtyArea = cpuDirtyArea.getUnion ({ x, y, bitmapData.width, bitmapData.height });
+    }
+
+    /** Uploads any pending CPU-side changes to the framebuffer.
+        Requires an active GL context.
+    */
+    void flushToGpu()
+    {
+        if (cpuDirtyArea.isEmpty())
+            return;
+
+        auto area = cpuDirtyArea.getIntersection (Rectangle<int> (width, height));
+        cpuDirtyArea = {};
+
+        Image source (cpuCopy);
+        const Image::BitmapData src (source, area.getX(), area.getY(),
+                                     area.getWidth(), area.getHeight(), Image::BitmapData::readOnly);
+
+        HeapBlock<PixelARGB> inverted ((size_t) area.getWidth() * (size_t) area.getHeight());
+        auto rowSize = (size_t) area.getWidth() * sizeof (PixelARGB);
+
+        for (int y = 0; y < area.getHeight(); ++y)
+            memcpy (inverted + (size_t) area.getWidth() * (size_t) y,
+                    src.getLinePointer (area.getHeight() - 1 - y), rowSize);
+
+        frameBuffer.writePixels (inverted, area);
+    }
+
+    /** Reads any pending GPU-side changes back into the CPU copy.
+        Requires an active GL context.
+    */
+    void flushToCpu()
+    {
+        if (gpuDirtyArea.isEmpty())
+            return;
+
+        auto area = gpuDirtyArea.getIntersection (Rectangle<int> (width, height));
+        gpuDirtyArea = {};
+
+        HeapBlock<PixelARGB> temp ((size_t) area.getWidth() * (size_t) area.getHeight());
+        frameBuffer.readPixels (temp, { area.getX(), height - area.getBottom(),
+                                        area.getWidth(), area.getHeight() });
+
+        Image target (cpuCopy);
+        Image::BitmapData dest (target, area.getX(), area.getY(),
+                                area.getWidth(), area.getHeight(), Image::BitmapData::writeOnly);
+        auto rowSize = (size_t) area.getWidth() * sizeof (PixelARGB);
+
+        for (int y = 0; y < area.getHeight(); ++y)
+            memcpy (dest.getLinePointer (y),
+                    temp + (size_t) area.getWidth() * (size_t) (area.getHeight() - 1 - y), rowSize);
+    }
+
+    OpenGLContext& context;
+    OpenGLFrameBuffer frameBuffer;
+
+private:
+    ImagePixelData::Ptr cpuCopy;
+    Rectangle<int> cpuDirtyArea, gpuDirtyArea;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OpenGLSharedImage)
+};
+
+//==============================================================================
+OpenGLSharedImageType::OpenGLSharedImageType() {}
+OpenGLSharedImageType::~OpenGLSharedImageType() {}
+
+int OpenGLSharedImageType::getTypeID() const
+{
+    return 4;
+}
+
+ImagePixelData::Ptr OpenGLSharedImageType::create (Image::PixelFormat, int width, int height, bool /*shouldClearImage*/) const
+{
+    OpenGLContext* currentContext = OpenGLContext::getCurrentContext();
+    jassert (currentContext != nullptr); // an OpenGL image can only be created when a valid context is active!
+
+    std::unique_ptr<OpenGLSharedImage> im (new OpenGLSharedImage (*currentContext, width, height));
+
+    if (! im->initialise())
+        return ImagePixelData::Ptr();
+
+    return *im.release();
+}
+
+OpenGLFrameBuffer* OpenGLSharedImageType::getFrameBufferFrom (const Image& image)
+{
+    if (auto* glImage = dynamic_cast<OpenGLSharedImage*> (image.getPixelData()))
+    {
+        glImage->flushToGpu();
+        return &(glImage->frameBuffer);
+    }
+
+    return nullptr;
+}
+
 } // namespace juce
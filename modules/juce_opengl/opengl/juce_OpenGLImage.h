@@ -51,4 +51,44 @@ public:
     static OpenGLFrameBuffer* getFrameBufferFrom (const Image&);
 };
 
+//==============================================================================
+/**
+    An image type whose pixels live in both CPU memory and an OpenGL
+    framebuffer, keeping the two in sync lazily.
+
+    A plain OpenGLImageType image is GPU-resident, so every BitmapData access
+    or software paint triggers a full readback and re-upload. Images of this
+    type instead keep a software copy alongside the framebuffer and track
+    which side is out of date: software paints and pixel access run on the
+    CPU copy and only the touched area is uploaded when the GPU side is next
+    used, while GL paints go straight into the framebuffer and are read back
+    only when (and where) the CPU side actually needs them.
+
+    This makes it cheap to mix paint paths - for example a component that is
+    mostly rendered by an OpenGLContext but occasionally retouched with the
+    software renderer - because pixels only cross the bus for the dirty area,
+    not the whole image, on each transition.
+
+    Like OpenGLImageType, images of this type can only be created and drawn
+    while a GL context is active.
+
+    @see OpenGLImageType, ImagePixelData::Residency
+
+    @tags{OpenGL}
+*/
+class JUCE_API  OpenGLSharedImageType   : public ImageType
+{
+public:
+    OpenGLSharedImageType();
+    ~OpenGLSharedImageType() override;
+
+    ImagePixelData::Ptr create (Image::PixelFormat, int width, int height, bool shouldClearImage) const override;
+    int getTypeID() const override;
+
+    /** If the given image is of this type, returns its framebuffer, first
+        uploading any pending CPU-side changes. Returns nullptr otherwise.
+    */
+    static OpenGLFrameBuffer* getFrameBufferFrom (const Image&);
+};
+
 } // namespace juce
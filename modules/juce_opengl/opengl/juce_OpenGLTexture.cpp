@@ -141,11 +141,62 @@ void OpenGLTexture::loadImage (const Image& image)
     create (imageW, imageH, dataCopy, JUCE_RGBA_FORMAT, true);
 }
 
+void OpenGLTexture::updateImageArea (const Image& image, const Rectangle<int>& area)
+{
+    // The texture must already have been created from an image of this size
+    // with loadImage() before you can update areas of it
+    jassert (textureID != 0 && ownerContext == OpenGLContext::getCurrentContext());
+    jassert (image.getBounds().contains (area));
+
+    if (area.isEmpty() || textureID == 0)
+        return;
+
+    HeapBlock<PixelARGB> dataCopy;
+    Image::BitmapData srcData (image, area.getX(), area.getY(), area.getWidth(), area.getHeight());
+
+    switch (srcData.pixelFormat)
+    {
+        case Image::ARGB:           Flipper<PixelARGB> ::flip (dataCopy, srcData.data, srcData.lineStride, area.getWidth(), area.getHeight()); break;
+        case Image::RGB:            Flipper<PixelRGB>  ::flip (dataCopy, srcData.data, srcData.lineStride, area.getWidth(), area.getHeight()); break;
+        case Image::SingleChannel:  Flipper<PixelAlpha>::flip (dataCopy, srcData.data, srcData.lineStride, area.getWidth(), area.getHeight()); break;
+        case Image::UnknownFormat:
+        default: return;
+    }
+
+    glBindTexture (GL_TEXTURE_2D, textureID);
+    glPixelStorei (GL_UNPACK_ALIGNMENT, 1);
+
+    // the image was loaded flipped and anchored at the top of the (possibly
+    // padded) texture, so its row y lives at texture row (height - 1 - y)
+    glTexSubImage2D (GL_TEXTURE_2D, 0, area.getX(), height - area.getBottom(),
+                     area.getWidth(), area.getHeight(),
+                     JUCE_RGBA_FORMAT, GL_UNSIGNED_BYTE, dataCopy);
+    JUCE_CHECK_OPENGL_ERROR
+}
+
 void OpenGLTexture::loadARGB (const PixelARGB* pixels, const int w, const int h)
 {
     create (w, h, pixels, JUCE_RGBA_FORMAT, false);
 }
 
+void OpenGLTexture::updateARGBArea (const PixelARGB* pixels, int x, int y, int w, int h)
+{
+    // The texture must already have been created with loadARGB() before
+    // you can update areas of it
+    jassert (textureID != 0 && ownerContext == OpenGLContext::getCurrentContext());
+    jassert (x >= 0 && y >= 0 && x + w <= width && y + h <= height);
+
+    if (w <= 0 || h <= 0 || textureID == 0)
+        return;
+
+    glBindTexture (GL_TEXTURE_2D, textureID);
+    glPixelStorei (GL_UNPACK_ALIGNMENT, 1);
+
+    glTexSubImage2D (GL_TEXTURE_2D, 0, x, y, w, h,
+                     JUCE_RGBA_FORMAT, GL_UNSIGNED_BYTE, pixels);
+    JUCE_CHECK_OPENGL_ERROR
+}
+
 void OpenGLTexture::loadAlpha (const uint8* pixels, int w, int h)
 {
     create (w, h, pixels, GL_ALPHA, false);
@@ -48,6 +48,15 @@ public:
     */
     void loadImage (const Image& image);
 
+    /** Re-uploads just a sub-section of an image into an existing texture.
+
+        The texture must previously have been created from this image (or one
+        with identical dimensions) with loadImage() - only the pixels inside
+        the given area are sent to the driver, so updating a small region of a
+        large image is much cheaper than re-loading the whole thing.
+    */
+    void updateImageArea (const Image& image, const Rectangle<int>& area);
+
     /** Creates a texture from a raw array of pixels.
         If width and height are not powers-of-two, the texture will be created with a
         larger size, and only the subsection (0, 0, width, height) will be initialised.
@@ -56,6 +65,17 @@ public:
     */
     void loadARGB (const PixelARGB* pixels, int width, int height);
 
+    /** Re-uploads a rectangle of raw pixels into an existing texture.
+
+        The texture must already have been created with loadARGB() (or another
+        method using the same orientation), and the rectangle must lie within
+        its bounds. The pixels are packed rows of the given width with no
+        padding, and are sent to the driver as-is, so this is the cheapest way
+        to stream freshly-generated data - e.g. new spectrogram columns - into
+        a texture each frame.
+    */
+    void updateARGBArea (const PixelARGB* pixels, int x, int y, int width, int height);
+
     /** Creates a texture from a raw array of pixels.
         This is like loadARGB, but will vertically flip the data so that the first
         pixel ends up at texture coordinate (0, 1), and if the width and height are
@@ -394,6 +394,142 @@ String OSCAddressPattern::toString() const noexcept
     return asString;
 }
 
+//==============================================================================
+OSCAddressTrie::OSCAddressTrie() {}
+
+void OSCAddressTrie::add (const OSCAddress& address, int value)
+{
+    auto* node = &root;
+
+    for (auto& symbol : address.oscSymbols)
+    {
+        Node* next = nullptr;
+
+        for (auto* child : node->children)
+        {
+            if (child->symbol == symbol)
+            {
+                next = child;
+                break;
+            }
+        }
+
+        if (next == nullptr)
+        {
+            next = new Node();
+            next->symbol = symbol;
+            node->children.add (next);
+        }
+
+        node = next;
+    }
+
+    node->values.add (value);
+}
+
+bool OSCAddressTrie::remove (const OSCAddress& address, int value)
+{
+    auto removeFrom = [&] (Node& node, int depth, auto& self) -> bool
+    {
+        if (depth == address.oscSymbols.size())
+        {
+            auto indexOfValue = node.values.indexOf (value);
+
+            if (indexOfValue < 0)
+                return false;
+
+            node.values.remove (indexOfValue);
+            return true;
+        }
+
+        for (int i = 0; i < node.children.size(); ++i)
+        {
+            auto* child = node.children.getUnchecked (i);
+
+            if (child->symbol == address.oscSymbols[depth])
+            {
+                if (! self (*child, depth + 1, self))
+                    return false;
+
+                // prune branches that no longer lead to any values:
+                if (child->values.isEmpty() && child->children.isEmpty())
+                    node.children.remove (i);
+
+                return true;
+            }
+        }
+
+        return false;
+    };
+
+    return removeFrom (root, 0, removeFrom);
+}
+
+void OSCAddressTrie::clear()
+{
+    root.children.clear();
+    root.values.clear();
+}
+
+bool OSCAddressTrie::isEmpty() const noexcept
+{
+    return root.children.isEmpty() && root.values.isEmpty();
+}
+
+//==============================================================================
+void OSCAddressTrie::findMatches (const OSCAddressPattern& pattern, Array<int>& results) const
+{
+    auto matchFrom = [&] (const Node& node, int depth, auto& self) -> void
+    {
+        if (depth == pattern.oscSymbols.size())
+        {
+            results.addArray (node.values);
+            return;
+        }
+
+        for (auto* child : node.children)
+            if (matchOscPattern (pattern.oscSymbols[depth], child->symbol))
+                self (*child, depth + 1, self);
+    };
+
+    matchFrom (root, 0, matchFrom);
+}
+
+void OSCAddressTrie::findMatches (StringRef patternString, Array<int>& results) const
+{
+    using CharPtr = String::CharPointerType;
+
+    if (patternString.isEmpty() || *patternString.text != '/')
+        return;
+
+    auto matchFrom = [&results] (const Node& node, CharPtr pos, auto& self) -> void
+    {
+        while (*pos == '/')  // additional slashes are ignored, as in the tokeniser
+            ++pos;
+
+        if (pos.isEmpty())
+        {
+            results.addArray (node.values);
+            return;
+        }
+
+        auto componentEnd = pos;
+
+        while (! componentEnd.isEmpty() && *componentEnd != '/')
+            ++componentEnd;
+
+        for (auto* child : node.children)
+        {
+            auto symbol = child->symbol.getCharPointer();
+
+            if (OSCPatternMatcherImpl<CharPtr>::match (pos, componentEnd,
+                                                       symbol, symbol.findTerminatingNull()))
+                self (*child, componentEnd, self);
+        }
+    };
+
+    matchFrom (root, patternString.text, matchFrom);
+}
 
 //==============================================================================
 //==============================================================================
@@ -787,6 +923,137 @@ public:
 
 static OSCPatternMatcherTests OSCPatternMatcherUnitTests;
 
+//==============================================================================
+
+class OSCAddressTrieTests  : public UnitTest
+{
+public:
+    OSCAddressTrieTests()
+        : UnitTest ("OSCAddressTrie class", UnitTestCategories::osc)
+    {}
+
+    void runTest()
+    {
+        beginTest ("adding and removing addresses");
+        {
+            OSCAddressTrie trie;
+            expect (trie.isEmpty());
+
+            trie.add (OSCAddress ("/foo/bar"), 1);
+            trie.add (OSCAddress ("/foo/baz"), 2);
+            trie.add (OSCAddress ("/foo/bar"), 3);
+            expect (! trie.isEmpty());
+
+            expect (trie.remove (OSCAddress ("/foo/bar"), 1));
+            expect (! trie.remove (OSCAddress ("/foo/bar"), 1));
+            expect (! trie.remove (OSCAddress ("/foo/nothere"), 2));
+            expect (trie.remove (OSCAddress ("/foo/baz"), 2));
+            expect (trie.remove (OSCAddress ("/foo/bar"), 3));
+            expect (trie.isEmpty());
+        }
+
+        beginTest ("literal pattern lookup");
+        {
+            OSCAddressTrie trie;
+            trie.add (OSCAddress ("/patch/input/slider0"), 0);
+            trie.add (OSCAddress ("/patch/input/slider1"), 1);
+            trie.add (OSCAddress ("/patch/output/slider0"), 2);
+            trie.add (OSCAddress ("/patch"), 3);
+
+            Array<int> results;
+            trie.findMatches (OSCAddressPattern ("/patch/input/slider1"), results);
+            expectEquals (results.size(), 1);
+            expectEquals (results[0], 1);
+
+            results.clearQuick();
+            trie.findMatches (OSCAddressPattern ("/patch"), results);
+            expectEquals (results.size(), 1);
+            expectEquals (results[0], 3);
+
+            // addresses are only matched in full - a pattern matching a prefix is not enough:
+            results.clearQuick();
+            trie.findMatches (OSCAddressPattern ("/patch/input"), results);
+            expectEquals (results.size(), 0);
+
+            trie.findMatches (OSCAddressPattern ("/patch/input/slider7"), results);
+            expectEquals (results.size(), 0);
+        }
+
+        beginTest ("wildcard pattern lookup");
+        {
+            OSCAddressTrie trie;
+            trie.add (OSCAddress ("/patch/input/slider0"), 0);
+            trie.add (OSCAddress ("/patch/input/slider1"), 1);
+            trie.add (OSCAddress ("/patch/output/slider0"), 2);
+            trie.add (OSCAddress ("/patch/output/knob0"), 3);
+
+            Array<int> results;
+            trie.findMatches (OSCAddressPattern ("/*/*put/slider[0-9]"), results);
+            results.sort();
+            expectEquals (results.size(), 3);
+            expectEquals (results[0], 0);
+            expectEquals (results[1], 1);
+            expectEquals (results[2], 2);
+
+            results.clearQuick();
+            trie.findMatches (OSCAddressPattern ("/patch/output/{slider,knob}0"), results);
+            results.sort();
+            expectEquals (results.size(), 2);
+            expectEquals (results[0], 2);
+            expectEquals (results[1], 3);
+        }
+
+        beginTest ("lookup from an unparsed pattern string");
+        {
+            OSCAddressTrie trie;
+            trie.add (OSCAddress ("/patch/input/slider0"), 0);
+            trie.add (OSCAddress ("/patch/input/slider1"), 1);
+            trie.add (OSCAddress ("/"), 7);
+
+            Array<int> results;
+            trie.findMatches (StringRef ("/patch/input/slider?"), results);
+            results.sort();
+            expectEquals (results.size(), 2);
+            expectEquals (results[0], 0);
+            expectEquals (results[1], 1);
+
+            // additional slashes are ignored, as in OSCAddressPattern:
+            results.clearQuick();
+            trie.findMatches (StringRef ("//patch//input/slider0/"), results);
+            expectEquals (results.size(), 1);
+            expectEquals (results[0], 0);
+
+            // the root address is reachable:
+            results.clearQuick();
+            trie.findMatches (StringRef ("/"), results);
+            expectEquals (results.size(), 1);
+            expectEquals (results[0], 7);
+
+            // strings that are not valid patterns match nothing:
+            results.clearQuick();
+            trie.findMatches (StringRef ("noleadingslash"), results);
+            trie.findMatches (StringRef (""), results);
+            expectEquals (results.size(), 0);
+        }
+
+        beginTest ("results accumulate so the array can be reused");
+        {
+            OSCAddressTrie trie;
+            trie.add (OSCAddress ("/a"), 1);
+            trie.add (OSCAddress ("/b"), 2);
+
+            Array<int> results;
+            trie.findMatches (OSCAddressPattern ("/a"), results);
+            trie.findMatches (OSCAddressPattern ("/b"), results);
+            expectEquals (results.size(), 2);
+            expectEquals (results[0], 1);
+            expectEquals (results[1], 2);
+        }
+    }
+};
+
+static OSCAddressTrieTests OSCAddressTrieUnitTests;
+
 #endif
 
 } // namespace juce
@@ -80,6 +80,7 @@ private:
     StringArray oscSymbols;
     String asString;
     friend class OSCAddressPattern;
+    friend class OSCAddressTrie;
 };
 
 //==============================================================================
@@ -148,6 +149,79 @@ private:
     StringArray oscSymbols;
     String asString;
     bool wasInitialisedWithWildcards;
+    friend class OSCAddressTrie;
+};
+
+//==============================================================================
+/**
+    A compiled index of OSCAddresses for quickly finding the addresses matched
+    by an incoming OSC address pattern.
+
+    Each address added to the trie is associated with a caller-supplied integer
+    value (typically the index of a listener in some array). findMatches() then
+    walks the trie one address part at a time, so a lookup visits only the
+    registered addresses that share a prefix with the pattern instead of
+    matching the pattern against every address in turn.
+
+    Lookups don't allocate: findMatches() appends to a results array that the
+    caller can reuse between calls, and the StringRef overload reads the
+    pattern straight out of a packet buffer.
+
+    @see OSCAddress, OSCAddressPattern, OSCReceiver
+
+    @tags{OSC}
+*/
+class JUCE_API  OSCAddressTrie
+{
+public:
+    //==============================================================================
+    /** Creates an empty trie. */
+    OSCAddressTrie();
+
+    /** Adds an address to the trie, associated with the given value.
+        The same address may be added several times with different values.
+    */
+    void add (const OSCAddress& address, int value);
+
+    /** Removes a previously added address/value pair.
+        @returns true if the pair was found and removed.
+    */
+    bool remove (const OSCAddress& address, int value);
+
+    /** Removes all the addresses from the trie. */
+    void clear();
+
+    /** Returns true if no addresses have been added. */
+    bool isEmpty() const noexcept;
+
+    //==============================================================================
+    /** Finds the values of all the addresses that the given pattern matches,
+        appending them to the results array.
+
+        The results array is not cleared first, so a caller dispatching messages
+        can reuse the same array to avoid allocating once it has grown.
+    */
+    void findMatches (const OSCAddressPattern& pattern, Array<int>& results) const;
+
+    /** As above, but takes the pattern as an unparsed string, so a pattern can
+        be matched straight out of a packet buffer without constructing an
+        OSCAddressPattern. Strings that aren't valid patterns simply match
+        nothing.
+    */
+    void findMatches (StringRef patternString, Array<int>& results) const;
+
+private:
+    //==============================================================================
+    struct Node
+    {
+        String symbol;
+        OwnedArray<Node> children;
+        Array<int> values;
+    };
+
+    Node root;
+
+    JUCE_LEAK_DETECTOR (OSCAddressTrie)
 };
 
 } // namespace juce
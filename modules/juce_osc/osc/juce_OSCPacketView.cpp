@@ -0,0 +1,446 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace
+{
+    constexpr size_t roundUpToMultipleOfFour (size_t n) noexcept
+    {
+        return (n + 3) & ~(size_t) 3;
+    }
+}
+
+//==============================================================================
+int32 OSCArgumentView::getInt32() const noexcept
+{
+    jassert (isInt32());
+    return (int32) ByteOrder::bigEndianInt (data);
+}
+
+float OSCArgumentView::getFloat32() const noexcept
+{
+    jassert (isFloat32());
+
+    union { int32 asInt; float asFloat; } n;
+    n.asInt = (int32) ByteOrder::bigEndianInt (data);
+
+    return n.asFloat;
+}
+
+StringRef OSCArgumentView::getString() const noexcept
+{
+    jassert (isString());
+    return StringRef (reinterpret_cast<const char*> (data));
+}
+
+const void* OSCArgumentView::getBlobData() const noexcept
+{
+    jassert (isBlob());
+    return data + 4;
+}
+
+size_t OSCArgumentView::getBlobDataSize() const noexcept
+{
+    jassert (isBlob());
+    return (size_t) ByteOrder::bigEndianInt (data);
+}
+
+OSCColour OSCArgumentView::getColour() const noexcept
+{
+    jassert (isColour());
+    return OSCColour::fromInt32 (ByteOrder::bigEndianInt (data));
+}
+
+//==============================================================================
+OSCMessageView::OSCMessageView (const void* sourceData, size_t sourceDataSize)
+{
+    auto* pos = static_cast<const uint8*> (sourceData);
+    auto* end = pos + sourceDataSize;
+
+    auto readStringInPlace = [&pos, end] (const char* errorMessage) -> const char*
+    {
+        auto* stringBegin = pos;
+
+        while (pos != end && *pos != '\0')
+            ++pos;
+
+        if (pos == end)
+            throw OSCFormatError (errorMessage);
+
+        auto paddedSize = roundUpToMultipleOfFour ((size_t) (pos - stringBegin) + 1);
+
+        if (paddedSize > (size_t) (end - stringBegin))
+            throw OSCFormatError ("OSC packet format error: missing padding zeros after string");
+
+        for (auto* p = pos + 1; p != stringBegin + paddedSize; ++p)
+            if (*p != 0)
+                throw OSCFormatError ("OSC packet format error: missing padding zeros after string");
+
+        pos = stringBegin + paddedSize;
+        return reinterpret_cast<const char*> (stringBegin);
+    };
+
+    addressPattern = readStringInPlace ("OSC packet exhausted while reading address pattern");
+
+    if (addressPattern[0] != '/')
+        throw OSCFormatError ("OSC packet format error: address pattern should start with a '/'");
+
+    auto* typeTagString = readStringInPlace ("OSC packet exhausted while reading type tag string");
+
+    if (typeTagString[0] != ',')
+        throw OSCFormatError ("OSC packet format error: expected type tag string");
+
+    typeTags = typeTagString + 1;
+    numArguments = 0;
+
+    for (auto* tag = typeTags; *tag != '\0'; ++tag)
+    {
+        if (! OSCTypes::isSupportedType (*tag))
+            throw OSCFormatError ("OSC packet format error: encountered unsupported type tag");
+
+        ++numArguments;
+    }
+
+    firstArgument = pos;
+
+    // walk the arguments once to check that they all fit inside the buffer,
+    // so that the accessors can be noexcept:
+    for (int i = 0; i < numArguments; ++i)
+    {
+        if (typeTags[i] == OSCTypes::string)
+        {
+            readStringInPlace ("OSC packet exhausted while reading string argument");
+        }
+        else if (typeTags[i] == OSCTypes::blob)
+        {
+            if ((size_t) (end - pos) < 4)
+                throw OSCFormatError ("OSC packet exhausted while reading blob size");
+
+            auto blobSize = (size_t) ByteOrder::bigEndianInt (pos);
+            pos += 4;
+
+            auto paddedSize = roundUpToMultipleOfFour (blobSize);
+
+            if (paddedSize > (size_t) (end - pos))
+                throw OSCFormatError ("OSC packet exhausted before reaching end of blob");
+
+            for (auto* p = pos + blobSize; p != pos + paddedSize; ++p)
+                if (*p != 0)
+                    throw OSCFormatError ("OSC packet format error: missing padding zeros after blob");
+
+            pos += paddedSize;
+        }
+        else  // int32, float32 and colour are all stored as 4 bytes
+        {
+            if ((size_t) (end - pos) < 4)
+                throw OSCFormatError ("OSC packet exhausted while reading argument");
+
+            pos += 4;
+        }
+    }
+
+    if (pos != end)
+        throw OSCFormatError ("OSC packet format error: unexpected data after the last argument");
+}
+
+OSCArgumentView OSCMessageView::operator[] (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, numArguments));
+
+    auto iter = begin();
+
+    for (int i = 0; i < index; ++i)
+        ++iter;
+
+    return *iter;
+}
+
+size_t OSCMessageView::getArgumentSizeInBytes (OSCType type, const uint8* argumentData) noexcept
+{
+    if (type == OSCTypes::string)
+        return roundUpToMultipleOfFour (strlen (reinterpret_cast<const char*> (argumentData)) + 1);
+
+    if (type == OSCTypes::blob)
+        return 4 + roundUpToMultipleOfFour ((size_t) ByteOrder::bigEndianInt (argumentData));
+
+    return 4;
+}
+
+//==============================================================================
+OSCPacketView::OSCPacketView (const void* sourceData, size_t sourceDataSize)
+    : data (static_cast<const uint8*> (sourceData)), dataSize (sourceDataSize)
+{
+    if (dataSize == 0 || (data[0] != '/' && data[0] != '#'))
+        throw OSCFormatError ("OSC packet format error: invalid packet content");
+}
+
+OSCMessageView OSCPacketView::getMessageView() const
+{
+    if (! isMessage())
+        throw OSCFormatError ("OSC packet format error: packet is a bundle, not a message");
+
+    return OSCMessageView (data, dataSize);
+}
+
+OSCTimeTag OSCPacketView::readBundleHeader (const uint8* d, size_t numBytes)
+{
+    if (numBytes < 16)
+        throw OSCFormatError ("OSC packet exhausted while reading bundle");
+
+    if (memcmp (d, "#bundle\0", 8) != 0)
+        throw OSCFormatError ("OSC packet format error: bundle does not start with string '#bundle'");
+
+    return OSCTimeTag (ByteOrder::bigEndianInt64 (d + 8));
+}
+
+size_t OSCPacketView::readBundleElementSize (const uint8* d, size_t numBytesRemaining)
+{
+    if (numBytesRemaining < 4)
+        throw OSCFormatError ("OSC packet exhausted while reading bundle element size");
+
+    auto elementSize = (size_t) ByteOrder::bigEndianInt (d);
+
+    if (elementSize < 4)
+        throw OSCFormatError ("OSC packet format error: invalid bundle element size");
+
+    if (elementSize > numBytesRemaining - 4)
+        throw OSCFormatError ("OSC packet exhausted while reading bundle element content");
+
+    return elementSize;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class OSCPacketViewTests  : public UnitTest
+{
+public:
+    OSCPacketViewTests()
+        : UnitTest ("OSCPacketView class", UnitTestCategories::osc)
+    {}
+
+    void runTest()
+    {
+        beginTest ("parsing a message in place");
+        {
+            const uint8 buffer[] = {
+                '/', 't', 'e', 's', 't', '\0', '\0', '\0',     // address pattern
+                ',', 'i', 'f', 's', 'b', 'r', '\0', '\0',      // type tag string
+                0xFF, 0xFF, 0xF8, 0x21,                        // int32: -2015
+                0x43, 0xAC, 0xCE, 0x66,                        // float32: 345.6125
+                'f', 'o', 'o', '\0',                           // string: "foo"
+                0x00, 0x00, 0x00, 0x05,                        // blob size: 5
+                0xBB, 0xCC, 0xDD, 0xEE, 0xFF, 0x00, 0x00, 0x00,// blob data + padding
+                0xAA, 0xBB, 0xCC, 0xDD };                      // colour
+
+            OSCMessageView message (buffer, sizeof (buffer));
+
+            expect (message.getAddressPatternString() == StringRef ("/test"));
+            expectEquals (message.size(), 5);
+
+            expect (message[0].isInt32());
+            expectEquals (message[0].getInt32(), -2015);
+
+            expect (message[1].isFloat32());
+            expectEquals (message[1].getFloat32(), 345.6125f);
+
+            expect (message[2].isString());
+            expect (message[2].getString() == StringRef ("foo"));
+            expect (message[2].getString().text.getAddress() == reinterpret_cast<const char*> (buffer) + 24); // no copy
+
+            expect (message[3].isBlob());
+            expectEquals ((int) message[3].getBlobDataSize(), 5);
+            expect (memcmp (message[3].getBlobData(), buffer + 32, 5) == 0);
+
+            expect (message[4].isColour());
+            expect (message[4].getColour().toInt32() == 0xAABBCCDD);
+
+            // iteration visits the same arguments:
+            int numVisited = 0;
+
+            for (auto argument : message)
+                expectEquals ((int) argument.getType(), (int) message[numVisited++].getType());
+
+            expectEquals (numVisited, 5);
+        }
+
+        beginTest ("parsing a message with no arguments");
+        {
+            const uint8 buffer[] = {
+                '/', 'p', 'i', 'n', 'g', '\0', '\0', '\0',
+                ',', '\0', '\0', '\0' };
+
+            OSCMessageView message (buffer, sizeof (buffer));
+
+            expect (message.getAddressPatternString() == StringRef ("/ping"));
+            expect (message.isEmpty());
+            expect (! (message.begin() != message.end()));
+        }
+
+        beginTest ("failing on malformed messages");
+        {
+            const uint8 buffer[] = {
+                '/', 't', 'e', 's', 't', '\0', '\0', '\0',
+                ',', 'i', '\0', '\0',
+                0x00, 0x00, 0x00, 0x2A };
+
+            expectDoesNotThrow (OSCMessageView (buffer, sizeof (buffer)));
+
+            // buffer truncated in the middle of an argument:
+            expectThrowsType (OSCMessageView (buffer, sizeof (buffer) - 2), OSCFormatError)
+
+            // buffer truncated before the type tag string:
+            expectThrowsType (OSCMessageView (buffer, 8), OSCFormatError)
+
+            // address pattern without a leading slash:
+            expectThrowsType (OSCMessageView (buffer + 1, sizeof (buffer) - 1), OSCFormatError)
+
+            // trailing bytes after the last argument:
+            const uint8 oversized[] = {
+                '/', 't', 'e', 's', 't', '\0', '\0', '\0',
+                ',', 'i', '\0', '\0',
+                0x00, 0x00, 0x00, 0x2A,
+                0x00, 0x00, 0x00, 0x00 };
+
+            expectThrowsType (OSCMessageView (oversized, sizeof (oversized)), OSCFormatError)
+
+            // unsupported type tag:
+            const uint8 unsupportedType[] = {
+                '/', 't', 'e', 's', 't', '\0', '\0', '\0',
+                ',', 'x', '\0', '\0',
+                0x00, 0x00, 0x00, 0x2A };
+
+            expectThrowsType (OSCMessageView (unsupportedType, sizeof (unsupportedType)), OSCFormatError)
+
+            // missing padding zeros after a string argument:
+            const uint8 badPadding[] = {
+                '/', 't', 'e', 's', 't', '\0', '\0', '\0',
+                ',', 's', '\0', '\0',
+                'f', 'o', 'o', 'b', 'a', 'r', '\0', 'x' };
+
+            expectThrowsType (OSCMessageView (badPadding, sizeof (badPadding)), OSCFormatError)
+        }
+
+        beginTest ("iterating the messages of a bundle");
+        {
+            const uint8 buffer[] = {
+                '#', 'b', 'u', 'n', 'd', 'l', 'e', '\0',       // bundle header
+                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,// time tag: immediately
+                0x00, 0x00, 0x00, 0x0C,                        // element 1 size: 12
+                '/', 'a', '\0', '\0',                          // message 1
+                ',', 'i', '\0', '\0',
+                0x00, 0x00, 0x00, 0x01,
+                0x00, 0x00, 0x00, 0x20,                        // element 2 size: 32 (nested bundle)
+                '#', 'b', 'u', 'n', 'd', 'l', 'e', '\0',
+                0x12, 0x34, 0x56, 0x78, 0x00, 0x00, 0x00, 0x00,// non-immediate time tag
+                0x00, 0x00, 0x00, 0x0C,                        // nested element size: 12
+                '/', 'b', '\0', '\0',                          // message 2
+                ',', 'i', '\0', '\0',
+                0x00, 0x00, 0x00, 0x02 };
+
+            OSCPacketView packet (buffer, sizeof (buffer));
+            expect (packet.isBundle());
+            expect (! packet.isMessage());
+            expectThrowsType (packet.getMessageView(), OSCFormatError)
+
+            StringArray addresses;
+            Array<int> values;
+            int numImmediate = 0;
+
+            packet.forEachMessage ([&] (const OSCMessageView& message, OSCTimeTag timeTag)
+            {
+                addresses.add (message.getAddressPatternString());
+                values.add (message[0].getInt32());
+
+                if (timeTag.isImmediately())
+                    ++numImmediate;
+            });
+
+            expectEquals (addresses.size(), 2);
+            expectEquals (addresses[0], String ("/a"));
+            expectEquals (addresses[1], String ("/b"));
+            expectEquals (values[0], 1);
+            expectEquals (values[1], 2);
+
+            // the nested message should get the nested bundle's time tag:
+            expectEquals (numImmediate, 1);
+        }
+
+        beginTest ("iterating the message of a single-message packet");
+        {
+            const uint8 buffer[] = {
+                '/', 'p', 'i', 'n', 'g', '\0', '\0', '\0',
+                ',', '\0', '\0', '\0' };
+
+            OSCPacketView packet (buffer, sizeof (buffer));
+            expect (packet.isMessage());
+            expect (packet.getMessageView().getAddressPatternString() == StringRef ("/ping"));
+
+            int numVisited = 0;
+
+            packet.forEachMessage ([&] (const OSCMessageView& message, OSCTimeTag timeTag)
+            {
+                expect (message.getAddressPatternString() == StringRef ("/ping"));
+                expect (timeTag.isImmediately());
+                ++numVisited;
+            });
+
+            expectEquals (numVisited, 1);
+        }
+
+        beginTest ("failing on malformed bundles");
+        {
+            // neither a message nor a bundle:
+            const uint8 garbage[] = { 'x', 'y', 'z', '\0' };
+            expectThrowsType (OSCPacketView (garbage, sizeof (garbage)), OSCFormatError)
+
+            // bundle header truncated:
+            const uint8 truncated[] = { '#', 'b', 'u', 'n', 'd', 'l', 'e', '\0' };
+            OSCPacketView packet (truncated, sizeof (truncated));
+            expectThrowsType (packet.forEachMessage ([] (const OSCMessageView&, OSCTimeTag) {}), OSCFormatError)
+
+            // element size larger than the remaining content:
+            const uint8 badElementSize[] = {
+                '#', 'b', 'u', 'n', 'd', 'l', 'e', '\0',
+                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+                0x00, 0x00, 0x01, 0x00,
+                '/', 'a', '\0', '\0',
+                ',', '\0', '\0', '\0' };
+
+            OSCPacketView packet2 (badElementSize, sizeof (badElementSize));
+            expectThrowsType (packet2.forEachMessage ([] (const OSCMessageView&, OSCTimeTag) {}), OSCFormatError)
+        }
+    }
+};
+
+static OSCPacketViewTests OSCPacketViewUnitTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,290 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A non-owning view of a single OSC argument stored inside an OSC packet.
+
+    Unlike OSCArgument, this does not copy the argument's value: the accessors
+    read it straight out of the packet buffer, so the buffer must stay valid
+    for as long as the view is used.
+
+    You get OSCArgumentView objects by iterating an OSCMessageView.
+
+    @see OSCMessageView, OSCArgument
+
+    @tags{OSC}
+*/
+class JUCE_API  OSCArgumentView
+{
+public:
+    /** Returns the type of the argument as an OSCType.
+        OSCType is a char type, and its value will be the OSC type tag of the type.
+    */
+    OSCType getType() const noexcept        { return type; }
+
+    /** Returns whether the type of the argument is int32. */
+    bool isInt32() const noexcept           { return type == OSCTypes::int32; }
+
+    /** Returns whether the type of the argument is float. */
+    bool isFloat32() const noexcept         { return type == OSCTypes::float32; }
+
+    /** Returns whether the type of the argument is string. */
+    bool isString() const noexcept          { return type == OSCTypes::string; }
+
+    /** Returns whether the type of the argument is blob. */
+    bool isBlob() const noexcept            { return type == OSCTypes::blob; }
+
+    /** Returns whether the type of the argument is colour. */
+    bool isColour() const noexcept          { return type == OSCTypes::colour; }
+
+    /** Returns the value of the argument as an int32.
+        If the type of the argument is not int32, the behaviour is undefined.
+    */
+    int32 getInt32() const noexcept;
+
+    /** Returns the value of the argument as a float32.
+        If the type of the argument is not float32, the behaviour is undefined.
+    */
+    float getFloat32() const noexcept;
+
+    /** Returns the value of the argument as a StringRef pointing into the packet.
+        If the type of the argument is not string, the behaviour is undefined.
+    */
+    StringRef getString() const noexcept;
+
+    /** Returns a pointer to the binary data of the blob inside the packet.
+        If the type of the argument is not blob, the behaviour is undefined.
+    */
+    const void* getBlobData() const noexcept;
+
+    /** Returns the number of bytes in the blob.
+        If the type of the argument is not blob, the behaviour is undefined.
+    */
+    size_t getBlobDataSize() const noexcept;
+
+    /** Returns the value of the argument as an OSCColour.
+        If the type of the argument is not a colour, the behaviour is undefined.
+    */
+    OSCColour getColour() const noexcept;
+
+private:
+    //==============================================================================
+    friend class OSCMessageView;
+
+    OSCArgumentView (OSCType t, const uint8* d) noexcept  : type (t), data (d) {}
+
+    OSCType type;
+    const uint8* data;
+};
+
+//==============================================================================
+/**
+    A non-owning view of an OSC message stored in a packet buffer.
+
+    Where OSCInputStream copies the address pattern, strings and blobs of a
+    message into newly allocated OSCMessage and OSCArgument objects, this class
+    parses the message in place: constructing a view and reading its arguments
+    does not allocate any memory, which makes it suitable for use on realtime
+    threads.
+
+    The view only keeps pointers into the buffer, so the buffer must outlive
+    the view and any OSCArgumentView objects obtained from it.
+
+    The message is validated once, by the constructor; afterwards, all the
+    accessors are non-throwing.
+
+    @see OSCPacketView, OSCMessage, OSCReceiver
+
+    @tags{OSC}
+*/
+class JUCE_API  OSCMessageView
+{
+public:
+    //==============================================================================
+    /** Creates a view of the OSC message stored in the given buffer.
+
+        @param sourceData      the buffer holding the message content
+        @param sourceDataSize  the number of bytes in the buffer
+
+        @throw OSCFormatError if the buffer does not hold a well-formed OSC message.
+    */
+    OSCMessageView (const void* sourceData, size_t sourceDataSize);
+
+    //==============================================================================
+    /** Returns the address pattern of the message, pointing into the packet. */
+    StringRef getAddressPatternString() const noexcept      { return StringRef (addressPattern); }
+
+    /** Returns the number of arguments in the message. */
+    int size() const noexcept                               { return numArguments; }
+
+    /** Returns true if the message contains no arguments. */
+    bool isEmpty() const noexcept                           { return numArguments == 0; }
+
+    /** Returns a view of the argument at the given index.
+
+        Note: this has to skip over the preceding arguments, so iterating the
+        message is more efficient than repeated indexed access.
+    */
+    OSCArgumentView operator[] (int index) const noexcept;
+
+    //==============================================================================
+    /** An iterator over the arguments of an OSCMessageView. */
+    class Iterator
+    {
+    public:
+        OSCArgumentView operator*() const noexcept      { return makeArgumentView (*typeTag, argumentData); }
+
+        Iterator& operator++() noexcept
+        {
+            argumentData += getArgumentSizeInBytes (*typeTag, argumentData);
+            ++typeTag;
+            return *this;
+        }
+
+        bool operator== (const Iterator& other) const noexcept   { return typeTag == other.typeTag; }
+        bool operator!= (const Iterator& other) const noexcept   { return typeTag != other.typeTag; }
+
+    private:
+        friend class OSCMessageView;
+
+        Iterator (const OSCType* tt, const uint8* ad) noexcept  : typeTag (tt), argumentData (ad) {}
+
+        const OSCType* typeTag;
+        const uint8* argumentData;
+    };
+
+    /** Returns an iterator pointing at the first argument of the message. */
+    Iterator begin() const noexcept                         { return { typeTags, firstArgument }; }
+
+    /** Returns an iterator pointing past the last argument of the message. */
+    Iterator end() const noexcept                           { return { typeTags + numArguments, nullptr }; }
+
+private:
+    //==============================================================================
+    static size_t getArgumentSizeInBytes (OSCType type, const uint8* argumentData) noexcept;
+
+    // gives the nested Iterator access to OSCArgumentView's private constructor:
+    static OSCArgumentView makeArgumentView (OSCType t, const uint8* d) noexcept    { return { t, d }; }
+
+    const char* addressPattern;
+    const OSCType* typeTags;
+    const uint8* firstArgument;
+    int numArguments;
+};
+
+//==============================================================================
+/**
+    A non-owning view of an OSC packet, which contains either a single OSC
+    message or an OSC bundle.
+
+    Use forEachMessage() to walk all the messages in the packet - including
+    those inside nested bundles - without copying any of the packet's content
+    or allocating any memory.
+
+    As with OSCMessageView, the buffer must outlive the view.
+
+    @see OSCMessageView, OSCBundle, OSCReceiver
+
+    @tags{OSC}
+*/
+class JUCE_API  OSCPacketView
+{
+public:
+    //==============================================================================
+    /** Creates a view of the OSC packet stored in the given buffer.
+
+        The packet content is only fully validated when it is traversed, so
+        forEachMessage() and getMessageView() may throw an OSCFormatError even
+        if construction succeeded.
+
+        @throw OSCFormatError if the buffer content is neither an OSC message
+                              nor an OSC bundle.
+    */
+    OSCPacketView (const void* sourceData, size_t sourceDataSize);
+
+    //==============================================================================
+    /** Returns true if the packet contains a single OSC message. */
+    bool isMessage() const noexcept                 { return data[0] == '/'; }
+
+    /** Returns true if the packet contains an OSC bundle. */
+    bool isBundle() const noexcept                  { return data[0] == '#'; }
+
+    /** Returns a view of the message contained in the packet.
+        @throw OSCFormatError if the packet is a bundle or the message is malformed.
+    */
+    OSCMessageView getMessageView() const;
+
+    //==============================================================================
+    /** Calls a function for every message in the packet, descending into
+        nested bundles recursively.
+
+        The callback must be callable as callback (const OSCMessageView&, OSCTimeTag),
+        where the time tag is the one of the innermost bundle containing the
+        message, or OSCTimeTag::immediately if the packet is a single message.
+
+        @throw OSCFormatError if the packet content is malformed.
+    */
+    template <typename Callback>
+    void forEachMessage (Callback&& callback) const
+    {
+        visit (data, dataSize, OSCTimeTag::immediately, callback);
+    }
+
+private:
+    //==============================================================================
+    template <typename Callback>
+    static void visit (const uint8* d, size_t numBytes, OSCTimeTag timeTag, Callback& callback)
+    {
+        if (numBytes > 0 && d[0] == '#')
+        {
+            auto bundleTime = readBundleHeader (d, numBytes);
+
+            for (size_t pos = 16; pos < numBytes;)
+            {
+                auto elementSize = readBundleElementSize (d + pos, numBytes - pos);
+                pos += 4;
+                visit (d + pos, elementSize, bundleTime, callback);
+                pos += elementSize;
+            }
+        }
+        else
+        {
+            const OSCMessageView message (d, numBytes);
+            callback (message, timeTag);
+        }
+    }
+
+    static OSCTimeTag readBundleHeader (const uint8* d, size_t numBytes);
+    static size_t readBundleElementSize (const uint8* d, size_t numBytesRemaining);
+
+    const uint8* data;
+    size_t dataSize;
+};
+
+} // namespace juce
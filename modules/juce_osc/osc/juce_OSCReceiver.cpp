@@ -380,12 +380,12 @@ struct OSCReceiver::Pimpl   : private Thread,
     void addListener (ListenerWithOSCAddress<MessageLoopCallback>* listenerToAdd,
                       OSCAddress addressToMatch)
     {
-        addListenerWithAddress (listenerToAdd, addressToMatch, listenersWithAddress);
+        addListenerWithAddress (listenerToAdd, addressToMatch, listenersWithAddress, listenersWithAddressTrie);
     }
 
     void addListener (ListenerWithOSCAddress<RealtimeCallback>* listenerToAdd, OSCAddress addressToMatch)
     {
-        addListenerWithAddress (listenerToAdd, addressToMatch, realtimeListenersWithAddress);
+        addListenerWithAddress (listenerToAdd, addressToMatch, realtimeListenersWithAddress, realtimeListenersWithAddressTrie);
     }
 
     void removeListener (OSCReceiver::Listener<MessageLoopCallback>* listenerToRemove)
@@ -400,12 +400,12 @@ struct OSCReceiver::Pimpl   : private Thread,
 
     void removeListener (ListenerWithOSCAddress<MessageLoopCallback>* listenerToRemove)
     {
-        removeListenerWithAddress (listenerToRemove, listenersWithAddress);
+        removeListenerWithAddress (listenerToRemove, listenersWithAddress, listenersWithAddressTrie);
     }
 
     void removeListener (ListenerWithOSCAddress<RealtimeCallback>* listenerToRemove)
     {
-        removeListenerWithAddress (listenerToRemove, realtimeListenersWithAddress);
+        removeListenerWithAddress (listenerToRemove, realtimeListenersWithAddress, realtimeListenersWithAddressTrie);
     }
 
     //==============================================================================
@@ -424,6 +424,22 @@ struct OSCReceiver::Pimpl   : private Thread,
 
         try
         {
+            // if only address-matching listeners are registered and this is a single
+            // message whose address pattern matches none of their addresses, the
+            // packet can be rejected here without allocating anything:
+            if (listeners.size() == 0 && realtimeListeners.size() == 0
+                 && dataSize > 0 && data[0] == '/')
+            {
+                const OSCMessageView messageView (data, dataSize);
+
+                scratchMatches.clearQuick();
+                listenersWithAddressTrie.findMatches (messageView.getAddressPatternString(), scratchMatches);
+                realtimeListenersWithAddressTrie.findMatches (messageView.getAddressPatternString(), scratchMatches);
+
+                if (scratchMatches.isEmpty())
+                    return;
+            }
+
             auto content = inStream.readElementWithKnownSize (dataSize);
 
             // realtime listeners should receive the OSC content first - and immediately
@@ -480,19 +496,22 @@ private:
     template <typename ListenerType>
     void addListenerWithAddress (ListenerType* listenerToAdd,
                                  OSCAddress address,
-                                 Array<std::pair<OSCAddress, ListenerType*>>& array)
+                                 Array<std::pair<OSCAddress, ListenerType*>>& array,
+                                 OSCAddressTrie& trie)
     {
         for (auto& i : array)
             if (address == i.first && listenerToAdd == i.second)
                 return;
 
+        trie.add (address, array.size());
         array.add (std::make_pair (address, listenerToAdd));
     }
 
     //==============================================================================
     template <typename ListenerType>
     void removeListenerWithAddress (ListenerType* listenerToRemove,
-                                    Array<std::pair<OSCAddress, ListenerType*>>& array)
+                                    Array<std::pair<OSCAddress, ListenerType*>>& array,
+                                    OSCAddressTrie& trie)
     {
         for (int i = 0; i < array.size(); ++i)
         {
@@ -503,11 +522,23 @@ private:
                 // luckily, we don't care about methods preserving element order:
                 array.swap (i, array.size() - 1);
                 array.removeLast();
+
+                // the swap above invalidates the indices stored in the trie:
+                rebuildTrie (array, trie);
                 break;
             }
         }
     }
 
+    template <typename ListenerType>
+    static void rebuildTrie (const Array<std::pair<OSCAddress, ListenerType*>>& array, OSCAddressTrie& trie)
+    {
+        trie.clear();
+
+        for (int i = 0; i < array.size(); ++i)
+            trie.add (array.getReference (i).first, i);
+    }
+
     //==============================================================================
     void handleMessage (const Message& msg) override
     {
@@ -558,18 +589,28 @@ private:
     //==============================================================================
     void callListenersWithAddress (const OSCMessage& message)
     {
-        for (auto& entry : listenersWithAddress)
-            if (auto* listener = entry.second)
-                if (message.getAddressPattern().matches (entry.first))
-                    listener->oscMessageReceived (message);
+        if (listenersWithAddress.isEmpty())
+            return;
+
+        matchedMessageLoopListeners.clearQuick();
+        listenersWithAddressTrie.findMatches (message.getAddressPattern(), matchedMessageLoopListeners);
+
+        for (auto index : matchedMessageLoopListeners)
+            if (auto* listener = listenersWithAddress.getReference (index).second)
+                listener->oscMessageReceived (message);
     }
 
     void callRealtimeListenersWithAddress (const OSCMessage& message)
     {
-        for (auto& entry : realtimeListenersWithAddress)
-            if (auto* listener = entry.second)
-                if (message.getAddressPattern().matches (entry.first))
-                    listener->oscMessageReceived (message);
+        if (realtimeListenersWithAddress.isEmpty())
+            return;
+
+        matchedRealtimeListeners.clearQuick();
+        realtimeListenersWithAddressTrie.findMatches (message.getAddressPattern(), matchedRealtimeListeners);
+
+        for (auto index : matchedRealtimeListeners)
+            if (auto* listener = realtimeListenersWithAddress.getReference (index).second)
+                listener->oscMessageReceived (message);
     }
 
     //==============================================================================
@@ -579,6 +620,13 @@ private:
     Array<std::pair<OSCAddress, OSCReceiver::ListenerWithOSCAddress<OSCReceiver::MessageLoopCallback>*>> listenersWithAddress;
     Array<std::pair<OSCAddress, OSCReceiver::ListenerWithOSCAddress<OSCReceiver::RealtimeCallback>*>>    realtimeListenersWithAddress;
 
+    // indexes into the arrays above, so that matching a message against the
+    // registered addresses only visits the addresses sharing a prefix with it:
+    OSCAddressTrie listenersWithAddressTrie, realtimeListenersWithAddressTrie;
+
+    // reusable match buffers, one per thread that dispatches messages:
+    Array<int> matchedMessageLoopListeners, matchedRealtimeListeners, scratchMatches;
+
     OptionalScopedPointer<DatagramSocket> socket;
     OSCReceiver::FormatErrorHandler formatErrorHandler { nullptr };
 
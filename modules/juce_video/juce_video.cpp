@@ -64,6 +64,7 @@
 
 //==============================================================================
 #include "playback/juce_VideoComponent.cpp"
+#include "playback/juce_VideoFrameCache.cpp"
 
 #if JUCE_USE_CAMERA
  #include "capture/juce_CameraDevice.cpp"
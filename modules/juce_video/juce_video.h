@@ -100,4 +100,5 @@
 
 //==============================================================================
 #include "playback/juce_VideoComponent.h"
+#include "playback/juce_VideoFrameCache.h"
 #include "capture/juce_CameraDevice.h"
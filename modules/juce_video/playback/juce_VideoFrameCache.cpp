@@ -0,0 +1,267 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+static size_t getFrameSizeInBytes (const Image& image) noexcept
+{
+    if (! image.isValid())
+        return 0;
+
+    auto bytesPerPixel = image.getFormat() == Image::RGB ? 3
+                       : image.getFormat() == Image::SingleChannel ? 1 : 4;
+
+    return (size_t) image.getWidth() * (size_t) image.getHeight() * (size_t) bytesPerPixel;
+}
+
+//==============================================================================
+VideoFrameCache::VideoFrameCache (FrameSource& sourceToUse, size_t maxCacheSizeInBytes)
+    : Thread ("Video Frame Cache"),
+      source (sourceToUse),
+      maxCacheSize (maxCacheSizeInBytes)
+{
+    startThread();
+}
+
+VideoFrameCache::~VideoFrameCache()
+{
+    stopThread (10000);
+    cancelPendingUpdate();
+}
+
+//==============================================================================
+void VideoFrameCache::requestFrame (double timeSeconds, FrameCallback callbackToInvoke, int priority)
+{
+    jassert (callbackToInvoke != nullptr);
+
+    auto frameTime = source.getFrameTimeFor (timeSeconds);
+
+    {
+        const ScopedLock sl (lock);
+
+        if (auto* cached = findCachedFrame (frameTime))
+        {
+            // already decoded - deliver asynchronously, for consistent ordering
+            completed.push_back ({ frameTime, cached->image, {} });
+            completed.back().callbacks.push_back (std::move (callbackToInvoke));
+            triggerAsyncUpdate();
+            return;
+        }
+
+        for (auto& request : pending)
+        {
+            if (request.time == frameTime)
+            {
+                request.priority = jmax (request.priority, priority);
+                request.callbacks.push_back (std::move (callbackToInvoke));
+                return;
+            }
+        }
+
+        pending.push_back ({ frameTime, priority, {} });
+        pending.back().callbacks.push_back (std::move (callbackToInvoke));
+    }
+
+    notify();
+}
+
+Image VideoFrameCache::getFrameIfCached (double timeSeconds)
+{
+    auto frameTime = source.getFrameTimeFor (timeSeconds);
+
+    const ScopedLock sl (lock);
+
+    if (auto* cached = findCachedFrame (frameTime))
+        return cached->image;
+
+    return {};
+}
+
+void VideoFrameCache::cancelPendingRequests()
+{
+    const ScopedLock sl (lock);
+    pending.clear();
+}
+
+void VideoFrameCache::clear()
+{
+    const ScopedLock sl (lock);
+    cache.clear();
+    cacheSize = 0;
+}
+
+void VideoFrameCache::setMaxCacheSize (size_t maxNumBytes)
+{
+    const ScopedLock sl (lock);
+    maxCacheSize = maxNumBytes;
+    trimCacheToSize (maxCacheSize);
+}
+
+size_t VideoFrameCache::getCacheSizeInBytes() const
+{
+    const ScopedLock sl (lock);
+    return cacheSize;
+}
+
+//==============================================================================
+void VideoFrameCache::run()
+{
+    while (! threadShouldExit())
+    {
+        PendingRequest request;
+
+        if (! pickNextRequest (request))
+        {
+            wait (-1);
+            continue;
+        }
+
+        Image frame;
+
+        {
+            const ScopedLock sl (lock);
+
+            if (auto* cached = findCachedFrame (request.time))
+                frame = cached->image;
+        }
+
+        // the expensive decode happens without holding the lock
+        if (! frame.isValid())
+        {
+            frame = source.decodeFrameAt (request.time);
+            storeFrame (request.time, frame);
+        }
+
+        queueCompletion (std::move (request), frame);
+    }
+}
+
+bool VideoFrameCache::pickNextRequest (PendingRequest& result)
+{
+    const ScopedLock sl (lock);
+
+    if (pending.empty())
+        return false;
+
+    // Decode the highest-priority request; among equals, work forwards in time
+    // from the last frame decoded, so that a keyframe-seeking decoder steps
+    // through the file monotonically instead of bouncing around.
+    auto isBetter = [this] (const PendingRequest& a, const PendingRequest& b)
+    {
+        if (a.priority != b.priority)
+            return a.priority > b.priority;
+
+        auto aIsForward = a.time >= lastDecodedTime;
+
+        if (aIsForward != (b.time >= lastDecodedTime))
+            return aIsForward;
+
+        return a.time < b.time;
+    };
+
+    auto best = pending.begin();
+
+    for (auto i = std::next (best); i != pending.end(); ++i)
+        if (isBetter (*i, *best))
+            best = i;
+
+    result = std::move (*best);
+    pending.erase (best);
+    lastDecodedTime = result.time;
+    return true;
+}
+
+VideoFrameCache::CachedFrame* VideoFrameCache::findCachedFrame (double time) noexcept
+{
+    for (auto& frame : cache)
+    {
+        if (frame.time == time)
+        {
+            frame.lastUseTime = ++useCounter;
+            return &frame;
+        }
+    }
+
+    return nullptr;
+}
+
+void VideoFrameCache::storeFrame (double time, const Image& image)
+{
+    auto numBytes = getFrameSizeInBytes (image);
+
+    if (numBytes == 0)
+        return; // failed decodes are delivered but not cached
+
+    const ScopedLock sl (lock);
+
+    if (findCachedFrame (time) != nullptr)
+        return;
+
+    // make room for the new frame, but never evict on its behalf alone
+    if (numBytes < maxCacheSize)
+        trimCacheToSize (maxCacheSize - numBytes);
+
+    cache.push_back ({ time, image, numBytes, ++useCounter });
+    cacheSize += numBytes;
+}
+
+void VideoFrameCache::trimCacheToSize (size_t maxNumBytes)
+{
+    while (cacheSize > maxNumBytes && ! cache.empty())
+    {
+        auto oldest = cache.begin();
+
+        for (auto i = std::next (oldest); i != cache.end(); ++i)
+            if (i->lastUseTime < oldest->lastUseTime)
+                oldest = i;
+
+        cacheSize -= oldest->numBytes;
+        cache.erase (oldest);
+    }
+}
+
+void VideoFrameCache::queueCompletion (PendingRequest&& request, const Image& image)
+{
+    const ScopedLock sl (lock);
+    completed.push_back ({ request.time, image, std::move (request.callbacks) });
+    triggerAsyncUpdate();
+}
+
+void VideoFrameCache::handleAsyncUpdate()
+{
+    std::vector<CompletedRequest> toDeliver;
+
+    {
+        const ScopedLock sl (lock);
+        std::swap (toDeliver, completed);
+    }
+
+    for (auto& request : toDeliver)
+        for (auto& callback : request.callbacks)
+            callback (request.time, request.image);
+}
+
+} // namespace juce
@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Extracts video frames as Images on a background thread, keeping the results
+    in a size-limited cache.
+
+    This provides the machinery that a scrubbing or thumbnail UI needs: requests
+    for timestamps are queued with a priority, decoded off the message thread,
+    cached within a byte budget, and delivered asynchronously to a callback on
+    the message thread. Repeated requests for the same frame are coalesced, and
+    each batch of pending requests is decoded in ascending time order, so a
+    decoder that seeks to the preceding keyframe ends up stepping forwards
+    through the file rather than seeking back and forth.
+
+    The actual decoding is delegated to a FrameSource that you supply, which
+    wraps whatever decoder the platform provides (e.g. AVAssetImageGenerator,
+    or a Media Foundation source reader).
+
+    @code
+    struct MySource  : public VideoFrameCache::FrameSource
+    {
+        Image decodeFrameAt (double time) override   { return myDecoder.getFrame (time); }
+    };
+
+    cache.requestFrame (mouseTimePosition, [this] (double time, const Image& frame)
+    {
+        thumbnailStrip.setFrame (time, frame);
+    });
+    @endcode
+
+    @see VideoComponent, Image
+
+    @tags{Video}
+*/
+class JUCE_API  VideoFrameCache  : private Thread,
+                                   private AsyncUpdater
+{
+public:
+    //==============================================================================
+    /** A decoder interface that produces frames for the cache. */
+    struct JUCE_API  FrameSource
+    {
+        virtual ~FrameSource() = default;
+
+        /** Snaps a requested timestamp to the time of the frame that would
+            actually be shown for it.
+
+            The snapped time is used as the cache key, so implementing this
+            means that scrub positions which land within the same frame (or the
+            same keyframe interval, for a keyframe-only decoder) share a single
+            cache entry and a single decode. The default returns the time
+            unchanged.
+
+            This may be called on any thread, concurrently with decodeFrameAt(),
+            so it should be fast and must not touch the decoder's seek state.
+        */
+        virtual double getFrameTimeFor (double timeSeconds)         { return timeSeconds; }
+
+        /** Must decode and return the frame at the given time, or an invalid
+            Image if it can't be produced.
+
+            This is only ever called on the cache's background thread, one frame
+            at a time, in ascending time order within each batch of requests.
+        */
+        virtual Image decodeFrameAt (double timeSeconds) = 0;
+    };
+
+    //==============================================================================
+    /** Creates a cache that will pull its frames from the given source.
+
+        The source must remain valid for the cache's lifetime.
+
+        @param sourceToUse          the decoder to fetch frames from
+        @param maxCacheSizeInBytes  the pixel-data budget to keep cached frames within
+    */
+    explicit VideoFrameCache (FrameSource& sourceToUse,
+                              size_t maxCacheSizeInBytes = 64 * 1024 * 1024);
+
+    /** Destructor. Pending requests are discarded without their callbacks being invoked. */
+    ~VideoFrameCache() override;
+
+    //==============================================================================
+    /** The type of callback invoked when a requested frame is ready.
+
+        The time passed in is the snapped frame time. The image will be invalid
+        if the source failed to decode the frame.
+    */
+    using FrameCallback = std::function<void (double timeSeconds, const Image& frame)>;
+
+    /** Asks for the frame at the given time, invoking the callback on the
+        message thread when it's available.
+
+        Requests with a higher priority are decoded first, so a UI can give the
+        frame under the cursor a higher priority than speculative read-ahead.
+        Requests that snap to the same frame time are coalesced into one decode,
+        and already-cached frames are delivered without touching the decoder
+        (though still asynchronously, for consistent callback ordering).
+    */
+    void requestFrame (double timeSeconds, FrameCallback callbackToInvoke, int priority = 0);
+
+    /** Returns the frame for the given time if it's already cached, or an
+        invalid Image otherwise. This never blocks on the decoder, so it's safe
+        to call from paint().
+    */
+    Image getFrameIfCached (double timeSeconds);
+
+    /** Discards all queued requests that haven't started decoding.
+        Their callbacks will not be invoked. Call this when the user stops
+        scrubbing and the backlog is no longer interesting.
+    */
+    void cancelPendingRequests();
+
+    /** Empties the cache, keeping any pending requests. */
+    void clear();
+
+    //==============================================================================
+    /** Changes the cache's pixel-data budget, evicting frames if necessary. */
+    void setMaxCacheSize (size_t maxNumBytes);
+
+    /** Returns the total size of the pixel data currently cached. */
+    size_t getCacheSizeInBytes() const;
+
+private:
+    //==============================================================================
+    struct PendingRequest
+    {
+        double time;
+        int priority;
+        std::vector<FrameCallback> callbacks;
+    };
+
+    struct CachedFrame
+    {
+        double time;
+        Image image;
+        size_t numBytes;
+        uint32 lastUseTime;
+    };
+
+    struct CompletedRequest
+    {
+        double time;
+        Image image;
+        std::vector<FrameCallback> callbacks;
+    };
+
+    void run() override;
+    void handleAsyncUpdate() override;
+
+    bool pickNextRequest (PendingRequest& result);
+    CachedFrame* findCachedFrame (double time) noexcept;
+    void storeFrame (double time, const Image&);
+    void trimCacheToSize (size_t maxNumBytes);
+    void queueCompletion (PendingRequest&&, const Image&);
+
+    //==============================================================================
+    FrameSource& source;
+    CriticalSection lock;
+    std::vector<PendingRequest> pending;
+    std::vector<CachedFrame> cache;
+    std::vector<CompletedRequest> completed;
+    size_t maxCacheSize, cacheSize = 0;
+    double lastDecodedTime = 0;
+    uint32 useCounter = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VideoFrameCache)
+};
+
+} // namespace juce